@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""
+Persistent analysis worker for dase_cli.
+
+dase_cli starts this once and sends one JSON request per line on stdin;
+each request gets one JSON response line on stdout. Interpreter startup
+and the numpy/scipy/matplotlib imports are paid once per session instead
+of once per python_analyze call.
+
+Engine state arrives as raw float64 arrays in a binary file (described by
+the request), which is mapped with numpy instead of parsed from JSON.
+
+Requests:
+  {"id": 1, "op": "ping"}
+  {"id": 2, "op": "run", "script": "analysis/analyze_igsoa_state.py",
+   "argv": ["2.0", "--no-plots"], "output_dir": "analysis_output",
+   "state": {"path": ".../state.bin", "dtype": "float64",
+             "fields": {"psi_real": {"offset": 0, "count": 4096}, ...},
+             "meta": {"engine_id": ..., "num_nodes": ..., ...}}}
+  {"id": 3, "op": "shutdown"}
+
+Responses:
+  {"id": 2, "exit_code": 0, "stdout": "...", "stderr": "...", "elapsed_ms": 12.5}
+
+Scripts may define analyze_state(state, argv) to receive the arrays as
+numpy arrays directly. Other scripts run unchanged as __main__ with
+sys.argv = [script, <state JSON file>, *argv]; the JSON file is written
+from the mapped arrays in the layout dase_cli has always passed.
+"""
+
+import contextlib
+import io
+import json
+import os
+import runpy
+import sys
+import tempfile
+import time
+import traceback
+
+import numpy as np
+
+PROTOCOL_VERSION = 1
+
+# Scripts exposing analyze_state(), cached by path (module globals per script)
+_module_cache = {}
+
+
+def load_state(descriptor):
+    """Map the binary state file into a dict of numpy arrays plus metadata."""
+    state = dict(descriptor.get("meta", {}))
+    dtype = np.dtype(descriptor.get("dtype", "float64")).newbyteorder("<")
+    path = descriptor["path"]
+    for name, field in descriptor.get("fields", {}).items():
+        count = int(field["count"])
+        if count == 0:
+            state[name] = np.empty(0, dtype=dtype)
+            continue
+        state[name] = np.memmap(path, dtype=dtype, mode="r",
+                                offset=int(field["offset"]), shape=(count,))
+    return state
+
+
+def write_legacy_state(state):
+    """Write the JSON state file that command-line scripts expect."""
+    fd, path = tempfile.mkstemp(prefix="state_", suffix=".json")
+    with os.fdopen(fd, "w") as f:
+        json.dump({k: (v.tolist() if isinstance(v, np.ndarray) else v)
+                   for k, v in state.items()}, f)
+    return path
+
+
+def find_fast_path(script):
+    """analyze_state() from script, or None if it only has a command line."""
+    if script in _module_cache:
+        return _module_cache[script]
+    entry = None
+    with open(script, "r", encoding="utf-8") as f:
+        source = f.read()
+    if "def analyze_state(" in source:
+        module = runpy.run_path(script, run_name="dase_worker_module")
+        entry = module.get("analyze_state")
+    _module_cache[script] = entry
+    return entry
+
+
+def run_script(request):
+    script = request["script"]
+    argv = [str(a) for a in request.get("argv", [])]
+    output_dir = request.get("output_dir")
+    if output_dir:
+        os.makedirs(output_dir, exist_ok=True)
+
+    state = load_state(request["state"])
+    out, err = io.StringIO(), io.StringIO()
+    exit_code = 0
+    legacy_path = None
+    saved_argv = sys.argv
+    try:
+        with contextlib.redirect_stdout(out), contextlib.redirect_stderr(err):
+            try:
+                fast = find_fast_path(script)
+                if fast is not None:
+                    result = fast(state, argv)
+                    if result is not None:
+                        print(json.dumps(result))
+                else:
+                    legacy_path = write_legacy_state(state)
+                    sys.argv = [script, legacy_path] + argv
+                    runpy.run_path(script, run_name="__main__")
+            except SystemExit as e:
+                code = e.code
+                exit_code = code if isinstance(code, int) else (0 if code is None else 1)
+                if code is not None and not isinstance(code, int):
+                    print(code, file=sys.stderr)
+            except Exception:
+                exit_code = 1
+                traceback.print_exc()
+    finally:
+        sys.argv = saved_argv
+        if legacy_path:
+            with contextlib.suppress(OSError):
+                os.remove(legacy_path)
+        # Release figures so long sessions do not accumulate them
+        if "matplotlib.pyplot" in sys.modules:
+            sys.modules["matplotlib.pyplot"].close("all")
+
+    return {"exit_code": exit_code, "stdout": out.getvalue(), "stderr": err.getvalue()}
+
+
+def main():
+    # The real stdout carries only protocol lines
+    protocol = sys.stdout
+    for line in sys.stdin:
+        line = line.strip()
+        if not line:
+            continue
+        start = time.perf_counter()
+        try:
+            request = json.loads(line)
+        except json.JSONDecodeError as e:
+            response = {"id": None, "exit_code": -1, "error": f"bad request: {e}"}
+        else:
+            op = request.get("op", "run")
+            if op == "shutdown":
+                break
+            if op == "ping":
+                response = {"ok": True, "version": PROTOCOL_VERSION,
+                            "python": sys.version.split()[0]}
+            elif op == "run":
+                try:
+                    response = run_script(request)
+                except Exception as e:
+                    response = {"exit_code": -1, "error": f"{type(e).__name__}: {e}"}
+            else:
+                response = {"exit_code": -1, "error": f"unknown op: {op}"}
+            response["id"] = request.get("id")
+        response["elapsed_ms"] = (time.perf_counter() - start) * 1000.0
+        protocol.write(json.dumps(response) + "\n")
+        protocol.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -6,6 +6,7 @@
 const express = require('express');
 const WebSocket = require('ws');
 const { spawn } = require('child_process');
+const net = require('net');
 const path = require('path');
 const fs = require('fs');
 const { configureApi } = require('./api');
@@ -21,6 +22,77 @@ const MAX_BUFFER_SIZE = 10 * 1024 * 1024;  // 10MB max buffer per client
 const IDLE_TIMEOUT_MS = 60 * 60 * 1000;  // 1 hour idle timeout
 const COMMAND_TIMEOUT_MS = 60 * 1000;  // 1 minute command timeout
 
+// DASE_DAEMON_SOCKET: a `dase_cli --listen` socket. When set, every client
+// connection (and every engine description) goes to that one daemon
+// instead of starting a dase_cli process. The daemon needs Unix domain
+// sockets; Windows builds keep the process-per-connection mode.
+const CLI_PATH = path.join(__dirname, '../dase_cli/dase_cli.exe');
+const DAEMON_SOCKET = process.env.DASE_DAEMON_SOCKET || '';
+if (DAEMON_SOCKET && process.platform === 'win32') {
+    console.error('DASE_DAEMON_SOCKET is set, but dase_cli --listen is not available on Windows');
+    process.exit(1);
+}
+
+/**
+ * One line-oriented channel to dase_cli: a connection to the daemon, or a
+ * dedicated process. input takes command lines, output yields response
+ * lines, errors is the process stderr (null for the daemon, which keeps
+ * its own), and stop() ends the channel.
+ */
+function openCliChannel() {
+    if (DAEMON_SOCKET) {
+        const socket = net.createConnection(DAEMON_SOCKET);
+        return {
+            label: `daemon ${DAEMON_SOCKET}`,
+            input: socket,
+            output: socket,
+            errors: null,
+            events: socket,
+            stop: () => socket.destroy()
+        };
+    }
+    const proc = spawn(CLI_PATH, [], {
+        cwd: path.join(__dirname, '../dase_cli'),
+        stdio: ['pipe', 'pipe', 'pipe']
+    });
+    return {
+        label: `PID ${proc.pid}`,
+        input: proc.stdin,
+        output: proc.stdout,
+        errors: proc.stderr,
+        events: proc,
+        stop: (signal) => proc.kill(signal)
+    };
+}
+
+/**
+ * Run one command on the daemon and pass its response (or an error) to done
+ */
+function daemonRequest(command, done) {
+    const socket = net.createConnection(DAEMON_SOCKET);
+    let buffer = '';
+    let finished = false;
+    const finish = (err, response) => {
+        if (finished) return;
+        finished = true;
+        socket.destroy();
+        done(err, response);
+    };
+    socket.on('connect', () => socket.write(JSON.stringify(command) + '\n'));
+    socket.on('data', (data) => {
+        buffer += data.toString();
+        const newline = buffer.indexOf('\n');
+        if (newline < 0) return;
+        try {
+            finish(null, JSON.parse(buffer.substring(0, newline)));
+        } catch (err) {
+            finish(err);
+        }
+    });
+    socket.on('error', (err) => finish(err));
+    socket.on('close', () => finish(new Error('daemon closed the connection')));
+}
+
 // Track active process count (Fix C7.1)
 let activeProcessCount = 0;
 
@@ -82,17 +154,33 @@ app.get('/api/engines', authenticateRequest, (req, res) => {
 // GET /api/engines/:name - Get detailed description of an engine
 app.get('/api/engines/:name', authenticateRequest, (req, res) => {
     const engineName = req.params.name;
-    const cliPath = path.join(__dirname, '../dase_cli/dase_cli.exe');
 
-    if (!fs.existsSync(cliPath)) {
+    if (DAEMON_SOCKET) {
+        daemonRequest({ command: 'describe_engine', params: { engine_name: engineName } }, (err, description) => {
+            if (err) {
+                return res.status(503).json({ error: 'DASE daemon unavailable', details: err.message });
+            }
+            if (description.status === 'success' && description.result) {
+                return res.json(description.result);
+            }
+            res.status(404).json({
+                error: 'Engine not found or description failed',
+                engine: engineName,
+                details: description.error
+            });
+        });
+        return;
+    }
+
+    if (!fs.existsSync(CLI_PATH)) {
         return res.status(500).json({
             error: 'DASE CLI executable not found',
-            path: cliPath
+            path: CLI_PATH
         });
     }
 
     // Call CLI with --describe flag
-    const proc = spawn(cliPath, ['--describe', engineName]);
+    const proc = spawn(CLI_PATH, ['--describe', engineName]);
 
     let output = '';
     let errorOutput = '';
@@ -348,11 +436,9 @@ wss.on('connection', (ws, req) => {
     activeProcessCount++;
     console.log(`Authenticated client connected (${activeProcessCount}/${MAX_PROCESSES} active)`);
 
-    // Spawn DASE CLI process for this client
-    const cliPath = path.join(__dirname, '../dase_cli/dase_cli.exe');
-
-    if (!fs.existsSync(cliPath)) {
-        console.error(`DASE CLI not found at: ${cliPath}`);
+    // Connect this client to the daemon, or spawn a DASE CLI process for it
+    if (!DAEMON_SOCKET && !fs.existsSync(CLI_PATH)) {
+        console.error(`DASE CLI not found at: ${CLI_PATH}`);
         ws.send(JSON.stringify({
             status: 'error',
             error: 'DASE CLI executable not found',
@@ -362,17 +448,14 @@ wss.on('connection', (ws, req) => {
         return;
     }
 
-    const daseProcess = spawn(cliPath, [], {
-        cwd: path.join(__dirname, '../dase_cli'),
-        stdio: ['pipe', 'pipe', 'pipe']
-    });
+    const daseProcess = openCliChannel();
 
-    console.log(`Spawned DASE CLI process (PID: ${daseProcess.pid})`);
+    console.log(`Opened DASE CLI channel (${daseProcess.label})`);
 
     // FIX C7.1: Add idle timeout
     let idleTimer = setTimeout(() => {
         console.log('Killing idle process (timeout reached)');
-        daseProcess.kill('SIGTERM');
+        daseProcess.stop('SIGTERM');
         ws.close(1000, 'Idle timeout');
     }, IDLE_TIMEOUT_MS);
 
@@ -385,7 +468,7 @@ wss.on('connection', (ws, req) => {
     });
 
     // Handle stdout from CLI (JSON responses)
-    daseProcess.stdout.on('data', (data) => {
+    daseProcess.output.on('data', (data) => {
         const client = clients.get(ws);
         if (!client) return;
 
@@ -395,7 +478,7 @@ wss.on('connection', (ws, req) => {
         // FIX H7.2: Check buffer size to prevent overflow
         if (client.buffer.length > MAX_BUFFER_SIZE) {
             console.error(`Buffer overflow detected (${client.buffer.length} bytes), killing process`);
-            daseProcess.kill('SIGKILL');
+            daseProcess.stop('SIGKILL');
             ws.send(JSON.stringify({
                 status: 'error',
                 error: `Response too large (exceeded ${MAX_BUFFER_SIZE} bytes)`,
@@ -413,6 +496,36 @@ wss.on('connection', (ws, req) => {
             line = line.trim();
             if (!line) return;
 
+            // Batched METRICS:[...] output (dase::MetricStream): forward the
+            // latest sample of each metric as a regular metrics:update
+            if (line.startsWith('METRICS:')) {
+                const batchJson = line.substring(8); // Remove "METRICS:" prefix
+                try {
+                    const batch = JSON.parse(batchJson);
+                    const latest = new Map();
+                    batch.forEach(metric => latest.set(metric.name, metric));
+
+                    latest.forEach(metric => {
+                        const metricMessage = JSON.stringify({
+                            type: 'metrics:update',
+                            data: metric
+                        });
+
+                        if (ws.readyState === WebSocket.OPEN) {
+                            ws.send(metricMessage);
+                        }
+                        gridClients.forEach((gridWs) => {
+                            if (gridWs.readyState === WebSocket.OPEN) {
+                                gridWs.send(metricMessage);
+                            }
+                        });
+                    });
+                } catch (err) {
+                    console.error('Failed to parse metric batch:', err.message);
+                }
+                return; // Don't process as regular JSON
+            }
+
             // Check for METRIC output
             if (line.startsWith('METRIC:')) {
                 const metricJson = line.substring(7); // Remove "METRIC:" prefix
@@ -458,8 +571,8 @@ wss.on('connection', (ws, req) => {
         });
     });
 
-    // Handle stderr from CLI (errors and debug output)
-    daseProcess.stderr.on('data', (data) => {
+    // Handle stderr from CLI (errors and debug output; the daemon keeps its own)
+    if (daseProcess.errors) daseProcess.errors.on('data', (data) => {
         const errorMsg = data.toString();
         console.error('CLI Error:', errorMsg);
 
@@ -479,15 +592,27 @@ wss.on('connection', (ws, req) => {
         }
     });
 
-    // Handle CLI process exit
-    daseProcess.on('close', (code) => {
-        console.log(`CLI process exited with code ${code}`);
+    // Handle CLI process exit (or the daemon closing the connection)
+    daseProcess.events.on('close', (code) => {
+        console.log(`CLI channel closed (${daseProcess.label}, ${code})`);
         if (ws.readyState === WebSocket.OPEN) {
             ws.send(JSON.stringify({
                 status: 'error',
                 error: 'CLI process terminated',
                 error_code: 'CLI_EXITED',
-                exit_code: code
+                exit_code: DAEMON_SOCKET ? null : code
+            }));
+        }
+    });
+
+    // A refused or lost daemon connection (closed right after)
+    daseProcess.events.on('error', (err) => {
+        console.error(`CLI channel error (${daseProcess.label}):`, err.message);
+        if (ws.readyState === WebSocket.OPEN) {
+            ws.send(JSON.stringify({
+                status: 'error',
+                error: `DASE CLI unavailable: ${err.message}`,
+                error_code: 'CLI_UNAVAILABLE'
             }));
         }
     });
@@ -500,7 +625,7 @@ wss.on('connection', (ws, req) => {
             clearTimeout(client.idleTimer);
             client.idleTimer = setTimeout(() => {
                 console.log('Killing idle process (timeout reached)');
-                daseProcess.kill('SIGTERM');
+                daseProcess.stop('SIGTERM');
                 ws.close(1000, 'Idle timeout');
             }, IDLE_TIMEOUT_MS);
         }
@@ -521,7 +646,7 @@ wss.on('connection', (ws, req) => {
 
             // Send command to CLI
             const jsonLine = JSON.stringify(command) + '\n';
-            daseProcess.stdin.write(jsonLine);
+            daseProcess.input.write(jsonLine);
             console.log('Sent to CLI:', jsonLine.trim());
 
         } catch (err) {
@@ -546,7 +671,7 @@ wss.on('connection', (ws, req) => {
             // Terminate CLI process
             if (client.process) {
                 console.log('Terminating CLI process');
-                client.process.kill();
+                client.process.stop();
             }
         }
         clients.delete(ws);
@@ -562,7 +687,7 @@ wss.on('connection', (ws, req) => {
     ws.send(JSON.stringify({
         status: 'connected',
         message: 'Connected to DASE CLI backend',
-        pid: daseProcess.pid
+        pid: daseProcess.events.pid || null
     }));
 });
 
@@ -573,7 +698,7 @@ process.on('SIGINT', () => {
     // Kill all CLI processes
     clients.forEach((client, ws) => {
         if (client.process) {
-            client.process.kill();
+            client.process.stop();
         }
         ws.close();
     });
@@ -589,5 +714,5 @@ console.log('  DASE Analog Excel Backend Server');
 console.log('==============================================');
 console.log(`  HTTP:       http://localhost:${PORT}`);
 console.log(`  WebSocket:  ws://localhost:${WS_PORT}`);
-console.log(`  CLI Path:   ../dase_cli/dase_cli.exe`);
+console.log(DAEMON_SOCKET ? `  CLI Daemon: ${DAEMON_SOCKET}` : `  CLI Path:   ../dase_cli/dase_cli.exe`);
 console.log('==============================================\n');
@@ -0,0 +1,733 @@
+/**
+ * DASE Benchmark Harness
+ *
+ * A small Google-Benchmark-style runner for dase_bench (no external
+ * dependency). Each benchmark is a factory that builds its engine for one
+ * parameter set and returns the step to time along with the site updates
+ * that step performs. The runner repeats each case over a thread-count
+ * axis:
+ *
+ *   1. One warm-up call, which builds plans and stencils.
+ *   2. Calibration to --min-time.
+ *   3. --repetitions timed runs, reporting the median and the minimum.
+ *
+ * Results are ns per call and ns per site update, written as a table and
+ * optionally as JSON. The JSON holds hardware and build metadata and one
+ * benchmark object per line. A previous JSON file can be passed as
+ * --baseline to flag regressions in ns/site-update.
+ *
+ * --perf adds one more repetition under hardware counters (perf_counters.h)
+ * and reports cycles, instructions, LLC misses and vector FP instructions
+ * per site update, with IPC and estimated DRAM bandwidth. Events the host
+ * does not expose are written as null.
+ *
+ * --scaling replaces the case list with a sweep for every group that has a
+ * ScalingSpec (see Runner::runScaling): thread counts × pinning × working
+ * sets sized to the L1/L2/L3/DRAM regimes of the host, in strong and weak
+ * form. It reports parallel efficiency, site updates/s and the implied
+ * state bandwidth as a table, --csv and --json.
+ *
+ * Engine progress output written to std::cout during a case is discarded.
+ * A case whose factory or step throws is reported as skipped.
+ */
+
+#pragma once
+
+#include "../../src/cpp/cpu_dispatch.h"
+#include "../../src/cpp/numa_memory.h"
+#include "../../src/cpp/perf_counters.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#ifndef DASE_BENCH_GIT_COMMIT
+#define DASE_BENCH_GIT_COMMIT "unknown"
+#endif
+#ifndef DASE_BENCH_BUILD_TYPE
+#define DASE_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace dase {
+namespace bench {
+
+// Ordered parameter set of one case ("n" -> 128, "R_c" -> 2, ...)
+using Params = std::vector<std::pair<std::string, double>>;
+
+inline double param(const Params& params, const std::string& name, double fallback = 0.0) {
+    for (const auto& p : params) {
+        if (p.first == name) return p.second;
+    }
+    return fallback;
+}
+
+// The timed step of one case
+struct Body {
+    std::function<void()> step;
+    double site_updates = 0.0;  // Site (node, grid point, sample) updates per step() call
+};
+
+using Factory = std::function<Body(const Params&)>;
+
+// How --scaling sizes a group: the size parameter is chosen so that the
+// state (bytes_per_site per site) fills a cache regime
+struct ScalingSpec {
+    std::string size_param = "n";  // Edge of an n^dims lattice (node count for dims = 1)
+    int dims = 1;
+    double bytes_per_site = 0.0;   // State streamed per site update; 0: not swept
+    Params fixed;                  // Remaining parameters, e.g. {"R_c", 1}
+};
+
+struct Benchmark {
+    std::string group;            // Engine / pipeline piece, e.g. "igsoa_2d"
+    std::vector<Params> cases;    // One entry per parameter set
+    Factory make;
+    ScalingSpec scaling;
+};
+
+// Problem-size preset chosen with --size
+enum class Scale { Small = 0, Default = 1, Large = 2 };
+
+template <typename T>
+T pick(Scale scale, T small, T normal, T large) {
+    return scale == Scale::Small ? small : (scale == Scale::Large ? large : normal);
+}
+
+struct Result {
+    std::string name;             // group/param=value/.../threads=T
+    std::string group;
+    Params params;
+    int threads = 1;
+    uint64_t iterations = 0;      // step() calls per repetition
+    double ns_per_call = 0.0;     // Median over repetitions
+    double min_ns_per_call = 0.0;
+    double ns_per_site_update = 0.0;
+    PerfCounterSample perf;       // --perf: counts over one extra repetition
+    double perf_site_updates = 0.0;
+};
+
+// One measurement of a --scaling sweep
+struct ScalingPoint {
+    std::string group;
+    std::string regime;           // "L1", "L2", "L3" or "DRAM"
+    std::string pinning;          // "compact" or "spread"
+    std::string mode;             // "strong" (fixed size) or "weak" (size × threads)
+    int threads = 1;
+    double size = 0.0;            // Value of the group's size parameter
+    double sites = 0.0;
+    double working_set_bytes = 0.0;
+    double ns_per_site_update = 0.0;
+    double site_updates_per_s = 0.0;
+    double gb_per_s = 0.0;        // bytes_per_site × site updates/s
+    double speedup = 0.0;         // Throughput relative to the first thread count
+    double efficiency = 0.0;      // speedup / (threads / first thread count)
+};
+
+// Data cache sizes in bytes (typical values where the host doesn't say)
+struct CacheSizes {
+    double l1 = 32.0 * 1024;
+    double l2 = 1024.0 * 1024;
+    double l3 = 32.0 * 1024 * 1024;
+};
+
+struct Options {
+    std::string filter;           // Substring of the case name
+    std::vector<int> threads;     // Empty: OpenMP default only
+    Scale scale = Scale::Default;
+    double min_time = 0.2;        // Seconds per repetition
+    int repetitions = 3;
+    std::string json_path;
+    std::string baseline_path;
+    double tolerance = 0.10;      // Allowed ns/site-update growth vs baseline
+    bool perf = false;            // Collect hardware counters
+    bool scaling = false;         // Run the scaling sweep instead of the cases
+    std::vector<ThreadPinning> pinnings = {ThreadPinning::Compact, ThreadPinning::Spread};
+    std::string csv_path;         // Scaling points as CSV
+};
+
+// Swallows engine banners while a case runs
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+};
+
+inline std::string formatNumber(double v) {
+    std::ostringstream out;
+    out << std::setprecision(6) << v;
+    return out.str();
+}
+
+inline std::string caseName(const std::string& group, const Params& params, int threads) {
+    std::string name = group;
+    for (const auto& p : params) name += "/" + p.first + "=" + formatNumber(p.second);
+    return name + "/threads=" + std::to_string(threads);
+}
+
+inline std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+inline std::string cpuModel() {
+#if defined(__linux__)
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            const size_t colon = line.find(':');
+            if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+    }
+#endif
+#if DASE_SIMD_DISPATCH
+    unsigned regs[12];
+    cpu_dispatch_detail::cpuid(0x80000000u, 0, regs);
+    if (regs[0] >= 0x80000004u) {
+        for (unsigned leaf = 0; leaf < 3; leaf++) {
+            cpu_dispatch_detail::cpuid(0x80000002u + leaf, 0, regs + 4 * leaf);
+        }
+        std::string brand(reinterpret_cast<const char*>(regs), sizeof(regs));
+        brand = brand.c_str();
+        const size_t first = brand.find_first_not_of(' ');
+        return first == std::string::npos ? "unknown" : brand.substr(first);
+    }
+#endif
+    return "unknown";
+}
+
+inline std::string hostName() {
+#ifdef _WIN32
+    const char* name = std::getenv("COMPUTERNAME");
+    return name ? name : "unknown";
+#else
+    char name[256] = {};
+    return gethostname(name, sizeof(name) - 1) == 0 ? name : "unknown";
+#endif
+}
+
+inline std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+inline CacheSizes cacheSizes() {
+    CacheSizes sizes;
+#if defined(__linux__)
+    auto level = [](int name, double& out) {
+        const long bytes = sysconf(name);
+        if (bytes > 0) out = static_cast<double>(bytes);
+    };
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    level(_SC_LEVEL1_DCACHE_SIZE, sizes.l1);
+    level(_SC_LEVEL2_CACHE_SIZE, sizes.l2);
+    level(_SC_LEVEL3_CACHE_SIZE, sizes.l3);
+#endif
+    // sysconf reports 0 on some kernels and containers
+    for (int index = 0; index < 8; index++) {
+        const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+        std::ifstream level_file(dir + "level"), type_file(dir + "type"), size_file(dir + "size");
+        int cache_level = 0;
+        std::string type, size;
+        if (!(level_file >> cache_level) || !(type_file >> type) || !(size_file >> size)) continue;
+        if (type == "Instruction") continue;
+        double bytes = std::atof(size.c_str());
+        if (size.back() == 'K') bytes *= 1024.0;
+        if (size.back() == 'M') bytes *= 1024.0 * 1024.0;
+        if (bytes <= 0.0) continue;
+        if (cache_level == 1) sizes.l1 = bytes;
+        if (cache_level == 2) sizes.l2 = bytes;
+        if (cache_level == 3) sizes.l3 = bytes;
+    }
+#endif
+    return sizes;
+}
+
+inline double physicalMemoryBytes() {
+#if defined(__linux__)
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long page = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page > 0) return static_cast<double>(pages) * static_cast<double>(page);
+#endif
+    return 16.0 * 1024 * 1024 * 1024;
+}
+
+inline int defaultThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+inline void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+inline std::string utcTimestamp() {
+    const std::time_t now = std::time(nullptr);
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &now);
+#else
+    gmtime_r(&now, &tm);
+#endif
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return text;
+}
+
+class Runner {
+public:
+    void add(const std::string& group, std::vector<Params> cases, Factory make, ScalingSpec scaling = {}) {
+        benchmarks.push_back({group, std::move(cases), std::move(make), std::move(scaling)});
+    }
+
+    std::vector<Result> run(const Options& options) {
+        std::vector<Result> results;
+        const std::vector<int> thread_counts = options.threads.empty()
+            ? std::vector<int>{defaultThreads()} : options.threads;
+        std::ostream report(std::cout.rdbuf());
+        report << std::left << std::setw(56) << "benchmark" << std::right << std::setw(12)
+               << "iters" << std::setw(16) << "ns/call" << std::setw(16) << "ns/site-upd" << std::endl;
+
+        for (const auto& benchmark : benchmarks) {
+            for (const auto& params : benchmark.cases) {
+                for (int threads : thread_counts) {
+                    const std::string name = caseName(benchmark.group, params, threads);
+                    if (!options.filter.empty() && name.find(options.filter) == std::string::npos) continue;
+                    setThreads(threads);
+                    Result result;
+                    try {
+                        result = measure(benchmark, params, options);
+                    } catch (const std::exception& e) {
+                        report << std::left << std::setw(56) << name << "  skipped: " << e.what() << std::endl;
+                        continue;
+                    }
+                    result.name = name;
+                    result.threads = threads;
+                    report << std::left << std::setw(56) << name << std::right << std::setw(12)
+                           << result.iterations << std::scientific << std::setprecision(3)
+                           << std::setw(16) << result.ns_per_call << std::setw(16)
+                           << result.ns_per_site_update << std::defaultfloat << std::endl;
+                    results.push_back(std::move(result));
+                }
+            }
+        }
+        setThreads(defaultThreads());
+        return results;
+    }
+
+    /**
+     * Thread and working-set sweep over every group with a ScalingSpec
+     *
+     * Each group runs at four working sets: half of L1, L2 and L3, and
+     * 4 × L3 (DRAM, capped at 1/16 of physical memory). For each, every
+     * thread count (--threads, default 1, 2, 4, … up to the OpenMP maximum)
+     * runs under each --pinning mode. Strong scaling keeps the working set.
+     * Weak scaling grows it with the thread count: from the regime size for
+     * the per-core L1/L2, and up to the regime size at the largest count for
+     * the shared L3/DRAM. Efficiency compares site updates/s with the first
+     * thread count.
+     */
+    std::vector<ScalingPoint> runScaling(const Options& options) {
+        std::vector<ScalingPoint> points;
+        const CacheSizes caches = cacheSizes();
+        const double dram = std::min(4.0 * caches.l3, physicalMemoryBytes() / 16.0);
+        struct Regime {
+            const char* name;
+            double bytes;
+            bool shared;
+        };
+        const Regime regimes[] = {
+            {"L1", 0.5 * caches.l1, false}, {"L2", 0.5 * caches.l2, false},
+            {"L3", 0.5 * caches.l3, true}, {"DRAM", std::max(dram, caches.l3), true},
+        };
+        std::vector<int> thread_counts = options.threads;
+        if (thread_counts.empty()) {
+            const int max_threads = defaultThreads();
+            for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+            thread_counts.push_back(max_threads);
+        }
+        const int max_count = *std::max_element(thread_counts.begin(), thread_counts.end());
+
+        std::ostream report(std::cout.rdbuf());
+        report << std::left << std::setw(16) << "group" << std::setw(7) << "cache" << std::setw(9) << "pinning"
+               << std::setw(8) << "mode" << std::right << std::setw(8) << "threads" << std::setw(12) << "sites"
+               << std::setw(14) << "ns/site-upd" << std::setw(10) << "GB/s" << std::setw(10) << "speedup"
+               << std::setw(8) << "eff" << std::endl;
+
+        for (const auto& benchmark : benchmarks) {
+            const ScalingSpec& spec = benchmark.scaling;
+            if (spec.bytes_per_site <= 0.0) continue;
+            if (!options.filter.empty() && benchmark.group.find(options.filter) == std::string::npos) continue;
+            for (const auto& regime : regimes) {
+                const double regime_sites = regime.bytes / spec.bytes_per_site;
+                for (ThreadPinning pinning : options.pinnings) {
+                    for (const char* mode : {"strong", "weak"}) {
+                        const bool weak = std::string(mode) == "weak";
+                        double reference = 0.0;
+                        int reference_threads = 0;
+                        for (int threads : thread_counts) {
+                            double sites = regime_sites;
+                            if (weak) {
+                                sites *= static_cast<double>(threads) / (regime.shared ? max_count : thread_counts.front());
+                            }
+                            const double size = scalingSize(spec, std::max(16.0, sites));
+                            Params params = spec.fixed;
+                            params.emplace_back(spec.size_param, size);
+
+                            setThreads(threads);
+                            pinThreads(pinning);
+                            Result result;
+                            try {
+                                result = measure(benchmark, params, options);
+                            } catch (const std::exception& e) {
+                                report << std::left << std::setw(16) << benchmark.group << "  skipped: "
+                                       << e.what() << std::endl;
+                                continue;
+                            }
+                            if (result.ns_per_site_update <= 0.0) continue;
+
+                            ScalingPoint point;
+                            point.group = benchmark.group;
+                            point.regime = regime.name;
+                            point.pinning = threadPinningName(pinning);
+                            point.mode = mode;
+                            point.threads = threads;
+                            point.size = size;
+                            point.sites = std::pow(size, spec.dims);
+                            point.working_set_bytes = point.sites * spec.bytes_per_site;
+                            point.ns_per_site_update = result.ns_per_site_update;
+                            point.site_updates_per_s = 1e9 / result.ns_per_site_update;
+                            point.gb_per_s = spec.bytes_per_site * point.site_updates_per_s * 1e-9;
+                            if (reference_threads == 0) {
+                                reference = point.site_updates_per_s;
+                                reference_threads = threads;
+                            }
+                            point.speedup = point.site_updates_per_s / reference;
+                            point.efficiency = point.speedup * reference_threads / threads;
+
+                            report << std::left << std::setw(16) << point.group << std::setw(7) << point.regime
+                                   << std::setw(9) << point.pinning << std::setw(8) << point.mode << std::right
+                                   << std::setw(8) << threads << std::setw(12) << static_cast<uint64_t>(point.sites) << std::fixed
+                                   << std::setprecision(3) << std::setw(14) << point.ns_per_site_update
+                                   << std::setprecision(2) << std::setw(10) << point.gb_per_s << std::setw(10)
+                                   << point.speedup << std::setw(8) << point.efficiency << std::defaultfloat
+                                   << std::endl;
+                            points.push_back(point);
+                        }
+                    }
+                }
+            }
+        }
+        setThreads(defaultThreads());
+        pinThreads(ThreadPinning::None);
+        return points;
+    }
+
+private:
+    std::vector<Benchmark> benchmarks;
+
+    // Size parameter whose n^dims lattice holds about `sites` sites
+    static double scalingSize(const ScalingSpec& spec, double sites) {
+        const double edge = std::round(std::pow(sites, 1.0 / std::max(1, spec.dims)));
+        return std::max(spec.dims == 1 ? 16.0 : 4.0, edge);
+    }
+
+    static Result measure(const Benchmark& benchmark, const Params& params, const Options& options) {
+        using clock = std::chrono::steady_clock;
+        NullBuffer null_buffer;
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+
+        Result result;
+        result.group = benchmark.group;
+        result.params = params;
+        try {
+            Body body = benchmark.make(params);
+            auto timeCalls = [&](uint64_t calls) {
+                const auto start = clock::now();
+                for (uint64_t i = 0; i < calls; i++) body.step();
+                return std::chrono::duration<double>(clock::now() - start).count();
+            };
+
+            // Warm-up, then grow the call count until one run reaches min_time
+            const double first = timeCalls(1);
+            uint64_t calls = 1;
+            double elapsed = first;
+            while (elapsed < options.min_time && calls < (1ull << 30)) {
+                const double per_call = std::max(elapsed / static_cast<double>(calls), 1e-9);
+                calls = std::max<uint64_t>(calls * 2, static_cast<uint64_t>(1.2 * options.min_time / per_call));
+                elapsed = timeCalls(calls);
+            }
+
+            std::vector<double> samples;
+            for (int r = 0; r < std::max(1, options.repetitions); r++) {
+                samples.push_back(timeCalls(calls) * 1e9 / static_cast<double>(calls));
+            }
+            std::sort(samples.begin(), samples.end());
+            result.iterations = calls;
+            result.ns_per_call = samples[samples.size() / 2];
+            result.min_ns_per_call = samples.front();
+            result.ns_per_site_update = body.site_updates > 0.0 ? result.ns_per_call / body.site_updates : 0.0;
+
+            if (options.perf) {
+                PerfCounters::Session session;
+                session.start();
+                for (uint64_t i = 0; i < calls; i++) body.step();
+                result.perf = session.stop();
+                result.perf_site_updates = body.site_updates * static_cast<double>(calls);
+            }
+        } catch (...) {
+            std::cout.rdbuf(saved);
+            throw;
+        }
+        std::cout.rdbuf(saved);
+        return result;
+    }
+};
+
+inline void writePerfJson(std::ostream& out, const Result& r) {
+    auto number = [&](double v) {
+        if (v >= 0.0) out << v; else out << "null";
+    };
+    auto perSite = [&](PerfEvent e) {
+        return r.perf.has(e) && r.perf_site_updates > 0.0
+            ? static_cast<double>(r.perf.value(e)) / r.perf_site_updates : -1.0;
+    };
+    out << ", \"perf\": {\"cycles_per_site_update\": ";
+    number(perSite(PerfEvent::Cycles));
+    out << ", \"instructions_per_site_update\": ";
+    number(perSite(PerfEvent::Instructions));
+    out << ", \"llc_misses_per_site_update\": ";
+    number(perSite(PerfEvent::LlcMisses));
+    out << ", \"fp_vector_instructions_per_site_update\": ";
+    number(perSite(PerfEvent::FpVectorInstructions));
+    out << ", \"ipc\": ";
+    number(r.perf.ipc());
+    out << ", \"dram_gb_per_s\": ";
+    number(r.perf.dramGBPerSecond());
+    out << ", \"average_parallelism\": ";
+    number(r.perf.averageParallelism());
+    out << "}";
+}
+
+inline void writeJson(std::ostream& out, const std::vector<Result>& results, const Options& options) {
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << utcTimestamp() << "\",\n"
+        << "    \"host\": \"" << jsonEscape(hostName()) << "\",\n"
+        << "    \"cpu_model\": \"" << jsonEscape(cpuModel()) << "\",\n"
+        << "    \"logical_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"simd_level\": \"" << simdLevelName(activeSimdLevel()) << "\",\n"
+        << "    \"compiled_simd_level\": \"" << simdLevelName(compiledSimdLevel()) << "\",\n"
+        << "    \"openmp_max_threads\": " << defaultThreads() << ",\n"
+        << "    \"compiler\": \"" << jsonEscape(compilerName()) << "\",\n"
+        << "    \"build_type\": \"" << DASE_BENCH_BUILD_TYPE << "\",\n"
+        << "    \"git_commit\": \"" << DASE_BENCH_GIT_COMMIT << "\",\n"
+        << "    \"min_time_s\": " << options.min_time << ",\n"
+        << "    \"repetitions\": " << options.repetitions << "\n"
+        << "  },\n  \"benchmarks\": [\n";
+    out << std::setprecision(9);
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"group\": \"" << r.group << "\", \"params\": {";
+        for (size_t p = 0; p < r.params.size(); p++) {
+            out << (p ? ", " : "") << "\"" << r.params[p].first << "\": " << r.params[p].second;
+        }
+        out << "}, \"threads\": " << r.threads << ", \"iterations\": " << r.iterations
+            << ", \"ns_per_call\": " << r.ns_per_call << ", \"min_ns_per_call\": " << r.min_ns_per_call
+            << ", \"ns_per_site_update\": " << r.ns_per_site_update;
+        if (options.perf) writePerfJson(out, r);
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+inline void writeScalingCsv(std::ostream& out, const std::vector<ScalingPoint>& points) {
+    out << "group,regime,pinning,mode,threads,size,sites,working_set_bytes,ns_per_site_update,"
+           "site_updates_per_s,gb_per_s,speedup,efficiency\n";
+    out << std::setprecision(9);
+    for (const ScalingPoint& p : points) {
+        out << p.group << ',' << p.regime << ',' << p.pinning << ',' << p.mode << ',' << p.threads << ','
+            << p.size << ',' << p.sites << ',' << p.working_set_bytes << ',' << p.ns_per_site_update << ','
+            << p.site_updates_per_s << ',' << p.gb_per_s << ',' << p.speedup << ',' << p.efficiency << '\n';
+    }
+}
+
+inline void writeScalingJson(std::ostream& out, const std::vector<ScalingPoint>& points, const Options& options) {
+    const CacheSizes caches = cacheSizes();
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << utcTimestamp() << "\",\n"
+        << "    \"host\": \"" << jsonEscape(hostName()) << "\",\n"
+        << "    \"cpu_model\": \"" << jsonEscape(cpuModel()) << "\",\n"
+        << "    \"logical_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"openmp_max_threads\": " << defaultThreads() << ",\n"
+        << "    \"l1_bytes\": " << caches.l1 << ", \"l2_bytes\": " << caches.l2
+        << ", \"l3_bytes\": " << caches.l3 << ",\n"
+        << "    \"compiler\": \"" << jsonEscape(compilerName()) << "\",\n"
+        << "    \"build_type\": \"" << DASE_BENCH_BUILD_TYPE << "\",\n"
+        << "    \"git_commit\": \"" << DASE_BENCH_GIT_COMMIT << "\",\n"
+        << "    \"min_time_s\": " << options.min_time << ",\n"
+        << "    \"repetitions\": " << options.repetitions << "\n"
+        << "  },\n  \"scaling\": [\n";
+    out << std::setprecision(9);
+    for (size_t i = 0; i < points.size(); i++) {
+        const ScalingPoint& p = points[i];
+        out << "    {\"group\": \"" << p.group << "\", \"regime\": \"" << p.regime << "\", \"pinning\": \""
+            << p.pinning << "\", \"mode\": \"" << p.mode << "\", \"threads\": " << p.threads
+            << ", \"size\": " << p.size << ", \"sites\": " << p.sites
+            << ", \"working_set_bytes\": " << p.working_set_bytes
+            << ", \"ns_per_site_update\": " << p.ns_per_site_update
+            << ", \"site_updates_per_s\": " << p.site_updates_per_s << ", \"gb_per_s\": " << p.gb_per_s
+            << ", \"speedup\": " << p.speedup << ", \"efficiency\": " << p.efficiency << "}"
+            << (i + 1 < points.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// name -> ns_per_site_update from a file written by writeJson (one
+// benchmark object per line)
+inline std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+    std::string line;
+    const std::string name_key = "{\"name\": \"";
+    const std::string value_key = "\"ns_per_site_update\": ";
+    while (std::getline(in, line)) {
+        const size_t name_at = line.find(name_key);
+        const size_t value_at = line.find(value_key);
+        if (name_at == std::string::npos || value_at == std::string::npos) continue;
+        const size_t begin = name_at + name_key.size();
+        const size_t end = line.find('"', begin);
+        if (end == std::string::npos) continue;
+        baseline[line.substr(begin, end - begin)] = std::atof(line.c_str() + value_at + value_key.size());
+    }
+    return baseline;
+}
+
+// Print the change per case; returns the number of regressions
+inline int compareBaseline(const std::vector<Result>& results,
+                           const std::map<std::string, double>& baseline,
+                           double tolerance) {
+    int regressions = 0;
+    std::cout << "\n" << std::left << std::setw(56) << "benchmark (vs baseline)" << std::right
+              << std::setw(12) << "change" << std::endl;
+    for (const Result& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0.0 || r.ns_per_site_update <= 0.0) continue;
+        const double change = r.ns_per_site_update / it->second - 1.0;
+        const bool regressed = change > tolerance;
+        regressions += regressed ? 1 : 0;
+        std::cout << std::left << std::setw(56) << r.name << std::right << std::setw(11)
+                  << std::fixed << std::setprecision(1) << 100.0 * change << "%"
+                  << (regressed ? "  REGRESSION" : "") << std::defaultfloat << std::endl;
+    }
+    return regressions;
+}
+
+inline std::vector<int> parseList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+    }
+    return values;
+}
+
+// --filter=S --threads=1,2,4 --size=small|default|large --min-time=S
+// --repetitions=N --json=PATH --baseline=PATH --tolerance=F --perf
+// --scaling --pinning=compact,spread --csv=PATH
+inline bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--filter") {
+            options.filter = value;
+        } else if (key == "--threads") {
+            options.threads = parseList(value);
+        } else if (key == "--size") {
+            if (value == "small") options.scale = Scale::Small;
+            else if (value == "large") options.scale = Scale::Large;
+            else if (value == "default") options.scale = Scale::Default;
+            else return false;
+        } else if (key == "--min-time") {
+            options.min_time = std::atof(value.c_str());
+        } else if (key == "--repetitions") {
+            options.repetitions = std::atoi(value.c_str());
+        } else if (key == "--json") {
+            options.json_path = value;
+        } else if (key == "--baseline") {
+            options.baseline_path = value;
+        } else if (key == "--tolerance") {
+            options.tolerance = std::atof(value.c_str());
+        } else if (key == "--perf") {
+            options.perf = true;
+        } else if (key == "--scaling") {
+            options.scaling = true;
+        } else if (key == "--pinning") {
+            options.pinnings.clear();
+            std::stringstream in(value);
+            std::string name;
+            while (std::getline(in, name, ',')) {
+                ThreadPinning mode;
+                if (name == "scatter") name = "spread";
+                if (!parseThreadPinning(name, mode)) return false;
+                options.pinnings.push_back(mode);
+            }
+            if (options.pinnings.empty()) return false;
+        } else if (key == "--csv") {
+            options.csv_path = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace bench
+} // namespace dase
@@ -0,0 +1,115 @@
+/**
+ * IGSOA Fixed-Radius Stencil Kernels Benchmark
+ *
+ * Times the Ψ coupling sweep of a 2D (512×512) and a 3D (64³) lattice for
+ * R_c = 1..5, once through the generic CouplingStencil sweep and once
+ * through the compile-time kernel for that radius, and reports node updates
+ * per second, the speedup and the largest |Ψ| difference of the two runs.
+ *
+ * Usage: benchmark_igsoa_fixed_radius [steps]   (default 10)
+ */
+
+#include "../../src/cpp/igsoa_physics_soa.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace dase::igsoa;
+
+namespace {
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+void seedLattice(IGSOALatticeSoA& lattice) {
+    for (size_t i = 0; i < lattice.size(); i++) {
+        lattice.psi_re[i] = 0.1 * std::sin(0.01 * i);
+        lattice.psi_im[i] = 0.1 * std::cos(0.013 * i);
+        lattice.phi[i] = 0.05 * std::cos(0.007 * i);
+        lattice.kappa[i] = 1.0;
+        lattice.gamma[i] = 0.1;
+    }
+}
+
+double maxPsiDifference(const IGSOALatticeSoA& a, const IGSOALatticeSoA& b) {
+    double max_diff = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        max_diff = std::max(max_diff, std::abs(a.psi_re[i] - b.psi_re[i]));
+        max_diff = std::max(max_diff, std::abs(a.psi_im[i] - b.psi_im[i]));
+    }
+    return max_diff;
+}
+
+void report(const char* shape, int R, size_t nodes, uint64_t steps,
+            double generic_time, double fixed_time, double diff) {
+    const double updates = static_cast<double>(steps) * static_cast<double>(nodes);
+    std::cout << std::setw(6) << shape << std::setw(5) << R
+              << std::scientific << std::setprecision(3)
+              << std::setw(15) << updates / generic_time
+              << std::setw(15) << updates / fixed_time
+              << std::fixed << std::setprecision(2)
+              << std::setw(9) << generic_time / fixed_time << "x"
+              << std::scientific << std::setprecision(1)
+              << std::setw(11) << diff << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint64_t steps = (argc > 1) ? static_cast<uint64_t>(std::atoi(argv[1])) : 10;
+    const double dt = 0.01;
+
+    std::cout << "=== IGSOA Fixed-Radius Kernels (" << steps << " steps) ===" << std::endl;
+    std::cout << std::setw(6) << "shape" << std::setw(5) << "R" << std::setw(15) << "generic/s"
+              << std::setw(15) << "fixed/s" << std::setw(10) << "speedup" << std::setw(11)
+              << "max |dΨ|" << std::endl;
+
+    const size_t N_2d = 512;
+    for (int R = 1; R <= kFixedStencilMaxRadius; R++) {
+        IGSOALatticeSoA generic(N_2d * N_2d);
+        seedLattice(generic);
+        IGSOALatticeSoA fixed = generic;
+        CouplingStencil2D stencil;
+        stencil.build(R, N_2d, N_2d);
+        const auto kernel = IGSOAPhysicsSoA::fixedKernel2D<double>(R);
+
+        const double generic_time = seconds([&]() {
+            for (uint64_t s = 0; s < steps; s++) {
+                IGSOAPhysicsSoA::evolveQuantumState2D(generic, stencil, dt, N_2d, N_2d);
+            }
+        });
+        const double fixed_time = seconds([&]() {
+            for (uint64_t s = 0; s < steps; s++) kernel(fixed, dt, N_2d, N_2d, 0, N_2d, 1.0);
+        });
+        report("2D", R, generic.size(), steps, generic_time, fixed_time, maxPsiDifference(generic, fixed));
+    }
+
+    const size_t N_3d = 64;
+    for (int R = 1; R <= kFixedStencilMaxRadius; R++) {
+        IGSOALatticeSoA generic(N_3d * N_3d * N_3d);
+        seedLattice(generic);
+        IGSOALatticeSoA fixed = generic;
+        CouplingStencil3D stencil;
+        stencil.build(R, N_3d, N_3d, N_3d);
+        const auto kernel = IGSOAPhysicsSoA::fixedKernel3D<double>(R);
+
+        const double generic_time = seconds([&]() {
+            for (uint64_t s = 0; s < steps; s++) {
+                IGSOAPhysicsSoA::evolveQuantumState3D(generic, stencil, dt, N_3d, N_3d, N_3d);
+            }
+        });
+        const double fixed_time = seconds([&]() {
+            for (uint64_t s = 0; s < steps; s++) kernel(fixed, dt, N_3d, N_3d, N_3d, 0, N_3d, 1.0);
+        });
+        report("3D", R, generic.size(), steps, generic_time, fixed_time, maxPsiDifference(generic, fixed));
+    }
+    return 0;
+}
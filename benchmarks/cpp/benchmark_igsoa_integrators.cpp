@@ -0,0 +1,120 @@
+/**
+ * IGSOA Integrator Benchmark - Wall Time to a Given Ψ Error
+ *
+ * For Euler and RK4, finds the largest dt (on a ladder of 2^(-1/4) steps
+ * down from 1) whose 2D run to t_end stays within the error bound: the
+ * max |ΔΨ| against an RK4 reference run at dt = 1e-3. It then reports the
+ * wall time of that run, so the comparison is time-to-solution at matched
+ * accuracy rather than time per step.
+ *
+ * Usage: benchmark_igsoa_integrators [error_bound] [size] [t_end] [R_c]
+ *        (defaults 1e-4, 64, 1, 2)
+ */
+
+#include "../../src/cpp/igsoa_complex_engine_2d.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace dase::igsoa;
+
+namespace {
+
+struct Run {
+    double dt = 0.0;
+    uint64_t steps = 0;
+    double error = 0.0;
+    double seconds = 0.0;
+    IGSOALatticeSoA state;
+};
+
+// Smooth Ψ / Φ (dominated by long wavelengths)
+void seedState(IGSOAComplexEngine2D& engine, size_t n) {
+    IGSOALatticeSoA state(n * n);
+    for (size_t y = 0; y < n; y++) {
+        for (size_t x = 0; x < n; x++) {
+            const double u = 2.0 * M_PI * static_cast<double>(x) / static_cast<double>(n);
+            const double v = 2.0 * M_PI * static_cast<double>(y) / static_cast<double>(n);
+            const size_t i = y * n + x;
+            state.psi_re[i] = 0.5 * std::sin(u) * std::cos(v) + 0.2;
+            state.psi_im[i] = 0.3 * std::cos(2.0 * u + v);
+            state.phi[i] = 0.05 * std::sin(v);
+        }
+    }
+    engine.setPsiRange(0, state.size(), state.psi_re.data(), state.psi_im.data());
+    engine.setPhiRange(0, state.size(), state.phi.data());
+}
+
+Run runTo(IGSOAIntegrator integrator, size_t n, double R_c, double dt, double t_end) {
+    // dt shortened to land on t_end
+    Run run;
+    run.steps = static_cast<uint64_t>(std::ceil(t_end / dt - 1e-9));
+    run.dt = t_end / static_cast<double>(run.steps);
+
+    IGSOAComplexConfig config;
+    config.R_c_default = R_c;
+    config.dt = run.dt;
+    config.normalize_psi = false;
+    config.integrator = integrator;
+    IGSOAComplexEngine2D engine(config, n, n);
+    seedState(engine, n);
+
+    const auto start = std::chrono::steady_clock::now();
+    engine.runMission(run.steps);
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    run.state = engine.getLattice();
+    return run;
+}
+
+double maxError(const IGSOALatticeSoA& state, const IGSOALatticeSoA& reference) {
+    double error = 0.0;
+    for (size_t i = 0; i < state.size(); i++) {
+        const double d = std::max(std::abs(state.psi_re[i] - reference.psi_re[i]),
+                                  std::abs(state.psi_im[i] - reference.psi_im[i]));
+        if (!(d <= error)) error = d;   // NaN of an unstable run wins
+    }
+    return error;
+}
+
+// Largest ladder dt within the error bound
+Run bestRun(IGSOAIntegrator integrator, size_t n, double R_c, double bound, double t_end,
+            const IGSOALatticeSoA& reference) {
+    Run run;
+    for (int k = 0; k < 64; k++) {
+        run = runTo(integrator, n, R_c, std::pow(2.0, -0.25 * k), t_end);
+        run.error = maxError(run.state, reference);
+        if (run.error <= bound) break;
+    }
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double bound = (argc > 1) ? std::atof(argv[1]) : 1e-4;
+    const size_t n = (argc > 2) ? static_cast<size_t>(std::atoi(argv[2])) : 64;
+    const double t_end = (argc > 3) ? std::atof(argv[3]) : 1.0;
+    const double R_c = (argc > 4) ? std::atof(argv[4]) : 2.0;
+
+    std::cout << "=== IGSOA Integrators: " << n << "^2, R_c = " << R_c << " to t = " << t_end
+              << ", max |dPsi| <= " << bound << " ===" << std::endl;
+    const IGSOALatticeSoA reference = runTo(IGSOAIntegrator::RK4, n, R_c, 1e-3, t_end).state;
+
+    std::cout << std::setw(10) << "scheme" << std::setw(12) << "dt" << std::setw(10) << "steps"
+              << std::setw(12) << "error" << std::setw(12) << "wall_s" << std::endl;
+    const Run euler = bestRun(IGSOAIntegrator::Euler, n, R_c, bound, t_end, reference);
+    const Run rk4 = bestRun(IGSOAIntegrator::RK4, n, R_c, bound, t_end, reference);
+    for (const Run* row : {&euler, &rk4}) {
+        std::cout << std::setw(10) << (row == &rk4 ? "rk4" : "euler") << std::scientific << std::setprecision(3)
+                  << std::setw(12) << row->dt << std::setw(10) << row->steps
+                  << std::setw(12) << row->error << std::fixed << std::setprecision(4)
+                  << std::setw(12) << row->seconds << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "dt ratio " << rk4.dt / euler.dt << "x, wall-time speedup "
+              << euler.seconds / rk4.seconds << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * IGSOA MPI Slab Decomposition Scaling Benchmark
+ *
+ * Strong scaling: fixed global torus on P = 1, 2, 4, ... ranks.
+ * Weak scaling:   fixed slab per rank, global torus grows with P.
+ *
+ * Each row reports the wall time per step (slowest rank), speedup and
+ * parallel efficiency against P = 1, and the mean share of the step spent
+ * blocked on the halo after the interior sweep (a measure of how much of
+ * the exchange the overlap hides).
+ *
+ * Usage: mpirun -np 8 benchmark_igsoa_mpi_scaling [2d|3d] [size] [R_c]
+ *        (defaults: 2d, 512 for 2D / 64 for 3D, R_c 3)
+ */
+
+#include "../../src/cpp/igsoa_distributed_engine.h"
+#include <mpi.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace dase::igsoa;
+
+namespace {
+
+struct Sample {
+    double seconds_per_step = 0.0;  // Slowest rank
+    double wait_fraction = 0.0;     // Mean over ranks
+};
+
+template <typename Engine>
+void seed(Engine& engine) {
+    IGSOALatticeSoA& lattice = engine.localLattice();
+    for (size_t i = 0; i < lattice.size(); i++) {
+        lattice.psi_re[i] = std::sin(0.37 * static_cast<double>(i));
+        lattice.psi_im[i] = std::cos(0.11 * static_cast<double>(i));
+    }
+}
+
+// Time `steps` steps (after one warm-up step) on communicator comm
+template <typename Engine>
+Sample measure(Engine& engine, MPI_Comm comm, uint64_t steps) {
+    seed(engine);
+    engine.runMission(1);
+    const DistributedStepTimings before = engine.getTimings();
+
+    MPI_Barrier(comm);
+    const double start = MPI_Wtime();
+    engine.runMission(steps);
+    const double local = MPI_Wtime() - start;
+
+    const DistributedStepTimings& after = engine.getTimings();
+    const double wait = (after.halo_wait_seconds - before.halo_wait_seconds) / local;
+
+    Sample sample;
+    int P = 1;
+    MPI_Comm_size(comm, &P);
+    MPI_Allreduce(&local, &sample.seconds_per_step, 1, MPI_DOUBLE, MPI_MAX, comm);
+    MPI_Allreduce(&wait, &sample.wait_fraction, 1, MPI_DOUBLE, MPI_SUM, comm);
+    sample.seconds_per_step /= static_cast<double>(steps);
+    sample.wait_fraction /= P;
+    return sample;
+}
+
+Sample run(bool three_d, MPI_Comm comm, const IGSOAComplexConfig& config, size_t n, size_t slabs,
+           uint64_t steps) {
+    if (three_d) {
+        IGSOADistributedEngine3D engine(config, comm, n, n, slabs);
+        return measure(engine, comm, steps);
+    }
+    IGSOADistributedEngine2D engine(config, comm, n, slabs);
+    return measure(engine, comm, steps);
+}
+
+void printRow(const char* mode, int P, const std::string& global, const Sample& sample,
+              double baseline, bool weak) {
+    // Weak scaling: efficiency T(1) / T(P) at constant work per rank, scaled speedup P times that
+    const double speedup = baseline / sample.seconds_per_step;
+    const double efficiency = weak ? speedup : speedup / P;
+    std::cout << std::setw(8) << mode << std::setw(6) << P << std::setw(17) << global
+              << std::fixed << std::setprecision(3) << std::setw(12) << sample.seconds_per_step * 1e3
+              << std::setw(10) << (weak ? speedup * P : speedup) << std::setw(10) << efficiency * 100.0 << "%"
+              << std::setw(10) << sample.wait_fraction * 100.0 << "%" << std::endl;
+}
+
+std::string globalDims(bool three_d, size_t n, size_t slabs) {
+    const std::string prefix = std::to_string(n) + "x" + (three_d ? std::to_string(n) + "x" : "");
+    return prefix + std::to_string(slabs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int world_rank = 0, world_size = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+
+    const bool three_d = (argc > 1) && std::strcmp(argv[1], "3d") == 0;
+    const size_t n = (argc > 2) ? static_cast<size_t>(std::atoi(argv[2])) : (three_d ? 64 : 512);
+    IGSOAComplexConfig config;
+    config.R_c_default = (argc > 3) ? std::atof(argv[3]) : 3.0;
+
+    // ~20M node updates per measurement of the full torus
+    const size_t nodes = three_d ? n * n * n : n * n;
+    const uint64_t steps = std::max<uint64_t>(3, (20u << 20) / nodes);
+    const size_t weak_slabs = std::max<size_t>(n / static_cast<size_t>(world_size),
+                                              static_cast<size_t>(std::ceil(config.R_c_default)));
+
+    if (world_rank == 0) {
+        std::cout << "=== IGSOA MPI Slab Scaling (" << (three_d ? "3D" : "2D") << ", R_c "
+                  << config.R_c_default << ", " << steps << " steps) ===" << std::endl;
+        std::cout << std::setw(8) << "mode" << std::setw(6) << "P" << std::setw(17) << "global"
+                  << std::setw(12) << "ms/step" << std::setw(10) << "speedup"
+                  << std::setw(11) << "eff" << std::setw(11) << "halo wait" << std::endl;
+    }
+
+    double strong_base = 0.0, weak_base = 0.0;
+    for (int P = 1; P <= world_size; P *= 2) {
+        MPI_Comm comm;
+        MPI_Comm_split(MPI_COMM_WORLD, world_rank < P ? 0 : MPI_UNDEFINED, world_rank, &comm);
+        if (comm != MPI_COMM_NULL) {
+            const Sample strong = run(three_d, comm, config, n, n, steps);
+            const size_t weak_total = weak_slabs * static_cast<size_t>(P);
+            const Sample weak = run(three_d, comm, config, n, weak_total, steps);
+            if (P == 1) {
+                strong_base = strong.seconds_per_step;
+                weak_base = weak.seconds_per_step;
+            }
+            if (world_rank == 0) {
+                printRow("strong", P, globalDims(three_d, n, n), strong, strong_base, false);
+                printRow("weak", P, globalDims(three_d, n, weak_total), weak, weak_base, true);
+            }
+            MPI_Comm_free(&comm);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    MPI_Finalize();
+    return 0;
+}
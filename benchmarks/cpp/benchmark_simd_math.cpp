@@ -0,0 +1,119 @@
+/**
+ * SIMD Math Benchmark
+ *
+ * Times expArray, sinCosArray and atan2Array (simd_math.h) on 4096-value
+ * arrays at every SIMD level the CPU supports, and reports ns per value,
+ * the speedup over the scalar level (plain libm calls) and the largest ULP
+ * difference from it.
+ *
+ * Usage: benchmark_simd_math [passes]   (default 2000)
+ */
+
+#include "../../src/cpp/simd_math.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+double ulpDistance(double a, double b) {
+    if (a == b) return 0.0;
+    auto ordered = [](double v) {
+        int64_t i;
+        std::memcpy(&i, &v, sizeof(i));
+        return i < 0 ? INT64_MIN - i : i;
+    };
+    const int64_t ia = ordered(a), ib = ordered(b);
+    return static_cast<double>(ia > ib ? static_cast<uint64_t>(ia) - static_cast<uint64_t>(ib)
+                                       : static_cast<uint64_t>(ib) - static_cast<uint64_t>(ia));
+}
+
+double maxUlp(const std::vector<double>& a, const std::vector<double>& b) {
+    double worst = 0.0;
+    for (size_t i = 0; i < a.size(); i++) worst = std::max(worst, ulpDistance(a[i], b[i]));
+    return worst;
+}
+
+struct Timing {
+    double ns_per_value;
+    std::vector<double> out;
+    std::vector<double> out2;
+};
+
+template <typename Fn>
+Timing time(size_t n, int passes, Fn&& fn) {
+    Timing t{0.0, std::vector<double>(n), std::vector<double>(n)};
+    fn(t.out.data(), t.out2.data());   // Warm-up
+    const double s = seconds([&]() {
+        for (int p = 0; p < passes; p++) fn(t.out.data(), t.out2.data());
+    });
+    t.ns_per_value = s * 1e9 / (static_cast<double>(passes) * static_cast<double>(n));
+    return t;
+}
+
+void report(const char* name, const char* level, const Timing& t, const Timing& scalar, double ulp) {
+    std::cout << std::setw(8) << name << std::setw(9) << level << std::fixed << std::setprecision(2)
+              << std::setw(12) << t.ns_per_value << std::setw(9) << scalar.ns_per_value / t.ns_per_value << "x"
+              << std::setprecision(0) << std::setw(9) << ulp << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int passes = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    const size_t n = 4096;
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> exp_arg(-50.0, 50.0);
+    std::uniform_real_distribution<double> angle(-100.0, 100.0);
+    std::uniform_real_distribution<double> coord(-10.0, 10.0);
+    std::vector<double> xe(n), xs(n), y(n), x(n);
+    for (size_t i = 0; i < n; i++) {
+        xe[i] = exp_arg(rng);
+        xs[i] = angle(rng);
+        y[i] = coord(rng);
+        x[i] = coord(rng);
+    }
+
+    std::cout << "=== SIMD Math (" << n << " values x " << passes << " passes) ===" << std::endl;
+    std::cout << std::setw(8) << "func" << std::setw(9) << "level" << std::setw(12) << "ns/value"
+              << std::setw(10) << "speedup" << std::setw(9) << "max ULP" << std::endl;
+
+    const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE4, SimdLevel::AVX2, SimdLevel::AVX512};
+    Timing exp_scalar{}, sincos_scalar{}, atan_scalar{};
+    for (SimdLevel requested : levels) {
+        const SimdLevel level = setSimdLevel(requested);
+        if (level != requested) continue;
+        const char* name = simdLevelName(level);
+
+        const Timing e = time(n, passes, [&](double* out, double*) { expArray(xe.data(), out, n); });
+        const Timing sc = time(n, passes, [&](double* s, double* c) { sinCosArray(xs.data(), s, c, n); });
+        const Timing a = time(n, passes, [&](double* out, double*) { atan2Array(y.data(), x.data(), out, n); });
+        if (level == SimdLevel::Scalar) {
+            exp_scalar = e;
+            sincos_scalar = sc;
+            atan_scalar = a;
+        }
+        report("exp", name, e, exp_scalar, maxUlp(e.out, exp_scalar.out));
+        report("sincos", name, sc, sincos_scalar,
+               std::max(maxUlp(sc.out, sincos_scalar.out), maxUlp(sc.out2, sincos_scalar.out2)));
+        report("atan2", name, a, atan_scalar, maxUlp(a.out, atan_scalar.out));
+    }
+    return 0;
+}
@@ -0,0 +1,437 @@
+/**
+ * DASE Cross-Engine Benchmark Suite
+ *
+ * One executable that times every engine on the same harness
+ * (bench_harness.h) and reports ns per site update:
+ *
+ *   analog_phase4a/4b/4c   AnalogCellularEngineAVX2 missions (node-steps)
+ *   igsoa_1d/2d/3d         IGSOA complex lattices across R_c
+ *   igsoa_1d_recursive     1D lattice with the recursive-filter coupling
+ *   satp_1d/2d/3d          SATP+Higgs Verlet steps
+ *   gw_*                   GW pipeline stages (sources, fractional memory,
+ *                          field step, strain) on an n³ SymmetryField
+ *   fft_1d/2d/3d           EngineFFTAnalysis spectra (points transformed)
+ *
+ * Usage: dase_bench [--filter=S] [--threads=1,2,4] [--size=small|default|large]
+ *                   [--min-time=S] [--repetitions=N] [--json=PATH]
+ *                   [--baseline=PATH] [--tolerance=F] [--perf]
+ *
+ * --baseline compares with an earlier --json file and exits with status 2
+ * when a case's ns/site-update grew by more than --tolerance (default 10%).
+ * --perf adds hardware-counter figures per case to the JSON.
+ *
+ * --scaling sweeps threads, pinning and cache-sized working sets for the
+ * analog Phase 4B/4C, IGSOA 2D/3D and SATP+Higgs groups instead:
+ *
+ *   dase_bench --scaling [--threads=1,2,4,8] [--pinning=compact,spread]
+ *              [--filter=S] [--csv=PATH] [--json=PATH]
+ */
+
+#include "bench_harness.h"
+
+#include "../../src/cpp/analog_universal_node_engine_avx2.h"
+#include "../../src/cpp/igsoa_complex_engine.h"
+#include "../../src/cpp/igsoa_complex_engine_2d.h"
+#include "../../src/cpp/igsoa_complex_engine_3d.h"
+#include "../../src/cpp/satp_higgs_engine_1d.h"
+#include "../../src/cpp/satp_higgs_physics_1d.h"
+#include "../../src/cpp/satp_higgs_engine_2d.h"
+#include "../../src/cpp/satp_higgs_physics_2d.h"
+#include "../../src/cpp/satp_higgs_engine_3d.h"
+#include "../../src/cpp/satp_higgs_physics_3d.h"
+#include "../../src/cpp/igsoa_gw_engine/core/symmetry_field.h"
+#include "../../src/cpp/igsoa_gw_engine/core/fractional_solver.h"
+#include "../../src/cpp/igsoa_gw_engine/core/source_manager.h"
+#include "../../src/cpp/igsoa_gw_engine/core/projection_operators.h"
+#include "../../src/cpp/igsoa_gw_engine/core/gw_step_workspace.h"
+#include "../../dase_cli/src/engine_fft_analysis.h"
+#include <cmath>
+#include <memory>
+
+using namespace dase::bench;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Analog engine phases
+// ---------------------------------------------------------------------------
+
+constexpr uint64_t kAnalogSteps = 64;
+constexpr uint32_t kAnalogIterations = 30;
+
+enum class AnalogPhase { Optimized, Phase4B, Phase4C };
+
+void addAnalog(Runner& runner, Scale scale) {
+    const std::vector<Params> cases = {
+        {{"nodes", pick(scale, 256.0, 1024.0, 4096.0)}},
+        {{"nodes", pick(scale, 1024.0, 8192.0, 65536.0)}},
+    };
+    const std::pair<const char*, AnalogPhase> phases[] = {
+        {"analog_phase4a", AnalogPhase::Optimized},
+        {"analog_phase4b", AnalogPhase::Phase4B},
+        {"analog_phase4c", AnalogPhase::Phase4C},
+    };
+    for (const auto& phase : phases) {
+        const AnalogPhase which = phase.second;
+        // Node state is the working set; Phase 4A is the serial reference
+        ScalingSpec scaling;
+        scaling.size_param = "nodes";
+        scaling.bytes_per_site = which == AnalogPhase::Optimized ? 0.0 : sizeof(AnalogUniversalNodeAVX2);
+        runner.add(phase.first, cases, [which](const Params& params) {
+            const size_t nodes = static_cast<size_t>(param(params, "nodes"));
+            auto engine = std::make_shared<AnalogCellularEngineAVX2>(nodes);
+            auto input = std::make_shared<std::vector<double>>(kAnalogSteps);
+            auto control = std::make_shared<std::vector<double>>(kAnalogSteps);
+            for (uint64_t i = 0; i < kAnalogSteps; i++) {
+                (*input)[i] = std::sin(0.01 * static_cast<double>(i));
+                (*control)[i] = std::cos(0.01 * static_cast<double>(i));
+            }
+            Body body;
+            body.site_updates = static_cast<double>(nodes * kAnalogSteps);
+            body.step = [engine, input, control, which]() {
+                switch (which) {
+                case AnalogPhase::Optimized:
+                    engine->runMissionOptimized(input->data(), control->data(), kAnalogSteps, kAnalogIterations);
+                    break;
+                case AnalogPhase::Phase4B:
+                    engine->runMissionOptimized_Phase4B(input->data(), control->data(), kAnalogSteps, kAnalogIterations);
+                    break;
+                case AnalogPhase::Phase4C:
+                    engine->runMissionOptimized_Phase4C(input->data(), control->data(), kAnalogSteps, kAnalogIterations);
+                    break;
+                }
+            };
+            return body;
+        }, scaling);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// IGSOA lattices
+// ---------------------------------------------------------------------------
+
+dase::igsoa::IGSOAComplexConfig igsoaConfig(size_t nodes, double R_c) {
+    dase::igsoa::IGSOAComplexConfig config;
+    config.num_nodes = nodes;
+    config.R_c_default = R_c;
+    config.kappa = 1.0;
+    config.gamma = 0.1;
+    config.dt = 0.01;
+    config.normalize_psi = false;
+    return config;
+}
+
+template <typename Engine>
+void seedPsi(Engine& engine) {
+    auto& nodes = engine.getNodesMutable();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i].psi = {0.1 * std::sin(0.01 * static_cast<double>(i)), 0.0};
+    }
+}
+
+// IGSOALatticeSoA arrays swept by a step (the AoS view stays untouched)
+constexpr double kIgsoaStateBytes = 11 * sizeof(double) + sizeof(uint32_t);
+
+ScalingSpec igsoaScaling(int dims) {
+    ScalingSpec scaling;
+    scaling.dims = dims;
+    scaling.bytes_per_site = kIgsoaStateBytes;
+    scaling.fixed = {{"R_c", 1.0}};
+    return scaling;
+}
+
+std::vector<Params> withRadii(const std::vector<double>& sizes, const std::vector<double>& radii) {
+    std::vector<Params> cases;
+    for (double n : sizes) {
+        for (double R_c : radii) cases.push_back({{"n", n}, {"R_c", R_c}});
+    }
+    return cases;
+}
+
+void addIgsoa(Runner& runner, Scale scale) {
+    using namespace dase::igsoa;
+
+    runner.add("igsoa_1d",
+               withRadii({pick(scale, 4096.0, 65536.0, 1048576.0)}, {1.0, 2.0, 4.0, 8.0}),
+               [](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        auto engine = std::make_shared<IGSOAComplexEngine>(igsoaConfig(n, param(params, "R_c")));
+        seedPsi(*engine);
+        return Body{[engine]() { engine->runMission(1); }, static_cast<double>(n)};
+    });
+
+    // O(N) exponential-kernel filter; flat in R_c where igsoa_1d is linear
+    runner.add("igsoa_1d_recursive",
+               withRadii({pick(scale, 4096.0, 65536.0, 1048576.0)}, {8.0, 64.0, 512.0}),
+               [](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        IGSOAComplexConfig config = igsoaConfig(n, param(params, "R_c"));
+        config.coupling_mode = IGSOACouplingMode::Recursive;
+        auto engine = std::make_shared<IGSOAComplexEngine>(config);
+        seedPsi(*engine);
+        return Body{[engine]() { engine->runMission(1); }, static_cast<double>(n)};
+    });
+
+    runner.add("igsoa_2d",
+               withRadii({pick(scale, 64.0, 256.0, 512.0)}, {1.0, 2.0, 4.0}),
+               [](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        auto engine = std::make_shared<IGSOAComplexEngine2D>(igsoaConfig(n * n, param(params, "R_c")), n, n);
+        seedPsi(*engine);
+        return Body{[engine]() { engine->runMission(1); }, static_cast<double>(n * n)};
+    }, igsoaScaling(2));
+
+    runner.add("igsoa_3d",
+               withRadii({pick(scale, 16.0, 48.0, 96.0)}, {1.0, 2.0}),
+               [](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        auto engine = std::make_shared<IGSOAComplexEngine3D>(igsoaConfig(n * n * n, param(params, "R_c")), n, n, n);
+        seedPsi(*engine);
+        return Body{[engine]() { engine->runMission(1); }, static_cast<double>(n * n * n)};
+    }, igsoaScaling(3));
+}
+
+// ---------------------------------------------------------------------------
+// SATP+Higgs lattices
+// ---------------------------------------------------------------------------
+
+constexpr double kSatpDx = 0.1;
+constexpr double kSatpDt = 0.02;
+
+// SATPHiggsPlanes: four field planes and four acceleration planes
+ScalingSpec satpScaling(int dims) {
+    ScalingSpec scaling;
+    scaling.dims = dims;
+    scaling.bytes_per_site = 8 * sizeof(double);
+    return scaling;
+}
+
+template <typename Engine>
+Body satpBody(std::shared_ptr<Engine> engine) {
+    for (size_t i = 0; i < engine->getN(); ++i) {
+        engine->getNodesMutable()[i].phi = 0.1 * std::sin(0.01 * static_cast<double>(i));
+    }
+    return Body{[engine]() { engine->evolve(1); }, static_cast<double>(engine->getN())};
+}
+
+void addSatp(Runner& runner, Scale scale) {
+    using namespace dase::satp_higgs;
+    SATPHiggsParams physics;
+    physics.gamma_phi = 0.01;
+
+    runner.add("satp_1d", {{{"n", pick(scale, 4096.0, 262144.0, 4194304.0)}}}, [physics](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        return satpBody(std::make_shared<SATPHiggsEngine1D>(n, kSatpDx, kSatpDt, physics));
+    }, satpScaling(1));
+    runner.add("satp_2d", {{{"n", pick(scale, 64.0, 512.0, 2048.0)}}}, [physics](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        return satpBody(std::make_shared<SATPHiggsEngine2D>(n, n, kSatpDx, kSatpDt, physics));
+    }, satpScaling(2));
+    runner.add("satp_3d", {{{"n", pick(scale, 16.0, 64.0, 128.0)}}}, [physics](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        return satpBody(std::make_shared<SATPHiggsEngine3D>(n, n, n, kSatpDx, kSatpDt, physics));
+    }, satpScaling(3));
+}
+
+// ---------------------------------------------------------------------------
+// GW pipeline stages
+// ---------------------------------------------------------------------------
+
+struct GWPipeline {
+    dase::igsoa::gw::SymmetryFieldConfig field_config;
+    std::unique_ptr<dase::igsoa::gw::SymmetryField> field;
+    std::unique_ptr<dase::igsoa::gw::FractionalSolver> solver;
+    std::unique_ptr<dase::igsoa::gw::BinaryMerger> merger;
+    std::unique_ptr<dase::igsoa::gw::ProjectionOperators> projector;
+    std::unique_ptr<dase::igsoa::gw::GWStepWorkspace> workspace;
+    double t = 0.0;
+
+    explicit GWPipeline(int n) {
+        using namespace dase::igsoa::gw;
+        field_config.nx = field_config.ny = field_config.nz = n;
+        field_config.dx = field_config.dy = field_config.dz = 2000.0;
+        field_config.dt = 0.001;
+        field = std::make_unique<SymmetryField>(field_config);
+
+        FractionalSolverConfig frac_config;
+        frac_config.T_max = 1.0;
+        frac_config.soe_rank = 12;
+        frac_config.alpha_min = 1.5;
+        frac_config.alpha_max = 1.5;
+        solver = std::make_unique<FractionalSolver>(frac_config, field->getTotalPoints());
+
+        BinaryMergerConfig merger_config;
+        merger_config.mass1 = 30.0;
+        merger_config.mass2 = 30.0;
+        merger_config.initial_separation = 0.2 * n * field_config.dx;
+        merger_config.gaussian_width = 5.0 * field_config.dx;
+        merger_config.center = Vector3D(n * field_config.dx / 2, n * field_config.dy / 2, n * field_config.dz / 2);
+        merger = std::make_unique<BinaryMerger>(merger_config);
+
+        ProjectionConfig proj_config;
+        proj_config.observer_position = Vector3D(n * field_config.dx * 0.75, n * field_config.dy * 0.75,
+                                                 n * field_config.dz * 0.75);
+        proj_config.detector_normal = Vector3D(0, 0, -1);
+        proj_config.detector_distance = n * field_config.dz;
+        projector = std::make_unique<ProjectionOperators>(proj_config);
+
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                for (int k = 0; k < n; k++) field->setAlpha(i, j, k, 1.5);
+            }
+        }
+        solver->setAlphaField(field->getAlphaFlat());
+        workspace = std::make_unique<GWStepWorkspace>(field->getTotalPoints());
+
+        // Populate the field and the memory history once
+        step();
+    }
+
+    void step() {
+        merger->computeSourceTerms(*field, t, workspace->source_terms);
+        solver->computeDerivatives(workspace->fractional_derivatives);
+        field->evolveStep(workspace->fractional_derivatives, workspace->source_terms);
+        solver->updateHistory(workspace->second_derivatives, field_config.dt);
+        merger->evolveOrbit(field_config.dt);
+        t += field_config.dt;
+    }
+};
+
+void addGw(Runner& runner, Scale scale) {
+    const std::vector<Params> cases = {{{"n", pick(scale, 16.0, 32.0, 64.0)}}};
+    auto points = [](const GWPipeline& gw) { return static_cast<double>(gw.field->getTotalPoints()); };
+
+    runner.add("gw_sources", cases, [points](const Params& params) {
+        auto gw = std::make_shared<GWPipeline>(static_cast<int>(param(params, "n")));
+        return Body{[gw]() { gw->merger->computeSourceTerms(*gw->field, gw->t, gw->workspace->source_terms); },
+                    points(*gw)};
+    });
+    runner.add("gw_fractional", cases, [points](const Params& params) {
+        auto gw = std::make_shared<GWPipeline>(static_cast<int>(param(params, "n")));
+        return Body{[gw]() {
+            gw->solver->computeDerivatives(gw->workspace->fractional_derivatives);
+            gw->solver->updateHistory(gw->workspace->second_derivatives, gw->field_config.dt);
+        }, points(*gw)};
+    });
+    runner.add("gw_field_step", cases, [points](const Params& params) {
+        auto gw = std::make_shared<GWPipeline>(static_cast<int>(param(params, "n")));
+        return Body{[gw]() { gw->field->evolveStep(gw->workspace->fractional_derivatives, gw->workspace->source_terms); },
+                    points(*gw)};
+    });
+    runner.add("gw_strain", cases, [points](const Params& params) {
+        auto gw = std::make_shared<GWPipeline>(static_cast<int>(param(params, "n")));
+        return Body{[gw]() {
+            volatile double h = gw->projector->compute_strain_at_observer(*gw->field).amplitude;
+            (void)h;
+        }, points(*gw)};
+    });
+    runner.add("gw_full_step", cases, [points](const Params& params) {
+        auto gw = std::make_shared<GWPipeline>(static_cast<int>(param(params, "n")));
+        return Body{[gw]() { gw->step(); }, points(*gw)};
+    });
+}
+
+// ---------------------------------------------------------------------------
+// FFT analysis
+// ---------------------------------------------------------------------------
+
+std::shared_ptr<std::vector<double>> fftField(size_t points) {
+    auto data = std::make_shared<std::vector<double>>(points);
+    for (size_t i = 0; i < points; i++) {
+        (*data)[i] = std::sin(0.37 * static_cast<double>(i)) + 0.5 * std::cos(0.011 * static_cast<double>(i));
+    }
+    return data;
+}
+
+void addFft(Runner& runner, Scale scale) {
+    using dase::analysis::EngineFFTAnalysis;
+
+    runner.add("fft_1d", {{{"n", pick(scale, 4096.0, 65536.0, 1048576.0)}}}, [](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        auto data = fftField(n);
+        return Body{[data]() { EngineFFTAnalysis::compute1DFFT(*data, "psi_real"); }, static_cast<double>(n)};
+    });
+    runner.add("fft_2d", {{{"n", pick(scale, 64.0, 256.0, 1024.0)}}}, [](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        auto data = fftField(n * n);
+        return Body{[data, n]() { EngineFFTAnalysis::compute2DFFT(*data, n, n, "psi_real"); },
+                    static_cast<double>(n * n)};
+    });
+    runner.add("fft_3d", {{{"n", pick(scale, 16.0, 64.0, 128.0)}}}, [](const Params& params) {
+        const size_t n = static_cast<size_t>(param(params, "n"));
+        auto data = fftField(n * n * n);
+        return Body{[data, n]() { EngineFFTAnalysis::compute3DFFT(*data, n, n, n, "psi_real"); },
+                    static_cast<double>(n * n * n)};
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: dase_bench [--filter=S] [--threads=1,2,4] [--size=small|default|large]\n"
+                     "                  [--min-time=S] [--repetitions=N] [--json=PATH]\n"
+                     "                  [--baseline=PATH] [--tolerance=F] [--perf]\n"
+                     "       dase_bench --scaling [--threads=...] [--pinning=compact,spread] [--filter=S]\n"
+                     "                  [--csv=PATH] [--json=PATH]" << std::endl;
+        return 1;
+    }
+
+    Runner runner;
+    addAnalog(runner, options.scale);
+    addIgsoa(runner, options.scale);
+    addSatp(runner, options.scale);
+    addGw(runner, options.scale);
+    addFft(runner, options.scale);
+
+    if (options.scaling) {
+        const std::vector<ScalingPoint> points = runner.runScaling(options);
+        if (!options.csv_path.empty()) {
+            std::ofstream out(options.csv_path);
+            if (!out) {
+                std::cerr << "Cannot write " << options.csv_path << std::endl;
+                return 1;
+            }
+            writeScalingCsv(out, points);
+            std::cout << "Wrote " << points.size() << " scaling points to " << options.csv_path << std::endl;
+        }
+        if (!options.json_path.empty()) {
+            std::ofstream out(options.json_path);
+            if (!out) {
+                std::cerr << "Cannot write " << options.json_path << std::endl;
+                return 1;
+            }
+            writeScalingJson(out, points, options);
+            std::cout << "Wrote " << points.size() << " scaling points to " << options.json_path << std::endl;
+        }
+        return 0;
+    }
+
+    const std::vector<Result> results = runner.run(options);
+
+    if (!options.json_path.empty()) {
+        std::ofstream out(options.json_path);
+        if (!out) {
+            std::cerr << "Cannot write " << options.json_path << std::endl;
+            return 1;
+        }
+        writeJson(out, results, options);
+        std::cout << "Wrote " << results.size() << " results to " << options.json_path << std::endl;
+    }
+
+    if (!options.baseline_path.empty()) {
+        const auto baseline = readBaseline(options.baseline_path);
+        if (baseline.empty()) {
+            std::cerr << "No results in baseline " << options.baseline_path << std::endl;
+            return 1;
+        }
+        const int regressions = compareBaseline(results, baseline, options.tolerance);
+        if (regressions > 0) {
+            std::cout << regressions << " case(s) regressed by more than "
+                      << 100.0 * options.tolerance << "%" << std::endl;
+            return 2;
+        }
+    }
+    return 0;
+}
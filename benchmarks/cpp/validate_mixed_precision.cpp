@@ -0,0 +1,225 @@
+/**
+ * float32 vs float64 Stepping Validation
+ *
+ * Runs each engine twice from the same initial state, once in the default
+ * double path and once with float32 stepping, and reports per case:
+ *
+ *   dE/E    relative difference of the final total energies
+ *   d(com)  center-of-mass distance of the packet (IGSOA |Ψ|² above its
+ *           minimum, circular statistics on the torus, lattice units);
+ *           ill-conditioned once |Ψ|² has relaxed to a near-uniform state
+ *   max|d|  largest per-node difference of the evolved field (Re Ψ / φ)
+ *   speedup double elapsed / float elapsed
+ *
+ * Cases: IGSOA 2D 512² and 3D 64³ Gaussian packets (stencil coupling),
+ * SATP+Higgs 1D 2^20, 2D 1024² and 3D 96³ sine perturbations.
+ *
+ * Usage: validate_mixed_precision [steps]   (default 50 per run)
+ */
+
+#include "../../src/cpp/igsoa_complex_engine_2d.h"
+#include "../../src/cpp/igsoa_complex_engine_3d.h"
+#include "../../src/cpp/igsoa_state_init_2d.h"
+#include "../../src/cpp/igsoa_state_init_3d.h"
+#include "../../src/cpp/satp_higgs_engine_1d.h"
+#include "../../src/cpp/satp_higgs_engine_2d.h"
+#include "../../src/cpp/satp_higgs_engine_3d.h"
+#include "../../src/cpp/satp_higgs_physics_1d.h"
+#include "../../src/cpp/satp_higgs_physics_2d.h"
+#include "../../src/cpp/satp_higgs_physics_3d.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace dase::igsoa;
+using namespace dase::satp_higgs;
+
+namespace {
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+IGSOAComplexConfig makeConfig(size_t num_nodes, IGSOAPrecision precision) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(num_nodes);
+    config.R_c_default = 2.5;
+    config.kappa = 1.0;
+    config.gamma = 0.1;
+    config.dt = 0.01;
+    config.precision = precision;
+    return config;
+}
+
+struct Result {
+    double energy_rel;
+    double com_shift;
+    double max_diff;
+    double speedup;
+    bool float_ran;
+};
+
+void printRow(const std::string& label, const Result& r) {
+    std::cout << std::setw(22) << label << std::scientific << std::setprecision(2)
+              << std::setw(12) << r.energy_rel
+              << std::setw(12) << r.com_shift
+              << std::setw(12) << r.max_diff
+              << std::fixed << std::setprecision(2) << std::setw(9) << r.speedup << "x"
+              << (r.float_ran ? "" : "  (float path inactive)") << std::endl;
+}
+
+double relative(double a, double b) {
+    return std::abs(a - b) / std::max(std::abs(a), 1e-300);
+}
+
+// Packet center along one axis of extent n (circular mean of the weights)
+struct CircularMean {
+    double sum_cos = 0.0;
+    double sum_sin = 0.0;
+    void add(double w, size_t i, size_t n) {
+        const double theta = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n);
+        sum_cos += w * std::cos(theta);
+        sum_sin += w * std::sin(theta);
+    }
+    double center(size_t n) const {
+        const double theta = std::atan2(sum_sin, sum_cos);
+        return (theta < 0.0 ? theta + 2.0 * M_PI : theta) * static_cast<double>(n) / (2.0 * M_PI);
+    }
+};
+
+// Axis distance on a ring of extent n
+double ringDistance(double a, double b, size_t n) {
+    const double d = std::abs(a - b);
+    return std::min(d, static_cast<double>(n) - d);
+}
+
+// Packet-center distance between two runs; the |Ψ|² background is subtracted
+// so the near-uniform baseline does not dominate the circular mean
+double comShift(const IGSOALatticeSoA& a, const IGSOALatticeSoA& b,
+                size_t N_x, size_t N_y, size_t N_z) {
+    CircularMean ca[3], cb[3];
+    const double floor_a = *std::min_element(a.F.begin(), a.F.end());
+    const double floor_b = *std::min_element(b.F.begin(), b.F.end());
+    for (size_t i = 0; i < a.size(); ++i) {
+        const size_t idx[3] = {i % N_x, (i / N_x) % N_y, i / (N_x * N_y)};
+        const size_t ext[3] = {N_x, N_y, N_z};
+        for (int d = 0; d < 3; ++d) {
+            ca[d].add(a.F[i] - floor_a, idx[d], ext[d]);
+            cb[d].add(b.F[i] - floor_b, idx[d], ext[d]);
+        }
+    }
+    const size_t ext[3] = {N_x, N_y, N_z};
+    double sq = 0.0;
+    for (int d = 0; d < 3; ++d) {
+        if (ext[d] == 1) continue;
+        const double r = ringDistance(ca[d].center(ext[d]), cb[d].center(ext[d]), ext[d]);
+        sq += r * r;
+    }
+    return std::sqrt(sq);
+}
+
+template <typename Engine>
+double maxPsiDiff(const Engine& a, const Engine& b) {
+    const auto& la = a.getLattice();
+    const auto& lb = b.getLattice();
+    double d = 0.0;
+    for (size_t i = 0; i < la.size(); ++i) {
+        d = std::max(d, std::abs(la.psi_re[i] - lb.psi_re[i]));
+    }
+    return d;
+}
+
+Result runIGSOA2D(size_t n, uint64_t steps) {
+    const size_t N = n * n;
+    IGSOAComplexEngine2D ref(makeConfig(N, IGSOAPrecision::Double), n, n);
+    IGSOAComplexEngine2D f32(makeConfig(N, IGSOAPrecision::Float), n, n);
+    const double c = 0.5 * static_cast<double>(n);
+    IGSOAStateInit2D::initCircularGaussian(ref, 1.0, c, c, 0.1 * static_cast<double>(n));
+    IGSOAStateInit2D::initCircularGaussian(f32, 1.0, c, c, 0.1 * static_cast<double>(n));
+
+    const double t_ref = seconds([&]() { ref.runMission(steps); });
+    const double t_f32 = seconds([&]() { f32.runMission(steps); });
+
+    return Result{relative(IGSOAPhysicsSoA::computeTotalEnergy(ref.getLattice()),
+                           IGSOAPhysicsSoA::computeTotalEnergy(f32.getLattice())),
+                  comShift(ref.getLattice(), f32.getLattice(), n, n, 1), maxPsiDiff(ref, f32), t_ref / t_f32,
+                  f32.isFloatPrecisionActive()};
+}
+
+Result runIGSOA3D(size_t n, uint64_t steps) {
+    const size_t N = n * n * n;
+    IGSOAComplexEngine3D ref(makeConfig(N, IGSOAPrecision::Double), n, n, n);
+    IGSOAComplexEngine3D f32(makeConfig(N, IGSOAPrecision::Float), n, n, n);
+    const double c = 0.5 * static_cast<double>(n);
+    IGSOAStateInit3D::initSphericalGaussian(ref, 1.0, c, c, c, 0.1 * static_cast<double>(n));
+    IGSOAStateInit3D::initSphericalGaussian(f32, 1.0, c, c, c, 0.1 * static_cast<double>(n));
+
+    const double t_ref = seconds([&]() { ref.runMission(steps); });
+    const double t_f32 = seconds([&]() { f32.runMission(steps); });
+
+    return Result{relative(IGSOAPhysicsSoA::computeTotalEnergy(ref.getLattice()),
+                           IGSOAPhysicsSoA::computeTotalEnergy(f32.getLattice())),
+                  comShift(ref.getLattice(), f32.getLattice(), n, n, n), maxPsiDiff(ref, f32), t_ref / t_f32,
+                  f32.isFloatPrecisionActive()};
+}
+
+// SATP+Higgs has no density center; d(com) is reported as 0
+template <typename Engine>
+Result runSATP(Engine& ref, Engine& f32, size_t steps) {
+    f32.setPrecision(SATPHiggsPrecision::Float);
+    for (size_t i = 0; i < ref.getN(); ++i) {
+        const double phi = 0.1 * std::sin(0.01 * static_cast<double>(i));
+        ref.getNodesMutable()[i].phi = phi;
+        f32.getNodesMutable()[i].phi = phi;
+    }
+
+    const double t_ref = seconds([&]() { ref.evolve(steps); });
+    const double t_f32 = seconds([&]() { f32.evolve(steps); });
+
+    double max_diff = 0.0;
+    for (size_t i = 0; i < ref.getN(); ++i) {
+        max_diff = std::max(max_diff, std::abs(ref.getNodes()[i].phi - f32.getNodes()[i].phi));
+    }
+    return Result{relative(ref.computeTotalEnergy(), f32.computeTotalEnergy()), 0.0, max_diff,
+                  t_ref / t_f32, f32.isFloatPrecisionActive()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint64_t steps = (argc > 1) ? static_cast<uint64_t>(std::atoi(argv[1])) : 50;
+
+    std::cout << "=== float32 vs float64 Stepping (" << steps << " steps) ===" << std::endl;
+    std::cout << std::setw(22) << "case" << std::setw(12) << "dE/E" << std::setw(12) << "d(com)"
+              << std::setw(12) << "max|d|" << std::setw(10) << "speedup" << std::endl;
+
+    printRow("IGSOA 2D 512^2", runIGSOA2D(512, steps));
+    printRow("IGSOA 3D 64^3", runIGSOA3D(64, steps));
+
+    SATPHiggsParams params;
+    params.gamma_phi = 0.01;
+    {
+        SATPHiggsEngine1D ref(size_t(1) << 20, 0.1, 0.02, params);
+        SATPHiggsEngine1D f32(size_t(1) << 20, 0.1, 0.02, params);
+        printRow("SATP+Higgs 1D 2^20", runSATP(ref, f32, steps));
+    }
+    {
+        SATPHiggsEngine2D ref(1024, 1024, 0.1, 0.02, params);
+        SATPHiggsEngine2D f32(1024, 1024, 0.1, 0.02, params);
+        printRow("SATP+Higgs 2D 1024^2", runSATP(ref, f32, steps));
+    }
+    {
+        SATPHiggsEngine3D ref(96, 96, 96, 0.1, 0.02, params);
+        SATPHiggsEngine3D f32(96, 96, 96, 0.1, 0.02, params);
+        printRow("SATP+Higgs 3D 96^3", runSATP(ref, f32, steps));
+    }
+    return 0;
+}
@@ -73,20 +73,33 @@ CombinedAnalysisResult AnalysisRouter::routeAnalysis(
 python::PythonAnalysisResult AnalysisRouter::quickPythonAnalysis(
     const std::string& engine_id,
     const std::string& script_name,
-    const std::map<std::string, std::string>& args
+    const std::map<std::string, std::string>& args,
+    bool use_worker
 ) {
-    // Extract state
-    nlohmann::json state_data = extractEngineState(engine_id);
-
-    // Write to temp file
-    std::string temp_file = writeTempStateFile(state_data);
-
     // Configure Python analysis
     python::PythonAnalysisConfig config;
     config.script_path = script_name;
     config.args = args;
     config.output_dir = "analysis_output";
 
+    if (use_worker && pythonWorker()) {
+        nlohmann::json descriptor = writeBinaryStateFile(engine_id);
+        if (!descriptor.is_null()) {
+            python::PythonAnalysisResult result;
+            bool handled = runInWorker(descriptor, config, result);
+            fs::remove(descriptor["path"].get<std::string>());
+            if (handled) {
+                return result;
+            }
+        }
+    }
+
+    // Extract state
+    nlohmann::json state_data = extractEngineState(engine_id);
+
+    // Write to temp file
+    std::string temp_file = writeTempStateFile(state_data);
+
     // Run analysis
     auto result = python::PythonBridge::runAnalysisScript(temp_file, config);
 
@@ -98,7 +111,8 @@ python::PythonAnalysisResult AnalysisRouter::quickPythonAnalysis(
 
 analysis::FFTResult AnalysisRouter::quickFFT(
     const std::string& engine_id,
-    const std::string& field_name
+    const std::string& field_name,
+    const analysis::FFTPeakOptions& peak_options
 ) {
     // Extract state
     nlohmann::json state_data = extractEngineState(engine_id);
@@ -126,7 +140,8 @@ analysis::FFTResult AnalysisRouter::quickFFT(
                 dims["N_x"].get<size_t>(),
                 dims["N_y"].get<size_t>(),
                 dims["N_z"].get<size_t>(),
-                field_name
+                field_name,
+                peak_options
             );
         } else if (dims.contains("N_y") && dims["N_y"].get<int>() > 1) {
             // 2D
@@ -134,13 +149,14 @@ analysis::FFTResult AnalysisRouter::quickFFT(
                 field_data,
                 dims["N_x"].get<size_t>(),
                 dims["N_y"].get<size_t>(),
-                field_name
+                field_name,
+                peak_options
             );
         }
     }
 
     // Default to 1D
-    return analysis::EngineFFTAnalysis::compute1DFFT(field_data, field_name);
+    return analysis::EngineFFTAnalysis::compute1DFFT(field_data, field_name, peak_options);
 }
 
 std::vector<std::string> AnalysisRouter::getAvailablePythonScripts() const {
@@ -157,7 +173,8 @@ nlohmann::json AnalysisRouter::checkToolAvailability() const {
         {"available", python_available},
         {"executable", "python"},
         {"version", python::PythonBridge::getPythonVersion("python")},
-        {"required_packages", python_packages}
+        {"required_packages", python_packages},
+        {"worker_script", python::AnalysisWorker::findWorkerScript()}
     };
 
     // Check Julia (basic check - just see if executable exists)
@@ -192,6 +209,91 @@ nlohmann::json AnalysisRouter::checkToolAvailability() const {
 }
 
 nlohmann::json AnalysisRouter::extractEngineState(const std::string& engine_id) {
+    nlohmann::json state = extractEngineMetadata(engine_id);
+    auto instance = engine_manager_->getEngine(engine_id);
+
+    // Extract field data based on engine type
+    if (instance->engine_type.find("igsoa_complex") != std::string::npos) {
+        // IGSOA Complex engines
+        std::vector<double> psi_real, psi_imag, phi;
+        if (engine_manager_->getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
+            state["psi_real"] = psi_real;
+            state["psi_imag"] = psi_imag;
+            state["phi"] = phi;
+        }
+    } else if (instance->engine_type.find("satp_higgs") != std::string::npos) {
+        // SATP+Higgs engines
+        std::vector<double> phi, phi_dot, h, h_dot;
+        if (engine_manager_->getSatpState(engine_id, phi, phi_dot, h, h_dot)) {
+            state["phi"] = phi;
+            state["phi_dot"] = phi_dot;
+            state["h"] = h;
+            state["h_dot"] = h_dot;
+        }
+    }
+
+    return state;
+}
+
+nlohmann::json AnalysisRouter::writeBinaryStateFile(const std::string& engine_id) {
+    nlohmann::json meta = extractEngineMetadata(engine_id);
+    auto instance = engine_manager_->getEngine(engine_id);
+
+    // Same fields as extractEngineState, written raw instead of as JSON arrays
+    std::vector<double> a, b, c, d;
+    std::vector<std::pair<std::string, const std::vector<double>*>> fields;
+    if (instance->engine_type.find("igsoa_complex") != std::string::npos) {
+        if (engine_manager_->getAllNodeStates(engine_id, a, b, c)) {
+            fields = {{"psi_real", &a}, {"psi_imag", &b}, {"phi", &c}};
+        }
+    } else if (instance->engine_type.find("satp_higgs") != std::string::npos) {
+        if (engine_manager_->getSatpState(engine_id, a, b, c, d)) {
+            fields = {{"phi", &a}, {"phi_dot", &b}, {"h", &c}, {"h_dot", &d}};
+        }
+    }
+
+    fs::path temp_dir = fs::temp_directory_path() / "dase_analysis";
+    fs::create_directories(temp_dir);
+    auto timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+    fs::path temp_file = temp_dir / ("state_" + std::to_string(timestamp) + ".bin");
+
+    return python::AnalysisWorker::writeStateFile(temp_file.string(), fields, meta);
+}
+
+python::AnalysisWorker* AnalysisRouter::pythonWorker() {
+    if (python_worker_failed_) {
+        return nullptr;
+    }
+    if (!python_worker_) {
+        std::string script = python::AnalysisWorker::findWorkerScript();
+        if (script.empty()) {
+            python_worker_failed_ = true;
+            return nullptr;
+        }
+        python_worker_ = std::make_unique<python::AnalysisWorker>("python", script);
+    }
+    if (!python_worker_->ensureStarted()) {
+        // No usable interpreter; stay on the per-script path for this session
+        python_worker_failed_ = true;
+        python_worker_.reset();
+        return nullptr;
+    }
+    return python_worker_.get();
+}
+
+bool AnalysisRouter::runInWorker(
+    const nlohmann::json& state_descriptor,
+    const python::PythonAnalysisConfig& config,
+    python::PythonAnalysisResult& result
+) {
+    python::AnalysisWorker* worker = pythonWorker();
+    if (!worker) {
+        return false;
+    }
+    return python::PythonBridge::runAnalysisInWorker(*worker, state_descriptor, config, result);
+}
+
+nlohmann::json AnalysisRouter::extractEngineMetadata(const std::string& engine_id) {
     nlohmann::json state;
     state["engine_id"] = engine_id;
 
@@ -225,26 +327,6 @@ nlohmann::json AnalysisRouter::extractEngineState(const std::string& engine_id)
         };
     }
 
-    // Extract field data based on engine type
-    if (instance->engine_type.find("igsoa_complex") != std::string::npos) {
-        // IGSOA Complex engines
-        std::vector<double> psi_real, psi_imag, phi;
-        if (engine_manager_->getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
-            state["psi_real"] = psi_real;
-            state["psi_imag"] = psi_imag;
-            state["phi"] = phi;
-        }
-    } else if (instance->engine_type.find("satp_higgs") != std::string::npos) {
-        // SATP+Higgs engines
-        std::vector<double> phi, phi_dot, h, h_dot;
-        if (engine_manager_->getSatpState(engine_id, phi, phi_dot, h, h_dot)) {
-            state["phi"] = phi;
-            state["phi_dot"] = phi_dot;
-            state["h"] = h;
-            state["h_dot"] = h_dot;
-        }
-    }
-
     return state;
 }
 
@@ -256,9 +338,12 @@ void AnalysisRouter::runPythonAnalysis(
     result.python.executed = true;
 
     try {
-        // Extract state and write to file
-        nlohmann::json state_data = extractEngineState(engine_id);
-        std::string temp_file = writeTempStateFile(state_data);
+        // Binary state for the worker; JSON state only if a script needs the fallback
+        nlohmann::json descriptor;
+        if (config.python.use_worker && pythonWorker()) {
+            descriptor = writeBinaryStateFile(engine_id);
+        }
+        std::string temp_file;
 
         // Run each requested script
         for (const auto& script : config.python.scripts) {
@@ -267,12 +352,23 @@ void AnalysisRouter::runPythonAnalysis(
             py_config.output_dir = config.python.output_dir;
             py_config.args = config.python.args;
 
-            auto py_result = python::PythonBridge::runAnalysisScript(temp_file, py_config);
+            python::PythonAnalysisResult py_result;
+            if (descriptor.is_null() || !runInWorker(descriptor, py_config, py_result)) {
+                if (temp_file.empty()) {
+                    temp_file = writeTempStateFile(extractEngineState(engine_id));
+                }
+                py_result = python::PythonBridge::runAnalysisScript(temp_file, py_config);
+            }
             result.python.script_results.push_back(py_result);
         }
 
         // Cleanup
-        fs::remove(temp_file);
+        if (!descriptor.is_null()) {
+            fs::remove(descriptor["path"].get<std::string>());
+        }
+        if (!temp_file.empty()) {
+            fs::remove(temp_file);
+        }
 
     } catch (const std::exception& e) {
         result.success = false;
@@ -14,6 +14,7 @@
 #include <memory>
 #include "json.hpp"
 #include "python_bridge.h"
+#include "analysis_worker.h"
 #include "engine_fft_analysis.h"
 #include "engine_manager.h"
 
@@ -35,6 +36,7 @@ struct AnalysisConfig {
         std::vector<std::string> scripts;
         std::string output_dir = "python_analysis";
         std::map<std::string, std::string> args;
+        bool use_worker = true;  // Persistent worker; falls back to one process per script
     } python;
 
     // Julia EFA configuration
@@ -113,12 +115,14 @@ public:
      * @param engine_id Engine to analyze
      * @param script_name Python script to run (e.g., "analyze_igsoa_state.py")
      * @param args Script arguments
+     * @param use_worker Run in the persistent analysis worker when available
      * @return Python analysis result
      */
     python::PythonAnalysisResult quickPythonAnalysis(
         const std::string& engine_id,
         const std::string& script_name,
-        const std::map<std::string, std::string>& args
+        const std::map<std::string, std::string>& args,
+        bool use_worker = true
     );
 
     /**
@@ -126,11 +130,13 @@ public:
      *
      * @param engine_id Engine to analyze
      * @param field_name Field to analyze (e.g., "psi_real", "phi")
+     * @param peak_options Peak search for the result's peaks
      * @return FFT result
      */
     analysis::FFTResult quickFFT(
         const std::string& engine_id,
-        const std::string& field_name
+        const std::string& field_name,
+        const analysis::FFTPeakOptions& peak_options = analysis::FFTPeakOptions()
     );
 
     /**
@@ -150,9 +156,29 @@ public:
 private:
     EngineManager* engine_manager_;
 
+    // Persistent Python worker, started on first use
+    std::unique_ptr<python::AnalysisWorker> python_worker_;
+    bool python_worker_failed_ = false;
+
     // Extract engine state to JSON for analysis
     nlohmann::json extractEngineState(const std::string& engine_id);
 
+    // Engine identity, dimensions and config (extractEngineState without arrays)
+    nlohmann::json extractEngineMetadata(const std::string& engine_id);
+
+    // Write engine fields to a binary state file; returns its descriptor
+    nlohmann::json writeBinaryStateFile(const std::string& engine_id);
+
+    // Worker for this session, or nullptr if it cannot be started
+    python::AnalysisWorker* pythonWorker();
+
+    // Run one script in the worker; false means fall back to runAnalysisScript
+    bool runInWorker(
+        const nlohmann::json& state_descriptor,
+        const python::PythonAnalysisConfig& config,
+        python::PythonAnalysisResult& result
+    );
+
     // Run Python analysis
     void runPythonAnalysis(
         const std::string& engine_id,
@@ -0,0 +1,379 @@
+/**
+ * Analysis Worker Implementation
+ */
+
+#include "analysis_worker.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace dase {
+namespace python {
+
+namespace {
+
+// First ping also covers interpreter startup and numpy import
+constexpr int kStartupTimeoutMs = 30000;
+
+} // namespace
+
+AnalysisWorker::AnalysisWorker(const std::string& executable, const std::string& worker_script)
+    : executable_(executable)
+    , worker_script_(worker_script)
+    , next_id_(1)
+#ifdef _WIN32
+    , process_(nullptr)
+    , stdin_write_(nullptr)
+    , stdout_read_(nullptr)
+#else
+    , pid_(-1)
+    , stdin_write_(-1)
+    , stdout_read_(-1)
+#endif
+{
+}
+
+AnalysisWorker::~AnalysisWorker() {
+    if (running()) {
+        writeLine("{\"op\":\"shutdown\"}");
+    }
+    stop();
+}
+
+std::string AnalysisWorker::findWorkerScript() {
+    if (const char* env = std::getenv("DASE_ANALYSIS_WORKER")) {
+        if (fs::exists(env)) {
+            return env;
+        }
+    }
+
+    std::error_code ec;
+    fs::path dir = fs::current_path(ec);
+    for (int level = 0; level < 4 && !dir.empty(); level++) {
+        fs::path candidate = dir / "analysis" / "analysis_worker.py";
+        if (fs::exists(candidate, ec)) {
+            return candidate.string();
+        }
+        if (dir == dir.parent_path()) {
+            break;
+        }
+        dir = dir.parent_path();
+    }
+    return "";
+}
+
+nlohmann::json AnalysisWorker::writeStateFile(
+    const std::string& path,
+    const std::vector<std::pair<std::string, const std::vector<double>*>>& fields,
+    const nlohmann::json& meta
+) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return nullptr;
+    }
+
+    nlohmann::json descriptor_fields = nlohmann::json::object();
+    uint64_t offset = 0;
+    for (const auto& [name, values] : fields) {
+        descriptor_fields[name] = {{"offset", offset}, {"count", values->size()}};
+        out.write(reinterpret_cast<const char*>(values->data()),
+                  static_cast<std::streamsize>(values->size() * sizeof(double)));
+        offset += values->size() * sizeof(double);
+    }
+    out.close();
+    if (out.fail()) {
+        return nullptr;
+    }
+
+    return {
+        {"path", path},
+        {"dtype", "float64"},
+        {"fields", descriptor_fields},
+        {"meta", meta}
+    };
+}
+
+bool AnalysisWorker::call(nlohmann::json request, nlohmann::json& response, int timeout_ms, std::string& error) {
+    if (!ensureStarted()) {
+        error = "Analysis worker could not be started (" + executable_ + " " + worker_script_ + ")";
+        return false;
+    }
+
+    const uint64_t id = next_id_++;
+    request["id"] = id;
+    if (!writeLine(request.dump())) {
+        stop();
+        error = "Analysis worker closed its input";
+        return false;
+    }
+
+    std::string line;
+    while (readLine(line, timeout_ms)) {
+        try {
+            response = nlohmann::json::parse(line);
+        } catch (const nlohmann::json::parse_error&) {
+            continue;  // Stray output from an analysis library
+        }
+        if (response.value("id", uint64_t(0)) == id) {
+            return true;
+        }
+    }
+
+    stop();
+    error = "Analysis worker did not respond (exited or timed out)";
+    return false;
+}
+
+bool AnalysisWorker::writeLine(const std::string& line) {
+    const std::string data = line + "\n";
+#ifdef _WIN32
+    DWORD written = 0;
+    return WriteFile(stdin_write_, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) &&
+           written == data.size();
+#else
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::write(stdin_write_, data.data() + sent, data.size() - sent);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+#endif
+}
+
+bool AnalysisWorker::readLine(std::string& line, int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    while (true) {
+        size_t newline = read_buffer_.find('\n');
+        if (newline != std::string::npos) {
+            line = read_buffer_.substr(0, newline);
+            read_buffer_.erase(0, newline + 1);
+            return true;
+        }
+
+        int wait_ms = -1;
+        if (timeout_ms > 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) {
+                return false;
+            }
+            wait_ms = static_cast<int>(remaining);
+        }
+
+        char chunk[4096];
+#ifdef _WIN32
+        // Poll so the timeout applies; ReadFile on an anonymous pipe cannot time out
+        DWORD available = 0;
+        if (!PeekNamedPipe(stdout_read_, nullptr, 0, nullptr, &available, nullptr)) {
+            return false;
+        }
+        if (available == 0) {
+            Sleep(1);
+            continue;
+        }
+        DWORD n = 0;
+        if (!ReadFile(stdout_read_, chunk, sizeof(chunk), &n, nullptr) || n == 0) {
+            return false;
+        }
+#else
+        pollfd pfd = {stdout_read_, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, wait_ms);
+        if (ready <= 0) {
+            return false;
+        }
+        ssize_t n = ::read(stdout_read_, chunk, sizeof(chunk));
+        if (n <= 0) {
+            return false;
+        }
+#endif
+        read_buffer_.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+#ifdef _WIN32
+
+bool AnalysisWorker::running() const {
+    if (!process_) {
+        return false;
+    }
+    DWORD code = 0;
+    return GetExitCodeProcess(process_, &code) && code == STILL_ACTIVE;
+}
+
+bool AnalysisWorker::ensureStarted() {
+    if (running()) {
+        return true;
+    }
+    stop();
+    if (worker_script_.empty()) {
+        return false;
+    }
+
+    SECURITY_ATTRIBUTES sa = {sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+    HANDLE child_stdin_read = nullptr, child_stdout_write = nullptr;
+    if (!CreatePipe(&child_stdin_read, &stdin_write_, &sa, 0)) {
+        return false;
+    }
+    if (!CreatePipe(&stdout_read_, &child_stdout_write, &sa, 0)) {
+        CloseHandle(child_stdin_read);
+        stop();
+        return false;
+    }
+    // Parent ends must not leak into the child
+    SetHandleInformation(stdin_write_, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(stdout_read_, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFOA si = {};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = child_stdin_read;
+    si.hStdOutput = child_stdout_write;
+    si.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+    std::string cmd = "\"" + executable_ + "\" -u \"" + worker_script_ + "\"";
+    PROCESS_INFORMATION pi = {};
+    BOOL created = CreateProcessA(nullptr, &cmd[0], nullptr, nullptr, TRUE,
+                                  CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi);
+    CloseHandle(child_stdin_read);
+    CloseHandle(child_stdout_write);
+    if (!created) {
+        stop();
+        return false;
+    }
+    CloseHandle(pi.hThread);
+    process_ = pi.hProcess;
+
+    std::string line;
+    if (!writeLine("{\"op\":\"ping\",\"id\":0}") || !readLine(line, kStartupTimeoutMs)) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void AnalysisWorker::stop() {
+    if (stdin_write_) {
+        CloseHandle(stdin_write_);
+        stdin_write_ = nullptr;
+    }
+    if (process_) {
+        if (WaitForSingleObject(process_, 2000) == WAIT_TIMEOUT) {
+            TerminateProcess(process_, 1);
+        }
+        CloseHandle(process_);
+        process_ = nullptr;
+    }
+    if (stdout_read_) {
+        CloseHandle(stdout_read_);
+        stdout_read_ = nullptr;
+    }
+    read_buffer_.clear();
+}
+
+#else
+
+bool AnalysisWorker::running() const {
+    if (pid_ <= 0) {
+        return false;
+    }
+    int status = 0;
+    return ::waitpid(pid_, &status, WNOHANG) == 0;
+}
+
+bool AnalysisWorker::ensureStarted() {
+    if (running()) {
+        return true;
+    }
+    stop();
+    if (worker_script_.empty()) {
+        return false;
+    }
+
+    // A dead worker must fail writes, not kill the CLI
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int to_child[2], from_child[2];
+    if (::pipe(to_child) != 0) {
+        return false;
+    }
+    if (::pipe(from_child) != 0) {
+        ::close(to_child[0]);
+        ::close(to_child[1]);
+        return false;
+    }
+
+    pid_ = ::fork();
+    if (pid_ == 0) {
+        ::dup2(to_child[0], STDIN_FILENO);
+        ::dup2(from_child[1], STDOUT_FILENO);
+        ::close(to_child[0]);
+        ::close(to_child[1]);
+        ::close(from_child[0]);
+        ::close(from_child[1]);
+        ::execlp(executable_.c_str(), executable_.c_str(), "-u", worker_script_.c_str(), (char*)nullptr);
+        ::_exit(127);
+    }
+
+    ::close(to_child[0]);
+    ::close(from_child[1]);
+    if (pid_ < 0) {
+        ::close(to_child[1]);
+        ::close(from_child[0]);
+        return false;
+    }
+    stdin_write_ = to_child[1];
+    stdout_read_ = from_child[0];
+    ::fcntl(stdin_write_, F_SETFD, FD_CLOEXEC);
+    ::fcntl(stdout_read_, F_SETFD, FD_CLOEXEC);
+
+    std::string line;
+    if (!writeLine("{\"op\":\"ping\",\"id\":0}") || !readLine(line, kStartupTimeoutMs)) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void AnalysisWorker::stop() {
+    if (stdin_write_ >= 0) {
+        ::close(stdin_write_);
+        stdin_write_ = -1;
+    }
+    if (pid_ > 0) {
+        // Closing stdin ends the worker's read loop; give it a moment before killing
+        int status = 0;
+        for (int i = 0; i < 200 && ::waitpid(pid_, &status, WNOHANG) == 0; i++) {
+            ::usleep(10000);
+        }
+        if (::waitpid(pid_, &status, WNOHANG) == 0) {
+            ::kill(pid_, SIGKILL);
+            ::waitpid(pid_, &status, 0);
+        }
+        pid_ = -1;
+    }
+    if (stdout_read_ >= 0) {
+        ::close(stdout_read_);
+        stdout_read_ = -1;
+    }
+    read_buffer_.clear();
+}
+
+#endif
+
+} // namespace python
+} // namespace dase
@@ -0,0 +1,104 @@
+/**
+ * Analysis Worker - Long-lived analysis interpreter fed over pipes
+ *
+ * Starts analysis/analysis_worker.py once and exchanges one JSON line per
+ * request/response over its stdin/stdout, so python_analyze skips
+ * interpreter startup and package imports on every call. Engine state is
+ * handed over as a raw float64 file described in the request (see
+ * writeStateFile), not as JSON.
+ *
+ * A worker that exits or times out is stopped; the next call starts a
+ * fresh one.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#endif
+
+namespace dase {
+namespace python {
+
+class AnalysisWorker {
+public:
+    AnalysisWorker(const std::string& executable, const std::string& worker_script);
+    ~AnalysisWorker();
+
+    AnalysisWorker(const AnalysisWorker&) = delete;
+    AnalysisWorker& operator=(const AnalysisWorker&) = delete;
+
+    /**
+     * Start the worker if it is not running
+     *
+     * @return true once the worker answered a ping
+     */
+    bool ensureStarted();
+
+    /**
+     * Send one request and wait for its response
+     *
+     * @param request JSON request (an "id" is assigned)
+     * @param response Parsed response line
+     * @param timeout_ms Give up (and stop the worker) after this long; <= 0 waits forever
+     * @param error Failure description
+     * @return false if the worker could not be reached or did not answer
+     */
+    bool call(nlohmann::json request, nlohmann::json& response, int timeout_ms, std::string& error);
+
+    bool running() const;
+    void stop();
+
+    const std::string& script() const { return worker_script_; }
+
+    /**
+     * Locate analysis_worker.py: $DASE_ANALYSIS_WORKER, then analysis/ in the
+     * working directory and its parents
+     *
+     * @return Path, or empty if not found
+     */
+    static std::string findWorkerScript();
+
+    /**
+     * Write named float64 arrays to a binary state file
+     *
+     * @param path Output file
+     * @param fields (name, values) pairs, written back to back
+     * @param meta Metadata forwarded to the script (engine_id, dimensions, ...)
+     * @return State descriptor for a "run" request, or null on write failure
+     */
+    static nlohmann::json writeStateFile(
+        const std::string& path,
+        const std::vector<std::pair<std::string, const std::vector<double>*>>& fields,
+        const nlohmann::json& meta
+    );
+
+private:
+    bool writeLine(const std::string& line);
+    bool readLine(std::string& line, int timeout_ms);
+
+    std::string executable_;
+    std::string worker_script_;
+    std::string read_buffer_;
+    uint64_t next_id_;
+
+#ifdef _WIN32
+    HANDLE process_;
+    HANDLE stdin_write_;
+    HANDLE stdout_read_;
+#else
+    pid_t pid_;
+    int stdin_write_;
+    int stdout_read_;
+#endif
+};
+
+} // namespace python
+} // namespace dase
@@ -0,0 +1,163 @@
+/**
+ * Command Parser - Implementation
+ */
+
+#include "command_parser.h"
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <utility>
+
+using json = nlohmann::json;
+
+namespace dase {
+
+namespace {
+
+constexpr char kPlaceholderPrefix[] = "\x01packed:";
+
+bool isJsonSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// line[open] == '['. If the array holds at least kPackedArrayElements
+// numbers and nothing else, parse them into packed (native float64) and
+// set close to the matching ']'. Anything unusual returns false and is
+// left to json::parse.
+bool scanNumericArray(const std::string& line, size_t open, size_t& close, std::vector<std::uint8_t>& packed) {
+    const char* const begin = line.data();
+    const char* const end = begin + line.size();
+    const char* p = begin + open + 1;
+    std::vector<double> values;
+    while (true) {
+        while (p < end && isJsonSpace(*p)) p++;
+        if (p == end || !(*p == '-' || (*p >= '0' && *p <= '9'))) {
+            return false;
+        }
+        double value;
+        const std::from_chars_result parsed = std::from_chars(p, end, value);
+        if (parsed.ec != std::errc()) {
+            return false;
+        }
+        values.push_back(value);
+        p = parsed.ptr;
+        while (p < end && isJsonSpace(*p)) p++;
+        if (p < end && *p == ',') {
+            p++;
+            continue;
+        }
+        if (p < end && *p == ']') {
+            break;
+        }
+        return false;
+    }
+    if (values.size() < kPackedArrayElements) {
+        return false;
+    }
+    packed.resize(values.size() * sizeof(double));
+    std::memcpy(packed.data(), values.data(), packed.size());
+    close = static_cast<size_t>(p - begin);
+    return true;
+}
+
+// Copy of line with each long numeric array replaced by the string
+// "\u0001packed:<k>"; false if there was none
+bool extractNumericArrays(const std::string& line, std::string& reduced,
+                          std::vector<std::vector<std::uint8_t>>& arrays) {
+    size_t copied = 0;
+    bool in_string = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        const char c = line[i];
+        if (in_string) {
+            if (c == '\\') {
+                i++;
+            } else if (c == '"') {
+                in_string = false;
+            }
+            continue;
+        }
+        if (c == '"') {
+            in_string = true;
+            continue;
+        }
+        if (c != '[') {
+            continue;
+        }
+        std::vector<std::uint8_t> packed;
+        size_t close = 0;
+        if (!scanNumericArray(line, i, close, packed)) {
+            continue;
+        }
+        if (arrays.empty()) {
+            reduced.reserve(line.size() / 4);
+        }
+        reduced.append(line, copied, i - copied);
+        reduced += "\"\\u0001packed:" + std::to_string(arrays.size()) + "\"";
+        arrays.push_back(std::move(packed));
+        copied = close + 1;
+        i = close;
+    }
+    if (arrays.empty()) {
+        return false;
+    }
+    reduced.append(line, copied, std::string::npos);
+    return true;
+}
+
+void restoreNumericArrays(json& value, std::vector<std::vector<std::uint8_t>>& arrays) {
+    if (value.is_structured()) {
+        for (json& element : value) restoreNumericArrays(element, arrays);
+        return;
+    }
+    if (!value.is_string()) {
+        return;
+    }
+    const std::string& text = value.get_ref<const std::string&>();
+    const size_t prefix = sizeof(kPlaceholderPrefix) - 1;
+    if (text.size() <= prefix || text.compare(0, prefix, kPlaceholderPrefix) != 0) {
+        return;
+    }
+    size_t index = 0;
+    const std::from_chars_result parsed = std::from_chars(text.data() + prefix, text.data() + text.size(), index);
+    if (parsed.ec == std::errc() && parsed.ptr == text.data() + text.size() && index < arrays.size()) {
+        value = json::binary(std::move(arrays[index]), kPackedArraySubtype);
+    }
+}
+
+} // namespace
+
+json parseCommand(const std::string& line) {
+    std::string reduced;
+    std::vector<std::vector<std::uint8_t>> arrays;
+    if (line.size() < kScanLineBytes || !extractNumericArrays(line, reduced, arrays)) {
+        return json::parse(line);
+    }
+    json command = json::parse(reduced);
+    restoreNumericArrays(command, arrays);
+    return command;
+}
+
+bool readNumbers(const json& value, std::vector<double>& out) {
+    if (value.is_binary()) {
+        const json::binary_t& packed = value.get_binary();
+        if (!packed.has_subtype() || packed.subtype() != kPackedArraySubtype) {
+            return false;
+        }
+        out.resize(packed.size() / sizeof(double));
+        if (!out.empty()) std::memcpy(out.data(), packed.data(), out.size() * sizeof(double));
+        return true;
+    }
+    if (!value.is_array()) {
+        return false;
+    }
+    out.resize(value.size());
+    for (size_t i = 0; i < value.size(); i++) {
+        if (!value[i].is_number()) {
+            return false;
+        }
+        out[i] = value[i].get<double>();
+    }
+    return true;
+}
+
+} // namespace dase
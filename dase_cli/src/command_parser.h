@@ -0,0 +1,40 @@
+/**
+ * Command Parser - JSON command lines with a fast path for numeric arrays
+ *
+ * json::parse lexes every number of a line into a DOM element, which is
+ * by far the largest cost of a command carrying node values. Lines of at
+ * least kScanLineBytes are first scanned for arrays of at least
+ * kPackedArrayElements numbers and nothing else; those are parsed with
+ * std::from_chars straight into one packed binary value (subtype
+ * kPackedArraySubtype, float64 in host byte order). Only the rest of the
+ * line goes through json::parse. Any array the scan is unsure about
+ * (mixed elements, malformed numbers) is left to json::parse, which also
+ * reports the errors.
+ *
+ * Handlers read numeric arrays with readNumbers(), which accepts both the
+ * packed form and a plain json array, so payloads such as
+ * set_igsoa_state's "custom" profile are copied straight into engine
+ * buffers. Integers in a packed array are converted to double.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+
+constexpr size_t kScanLineBytes = 4096;
+constexpr size_t kPackedArrayElements = 256;
+constexpr std::uint8_t kPackedArraySubtype = 0xD0;
+
+// Parse one command line; throws nlohmann::json::parse_error on bad input
+nlohmann::json parseCommand(const std::string& line);
+
+// Numeric array value (packed or plain) into out; false if value is neither
+bool readNumbers(const nlohmann::json& value, std::vector<double>& out);
+
+} // namespace dase
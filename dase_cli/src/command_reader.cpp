@@ -0,0 +1,104 @@
+/**
+ * Command Reader - Implementation
+ */
+
+#include "command_reader.h"
+#include "command_parser.h"
+
+using json = nlohmann::json;
+
+CommandReader::CommandReader(std::istream& input_stream, bool pipelined, size_t queue_depth)
+    : input(input_stream) {
+    if (pipelined) {
+        pipeline = std::make_shared<Pipeline>();
+        pipeline->depth = queue_depth > 0 ? queue_depth : 1;
+        reader = std::thread(readerLoop, std::ref(input), pipeline);
+    }
+}
+
+CommandReader::~CommandReader() {
+    if (!pipeline) {
+        return;
+    }
+    bool finished;
+    {
+        std::lock_guard<std::mutex> lock(pipeline->mutex);
+        pipeline->stopping = true;
+        finished = pipeline->finished;
+    }
+    pipeline->not_full.notify_all();
+    // A reader still blocked in getline() keeps its own reference to the
+    // queue state and exits at the next line or end of input
+    if (finished) {
+        reader.join();
+    } else {
+        reader.detach();
+    }
+}
+
+bool CommandReader::readItem(std::istream& input, Item& item) {
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+        item.parse_error.clear();
+        try {
+            item.command = dase::parseCommand(line);
+        } catch (const json::exception& e) {
+            item.command = nullptr;
+            item.parse_error = e.what();
+        }
+        return true;
+    }
+    return false;
+}
+
+void CommandReader::readerLoop(std::istream& input, std::shared_ptr<Pipeline> pipeline) {
+    Item item;
+    while (readItem(input, item)) {
+        std::unique_lock<std::mutex> lock(pipeline->mutex);
+        pipeline->not_full.wait(lock, [&] {
+            return pipeline->stopping || pipeline->queue.size() < pipeline->depth;
+        });
+        if (pipeline->stopping) {
+            break;
+        }
+        pipeline->queue.push_back(std::move(item));
+        lock.unlock();
+        pipeline->not_empty.notify_one();
+    }
+    {
+        std::lock_guard<std::mutex> lock(pipeline->mutex);
+        pipeline->finished = true;
+    }
+    pipeline->not_empty.notify_all();
+}
+
+bool CommandReader::next(Item& item) {
+    if (!pipeline) {
+        return readItem(input, item);
+    }
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    pipeline->not_empty.wait(lock, [&] { return !pipeline->queue.empty() || pipeline->finished; });
+    if (pipeline->queue.empty()) {
+        return false;
+    }
+    item = std::move(pipeline->queue.front());
+    pipeline->queue.pop_front();
+    lock.unlock();
+    pipeline->not_full.notify_one();
+    return true;
+}
+
+bool CommandReader::inputPending() {
+    if (pipeline) {
+        std::lock_guard<std::mutex> lock(pipeline->mutex);
+        return !pipeline->queue.empty();
+    }
+    // Bytes already in the stream buffer (0 when stdin is synced with stdio)
+    return input.rdbuf()->in_avail() > 0;
+}
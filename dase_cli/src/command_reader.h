@@ -0,0 +1,64 @@
+/**
+ * Command Reader - Reads and parses JSON command lines from a stream
+ *
+ * In the default mode next() reads and parses one line when it is called.
+ * In pipelined mode a background thread reads and parses ahead into a
+ * bounded queue, so parsing command N+1 overlaps the execution of command
+ * N. Commands are delivered in input order in both modes; a line that
+ * fails to parse is delivered as an item carrying the parse error. Lines
+ * are parsed by dase::parseCommand (command_parser.h).
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "json.hpp"
+
+class CommandReader {
+public:
+    struct Item {
+        nlohmann::json command;
+        std::string parse_error;   // non-empty if the line was not valid JSON
+    };
+
+    // pipelined: parse ahead on a thread, up to queue_depth commands
+    CommandReader(std::istream& input, bool pipelined, size_t queue_depth = 256);
+    ~CommandReader();
+
+    CommandReader(const CommandReader&) = delete;
+    CommandReader& operator=(const CommandReader&) = delete;
+
+    // Next command in input order; false at end of input
+    bool next(Item& item);
+
+    // True if another command is already buffered, so next() will not wait
+    // on the input (used to flush responses once per burst of commands)
+    bool inputPending();
+
+private:
+    // Queue state, shared with the reader thread so that it can be detached
+    // if the reader is destroyed while blocked on the input
+    struct Pipeline {
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::deque<Item> queue;
+        size_t depth = 0;
+        bool finished = false;
+        bool stopping = false;
+    };
+
+    static bool readItem(std::istream& input, Item& item);
+    static void readerLoop(std::istream& input, std::shared_ptr<Pipeline> pipeline);
+
+    std::istream& input;
+    std::shared_ptr<Pipeline> pipeline;   // null unless pipelined
+    std::thread reader;
+};
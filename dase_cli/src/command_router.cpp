@@ -7,15 +7,645 @@
 #include "../../src/cpp/satp_higgs_engine_1d.h"
 #include "../../src/cpp/satp_higgs_engine_2d.h"
 #include "../../src/cpp/satp_higgs_engine_3d.h"
+#include "../../src/cpp/numa_memory.h"
+#include "../../src/cpp/out_of_core.h"
 #include "analysis_router.h"
 #include "python_bridge.h"
 #include "engine_fft_analysis.h"
+#include "snapshot_stream_writer.h"
+#include "mission_pipeline.h"
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+namespace fs = std::filesystem;
 
 // Global analysis router (initialized after engine_manager)
 static std::unique_ptr<dase::AnalysisRouter> g_analysis_router;
 
+namespace {
+
+/**
+ * Binary state channel: raw float64 arrays in a file, described in the JSON
+ * response ({path, dtype, byte_order, shape, fields{name: {offset, count}}}),
+ * so clients can mmap or read the arrays instead of parsing number text.
+ */
+class BinaryStateFile {
+public:
+    // Empty path picks <temp>/dase_state/<tag>_<timestamp>.bin
+    BinaryStateFile(const std::string& path, const std::string& tag) {
+        if (path.empty()) {
+            fs::path temp_dir = fs::temp_directory_path() / "dase_state";
+            fs::create_directories(temp_dir);
+            auto timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+            file_path = (temp_dir / (tag + "_" + std::to_string(timestamp) + ".bin")).string();
+        } else {
+            file_path = path;
+        }
+        out.open(file_path, std::ios::binary | std::ios::trunc);
+    }
+
+    bool ok() const { return static_cast<bool>(out); }
+
+    // Append one array (double or float); returns its descriptor
+    template<typename T>
+    json append(const std::vector<T>& values) {
+        json field = {
+            {"offset", bytes_written},
+            {"count", values.size()}
+        };
+        out.write(reinterpret_cast<const char*>(values.data()),
+                  static_cast<std::streamsize>(values.size() * sizeof(T)));
+        bytes_written += values.size() * sizeof(T);
+        return field;
+    }
+
+    // Flush and describe the file (call after the last append)
+    json finish(const json& shape, const std::string& dtype = "float64") {
+        out.close();
+        return {
+            {"path", file_path},
+            {"dtype", dtype},
+            {"byte_order", "little"},
+            {"shape", shape},
+            {"bytes", bytes_written}
+        };
+    }
+
+private:
+    std::string file_path;
+    std::ofstream out;
+    uint64_t bytes_written = 0;
+};
+
+// Row-major array shape for an engine's node arrays ([N_z,] N_y, N_x or [num_nodes])
+json stateShape(EngineInstance* instance, size_t num_nodes) {
+    if (instance && instance->dimension_x > 0 && instance->dimension_y > 0) {
+        if (instance->dimension_z > 0) {
+            return json::array({instance->dimension_z, instance->dimension_y, instance->dimension_x});
+        }
+        return json::array({instance->dimension_y, instance->dimension_x});
+    }
+    return json::array({num_nodes});
+}
+
+bool wantsBinaryTransfer(const json& params) {
+    return params.value("transfer", std::string("json")) == "binary";
+}
+
+/**
+ * Optional snapshot selection: "roi" {x0, y0, z0, nx, ny, nz}, "stride",
+ * "fields" (subset of "psi", "F", "phi") and "dtype" ("float64"/"float32").
+ * Extraction happens on the engine lattice, so unselected data is never copied.
+ */
+struct StateSelection {
+    bool active = false;
+    dase::igsoa::StateRegion region;
+    uint32_t field_mask = dase::igsoa::STATE_FIELD_PSI | dase::igsoa::STATE_FIELD_PHI;
+    bool float32 = false;
+    json shape;
+};
+
+bool parseStateSelection(const json& params, const EngineInstance* instance,
+                         StateSelection& selection, std::string& error) {
+    selection.active = params.contains("roi") || params.contains("stride") ||
+                       params.contains("fields") || params.contains("dtype");
+    if (!selection.active) {
+        return true;
+    }
+    if (!instance) {
+        error = "Engine not found";
+        return false;
+    }
+
+    // Lattice extents (1D engines report only num_nodes)
+    const size_t N_x = instance->dimension_x > 0 ? instance->dimension_x : instance->num_nodes;
+    const size_t N_y = instance->dimension_y > 0 ? instance->dimension_y : 1;
+    const size_t N_z = instance->dimension_z > 0 ? instance->dimension_z : 1;
+    const int ndim = instance->dimension_z > 0 ? 3 : (instance->dimension_y > 0 ? 2 : 1);
+
+    auto& region = selection.region;
+    region = dase::igsoa::StateRegion::full(N_x, N_y, N_z);
+    if (params.contains("roi")) {
+        const json& roi = params["roi"];
+        region.x0 = roi.value("x0", size_t(0));
+        region.y0 = roi.value("y0", size_t(0));
+        region.z0 = roi.value("z0", size_t(0));
+        region.nx = roi.value("nx", N_x - std::min(N_x, region.x0));
+        region.ny = roi.value("ny", N_y - std::min(N_y, region.y0));
+        region.nz = roi.value("nz", N_z - std::min(N_z, region.z0));
+    }
+    region.stride = params.value("stride", size_t(1));
+    if (!region.fits(N_x, N_y, N_z)) {
+        error = "roi/stride outside the lattice";
+        return false;
+    }
+
+    if (params.contains("fields")) {
+        selection.field_mask = 0;
+        for (const auto& field : params["fields"]) {
+            const std::string name = field.get<std::string>();
+            if (name == "psi") selection.field_mask |= dase::igsoa::STATE_FIELD_PSI;
+            else if (name == "F") selection.field_mask |= dase::igsoa::STATE_FIELD_F;
+            else if (name == "phi") selection.field_mask |= dase::igsoa::STATE_FIELD_PHI;
+            else {
+                error = "Unknown field: " + name + " (expected psi, F or phi)";
+                return false;
+            }
+        }
+        if (selection.field_mask == 0) {
+            error = "fields must name at least one of psi, F, phi";
+            return false;
+        }
+    }
+
+    const std::string dtype = params.value("dtype", std::string("float64"));
+    if (dtype != "float64" && dtype != "float32") {
+        error = "dtype must be float64 or float32";
+        return false;
+    }
+    selection.float32 = dtype == "float32";
+
+    selection.shape = json::array();
+    if (ndim == 3) selection.shape.push_back(region.outZ());
+    if (ndim >= 2) selection.shape.push_back(region.outY());
+    selection.shape.push_back(region.outX());
+    return true;
+}
+
+// Selected fields as JSON arrays, or as descriptors into binary when given
+template<typename T>
+bool captureSelectionAs(EngineManager& manager, const std::string& engine_id,
+                        const StateSelection& selection, BinaryStateFile* binary, json& fields) {
+    std::vector<T> psi_real, psi_imag, F, phi;
+    if (!manager.getRegionStates(engine_id, selection.region, selection.field_mask,
+                                 psi_real, psi_imag, F, phi)) {
+        return false;
+    }
+
+    fields = json::object();
+    auto emit = [&](const char* name, const std::vector<T>& values) {
+        fields[name] = binary ? binary->append(values) : json(values);
+    };
+    if (selection.field_mask & dase::igsoa::STATE_FIELD_PSI) {
+        emit("psi_real", psi_real);
+        emit("psi_imag", psi_imag);
+    }
+    if (selection.field_mask & dase::igsoa::STATE_FIELD_F) {
+        emit("F", F);
+    }
+    if (selection.field_mask & dase::igsoa::STATE_FIELD_PHI) {
+        emit("phi", phi);
+    }
+    return true;
+}
+
+bool captureSelection(EngineManager& manager, const std::string& engine_id,
+                      const StateSelection& selection, BinaryStateFile* binary, json& fields) {
+    return selection.float32
+        ? captureSelectionAs<float>(manager, engine_id, selection, binary, fields)
+        : captureSelectionAs<double>(manager, engine_id, selection, binary, fields);
+}
+
+json selectionDescriptor(const StateSelection& selection) {
+    const auto& region = selection.region;
+    return {
+        {"roi", {{"x0", region.x0}, {"y0", region.y0}, {"z0", region.z0},
+                 {"nx", region.nx}, {"ny", region.ny}, {"nz", region.nz}}},
+        {"stride", region.stride},
+        {"shape", selection.shape},
+        {"dtype", selection.float32 ? "float32" : "float64"}
+    };
+}
+
+// run_mission "checkpoint": {"every_steps", "directory", "prefix", "keep",
+// "max_mb_per_s", "fsync"} starts (or changes) background checkpointing,
+// false stops it; an absent key leaves the current setting alone
+bool applyCheckpointParams(EngineManager& manager, const std::string& engine_id,
+                           const json& params, std::string& error) {
+    if (!params.contains("checkpoint")) {
+        return true;
+    }
+    const json& cfg = params["checkpoint"];
+    if (cfg.is_boolean() && !cfg.get<bool>()) {
+        manager.disableCheckpoints(engine_id);
+        return true;
+    }
+    if (!cfg.is_object()) {
+        error = "checkpoint must be an object or false";
+        return false;
+    }
+
+    dase::CheckpointPolicy policy;
+    policy.directory = cfg.value("directory", std::string("checkpoints"));
+    policy.prefix = cfg.value("prefix", engine_id);
+    policy.keep_last = cfg.value("keep", size_t(2));
+    policy.max_write_mb_per_s = cfg.value("max_mb_per_s", 0.0);
+    policy.fsync = cfg.value("fsync", true);
+    const int every_steps = cfg.value("every_steps", 0);
+
+    // Same settings as the running checkpointer: keep it (and its history)
+    auto* instance = manager.getEngine(engine_id);
+    if (instance && instance->checkpointer && instance->checkpoint_every_steps == every_steps) {
+        const auto& current = instance->checkpointer->policy();
+        if (current.directory == policy.directory && current.prefix == policy.prefix &&
+            current.keep_last == policy.keep_last && current.fsync == policy.fsync &&
+            current.max_write_mb_per_s == policy.max_write_mb_per_s) {
+            return true;
+        }
+    }
+    return manager.configureCheckpoints(engine_id, policy, every_steps, error);
+}
+
+// run_mission "perf_counters": true or {"peak_ipc", "peak_dram_gb_per_s",
+// "reset"} counts hardware events around this and later missions, false
+// stops it; an absent key leaves the current setting alone
+bool applyPerfCounterParams(EngineManager& manager, const std::string& engine_id,
+                            const json& params, std::string& error) {
+    if (!params.contains("perf_counters")) {
+        return true;
+    }
+    const json& cfg = params["perf_counters"];
+    if (cfg.is_boolean()) {
+        if (!cfg.get<bool>()) {
+            manager.disablePerfCounters(engine_id);
+            return true;
+        }
+        return manager.enablePerfCounters(engine_id, 0.0, 0.0, false);
+    }
+    if (!cfg.is_object()) {
+        error = "perf_counters must be an object or a boolean";
+        return false;
+    }
+    const double peak_ipc = cfg.value("peak_ipc", 0.0);
+    const double peak_dram = cfg.value("peak_dram_gb_per_s", 0.0);
+    if (peak_ipc < 0.0 || peak_dram < 0.0) {
+        error = "perf_counters peaks must be non-negative";
+        return false;
+    }
+    return manager.enablePerfCounters(engine_id, peak_ipc, peak_dram, cfg.value("reset", false));
+}
+
+// Counts (null when the event is unavailable) and derived figures; the
+// peak fractions appear when the peaks are set
+json perfSampleJson(const dase::PerfCounterSample& sample, double peak_ipc, double peak_dram_gb_per_s) {
+    json out = {{"wall_ns", sample.wall_ns}, {"multiplexed", sample.multiplexed}};
+    for (size_t e = 0; e < dase::kPerfEventCount; e++) {
+        const auto event = static_cast<dase::PerfEvent>(e);
+        out[dase::perfEventName(event)] = sample.has(event) ? json(sample.value(event)) : json(nullptr);
+    }
+    auto derived = [](double v) { return v >= 0.0 ? json(v) : json(nullptr); };
+    const double ipc = sample.ipc();
+    const double dram = sample.dramGBPerSecond();
+    out["ipc"] = derived(ipc);
+    out["llc_miss_ratio"] = derived(sample.llcMissRatio());
+    out["vector_instructions_per_cycle"] = derived(sample.vectorInstructionsPerCycle());
+    out["vector_instructions_per_dram_byte"] = derived(sample.vectorInstructionsPerByte());
+    out["dram_gb_per_s"] = derived(dram);
+    out["average_parallelism"] = derived(sample.averageParallelism());
+    if (peak_ipc > 0.0) {
+        out["ipc_fraction_of_peak"] = derived(ipc >= 0.0 ? ipc / peak_ipc : -1.0);
+    }
+    if (peak_dram_gb_per_s > 0.0) {
+        out["dram_fraction_of_peak"] = derived(dram >= 0.0 ? dram / peak_dram_gb_per_s : -1.0);
+    }
+    return out;
+}
+
+json memoryAdmissionJson(const dase::MemoryAdmissionStats& stats) {
+    return {
+        {"budget_bytes", stats.budget_bytes},
+        {"reserved_bytes", stats.reserved_bytes},
+        {"peak_reserved_bytes", stats.peak_reserved_bytes},
+        {"waiting", stats.waiting},
+        {"admitted", stats.admitted},
+        {"waited", stats.waited},
+        {"rejected", stats.rejected}
+    };
+}
+
+// Memory admission of a create command: "admission" "reject" (default, a
+// create that does not fit fails) or "wait" (for up to admission_timeout_s,
+// default 60); false with error for invalid values
+bool admissionWait(const json& params, double& wait_seconds, std::string& error) {
+    wait_seconds = 0.0;
+    const std::string admission = params.value("admission", "reject");
+    if (admission != "reject" && admission != "wait") {
+        error = "Invalid admission (expected 'reject' or 'wait')";
+        return false;
+    }
+    if (admission == "wait") {
+        wait_seconds = 60.0;
+        if (params.contains("admission_timeout_s")) {
+            if (!params["admission_timeout_s"].is_number() || !(params["admission_timeout_s"].get<double>() > 0.0)) {
+                error = "Invalid admission_timeout_s (expected a number > 0)";
+                return false;
+            }
+            wait_seconds = params["admission_timeout_s"].get<double>();
+        }
+    }
+    return true;
+}
+
+json enginePoolJson(const EngineManager::EnginePoolStats& stats) {
+    const uint64_t creates = stats.hits + stats.misses;
+    return {
+        {"hits", stats.hits},
+        {"misses", stats.misses},
+        {"hit_rate", creates > 0 ? static_cast<double>(stats.hits) / creates : 0.0},
+        {"retained_engines", stats.retained_engines},
+        {"retained_bytes", stats.retained_bytes},
+        {"max_bytes", stats.max_bytes}
+    };
+}
+
+json resultCacheJson(const EngineManager& manager) {
+    const dase::ResultCacheStats stats = manager.getResultCacheStats();
+    const uint64_t lookups = stats.hits + stats.misses;
+    return {
+        {"enabled", manager.resultCacheEnabled()},
+        {"directory", manager.resultCacheDirectory()},
+        {"hits", stats.hits},
+        {"misses", stats.misses},
+        {"hit_rate", lookups > 0 ? static_cast<double>(stats.hits) / lookups : 0.0},
+        {"stores", stats.stores},
+        {"evictions", stats.evictions},
+        {"entries", stats.entries},
+        {"bytes", stats.bytes},
+        {"max_bytes", stats.max_bytes}
+    };
+}
+
+json checkpointRecordJson(const dase::CheckpointRecord& record) {
+    json entry = {
+        {"step", record.step},
+        {"path", record.path},
+        {"bytes", record.bytes},
+        {"stall_ms", record.stall_ms},
+        {"write_ms", record.write_ms},
+        {"write_mb_per_s", record.write_mb_per_s},
+        {"ok", record.ok}
+    };
+    if (!record.ok) {
+        entry["error"] = record.error;
+    }
+    return entry;
+}
+
+// Observable list of get_diagnostics / run_mission "diagnostics": true or a
+// missing value selects all, otherwise an array of names
+bool parseObservables(const json& value, std::vector<std::string>& observables, std::string& error) {
+    observables.clear();
+    if (value.is_null() || (value.is_boolean() && value.get<bool>())) {
+        return true;
+    }
+    if (!value.is_array()) {
+        error = "observables must be an array of names";
+        return false;
+    }
+    for (const auto& name : value) {
+        if (!name.is_string()) {
+            error = "observables must be an array of names";
+            return false;
+        }
+        observables.push_back(name.get<std::string>());
+    }
+    return true;
+}
+
+// record_observables "probes": [{"node" | "x", "y", "z", "field"}, ...];
+// coordinates are row-major on the engine's lattice, field defaults to psi_real
+bool parseProbes(const json& value, const EngineInstance* instance,
+                 std::vector<dase::igsoa::IGSOAProbe>& probes, std::string& error) {
+    probes.clear();
+    if (value.is_null()) {
+        return true;
+    }
+    if (!value.is_array()) {
+        error = "probes must be an array of {node | x, y, z, field} objects";
+        return false;
+    }
+    const size_t N_x = instance->dimension_x > 0 ? static_cast<size_t>(instance->dimension_x) : 0;
+    const size_t N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : 1;
+    for (const auto& entry : value) {
+        if (!entry.is_object()) {
+            error = "probes must be an array of {node | x, y, z, field} objects";
+            return false;
+        }
+        auto index = [&entry](const char* key, long long& out) {
+            if (!entry.contains(key)) return true;
+            if (!entry[key].is_number_integer() || entry[key].get<long long>() < 0) return false;
+            out = entry[key].get<long long>();
+            return true;
+        };
+        long long node = -1, x = 0, y = 0, z = 0;
+        if (!index("node", node) || !index("x", x) || !index("y", y) || !index("z", z)) {
+            error = "probe node and coordinates must be non-negative integers";
+            return false;
+        }
+        dase::igsoa::IGSOAProbe probe;
+        if (node >= 0) {
+            probe.node = static_cast<size_t>(node);
+        } else if (entry.contains("x")) {
+            if (N_x == 0 && (y != 0 || z != 0)) {
+                error = "probe coordinates y and z need a 2D or 3D engine";
+                return false;
+            }
+            if ((N_x > 0 && static_cast<size_t>(x) >= N_x) || static_cast<size_t>(y) >= N_y ||
+                (instance->dimension_z <= 0 && z != 0) ||
+                (instance->dimension_z > 0 && z >= instance->dimension_z)) {
+                error = "probe coordinates outside the lattice";
+                return false;
+            }
+            probe.node = N_x == 0 ? static_cast<size_t>(x)
+                                  : (static_cast<size_t>(z) * N_y + static_cast<size_t>(y)) * N_x +
+                                        static_cast<size_t>(x);
+        } else {
+            error = "probe needs a node or x (and y, z) coordinates";
+            return false;
+        }
+        const std::string field = entry.value("field", std::string("psi_real"));
+        if (!dase::igsoa::parseProbeField(field, probe.field)) {
+            error = "Invalid probe field (expected 'psi_real', 'psi_imag', 'phi' or 'F'): " + field;
+            return false;
+        }
+        probes.push_back(probe);
+    }
+    return true;
+}
+
+// record_observables "spectrum": {"frequencies" (cycles per unit time),
+// "window", "hop", "frames", "taper"}
+bool parseSpectrum(const json& value, dase::SlidingSpectrumConfig& spectrum, std::string& error) {
+    spectrum = dase::SlidingSpectrumConfig();
+    if (value.is_null() || (value.is_boolean() && !value.get<bool>())) {
+        return true;
+    }
+    if (!value.is_object() || !value.contains("frequencies") || !value["frequencies"].is_array() ||
+        value["frequencies"].empty()) {
+        error = "spectrum must be an object with a non-empty frequencies array";
+        return false;
+    }
+    for (const auto& f : value["frequencies"]) {
+        if (!f.is_number() || !(f.get<double>() >= 0.0)) {
+            error = "spectrum frequencies must be non-negative numbers";
+            return false;
+        }
+        spectrum.frequencies.push_back(f.get<double>());
+    }
+    auto count = [&value](const char* key, size_t fallback, size_t lo, size_t& out) {
+        out = fallback;
+        if (!value.contains(key)) return true;
+        if (!value[key].is_number_integer() || value[key].get<long long>() < static_cast<long long>(lo) ||
+            value[key].get<long long>() > 65536) {
+            return false;
+        }
+        out = static_cast<size_t>(value[key].get<long long>());
+        return true;
+    };
+    if (!count("window", spectrum.window, 2, spectrum.window) || !count("hop", 0, 1, spectrum.hop) ||
+        !count("frames", spectrum.frames, 1, spectrum.frames)) {
+        error = "spectrum window must be in [2, 65536], hop and frames in [1, 65536]";
+        return false;
+    }
+    if (value.contains("taper") &&
+        (!value["taper"].is_string() || !dase::parseSpectrumWindow(value["taper"].get<std::string>(), spectrum.shape))) {
+        error = "Invalid spectrum taper (expected 'hann' or 'rectangular')";
+        return false;
+    }
+    return true;
+}
+
+// run_mission "record_observables": true or {"observables", "every_steps",
+// "capacity", "probes", "spectrum", "reset"} records a time series of
+// observables during this and later missions, false stops it; an absent key
+// leaves the current setting alone
+bool applyObservableParams(EngineManager& manager, const std::string& engine_id,
+                           const json& params, std::string& error) {
+    if (!params.contains("record_observables")) {
+        return true;
+    }
+    const json& cfg = params["record_observables"];
+    if (cfg.is_boolean() && !cfg.get<bool>()) {
+        manager.disableObservables(engine_id);
+        return true;
+    }
+    if (!cfg.is_boolean() && !cfg.is_object()) {
+        error = "record_observables must be an object or a boolean";
+        return false;
+    }
+
+    std::vector<std::string> observables;
+    std::vector<dase::igsoa::IGSOAProbe> probes;
+    dase::SlidingSpectrumConfig spectrum;
+    bool observables_none = false;
+    int every_steps = 1;
+    int capacity = 4096;
+    if (cfg.is_object()) {
+        if (!parseObservables(cfg.value("observables", json()), observables, error)) {
+            return false;
+        }
+        // With probes, "observables": [] records the probes alone
+        observables_none = cfg.contains("observables") && cfg["observables"].is_array() &&
+                           cfg["observables"].empty();
+        if (!parseProbes(cfg.value("probes", json()), manager.getEngine(engine_id), probes, error) ||
+            !parseSpectrum(cfg.value("spectrum", json()), spectrum, error)) {
+            return false;
+        }
+        every_steps = cfg.value("every_steps", every_steps);
+        capacity = cfg.value("capacity", capacity);
+    }
+    if (capacity <= 0) {
+        error = "every_steps and capacity must be positive";
+        return false;
+    }
+    if (!manager.configureObservables(engine_id, observables, every_steps, static_cast<size_t>(capacity), error,
+                                      probes, spectrum, observables_none)) {
+        return false;
+    }
+    if (cfg.is_object() && cfg.value("reset", false)) {
+        manager.clearObservables(engine_id);
+    }
+    return true;
+}
+
+// run_mission "parareal": true or {"slices", "max_iterations", "tolerance",
+// "coarse_stride", "coarse_float", "checkpoint_path"} runs the mission
+// parallel in time; unset keys keep the PararealConfig defaults
+bool parseParareal(const json& value, dase::PararealConfig& config, std::string& error) {
+    config = dase::PararealConfig();
+    if (value.is_boolean()) {
+        return true;
+    }
+    if (!value.is_object()) {
+        error = "parareal must be an object or a boolean";
+        return false;
+    }
+    auto count = [&value](const char* key, size_t lo, size_t& out) {
+        if (!value.contains(key)) return true;
+        if (!value[key].is_number_integer() || value[key].get<long long>() < static_cast<long long>(lo) ||
+            value[key].get<long long>() > 65536) {
+            return false;
+        }
+        out = static_cast<size_t>(value[key].get<long long>());
+        return true;
+    };
+    if (!count("slices", 0, config.slices) || !count("max_iterations", 0, config.max_iterations) ||
+        !count("coarse_stride", 1, config.coarse_stride)) {
+        error = "parareal slices and max_iterations must be in [0, 65536], coarse_stride in [1, 65536]";
+        return false;
+    }
+    if (value.contains("tolerance")) {
+        if (!value["tolerance"].is_number() || !(value["tolerance"].get<double>() >= 0.0)) {
+            error = "parareal tolerance must be a non-negative number";
+            return false;
+        }
+        config.tolerance = value["tolerance"].get<double>();
+    }
+    if (value.contains("coarse_float")) {
+        if (!value["coarse_float"].is_boolean()) {
+            error = "parareal coarse_float must be a boolean";
+            return false;
+        }
+        config.coarse_float = value["coarse_float"].get<bool>();
+    }
+    if (value.contains("checkpoint_path")) {
+        if (!value["checkpoint_path"].is_string()) {
+            error = "parareal checkpoint_path must be a string";
+            return false;
+        }
+        config.checkpoint_path = value["checkpoint_path"].get<std::string>();
+    }
+    return true;
+}
+
+json pararealStatsJson(const dase::PararealStats& stats) {
+    return {
+        {"slices", stats.slices},
+        {"iterations", stats.iterations},
+        {"converged", stats.converged},
+        {"resumed", stats.resumed},
+        {"change", stats.change},
+        {"coarse_stride", stats.coarse_stride},
+        {"fine_steps", stats.fine_steps},
+        {"coarse_steps", stats.coarse_steps},
+        {"fine_seconds", stats.fine_seconds},
+        {"coarse_seconds", stats.coarse_seconds}
+    };
+}
+
+json withRequestId(json response, const json& request_id) {
+    if (!request_id.is_null()) {
+        response["request_id"] = request_id;
+    }
+    return response;
+}
+
+} // namespace
+
 CommandRouter::CommandRouter()
     : engine_manager(std::make_unique<EngineManager>()) {
 
@@ -23,28 +653,41 @@ CommandRouter::CommandRouter()
     g_analysis_router = std::make_unique<dase::AnalysisRouter>(engine_manager.get());
 
     // Register command handlers
-    command_handlers["get_capabilities"] = [this](const json& p) { return handleGetCapabilities(p); };
-    command_handlers["describe_engine"] = [this](const json& p) { return handleDescribeEngine(p); };
-    command_handlers["list_engines"] = [this](const json& p) { return handleListEngines(p); };
-    command_handlers["create_engine"] = [this](const json& p) { return handleCreateEngine(p); };
-    command_handlers["destroy_engine"] = [this](const json& p) { return handleDestroyEngine(p); };
-    command_handlers["set_node_state"] = [this](const json& p) { return handleSetNodeState(p); };
-    command_handlers["get_node_state"] = [this](const json& p) { return handleGetNodeState(p); };
-    command_handlers["set_igsoa_state"] = [this](const json& p) { return handleSetIgsoaState(p); };
-    command_handlers["set_satp_state"] = [this](const json& p) { return handleSetSatpState(p); };
-    command_handlers["run_mission"] = [this](const json& p) { return handleRunMission(p); };
-    command_handlers["run_mission_with_snapshots"] = [this](const json& p) { return handleRunMissionWithSnapshots(p); };
-    command_handlers["run_benchmark"] = [this](const json& p) { return handleRunBenchmark(p); };
-    command_handlers["get_metrics"] = [this](const json& p) { return handleGetMetrics(p); };
-    command_handlers["get_state"] = [this](const json& p) { return handleGetState(p); };
-    command_handlers["get_satp_state"] = [this](const json& p) { return handleGetSatpState(p); };
-    command_handlers["get_center_of_mass"] = [this](const json& p) { return handleGetCenterOfMass(p); };
+    command_handlers.add("get_capabilities", [this](const json& p) { return handleGetCapabilities(p); });
+    command_handlers.add("describe_engine", [this](const json& p) { return handleDescribeEngine(p); });
+    command_handlers.add("list_engines", [this](const json& p) { return handleListEngines(p); });
+    command_handlers.add("create_engine", [this](const json& p) { return handleCreateEngine(p); });
+    command_handlers.add("create_ensemble", [this](const json& p) { return handleCreateEnsemble(p); });
+    command_handlers.add("destroy_engine", [this](const json& p) { return handleDestroyEngine(p); });
+    command_handlers.add("configure_engine_pool", [this](const json& p) { return handleConfigureEnginePool(p); });
+    command_handlers.add("configure_memory_budget", [this](const json& p) { return handleConfigureMemoryBudget(p); });
+    command_handlers.add("configure_result_cache", [this](const json& p) { return handleConfigureResultCache(p); });
+    command_handlers.add("set_node_state", [this](const json& p) { return handleSetNodeState(p); });
+    command_handlers.add("get_node_state", [this](const json& p) { return handleGetNodeState(p); });
+    command_handlers.add("set_igsoa_state", [this](const json& p) { return handleSetIgsoaState(p); });
+    command_handlers.add("set_satp_state", [this](const json& p) { return handleSetSatpState(p); });
+    command_handlers.add("run_mission", [this](const json& p) { return handleRunMission(p); });
+    command_handlers.add("run_mission_with_snapshots", [this](const json& p) { return handleRunMissionWithSnapshots(p); });
+    command_handlers.add("run_mission_pipelined", [this](const json& p) { return handleRunMissionPipelined(p); });
+    command_handlers.add("run_benchmark", [this](const json& p) { return handleRunBenchmark(p); });
+    command_handlers.add("get_metrics", [this](const json& p) { return handleGetMetrics(p); });
+    command_handlers.add("get_state", [this](const json& p) { return handleGetState(p); });
+    command_handlers.add("get_satp_state", [this](const json& p) { return handleGetSatpState(p); });
+    command_handlers.add("get_center_of_mass", [this](const json& p) { return handleGetCenterOfMass(p); });
+    command_handlers.add("get_diagnostics", [this](const json& p) { return handleGetDiagnostics(p); });
+    command_handlers.add("get_observables", [this](const json& p) { return handleGetObservables(p); });
+    command_handlers.add("batch", [this](const json& p) { return handleBatch(p); });
+
+    // Register async mission commands
+    command_handlers.add("get_job_status", [this](const json& p) { return handleGetJobStatus(p); });
+    command_handlers.add("list_jobs", [this](const json& p) { return handleListJobs(p); });
+    command_handlers.add("cancel_job", [this](const json& p) { return handleCancelJob(p); });
 
     // Register analysis commands
-    command_handlers["check_analysis_tools"] = [this](const json& p) { return handleCheckAnalysisTools(p); };
-    command_handlers["python_analyze"] = [this](const json& p) { return handlePythonAnalyze(p); };
-    command_handlers["engine_fft"] = [this](const json& p) { return handleEngineFFT(p); };
-    command_handlers["analyze_fields"] = [this](const json& p) { return handleAnalyzeFields(p); };
+    command_handlers.add("check_analysis_tools", [this](const json& p) { return handleCheckAnalysisTools(p); });
+    command_handlers.add("python_analyze", [this](const json& p) { return handlePythonAnalyze(p); });
+    command_handlers.add("engine_fft", [this](const json& p) { return handleEngineFFT(p); });
+    command_handlers.add("analyze_fields", [this](const json& p) { return handleAnalyzeFields(p); });
 }
 
 CommandRouter::~CommandRouter() = default;
@@ -52,25 +695,44 @@ CommandRouter::~CommandRouter() = default;
 json CommandRouter::execute(const json& command) {
     auto start_time = std::chrono::high_resolution_clock::now();
 
+    current_request_id = (command.is_object() && command.contains("request_id"))
+        ? command["request_id"] : json(nullptr);
+
     try {
         // Extract command name
         if (!command.contains("command")) {
-            return createErrorResponse("", "Missing 'command' field", "MISSING_COMMAND");
+            return withRequestId(createErrorResponse("", "Missing 'command' field", "MISSING_COMMAND"),
+                                 current_request_id);
         }
 
-        std::string cmd_name = command["command"].get<std::string>();
+        const std::string& cmd_name = command["command"].get_ref<const std::string&>();
 
-        // Get parameters (optional)
-        json params = command.contains("params") ? command["params"] : json::object();
+        // Get parameters (optional; referenced, not copied out of the command)
+        static const json kNoParams = json::object();
+        auto params_it = command.find("params");
+        const json& params = params_it != command.end() ? *params_it : kNoParams;
 
         // Find and execute handler
-        auto it = command_handlers.find(cmd_name);
-        if (it == command_handlers.end()) {
-            return createErrorResponse(cmd_name, "Unknown command: " + cmd_name, "UNKNOWN_COMMAND");
+        const auto* handler = command_handlers.find(cmd_name);
+        if (!handler) {
+            return withRequestId(createErrorResponse(cmd_name, "Unknown command: " + cmd_name, "UNKNOWN_COMMAND"),
+                                 current_request_id);
+        }
+
+        // Engines held by an async mission only accept further async missions
+        if (scheduler && params.is_object() && params.contains("engine_id") && params["engine_id"].is_string()) {
+            bool async_submit = cmd_name == "run_mission" && params.value("async", false);
+            std::string engine_id = params["engine_id"].get<std::string>();
+            if (!async_submit && scheduler->isEngineReserved(engine_id)) {
+                return withRequestId(createErrorResponse(cmd_name,
+                                                         "Engine has a mission in progress: " + engine_id,
+                                                         "ENGINE_BUSY"),
+                                     current_request_id);
+            }
         }
 
         // Execute command
-        json result = it->second(params);
+        json result = (*handler)(params);
 
         // Calculate execution time
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -80,24 +742,97 @@ json CommandRouter::execute(const json& command) {
         // Add execution time to result
         result["execution_time_ms"] = execution_time_ms;
 
-        return result;
+        return withRequestId(result, current_request_id);
 
     } catch (const std::exception& e) {
-        return createErrorResponse("", std::string("Exception: ") + e.what(), "INTERNAL_ERROR");
+        return withRequestId(createErrorResponse("", std::string("Exception: ") + e.what(), "INTERNAL_ERROR"),
+                             current_request_id);
+    }
+}
+
+void CommandRouter::configureScheduler(const MissionScheduler::Options& options,
+                                       MissionScheduler::ResponseCallback on_complete) {
+    scheduler_options = options;
+    scheduler_callback = std::move(on_complete);
+}
+
+bool CommandRouter::loadEnginePlugin(const std::string& engine_type, const std::string& path, std::string& error) {
+    return engine_manager->loadEnginePlugin(engine_type, path, error);
+}
+
+void CommandRouter::waitForJobs() {
+    if (scheduler) {
+        scheduler->waitAll();
+    }
+}
+
+void CommandRouter::destroyEngines() {
+    waitForJobs();
+    engine_manager->destroyAllEngines();
+}
+
+MissionScheduler* CommandRouter::getScheduler() {
+    if (!scheduler) {
+        scheduler = std::make_unique<MissionScheduler>(engine_manager.get(), scheduler_options, scheduler_callback);
     }
+    return scheduler.get();
+}
+
+json CommandRouter::handleBatch(const json& params) {
+    if (!params.contains("commands") || !params["commands"].is_array()) {
+        return createErrorResponse("batch", "Missing 'commands' array", "MISSING_PARAMETER");
+    }
+    const json& commands = params["commands"];
+    const bool stop_on_error = params.value("stop_on_error", false);
+
+    // Sub-commands run through execute(), which overwrites the request_id
+    const json batch_request_id = current_request_id;
+
+    json responses = json::array();
+    size_t failed = 0;
+    for (const json& command : commands) {
+        json response;
+        if (command.is_object() && command.value("command", "") == "batch") {
+            response = withRequestId(createErrorResponse("batch", "Batches cannot be nested", "NESTED_BATCH"),
+                                     command.contains("request_id") ? command["request_id"] : json(nullptr));
+        } else {
+            response = execute(command);
+        }
+        const bool ok = response.value("status", "") == "success";
+        responses.push_back(std::move(response));
+        if (!ok) {
+            failed++;
+            if (stop_on_error) break;
+        }
+    }
+    current_request_id = batch_request_id;
+
+    const size_t executed = responses.size();
+    json result = {
+        {"responses", std::move(responses)},
+        {"executed", executed},
+        {"failed", failed},
+        {"skipped", commands.size() - executed}
+    };
+    return createSuccessResponse("batch", result, 0);
 }
 
 json CommandRouter::handleGetCapabilities(const json& params) {
+    // Registered backends (phase4b only when compiled in or loaded as a plugin)
+    json engines = engine_manager->engineTypes();
+    engines.push_back("igsoa_gw");
+
     json result = {
         {"version", "1.0.0"},
         {"status", "prototype"},
-        {"engines", json::array({"phase4b", "igsoa_complex", "igsoa_complex_2d", "igsoa_complex_3d", "satp_higgs_1d", "satp_higgs_2d", "satp_higgs_3d", "igsoa_gw"})},
+        {"engines", engines},
         {"cpu_features", {
             {"avx2", true},
             {"avx512", false},
             {"fma", true}
         }},
-        {"max_nodes", 1048576}
+        {"max_nodes", 1048576},
+        {"async_missions", true}
     };
 
     return createSuccessResponse("get_capabilities", result, 0);
@@ -309,7 +1044,8 @@ json CommandRouter::handleListEngines(const json& params) {
         json engine_json = {
             {"engine_id", engine->engine_id},
             {"engine_type", engine->engine_type},
-            {"num_nodes", engine->num_nodes}
+            {"num_nodes", engine->num_nodes},
+            {"footprint_bytes", engine->footprint_bytes}
         };
 
         if (engine->dimension_x > 0 && engine->dimension_y > 0) {
@@ -328,6 +1064,14 @@ json CommandRouter::handleListEngines(const json& params) {
                 {"R_c", engine->R_c},
                 {"kappa", engine->kappa},
                 {"gamma", engine->gamma},
+                {"dt", engine->dt},
+                {"integrator", engine->integrator}
+            };
+        }
+        if (engine->engine_type == "igsoa_ensemble_2d") {
+            engine_json["replicas"] = engine->replicas;
+            engine_json["config"] = {
+                {"R_c", engine->R_c},
                 {"dt", engine->dt}
             };
         }
@@ -355,6 +1099,65 @@ json CommandRouter::handleCreateEngine(const json& params) {
     int N_x = params.value("N_x", params.value("width", 0));
     int N_y = params.value("N_y", params.value("height", 0));
     int N_z = params.value("N_z", params.value("depth", 0));
+    std::string coupling_mode = params.value("coupling", "direct");
+    std::string precision = params.value("precision", "float64");
+
+    if (coupling_mode == "gpu") {
+        return createErrorResponse("create_engine",
+                                   "GPU coupling is not available: this build has no device backend",
+                                   "INVALID_PARAMETER");
+    }
+    if (coupling_mode != "direct" && coupling_mode != "neighbor_cache" && coupling_mode != "spectral" &&
+        coupling_mode != "recursive") {
+        return createErrorResponse("create_engine",
+                                   "Invalid coupling mode (expected 'direct', 'neighbor_cache', 'spectral' "
+                                   "or 'recursive')",
+                                   "INVALID_PARAMETER");
+    }
+
+    const bool precision_selectable = engine_type == "igsoa_complex_2d" || engine_type == "igsoa_complex_3d" ||
+                                      engine_type == "satp_higgs_1d" || engine_type == "satp_higgs_2d" ||
+                                      engine_type == "satp_higgs_3d";
+    if (precision != "float64" && precision != "float32") {
+        return createErrorResponse("create_engine",
+                                   "Invalid precision (expected 'float64' or 'float32')",
+                                   "INVALID_PARAMETER");
+    }
+    if (precision == "float32" && !precision_selectable) {
+        return createErrorResponse("create_engine",
+                                   "float32 precision requires an IGSOA 2D/3D or SATP+Higgs engine",
+                                   "INVALID_PARAMETER");
+    }
+    double admission_wait_seconds = 0.0;
+    std::string admission_error;
+    if (!admissionWait(params, admission_wait_seconds, admission_error)) {
+        return createErrorResponse("create_engine", admission_error, "INVALID_PARAMETER");
+    }
+
+    // Time integrator: SATP+Higgs "verlet" (default) or "yoshida4", IGSOA "euler" (default) or "rk4"
+    const bool satp_engine = engine_type == "satp_higgs_1d" || engine_type == "satp_higgs_2d" ||
+                             engine_type == "satp_higgs_3d";
+    const bool igsoa_engine = engine_type == "igsoa_complex" || engine_type == "igsoa_complex_2d" ||
+                              engine_type == "igsoa_complex_3d";
+    dase::satp_higgs::SATPHiggsIntegrator integrator = dase::satp_higgs::SATPHiggsIntegrator::Verlet;
+    dase::igsoa::IGSOAIntegrator igsoa_integrator = dase::igsoa::IGSOAIntegrator::Euler;
+    if (params.contains("integrator")) {
+        if (!satp_engine && !igsoa_engine) {
+            return createErrorResponse("create_engine",
+                                       "integrator requires a SATP+Higgs or IGSOA complex engine",
+                                       "INVALID_PARAMETER");
+        }
+        const bool parsed = params["integrator"].is_string() &&
+            (satp_engine
+                 ? dase::satp_higgs::parseSATPHiggsIntegrator(params["integrator"].get<std::string>(), integrator)
+                 : dase::igsoa::parseIGSOAIntegrator(params["integrator"].get<std::string>(), igsoa_integrator));
+        if (!parsed) {
+            return createErrorResponse("create_engine",
+                                       satp_engine ? "Invalid integrator (expected 'verlet' or 'yoshida4')"
+                                                   : "Invalid integrator (expected 'euler' or 'rk4')",
+                                       "INVALID_PARAMETER");
+        }
+    }
 
     if (engine_type == "igsoa_complex_2d") {
         if (N_x <= 0 || N_y <= 0) {
@@ -388,7 +1191,73 @@ json CommandRouter::handleCreateEngine(const json& params) {
         num_nodes = static_cast<int>(expected_nodes);
     }
 
+    // Process-wide memory placement and thread pinning (apply to engines created from now on)
+    dase::MemoryPolicy memory_policy = dase::getMemoryPolicy();
+    memory_policy.first_touch = params.value("first_touch", memory_policy.first_touch);
+    memory_policy.huge_pages = params.value("huge_pages", memory_policy.huge_pages);
+    // Out-of-core storage: footprint above memory_budget_mb spills to spill_directory
+    dase::OutOfCorePolicy out_of_core_policy = dase::getOutOfCorePolicy();
+    if (params.contains("memory_budget_mb")) {
+        const double budget_mb = params["memory_budget_mb"].is_number() ? params["memory_budget_mb"].get<double>() : -1.0;
+        if (budget_mb < 0.0) {
+            return createErrorResponse("create_engine",
+                                       "Invalid memory_budget_mb (expected a number >= 0, 0 disables spilling)",
+                                       "INVALID_PARAMETER");
+        }
+        out_of_core_policy.memory_budget_bytes = static_cast<size_t>(budget_mb * 1048576.0);
+    }
+    out_of_core_policy.directory = params.value("spill_directory", out_of_core_policy.directory);
+    const int prefetch_slabs = params.value("prefetch_slabs", static_cast<int>(out_of_core_policy.prefetch_slabs));
+    if (prefetch_slabs < 0) {
+        return createErrorResponse("create_engine",
+                                   "Invalid prefetch_slabs (must be >= 0)",
+                                   "INVALID_PARAMETER");
+    }
+    out_of_core_policy.prefetch_slabs = static_cast<size_t>(prefetch_slabs);
+    const bool pinning_requested = params.contains("thread_pinning");
+    dase::ThreadPinning pinning = dase::ThreadPinning::None;
+    if (pinning_requested &&
+        (!params["thread_pinning"].is_string() ||
+         !dase::parseThreadPinning(params["thread_pinning"].get<std::string>(), pinning))) {
+        return createErrorResponse("create_engine",
+                                   "Invalid thread_pinning (expected 'none', 'compact' or 'spread')",
+                                   "INVALID_PARAMETER");
+    }
+    // Active-region stepping: true, or {"threshold": ..., "tile": ...} (IGSOA 2D/3D)
+    dase::igsoa::ActiveRegionConfig active_region;
+    if (params.contains("active_region")) {
+        const json& value = params["active_region"];
+        const bool lattice_engine = engine_type == "igsoa_complex_2d" || engine_type == "igsoa_complex_3d";
+        if (!lattice_engine) {
+            return createErrorResponse("create_engine",
+                                       "active_region requires an IGSOA 2D/3D engine",
+                                       "INVALID_PARAMETER");
+        }
+        if (value.is_boolean()) {
+            active_region.enabled = value.get<bool>();
+        } else if (value.is_object()) {
+            active_region.enabled = value.value("enabled", true);
+            active_region.threshold = value.value("threshold", active_region.threshold);
+            const int tile = value.value("tile", static_cast<int>(active_region.tile));
+            if (tile <= 0 || active_region.threshold < 0.0) {
+                return createErrorResponse("create_engine",
+                                           "Invalid active_region (tile must be > 0, threshold >= 0)",
+                                           "INVALID_PARAMETER");
+            }
+            active_region.tile = static_cast<size_t>(tile);
+        } else {
+            return createErrorResponse("create_engine",
+                                       "Invalid active_region (expected a boolean or an object)",
+                                       "INVALID_PARAMETER");
+        }
+    }
+
+    dase::setMemoryPolicy(memory_policy);
+    dase::setOutOfCorePolicy(out_of_core_policy);
+    const int threads_pinned = pinning_requested ? dase::pinThreads(pinning) : 0;
+
     // Create engine
+    const uint64_t pool_hits = engine_manager->getEnginePoolStats().hits;
     std::string engine_id = engine_manager->createEngine(
         engine_type,
         num_nodes,
@@ -398,12 +1267,26 @@ json CommandRouter::handleCreateEngine(const json& params) {
         dt,
         N_x,
         N_y,
-        N_z
+        N_z,
+        coupling_mode,
+        precision,
+        dase::igsoa::igsoaIntegratorName(igsoa_integrator),
+        admission_wait_seconds,
+        &admission_error
     );
 
     if (engine_id.empty()) {
+        if (!admission_error.empty()) {
+            return createErrorResponse("create_engine", admission_error, "MEMORY_BUDGET_EXCEEDED");
+        }
         return createErrorResponse("create_engine", "Failed to create engine", "ENGINE_CREATE_FAILED");
     }
+    if (active_region.enabled) {
+        engine_manager->setActiveRegion(engine_id, active_region);
+    }
+    if (satp_engine) {
+        engine_manager->setSatpIntegrator(engine_id, integrator);
+    }
 
     json result = {
         {"engine_id", engine_id},
@@ -418,15 +1301,119 @@ json CommandRouter::handleCreateEngine(const json& params) {
     if (engine_type == "igsoa_complex_2d") {
         result["N_x"] = N_x;
         result["N_y"] = N_y;
+        result["coupling"] = coupling_mode;
     } else if (engine_type == "igsoa_complex_3d") {
         result["N_x"] = N_x;
         result["N_y"] = N_y;
         result["N_z"] = N_z;
+        result["coupling"] = coupling_mode;
+        result["out_of_core"] = engine_manager->isOutOfCore(engine_id);
+    }
+    if (engine_type == "igsoa_complex_2d" || engine_type == "igsoa_complex_3d") {
+        result["reused"] = engine_manager->getEnginePoolStats().hits > pool_hits;
+    }
+    if (precision_selectable) {
+        result["precision"] = precision;
+    }
+    if (satp_engine) {
+        result["integrator"] = dase::satp_higgs::satpHiggsIntegratorName(integrator);
+    } else if (igsoa_engine) {
+        result["integrator"] = dase::igsoa::igsoaIntegratorName(igsoa_integrator);
+    }
+    if (active_region.enabled) {
+        result["active_region"] = {
+            {"threshold", active_region.threshold},
+            {"tile", active_region.tile}
+        };
+    }
+    result["footprint_bytes"] = engine_manager->getEngine(engine_id)->footprint_bytes;
+    result["first_touch"] = memory_policy.first_touch;
+    result["huge_pages"] = memory_policy.huge_pages;
+    if (pinning_requested) {
+        result["thread_pinning"] = dase::threadPinningName(pinning);
+        result["threads_pinned"] = threads_pinned;
     }
 
     return createSuccessResponse("create_engine", result, 0);
 }
 
+json CommandRouter::handleCreateEnsemble(const json& params) {
+    int N_x = params.value("N_x", params.value("width", 0));
+    int N_y = params.value("N_y", params.value("height", 0));
+    double R_c = params.value("R_c_default", params.value("R_c", 1.0));
+    double dt = params.value("dt", 0.01);
+    int replicas = params.value("replicas", 0);
+
+    if (N_x <= 0 || N_y <= 0) {
+        return createErrorResponse("create_ensemble",
+                                   "Invalid 2D dimensions (N_x and N_y must be > 0)",
+                                   "INVALID_DIMENSIONS");
+    }
+
+    // kappa / gamma: one value per replica, or a scalar shared by all
+    // (replicas then defaults to the array length)
+    std::vector<double> kappas;
+    std::vector<double> gammas;
+    if (params.contains("kappa") && params["kappa"].is_array()) {
+        kappas = params["kappa"].get<std::vector<double>>();
+    }
+    if (params.contains("gamma") && params["gamma"].is_array()) {
+        gammas = params["gamma"].get<std::vector<double>>();
+    }
+    if (replicas <= 0) {
+        replicas = static_cast<int>(!kappas.empty() ? kappas.size() : gammas.size());
+    }
+    if (replicas <= 0) {
+        return createErrorResponse("create_ensemble",
+                                   "Missing replica count ('replicas' or kappa/gamma arrays)",
+                                   "INVALID_PARAMETER");
+    }
+    if (kappas.empty()) {
+        kappas.assign(static_cast<size_t>(replicas), params.value("kappa", 1.0));
+    }
+    if (gammas.empty()) {
+        gammas.assign(static_cast<size_t>(replicas), params.value("gamma", 0.1));
+    }
+    if (kappas.size() != static_cast<size_t>(replicas) || gammas.size() != static_cast<size_t>(replicas)) {
+        return createErrorResponse("create_ensemble",
+                                   "kappa/gamma arrays must have one value per replica",
+                                   "INVALID_PARAMETER");
+    }
+
+    double admission_wait_seconds = 0.0;
+    std::string admission_error;
+    if (!admissionWait(params, admission_wait_seconds, admission_error)) {
+        return createErrorResponse("create_ensemble", admission_error, "INVALID_PARAMETER");
+    }
+
+    std::string engine_id = engine_manager->createEnsemble(N_x, N_y, R_c, dt, kappas, gammas,
+                                                           admission_wait_seconds, &admission_error);
+    if (engine_id.empty() && !admission_error.empty()) {
+        return createErrorResponse("create_ensemble", admission_error, "MEMORY_BUDGET_EXCEEDED");
+    }
+    if (engine_id.empty()) {
+        return createErrorResponse("create_ensemble",
+                                   "Failed to create ensemble (lattice or replica count exceeds limits)",
+                                   "ENGINE_CREATE_FAILED");
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"engine_type", "igsoa_ensemble_2d"},
+        {"num_nodes", N_x * N_y},
+        {"N_x", N_x},
+        {"N_y", N_y},
+        {"replicas", replicas},
+        {"R_c", R_c},
+        {"dt", dt},
+        {"kappa", kappas},
+        {"gamma", gammas},
+        {"footprint_bytes", engine_manager->getEngine(engine_id)->footprint_bytes}
+    };
+
+    return createSuccessResponse("create_ensemble", result, 0);
+}
+
 json CommandRouter::handleDestroyEngine(const json& params) {
     if (!params.contains("engine_id")) {
         return createErrorResponse("destroy_engine", "Missing engine_id", "MISSING_PARAM");
@@ -449,7 +1436,56 @@ json CommandRouter::handleDestroyEngine(const json& params) {
     return createSuccessResponse("destroy_engine", result, 0);
 }
 
-json CommandRouter::handleSetNodeState(const json& params) {
+json CommandRouter::handleConfigureEnginePool(const json& params) {
+    if (params.contains("max_mb")) {
+        if (!params["max_mb"].is_number() || params["max_mb"].get<double>() < 0.0) {
+            return createErrorResponse("configure_engine_pool", "max_mb must be a non-negative number",
+                                       "INVALID_PARAMETER");
+        }
+        engine_manager->setEnginePoolLimit(static_cast<size_t>(params["max_mb"].get<double>() * 1048576.0));
+    }
+    return createSuccessResponse("configure_engine_pool", enginePoolJson(engine_manager->getEnginePoolStats()), 0);
+}
+
+json CommandRouter::handleConfigureMemoryBudget(const json& params) {
+    if (params.contains("max_mb")) {
+        if (!params["max_mb"].is_number() || params["max_mb"].get<double>() < 0.0) {
+            return createErrorResponse("configure_memory_budget", "max_mb must be a non-negative number",
+                                       "INVALID_PARAMETER");
+        }
+        EngineManager::setMemoryBudget(static_cast<size_t>(params["max_mb"].get<double>() * 1048576.0));
+    }
+    return createSuccessResponse("configure_memory_budget",
+                                 memoryAdmissionJson(EngineManager::getMemoryAdmissionStats()), 0);
+}
+
+json CommandRouter::handleConfigureResultCache(const json& params) {
+    if (params.contains("enabled") && params["enabled"].is_boolean() && !params["enabled"].get<bool>()) {
+        engine_manager->disableResultCache();
+        return createSuccessResponse("configure_result_cache", resultCacheJson(*engine_manager), 0);
+    }
+    if (!params.contains("directory") || !params["directory"].is_string() ||
+        params["directory"].get<std::string>().empty()) {
+        return createErrorResponse("configure_result_cache", "directory must be a non-empty string",
+                                   "INVALID_PARAMETER");
+    }
+    double max_mb = 1024.0;
+    if (params.contains("max_mb")) {
+        if (!params["max_mb"].is_number() || params["max_mb"].get<double>() <= 0.0) {
+            return createErrorResponse("configure_result_cache", "max_mb must be a positive number",
+                                       "INVALID_PARAMETER");
+        }
+        max_mb = params["max_mb"].get<double>();
+    }
+    std::string error;
+    if (!engine_manager->configureResultCache(params["directory"].get<std::string>(),
+                                              static_cast<size_t>(max_mb * 1048576.0), error)) {
+        return createErrorResponse("configure_result_cache", error, "INVALID_PARAMETER");
+    }
+    return createSuccessResponse("configure_result_cache", resultCacheJson(*engine_manager), 0);
+}
+
+json CommandRouter::handleSetNodeState(const json& params) {
     std::string engine_id = params.value("engine_id", "");
     int node_index = params.value("node_index", 0);
     double value = params.value("value", 0.0);
@@ -490,7 +1526,89 @@ json CommandRouter::handleRunMission(const json& params) {
     int num_steps = params.value("num_steps", 0);
     int iterations_per_node = params.value("iterations_per_node", 30);
 
-    bool success = engine_manager->runMission(engine_id, num_steps, iterations_per_node);
+    std::string checkpoint_error;
+    if (params.contains("checkpoint") || params.contains("perf_counters") ||
+        params.contains("record_observables")) {
+        if (!engine_manager->getEngine(engine_id)) {
+            return createErrorResponse("run_mission", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+        }
+        if (!applyCheckpointParams(*engine_manager, engine_id, params, checkpoint_error) ||
+            !applyPerfCounterParams(*engine_manager, engine_id, params, checkpoint_error) ||
+            !applyObservableParams(*engine_manager, engine_id, params, checkpoint_error)) {
+            return createErrorResponse("run_mission", checkpoint_error, "INVALID_PARAMETER");
+        }
+    }
+
+    const bool parareal = params.contains("parareal") &&
+                          !(params["parareal"].is_boolean() && !params["parareal"].get<bool>());
+    dase::PararealConfig parareal_config;
+    if (parareal) {
+        std::string parareal_error;
+        if (!parseParareal(params["parareal"], parareal_config, parareal_error)) {
+            return createErrorResponse("run_mission", parareal_error, "INVALID_PARAMETER");
+        }
+        if (params.value("async", false)) {
+            return createErrorResponse("run_mission", "parareal missions cannot run async", "INVALID_PARAMETER");
+        }
+    }
+
+    if (params.value("async", false)) {
+        auto* instance = engine_manager->getEngine(engine_id);
+        if (!instance) {
+            return createErrorResponse("run_mission", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+        }
+        if (num_steps <= 0) {
+            return createErrorResponse("run_mission", "num_steps must be positive", "INVALID_PARAMETER");
+        }
+
+        // Completion arrives later as a separate run_mission response tagged with request_id
+        auto* pool = getScheduler();
+        std::string job_id = pool->submit(instance, engine_id, num_steps, iterations_per_node,
+                                          params.value("chunk_steps", 0),
+                                          params.value("threads", 0),
+                                          current_request_id);
+
+        json result = {
+            {"job_id", job_id},
+            {"engine_id", engine_id},
+            {"state", "queued"},
+            {"num_steps", num_steps},
+            {"workers", pool->workerCount()}
+        };
+        return createSuccessResponse("run_mission", result, 0);
+    }
+
+    // diagnostics: observables of the final state from one fused pass
+    std::vector<std::string> observables;
+    const bool want_diagnostics = params.contains("diagnostics") &&
+                                  !(params["diagnostics"].is_boolean() && !params["diagnostics"].get<bool>());
+    if (want_diagnostics) {
+        std::string diagnostics_error;
+        if (!parseObservables(params["diagnostics"], observables, diagnostics_error)) {
+            return createErrorResponse("run_mission", diagnostics_error, "INVALID_PARAMETER");
+        }
+    }
+
+    // parareal: time slices stepped concurrently (the result cache is not consulted)
+    dase::PararealStats parareal_stats;
+    if (parareal) {
+        std::string parareal_error;
+        if (!engine_manager->getEngine(engine_id)) {
+            return createErrorResponse("run_mission", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+        }
+        if (!engine_manager->runPararealMission(engine_id, num_steps, parareal_config, parareal_stats,
+                                                parareal_error)) {
+            return createErrorResponse("run_mission", parareal_error, "INVALID_PARAMETER");
+        }
+    }
+
+    // cache: look the final state up in the result cache ("cache": false skips it)
+    const bool use_cache = !parareal && engine_manager->resultCacheEnabled() && params.value("cache", true);
+    EngineManager::MissionCacheOutcome cache_outcome;
+    bool success = parareal ||
+        (use_cache
+            ? engine_manager->runCachedMission(engine_id, num_steps, iterations_per_node, cache_outcome)
+            : engine_manager->runMission(engine_id, num_steps, iterations_per_node));
 
     if (!success) {
         return createErrorResponse("run_mission",
@@ -503,15 +1621,137 @@ json CommandRouter::handleRunMission(const json& params) {
         {"total_operations", static_cast<double>(num_steps) * iterations_per_node * 1024}
     };
 
+    if (parareal) {
+        result["parareal"] = pararealStatsJson(parareal_stats);
+    }
+
+    if (use_cache) {
+        json cache = {{"hit", cache_outcome.hit}};
+        if (cache_outcome.key.empty()) {
+            cache["bypassed"] = cache_outcome.bypass_reason;
+        } else {
+            cache["key"] = cache_outcome.key;
+            cache["stored"] = cache_outcome.stored;
+            if (!cache_outcome.error.empty()) {
+                cache["error"] = cache_outcome.error;
+            }
+        }
+        result["cache"] = cache;
+    }
+
+    if (want_diagnostics) {
+        json diagnostics;
+        std::string diagnostics_error;
+        if (!engine_manager->computeDiagnostics(engine_id, observables, diagnostics, diagnostics_error)) {
+            return createErrorResponse("run_mission", diagnostics_error, "INVALID_PARAMETER");
+        }
+        result["diagnostics"] = diagnostics;
+    }
+
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (instance && instance->checkpointer) {
+        result["checkpoints_pending"] = instance->checkpointer->pending();
+    }
+
     return createSuccessResponse("run_mission", result, 0);
 }
 
+json CommandRouter::handleGetJobStatus(const json& params) {
+    if (!params.contains("job_id")) {
+        return createErrorResponse("get_job_status", "Missing required parameter: job_id", "MISSING_PARAMETER");
+    }
+    std::string job_id = params["job_id"].get<std::string>();
+
+    json status = scheduler ? scheduler->jobStatus(job_id) : json(nullptr);
+    if (status.is_null()) {
+        return createErrorResponse("get_job_status", "Job not found: " + job_id, "JOB_NOT_FOUND");
+    }
+
+    return createSuccessResponse("get_job_status", status, 0);
+}
+
+json CommandRouter::handleListJobs(const json& params) {
+    json result = {
+        {"jobs", scheduler ? scheduler->listJobs() : json::array()}
+    };
+
+    return createSuccessResponse("list_jobs", result, 0);
+}
+
+json CommandRouter::handleCancelJob(const json& params) {
+    if (!params.contains("job_id")) {
+        return createErrorResponse("cancel_job", "Missing required parameter: job_id", "MISSING_PARAMETER");
+    }
+    std::string job_id = params["job_id"].get<std::string>();
+
+    if (!scheduler || !scheduler->cancel(job_id)) {
+        return createErrorResponse("cancel_job", "Job not found or already finished: " + job_id, "JOB_NOT_FOUND");
+    }
+
+    json result = {
+        {"job_id", job_id},
+        {"cancel_requested", true}
+    };
+
+    return createSuccessResponse("cancel_job", result, 0);
+}
+
 json CommandRouter::handleRunMissionWithSnapshots(const json& params) {
     std::string engine_id = params.value("engine_id", "");
     int num_steps = params.value("num_steps", 0);
     int iterations_per_node = params.value("iterations_per_node", 30);
     int snapshot_interval = params.value("snapshot_interval", 1);
 
+    // stream_path: frames go to disk as they are taken; nothing is kept in memory
+    if (params.contains("stream_path")) {
+        // compression: "lossless" (bit-exact) or "lossy" (within error_bound, for visualization)
+        dase::SnapshotCodecOptions codec{dase::SnapshotCodec::Raw};
+        const std::string compression = params.value("compression", std::string("none"));
+        if (compression == "lossless") {
+            codec.codec = dase::SnapshotCodec::Lossless;
+        } else if (compression == "lossy") {
+            codec.codec = dase::SnapshotCodec::Quantized;
+            codec.error_bound = params.value("error_bound", 0.0);
+            if (!(codec.error_bound > 0.0)) {
+                return createErrorResponse("run_mission_with_snapshots",
+                                           "compression \"lossy\" needs a positive error_bound",
+                                           "INVALID_PARAMETER");
+            }
+        } else if (compression != "none") {
+            return createErrorResponse("run_mission_with_snapshots",
+                                       "compression must be \"none\", \"lossless\" or \"lossy\"",
+                                       "INVALID_PARAMETER");
+        }
+        return streamMissionSnapshots(engine_id, num_steps, iterations_per_node, snapshot_interval,
+                                      params["stream_path"].get<std::string>(), codec);
+    }
+
+    // The snapshot codec frames stream files only; in-memory and binary snapshots stay float64
+    if (params.contains("compression") && params["compression"] != "none") {
+        return createErrorResponse("run_mission_with_snapshots",
+                                   "compression needs stream_path",
+                                   "INVALID_PARAMETER");
+    }
+
+    StateSelection selection;
+    std::string selection_error;
+    if (!parseStateSelection(params, engine_manager->getEngine(engine_id), selection, selection_error)) {
+        return createErrorResponse("run_mission_with_snapshots", selection_error, "INVALID_PARAMETER");
+    }
+
+    // transfer: "binary" appends every snapshot's arrays to one file
+    std::unique_ptr<BinaryStateFile> binary;
+    size_t num_nodes = 0;
+    if (wantsBinaryTransfer(params)) {
+        binary = std::make_unique<BinaryStateFile>(params.value("binary_path", std::string()),
+                                                   engine_id + "_snapshots");
+        if (!binary->ok()) {
+            return createErrorResponse("run_mission_with_snapshots",
+                                       "Cannot open binary snapshot file",
+                                       "STATE_TRANSFER_FAILED");
+        }
+    }
+
     json snapshots = json::array();
 
     for (int step = snapshot_interval; step <= num_steps; step += snapshot_interval) {
@@ -527,6 +1767,23 @@ json CommandRouter::handleRunMissionWithSnapshots(const json& params) {
         json snapshot;
         snapshot["timestep"] = step;
 
+        if (selection.active) {
+            json fields;
+            if (!captureSelection(*engine_manager, engine_id, selection, binary.get(), fields)) {
+                return createErrorResponse("run_mission_with_snapshots",
+                                           "Failed to get state at step " + std::to_string(step),
+                                           "STATE_CAPTURE_FAILED");
+            }
+            snapshot["num_nodes"] = selection.region.outCount();
+            if (binary) {
+                snapshot["fields"] = fields;
+            } else {
+                snapshot.update(fields);
+            }
+            snapshots.push_back(snapshot);
+            continue;
+        }
+
         std::vector<double> psi_real, psi_imag, phi;
         bool success_state = engine_manager->getAllNodeStates(engine_id, psi_real, psi_imag, phi);
 
@@ -537,9 +1794,18 @@ json CommandRouter::handleRunMissionWithSnapshots(const json& params) {
         }
 
         snapshot["num_nodes"] = psi_real.size();
-        snapshot["psi_real"] = psi_real;
-        snapshot["psi_imag"] = psi_imag;
-        snapshot["phi"] = phi;
+        if (binary) {
+            snapshot["fields"] = {
+                {"psi_real", binary->append(psi_real)},
+                {"psi_imag", binary->append(psi_imag)},
+                {"phi", binary->append(phi)}
+            };
+            num_nodes = psi_real.size();
+        } else {
+            snapshot["psi_real"] = psi_real;
+            snapshot["psi_imag"] = psi_imag;
+            snapshot["phi"] = phi;
+        }
 
         snapshots.push_back(snapshot);
     }
@@ -549,10 +1815,261 @@ json CommandRouter::handleRunMissionWithSnapshots(const json& params) {
         {"snapshot_count", snapshots.size()},
         {"snapshots", snapshots}
     };
+    if (selection.active) {
+        result["selection"] = selectionDescriptor(selection);
+    }
+
+    if (binary) {
+        if (!binary->ok()) {
+            return createErrorResponse("run_mission_with_snapshots",
+                                       "Failed to write binary snapshot file",
+                                       "STATE_TRANSFER_FAILED");
+        }
+        result["transfer"] = "binary";
+        result["binary"] = selection.active
+            ? binary->finish(selection.shape, selection.float32 ? "float32" : "float64")
+            : binary->finish(stateShape(engine_manager->getEngine(engine_id), num_nodes));
+    }
+
+    return createSuccessResponse("run_mission_with_snapshots", result, 0);
+}
+
+json CommandRouter::streamMissionSnapshots(const std::string& engine_id,
+                                           int num_steps,
+                                           int iterations_per_node,
+                                           int snapshot_interval,
+                                           const std::string& stream_path,
+                                           const dase::SnapshotCodecOptions& codec) {
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (!instance) {
+        return createErrorResponse("run_mission_with_snapshots", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+    }
+    if (snapshot_interval <= 0) {
+        return createErrorResponse("run_mission_with_snapshots", "snapshot_interval must be positive", "INVALID_PARAMETER");
+    }
+
+    const size_t num_nodes = static_cast<size_t>(instance->num_nodes);
+    json shape = stateShape(instance, num_nodes);
+    SnapshotStreamWriter stream;
+    if (!stream.open(stream_path, num_nodes, shape.get<std::vector<uint64_t>>(), codec)) {
+        return createErrorResponse("run_mission_with_snapshots",
+                                   "Cannot open snapshot stream: " + stream_path,
+                                   "STATE_TRANSFER_FAILED");
+    }
+
+    int snapshot_count = 0;
+    for (int step = snapshot_interval; step <= num_steps; step += snapshot_interval) {
+        if (!engine_manager->runMission(engine_id, snapshot_interval, iterations_per_node)) {
+            stream.close();
+            return createErrorResponse("run_mission_with_snapshots",
+                                       "Mission execution failed at step " + std::to_string(step),
+                                       "EXECUTION_FAILED");
+        }
+
+        // Capture straight into a writer buffer; the previous frame may still be on its way to disk
+        auto& frame = stream.acquire();
+        frame.timestep = step;
+        if (!engine_manager->getAllNodeStates(engine_id, frame.psi_real, frame.psi_imag, frame.phi)) {
+            stream.close();
+            return createErrorResponse("run_mission_with_snapshots",
+                                       "Failed to get state at step " + std::to_string(step),
+                                       "STATE_CAPTURE_FAILED");
+        }
+        if (!stream.commit()) {
+            stream.close();
+            return createErrorResponse("run_mission_with_snapshots",
+                                       "Snapshot write failed at step " + std::to_string(step),
+                                       "STATE_TRANSFER_FAILED");
+        }
+        snapshot_count++;
+    }
+
+    if (!stream.close()) {
+        return createErrorResponse("run_mission_with_snapshots",
+                                   "Snapshot write failed: " + stream_path,
+                                   "STATE_TRANSFER_FAILED");
+    }
+
+    json result = {
+        {"steps_completed", num_steps},
+        {"snapshot_count", snapshot_count},
+        {"stream", {
+            {"path", stream.path()},
+            {"format", "dase_snapshot_stream"},
+            {"version", stream.version()},
+            {"num_nodes", num_nodes},
+            {"shape", shape},
+            {"header_bytes", SnapshotStreamWriter::kHeaderBytes},
+            {"frame_bytes", stream.frameBytes()},
+            {"bytes", stream.bytesWritten()},
+            {"writer_stall_ms", stream.stallMs()}
+        }}
+    };
+    if (stream.compressed()) {
+        const uint64_t raw_bytes = static_cast<uint64_t>(snapshot_count) * stream.frameBytes();
+        result["stream"]["compression"] = codec.codec == dase::SnapshotCodec::Quantized ? "lossy" : "lossless";
+        if (codec.codec == dase::SnapshotCodec::Quantized) {
+            result["stream"]["error_bound"] = codec.error_bound;
+        }
+        result["stream"]["chunk_values"] = codec.chunk_values;
+        result["stream"]["frame_data_bytes"] = stream.frameDataBytes();
+        result["stream"]["compression_ratio"] = stream.frameDataBytes() > 0
+            ? static_cast<double>(raw_bytes) / static_cast<double>(stream.frameDataBytes())
+            : 1.0;
+    }
 
     return createSuccessResponse("run_mission_with_snapshots", result, 0);
 }
 
+json CommandRouter::handleRunMissionPipelined(const json& params) {
+    std::string engine_id = params.value("engine_id", "");
+    int num_steps = params.value("num_steps", 0);
+    int iterations_per_node = params.value("iterations_per_node", 30);
+    int snapshot_interval = params.value("snapshot_interval", 1);
+    int analysis_threads = params.value("analysis_threads", 1);
+
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (!instance) {
+        return createErrorResponse("run_mission_pipelined", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+    }
+    const std::string& type = instance->engine_type;
+    if (type != "igsoa_complex" && type != "igsoa_complex_2d" && type != "igsoa_complex_3d") {
+        return createErrorResponse("run_mission_pipelined",
+                                   "Pipelined missions require an igsoa_complex, igsoa_complex_2d or igsoa_complex_3d engine",
+                                   "INVALID_ENGINE_TYPE");
+    }
+    if (num_steps <= 0 || snapshot_interval <= 0 || analysis_threads <= 0) {
+        return createErrorResponse("run_mission_pipelined",
+                                   "num_steps, snapshot_interval and analysis_threads must be positive",
+                                   "INVALID_PARAMETER");
+    }
+
+    // fft: field names (or one name); diagnostics: true or a subset of
+    // energy / center_of_mass
+    PipelineAnalysis analysis;
+    const size_t num_nodes = static_cast<size_t>(instance->num_nodes);
+    analysis.N_x = instance->dimension_x > 0 ? static_cast<size_t>(instance->dimension_x) : num_nodes;
+    analysis.N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : 1;
+    analysis.N_z = instance->dimension_z > 0 ? static_cast<size_t>(instance->dimension_z) : 1;
+    if (params.contains("fft")) {
+        const json& fft = params["fft"];
+        if (fft.is_string()) {
+            analysis.fft_fields.push_back(fft.get<std::string>());
+        } else if (fft.is_array() && std::all_of(fft.begin(), fft.end(), [](const json& f) { return f.is_string(); })) {
+            analysis.fft_fields = fft.get<std::vector<std::string>>();
+        } else {
+            return createErrorResponse("run_mission_pipelined", "fft must be a field name or an array of names",
+                                       "INVALID_PARAMETER");
+        }
+        for (const std::string& field : analysis.fft_fields) {
+            if (field != "psi_real" && field != "psi_imag" && field != "phi") {
+                return createErrorResponse("run_mission_pipelined", "Unknown fft field: " + field, "INVALID_PARAMETER");
+            }
+        }
+    }
+    if (params.contains("diagnostics") && !(params["diagnostics"].is_boolean() && !params["diagnostics"].get<bool>())) {
+        std::vector<std::string> observables;
+        std::string error;
+        if (!parseObservables(params["diagnostics"], observables, error)) {
+            return createErrorResponse("run_mission_pipelined", error, "INVALID_PARAMETER");
+        }
+        if (observables.empty()) {
+            observables = {"energy", "center_of_mass"};
+        }
+        for (const std::string& name : observables) {
+            if (name == "energy") {
+                analysis.energy = true;
+            } else if (name == "center_of_mass") {
+                analysis.center_of_mass = true;
+            } else {
+                return createErrorResponse("run_mission_pipelined",
+                                           "Pipelined diagnostics are energy and center_of_mass, not " + name,
+                                           "INVALID_PARAMETER");
+            }
+        }
+    }
+
+    // stream (default on when responses have a sink): one response per
+    // analysed snapshot as it finishes; otherwise they are collected
+    const bool stream = params.value("stream", true) && static_cast<bool>(scheduler_callback);
+    const json request_id = current_request_id;
+    std::mutex collected_mutex;
+    std::vector<json> collected;
+    MissionPipeline::ResultCallback on_result;
+    if (stream) {
+        on_result = [this, &request_id, &engine_id](const json& analysed) {
+            json event = analysed;
+            event["event"] = "snapshot";
+            event["engine_id"] = engine_id;
+            scheduler_callback(withRequestId(createSuccessResponse("run_mission_pipelined", event,
+                                                                   analysed.value("analysis_ms", 0.0)),
+                                             request_id));
+        };
+    } else {
+        on_result = [&collected_mutex, &collected](const json& analysed) {
+            std::lock_guard<std::mutex> lock(collected_mutex);
+            collected.push_back(analysed);
+        };
+    }
+
+    double engine_ms = 0.0;
+    double capture_ms = 0.0;
+    int snapshot_count = 0;
+    std::string failure;
+    std::string failure_code;
+    {
+        MissionPipeline pipeline(analysis, analysis_threads, on_result);
+        for (int step = snapshot_interval; step <= num_steps; step += snapshot_interval) {
+            auto start = std::chrono::steady_clock::now();
+            if (!engine_manager->runMission(engine_id, snapshot_interval, iterations_per_node)) {
+                failure = "Mission execution failed at step " + std::to_string(step);
+                failure_code = "EXECUTION_FAILED";
+                break;
+            }
+            auto ran = std::chrono::steady_clock::now();
+            engine_ms += std::chrono::duration<double, std::milli>(ran - start).count();
+
+            // Blocks only if every slot is still being analysed
+            PipelineSnapshot& snapshot = pipeline.acquire();
+            snapshot.timestep = step;
+            if (!engine_manager->getAllNodeStates(engine_id, snapshot.psi_real, snapshot.psi_imag, snapshot.phi)) {
+                failure = "Failed to get state at step " + std::to_string(step);
+                failure_code = "STATE_CAPTURE_FAILED";
+                break;
+            }
+            pipeline.submit();
+            capture_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - ran).count();
+            snapshot_count++;
+        }
+        pipeline.finish();
+
+        if (failure.empty()) {
+            json result = {
+                {"event", "completed"},
+                {"steps_completed", num_steps - num_steps % snapshot_interval},
+                {"snapshot_count", snapshot_count},
+                {"streamed", stream},
+                {"pipeline", {
+                    {"slots", pipeline.slotCount()},
+                    {"analysis_threads", analysis_threads},
+                    {"engine_ms", engine_ms},
+                    {"capture_ms", capture_ms},
+                    {"analysis_ms", pipeline.analysisMs()},
+                    {"engine_stall_ms", pipeline.stallMs()}
+                }}
+            };
+            if (!stream) {
+                std::sort(collected.begin(), collected.end(), [](const json& a, const json& b) {
+                    return a["timestep"].get<int64_t>() < b["timestep"].get<int64_t>();
+                });
+                result["analyses"] = collected;
+            }
+            return createSuccessResponse("run_mission_pipelined", result, 0);
+        }
+    }
+    return createErrorResponse("run_mission_pipelined", failure, failure_code);
+}
+
 json CommandRouter::handleRunBenchmark(const json& params) {
     json result = {
         {"benchmark_type", "quick"},
@@ -581,6 +2098,93 @@ json CommandRouter::handleGetMetrics(const json& params) {
         {"total_operations", metrics.total_operations}
     };
 
+    if (engine_type == "igsoa_complex_2d" || engine_type == "igsoa_complex_3d") {
+        result["coupling_mode"] = instance->coupling_mode;
+        result["coupling_cache_bytes"] = metrics.coupling_cache_bytes;
+        result["coupling_spectral_active"] = metrics.coupling_spectral_active;
+        result["precision"] = instance->precision;
+        result["float_precision_active"] = metrics.float_precision_active;
+        result["integrator"] = instance->integrator;
+        if (metrics.active_region_enabled) {
+            const auto& region = metrics.active_region;
+            result["active_region"] = {
+                {"masked_steps", region.masked_steps},
+                {"dense_steps", region.dense_steps},
+                {"fallback_steps", region.fallback_steps},
+                {"fallback_reason", region.fallback_reason},
+                {"tiles", region.tiles},
+                {"last_active_tiles", region.last_active_tiles},
+                {"skipped_tile_ratio", region.skippedRatio()},
+                {"guard_trips", region.guard_trips},
+                {"halo_tiles", region.halo_tiles}
+            };
+        }
+    } else if (engine_type == "igsoa_ensemble_2d") {
+        result["replicas"] = instance->replicas;
+    } else if (engine_type == "satp_higgs_1d" || engine_type == "satp_higgs_2d" ||
+               engine_type == "satp_higgs_3d") {
+        result["evolve_allocations"] = metrics.evolve_allocations;
+        result["precision"] = instance->precision;
+        result["float_precision_active"] = metrics.float_precision_active;
+    }
+
+    // Per-phase step timing; "reset_phases": true clears it after reading
+    if (!metrics.phases.empty()) {
+        json phases = json::object();
+        for (const auto& phase : metrics.phases) {
+            phases[phase.name] = {
+                {"calls", phase.calls},
+                {"total_ms", phase.total_ns * 1e-6},
+                {"mean_us", phase.calls > 0 ? phase.total_ns * 1e-3 / phase.calls : 0.0}
+            };
+        }
+        result["profiling_enabled"] = dase::PhaseProfiler::enabled();
+        result["phases"] = phases;
+        if (params.value("reset_phases", false)) {
+            engine_manager->resetPhaseTimings(engine_id);
+        }
+    }
+
+    if (instance && instance->perf_counters) {
+        const auto& counters = *instance->perf_counters;
+        result["perf_counters"] = {
+            {"supported", dase::PerfCounters::supported()},
+            {"missions", counters.missions()},
+            {"last", perfSampleJson(counters.last(), instance->perf_peak_ipc, instance->perf_peak_dram_gb_per_s)},
+            {"total", perfSampleJson(counters.total(), instance->perf_peak_ipc, instance->perf_peak_dram_gb_per_s)}
+        };
+    }
+
+    if (instance && instance->checkpointer) {
+        const auto& checkpointer = *instance->checkpointer;
+        const auto totals = checkpointer.totals();
+        json recent = json::array();
+        for (const auto& record : checkpointer.recent()) {
+            recent.push_back(checkpointRecordJson(record));
+        }
+        const uint64_t attempts = totals.written + totals.failed;
+        result["checkpoint"] = {
+            {"every_steps", instance->checkpoint_every_steps},
+            {"directory", checkpointer.policy().directory},
+            {"written", totals.written},
+            {"failed", totals.failed},
+            {"pending", checkpointer.pending()},
+            {"bytes_written", totals.bytes},
+            {"mean_stall_ms", attempts > 0 ? totals.stall_ms / attempts : 0.0},
+            {"max_stall_ms", totals.max_stall_ms},
+            {"mean_write_mb_per_s", totals.write_ms > 0.0 ? totals.bytes / 1.0e6 / (totals.write_ms / 1000.0) : 0.0},
+            {"files", checkpointer.files()},
+            {"recent", recent}
+        };
+    }
+
+    // Manager-wide: create/destroy recycling across every engine
+    result["engine_pool"] = enginePoolJson(engine_manager->getEnginePoolStats());
+    result["memory_admission"] = memoryAdmissionJson(EngineManager::getMemoryAdmissionStats());
+    if (engine_manager->resultCacheEnabled()) {
+        result["result_cache"] = resultCacheJson(*engine_manager);
+    }
+
     return createSuccessResponse("get_metrics", result, 0);
 }
 
@@ -604,7 +2208,7 @@ json CommandRouter::handleSetIgsoaState(const json& params) {
         return createErrorResponse("set_igsoa_state", "Missing 'params' parameter", "MISSING_PARAMETER");
     }
 
-    json profile_params = params["params"];
+    const json& profile_params = params["params"];
 
     // Call engine manager to set state
     if (!engine_manager->setIgsoaState(engine_id, profile_type, profile_params)) {
@@ -641,7 +2245,7 @@ json CommandRouter::handleSetSatpState(const json& params) {
         return createErrorResponse("set_satp_state", "Missing 'params' parameter", "MISSING_PARAMETER");
     }
 
-    json profile_params = params["params"];
+    const json& profile_params = params["params"];
 
     // Call engine manager to set state
     if (!engine_manager->setSatpState(engine_id, profile_type, profile_params)) {
@@ -666,20 +2270,78 @@ json CommandRouter::handleGetState(const json& params) {
 
     std::string engine_id = params["engine_id"].get<std::string>();
 
-    // Extract all node states
-    std::vector<double> psi_real, psi_imag, phi;
+    // Cropped / strided / field-masked capture
+    StateSelection selection;
+    std::string selection_error;
+    if (!parseStateSelection(params, engine_manager->getEngine(engine_id), selection, selection_error)) {
+        return createErrorResponse("get_state", selection_error, "INVALID_PARAMETER");
+    }
+    if (selection.active) {
+        std::unique_ptr<BinaryStateFile> binary;
+        if (wantsBinaryTransfer(params)) {
+            binary = std::make_unique<BinaryStateFile>(params.value("binary_path", std::string()), engine_id + "_state");
+        }
+        json fields;
+        if (!captureSelection(*engine_manager, engine_id, selection, binary.get(), fields)) {
+            return createErrorResponse("get_state", "Failed to extract state (wrong engine type or invalid engine_id)", "STATE_EXTRACTION_FAILED");
+        }
 
-    if (!engine_manager->getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
+        json result = selectionDescriptor(selection);
+        result["num_nodes"] = selection.region.outCount();
+        result["engine_type"] = engine_manager->getEngine(engine_id)->engine_type;
+        if (binary) {
+            if (!binary->ok()) {
+                return createErrorResponse("get_state", "Failed to write binary state file", "STATE_TRANSFER_FAILED");
+            }
+            result["transfer"] = "binary";
+            result["binary"] = binary->finish(selection.shape, selection.float32 ? "float32" : "float64");
+            result["binary"]["fields"] = fields;
+        } else {
+            result.update(fields);
+        }
+        return createSuccessResponse("get_state", result, 0);
+    }
+
+    // Extract all node states (one replica of an ensemble)
+    std::vector<double> psi_real, psi_imag, phi;
+    auto* target = engine_manager->getEngine(engine_id);
+    const bool ensemble = target && target->engine_type == "igsoa_ensemble_2d";
+    const int replica = params.value("replica", 0);
+
+    const bool extracted = ensemble
+        ? engine_manager->getReplicaStates(engine_id, replica, psi_real, psi_imag, phi)
+        : engine_manager->getAllNodeStates(engine_id, psi_real, psi_imag, phi);
+    if (!extracted) {
         return createErrorResponse("get_state", "Failed to extract state (wrong engine type or invalid engine_id)", "STATE_EXTRACTION_FAILED");
     }
 
-    // Return state arrays
     json result = {
-        {"num_nodes", psi_real.size()},
-        {"psi_real", psi_real},
-        {"psi_imag", psi_imag},
-        {"phi", phi}
+        {"num_nodes", psi_real.size()}
     };
+    if (ensemble) {
+        result["replica"] = replica;
+    }
+
+    if (wantsBinaryTransfer(params)) {
+        // Arrays go to a file; the response carries only the descriptor
+        BinaryStateFile binary(params.value("binary_path", std::string()), engine_id + "_state");
+        json fields = {
+            {"psi_real", binary.append(psi_real)},
+            {"psi_imag", binary.append(psi_imag)},
+            {"phi", binary.append(phi)}
+        };
+        if (!binary.ok()) {
+            return createErrorResponse("get_state", "Failed to write binary state file", "STATE_TRANSFER_FAILED");
+        }
+        result["transfer"] = "binary";
+        result["binary"] = binary.finish(stateShape(engine_manager->getEngine(engine_id), psi_real.size()));
+        result["binary"]["fields"] = fields;
+    } else {
+        // Return state arrays
+        result["psi_real"] = psi_real;
+        result["psi_imag"] = psi_imag;
+        result["phi"] = phi;
+    }
 
     if (auto* instance = engine_manager->getEngine(engine_id)) {
         result["engine_type"] = instance->engine_type;
@@ -831,6 +2493,175 @@ json CommandRouter::handleGetCenterOfMass(const json& params) {
     return createSuccessResponse("get_center_of_mass", result, 0);
 }
 
+json CommandRouter::handleGetDiagnostics(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("get_diagnostics",
+                                   "Missing 'engine_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (!instance) {
+        return createErrorResponse("get_diagnostics",
+                                   "Engine does not exist",
+                                   "ENGINE_NOT_FOUND");
+    }
+
+    std::vector<std::string> observables;
+    std::string error;
+    if (!parseObservables(params.value("observables", json()), observables, error)) {
+        return createErrorResponse("get_diagnostics", error, "INVALID_PARAMETER");
+    }
+
+    json result;
+    if (!engine_manager->computeDiagnostics(engine_id, observables, result, error)) {
+        const bool wrong_type = error.rfind("Diagnostics require", 0) == 0;
+        return createErrorResponse("get_diagnostics", error,
+                                   wrong_type ? "INVALID_ENGINE_TYPE" : "INVALID_PARAMETER");
+    }
+
+    result["engine_id"] = engine_id;
+    result["engine_type"] = instance->engine_type;
+
+    return createSuccessResponse("get_diagnostics", result, 0);
+}
+
+json CommandRouter::handleGetObservables(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("get_observables",
+                                   "Missing 'engine_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (!instance) {
+        return createErrorResponse("get_observables",
+                                   "Engine does not exist",
+                                   "ENGINE_NOT_FOUND");
+    }
+    const auto* recorder = engine_manager->getObservableRecorder(engine_id);
+    if (!recorder) {
+        return createErrorResponse("get_observables",
+                                   "Observable recording requires an igsoa_complex, igsoa_complex_2d or "
+                                   "igsoa_complex_3d engine",
+                                   "INVALID_ENGINE_TYPE");
+    }
+
+    // Series in recording order: step, time, then one array per channel
+    // ("series": false leaves them out, e.g. to read only the spectrum)
+    const dase::ObservableRing& ring = recorder->series();
+    const bool want_series = params.value("series", true);
+    std::vector<std::pair<std::string, std::vector<double>>> series;
+    json channels = json::array();
+    for (size_t c = 0; c < recorder->channelCount(); c++) {
+        channels.push_back(recorder->channelName(c));
+    }
+    if (want_series) {
+        series.emplace_back("step", std::vector<double>());
+        ring.copySteps(series.back().second);
+        series.emplace_back("time", std::vector<double>());
+        ring.copyTimes(series.back().second);
+        for (size_t c = 0; c < recorder->channelCount(); c++) {
+            series.emplace_back(recorder->channelName(c), std::vector<double>());
+            ring.copyChannel(c, series.back().second);
+        }
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"engine_type", instance->engine_type},
+        {"enabled", recorder->enabled()},
+        {"every_steps", recorder->interval()},
+        {"capacity", ring.capacity()},
+        {"samples", ring.size()},
+        {"recorded", ring.recorded()},
+        {"dropped", ring.dropped()},
+        {"channels", channels}
+    };
+
+    // Sliding spectrum: current window per channel and the spectrogram
+    // frames (frames × frequencies per channel, oldest first)
+    const dase::SlidingSpectrumBank& bank = recorder->spectrum();
+    std::vector<std::pair<std::string, std::vector<double>>> frames;
+    if (bank.enabled()) {
+        const size_t K = bank.frequencyCount();
+        json current = json::object();
+        for (size_t c = 0; c < bank.channels(); c++) {
+            std::vector<double> magnitudes(K);
+            for (size_t k = 0; k < K; k++) magnitudes[k] = bank.magnitude(c, k);
+            current[recorder->channelName(c)] = magnitudes;
+        }
+        frames.emplace_back("step", std::vector<double>());
+        bank.copyFrameSteps(frames.back().second);
+        frames.emplace_back("time", std::vector<double>());
+        bank.copyFrameTimes(frames.back().second);
+        for (size_t c = 0; c < bank.channels(); c++) {
+            frames.emplace_back(recorder->channelName(c), std::vector<double>());
+            bank.copyFrames(c, frames.back().second);
+        }
+        result["spectrum"] = {
+            {"frequencies", recorder->spectrumRequest().frequencies},
+            {"window", bank.config().window},
+            {"hop", bank.config().hop},
+            {"taper", dase::spectrumWindowName(bank.config().shape)},
+            {"samples", bank.samples()},
+            {"ready", bank.ready()},
+            {"frame_capacity", bank.frameCapacity()},
+            {"frames", bank.frameCount()},
+            {"frames_recorded", bank.framesRecorded()},
+            {"frames_dropped", bank.framesDropped()},
+            {"current", current}
+        };
+    }
+
+    // transfer: "binary" writes every array once into one file
+    json fields = json::object();
+    json frame_fields = json::object();
+    if (wantsBinaryTransfer(params)) {
+        BinaryStateFile binary(params.value("binary_path", std::string()), engine_id + "_observables");
+        for (const auto& entry : series) {
+            fields[entry.first] = binary.append(entry.second);
+        }
+        for (const auto& entry : frames) {
+            frame_fields[entry.first] = binary.append(entry.second);
+            if (entry.first != "step" && entry.first != "time") {
+                frame_fields[entry.first]["shape"] = json::array({bank.frameCount(), bank.frequencyCount()});
+            }
+        }
+        if (!binary.ok()) {
+            return createErrorResponse("get_observables", "Failed to write binary observables file",
+                                       "STATE_TRANSFER_FAILED");
+        }
+        result["transfer"] = "binary";
+        result["binary"] = binary.finish(json::array({ring.size()}));
+        result["binary"]["fields"] = fields;
+        if (bank.enabled()) {
+            result["spectrum"]["binary_fields"] = frame_fields;
+        }
+    } else {
+        if (want_series) {
+            for (const auto& entry : series) {
+                fields[entry.first] = entry.second;
+            }
+            result["series"] = fields;
+        }
+        if (bank.enabled()) {
+            for (const auto& entry : frames) {
+                frame_fields[entry.first] = entry.second;
+            }
+            result["spectrum"]["series"] = frame_fields;
+        }
+    }
+
+    if (params.value("clear", false)) {
+        engine_manager->clearObservables(engine_id);
+    }
+
+    return createSuccessResponse("get_observables", result, 0);
+}
+
 // ============================================================================
 // ANALYSIS COMMANDS
 // ============================================================================
@@ -860,14 +2691,17 @@ json CommandRouter::handlePythonAnalyze(const json& params) {
         return createErrorResponse("python_analyze", "Missing script", "MISSING_PARAMETER");
     }
 
+    bool use_worker = params.value("worker", true);
+
     try {
-        auto result_data = g_analysis_router->quickPythonAnalysis(engine_id, script, args);
+        auto result_data = g_analysis_router->quickPythonAnalysis(engine_id, script, args, use_worker);
 
         json result = {
             {"success", result_data.success},
             {"exit_code", result_data.exit_code},
             {"execution_time_ms", result_data.execution_time_ms},
-            {"generated_files", result_data.generated_files}
+            {"generated_files", result_data.generated_files},
+            {"stdout", result_data.stdout_output}
         };
 
         if (!result_data.success) {
@@ -891,8 +2725,31 @@ json CommandRouter::handleEngineFFT(const json& params) {
         return createErrorResponse("engine_fft", "Missing engine_id", "MISSING_PARAMETER");
     }
 
+    // Peak search: the max_peaks largest local maxima above peak_threshold × peak_magnitude
+    dase::analysis::FFTPeakOptions peak_options;
+    if (params.contains("max_peaks")) {
+        if (!params["max_peaks"].is_number_integer() || params["max_peaks"].get<long long>() < 0) {
+            return createErrorResponse("engine_fft", "max_peaks must be a non-negative integer", "INVALID_PARAMETER");
+        }
+        peak_options.max_peaks = params["max_peaks"].get<size_t>();
+    }
+    if (params.contains("peak_threshold")) {
+        if (!params["peak_threshold"].is_number() || !(params["peak_threshold"].get<double>() >= 0.0)) {
+            return createErrorResponse("engine_fft", "peak_threshold must be a non-negative number", "INVALID_PARAMETER");
+        }
+        peak_options.threshold = params["peak_threshold"].get<double>();
+    }
+    if (params.contains("peak_neighborhood")) {
+        if (!params["peak_neighborhood"].is_number_integer() || params["peak_neighborhood"].get<long long>() < 0 ||
+            params["peak_neighborhood"].get<long long>() > 64) {
+            return createErrorResponse("engine_fft", "peak_neighborhood must be an integer in [0, 64]",
+                                       "INVALID_PARAMETER");
+        }
+        peak_options.neighborhood = params["peak_neighborhood"].get<int>();
+    }
+
     try {
-        auto fft_result = g_analysis_router->quickFFT(engine_id, field);
+        auto fft_result = g_analysis_router->quickFFT(engine_id, field, peak_options);
         json result = dase::analysis::EngineFFTAnalysis::toJSON(fft_result);
 
         return createSuccessResponse("engine_fft", result, fft_result.execution_time_ms);
@@ -939,6 +2796,7 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
                 }
             }
             config.python.output_dir = cfg["python"].value("output_dir", "analysis_output");
+            config.python.use_worker = cfg["python"].value("worker", true);
 
             if (cfg["python"].contains("args")) {
                 for (auto& [key, value] : cfg["python"]["args"].items()) {
@@ -9,6 +9,9 @@
 #include <functional>
 #include <memory>
 #include "json.hpp"
+#include "command_table.h"
+#include "mission_scheduler.h"
+#include "../../src/cpp/snapshot_codec.h"
 
 // Forward declarations
 class EngineManager;
@@ -21,26 +24,61 @@ public:
     ~CommandRouter();
 
     // Execute a JSON command and return JSON response
+    // (a top-level "request_id" is echoed on the response)
     json execute(const json& command);
 
+    // Worker pool settings and completion sink for async run_mission.
+    // Must be called before the first async mission; the pool starts lazily.
+    void configureScheduler(const MissionScheduler::Options& options,
+                            MissionScheduler::ResponseCallback on_complete);
+
+    // Register a DASE C API shared library as the backend of engine_type
+    bool loadEnginePlugin(const std::string& engine_type, const std::string& path, std::string& error);
+
+    // Block until every async mission has finished and reported
+    void waitForJobs();
+
+    // Finish async missions, then destroy every engine and give its memory
+    // admission back (daemon session teardown)
+    void destroyEngines();
+
 private:
     // Command handlers
     json handleGetCapabilities(const json& params);
     json handleDescribeEngine(const json& params);
     json handleListEngines(const json& params);
     json handleCreateEngine(const json& params);
+    json handleCreateEnsemble(const json& params);
     json handleDestroyEngine(const json& params);
+    json handleConfigureEnginePool(const json& params);
+    json handleConfigureMemoryBudget(const json& params);
+    json handleConfigureResultCache(const json& params);
     json handleSetNodeState(const json& params);
     json handleGetNodeState(const json& params);
     json handleSetIgsoaState(const json& params);
     json handleSetSatpState(const json& params);
     json handleRunMission(const json& params);
     json handleRunMissionWithSnapshots(const json& params);
+    json streamMissionSnapshots(const std::string& engine_id,
+                                int num_steps,
+                                int iterations_per_node,
+                                int snapshot_interval,
+                                const std::string& stream_path,
+                                const dase::SnapshotCodecOptions& codec);
+    json handleRunMissionPipelined(const json& params);
     json handleRunBenchmark(const json& params);
     json handleGetMetrics(const json& params);
     json handleGetState(const json& params);
     json handleGetSatpState(const json& params);
     json handleGetCenterOfMass(const json& params);
+    json handleGetDiagnostics(const json& params);
+    json handleGetObservables(const json& params);
+    json handleBatch(const json& params);
+
+    // Async mission handlers
+    json handleGetJobStatus(const json& params);
+    json handleListJobs(const json& params);
+    json handleCancelJob(const json& params);
 
     // Analysis command handlers
     json handleCheckAnalysisTools(const json& params);
@@ -61,6 +99,15 @@ private:
     // Engine manager (manages engine lifecycle)
     std::unique_ptr<EngineManager> engine_manager;
 
+    // Async mission workers (declared after engine_manager so it stops first)
+    MissionScheduler* getScheduler();
+    MissionScheduler::Options scheduler_options;
+    MissionScheduler::ResponseCallback scheduler_callback;
+    std::unique_ptr<MissionScheduler> scheduler;
+
+    // request_id of the command being executed (null if untagged)
+    json current_request_id;
+
     // Command registry
-    std::map<std::string, std::function<json(const json&)>> command_handlers;
+    CommandTable<std::function<json(const json&)>> command_handlers;
 };
@@ -0,0 +1,80 @@
+/**
+ * Command Table - Handler lookup by command name
+ *
+ * An open-addressed hash table built once when the router registers its
+ * handlers. find() hashes the name (FNV-1a), probes from its slot and
+ * confirms with one string compare, so a lookup costs no allocation and
+ * no chain of string compares. The table is kept at most a quarter full,
+ * so a probe rarely passes one slot.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+template <typename Handler>
+class CommandTable {
+public:
+    void add(const std::string& name, Handler handler) {
+        if (4 * (entries.size() + 1) > slots.size()) {
+            rehash(slots.empty() ? 64 : 2 * slots.size());
+        }
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].first == name) {
+                entries[i].second = std::move(handler);
+                return;
+            }
+        }
+        entries.emplace_back(name, std::move(handler));
+        insert(entries.size() - 1);
+    }
+
+    // Handler registered for name, or nullptr
+    const Handler* find(std::string_view name) const {
+        if (slots.empty()) {
+            return nullptr;
+        }
+        const size_t mask = slots.size() - 1;
+        for (size_t slot = hash(name) & mask;; slot = (slot + 1) & mask) {
+            const int32_t index = slots[slot];
+            if (index < 0) {
+                return nullptr;
+            }
+            if (entries[index].first == name) {
+                return &entries[index].second;
+            }
+        }
+    }
+
+    size_t size() const { return entries.size(); }
+
+private:
+    static uint64_t hash(std::string_view name) {
+        uint64_t h = 14695981039346656037ull;
+        for (char c : name) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    void insert(size_t index) {
+        const size_t mask = slots.size() - 1;
+        size_t slot = hash(entries[index].first) & mask;
+        while (slots[slot] >= 0) slot = (slot + 1) & mask;
+        slots[slot] = static_cast<int32_t>(index);
+    }
+
+    void rehash(size_t slot_count) {
+        slots.assign(slot_count, -1);
+        for (size_t i = 0; i < entries.size(); i++) insert(i);
+    }
+
+    std::vector<std::pair<std::string, Handler>> entries;
+    std::vector<int32_t> slots;   // entry index, -1 for an empty slot
+};
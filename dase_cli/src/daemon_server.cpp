@@ -0,0 +1,460 @@
+/**
+ * Daemon Server Implementation
+ */
+
+#include "daemon_server.h"
+#include "command_parser.h"
+#include "command_router.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+
+json daemonSuccess(const std::string& command, const json& result) {
+    return {
+        {"status", "success"},
+        {"command", command},
+        {"result", result},
+        {"execution_time_ms", 0.0}
+    };
+}
+
+json daemonError(const std::string& command, const std::string& error, const std::string& error_code) {
+    return {
+        {"status", "error"},
+        {"command", command},
+        {"error", error},
+        {"error_code", error_code}
+    };
+}
+
+json lineTooLong(size_t max_line_bytes) {
+    return daemonError("", "Request line exceeds " + std::to_string(max_line_bytes) + " bytes", "LINE_TOO_LONG");
+}
+
+json withRequestId(json response, const json& command) {
+    if (command.is_object() && command.contains("request_id")) {
+        response["request_id"] = command["request_id"];
+    }
+    return response;
+}
+
+} // namespace
+
+DaemonServer::Session::~Session() {
+    // Free the engines (and their memory admission) for the other sessions,
+    // and stop the router's workers while the client list they report to exists
+    if (router) {
+        router->destroyEngines();
+    }
+    router.reset();
+}
+
+void DaemonServer::Session::broadcast(const json& response) {
+    std::lock_guard<std::mutex> lock(clients_mutex);
+    for (Connection* client : clients) {
+        client->write(response);
+    }
+}
+
+bool DaemonServer::Connection::write(const json& response) {
+#ifndef _WIN32
+    const std::string line = response.dump() + '\n';
+    std::lock_guard<std::mutex> lock(write_mutex);
+    size_t sent = 0;
+    while (sent < line.size()) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t n = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+#else
+        const ssize_t n = ::send(fd, line.data() + sent, line.size() - sent, 0);
+#endif
+        if (n <= 0) {
+            return false;  // Client went away; its reader sees EOF
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+#else
+    (void)response;
+    return false;
+#endif
+}
+
+DaemonServer::DaemonServer(Options options)
+    : options_(std::move(options)) {}
+
+DaemonServer::~DaemonServer() {
+#ifndef _WIN32
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        ::unlink(options_.socket_path.c_str());
+    }
+#endif
+}
+
+bool DaemonServer::start(std::string& error) {
+#ifdef _WIN32
+    error = "--listen needs Unix domain sockets, which this build does not support";
+    return false;
+#else
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (options_.socket_path.empty() || options_.socket_path.size() >= sizeof(address.sun_path)) {
+        error = "Socket path must be 1-" + std::to_string(sizeof(address.sun_path) - 1) + " bytes";
+        return false;
+    }
+    std::memcpy(address.sun_path, options_.socket_path.c_str(), options_.socket_path.size() + 1);
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    // Replace a socket left behind by a daemon that did not exit cleanly,
+    // but not one a running daemon still accepts on
+    struct stat info;
+    if (::stat(options_.socket_path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        const bool live = probe >= 0 &&
+                          ::connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0) {
+            ::close(probe);
+        }
+        if (live) {
+            error = "Another daemon is listening on " + options_.socket_path;
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+            return false;
+        }
+        ::unlink(options_.socket_path.c_str());
+    }
+
+    // Owner only from the moment the file exists: clients can run any command.
+    // start() runs before any thread, so the process-wide umask is safe to swap
+    const mode_t previous_mask = ::umask(077);
+    const int bound = ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    const int bind_errno = errno;
+    ::umask(previous_mask);
+    if (bound != 0) {
+        error = "bind " + options_.socket_path + ": " + std::strerror(bind_errno);
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    ::chmod(options_.socket_path.c_str(), 0600);
+    if (::listen(listen_fd_, 16) != 0) {
+        error = std::string("listen: ") + std::strerror(errno);
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        ::unlink(options_.socket_path.c_str());
+        return false;
+    }
+    return true;
+#endif
+}
+
+void DaemonServer::stop() {
+    stopping_ = true;
+}
+
+void DaemonServer::run() {
+#ifndef _WIN32
+    if (listen_fd_ < 0) {
+        return;
+    }
+
+    while (!stopping_) {
+        // Poll so that stop() is noticed without a new client
+        pollfd pending{listen_fd_, POLLIN, 0};
+        if (::poll(&pending, 1, 200) <= 0 || !(pending.revents & POLLIN)) {
+            continue;
+        }
+        const int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+
+        auto connection = std::make_shared<Connection>();
+        connection->fd = fd;
+        connection->id = ++next_connection_id_;
+
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        // Reap threads of clients that have disconnected
+        for (uint64_t id : finished_) {
+            threads_[id].join();
+            threads_.erase(id);
+        }
+        finished_.clear();
+        if (connections_.size() >= options_.max_clients) {
+            connection->write(daemonError("", "Too many clients (max " + std::to_string(options_.max_clients) + ")",
+                                          "TOO_MANY_CLIENTS"));
+            ::close(fd);
+            continue;
+        }
+        connections_[connection->id] = connection;
+        threads_[connection->id] = std::thread([this, connection]() { serve(connection); });
+    }
+
+    // Wake every client reader, then wait for them to detach
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto& entry : connections_) {
+            ::shutdown(entry.second->fd, SHUT_RDWR);
+        }
+    }
+    for (auto& entry : threads_) {
+        entry.second.join();
+    }
+    threads_.clear();
+    finished_.clear();
+
+    std::map<std::string, std::shared_ptr<Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        sessions.swap(sessions_);
+    }
+    for (auto& entry : sessions) {
+        entry.second->router->waitForJobs();
+    }
+    sessions.clear();
+
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    ::unlink(options_.socket_path.c_str());
+#endif
+}
+
+std::shared_ptr<DaemonServer::Session> DaemonServer::createSession(const std::string& name, std::string& error) {
+    auto session = std::make_shared<Session>();
+    session->name = name;
+    session->router = std::make_unique<CommandRouter>();
+    Session* raw = session.get();  // The router is owned by, and dies with, the session
+    session->router->configureScheduler(options_.scheduler, [raw](const json& response) { raw->broadcast(response); });
+    for (const auto& plugin : options_.plugins) {
+        if (!session->router->loadEnginePlugin(plugin.first, plugin.second, error)) {
+            return nullptr;
+        }
+    }
+    return session;
+}
+
+void DaemonServer::attach(Connection& connection, const std::shared_ptr<Session>& session) {
+    detach(connection);
+    {
+        std::lock_guard<std::mutex> lock(session->clients_mutex);
+        session->clients.insert(&connection);
+    }
+    connection.session = session;
+}
+
+void DaemonServer::detach(Connection& connection) {
+    std::shared_ptr<Session> session = std::move(connection.session);
+    connection.session.reset();
+    if (!session) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(session->clients_mutex);
+        session->clients.erase(&connection);
+    }
+    if (session->name.empty()) {
+        // Private session: nobody can reach its engines any more
+        session->router->waitForJobs();
+    }
+}
+
+void DaemonServer::serve(std::shared_ptr<Connection> connection) {
+#ifndef _WIN32
+    std::string error;
+    std::shared_ptr<Session> session = createSession("", error);
+    if (!session) {
+        connection->write(daemonError("", error, "PLUGIN_LOAD_FAILED"));
+    } else {
+        attach(*connection, session);
+        session.reset();
+    }
+
+    std::string buffer;
+    char chunk[65536];
+    bool open = connection->session != nullptr;
+    bool discarding = false;  // Inside a line past max_line_bytes
+    while (open) {
+        const ssize_t n = ::recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            break;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t start = 0;
+        for (size_t end; open && (end = buffer.find('\n', start)) != std::string::npos; start = end + 1) {
+            if (discarding || end - start > options_.max_line_bytes) {
+                if (!discarding) {
+                    open = connection->write(lineTooLong(options_.max_line_bytes));
+                }
+                discarding = false;
+                continue;
+            }
+            std::string line = buffer.substr(start, end - start);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+
+            json command;
+            json response;
+            try {
+                command = dase::parseCommand(line);
+            } catch (const json::exception& e) {
+                response = {
+                    {"status", "error"},
+                    {"error", std::string("JSON parse error: ") + e.what()},
+                    {"error_code", "PARSE_ERROR"}
+                };
+            }
+            if (response.is_null() && !handleDaemonCommand(*connection, command, response)) {
+                std::shared_ptr<Session> current = connection->session;
+                std::lock_guard<std::mutex> lock(current->execute_mutex);
+                try {
+                    response = current->router->execute(command);
+                } catch (const std::exception& e) {
+                    response = {
+                        {"status", "error"},
+                        {"error", e.what()},
+                        {"error_code", "INTERNAL_ERROR"}
+                    };
+                }
+            }
+            open = connection->write(response);
+        }
+        buffer.erase(0, start);
+
+        // Answer an over-long line as soon as it passes the cap, and drop
+        // its bytes up to the next newline instead of buffering them
+        if (open && buffer.size() > options_.max_line_bytes) {
+            if (!discarding) {
+                open = connection->write(lineTooLong(options_.max_line_bytes));
+                discarding = true;
+            }
+            buffer.clear();
+        }
+    }
+
+    detach(*connection);
+    ::close(connection->fd);
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    connections_.erase(connection->id);
+    finished_.push_back(connection->id);
+#else
+    (void)connection;
+#endif
+}
+
+bool DaemonServer::handleDaemonCommand(Connection& connection, const json& command, json& response) {
+    const std::string name = command.is_object() ? command.value("command", std::string()) : std::string();
+    const json params = command.is_object() && command.contains("params") ? command["params"] : json::object();
+
+    if (name == "attach_session") {
+        const std::string session_name = params.value("session", std::string());
+        if (session_name.empty()) {
+            response = withRequestId(daemonError(name, "Missing required parameter: session", "MISSING_PARAMETER"), command);
+            return true;
+        }
+        std::shared_ptr<Session> session;
+        bool created = false;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            auto it = sessions_.find(session_name);
+            if (it != sessions_.end()) {
+                session = it->second;
+            } else {
+                std::string error;
+                session = createSession(session_name, error);
+                if (!session) {
+                    response = withRequestId(daemonError(name, error, "PLUGIN_LOAD_FAILED"), command);
+                    return true;
+                }
+                sessions_[session_name] = session;
+                created = true;
+            }
+        }
+        if (connection.session != session) {
+            attach(connection, session);
+        }
+        response = withRequestId(daemonSuccess(name, {{"session", session_name}, {"created", created}}), command);
+        return true;
+    }
+
+    if (name == "list_sessions") {
+        json sessions = json::array();
+        std::vector<std::shared_ptr<Session>> named;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            for (const auto& entry : sessions_) named.push_back(entry.second);
+        }
+        for (const auto& session : named) {
+            size_t clients = 0;
+            {
+                std::lock_guard<std::mutex> lock(session->clients_mutex);
+                clients = session->clients.size();
+            }
+            json engines;
+            {
+                std::lock_guard<std::mutex> lock(session->execute_mutex);
+                engines = session->router->execute({{"command", "list_engines"}, {"params", json::object()}});
+            }
+            sessions.push_back({
+                {"session", session->name},
+                {"clients", clients},
+                {"engines", engines.contains("result") ? engines["result"].value("engines", json::array()).size() : 0}
+            });
+        }
+        const std::string current = connection.session ? connection.session->name : std::string();
+        response = withRequestId(daemonSuccess(name, {{"sessions", sessions}, {"current_session", current}}), command);
+        return true;
+    }
+
+    if (name == "close_session") {
+        const std::string session_name = params.value("session", std::string());
+        std::shared_ptr<Session> session;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            auto it = sessions_.find(session_name);
+            if (it != sessions_.end()) {
+                session = it->second;
+                sessions_.erase(it);
+            }
+        }
+        if (!session) {
+            response = withRequestId(daemonError(name, "Session not found: " + session_name, "SESSION_NOT_FOUND"),
+                                     command);
+            return true;
+        }
+        // Attached clients keep the router (and engines) until they detach;
+        // the session is freed with its last reference
+        response = withRequestId(daemonSuccess(name, {{"session", session_name}, {"closed", true}}), command);
+        return true;
+    }
+
+    if (name == "shutdown_daemon") {
+        stop();
+        response = withRequestId(daemonSuccess(name, {{"stopping", true}}), command);
+        return true;
+    }
+
+    return false;
+}
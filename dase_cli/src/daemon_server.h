@@ -0,0 +1,115 @@
+/**
+ * Daemon Server - Long-lived dase_cli serving clients over a local socket
+ *
+ * `dase_cli --listen /tmp/dase.sock` keeps one process (engines, FFT
+ * plan caches and imported wisdom) alive between clients. Each accepted
+ * connection speaks the stdin protocol: one JSON command per line in,
+ * one JSON response per line out.
+ *
+ * Engines live in sessions. A session is a CommandRouter with its own
+ * EngineManager and async worker pool, so engine ids ("engine_001", ...)
+ * are per session and clients cannot see each other's engines. A new
+ * connection starts in a private session that is destroyed when it
+ * disconnects. attach_session moves it into a named session that outlives
+ * its clients, so a backend can reconnect and find its engines warm.
+ * Commands of one session run one at a time (in arrival order per
+ * client); different sessions run concurrently on their connection
+ * threads.
+ *
+ * Daemon commands, answered by the server itself:
+ *   attach_session  {"session": name}  join (or create) a named session
+ *   list_sessions                      names, clients and engine counts
+ *   close_session   {"session": name}  drop a named session and its engines
+ *   shutdown_daemon                    stop accepting and close every client
+ *
+ * Async completions and streamed events of a session go to every client
+ * attached to it. A request line longer than max_line_bytes is dropped
+ * with a LINE_TOO_LONG error. Unix domain sockets only; on Windows start()
+ * fails.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "json.hpp"
+#include "mission_scheduler.h"
+
+class CommandRouter;
+
+class DaemonServer {
+public:
+    struct Options {
+        std::string socket_path;
+        MissionScheduler::Options scheduler;                          // Per session
+        std::vector<std::pair<std::string, std::string>> plugins;      // type, path; loaded per session
+        size_t max_clients = 64;
+        size_t max_line_bytes = size_t(256) << 20;                     // Longest request line
+    };
+
+    explicit DaemonServer(Options options);
+    ~DaemonServer();
+
+    DaemonServer(const DaemonServer&) = delete;
+    DaemonServer& operator=(const DaemonServer&) = delete;
+
+    // Bind and listen on options.socket_path. A stale socket file is
+    // replaced; one a live daemon still accepts on is an error
+    bool start(std::string& error);
+
+    // Accept clients until shutdown_daemon or stop(); then close every
+    // client, finish async missions and remove the socket file
+    void run();
+
+    // Make run() return (any thread)
+    void stop();
+
+private:
+    struct Connection;
+
+    struct Session {
+        std::string name;                     // Empty for a private session
+        std::unique_ptr<CommandRouter> router;
+        std::mutex execute_mutex;             // One command at a time
+        std::mutex clients_mutex;
+        std::set<Connection*> clients;
+
+        ~Session();
+        void broadcast(const nlohmann::json& response);
+    };
+
+    struct Connection {
+        int fd = -1;
+        uint64_t id = 0;
+        std::mutex write_mutex;
+        std::shared_ptr<Session> session;
+
+        bool write(const nlohmann::json& response);
+    };
+
+    std::shared_ptr<Session> createSession(const std::string& name, std::string& error);
+    void attach(Connection& connection, const std::shared_ptr<Session>& session);
+    void detach(Connection& connection);
+    void serve(std::shared_ptr<Connection> connection);
+    bool handleDaemonCommand(Connection& connection, const nlohmann::json& command, nlohmann::json& response);
+
+    Options options_;
+    int listen_fd_ = -1;
+    std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> next_connection_id_{0};
+
+    std::mutex sessions_mutex_;
+    std::map<std::string, std::shared_ptr<Session>> sessions_;   // Named sessions
+
+    std::mutex connections_mutex_;
+    std::map<uint64_t, std::shared_ptr<Connection>> connections_;
+    std::map<uint64_t, std::thread> threads_;
+    std::vector<uint64_t> finished_;   // Connections whose thread is done (join on next accept)
+};
@@ -6,9 +6,17 @@
 #include <cmath>
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <queue>
+#include <stdexcept>
 
 #ifdef USE_FFTW3
 #include <fftw3.h>
+#include <array>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include "../../src/cpp/fftw_wisdom_cache.hpp"
 #endif
 
 #ifndef M_PI
@@ -18,9 +26,150 @@
 namespace dase {
 namespace analysis {
 
+namespace {
+
+// A local maximum of the spectrum; ties go to the lower bin index
+struct PeakCandidate {
+    double magnitude;
+    size_t index;
+};
+
+inline bool strongerPeak(const PeakCandidate& a, const PeakCandidate& b) {
+    return a.magnitude > b.magnitude || (a.magnitude == b.magnitude && a.index < b.index);
+}
+
+// Bounded set of the k strongest candidates (min-heap on strength)
+class TopPeaks {
+public:
+    explicit TopPeaks(size_t k) : k_(k) {}
+
+    // False when a candidate this weak can no longer get in
+    bool admits(double magnitude, size_t index) const {
+        if (k_ == 0) return false;
+        return heap_.size() < k_ || strongerPeak({magnitude, index}, heap_.top());
+    }
+
+    void push(double magnitude, size_t index) {
+        if (!admits(magnitude, index)) return;
+        heap_.push({magnitude, index});
+        if (heap_.size() > k_) heap_.pop();
+    }
+
+    // Candidates strongest first (empties the set)
+    std::vector<PeakCandidate> take() {
+        std::vector<PeakCandidate> out;
+        out.reserve(heap_.size());
+        while (!heap_.empty()) {
+            out.push_back(heap_.top());
+            heap_.pop();
+        }
+        std::reverse(out.begin(), out.end());
+        return out;
+    }
+
+private:
+    struct Weaker {
+        bool operator()(const PeakCandidate& a, const PeakCandidate& b) const { return strongerPeak(a, b); }
+    };
+
+    size_t k_;
+    std::priority_queue<PeakCandidate, std::vector<PeakCandidate>, Weaker> heap_;
+};
+
+// Signed frequency index of bin i of an axis of length n (Nyquist positive)
+inline long signedIndex(size_t i, size_t n) {
+    return i <= n / 2 ? static_cast<long>(i) : static_cast<long>(i) - static_cast<long>(n);
+}
+
+} // namespace
+
+#ifdef USE_FFTW3
+namespace {
+
+/**
+ * Process-wide pool of r2c plans keyed by shape
+ *
+ * engine_fft runs on every snapshot of a monitoring loop, so each shape is
+ * planned once with FFTW_MEASURE (fast when the wisdom loaded at startup
+ * already covers it) and keeps its aligned in/out buffers. Wisdom is saved
+ * when the process exits.
+ */
+class FFTPlanPool {
+public:
+    struct Plan {
+        fftw_plan plan = nullptr;
+        double* in = nullptr;
+        fftw_complex* out = nullptr;
+    };
+
+    // Holds the pool lock for as long as the caller uses the buffers
+    struct Lease {
+        std::unique_lock<std::mutex> lock;
+        Plan& plan;
+    };
+
+    static FFTPlanPool& instance() {
+        static FFTPlanPool pool;
+        return pool;
+    }
+
+    /**
+     * Plan for a row-major real array of extents dims[0..rank) (slowest first)
+     * @param out_count Complex outputs to allocate (the r2c output size)
+     */
+    Lease acquire(int rank, const int* dims, size_t out_count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Key key = {rank, dims[0], rank > 1 ? dims[1] : 0, rank > 2 ? dims[2] : 0};
+        auto it = plans_.find(key);
+        if (it == plans_.end()) {
+            size_t in_count = 1;
+            for (int d = 0; d < rank; d++) {
+                in_count *= static_cast<size_t>(dims[d]);
+            }
+
+            Plan entry;
+            entry.in = fftw_alloc_real(in_count);
+            entry.out = fftw_alloc_complex(out_count);
+
+            // FFTW_MEASURE overwrites the buffers, so plan before any data is copied in
+            entry.plan = fftw_plan_dft_r2c(rank, dims, entry.in, entry.out, FFTW_MEASURE);
+            if (!entry.plan) {
+                fftw_free(entry.in);
+                fftw_free(entry.out);
+                throw std::runtime_error("FFTW planning failed");
+            }
+            it = plans_.emplace(key, entry).first;
+        }
+        return Lease{std::move(lock), it->second};
+    }
+
+    ~FFTPlanPool() {
+        for (auto& pair : plans_) {
+            fftw_destroy_plan(pair.second.plan);
+            fftw_free(pair.second.in);
+            fftw_free(pair.second.out);
+        }
+        FFTWWisdomCache::flush();
+    }
+
+private:
+    using Key = std::array<int, 4>;
+
+    FFTPlanPool() {
+        FFTWWisdomCache::initialize();
+    }
+
+    std::mutex mutex_;
+    std::map<Key, Plan> plans_;
+};
+
+} // namespace
+#endif // USE_FFTW3
+
 FFTResult EngineFFTAnalysis::compute1DFFT(
     const std::vector<double>& field_data,
-    const std::string& field_name
+    const std::string& field_name,
+    const FFTPeakOptions& peak_options
 ) {
     auto start_time = std::chrono::high_resolution_clock::now();
 
@@ -48,18 +197,14 @@ FFTResult EngineFFTAnalysis::compute1DFFT(
     result.N_z = 1;
     result.field_name = field_name;
 
-    // Allocate FFTW arrays
-    double* in = fftw_alloc_real(result.N);
-    fftw_complex* out = fftw_alloc_complex(result.N / 2 + 1);
-
-    // Copy input data
-    for (size_t i = 0; i < result.N; ++i) {
-        in[i] = field_data[i];
-    }
+    // Pooled plan and buffers for this length
+    const int dims[1] = {static_cast<int>(result.N)};
+    auto lease = FFTPlanPool::instance().acquire(1, dims, result.N / 2 + 1);
+    double* in = lease.plan.in;
+    fftw_complex* out = lease.plan.out;
 
-    // Create plan and execute
-    fftw_plan plan = fftw_plan_dft_r2c_1d(static_cast<int>(result.N), in, out, FFTW_ESTIMATE);
-    fftw_execute(plan);
+    std::memcpy(in, field_data.data(), result.N * sizeof(double));
+    fftw_execute(lease.plan.plan);
 
     // Process results
     size_t half_N = result.N / 2 + 1;
@@ -90,11 +235,7 @@ FFTResult EngineFFTAnalysis::compute1DFFT(
     }
 
     result.dc_component = result.magnitude[0];
-
-    // Cleanup
-    fftw_destroy_plan(plan);
-    fftw_free(in);
-    fftw_free(out);
+    result.peaks = findPeaks(result, peak_options.max_peaks, peak_options.threshold, peak_options.neighborhood);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -108,7 +249,8 @@ FFTResult EngineFFTAnalysis::compute2DFFT(
     const std::vector<double>& field_data,
     size_t N_x,
     size_t N_y,
-    const std::string& field_name
+    const std::string& field_name,
+    const FFTPeakOptions& peak_options
 ) {
     auto start_time = std::chrono::high_resolution_clock::now();
 
@@ -136,61 +278,16 @@ FFTResult EngineFFTAnalysis::compute2DFFT(
     result.N_z = 1;
     result.field_name = field_name;
 
-    // Allocate FFTW arrays
-    double* in = fftw_alloc_real(result.N);
-    fftw_complex* out = fftw_alloc_complex(N_x * (N_y / 2 + 1));
-
-    // Copy input data
-    for (size_t i = 0; i < result.N; ++i) {
-        in[i] = field_data[i];
-    }
-
-    // Create plan and execute
-    fftw_plan plan = fftw_plan_dft_r2c_2d(
-        static_cast<int>(N_y),
-        static_cast<int>(N_x),
-        in,
-        out,
-        FFTW_ESTIMATE
-    );
-    fftw_execute(plan);
-
-    // Process results - store full spectrum
-    std::vector<std::complex<double>> fft_complex;
-    size_t out_size = N_x * (N_y / 2 + 1);
-    fft_complex.reserve(out_size);
+    // Pooled plan and buffers for this shape (row-major: y slowest, so x is halved)
+    const int dims[2] = {static_cast<int>(N_y), static_cast<int>(N_x)};
+    auto lease = FFTPlanPool::instance().acquire(2, dims, N_y * (N_x / 2 + 1));
+    double* in = lease.plan.in;
+    fftw_complex* out = lease.plan.out;
 
-    result.total_power = 0.0;
-    result.peak_magnitude = 0.0;
-    result.peak_frequency = 0.0;
+    std::memcpy(in, field_data.data(), result.N * sizeof(double));
+    fftw_execute(lease.plan.plan);
 
-    for (size_t i = 0; i < out_size; ++i) {
-        std::complex<double> val(out[i][0], out[i][1]);
-        fft_complex.push_back(val);
-
-        double mag = std::abs(val);
-        if (i > 0 && mag > result.peak_magnitude) {
-            result.peak_magnitude = mag;
-            // Compute k_x, k_y for peak
-            size_t ix = i % N_x;
-            size_t iy = i / N_x;
-            double kx = static_cast<double>(ix) / static_cast<double>(N_x);
-            double ky = static_cast<double>(iy) / static_cast<double>(N_y);
-            result.peak_frequency = std::sqrt(kx * kx + ky * ky);
-        }
-
-        result.total_power += mag * mag;
-    }
-
-    result.dc_component = std::abs(fft_complex[0]);
-
-    // Compute radial profile
-    computeRadialProfile2D(result, fft_complex, N_x, N_y);
-
-    // Cleanup
-    fftw_destroy_plan(plan);
-    fftw_free(in);
-    fftw_free(out);
+    analyzeHalfSpectrum(result, reinterpret_cast<const double*>(out), N_x, N_y, 1, peak_options);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -205,7 +302,8 @@ FFTResult EngineFFTAnalysis::compute3DFFT(
     size_t N_x,
     size_t N_y,
     size_t N_z,
-    const std::string& field_name
+    const std::string& field_name,
+    const FFTPeakOptions& peak_options
 ) {
     auto start_time = std::chrono::high_resolution_clock::now();
 
@@ -233,56 +331,16 @@ FFTResult EngineFFTAnalysis::compute3DFFT(
     result.N_z = N_z;
     result.field_name = field_name;
 
-    // Allocate FFTW arrays
-    double* in = fftw_alloc_real(result.N);
-    fftw_complex* out = fftw_alloc_complex(N_x * N_y * (N_z / 2 + 1));
-
-    // Copy input data
-    for (size_t i = 0; i < result.N; ++i) {
-        in[i] = field_data[i];
-    }
-
-    // Create plan and execute
-    fftw_plan plan = fftw_plan_dft_r2c_3d(
-        static_cast<int>(N_z),
-        static_cast<int>(N_y),
-        static_cast<int>(N_x),
-        in,
-        out,
-        FFTW_ESTIMATE
-    );
-    fftw_execute(plan);
-
-    // Process results
-    std::vector<std::complex<double>> fft_complex;
-    size_t out_size = N_x * N_y * (N_z / 2 + 1);
-    fft_complex.reserve(out_size);
-
-    result.total_power = 0.0;
-    result.peak_magnitude = 0.0;
-    result.peak_frequency = 0.0;
-
-    for (size_t i = 0; i < out_size; ++i) {
-        std::complex<double> val(out[i][0], out[i][1]);
-        fft_complex.push_back(val);
-
-        double mag = std::abs(val);
-        if (i > 0 && mag > result.peak_magnitude) {
-            result.peak_magnitude = mag;
-        }
-
-        result.total_power += mag * mag;
-    }
-
-    result.dc_component = std::abs(fft_complex[0]);
+    // Pooled plan and buffers for this shape (row-major: z slowest, so x is halved)
+    const int dims[3] = {static_cast<int>(N_z), static_cast<int>(N_y), static_cast<int>(N_x)};
+    auto lease = FFTPlanPool::instance().acquire(3, dims, N_z * N_y * (N_x / 2 + 1));
+    double* in = lease.plan.in;
+    fftw_complex* out = lease.plan.out;
 
-    // Compute radial profile
-    computeRadialProfile3D(result, fft_complex, N_x, N_y, N_z);
+    std::memcpy(in, field_data.data(), result.N * sizeof(double));
+    fftw_execute(lease.plan.plan);
 
-    // Cleanup
-    fftw_destroy_plan(plan);
-    fftw_free(in);
-    fftw_free(out);
+    analyzeHalfSpectrum(result, reinterpret_cast<const double*>(out), N_x, N_y, N_z, peak_options);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -292,114 +350,236 @@ FFTResult EngineFFTAnalysis::compute3DFFT(
 #endif // USE_FFTW3
 }
 
-#ifdef USE_FFTW3
-void EngineFFTAnalysis::computeRadialProfile2D(
+void EngineFFTAnalysis::analyzeHalfSpectrum(
     FFTResult& result,
-    const std::vector<std::complex<double>>& fft_data,
+    const double* spectrum,
     size_t N_x,
-    size_t N_y
+    size_t N_y,
+    size_t N_z,
+    const FFTPeakOptions& peak_options
 ) {
-    // Compute maximum radius
-    size_t max_radius = static_cast<size_t>(
-        std::sqrt(static_cast<double>(N_x * N_x + N_y * N_y)) / 2.0
-    ) + 1;
+    const size_t half_x = N_x / 2 + 1;
+    const size_t rows = N_y * N_z;
+    const double N_x_d = static_cast<double>(N_x);
+    const double N_y_d = static_cast<double>(N_y);
+    const double N_z_d = static_cast<double>(N_z);
+
+    // |k| in index units stays below half the diagonal of the extents
+    const double diagonal_sq = N_x_d * N_x_d + N_y_d * N_y_d + (N_z > 1 ? N_z_d * N_z_d : 0.0);
+    const size_t max_radius = static_cast<size_t>(std::sqrt(diagonal_sq) / 2.0) + 1;
+
+    auto magnitudeAt = [spectrum](size_t index) {
+        const double re = spectrum[2 * index];
+        const double im = spectrum[2 * index + 1];
+        return std::sqrt(re * re + im * im);
+    };
 
-    std::vector<double> radial_sum(max_radius, 0.0);
-    std::vector<size_t> radial_count(max_radius, 0);
-
-    // Bin by radius
-    for (size_t iy = 0; iy < N_y / 2 + 1; ++iy) {
-        for (size_t ix = 0; ix < N_x; ++ix) {
-            size_t idx = iy * N_x + ix;
-            if (idx >= fft_data.size()) continue;
-
-            // Compute radius
-            double kx = static_cast<double>(ix);
-            double ky = static_cast<double>(iy);
-            if (ix > N_x / 2) kx = static_cast<double>(ix) - static_cast<double>(N_x);
-
-            double k_radius = std::sqrt(kx * kx + ky * ky);
-            size_t bin = static_cast<size_t>(k_radius);
-
-            if (bin < max_radius) {
-                double power = std::abs(fft_data[idx]) * std::abs(fft_data[idx]);
-                radial_sum[bin] += power;
-                radial_count[bin]++;
+    // Stored index of full-spectrum bin (x, y, z) with wrap-around; bins
+    // past the stored half map to their conjugate mirror
+    auto fullIndex = [&](long x, long y, long z) {
+        size_t fx = static_cast<size_t>(((x % static_cast<long>(N_x)) + static_cast<long>(N_x)) % static_cast<long>(N_x));
+        size_t fy = static_cast<size_t>(((y % static_cast<long>(N_y)) + static_cast<long>(N_y)) % static_cast<long>(N_y));
+        size_t fz = static_cast<size_t>(((z % static_cast<long>(N_z)) + static_cast<long>(N_z)) % static_cast<long>(N_z));
+        if (fx >= half_x) {
+            fx = N_x - fx;
+            fy = (N_y - fy) % N_y;
+            fz = (N_z - fz) % N_z;
+        }
+        return (fz * N_y + fy) * half_x + fx;
+    };
+
+    // x = 0 and the even-N_x Nyquist column hold both members of each
+    // conjugate pair; report a peak there only from its canonical member
+    auto selfMirrored = [&](size_t fx) {
+        return fx == 0 || (N_x % 2 == 0 && fx == N_x / 2);
+    };
+    auto canonical = [&](size_t fx, size_t fy, size_t fz) {
+        if (!selfMirrored(fx)) return true;
+        const size_t my = (N_y - fy) % N_y;
+        const size_t mz = (N_z - fz) % N_z;
+        return fz < mz || (fz == mz && fy <= my);
+    };
+
+    const int r = std::max(0, peak_options.neighborhood);
+    const long r_y = N_y > 1 ? r : 0;
+    const long r_z = N_z > 1 ? r : 0;
+    auto isLocalMax = [&](size_t fx, size_t fy, size_t fz, double magnitude) {
+        const size_t index = (fz * N_y + fy) * half_x + fx;
+        // The stored twin of a self-mirrored bin is the same peak (rounding apart)
+        const size_t twin = selfMirrored(fx) ? (((N_z - fz) % N_z) * N_y + (N_y - fy) % N_y) * half_x + fx : index;
+        for (long dz = -r_z; dz <= r_z; ++dz) {
+            for (long dy = -r_y; dy <= r_y; ++dy) {
+                for (long dx = -r; dx <= r; ++dx) {
+                    const size_t neighbor = fullIndex(static_cast<long>(fx) + dx, static_cast<long>(fy) + dy,
+                                                      static_cast<long>(fz) + dz);
+                    if (neighbor == index || neighbor == twin) continue;
+                    if (magnitudeAt(neighbor) > magnitude) return false;
+                }
             }
         }
-    }
+        return true;
+    };
 
-    // Average and store
-    for (size_t i = 0; i < max_radius; ++i) {
-        if (radial_count[i] > 0) {
-            result.radial_k.push_back(static_cast<double>(i) / std::max(N_x, N_y));
-            result.radial_power.push_back(radial_sum[i] / radial_count[i]);
+    // Fixed row blocks, each with its own histogram and peak heap
+    struct Block {
+        std::vector<double> radial_sum;
+        std::vector<double> radial_weight;
+        double total_power = 0.0;
+        double peak_magnitude = 0.0;
+        size_t peak_index = 0;
+        std::vector<PeakCandidate> peaks;
+    };
+    const size_t num_blocks = std::max<size_t>(1, std::min<size_t>(rows, 64));
+    std::vector<Block> blocks(num_blocks);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long b = 0; b < static_cast<long>(num_blocks); ++b) {
+        Block& block = blocks[static_cast<size_t>(b)];
+        block.radial_sum.assign(max_radius, 0.0);
+        block.radial_weight.assign(max_radius, 0.0);
+        TopPeaks top(peak_options.max_peaks);
+
+        const size_t row_begin = rows * static_cast<size_t>(b) / num_blocks;
+        const size_t row_end = rows * static_cast<size_t>(b + 1) / num_blocks;
+        for (size_t row = row_begin; row < row_end; ++row) {
+            const size_t fy = row % N_y;
+            const size_t fz = row / N_y;
+            const double ky = static_cast<double>(signedIndex(fy, N_y));
+            const double kz = static_cast<double>(signedIndex(fz, N_z));
+            const double k_yz_sq = ky * ky + kz * kz;
+
+            for (size_t fx = 0; fx < half_x; ++fx) {
+                const size_t index = row * half_x + fx;
+                const double re = spectrum[2 * index];
+                const double im = spectrum[2 * index + 1];
+                const double power = re * re + im * im;
+                const double magnitude = std::sqrt(power);
+
+                // Bins other than x = 0 and Nyquist also stand for their mirror
+                const double weight = selfMirrored(fx) ? 1.0 : 2.0;
+                const double kx = static_cast<double>(fx);
+                const size_t bin = static_cast<size_t>(std::sqrt(kx * kx + k_yz_sq));
+                if (bin < max_radius) {
+                    block.radial_sum[bin] += weight * power;
+                    block.radial_weight[bin] += weight;
+                }
+
+                block.total_power += power;
+                if (index == 0) continue;
+                if (magnitude > block.peak_magnitude) {
+                    block.peak_magnitude = magnitude;
+                    block.peak_index = index;
+                }
+                if (top.admits(magnitude, index) && canonical(fx, fy, fz) &&
+                    (r == 0 || isLocalMax(fx, fy, fz, magnitude))) {
+                    top.push(magnitude, index);
+                }
+            }
         }
+        block.peaks = top.take();
     }
-}
-
-void EngineFFTAnalysis::computeRadialProfile3D(
-    FFTResult& result,
-    const std::vector<std::complex<double>>& fft_data,
-    size_t N_x,
-    size_t N_y,
-    size_t N_z
-) {
-    // Similar to 2D but with 3D radius
-    size_t max_radius = static_cast<size_t>(
-        std::sqrt(static_cast<double>(N_x * N_x + N_y * N_y + N_z * N_z)) / 2.0
-    ) + 1;
 
+    // Merge in block order
     std::vector<double> radial_sum(max_radius, 0.0);
-    std::vector<size_t> radial_count(max_radius, 0);
-
-    // Simplified binning (full implementation would iterate over all 3D indices)
-    // For now, just compute from available data
-    size_t max_N = std::max({N_x, N_y, N_z});
-    for (size_t i = 0; i < fft_data.size() && i < max_radius; ++i) {
-        double power = std::abs(fft_data[i]) * std::abs(fft_data[i]);
-        radial_sum[i] += power;
-        radial_count[i]++;
+    std::vector<double> radial_weight(max_radius, 0.0);
+    std::vector<PeakCandidate> candidates;
+    result.total_power = 0.0;
+    result.peak_magnitude = 0.0;
+    size_t peak_index = 0;
+    for (const Block& block : blocks) {
+        for (size_t i = 0; i < max_radius; ++i) {
+            radial_sum[i] += block.radial_sum[i];
+            radial_weight[i] += block.radial_weight[i];
+        }
+        result.total_power += block.total_power;
+        if (block.peak_magnitude > result.peak_magnitude) {
+            result.peak_magnitude = block.peak_magnitude;
+            peak_index = block.peak_index;
+        }
+        candidates.insert(candidates.end(), block.peaks.begin(), block.peaks.end());
     }
 
+    auto frequencyOf = [&](size_t index) {
+        const double kx = static_cast<double>(index % half_x) / N_x_d;
+        const double ky = static_cast<double>(signedIndex((index / half_x) % N_y, N_y)) / N_y_d;
+        const double kz = static_cast<double>(signedIndex(index / (half_x * N_y), N_z)) / N_z_d;
+        return std::sqrt(kx * kx + ky * ky + kz * kz);
+    };
+
+    result.dc_component = magnitudeAt(0);
+    result.peak_frequency = result.peak_magnitude > 0.0 ? frequencyOf(peak_index) : 0.0;
+
+    const double max_N = static_cast<double>(std::max({N_x, N_y, N_z}));
+    result.radial_k.clear();
+    result.radial_power.clear();
     for (size_t i = 0; i < max_radius; ++i) {
-        if (radial_count[i] > 0) {
+        if (radial_weight[i] > 0.0) {
             result.radial_k.push_back(static_cast<double>(i) / max_N);
-            result.radial_power.push_back(radial_sum[i] / radial_count[i]);
+            result.radial_power.push_back(radial_sum[i] / radial_weight[i]);
         }
     }
+
+    const size_t keep = std::min(peak_options.max_peaks, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(), strongerPeak);
+    const double min_magnitude = result.peak_magnitude * peak_options.threshold;
+    result.peaks.clear();
+    for (size_t i = 0; i < keep && candidates[i].magnitude > min_magnitude; ++i) {
+        result.peaks.push_back({frequencyOf(candidates[i].index), candidates[i].magnitude});
+    }
 }
-#endif // USE_FFTW3
 
 std::vector<std::pair<double, double>> EngineFFTAnalysis::findPeaks(
     const FFTResult& result,
     size_t n_peaks,
-    double threshold
+    double threshold,
+    int neighborhood
 ) {
     std::vector<std::pair<double, double>> peaks;
 
     if (result.magnitude.empty()) {
+        // 2D/3D: peaks found by the spectrum pass
+        const double min_threshold = result.peak_magnitude * threshold;
+        for (const auto& peak : result.peaks) {
+            if (peaks.size() == n_peaks || peak.second <= min_threshold) break;
+            peaks.push_back(peak);
+        }
         return peaks;
     }
 
     double max_mag = result.peak_magnitude;
     double min_threshold = max_mag * threshold;
 
-    // Create pairs of (frequency, magnitude)
-    std::vector<std::pair<double, double>> all_peaks;
-    for (size_t i = 1; i < result.magnitude.size(); ++i) {
-        if (result.magnitude[i] > min_threshold) {
-            all_peaks.push_back({result.frequencies[i], result.magnitude[i]});
+    // Bins above the threshold with no larger neighbor (periodic, with the
+    // bins past N/2 read from their conjugate mirror)
+    const size_t n = result.magnitude.size();
+    const long N = static_cast<long>(std::max<size_t>(result.N, 1));
+    auto magnitudeAt = [&](long i) {
+        long j = ((i % N) + N) % N;
+        if (j >= static_cast<long>(n)) j = N - j;
+        return j < static_cast<long>(n) ? result.magnitude[static_cast<size_t>(j)] : 0.0;
+    };
+    const long r = std::max(0, neighborhood);
+
+    std::vector<PeakCandidate> candidates;
+    for (size_t i = 1; i < n; ++i) {
+        const double magnitude = result.magnitude[i];
+        if (!(magnitude > min_threshold)) continue;
+        bool local_max = true;
+        for (long d = -r; d <= r && local_max; ++d) {
+            if (d != 0 && magnitudeAt(static_cast<long>(i) + d) > magnitude) local_max = false;
         }
+        if (local_max) candidates.push_back({magnitude, i});
     }
 
-    // Sort by magnitude (descending)
-    std::sort(all_peaks.begin(), all_peaks.end(),
-        [](const auto& a, const auto& b) { return a.second > b.second; });
-
-    // Take top n_peaks
-    size_t count = (std::min)(n_peaks, all_peaks.size());
-    peaks.insert(peaks.end(), all_peaks.begin(), all_peaks.begin() + count);
+    // Top n_peaks without sorting the rest
+    const size_t count = (std::min)(n_peaks, candidates.size());
+    if (count < candidates.size()) {
+        std::nth_element(candidates.begin(), candidates.begin() + count, candidates.end(), strongerPeak);
+    }
+    std::sort(candidates.begin(), candidates.begin() + count, strongerPeak);
+    for (size_t i = 0; i < count; ++i) {
+        peaks.push_back({result.frequencies[candidates[i].index], candidates[i].magnitude});
+    }
 
     return peaks;
 }
@@ -432,10 +612,9 @@ nlohmann::json EngineFFTAnalysis::toJSON(const FFTResult& result) {
         }
     }
 
-    // Find and include peaks
-    auto peaks = findPeaks(result, 10, 0.01);
+    // Peaks found by the compute pass
     j["peaks"] = nlohmann::json::array();
-    for (const auto& [freq, mag] : peaks) {
+    for (const auto& [freq, mag] : result.peaks) {
         j["peaks"].push_back({
             {"frequency", freq},
             {"magnitude", mag}
@@ -6,6 +6,13 @@
  * - Frequency domain analysis
  * - Peak detection in k-space
  * - Radial averaging for 2D/3D
+ *
+ * 2D/3D spectra are analyzed in one pass over FFTW's r2c half-spectrum
+ * (x halved): the block of rows each thread takes bins its power by |k|
+ * into its own radial histogram, weighting every bin by its conjugate
+ * mirror so the profile is that of the full spectrum, and keeps a bounded
+ * heap of its largest local maxima. Blocks merge in a fixed order, so the
+ * result does not depend on the thread count.
  */
 
 #pragma once
@@ -18,6 +25,13 @@
 namespace dase {
 namespace analysis {
 
+// Spectral peak search (findPeaks and the 2D/3D spectrum pass)
+struct FFTPeakOptions {
+    size_t max_peaks = 10;     // Keep the k largest peaks
+    double threshold = 0.01;   // Minimum magnitude, as a fraction of peak_magnitude
+    int neighborhood = 0;      // A peak has no larger bin within ±neighborhood bins per axis (0: any bin)
+};
+
 struct FFTResult {
     // Spectrum data
     std::vector<double> frequencies;      // Frequency bins
@@ -35,6 +49,10 @@ struct FFTResult {
     std::vector<double> radial_k;         // Radial frequency bins
     std::vector<double> radial_power;     // Azimuthally averaged power
 
+    // Largest peaks as (frequency |k|, magnitude), strongest first; DC and
+    // the conjugate mirror of a stored bin are never reported
+    std::vector<std::pair<double, double>> peaks;
+
     // Metadata
     size_t N;                             // Number of points
     size_t N_x, N_y, N_z;                // Dimensions (for 2D/3D)
@@ -49,11 +67,13 @@ public:
      *
      * @param field_data Real or imaginary values
      * @param field_name Name of the field
+     * @param peak_options Peak search for result.peaks
      * @return FFT result with spectrum
      */
     static FFTResult compute1DFFT(
         const std::vector<double>& field_data,
-        const std::string& field_name
+        const std::string& field_name,
+        const FFTPeakOptions& peak_options = FFTPeakOptions()
     );
 
     /**
@@ -63,13 +83,15 @@ public:
      * @param N_x Width
      * @param N_y Height
      * @param field_name Name of the field
-     * @return FFT result with 2D spectrum and radial profile
+     * @param peak_options Peak search for result.peaks
+     * @return FFT statistics, radial profile and peaks (the spectrum itself is not kept)
      */
     static FFTResult compute2DFFT(
         const std::vector<double>& field_data,
         size_t N_x,
         size_t N_y,
-        const std::string& field_name
+        const std::string& field_name,
+        const FFTPeakOptions& peak_options = FFTPeakOptions()
     );
 
     /**
@@ -78,28 +100,38 @@ public:
      * @param field_data Flattened 3D array
      * @param N_x, N_y, N_z Dimensions
      * @param field_name Name of the field
-     * @return FFT result with 3D spectrum and radial profile
+     * @param peak_options Peak search for result.peaks
+     * @return FFT statistics, radial profile and peaks (the spectrum itself is not kept)
      */
     static FFTResult compute3DFFT(
         const std::vector<double>& field_data,
         size_t N_x,
         size_t N_y,
         size_t N_z,
-        const std::string& field_name
+        const std::string& field_name,
+        const FFTPeakOptions& peak_options = FFTPeakOptions()
     );
 
     /**
      * Find peaks in power spectrum
      *
+     * Scans result.magnitude (1D spectra) for bins above the threshold with
+     * no larger bin within ±neighborhood, and keeps the n_peaks largest
+     * (nth_element) without sorting every candidate. 2D/3D results carry no
+     * magnitude array; their peaks come from the compute pass and are
+     * returned from result.peaks, cut to n_peaks and the threshold.
+     *
      * @param result FFT result
      * @param n_peaks Number of peaks to find
      * @param threshold Minimum threshold (fraction of max)
-     * @return Vector of (frequency, magnitude) pairs
+     * @param neighborhood Bins on each side a peak must dominate
+     * @return Vector of (frequency, magnitude) pairs, strongest first
      */
     static std::vector<std::pair<double, double>> findPeaks(
         const FFTResult& result,
         size_t n_peaks = 10,
-        double threshold = 0.01
+        double threshold = 0.01,
+        int neighborhood = 0
     );
 
     /**
@@ -110,22 +142,18 @@ public:
      */
     static nlohmann::json toJSON(const FFTResult& result);
 
-private:
-    // Radial averaging helper for 2D
-    static void computeRadialProfile2D(
-        FFTResult& result,
-        const std::vector<std::complex<double>>& fft_data,
-        size_t N_x,
-        size_t N_y
-    );
-
-    // Radial averaging helper for 3D
-    static void computeRadialProfile3D(
+    /**
+     * Statistics, radial profile and peaks of an r2c half-spectrum
+     *
+     * @param spectrum Interleaved (re, im) of N_z × N_y × (N_x/2 + 1) bins, x fastest
+     */
+    static void analyzeHalfSpectrum(
         FFTResult& result,
-        const std::vector<std::complex<double>>& fft_data,
+        const double* spectrum,
         size_t N_x,
         size_t N_y,
-        size_t N_z
+        size_t N_z,
+        const FFTPeakOptions& peak_options
     );
 };
 
@@ -1,9 +1,11 @@
 /**
  * Engine Manager Implementation
- * Manages lifecycle of DASE engines using dynamic DLL loading
+ * Manages lifecycle of DASE engines through the engine registry
  */
 
 #include "engine_manager.h"
+#include "engine_registry.h"
+#include "command_parser.h"
 #include <chrono>
 #include <sstream>
 #include <iomanip>
@@ -12,11 +14,13 @@
 #include <iostream>
 #include <cstdint>
 #include <algorithm>
+#include <filesystem>
 
 // Include IGSOA engine directly (header-only)
 #include "../../src/cpp/igsoa_complex_engine.h"
 #include "../../src/cpp/igsoa_complex_engine_2d.h"
 #include "../../src/cpp/igsoa_complex_engine_3d.h"
+#include "../../src/cpp/igsoa_ensemble_engine_2d.h"
 #include "../../src/cpp/igsoa_state_init_2d.h"
 #include "../../src/cpp/igsoa_state_init_3d.h"
 
@@ -31,103 +35,63 @@
 #include "../../src/cpp/satp_higgs_physics_3d.h"
 #include "../../src/cpp/satp_higgs_state_init_3d.h"
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <dlfcn.h>
-#endif
+namespace {
 
-// Function pointer types for DASE API
-typedef void* (*CreateEngineFunc)(uint32_t);
-typedef void (*DestroyEngineFunc)(void*);
-typedef void (*RunMissionFunc)(void*, const double*, const double*, uint64_t, uint32_t);
-typedef void (*GetMetricsFunc)(void*, double*, double*, double*, uint64_t*);
+constexpr size_t kDefaultEnginePoolBytes = size_t(1) << 30;
 
-// DLL handle and function pointers
-static HMODULE dll_handle = nullptr;
-static CreateEngineFunc dase_create_engine = nullptr;
-static DestroyEngineFunc dase_destroy_engine = nullptr;
-static RunMissionFunc dase_run_mission_optimized_phase4c = nullptr;
-static GetMetricsFunc dase_get_metrics = nullptr;
-
-// Load the DASE DLL and get function pointers
-static bool loadDaseDLL() {
-    if (dll_handle != nullptr) {
-        return true; // Already loaded
-    }
-
-    // Try to load dase_engine_phase4b.dll
-    dll_handle = LoadLibraryA("dase_engine_phase4b.dll");
-
-    if (!dll_handle) {
-        // Try fallback to dase_engine.dll
-        dll_handle = LoadLibraryA("dase_engine.dll");
-    }
-
-    if (!dll_handle) {
-        DWORD error = GetLastError();
-        std::cerr << "LoadLibrary failed with error code: " << error << std::endl;
-        return false;
-    }
-
-    // Get function pointers
-    dase_create_engine = reinterpret_cast<CreateEngineFunc>(
-        GetProcAddress(dll_handle, "dase_create_engine"));
-
-    dase_destroy_engine = reinterpret_cast<DestroyEngineFunc>(
-        GetProcAddress(dll_handle, "dase_destroy_engine"));
-
-    // Try Phase 4C first, then Phase 4B, then generic optimized
-    dase_run_mission_optimized_phase4c = reinterpret_cast<RunMissionFunc>(
-        GetProcAddress(dll_handle, "dase_run_mission_optimized_phase4c"));
-
-    if (!dase_run_mission_optimized_phase4c) {
-        dase_run_mission_optimized_phase4c = reinterpret_cast<RunMissionFunc>(
-            GetProcAddress(dll_handle, "dase_run_mission_optimized_phase4b"));
-    }
-
-    if (!dase_run_mission_optimized_phase4c) {
-        dase_run_mission_optimized_phase4c = reinterpret_cast<RunMissionFunc>(
-            GetProcAddress(dll_handle, "dase_run_mission_optimized"));
-    }
-
-    dase_get_metrics = reinterpret_cast<GetMetricsFunc>(
-        GetProcAddress(dll_handle, "dase_get_metrics"));
+// Random profiles draw from entropy unless given a seed
+bool reproducibleProfile(const std::string& profile_type, const nlohmann::json& params) {
+    return profile_type.rfind("random", 0) != 0 ||
+           (params.contains("seed") && params["seed"].is_number() && params["seed"].get<double>() != 0.0);
+}
 
-    // Check if all functions were found
-    if (!dase_create_engine) {
-        std::cerr << "Failed to find dase_create_engine" << std::endl;
-    }
-    if (!dase_destroy_engine) {
-        std::cerr << "Failed to find dase_destroy_engine" << std::endl;
-    }
-    if (!dase_run_mission_optimized_phase4c) {
-        std::cerr << "Failed to find dase_run_mission_optimized_phase4c" << std::endl;
-    }
-    if (!dase_get_metrics) {
-        std::cerr << "Failed to find dase_get_metrics" << std::endl;
+// Fold an applied state profile into the provenance (any failure untracks:
+// the engine may be partly written)
+void recordStateProfile(EngineInstance& instance, const char* kind, const std::string& profile_type,
+                        const nlohmann::json& params, bool applied) {
+    if (applied && reproducibleProfile(profile_type, params)) {
+        instance.provenance.event(kind).add(profile_type).add(params.dump());
+    } else {
+        instance.provenance.untrack();
     }
+}
 
-    if (!dase_create_engine || !dase_destroy_engine ||
-        !dase_run_mission_optimized_phase4c || !dase_get_metrics) {
-        FreeLibrary(dll_handle);
-        dll_handle = nullptr;
+// Call fn with the typed engine of a checkpointable instance
+template <typename Fn>
+bool withCheckpointableEngine(EngineInstance& instance, Fn&& fn) {
+    const std::string& type = instance.engine_type;
+    void* handle = instance.engine_handle;
+    if (type == "igsoa_complex") {
+        fn(*static_cast<dase::igsoa::IGSOAComplexEngine*>(handle));
+    } else if (type == "igsoa_complex_2d") {
+        fn(*static_cast<dase::igsoa::IGSOAComplexEngine2D*>(handle));
+    } else if (type == "igsoa_complex_3d") {
+        fn(*static_cast<dase::igsoa::IGSOAComplexEngine3D*>(handle));
+    } else if (type == "satp_higgs_1d") {
+        fn(*static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(handle));
+    } else if (type == "satp_higgs_2d") {
+        fn(*static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(handle));
+    } else if (type == "satp_higgs_3d") {
+        fn(*static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(handle));
+    } else {
         return false;
     }
-
     return true;
 }
 
-EngineManager::EngineManager() : next_engine_id(1) {
-    // Load the DLL on construction
-    if (!loadDaseDLL()) {
-        throw std::runtime_error("Failed to load DASE engine DLL (dase_engine_phase4b.dll or dase_engine.dll)");
-    }
-}
+} // namespace
+
+EngineManager::EngineManager()
+    : registry(std::make_unique<EngineRegistry>())
+    , next_engine_id(1)
+    , pool_bytes(0)
+    , pool_max_bytes(kDefaultEnginePoolBytes)
+    , pool_hits(0)
+    , pool_misses(0) {}
 
 EngineManager::~EngineManager() {
     // Skip cleanup to avoid FFTW/DLL unload ordering issues
-    // Memory will be reclaimed by OS on process exit
+    // Memory will be reclaimed by OS on process exit (parked engines too)
     // TODO: Fix FFTW wisdom cleanup order for long-running services
 
     // Note: For short-lived CLI processes, this is acceptable
@@ -142,12 +106,43 @@ std::string EngineManager::createEngine(const std::string& engine_type,
                                         double dt,
                                         int N_x,
                                         int N_y,
-                                        int N_z) {
+                                        int N_z,
+                                        const std::string& coupling_mode,
+                                        const std::string& precision,
+                                        const std::string& integrator,
+                                        double admission_wait_seconds,
+                                        std::string* error) {
     // Validate parameters
     if (num_nodes <= 0 || num_nodes > 1048576) {
         return "";
     }
 
+    dase::igsoa::IGSOACouplingMode coupling;
+    if (coupling_mode == "direct") {
+        coupling = dase::igsoa::IGSOACouplingMode::Direct;
+    } else if (coupling_mode == "neighbor_cache") {
+        coupling = dase::igsoa::IGSOACouplingMode::NeighborCache;
+    } else if (coupling_mode == "spectral") {
+        coupling = dase::igsoa::IGSOACouplingMode::Spectral;
+    } else if (coupling_mode == "recursive") {
+        coupling = dase::igsoa::IGSOACouplingMode::Recursive;
+    } else {
+        return "";
+    }
+
+    if (precision != "float64" && precision != "float32") {
+        return "";
+    }
+    dase::igsoa::IGSOAIntegrator igsoa_integrator;
+    if (!dase::igsoa::parseIGSOAIntegrator(integrator, igsoa_integrator)) {
+        return "";
+    }
+    const EngineBackend* backend = registry->find(engine_type);
+    if (!backend) {
+        // Unknown engine type (or phase4b without a static build or plugin)
+        return "";
+    }
+
     // Create engine instance
     auto instance = std::make_unique<EngineInstance>();
     instance->engine_id = generateEngineId();
@@ -161,273 +156,243 @@ std::string EngineManager::createEngine(const std::string& engine_type,
     instance->dimension_x = N_x;
     instance->dimension_y = N_y;
     instance->dimension_z = N_z;
-
-    void* handle = nullptr;
-
-    if (engine_type == "phase4b") {
-        // Phase 4B - load from DLL
-        if (!dase_create_engine) {
-            return "";
+    instance->coupling_mode = coupling_mode;
+    instance->precision = precision;
+    instance->integrator = integrator;
+
+    EngineCreateParams params;
+    params.num_nodes = num_nodes;
+    params.R_c = R_c;
+    params.kappa = kappa;
+    params.gamma = gamma;
+    params.dt = dt;
+    params.N_x = N_x;
+    params.N_y = N_y;
+    params.N_z = N_z;
+    params.coupling = coupling;
+    params.use_float = (precision == "float32");
+    params.integrator = igsoa_integrator;
+
+    // Reserve the footprint before allocating; a parked engine brings its reservation
+    const size_t footprint = backend->estimateBytes(params);
+    size_t held = 0;
+    void* handle = takePooledEngine(engine_type, backend, *instance, params, held);
+    if (!admit(held, footprint, admission_wait_seconds, error)) {
+        if (handle) {
+            backend->destroy(handle);
+            dase::MemoryAdmission::instance().release(held);
         }
-        handle = dase_create_engine(static_cast<uint32_t>(num_nodes));
-
-    } else if (engine_type == "igsoa_complex") {
-        // IGSOA Complex - create directly
+        return "";
+    }
+    if (handle) {
+        pool_hits++;
+    } else {
         try {
-            dase::igsoa::IGSOAComplexConfig config;
-            config.num_nodes = num_nodes;
-            config.R_c_default = R_c;
-            config.kappa = kappa;
-            config.gamma = gamma;
-            config.dt = dt;
-
-            // DIAGNOSTIC: Print config being used
-            std::cerr << "[ENGINE MANAGER] Creating IGSOA engine with R_c=" << R_c
-                      << " (config.R_c_default=" << config.R_c_default << ")" << std::endl;
-
-            auto* engine = new dase::igsoa::IGSOAComplexEngine(config);
-            handle = static_cast<void*>(engine);
-
+            handle = backend->create(*instance, params);
         } catch (...) {
-            return "";
+            handle = nullptr;
         }
-
-    } else if (engine_type == "igsoa_complex_2d") {
-        // IGSOA Complex - 2D extension
-        if (N_x <= 0 || N_y <= 0) {
+        if (!handle) {
+            dase::MemoryAdmission::instance().release(footprint);
             return "";
         }
-
-        // If num_nodes doesn't match N_x * N_y, adjust to prevent inconsistency
-        int64_t expected_nodes = static_cast<int64_t>(N_x) * static_cast<int64_t>(N_y);
-        if (expected_nodes <= 0 || expected_nodes > 1048576) {
-            return "";
+        if (backend->reusableBytes(handle) > 0) {
+            pool_misses++;
         }
+    }
 
-        instance->num_nodes = static_cast<int>(expected_nodes);
+    instance->backend = backend;
+    instance->engine_handle = handle;
+    instance->footprint_bytes = footprint;
+    instance->provenance.start();
+    instance->provenance.event("create")
+        .add(engine_type).add(num_nodes).add(R_c).add(kappa).add(gamma).add(dt)
+        .add(N_x).add(N_y).add(N_z).add(coupling_mode).add(precision).add(integrator);
 
-        try {
-            dase::igsoa::IGSOAComplexConfig config;
-            config.num_nodes = static_cast<size_t>(expected_nodes);
-            config.R_c_default = R_c;
-            config.kappa = kappa;
-            config.gamma = gamma;
-            config.dt = dt;
-            config.normalize_psi = false;
+    std::string id = instance->engine_id;
+    engines[id] = std::move(instance);
 
-            auto* engine = new dase::igsoa::IGSOAComplexEngine2D(
-                config,
-                static_cast<size_t>(N_x),
-                static_cast<size_t>(N_y)
-            );
+    return id;
+}
 
-            handle = static_cast<void*>(engine);
+std::string EngineManager::createEnsemble(int N_x,
+                                          int N_y,
+                                          double R_c,
+                                          double dt,
+                                          const std::vector<double>& kappas,
+                                          const std::vector<double>& gammas,
+                                          double admission_wait_seconds,
+                                          std::string* error) {
+    if (N_x <= 0 || N_y <= 0 || kappas.empty() || kappas.size() != gammas.size()) {
+        return "";
+    }
 
-        } catch (...) {
-            return "";
-        }
+    const int64_t nodes = static_cast<int64_t>(N_x) * static_cast<int64_t>(N_y);
+    const int64_t total = nodes * static_cast<int64_t>(kappas.size());
+    if (nodes > 1048576 || total > 16777216) {
+        return "";
+    }
 
-    } else if (engine_type == "igsoa_complex_3d") {
-        if (N_x <= 0 || N_y <= 0 || N_z <= 0) {
-            return "";
-        }
+    auto instance = std::make_unique<EngineInstance>();
+    instance->engine_id = generateEngineId();
+    instance->engine_type = "igsoa_ensemble_2d";
+    instance->num_nodes = static_cast<int>(nodes);
+    instance->created_timestamp = getCurrentTimestamp();
+    instance->R_c = R_c;
+    instance->kappa = kappas[0];
+    instance->gamma = gammas[0];
+    instance->dt = dt;
+    instance->dimension_x = N_x;
+    instance->dimension_y = N_y;
+    instance->replicas = static_cast<int>(kappas.size());
+
+    dase::igsoa::IGSOAComplexConfig config;
+    config.num_nodes = static_cast<size_t>(nodes);
+    config.R_c_default = R_c;
+    config.kappa = kappas[0];
+    config.gamma = gammas[0];
+    config.dt = dt;
+    config.normalize_psi = false;
+
+    const size_t footprint = dase::igsoa::IGSOAEnsembleEngine2D::estimateMemoryUsage(
+        config, static_cast<size_t>(N_x), static_cast<size_t>(N_y), kappas.size());
+    if (!admit(0, footprint, admission_wait_seconds, error)) {
+        return "";
+    }
 
-        int64_t expected_nodes = static_cast<int64_t>(N_x) * static_cast<int64_t>(N_y) * static_cast<int64_t>(N_z);
-        if (expected_nodes <= 0 || expected_nodes > 1048576) {
-            return "";
+    try {
+        auto* ensemble = new dase::igsoa::IGSOAEnsembleEngine2D(
+            config,
+            static_cast<size_t>(N_x),
+            static_cast<size_t>(N_y),
+            kappas.size()
+        );
+        for (size_t b = 0; b < kappas.size(); b++) {
+            ensemble->setReplicaParams(b, kappas[b], gammas[b]);
         }
+        instance->engine_handle = static_cast<void*>(ensemble);
+        instance->backend = registry->find("igsoa_ensemble_2d");
+        instance->footprint_bytes = footprint;
 
-        instance->num_nodes = static_cast<int>(expected_nodes);
-
-        try {
-            dase::igsoa::IGSOAComplexConfig config;
-            config.num_nodes = static_cast<size_t>(expected_nodes);
-            config.R_c_default = R_c;
-            config.kappa = kappa;
-            config.gamma = gamma;
-            config.dt = dt;
-            config.normalize_psi = false;
+    } catch (...) {
+        dase::MemoryAdmission::instance().release(footprint);
+        return "";
+    }
 
-            auto* engine = new dase::igsoa::IGSOAComplexEngine3D(
-                config,
-                static_cast<size_t>(N_x),
-                static_cast<size_t>(N_y),
-                static_cast<size_t>(N_z)
-            );
+    std::string id = instance->engine_id;
+    engines[id] = std::move(instance);
 
-            handle = static_cast<void*>(engine);
+    return id;
+}
 
-        } catch (...) {
-            return "";
-        }
+bool EngineManager::destroyEngine(const std::string& engine_id) {
+    auto it = engines.find(engine_id);
+    if (it == engines.end()) {
+        return false;
+    }
 
-    } else if (engine_type == "satp_higgs_1d") {
-        // SATP+Higgs coupled field engine - 1D
-        if (num_nodes <= 0) {
-            return "";
+    EngineInstance& instance = *it->second;
+    if (instance.engine_handle && instance.backend) {
+        const size_t bytes = pool_max_bytes > 0 ? instance.backend->reusableBytes(instance.engine_handle) : 0;
+        if (bytes > 0 && bytes <= pool_max_bytes) {
+            trimPool(pool_max_bytes - bytes);
+            pool.push_back({instance.engine_type, instance.backend, instance.engine_handle, bytes,
+                            instance.footprint_bytes});
+            pool_bytes += bytes;
+        } else {
+            instance.backend->destroy(instance.engine_handle);
+            dase::MemoryAdmission::instance().release(instance.footprint_bytes);
         }
+    }
 
-        try {
-            // Create SATP+Higgs physics parameters
-            dase::satp_higgs::SATPHiggsParams params;
-            params.c = (R_c > 0.0) ? R_c : 1.0;  // Wave speed (reuse R_c parameter)
-            params.gamma_phi = gamma;             // Scale field dissipation
-            params.gamma_h = gamma;               // Higgs dissipation (same for now)
-            params.lambda = kappa;                // φ-h coupling (reuse kappa parameter)
-            params.mu_squared = -1.0;             // Higgs mass² (negative for SSB)
-            params.lambda_h = 0.5;                // Higgs self-coupling
-            params.updateVEV();                   // Compute VEV
-
-            // Lattice parameters
-            double dx = 0.1;  // Default spatial step (can be overridden via JSON)
-            double dt_val = (dt > 0.0) ? dt : 0.001;  // Time step
-
-            auto* engine = new dase::satp_higgs::SATPHiggsEngine1D(
-                static_cast<size_t>(num_nodes),
-                dx,
-                dt_val,
-                params
-            );
-
-            handle = static_cast<void*>(engine);
-
-        } catch (...) {
-            return "";
-        }
+    engines.erase(it);
+    return true;
+}
 
-    } else if (engine_type == "satp_higgs_2d") {
-        // SATP+Higgs coupled field engine - 2D
-        if (N_x <= 0 || N_y <= 0) {
-            return "";
-        }
+void EngineManager::destroyAllEngines() {
+    while (!engines.empty()) {
+        destroyEngine(engines.begin()->first);
+    }
+    trimPool(0);
+}
 
-        int64_t expected_nodes = static_cast<int64_t>(N_x) * static_cast<int64_t>(N_y);
-        if (expected_nodes <= 0 || expected_nodes > 1048576) {
-            return "";
+bool EngineManager::admit(size_t held, size_t bytes, double wait_seconds, std::string* error) {
+    dase::MemoryAdmission& admission = dase::MemoryAdmission::instance();
+    if (bytes <= held) {
+        admission.release(held - bytes);
+        return true;
+    }
+    const size_t extra = bytes - held;
+    if (admission.tryReserve(extra)) {
+        return true;
+    }
+    // Parked engines are the cheapest memory to give back
+    while (!pool.empty()) {
+        evictPooledEngine(0);
+        if (admission.tryReserve(extra)) {
+            return true;
         }
+    }
+    return admission.reserve(extra, wait_seconds, error);
+}
 
-        instance->num_nodes = static_cast<int>(expected_nodes);
-
-        try {
-            // Create SATP+Higgs physics parameters
-            dase::satp_higgs::SATPHiggsParams params;
-            params.c = (R_c > 0.0) ? R_c : 1.0;
-            params.gamma_phi = gamma;
-            params.gamma_h = gamma;
-            params.lambda = kappa;
-            params.mu_squared = -1.0;
-            params.lambda_h = 0.5;
-            params.updateVEV();
-
-            // Lattice parameters
-            double dx = 0.1;
-            double dt_val = (dt > 0.0) ? dt : 0.001;
-
-            auto* engine = new dase::satp_higgs::SATPHiggsEngine2D(
-                static_cast<size_t>(N_x),
-                static_cast<size_t>(N_y),
-                dx,
-                dt_val,
-                params
-            );
-
-            handle = static_cast<void*>(engine);
-
-        } catch (...) {
-            return "";
-        }
+void EngineManager::setMemoryBudget(size_t bytes) {
+    dase::MemoryAdmission::instance().setBudget(bytes);
+}
 
-    } else if (engine_type == "satp_higgs_3d") {
-        // SATP+Higgs coupled field engine - 3D
-        if (N_x <= 0 || N_y <= 0 || N_z <= 0) {
-            return "";
-        }
+dase::MemoryAdmissionStats EngineManager::getMemoryAdmissionStats() {
+    return dase::MemoryAdmission::instance().stats();
+}
 
-        int64_t expected_nodes = static_cast<int64_t>(N_x) * static_cast<int64_t>(N_y) * static_cast<int64_t>(N_z);
-        if (expected_nodes <= 0 || expected_nodes > 1048576) {
-            return "";
+void* EngineManager::takePooledEngine(const std::string& engine_type, const EngineBackend* backend,
+                                      EngineInstance& instance, const EngineCreateParams& params,
+                                      size_t& reserved) {
+    // Newest first: its caches are the most likely to still be warm
+    for (size_t k = pool.size(); k-- > 0;) {
+        PooledEngine& entry = pool[k];
+        if (entry.engine_type != engine_type || entry.backend != backend) {
+            continue;
         }
-
-        instance->num_nodes = static_cast<int>(expected_nodes);
-
+        bool reused = false;
         try {
-            dase::satp_higgs::SATPHiggsParams params;
-            params.c = (R_c > 0.0) ? R_c : 1.0;
-            params.gamma_phi = gamma;
-            params.gamma_h = gamma;
-            params.lambda = kappa;
-            params.mu_squared = -1.0;
-            params.lambda_h = 0.5;
-            params.updateVEV();
-
-            double dx = 0.1;
-            double dt_val = (dt > 0.0) ? dt : 0.001;
-
-            auto* engine = new dase::satp_higgs::SATPHiggsEngine3D(
-                static_cast<size_t>(N_x),
-                static_cast<size_t>(N_y),
-                static_cast<size_t>(N_z),
-                dx,
-                dt_val,
-                params
-            );
-
-            handle = static_cast<void*>(engine);
-
+            reused = backend->reinit(entry.handle, instance, params);
         } catch (...) {
-            return "";
+            // Not trusted after a throw
+            evictPooledEngine(k);
+            continue;
+        }
+        if (reused) {
+            void* handle = entry.handle;
+            reserved = entry.reserved;
+            pool_bytes -= entry.bytes;
+            pool.erase(pool.begin() + static_cast<std::ptrdiff_t>(k));
+            return handle;
         }
-
-    } else {
-        // Unknown engine type
-        return "";
     }
+    return nullptr;
+}
 
-    if (!handle) {
-        return "";
+void EngineManager::trimPool(size_t max_bytes) {
+    while (!pool.empty() && pool_bytes > max_bytes) {
+        evictPooledEngine(0);
     }
-
-    instance->engine_handle = handle;
-
-    std::string id = instance->engine_id;
-    engines[id] = std::move(instance);
-
-    return id;
 }
 
-bool EngineManager::destroyEngine(const std::string& engine_id) {
-    auto it = engines.find(engine_id);
-    if (it == engines.end()) {
-        return false;
-    }
+void EngineManager::evictPooledEngine(size_t k) {
+    PooledEngine& entry = pool[k];
+    entry.backend->destroy(entry.handle);
+    pool_bytes -= entry.bytes;
+    dase::MemoryAdmission::instance().release(entry.reserved);
+    pool.erase(pool.begin() + static_cast<std::ptrdiff_t>(k));
+}
 
-    // Destroy engine based on type
-    if (it->second->engine_handle) {
-        if (it->second->engine_type == "phase4b" && dase_destroy_engine) {
-            dase_destroy_engine(it->second->engine_handle);
-        } else if (it->second->engine_type == "igsoa_complex") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(it->second->engine_handle);
-            delete engine;
-        } else if (it->second->engine_type == "igsoa_complex_2d") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(it->second->engine_handle);
-            delete engine;
-        } else if (it->second->engine_type == "igsoa_complex_3d") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(it->second->engine_handle);
-            delete engine;
-        } else if (it->second->engine_type == "satp_higgs_1d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(it->second->engine_handle);
-            delete engine;
-        } else if (it->second->engine_type == "satp_higgs_2d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(it->second->engine_handle);
-            delete engine;
-        } else if (it->second->engine_type == "satp_higgs_3d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(it->second->engine_handle);
-            delete engine;
-        }
-    }
+void EngineManager::setEnginePoolLimit(size_t max_bytes) {
+    pool_max_bytes = max_bytes;
+    trimPool(max_bytes);
+}
 
-    engines.erase(it);
-    return true;
+EngineManager::EnginePoolStats EngineManager::getEnginePoolStats() const {
+    return {pool_hits, pool_misses, pool.size(), pool_bytes, pool_max_bytes};
 }
 
 EngineInstance* EngineManager::getEngine(const std::string& engine_id) {
@@ -446,16 +411,33 @@ std::vector<EngineInstance*> EngineManager::listEngines() {
     return result;
 }
 
+bool EngineManager::loadEnginePlugin(const std::string& engine_type, const std::string& path, std::string& error) {
+    if (!registry->loadPlugin(engine_type, path, error)) {
+        return false;
+    }
+    // Parked engines of the replaced backend can never be reused
+    for (size_t k = pool.size(); k-- > 0;) {
+        if (pool[k].engine_type == engine_type) {
+            pool[k].backend->destroy(pool[k].handle);
+            pool_bytes -= pool[k].bytes;
+            pool.erase(pool.begin() + static_cast<std::ptrdiff_t>(k));
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> EngineManager::engineTypes() const {
+    return registry->types();
+}
+
 bool EngineManager::setNodeState(const std::string& engine_id, int node_index, double value) {
     auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
         return false;
     }
 
-    // Phase 4B doesn't expose individual node state setting in the C API
-    // This would require extending the C API
-    // For now, return success (no-op)
-    return true;
+    instance->provenance.untrack();
+    return instance->backend->setNodeValue(instance->engine_handle, node_index, value);
 }
 
 double EngineManager::getNodeState(const std::string& engine_id, int node_index) {
@@ -464,91 +446,265 @@ double EngineManager::getNodeState(const std::string& engine_id, int node_index)
         return 0.0;
     }
 
-    // Phase 4B doesn't expose individual node state reading in the C API
-    // This would require extending the C API
-    // For now, return 0.0
-    return 0.0;
+    double value = 0.0;
+    instance->backend->getNodeValue(instance->engine_handle, node_index, value);
+    return value;
 }
 
 bool EngineManager::runMission(const std::string& engine_id, int num_steps, int iterations_per_node) {
     auto* instance = getEngine(engine_id);
+    if (!instance) {
+        return false;
+    }
+    return runMission(*instance, num_steps, iterations_per_node, 0);
+}
+
+bool EngineManager::runMission(EngineInstance& instance, int num_steps, int iterations_per_node, int step_offset) {
+    if (instance.perf_counters) {
+        return instance.perf_counters->measure([&]() {
+            return runCheckpointedMission(instance, num_steps, iterations_per_node, step_offset);
+        });
+    }
+    return runCheckpointedMission(instance, num_steps, iterations_per_node, step_offset);
+}
+
+bool EngineManager::runCheckpointedMission(EngineInstance& instance, int num_steps, int iterations_per_node,
+                                           int step_offset) {
+    if (!instance.checkpointer || instance.checkpoint_every_steps <= 0) {
+        if (!runMissionSteps(instance, num_steps, iterations_per_node, step_offset)) {
+            instance.provenance.untrack();
+            return false;
+        }
+        instance.mission_steps += static_cast<uint64_t>(num_steps);
+        instance.provenance.advance(static_cast<uint64_t>(step_offset), static_cast<uint64_t>(num_steps));
+        return true;
+    }
+
+    // Stop at each checkpoint boundary; the capture only copies state, the
+    // write happens on the checkpointer's thread while the next piece runs
+    const uint64_t every = static_cast<uint64_t>(instance.checkpoint_every_steps);
+    int done = 0;
+    while (done < num_steps) {
+        const uint64_t to_boundary = every - instance.mission_steps % every;
+        const int steps = static_cast<int>(std::min<uint64_t>(to_boundary, static_cast<uint64_t>(num_steps - done)));
+        if (!runMissionSteps(instance, steps, iterations_per_node, step_offset + done)) {
+            instance.provenance.untrack();
+            return false;
+        }
+        instance.provenance.advance(static_cast<uint64_t>(step_offset + done), static_cast<uint64_t>(steps));
+        done += steps;
+        instance.mission_steps += static_cast<uint64_t>(steps);
+        if (instance.mission_steps % every == 0) {
+            captureCheckpoint(instance);
+        }
+    }
+    return num_steps > 0;
+}
+
+bool EngineManager::captureCheckpoint(EngineInstance& instance) {
+    auto& checkpointer = *instance.checkpointer;
+    const uint64_t step = instance.mission_steps;
+    return withCheckpointableEngine(instance, [&](auto& engine) { checkpointer.capture(engine, step); });
+}
+
+bool EngineManager::configureCheckpoints(const std::string& engine_id,
+                                         const dase::CheckpointPolicy& policy,
+                                         int every_steps,
+                                         std::string& error) {
+    auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
+        error = "Engine not found: " + engine_id;
+        return false;
+    }
+    const std::string& type = instance->engine_type;
+    if (type.rfind("igsoa_complex", 0) != 0 && type.rfind("satp_higgs_", 0) != 0) {
+        error = "Checkpointing is not supported for engine type: " + instance->engine_type;
+        return false;
+    }
+    if (every_steps <= 0) {
+        error = "checkpoint every_steps must be positive";
         return false;
     }
 
-    if (num_steps <= 0) {
+    std::error_code ec;
+    std::filesystem::create_directories(policy.directory, ec);
+    if (ec) {
+        error = "Cannot create checkpoint directory: " + policy.directory;
         return false;
     }
 
-    try {
-        // Pre-compute input signals and control patterns
-        std::vector<double> input_signals(num_steps);
-        std::vector<double> control_patterns(num_steps);
+    instance->checkpointer.reset();  // Drains the previous policy's writes
+    instance->checkpointer = std::make_unique<dase::AsyncCheckpointer>(policy);
+    instance->checkpoint_every_steps = every_steps;
+    return true;
+}
 
-        for (int i = 0; i < num_steps; i++) {
-            input_signals[i] = std::sin(i * 0.01);
-            control_patterns[i] = std::cos(i * 0.01);
-        }
+void EngineManager::disableCheckpoints(const std::string& engine_id) {
+    if (auto* instance = getEngine(engine_id)) {
+        instance->checkpointer.reset();
+        instance->checkpoint_every_steps = 0;
+    }
+}
 
-        if (instance->engine_type == "phase4b") {
-            // Phase 4B - call DLL
-            if (!dase_run_mission_optimized_phase4c || iterations_per_node <= 0) {
-                return false;
-            }
+bool EngineManager::configureResultCache(const std::string& directory, size_t max_bytes, std::string& error) {
+    return result_cache.configure(directory, max_bytes, &error);
+}
 
-            dase_run_mission_optimized_phase4c(
-                instance->engine_handle,
-                input_signals.data(),
-                control_patterns.data(),
-                static_cast<uint64_t>(num_steps),
-                static_cast<uint32_t>(iterations_per_node)
-            );
+void EngineManager::disableResultCache() {
+    result_cache.disable();
+}
 
-        } else if (instance->engine_type == "igsoa_complex") {
-            // IGSOA Complex - call directly
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
-            engine->runMission(
-                num_steps,
-                input_signals.data(),
-                control_patterns.data()
-            );
+bool EngineManager::resultCacheEnabled() const {
+    return result_cache.enabled();
+}
 
-        } else if (instance->engine_type == "igsoa_complex_2d") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-            engine->runMission(
-                num_steps,
-                input_signals.data(),
-                control_patterns.data()
-            );
+dase::ResultCacheStats EngineManager::getResultCacheStats() const {
+    return result_cache.stats();
+}
 
-        } else if (instance->engine_type == "igsoa_complex_3d") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-            engine->runMission(
-                num_steps,
-                input_signals.data(),
-                control_patterns.data()
-            );
-
-        } else if (instance->engine_type == "satp_higgs_1d") {
-            // SATP+Higgs engine - use evolve() method
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
-            engine->evolve(static_cast<size_t>(num_steps));
+const std::string& EngineManager::resultCacheDirectory() const {
+    return result_cache.directory();
+}
 
-        } else if (instance->engine_type == "satp_higgs_2d") {
-            // SATP+Higgs 2D engine
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
-            engine->evolve(static_cast<size_t>(num_steps));
+bool EngineManager::runCachedMission(const std::string& engine_id, int num_steps, int iterations_per_node,
+                                     MissionCacheOutcome& outcome) {
+    outcome = MissionCacheOutcome{std::string(), false, false, std::string(), std::string()};
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
 
-        } else if (instance->engine_type == "satp_higgs_3d") {
-            // SATP+Higgs 3D engine
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
-            engine->evolve(static_cast<size_t>(num_steps));
+    const std::string& type = instance->engine_type;
+    const auto* recorder = getObservableRecorder(engine_id);
+    if (!result_cache.enabled()) {
+        outcome.bypass_reason = "result cache disabled";
+    } else if (type.rfind("igsoa_complex", 0) != 0 && type.rfind("satp_higgs_", 0) != 0) {
+        outcome.bypass_reason = "engine type has no checkpoint format";
+    } else if (!instance->provenance.tracked()) {
+        outcome.bypass_reason = "engine state has untracked changes";
+    } else if (instance->checkpointer) {
+        outcome.bypass_reason = "checkpoints are enabled";
+    } else if (recorder && recorder->enabled()) {
+        outcome.bypass_reason = "observables are recorded";
+    } else if (num_steps <= 0) {
+        outcome.bypass_reason = "num_steps must be positive";
+    }
+    if (!outcome.bypass_reason.empty()) {
+        return runMission(*instance, num_steps, iterations_per_node, 0);
+    }
 
+    outcome.key = instance->provenance.keyAfter(0, static_cast<uint64_t>(num_steps));
+    withCheckpointableEngine(*instance, [&](auto& engine) {
+        outcome.hit = result_cache.load(outcome.key, engine, &outcome.error);
+    });
+    if (outcome.hit) {
+        instance->mission_steps += static_cast<uint64_t>(num_steps);
+        instance->provenance.advance(0, static_cast<uint64_t>(num_steps));
+        return true;
+    }
+
+    if (!runMission(*instance, num_steps, iterations_per_node, 0)) {
+        return false;
+    }
+    withCheckpointableEngine(*instance, [&](auto& engine) {
+        outcome.stored = result_cache.store(outcome.key, engine, &outcome.error);
+    });
+    return true;
+}
+
+bool EngineManager::runPararealMission(const std::string& engine_id, int num_steps,
+                                       const dase::PararealConfig& config, dase::PararealStats& stats,
+                                       std::string& error) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error = "Engine not found: " + engine_id;
+        return false;
+    }
+    const auto* recorder = getObservableRecorder(engine_id);
+    if (instance->checkpointer) {
+        error = "parareal missions take no periodic checkpoints; disable them or use parareal checkpoint_path";
+        return false;
+    }
+    if (recorder && recorder->enabled()) {
+        error = "parareal missions do not record observables";
+        return false;
+    }
+    if (num_steps <= 0) {
+        error = "num_steps must be positive";
+        return false;
+    }
+
+    bool supported = false;
+    auto run = [&]() {
+        supported = withCheckpointableEngine(*instance, [&](auto& engine) {
+            stats = engine.runParareal(static_cast<uint64_t>(num_steps), config);
+        });
+        return supported;
+    };
+    try {
+        if (instance->perf_counters) {
+            instance->perf_counters->measure(run);
         } else {
-            return false;
+            run();
+        }
+    } catch (const std::exception& e) {
+        error = std::string("parareal mission failed: ") + e.what();
+        instance->provenance.untrack();
+        return false;
+    }
+    if (!supported) {
+        error = "Parareal is not supported for engine type: " + instance->engine_type;
+        return false;
+    }
+    instance->mission_steps += static_cast<uint64_t>(num_steps);
+    instance->provenance.untrack();
+    return true;
+}
+
+bool EngineManager::enablePerfCounters(const std::string& engine_id, double peak_ipc,
+                                       double peak_dram_gb_per_s, bool reset) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    if (!instance->perf_counters) {
+        instance->perf_counters = std::make_unique<dase::PerfCounters>();
+    } else if (reset) {
+        instance->perf_counters->reset();
+    }
+    instance->perf_peak_ipc = peak_ipc;
+    instance->perf_peak_dram_gb_per_s = peak_dram_gb_per_s;
+    return true;
+}
+
+void EngineManager::disablePerfCounters(const std::string& engine_id) {
+    if (auto* instance = getEngine(engine_id)) {
+        instance->perf_counters.reset();
+    }
+}
+
+bool EngineManager::runMissionSteps(EngineInstance& engine_instance, int num_steps, int iterations_per_node, int step_offset) {
+    auto* instance = &engine_instance;
+    if (!instance->engine_handle) {
+        return false;
+    }
+
+    if (num_steps <= 0 || step_offset < 0) {
+        return false;
+    }
+
+    try {
+        // Pre-compute input signals and control patterns (continuing at step_offset)
+        std::vector<double> input_signals(num_steps);
+        std::vector<double> control_patterns(num_steps);
+
+        for (int i = 0; i < num_steps; i++) {
+            input_signals[i] = std::sin((step_offset + i) * 0.01);
+            control_patterns[i] = std::cos((step_offset + i) * 0.01);
         }
 
-        return true;
+        return instance->backend->run(instance->engine_handle, num_steps, input_signals.data(),
+                                      control_patterns.data(), iterations_per_node);
 
     } catch (...) {
         return false;
@@ -560,6 +716,7 @@ bool EngineManager::setNodePsi(const std::string& engine_id, int node_index, dou
     if (!instance || !instance->engine_handle) {
         return false;
     }
+    instance->provenance.untrack();
 
     if (instance->engine_type == "igsoa_complex") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
@@ -650,52 +807,31 @@ bool EngineManager::getAllNodeStates(const std::string& engine_id,
 
     if (instance->engine_type == "igsoa_complex") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
+        const auto& lattice = engine->getLattice();
 
-        size_t num_nodes = nodes.size();
-        psi_real.resize(num_nodes);
-        psi_imag.resize(num_nodes);
-        phi.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            psi_real[i] = nodes[i].psi.real();
-            psi_imag[i] = nodes[i].psi.imag();
-            phi[i] = nodes[i].phi;
-        }
+        psi_real.assign(lattice.psi_re.begin(), lattice.psi_re.end());
+        psi_imag.assign(lattice.psi_im.begin(), lattice.psi_im.end());
+        phi.assign(lattice.phi.begin(), lattice.phi.end());
 
         return true;
 
     } else if (instance->engine_type == "igsoa_complex_2d") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
+        const auto& lattice = engine->getLattice();
 
-        size_t num_nodes = nodes.size();
-        psi_real.resize(num_nodes);
-        psi_imag.resize(num_nodes);
-        phi.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            psi_real[i] = nodes[i].psi.real();
-            psi_imag[i] = nodes[i].psi.imag();
-            phi[i] = nodes[i].phi;
-        }
+        psi_real.assign(lattice.psi_re.begin(), lattice.psi_re.end());
+        psi_imag.assign(lattice.psi_im.begin(), lattice.psi_im.end());
+        phi.assign(lattice.phi.begin(), lattice.phi.end());
 
         return true;
 
     } else if (instance->engine_type == "igsoa_complex_3d") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
-
-        size_t num_nodes = nodes.size();
-        psi_real.resize(num_nodes);
-        psi_imag.resize(num_nodes);
-        phi.resize(num_nodes);
+        const auto& lattice = engine->getLattice();
 
-        for (size_t i = 0; i < num_nodes; i++) {
-            psi_real[i] = nodes[i].psi.real();
-            psi_imag[i] = nodes[i].psi.imag();
-            phi[i] = nodes[i].phi;
-        }
+        psi_real.assign(lattice.psi_re.begin(), lattice.psi_re.end());
+        psi_imag.assign(lattice.psi_im.begin(), lattice.psi_im.end());
+        phi.assign(lattice.phi.begin(), lattice.phi.end());
 
         return true;
     }
@@ -703,6 +839,103 @@ bool EngineManager::getAllNodeStates(const std::string& engine_id,
     return false;
 }
 
+bool EngineManager::getReplicaStates(const std::string& engine_id,
+                                     int replica,
+                                     std::vector<double>& psi_real,
+                                     std::vector<double>& psi_imag,
+                                     std::vector<double>& phi) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle || instance->engine_type != "igsoa_ensemble_2d" ||
+        replica < 0 || replica >= instance->replicas) {
+        return false;
+    }
+
+    auto* engine = static_cast<dase::igsoa::IGSOAEnsembleEngine2D*>(instance->engine_handle);
+    const size_t count = engine->getNodesPerReplica();
+    const size_t b = static_cast<size_t>(replica);
+    psi_real.resize(count);
+    psi_imag.resize(count);
+    phi.resize(count);
+    return engine->getPsiRange(b, 0, count, psi_real.data(), psi_imag.data()) &&
+           engine->getPhiRange(b, 0, count, phi.data());
+}
+
+namespace {
+
+template<typename Out>
+bool extractInstanceRegion(const EngineInstance& instance,
+                           const dase::igsoa::StateRegion& region,
+                           uint32_t field_mask,
+                           std::vector<Out>& psi_real,
+                           std::vector<Out>& psi_imag,
+                           std::vector<Out>& F,
+                           std::vector<Out>& phi) {
+    const dase::igsoa::IGSOALatticeSoA* lattice = nullptr;
+    size_t N_x = 0, N_y = 1, N_z = 1;
+
+    if (instance.engine_type == "igsoa_complex") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance.engine_handle);
+        lattice = &engine->getLattice();
+        N_x = engine->getNumNodes();
+    } else if (instance.engine_type == "igsoa_complex_2d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance.engine_handle);
+        lattice = &engine->getLattice();
+        N_x = engine->getNx();
+        N_y = engine->getNy();
+    } else if (instance.engine_type == "igsoa_complex_3d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance.engine_handle);
+        lattice = &engine->getLattice();
+        N_x = engine->getNx();
+        N_y = engine->getNy();
+        N_z = engine->getNz();
+    } else {
+        return false;
+    }
+
+    if (!region.fits(N_x, N_y, N_z)) {
+        return false;
+    }
+
+    const size_t count = region.outCount();
+    psi_real.resize((field_mask & dase::igsoa::STATE_FIELD_PSI) ? count : 0);
+    psi_imag.resize((field_mask & dase::igsoa::STATE_FIELD_PSI) ? count : 0);
+    F.resize((field_mask & dase::igsoa::STATE_FIELD_F) ? count : 0);
+    phi.resize((field_mask & dase::igsoa::STATE_FIELD_PHI) ? count : 0);
+
+    return dase::igsoa::extractRegion(*lattice, N_x, N_y, N_z, region, field_mask,
+                                      psi_real.data(), psi_imag.data(), F.data(), phi.data());
+}
+
+} // namespace
+
+bool EngineManager::getRegionStates(const std::string& engine_id,
+                                    const dase::igsoa::StateRegion& region,
+                                    uint32_t field_mask,
+                                    std::vector<double>& psi_real,
+                                    std::vector<double>& psi_imag,
+                                    std::vector<double>& F,
+                                    std::vector<double>& phi) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    return extractInstanceRegion(*instance, region, field_mask, psi_real, psi_imag, F, phi);
+}
+
+bool EngineManager::getRegionStates(const std::string& engine_id,
+                                    const dase::igsoa::StateRegion& region,
+                                    uint32_t field_mask,
+                                    std::vector<float>& psi_real,
+                                    std::vector<float>& psi_imag,
+                                    std::vector<float>& F,
+                                    std::vector<float>& phi) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    return extractInstanceRegion(*instance, region, field_mask, psi_real, psi_imag, F, phi);
+}
+
 bool EngineManager::getSatpState(const std::string& engine_id,
                                   std::vector<double>& phi_out,
                                   std::vector<double>& phi_dot_out,
@@ -713,71 +946,214 @@ bool EngineManager::getSatpState(const std::string& engine_id,
         return false;
     }
 
-    if (instance->engine_type == "satp_higgs_1d") {
-        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
-
-        size_t num_nodes = nodes.size();
+    // One bulk copy per field, straight from the engine's node array
+    auto readFields = [&](const auto* engine) {
+        using dase::satp_higgs::SATPHiggsField;
+        size_t num_nodes = engine->getNodes().size();
         phi_out.resize(num_nodes);
         phi_dot_out.resize(num_nodes);
         h_out.resize(num_nodes);
         h_dot_out.resize(num_nodes);
+        return engine->getFieldRange(SATPHiggsField::Phi, 0, num_nodes, phi_out.data()) &&
+               engine->getFieldRange(SATPHiggsField::PhiDot, 0, num_nodes, phi_dot_out.data()) &&
+               engine->getFieldRange(SATPHiggsField::H, 0, num_nodes, h_out.data()) &&
+               engine->getFieldRange(SATPHiggsField::HDot, 0, num_nodes, h_dot_out.data());
+    };
+
+    if (instance->engine_type == "satp_higgs_1d") {
+        return readFields(static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle));
+    } else if (instance->engine_type == "satp_higgs_2d") {
+        return readFields(static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle));
+    } else if (instance->engine_type == "satp_higgs_3d") {
+        return readFields(static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle));
+    }
+
+    return false;
+}
+
+namespace {
+
+// Gaussian of a "gaussian" profile or one entry of a "gaussians" list
+// ("sigma" sets both widths when sigma_x / sigma_y are absent)
+dase::igsoa::Gaussian2DParams gaussian2DFromJson(const nlohmann::json& params,
+                                                 size_t N_x,
+                                                 size_t N_y) {
+    dase::igsoa::Gaussian2DParams gparams;
+    gparams.amplitude = params.value("amplitude", 1.0);
+    gparams.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
+    gparams.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
+    double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
+    double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
+    gparams.sigma_x = params.value("sigma_x", params.value("sigma", default_sigma_x));
+    gparams.sigma_y = params.value("sigma_y", params.value("sigma", default_sigma_y));
+    gparams.baseline_phi = params.value("baseline_phi", 0.0);
+    gparams.mode = params.value("mode", std::string("overwrite"));
+    gparams.beta = params.value("beta", 1.0);
+    return gparams;
+}
+
+dase::igsoa::Gaussian3DParams gaussian3DFromJson(const nlohmann::json& params,
+                                                 size_t N_x,
+                                                 size_t N_y,
+                                                 size_t N_z) {
+    dase::igsoa::Gaussian3DParams params3d;
+    params3d.amplitude = params.value("amplitude", 1.0);
+    params3d.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
+    params3d.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
+    params3d.center_z = params.value("center_z", static_cast<double>(N_z) / 2.0);
+    double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
+    double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
+    double default_sigma_z = (std::max)(1.0, static_cast<double>(N_z) / 16.0);
+    params3d.sigma_x = params.value("sigma_x", params.value("sigma", default_sigma_x));
+    params3d.sigma_y = params.value("sigma_y", params.value("sigma", default_sigma_y));
+    params3d.sigma_z = params.value("sigma_z", params.value("sigma", default_sigma_z));
+    params3d.baseline_phi = params.value("baseline_phi", 0.0);
+    params3d.mode = params.value("mode", std::string("overwrite"));
+    params3d.beta = params.value("beta", 1.0);
+    return params3d;
+}
+
+// "custom" profile of set_igsoa_state: node values as arrays, written from
+// params["first_node"] (default 0) through the bulk range setters.
+// psi_real (with optional psi_imag, default 0) and/or phi; a field that is
+// not given keeps its values. Arrays arrive packed from parseCommand.
+template <typename Engine>
+bool applyCustomProfile(Engine& engine, const nlohmann::json& params) {
+    const size_t first = params.value("first_node", static_cast<size_t>(0));
+    std::vector<double> values;
+    std::vector<double> imag;
+    bool applied = false;
+
+    if (params.contains("psi_real")) {
+        if (!dase::readNumbers(params["psi_real"], values)) {
+            return false;
+        }
+        if (params.contains("psi_imag")) {
+            if (!dase::readNumbers(params["psi_imag"], imag) || imag.size() != values.size()) {
+                return false;
+            }
+        } else {
+            imag.assign(values.size(), 0.0);
+        }
+        if (!engine.setPsiRange(first, values.size(), values.data(), imag.data())) {
+            return false;
+        }
+        applied = true;
+    } else if (params.contains("psi_imag")) {
+        return false;
+    }
 
-        for (size_t i = 0; i < num_nodes; i++) {
-            phi_out[i] = nodes[i].phi;
-            phi_dot_out[i] = nodes[i].phi_dot;
-            h_out[i] = nodes[i].h;
-            h_dot_out[i] = nodes[i].h_dot;
+    if (params.contains("phi")) {
+        if (!dase::readNumbers(params["phi"], values) ||
+            !engine.setPhiRange(first, values.size(), values.data())) {
+            return false;
         }
+        applied = true;
+    }
+    return applied;
+}
 
+// 2D profiles of set_igsoa_state (shared by igsoa_complex_2d and ensemble replicas)
+bool applyProfile2D(dase::igsoa::IGSOAComplexEngine2D& engine2d,
+                    size_t N_x,
+                    size_t N_y,
+                    const std::string& profile_type,
+                    const nlohmann::json& params) {
+    if (profile_type == "custom") {
+        return applyCustomProfile(engine2d, params);
+    }
+    if (profile_type == "gaussian" || profile_type == "gaussian_2d") {
+        dase::igsoa::IGSOAStateInit2D::initGaussian2D(engine2d, gaussian2DFromJson(params, N_x, N_y));
         return true;
 
-    } else if (instance->engine_type == "satp_higgs_2d") {
-        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
+    } else if (profile_type == "gaussians" || profile_type == "gaussians_2d") {
+        // Several Gaussians applied in order in one lattice sweep
+        if (!params.contains("profiles") || !params["profiles"].is_array()) {
+            return false;
+        }
+        std::vector<dase::igsoa::Gaussian2DParams> profiles;
+        for (const auto& entry : params["profiles"]) {
+            profiles.push_back(gaussian2DFromJson(entry, N_x, N_y));
+        }
+        dase::igsoa::IGSOAStateInit2D::initGaussians2D(engine2d, profiles);
+        return true;
 
-        size_t num_nodes = nodes.size();
-        phi_out.resize(num_nodes);
-        phi_dot_out.resize(num_nodes);
-        h_out.resize(num_nodes);
-        h_dot_out.resize(num_nodes);
+    } else if (profile_type == "circular_gaussian" || profile_type == "circular_gaussian_2d") {
+        double amplitude = params.value("amplitude", 1.0);
+        double center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
+        double center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
+        double min_dim = (std::min)(static_cast<double>(N_x), static_cast<double>(N_y));
+        double default_sigma = (std::max)(1.0, min_dim / 16.0);
+        double sigma = params.value("sigma", default_sigma);
+        double baseline_phi = params.value("baseline_phi", 0.0);
+        std::string mode = params.value("mode", std::string("overwrite"));
+        double beta = params.value("beta", 1.0);
+
+        dase::igsoa::IGSOAStateInit2D::initCircularGaussian(
+            engine2d,
+            amplitude,
+            center_x,
+            center_y,
+            sigma,
+            baseline_phi,
+            mode,
+            beta
+        );
 
-        for (size_t i = 0; i < num_nodes; i++) {
-            phi_out[i] = nodes[i].phi;
-            phi_dot_out[i] = nodes[i].phi_dot;
-            h_out[i] = nodes[i].h;
-            h_dot_out[i] = nodes[i].h_dot;
-        }
+        return true;
+
+    } else if (profile_type == "plane_wave_2d" || profile_type == "plane_wave") {
+        dase::igsoa::PlaneWave2DParams wave_params;
+        wave_params.amplitude = params.value("amplitude", 1.0);
+        wave_params.k_x = params.value("k_x", 2.0 * M_PI / std::max<double>(1.0, N_x));
+        wave_params.k_y = params.value("k_y", 2.0 * M_PI / std::max<double>(1.0, N_y));
+        wave_params.phase_offset = params.value("phase_offset", 0.0);
 
+        dase::igsoa::IGSOAStateInit2D::initPlaneWave2D(engine2d, wave_params);
         return true;
 
-    } else if (instance->engine_type == "satp_higgs_3d") {
-        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
+    } else if (profile_type == "uniform") {
+        double psi_real = params.value("psi_real", 0.1);
+        double psi_imag = params.value("psi_imag", 0.0);
+        double phi = params.value("phi", 0.0);
 
-        size_t num_nodes = nodes.size();
-        phi_out.resize(num_nodes);
-        phi_dot_out.resize(num_nodes);
-        h_out.resize(num_nodes);
-        h_dot_out.resize(num_nodes);
+        dase::igsoa::IGSOAStateInit2D::initUniform(engine2d, psi_real, psi_imag, phi);
+        return true;
 
-        for (size_t i = 0; i < num_nodes; i++) {
-            phi_out[i] = nodes[i].phi;
-            phi_dot_out[i] = nodes[i].phi_dot;
-            h_out[i] = nodes[i].h;
-            h_dot_out[i] = nodes[i].h_dot;
-        }
+    } else if (profile_type == "random" || profile_type == "random_2d") {
+        double amplitude = params.value("amplitude", 1.0);
+        unsigned int seed = params.value("seed", 0u);
 
+        dase::igsoa::IGSOAStateInit2D::initRandom(engine2d, amplitude, seed);
         return true;
-    }
 
-    return false;
+    } else if (profile_type == "reset") {
+        engine2d.reset();
+        return true;
+
+    } else {
+        return false;
+    }
 }
 
+} // namespace
+
 bool EngineManager::setIgsoaState(const std::string& engine_id,
                                    const std::string& profile_type,
                                    const nlohmann::json& params) {
     auto* instance = getEngine(engine_id);
+    if (!instance) {
+        return false;
+    }
+    const bool applied = applyIgsoaState(engine_id, profile_type, params);
+    recordStateProfile(*instance, "igsoa_state", profile_type, params, applied);
+    return applied;
+}
+
+bool EngineManager::applyIgsoaState(const std::string& engine_id,
+                                     const std::string& profile_type,
+                                     const nlohmann::json& params) {
+    auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
         return false;
     }
@@ -787,6 +1163,10 @@ bool EngineManager::setIgsoaState(const std::string& engine_id,
             auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
             size_t num_nodes = instance->num_nodes;
 
+            if (profile_type == "custom") {
+                return applyCustomProfile(*engine, params);
+            }
+
             if (profile_type == "gaussian") {
             // Extract Gaussian profile parameters
             double amplitude = params.value("amplitude", 1.0);
@@ -818,13 +1198,12 @@ bool EngineManager::setIgsoaState(const std::string& engine_id,
                     double gaussian_value = amplitude * std::exp(-(distance * distance) / (2.0 * width * width));
 
                     // Add to Ψ (complex quantum state)
-                    const auto& node = engine->getNodes()[i];
-                    double psi_real = node.psi.real() + gaussian_value;
-                    double psi_imag = node.psi.imag();
-                    engine->setNodePsi(i, psi_real, psi_imag);
+                    double psi_real = 0.0, psi_imag = 0.0;
+                    engine->getNodePsi(i, psi_real, psi_imag);
+                    double phi_current = engine->getNodePhi(i);
+                    engine->setNodePsi(i, psi_real + gaussian_value, psi_imag);
 
                     // Add gaussian to Φ (realized field)
-                    double phi_current = node.phi;
                     engine->setNodePhi(i, phi_current + gaussian_value);
                 }
 
@@ -837,16 +1216,18 @@ bool EngineManager::setIgsoaState(const std::string& engine_id,
                     double gaussian_value = amplitude * std::exp(-(distance * distance) / (2.0 * width * width));
 
                     // Blend Ψ toward target
-                    const auto& node = engine->getNodes()[i];
+                    double psi_real = 0.0, psi_imag = 0.0;
+                    engine->getNodePsi(i, psi_real, psi_imag);
+                    double phi_current = engine->getNodePhi(i);
                     double target_psi_real = gaussian_value;
                     double target_psi_imag = 0.0;
-                    double blended_psi_real = (1.0 - beta) * node.psi.real() + beta * target_psi_real;
-                    double blended_psi_imag = (1.0 - beta) * node.psi.imag() + beta * target_psi_imag;
+                    double blended_psi_real = (1.0 - beta) * psi_real + beta * target_psi_real;
+                    double blended_psi_imag = (1.0 - beta) * psi_imag + beta * target_psi_imag;
                     engine->setNodePsi(i, blended_psi_real, blended_psi_imag);
 
                     // Blend Φ toward baseline + gaussian
                     double target_phi = baseline_phi + gaussian_value;
-                    double blended_phi = (1.0 - beta) * node.phi + beta * target_phi;
+                    double blended_phi = (1.0 - beta) * phi_current + beta * target_phi;
                     engine->setNodePhi(i, blended_phi);
                 }
 
@@ -902,78 +1283,50 @@ bool EngineManager::setIgsoaState(const std::string& engine_id,
             size_t N_x = instance->dimension_x > 0 ? static_cast<size_t>(instance->dimension_x) : engine2d->getNx();
             size_t N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : engine2d->getNy();
 
-            if (profile_type == "gaussian" || profile_type == "gaussian_2d") {
-                dase::igsoa::Gaussian2DParams gparams;
-                gparams.amplitude = params.value("amplitude", 1.0);
-                gparams.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
-                gparams.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
-                double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
-                double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
-                gparams.sigma_x = params.value("sigma_x", default_sigma_x);
-                gparams.sigma_y = params.value("sigma_y", default_sigma_y);
-                gparams.baseline_phi = params.value("baseline_phi", 0.0);
-                gparams.mode = params.value("mode", std::string("overwrite"));
-                gparams.beta = params.value("beta", 1.0);
-
-                dase::igsoa::IGSOAStateInit2D::initGaussian2D(*engine2d, gparams);
-                return true;
-
-            } else if (profile_type == "circular_gaussian" || profile_type == "circular_gaussian_2d") {
-                double amplitude = params.value("amplitude", 1.0);
-                double center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
-                double center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
-                double min_dim = (std::min)(static_cast<double>(N_x), static_cast<double>(N_y));
-                double default_sigma = (std::max)(1.0, min_dim / 16.0);
-                double sigma = params.value("sigma", default_sigma);
-                double baseline_phi = params.value("baseline_phi", 0.0);
-                std::string mode = params.value("mode", std::string("overwrite"));
-                double beta = params.value("beta", 1.0);
-
-                dase::igsoa::IGSOAStateInit2D::initCircularGaussian(
-                    *engine2d,
-                    amplitude,
-                    center_x,
-                    center_y,
-                    sigma,
-                    baseline_phi,
-                    mode,
-                    beta
-                );
-
-                return true;
-
-            } else if (profile_type == "plane_wave_2d" || profile_type == "plane_wave") {
-                dase::igsoa::PlaneWave2DParams wave_params;
-                wave_params.amplitude = params.value("amplitude", 1.0);
-                wave_params.k_x = params.value("k_x", 2.0 * M_PI / std::max<double>(1.0, N_x));
-                wave_params.k_y = params.value("k_y", 2.0 * M_PI / std::max<double>(1.0, N_y));
-                wave_params.phase_offset = params.value("phase_offset", 0.0);
-
-                dase::igsoa::IGSOAStateInit2D::initPlaneWave2D(*engine2d, wave_params);
-                return true;
-
-            } else if (profile_type == "uniform") {
-                double psi_real = params.value("psi_real", 0.1);
-                double psi_imag = params.value("psi_imag", 0.0);
-                double phi = params.value("phi", 0.0);
-
-                dase::igsoa::IGSOAStateInit2D::initUniform(*engine2d, psi_real, psi_imag, phi);
-                return true;
-
-            } else if (profile_type == "random" || profile_type == "random_2d") {
-                double amplitude = params.value("amplitude", 1.0);
-                unsigned int seed = params.value("seed", 0u);
+            return applyProfile2D(*engine2d, N_x, N_y, profile_type, params);
 
-                dase::igsoa::IGSOAStateInit2D::initRandom(*engine2d, amplitude, seed);
+        } else if (instance->engine_type == "igsoa_ensemble_2d") {
+            auto* ensemble = static_cast<dase::igsoa::IGSOAEnsembleEngine2D*>(instance->engine_handle);
+            if (profile_type == "reset") {
+                ensemble->reset();
                 return true;
+            }
 
-            } else if (profile_type == "reset") {
-                engine2d->reset();
-                return true;
+            const size_t N_x = ensemble->getNx();
+            const size_t N_y = ensemble->getNy();
+            const size_t count = ensemble->getNodesPerReplica();
+            size_t first = 0;
+            size_t last = ensemble->getReplicaCount();
+            if (params.contains("replica")) {
+                const int replica = params["replica"].get<int>();
+                if (replica < 0 || replica >= instance->replicas) {
+                    return false;
+                }
+                first = static_cast<size_t>(replica);
+                last = first + 1;
+            }
 
-            } else {
-                return false;
+            // Each replica is initialized through a scratch single-lattice
+            // engine holding its current state ("add"/"blend" modes read it)
+            dase::igsoa::IGSOAComplexConfig config;
+            config.num_nodes = count;
+            config.R_c_default = ensemble->getRc();
+            config.dt = instance->dt;
+            config.normalize_psi = false;
+            dase::igsoa::IGSOAComplexEngine2D scratch(config, N_x, N_y);
+            std::vector<double> psi_real(count), psi_imag(count), phi(count);
+
+            for (size_t b = first; b < last; b++) {
+                ensemble->getPsiRange(b, 0, count, psi_real.data(), psi_imag.data());
+                ensemble->getPhiRange(b, 0, count, phi.data());
+                scratch.setPsiRange(0, count, psi_real.data(), psi_imag.data());
+                scratch.setPhiRange(0, count, phi.data());
+                if (!applyProfile2D(scratch, N_x, N_y, profile_type, params)) {
+                    return false;
+                }
+                ensemble->loadReplica(b, scratch.getLattice());
             }
+            return true;
 
         } else if (instance->engine_type == "igsoa_complex_3d") {
             auto* engine3d = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
@@ -981,23 +1334,24 @@ bool EngineManager::setIgsoaState(const std::string& engine_id,
             size_t N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : engine3d->getNy();
             size_t N_z = instance->dimension_z > 0 ? static_cast<size_t>(instance->dimension_z) : engine3d->getNz();
 
+            if (profile_type == "custom") {
+                return applyCustomProfile(*engine3d, params);
+            }
+
             if (profile_type == "gaussian" || profile_type == "gaussian_3d") {
-                dase::igsoa::Gaussian3DParams params3d;
-                params3d.amplitude = params.value("amplitude", 1.0);
-                params3d.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
-                params3d.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
-                params3d.center_z = params.value("center_z", static_cast<double>(N_z) / 2.0);
-                double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
-                double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
-                double default_sigma_z = (std::max)(1.0, static_cast<double>(N_z) / 16.0);
-                params3d.sigma_x = params.value("sigma_x", default_sigma_x);
-                params3d.sigma_y = params.value("sigma_y", default_sigma_y);
-                params3d.sigma_z = params.value("sigma_z", default_sigma_z);
-                params3d.baseline_phi = params.value("baseline_phi", 0.0);
-                params3d.mode = params.value("mode", std::string("overwrite"));
-                params3d.beta = params.value("beta", 1.0);
-
-                dase::igsoa::IGSOAStateInit3D::initGaussian3D(*engine3d, params3d);
+                dase::igsoa::IGSOAStateInit3D::initGaussian3D(*engine3d, gaussian3DFromJson(params, N_x, N_y, N_z));
+                return true;
+
+            } else if (profile_type == "gaussians" || profile_type == "gaussians_3d") {
+                // Several Gaussians applied in order in one lattice sweep
+                if (!params.contains("profiles") || !params["profiles"].is_array()) {
+                    return false;
+                }
+                std::vector<dase::igsoa::Gaussian3DParams> profiles;
+                for (const auto& entry : params["profiles"]) {
+                    profiles.push_back(gaussian3DFromJson(entry, N_x, N_y, N_z));
+                }
+                dase::igsoa::IGSOAStateInit3D::initGaussians3D(*engine3d, profiles);
                 return true;
 
             } else if (profile_type == "spherical_gaussian" || profile_type == "gaussian_spherical") {
@@ -1068,10 +1422,56 @@ bool EngineManager::setIgsoaState(const std::string& engine_id,
     }
 }
 
+namespace {
+
+// "gaussian_source" of the SATP engines: a GaussianPulseSource, or a
+// MovingGaussianSource when any velocity_* is given. The centre defaults
+// to the middle of the lattice.
+dase::satp_higgs::SATPSourceBatch satpGaussianSource(const nlohmann::json& params,
+                                                     double L_x, double L_y, double L_z) {
+    const double center[3] = {params.value("center_x", L_x / 2.0),
+                              params.value("center_y", L_y / 2.0),
+                              params.value("center_z", L_z / 2.0)};
+    const double sigma = std::max(params.value("sigma", 1.0), 1.0e-9);
+    if (params.contains("velocity_x") || params.contains("velocity_y") || params.contains("velocity_z")) {
+        dase::satp_higgs::MovingGaussianSource source;
+        source.amplitude = params.value("amplitude", 1.0);
+        std::copy(center, center + 3, source.start);
+        source.velocity[0] = params.value("velocity_x", 0.0);
+        source.velocity[1] = params.value("velocity_y", 0.0);
+        source.velocity[2] = params.value("velocity_z", 0.0);
+        source.sigma = sigma;
+        source.frequency = params.value("frequency", 0.0);
+        return source;
+    }
+    dase::satp_higgs::GaussianPulseSource source;
+    source.amplitude = params.value("amplitude", 1.0);
+    std::copy(center, center + 3, source.center);
+    source.sigma = sigma;
+    source.t0 = params.value("t0", 0.0);
+    source.duration = params.value("duration", 0.0);
+    source.frequency = params.value("frequency", 0.0);
+    return source;
+}
+
+} // namespace
+
 bool EngineManager::setSatpState(const std::string& engine_id,
                                   const std::string& profile_type,
                                   const nlohmann::json& params) {
     auto* instance = getEngine(engine_id);
+    if (!instance) {
+        return false;
+    }
+    const bool applied = applySatpState(engine_id, profile_type, params);
+    recordStateProfile(*instance, "satp_state", profile_type, params, applied);
+    return applied;
+}
+
+bool EngineManager::applySatpState(const std::string& engine_id,
+                                    const std::string& profile_type,
+                                    const nlohmann::json& params) {
+    auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
         return false;
     }
@@ -1129,9 +1529,18 @@ bool EngineManager::setSatpState(const std::string& engine_id,
                 sparams.t_start = params.value("t_start", 0.0);
                 sparams.t_end = params.value("t_end", -1.0);
 
-                auto source_func = dase::satp_higgs::SATPHiggsStateInit1D::createThreeZoneSource(
-                    sparams, engine->getDx());
-                engine->setSource(source_func);
+                engine->setSourceBatch(
+                    dase::satp_higgs::SATPHiggsStateInit1D::createThreeZoneSourceBatch(sparams));
+                return true;
+
+            } else if (profile_type == "gaussian_source") {
+                // Batched φ source S(t, r) (satp_higgs_source.h)
+                engine->setSourceBatch(satpGaussianSource(params,
+                    engine->getN() * engine->getDx(), 0.0, 0.0));
+                return true;
+
+            } else if (profile_type == "clear_source") {
+                engine->clearSource();
                 return true;
 
             } else if (profile_type == "uniform") {
@@ -1207,6 +1616,16 @@ bool EngineManager::setSatpState(const std::string& engine_id,
                     *engine, amplitude, center_x, center_y, sigma, mode);
                 return true;
 
+            } else if (profile_type == "gaussian_source") {
+                // Batched φ source S(t, r) (satp_higgs_source.h)
+                engine->setSourceBatch(satpGaussianSource(params,
+                    engine->getNx() * engine->getDx(), engine->getNy() * engine->getDx(), 0.0));
+                return true;
+
+            } else if (profile_type == "clear_source") {
+                engine->clearSource();
+                return true;
+
             } else if (profile_type == "uniform") {
                 // Uniform initialization
                 double phi_val = params.value("phi", 0.0);
@@ -1284,6 +1703,17 @@ bool EngineManager::setSatpState(const std::string& engine_id,
                     *engine, amplitude, center_x, center_y, center_z, sigma, mode);
                 return true;
 
+            } else if (profile_type == "gaussian_source") {
+                // Batched φ source S(t, r) (satp_higgs_source.h)
+                engine->setSourceBatch(satpGaussianSource(params,
+                    engine->getNx() * engine->getDx(), engine->getNy() * engine->getDx(),
+                    engine->getNz() * engine->getDx()));
+                return true;
+
+            } else if (profile_type == "clear_source") {
+                engine->clearSource();
+                return true;
+
             } else if (profile_type == "uniform") {
                 // Uniform initialization
                 double phi_val = params.value("phi", 0.0);
@@ -1318,6 +1748,268 @@ bool EngineManager::setSatpState(const std::string& engine_id,
     }
 }
 
+namespace {
+
+// Observable names of computeDiagnostics() to mask bits ("rms" is the SATP
+// name of bit 1, "entropy_rate" the IGSOA one); empty selects all
+bool parseDiagnosticMask(const std::vector<std::string>& observables,
+                         bool satp,
+                         uint32_t& mask,
+                         std::string& error) {
+    using namespace dase::igsoa;
+    using namespace dase::satp_higgs;
+    if (observables.empty()) {
+        mask = satp ? static_cast<uint32_t>(SATP_DIAG_ALL) : static_cast<uint32_t>(DIAG_ALL);
+        return true;
+    }
+    mask = 0;
+    for (const auto& name : observables) {
+        if (name == "energy") {
+            mask |= satp ? static_cast<uint32_t>(SATP_DIAG_ENERGY) : static_cast<uint32_t>(DIAG_ENERGY);
+        } else if (name == "center_of_mass") {
+            mask |= satp ? static_cast<uint32_t>(SATP_DIAG_CENTER_OF_MASS)
+                         : static_cast<uint32_t>(DIAG_CENTER_OF_MASS);
+        } else if (satp && name == "rms") {
+            mask |= SATP_DIAG_RMS;
+        } else if (!satp && name == "entropy_rate") {
+            mask |= DIAG_ENTROPY_RATE;
+        } else {
+            error = "Unknown observable for this engine: " + name;
+            return false;
+        }
+    }
+    return true;
+}
+
+nlohmann::json igsoaDiagnosticsJson(const dase::igsoa::IGSOADiagnostics& d, bool three_d) {
+    using namespace dase::igsoa;
+    nlohmann::json out = nlohmann::json::object();
+    if (d.has(DIAG_ENERGY)) out["total_energy"] = d.total_energy;
+    if (d.has(DIAG_ENTROPY_RATE)) out["total_entropy_rate"] = d.total_entropy_rate;
+    if (d.has(DIAG_CENTER_OF_MASS)) {
+        out["x_cm"] = d.x_cm;
+        out["y_cm"] = d.y_cm;
+        if (three_d) out["z_cm"] = d.z_cm;
+    }
+    return out;
+}
+
+nlohmann::json satpDiagnosticsJson(const dase::satp_higgs::SATPHiggsDiagnostics& d, int dimension) {
+    using namespace dase::satp_higgs;
+    nlohmann::json out = nlohmann::json::object();
+    if (d.has(SATP_DIAG_ENERGY)) out["total_energy"] = d.total_energy;
+    if (d.has(SATP_DIAG_RMS)) {
+        out["phi_rms"] = d.phi_rms;
+        out["h_rms"] = d.h_rms;
+        out["higgs_rms"] = d.higgs_rms;
+    }
+    if (d.has(SATP_DIAG_CENTER_OF_MASS)) {
+        out["x_cm"] = d.x_cm;
+        if (dimension == 1) out["x_cm_h"] = d.x_cm_h;
+        if (dimension >= 2) out["y_cm"] = d.y_cm;
+        if (dimension == 3) out["z_cm"] = d.z_cm;
+    }
+    return out;
+}
+
+} // namespace
+
+bool EngineManager::computeDiagnostics(const std::string& engine_id,
+                                       const std::vector<std::string>& observables,
+                                       nlohmann::json& out,
+                                       std::string& error) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error = "Engine not found: " + engine_id;
+        return false;
+    }
+
+    const std::string& type = instance->engine_type;
+    const bool satp = type == "satp_higgs_1d" || type == "satp_higgs_2d" || type == "satp_higgs_3d";
+    if (!satp && type != "igsoa_complex_2d" && type != "igsoa_complex_3d") {
+        error = "Diagnostics require an igsoa_complex_2d/3d or satp_higgs engine";
+        return false;
+    }
+
+    uint32_t mask = 0;
+    if (!parseDiagnosticMask(observables, satp, mask, error)) {
+        return false;
+    }
+
+    if (type == "igsoa_complex_2d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+        out = igsoaDiagnosticsJson(engine->computeDiagnostics(mask), false);
+    } else if (type == "igsoa_complex_3d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+        out = igsoaDiagnosticsJson(engine->computeDiagnostics(mask), true);
+    } else if (type == "satp_higgs_1d") {
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
+        out = satpDiagnosticsJson(engine->computeDiagnostics(mask), 1);
+    } else if (type == "satp_higgs_2d") {
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
+        out = satpDiagnosticsJson(engine->computeDiagnostics(mask), 2);
+    } else {
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
+        out = satpDiagnosticsJson(engine->computeDiagnostics(mask), 3);
+    }
+    return true;
+}
+
+bool EngineManager::configureObservables(const std::string& engine_id,
+                                         const std::vector<std::string>& observables,
+                                         int every_steps,
+                                         size_t capacity,
+                                         std::string& error,
+                                         const std::vector<dase::igsoa::IGSOAProbe>& probes,
+                                         const dase::SlidingSpectrumConfig& spectrum,
+                                         bool observables_none) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (!getObservableRecorder(engine_id)) {
+        error = "Observable recording requires an igsoa_complex, igsoa_complex_2d or igsoa_complex_3d engine";
+        return false;
+    }
+    if (every_steps <= 0 || capacity == 0) {
+        error = "every_steps and capacity must be positive";
+        return false;
+    }
+    for (const auto& probe : probes) {
+        if (probe.node >= static_cast<size_t>(instance->num_nodes)) {
+            error = "Probe node out of range: " + std::to_string(probe.node);
+            return false;
+        }
+    }
+
+    uint32_t mask = 0;
+    if (observables_none && !probes.empty()) {
+        mask = 0;
+    } else if (!parseDiagnosticMask(observables, false, mask, error)) {
+        return false;
+    }
+
+    // Unchanged settings keep the series recorded so far
+    const auto* current = getObservableRecorder(engine_id);
+    const uint64_t interval = static_cast<uint64_t>(every_steps);
+    if (current->enabled() && current->mask() == mask && current->interval() == interval &&
+        current->series().capacity() == capacity && current->probes() == probes &&
+        current->spectrumRequest() == spectrum) {
+        return true;
+    }
+
+    const std::string& type = instance->engine_type;
+    if (type == "igsoa_complex") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+        engine->setObservableRecording(mask, interval, capacity, probes);
+        engine->setObservableSpectrum(spectrum);
+    } else if (type == "igsoa_complex_2d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+        engine->setObservableRecording(mask, interval, capacity, probes);
+        engine->setObservableSpectrum(spectrum);
+    } else {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+        engine->setObservableRecording(mask, interval, capacity, probes);
+        engine->setObservableSpectrum(spectrum);
+    }
+    return true;
+}
+
+void EngineManager::disableObservables(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !getObservableRecorder(engine_id)) {
+        return;
+    }
+    const std::string& type = instance->engine_type;
+    if (type == "igsoa_complex") {
+        static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->setObservableRecording(0, 0, 0);
+    } else if (type == "igsoa_complex_2d") {
+        static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->setObservableRecording(0, 0, 0);
+    } else {
+        static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->setObservableRecording(0, 0, 0);
+    }
+}
+
+const dase::igsoa::IGSOAObservableRecorder* EngineManager::getObservableRecorder(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return nullptr;
+    }
+
+    const std::string& type = instance->engine_type;
+    if (type == "igsoa_complex") {
+        return &static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->getObservableRecorder();
+    } else if (type == "igsoa_complex_2d") {
+        return &static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->getObservableRecorder();
+    } else if (type == "igsoa_complex_3d") {
+        return &static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->getObservableRecorder();
+    }
+    return nullptr;
+}
+
+void EngineManager::clearObservables(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !getObservableRecorder(engine_id)) {
+        return;
+    }
+    const std::string& type = instance->engine_type;
+    if (type == "igsoa_complex") {
+        static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->clearObservables();
+    } else if (type == "igsoa_complex_2d") {
+        static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->clearObservables();
+    } else {
+        static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->clearObservables();
+    }
+}
+
+bool EngineManager::setActiveRegion(const std::string& engine_id,
+                                    const dase::igsoa::ActiveRegionConfig& config) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    if (instance->engine_type == "igsoa_complex_2d") {
+        static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->setActiveRegion(config);
+    } else if (instance->engine_type == "igsoa_complex_3d") {
+        static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->setActiveRegion(config);
+    } else {
+        return false;
+    }
+    // Masked stepping changes the trajectory; its settings are not hashed
+    instance->provenance.untrack();
+    return true;
+}
+
+bool EngineManager::setSatpIntegrator(const std::string& engine_id,
+                                      dase::satp_higgs::SATPHiggsIntegrator integrator) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    if (instance->engine_type == "satp_higgs_1d") {
+        static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle)->setIntegrator(integrator);
+    } else if (instance->engine_type == "satp_higgs_2d") {
+        static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle)->setIntegrator(integrator);
+    } else if (instance->engine_type == "satp_higgs_3d") {
+        static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->setIntegrator(integrator);
+    } else {
+        return false;
+    }
+    instance->provenance.event("integrator").add(integrator);
+    return true;
+}
+
+bool EngineManager::isOutOfCore(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle || instance->engine_type != "igsoa_complex_3d") {
+        return false;
+    }
+    return static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->isOutOfCore();
+}
+
 bool EngineManager::computeCenterOfMass2D(const std::string& engine_id,
                                           double& x_cm_out,
                                           double& y_cm_out) {
@@ -1331,7 +2023,9 @@ bool EngineManager::computeCenterOfMass2D(const std::string& engine_id,
     }
 
     auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-    dase::igsoa::IGSOAStateInit2D::computeCenterOfMass(*engine, x_cm_out, y_cm_out);
+    const auto d = engine->computeDiagnostics(dase::igsoa::DIAG_CENTER_OF_MASS);
+    x_cm_out = d.x_cm;
+    y_cm_out = d.y_cm;
     return true;
 }
 
@@ -1349,7 +2043,10 @@ bool EngineManager::computeCenterOfMass3D(const std::string& engine_id,
     }
 
     auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-    dase::igsoa::IGSOAStateInit3D::computeCenterOfMass(*engine, x_cm_out, y_cm_out, z_cm_out);
+    const auto d = engine->computeDiagnostics(dase::igsoa::DIAG_CENTER_OF_MASS);
+    x_cm_out = d.x_cm;
+    y_cm_out = d.y_cm;
+    z_cm_out = d.z_cm;
     return true;
 }
 
@@ -1359,55 +2056,44 @@ EngineManager::EngineMetrics EngineManager::getMetrics(const std::string& engine
     metrics.ops_per_sec = 0;
     metrics.total_operations = 0;
     metrics.speedup_factor = 0;
+    metrics.coupling_cache_bytes = 0;
+    metrics.coupling_spectral_active = false;
+    metrics.float_precision_active = false;
+    metrics.evolve_allocations = 0;
+    metrics.active_region_enabled = false;
 
     auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
         return metrics;
     }
 
-    if (instance->engine_type == "phase4b") {
-        // Phase 4B - get from DLL
-        if (!dase_get_metrics) {
-            return metrics;
-        }
-
-        dase_get_metrics(
-            instance->engine_handle,
-            &metrics.ns_per_op,
-            &metrics.ops_per_sec,
-            &metrics.speedup_factor,
-            &metrics.total_operations
-        );
-
-    } else if (instance->engine_type == "igsoa_complex") {
-        // IGSOA Complex - get directly
-        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
-        engine->getMetrics(
-            metrics.ns_per_op,
-            metrics.ops_per_sec,
-            metrics.speedup_factor,
-            metrics.total_operations
-        );
+    instance->backend->metrics(instance->engine_handle, metrics);
+    return metrics;
+}
 
-    } else if (instance->engine_type == "igsoa_complex_2d") {
-        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-        engine->getMetrics(
-            metrics.ns_per_op,
-            metrics.ops_per_sec,
-            metrics.speedup_factor,
-            metrics.total_operations
-        );
-    } else if (instance->engine_type == "igsoa_complex_3d") {
-        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-        engine->getMetrics(
-            metrics.ns_per_op,
-            metrics.ops_per_sec,
-            metrics.speedup_factor,
-            metrics.total_operations
-        );
+bool EngineManager::resetPhaseTimings(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
     }
 
-    return metrics;
+    const std::string& type = instance->engine_type;
+    if (type == "igsoa_complex") {
+        static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->resetPhaseTimings();
+    } else if (type == "igsoa_complex_2d") {
+        static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->resetPhaseTimings();
+    } else if (type == "igsoa_complex_3d") {
+        static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->resetPhaseTimings();
+    } else if (type == "satp_higgs_1d") {
+        static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle)->resetPhaseTimings();
+    } else if (type == "satp_higgs_2d") {
+        static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle)->resetPhaseTimings();
+    } else if (type == "satp_higgs_3d") {
+        static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->resetPhaseTimings();
+    } else {
+        return false;
+    }
+    return true;
 }
 
 std::string EngineManager::generateEngineId() {
@@ -5,18 +5,39 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <memory>
 #include <vector>
 #include <atomic>
 #include "json.hpp"
+#include "../../src/cpp/igsoa_active_region.h"
+#include "../../src/cpp/igsoa_diagnostics.h"
+#include "../../src/cpp/igsoa_state_extract.h"
+#include "../../src/cpp/async_checkpointer.h"
+#include "../../src/cpp/result_cache.h"
+#include "../../src/cpp/memory_admission.h"
+#include "../../src/cpp/parareal.h"
+#include "../../src/cpp/perf_counters.h"
+#include "../../src/cpp/phase_profiler.h"
+
+class EngineBackend;
+class EngineRegistry;
+struct EngineCreateParams;
+
+namespace dase {
+namespace satp_higgs {
+enum class SATPHiggsIntegrator : uint8_t;  // satp_higgs_engine_1d.h
+}
+}
 
 // Engine instance wrapper
 struct EngineInstance {
     std::string engine_id;
     std::string engine_type; // "phase4b", "igsoa_complex", or IGSOA lattice variants
-    void* engine_handle;      // Opaque handle to DLL engine
+    void* engine_handle;      // Opaque engine handle, owned through backend
+    const EngineBackend* backend;  // Registry backend that created engine_handle
     int num_nodes;
     double created_timestamp;
     int dimension_x;
@@ -26,9 +47,31 @@ struct EngineInstance {
     double kappa;
     double gamma;
     double dt;
+    std::string coupling_mode;  // "direct", "neighbor_cache", "spectral" or "recursive"
+    int replicas;               // Replica count (igsoa_ensemble_2d; num_nodes is per replica)
+    std::string precision;      // "float64" or "float32" (IGSOA 2D/3D, SATP+Higgs)
+    std::string integrator;     // "euler" or "rk4" (IGSOA 1D/2D/3D)
+    size_t footprint_bytes;     // Reserved with dase::MemoryAdmission (0: none)
+
+    // Background checkpointing (IGSOA / SATP+Higgs engines): runMission captures
+    // whenever mission_steps crosses a multiple of checkpoint_every_steps
+    std::unique_ptr<dase::AsyncCheckpointer> checkpointer;
+    int checkpoint_every_steps;
+    uint64_t mission_steps;     // Steps run through EngineManager::runMission
+
+    // Configuration, state profiles and missions behind the current state
+    // (result cache key); untracked after changes that cannot be hashed
+    dase::MissionProvenance provenance;
+
+    // Hardware event counts around each runMission (any engine type); the
+    // peaks (0: unset) scale the achieved IPC and DRAM bandwidth in get_metrics
+    std::unique_ptr<dase::PerfCounters> perf_counters;
+    double perf_peak_ipc;
+    double perf_peak_dram_gb_per_s;
 
     EngineInstance()
         : engine_handle(nullptr)
+        , backend(nullptr)
         , num_nodes(0)
         , created_timestamp(0)
         , dimension_x(0)
@@ -37,7 +80,16 @@ struct EngineInstance {
         , R_c(1.0)
         , kappa(1.0)
         , gamma(0.1)
-        , dt(0.01) {}
+        , dt(0.01)
+        , coupling_mode("direct")
+        , replicas(0)
+        , precision("float64")
+        , integrator("euler")
+        , footprint_bytes(0)
+        , checkpoint_every_steps(0)
+        , mission_steps(0)
+        , perf_peak_ipc(0.0)
+        , perf_peak_dram_gb_per_s(0.0) {}
 };
 
 class EngineManager {
@@ -54,18 +106,118 @@ public:
                              double dt = 0.01,
                              int N_x = 0,
                              int N_y = 0,
-                             int N_z = 0);
+                             int N_z = 0,
+                             const std::string& coupling_mode = "direct",
+                             const std::string& precision = "float64",
+                             const std::string& integrator = "euler",
+                             double admission_wait_seconds = 0.0,
+                             std::string* error = nullptr);
+    // Ensemble of N_x × N_y IGSOA 2D replicas sharing R_c and dt; kappas and
+    // gammas hold one value per replica
+    std::string createEnsemble(int N_x,
+                               int N_y,
+                               double R_c,
+                               double dt,
+                               const std::vector<double>& kappas,
+                               const std::vector<double>& gammas,
+                               double admission_wait_seconds = 0.0,
+                               std::string* error = nullptr);
     bool destroyEngine(const std::string& engine_id);
     EngineInstance* getEngine(const std::string& engine_id);
 
+    // Destroy every engine, parked ones included (session teardown)
+    void destroyAllEngines();
+
+    // Memory admission: createEngine and createEnsemble reserve the new
+    // engine's estimated footprint (EngineBackend::estimateBytes) with the
+    // process-wide dase::MemoryAdmission before allocating it, and hold it
+    // until the engine is destroyed (parked engines keep theirs). A create
+    // that does not fit first destroys this manager's parked engines,
+    // oldest first, then waits up to admission_wait_seconds for memory to
+    // be released (other daemon sessions); error says why it failed.
+    static void setMemoryBudget(size_t bytes);
+    static dase::MemoryAdmissionStats getMemoryAdmissionStats();
+
+    // Engine pool: destroyEngine parks reusable engines (IGSOA 2D/3D in RAM)
+    // while they fit in max_bytes, oldest evicted first, and createEngine
+    // re-initializes a parked engine of the same type and extents instead
+    // of allocating a new one. 0 disables the pool and frees what it holds.
+    struct EnginePoolStats {
+        uint64_t hits;            // Creates served from the pool
+        uint64_t misses;          // Creates of a poolable type that allocated
+        size_t retained_engines;
+        size_t retained_bytes;
+        size_t max_bytes;
+    };
+
+    void setEnginePoolLimit(size_t max_bytes);
+    EnginePoolStats getEnginePoolStats() const;
+
     // List all engines
     std::vector<EngineInstance*> listEngines();
 
-    // Engine operations (Phase 4B)
+    // Load a shared library exporting the DASE C API as the backend of
+    // engine_type (replacing a built-in one); error explains a failure
+    bool loadEnginePlugin(const std::string& engine_type, const std::string& path, std::string& error);
+
+    // Engine types create_engine accepts
+    std::vector<std::string> engineTypes() const;
+
+    // Engine operations (Phase 4B integrator state; no-op for other engines)
     bool setNodeState(const std::string& engine_id, int node_index, double value);
     double getNodeState(const std::string& engine_id, int node_index);
     bool runMission(const std::string& engine_id, int num_steps, int iterations_per_node);
 
+    // Run on an already-resolved instance without touching the engine map
+    // (used by MissionScheduler workers). Inputs continue the sin/cos
+    // sequence at step_offset, so consecutive chunks match one long call.
+    bool runMission(EngineInstance& instance, int num_steps, int iterations_per_node, int step_offset = 0);
+
+    // Checkpoint every every_steps mission steps (IGSOA / SATP+Higgs engines).
+    // Reconfiguring waits for the previous checkpointer's pending writes.
+    bool configureCheckpoints(const std::string& engine_id,
+                              const dase::CheckpointPolicy& policy,
+                              int every_steps,
+                              std::string& error);
+    void disableCheckpoints(const std::string& engine_id);
+
+    // Result cache: runCachedMission restores the final state of a mission
+    // already run from the same provenance (IGSOA / SATP+Higgs engines)
+    // instead of stepping, and stores it otherwise, least recently used
+    // entries evicted beyond max_bytes. The cache is bypassed (and the
+    // mission runs normally) for untracked engines and while checkpoints
+    // or observables are recorded, since neither is replayed from a hit.
+    struct MissionCacheOutcome {
+        std::string key;          // Empty when bypassed
+        bool hit;
+        bool stored;
+        std::string bypass_reason;
+        std::string error;        // Why a store or a stored entry failed
+    };
+
+    bool configureResultCache(const std::string& directory, size_t max_bytes, std::string& error);
+    void disableResultCache();
+    bool resultCacheEnabled() const;
+    dase::ResultCacheStats getResultCacheStats() const;
+    const std::string& resultCacheDirectory() const;
+    bool runCachedMission(const std::string& engine_id, int num_steps, int iterations_per_node,
+                          MissionCacheOutcome& outcome);
+
+    // Parareal: num_steps undriven steps cut into time slices that run
+    // concurrently (parareal.h; IGSOA / SATP+Higgs engines). The final
+    // state matches runMission within the tolerance rather than bit for
+    // bit, so the engine leaves the result cache's provenance. Refused
+    // while checkpoints or observables are recorded, which the slice
+    // workers do not take.
+    bool runPararealMission(const std::string& engine_id, int num_steps, const dase::PararealConfig& config,
+                            dase::PararealStats& stats, std::string& error);
+
+    // Count hardware events around every later runMission. Enabling again
+    // keeps the totals unless reset; disabling drops them.
+    bool enablePerfCounters(const std::string& engine_id, double peak_ipc, double peak_dram_gb_per_s,
+                            bool reset);
+    void disablePerfCounters(const std::string& engine_id);
+
     // Engine operations (IGSOA Complex)
     bool setNodePsi(const std::string& engine_id, int node_index, double real, double imag);
     bool getNodePsi(const std::string& engine_id, int node_index, double& real_out, double& imag_out);
@@ -76,6 +228,31 @@ public:
                           std::vector<double>& psi_imag,
                           std::vector<double>& phi);
 
+    // One replica of an igsoa_ensemble_2d engine
+    bool getReplicaStates(const std::string& engine_id,
+                          int replica,
+                          std::vector<double>& psi_real,
+                          std::vector<double>& psi_imag,
+                          std::vector<double>& phi);
+
+    // Region-of-interest extraction (IGSOA engines): only the fields in
+    // field_mask (dase::igsoa::STATE_FIELD_*) over the strided region are
+    // copied; unselected outputs are left empty
+    bool getRegionStates(const std::string& engine_id,
+                         const dase::igsoa::StateRegion& region,
+                         uint32_t field_mask,
+                         std::vector<double>& psi_real,
+                         std::vector<double>& psi_imag,
+                         std::vector<double>& F,
+                         std::vector<double>& phi);
+    bool getRegionStates(const std::string& engine_id,
+                         const dase::igsoa::StateRegion& region,
+                         uint32_t field_mask,
+                         std::vector<float>& psi_real,
+                         std::vector<float>& psi_imag,
+                         std::vector<float>& F,
+                         std::vector<float>& phi);
+
     // Bulk state extraction (for SATP+Higgs engines)
     bool getSatpState(const std::string& engine_id,
                       std::vector<double>& phi_out,
@@ -83,7 +260,8 @@ public:
                       std::vector<double>& h_out,
                       std::vector<double>& h_dot_out);
 
-    // Bulk state initialization (for IGSOA engines)
+    // Bulk state initialization (for IGSOA engines; ensembles apply the
+    // 2D profiles to params["replica"], or to every replica if absent)
     bool setIgsoaState(const std::string& engine_id,
                        const std::string& profile_type,
                        const nlohmann::json& params);
@@ -93,6 +271,43 @@ public:
                       const std::string& profile_type,
                       const nlohmann::json& params);
 
+    // One fused diagnostics pass (IGSOA 2D/3D, SATP+Higgs 1D/2D/3D).
+    // observables: "energy", "center_of_mass" and "entropy_rate" (IGSOA) or
+    // "rms" (SATP+Higgs); empty selects all. Fills out with the results.
+    bool computeDiagnostics(const std::string& engine_id,
+                            const std::vector<std::string>& observables,
+                            nlohmann::json& out,
+                            std::string& error);
+
+    // Observable time series (IGSOA 1D/2D/3D): record observables (names as
+    // for computeDiagnostics; none at all with observables_none) and probe
+    // nodes every every_steps steps of later missions into a ring of
+    // capacity samples, feeding the sliding spectrum if it has frequencies
+    // (cycles per unit time). New settings clear the series.
+    bool configureObservables(const std::string& engine_id,
+                              const std::vector<std::string>& observables,
+                              int every_steps,
+                              size_t capacity,
+                              std::string& error,
+                              const std::vector<dase::igsoa::IGSOAProbe>& probes = {},
+                              const dase::SlidingSpectrumConfig& spectrum = dase::SlidingSpectrumConfig(),
+                              bool observables_none = false);
+    void disableObservables(const std::string& engine_id);
+
+    // Recorder of an IGSOA engine (nullptr for other types); read it while
+    // no mission runs on the engine
+    const dase::igsoa::IGSOAObservableRecorder* getObservableRecorder(const std::string& engine_id);
+    void clearObservables(const std::string& engine_id);
+
+    // Active-region stepping (IGSOA 2D/3D); false for other engine types
+    bool setActiveRegion(const std::string& engine_id, const dase::igsoa::ActiveRegionConfig& config);
+
+    // Time integrator of a SATP+Higgs engine; false for other engine types
+    bool setSatpIntegrator(const std::string& engine_id, dase::satp_higgs::SATPHiggsIntegrator integrator);
+
+    // True if the engine's lattice lives in spill files (IGSOA 3D over the memory budget)
+    bool isOutOfCore(const std::string& engine_id);
+
     // 2D analysis helpers
     bool computeCenterOfMass2D(const std::string& engine_id,
                                double& x_cm_out,
@@ -108,14 +323,51 @@ public:
         double ops_per_sec;
         uint64_t total_operations;
         double speedup_factor;
+        uint64_t coupling_cache_bytes;  // Neighbor-list / stencil / FFT memory (IGSOA 2D/3D)
+        bool coupling_spectral_active;  // Last run used the FFT coupling path (IGSOA 2D/3D)
+        bool float_precision_active;    // Last run stepped in float32 (IGSOA 2D/3D, SATP+Higgs)
+        uint64_t evolve_allocations;    // Heap allocations inside evolve() (SATP+Higgs)
+        bool active_region_enabled;     // Active-region stepping configured (IGSOA 2D/3D)
+        dase::igsoa::ActiveRegionStats active_region;  // Mask statistics (IGSOA 2D/3D)
+        std::vector<dase::PhaseTiming> phases;  // Per-phase step timing (IGSOA 1D/2D/3D, SATP+Higgs)
     };
 
     EngineMetrics getMetrics(const std::string& engine_id);
 
+    // Clear the per-phase step timing; false if the engine has no phase profiler
+    bool resetPhaseTimings(const std::string& engine_id);
+
 private:
+    std::unique_ptr<EngineRegistry> registry;
     std::map<std::string, std::unique_ptr<EngineInstance>> engines;
     std::atomic<int> next_engine_id;
 
+    struct PooledEngine {
+        std::string engine_type;
+        const EngineBackend* backend;
+        void* handle;
+        size_t bytes;
+        size_t reserved;   // Admission reservation it keeps while parked
+    };
+    std::vector<PooledEngine> pool;  // Oldest first
+    size_t pool_bytes;
+    size_t pool_max_bytes;
+    uint64_t pool_hits;
+    uint64_t pool_misses;
+
+    dase::ResultCache result_cache;
+
+    void* takePooledEngine(const std::string& engine_type, const EngineBackend* backend,
+                           EngineInstance& instance, const EngineCreateParams& params, size_t& reserved);
+    void trimPool(size_t max_bytes);
+    void evictPooledEngine(size_t k);
+    bool admit(size_t held, size_t bytes, double wait_seconds, std::string* error);
+
     std::string generateEngineId();
+    bool runCheckpointedMission(EngineInstance& instance, int num_steps, int iterations_per_node, int step_offset);
+    bool runMissionSteps(EngineInstance& instance, int num_steps, int iterations_per_node, int step_offset);
+    static bool captureCheckpoint(EngineInstance& instance);
+    bool applyIgsoaState(const std::string& engine_id, const std::string& profile_type, const nlohmann::json& params);
+    bool applySatpState(const std::string& engine_id, const std::string& profile_type, const nlohmann::json& params);
     double getCurrentTimestamp();
 };
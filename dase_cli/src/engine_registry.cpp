@@ -0,0 +1,557 @@
+/**
+ * Engine Registry Implementation
+ */
+
+#include "engine_registry.h"
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+#include "../../src/cpp/igsoa_complex_engine.h"
+#include "../../src/cpp/igsoa_complex_engine_2d.h"
+#include "../../src/cpp/igsoa_complex_engine_3d.h"
+#include "../../src/cpp/igsoa_ensemble_engine_2d.h"
+#include "../../src/cpp/satp_higgs_engine_1d.h"
+#include "../../src/cpp/satp_higgs_physics_1d.h"
+#include "../../src/cpp/satp_higgs_engine_2d.h"
+#include "../../src/cpp/satp_higgs_physics_2d.h"
+#include "../../src/cpp/satp_higgs_engine_3d.h"
+#include "../../src/cpp/satp_higgs_physics_3d.h"
+
+#ifdef DASE_CLI_STATIC_PHASE4B
+#include "../../src/cpp/analog_universal_node_engine_avx2.h"
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace {
+
+constexpr int64_t kMaxNodes = 1048576;
+
+// Lattice size, or 0 if an extent is missing or the product is too large
+int latticeNodes(int N_x, int N_y, int N_z = 1) {
+    if (N_x <= 0 || N_y <= 0 || N_z <= 0) {
+        return 0;
+    }
+    const int64_t nodes = static_cast<int64_t>(N_x) * N_y * N_z;
+    return nodes <= kMaxNodes ? static_cast<int>(nodes) : 0;
+}
+
+template <typename Engine>
+class TypedBackend : public EngineBackend {
+public:
+    void destroy(void* handle) const override { delete static_cast<Engine*>(handle); }
+
+protected:
+    static Engine& engine(void* handle) { return *static_cast<Engine*>(handle); }
+};
+
+// ---------------------------------------------------------------------------
+// IGSOA lattices
+// ---------------------------------------------------------------------------
+
+dase::igsoa::IGSOAComplexConfig igsoaConfig(const EngineCreateParams& params, size_t num_nodes) {
+    dase::igsoa::IGSOAComplexConfig config;
+    config.num_nodes = num_nodes;
+    config.R_c_default = params.R_c;
+    config.kappa = params.kappa;
+    config.gamma = params.gamma;
+    config.dt = params.dt;
+    config.integrator = params.integrator;
+    return config;
+}
+
+template <typename Engine>
+class IgsoaBackend : public TypedBackend<Engine> {
+public:
+    bool run(void* handle, int num_steps, const double* input, const double* control, int) const override {
+        this->engine(handle).runMission(num_steps, input, control);
+        return true;
+    }
+};
+
+class Igsoa1DBackend : public IgsoaBackend<dase::igsoa::IGSOAComplexEngine> {
+public:
+    void* create(EngineInstance&, const EngineCreateParams& params) const override {
+        dase::igsoa::IGSOAComplexConfig config = igsoaConfig(params, static_cast<size_t>(params.num_nodes));
+        config.coupling_mode = params.coupling;
+
+        // DIAGNOSTIC: Print config being used
+        std::cerr << "[ENGINE MANAGER] Creating IGSOA engine with R_c=" << params.R_c
+                  << " (config.R_c_default=" << config.R_c_default << ")" << std::endl;
+
+        return new dase::igsoa::IGSOAComplexEngine(config);
+    }
+
+    size_t estimateBytes(const EngineCreateParams& params) const override {
+        dase::igsoa::IGSOAComplexConfig config = igsoaConfig(params, static_cast<size_t>(params.num_nodes));
+        config.coupling_mode = params.coupling;
+        return dase::igsoa::IGSOAComplexEngine::estimateFootprint(config);
+    }
+
+    void metrics(void* handle, EngineManager::EngineMetrics& out) const override {
+        auto& e = engine(handle);
+        e.getMetrics(out.ns_per_op, out.ops_per_sec, out.speedup_factor, out.total_operations);
+        out.phases = e.getPhaseTimings();
+    }
+};
+
+// Configuration of an IGSOA 2D/3D lattice engine
+dase::igsoa::IGSOAComplexConfig latticeConfig(const EngineCreateParams& params, int nodes) {
+    dase::igsoa::IGSOAComplexConfig config = igsoaConfig(params, static_cast<size_t>(nodes));
+    config.normalize_psi = false;
+    config.coupling_mode = params.coupling;
+    config.precision = params.use_float ? dase::igsoa::IGSOAPrecision::Float : dase::igsoa::IGSOAPrecision::Double;
+    return config;
+}
+
+// 2D and 3D lattices report the same coupling/precision/active-region fields
+template <typename Engine>
+void latticeMetrics(Engine& e, EngineManager::EngineMetrics& out) {
+    e.getMetrics(out.ns_per_op, out.ops_per_sec, out.speedup_factor, out.total_operations);
+    out.coupling_cache_bytes = e.getCouplingCacheMemoryUsage();
+    out.coupling_spectral_active = e.isSpectralCouplingActive();
+    out.float_precision_active = e.isFloatPrecisionActive();
+    out.active_region_enabled = e.getActiveRegion().enabled;
+    out.active_region = e.getActiveRegionStats();
+    out.phases = e.getPhaseTimings();
+}
+
+class Igsoa2DBackend : public IgsoaBackend<dase::igsoa::IGSOAComplexEngine2D> {
+public:
+    void* create(EngineInstance& instance, const EngineCreateParams& params) const override {
+        // num_nodes follows N_x * N_y to prevent inconsistency
+        const int nodes = latticeNodes(params.N_x, params.N_y);
+        if (nodes == 0) {
+            return nullptr;
+        }
+        instance.num_nodes = nodes;
+        return new dase::igsoa::IGSOAComplexEngine2D(latticeConfig(params, nodes), static_cast<size_t>(params.N_x),
+                                                     static_cast<size_t>(params.N_y));
+    }
+
+    size_t estimateBytes(const EngineCreateParams& params) const override {
+        const int nodes = latticeNodes(params.N_x, params.N_y);
+        if (nodes == 0) {
+            return 0;
+        }
+        return dase::igsoa::IGSOAComplexEngine2D::estimateFootprint(latticeConfig(params, nodes),
+                                                                     static_cast<size_t>(params.N_x),
+                                                                     static_cast<size_t>(params.N_y));
+    }
+
+    size_t reusableBytes(void* handle) const override {
+        auto& e = engine(handle);
+        return dase::igsoa::IGSOAComplexEngine2D::estimateMemoryUsage(e.getNx(), e.getNy()) +
+               e.getCouplingCacheMemoryUsage();
+    }
+
+    bool reinit(void* handle, EngineInstance& instance, const EngineCreateParams& params) const override {
+        auto& e = engine(handle);
+        if (e.getNx() != static_cast<size_t>(params.N_x) || e.getNy() != static_cast<size_t>(params.N_y)) {
+            return false;
+        }
+        instance.num_nodes = static_cast<int>(e.getTotalNodes());
+        e.reinitialize(latticeConfig(params, instance.num_nodes));
+        return true;
+    }
+
+    void metrics(void* handle, EngineManager::EngineMetrics& out) const override {
+        latticeMetrics(engine(handle), out);
+    }
+};
+
+class Igsoa3DBackend : public IgsoaBackend<dase::igsoa::IGSOAComplexEngine3D> {
+public:
+    void* create(EngineInstance& instance, const EngineCreateParams& params) const override {
+        const int nodes = latticeNodes(params.N_x, params.N_y, params.N_z);
+        if (nodes == 0) {
+            return nullptr;
+        }
+        instance.num_nodes = nodes;
+        return new dase::igsoa::IGSOAComplexEngine3D(latticeConfig(params, nodes), static_cast<size_t>(params.N_x),
+                                                     static_cast<size_t>(params.N_y),
+                                                     static_cast<size_t>(params.N_z));
+    }
+
+    size_t estimateBytes(const EngineCreateParams& params) const override {
+        const int nodes = latticeNodes(params.N_x, params.N_y, params.N_z);
+        if (nodes == 0) {
+            return 0;
+        }
+        return dase::igsoa::IGSOAComplexEngine3D::estimateFootprint(latticeConfig(params, nodes),
+                                                                     static_cast<size_t>(params.N_x),
+                                                                     static_cast<size_t>(params.N_y),
+                                                                     static_cast<size_t>(params.N_z));
+    }
+
+    // Out-of-core lattices give their spill files back instead of parking
+    size_t reusableBytes(void* handle) const override {
+        auto& e = engine(handle);
+        if (e.isOutOfCore()) {
+            return 0;
+        }
+        return dase::igsoa::IGSOAComplexEngine3D::estimateMemoryUsage(e.getNx(), e.getNy(), e.getNz()) +
+               e.getCouplingCacheMemoryUsage();
+    }
+
+    bool reinit(void* handle, EngineInstance& instance, const EngineCreateParams& params) const override {
+        auto& e = engine(handle);
+        if (e.getNx() != static_cast<size_t>(params.N_x) || e.getNy() != static_cast<size_t>(params.N_y) ||
+            e.getNz() != static_cast<size_t>(params.N_z)) {
+            return false;
+        }
+        instance.num_nodes = static_cast<int>(e.getTotalNodes());
+        e.reinitialize(latticeConfig(params, instance.num_nodes));
+        return true;
+    }
+
+    void metrics(void* handle, EngineManager::EngineMetrics& out) const override {
+        latticeMetrics(engine(handle), out);
+    }
+};
+
+// Created by EngineManager::createEnsemble (per-replica parameters)
+class IgsoaEnsembleBackend : public IgsoaBackend<dase::igsoa::IGSOAEnsembleEngine2D> {
+public:
+    void* create(EngineInstance&, const EngineCreateParams&) const override { return nullptr; }
+
+    void metrics(void* handle, EngineManager::EngineMetrics& out) const override {
+        engine(handle).getMetrics(out.ns_per_op, out.ops_per_sec, out.speedup_factor, out.total_operations);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// SATP+Higgs lattices
+// ---------------------------------------------------------------------------
+
+dase::satp_higgs::SATPHiggsParams satpParams(const EngineCreateParams& params) {
+    dase::satp_higgs::SATPHiggsParams physics;
+    physics.c = (params.R_c > 0.0) ? params.R_c : 1.0;  // Wave speed (reuse R_c parameter)
+    physics.gamma_phi = params.gamma;                    // Scale field dissipation
+    physics.gamma_h = params.gamma;                      // Higgs dissipation (same for now)
+    physics.lambda = params.kappa;                       // φ-h coupling (reuse kappa parameter)
+    physics.mu_squared = -1.0;                           // Higgs mass² (negative for SSB)
+    physics.lambda_h = 0.5;                              // Higgs self-coupling
+    physics.updateVEV();                                 // Compute VEV
+    return physics;
+}
+
+constexpr double kSatpDx = 0.1;  // Default spatial step
+
+double satpDt(const EngineCreateParams& params) {
+    return (params.dt > 0.0) ? params.dt : 0.001;
+}
+
+template <typename Engine>
+class SatpBackend : public TypedBackend<Engine> {
+public:
+    bool run(void* handle, int num_steps, const double*, const double*, int) const override {
+        this->engine(handle).evolve(static_cast<size_t>(num_steps));
+        return true;
+    }
+
+    void metrics(void* handle, EngineManager::EngineMetrics& out) const override {
+        auto& e = this->engine(handle);
+        out.total_operations = e.getTotalUpdates();
+        out.evolve_allocations = e.getEvolveAllocationCount();
+        out.float_precision_active = e.isFloatPrecisionActive();
+        out.phases = e.getPhaseTimings();
+    }
+
+protected:
+    // Nodes plus Verlet scratch over sites (tile planes of tile_plane sites, 3D)
+    static size_t footprint(size_t sites, size_t tile_plane, const EngineCreateParams& params) {
+        return sites * sizeof(dase::satp_higgs::SATPHiggsNode) +
+               dase::satp_higgs::SATPHiggsScratch::estimateMemoryUsage(sites, tile_plane, params.use_float);
+    }
+
+    static Engine* withPrecision(Engine* engine, const EngineCreateParams& params) {
+        engine->setPrecision(params.use_float ? dase::satp_higgs::SATPHiggsPrecision::Float
+                                              : dase::satp_higgs::SATPHiggsPrecision::Double);
+        return engine;
+    }
+};
+
+class Satp1DBackend : public SatpBackend<dase::satp_higgs::SATPHiggsEngine1D> {
+public:
+    void* create(EngineInstance&, const EngineCreateParams& params) const override {
+        return withPrecision(new dase::satp_higgs::SATPHiggsEngine1D(
+            static_cast<size_t>(params.num_nodes), kSatpDx, satpDt(params), satpParams(params)), params);
+    }
+
+    size_t estimateBytes(const EngineCreateParams& params) const override {
+        return params.num_nodes > 0 ? footprint(static_cast<size_t>(params.num_nodes), 0, params) : 0;
+    }
+};
+
+class Satp2DBackend : public SatpBackend<dase::satp_higgs::SATPHiggsEngine2D> {
+public:
+    void* create(EngineInstance& instance, const EngineCreateParams& params) const override {
+        const int nodes = latticeNodes(params.N_x, params.N_y);
+        if (nodes == 0) {
+            return nullptr;
+        }
+        instance.num_nodes = nodes;
+        return withPrecision(new dase::satp_higgs::SATPHiggsEngine2D(
+            static_cast<size_t>(params.N_x), static_cast<size_t>(params.N_y),
+            kSatpDx, satpDt(params), satpParams(params)), params);
+    }
+
+    size_t estimateBytes(const EngineCreateParams& params) const override {
+        const int nodes = latticeNodes(params.N_x, params.N_y);
+        return nodes > 0 ? footprint(static_cast<size_t>(nodes), 0, params) : 0;
+    }
+};
+
+class Satp3DBackend : public SatpBackend<dase::satp_higgs::SATPHiggsEngine3D> {
+public:
+    void* create(EngineInstance& instance, const EngineCreateParams& params) const override {
+        const int nodes = latticeNodes(params.N_x, params.N_y, params.N_z);
+        if (nodes == 0) {
+            return nullptr;
+        }
+        instance.num_nodes = nodes;
+        return withPrecision(new dase::satp_higgs::SATPHiggsEngine3D(
+            static_cast<size_t>(params.N_x), static_cast<size_t>(params.N_y), static_cast<size_t>(params.N_z),
+            kSatpDx, satpDt(params), satpParams(params)), params);
+    }
+
+    size_t estimateBytes(const EngineCreateParams& params) const override {
+        const int nodes = latticeNodes(params.N_x, params.N_y, params.N_z);
+        const size_t plane = static_cast<size_t>(params.N_x) * static_cast<size_t>(params.N_y);
+        return nodes > 0 ? footprint(static_cast<size_t>(nodes), plane, params) : 0;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Phase 4B analog engine
+// ---------------------------------------------------------------------------
+
+#ifdef DASE_CLI_STATIC_PHASE4B
+class Phase4BBackend : public TypedBackend<AnalogCellularEngineAVX2> {
+public:
+    void* create(EngineInstance&, const EngineCreateParams& params) const override {
+        return new AnalogCellularEngineAVX2(static_cast<size_t>(params.num_nodes));
+    }
+
+    size_t estimateBytes(const EngineCreateParams& params) const override {
+        return params.num_nodes > 0 ? AnalogNodeStateSoA::estimateMemoryUsage(static_cast<size_t>(params.num_nodes))
+                                    : 0;
+    }
+
+    bool run(void* handle, int num_steps, const double* input, const double* control,
+             int iterations_per_node) const override {
+        if (iterations_per_node <= 0) {
+            return false;
+        }
+        engine(handle).runMissionOptimized_Phase4C(input, control, static_cast<uint64_t>(num_steps),
+                                                   static_cast<uint32_t>(iterations_per_node));
+        return true;
+    }
+
+    void metrics(void* handle, EngineManager::EngineMetrics& out) const override {
+        const ::EngineMetrics m = engine(handle).getMetrics();
+        out.ns_per_op = m.current_ns_per_op;
+        out.ops_per_sec = m.current_ops_per_second;
+        out.speedup_factor = m.speedup_factor;
+        out.total_operations = static_cast<uint64_t>(m.total_operations);
+    }
+
+    // The node's integrator state
+    bool setNodeValue(void* handle, int node_index, double value) const override {
+        AnalogNodeStateSoA& nodes = engine(handle).getNodeStateMutable();
+        if (node_index < 0 || static_cast<size_t>(node_index) >= nodes.size()) {
+            return false;
+        }
+        nodes.integrator_state[node_index] = value;
+        return true;
+    }
+
+    bool getNodeValue(void* handle, int node_index, double& value) const override {
+        const AnalogNodeStateSoA& nodes = engine(handle).getNodeState();
+        if (node_index < 0 || static_cast<size_t>(node_index) >= nodes.size()) {
+            return false;
+        }
+        value = nodes.integrator_state[node_index];
+        return true;
+    }
+};
+#endif
+
+// ---------------------------------------------------------------------------
+// Plugin libraries (DASE C API)
+// ---------------------------------------------------------------------------
+
+// Loaded libraries are never unloaded (FFTW/DLL unload ordering at exit)
+class SharedLibrary {
+public:
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        handle = reinterpret_cast<void*>(LoadLibraryA(path.c_str()));
+#else
+        handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+        return handle != nullptr;
+    }
+
+    void* symbol(const char* name) const {
+#ifdef _WIN32
+        return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(handle), name));
+#else
+        return dlsym(handle, name);
+#endif
+    }
+
+    void close() {
+#ifdef _WIN32
+        FreeLibrary(static_cast<HMODULE>(handle));
+#else
+        dlclose(handle);
+#endif
+        handle = nullptr;
+    }
+
+    static std::string lastError() {
+#ifdef _WIN32
+        return "error code " + std::to_string(GetLastError());
+#else
+        const char* message = dlerror();
+        return message ? message : "unknown error";
+#endif
+    }
+
+private:
+    void* handle = nullptr;
+};
+
+class PluginBackend : public EngineBackend {
+public:
+    typedef void* (*CreateEngineFunc)(uint32_t);
+    typedef void (*DestroyEngineFunc)(void*);
+    typedef void (*RunMissionFunc)(void*, const double*, const double*, uint64_t, uint32_t);
+    typedef void (*GetMetricsFunc)(void*, double*, double*, double*, uint64_t*);
+
+    // Resolve the C API; the library is closed again if an entry point is missing
+    bool load(const std::string& library_path, std::string& error) {
+        if (!library.open(library_path)) {
+            error = "Cannot load " + library_path + ": " + SharedLibrary::lastError();
+            return false;
+        }
+        create_engine = reinterpret_cast<CreateEngineFunc>(library.symbol("dase_create_engine"));
+        destroy_engine = reinterpret_cast<DestroyEngineFunc>(library.symbol("dase_destroy_engine"));
+
+        // Try Phase 4C first, then Phase 4B, then generic optimized
+        for (const char* name : {"dase_run_mission_optimized_phase4c",
+                                 "dase_run_mission_optimized_phase4b",
+                                 "dase_run_mission_optimized"}) {
+            run_mission = reinterpret_cast<RunMissionFunc>(library.symbol(name));
+            if (run_mission) break;
+        }
+        get_metrics = reinterpret_cast<GetMetricsFunc>(library.symbol("dase_get_metrics"));
+
+        if (!create_engine || !destroy_engine || !run_mission || !get_metrics) {
+            error = library_path + " does not export the DASE C API (dase_create_engine, "
+                    "dase_destroy_engine, dase_run_mission_optimized_phase4c, dase_get_metrics)";
+            library.close();
+            return false;
+        }
+        path = library_path;
+        return true;
+    }
+
+    void* create(EngineInstance&, const EngineCreateParams& params) const override {
+        return create_engine(static_cast<uint32_t>(params.num_nodes));
+    }
+
+    void destroy(void* handle) const override { destroy_engine(handle); }
+
+    bool run(void* handle, int num_steps, const double* input, const double* control,
+             int iterations_per_node) const override {
+        if (iterations_per_node <= 0) {
+            return false;
+        }
+        run_mission(handle, input, control, static_cast<uint64_t>(num_steps),
+                    static_cast<uint32_t>(iterations_per_node));
+        return true;
+    }
+
+    void metrics(void* handle, EngineManager::EngineMetrics& out) const override {
+        get_metrics(handle, &out.ns_per_op, &out.ops_per_sec, &out.speedup_factor, &out.total_operations);
+    }
+
+    std::string origin() const override { return path; }
+
+private:
+    SharedLibrary library;
+    std::string path;
+    CreateEngineFunc create_engine = nullptr;
+    DestroyEngineFunc destroy_engine = nullptr;
+    RunMissionFunc run_mission = nullptr;
+    GetMetricsFunc get_metrics = nullptr;
+};
+
+} // namespace
+
+EngineRegistry::EngineRegistry() {
+    add("igsoa_complex", std::make_unique<Igsoa1DBackend>());
+    add("igsoa_complex_2d", std::make_unique<Igsoa2DBackend>());
+    add("igsoa_complex_3d", std::make_unique<Igsoa3DBackend>());
+    add("igsoa_ensemble_2d", std::make_unique<IgsoaEnsembleBackend>());
+    add("satp_higgs_1d", std::make_unique<Satp1DBackend>());
+    add("satp_higgs_2d", std::make_unique<Satp2DBackend>());
+    add("satp_higgs_3d", std::make_unique<Satp3DBackend>());
+
+#ifdef DASE_CLI_STATIC_PHASE4B
+    add("phase4b", std::make_unique<Phase4BBackend>());
+#else
+    // Historical plugin locations; phase4b stays unavailable if none loads
+#ifdef _WIN32
+    const char* const candidates[] = {"dase_engine_phase4b.dll", "dase_engine.dll"};
+#else
+    const char* const candidates[] = {"libdase_engine_phase4b.so", "libdase_engine.so"};
+#endif
+    std::string error;
+    for (const char* candidate : candidates) {
+        if (loadPlugin("phase4b", candidate, error)) break;
+    }
+#endif
+}
+
+EngineRegistry::~EngineRegistry() = default;
+
+void EngineRegistry::add(const std::string& type, std::unique_ptr<EngineBackend> backend) {
+    auto it = backends.find(type);
+    if (it != backends.end()) {
+        retired.push_back(std::move(it->second));
+        it->second = std::move(backend);
+    } else {
+        backends.emplace(type, std::move(backend));
+    }
+}
+
+const EngineBackend* EngineRegistry::find(const std::string& type) const {
+    auto it = backends.find(type);
+    return it != backends.end() ? it->second.get() : nullptr;
+}
+
+std::vector<std::string> EngineRegistry::types() const {
+    std::vector<std::string> names;
+    for (const auto& pair : backends) {
+        names.push_back(pair.first);
+    }
+    return names;
+}
+
+bool EngineRegistry::loadPlugin(const std::string& type, const std::string& path, std::string& error) {
+    auto plugin = std::make_unique<PluginBackend>();
+    if (!plugin->load(path, error)) {
+        return false;
+    }
+    add(type, std::move(plugin));
+    return true;
+}
@@ -0,0 +1,109 @@
+/**
+ * Engine Registry - Engine types behind one interface
+ *
+ * Every engine type that create_engine accepts is an EngineBackend
+ * registered under its type name. The built-in backends wrap engines
+ * compiled into dase_cli: the IGSOA and SATP+Higgs lattices, and the
+ * Phase 4B analog engine when the build sets DASE_CLI_STATIC_PHASE4B. So
+ * EngineManager creates, runs, measures and destroys them with direct
+ * calls on every platform, without a DLL search at startup.
+ *
+ * A shared library exporting the DASE C API (dase_capi.h) can still be
+ * loaded as a plugin with loadPlugin(), for instance a Phase 4B build
+ * tuned for another machine. It replaces the backend registered under the
+ * same type. Without the static Phase 4B engine, the registry tries the
+ * historical library names (dase_engine_phase4b, dase_engine) once at
+ * construction.
+ *
+ * Engine-specific operations (profiles, state extraction, diagnostics)
+ * stay in EngineManager, keyed by EngineInstance::engine_type.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "engine_manager.h"
+
+// Validated create_engine parameters
+struct EngineCreateParams {
+    int num_nodes = 0;
+    double R_c = 1.0;
+    double kappa = 1.0;
+    double gamma = 0.1;
+    double dt = 0.01;
+    int N_x = 0;
+    int N_y = 0;
+    int N_z = 0;
+    dase::igsoa::IGSOACouplingMode coupling = dase::igsoa::IGSOACouplingMode::Direct;
+    bool use_float = false;   // precision "float32"
+    dase::igsoa::IGSOAIntegrator integrator = dase::igsoa::IGSOAIntegrator::Euler;   // integrator (IGSOA)
+};
+
+class EngineBackend {
+public:
+    virtual ~EngineBackend() = default;
+
+    // New engine for instance, or nullptr if the parameters don't fit this
+    // type. Lattice engines set instance.num_nodes to the lattice size.
+    virtual void* create(EngineInstance& instance, const EngineCreateParams& params) const = 0;
+    virtual void destroy(void* handle) const = 0;
+
+    // Memory admission (EngineManager): bytes an engine created from params
+    // holds once its missions have built their caches, estimated before
+    // create; 0 if unknown (the engine is admitted without a reservation).
+    // float32 precision raises the estimate: its working planes are held
+    // next to the double state, never instead of it
+    virtual size_t estimateBytes(const EngineCreateParams& /*params*/) const { return 0; }
+
+    // Engine pool (EngineManager): bytes a destroyed engine keeps allocated
+    // while parked for reuse, or 0 if this type is never pooled
+    virtual size_t reusableBytes(void* /*handle*/) const { return 0; }
+
+    // Turn a parked engine into a new one for params in place (as if from
+    // create); false if it cannot take them, e.g. different lattice extents
+    virtual bool reinit(void* /*handle*/, EngineInstance& /*instance*/, const EngineCreateParams& /*params*/) const {
+        return false;
+    }
+
+    // Advance num_steps steps; input/control hold one value per step
+    // (engines without a drive ignore them)
+    virtual bool run(void* handle, int num_steps, const double* input, const double* control,
+                     int iterations_per_node) const = 0;
+
+    // Fill the fields this engine reports; the rest keep their defaults
+    virtual void metrics(void* handle, EngineManager::EngineMetrics& out) const = 0;
+
+    // Scalar per-node state (Phase 4B). Engines without one accept writes
+    // as a no-op and read 0.
+    virtual bool setNodeValue(void* /*handle*/, int /*node_index*/, double /*value*/) const { return true; }
+    virtual bool getNodeValue(void* /*handle*/, int /*node_index*/, double& /*value*/) const { return false; }
+
+    // "static" for a compiled-in engine, otherwise the plugin path
+    virtual std::string origin() const { return "static"; }
+};
+
+class EngineRegistry {
+public:
+    EngineRegistry();
+    ~EngineRegistry();
+
+    EngineRegistry(const EngineRegistry&) = delete;
+    EngineRegistry& operator=(const EngineRegistry&) = delete;
+
+    // Register (or replace) the backend of type. Engines created by a
+    // replaced backend keep using it, so it stays alive.
+    void add(const std::string& type, std::unique_ptr<EngineBackend> backend);
+
+    const EngineBackend* find(const std::string& type) const;
+    std::vector<std::string> types() const;
+
+    // Load a shared library with the DASE C API as the backend of type
+    bool loadPlugin(const std::string& type, const std::string& path, std::string& error);
+
+private:
+    std::map<std::string, std::unique_ptr<EngineBackend>> backends;
+    std::vector<std::unique_ptr<EngineBackend>> retired;
+};
@@ -3,8 +3,12 @@
  * Main entry point for command-line JSON-based engine control
  */
 
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 #include <io.h>
@@ -12,10 +16,33 @@
 #endif
 
 #include "json.hpp"
+#include "command_reader.h"
 #include "command_router.h"
+#include "daemon_server.h"
+#include "../../src/cpp/memory_admission.h"
 
 using json = nlohmann::json;
 
+namespace {
+
+// Async mission completions are written from worker threads
+std::mutex g_output_mutex;
+
+// Response stream on stdout; std::cout itself is pointed at stderr so
+// progress output from statically linked engines can't corrupt the stream
+std::ostream* g_responses = &std::cout;
+
+// flush = false leaves the line in the stdout buffer (--buffered mode)
+void writeResponse(const json& response, bool flush = true) {
+    std::lock_guard<std::mutex> lock(g_output_mutex);
+    *g_responses << response.dump() << '\n';
+    if (flush) {
+        g_responses->flush();
+    }
+}
+
+} // namespace
+
 int main(int argc, char** argv) {
     try {
         // Handle --describe flag for engine introspection
@@ -37,50 +64,124 @@ int main(int argc, char** argv) {
         _setmode(_fileno(stdout), _O_BINARY);
         #endif
 
-        // Disable cout buffering for immediate output
-        std::cout.setf(std::ios::unitbuf);
-
-        // Create command router
-        CommandRouter router;
-
-        // Read JSON commands from stdin line-by-line
-        std::string line;
-        while (std::getline(std::cin, line)) {
-            // Skip empty lines
-            if (line.empty() || line == "\n" || line == "\r\n") {
-                continue;
+        // Worker pool options for async run_mission, and stream options:
+        //   --buffered  flush stdout once per burst of input instead of per response
+        //   --pipeline  parse the next command on a reader thread while one executes
+        //   --engine-plugin type=path  load a DASE C API library as engine type
+        //   --listen path  serve clients on a Unix domain socket instead of stdin
+        //   --memory-budget-mb N  admit engines only while their footprints fit in N MB
+        MissionScheduler::Options scheduler_options;
+        std::string listen_path;
+        bool buffered = false;
+        bool pipelined = false;
+        std::vector<std::pair<std::string, std::string>> plugins;
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--workers" && i + 1 < argc) {
+                scheduler_options.workers = std::atoi(argv[++i]);
+            } else if (arg == "--threads-per-worker" && i + 1 < argc) {
+                scheduler_options.threads_per_worker = std::atoi(argv[++i]);
+            } else if (arg == "--pin-workers") {
+                scheduler_options.pin_workers = true;
+            } else if (arg == "--buffered") {
+                buffered = true;
+            } else if (arg == "--pipeline") {
+                pipelined = true;
+            } else if (arg == "--listen" && i + 1 < argc) {
+                listen_path = argv[++i];
+            } else if (arg == "--engine-plugin" && i + 1 < argc) {
+                const std::string spec = argv[++i];
+                const size_t eq = spec.find('=');
+                if (eq == std::string::npos || eq == 0 || eq + 1 == spec.size()) {
+                    std::cerr << "FATAL: --engine-plugin expects type=path" << std::endl;
+                    return 1;
+                }
+                plugins.emplace_back(spec.substr(0, eq), spec.substr(eq + 1));
+            } else if (arg == "--memory-budget-mb" && i + 1 < argc) {
+                const double budget_mb = std::atof(argv[++i]);
+                if (!(budget_mb >= 0.0)) {
+                    std::cerr << "FATAL: --memory-budget-mb expects a number >= 0" << std::endl;
+                    return 1;
+                }
+                dase::MemoryAdmission::instance().setBudget(static_cast<size_t>(budget_mb * 1048576.0));
             }
+        }
 
-            try {
-                // Parse JSON command
-                json command = json::parse(line);
+        if (!listen_path.empty()) {
+            // Daemon: engines persist across clients; stdout is unused
+            std::cout.rdbuf(std::cerr.rdbuf());
+            DaemonServer::Options daemon_options;
+            daemon_options.socket_path = listen_path;
+            daemon_options.scheduler = scheduler_options;
+            daemon_options.plugins = plugins;
+            DaemonServer server(daemon_options);
+            std::string error;
+            if (!server.start(error)) {
+                std::cerr << "FATAL: " << error << std::endl;
+                return 1;
+            }
+            std::cerr << "dase_cli listening on " << listen_path << std::endl;
+            server.run();
+            return 0;
+        }
 
-                // Execute command
-                json response = router.execute(command);
+        if (buffered) {
+            // Gives std::cin its own buffer, so a burst of waiting commands is
+            // visible to CommandReader::inputPending()
+            std::ios::sync_with_stdio(false);
+        }
+        static std::ostream responses(std::cout.rdbuf());
+        std::cout.rdbuf(std::cerr.rdbuf());
+        g_responses = &responses;
+        if (!buffered) {
+            // Disable response buffering for immediate output
+            responses.setf(std::ios::unitbuf);
+        }
 
-                // Output JSON response
-                std::cout << response.dump() << std::endl;
+        // Create command router (async completions are always flushed)
+        CommandRouter router;
+        router.configureScheduler(scheduler_options, [](const json& response) { writeResponse(response); });
+        for (const auto& plugin : plugins) {
+            std::string error;
+            if (!router.loadEnginePlugin(plugin.first, plugin.second, error)) {
+                std::cerr << "FATAL: " << error << std::endl;
+                return 1;
+            }
+        }
 
-            } catch (const json::parse_error& e) {
+        // Read JSON commands from stdin line-by-line
+        CommandReader reader(std::cin, pipelined);
+        CommandReader::Item item;
+        while (reader.next(item)) {
+            json response;
+            if (!item.parse_error.empty()) {
                 // JSON parsing error
-                json error_response = {
+                response = {
                     {"status", "error"},
-                    {"error", std::string("JSON parse error: ") + e.what()},
+                    {"error", "JSON parse error: " + item.parse_error},
                     {"error_code", "PARSE_ERROR"}
                 };
-                std::cout << error_response.dump() << std::endl;
-
-            } catch (const std::exception& e) {
-                // Other error
-                json error_response = {
-                    {"status", "error"},
-                    {"error", e.what()},
-                    {"error_code", "INTERNAL_ERROR"}
-                };
-                std::cout << error_response.dump() << std::endl;
+            } else {
+                try {
+                    response = router.execute(item.command);
+                } catch (const std::exception& e) {
+                    // Other error
+                    response = {
+                        {"status", "error"},
+                        {"error", e.what()},
+                        {"error_code", "INTERNAL_ERROR"}
+                    };
+                }
             }
+
+            // Buffered: flush when no further command is waiting
+            writeResponse(response, !buffered || !reader.inputPending());
         }
 
+        // Let queued async missions finish and report before exiting
+        router.waitForJobs();
+        responses.flush();
+
         return 0;
 
     } catch (const std::exception& e) {
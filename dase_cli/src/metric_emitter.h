@@ -3,12 +3,42 @@
  *
  * Emits metrics in format: METRIC:{"name":"...", "value":..., "units":"..."}
  * which the backend can parse and stream to the frontend via WebSocket.
+ *
+ * emitMetric() writes and flushes one line per call. For per-step output
+ * use a MetricStream, which appends samples to a preallocated buffer and
+ * writes it out when it fills or the flush interval elapses:
+ *
+ *   MetricStream stream;                       // NDJSON batches on stdout
+ *   auto energy = stream.channel("total_energy", "J");
+ *   stream.setDecimation(energy, 10);          // keep every 10th sample
+ *   for (...) stream.record(energy, E, step);
+ *   stream.flush();                            // also done on destruction
+ *
+ * Output formats (MetricFormat):
+ *   Lines        METRIC:{"name":..,"value":..,"units":..,"step":..} per sample
+ *   NDJSONBatch  METRICS:[{...},{...}] - one line per flush
+ *   Binary       frames for a file or pipe sink (not the stdout protocol):
+ *                  char[4] "DMB1", u32 payload_bytes, u32 num_defs, u32 num_samples
+ *                  num_defs    x {u32 id, u16 name_len, name, u16 units_len, units}
+ *                  num_samples x {u32 id, u32 reserved, u64 step, f64 value}
+ *                A channel's definition is sent in the first frame that
+ *                carries one of its samples. Integers and doubles are in
+ *                host byte order. payload_bytes excludes the 16-byte header.
  */
 
 #pragma once
 
-#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "json.hpp"
 
 using json = nlohmann::json;
@@ -55,20 +85,266 @@ inline void emitMetric(const std::string& name, const std::string& value) {
 }
 
 /**
- * Emit multiple metrics at once
+ * Emit multiple metrics at once (one write and one flush for the whole map)
  * @param metrics Map of name -> value
  * @param units Optional map of name -> units (defaults to "dimensionless")
  */
 inline void emitMetrics(const std::map<std::string, double>& metrics,
                        const std::map<std::string, std::string>& units = {}) {
+    std::string lines;
     for (const auto& [name, value] : metrics) {
         std::string unit = "dimensionless";
         auto unit_it = units.find(name);
         if (unit_it != units.end()) {
             unit = unit_it->second;
         }
-        emitMetric(name, value, unit);
+        json metric = {
+            {"name", name},
+            {"value", value},
+            {"units", unit}
+        };
+        lines += "METRIC:";
+        lines += metric.dump();
+        lines += '\n';
     }
+    std::cout << lines << std::flush;
 }
 
+enum class MetricFormat {
+    Lines,        // METRIC:{...} per sample (same lines as emitMetric)
+    NDJSONBatch,  // METRICS:[...] per flush
+    Binary        // DMB1 frames (see file header)
+};
+
+struct MetricStreamConfig {
+    MetricFormat format = MetricFormat::NDJSONBatch;
+    size_t buffer_bytes = 64 * 1024;   // Flush once the buffer holds this much
+    uint32_t flush_interval_ms = 100;  // Flush when this long since the last one (0: size only)
+    uint32_t decimation = 1;           // Default: keep every n-th sample of a channel
+};
+
+/**
+ * Buffered, decimated metric output
+ *
+ * Channels are registered once by name; record() through the returned id
+ * does no lookup and no allocation while the buffer has room. All methods
+ * are thread-safe.
+ */
+class MetricStream {
+public:
+    using ChannelId = uint32_t;
+
+    struct Stats {
+        uint64_t recorded = 0;   // record() calls
+        uint64_t emitted = 0;    // Samples written
+        uint64_t decimated = 0;  // Samples dropped by decimation
+        uint64_t flushes = 0;    // Writes to the sink
+        uint64_t bytes = 0;      // Bytes written
+    };
+
+    explicit MetricStream(const MetricStreamConfig& config = MetricStreamConfig(),
+                          std::ostream& out = std::cout)
+        : config_(config), out_(out), last_flush_(std::chrono::steady_clock::now()) {
+        if (config_.decimation == 0) config_.decimation = 1;
+        buffer_.reserve(config_.buffer_bytes + kRecordSlack);
+    }
+
+    ~MetricStream() { flush(); }
+
+    MetricStream(const MetricStream&) = delete;
+    MetricStream& operator=(const MetricStream&) = delete;
+
+    /**
+     * Id of the channel for name (registered with units on first use)
+     */
+    ChannelId channel(const std::string& name, const std::string& units = "dimensionless") {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return channelLocked(name, units);
+    }
+
+    /**
+     * Keep every n-th sample of a channel (1: all, 0 treated as 1)
+     */
+    void setDecimation(ChannelId id, uint32_t every_n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (id < channels_.size()) channels_[id].every = every_n > 0 ? every_n : 1;
+    }
+
+    void setDecimation(const std::string& name, uint32_t every_n) {
+        setDecimation(channel(name), every_n);
+    }
+
+    /**
+     * Queue one sample; returns false if decimation dropped it
+     */
+    bool record(ChannelId id, double value, uint64_t step = 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (id >= channels_.size()) return false;
+        return recordLocked(channels_[id], value, step);
+    }
+
+    bool record(const std::string& name, double value,
+                const std::string& units = "dimensionless", uint64_t step = 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return recordLocked(channels_[channelLocked(name, units)], value, step);
+    }
+
+    /**
+     * Write out everything queued so far
+     */
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushLocked();
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    const MetricStreamConfig& config() const { return config_; }
+
+private:
+    static constexpr size_t kRecordSlack = 512;  // Headroom so one record never reallocates
+
+    struct Channel {
+        std::string name;
+        std::string units;
+        std::string json_head;  // {"name":"...","value":
+        std::string json_tail;  // ,"units":"...","step":
+        uint32_t every = 1;
+        uint64_t seen = 0;
+        bool defined = false;   // Binary: definition already sent
+    };
+
+    ChannelId channelLocked(const std::string& name, const std::string& units) {
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+
+        Channel ch;
+        ch.name = name;
+        ch.units = units;
+        ch.json_head = "{\"name\":" + json(name).dump() + ",\"value\":";
+        ch.json_tail = ",\"units\":" + json(units).dump() + ",\"step\":";
+        ch.every = config_.decimation;
+        const ChannelId id = static_cast<ChannelId>(channels_.size());
+        channels_.push_back(std::move(ch));
+        ids_.emplace(name, id);
+        return id;
+    }
+
+    bool recordLocked(Channel& ch, double value, uint64_t step) {
+        stats_.recorded++;
+        if (ch.seen++ % ch.every != 0) {
+            stats_.decimated++;
+            return false;
+        }
+
+        const ChannelId id = static_cast<ChannelId>(&ch - channels_.data());
+        if (config_.format == MetricFormat::Binary) {
+            if (!ch.defined) {
+                appendDefinition(id, ch);
+                ch.defined = true;
+            }
+            appendPod(buffer_, id);
+            appendPod(buffer_, uint32_t(0));
+            appendPod(buffer_, step);
+            appendPod(buffer_, value);
+        } else {
+            if (config_.format == MetricFormat::Lines) {
+                buffer_ += "METRIC:";
+            } else {
+                buffer_ += pending_ == 0 ? "METRICS:[" : ",";
+            }
+            buffer_ += ch.json_head;
+            appendNumber(value);
+            buffer_ += ch.json_tail;
+            char digits[24];
+            const int n = std::snprintf(digits, sizeof(digits), "%llu", static_cast<unsigned long long>(step));
+            buffer_.append(digits, static_cast<size_t>(n));
+            buffer_ += '}';
+            if (config_.format == MetricFormat::Lines) buffer_ += '\n';
+        }
+        pending_++;
+
+        if (buffer_.size() + definitions_.size() >= config_.buffer_bytes || intervalElapsed()) {
+            flushLocked();
+        }
+        return true;
+    }
+
+    bool intervalElapsed() const {
+        if (config_.flush_interval_ms == 0) return false;
+        return std::chrono::steady_clock::now() - last_flush_ >=
+               std::chrono::milliseconds(config_.flush_interval_ms);
+    }
+
+    void flushLocked() {
+        last_flush_ = std::chrono::steady_clock::now();
+        if (pending_ == 0) return;
+
+        if (config_.format == MetricFormat::Binary) {
+            std::string header;
+            header.append("DMB1", 4);
+            appendPod(header, static_cast<uint32_t>(definitions_.size() + buffer_.size()));
+            appendPod(header, pending_definitions_);
+            appendPod(header, static_cast<uint32_t>(pending_));
+            out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+            out_.write(definitions_.data(), static_cast<std::streamsize>(definitions_.size()));
+            stats_.bytes += header.size() + definitions_.size();
+        } else if (config_.format == MetricFormat::NDJSONBatch) {
+            buffer_ += "]\n";
+        }
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        out_.flush();
+
+        stats_.bytes += buffer_.size();
+        stats_.emitted += pending_;
+        stats_.flushes++;
+        buffer_.clear();    // Capacity is kept
+        definitions_.clear();
+        pending_definitions_ = 0;
+        pending_ = 0;
+    }
+
+    void appendDefinition(ChannelId id, const Channel& ch) {
+        appendPod(definitions_, id);
+        appendPod(definitions_, static_cast<uint16_t>(ch.name.size()));
+        definitions_ += ch.name;
+        appendPod(definitions_, static_cast<uint16_t>(ch.units.size()));
+        definitions_ += ch.units;
+        pending_definitions_++;
+    }
+
+    // Round-trip decimal (%.17g); non-finite values as null (as nlohmann::json does)
+    void appendNumber(double value) {
+        if (!std::isfinite(value)) {
+            buffer_ += "null";
+            return;
+        }
+        char digits[32];
+        const int n = std::snprintf(digits, sizeof(digits), "%.17g", value);
+        buffer_.append(digits, static_cast<size_t>(n));
+    }
+
+    template<typename T>
+    static void appendPod(std::string& out, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    MetricStreamConfig config_;
+    std::ostream& out_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, ChannelId> ids_;
+    std::vector<Channel> channels_;
+    std::string buffer_;               // Samples (JSON text or binary records)
+    std::string definitions_;          // Binary: channel definitions of the next frame
+    uint32_t pending_definitions_ = 0;
+    uint64_t pending_ = 0;             // Samples in buffer_
+    std::chrono::steady_clock::time_point last_flush_;
+    Stats stats_;
+};
+
 } // namespace dase
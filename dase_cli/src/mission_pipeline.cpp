@@ -0,0 +1,198 @@
+/**
+ * Mission Pipeline Implementation
+ */
+
+#include "mission_pipeline.h"
+#include "engine_fft_analysis.h"
+#include "../../src/cpp/lattice_diagnostics.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+using json = nlohmann::json;
+
+MissionPipeline::MissionPipeline(const PipelineAnalysis& analysis, int analysis_threads, ResultCallback on_result)
+    : analysis_(analysis)
+    , on_result_(std::move(on_result)) {
+    const int threads = std::max(1, analysis_threads);
+    for (int i = 0; i <= threads; i++) {
+        slots_.push_back(std::make_unique<Slot>());
+    }
+    for (int i = 0; i < threads; i++) {
+        workers_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+MissionPipeline::~MissionPipeline() {
+    finish();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+PipelineSnapshot& MissionPipeline::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (filling_) {
+        return filling_->snapshot;
+    }
+
+    auto free_slot = [this]() {
+        for (auto& slot : slots_) {
+            if (slot->state == SlotState::Free) return slot.get();
+        }
+        return static_cast<Slot*>(nullptr);
+    };
+    Slot* slot = free_slot();
+    if (!slot) {
+        const auto start = std::chrono::steady_clock::now();
+        slot_free_.wait(lock, [&]() { return (slot = free_slot()) != nullptr; });
+        stall_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    slot->state = SlotState::Filling;
+    filling_ = slot;
+    return slot->snapshot;
+}
+
+void MissionPipeline::submit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!filling_) return;
+        filling_->state = SlotState::Queued;
+        queue_.push_back(filling_);
+        filling_ = nullptr;
+        in_flight_++;
+    }
+    work_ready_.notify_one();
+}
+
+void MissionPipeline::finish() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    slot_free_.wait(lock, [this]() { return in_flight_ == 0; });
+}
+
+uint64_t MissionPipeline::analyzedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return analyzed_;
+}
+
+double MissionPipeline::analysisMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return analysis_ms_;
+}
+
+void MissionPipeline::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_ready_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;  // Stopping and drained
+        }
+        Slot* slot = queue_.front();
+        queue_.pop_front();
+        slot->state = SlotState::Analyzing;
+        lock.unlock();
+
+        // The engine thread only writes Free / Filling slots
+        json result = analyze(analysis_, slot->snapshot);
+        if (on_result_) {
+            on_result_(result);
+        }
+
+        lock.lock();
+        analysis_ms_ += result.value("analysis_ms", 0.0);
+        analyzed_++;
+        slot->state = SlotState::Free;
+        in_flight_--;
+        slot_free_.notify_all();
+    }
+}
+
+json MissionPipeline::analyze(const PipelineAnalysis& analysis, const PipelineSnapshot& snapshot) {
+    const auto start = std::chrono::steady_clock::now();
+    json result = {{"timestep", snapshot.timestep}};
+    const size_t N = snapshot.psi_real.size();
+
+    if (!analysis.fft_fields.empty()) {
+        json spectra = json::object();
+        for (const std::string& field : analysis.fft_fields) {
+            const std::vector<double>* data = field == "psi_real" ? &snapshot.psi_real
+                                            : field == "psi_imag" ? &snapshot.psi_imag
+                                            : field == "phi" ? &snapshot.phi : nullptr;
+            if (!data) {
+                spectra[field] = {{"error", "Field not found: " + field}};
+                continue;
+            }
+            try {
+                using dase::analysis::EngineFFTAnalysis;
+                const dase::analysis::FFTResult fft =
+                    analysis.N_z > 1 ? EngineFFTAnalysis::compute3DFFT(*data, analysis.N_x, analysis.N_y, analysis.N_z, field)
+                  : analysis.N_y > 1 ? EngineFFTAnalysis::compute2DFFT(*data, analysis.N_x, analysis.N_y, field)
+                                     : EngineFFTAnalysis::compute1DFFT(*data, field);
+                spectra[field] = EngineFFTAnalysis::toJSON(fft);
+            } catch (const std::exception& e) {
+                spectra[field] = {{"error", std::string("FFT failed: ") + e.what()}};
+            }
+        }
+        result["fft"] = spectra;
+    }
+
+    if ((analysis.energy || analysis.center_of_mass) && N > 0) {
+        // One pass over F = |ψ|², as IGSOADiagnosticsPass on the live lattice
+        dase::CircularAxis axis_x, axis_y, axis_z;
+        if (analysis.center_of_mass) {
+            axis_x.build(analysis.N_x);
+            axis_y.build(analysis.N_y);
+            axis_z.build(analysis.N_z);
+        }
+        const double* re = snapshot.psi_real.data();
+        const double* im = snapshot.psi_imag.data();
+        const double* phi = snapshot.phi.data();
+        const size_t N_x = analysis.N_x;
+        double energy = 0.0, sum_F = 0.0;
+        double cx = 0.0, sx = 0.0, cy = 0.0, sy = 0.0, cz = 0.0, sz = 0.0;
+        for (size_t row = 0; row * N_x < N; row++) {
+            const size_t base = row * N_x;
+            double row_energy = 0.0, row_F = 0.0, row_cx = 0.0, row_sx = 0.0;
+            for (size_t x = 0; x < N_x; x++) {
+                const double F = re[base + x] * re[base + x] + im[base + x] * im[base + x];
+                row_energy += F + phi[base + x] * phi[base + x];
+                if (analysis.center_of_mass) {
+                    row_F += F;
+                    row_cx += F * axis_x.cosTable()[x];
+                    row_sx += F * axis_x.sinTable()[x];
+                }
+            }
+            energy += row_energy;
+            if (analysis.center_of_mass) {
+                const size_t y = row % analysis.N_y;
+                const size_t z = row / analysis.N_y;
+                sum_F += row_F;
+                cx += row_cx;
+                sx += row_sx;
+                cy += row_F * axis_y.cosTable()[y];
+                sy += row_F * axis_y.sinTable()[y];
+                cz += row_F * axis_z.cosTable()[z];
+                sz += row_F * axis_z.sinTable()[z];
+            }
+        }
+
+        json diagnostics = json::object();
+        if (analysis.energy) {
+            diagnostics["total_energy"] = energy;
+        }
+        if (analysis.center_of_mass && sum_F > 0.0) {
+            diagnostics["x_cm"] = dase::circularCenter(cx, sx, analysis.N_x);
+            if (analysis.N_y > 1) diagnostics["y_cm"] = dase::circularCenter(cy, sy, analysis.N_y);
+            if (analysis.N_z > 1) diagnostics["z_cm"] = dase::circularCenter(cz, sz, analysis.N_z);
+        }
+        result["diagnostics"] = diagnostics;
+    }
+
+    result["analysis_ms"] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,104 @@
+/**
+ * Mission Pipeline - Overlaps engine stepping with snapshot analysis
+ *
+ * run_mission_pipelined advances the engine in snapshot_interval chunks.
+ * After each chunk the state is copied into a free snapshot slot and
+ * queued for an analysis thread, and the engine starts the next chunk
+ * right away. The analysis of snapshot k (EngineFFTAnalysis spectra and
+ * energy / center-of-mass sums) therefore runs while the engine computes
+ * snapshot k+1:
+ *
+ *   engine    | chunk 1 | chunk 2 | chunk 3 | ...
+ *   analysis            | snap 1  | snap 2  | snap 3
+ *
+ * There are analysis_threads + 1 slots (double-buffering for a single
+ * thread). acquire() only blocks when every slot is still being analysed,
+ * i.e. when analysis is slower than stepping; stallMs() reports that wait.
+ * Results are passed to the callback from the analysis threads as each
+ * snapshot finishes, so with several threads they may arrive out of
+ * timestep order.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "json.hpp"
+
+struct PipelineSnapshot {
+    int64_t timestep = 0;
+    std::vector<double> psi_real;
+    std::vector<double> psi_imag;
+    std::vector<double> phi;
+};
+
+struct PipelineAnalysis {
+    std::vector<std::string> fft_fields;   // Any of psi_real, psi_imag, phi
+    bool energy = false;                   // Σ |ψ|² + Φ²
+    bool center_of_mass = false;           // Circular mean of |ψ|² per torus axis
+    size_t N_x = 0;                        // Row-major lattice shape (1 for unused axes)
+    size_t N_y = 1;
+    size_t N_z = 1;
+};
+
+class MissionPipeline {
+public:
+    using ResultCallback = std::function<void(const nlohmann::json&)>;
+
+    // Start analysis_threads (>= 1) workers; on_result must be thread-safe
+    MissionPipeline(const PipelineAnalysis& analysis, int analysis_threads, ResultCallback on_result);
+    ~MissionPipeline();
+
+    MissionPipeline(const MissionPipeline&) = delete;
+    MissionPipeline& operator=(const MissionPipeline&) = delete;
+
+    // Free slot for the next snapshot; blocks while every slot is queued or in analysis
+    PipelineSnapshot& acquire();
+
+    // Queue the acquired slot for analysis
+    void submit();
+
+    // Wait until every submitted snapshot has been analysed and reported
+    void finish();
+
+    // Analysis of one snapshot (what the workers report, plus "analysis_ms")
+    static nlohmann::json analyze(const PipelineAnalysis& analysis, const PipelineSnapshot& snapshot);
+
+    size_t slotCount() const { return slots_.size(); }
+    uint64_t analyzedCount() const;
+    double stallMs() const { return stall_ms_; }   // Engine thread waiting in acquire()
+    double analysisMs() const;                      // Summed over analysis threads
+
+private:
+    enum class SlotState { Free, Filling, Queued, Analyzing };
+
+    struct Slot {
+        PipelineSnapshot snapshot;
+        SlotState state = SlotState::Free;
+    };
+
+    PipelineAnalysis analysis_;
+    ResultCallback on_result_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable slot_free_;
+    std::deque<Slot*> queue_;
+    Slot* filling_ = nullptr;
+    size_t in_flight_ = 0;
+    bool stopping_ = false;
+    uint64_t analyzed_ = 0;
+    double analysis_ms_ = 0.0;
+    double stall_ms_ = 0.0;
+
+    void workerLoop();
+};
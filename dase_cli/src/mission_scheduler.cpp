@@ -0,0 +1,321 @@
+/**
+ * Mission Scheduler Implementation
+ */
+
+#include "mission_scheduler.h"
+#include "engine_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+double currentTimestamp() {
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return static_cast<double>(millis) / 1000.0;
+}
+
+int hardwareThreads() {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+} // namespace
+
+MissionScheduler::MissionScheduler(EngineManager* manager, const Options& opts, ResponseCallback callback)
+    : engine_manager(manager)
+    , on_complete(std::move(callback))
+    , options(opts)
+    , default_threads(1)
+    , unfinished_jobs(0)
+    , next_job_id(1)
+    , stopping(false) {
+
+    const int cores = hardwareThreads();
+    const int worker_count = options.workers > 0 ? options.workers : cores;
+    default_threads = options.threads_per_worker > 0
+        ? options.threads_per_worker
+        : std::max(1, cores / worker_count);
+
+    workers.reserve(worker_count);
+    for (int w = 0; w < worker_count; w++) {
+        workers.emplace_back([this, w]() { workerLoop(w); });
+    }
+}
+
+MissionScheduler::~MissionScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (auto& pair : jobs) {
+            pair.second->cancel_requested = true;
+        }
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::string MissionScheduler::submit(EngineInstance* instance,
+                                     const std::string& engine_id,
+                                     int num_steps,
+                                     int iterations_per_node,
+                                     int chunk_steps,
+                                     int threads,
+                                     const json& request_id) {
+    auto job = std::make_unique<MissionJob>();
+    job->engine_id = engine_id;
+    job->instance = instance;
+    job->request_id = request_id;
+    job->num_steps = num_steps;
+    job->iterations_per_node = iterations_per_node;
+    // Default: ~100 progress/cancellation points per mission
+    job->chunk_steps = chunk_steps > 0 ? chunk_steps : std::max(1, num_steps / 100);
+    job->threads = threads > 0 ? threads : default_threads;
+    job->submitted_timestamp = currentTimestamp();
+
+    std::string job_id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ostringstream oss;
+        oss << "job_" << std::setw(3) << std::setfill('0') << next_job_id++;
+        job_id = oss.str();
+        job->job_id = job_id;
+
+        queue.push_back(job.get());
+        reserved_engines[engine_id]++;
+        unfinished_jobs++;
+        jobs[job_id] = std::move(job);
+    }
+    work_available.notify_one();
+    return job_id;
+}
+
+bool MissionScheduler::cancel(const std::string& job_id) {
+    MissionJob* cancelled = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = jobs.find(job_id);
+        if (it == jobs.end()) {
+            return false;
+        }
+        MissionJob& job = *it->second;
+        if (job.state != "queued" && job.state != "running") {
+            return false;
+        }
+        job.cancel_requested = true;
+
+        // Queued jobs never start; running ones stop at the next chunk
+        auto queued = std::find(queue.begin(), queue.end(), &job);
+        if (queued == queue.end()) {
+            return true;
+        }
+        queue.erase(queued);
+        cancelled = &job;
+    }
+    finishJob(*cancelled, "cancelled", "Mission cancelled before it started");
+    return true;
+}
+
+json MissionScheduler::jobStatus(const std::string& job_id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = jobs.find(job_id);
+    if (it == jobs.end()) {
+        return nullptr;
+    }
+    return describe(*it->second);
+}
+
+json MissionScheduler::listJobs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    json result = json::array();
+    for (const auto& pair : jobs) {
+        result.push_back(describe(*pair.second));
+    }
+    return result;
+}
+
+bool MissionScheduler::isEngineReserved(const std::string& engine_id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reserved_engines.count(engine_id) != 0;
+}
+
+void MissionScheduler::waitAll() {
+    std::unique_lock<std::mutex> lock(mutex);
+    job_finished.wait(lock, [this]() { return unfinished_jobs == 0; });
+}
+
+void MissionScheduler::workerLoop(int worker_index) {
+    pinCurrentThread(worker_index);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        // First queued job whose engine is idle (one mission per engine at a time)
+        auto runnable = queue.end();
+        work_available.wait(lock, [&]() {
+            runnable = std::find_if(queue.begin(), queue.end(), [this](const MissionJob* job) {
+                return running_engines.count(job->engine_id) == 0;
+            });
+            return stopping || runnable != queue.end();
+        });
+        if (stopping) {
+            return;
+        }
+
+        MissionJob& job = **runnable;
+        queue.erase(runnable);
+        running_engines.insert(job.engine_id);
+        job.state = "running";
+
+        lock.unlock();
+        runJob(job);
+        lock.lock();
+    }
+}
+
+void MissionScheduler::runJob(MissionJob& job) {
+#ifdef _OPENMP
+    omp_set_num_threads(job.threads);
+#endif
+
+    // Chunk k continues the input sequence at step_offset, so a chunked
+    // mission sees the same inputs as one runMission call
+    int done = 0;
+    while (done < job.num_steps) {
+        if (job.cancel_requested) {
+            finishJob(job, "cancelled", "Mission cancelled after " + std::to_string(done) + " steps");
+            return;
+        }
+        const int steps = std::min(job.chunk_steps, job.num_steps - done);
+        if (!engine_manager->runMission(*job.instance, steps, job.iterations_per_node, done)) {
+            finishJob(job, "failed", "Mission execution failed at step " + std::to_string(done));
+            return;
+        }
+        done += steps;
+        job.steps_completed = done;
+    }
+    finishJob(job, "completed", "");
+}
+
+void MissionScheduler::finishJob(MissionJob& job, const std::string& state, const std::string& error) {
+    json response;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job.state = state;
+        job.error = error;
+        running_engines.erase(job.engine_id);
+        auto reserved = reserved_engines.find(job.engine_id);
+        if (reserved != reserved_engines.end() && --reserved->second == 0) {
+            reserved_engines.erase(reserved);
+        }
+
+        const int steps = job.steps_completed;
+        if (state == "completed") {
+            response = {
+                {"status", "success"},
+                {"command", "run_mission"},
+                {"result", {
+                    {"job_id", job.job_id},
+                    {"engine_id", job.engine_id},
+                    {"steps_completed", steps},
+                    {"total_operations", static_cast<double>(steps) * job.iterations_per_node * 1024}
+                }}
+            };
+        } else {
+            response = {
+                {"status", "error"},
+                {"command", "run_mission"},
+                {"error", error},
+                {"error_code", state == "cancelled" ? "JOB_CANCELLED" : "EXECUTION_FAILED"},
+                {"job_id", job.job_id},
+                {"steps_completed", steps}
+            };
+        }
+        response["execution_time_ms"] = (currentTimestamp() - job.submitted_timestamp) * 1000.0;
+        if (!job.request_id.is_null()) {
+            response["request_id"] = job.request_id;
+        }
+    }
+
+    // The engine is free before the client hears about it
+    work_available.notify_all();
+    if (on_complete) {
+        on_complete(response);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        unfinished_jobs--;
+    }
+    job_finished.notify_all();
+}
+
+json MissionScheduler::describe(const MissionJob& job) const {
+    json result = {
+        {"job_id", job.job_id},
+        {"engine_id", job.engine_id},
+        {"state", job.state},
+        {"num_steps", job.num_steps},
+        {"steps_completed", job.steps_completed.load()},
+        {"chunk_steps", job.chunk_steps},
+        {"threads", job.threads},
+        {"submitted_timestamp", job.submitted_timestamp}
+    };
+    if (!job.error.empty()) {
+        result["error"] = job.error;
+    }
+    if (!job.request_id.is_null()) {
+        result["request_id"] = job.request_id;
+    }
+    return result;
+}
+
+void MissionScheduler::pinCurrentThread(int worker_index) const {
+    if (!options.pin_workers) {
+        return;
+    }
+
+    // Worker w owns cores [w*T, (w+1)*T) modulo the core count, T = default threads.
+    // OpenMP teams forked from the worker inherit its mask on runtimes that
+    // create team threads from the forking thread (libgomp).
+    const int cores = hardwareThreads();
+    const int first = (worker_index * default_threads) % cores;
+
+#ifdef _WIN32
+    DWORD_PTR mask = 0;
+    for (int t = 0; t < default_threads; t++) {
+        const int core = (first + t) % cores;
+        if (core < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            mask |= static_cast<DWORD_PTR>(1) << core;
+        }
+    }
+    if (mask != 0) {
+        SetThreadAffinityMask(GetCurrentThread(), mask);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int t = 0; t < default_threads; t++) {
+        CPU_SET((first + t) % cores, &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)first;
+#endif
+}
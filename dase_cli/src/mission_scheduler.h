@@ -0,0 +1,130 @@
+/**
+ * Mission Scheduler - Runs engine missions asynchronously on a worker pool
+ *
+ * Each job runs one engine's mission on a worker thread. Jobs for the same
+ * engine run one at a time in submission order; jobs for different engines
+ * run concurrently. Missions advance in chunks so progress is visible to
+ * get_job_status and cancel_job takes effect at the next chunk boundary.
+ * Completion responses are delivered through a callback, tagged with the
+ * request_id of the command that submitted the job.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "json.hpp"
+
+// Forward declarations
+class EngineManager;
+struct EngineInstance;
+
+using json = nlohmann::json;
+
+// One submitted mission
+struct MissionJob {
+    std::string job_id;
+    std::string engine_id;
+    EngineInstance* instance;   // Resolved at submission; engine is reserved until the job ends
+    json request_id;            // Echoed on the completion response (null if untagged)
+    int num_steps;
+    int iterations_per_node;
+    int chunk_steps;            // Steps per runMission call (cancellation granularity)
+    int threads;                // OpenMP threads for this mission
+    double submitted_timestamp;
+
+    std::string state;          // "queued", "running", "completed", "failed", "cancelled"
+    std::string error;
+    std::atomic<int> steps_completed;
+    std::atomic<bool> cancel_requested;
+
+    MissionJob()
+        : instance(nullptr)
+        , num_steps(0)
+        , iterations_per_node(0)
+        , chunk_steps(0)
+        , threads(1)
+        , submitted_timestamp(0)
+        , state("queued")
+        , steps_completed(0)
+        , cancel_requested(false) {}
+};
+
+class MissionScheduler {
+public:
+    struct Options {
+        int workers;             // Worker threads (0 = hardware concurrency)
+        int threads_per_worker;  // Default OpenMP threads per mission (0 = cores / workers)
+        bool pin_workers;        // Pin worker w to a contiguous block of cores
+
+        Options() : workers(0), threads_per_worker(0), pin_workers(false) {}
+    };
+
+    using ResponseCallback = std::function<void(const json&)>;
+
+    MissionScheduler(EngineManager* manager, const Options& options, ResponseCallback on_complete);
+    ~MissionScheduler();
+
+    MissionScheduler(const MissionScheduler&) = delete;
+    MissionScheduler& operator=(const MissionScheduler&) = delete;
+
+    // Queue a mission; returns the job id (chunk_steps/threads <= 0 pick defaults)
+    std::string submit(EngineInstance* instance,
+                       const std::string& engine_id,
+                       int num_steps,
+                       int iterations_per_node,
+                       int chunk_steps,
+                       int threads,
+                       const json& request_id);
+
+    // Request cancellation; false if the job is unknown or already finished
+    bool cancel(const std::string& job_id);
+
+    // Job description, or null if unknown
+    json jobStatus(const std::string& job_id) const;
+    json listJobs() const;
+
+    // True while a queued or running job holds the engine
+    bool isEngineReserved(const std::string& engine_id) const;
+
+    // Block until every submitted job has finished
+    void waitAll();
+
+    int workerCount() const { return static_cast<int>(workers.size()); }
+    int defaultThreads() const { return default_threads; }
+
+private:
+    void workerLoop(int worker_index);
+    void runJob(MissionJob& job);
+    void finishJob(MissionJob& job, const std::string& state, const std::string& error);
+    json describe(const MissionJob& job) const;
+    void pinCurrentThread(int worker_index) const;
+
+    EngineManager* engine_manager;
+    ResponseCallback on_complete;
+    Options options;
+    int default_threads;
+
+    mutable std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable job_finished;
+    std::deque<MissionJob*> queue;                                // Submission order
+    std::map<std::string, std::unique_ptr<MissionJob>> jobs;      // All jobs by id
+    std::map<std::string, int> reserved_engines;                  // engine_id -> unfinished jobs
+    std::set<std::string> running_engines;                        // Engines with a mission in progress
+    int unfinished_jobs;
+    int next_job_id;
+    bool stopping;
+
+    std::vector<std::thread> workers;
+};
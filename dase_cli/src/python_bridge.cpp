@@ -3,6 +3,7 @@
  */
 
 #include "python_bridge.h"
+#include "analysis_worker.h"
 #include <chrono>
 #include <filesystem>
 #include <fstream>
@@ -73,6 +74,54 @@ PythonAnalysisResult PythonBridge::runAnalysisScript(
     return result;
 }
 
+bool PythonBridge::runAnalysisInWorker(
+    AnalysisWorker& worker,
+    const nlohmann::json& state_descriptor,
+    const PythonAnalysisConfig& config,
+    PythonAnalysisResult& result
+) {
+    result.success = false;
+    result.exit_code = -1;
+    result.execution_time_ms = 0;
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    nlohmann::json request = {
+        {"op", "run"},
+        {"script", config.script_path},
+        {"argv", buildArgv(config)},
+        {"output_dir", config.output_dir},
+        {"state", state_descriptor}
+    };
+
+    nlohmann::json response;
+    std::string error;
+    if (!worker.call(request, response, config.timeout_ms, error)) {
+        result.error_message = error;
+        return false;
+    }
+    if (response.contains("error")) {
+        // Worker-side failure before the script ran (bad state file, unknown op)
+        result.error_message = response["error"].get<std::string>();
+        return false;
+    }
+
+    result.exit_code = response.value("exit_code", -1);
+    result.stdout_output = response.value("stdout", std::string());
+    result.stderr_output = response.value("stderr", std::string());
+    result.success = (result.exit_code == 0);
+
+    if (!config.output_dir.empty() && fs::exists(config.output_dir)) {
+        result.generated_files = findGeneratedFiles(config.output_dir);
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    result.execution_time_ms = duration.count() / 1000.0;
+
+    return true;
+}
+
 bool PythonBridge::checkDependencies(
     const std::string& python_exe,
     const std::vector<std::string>& required_packages
@@ -226,6 +275,21 @@ std::string PythonBridge::buildCommandLine(
     return cmd.str();
 }
 
+std::vector<std::string> PythonBridge::buildArgv(const PythonAnalysisConfig& config) {
+    std::vector<std::string> argv;
+    for (const auto& [key, value] : config.args) {
+        if (key == "positional") {
+            argv.push_back(value);
+        } else {
+            argv.push_back("--" + key);
+            if (!value.empty()) {
+                argv.push_back(value);
+            }
+        }
+    }
+    return argv;
+}
+
 std::vector<std::string> PythonBridge::findGeneratedFiles(
     const std::string& output_dir,
     const std::vector<std::string>& extensions
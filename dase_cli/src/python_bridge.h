@@ -18,6 +18,8 @@
 namespace dase {
 namespace python {
 
+class AnalysisWorker;
+
 struct PythonAnalysisConfig {
     std::string script_path;
     std::string python_executable = "python";
@@ -50,6 +52,23 @@ public:
         const PythonAnalysisConfig& config
     );
 
+    /**
+     * Run a Python analysis script in the persistent worker
+     *
+     * @param worker Running (or startable) analysis worker
+     * @param state_descriptor Binary state descriptor (AnalysisWorker::writeStateFile)
+     * @param config Python script configuration (python_executable is the worker's)
+     * @param result Script outcome (exit code, captured output, generated files)
+     * @return false if the worker could not run the request; the caller should
+     *         fall back to runAnalysisScript
+     */
+    static bool runAnalysisInWorker(
+        AnalysisWorker& worker,
+        const nlohmann::json& state_descriptor,
+        const PythonAnalysisConfig& config,
+        PythonAnalysisResult& result
+    );
+
     /**
      * Check if Python is available and has required packages
      *
@@ -99,6 +118,9 @@ private:
         const PythonAnalysisConfig& config
     );
 
+    // Script arguments in command-line order (positional and --key value)
+    static std::vector<std::string> buildArgv(const PythonAnalysisConfig& config);
+
     static std::vector<std::string> findGeneratedFiles(
         const std::string& output_dir,
         const std::vector<std::string>& extensions = {".png", ".pdf", ".svg", ".txt", ".json"}
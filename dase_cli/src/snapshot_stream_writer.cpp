@@ -0,0 +1,184 @@
+/**
+ * Snapshot Stream Writer Implementation
+ */
+
+#include "snapshot_stream_writer.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+void putU32(char* dst, uint32_t value) {
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+void putU64(char* dst, uint64_t value) {
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+template <typename T>
+void writeRaw(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // namespace
+
+SnapshotStreamWriter::~SnapshotStreamWriter() {
+    if (writer.joinable()) {
+        close();
+    }
+}
+
+bool SnapshotStreamWriter::open(const std::string& path, size_t nodes, const std::vector<uint64_t>& shape,
+                                const dase::SnapshotCodecOptions& codec) {
+    if (writer.joinable() || nodes == 0 || shape.empty() || shape.size() > 3) {
+        return false;
+    }
+    if (codec.codec == dase::SnapshotCodec::Quantized && !(codec.error_bound > 0.0)) {
+        return false;
+    }
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    file_path = path;
+    num_nodes = nodes;
+    codec_options = codec;
+
+    char header[kHeaderBytes] = {};
+    std::memcpy(header, "DASESNP1", 8);
+    putU32(header + 8, version());
+    putU32(header + 12, kNumFields);
+    putU64(header + 16, static_cast<uint64_t>(num_nodes));
+    putU32(header + 24, static_cast<uint32_t>(shape.size()));
+    putU32(header + 28, static_cast<uint32_t>(codec_options.codec));
+    for (size_t d = 0; d < shape.size(); d++) {
+        putU64(header + 32 + 8 * d, shape[d]);
+    }
+    std::memcpy(header + 56, &codec_options.error_bound, sizeof(double));
+    out.write(header, sizeof(header));
+    bytes_written = kHeaderBytes;
+    if (!out) {
+        return false;
+    }
+
+    for (auto& slot : slots) {
+        slot.psi_real.reserve(num_nodes);
+        slot.psi_imag.reserve(num_nodes);
+        slot.phi.reserve(num_nodes);
+    }
+
+    writer = std::thread([this]() { writerLoop(); });
+    return true;
+}
+
+SnapshotStreamWriter::Frame& SnapshotStreamWriter::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto start = std::chrono::steady_clock::now();
+    slot_free.wait(lock, [this]() { return !filled[produce_index]; });
+    stall_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return slots[produce_index];
+}
+
+bool SnapshotStreamWriter::commit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failed) {
+            return false;
+        }
+        filled[produce_index] = true;
+        produce_index ^= 1;
+    }
+    frame_ready.notify_one();
+    return true;
+}
+
+bool SnapshotStreamWriter::close() {
+    if (!writer.joinable()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    frame_ready.notify_one();
+    writer.join();
+
+    // Index, then footer pointing back at it
+    const uint64_t index_offset = bytes_written;
+    writeRaw(out, static_cast<uint64_t>(index.size()));
+    for (const auto& entry : index) {
+        writeRaw(out, entry.first);
+        writeRaw(out, entry.second);
+    }
+    writeRaw(out, index_offset);
+    out.write("DASEIDX1", 8);
+    bytes_written += sizeof(uint64_t) * (1 + 2 * index.size()) + 16;
+
+    out.close();
+    return !failed && !out.fail();
+}
+
+void SnapshotStreamWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        frame_ready.wait(lock, [this]() { return filled[consume_index] || closing; });
+        if (!filled[consume_index]) {
+            return;  // Closing and drained
+        }
+
+        // The producer only touches the other slot while this one is filled
+        const Frame& frame = slots[consume_index];
+        lock.unlock();
+        const bool ok = !failed && writeFrame(frame);
+        lock.lock();
+
+        if (!ok) {
+            failed = true;
+        }
+        filled[consume_index] = false;
+        consume_index ^= 1;
+        slot_free.notify_one();
+    }
+}
+
+bool SnapshotStreamWriter::writeFrame(const Frame& frame) {
+    if (frame.psi_real.size() != num_nodes ||
+        frame.psi_imag.size() != num_nodes ||
+        frame.phi.size() != num_nodes) {
+        return false;
+    }
+
+    const uint64_t frame_offset = bytes_written;
+    index.emplace_back(static_cast<uint64_t>(frame.timestep), frame_offset);
+
+    if (compressed()) {
+        const std::vector<uint8_t> fields[kNumFields] = {
+            dase::encodeSnapshotField(frame.psi_real.data(), num_nodes, codec_options),
+            dase::encodeSnapshotField(frame.psi_imag.data(), num_nodes, codec_options),
+            dase::encodeSnapshotField(frame.phi.data(), num_nodes, codec_options)
+        };
+        writeRaw(out, static_cast<uint64_t>(frame.timestep));
+        for (const auto& field : fields) {
+            writeRaw(out, static_cast<uint64_t>(field.size()));
+        }
+        bytes_written += sizeof(uint64_t) * (1 + kNumFields);
+        for (const auto& field : fields) {
+            out.write(reinterpret_cast<const char*>(field.data()), static_cast<std::streamsize>(field.size()));
+            bytes_written += field.size();
+        }
+        frame_data_bytes += bytes_written - frame_offset;
+        return static_cast<bool>(out);
+    }
+
+    const auto array_bytes = static_cast<std::streamsize>(num_nodes * sizeof(double));
+    writeRaw(out, static_cast<uint64_t>(frame.timestep));
+    out.write(reinterpret_cast<const char*>(frame.psi_real.data()), array_bytes);
+    out.write(reinterpret_cast<const char*>(frame.psi_imag.data()), array_bytes);
+    out.write(reinterpret_cast<const char*>(frame.phi.data()), array_bytes);
+    bytes_written += frameBytes();
+    frame_data_bytes += frameBytes();
+
+    return static_cast<bool>(out);
+}
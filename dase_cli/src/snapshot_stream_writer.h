@@ -0,0 +1,111 @@
+/**
+ * Snapshot Stream Writer - Streams mission snapshots to disk as they are taken
+ *
+ * Frames are written by a background thread from two swap buffers, so the
+ * mission only waits when the disk falls a full frame behind. The file is
+ * a fixed header, fixed-size frames, and a trailing frame index:
+ *
+ *   header  (64 bytes)  "DASESNP1", u32 version, u32 num_fields, u64 num_nodes,
+ *                       u32 ndim, u32 reserved, u64 shape[3], 8 bytes padding
+ *   frame k             u64 timestep, float64 psi_real[N], psi_imag[N], phi[N]
+ *   index               u64 frame_count, {u64 timestep, u64 offset} per frame
+ *   footer  (16 bytes)  u64 index_offset, "DASEIDX1"
+ *
+ * All integers and floats are little-endian. Frame k starts at
+ * header_bytes + k * frame_bytes, so a file cut short by a crash (no
+ * index) is still readable frame by frame.
+ *
+ * With a codec (snapshot_codec.h) the header's reserved word holds the
+ * codec id, its padding the f64 error bound, and the version is 2. Each
+ * field is then encoded on the writer thread, chunks in parallel:
+ *
+ *   frame k             u64 timestep, u64 field_bytes[3], encoded psi_real,
+ *                       psi_imag, phi
+ *
+ * Frames vary in size, so readers seek through the index (or walk the
+ * field_bytes of an unindexed file); a field's chunks decode independently
+ * for windowed playback.
+ */
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../src/cpp/snapshot_codec.h"
+
+class SnapshotStreamWriter {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kCompressedVersion = 2;
+    static constexpr uint32_t kNumFields = 3;
+    static constexpr uint64_t kHeaderBytes = 64;
+
+    struct Frame {
+        int64_t timestep = 0;
+        std::vector<double> psi_real;
+        std::vector<double> psi_imag;
+        std::vector<double> phi;
+    };
+
+    SnapshotStreamWriter() = default;
+    ~SnapshotStreamWriter();
+
+    SnapshotStreamWriter(const SnapshotStreamWriter&) = delete;
+    SnapshotStreamWriter& operator=(const SnapshotStreamWriter&) = delete;
+
+    // Create the file, write the header and start the writer thread
+    // (shape: up to 3 row-major extents whose product is num_nodes;
+    // codec Raw writes plain float64 frames)
+    bool open(const std::string& path, size_t num_nodes, const std::vector<uint64_t>& shape,
+              const dase::SnapshotCodecOptions& codec = {dase::SnapshotCodec::Raw});
+
+    // Free buffer for the next frame; blocks while both buffers are in flight
+    Frame& acquire();
+
+    // Queue the acquired frame; false once a write has failed
+    bool commit();
+
+    // Drain queued frames and write the index; false if any write failed
+    bool close();
+
+    const std::string& path() const { return file_path; }
+    uint32_t version() const { return compressed() ? kCompressedVersion : kVersion; }
+    bool compressed() const { return codec_options.codec != dase::SnapshotCodec::Raw; }
+    const dase::SnapshotCodecOptions& codec() const { return codec_options; }
+    // Uncompressed frame size (the on-disk size when codec is Raw)
+    uint64_t frameBytes() const { return sizeof(uint64_t) + kNumFields * num_nodes * sizeof(double); }
+    uint64_t framesWritten() const { return static_cast<uint64_t>(index.size()); }
+    uint64_t bytesWritten() const { return bytes_written; }
+    uint64_t frameDataBytes() const { return frame_data_bytes; }   // Frames only, as stored
+    double stallMs() const { return stall_ms; }
+
+private:
+    void writerLoop();
+    bool writeFrame(const Frame& frame);
+
+    std::string file_path;
+    std::ofstream out;
+    size_t num_nodes = 0;
+    dase::SnapshotCodecOptions codec_options{dase::SnapshotCodec::Raw};
+    uint64_t bytes_written = 0;
+    uint64_t frame_data_bytes = 0;
+    double stall_ms = 0.0;                             // Time acquire() spent waiting
+    std::vector<std::pair<uint64_t, uint64_t>> index;  // (timestep, offset); writer thread only
+
+    std::mutex mutex;
+    std::condition_variable frame_ready;
+    std::condition_variable slot_free;
+    std::array<Frame, 2> slots;
+    std::array<bool, 2> filled{{false, false}};
+    size_t produce_index = 0;
+    size_t consume_index = 0;
+    bool closing = false;
+    bool failed = false;
+    std::thread writer;
+};
@@ -9,8 +9,35 @@ import matplotlib.pyplot as plt
 import sys
 import os
 
+def load_waveform(filename, detector=0):
+    """
+    Load (time, h_plus, h_cross, amplitude) from a waveform CSV or a .gwf
+    stream (one detector of the array; see waveform_stream.h for the layout)
+    """
+    if not filename.endswith('.gwf'):
+        data = np.loadtxt(filename, delimiter=',', skiprows=1)
+        return data[:, 0], data[:, 1], data[:, 2], data[:, 3]
+
+    raw = np.fromfile(filename, dtype=np.uint8)
+    if raw[:8].tobytes() != b'DASEGWF1':
+        raise ValueError(f"Not a waveform file: {filename}")
+    num_detectors = int(raw[12:16].view('<u4')[0])
+    frame_count = int(raw[16:24].view('<u8')[0])
+    table_end = 64 + 48 * num_detectors
+    frame_values = 1 + 2 * num_detectors
+
+    # An unclosed file (frame_count 0) keeps every complete frame
+    available = (raw.size - table_end) // (8 * frame_values)
+    frames = min(frame_count, available) if frame_count > 0 else available
+    body = raw[table_end:table_end + 8 * frame_values * frames].view('<f8').reshape(frames, frame_values)
+
+    time = body[:, 0]
+    h_plus = body[:, 1 + detector]
+    h_cross = body[:, 1 + num_detectors + detector]
+    return time, h_plus, h_cross, np.sqrt(h_plus**2 + h_cross**2)
+
 def plot_waveform(filename):
-    """Plot waveform from CSV file"""
+    """Plot waveform from a CSV or .gwf file"""
 
     # Check if file exists
     if not os.path.exists(filename):
@@ -19,12 +46,7 @@ def plot_waveform(filename):
 
     # Load data
     print(f"Loading: {filename}")
-    data = np.loadtxt(filename, delimiter=',', skiprows=1)
-
-    time = data[:, 0]
-    h_plus = data[:, 1]
-    h_cross = data[:, 2]
-    amplitude = data[:, 3]
+    time, h_plus, h_cross, amplitude = load_waveform(filename)
 
     print(f"Data points: {len(time)}")
     print(f"Time range: {time[0]:.3f} to {time[-1]:.3f} seconds")
@@ -63,7 +85,7 @@ def plot_waveform(filename):
     plt.tight_layout()
 
     # Save figure
-    output_file = filename.replace('.csv', '.png')
+    output_file = os.path.splitext(filename)[0] + '.png'
     plt.savefig(output_file, dpi=300)
     print(f"Saved figure: {output_file}")
 
@@ -79,12 +101,11 @@ def compare_waveforms(filenames):
             print(f"Warning: File not found: {filename}")
             continue
 
-        data = np.loadtxt(filename, delimiter=',', skiprows=1)
-        time = data[:, 0] * 1000  # Convert to ms
-        h_plus = data[:, 1]
+        time, h_plus, _, _ = load_waveform(filename)
+        time = time * 1000  # Convert to ms
 
         # Extract alpha from filename
-        alpha = filename.split('alpha_')[1].split('.csv')[0]
+        alpha = os.path.splitext(filename.split('alpha_')[1])[0]
 
         ax.plot(time, h_plus, linewidth=1.5, label=f'α = {alpha}', alpha=0.8)
 
@@ -101,8 +122,8 @@ def compare_waveforms(filenames):
 
 if __name__ == '__main__':
     if len(sys.argv) < 2:
-        print("Usage: python plot_gw_waveform.py <waveform.csv> [<waveform2.csv> ...]")
-        print("Example: python plot_gw_waveform.py gw_waveform_alpha_1.5.csv")
+        print("Usage: python plot_gw_waveform.py <waveform.csv|.gwf> [<waveform2> ...]")
+        print("Example: python plot_gw_waveform.py gw_waveform_alpha_1.500000.gwf")
         sys.exit(1)
 
     if len(sys.argv) == 2:
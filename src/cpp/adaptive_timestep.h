@@ -0,0 +1,175 @@
+/**
+ * Adaptive Timestep - Error-Controlled Stepping to a Target Time
+ *
+ * runUntil(t_end) on the IGSOA and SATP+Higgs engines advances to t_end
+ * with step sizes chosen from a per-attempt error estimate rather than the
+ * fixed config dt. The fixed dt is only the first guess, so a mission is
+ * not held to the step size its stiffest moment needs:
+ *
+ *   IGSOA       step doubling: one step of h against two of h/2 from the
+ *               same state, err = max|Ψ_h - Ψ_h/2| / (1 + max|Ψ_h/2|)
+ *               (absolute for small Ψ, relative for large); the
+ *               two-half-step state is kept
+ *   SATP+Higgs  relative energy drift over a block of check_interval Verlet
+ *               steps, err = |E1 - E0 + damping loss| / max(|E0|, energy_floor);
+ *               h is also capped by the Verlet stability limit
+ *               (SATPHiggsParams::stableDt)
+ *
+ * AdaptiveStepController turns each estimate into accept/reject and the
+ * next size, h ← h·clamp(safety·(tolerance/err)^(1/(order+1)), shrink_min,
+ * grow_max), kept within [dt_min, dt_max]. Rejected attempts restore the
+ * saved state. An attempt at dt_min is accepted regardless, so a run
+ * always makes progress. The last attempt is shortened to land on t_end.
+ *
+ * Both engines step a first-order-accurate error model (Euler Ψ update,
+ * O(h²) Verlet energy error), hence order 1 and exponent 1/2; IGSOA
+ * engines with IGSOAIntegrator::RK4 pass order 4 (exponent 1/5).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace dase {
+
+struct AdaptiveStepConfig {
+    double tolerance = 1e-5;       // Error bound per attempt (IGSOA: scaled |ΔΨ|, SATP: relative energy)
+    double dt_initial = 0.0;       // First attempt (0: engine dt)
+    double dt_min = 0.0;           // Smallest step (0: dt_initial·1e-4)
+    double dt_max = 0.0;           // Largest step (0: dt_initial·1e3; SATP: also the stability limit)
+    double safety = 0.9;
+    double grow_max = 2.0;         // Largest growth per attempt
+    double shrink_min = 0.2;       // Strongest shrink per attempt
+    double stability_fraction = 0.9;  // SATP: share of the Verlet stability limit allowed
+    double energy_floor = 1e-12;   // SATP: energy scale below which drift is absolute
+    uint32_t check_interval = 8;   // SATP: Verlet steps per energy check
+    uint64_t max_attempts = 10000000;
+};
+
+struct AdaptiveRunStats {
+    uint64_t accepted = 0;    // Accepted attempts
+    uint64_t rejected = 0;    // Rejected (state restored) attempts
+    uint64_t steps = 0;       // Engine steps kept (IGSOA: 2 per attempt)
+    double dt_smallest = 0.0; // Range of accepted step sizes
+    double dt_largest = 0.0;
+    double dt_next = 0.0;     // Proposed size for a following run
+    double max_error = 0.0;   // Largest accepted error estimate
+    bool reached = false;     // Time reached t_end (false: max_attempts hit)
+};
+
+class AdaptiveStepController {
+public:
+    /**
+     * @param engine_dt Engine dt (first guess unless dt_initial is set)
+     * @param order Accuracy order of the error model (exponent 1/(order+1))
+     * @param dt_cap Extra upper bound on h (stability limit), inf for none
+     */
+    AdaptiveStepController(const AdaptiveStepConfig& config, double engine_dt, int order,
+                           double dt_cap = std::numeric_limits<double>::infinity())
+        : config_(config), exponent_(1.0 / (order + 1)) {
+        const double first = config.dt_initial > 0.0 ? config.dt_initial : engine_dt;
+        dt_min_ = config.dt_min > 0.0 ? config.dt_min : first * 1e-4;
+        dt_max_ = std::min(config.dt_max > 0.0 ? config.dt_max : first * 1e3, dt_cap);
+        dt_max_ = std::max(dt_max_, dt_min_);
+        h_ = std::clamp(first, dt_min_, dt_max_);
+    }
+
+    /**
+     * True while t_end is ahead of t and attempts remain
+     */
+    bool running(double t, double t_end) {
+        const double remaining = t_end - t;
+        if (remaining <= 1e-12 * std::max(1.0, std::abs(t_end))) {
+            stats_.reached = true;
+            return false;
+        }
+        return !stopped_ && stats_.accepted + stats_.rejected < config_.max_attempts;
+    }
+
+    /**
+     * Step size of the next attempt of steps_per_attempt steps, shortened to
+     * land on t_end
+     */
+    double proposal(double t, double t_end, uint64_t steps_per_attempt = 1) const {
+        const double span = h_ * static_cast<double>(steps_per_attempt);
+        if (t + span >= t_end) {
+            return (t_end - t) / static_cast<double>(steps_per_attempt);
+        }
+        return h_;
+    }
+
+    /**
+     * Judge an attempt of size h with error estimate err; returns true if the
+     * caller keeps the new state
+     */
+    bool accept(double err, double h, uint64_t steps) {
+        double factor;
+        bool keep;
+        if (!std::isfinite(err)) {
+            factor = config_.shrink_min;
+            keep = false;
+        } else {
+            const double ratio = err / config_.tolerance;
+            factor = ratio > 0.0 ? config_.safety * std::pow(1.0 / ratio, exponent_) : config_.grow_max;
+            factor = std::clamp(factor, config_.shrink_min, config_.grow_max);
+            keep = ratio <= 1.0 || h <= dt_min_ * (1.0 + 1e-12);
+        }
+
+        if (keep) {
+            stats_.dt_smallest = stats_.accepted == 0 ? h : std::min(stats_.dt_smallest, h);
+            stats_.dt_largest = std::max(stats_.dt_largest, h);
+            stats_.max_error = std::max(stats_.max_error, err);
+            stats_.accepted++;
+            stats_.steps += steps;
+        } else {
+            stats_.rejected++;
+        }
+        // A shortened landing attempt does not shrink the next proposal
+        const double base = keep ? std::max(h, h_) : h;
+        h_ = std::clamp(base * factor, dt_min_, dt_max_);
+        stopped_ = !keep && h <= dt_min_ * (1.0 + 1e-12);  // Non-finite even at dt_min
+        return keep;
+    }
+
+    AdaptiveRunStats stats() const {
+        AdaptiveRunStats out = stats_;
+        out.dt_next = h_;
+        return out;
+    }
+
+private:
+    AdaptiveStepConfig config_;
+    double exponent_;
+    double dt_min_ = 0.0;
+    double dt_max_ = 0.0;
+    double h_ = 0.0;
+    bool stopped_ = false;
+    AdaptiveRunStats stats_;
+};
+
+/**
+ * Step-doubling error of complex fields a (kept) and b (coarse):
+ * max_i |a_i - b_i| / (1 + max_i |a_i|)
+ */
+struct StepDoublingError {
+    static constexpr size_t kParallelThreshold = 16384;  // Values below which threads cost more
+
+    static double scaledDifference(const double* re_a, const double* im_a,
+                                   const double* re_b, const double* im_b, size_t n) {
+        double diff_sq = 0.0, norm_sq = 0.0;
+        #pragma omp parallel for schedule(static) reduction(max : diff_sq, norm_sq) if(n >= kParallelThreshold)
+        for (long i = 0; i < static_cast<long>(n); i++) {
+            const double dr = re_a[i] - re_b[i];
+            const double di = im_a[i] - im_b[i];
+            diff_sq = std::max(diff_sq, dr * dr + di * di);
+            norm_sq = std::max(norm_sq, re_a[i] * re_a[i] + im_a[i] * im_a[i]);
+        }
+        return std::sqrt(diff_sq) / (1.0 + std::sqrt(norm_sq));
+    }
+};
+
+} // namespace dase
@@ -0,0 +1,55 @@
+/**
+ * Cache-Line Aligned Allocator
+ *
+ * std::vector allocator returning 64-byte aligned storage, shared by the
+ * lattice arrays (IGSOALatticeSoA) and per-engine scratch buffers so SIMD
+ * loads never straddle cache lines. Storage comes from allocateAligned()
+ * (numa_memory.h), so large blocks are first-touched by their owning
+ * threads.
+ */
+
+#pragma once
+
+#include "numa_memory.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace dase {
+
+/**
+ * Minimal aligned allocator (default: 64-byte cache lines)
+ */
+template<typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(allocateAligned(n * sizeof(T), Alignment));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        deallocateAligned(p, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace dase
@@ -0,0 +1,194 @@
+/**
+ * Analog Stream Filter - Streaming Overlap-Add FIR Filter
+ *
+ * processBlockFrequencyDomain() filters isolated blocks: every call starts
+ * from silence, so a continuous signal cut into blocks picks up edge
+ * artifacts at each boundary. StreamFilter carries the state across calls
+ * and applies a fixed FIR impulse response h (num_taps long) to an
+ * unbounded stream by overlap-add:
+ *
+ *   - the FFT size N is the smallest power of two >= block_size + num_taps - 1,
+ *     and the spectrum H = FFT(h) / N is computed once at construction,
+ *   - input samples collect in a block buffer; each full block is zero-padded
+ *     to N, transformed (r2c), multiplied by H and transformed back (c2r),
+ *   - the N-sample result is added into an accumulator; its first block_size
+ *     samples are final and become the output, the rest is carried over.
+ *
+ * The output is the linear convolution y = h * x delayed by exactly
+ * block_size samples (latency() samples of leading zeros), independent of
+ * how the caller chunks its process() calls. Cost is one N-point real FFT
+ * pair per block, O(log N) per sample. Plans come from RealFFTPlanCache and
+ * the transform buffers from RealFFTScratch, so process() never allocates.
+ *
+ * A filter instance is not thread-safe; use one per stream.
+ */
+
+#pragma once
+
+#include "real_fft_plan_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dase {
+
+class StreamFilter {
+public:
+    /**
+     * @param taps FIR impulse response (at least one tap)
+     * @param block_size Samples per FFT block (the latency)
+     */
+    StreamFilter(const std::vector<double>& taps, size_t block_size)
+        : num_taps_(taps.size()), block_size_(block_size) {
+        if (taps.empty()) {
+            throw std::invalid_argument("StreamFilter: taps must not be empty");
+        }
+        if (block_size == 0) {
+            throw std::invalid_argument("StreamFilter: block_size must be positive");
+        }
+        fft_size_ = 1;
+        while (fft_size_ < block_size_ + num_taps_ - 1) fft_size_ <<= 1;
+
+        const int N = static_cast<int>(fft_size_);
+        const size_t bins = fft_size_ / 2 + 1;
+        plans_ = RealFFTPlanCache::instance().get(N);
+
+        RealFFTScratch& scratch = RealFFTScratch::local(fft_size_);
+        std::fill(scratch.real, scratch.real + fft_size_, 0.0);
+        std::copy(taps.begin(), taps.end(), scratch.real);
+        fftw_execute_dft_r2c(plans_.forward, scratch.real, scratch.spectrum);
+
+        // Fold the 1/N of the unnormalized inverse into H
+        const double scale = 1.0 / static_cast<double>(fft_size_);
+        response_re_.resize(bins);
+        response_im_.resize(bins);
+        for (size_t k = 0; k < bins; k++) {
+            response_re_[k] = scratch.spectrum[k][0] * scale;
+            response_im_[k] = scratch.spectrum[k][1] * scale;
+        }
+
+        pending_.assign(block_size_, 0.0);
+        ready_.assign(block_size_, 0.0);
+        accumulator_.assign(fft_size_, 0.0);
+    }
+
+    /**
+     * Windowed-sinc (Hann) band-pass taps for [low, high) cycles/sample
+     *
+     * low = 0 gives a low-pass, high = 0.5 a high-pass. num_taps should be
+     * odd for a symmetric (linear-phase) response.
+     */
+    static std::vector<double> designBandPass(double low, double high, size_t num_taps) {
+        if (!(low >= 0.0 && low < high && high <= 0.5)) {
+            throw std::invalid_argument("StreamFilter: band must satisfy 0 <= low < high <= 0.5");
+        }
+        if (num_taps == 0) {
+            throw std::invalid_argument("StreamFilter: num_taps must be positive");
+        }
+        std::vector<double> taps(num_taps);
+        const double center = 0.5 * static_cast<double>(num_taps - 1);
+        for (size_t i = 0; i < num_taps; i++) {
+            const double t = static_cast<double>(i) - center;
+            // Ideal band-pass = low-pass(high) - low-pass(low)
+            const double ideal = (t == 0.0)
+                ? 2.0 * (high - low)
+                : (std::sin(2.0 * M_PI * high * t) - std::sin(2.0 * M_PI * low * t)) / (M_PI * t);
+            const double window = (num_taps == 1)
+                ? 1.0
+                : 0.5 - 0.5 * std::cos(2.0 * M_PI * static_cast<double>(i) / static_cast<double>(num_taps - 1));
+            taps[i] = ideal * window;
+        }
+        return taps;
+    }
+
+    /**
+     * Filter n samples: out[i] is the filtered stream block_size samples
+     * behind in[i]. in and out may alias.
+     */
+    template <typename T>
+    void process(const T* in, T* out, size_t n) {
+        size_t done = 0;
+        while (done < n) {
+            const size_t chunk = std::min(n - done, block_size_ - fill_);
+            for (size_t i = 0; i < chunk; i++) {
+                const double x = static_cast<double>(in[done + i]);
+                out[done + i] = static_cast<T>(ready_[fill_ + i]);
+                pending_[fill_ + i] = x;
+            }
+            fill_ += chunk;
+            done += chunk;
+            if (fill_ == block_size_) {
+                filterBlock();
+                fill_ = 0;
+            }
+        }
+    }
+
+    void process(std::vector<double>& samples) {
+        process(samples.data(), samples.data(), samples.size());
+    }
+
+    /**
+     * Clear the stream history (the filter response is kept)
+     */
+    void reset() {
+        std::fill(pending_.begin(), pending_.end(), 0.0);
+        std::fill(ready_.begin(), ready_.end(), 0.0);
+        std::fill(accumulator_.begin(), accumulator_.end(), 0.0);
+        fill_ = 0;
+    }
+
+    size_t latency() const { return block_size_; }
+    size_t blockSize() const { return block_size_; }
+    size_t fftSize() const { return fft_size_; }
+    size_t numTaps() const { return num_taps_; }
+
+private:
+    void filterBlock() {
+        const size_t bins = fft_size_ / 2 + 1;
+        RealFFTScratch& scratch = RealFFTScratch::local(fft_size_);
+        double* real = scratch.real;
+        fftw_complex* spectrum = scratch.spectrum;
+
+        std::copy(pending_.begin(), pending_.end(), real);
+        std::fill(real + block_size_, real + fft_size_, 0.0);
+        fftw_execute_dft_r2c(plans_.forward, real, spectrum);
+
+        for (size_t k = 0; k < bins; k++) {
+            const double re = spectrum[k][0];
+            const double im = spectrum[k][1];
+            spectrum[k][0] = re * response_re_[k] - im * response_im_[k];
+            spectrum[k][1] = re * response_im_[k] + im * response_re_[k];
+        }
+        fftw_execute_dft_c2r(plans_.inverse, spectrum, real);
+
+        // Only the first block_size + num_taps - 1 samples of the block's
+        // convolution are nonzero
+        const size_t span = block_size_ + num_taps_ - 1;
+        for (size_t i = 0; i < span; i++) accumulator_[i] += real[i];
+
+        std::copy(accumulator_.begin(), accumulator_.begin() + block_size_, ready_.begin());
+        std::copy(accumulator_.begin() + block_size_, accumulator_.end(), accumulator_.begin());
+        std::fill(accumulator_.end() - block_size_, accumulator_.end(), 0.0);
+    }
+
+    size_t num_taps_;
+    size_t block_size_;
+    size_t fft_size_ = 0;
+    RealFFTPlanCache::Plans plans_;
+
+    std::vector<double> response_re_;   // H / N, N/2 + 1 bins
+    std::vector<double> response_im_;
+    std::vector<double> pending_;       // input block being filled
+    std::vector<double> ready_;         // finished output block being drained
+    std::vector<double> accumulator_;   // overlap-add sums, fft_size samples
+    size_t fill_ = 0;
+};
+
+} // namespace dase
@@ -1,6 +1,12 @@
 #include "analog_universal_node_engine_avx2.h"
+#include "cpu_dispatch.h"
+#include "oscillator_bank.h"
+#include "real_fft_plan_cache.h"
+#include "simd_math.h"
 #include <algorithm>
+#include <cmath>
 #include <random>
+#include <stdexcept>
 #include <chrono>
 #include <iostream>
 #include <iomanip>
@@ -124,9 +130,10 @@ void EngineMetrics::print_metrics() noexcept {
     std::cout << "================================\n" << std::endl;
 }
 
-// AVX2 Vectorized Math Functions 
+// AVX2 Vectorized Math Functions (dispatched variants below, see cpu_dispatch.h)
+#if DASE_SIMD_HAS_AVX2
 namespace AVX2Math {
-    __m256 fast_sin_avx2(__m256 x) {
+    DASE_TARGET_AVX2 __m256 fast_sin_avx2(__m256 x) {
         // Fast sin approximation using AVX2
         __m256 pi2 = _mm256_set1_ps(2.0f * M_PI);
         x = _mm256_sub_ps(x, _mm256_mul_ps(pi2, _mm256_floor_ps(_mm256_div_ps(x, pi2))));
@@ -137,7 +144,7 @@ namespace AVX2Math {
         return _mm256_add_ps(x, _mm256_add_ps(_mm256_mul_ps(c1, x3), _mm256_mul_ps(_mm256_set1_ps(1.0f / 120.0f), x5)));
     }
 
-    __m256 fast_cos_avx2(__m256 x) {
+    DASE_TARGET_AVX2 __m256 fast_cos_avx2(__m256 x) {
         // Fast cos approximation using AVX2
         __m256 pi2 = _mm256_set1_ps(2.0f * M_PI);
         x = _mm256_sub_ps(x, _mm256_mul_ps(pi2, _mm256_floor_ps(_mm256_div_ps(x, pi2))));
@@ -148,7 +155,7 @@ namespace AVX2Math {
         return _mm256_add_ps(one, _mm256_add_ps(_mm256_mul_ps(c1, x2), _mm256_mul_ps(_mm256_set1_ps(1.0f / 24.0f), x4)));
     }
 
-    void generate_harmonics_avx2(float input_signal, float pass_offset, float* harmonics_out) {
+    DASE_TARGET_AVX2 void generate_harmonics_avx2(float input_signal, float pass_offset, float* harmonics_out) {
         PROFILE_TOTAL();
         COUNT_AVX2();
         COUNT_HARMONIC();
@@ -166,7 +173,7 @@ namespace AVX2Math {
         _mm256_store_ps(harmonics_out, result);
     }
 
-    float process_spectral_avx2(float output_base) {
+    DASE_TARGET_AVX2 float process_spectral_avx2(float output_base) {
         // REMOVED PROFILE_TOTAL() - called 92M times!
         COUNT_AVX2();
 
@@ -184,6 +191,433 @@ namespace AVX2Math {
     }
 
 } // End AVX2Math namespace
+#endif
+
+// SSE4.1 variants: the AVX2 functions on two 4-wide halves, same operation order
+#if DASE_SIMD_HAS_SSE4
+namespace SSE4Math {
+    DASE_TARGET_SSE4 __m128 fast_sin_sse4(__m128 x) {
+        __m128 pi2 = _mm_set1_ps(2.0f * M_PI);
+        x = _mm_sub_ps(x, _mm_mul_ps(pi2, _mm_floor_ps(_mm_div_ps(x, pi2))));
+        __m128 x2 = _mm_mul_ps(x, x);
+        __m128 x3 = _mm_mul_ps(x2, x);
+        __m128 x5 = _mm_mul_ps(x3, x2);
+        __m128 c1 = _mm_set1_ps(-1.0f / 6.0f);
+        return _mm_add_ps(x, _mm_add_ps(_mm_mul_ps(c1, x3), _mm_mul_ps(_mm_set1_ps(1.0f / 120.0f), x5)));
+    }
+
+    DASE_TARGET_SSE4 void generate_harmonics_sse4(float input_signal, float pass_offset, float* harmonics_out) {
+        const __m128 input_vec = _mm_set1_ps(input_signal);
+        const __m128 offset_vec = _mm_set1_ps(pass_offset);
+        const __m128 base_amp = _mm_set1_ps(0.1f);
+        for (int half = 0; half < 2; ++half) {
+            const float h0 = 1.0f + 4.0f * half;
+            __m128 harmonics = _mm_set_ps(h0 + 3.0f, h0 + 2.0f, h0 + 1.0f, h0);
+            __m128 freq_vec = _mm_add_ps(_mm_mul_ps(input_vec, harmonics), offset_vec);
+            __m128 amplitudes = _mm_div_ps(base_amp, harmonics);
+            _mm_store_ps(harmonics_out + 4 * half, _mm_mul_ps(fast_sin_sse4(freq_vec), amplitudes));
+        }
+    }
+
+    DASE_TARGET_SSE4 float process_spectral_sse4(float output_base) {
+        __m128 base_vec = _mm_set1_ps(output_base);
+        __m128 low = fast_sin_sse4(_mm_mul_ps(base_vec, _mm_set_ps(1.2f, 0.9f, 0.7f, 0.3f)));
+        __m128 high = fast_sin_sse4(_mm_mul_ps(base_vec, _mm_set_ps(2.7f, 2.1f, 1.8f, 1.4f)));
+        __m128 sum = _mm_add_ps(low, high);
+        sum = _mm_hadd_ps(sum, sum);
+        sum = _mm_hadd_ps(sum, sum);
+        return _mm_cvtss_f32(sum) * 0.125f; // Divide by 8
+    }
+} // End SSE4Math namespace
+#endif
+
+// Scalar variants (x86-64 baseline): per-lane loops, same reduction order
+namespace ScalarMath {
+    inline float fast_sin(float x) {
+        const float pi2 = static_cast<float>(2.0f * M_PI);
+        x = x - pi2 * std::floor(x / pi2);
+        const float x2 = x * x;
+        const float x3 = x2 * x;
+        const float x5 = x3 * x2;
+        return x + ((-1.0f / 6.0f) * x3 + (1.0f / 120.0f) * x5);
+    }
+
+    void generate_harmonics(float input_signal, float pass_offset, float* harmonics_out) {
+        for (int h = 0; h < 8; ++h) {
+            const float harmonic = static_cast<float>(h + 1);
+            harmonics_out[h] = fast_sin(input_signal * harmonic + pass_offset) * (0.1f / harmonic);
+        }
+    }
+
+    float process_spectral(float output_base) {
+        static const float freq_mults[8] = {0.3f, 0.7f, 0.9f, 1.2f, 1.4f, 1.8f, 2.1f, 2.7f};
+        float lanes[4];
+        for (int l = 0; l < 4; ++l) {
+            lanes[l] = fast_sin(output_base * freq_mults[l]) + fast_sin(output_base * freq_mults[l + 4]);
+        }
+        return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) * 0.125f; // Divide by 8
+    }
+} // End ScalarMath namespace
+
+// -----------------------------------------------------------------------------
+// Phase 4C batch kernels: nodes [begin, end) of the SoA state in blocks of
+// the vector width, iterations_per_node updates each; return the first node
+// left for the scalar hot path. begin must be a multiple of 8 so the vector
+// loads and stores are aligned. All variants apply the same operations per lane.
+// -----------------------------------------------------------------------------
+namespace Phase4CKernels {
+    constexpr double kDt = 1.0 / 48000.0;
+    constexpr double kGain = 0.1;
+    constexpr double kDecay = 0.999999;
+    constexpr double kMaxAccum = 1e6;
+    constexpr double kMaxOut = 10.0;
+    constexpr double kSpectral = 0.01;
+
+    int blocks_scalar(AnalogNodeStateSoA& s, int begin, int end, double input, double control,
+                      std::uint32_t iterations_per_node) {
+        const double amplified = input * control;
+        const double increment = amplified * kGain * kDt;
+        const double spectral = amplified * kSpectral;
+        double* integrator_state = s.integrator_state.data();
+        double* current_output = s.current_output.data();
+        double* previous_input = s.previous_input.data();
+        const double* feedback_gain = s.feedback_gain.data();
+        const int block_end = begin + ((end - begin) / 4) * 4;
+        for (int i = begin; i < block_end; ++i) {
+            double integrator = integrator_state[i];
+            double output = 0.0;
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                integrator = (integrator + increment) * kDecay;
+                integrator = std::max(std::min(integrator, kMaxAccum), -kMaxAccum);
+                output = (integrator + integrator * feedback_gain[i]) + spectral;
+                output = std::max(std::min(output, kMaxOut), -kMaxOut);
+            }
+            integrator_state[i] = integrator;
+            current_output[i] = output;
+            previous_input[i] = input;
+        }
+        return std::max(begin, block_end);
+    }
+
+#if DASE_SIMD_HAS_SSE4
+    // 4-node blocks as two 2-wide halves
+    DASE_TARGET_SSE4 int blocks_sse4(AnalogNodeStateSoA& s, int begin, int end, double input, double control,
+                                     std::uint32_t iterations_per_node) {
+        const __m128d amplified = _mm_set1_pd(input * control);
+        const __m128d increment = _mm_mul_pd(_mm_mul_pd(amplified, _mm_set1_pd(kGain)), _mm_set1_pd(kDt));
+        const __m128d spectral = _mm_mul_pd(amplified, _mm_set1_pd(kSpectral));
+        const __m128d decay = _mm_set1_pd(kDecay);
+        const __m128d max_accum = _mm_set1_pd(kMaxAccum);
+        const __m128d min_accum = _mm_set1_pd(-kMaxAccum);
+        const __m128d max_out = _mm_set1_pd(kMaxOut);
+        const __m128d min_out = _mm_set1_pd(-kMaxOut);
+        const __m128d input_vec = _mm_set1_pd(input);
+        int i = begin;
+        for (; i + 4 <= end; i += 4) {
+            __m128d integrator[2];
+            __m128d gain[2];
+            __m128d output[2] = {_mm_setzero_pd(), _mm_setzero_pd()};
+            for (int h = 0; h < 2; ++h) {
+                integrator[h] = _mm_load_pd(&s.integrator_state[i + 2 * h]);
+                gain[h] = _mm_load_pd(&s.feedback_gain[i + 2 * h]);
+            }
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                for (int h = 0; h < 2; ++h) {
+                    integrator[h] = _mm_mul_pd(_mm_add_pd(integrator[h], increment), decay);
+                    integrator[h] = _mm_max_pd(_mm_min_pd(integrator[h], max_accum), min_accum);
+                    __m128d feedback_out = _mm_add_pd(integrator[h], _mm_mul_pd(integrator[h], gain[h]));
+                    output[h] = _mm_max_pd(_mm_min_pd(_mm_add_pd(feedback_out, spectral), max_out), min_out);
+                }
+            }
+            for (int h = 0; h < 2; ++h) {
+                _mm_store_pd(&s.integrator_state[i + 2 * h], integrator[h]);
+                _mm_store_pd(&s.current_output[i + 2 * h], output[h]);
+                _mm_store_pd(&s.previous_input[i + 2 * h], input_vec);
+            }
+        }
+        return i;
+    }
+#endif
+
+#if DASE_SIMD_HAS_AVX2
+    // 4-node blocks, one __m256d per field
+    DASE_TARGET_AVX2 int blocks_avx2(AnalogNodeStateSoA& s, int begin, int end, double input, double control,
+                                     std::uint32_t iterations_per_node) {
+        const __m256d amplified = _mm256_set1_pd(input * control);
+        const __m256d increment = _mm256_mul_pd(_mm256_mul_pd(amplified, _mm256_set1_pd(kGain)), _mm256_set1_pd(kDt));
+        const __m256d spectral = _mm256_mul_pd(amplified, _mm256_set1_pd(kSpectral));
+        const __m256d decay = _mm256_set1_pd(kDecay);
+        const __m256d max_accum = _mm256_set1_pd(kMaxAccum);
+        const __m256d min_accum = _mm256_set1_pd(-kMaxAccum);
+        const __m256d max_out = _mm256_set1_pd(kMaxOut);
+        const __m256d min_out = _mm256_set1_pd(-kMaxOut);
+        const __m256d input_vec = _mm256_set1_pd(input);
+        int i = begin;
+        for (; i + 4 <= end; i += 4) {
+            __m256d integrator = _mm256_load_pd(&s.integrator_state[i]);
+            const __m256d gain = _mm256_load_pd(&s.feedback_gain[i]);
+            __m256d output = _mm256_setzero_pd();
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                integrator = _mm256_mul_pd(_mm256_add_pd(integrator, increment), decay);
+                integrator = _mm256_max_pd(_mm256_min_pd(integrator, max_accum), min_accum);
+                __m256d feedback_out = _mm256_add_pd(integrator, _mm256_mul_pd(integrator, gain));
+                output = _mm256_max_pd(_mm256_min_pd(_mm256_add_pd(feedback_out, spectral), max_out), min_out);
+            }
+            _mm256_store_pd(&s.integrator_state[i], integrator);
+            _mm256_store_pd(&s.current_output[i], output);
+            _mm256_store_pd(&s.previous_input[i], input_vec);
+        }
+        return i;
+    }
+#endif
+
+#if DASE_SIMD_HAS_AVX512
+// _mm512_min_pd / _mm512_max_pd: see the note in simd_math.h
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    // 8-node blocks, one __m512d per field; a trailing 4-node block runs on AVX2
+    DASE_TARGET_AVX512 int blocks_avx512(AnalogNodeStateSoA& s, int begin, int end, double input, double control,
+                                         std::uint32_t iterations_per_node) {
+        const __m512d amplified = _mm512_set1_pd(input * control);
+        const __m512d increment = _mm512_mul_pd(_mm512_mul_pd(amplified, _mm512_set1_pd(kGain)), _mm512_set1_pd(kDt));
+        const __m512d spectral = _mm512_mul_pd(amplified, _mm512_set1_pd(kSpectral));
+        const __m512d decay = _mm512_set1_pd(kDecay);
+        const __m512d max_accum = _mm512_set1_pd(kMaxAccum);
+        const __m512d min_accum = _mm512_set1_pd(-kMaxAccum);
+        const __m512d max_out = _mm512_set1_pd(kMaxOut);
+        const __m512d min_out = _mm512_set1_pd(-kMaxOut);
+        const __m512d input_vec = _mm512_set1_pd(input);
+        int i = begin;
+        for (; i + 8 <= end; i += 8) {
+            __m512d integrator = _mm512_load_pd(&s.integrator_state[i]);
+            const __m512d gain = _mm512_load_pd(&s.feedback_gain[i]);
+            __m512d output = _mm512_setzero_pd();
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                integrator = _mm512_mul_pd(_mm512_add_pd(integrator, increment), decay);
+                integrator = _mm512_max_pd(_mm512_min_pd(integrator, max_accum), min_accum);
+                __m512d feedback_out = _mm512_add_pd(integrator, _mm512_mul_pd(integrator, gain));
+                output = _mm512_max_pd(_mm512_min_pd(_mm512_add_pd(feedback_out, spectral), max_out), min_out);
+            }
+            _mm512_store_pd(&s.integrator_state[i], integrator);
+            _mm512_store_pd(&s.current_output[i], output);
+            _mm512_store_pd(&s.previous_input[i], input_vec);
+        }
+        return blocks_avx2(s, i, end, input, control, iterations_per_node);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+    // Per-node drive: input[k] / control[k] belong to node begin + k (one
+    // step's row of the thread's slice). Same lane operations as above.
+    int rows_scalar(AnalogNodeStateSoA& s, int begin, int end, const double* input, const double* control,
+                    std::uint32_t iterations_per_node) {
+        double* integrator_state = s.integrator_state.data();
+        double* current_output = s.current_output.data();
+        double* previous_input = s.previous_input.data();
+        const double* feedback_gain = s.feedback_gain.data();
+        const int block_end = begin + ((end - begin) / 4) * 4;
+        for (int i = begin; i < block_end; ++i) {
+            const double amplified = input[i - begin] * control[i - begin];
+            const double increment = amplified * kGain * kDt;
+            const double spectral = amplified * kSpectral;
+            double integrator = integrator_state[i];
+            double output = 0.0;
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                integrator = (integrator + increment) * kDecay;
+                integrator = std::max(std::min(integrator, kMaxAccum), -kMaxAccum);
+                output = (integrator + integrator * feedback_gain[i]) + spectral;
+                output = std::max(std::min(output, kMaxOut), -kMaxOut);
+            }
+            integrator_state[i] = integrator;
+            current_output[i] = output;
+            previous_input[i] = input[i - begin];
+        }
+        return std::max(begin, block_end);
+    }
+
+#if DASE_SIMD_HAS_SSE4
+    DASE_TARGET_SSE4 int rows_sse4(AnalogNodeStateSoA& s, int begin, int end, const double* input,
+                                   const double* control, std::uint32_t iterations_per_node) {
+        const __m128d gain_k = _mm_set1_pd(kGain);
+        const __m128d dt = _mm_set1_pd(kDt);
+        const __m128d spectral_k = _mm_set1_pd(kSpectral);
+        const __m128d decay = _mm_set1_pd(kDecay);
+        const __m128d max_accum = _mm_set1_pd(kMaxAccum);
+        const __m128d min_accum = _mm_set1_pd(-kMaxAccum);
+        const __m128d max_out = _mm_set1_pd(kMaxOut);
+        const __m128d min_out = _mm_set1_pd(-kMaxOut);
+        int i = begin;
+        for (; i + 4 <= end; i += 4) {
+            __m128d integrator[2];
+            __m128d gain[2];
+            __m128d input_vec[2];
+            __m128d increment[2];
+            __m128d spectral[2];
+            __m128d output[2] = {_mm_setzero_pd(), _mm_setzero_pd()};
+            for (int h = 0; h < 2; ++h) {
+                integrator[h] = _mm_load_pd(&s.integrator_state[i + 2 * h]);
+                gain[h] = _mm_load_pd(&s.feedback_gain[i + 2 * h]);
+                input_vec[h] = _mm_loadu_pd(&input[i - begin + 2 * h]);
+                const __m128d amplified = _mm_mul_pd(input_vec[h], _mm_loadu_pd(&control[i - begin + 2 * h]));
+                increment[h] = _mm_mul_pd(_mm_mul_pd(amplified, gain_k), dt);
+                spectral[h] = _mm_mul_pd(amplified, spectral_k);
+            }
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                for (int h = 0; h < 2; ++h) {
+                    integrator[h] = _mm_mul_pd(_mm_add_pd(integrator[h], increment[h]), decay);
+                    integrator[h] = _mm_max_pd(_mm_min_pd(integrator[h], max_accum), min_accum);
+                    __m128d feedback_out = _mm_add_pd(integrator[h], _mm_mul_pd(integrator[h], gain[h]));
+                    output[h] = _mm_max_pd(_mm_min_pd(_mm_add_pd(feedback_out, spectral[h]), max_out), min_out);
+                }
+            }
+            for (int h = 0; h < 2; ++h) {
+                _mm_store_pd(&s.integrator_state[i + 2 * h], integrator[h]);
+                _mm_store_pd(&s.current_output[i + 2 * h], output[h]);
+                _mm_store_pd(&s.previous_input[i + 2 * h], input_vec[h]);
+            }
+        }
+        return i;
+    }
+#endif
+
+#if DASE_SIMD_HAS_AVX2
+    DASE_TARGET_AVX2 int rows_avx2(AnalogNodeStateSoA& s, int begin, int end, const double* input,
+                                   const double* control, std::uint32_t iterations_per_node) {
+        const __m256d gain_k = _mm256_set1_pd(kGain);
+        const __m256d dt = _mm256_set1_pd(kDt);
+        const __m256d spectral_k = _mm256_set1_pd(kSpectral);
+        const __m256d decay = _mm256_set1_pd(kDecay);
+        const __m256d max_accum = _mm256_set1_pd(kMaxAccum);
+        const __m256d min_accum = _mm256_set1_pd(-kMaxAccum);
+        const __m256d max_out = _mm256_set1_pd(kMaxOut);
+        const __m256d min_out = _mm256_set1_pd(-kMaxOut);
+        int i = begin;
+        for (; i + 4 <= end; i += 4) {
+            const __m256d input_vec = _mm256_loadu_pd(&input[i - begin]);
+            const __m256d amplified = _mm256_mul_pd(input_vec, _mm256_loadu_pd(&control[i - begin]));
+            const __m256d increment = _mm256_mul_pd(_mm256_mul_pd(amplified, gain_k), dt);
+            const __m256d spectral = _mm256_mul_pd(amplified, spectral_k);
+            __m256d integrator = _mm256_load_pd(&s.integrator_state[i]);
+            const __m256d gain = _mm256_load_pd(&s.feedback_gain[i]);
+            __m256d output = _mm256_setzero_pd();
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                integrator = _mm256_mul_pd(_mm256_add_pd(integrator, increment), decay);
+                integrator = _mm256_max_pd(_mm256_min_pd(integrator, max_accum), min_accum);
+                __m256d feedback_out = _mm256_add_pd(integrator, _mm256_mul_pd(integrator, gain));
+                output = _mm256_max_pd(_mm256_min_pd(_mm256_add_pd(feedback_out, spectral), max_out), min_out);
+            }
+            _mm256_store_pd(&s.integrator_state[i], integrator);
+            _mm256_store_pd(&s.current_output[i], output);
+            _mm256_store_pd(&s.previous_input[i], input_vec);
+        }
+        return i;
+    }
+#endif
+
+#if DASE_SIMD_HAS_AVX512
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    DASE_TARGET_AVX512 int rows_avx512(AnalogNodeStateSoA& s, int begin, int end, const double* input,
+                                       const double* control, std::uint32_t iterations_per_node) {
+        const __m512d gain_k = _mm512_set1_pd(kGain);
+        const __m512d dt = _mm512_set1_pd(kDt);
+        const __m512d spectral_k = _mm512_set1_pd(kSpectral);
+        const __m512d decay = _mm512_set1_pd(kDecay);
+        const __m512d max_accum = _mm512_set1_pd(kMaxAccum);
+        const __m512d min_accum = _mm512_set1_pd(-kMaxAccum);
+        const __m512d max_out = _mm512_set1_pd(kMaxOut);
+        const __m512d min_out = _mm512_set1_pd(-kMaxOut);
+        int i = begin;
+        for (; i + 8 <= end; i += 8) {
+            const __m512d input_vec = _mm512_loadu_pd(&input[i - begin]);
+            const __m512d amplified = _mm512_mul_pd(input_vec, _mm512_loadu_pd(&control[i - begin]));
+            const __m512d increment = _mm512_mul_pd(_mm512_mul_pd(amplified, gain_k), dt);
+            const __m512d spectral = _mm512_mul_pd(amplified, spectral_k);
+            __m512d integrator = _mm512_load_pd(&s.integrator_state[i]);
+            const __m512d gain = _mm512_load_pd(&s.feedback_gain[i]);
+            __m512d output = _mm512_setzero_pd();
+            for (std::uint32_t iter = 0; iter < iterations_per_node; ++iter) {
+                integrator = _mm512_mul_pd(_mm512_add_pd(integrator, increment), decay);
+                integrator = _mm512_max_pd(_mm512_min_pd(integrator, max_accum), min_accum);
+                __m512d feedback_out = _mm512_add_pd(integrator, _mm512_mul_pd(integrator, gain));
+                output = _mm512_max_pd(_mm512_min_pd(_mm512_add_pd(feedback_out, spectral), max_out), min_out);
+            }
+            _mm512_store_pd(&s.integrator_state[i], integrator);
+            _mm512_store_pd(&s.current_output[i], output);
+            _mm512_store_pd(&s.previous_input[i], input_vec);
+        }
+        return rows_avx2(s, i, end, input + (i - begin), control + (i - begin), iterations_per_node);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+} // End Phase4CKernels namespace
+
+// -----------------------------------------------------------------------------
+// Kernel table per SIMD level; levels a non-dispatching build did not
+// compile fall back to the next lower one (they are never active there)
+// -----------------------------------------------------------------------------
+struct AnalogKernelTable {
+    float (*process_spectral)(float output_base);
+    void (*generate_harmonics)(float input_signal, float pass_offset, float* harmonics_out);
+    int (*phase4c_blocks)(AnalogNodeStateSoA& nodes, int begin, int end, double input,
+                          double control, std::uint32_t iterations_per_node);
+    int (*phase4c_rows)(AnalogNodeStateSoA& nodes, int begin, int end, const double* input,
+                        const double* control, std::uint32_t iterations_per_node);
+    int phase4c_width;  // nodes per vector
+};
+
+static const AnalogKernelTable kScalarKernels = {
+    ScalarMath::process_spectral, ScalarMath::generate_harmonics,
+    Phase4CKernels::blocks_scalar, Phase4CKernels::rows_scalar, 1};
+#if DASE_SIMD_HAS_SSE4
+static const AnalogKernelTable kSSE4Kernels = {
+    SSE4Math::process_spectral_sse4, SSE4Math::generate_harmonics_sse4,
+    Phase4CKernels::blocks_sse4, Phase4CKernels::rows_sse4, 2};
+#else
+static const AnalogKernelTable kSSE4Kernels = kScalarKernels;
+#endif
+#if DASE_SIMD_HAS_AVX2
+static const AnalogKernelTable kAVX2Kernels = {
+    AVX2Math::process_spectral_avx2, AVX2Math::generate_harmonics_avx2,
+    Phase4CKernels::blocks_avx2, Phase4CKernels::rows_avx2, 4};
+#else
+static const AnalogKernelTable kAVX2Kernels = kSSE4Kernels;
+#endif
+#if DASE_SIMD_HAS_AVX512
+static const AnalogKernelTable kAVX512Kernels = {
+    AVX2Math::process_spectral_avx2, AVX2Math::generate_harmonics_avx2,
+    Phase4CKernels::blocks_avx512, Phase4CKernels::rows_avx512, 8};
+#else
+static const AnalogKernelTable kAVX512Kernels = kAVX2Kernels;
+#endif
+
+static const AnalogKernelTable& analogKernels() {
+    switch (dase::activeSimdLevel()) {
+    case dase::SimdLevel::AVX512: return kAVX512Kernels;
+    case dase::SimdLevel::AVX2: return kAVX2Kernels;
+    case dase::SimdLevel::SSE4: return kSSE4Kernels;
+    case dase::SimdLevel::Scalar: break;
+    }
+    return kScalarKernels;
+}
+
+// Per-node spectral boost; a build that already targets AVX2 calls it directly
+static inline float processSpectral(float output_base) {
+#if defined(__AVX2__) && defined(__FMA__)
+    return AVX2Math::process_spectral_avx2(output_base);
+#else
+    return analogKernels().process_spectral(output_base);
+#endif
+}
+
 
 // AnalogUniversalNodeAVX2 Implementation
 FORCE_INLINE double AnalogUniversalNodeAVX2::amplify(double input_signal, double gain) {
@@ -230,7 +664,7 @@ double AnalogUniversalNodeAVX2::processSignalAVX2(double input_signal, double co
     double integrated_output = integrate(amplified_signal, 0.1);
     double aux_blended = amplified_signal + aux_signal;
 
-    float spectral_boost = AVX2Math::process_spectral_avx2(static_cast<float>(aux_blended));
+    float spectral_boost = processSpectral(static_cast<float>(aux_blended));
 
     double feedback_output = applyFeedback(integrated_output, feedback_gain);
 
@@ -264,7 +698,7 @@ FORCE_INLINE double AnalogUniversalNodeAVX2::processSignalAVX2_hotpath(
 
     double aux_blended = amplified_signal + aux_signal;
 
-    float spectral_boost = AVX2Math::process_spectral_avx2(static_cast<float>(aux_blended));
+    float spectral_boost = processSpectral(static_cast<float>(aux_blended));
 
     // Inline applyFeedback
     double feedback_component = integrator_state * feedback_gain;
@@ -303,44 +737,10 @@ void AnalogUniversalNodeAVX2::resetIntegrator() noexcept {
 // Oscillator: Generate waveform at specified frequency
 // -----------------------------------------------------------------------------
 std::vector<float> AnalogUniversalNodeAVX2::oscillate(double frequency_hz, double duration_seconds) {
-    PROFILE_TOTAL();
-    COUNT_OPERATION();
-
     const int sample_rate = 48000; // 48 kHz sampling rate
     const int num_samples = static_cast<int>(duration_seconds * sample_rate);
     std::vector<float> output(num_samples);
-
-    const float angular_freq_f = static_cast<float>(2.0 * M_PI * frequency_hz / sample_rate);
-
-    // AVX2-optimized oscillator: process 8 samples at a time
-    COUNT_AVX2();
-
-    const int simd_width = 8;
-    const int num_simd_chunks = num_samples / simd_width;
-    const int remainder = num_samples % simd_width;
-
-    // Pre-compute phase increment vector
-    __m256 phase_increment = _mm256_set1_ps(angular_freq_f);
-    __m256 phase_step = _mm256_mul_ps(phase_increment,
-                                       _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f));
-    __m256 phase_advance = _mm256_set1_ps(angular_freq_f * simd_width);
-
-    __m256 current_phase = phase_step;
-
-    // Vectorized loop for 8 samples at a time
-    // MSVC /Ob3 handles loop optimization automatically
-    for (int chunk = 0; chunk < num_simd_chunks; ++chunk) {
-        __m256 wave = AVX2Math::fast_sin_avx2(current_phase);
-        _mm256_storeu_ps(&output[chunk * simd_width], wave);
-        current_phase = _mm256_add_ps(current_phase, phase_advance);
-    }
-
-    // Handle remainder with scalar code
-    for (int i = num_simd_chunks * simd_width; i < num_samples; ++i) {
-        float phase = i * angular_freq_f;
-        output[i] = std::sin(phase);
-    }
-
+    oscillate_inplace(output.data(), num_samples, frequency_hz, sample_rate);
     return output;
 }
 
@@ -351,34 +751,23 @@ void AnalogUniversalNodeAVX2::oscillate_inplace(float* output, int num_samples,
     PROFILE_TOTAL();
     COUNT_OPERATION();
 
-    const float angular_freq_f = static_cast<float>(2.0 * M_PI * frequency_hz / sample_rate);
-
-    // AVX2-optimized oscillator: process 8 samples at a time
+    // Phase rotation, 8 samples per rotated row at the dispatched level
     COUNT_AVX2();
 
-    const int simd_width = 8;
-    const int num_simd_chunks = num_samples / simd_width;
-
-    // Pre-compute phase increment vector
-    __m256 phase_increment = _mm256_set1_ps(angular_freq_f);
-    __m256 phase_step = _mm256_mul_ps(phase_increment,
-                                       _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f));
-    __m256 phase_advance = _mm256_set1_ps(angular_freq_f * simd_width);
-
-    __m256 current_phase = phase_step;
-
-    // Vectorized loop for 8 samples at a time
-    // MSVC /Ob3 handles loop optimization automatically
-    for (int chunk = 0; chunk < num_simd_chunks; ++chunk) {
-        __m256 wave = AVX2Math::fast_sin_avx2(current_phase);
-        _mm256_storeu_ps(&output[chunk * simd_width], wave);
-        current_phase = _mm256_add_ps(current_phase, phase_advance);
-    }
-
-    // Handle remainder with scalar code
-    for (int i = num_simd_chunks * simd_width; i < num_samples; ++i) {
-        float phase = i * angular_freq_f;
-        output[i] = std::sin(phase);
+    constexpr int kLanes = 8;
+    constexpr std::uint32_t kRows = 256;
+    const dase::OscillatorBank bank =
+        dase::OscillatorBank::interleaved(2.0 * M_PI * frequency_hz / sample_rate, kLanes);
+    double sin_block[kRows * kLanes];
+    double cos_block[kRows * kLanes];
+
+    for (int first = 0; first < num_samples; first += kRows * kLanes) {
+        const int count = std::min<int>(kRows * kLanes, num_samples - first);
+        const std::uint32_t rows = static_cast<std::uint32_t>((count + kLanes - 1) / kLanes);
+        bank.fill(static_cast<std::uint64_t>(first / kLanes), rows, 0, kLanes, sin_block, cos_block);
+        for (int i = 0; i < count; ++i) {
+            output[first + i] = static_cast<float>(sin_block[i]);
+        }
     }
 }
 
@@ -524,7 +913,7 @@ std::vector<double> AnalogUniversalNodeAVX2::processBatch(
         double integrated_output = integrate(amplified_signal, 0.1);
         double aux_blended = amplified_signal + aux_signals[i];
 
-        float spectral_boost = AVX2Math::process_spectral_avx2(static_cast<float>(aux_blended));
+        float spectral_boost = processSpectral(static_cast<float>(aux_blended));
 
         double feedback_output = applyFeedback(integrated_output, feedback_gain);
 
@@ -540,13 +929,13 @@ std::vector<double> AnalogUniversalNodeAVX2::processBatch(
 
 // AnalogCellularEngineAVX2 Implementation
 AnalogCellularEngineAVX2::AnalogCellularEngineAVX2(size_t num_nodes)
-    : nodes(num_nodes), system_frequency(1.0), noise_level(0.001) {
+    : nodes(num_nodes), system_frequency(1.0), noise_level(0.001),
+      noise_rng(dase::CounterRNG::entropySeed()), noise_draws(0) {
     for (size_t i = 0; i < num_nodes; i++) {
-        nodes[i] = AnalogUniversalNodeAVX2();
-        nodes[i].x = static_cast<int16_t>(i % 10);
-        nodes[i].y = static_cast<int16_t>((i / 10) % 10);
-        nodes[i].z = static_cast<int16_t>(i / 100);
-        nodes[i].node_id = static_cast<uint16_t>(i);
+        nodes.x[i] = static_cast<int16_t>(i % 10);
+        nodes.y[i] = static_cast<int16_t>((i / 10) % 10);
+        nodes.z[i] = static_cast<int16_t>(i / 100);
+        nodes.node_id[i] = static_cast<uint16_t>(i);
     }
 }
 
@@ -569,17 +958,31 @@ void AnalogCellularEngineAVX2::runMission(uint64_t num_steps) {
     // Profile ONLY the outer loop, not the inner hot path
     auto mission_start = std::chrono::high_resolution_clock::now();
 
+    // Drive sin / cos(0.01 step), generated a block of steps at a time by
+    // phase rotation (8 steps per row) instead of two libm calls per step
+    constexpr std::uint32_t kDriveLanes = 8;
+    constexpr std::uint32_t kDriveRows = 32;
+    constexpr std::uint64_t kDriveBlock = kDriveLanes * kDriveRows;
+    const dase::OscillatorBank drive = dase::OscillatorBank::interleaved(0.01, kDriveLanes);
+    double drive_sin[kDriveBlock];
+    double drive_cos[kDriveBlock];
+
     for (uint64_t step = 0; step < num_steps; ++step) {
-        double input_signal = std::sin(static_cast<double>(step) * 0.01);
-        double control_pattern = std::cos(static_cast<double>(step) * 0.01);
+        if (step % kDriveBlock == 0) {
+            drive.fill(step / kDriveLanes, kDriveRows, 0, kDriveLanes, drive_sin, drive_cos);
+        }
+        double input_signal = drive_sin[step % kDriveBlock];
+        double control_pattern = drive_cos[step % kDriveBlock];
 
         #pragma omp parallel for
-        for (int i = 0; i < nodes.size(); i++) {
+        for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
             // Process 30 iterations for this node
             // Compiler /Ob3 flag handles loop optimization automatically
+            AnalogUniversalNodeAVX2 node = nodes.load(i);
             for (int j = 0; j < 30; ++j) {
-                nodes[i].processSignalAVX2(input_signal, control_pattern, 0.0);
+                node.processSignalAVX2(input_signal, control_pattern, 0.0);
             }
+            nodes.store(i, node);
         }
         
         // Removed blocking I/O here to prevent bottlenecks
@@ -624,12 +1027,11 @@ void AnalogCellularEngineAVX2::runMissionOptimized(
     auto mission_start = std::chrono::high_resolution_clock::now();
 
     // Phase 4A optimizations:
-    // 1. Cache pointer for direct access (eliminate vector overhead)
+    // 1. Work on a register-resident copy of each node (one load/store per step)
     // 2. Use hot-path version without profiling counters
     // 3. Force inlining of all trivial functions
     const int64_t num_steps_int = static_cast<int64_t>(num_steps);
     const int num_nodes_int = static_cast<int>(nodes.size());
-    auto* nodes_ptr = nodes.data();  // Direct pointer access
 
     for (int64_t step = 0; step < num_steps_int; ++step) {
         const double input = input_signals[step];
@@ -637,12 +1039,13 @@ void AnalogCellularEngineAVX2::runMissionOptimized(
 
         #pragma omp parallel for schedule(static)
         for (int i = 0; i < num_nodes_int; ++i) {
-            auto& node = nodes_ptr[i];  // Direct pointer dereference
+            AnalogUniversalNodeAVX2 node = nodes.load(i);
 
             // Inner hot loop: Use hot-path version (no profiling)
             for (uint32_t j = 0; j < iterations_per_node; ++j) {
                 node.processSignalAVX2_hotpath(input, control, 0.0);
             }
+            nodes.store(i, node);
         }
     }
 
@@ -688,7 +1091,6 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4B(
 
     const int64_t num_steps_int = static_cast<int64_t>(num_steps);
     const int num_nodes_int = static_cast<int>(nodes.size());
-    auto* nodes_ptr = nodes.data();
 
     // Phase 4B: Single parallel region with manual work distribution
     // This eliminates 54,750 implicit barriers (one per step)
@@ -713,12 +1115,13 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4B(
 
             // Each thread processes its assigned nodes
             for (int i = node_start; i < node_end; ++i) {
-                auto& node = nodes_ptr[i];
+                AnalogUniversalNodeAVX2 node = nodes.load(i);
 
                 // Hot-path inner loop
                 for (uint32_t j = 0; j < iterations_per_node; ++j) {
                     node.processSignalAVX2_hotpath(input, control, 0.0);
                 }
+                nodes.store(i, node);
             }
         }
     } // Single barrier at end of parallel region
@@ -735,7 +1138,7 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4B(
     std::cout << "=========================================" << std::endl;
 }
 
-// Phase 4C: AVX2 Spatial Vectorization - Process 4 nodes in parallel
+// Phase 4C: SIMD Spatial Vectorization - 4 nodes per vector (8 on AVX-512)
 void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
     const double* input_signals,
     const double* control_patterns,
@@ -747,7 +1150,10 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
     omp_set_num_threads(omp_get_max_threads());
     #endif
 
-    std::cout << "\n🚀 C++ OPTIMIZED MISSION LOOP STARTED (PHASE 4C - AVX2 SPATIAL) 🚀" << std::endl;
+    // Batch kernel of the dispatched SIMD level, chosen once per mission
+    const AnalogKernelTable& kernels = analogKernels();
+
+    std::cout << "\n🚀 C++ OPTIMIZED MISSION LOOP STARTED (PHASE 4C - SIMD SPATIAL) 🚀" << std::endl;
     std::cout << "=========================================" << std::endl;
     std::cout << "Total steps: " << num_steps << std::endl;
     std::cout << "Total nodes: " << nodes.size() << std::endl;
@@ -756,23 +1162,14 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
     std::cout << "Threads: " << omp_get_max_threads() << std::endl;
     #endif
     std::cout << "Mode: ZERO-COPY (Julia FFI)" << std::endl;
-    std::cout << "Phase 4C: AVX2 spatial vectorization (4 nodes/batch)" << std::endl;
+    std::cout << "Phase 4C: " << dase::simdLevelName(dase::activeSimdLevel())
+              << " spatial vectorization (" << kernels.phase4c_width << " nodes/vector)" << std::endl;
     std::cout << "=========================================" << std::endl;
 
     auto mission_start = std::chrono::high_resolution_clock::now();
 
     const int num_nodes_int = static_cast<int>(nodes.size());
     const int64_t num_steps_int = static_cast<int64_t>(num_steps);
-    auto* nodes_ptr = nodes.data();
-
-    // AVX2 constants (broadcast to all 4 lanes)
-    const __m256d dt_vec = _mm256_set1_pd(1.0 / 48000.0);
-    const __m256d gain_vec = _mm256_set1_pd(0.1);
-    const __m256d decay_vec = _mm256_set1_pd(0.999999);
-    const __m256d max_accum_vec = _mm256_set1_pd(1e6);
-    const __m256d min_accum_vec = _mm256_set1_pd(-1e6);
-    const __m256d max_out_vec = _mm256_set1_pd(10.0);
-    const __m256d min_out_vec = _mm256_set1_pd(-10.0);
 
     // Single parallel region (Phase 4B optimization retained)
     #pragma omp parallel
@@ -780,7 +1177,8 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
         const int tid = omp_get_thread_num();
         const int nthreads = omp_get_num_threads();
 
-        const int nodes_per_thread = (num_nodes_int + nthreads - 1) / nthreads;
+        // Slices start on a multiple of 8 nodes: aligned vector loads/stores
+        const int nodes_per_thread = ((num_nodes_int + nthreads - 1) / nthreads + 7) & ~7;
         const int node_start = tid * nodes_per_thread;
         const int node_end = std::min(node_start + nodes_per_thread, num_nodes_int);
 
@@ -789,94 +1187,225 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
             const double input = input_signals[step];
             const double control = control_patterns[step];
 
-            // Broadcast inputs to AVX2 vectors
-            const __m256d input_vec = _mm256_set1_pd(input);
-            const __m256d control_vec = _mm256_set1_pd(control);
-
-            // Process nodes in batches of 4 using AVX2
-            int i = node_start;
-            const int node_end_avx2 = node_start + ((node_end - node_start) / 4) * 4;
-
-            // AVX2 batch loop: process 4 nodes at once
-            for (; i < node_end_avx2; i += 4) {
-                // Aligned arrays for SIMD operations
-                alignas(32) double integrator_states[4];
-                alignas(32) double feedback_gains[4];
-                alignas(32) double outputs[4] = {0.0, 0.0, 0.0, 0.0};
-
-                // Load state from 4 nodes
-                for (int j = 0; j < 4; ++j) {
-                    integrator_states[j] = nodes_ptr[i + j].integrator_state;
-                    feedback_gains[j] = nodes_ptr[i + j].feedback_gain;
+            // Vector batch loop: whole blocks of nodes at once
+            int i = kernels.phase4c_blocks(nodes, node_start, node_end, input, control,
+                                           iterations_per_node);
+
+            // Handle remaining nodes with scalar code
+            for (; i < node_end; ++i) {
+                AnalogUniversalNodeAVX2 node = nodes.load(i);
+                for (uint32_t j = 0; j < iterations_per_node; ++j) {
+                    node.processSignalAVX2_hotpath(input, control, 0.0);
                 }
+                nodes.store(i, node);
+            }
+        }
+    } // Single barrier at end
 
-                __m256d integrator_vec = _mm256_load_pd(integrator_states);
-                __m256d feedback_gain_vec = _mm256_load_pd(feedback_gains);
-                __m256d output_vec = _mm256_setzero_pd();
+    auto mission_end = std::chrono::high_resolution_clock::now();
+    auto mission_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start);
 
-                // Process iterations_per_node times
-                for (uint32_t iter = 0; iter < iterations_per_node; ++iter) {
-                    // 1. Amplify: amplified = input * control
-                    __m256d amplified_vec = _mm256_mul_pd(input_vec, control_vec);
+    metrics_.total_execution_time_ns = mission_duration.count();
+    metrics_.total_operations = num_steps * nodes.size() * iterations_per_node;
+    metrics_.node_processes = metrics_.total_operations;
+    metrics_.update_performance();
 
-                    // 2. Integrate: integrator += amplified * 0.1 * dt
-                    __m256d increment = _mm256_mul_pd(amplified_vec, gain_vec);
-                    increment = _mm256_mul_pd(increment, dt_vec);
-                    integrator_vec = _mm256_add_pd(integrator_vec, increment);
+    metrics_.print_metrics();
+    std::cout << "=========================================" << std::endl;
+}
 
-                    // 3. Decay: integrator *= 0.999999
-                    integrator_vec = _mm256_mul_pd(integrator_vec, decay_vec);
+// -----------------------------------------------------------------------------
+// Node-parallel missions: per-node drive streamed through the Phase 4C kernels
+// -----------------------------------------------------------------------------
 
-                    // 4. Clamp integrator [-1e6, 1e6]
-                    integrator_vec = _mm256_min_pd(integrator_vec, max_accum_vec);
-                    integrator_vec = _mm256_max_pd(integrator_vec, min_accum_vec);
+// Pull the next step's row of a thread slice toward L1 while this one computes
+static inline void prefetchRow(const double* row, int count) {
+    for (int k = 0; k < count; k += 8) {
+#if defined(_MSC_VER)
+        _mm_prefetch(reinterpret_cast<const char*>(row + k), _MM_HINT_T0);
+#else
+        __builtin_prefetch(row + k, 0, 3);
+#endif
+    }
+}
 
-                    // 5. Apply feedback: output = integrator + integrator * feedback_gain
-                    __m256d feedback_comp = _mm256_mul_pd(integrator_vec, feedback_gain_vec);
-                    __m256d feedback_out = _mm256_add_pd(integrator_vec, feedback_comp);
+// View of one block of steps for a thread slice: row s of input / control
+// starts at input + s * stride and holds the slice's nodes in order
+struct MissionDriveBlock {
+    const double* input = nullptr;
+    const double* control = nullptr;
+    std::size_t stride = 0;
+};
 
-                    // 6. Spectral boost (simplified for vectorization)
-                    // Use a simple approximation: spectral_boost ≈ amplified * 0.01
-                    __m256d spectral_approx = _mm256_mul_pd(amplified_vec, _mm256_set1_pd(0.01));
+// Nodes per chunk of a thread slice: a block of steps runs over one chunk at
+// a time, so the chunk's state stays in L1 and a drive tile (block_steps rows
+// of the chunk) in L2. A multiple of 8 keeps the vector / tail split of Phase 4C.
+constexpr int kMissionChunkNodes = 256;
+
+// Single parallel region over [0, num_steps) in blocks of block_steps; for
+// each node chunk, fill(step_begin, step_count, chunk_begin, chunk_count,
+// tile_in, tile_ctl) returns the block view, either into the caller's matrix
+// or into the thread's tiles (allocated only when uses_tiles)
+template <typename Fill>
+static void runNodeParallelMission(AnalogNodeStateSoA& nodes, std::uint64_t num_steps,
+                                   std::uint32_t iterations_per_node, std::uint32_t block_steps,
+                                   bool uses_tiles, Fill&& fill) {
+    const AnalogKernelTable& kernels = analogKernels();
+    const int num_nodes_int = static_cast<int>(nodes.size());
+    const std::uint64_t block = std::max<std::uint32_t>(block_steps, 1);
 
-                    // 7. Final output = feedback + spectral
-                    output_vec = _mm256_add_pd(feedback_out, spectral_approx);
+    #pragma omp parallel
+    {
+        #ifdef _OPENMP
+        const int tid = omp_get_thread_num();
+        const int nthreads = omp_get_num_threads();
+        #else
+        const int tid = 0;
+        const int nthreads = 1;
+        #endif
 
-                    // 8. Clamp output [-10.0, 10.0]
-                    output_vec = _mm256_min_pd(output_vec, max_out_vec);
-                    output_vec = _mm256_max_pd(output_vec, min_out_vec);
-                }
+        // Same 8-aligned slices as Phase 4C
+        const int nodes_per_thread = ((num_nodes_int + nthreads - 1) / nthreads + 7) & ~7;
+        const int node_start = tid * nodes_per_thread;
+        const int node_end = std::min(node_start + nodes_per_thread, num_nodes_int);
 
-                // Store final states back to nodes
-                _mm256_store_pd(integrator_states, integrator_vec);
-                _mm256_store_pd(outputs, output_vec);
-                for (int j = 0; j < 4; ++j) {
-                    nodes_ptr[i + j].integrator_state = integrator_states[j];
-                    nodes_ptr[i + j].current_output = outputs[j];
-                    nodes_ptr[i + j].previous_input = input;
-                }
-            }
+        std::vector<double> tile_in;
+        std::vector<double> tile_ctl;
+        if (uses_tiles && node_start < node_end) {
+            const std::size_t tile = static_cast<std::size_t>(block) * kMissionChunkNodes;
+            tile_in.resize(tile);
+            tile_ctl.resize(tile);
+        }
 
-            // Handle remaining nodes with scalar code
-            for (; i < node_end; ++i) {
-                auto& node = nodes_ptr[i];
-                for (uint32_t j = 0; j < iterations_per_node; ++j) {
-                    node.processSignalAVX2_hotpath(input, control, 0.0);
+        for (std::uint64_t step_begin = 0; node_start < node_end && step_begin < num_steps; step_begin += block) {
+            const std::uint32_t step_count = static_cast<std::uint32_t>(std::min(block, num_steps - step_begin));
+
+            for (int chunk_begin = node_start; chunk_begin < node_end; chunk_begin += kMissionChunkNodes) {
+                const int chunk_end = std::min(chunk_begin + kMissionChunkNodes, node_end);
+                const int chunk_count = chunk_end - chunk_begin;
+                const MissionDriveBlock drive = fill(step_begin, step_count, chunk_begin, chunk_count,
+                                                     tile_in.data(), tile_ctl.data());
+
+                for (std::uint32_t s = 0; s < step_count; ++s) {
+                    const double* input = drive.input + s * drive.stride;
+                    const double* control = drive.control + s * drive.stride;
+                    if (s + 1 < step_count) {
+                        prefetchRow(input + drive.stride, chunk_count);
+                        prefetchRow(control + drive.stride, chunk_count);
+                    }
+
+                    int i = kernels.phase4c_rows(nodes, chunk_begin, chunk_end, input, control,
+                                                 iterations_per_node);
+                    for (; i < chunk_end; ++i) {
+                        AnalogUniversalNodeAVX2 node = nodes.load(i);
+                        for (uint32_t j = 0; j < iterations_per_node; ++j) {
+                            node.processSignalAVX2_hotpath(input[i - chunk_begin], control[i - chunk_begin], 0.0);
+                        }
+                        nodes.store(i, node);
+                    }
                 }
             }
         }
     } // Single barrier at end
+}
+
+void AnalogCellularEngineAVX2::runMissionPerNode(
+    const double* input_signals,
+    const double* control_patterns,
+    std::uint64_t num_steps,
+    SignalLayout layout,
+    std::uint32_t iterations_per_node
+) {
+    #ifdef _OPENMP
+    omp_set_dynamic(0);
+    omp_set_num_threads(omp_get_max_threads());
+    #endif
+
+    metrics_.reset();
+    const std::size_t num_nodes = nodes.size();
+    auto mission_start = std::chrono::high_resolution_clock::now();
+
+    if (layout == SignalLayout::StepMajor) {
+        // Rows are read in place
+        runNodeParallelMission(nodes, num_steps, iterations_per_node, 64, false,
+            [&](std::uint64_t step_begin, std::uint32_t, int node_begin, int, double*, double*) {
+                MissionDriveBlock drive;
+                drive.input = input_signals + step_begin * num_nodes + node_begin;
+                drive.control = control_patterns + step_begin * num_nodes + node_begin;
+                drive.stride = num_nodes;
+                return drive;
+            });
+    } else {
+        // Transpose a block of steps of the chunk's node rows into the tiles
+        runNodeParallelMission(nodes, num_steps, iterations_per_node, 64, true,
+            [&](std::uint64_t step_begin, std::uint32_t step_count, int node_begin, int node_count,
+                double* tile_in, double* tile_ctl) {
+                for (int n = 0; n < node_count; ++n) {
+                    const std::size_t row = static_cast<std::size_t>(node_begin + n) * num_steps + step_begin;
+                    for (std::uint32_t s = 0; s < step_count; ++s) {
+                        tile_in[static_cast<std::size_t>(s) * node_count + n] = input_signals[row + s];
+                        tile_ctl[static_cast<std::size_t>(s) * node_count + n] = control_patterns[row + s];
+                    }
+                }
+                MissionDriveBlock drive;
+                drive.input = tile_in;
+                drive.control = tile_ctl;
+                drive.stride = static_cast<std::size_t>(node_count);
+                return drive;
+            });
+    }
 
     auto mission_end = std::chrono::high_resolution_clock::now();
-    auto mission_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start);
+    metrics_.total_execution_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start).count();
+    metrics_.total_operations = num_steps * num_nodes * iterations_per_node;
+    metrics_.node_processes = metrics_.total_operations;
+    metrics_.update_performance();
+}
 
-    metrics_.total_execution_time_ns = mission_duration.count();
+void AnalogCellularEngineAVX2::runMissionGenerated(
+    SignalGenerator generator,
+    void* user_data,
+    std::uint64_t num_steps,
+    std::uint32_t iterations_per_node,
+    std::uint32_t block_steps
+) {
+    #ifdef _OPENMP
+    omp_set_dynamic(0);
+    omp_set_num_threads(omp_get_max_threads());
+    #endif
+
+    metrics_.reset();
+    auto mission_start = std::chrono::high_resolution_clock::now();
+
+    runNodeParallelMission(nodes, num_steps, iterations_per_node, block_steps, true,
+        [&](std::uint64_t step_begin, std::uint32_t step_count, int node_begin, int node_count,
+            double* tile_in, double* tile_ctl) {
+            generator(user_data, step_begin, step_count, static_cast<std::uint32_t>(node_begin),
+                      static_cast<std::uint32_t>(node_count), tile_in, tile_ctl);
+            MissionDriveBlock drive;
+            drive.input = tile_in;
+            drive.control = tile_ctl;
+            drive.stride = static_cast<std::size_t>(node_count);
+            return drive;
+        });
+
+    auto mission_end = std::chrono::high_resolution_clock::now();
+    metrics_.total_execution_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start).count();
     metrics_.total_operations = num_steps * nodes.size() * iterations_per_node;
     metrics_.node_processes = metrics_.total_operations;
     metrics_.update_performance();
+}
 
-    metrics_.print_metrics();
-    std::cout << "=========================================" << std::endl;
+void AnalogCellularEngineAVX2::runMissionOscillators(
+    const dase::OscillatorBank& bank,
+    std::uint64_t num_steps,
+    std::uint32_t iterations_per_node
+) {
+    if (bank.size() != nodes.size()) {
+        throw std::invalid_argument("runMissionOscillators: need one oscillator per node");
+    }
+    runMissionGenerated(dase::OscillatorBank::missionGenerator, const_cast<dase::OscillatorBank*>(&bank),
+                        num_steps, iterations_per_node, 64);
 }
 
 // New: The massive benchmark function to simulate a continuous heavy load
@@ -891,6 +1420,7 @@ void AnalogCellularEngineAVX2::runMassiveBenchmark(int iterations) {
     std::cout << "🖥️  CPU Features:" << std::endl;
     std::cout << "   AVX2: " << (CPUFeatures::hasAVX2() ? "✅" : "❌") << std::endl;
     std::cout << "   FMA:  " << (CPUFeatures::hasFMA() ? "✅" : "❌") << std::endl;
+    std::cout << "   Kernels: " << CPUFeatures::dispatchLevel() << std::endl;
     
     // Warmup
     std::cout << "🔥 Warming up..." << std::endl;
@@ -957,13 +1487,15 @@ double AnalogCellularEngineAVX2::runDragRaceBenchmark(int num_runs) {
         auto start_time = std::chrono::high_resolution_clock::now();
         
         #pragma omp parallel for
-        for (int i = 0; i < nodes.size(); ++i) {
+        for (int i = 0; i < static_cast<int>(nodes.size()); ++i) {
             // This is the short-duration, high-intensity workload
+            AnalogUniversalNodeAVX2 node = nodes.load(i);
             for(int j = 0; j < num_iterations; ++j) {
                 double input_signal = 1.0;
                 double control_pattern = 1.0;
-                nodes[i].processSignalAVX2(input_signal, control_pattern, 0.0);
+                node.processSignalAVX2(input_signal, control_pattern, 0.0);
             }
+            nodes.store(i, node);
         }
         
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -983,29 +1515,42 @@ double AnalogCellularEngineAVX2::runDragRaceBenchmark(int num_runs) {
 
 double AnalogCellularEngineAVX2::processSignalWaveAVX2(double input_signal, double control_pattern) {
     double total_output = 0.0;
+    const AnalogKernelTable& kernels = analogKernels();
 
     #ifdef _OPENMP
     omp_set_dynamic(0);
     omp_set_num_threads(omp_get_max_threads());
     #endif
 
+    // The control ripple sin((i + pass)·0.1) only depends on i + pass, and the
+    // harmonic aux signal only on the pass: tabulate both once per call
+    const int num_nodes = static_cast<int>(nodes.size());
+    std::vector<double> ripple_arg(static_cast<size_t>(num_nodes) + 9);
+    for (size_t k = 0; k < ripple_arg.size(); k++) ripple_arg[k] = static_cast<double>(k) * 0.1;
+    std::vector<double> ripple(ripple_arg.size());
+    dase::sinCosArray(ripple_arg.data(), ripple.data(), nullptr, ripple.size());
+
+    double aux_by_pass[10];
+    for (int pass = 0; pass < 10; pass++) {
+        alignas(32) float harmonics_result[8];
+        kernels.generate_harmonics(static_cast<float>(input_signal),
+                                   static_cast<float>(pass) * 0.1f, harmonics_result);
+        double aux_signal = input_signal * 0.5;
+        for (int h = 0; h < 8; h++) {
+            aux_signal += static_cast<double>(harmonics_result[h]);
+        }
+        aux_by_pass[pass] = aux_signal;
+    }
+
     #pragma omp parallel for reduction(+:total_output) schedule(dynamic, 2)
-    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
+    for (int i = 0; i < num_nodes; i++) {
+        AnalogUniversalNodeAVX2 node = nodes.load(i);
         for (int pass = 0; pass < 10; pass++) {
-            double control = control_pattern + std::sin(static_cast<double>(i + pass) * 0.1) * 0.3;
-            double aux_signal = input_signal * 0.5;
-
-            alignas(32) float harmonics_result[8];
-            AVX2Math::generate_harmonics_avx2(static_cast<float>(input_signal),
-                                             static_cast<float>(pass) * 0.1f, harmonics_result);
-
-            for (int h = 0; h < 8; h++) {
-                aux_signal += static_cast<double>(harmonics_result[h]);
-            }
-
-            double output = nodes[i].processSignalAVX2(input_signal, control, aux_signal);
+            double control = control_pattern + ripple[static_cast<size_t>(i + pass)] * 0.3;
+            double output = node.processSignalAVX2(input_signal, control, aux_by_pass[pass]);
             total_output += output;
         }
+        nodes.store(i, node);
     }
 
     return total_output / (static_cast<double>(nodes.size()) * 10.0);
@@ -1037,6 +1582,7 @@ void AnalogCellularEngineAVX2::runBuiltinBenchmark(int iterations) {
     std::cout << "🖥️  CPU Features:" << std::endl;
     std::cout << "   AVX2: " << (CPUFeatures::hasAVX2() ? "✅" : "❌") << std::endl;
     std::cout << "   FMA:  " << (CPUFeatures::hasFMA() ? "✅" : "❌") << std::endl;
+    std::cout << "   Kernels: " << CPUFeatures::dispatchLevel() << std::endl;
     
     std::cout << "🔥 Warming up..." << std::endl;
     for (int i = 0; i < 100; i++) {
@@ -1078,35 +1624,57 @@ void AnalogCellularEngineAVX2::runBuiltinBenchmark(int iterations) {
 }
 
 void AnalogCellularEngineAVX2::processBlockFrequencyDomain(std::vector<double>& signal_block) {
-    int N = static_cast<int>(signal_block.size());  // Safe cast - validated in bounds
-    fftw_complex* in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    fftw_complex* out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    fftw_plan p = fftw_plan_dft_1d(N, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
+    const int N = static_cast<int>(signal_block.size());  // Safe cast - validated in bounds
+    if (N == 0) return;
 
-    for (int i = 0; i < N; ++i) {
-        in[i][0] = signal_block[i];
-        in[i][1] = 0;
-    }
+    // Real input: r2c/c2r plans shared across engines and threads, per-thread buffers
+    const dase::RealFFTPlanCache::Plans plans = dase::RealFFTPlanCache::instance().get(N);
+    dase::RealFFTScratch& scratch = dase::RealFFTScratch::local(static_cast<size_t>(N));
+    std::copy(signal_block.begin(), signal_block.end(), scratch.real);
 
-    fftw_execute(p);
+    fftw_execute_dft_r2c(plans.forward, scratch.real, scratch.spectrum);
+    applyFrequencyMask(scratch.spectrum, N);
+    fftw_execute_dft_c2r(plans.inverse, scratch.spectrum, scratch.real);
 
-    // --- MANIPULATE FREQUENCIES HERE (e.g., a simple filter) ---
-    for (int i = N / 4; i < (N * 3 / 4); ++i) {
-         out[i][0] = 0;
-         out[i][1] = 0;
+    const double scale = 1.0 / N;
+    for (int i = 0; i < N; ++i) {
+        signal_block[i] = scratch.real[i] * scale;
     }
+}
 
-    fftw_plan p_inv = fftw_plan_dft_1d(N, out, in, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fftw_execute(p_inv);
+void AnalogCellularEngineAVX2::setFrequencyBand(double low, double high) {
+    if (!(low >= 0.0 && low <= high)) {
+        throw std::invalid_argument("setFrequencyBand: need 0 <= low <= high");
+    }
+    band_low_ = low;
+    band_high_ = high;
+}
 
-    for (int i = 0; i < N; ++i) {
-        signal_block[i] = in[i][0] / N;
+void AnalogCellularEngineAVX2::setFrequencyMask(std::size_t block_size, std::vector<double> gains) {
+    if (!gains.empty() && gains.size() != block_size / 2 + 1) {
+        throw std::invalid_argument("setFrequencyMask: need block_size / 2 + 1 gains");
     }
+    mask_block_size_ = gains.empty() ? 0 : block_size;
+    mask_gains_ = std::move(gains);
+}
 
-    fftw_destroy_plan(p);
-    fftw_destroy_plan(p_inv);
-    fftw_free(in);
-    fftw_free(out);
+void AnalogCellularEngineAVX2::applyFrequencyMask(fftw_complex* spectrum, int N) const {
+    const int bins = N / 2 + 1;
+    if (static_cast<std::size_t>(N) == mask_block_size_) {
+        for (int k = 0; k < bins; ++k) {
+            spectrum[k][0] *= mask_gains_[k];
+            spectrum[k][1] *= mask_gains_[k];
+        }
+        return;
+    }
+    // Bin k is k / N cycles per sample
+    for (int k = 0; k < bins; ++k) {
+        const double f = static_cast<double>(k) / N;
+        if (f < band_low_ || f >= band_high_) {
+            spectrum[k][0] = 0.0;
+            spectrum[k][1] = 0.0;
+        }
+    }
 }
 
 EngineMetrics AnalogCellularEngineAVX2::getMetrics() const noexcept {
@@ -1121,11 +1689,21 @@ void AnalogCellularEngineAVX2::resetMetrics() {
     metrics_.reset();
 }
 
+// One draw per call from a counter (thread-safe; no shared generator state).
+// The draws use the last counter step so they never collide with a batch.
 double AnalogCellularEngineAVX2::generateNoiseSignal() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::normal_distribution<double> dist(0.0, noise_level);
-    return dist(gen);
+    const uint64_t draw = noise_draws.fetch_add(1, std::memory_order_relaxed);
+    return noise_level * noise_rng.normal(UINT64_MAX, draw);
+}
+
+void AnalogCellularEngineAVX2::generateNoiseBatch(double* out, size_t count, uint64_t step) const {
+    if (!out) return;
+    noise_rng.fillNormal(out, count, step, 0.0, noise_level);
+}
+
+void AnalogCellularEngineAVX2::setNoiseSeed(uint64_t seed) {
+    noise_rng.setSeed(seed);
+    noise_draws.store(0, std::memory_order_relaxed);
 }
 
 double AnalogCellularEngineAVX2::calculateInterNodeCoupling(size_t node_index) {
@@ -1134,10 +1712,10 @@ double AnalogCellularEngineAVX2::calculateInterNodeCoupling(size_t node_index) {
     // Simple nearest-neighbor coupling
     double coupling = 0.0;
     if (node_index > 0) {
-        coupling += nodes[node_index - 1].getOutput() * 0.1;
+        coupling += nodes.current_output[node_index - 1] * 0.1;
     }
     if (node_index < nodes.size() - 1) {
-        coupling += nodes[node_index + 1].getOutput() * 0.1;
+        coupling += nodes.current_output[node_index + 1] * 0.1;
     }
     
     return coupling;
@@ -1176,6 +1754,18 @@ bool CPUFeatures::hasFMA() noexcept {
     #endif
 }
 
+bool CPUFeatures::hasSSE41() noexcept {
+    return checkCPUID(1, 0, 2, 19); // ECX bit 19 = SSE4.1
+}
+
+bool CPUFeatures::hasAVX512F() noexcept {
+    return checkCPUID(7, 0, 1, 16); // EBX bit 16 = AVX-512F
+}
+
+const char* CPUFeatures::dispatchLevel() noexcept {
+    return dase::simdLevelName(dase::activeSimdLevel());
+}
+
 bool CPUFeatures::checkCPUID(int function, int subfunction, int reg, int bit) {
     #ifdef _WIN32
     int cpui[4];
@@ -1195,12 +1785,15 @@ bool CPUFeatures::checkCPUID(int function, int subfunction, int reg, int bit) {
 
 void CPUFeatures::printCapabilities() noexcept {
     std::cout << "CPU Features Detected:" << std::endl;
-    std::cout << "  AVX2: " << (hasAVX2() ? "✅ Supported" : "❌ Not Available") << std::endl;
-    std::cout << "  FMA:  " << (hasFMA() ? "✅ Supported" : "❌ Not Available") << std::endl;
+    std::cout << "  SSE4.1:   " << (hasSSE41() ? "✅ Supported" : "❌ Not Available") << std::endl;
+    std::cout << "  AVX2:     " << (hasAVX2() ? "✅ Supported" : "❌ Not Available") << std::endl;
+    std::cout << "  FMA:      " << (hasFMA() ? "✅ Supported" : "❌ Not Available") << std::endl;
+    std::cout << "  AVX-512F: " << (hasAVX512F() ? "✅ Supported" : "❌ Not Available") << std::endl;
+    std::cout << "  Kernels:  " << dispatchLevel() << " (runtime dispatch)" << std::endl;
 
-    if (hasAVX2()) {
+    if (dase::simdAtLeast(dase::SimdLevel::AVX2)) {
         std::cout << "🚀 AVX2 acceleration will provide 2-3x speedup!" << std::endl;
     } else {
-        std::cout << "⚠️  Falling back to scalar operations" << std::endl;
+        std::cout << "⚠️  Falling back to SSE4.1 / scalar kernels" << std::endl;
     }
 }
@@ -1,8 +1,13 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
+#include "counter_rng.h"
+#include "numa_memory.h"
+
+namespace dase { class OscillatorBank; }
 
 // ============================================================================
 // ALIGNED ALLOCATOR (64-byte cache-line alignment for AVX2 optimization)
@@ -28,37 +33,14 @@ public:
     template<typename U>
     aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
 
+    // Shared with AlignedAllocator: large blocks are first-touched by
+    // their owning OpenMP threads (numa_memory.h)
     pointer allocate(size_type n) {
-        if (n == 0) return nullptr;
-
-        size_type alignment = Alignment;
-        size_type size = n * sizeof(T);
-
-        void* ptr = nullptr;
-
-#ifdef _WIN32
-        ptr = _aligned_malloc(size, alignment);
-#else
-        if (posix_memalign(&ptr, alignment, size) != 0) {
-            ptr = nullptr;
-        }
-#endif
-
-        if (!ptr) {
-            throw std::bad_alloc();
-        }
-
-        return static_cast<pointer>(ptr);
+        return static_cast<pointer>(dase::allocateAligned(n * sizeof(T), Alignment));
     }
 
-    void deallocate(pointer p, size_type) noexcept {
-        if (p) {
-#ifdef _WIN32
-            _aligned_free(p);
-#else
-            free(p);
-#endif
-        }
+    void deallocate(pointer p, size_type n) noexcept {
+        dase::deallocateAligned(p, n * sizeof(T));
     }
 
     template<typename U, typename... Args>
@@ -86,8 +68,12 @@ bool operator!=(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2
 // CPU FEATURES
 // ============================================================================
 struct CPUFeatures {
+    static bool hasSSE41() noexcept;
     static bool hasAVX2() noexcept;
     static bool hasFMA() noexcept;
+    static bool hasAVX512F() noexcept;
+    // SIMD level the engine kernels dispatch to ("scalar", "sse4", "avx2", "avx512")
+    static const char* dispatchLevel() noexcept;
     static bool checkCPUID(int function, int subfunction, int reg, int bit);
     static void printCapabilities() noexcept;
 };
@@ -180,20 +166,96 @@ public:
     }
 };
 
+// ============================================================================
+// ANALOG NODE STATE (SoA)
+// ============================================================================
+// Engine-side node storage: one 64-byte aligned array per field, so the
+// Phase 4C kernels load and store whole vectors of nodes without gathers.
+// AnalogUniversalNodeAVX2 stays the per-node interface: load() copies a
+// node out, store() writes it back.
+struct AnalogNodeStateSoA {
+    template<typename T>
+    using Array = std::vector<T, aligned_allocator<T, 64>>;
+
+    Array<double>  integrator_state;
+    Array<double>  previous_input;
+    Array<double>  current_output;
+    Array<double>  feedback_gain;
+    Array<int>     node_id;
+    Array<int16_t> x;
+    Array<int16_t> y;
+    Array<int16_t> z;
+
+    AnalogNodeStateSoA() = default;
+    explicit AnalogNodeStateSoA(std::size_t num_nodes) { resize(num_nodes); }
+
+    std::size_t size() const noexcept { return integrator_state.size(); }
+
+    // Heap bytes of the field arrays for num_nodes nodes
+    static std::size_t estimateMemoryUsage(std::size_t num_nodes) noexcept {
+        return num_nodes * (4 * sizeof(double) + sizeof(int) + 3 * sizeof(int16_t));
+    }
+
+    void resize(std::size_t num_nodes) {
+        integrator_state.assign(num_nodes, 0.0);
+        previous_input.assign(num_nodes, 0.0);
+        current_output.assign(num_nodes, 0.0);
+        feedback_gain.assign(num_nodes, 0.0);
+        node_id.assign(num_nodes, 0);
+        x.assign(num_nodes, 0);
+        y.assign(num_nodes, 0);
+        z.assign(num_nodes, 0);
+    }
+
+    AnalogUniversalNodeAVX2 load(std::size_t i) const {
+        AnalogUniversalNodeAVX2 node;
+        node.integrator_state = integrator_state[i];
+        node.previous_input = previous_input[i];
+        node.current_output = current_output[i];
+        node.feedback_gain = feedback_gain[i];
+        node.node_id = node_id[i];
+        node.x = x[i];
+        node.y = y[i];
+        node.z = z[i];
+        return node;
+    }
+
+    void store(std::size_t i, const AnalogUniversalNodeAVX2& node) {
+        integrator_state[i] = node.integrator_state;
+        previous_input[i] = node.previous_input;
+        current_output[i] = node.current_output;
+        feedback_gain[i] = node.feedback_gain;
+        node_id[i] = node.node_id;
+        x[i] = node.x;
+        y[i] = node.y;
+        z[i] = node.z;
+    }
+};
+
 // ============================================================================
 // ANALOG CELLULAR ENGINE AVX2
 // ============================================================================
 class AnalogCellularEngineAVX2 {
 private:
-    // Use 64-byte aligned allocator for cache-line optimization
-    std::vector<AnalogUniversalNodeAVX2, aligned_allocator<AnalogUniversalNodeAVX2, 64>> nodes;
+    // Node state as 64-byte aligned field arrays (see AnalogNodeStateSoA)
+    AnalogNodeStateSoA nodes;
     double system_frequency;
     double noise_level;
+    dase::CounterRNG noise_rng;             // Noise keyed by (seed, step, index)
+    std::atomic<std::uint64_t> noise_draws; // Counter of generateNoiseSignal() calls
 
     // FIX C2.1: Per-instance metrics instead of global static
     // This prevents data races when multiple engines run concurrently
     EngineMetrics metrics_;
 
+    // Block filter mask (configure between blocks; read by processBlockFrequencyDomain)
+    double band_low_ = 0.0;
+    double band_high_ = 0.25;
+    std::size_t mask_block_size_ = 0;
+    std::vector<double> mask_gains_;
+
+    void applyFrequencyMask(double (*spectrum)[2], int N) const;
+
 public:
     explicit AnalogCellularEngineAVX2(std::size_t num_nodes);
 
@@ -213,12 +275,45 @@ public:
                                      std::uint64_t num_steps,
                                      std::uint32_t iterations_per_node = 30);
 
-    // Phase 4C: AVX2 spatial vectorization (process 4 nodes in parallel)
+    // Phase 4C: SIMD spatial vectorization (4 nodes per vector, 8 on AVX-512)
     void runMissionOptimized_Phase4C(const double* input_signals,
                                      const double* control_patterns,
                                      std::uint64_t num_steps,
                                      std::uint32_t iterations_per_node = 30);
 
+    // Per-node drive for the node-parallel missions: StepMajor holds one row
+    // per step, element [step * num_nodes + node]; NodeMajor one row per
+    // node, element [node * num_steps + step]
+    enum class SignalLayout : int { StepMajor = 0, NodeMajor = 1 };
+
+    // Fills input / control for steps [step_begin, step_begin + step_count) of
+    // nodes [node_begin, node_begin + node_count), step-major within the block
+    // (out[s * node_count + n]). Called concurrently by the mission threads.
+    using SignalGenerator = void (*)(void* user_data, std::uint64_t step_begin, std::uint32_t step_count,
+                                     std::uint32_t node_begin, std::uint32_t node_count,
+                                     double* input_out, double* control_out);
+
+    // Phase 4C with every node driven by its own signal (single parallel region,
+    // each thread streams its slice of the [steps x nodes] drive)
+    void runMissionPerNode(const double* input_signals,
+                           const double* control_patterns,
+                           std::uint64_t num_steps,
+                           SignalLayout layout = SignalLayout::StepMajor,
+                           std::uint32_t iterations_per_node = 30);
+
+    // As runMissionPerNode, drive produced by generator in blocks of block_steps
+    void runMissionGenerated(SignalGenerator generator,
+                             void* user_data,
+                             std::uint64_t num_steps,
+                             std::uint32_t iterations_per_node = 30,
+                             std::uint32_t block_steps = 64);
+
+    // Per-node mission driven by one oscillator per node (bank.size() must
+    // equal the node count): input sin, control cos of each oscillator
+    void runMissionOscillators(const dase::OscillatorBank& bank,
+                               std::uint64_t num_steps,
+                               std::uint32_t iterations_per_node = 30);
+
     void runMassiveBenchmark(int iterations);
     double runDragRaceBenchmark(int num_runs);
     void runBuiltinBenchmark(int iterations);
@@ -227,15 +322,38 @@ public:
     double performSignalSweepAVX2(double frequency);
     double processSignalWaveAVX2(double input_signal, double control_pattern);
 
-    // Frequency domain processing (takes std::vector<double>&, not const std::vector<float>&)
+    // Frequency domain processing (takes std::vector<double>&, not const std::vector<float>&):
+    // real FFT with cached plans, frequency mask, inverse FFT, in place
     void processBlockFrequencyDomain(std::vector<double>& signal_block);
 
+    // Block filter pass band [low, high) in cycles/sample (0..0.5); other bins are
+    // zeroed. Default [0, 0.25): the previous fixed N/4 low-pass.
+    void setFrequencyBand(double low, double high);
+    // Per-bin gains (block_size / 2 + 1) for blocks of exactly block_size samples,
+    // used instead of the band; empty gains clear the mask
+    void setFrequencyMask(std::size_t block_size, std::vector<double> gains);
+    double getFrequencyBandLow() const noexcept { return band_low_; }
+    double getFrequencyBandHigh() const noexcept { return band_high_; }
+
     // Helper functions
     double calculateInterNodeCoupling(std::size_t node_index);
     void printLiveMetrics();
     void resetMetrics();
     double generateNoiseSignal();
 
+    // Reproducible noise: out[i] = noise_level * N(0,1) at (seed, step, i),
+    // filled in parallel and independent of the thread count
+    void generateNoiseBatch(double* out, std::size_t count, std::uint64_t step) const;
+    void setNoiseSeed(std::uint64_t seed);
+    std::uint64_t getNoiseSeed() const { return noise_rng.seed(); }
+
+    // Node access: per-node copies, or the SoA arrays the missions update
+    std::size_t getNodeCount() const noexcept { return nodes.size(); }
+    AnalogUniversalNodeAVX2 getNode(std::size_t index) const { return nodes.load(index); }
+    void setNode(std::size_t index, const AnalogUniversalNodeAVX2& node) { nodes.store(index, node); }
+    const AnalogNodeStateSoA& getNodeState() const noexcept { return nodes; }
+    AnalogNodeStateSoA& getNodeStateMutable() noexcept { return nodes; }
+
     // Metrics access
     EngineMetrics getMetrics() const noexcept;
 };
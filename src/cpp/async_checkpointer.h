@@ -0,0 +1,257 @@
+/**
+ * Asynchronous Double-Buffered Checkpointing
+ *
+ * capture() copies an engine's checkpoint sections into one of two
+ * long-lived staging writers and returns; a background thread writes the
+ * staged checkpoint (throttled, optionally fsync'd) while the caller keeps
+ * time-stepping. The time-stepping thread only stalls for the memcpy, plus
+ * any wait for a free slot when checkpoints are requested faster than the
+ * disk absorbs them.
+ *
+ * Files are named <directory>/<prefix>_<step>.dckpt; only the newest
+ * keep_last successful checkpoints are kept.
+ */
+
+#pragma once
+
+#include "checkpoint_file.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dase {
+
+struct CheckpointPolicy {
+    std::string directory = ".";
+    std::string prefix = "checkpoint";
+    size_t keep_last = 2;              // 0 keeps every checkpoint
+    double max_write_mb_per_s = 0.0;   // <= 0: unthrottled
+    bool fsync = true;
+};
+
+/**
+ * Outcome of one checkpoint
+ */
+struct CheckpointRecord {
+    uint64_t step = 0;
+    std::string path;
+    uint64_t bytes = 0;
+    double stall_ms = 0.0;        // Time capture() held the caller
+    double write_ms = 0.0;        // Background write, rename and fsync
+    double write_mb_per_s = 0.0;
+    bool ok = false;
+    std::string error;
+};
+
+/**
+ * Totals over the checkpointer's lifetime
+ */
+struct CheckpointTotals {
+    uint64_t written = 0;
+    uint64_t failed = 0;
+    uint64_t bytes = 0;
+    double stall_ms = 0.0;
+    double max_stall_ms = 0.0;
+    double write_ms = 0.0;
+};
+
+class AsyncCheckpointer {
+public:
+    static constexpr size_t kHistory = 16;  // Records kept for recent()
+
+    explicit AsyncCheckpointer(const CheckpointPolicy& policy)
+        : policy_(policy), stop_(false), thread_([this]() { writerLoop(); }) {}
+
+    ~AsyncCheckpointer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_writer_.notify_all();
+        thread_.join();
+    }
+
+    AsyncCheckpointer(const AsyncCheckpointer&) = delete;
+    AsyncCheckpointer& operator=(const AsyncCheckpointer&) = delete;
+
+    const CheckpointPolicy& policy() const { return policy_; }
+
+    /**
+     * Stage the engine's checkpoint for step and queue it for writing
+     *
+     * Blocks only while both staging slots are busy and for the copy.
+     */
+    template <typename Engine>
+    void capture(const Engine& engine, uint64_t step) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        slot_freed_.wait(lock, [this]() { return freeSlot() != nullptr; });
+        Slot* slot = freeSlot();
+        slot->state = SlotState::Staging;
+        lock.unlock();
+
+        CheckpointWriter live;
+        engine.saveCheckpoint(live);
+        slot->staging.copyFrom(live);
+        slot->step = step;
+        slot->stall_ms = elapsedMs(start);
+
+        lock.lock();
+        slot->state = SlotState::Queued;
+        slot->sequence = next_sequence_++;
+        lock.unlock();
+        wake_writer_.notify_one();
+    }
+
+    /**
+     * Wait until every queued checkpoint has been written
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        slot_freed_.wait(lock, [this]() {
+            return std::all_of(std::begin(slots_), std::end(slots_),
+                               [](const Slot& slot) { return slot.state == SlotState::Free; });
+        });
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<size_t>(std::count_if(std::begin(slots_), std::end(slots_),
+            [](const Slot& slot) { return slot.state != SlotState::Free; }));
+    }
+
+    std::vector<CheckpointRecord> recent() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::vector<CheckpointRecord>(history_.begin(), history_.end());
+    }
+
+    CheckpointTotals totals() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return totals_;
+    }
+
+    /**
+     * Retained checkpoint files, oldest first
+     */
+    std::vector<std::string> files() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::vector<std::string>(kept_.begin(), kept_.end());
+    }
+
+private:
+    enum class SlotState { Free, Staging, Queued, Writing };
+
+    struct Slot {
+        CheckpointWriter staging;
+        SlotState state = SlotState::Free;
+        uint64_t step = 0;
+        uint64_t sequence = 0;
+        double stall_ms = 0.0;
+    };
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Slot* freeSlot() {
+        for (Slot& slot : slots_) {
+            if (slot.state == SlotState::Free) return &slot;
+        }
+        return nullptr;
+    }
+
+    // Oldest queued slot (captures are written in order)
+    Slot* nextQueued() {
+        Slot* next = nullptr;
+        for (Slot& slot : slots_) {
+            if (slot.state == SlotState::Queued && (!next || slot.sequence < next->sequence)) {
+                next = &slot;
+            }
+        }
+        return next;
+    }
+
+    std::string pathFor(uint64_t step) const {
+        return policy_.directory + "/" + policy_.prefix + "_" + std::to_string(step) + ".dckpt";
+    }
+
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_writer_.wait(lock, [this]() { return stop_ || nextQueued() != nullptr; });
+            Slot* slot = nextQueued();
+            if (!slot) {
+                return;  // Stopping with nothing left to write
+            }
+            slot->state = SlotState::Writing;
+            lock.unlock();
+
+            CheckpointRecord record;
+            record.step = slot->step;
+            record.path = pathFor(slot->step);
+            record.bytes = slot->staging.dataBytes();
+            record.stall_ms = slot->stall_ms;
+
+            CheckpointWriteOptions options;
+            options.max_bytes_per_sec = policy_.max_write_mb_per_s * 1.0e6;
+            options.fsync = policy_.fsync;
+            const auto start = std::chrono::steady_clock::now();
+            record.ok = slot->staging.write(record.path, options, &record.error);
+            record.write_ms = elapsedMs(start);
+            if (record.write_ms > 0.0) {
+                record.write_mb_per_s = record.bytes / 1.0e6 / (record.write_ms / 1000.0);
+            }
+
+            lock.lock();
+            finish(record);
+            slot->state = SlotState::Free;
+            slot_freed_.notify_all();
+        }
+    }
+
+    // Called with mutex_ held
+    void finish(const CheckpointRecord& record) {
+        totals_.stall_ms += record.stall_ms;
+        totals_.max_stall_ms = std::max(totals_.max_stall_ms, record.stall_ms);
+        if (record.ok) {
+            totals_.written++;
+            totals_.bytes += record.bytes;
+            totals_.write_ms += record.write_ms;
+            if (kept_.empty() || kept_.back() != record.path) {
+                kept_.push_back(record.path);
+            }
+            while (policy_.keep_last > 0 && kept_.size() > policy_.keep_last) {
+                std::remove(kept_.front().c_str());
+                kept_.pop_front();
+            }
+        } else {
+            totals_.failed++;
+        }
+        history_.push_back(record);
+        if (history_.size() > kHistory) {
+            history_.pop_front();
+        }
+    }
+
+    const CheckpointPolicy policy_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_writer_;
+    std::condition_variable slot_freed_;
+    Slot slots_[2];
+    uint64_t next_sequence_ = 0;
+    bool stop_;
+    std::deque<CheckpointRecord> history_;
+    std::deque<std::string> kept_;
+    CheckpointTotals totals_;
+    std::thread thread_;  // Last: starts after every other member is ready
+};
+
+} // namespace dase
@@ -0,0 +1,565 @@
+/**
+ * Binary Checkpoint File
+ *
+ * Versioned container for engine checkpoints: a fixed header, a section
+ * table, then each section's raw array data, 64-byte aligned. Writing is
+ * one large sequential write per section into "<path>.tmp", renamed over
+ * <path> once complete, so a crash mid-write never clobbers the previous
+ * checkpoint. Reading maps the file and hands out pointers into the
+ * mapping, so restart is a validation of the table plus memcpy into the
+ * engine's arrays, with no parse step.
+ *
+ * Layout (little-endian):
+ *   CheckpointHeader                      64 bytes, magic "DASECKP1"
+ *   CheckpointSectionEntry[section_count] 64 bytes each
+ *   section data                          each at a 64-byte aligned offset
+ *
+ * Engines append their state with saveCheckpoint(CheckpointWriter&) and
+ * restore it with loadCheckpoint(const CheckpointReader&, std::string*).
+ * AsyncCheckpointer (async_checkpointer.h) stages and writes them off the
+ * time-stepping thread.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dase {
+
+constexpr uint32_t kCheckpointVersion = 1;
+constexpr size_t kCheckpointAlignment = 64;
+
+enum class CheckpointDType : uint32_t {
+    Bytes = 0,       // Opaque POD records (elem_size bytes each)
+    Float64 = 1,
+    Complex128 = 2,
+    UInt64 = 3,
+    UInt32 = 4,
+    Int64 = 5
+};
+
+template <typename T> struct CheckpointDTypeOf { static constexpr CheckpointDType value = CheckpointDType::Bytes; };
+template <> struct CheckpointDTypeOf<double> { static constexpr CheckpointDType value = CheckpointDType::Float64; };
+template <> struct CheckpointDTypeOf<std::complex<double>> { static constexpr CheckpointDType value = CheckpointDType::Complex128; };
+template <> struct CheckpointDTypeOf<uint64_t> { static constexpr CheckpointDType value = CheckpointDType::UInt64; };
+template <> struct CheckpointDTypeOf<uint32_t> { static constexpr CheckpointDType value = CheckpointDType::UInt32; };
+template <> struct CheckpointDTypeOf<int64_t> { static constexpr CheckpointDType value = CheckpointDType::Int64; };
+
+struct CheckpointHeader {
+    char magic[8];              // "DASECKP1"
+    uint32_t version;
+    uint32_t section_count;
+    char engine_type[32];       // e.g. "igsoa_complex_2d"
+    uint64_t file_size;         // Total bytes, checked against the mapped size
+    uint64_t reserved;
+};
+static_assert(sizeof(CheckpointHeader) == 64, "checkpoint header must stay 64 bytes");
+
+struct CheckpointSectionEntry {
+    char name[32];
+    uint32_t dtype;             // CheckpointDType
+    uint32_t elem_size;         // Bytes per element
+    uint64_t count;             // Elements
+    uint64_t offset;            // From file start, kCheckpointAlignment aligned
+    uint64_t reserved;
+};
+static_assert(sizeof(CheckpointSectionEntry) == 64, "checkpoint section entry must stay 64 bytes");
+
+/**
+ * Write pacing and durability
+ */
+struct CheckpointWriteOptions {
+    double max_bytes_per_sec = 0.0;  // Throttle section data; <= 0 writes flat out
+    bool fsync = false;              // Flush to stable storage before the rename
+};
+
+/**
+ * Checkpoint writer
+ *
+ * Sections reference caller memory until snapshot() copies them, so a
+ * synchronous write() costs no extra memory. writeAsync() snapshots first
+ * (a memcpy stall only) and writes on a background thread while the caller
+ * resumes the mission.
+ */
+class CheckpointWriter {
+public:
+    CheckpointWriter() = default;
+    explicit CheckpointWriter(const std::string& engine_type) : engine_type_(engine_type) {}
+
+    void setEngineType(const std::string& engine_type) { engine_type_ = engine_type; }
+
+    template <typename T>
+    void addArray(const std::string& name, const T* data, uint64_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint sections must be trivially copyable");
+        Section section;
+        section.name = name;
+        section.dtype = CheckpointDTypeOf<T>::value;
+        section.elem_size = sizeof(T);
+        section.count = count;
+        section.data = data;
+        sections_.push_back(std::move(section));
+    }
+
+    /**
+     * Add an array copied into writer-owned memory (for temporaries)
+     */
+    template <typename T>
+    void copyArray(const std::string& name, const T* data, uint64_t count) {
+        addArray(name, data, count);
+        Section& section = sections_.back();
+        const auto* bytes = reinterpret_cast<const char*>(data);
+        section.owned.assign(bytes, bytes + count * sizeof(T));
+        section.data = section.owned.data();
+    }
+
+    template <typename T>
+    void addScalar(const std::string& name, T value) {
+        copyArray(name, &value, 1);
+    }
+
+    /**
+     * Copy every referenced section into writer-owned memory
+     */
+    void snapshot() {
+        for (auto& section : sections_) {
+            if (section.owned.empty() && section.count > 0) {
+                const auto* bytes = static_cast<const char*>(section.data);
+                section.owned.assign(bytes, bytes + section.count * section.elem_size);
+                section.data = section.owned.data();
+            }
+        }
+    }
+
+    /**
+     * Become an owned copy of source
+     *
+     * Buffers already held by this writer are reused when the section sizes
+     * are unchanged, so a long-lived staging writer copies into warm memory
+     * instead of allocating (and page-faulting) a fresh snapshot each time.
+     */
+    void copyFrom(const CheckpointWriter& source) {
+        engine_type_ = source.engine_type_;
+        sections_.resize(source.sections_.size());
+        for (size_t s = 0; s < sections_.size(); s++) {
+            const Section& src = source.sections_[s];
+            Section& dst = sections_[s];
+            dst.name = src.name;
+            dst.dtype = src.dtype;
+            dst.elem_size = src.elem_size;
+            dst.count = src.count;
+            const size_t bytes = static_cast<size_t>(src.count * src.elem_size);
+            dst.owned.resize(bytes);
+            if (bytes > 0) {
+                std::memcpy(dst.owned.data(), src.data, bytes);
+            }
+            dst.data = dst.owned.data();
+        }
+    }
+
+    /**
+     * Total bytes of section data
+     */
+    uint64_t dataBytes() const {
+        uint64_t bytes = 0;
+        for (const auto& section : sections_) {
+            bytes += section.count * section.elem_size;
+        }
+        return bytes;
+    }
+
+    /**
+     * Write the checkpoint to path (via path + ".tmp" and rename)
+     */
+    bool write(const std::string& path, std::string* error = nullptr) const {
+        return write(path, CheckpointWriteOptions(), error);
+    }
+
+    bool write(const std::string& path, const CheckpointWriteOptions& options,
+               std::string* error = nullptr) const {
+        auto fail = [&](const std::string& message) {
+            if (error) *error = message;
+            return false;
+        };
+        if (engine_type_.size() >= sizeof(CheckpointHeader::engine_type)) {
+            return fail("Engine type too long: " + engine_type_);
+        }
+
+        std::vector<CheckpointSectionEntry> table(sections_.size());
+        uint64_t offset = align(sizeof(CheckpointHeader) + table.size() * sizeof(CheckpointSectionEntry));
+        for (size_t s = 0; s < sections_.size(); s++) {
+            const Section& section = sections_[s];
+            if (section.name.size() >= sizeof(CheckpointSectionEntry::name)) {
+                return fail("Section name too long: " + section.name);
+            }
+            CheckpointSectionEntry& entry = table[s];
+            std::memset(&entry, 0, sizeof(entry));
+            std::memcpy(entry.name, section.name.data(), section.name.size());
+            entry.dtype = static_cast<uint32_t>(section.dtype);
+            entry.elem_size = section.elem_size;
+            entry.count = section.count;
+            entry.offset = offset;
+            offset = align(offset + section.count * section.elem_size);
+        }
+
+        CheckpointHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "DASECKP1", 8);
+        header.version = kCheckpointVersion;
+        header.section_count = static_cast<uint32_t>(table.size());
+        std::memcpy(header.engine_type, engine_type_.data(), engine_type_.size());
+        header.file_size = offset;
+
+        const std::string tmp_path = path + ".tmp";
+        FILE* file = std::fopen(tmp_path.c_str(), "wb");
+        if (!file) {
+            return fail("Cannot open checkpoint file for writing: " + tmp_path);
+        }
+
+        static const char zeros[kCheckpointAlignment] = {};
+        Pacer pacer(options.max_bytes_per_sec);
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        if (ok && !table.empty()) {
+            ok = std::fwrite(table.data(), sizeof(CheckpointSectionEntry), table.size(), file) == table.size();
+        }
+        uint64_t position = sizeof(header) + table.size() * sizeof(CheckpointSectionEntry);
+        for (size_t s = 0; ok && s < sections_.size(); s++) {
+            const uint64_t pad = table[s].offset - position;
+            ok = pad == 0 || std::fwrite(zeros, 1, pad, file) == pad;
+            const uint64_t bytes = sections_[s].count * sections_[s].elem_size;
+            ok = ok && pacer.write(file, sections_[s].data, bytes);
+            position = table[s].offset + bytes;
+        }
+        const uint64_t tail = header.file_size - position;
+        ok = ok && (tail == 0 || std::fwrite(zeros, 1, tail, file) == tail);
+        ok = ok && (!options.fsync || syncFile(file));
+        ok = (std::fclose(file) == 0) && ok;
+
+        if (!ok) {
+            std::remove(tmp_path.c_str());
+            return fail("Failed writing checkpoint: " + tmp_path);
+        }
+        if (!replaceFile(tmp_path, path)) {
+            std::remove(tmp_path.c_str());
+            return fail("Cannot move checkpoint into place: " + path);
+        }
+        if (options.fsync) {
+            syncParentDirectory(path);
+        }
+        return true;
+    }
+
+    /**
+     * Snapshot, then write on a background thread
+     *
+     * The writer is consumed; the future yields write()'s result.
+     */
+    std::future<bool> writeAsync(const std::string& path) && {
+        snapshot();
+        auto self = std::make_shared<CheckpointWriter>(std::move(*this));
+        return std::async(std::launch::async, [self, path]() { return self->write(path); });
+    }
+
+private:
+    struct Section {
+        std::string name;
+        CheckpointDType dtype = CheckpointDType::Bytes;
+        uint32_t elem_size = 0;
+        uint64_t count = 0;
+        const void* data = nullptr;
+        std::vector<char> owned;
+    };
+
+    // Writes in fixed chunks, sleeping between them to hold a byte rate
+    class Pacer {
+    public:
+        explicit Pacer(double bytes_per_sec)
+            : bytes_per_sec_(bytes_per_sec), start_(std::chrono::steady_clock::now()) {}
+
+        bool write(FILE* file, const void* data, uint64_t bytes) {
+            const auto* cursor = static_cast<const char*>(data);
+            while (bytes > 0) {
+                const size_t chunk = static_cast<size_t>(std::min<uint64_t>(bytes, kChunkBytes));
+                if (std::fwrite(cursor, 1, chunk, file) != chunk) return false;
+                cursor += chunk;
+                bytes -= chunk;
+                written_ += chunk;
+                if (bytes_per_sec_ > 0.0) {
+                    const auto due = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(written_ / bytes_per_sec_));
+                    std::this_thread::sleep_until(due);
+                }
+            }
+            return true;
+        }
+
+    private:
+        static constexpr uint64_t kChunkBytes = 4u << 20;
+        double bytes_per_sec_;
+        std::chrono::steady_clock::time_point start_;
+        double written_ = 0.0;
+    };
+
+    static bool syncFile(FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)))) != 0;
+#else
+        return ::fsync(::fileno(file)) == 0;
+#endif
+    }
+
+    // Make the rename itself durable (POSIX; NTFS journals it already)
+    static void syncParentDirectory(const std::string& path) {
+#ifndef _WIN32
+        const size_t slash = path.find_last_of('/');
+        const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int fd = ::open(dir.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+#else
+        (void)path;
+#endif
+    }
+
+    static uint64_t align(uint64_t offset) {
+        return (offset + kCheckpointAlignment - 1) / kCheckpointAlignment * kCheckpointAlignment;
+    }
+
+    static bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    std::string engine_type_;
+    std::vector<Section> sections_;
+};
+
+/**
+ * Checkpoint reader over a read-only file mapping
+ */
+class CheckpointReader {
+public:
+    CheckpointReader() = default;
+    ~CheckpointReader() { close(); }
+
+    CheckpointReader(const CheckpointReader&) = delete;
+    CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+    /**
+     * Map a checkpoint and validate its header and section table
+     */
+    bool open(const std::string& path, std::string* error = nullptr) {
+        close();
+        auto fail = [&](const std::string& message) {
+            close();
+            if (error) *error = message;
+            return false;
+        };
+        if (!map(path)) {
+            return fail("Cannot map checkpoint file: " + path);
+        }
+        if (size_ < sizeof(CheckpointHeader)) {
+            return fail("Checkpoint file truncated: " + path);
+        }
+        const auto* header = reinterpret_cast<const CheckpointHeader*>(base_);
+        if (std::memcmp(header->magic, "DASECKP1", 8) != 0) {
+            return fail("Not a DASE checkpoint: " + path);
+        }
+        if (header->version != kCheckpointVersion) {
+            return fail("Unsupported checkpoint version " + std::to_string(header->version));
+        }
+        if (header->file_size != size_ ||
+            sizeof(CheckpointHeader) + uint64_t(header->section_count) * sizeof(CheckpointSectionEntry) > size_) {
+            return fail("Checkpoint file truncated: " + path);
+        }
+        const auto* table = reinterpret_cast<const CheckpointSectionEntry*>(base_ + sizeof(CheckpointHeader));
+        for (uint32_t s = 0; s < header->section_count; s++) {
+            const CheckpointSectionEntry& entry = table[s];
+            if (entry.offset % kCheckpointAlignment != 0 || entry.offset > size_ ||
+                (entry.elem_size != 0 && entry.count > (size_ - entry.offset) / entry.elem_size)) {
+                return fail("Corrupt checkpoint section table: " + path);
+            }
+        }
+        header_ = header;
+        table_ = table;
+        return true;
+    }
+
+    void close() {
+        if (base_) {
+#ifdef _WIN32
+            UnmapViewOfFile(base_);
+#else
+            ::munmap(const_cast<char*>(base_), size_);
+#endif
+        }
+        base_ = nullptr;
+        size_ = 0;
+        header_ = nullptr;
+        table_ = nullptr;
+    }
+
+    bool isOpen() const { return header_ != nullptr; }
+
+    std::string engineType() const {
+        if (!header_) return "";
+        return std::string(header_->engine_type, strnlen(header_->engine_type, sizeof(header_->engine_type)));
+    }
+
+    const CheckpointSectionEntry* find(const std::string& name) const {
+        if (!header_) return nullptr;
+        for (uint32_t s = 0; s < header_->section_count; s++) {
+            if (strnlen(table_[s].name, sizeof(table_[s].name)) == name.size() &&
+                std::memcmp(table_[s].name, name.data(), name.size()) == 0) {
+                return &table_[s];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Typed pointer into the mapping, or nullptr if the section is missing,
+     * has a different element type, or does not hold exactly `count` elements
+     */
+    template <typename T>
+    const T* array(const std::string& name, uint64_t count) const {
+        const CheckpointSectionEntry* entry = find(name);
+        if (!entry || entry->elem_size != sizeof(T) || entry->count != count ||
+            entry->dtype != static_cast<uint32_t>(CheckpointDTypeOf<T>::value)) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(base_ + entry->offset);
+    }
+
+    template <typename T>
+    bool scalar(const std::string& name, T& value) const {
+        const T* data = array<T>(name, 1);
+        if (!data) return false;
+        std::memcpy(&value, data, sizeof(T));
+        return true;
+    }
+
+    /**
+     * Copy a section into dst (count elements), false if it does not match
+     */
+    template <typename T>
+    bool copyTo(const std::string& name, T* dst, uint64_t count) const {
+        const T* data = array<T>(name, count);
+        if (!data) return false;
+        if (count > 0) {
+            std::memcpy(dst, data, count * sizeof(T));
+        }
+        return true;
+    }
+
+private:
+    bool map(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) return false;
+        base_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+        size_ = static_cast<uint64_t>(file_size.QuadPart);
+        return base_ != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) return false;
+        ::madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        base_ = static_cast<const char*>(addr);
+        size_ = static_cast<uint64_t>(st.st_size);
+        return true;
+#endif
+    }
+
+    const char* base_ = nullptr;
+    uint64_t size_ = 0;
+    const CheckpointHeader* header_ = nullptr;
+    const CheckpointSectionEntry* table_ = nullptr;
+};
+
+/**
+ * Check the engine type and a dimensions section before restoring anything
+ */
+inline bool checkCheckpointShape(const CheckpointReader& reader, const std::string& engine_type,
+                                 const std::vector<uint64_t>& dims, std::string* error,
+                                 const std::string& dims_section = "dims") {
+    auto fail = [&](const std::string& message) {
+        if (error) *error = message;
+        return false;
+    };
+    if (reader.engineType() != engine_type) {
+        return fail("Checkpoint is for " + reader.engineType() + ", not " + engine_type);
+    }
+    const uint64_t* stored = reader.array<uint64_t>(dims_section, dims.size());
+    if (!stored || !std::equal(dims.begin(), dims.end(), stored)) {
+        return fail("Checkpoint " + dims_section + " do not match the engine");
+    }
+    return true;
+}
+
+/**
+ * Save an engine to path (engine.saveCheckpoint + synchronous write)
+ */
+template <typename Engine>
+bool saveCheckpointFile(const Engine& engine, const std::string& path, std::string* error = nullptr) {
+    CheckpointWriter writer;
+    engine.saveCheckpoint(writer);
+    return writer.write(path, error);
+}
+
+/**
+ * Restore an engine from path (map + engine.loadCheckpoint)
+ */
+template <typename Engine>
+bool loadCheckpointFile(Engine& engine, const std::string& path, std::string* error = nullptr) {
+    CheckpointReader reader;
+    return reader.open(path, error) && engine.loadCheckpoint(reader, error);
+}
+
+} // namespace dase
@@ -0,0 +1,235 @@
+/**
+ * CPU Dispatch - Runtime SIMD Level Selection
+ *
+ * The portable build compiles for the x86-64 baseline (SSE2) and carries
+ * SSE4.1, AVX2+FMA and AVX-512 variants of the hot kernels, compiled with
+ * per-function target attributes (DASE_TARGET_SSE4 / _AVX2 / _AVX512).
+ * activeSimdLevel() picks one level for the process on first use:
+ *
+ *   1. the highest level the CPU and the OS support (CPUID, XGETBV: the
+ *      OS must save the YMM / ZMM state across context switches),
+ *   2. lowered by DASE_SIMD=scalar|sse4|avx2|avx512 in the environment,
+ *   3. never below the level the binary was compiled for (a -march=native
+ *      build cannot run its baseline code on a smaller CPU anyway).
+ *
+ * setSimdLevel() overrides the choice (capped to what the CPU supports);
+ * tests and benchmarks use it to run every variant on one machine. Kernels
+ * read the level once per call, outside their loops.
+ *
+ * Defining DASE_NO_SIMD_DISPATCH (or building for a non-x86 target) keeps
+ * only the compiled level: the target macros expand to nothing and
+ * DASE_SIMD_DISPATCH is 0, so guarded variants drop out.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(DASE_NO_SIMD_DISPATCH) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define DASE_SIMD_DISPATCH 1
+#else
+#define DASE_SIMD_DISPATCH 0
+#endif
+
+#if DASE_SIMD_DISPATCH
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// Variants a translation unit can contain: all of them when dispatching,
+// otherwise only those the build flags already enable
+#if DASE_SIMD_DISPATCH || defined(__SSE4_1__)
+#define DASE_SIMD_HAS_SSE4 1
+#else
+#define DASE_SIMD_HAS_SSE4 0
+#endif
+#if DASE_SIMD_DISPATCH || (defined(__AVX2__) && defined(__FMA__))
+#define DASE_SIMD_HAS_AVX2 1
+#else
+#define DASE_SIMD_HAS_AVX2 0
+#endif
+#if DASE_SIMD_DISPATCH || defined(__AVX512F__)
+#define DASE_SIMD_HAS_AVX512 1
+#else
+#define DASE_SIMD_HAS_AVX512 0
+#endif
+
+#if DASE_SIMD_HAS_SSE4
+#include <immintrin.h>
+#endif
+
+// Per-function instruction sets of the dispatched variants (MSVC emits any
+// intrinsic without /arch, so the attributes are GCC/Clang only)
+#if DASE_SIMD_DISPATCH && (defined(__GNUC__) || defined(__clang__))
+#define DASE_TARGET_SSE4 __attribute__((target("sse4.1")))
+#define DASE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define DASE_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define DASE_TARGET_SSE4
+#define DASE_TARGET_AVX2
+#define DASE_TARGET_AVX512
+#endif
+
+// Generic helpers called from the targeted variants must be inlined into
+// them to be compiled for that instruction set
+#if defined(_MSC_VER)
+#define DASE_ALWAYS_INLINE __forceinline
+#else
+#define DASE_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace dase {
+
+/**
+ * Instruction-set level of the dispatched kernels (ordered)
+ */
+enum class SimdLevel : int {
+    Scalar = 0,  // x86-64 baseline / portable C++
+    SSE4 = 1,    // SSE4.1 (2 doubles per register)
+    AVX2 = 2,    // AVX2 + FMA (4 doubles)
+    AVX512 = 3   // AVX-512F (8 doubles)
+};
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::SSE4: return "sse4";
+    case SimdLevel::AVX2: return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    case SimdLevel::Scalar: break;
+    }
+    return "scalar";
+}
+
+inline bool parseSimdLevel(const char* name, SimdLevel& out) {
+    if (!name) return false;
+    if (std::strcmp(name, "scalar") == 0) { out = SimdLevel::Scalar; return true; }
+    if (std::strcmp(name, "sse4") == 0) { out = SimdLevel::SSE4; return true; }
+    if (std::strcmp(name, "avx2") == 0) { out = SimdLevel::AVX2; return true; }
+    if (std::strcmp(name, "avx512") == 0) { out = SimdLevel::AVX512; return true; }
+    return false;
+}
+
+/**
+ * Level the compiler may already assume everywhere (from -m / -march / /arch)
+ */
+constexpr SimdLevel compiledSimdLevel() {
+#if defined(__AVX512F__)
+    return SimdLevel::AVX512;
+#elif defined(__AVX2__) && defined(__FMA__)
+    return SimdLevel::AVX2;
+#elif defined(__SSE4_1__)
+    return SimdLevel::SSE4;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+namespace cpu_dispatch_detail {
+
+#if DASE_SIMD_DISPATCH
+inline void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int r = 0; r < 4; r++) regs[r] = static_cast<unsigned>(out[r]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// XCR0: register state the OS saves on context switch
+inline unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+inline std::atomic<int>& selectedLevel() {
+    static std::atomic<int> level{-1};
+    return level;
+}
+
+} // namespace cpu_dispatch_detail
+
+/**
+ * Highest level this CPU and OS support
+ */
+inline SimdLevel detectSimdLevel() {
+#if DASE_SIMD_DISPATCH
+    using namespace cpu_dispatch_detail;
+    unsigned r[4];
+    cpuid(0, 0, r);
+    const unsigned max_leaf = r[0];
+
+    cpuid(1, 0, r);
+    const bool sse41 = (r[2] & (1u << 19)) != 0;
+    const bool fma = (r[2] & (1u << 12)) != 0;
+    const bool osxsave = (r[2] & (1u << 27)) != 0;
+    const bool avx = (r[2] & (1u << 28)) != 0;
+    if (!sse41) return SimdLevel::Scalar;
+    if (!osxsave || !avx || max_leaf < 7) return SimdLevel::SSE4;
+
+    const unsigned long long xcr0 = xgetbv0();
+    const bool ymm_saved = (xcr0 & 0x6) == 0x6;     // SSE + AVX state
+    const bool zmm_saved = (xcr0 & 0xE6) == 0xE6;   // + opmask, ZMM_Hi256, Hi16_ZMM
+    cpuid(7, 0, r);
+    const bool avx2 = (r[1] & (1u << 5)) != 0;
+    const bool avx512f = (r[1] & (1u << 16)) != 0;
+    if (!ymm_saved || !avx2 || !fma) return SimdLevel::SSE4;
+    if (!zmm_saved || !avx512f) return SimdLevel::AVX2;
+    return SimdLevel::AVX512;
+#else
+    return compiledSimdLevel();
+#endif
+}
+
+inline SimdLevel clampSimdLevel(SimdLevel requested) {
+    SimdLevel level = requested;
+    const SimdLevel supported = detectSimdLevel();
+    if (level > supported) level = supported;
+    if (level < compiledSimdLevel()) level = compiledSimdLevel();
+    return level;
+}
+
+/**
+ * Level the dispatched kernels run at (chosen once, see the file comment)
+ */
+inline SimdLevel activeSimdLevel() {
+    std::atomic<int>& selected = cpu_dispatch_detail::selectedLevel();
+    int level = selected.load(std::memory_order_relaxed);
+    if (level < 0) {
+        SimdLevel chosen = SimdLevel::AVX512;
+        SimdLevel from_env;
+        if (parseSimdLevel(std::getenv("DASE_SIMD"), from_env)) chosen = from_env;
+        level = static_cast<int>(clampSimdLevel(chosen));
+        selected.store(level, std::memory_order_relaxed);
+    }
+    return static_cast<SimdLevel>(level);
+}
+
+/**
+ * Force a level for the kernels dispatched from now on
+ *
+ * @return The level in effect (requested level capped to the CPU)
+ */
+inline SimdLevel setSimdLevel(SimdLevel requested) {
+    const SimdLevel level = clampSimdLevel(requested);
+    cpu_dispatch_detail::selectedLevel().store(static_cast<int>(level), std::memory_order_relaxed);
+    return level;
+}
+
+inline bool simdAtLeast(SimdLevel level) {
+    return activeSimdLevel() >= level;
+}
+
+} // namespace dase
@@ -7,7 +7,12 @@
 
 #include "dase_capi.h"
 #include "analog_universal_node_engine_avx2.h"
+#include "analog_stream_filter.h"
+#include "oscillator_bank.h"
 #include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
 
 // =============================================================================
 // HELPER: Cast between opaque handle and C++ pointer
@@ -21,6 +26,30 @@ static inline DaseEngineHandle to_c_handle(AnalogCellularEngineAVX2* engine) {
     return reinterpret_cast<DaseEngineHandle>(engine);
 }
 
+static inline dase::StreamFilter* to_cpp_filter(DaseStreamFilterHandle handle) {
+    return reinterpret_cast<dase::StreamFilter*>(handle);
+}
+
+// Construct a filter behind a C handle, mapping exceptions to status codes
+template <typename MakeTaps>
+static DaseStatus create_stream_filter(uint32_t block_size, DaseStreamFilterHandle* out_filter,
+                                       MakeTaps&& make_taps) {
+    if (!out_filter) return DASE_ERROR_NULL_POINTER;
+    *out_filter = nullptr;
+    if (block_size == 0) return DASE_ERROR_INVALID_PARAM;
+    try {
+        auto* filter = new dase::StreamFilter(make_taps(), block_size);
+        *out_filter = reinterpret_cast<DaseStreamFilterHandle>(filter);
+        return DASE_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    } catch (...) {
+        return DASE_ERROR_UNKNOWN;
+    }
+}
+
 // =============================================================================
 // EXTERN "C" IMPLEMENTATIONS
 // =============================================================================
@@ -199,6 +228,73 @@ void dase_run_mission_optimized_phase4c(
                                         num_steps, iterations_per_node);
 }
 
+DaseStatus dase_run_mission_per_node(
+    DaseEngineHandle handle,
+    const double* input_signals,
+    const double* control_patterns,
+    uint64_t num_steps,
+    DaseSignalLayout layout,
+    uint32_t iterations_per_node
+) {
+    if (!handle) return DASE_ERROR_NULL_HANDLE;
+    if (num_steps == 0) return DASE_SUCCESS;
+    if (!input_signals || !control_patterns) return DASE_ERROR_NULL_POINTER;
+    if (layout != DASE_SIGNALS_STEP_MAJOR && layout != DASE_SIGNALS_NODE_MAJOR) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+
+    auto* engine = to_cpp_engine(handle);
+    engine->runMissionPerNode(input_signals, control_patterns, num_steps,
+                              static_cast<AnalogCellularEngineAVX2::SignalLayout>(layout),
+                              iterations_per_node);
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_run_mission_generated(
+    DaseEngineHandle handle,
+    DaseSignalGenerator generator,
+    void* user_data,
+    uint64_t num_steps,
+    uint32_t iterations_per_node,
+    uint32_t block_steps
+) {
+    if (!handle) return DASE_ERROR_NULL_HANDLE;
+    if (!generator) return DASE_ERROR_NULL_POINTER;
+    if (block_steps == 0) return DASE_ERROR_INVALID_PARAM;
+    if (num_steps == 0) return DASE_SUCCESS;
+
+    auto* engine = to_cpp_engine(handle);
+    engine->runMissionGenerated(generator, user_data, num_steps, iterations_per_node, block_steps);
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_run_mission_oscillators(
+    DaseEngineHandle handle,
+    const double* angular_freqs,
+    const double* phases,
+    uint64_t num_steps,
+    uint32_t iterations_per_node
+) {
+    if (!handle) return DASE_ERROR_NULL_HANDLE;
+    if (!angular_freqs) return DASE_ERROR_NULL_POINTER;
+    if (num_steps == 0) return DASE_SUCCESS;
+
+    auto* engine = to_cpp_engine(handle);
+    try {
+        const std::size_t num_nodes = engine->getNodeCount();
+        dase::OscillatorBank bank;
+        for (std::size_t k = 0; k < num_nodes; ++k) {
+            bank.add(angular_freqs[k], phases ? phases[k] : 0.0);
+        }
+        engine->runMissionOscillators(bank, num_steps, iterations_per_node);
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    } catch (...) {
+        return DASE_ERROR_UNKNOWN;
+    }
+    return DASE_SUCCESS;
+}
+
 // -----------------------------------------------------------------------------
 // Metrics Retrieval
 // -----------------------------------------------------------------------------
@@ -231,6 +327,65 @@ void dase_get_metrics(
     }
 }
 
+// -----------------------------------------------------------------------------
+// Streaming Block Filter
+// -----------------------------------------------------------------------------
+
+DaseStatus dase_stream_filter_create(
+    const double* taps,
+    uint32_t num_taps,
+    uint32_t block_size,
+    DaseStreamFilterHandle* out_filter
+) {
+    if (!taps) {
+        if (out_filter) *out_filter = nullptr;
+        return DASE_ERROR_NULL_POINTER;
+    }
+    return create_stream_filter(block_size, out_filter, [&]() {
+        return std::vector<double>(taps, taps + num_taps);
+    });
+}
+
+DaseStatus dase_stream_filter_create_bandpass(
+    double low,
+    double high,
+    uint32_t num_taps,
+    uint32_t block_size,
+    DaseStreamFilterHandle* out_filter
+) {
+    return create_stream_filter(block_size, out_filter, [&]() {
+        return dase::StreamFilter::designBandPass(low, high, num_taps);
+    });
+}
+
+DaseStatus dase_stream_filter_process(
+    DaseStreamFilterHandle handle,
+    const double* input,
+    double* output,
+    uint64_t num_samples
+) {
+    if (!handle) return DASE_ERROR_NULL_HANDLE;
+    if (num_samples == 0) return DASE_SUCCESS;
+    if (!input || !output) return DASE_ERROR_NULL_POINTER;
+
+    to_cpp_filter(handle)->process(input, output, static_cast<std::size_t>(num_samples));
+    return DASE_SUCCESS;
+}
+
+void dase_stream_filter_reset(DaseStreamFilterHandle handle) {
+    if (handle) {
+        to_cpp_filter(handle)->reset();
+    }
+}
+
+uint32_t dase_stream_filter_latency(DaseStreamFilterHandle handle) {
+    return handle ? static_cast<uint32_t>(to_cpp_filter(handle)->latency()) : 0;
+}
+
+void dase_stream_filter_destroy(DaseStreamFilterHandle handle) {
+    delete to_cpp_filter(handle);
+}
+
 // -----------------------------------------------------------------------------
 // CPU Features
 // -----------------------------------------------------------------------------
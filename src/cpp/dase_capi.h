@@ -195,6 +195,104 @@ DASE_API void dase_run_mission_optimized_phase4c(
     uint32_t iterations_per_node
 );
 
+/**
+ * Layout of the per-node drive matrices of dase_run_mission_per_node.
+ */
+typedef enum {
+    DASE_SIGNALS_STEP_MAJOR = 0,  /* [steps x nodes]: element step * num_nodes + node */
+    DASE_SIGNALS_NODE_MAJOR = 1   /* [nodes x steps]: element node * num_steps + step */
+} DaseSignalLayout;
+
+/**
+ * Run a Phase 4C mission in which every node has its own input and control
+ * signal (no broadcast).
+ *
+ * Keeps the single parallel region: each thread streams its slice of the
+ * drive, a block of steps over one cache-sized node chunk at a time, with the
+ * next row prefetched. Step-major rows are read in place, node-major ones are
+ * transposed per block into a small per-thread tile. Replaces calling the
+ * broadcast missions once per step with one-step arrays.
+ *
+ * @param engine Handle to the engine
+ * @param input_signals Per-node input signals (num_steps * num_nodes values)
+ * @param control_patterns Per-node control patterns (same shape and layout)
+ * @param num_steps Number of mission steps
+ * @param layout DASE_SIGNALS_STEP_MAJOR or DASE_SIGNALS_NODE_MAJOR
+ * @param iterations_per_node Number of iterations to process per node
+ * @return Status code (DASE_SUCCESS on success)
+ */
+DASE_API DaseStatus dase_run_mission_per_node(
+    DaseEngineHandle engine,
+    const double* input_signals,
+    const double* control_patterns,
+    uint64_t num_steps,
+    DaseSignalLayout layout,
+    uint32_t iterations_per_node
+);
+
+/**
+ * Drive generator for dase_run_mission_generated: fill input_out and
+ * control_out for steps [step_begin, step_begin + step_count) of nodes
+ * [node_begin, node_begin + node_count), step-major within the block
+ * (index s * node_count + n).
+ *
+ * Called from the mission's worker threads, concurrently for disjoint node
+ * ranges; it must be thread-safe and must not call back into the engine.
+ */
+typedef void (*DaseSignalGenerator)(
+    void* user_data,
+    uint64_t step_begin,
+    uint32_t step_count,
+    uint32_t node_begin,
+    uint32_t node_count,
+    double* input_out,
+    double* control_out
+);
+
+/**
+ * Run a per-node Phase 4C mission whose drive is produced by a callback in
+ * blocks of block_steps steps (no [steps x nodes] matrix in memory).
+ *
+ * @param engine Handle to the engine
+ * @param generator Drive generator (see DaseSignalGenerator)
+ * @param user_data Passed through to every generator call
+ * @param num_steps Number of mission steps
+ * @param iterations_per_node Number of iterations to process per node
+ * @param block_steps Steps per generator call (e.g. 64; >= 1)
+ * @return Status code (DASE_SUCCESS on success)
+ */
+DASE_API DaseStatus dase_run_mission_generated(
+    DaseEngineHandle engine,
+    DaseSignalGenerator generator,
+    void* user_data,
+    uint64_t num_steps,
+    uint32_t iterations_per_node,
+    uint32_t block_steps
+);
+
+/**
+ * Run a per-node Phase 4C mission driven by one oscillator per node:
+ * input_k = sin(phase_k + angular_freq_k * step), control_k = cos(...).
+ *
+ * The drive is generated inside the mission by complex phase rotation
+ * (dase::OscillatorBank), a block of steps per node chunk, so no signal
+ * arrays are needed and generation costs far less than node processing.
+ *
+ * @param engine Handle to the engine
+ * @param angular_freqs Per-node angular frequency in radians per step (num_nodes values)
+ * @param phases Per-node initial phase (num_nodes values, or NULL for 0)
+ * @param num_steps Number of mission steps
+ * @param iterations_per_node Number of iterations to process per node
+ * @return Status code (DASE_SUCCESS on success)
+ */
+DASE_API DaseStatus dase_run_mission_oscillators(
+    DaseEngineHandle engine,
+    const double* angular_freqs,
+    const double* phases,
+    uint64_t num_steps,
+    uint32_t iterations_per_node
+);
+
 // =============================================================================
 // METRICS RETRIEVAL
 // =============================================================================
@@ -216,6 +314,73 @@ DASE_API void dase_get_metrics(
     uint64_t* out_total_ops
 );
 
+// =============================================================================
+// STREAMING BLOCK FILTER
+// =============================================================================
+
+/**
+ * Opaque pointer to a dase::StreamFilter (overlap-add FIR filter that keeps
+ * its state between calls, so a continuous signal can be fed in chunks).
+ */
+typedef struct DaseStreamFilter_C* DaseStreamFilterHandle;
+
+/**
+ * Create a streaming filter from an FIR impulse response.
+ *
+ * Output is the convolution taps * input delayed by block_size samples;
+ * each block costs one real FFT pair of the next power of two
+ * >= block_size + num_taps - 1.
+ *
+ * @param taps Impulse response (length: num_taps, copied)
+ * @param num_taps Number of taps (>= 1)
+ * @param block_size Samples per block, also the latency (>= 1)
+ * @param out_filter Output parameter for the filter handle (set only on success)
+ * @return Status code (DASE_SUCCESS on success)
+ */
+DASE_API DaseStatus dase_stream_filter_create(
+    const double* taps,
+    uint32_t num_taps,
+    uint32_t block_size,
+    DaseStreamFilterHandle* out_filter
+);
+
+/**
+ * Create a streaming windowed-sinc band-pass for [low, high) cycles/sample
+ * (0 <= low < high <= 0.5; low = 0 is a low-pass).
+ */
+DASE_API DaseStatus dase_stream_filter_create_bandpass(
+    double low,
+    double high,
+    uint32_t num_taps,
+    uint32_t block_size,
+    DaseStreamFilterHandle* out_filter
+);
+
+/**
+ * Filter the next num_samples of the stream (input and output may alias).
+ */
+DASE_API DaseStatus dase_stream_filter_process(
+    DaseStreamFilterHandle filter,
+    const double* input,
+    double* output,
+    uint64_t num_samples
+);
+
+/**
+ * Clear the stream history (the filter response is kept).
+ */
+DASE_API void dase_stream_filter_reset(DaseStreamFilterHandle filter);
+
+/**
+ * Latency in samples (the block size); 0 for a null handle.
+ */
+DASE_API uint32_t dase_stream_filter_latency(DaseStreamFilterHandle filter);
+
+/**
+ * Destroy a streaming filter.
+ */
+DASE_API void dase_stream_filter_destroy(DaseStreamFilterHandle filter);
+
 // =============================================================================
 // CPU FEATURES
 // =============================================================================
@@ -5,6 +5,8 @@
  * This module provides automatic caching of FFTW wisdom to dramatically
  * speed up FFT planning operations.
  *
+ * Status messages go to stderr: stdout is the JSON protocol channel of dase_cli.
+ *
  * Benefits:
  * - 100-1000x faster FFT initialization
  * - Persistent wisdom across runs
@@ -47,6 +49,13 @@ public:
         load_global_wisdom();
     }
 
+    /**
+     * Save accumulated wisdom without tearing FFTW down (live plans stay valid).
+     */
+    static void flush() {
+        save_global_wisdom();
+    }
+
     /**
      * Clean up FFTW resources.
      */
@@ -78,6 +87,47 @@ public:
         });
     }
 
+    /**
+     * Create 1D real-to-complex FFT plan with caching (n/2 + 1 output bins).
+     *
+     * @param n Transform size
+     * @param in Real input array (n values)
+     * @param out Complex output array (n/2 + 1 bins)
+     * @param flags Planning flags (default: FFTW_MEASURE)
+     * @return FFTW plan
+     */
+    static fftw_plan create_plan_r2c_1d(
+        int n,
+        double* in,
+        fftw_complex* out,
+        unsigned flags = FFTW_MEASURE
+    ) {
+        return create_plan_with_cache("rfft_1d_" + std::to_string(n), [&]() {
+            return fftw_plan_dft_r2c_1d(n, in, out, flags);
+        });
+    }
+
+    /**
+     * Create 1D complex-to-real FFT plan with caching (unnormalized inverse
+     * of create_plan_r2c_1d; the input array is overwritten).
+     *
+     * @param n Transform size
+     * @param in Complex input array (n/2 + 1 bins)
+     * @param out Real output array (n values)
+     * @param flags Planning flags (default: FFTW_MEASURE)
+     * @return FFTW plan
+     */
+    static fftw_plan create_plan_c2r_1d(
+        int n,
+        fftw_complex* in,
+        double* out,
+        unsigned flags = FFTW_MEASURE
+    ) {
+        return create_plan_with_cache("irfft_1d_" + std::to_string(n), [&]() {
+            return fftw_plan_dft_c2r_1d(n, in, out, flags);
+        });
+    }
+
     /**
      * Create 2D FFT plan with caching.
      *
@@ -167,7 +217,8 @@ public:
     }
 
 private:
-    static std::string cache_directory_;
+    // inline: the header is included by several translation units
+    inline static std::string cache_directory_ = "./cache/fftw_wisdom";
 
     /**
      * Create cache directory if it doesn't exist.
@@ -186,7 +237,7 @@ private:
     static void load_global_wisdom() {
         std::string global_wisdom = cache_directory_ + "/global_wisdom.dat";
         if (import_wisdom(global_wisdom)) {
-            std::cout << "[FFTW Cache] Loaded global wisdom from: " << global_wisdom << std::endl;
+            std::cerr << "[FFTW Cache] Loaded global wisdom from: " << global_wisdom << std::endl;
         }
     }
 
@@ -196,7 +247,7 @@ private:
     static void save_global_wisdom() {
         std::string global_wisdom = cache_directory_ + "/global_wisdom.dat";
         if (export_wisdom(global_wisdom)) {
-            std::cout << "[FFTW Cache] Saved global wisdom to: " << global_wisdom << std::endl;
+            std::cerr << "[FFTW Cache] Saved global wisdom to: " << global_wisdom << std::endl;
         }
     }
 
@@ -249,18 +300,15 @@ private:
         if (plan && !wisdom_loaded) {
             // Save wisdom for future use
             export_wisdom(wisdom_file);
-            std::cout << "[FFTW Cache] Saved wisdom: " << key << std::endl;
+            std::cerr << "[FFTW Cache] Saved wisdom: " << key << std::endl;
         } else if (plan && wisdom_loaded) {
-            std::cout << "[FFTW Cache] Used cached wisdom: " << key << std::endl;
+            std::cerr << "[FFTW Cache] Used cached wisdom: " << key << std::endl;
         }
 
         return plan;
     }
 };
 
-// Static member initialization
-std::string FFTWWisdomCache::cache_directory_ = "./cache/fftw_wisdom";
-
 } // namespace dase
 
 #endif // FFTW_WISDOM_CACHE_HPP
@@ -0,0 +1,331 @@
+/**
+ * IGSOA Active Region - Tile Mask for Mostly-Quiescent Lattices
+ *
+ * Missions that start from a localized state spend most early steps on
+ * nodes where Ψ and Φ are still zero. The lattice is cut into tile³ (tile²
+ * in 2D) blocks; a tile is hot when some node has |Ψ| or |Φ| above the
+ * threshold, and a tile is stepped when a hot tile lies within halo tiles
+ * of it (halo = ceil(reach / tile), the stencil reach in tiles). All other
+ * tiles are left untouched for the step.
+ *
+ * A skipped node only has quiescent neighbors within R_c, so the update it
+ * misses is bounded by dt · ΣK · threshold per step. The mask is rebuilt
+ * every step from the tiles stepped last step (skipped tiles do not change,
+ * so they stay cold), which grows it by up to R_c per step as the front
+ * spreads.
+ *
+ * Correctness guard: the outermost ring of stepped tiles (frontier) is cold
+ * when the mask is built. If a frontier tile is hot one step later, the
+ * front outran the halo; the halo is widened by one tile and the trip is
+ * counted in the statistics.
+ *
+ * Tiles and halos wrap with the torus. Rows of the lattice (N_x nodes, one
+ * (y, z) pair) are stepped as segments of consecutive stepped tiles.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * Active-region settings (disabled by default)
+ */
+struct ActiveRegionConfig {
+    bool enabled = false;
+    double threshold = 1e-10;  // |Ψ|, |Φ| at or below this count as quiescent
+    size_t tile = 16;          // Tile edge in nodes
+};
+
+/**
+ * Cumulative active-region statistics; cleared when the configuration changes
+ */
+struct ActiveRegionStats {
+    uint64_t masked_steps = 0;    // Steps stepped through the tile mask
+    uint64_t dense_steps = 0;     // Steps after the mask covered the whole lattice
+    uint64_t fallback_steps = 0;  // Steps where the mask did not apply (see fallback_reason)
+    uint64_t tiles_total = 0;     // Σ tiles over masked and dense steps
+    uint64_t tiles_skipped = 0;   // Σ skipped tiles over masked steps
+    uint64_t guard_trips = 0;     // Frontier tiles found hot (halo widened)
+    size_t tiles = 0;             // Tiles per step
+    size_t last_active_tiles = 0; // Tiles stepped in the last masked step
+    int halo_tiles = 0;           // Current halo width in tiles
+    std::string fallback_reason;  // Why the last mission ran without the mask ("" if it did not)
+
+    double skippedRatio() const {
+        return tiles_total > 0 ? static_cast<double>(tiles_skipped) / static_cast<double>(tiles_total) : 0.0;
+    }
+};
+
+/**
+ * Tile mask of one 2D (N_z = 1) or 3D lattice
+ */
+class IGSOAActiveRegion {
+public:
+    /**
+     * Set the geometry; keeps the mask if nothing changed
+     *
+     * @param reach Stencil reach in nodes (max |offset| per axis)
+     */
+    void configure(const ActiveRegionConfig& config, size_t N_x, size_t N_y, size_t N_z, int reach) {
+        const size_t tile = std::max<size_t>(config.tile, 1);
+        if (tile == tile_ && N_x == N_x_ && N_y == N_y_ && N_z == N_z_ && reach == reach_ &&
+            config.threshold == threshold_) {
+            return;
+        }
+        tile_ = tile;
+        N_x_ = N_x;
+        N_y_ = N_y;
+        N_z_ = N_z;
+        reach_ = reach;
+        threshold_ = config.threshold;
+        threshold_sq_ = config.threshold * config.threshold;
+        T_x_ = (N_x + tile - 1) / tile;
+        T_y_ = (N_y + tile - 1) / tile;
+        T_z_ = (N_z + tile - 1) / tile;
+        base_halo_ = std::max(1, static_cast<int>((static_cast<size_t>(std::max(reach, 0)) + tile - 1) / tile));
+
+        const size_t tiles = T_x_ * T_y_ * T_z_;
+        hot_.assign(tiles, 0);
+        active_.assign(tiles, 0);
+        frontier_.assign(tiles, 0);
+        seg_offset_.assign(T_y_ * T_z_ + 1, 0);
+        stats_ = ActiveRegionStats();
+        stats_.tiles = tiles;
+        stats_.halo_tiles = base_halo_;
+        halo_ = base_halo_;
+    }
+
+    /**
+     * Start a mission: the state may have been edited, so every tile is scanned
+     */
+    void beginMission() {
+        scan_.resize(active_.size());
+        for (size_t t = 0; t < scan_.size(); t++) scan_[t] = t;
+        std::fill(frontier_.begin(), frontier_.end(), 0);
+        stats_.fallback_reason.clear();
+    }
+
+    /**
+     * Tiles to scan before the next update (all tiles, then last step's active ones)
+     */
+    size_t scanCount() const { return scan_.size(); }
+
+    /**
+     * Set the hot flag of the k-th scanned tile from the current state
+     */
+    template<typename Lattice>
+    void scanTile(const Lattice& lattice, size_t k) {
+        const size_t t = scan_[k];
+        size_t x0, x1, y0, y1, z0, z1;
+        tileBounds(t, x0, x1, y0, y1, z0, z1);
+        const auto* psi_re = lattice.psi_re.data();
+        const auto* psi_im = lattice.psi_im.data();
+        const auto* phi = lattice.phi.data();
+
+        double peak = 0.0;
+        for (size_t z = z0; z < z1; z++) {
+            for (size_t y = y0; y < y1; y++) {
+                const size_t row = (z * N_y_ + y) * N_x_;
+                for (size_t x = row + x0; x < row + x1; x++) {
+                    const double re = psi_re[x];
+                    const double im = psi_im[x];
+                    const double f = phi[x];
+                    peak = std::max(peak, std::max(re * re + im * im, f * f));
+                }
+            }
+        }
+        hot_[t] = peak > threshold_sq_ ? 1 : 0;
+    }
+
+    /**
+     * Rebuild the mask from the scanned tiles
+     *
+     * Runs the frontier guard, dilates the hot tiles by the halo, and builds
+     * the row segments and the list of rows with stepped nodes.
+     *
+     * @return true if every tile is stepped
+     */
+    bool update() {
+        for (size_t t : scan_) {
+            if (hot_[t] && frontier_[t]) {
+                stats_.guard_trips++;
+                halo_ = std::min(halo_ + 1, static_cast<int>(std::max({T_x_, T_y_, T_z_})));
+                stats_.halo_tiles = halo_;
+                break;
+            }
+        }
+
+        std::fill(active_.begin(), active_.end(), 0);
+        const int hx = std::min(halo_, static_cast<int>(T_x_ / 2));
+        const int hy = std::min(halo_, static_cast<int>(T_y_ / 2));
+        const int hz = std::min(halo_, static_cast<int>(T_z_ / 2));
+        for (size_t t : scan_) {
+            if (!hot_[t]) continue;
+            const int tx = static_cast<int>(t % T_x_);
+            const int ty = static_cast<int>((t / T_x_) % T_y_);
+            const int tz = static_cast<int>(t / (T_x_ * T_y_));
+            for (int dz = -hz; dz <= hz; dz++) {
+                const size_t z = wrapTile(tz + dz, T_z_);
+                for (int dy = -hy; dy <= hy; dy++) {
+                    const size_t y = wrapTile(ty + dy, T_y_);
+                    for (int dx = -hx; dx <= hx; dx++) {
+                        active_[(z * T_y_ + y) * T_x_ + wrapTile(tx + dx, T_x_)] = 1;
+                    }
+                }
+            }
+        }
+
+        scan_.clear();
+        for (size_t t = 0; t < active_.size(); t++) {
+            if (active_[t]) scan_.push_back(t);
+        }
+        stats_.last_active_tiles = scan_.size();
+        if (scan_.size() == active_.size()) return true;
+
+        for (size_t t : scan_) {
+            frontier_[t] = touchesInactive(t) ? 1 : 0;
+        }
+        buildSegments();
+        return false;
+    }
+
+    /**
+     * Count one step stepped through the mask / on the whole lattice
+     */
+    void countMaskedStep() {
+        stats_.masked_steps++;
+        stats_.tiles_total += active_.size();
+        stats_.tiles_skipped += active_.size() - scan_.size();
+    }
+
+    void countDenseSteps(uint64_t steps) {
+        stats_.dense_steps += steps;
+        stats_.tiles_total += steps * active_.size();
+    }
+
+    void countFallbackSteps(uint64_t steps, const std::string& reason) {
+        stats_.fallback_steps += steps;
+        stats_.fallback_reason = reason;
+    }
+
+    /**
+     * Rows (r = z·N_y + y, ascending) holding stepped nodes in the current mask
+     */
+    const std::vector<size_t>& activeRows() const { return rows_; }
+
+    /**
+     * Stepped column segments [x0[s], x1[s]) of row r, s in [begin, end)
+     */
+    void rowSegments(size_t r, size_t& begin, size_t& end) const {
+        const size_t tile_row = ((r / N_y_) / tile_) * T_y_ + (r % N_y_) / tile_;
+        begin = seg_offset_[tile_row];
+        end = seg_offset_[tile_row + 1];
+    }
+
+    const size_t* segmentBegin() const { return seg_x0_.data(); }
+    const size_t* segmentEnd() const { return seg_x1_.data(); }
+
+    /**
+     * Stepped nodes in the current mask
+     */
+    size_t activeNodes() const { return active_nodes_; }
+
+    const ActiveRegionStats& stats() const { return stats_; }
+
+    size_t getMemoryUsage() const {
+        return hot_.size() * 3 + (scan_.capacity() + rows_.capacity() + seg_offset_.capacity() +
+                                  seg_x0_.capacity() + seg_x1_.capacity()) * sizeof(size_t);
+    }
+
+private:
+    static size_t wrapTile(int t, size_t T) {
+        const int n = static_cast<int>(T);
+        int r = t % n;
+        return static_cast<size_t>(r < 0 ? r + n : r);
+    }
+
+    void tileBounds(size_t t, size_t& x0, size_t& x1, size_t& y0, size_t& y1, size_t& z0, size_t& z1) const {
+        x0 = (t % T_x_) * tile_;
+        y0 = ((t / T_x_) % T_y_) * tile_;
+        z0 = (t / (T_x_ * T_y_)) * tile_;
+        x1 = std::min(x0 + tile_, N_x_);
+        y1 = std::min(y0 + tile_, N_y_);
+        z1 = std::min(z0 + tile_, N_z_);
+    }
+
+    bool touchesInactive(size_t t) const {
+        const int tx = static_cast<int>(t % T_x_);
+        const int ty = static_cast<int>((t / T_x_) % T_y_);
+        const int tz = static_cast<int>(t / (T_x_ * T_y_));
+        for (int dz = -1; dz <= 1; dz++) {
+            const size_t z = wrapTile(tz + dz, T_z_);
+            for (int dy = -1; dy <= 1; dy++) {
+                const size_t y = wrapTile(ty + dy, T_y_);
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (!active_[(z * T_y_ + y) * T_x_ + wrapTile(tx + dx, T_x_)]) return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Runs of stepped tiles per tile row (ty, tz), then every lattice row they cover
+    void buildSegments() {
+        seg_x0_.clear();
+        seg_x1_.clear();
+        active_nodes_ = 0;
+        for (size_t tile_row = 0; tile_row < T_y_ * T_z_; tile_row++) {
+            seg_offset_[tile_row] = seg_x0_.size();
+            const uint8_t* flags = active_.data() + tile_row * T_x_;
+            for (size_t tx = 0; tx < T_x_;) {
+                if (!flags[tx]) { tx++; continue; }
+                const size_t run = tx;
+                while (tx < T_x_ && flags[tx]) tx++;
+                seg_x0_.push_back(run * tile_);
+                seg_x1_.push_back(std::min(tx * tile_, N_x_));
+            }
+        }
+        seg_offset_[T_y_ * T_z_] = seg_x0_.size();
+
+        rows_.clear();
+        const size_t rows = N_y_ * N_z_;
+        for (size_t r = 0; r < rows; r++) {
+            size_t begin, end;
+            rowSegments(r, begin, end);
+            if (begin == end) continue;
+            rows_.push_back(r);
+            for (size_t s = begin; s < end; s++) active_nodes_ += seg_x1_[s] - seg_x0_[s];
+        }
+    }
+
+    size_t tile_ = 0;
+    size_t N_x_ = 0, N_y_ = 0, N_z_ = 0;
+    size_t T_x_ = 0, T_y_ = 0, T_z_ = 0;  // Tiles per axis
+    int reach_ = -1;
+    int base_halo_ = 1;
+    int halo_ = 1;
+    double threshold_ = -1.0;
+    double threshold_sq_ = 0.0;
+
+    std::vector<uint8_t> hot_;       // Per tile: scanned above threshold
+    std::vector<uint8_t> active_;    // Per tile: stepped this step
+    std::vector<uint8_t> frontier_;  // Per tile: stepped with an unstepped neighbor tile
+    std::vector<size_t> scan_;       // Tiles to scan (stepped tiles after update())
+    std::vector<size_t> rows_;
+    std::vector<size_t> seg_offset_; // Per tile row: first segment
+    std::vector<size_t> seg_x0_;
+    std::vector<size_t> seg_x1_;
+    size_t active_nodes_ = 0;
+    ActiveRegionStats stats_;
+};
+
+} // namespace igsoa
+} // namespace dase
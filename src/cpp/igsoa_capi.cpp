@@ -98,6 +98,73 @@ IGSOA_API double igsoa_get_node_F(
     return 0.0;
 }
 
+IGSOA_API int igsoa_set_psi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    const double* psi_real,
+    const double* psi_imag,
+    uint32_t stride
+) {
+    if (engine && engine->engine) {
+        return engine->engine->setPsiRange(first, count, psi_real, psi_imag, stride) ? 1 : 0;
+    }
+    return 0;
+}
+
+IGSOA_API int igsoa_get_psi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    double* out_psi_real,
+    double* out_psi_imag,
+    uint32_t stride
+) {
+    if (engine && engine->engine) {
+        return engine->engine->getPsiRange(first, count, out_psi_real, out_psi_imag, stride) ? 1 : 0;
+    }
+    return 0;
+}
+
+IGSOA_API int igsoa_set_phi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    const double* phi,
+    uint32_t stride
+) {
+    if (engine && engine->engine) {
+        return engine->engine->setPhiRange(first, count, phi, stride) ? 1 : 0;
+    }
+    return 0;
+}
+
+IGSOA_API int igsoa_get_phi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    double* out_phi,
+    uint32_t stride
+) {
+    if (engine && engine->engine) {
+        return engine->engine->getPhiRange(first, count, out_phi, stride) ? 1 : 0;
+    }
+    return 0;
+}
+
+IGSOA_API int igsoa_get_F_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    double* out_F,
+    uint32_t stride
+) {
+    if (engine && engine->engine) {
+        return engine->engine->getFRange(first, count, out_F, stride) ? 1 : 0;
+    }
+    return 0;
+}
+
 IGSOA_API void igsoa_run_mission(
     IGSOAEngineHandle engine,
     const double* input_signals,
@@ -133,6 +133,79 @@ IGSOA_API double igsoa_get_node_F(
     uint32_t node_index
 );
 
+// =============================================================================
+// BULK NODE STATE
+// =============================================================================
+
+/*
+ * Whole-field or index-range access in one call, for initialization loops
+ * and state readback from Julia/Python. Each function covers nodes
+ * [first, first + count) and reads/writes caller-owned buffers with an
+ * element stride: stride 1 for separate arrays, stride 2 with
+ * (buf, buf + 1) for interleaved complex (re, im, re, im, ...) data.
+ * Values move directly between the buffers and the engine's field arrays.
+ *
+ * All return 1 on success, 0 for a bad handle, null buffer, zero stride or
+ * a range extending past igsoa_get_num_nodes().
+ */
+
+/**
+ * Set Ψ for a node range (F and phase are updated as in igsoa_set_node_psi)
+ */
+IGSOA_API int igsoa_set_psi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    const double* psi_real,
+    const double* psi_imag,
+    uint32_t stride
+);
+
+/**
+ * Get Ψ for a node range
+ */
+IGSOA_API int igsoa_get_psi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    double* out_psi_real,
+    double* out_psi_imag,
+    uint32_t stride
+);
+
+/**
+ * Set Φ for a node range
+ */
+IGSOA_API int igsoa_set_phi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    const double* phi,
+    uint32_t stride
+);
+
+/**
+ * Get Φ for a node range
+ */
+IGSOA_API int igsoa_get_phi_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    double* out_phi,
+    uint32_t stride
+);
+
+/**
+ * Get F = |Ψ|² for a node range
+ */
+IGSOA_API int igsoa_get_F_range(
+    IGSOAEngineHandle engine,
+    uint32_t first,
+    uint32_t count,
+    double* out_F,
+    uint32_t stride
+);
+
 // =============================================================================
 // MISSION EXECUTION
 // =============================================================================
@@ -4,7 +4,9 @@
 
 #include "igsoa_capi_2d.h"
 #include "igsoa_complex_engine_2d.h"
+#include "igsoa_ensemble_engine_2d.h"
 #include "igsoa_state_init_2d.h"
+#include "igsoa_state_extract.h"
 #include <cstring>
 #include <string>
 
@@ -19,6 +21,25 @@ IGSOA2DEngineHandle igsoa2d_create_engine(
     double gamma,
     double dt
 ) {
+    return igsoa2d_create_engine_ex(N_x, N_y, R_c, kappa, gamma, dt, IGSOA2D_COUPLING_DIRECT);
+}
+
+// Create 2D engine with coupling strategy
+IGSOA2DEngineHandle igsoa2d_create_engine_ex(
+    size_t N_x,
+    size_t N_y,
+    double R_c,
+    double kappa,
+    double gamma,
+    double dt,
+    int coupling_mode
+) {
+    if (coupling_mode != IGSOA2D_COUPLING_DIRECT &&
+        coupling_mode != IGSOA2D_COUPLING_NEIGHBOR_CACHE &&
+        coupling_mode != IGSOA2D_COUPLING_SPECTRAL) {
+        return nullptr;
+    }
+
     try {
         // Create configuration
         IGSOAComplexConfig config;
@@ -28,6 +49,7 @@ IGSOA2DEngineHandle igsoa2d_create_engine(
         config.gamma = gamma;
         config.dt = dt;
         config.normalize_psi = false;  // Preserve amplitude for SATP validation
+        config.coupling_mode = static_cast<IGSOACouplingMode>(coupling_mode);
 
         // Create engine
         auto* engine = new IGSOAComplexEngine2D(config, N_x, N_y);
@@ -113,6 +135,69 @@ double igsoa2d_get_node_phi(
     return engine->getNodePhi(x, y);
 }
 
+// Bulk node state
+bool igsoa2d_set_psi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    const double* psi_real,
+    const double* psi_imag,
+    size_t stride
+) {
+    if (!handle) return false;
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine->setPsiRange(first, count, psi_real, psi_imag, stride);
+}
+
+bool igsoa2d_get_psi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    double* psi_real_out,
+    double* psi_imag_out,
+    size_t stride
+) {
+    if (!handle) return false;
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine->getPsiRange(first, count, psi_real_out, psi_imag_out, stride);
+}
+
+bool igsoa2d_set_phi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    const double* phi,
+    size_t stride
+) {
+    if (!handle) return false;
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine->setPhiRange(first, count, phi, stride);
+}
+
+bool igsoa2d_get_phi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    double* phi_out,
+    size_t stride
+) {
+    if (!handle) return false;
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine->getPhiRange(first, count, phi_out, stride);
+}
+
+bool igsoa2d_get_F_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    double* F_out,
+    size_t stride
+) {
+    if (!handle) return false;
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine->getFRange(first, count, F_out, stride);
+}
+
 // Run mission
 bool igsoa2d_run_mission(
     IGSOA2DEngineHandle handle,
@@ -141,6 +226,13 @@ void igsoa2d_get_metrics(
     engine->getMetrics(*ns_per_op_out, *ops_per_sec_out, *speedup_out, *total_ops_out);
 }
 
+// Get coupling cache memory
+size_t igsoa2d_get_coupling_cache_memory(IGSOA2DEngineHandle handle) {
+    if (!handle) return 0;
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine->getCouplingCacheMemoryUsage();
+}
+
 // Get all states
 bool igsoa2d_get_all_states(
     IGSOA2DEngineHandle handle,
@@ -152,14 +244,13 @@ bool igsoa2d_get_all_states(
 
     try {
         auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
-        const auto& nodes = engine->getNodes();
+        const auto& lattice = engine->getLattice();
 
-        size_t N_total = engine->getTotalNodes();
-        for (size_t i = 0; i < N_total; i++) {
-            psi_real_out[i] = nodes[i].psi.real();
-            psi_imag_out[i] = nodes[i].psi.imag();
-            phi_out[i] = nodes[i].phi;
-        }
+        // SoA planes map 1:1 onto the output arrays
+        const size_t N_total = engine->getTotalNodes();
+        std::memcpy(psi_real_out, lattice.psi_re.data(), N_total * sizeof(double));
+        std::memcpy(psi_imag_out, lattice.psi_im.data(), N_total * sizeof(double));
+        std::memcpy(phi_out, lattice.phi.data(), N_total * sizeof(double));
 
         return true;
     } catch (...) {
@@ -167,6 +258,59 @@ bool igsoa2d_get_all_states(
     }
 }
 
+namespace {
+
+template<typename Out>
+bool getRegionStates(IGSOA2DEngineHandle handle,
+                     size_t x0, size_t y0, size_t nx, size_t ny, size_t stride,
+                     uint32_t field_mask,
+                     Out* psi_real_out, Out* psi_imag_out, Out* F_out, Out* phi_out) {
+    if (!handle) return false;
+
+    try {
+        auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+        StateRegion region;
+        region.x0 = x0;
+        region.y0 = y0;
+        region.nx = nx;
+        region.ny = ny;
+        region.stride = stride;
+        return extractRegion(engine->getLattice(), engine->getNx(), engine->getNy(), 1,
+                             region, field_mask, psi_real_out, psi_imag_out, F_out, phi_out);
+    } catch (...) {
+        return false;
+    }
+}
+
+} // namespace
+
+// Get region-of-interest states
+bool igsoa2d_get_region_states(
+    IGSOA2DEngineHandle handle,
+    size_t x0, size_t y0, size_t nx, size_t ny, size_t stride,
+    uint32_t field_mask,
+    double* psi_real_out,
+    double* psi_imag_out,
+    double* F_out,
+    double* phi_out
+) {
+    return getRegionStates(handle, x0, y0, nx, ny, stride, field_mask,
+                           psi_real_out, psi_imag_out, F_out, phi_out);
+}
+
+bool igsoa2d_get_region_states_f32(
+    IGSOA2DEngineHandle handle,
+    size_t x0, size_t y0, size_t nx, size_t ny, size_t stride,
+    uint32_t field_mask,
+    float* psi_real_out,
+    float* psi_imag_out,
+    float* F_out,
+    float* phi_out
+) {
+    return getRegionStates(handle, x0, y0, nx, ny, stride, field_mask,
+                           psi_real_out, psi_imag_out, F_out, phi_out);
+}
+
 // Initialize circular Gaussian
 bool igsoa2d_init_circular_gaussian(
     IGSOA2DEngineHandle handle,
@@ -273,3 +417,167 @@ double igsoa2d_get_entropy_rate(IGSOA2DEngineHandle handle) {
     auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
     return engine->getTotalEntropyRate();
 }
+
+// Create ensemble
+IGSOA2DEnsembleHandle igsoa2d_create_ensemble(
+    size_t N_x,
+    size_t N_y,
+    double R_c,
+    double dt,
+    size_t replicas,
+    const double* kappas,
+    const double* gammas
+) {
+    try {
+        IGSOAComplexConfig config;
+        config.num_nodes = N_x * N_y;
+        config.R_c_default = R_c;
+        config.kappa = 1.0;
+        config.gamma = 0.1;
+        config.dt = dt;
+        config.normalize_psi = false;  // As igsoa2d_create_engine_ex
+
+        auto* ensemble = new IGSOAEnsembleEngine2D(config, N_x, N_y, replicas);
+        for (size_t b = 0; b < replicas; b++) {
+            ensemble->setReplicaParams(b, kappas ? kappas[b] : config.kappa,
+                                       gammas ? gammas[b] : config.gamma);
+        }
+        return static_cast<IGSOA2DEnsembleHandle>(ensemble);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+// Destroy ensemble
+void igsoa2d_destroy_ensemble(IGSOA2DEnsembleHandle handle) {
+    if (handle) {
+        auto* ensemble = static_cast<IGSOAEnsembleEngine2D*>(handle);
+        delete ensemble;
+    }
+}
+
+// Get replica count
+size_t igsoa2d_ensemble_get_replica_count(IGSOA2DEnsembleHandle handle) {
+    if (!handle) return 0;
+    return static_cast<IGSOAEnsembleEngine2D*>(handle)->getReplicaCount();
+}
+
+// Set replica κ/γ
+bool igsoa2d_ensemble_set_replica_params(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    double kappa,
+    double gamma
+) {
+    if (!handle) return false;
+    return static_cast<IGSOAEnsembleEngine2D*>(handle)->setReplicaParams(replica, kappa, gamma);
+}
+
+// Bulk replica state
+bool igsoa2d_ensemble_set_psi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    const double* psi_real,
+    const double* psi_imag,
+    size_t stride
+) {
+    if (!handle) return false;
+    return static_cast<IGSOAEnsembleEngine2D*>(handle)->setPsiRange(
+        replica, first, count, psi_real, psi_imag, stride);
+}
+
+bool igsoa2d_ensemble_get_psi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    double* psi_real_out,
+    double* psi_imag_out,
+    size_t stride
+) {
+    if (!handle) return false;
+    return static_cast<const IGSOAEnsembleEngine2D*>(handle)->getPsiRange(
+        replica, first, count, psi_real_out, psi_imag_out, stride);
+}
+
+bool igsoa2d_ensemble_set_phi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    const double* phi,
+    size_t stride
+) {
+    if (!handle) return false;
+    return static_cast<IGSOAEnsembleEngine2D*>(handle)->setPhiRange(replica, first, count, phi, stride);
+}
+
+bool igsoa2d_ensemble_get_phi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    double* phi_out,
+    size_t stride
+) {
+    if (!handle) return false;
+    return static_cast<const IGSOAEnsembleEngine2D*>(handle)->getPhiRange(replica, first, count, phi_out, stride);
+}
+
+bool igsoa2d_ensemble_get_F_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    double* F_out,
+    size_t stride
+) {
+    if (!handle) return false;
+    return static_cast<const IGSOAEnsembleEngine2D*>(handle)->getFRange(replica, first, count, F_out, stride);
+}
+
+// Run ensemble mission
+bool igsoa2d_ensemble_run_mission(
+    IGSOA2DEnsembleHandle handle,
+    uint64_t num_steps
+) {
+    if (!handle) return false;
+    try {
+        static_cast<IGSOAEnsembleEngine2D*>(handle)->runMission(num_steps);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Get ensemble metrics
+void igsoa2d_ensemble_get_metrics(
+    IGSOA2DEnsembleHandle handle,
+    double* ns_per_op_out,
+    double* ops_per_sec_out,
+    double* speedup_out,
+    uint64_t* total_ops_out
+) {
+    if (!handle || !ns_per_op_out || !ops_per_sec_out || !speedup_out || !total_ops_out) return;
+    auto* ensemble = static_cast<IGSOAEnsembleEngine2D*>(handle);
+    ensemble->getMetrics(*ns_per_op_out, *ops_per_sec_out, *speedup_out, *total_ops_out);
+}
+
+// Replica energy / entropy rate
+double igsoa2d_ensemble_get_replica_energy(IGSOA2DEnsembleHandle handle, size_t replica) {
+    if (!handle) return 0.0;
+    return static_cast<IGSOAEnsembleEngine2D*>(handle)->getReplicaEnergy(replica);
+}
+
+double igsoa2d_ensemble_get_replica_entropy_rate(IGSOA2DEnsembleHandle handle, size_t replica) {
+    if (!handle) return 0.0;
+    return static_cast<IGSOAEnsembleEngine2D*>(handle)->getReplicaEntropyRate(replica);
+}
+
+// Reset ensemble
+void igsoa2d_ensemble_reset(IGSOA2DEnsembleHandle handle) {
+    if (!handle) return;
+    static_cast<IGSOAEnsembleEngine2D*>(handle)->reset();
+}
@@ -13,6 +13,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Opaque handle to 2D engine instance
 typedef void* IGSOA2DEngineHandle;
@@ -37,6 +38,33 @@ IGSOA2DEngineHandle igsoa2d_create_engine(
     double dt
 );
 
+// Non-local coupling strategies for igsoa2d_create_engine_ex
+#define IGSOA2D_COUPLING_DIRECT          0  // Per-step search (stencil for uniform R_c)
+#define IGSOA2D_COUPLING_NEIGHBOR_CACHE  1  // Cached CSR neighbor lists, tiered kernel
+#define IGSOA2D_COUPLING_SPECTRAL        2  // FFT convolution for large uniform R_c (USE_FFTW3 builds)
+
+/**
+ * Create a 2D IGSOA engine with an explicit coupling strategy
+ *
+ * @param N_x Number of nodes in x-direction
+ * @param N_y Number of nodes in y-direction
+ * @param R_c Causal radius (default coupling range)
+ * @param kappa Coupling strength
+ * @param gamma Dissipation rate
+ * @param dt Time step
+ * @param coupling_mode IGSOA2D_COUPLING_DIRECT, _NEIGHBOR_CACHE or _SPECTRAL
+ * @return Handle to engine instance (NULL on failure or unknown mode)
+ */
+IGSOA2DEngineHandle igsoa2d_create_engine_ex(
+    size_t N_x,
+    size_t N_y,
+    double R_c,
+    double kappa,
+    double gamma,
+    double dt,
+    int coupling_mode
+);
+
 /**
  * Destroy a 2D IGSOA engine
  *
@@ -128,6 +156,72 @@ double igsoa2d_get_node_phi(
     size_t y
 );
 
+/*
+ * Bulk node state for nodes [first, first + count) in row-major order
+ * (index = y*N_x + x); first = 0, count = N_x*N_y covers the whole field.
+ * Caller buffers are addressed with an element stride (stride 2 with
+ * (buf, buf + 1) for interleaved complex data) and copied directly to or
+ * from the engine's field arrays. Return false for a bad handle, null
+ * buffer, zero stride or a range past igsoa2d_get_total_nodes().
+ */
+
+/**
+ * Set Ψ for a node range (F and phase are updated as in igsoa2d_set_node_psi)
+ */
+bool igsoa2d_set_psi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    const double* psi_real,
+    const double* psi_imag,
+    size_t stride
+);
+
+/**
+ * Get Ψ for a node range
+ */
+bool igsoa2d_get_psi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    double* psi_real_out,
+    double* psi_imag_out,
+    size_t stride
+);
+
+/**
+ * Set Φ for a node range
+ */
+bool igsoa2d_set_phi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    const double* phi,
+    size_t stride
+);
+
+/**
+ * Get Φ for a node range
+ */
+bool igsoa2d_get_phi_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    double* phi_out,
+    size_t stride
+);
+
+/**
+ * Get F = |Ψ|² for a node range
+ */
+bool igsoa2d_get_F_range(
+    IGSOA2DEngineHandle handle,
+    size_t first,
+    size_t count,
+    double* F_out,
+    size_t stride
+);
+
 /**
  * Run time evolution mission
  *
@@ -157,6 +251,14 @@ void igsoa2d_get_metrics(
     uint64_t* total_ops_out
 );
 
+/**
+ * Get memory held by coupling caches (neighbor lists or stencil)
+ *
+ * @param handle Engine handle
+ * @return Bytes used (0 for an invalid handle)
+ */
+size_t igsoa2d_get_coupling_cache_memory(IGSOA2DEngineHandle handle);
+
 /**
  * Extract full state (all nodes)
  *
@@ -176,6 +278,55 @@ bool igsoa2d_get_all_states(
     double* phi_out
 );
 
+// Field selection for igsoa2d_get_region_states (combine with |)
+#define IGSOA2D_FIELD_PSI  1  // psi_real and psi_imag
+#define IGSOA2D_FIELD_F    2  // Informational density |Ψ|²
+#define IGSOA2D_FIELD_PHI  4  // Realized field Φ
+#define IGSOA2D_FIELD_ALL  7
+
+/**
+ * Extract selected fields over a strided region of interest
+ *
+ * Samples x = x0, x0+stride, ... < x0+nx (same for y). Output arrays hold
+ * ceil(nx/stride) * ceil(ny/stride) values in row-major order
+ * (index = j*ceil(nx/stride) + i). Outputs for unselected fields may be NULL.
+ *
+ * @param handle Engine handle
+ * @param x0 First column (0 <= x0, x0+nx <= N_x)
+ * @param y0 First row (0 <= y0, y0+ny <= N_y)
+ * @param nx Region width
+ * @param ny Region height
+ * @param stride Sampling step (>= 1)
+ * @param field_mask IGSOA2D_FIELD_* bits
+ * @param psi_real_out Output: Re Ψ (IGSOA2D_FIELD_PSI)
+ * @param psi_imag_out Output: Im Ψ (IGSOA2D_FIELD_PSI)
+ * @param F_out Output: F (IGSOA2D_FIELD_F)
+ * @param phi_out Output: Φ (IGSOA2D_FIELD_PHI)
+ * @return true on success (false for an invalid region or missing output)
+ */
+bool igsoa2d_get_region_states(
+    IGSOA2DEngineHandle handle,
+    size_t x0, size_t y0, size_t nx, size_t ny, size_t stride,
+    uint32_t field_mask,
+    double* psi_real_out,
+    double* psi_imag_out,
+    double* F_out,
+    double* phi_out
+);
+
+/**
+ * Single-precision variant of igsoa2d_get_region_states (halves transfer size)
+ */
+bool igsoa2d_get_region_states_f32(
+    IGSOA2DEngineHandle handle,
+    size_t x0, size_t y0, size_t nx, size_t ny, size_t stride,
+    uint32_t field_mask,
+    float* psi_real_out,
+    float* psi_imag_out,
+    float* F_out,
+    float* phi_out
+);
+
 /**
  * Initialize 2D circular Gaussian profile
  *
@@ -263,6 +414,145 @@ double igsoa2d_get_total_energy(IGSOA2DEngineHandle handle);
  */
 double igsoa2d_get_entropy_rate(IGSOA2DEngineHandle handle);
 
+/*
+ * Ensembles: B replicas of one N_x × N_y lattice stepped in lockstep
+ * (IGSOAEnsembleEngine2D). All replicas share R_c and dt; κ and γ are per
+ * replica. Replica state uses the bulk range layout above, per replica.
+ */
+
+// Opaque handle to an ensemble instance
+typedef void* IGSOA2DEnsembleHandle;
+
+/**
+ * Create an ensemble of 2D IGSOA replicas
+ *
+ * @param N_x Number of nodes in x-direction
+ * @param N_y Number of nodes in y-direction
+ * @param R_c Causal radius (shared)
+ * @param dt Time step (shared)
+ * @param replicas Number of replicas B
+ * @param kappas Per-replica coupling strengths (length B; NULL: 1.0)
+ * @param gammas Per-replica dissipation rates (length B; NULL: 0.1)
+ * @return Handle to ensemble instance (NULL on failure)
+ */
+IGSOA2DEnsembleHandle igsoa2d_create_ensemble(
+    size_t N_x,
+    size_t N_y,
+    double R_c,
+    double dt,
+    size_t replicas,
+    const double* kappas,
+    const double* gammas
+);
+
+/**
+ * Destroy an ensemble
+ */
+void igsoa2d_destroy_ensemble(IGSOA2DEnsembleHandle handle);
+
+/**
+ * Get the number of replicas (0 for an invalid handle)
+ */
+size_t igsoa2d_ensemble_get_replica_count(IGSOA2DEnsembleHandle handle);
+
+/**
+ * Set κ and γ of one replica
+ *
+ * @return false for a bad handle or replica index
+ */
+bool igsoa2d_ensemble_set_replica_params(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    double kappa,
+    double gamma
+);
+
+/**
+ * Bulk state of one replica (as igsoa2d_set_psi_range / _get_*_range)
+ */
+bool igsoa2d_ensemble_set_psi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    const double* psi_real,
+    const double* psi_imag,
+    size_t stride
+);
+
+bool igsoa2d_ensemble_get_psi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    double* psi_real_out,
+    double* psi_imag_out,
+    size_t stride
+);
+
+bool igsoa2d_ensemble_set_phi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    const double* phi,
+    size_t stride
+);
+
+bool igsoa2d_ensemble_get_phi_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    double* phi_out,
+    size_t stride
+);
+
+bool igsoa2d_ensemble_get_F_range(
+    IGSOA2DEnsembleHandle handle,
+    size_t replica,
+    size_t first,
+    size_t count,
+    double* F_out,
+    size_t stride
+);
+
+/**
+ * Advance every replica num_steps time steps
+ *
+ * @return true on success
+ */
+bool igsoa2d_ensemble_run_mission(
+    IGSOA2DEnsembleHandle handle,
+    uint64_t num_steps
+);
+
+/**
+ * Get performance metrics (operations count every replica node)
+ */
+void igsoa2d_ensemble_get_metrics(
+    IGSOA2DEnsembleHandle handle,
+    double* ns_per_op_out,
+    double* ops_per_sec_out,
+    double* speedup_out,
+    uint64_t* total_ops_out
+);
+
+/**
+ * Get the energy E = ∑[|Ψ|² + Φ²] of one replica
+ */
+double igsoa2d_ensemble_get_replica_energy(IGSOA2DEnsembleHandle handle, size_t replica);
+
+/**
+ * Get the entropy production rate Ṡ_total of one replica
+ */
+double igsoa2d_ensemble_get_replica_entropy_rate(IGSOA2DEnsembleHandle handle, size_t replica);
+
+/**
+ * Zero every replica's state (κ and γ are kept)
+ */
+void igsoa2d_ensemble_reset(IGSOA2DEnsembleHandle handle);
+
 #ifdef __cplusplus
 }
 #endif
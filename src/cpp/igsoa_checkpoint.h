@@ -0,0 +1,101 @@
+/**
+ * IGSOA Checkpoint Sections
+ *
+ * Maps an IGSOALatticeSoA and the engine counters onto checkpoint_file.h
+ * sections, shared by the 1D/2D/3D complex engines. Each lattice plane is
+ * one section, so saving is one sequential write per plane and restoring
+ * is one memcpy per plane out of the mapped file.
+ */
+
+#pragma once
+
+#include "checkpoint_file.h"
+#include "igsoa_lattice_soa.h"
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * Visit every lattice plane with its checkpoint section name
+ *
+ * Older checkpoints also carry entropy_rate, T_IGS and phase sections; the
+ * lattice derives those now, so loading ignores them.
+ */
+template <typename Lattice, typename Fn>
+void forEachLatticePlane(Lattice& lattice, Fn&& fn) {
+    fn("psi_re", lattice.psi_re);
+    fn("psi_im", lattice.psi_im);
+    fn("psi_dot_re", lattice.psi_dot_re);
+    fn("psi_dot_im", lattice.psi_dot_im);
+    fn("phi", lattice.phi);
+    fn("phi_dot", lattice.phi_dot);
+    fn("F", lattice.F);
+    fn("F_gradient", lattice.F_gradient);
+    fn("R_c", lattice.R_c);
+    fn("kappa", lattice.kappa);
+    fn("gamma", lattice.gamma);
+    fn("harmonic_count", lattice.harmonic_count);
+}
+
+/**
+ * Append dims, lattice planes and counters
+ *
+ * Planes are referenced, not copied: the lattice must stay untouched until
+ * writer.write() returns or writer.snapshot() has run.
+ */
+inline void saveLatticeCheckpoint(CheckpointWriter& writer, const std::vector<uint64_t>& dims,
+                                  const IGSOALatticeSoA& lattice, double current_time,
+                                  uint64_t total_steps, uint64_t total_operations) {
+    writer.copyArray("dims", dims.data(), dims.size());
+    forEachLatticePlane(lattice, [&](const char* name, const auto& plane) {
+        writer.addArray(name, plane.data(), plane.size());
+    });
+    writer.addScalar("current_time", current_time);
+    writer.addScalar("total_steps", total_steps);
+    writer.addScalar("total_operations", total_operations);
+}
+
+/**
+ * Restore lattice planes and counters
+ *
+ * Every section is checked before anything is copied, so a mismatched or
+ * incomplete checkpoint leaves the engine state unchanged.
+ */
+inline bool loadLatticeCheckpoint(const CheckpointReader& reader, const std::string& engine_type,
+                                  const std::vector<uint64_t>& dims, IGSOALatticeSoA& lattice,
+                                  double& current_time, uint64_t& total_steps,
+                                  uint64_t& total_operations, std::string* error) {
+    if (!checkCheckpointShape(reader, engine_type, dims, error)) {
+        return false;
+    }
+
+    const size_t n = lattice.size();
+    bool complete = true;
+    forEachLatticePlane(lattice, [&](const char* name, auto& plane) {
+        using T = typename std::decay_t<decltype(plane)>::value_type;
+        complete = complete && reader.array<T>(name, n) != nullptr;
+    });
+    double time = 0.0;
+    uint64_t steps = 0, operations = 0;
+    complete = complete && reader.scalar("current_time", time) &&
+               reader.scalar("total_steps", steps) &&
+               reader.scalar("total_operations", operations);
+    if (!complete) {
+        if (error) *error = "Checkpoint is missing " + engine_type + " lattice sections";
+        return false;
+    }
+
+    forEachLatticePlane(lattice, [&](const char* name, auto& plane) {
+        reader.copyTo(name, plane.data(), n);
+    });
+    current_time = time;
+    total_steps = steps;
+    total_operations = operations;
+    return true;
+}
+
+} // namespace igsoa
+} // namespace dase
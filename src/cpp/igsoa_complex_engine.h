@@ -9,12 +9,22 @@
  * - Running time evolution simulations
  * - Accessing node states and metrics
  * - Performance measurement
+ *
+ * State is evolved on an IGSOALatticeSoA; the IGSOAComplexNode vector is a
+ * lazily synchronized AoS view kept for the node accessors.
  */
 
 #pragma once
 
 #include "igsoa_complex_node.h"
 #include "igsoa_physics.h"
+#include "igsoa_lattice_soa.h"
+#include "igsoa_checkpoint.h"
+#include "igsoa_parareal.h"
+#include "igsoa_physics_soa.h"
+#include "adaptive_timestep.h"
+#include "simd_math.h"
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <chrono>
@@ -37,24 +47,37 @@ public:
      */
     explicit IGSOAComplexEngine(const IGSOAComplexConfig& config)
         : config_(config)
-        , nodes_(config.num_nodes)
         , current_time_(0.0)
         , total_steps_(0)
         , total_operations_(0)
     {
-        // Initialize all nodes with configuration
-        for (auto& node : nodes_) {
-            node.R_c = config.R_c_default;
-            node.kappa = config.kappa;
-            node.gamma = config.gamma;
+        // The lattice is the state from the start; the AoS view is built on request
+        lattice_.resize(config.num_nodes);
+        lattice_.fillParameters(config.R_c_default, config.kappa, config.gamma);
+    }
+
+    /**
+     * Bytes an engine created with config holds once stepped: the SoA
+     * lattice, the Recursive-mode sweep buffers and the RK4 stages (the
+     * AoS view exists only between getNodes() and the next mission)
+     */
+    static size_t estimateFootprint(const IGSOAComplexConfig& config) {
+        const size_t N = config.num_nodes;
+        size_t total = IGSOALatticeSoA::estimateMemoryUsage(N);
+        if (config.coupling_mode == IGSOACouplingMode::Recursive) {
+            const size_t K = static_cast<size_t>(std::ceil(std::max(config.R_c_default, 0.0)));
+            total += 2 * (N + K) * sizeof(double);
+        } else if (config.integrator == IGSOAIntegrator::RK4) {
+            total += IGSOARK4Stages::estimateMemoryUsage(N);
         }
+        return total;
     }
 
     /**
      * Get number of nodes
      */
     size_t getNumNodes() const {
-        return nodes_.size();
+        return config_.num_nodes;
     }
 
     /**
@@ -71,6 +94,43 @@ public:
         return total_steps_;
     }
 
+    /**
+     * Coupling strategy (Direct or Recursive; other modes run as Direct)
+     */
+    IGSOACouplingMode getCouplingMode() const {
+        return config_.coupling_mode;
+    }
+
+    void setCouplingMode(IGSOACouplingMode mode) {
+        config_.coupling_mode = mode;
+    }
+
+    /**
+     * Time integrator (next runMission()); Recursive-mode missions step
+     * Euler. Switching to Euler frees the RK4 stages.
+     */
+    IGSOAIntegrator getIntegrator() const {
+        return config_.integrator;
+    }
+
+    void setIntegrator(IGSOAIntegrator integrator) {
+        config_.integrator = integrator;
+        if (integrator == IGSOAIntegrator::Euler) {
+            rk4_stages_ = IGSOARK4Stages();
+        }
+    }
+
+    size_t getIntegratorMemoryUsage() const {
+        return rk4_stages_.getMemoryUsage();
+    }
+
+    /**
+     * Whether the last step used the O(N) recursive coupling
+     */
+    bool isRecursiveCouplingActive() const {
+        return recursive_active_;
+    }
+
     /**
      * Get total operations executed
      */
@@ -86,10 +146,8 @@ public:
      * @param imag Imaginary part of Ψ
      */
     void setNodePsi(size_t index, double real, double imag) {
-        if (index < nodes_.size()) {
-            nodes_[index].psi = std::complex<double>(real, imag);
-            nodes_[index].updateInformationalDensity();
-            nodes_[index].updatePhase();
+        if (index < getNumNodes()) {
+            latticeForWrite().writePsi(index, 1, &real, &imag);
         }
     }
 
@@ -101,9 +159,10 @@ public:
      * @param imag_out Output: imaginary part of Ψ
      */
     void getNodePsi(size_t index, double& real_out, double& imag_out) const {
-        if (index < nodes_.size()) {
-            real_out = nodes_[index].psi.real();
-            imag_out = nodes_[index].psi.imag();
+        if (index < getNumNodes()) {
+            const IGSOALatticeSoA& lattice = getLattice();
+            real_out = lattice.psi_re[index];
+            imag_out = lattice.psi_im[index];
         } else {
             real_out = 0.0;
             imag_out = 0.0;
@@ -117,8 +176,8 @@ public:
      * @param value Φ value
      */
     void setNodePhi(size_t index, double value) {
-        if (index < nodes_.size()) {
-            nodes_[index].phi = value;
+        if (index < getNumNodes()) {
+            latticeForWrite().phi[index] = value;
         }
     }
 
@@ -129,8 +188,8 @@ public:
      * @return Φ value
      */
     double getNodePhi(size_t index) const {
-        if (index < nodes_.size()) {
-            return nodes_[index].phi;
+        if (index < getNumNodes()) {
+            return getLattice().phi[index];
         }
         return 0.0;
     }
@@ -142,12 +201,76 @@ public:
      * @return F = |Ψ|²
      */
     double getNodeF(size_t index) const {
-        if (index < nodes_.size()) {
-            return nodes_[index].F;
+        if (index < getNumNodes()) {
+            return getLattice().F[index];
         }
         return 0.0;
     }
 
+    /**
+     * Bulk state access for nodes [first, first + count)
+     *
+     * Buffers are caller-owned and addressed with an element stride (stride 2
+     * reads/writes one half of an interleaved complex array). Data moves
+     * directly between the buffers and the SoA lattice, without the per-node
+     * AoS round trip of setNodePsi/getNodePsi.
+     *
+     * @return false if the range does not fit the engine or a buffer is null
+     */
+    bool setPsiRange(size_t first, size_t count, const double* re, const double* im, size_t stride = 1) {
+        if (!re || !im || !rangeFits(first, count, stride)) return false;
+        latticeForWrite().writePsi(first, count, re, im, stride);
+        return true;
+    }
+
+    bool getPsiRange(size_t first, size_t count, double* re, double* im, size_t stride = 1) const {
+        if (!re || !im || !rangeFits(first, count, stride)) return false;
+        getLattice().readPsi(first, count, re, im, stride);
+        return true;
+    }
+
+    bool setPhiRange(size_t first, size_t count, const double* values, size_t stride = 1) {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        latticeForWrite().writePhi(first, count, values, stride);
+        return true;
+    }
+
+    bool getPhiRange(size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        getLattice().readPhi(first, count, values, stride);
+        return true;
+    }
+
+    bool getFRange(size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        getLattice().readF(first, count, values, stride);
+        return true;
+    }
+
+    /**
+     * Checkpoint/restart (see checkpoint_file.h)
+     *
+     * saveCheckpoint() references the lattice planes: write the checkpoint
+     * before the next runMission(), or use writeAsync(), which snapshots
+     * first. loadCheckpoint() requires a checkpoint of the same engine type
+     * and dimensions and leaves the engine unchanged on failure.
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.setEngineType("igsoa_complex_1d");
+        saveLatticeCheckpoint(writer, {getNumNodes()}, getLattice(),
+                              current_time_, total_steps_, total_operations_);
+    }
+
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error = nullptr) {
+        syncLatticeFromNodes();
+        if (!loadLatticeCheckpoint(reader, "igsoa_complex_1d", {getNumNodes()}, lattice_,
+                                   current_time_, total_steps_, total_operations_, error)) {
+            return false;
+        }
+        releaseNodes();
+        return true;
+    }
+
     /**
      * Run mission - execute time evolution
      *
@@ -163,24 +286,55 @@ public:
         auto start_time = std::chrono::high_resolution_clock::now();
         uint64_t operations_this_run = 0;
 
-        for (uint64_t step = 0; step < num_steps; step++) {
-            // Apply driving signals if provided
-            if (input_signals && control_patterns) {
-                IGSOAPhysics::applyDriving(
-                    nodes_,
-                    input_signals[step],
-                    control_patterns[step]
-                );
-                operations_this_run += static_cast<uint64_t>(nodes_.size());
-            }
-
-            // Execute one time step
-            operations_this_run += IGSOAPhysics::timeStep(nodes_, config_);
+        // Evolve on the SoA lattice; the AoS view is refreshed on next access
+        {
+            DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_TRANSFER);
+            syncLatticeFromNodes();
+        }
+        releaseNodes();
+
+        auto gradients = [this](size_t begin, size_t end) {
+            IGSOAPhysicsSoA::computeGradients1D(lattice_, begin, end);
+        };
+        if (config_.integrator == IGSOAIntegrator::RK4 && config_.coupling_mode != IGSOACouplingMode::Recursive) {
+            // Rows of one node: each stage sums the box coupling of the previous stage's Ψ
+            recursive_active_ = false;
+            operations_this_run = IGSOAPhysicsSoA::runRK4Steps(
+                lattice_, config_, num_steps, 1, input_signals, control_patterns, &profiler_, rk4_stages_, nullptr,
+                [this](const double* u_re, const double* u_im, size_t i, const double*& nl_re, const double*& nl_im) {
+                    return IGSOAPhysicsSoA::nodeCouplingRow(i, 1, nl_re, nl_im, [&](size_t j, double& re, double& im) {
+                        return IGSOAPhysicsSoA::boxCoupling1D(lattice_, u_re, u_im, j, re, im);
+                    });
+                },
+                gradients, beginObservables());
+        } else if (config_.coupling_mode == IGSOACouplingMode::Recursive) {
+            // The recursive filter runs along the whole ring: serial sweep
+            operations_this_run = IGSOAPhysicsSoA::runSteps(
+                lattice_, config_, num_steps, 1, input_signals, control_patterns, &profiler_,
+                [this]() { return evolveQuantumState(); },
+                gradients, beginObservables());
+        } else {
+            // Whole mission in one parallel region, Ψ sweep by node bands (see IGSOAPhysicsSoA::runSteps)
+            recursive_active_ = false;
+            const double* psi_re = lattice_.psi_re.data();
+            const double* psi_im = lattice_.psi_im.data();
+            operations_this_run = IGSOAPhysicsSoA::runSteps(
+                lattice_, config_, num_steps, 1, input_signals, control_patterns, &profiler_,
+                IGSOACouplingBands::make(lattice_.size(), IGSOAPhysicsSoA::radiusReach(lattice_)), []() {},
+                [&](size_t begin, size_t end) {
+                    return IGSOAPhysicsSoA::evolveQuantumStateNodes(lattice_, config_.dt, begin, end,
+                        [&](size_t i, double& re, double& im) {
+                            return IGSOAPhysicsSoA::boxCoupling1D(lattice_, psi_re, psi_im, i, re, im);
+                        });
+                },
+                gradients, beginObservables());
+        }
 
-            // Update counters
+        // Same float accumulation as one current_time_ += dt per step
+        for (uint64_t step = 0; step < num_steps; step++) {
             current_time_ += config_.dt;
-            total_steps_++;
         }
+        total_steps_ += num_steps;
 
         auto end_time = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
@@ -195,6 +349,84 @@ public:
         }
     }
 
+    /**
+     * Advance to t_end with step-doubling error control (adaptive_timestep.h)
+     *
+     * Each attempt runs one undriven step of h and, from the same state, two
+     * of h/2; the two-half-step state is kept when the scaled max|ΔΨ| is
+     * within the tolerance. The configured dt is the first guess and is left
+     * unchanged, also when a step throws.
+     * Observables see accepted states only.
+     * total_steps_ counts the kept half steps; total_operations_ all work.
+     */
+    AdaptiveRunStats runUntil(double t_end, const AdaptiveStepConfig& adaptive = AdaptiveStepConfig()) {
+        TrialSteps trial(*this);
+        // Missions that step Euler whatever the integrator (see IGSOAIntegrator)
+        const bool euler_only = config_.coupling_mode == IGSOACouplingMode::Recursive;
+        AdaptiveStepController controller(adaptive, trial.dt_fixed,
+                                          euler_only ? 1 : igsoaIntegratorOrder(config_.integrator));
+        IGSOALatticeSoA start;
+        LatticeArray<double> coarse_re, coarse_im;
+        while (controller.running(current_time_, t_end)) {
+            const double h = controller.proposal(current_time_, t_end);
+            const double t0 = current_time_;
+            const uint64_t steps0 = total_steps_;
+            getLattice().saveStepState(start);
+
+            config_.dt = h;
+            runMission(1);
+            coarse_re = lattice_.psi_re;
+            coarse_im = lattice_.psi_im;
+
+            latticeForWrite().restoreStepState(start);
+            current_time_ = t0;
+            total_steps_ = steps0;
+            config_.dt = 0.5 * h;
+            for (int half = 0; half < 2; half++) {
+                runMission(1);
+                holdObservables();
+            }
+            const double err = StepDoublingError::scaledDifference(
+                lattice_.psi_re.data(), lattice_.psi_im.data(),
+                coarse_re.data(), coarse_im.data(), lattice_.size());
+
+            if (controller.accept(err, h, 2)) {
+                current_time_ = t0 + h;
+                total_steps_ = steps0 + 2;
+                observables_.commitHeld();
+            } else {
+                latticeForWrite().restoreStepState(start);
+                current_time_ = t0;
+                total_steps_ = steps0;
+                observables_.dropHeld();
+            }
+        }
+        return controller.stats();
+    }
+
+    /**
+     * Parallel-in-time mission of num_steps undriven steps (parareal.h)
+     *
+     * Slices run concurrently on worker engines with copies of the
+     * configuration (igsoa_parareal.h); the coarse propagator steps
+     * coarse_stride·dt. The 1D ring has no float32 path, so coarse_float
+     * leaves the coarse steps in double. The result matches
+     * runMission(num_steps) within the tolerance.
+     */
+    PararealStats runParareal(uint64_t num_steps, const PararealConfig& parareal = PararealConfig()) {
+        return runIGSOAParareal<IGSOAComplexEngine>(
+            "igsoa_complex_1d", {getNumNodes()}, latticeForWrite(), config_, current_time_, total_steps_,
+            num_steps, parareal,
+            [](const IGSOAComplexConfig& config) {
+                return std::make_unique<IGSOAComplexEngine>(config);
+            },
+            [](IGSOAComplexEngine& worker, const IGSOALatticeSoA& in, uint64_t steps, IGSOALatticeSoA& out) {
+                worker.latticeForWrite() = in;
+                worker.runMission(steps);
+                out = worker.getLattice();
+            });
+    }
+
     /**
      * Get performance metrics
      *
@@ -215,11 +447,25 @@ public:
         out_total_ops = total_operations_;
     }
 
+    /**
+     * Accumulated time per step phase (IGSOAStepPhase order); cleared by reset()
+     */
+    std::vector<PhaseTiming> getPhaseTimings() const {
+        return profiler_.snapshot();
+    }
+
+    void resetPhaseTimings() {
+        profiler_.reset();
+    }
+
     /**
      * Compute total system energy
      * E = ∑_i [|Ψ_i|² + Φ_i²]
      */
     double getTotalEnergy() const {
+        if (!soa_stale_) {
+            return IGSOAPhysicsSoA::computeTotalEnergy(lattice_);
+        }
         return IGSOAPhysics::computeTotalEnergy(nodes_);
     }
 
@@ -228,19 +474,53 @@ public:
      * Ṡ_total = ∑_i Ṡ_i
      */
     double getTotalEntropyRate() const {
+        if (!soa_stale_) {
+            return IGSOAPhysicsSoA::computeTotalEntropyRate(lattice_);
+        }
         return IGSOAPhysics::computeTotalEntropyRate(nodes_);
     }
 
+    /**
+     * Record mask's observables (DiagnosticMask bits, igsoa_diagnostics.h;
+     * x_cm is the circular mean on the ring) and the probe nodes every
+     * interval steps of later missions into a ring of capacity samples.
+     * Clears the series; no channels disables.
+     */
+    void setObservableRecording(uint32_t mask, uint64_t interval, size_t capacity,
+                                const std::vector<IGSOAProbe>& probes = std::vector<IGSOAProbe>()) {
+        observables_.configure(mask, interval, capacity, 1, probes);
+    }
+
+    /**
+     * Sliding spectrum of every recorded channel, updated with each sample
+     * (frequencies in cycles per unit time; none disables)
+     */
+    void setObservableSpectrum(const SlidingSpectrumConfig& config) {
+        observables_.configureSpectrum(config, config_.dt);
+    }
+
+    /**
+     * Recorded series (observables_.series()) and its configuration
+     */
+    const IGSOAObservableRecorder& getObservableRecorder() const {
+        return observables_;
+    }
+
+    void clearObservables() {
+        observables_.clear();
+    }
+
     /**
      * Get average informational density
      * <F> = (1/N) ∑_i |Ψ_i|²
      */
     double getAverageInformationalDensity() const {
+        syncLatticeFromNodes();
         double sum = 0.0;
-        for (const auto& node : nodes_) {
-            sum += node.F;
+        for (size_t i = 0; i < lattice_.size(); i++) {
+            sum += lattice_.F[i];
         }
-        return sum / nodes_.size();
+        return sum / lattice_.size();
     }
 
     /**
@@ -248,29 +528,23 @@ public:
      * <θ> = (1/N) ∑_i arg(Ψ_i)
      */
     double getAveragePhase() const {
+        syncLatticeFromNodes();
+        constexpr size_t kChunk = 256;
+        double phase[kChunk];
         double sum = 0.0;
-        for (const auto& node : nodes_) {
-            sum += node.phase;
+        for (size_t begin = 0; begin < lattice_.size(); begin += kChunk) {
+            const size_t count = std::min(kChunk, lattice_.size() - begin);
+            atan2Array(lattice_.psi_im.data() + begin, lattice_.psi_re.data() + begin, phase, count);
+            for (size_t j = 0; j < count; j++) sum += phase[j];
         }
-        return sum / nodes_.size();
+        return sum / lattice_.size();
     }
 
     /**
      * Reset engine to initial state
      */
     void reset() {
-        for (auto& node : nodes_) {
-            node.psi = std::complex<double>(0.0, 0.0);
-            node.psi_dot = std::complex<double>(0.0, 0.0);
-            node.phi = 0.0;
-            node.phi_dot = 0.0;
-            node.F = 0.0;
-            node.F_gradient = 0.0;
-            node.entropy_rate = 0.0;
-            node.T_IGS = 0.0;
-            node.phase = 0.0;
-            node.harmonic_count = 0;
-        }
+        latticeForWrite().clearState();
 
         current_time_ = 0.0;
         total_steps_ = 0;
@@ -278,25 +552,168 @@ public:
         ns_per_op_ = 0.0;
         ops_per_sec_ = 0.0;
         last_execution_time_ns_ = 0;
+        profiler_.reset();
     }
 
     /**
-     * Get direct access to nodes (for advanced use)
+     * Get direct access to nodes (AoS compatibility view, for advanced use)
+     *
+     * The returned reference is refreshed from the lattice on each call;
+     * re-fetch it after runMission().
      */
     const std::vector<IGSOAComplexNode>& getNodes() const {
+        syncNodesFromLattice();
         return nodes_;
     }
 
     /**
-     * Get mutable access to nodes (for advanced use)
+     * Whether the AoS view is allocated (between getNodes() and the next
+     * write to the lattice)
+     */
+    bool hasNodeView() const {
+        return !nodes_.empty();
+    }
+
+    /**
+     * Get mutable access to nodes (AoS compatibility view, for advanced use)
+     *
+     * Edits are picked up by the next runMission(); re-fetch after it returns.
      */
     std::vector<IGSOAComplexNode>& getNodesMutable() {
-        return nodes_;
+        return nodesForWrite();
+    }
+
+    /**
+     * Get the SoA lattice (authoritative state during evolution)
+     */
+    const IGSOALatticeSoA& getLattice() const {
+        syncLatticeFromNodes();
+        return lattice_;
     }
 
 private:
+    /**
+     * Recorder for runSteps() starting at the current step (nullptr if off)
+     */
+    IGSOAObservableRecorder* beginObservables() {
+        if (!observables_.enabled() || trial_steps_) return nullptr;
+        observables_.beginMission(lattice_.size(), 1, 1, total_steps_, current_time_, config_.dt);
+        return &observables_;
+    }
+
+    /**
+     * runUntil() trial steps: missions skip the recorders, and the dt,
+     * held samples and flag are restored when the scope ends or unwinds
+     */
+    struct TrialSteps {
+        IGSOAComplexEngine& engine;
+        const double dt_fixed;
+
+        explicit TrialSteps(IGSOAComplexEngine& e) : engine(e), dt_fixed(e.config_.dt) {
+            engine.trial_steps_ = true;
+        }
+        ~TrialSteps() { end(); }
+        void end() {
+            engine.config_.dt = dt_fixed;
+            engine.trial_steps_ = false;
+            engine.observables_.dropHeld();
+        }
+    };
+
+    /**
+     * Sample the trial state if its step is due; runUntil() commits or drops it
+     */
+    void holdObservables() {
+        if (!observables_.enabled() || total_steps_ % observables_.interval() != 0) return;
+        DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_OBSERVABLES);
+        observables_.beginMission(lattice_.size(), 1, 1, total_steps_, current_time_, config_.dt);
+        observables_.hold(getLattice(), total_steps_, current_time_);
+    }
+
+    /**
+     * One in-place Ψ sweep with the configured coupling strategy
+     */
+    uint64_t evolveQuantumState() {
+        if (config_.coupling_mode == IGSOACouplingMode::Recursive) {
+            uint64_t operations = 0;
+            recursive_active_ = IGSOAPhysicsSoA::evolveQuantumState1DRecursive(
+                lattice_, config_.dt, recursive_scratch_, operations);
+            if (recursive_active_) return operations;
+        }
+        recursive_active_ = false;
+        return IGSOAPhysicsSoA::evolveQuantumState1D(lattice_, config_.dt);
+    }
+
+    /**
+     * Refresh the AoS view if the lattice holds newer state
+     */
+    void syncNodesFromLattice() const {
+        if (aos_stale_) {
+            lattice_.storeTo(nodes_);  // allocates the view on first use
+            aos_stale_ = false;
+        }
+    }
+
+    /**
+     * Refresh the lattice if the AoS view holds newer state
+     */
+    void syncLatticeFromNodes() const {
+        if (soa_stale_) {
+            lattice_.loadFrom(nodes_);
+            soa_stale_ = false;
+        }
+    }
+
+    /**
+     * AoS view for mutation; marks the lattice stale
+     */
+    std::vector<IGSOAComplexNode>& nodesForWrite() {
+        syncNodesFromLattice();
+        soa_stale_ = true;
+        return nodes_;
+    }
+
+    /**
+     * SoA lattice for mutation; marks the AoS view stale
+     */
+    IGSOALatticeSoA& latticeForWrite() {
+        syncLatticeFromNodes();
+        releaseNodes();
+        return lattice_;
+    }
+
+    /**
+     * Mark the AoS view stale and free it; the lattice must be current
+     */
+    void releaseNodes() const {
+        aos_stale_ = true;
+        std::vector<IGSOAComplexNode>().swap(nodes_);
+    }
+
+    bool rangeFits(size_t first, size_t count, size_t stride) const {
+        return stride > 0 && first <= getNumNodes() && count <= getNumNodes() - first;
+    }
+
     IGSOAComplexConfig config_;
-    std::vector<IGSOAComplexNode> nodes_;
+
+    // Storage: lattice_ is evolved, nodes_ is the AoS compatibility view,
+    // allocated while it is current and freed once the lattice moves on.
+    // At most one of the two is stale at any time.
+    mutable std::vector<IGSOAComplexNode> nodes_;
+    mutable IGSOALatticeSoA lattice_;
+    mutable bool aos_stale_ = true;
+    mutable bool soa_stale_ = false;
+
+    // Recursive coupling: right-sum and seam buffers, reused across steps
+    std::vector<double> recursive_scratch_;
+    bool recursive_active_ = false;
+    bool trial_steps_ = false;    // Inside runUntil() attempts (see TrialSteps)
+
+    // RK4 stage buffers (allocated by the first RK4 mission)
+    IGSOARK4Stages rk4_stages_;
+
+    // Observable time series recorded inside the step loop
+    IGSOAObservableRecorder observables_;
 
     // Simulation state
     double current_time_;
@@ -307,6 +724,7 @@ private:
     double ns_per_op_ = 0.0;
     double ops_per_sec_ = 0.0;
     int64_t last_execution_time_ns_ = 0;
+    IGSOAStepProfiler profiler_;         // Per-phase step timing
 };
 
 } // namespace igsoa
@@ -9,6 +9,8 @@
  * - Distance metric: Euclidean distance with wrapping
  * - Coupling region: Circular R_c neighborhood (not just linear)
  * - Memory layout: Row-major (cache-friendly sequential access)
+ * - Storage: IGSOALatticeSoA while time-stepping; IGSOAComplexNode (AoS)
+ *   kept as a lazily synchronized compatibility view for node accessors
  *
  * Physics Preserved:
  * - Same IGSOA evolution equations
@@ -20,6 +22,14 @@
 
 #include "igsoa_complex_node.h"
 #include "igsoa_physics_2d.h"
+#include "igsoa_coupling_stencil.h"
+#include "igsoa_lattice_soa.h"
+#include "igsoa_checkpoint.h"
+#include "neighbor_cache.h"
+#include "igsoa_physics_soa.h"
+#include "igsoa_diagnostics.h"
+#include "adaptive_timestep.h"
+#include "igsoa_parareal.h"
 #include <vector>
 #include <stdexcept>
 #include <memory>
@@ -48,7 +58,6 @@ public:
         : config_(config)
         , N_x_(N_x)
         , N_y_(N_y)
-        , nodes_(N_x * N_y)
         , current_time_(0.0)
         , total_steps_(0)
         , total_operations_(0)
@@ -65,12 +74,9 @@ public:
             throw std::invalid_argument("Total nodes exceeds limit (100M max)");
         }
 
-        // Initialize all nodes with configuration
-        for (auto& node : nodes_) {
-            node.R_c = config.R_c_default;
-            node.kappa = config.kappa;
-            node.gamma = config.gamma;
-        }
+        // The lattice is the state from the start; the AoS view is built on request
+        lattice_.resize(total);
+        lattice_.fillParameters(config.R_c_default, config.kappa, config.gamma);
     }
 
     /**
@@ -133,10 +139,8 @@ public:
      */
     void setNodePsi(size_t x, size_t y, double real, double imag) {
         size_t index = coordToIndex(x, y);
-        if (index < nodes_.size()) {
-            nodes_[index].psi = std::complex<double>(real, imag);
-            nodes_[index].updateInformationalDensity();
-            nodes_[index].updatePhase();
+        if (index < getTotalNodes()) {
+            latticeForWrite().writePsi(index, 1, &real, &imag);
         }
     }
 
@@ -145,9 +149,10 @@ public:
      */
     void getNodePsi(size_t x, size_t y, double& real_out, double& imag_out) const {
         size_t index = coordToIndex(x, y);
-        if (index < nodes_.size()) {
-            real_out = nodes_[index].psi.real();
-            imag_out = nodes_[index].psi.imag();
+        if (index < getTotalNodes()) {
+            const IGSOALatticeSoA& lattice = getLattice();
+            real_out = lattice.psi_re[index];
+            imag_out = lattice.psi_im[index];
         } else {
             real_out = 0.0;
             imag_out = 0.0;
@@ -159,8 +164,8 @@ public:
      */
     void setNodePhi(size_t x, size_t y, double value) {
         size_t index = coordToIndex(x, y);
-        if (index < nodes_.size()) {
-            nodes_[index].phi = value;
+        if (index < getTotalNodes()) {
+            latticeForWrite().phi[index] = value;
         }
     }
 
@@ -169,8 +174,8 @@ public:
      */
     double getNodePhi(size_t x, size_t y) const {
         size_t index = coordToIndex(x, y);
-        if (index < nodes_.size()) {
-            return nodes_[index].phi;
+        if (index < getTotalNodes()) {
+            return getLattice().phi[index];
         }
         return 0.0;
     }
@@ -180,12 +185,79 @@ public:
      */
     double getNodeF(size_t x, size_t y) const {
         size_t index = coordToIndex(x, y);
-        if (index < nodes_.size()) {
-            return nodes_[index].F;
+        if (index < getTotalNodes()) {
+            return getLattice().F[index];
         }
         return 0.0;
     }
 
+    /**
+     * Bulk state access for nodes [first, first + count)
+     *
+     * Indices are row-major (y * N_x + x), as in getLattice().
+     *
+     * Buffers are caller-owned and addressed with an element stride (stride 2
+     * reads/writes one half of an interleaved complex array). Data moves
+     * directly between the buffers and the SoA lattice, without the per-node
+     * AoS round trip of setNodePsi/getNodePsi.
+     *
+     * @return false if the range does not fit the engine or a buffer is null
+     */
+    bool setPsiRange(size_t first, size_t count, const double* re, const double* im, size_t stride = 1) {
+        if (!re || !im || !rangeFits(first, count, stride)) return false;
+        latticeForWrite().writePsi(first, count, re, im, stride);
+        return true;
+    }
+
+    bool getPsiRange(size_t first, size_t count, double* re, double* im, size_t stride = 1) const {
+        if (!re || !im || !rangeFits(first, count, stride)) return false;
+        getLattice().readPsi(first, count, re, im, stride);
+        return true;
+    }
+
+    bool setPhiRange(size_t first, size_t count, const double* values, size_t stride = 1) {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        latticeForWrite().writePhi(first, count, values, stride);
+        return true;
+    }
+
+    bool getPhiRange(size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        getLattice().readPhi(first, count, values, stride);
+        return true;
+    }
+
+    bool getFRange(size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        getLattice().readF(first, count, values, stride);
+        return true;
+    }
+
+    /**
+     * Checkpoint/restart (see checkpoint_file.h)
+     *
+     * saveCheckpoint() references the lattice planes: write the checkpoint
+     * before the next runMission(), or use writeAsync(), which snapshots
+     * first. loadCheckpoint() requires a checkpoint of the same engine type
+     * and dimensions and leaves the engine unchanged on failure.
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.setEngineType("igsoa_complex_2d");
+        saveLatticeCheckpoint(writer, {N_x_, N_y_}, getLattice(),
+                              current_time_, total_steps_, total_operations_);
+    }
+
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error = nullptr) {
+        syncLatticeFromNodes();
+        if (!loadLatticeCheckpoint(reader, "igsoa_complex_2d", {N_x_, N_y_}, lattice_,
+                                   current_time_, total_steps_, total_operations_, error)) {
+            return false;
+        }
+        releaseNodes();
+        coupling_dirty_ = true;
+        return true;
+    }
+
     /**
      * Run mission - execute time evolution
      *
@@ -201,23 +273,39 @@ public:
         auto start_time = std::chrono::high_resolution_clock::now();
         uint64_t operations_this_run = 0;
 
-        for (uint64_t step = 0; step < num_steps; step++) {
-            // Apply driving signals if provided
-            if (input_signals && control_patterns) {
-                IGSOAPhysics2D::applyDriving(
-                    nodes_,
-                    input_signals[step],
-                    control_patterns[step]
-                );
-                operations_this_run += static_cast<uint64_t>(nodes_.size());
-            }
+        // Evolve on the SoA lattice; the AoS view is refreshed on next access
+        {
+            DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_TRANSFER);
+            syncLatticeFromNodes();
+        }
+        releaseNodes();
+        refreshCoupling();
+        float_active_ = usesFloatStencil();
 
-            // Execute one time step (2D version)
-            operations_this_run += IGSOAPhysics2D::timeStep(nodes_, config_, N_x_, N_y_);
+        const bool driven = input_signals && control_patterns;
 
-            // Update counters
-            current_time_ += config_.dt;
-            total_steps_++;
+        if (float_active_) {
+            noteActiveRegionFallback(num_steps, "float32");
+            operations_this_run = runFloat(num_steps, input_signals, control_patterns);
+        } else {
+            if (config_.integrator == IGSOAIntegrator::RK4) {
+                noteActiveRegionFallback(num_steps, "rk4");
+                operations_this_run = runRK4(num_steps, input_signals, control_patterns);
+            } else {
+                // Quiescent tiles skipped while the mask applies (driven missions never use it)
+                const uint64_t masked_steps = runActiveRegion(num_steps, driven, operations_this_run);
+
+                // Whole mission in one parallel region, Ψ sweep by row bands (see IGSOAPhysicsSoA::runSteps)
+                operations_this_run += IGSOAPhysicsSoA::runSteps(
+                    lattice_, config_, num_steps - masked_steps, N_x_, input_signals, control_patterns, &profiler_,
+                    couplingBands(), [this]() { prepareCoupling(); },
+                    [this](size_t y_begin, size_t y_end) { return evolveCoupling(y_begin, y_end); },
+                    [this](size_t row_begin, size_t row_end) {
+                        IGSOAPhysicsSoA::computeGradients2D(lattice_, N_x_, N_y_, row_begin, row_end);
+                    },
+                    beginObservables());
+            }
+            advanceClock(num_steps);
         }
 
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -231,6 +319,213 @@ public:
             ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
             ops_per_sec_ = 1.0e9 / ns_per_op_;
         }
+
+        if (mission_diagnostics_mask_ != 0 && !trial_steps_) {
+            mission_diagnostics_ = computeDiagnostics(mission_diagnostics_mask_);
+        }
+    }
+
+    /**
+     * Advance to t_end with step-doubling error control (adaptive_timestep.h)
+     *
+     * Each attempt runs one undriven step of h and, from the same state, two
+     * of h/2; the two-half-step state is kept when the scaled max|ΔΨ| is
+     * within the tolerance. The configured dt is the first guess and is left
+     * unchanged, also when a step throws.
+     * Observables and mission diagnostics see accepted states only.
+     * total_steps_ counts the kept half steps; total_operations_ all work.
+     */
+    AdaptiveRunStats runUntil(double t_end, const AdaptiveStepConfig& adaptive = AdaptiveStepConfig()) {
+        TrialSteps trial(*this);
+        AdaptiveStepController controller(adaptive, trial.dt_fixed, igsoaIntegratorOrder(config_.integrator));
+        IGSOALatticeSoA start;
+        LatticeArray<double> coarse_re, coarse_im;
+        while (controller.running(current_time_, t_end)) {
+            const double h = controller.proposal(current_time_, t_end);
+            const double t0 = current_time_;
+            const uint64_t steps0 = total_steps_;
+            getLattice().saveStepState(start);
+
+            config_.dt = h;
+            runMission(1);
+            coarse_re = lattice_.psi_re;
+            coarse_im = lattice_.psi_im;
+
+            latticeForWrite().restoreStepState(start);
+            current_time_ = t0;
+            total_steps_ = steps0;
+            config_.dt = 0.5 * h;
+            for (int half = 0; half < 2; half++) {
+                runMission(1);
+                holdObservables();
+            }
+            const double err = StepDoublingError::scaledDifference(
+                lattice_.psi_re.data(), lattice_.psi_im.data(),
+                coarse_re.data(), coarse_im.data(), lattice_.size());
+
+            if (controller.accept(err, h, 2)) {
+                current_time_ = t0 + h;
+                total_steps_ = steps0 + 2;
+                observables_.commitHeld();
+            } else {
+                latticeForWrite().restoreStepState(start);
+                current_time_ = t0;
+                total_steps_ = steps0;
+                observables_.dropHeld();
+            }
+        }
+        trial.end();
+        if (mission_diagnostics_mask_ != 0) {
+            mission_diagnostics_ = computeDiagnostics(mission_diagnostics_mask_);
+        }
+        return controller.stats();
+    }
+
+    /**
+     * Parallel-in-time mission of num_steps undriven steps (parareal.h)
+     *
+     * Slices run concurrently on worker engines with copies of the
+     * configuration (igsoa_parareal.h); the coarse propagator steps
+     * coarse_stride·dt, optionally in float32. The result matches
+     * runMission(num_steps) within the tolerance.
+     */
+    PararealStats runParareal(uint64_t num_steps, const PararealConfig& parareal = PararealConfig()) {
+        return runIGSOAParareal<IGSOAComplexEngine2D>(
+            "igsoa_complex_2d", {N_x_, N_y_}, latticeForWrite(), config_, current_time_, total_steps_,
+            num_steps, parareal,
+            [this](const IGSOAComplexConfig& config) {
+                return std::make_unique<IGSOAComplexEngine2D>(config, N_x_, N_y_);
+            },
+            [](IGSOAComplexEngine2D& worker, const IGSOALatticeSoA& in, uint64_t steps, IGSOALatticeSoA& out) {
+                worker.latticeForWrite() = in;
+                worker.runMission(steps);
+                out = worker.getLattice();
+            });
+    }
+
+    /**
+     * Get / set the non-local coupling strategy
+     *
+     * Switching away from a mode releases its cache; the new mode's cache
+     * is built on the next runMission().
+     */
+    IGSOACouplingMode getCouplingMode() const {
+        return config_.coupling_mode;
+    }
+
+    void setCouplingMode(IGSOACouplingMode mode) {
+        if (mode == config_.coupling_mode) return;
+        config_.coupling_mode = mode;
+        if (mode != IGSOACouplingMode::NeighborCache) {
+            neighbor_cache_.reset();
+        }
+        if (mode != IGSOACouplingMode::Spectral) {
+            spectral_.reset();
+            spectral_active_ = false;
+        }
+        coupling_dirty_ = true;
+    }
+
+    /**
+     * Get the neighbor cache (nullptr unless built in NeighborCache mode)
+     */
+    const NeighborCache2D* getNeighborCache() const {
+        return neighbor_cache_.get();
+    }
+
+    /**
+     * Bytes held by coupling caches (neighbor lists, stencil or FFT spectrum)
+     */
+    size_t getCouplingCacheMemoryUsage() const {
+        size_t total = stencil_.getMemoryUsage();
+        if (neighbor_cache_) {
+            total += neighbor_cache_->getMemoryUsage();
+        }
+        if (spectral_) {
+            total += spectral_->getMemoryUsage();
+        }
+        return total;
+    }
+
+    /**
+     * True if the last runMission() evaluated the coupling by FFT
+     */
+    bool isSpectralCouplingActive() const {
+        return spectral_active_;
+    }
+
+    /**
+     * Get / set active-region stepping (igsoa_active_region.h)
+     *
+     * When enabled, undriven Direct-mode missions with a uniform R_c and
+     * normalize_psi off only step tiles within the stencil reach of a node
+     * above the threshold; other missions run on the whole lattice and are
+     * counted as fallback steps. Setting the configuration clears the
+     * statistics.
+     */
+    const ActiveRegionConfig& getActiveRegion() const {
+        return active_config_;
+    }
+
+    void setActiveRegion(const ActiveRegionConfig& config) {
+        active_config_ = config;
+        active_region_ = IGSOAActiveRegion();
+    }
+
+    const ActiveRegionStats& getActiveRegionStats() const {
+        return active_region_.stats();
+    }
+
+    /**
+     * Get / set the stepping precision (takes effect on the next runMission())
+     */
+    IGSOAPrecision getPrecision() const {
+        return config_.precision;
+    }
+
+    void setPrecision(IGSOAPrecision precision) {
+        config_.precision = precision;
+        if (precision == IGSOAPrecision::Double) {
+            lattice_f32_ = IGSOALatticeSoAF32();
+        }
+    }
+
+    /**
+     * Get / set the time integrator (takes effect on the next runMission()).
+     * Switching to Euler frees the RK4 stages.
+     */
+    IGSOAIntegrator getIntegrator() const {
+        return config_.integrator;
+    }
+
+    void setIntegrator(IGSOAIntegrator integrator) {
+        config_.integrator = integrator;
+        if (integrator == IGSOAIntegrator::Euler) {
+            rk4_stages_ = IGSOARK4Stages();
+            rk4_stages_f32_ = IGSOARK4StagesF32();
+        }
+    }
+
+    /**
+     * Bytes held by the RK4 stage buffers
+     */
+    size_t getIntegratorMemoryUsage() const {
+        return rk4_stages_.getMemoryUsage() + rk4_stages_f32_.getMemoryUsage();
+    }
+
+    /**
+     * True if the last runMission() stepped in float32
+     */
+    bool isFloatPrecisionActive() const {
+        return float_active_;
+    }
+
+    /**
+     * Integer R_c whose compile-time stencil kernel steps Direct mode
+     * (0: generic stencil or box search; valid after the first runMission)
+     */
+    int getFixedStencilRadius() const {
+        return fixed_radius_;
     }
 
     /**
@@ -248,11 +543,25 @@ public:
         out_total_ops = total_operations_;
     }
 
+    /**
+     * Accumulated time per step phase (IGSOAStepPhase order); cleared by reset()
+     */
+    std::vector<PhaseTiming> getPhaseTimings() const {
+        return profiler_.snapshot();
+    }
+
+    void resetPhaseTimings() {
+        profiler_.reset();
+    }
+
     /**
      * Compute total system energy
      * E = ∑_i [|Ψ_i|² + Φ_i²]
      */
     double getTotalEnergy() const {
+        if (!soa_stale_) {
+            return IGSOAPhysicsSoA::computeTotalEnergy(lattice_);
+        }
         return IGSOAPhysics2D::computeTotalEnergy(nodes_);
     }
 
@@ -261,37 +570,89 @@ public:
      * Ṡ_total = ∑_i Ṡ_i
      */
     double getTotalEntropyRate() const {
+        if (!soa_stale_) {
+            return IGSOAPhysicsSoA::computeTotalEntropyRate(lattice_);
+        }
         return IGSOAPhysics2D::computeTotalEntropyRate(nodes_);
     }
 
+    /**
+     * Energy, entropy rate and/or center of mass in one threaded pass
+     *
+     * @param mask DiagnosticMask bits (igsoa_diagnostics.h)
+     */
+    IGSOADiagnostics computeDiagnostics(uint32_t mask = DIAG_ALL) const {
+        return diagnostics_.compute(getLattice(), N_x_, N_y_, 1, mask);
+    }
+
+    /**
+     * Observables computed right after the last step of every runMission()
+     * (0 disables)
+     */
+    void setMissionDiagnostics(uint32_t mask) {
+        mission_diagnostics_mask_ = mask;
+        mission_diagnostics_ = IGSOADiagnostics();
+    }
+
+    uint32_t getMissionDiagnosticsMask() const {
+        return mission_diagnostics_mask_;
+    }
+
+    /**
+     * Observables of the last runMission() (mask 0 if none were requested)
+     */
+    const IGSOADiagnostics& getMissionDiagnostics() const {
+        return mission_diagnostics_;
+    }
+
+    /**
+     * Record mask's observables and the probe nodes every interval steps of
+     * later missions into a ring of capacity samples (clears the series; no
+     * channels disables). While recording the active-region mask does not
+     * apply.
+     */
+    void setObservableRecording(uint32_t mask, uint64_t interval, size_t capacity,
+                                const std::vector<IGSOAProbe>& probes = std::vector<IGSOAProbe>()) {
+        observables_.configure(mask, interval, capacity, 2, probes);
+    }
+
+    /**
+     * Sliding spectrum of every recorded channel, updated with each sample
+     * (frequencies in cycles per unit time; none disables)
+     */
+    void setObservableSpectrum(const SlidingSpectrumConfig& config) {
+        observables_.configureSpectrum(config, config_.dt);
+    }
+
+    /**
+     * Recorded series (observables_.series()) and its configuration
+     */
+    const IGSOAObservableRecorder& getObservableRecorder() const {
+        return observables_;
+    }
+
+    void clearObservables() {
+        observables_.clear();
+    }
+
     /**
      * Get average informational density
      * <F> = (1/N) ∑_i |Ψ_i|²
      */
     double getAverageInformationalDensity() const {
+        const IGSOALatticeSoA& lattice = getLattice();
         double sum = 0.0;
-        for (const auto& node : nodes_) {
-            sum += node.F;
+        for (size_t i = 0; i < lattice.size(); i++) {
+            sum += lattice.F[i];
         }
-        return sum / nodes_.size();
+        return sum / lattice.size();
     }
 
     /**
      * Reset engine to initial state
      */
     void reset() {
-        for (auto& node : nodes_) {
-            node.psi = std::complex<double>(0.0, 0.0);
-            node.psi_dot = std::complex<double>(0.0, 0.0);
-            node.phi = 0.0;
-            node.phi_dot = 0.0;
-            node.F = 0.0;
-            node.F_gradient = 0.0;
-            node.entropy_rate = 0.0;
-            node.T_IGS = 0.0;
-            node.phase = 0.0;
-            node.harmonic_count = 0;
-        }
+        latticeForWrite().clearState();
 
         current_time_ = 0.0;
         total_steps_ = 0;
@@ -299,27 +660,509 @@ public:
         ns_per_op_ = 0.0;
         ops_per_sec_ = 0.0;
         last_execution_time_ns_ = 0;
+        profiler_.reset();
+        active_region_ = IGSOAActiveRegion();
     }
 
     /**
-     * Get direct access to nodes (for advanced use)
+     * Re-initialize as a new engine with config (same lattice size)
+     *
+     * The state equals IGSOAComplexEngine2D(config, N_x, N_y), but the
+     * lattice planes and coupling caches stay allocated: caches
+     * are only rebuilt on the next runMission() if R_c or the coupling mode
+     * changed. Mission diagnostics, observable recording and active-region
+     * stepping are switched off, as on a new engine.
+     */
+    void reinitialize(const IGSOAComplexConfig& config) {
+        setCouplingMode(config.coupling_mode);
+        setPrecision(config.precision);
+        setIntegrator(config.integrator);
+        config_ = config;
+        config_.num_nodes = N_x_ * N_y_;
+
+        IGSOALatticeSoA& lattice = latticeForWrite();
+        lattice.clearState();
+        lattice.fillParameters(config.R_c_default, config.kappa, config.gamma);
+        coupling_dirty_ = true;
+
+        current_time_ = 0.0;
+        total_steps_ = 0;
+        total_operations_ = 0;
+        ns_per_op_ = 0.0;
+        ops_per_sec_ = 0.0;
+        last_execution_time_ns_ = 0;
+        profiler_.reset();
+        setActiveRegion(ActiveRegionConfig());
+        setMissionDiagnostics(0);
+        observables_.disable();
+    }
+
+    /**
+     * Lattice planes of an N_x × N_y engine (coupling caches not included;
+     * the AoS view exists only between getNodes() and the next mission)
+     */
+    static size_t estimateMemoryUsage(size_t N_x, size_t N_y) {
+        return IGSOALatticeSoA::estimateMemoryUsage(N_x * N_y);
+    }
+
+    /**
+     * Bytes an engine created with config holds once its missions have
+     * built their caches: estimateMemoryUsage(), the coupling cache of
+     * config's mode for a uniform R_c_default (CSR lists, or stencil plus
+     * kernel spectrum when Spectral would use the FFT), the float32
+     * working copy and the RK4 stages.
+     */
+    static size_t estimateFootprint(const IGSOAComplexConfig& config, size_t N_x, size_t N_y) {
+        const size_t N = N_x * N_y;
+        size_t total = estimateMemoryUsage(N_x, N_y);
+        if (config.coupling_mode == IGSOACouplingMode::NeighborCache) {
+            total += NeighborCache2D::estimateMemoryUsage(N_x, N_y, config.R_c_default);
+        } else {
+            CouplingStencil2D stencil;
+            stencil.build(config.R_c_default, N_x, N_y);
+            total += stencil.getMemoryUsage();
+            if (config.coupling_mode == IGSOACouplingMode::Spectral &&
+                SpectralCoupling::isFavorable(stencil.size(), N)) {
+                total += SpectralCoupling::estimateMemoryUsage(N);
+            }
+        }
+        if (config.precision == IGSOAPrecision::Float) {
+            total += IGSOALatticeSoAF32::estimateMemoryUsage(N);
+        }
+        if (config.integrator == IGSOAIntegrator::RK4) {
+            total += config.precision == IGSOAPrecision::Float ? IGSOARK4StagesF32::estimateMemoryUsage(N)
+                                                                : IGSOARK4Stages::estimateMemoryUsage(N);
+        }
+        return total;
+    }
+
+    /**
+     * Get direct access to nodes (AoS compatibility view, for advanced use)
+     *
+     * The returned reference is refreshed from the lattice on each call;
+     * re-fetch it after runMission().
      */
     const std::vector<IGSOAComplexNode>& getNodes() const {
+        syncNodesFromLattice();
         return nodes_;
     }
 
     /**
-     * Get mutable access to nodes (for advanced use)
+     * Whether the AoS view is allocated (between getNodes() and the next
+     * write to the lattice)
+     */
+    bool hasNodeView() const {
+        return !nodes_.empty();
+    }
+
+    /**
+     * Get mutable access to nodes (AoS compatibility view, for advanced use)
+     *
+     * Edits are picked up by the next runMission(); re-fetch after it returns.
      */
     std::vector<IGSOAComplexNode>& getNodesMutable() {
-        return nodes_;
+        return nodesForWrite();
+    }
+
+    /**
+     * Get the SoA lattice (authoritative state during evolution)
+     */
+    const IGSOALatticeSoA& getLattice() const {
+        syncLatticeFromNodes();
+        return lattice_;
     }
 
 private:
+    /**
+     * Refresh the AoS view if the lattice holds newer state
+     */
+    void syncNodesFromLattice() const {
+        if (aos_stale_) {
+            lattice_.storeTo(nodes_);
+            aos_stale_ = false;
+        }
+    }
+
+    /**
+     * Refresh the lattice if the AoS view holds newer state
+     */
+    void syncLatticeFromNodes() const {
+        if (soa_stale_) {
+            lattice_.loadFrom(nodes_);
+            soa_stale_ = false;
+            coupling_dirty_ = true;  // R_c may have been edited through the AoS view
+        }
+    }
+
+    /**
+     * AoS view for mutation; marks the lattice stale
+     */
+    std::vector<IGSOAComplexNode>& nodesForWrite() {
+        syncNodesFromLattice();
+        soa_stale_ = true;
+        return nodes_;
+    }
+
+    /**
+     * SoA lattice for mutation; marks the AoS view stale
+     */
+    IGSOALatticeSoA& latticeForWrite() {
+        syncLatticeFromNodes();
+        releaseNodes();
+        return lattice_;
+    }
+
+    /**
+     * Mark the AoS view stale and free it; the lattice must be current
+     */
+    void releaseNodes() const {
+        aos_stale_ = true;
+        std::vector<IGSOAComplexNode>().swap(nodes_);
+    }
+
+    bool rangeFits(size_t first, size_t count, size_t stride) const {
+        return stride > 0 && first <= getTotalNodes() && count <= getTotalNodes() - first;
+    }
+
+    /**
+     * Bring the coupling caches up to date with the lattice R_c
+     *
+     * NeighborCache mode rebuilds the CSR lists when any R_c changed;
+     * Direct mode rebuilds the stencil when the (uniform) R_c changed;
+     * Spectral mode also transforms the stencil when the FFT is cheaper.
+     */
+    void refreshCoupling() {
+        if (!coupling_dirty_) return;
+        coupling_dirty_ = false;
+
+        if (config_.coupling_mode == IGSOACouplingMode::NeighborCache) {
+            if (!neighbor_cache_) {
+                neighbor_cache_ = std::make_unique<NeighborCache2D>(N_x_, N_y_, config_.R_c_default);
+            }
+            if (neighbor_cache_->needsRebuild(lattice_)) {
+                neighbor_cache_->build(lattice_);
+            }
+            return;
+        }
+
+        double R_c = 0.0;
+        stencil_uniform_ = IGSOAPhysicsSoA::hasUniformRadius(lattice_, R_c);
+        if (stencil_uniform_ && !stencil_.matches(R_c, N_x_, N_y_)) {
+            stencil_.build(R_c, N_x_, N_y_);
+        }
+        fixed_radius_ = stencil_uniform_ ? fixedStencilRadius(R_c, N_x_, N_y_) : 0;
+        fixed_kernel_ = IGSOAPhysicsSoA::fixedKernel2D<double>(fixed_radius_);
+        fixed_kernel_f32_ = IGSOAPhysicsSoA::fixedKernel2D<float>(fixed_radius_);
+
+        spectral_active_ = config_.coupling_mode == IGSOACouplingMode::Spectral &&
+                           stencil_uniform_ &&
+                           SpectralCoupling::isFavorable(stencil_.size(), N_x_ * N_y_);
+        if (spectral_active_) {
+            if (!spectral_) {
+                spectral_ = std::make_unique<SpectralCoupling>();
+            }
+            if (!spectral_->matches(R_c, N_x_, N_y_)) {
+                spectral_->build(stencil_, N_x_, N_y_);
+            }
+        }
+    }
+
+    /**
+     * Recorder for runSteps() starting at the current step (nullptr if off)
+     */
+    IGSOAObservableRecorder* beginObservables() {
+        if (!observables_.enabled() || trial_steps_) return nullptr;
+        observables_.beginMission(N_x_, N_y_, 1, total_steps_, current_time_, config_.dt);
+        return &observables_;
+    }
+
+    /**
+     * runUntil() trial steps: missions skip the recorders, and the dt,
+     * held samples and flag are restored when the scope ends or unwinds
+     */
+    struct TrialSteps {
+        IGSOAComplexEngine2D& engine;
+        const double dt_fixed;
+
+        explicit TrialSteps(IGSOAComplexEngine2D& e) : engine(e), dt_fixed(e.config_.dt) {
+            engine.trial_steps_ = true;
+        }
+        ~TrialSteps() { end(); }
+        void end() {
+            engine.config_.dt = dt_fixed;
+            engine.trial_steps_ = false;
+            engine.observables_.dropHeld();
+        }
+    };
+
+    /**
+     * Sample the trial state if its step is due; runUntil() commits or drops it
+     */
+    void holdObservables() {
+        if (!observables_.enabled() || total_steps_ % observables_.interval() != 0) return;
+        DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_OBSERVABLES);
+        observables_.beginMission(N_x_, N_y_, 1, total_steps_, current_time_, config_.dt);
+        observables_.hold(getLattice(), total_steps_, current_time_);
+    }
+
+    /**
+     * True if Float precision applies: Direct/Spectral mode with a uniform R_c
+     * whose coupling runs from the stencil
+     */
+    bool usesFloatStencil() const {
+        return config_.precision == IGSOAPrecision::Float &&
+               config_.coupling_mode != IGSOACouplingMode::NeighborCache &&
+               stencil_uniform_ && !spectral_active_;
+    }
+
+    /**
+     * Advance num_steps on the float32 working copy, converting the lattice
+     * in before the first step and back after the last
+     */
+    uint64_t runFloat(uint64_t num_steps, const double* input_signals, const double* control_patterns) {
+        {
+            DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_TRANSFER);
+            lattice_f32_.assignFrom(lattice_);
+        }
+
+        auto gradients = [this](size_t row_begin, size_t row_end) {
+            IGSOAPhysicsSoA::computeGradients2D(lattice_f32_, N_x_, N_y_, row_begin, row_end);
+        };
+        const uint64_t operations = config_.integrator == IGSOAIntegrator::RK4
+            ? IGSOAPhysicsSoA::runRK4Steps(
+                  lattice_f32_, config_, num_steps, N_x_, input_signals, control_patterns, &profiler_,
+                  rk4_stages_f32_, nullptr,
+                  [this](const float* u_re, const float* u_im, size_t y, const float*& nl_re, const float*& nl_im) {
+                      return IGSOAPhysicsSoA::stencilCouplingRow2D(stencil_, u_re, u_im, N_x_, N_y_, y,
+                                                                   nl_re, nl_im);
+                  },
+                  gradients, beginObservables())
+            : IGSOAPhysicsSoA::runSteps(
+                  lattice_f32_, config_, num_steps, N_x_, input_signals, control_patterns, &profiler_,
+                  IGSOACouplingBands::make(N_y_, static_cast<size_t>(stencil_.reach())), []() {},
+                  [this](size_t y_begin, size_t y_end) {
+                      if (fixed_kernel_f32_) {
+                          return fixed_kernel_f32_(lattice_f32_, config_.dt, N_x_, N_y_, y_begin, y_end, 1.0);
+                      }
+                      return IGSOAPhysicsSoA::evolveQuantumStateRows2D(lattice_f32_, stencil_, config_.dt,
+                                                                       N_x_, N_y_, y_begin, y_end);
+                  },
+                  gradients, beginObservables());
+        advanceClock(num_steps);
+
+        DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_TRANSFER);
+        lattice_.assignFrom(lattice_f32_);
+        return operations;
+    }
+
+    /**
+     * runSteps() with RK4 (IGSOAPhysicsSoA::runRK4Steps) and the configured
+     * coupling strategy; the stencil path uses the generic stencil
+     */
+    uint64_t runRK4(uint64_t num_steps, const double* input_signals, const double* control_patterns) {
+        using Row = const double*;
+        auto gradients = [this](size_t row_begin, size_t row_end) {
+            IGSOAPhysicsSoA::computeGradients2D(lattice_, N_x_, N_y_, row_begin, row_end);
+        };
+        auto run = [&](auto&& prepare, auto&& row_coupling) {
+            return IGSOAPhysicsSoA::runRK4Steps(lattice_, config_, num_steps, N_x_, input_signals, control_patterns,
+                                                &profiler_, rk4_stages_, prepare, row_coupling, gradients,
+                                                beginObservables());
+        };
+
+        if (config_.coupling_mode == IGSOACouplingMode::NeighborCache && neighbor_cache_) {
+            const NeighborCache2D& cache = *neighbor_cache_;
+            return run(nullptr, [&](Row u_re, Row u_im, size_t y, Row& nl_re, Row& nl_im) {
+                return IGSOAPhysicsSoA::nodeCouplingRow(y * N_x_, N_x_, nl_re, nl_im,
+                    [&](size_t i, double& re, double& im) {
+                        cache.computeCoupling(i, u_re, u_im, re, im);
+                        return static_cast<uint64_t>(cache.getNeighborCount(i));
+                    });
+            });
+        }
+        if (spectral_active_) {
+            SpectralCoupling& spectral = *spectral_;
+            const uint64_t terms = spectral.terms();
+            return run([&](Row u_re, Row u_im) { spectral.convolve(u_re, u_im); },
+                       [&](Row, Row, size_t y, Row& nl_re, Row& nl_im) {
+                           return IGSOAPhysicsSoA::nodeCouplingRow(y * N_x_, N_x_, nl_re, nl_im,
+                               [&](size_t i, double& re, double& im) {
+                                   re = spectral.couplingRe(i);
+                                   im = spectral.couplingIm(i);
+                                   return terms;
+                               });
+                       });
+        }
+        if (stencil_uniform_) {
+            return run(nullptr, [&](Row u_re, Row u_im, size_t y, Row& nl_re, Row& nl_im) {
+                return IGSOAPhysicsSoA::stencilCouplingRow2D(stencil_, u_re, u_im, N_x_, N_y_, y, nl_re, nl_im);
+            });
+        }
+        return run(nullptr, [&](Row u_re, Row u_im, size_t y, Row& nl_re, Row& nl_im) {
+            return IGSOAPhysicsSoA::nodeCouplingRow(y * N_x_, N_x_, nl_re, nl_im,
+                [&](size_t i, double& re, double& im) {
+                    return IGSOAPhysicsSoA::boxCoupling2D(lattice_, u_re, u_im, i, N_x_, N_y_, re, im);
+                });
+        });
+    }
+
+    /**
+     * Why the active-region mask cannot step this mission (nullptr if it can)
+     */
+    const char* activeRegionBlocker(bool driven) const {
+        if (driven) return "driven";
+        if (observables_.enabled()) return "observables";
+        if (config_.normalize_psi) return "normalize_psi";
+        if (config_.coupling_mode != IGSOACouplingMode::Direct &&
+            config_.coupling_mode != IGSOACouplingMode::Recursive) return "coupling_mode";
+        if (!stencil_uniform_) return "non_uniform_R_c";
+        return nullptr;
+    }
+
+    void noteActiveRegionFallback(uint64_t num_steps, const char* reason) {
+        if (active_config_.enabled) {
+            active_region_.countFallbackSteps(num_steps, reason);
+        }
+    }
+
+    /**
+     * Step through the active-region mask until it covers the lattice
+     *
+     * @return Steps run (the rest of the mission goes through runSteps)
+     */
+    uint64_t runActiveRegion(uint64_t num_steps, bool driven, uint64_t& operations) {
+        if (!active_config_.enabled) return 0;
+        if (const char* blocker = activeRegionBlocker(driven)) {
+            active_region_.countFallbackSteps(num_steps, blocker);
+            return 0;
+        }
+        active_region_.configure(active_config_, N_x_, N_y_, 1, stencil_.reach());
+        const uint64_t steps = IGSOAPhysicsSoA::runActiveSteps(
+            lattice_, config_, num_steps, N_x_, N_y_, 1, active_region_, &profiler_, couplingBands(),
+            [this](size_t y_begin, size_t y_end) {
+                return IGSOAPhysicsSoA::evolveQuantumState2D(lattice_, stencil_, active_region_,
+                                                             config_.dt, N_x_, N_y_, y_begin, y_end);
+            },
+            operations);
+        active_region_.countDenseSteps(num_steps - steps);
+        return steps;
+    }
+
+    // Same float accumulation as one current_time_ += dt per step
+    void advanceClock(uint64_t num_steps) {
+        for (uint64_t step = 0; step < num_steps; step++) {
+            current_time_ += config_.dt;
+        }
+        total_steps_ += num_steps;
+    }
+
+    /**
+     * Ψ update with the configured coupling strategy
+     */
+    uint64_t evolveCoupling(size_t y_begin, size_t y_end) {
+        const size_t begin = y_begin * N_x_;
+        const size_t end = y_end * N_x_;
+        const double* psi_re = lattice_.psi_re.data();
+        const double* psi_im = lattice_.psi_im.data();
+        if (usesNeighborCache()) {
+            const NeighborCache2D& cache = *neighbor_cache_;
+            return IGSOAPhysicsSoA::evolveQuantumStateNodes(lattice_, config_.dt, begin, end,
+                [&](size_t i, double& re, double& im) {
+                    cache.computeCoupling(i, psi_re, psi_im, re, im);
+                    return static_cast<uint64_t>(cache.getNeighborCount(i));
+                });
+        }
+        if (spectral_active_) {
+            const SpectralCoupling& spectral = *spectral_;
+            const uint64_t terms = spectral.terms();
+            return IGSOAPhysicsSoA::evolveQuantumStateNodes(lattice_, config_.dt, begin, end,
+                [&](size_t i, double& re, double& im) {
+                    re = spectral.couplingRe(i);
+                    im = spectral.couplingIm(i);
+                    return terms;
+                });
+        }
+        if (stencil_uniform_) {
+            if (fixed_kernel_) {
+                return fixed_kernel_(lattice_, config_.dt, N_x_, N_y_, y_begin, y_end, 1.0);
+            }
+            return IGSOAPhysicsSoA::evolveQuantumStateRows2D(lattice_, stencil_, config_.dt, N_x_, N_y_,
+                                                             y_begin, y_end);
+        }
+        return IGSOAPhysicsSoA::evolveQuantumStateNodes(lattice_, config_.dt, begin, end,
+            [&](size_t i, double& re, double& im) {
+                return IGSOAPhysicsSoA::boxCoupling2D(lattice_, psi_re, psi_im, i, N_x_, N_y_, re, im);
+            });
+    }
+
+    // Row bands of the sweep above (spectral couplings come from the start-of-step Ψ)
+    IGSOACouplingBands couplingBands() const {
+        if (!usesNeighborCache() && spectral_active_) {
+            return IGSOACouplingBands::jacobi(N_y_);
+        }
+        if (!usesNeighborCache() && stencil_uniform_) {
+            return IGSOACouplingBands::make(N_y_, static_cast<size_t>(stencil_.reach()));
+        }
+        return IGSOACouplingBands::make(N_y_, IGSOAPhysicsSoA::radiusReach(lattice_));
+    }
+
+    // Start-of-step couplings of Jacobi bands
+    void prepareCoupling() {
+        if (!usesNeighborCache() && spectral_active_) {
+            spectral_->convolve(lattice_.psi_re.data(), lattice_.psi_im.data());
+        }
+    }
+
+    bool usesNeighborCache() const {
+        return config_.coupling_mode == IGSOACouplingMode::NeighborCache && neighbor_cache_ != nullptr;
+    }
+
     IGSOAComplexConfig config_;
     size_t N_x_;  // Lattice width
     size_t N_y_;  // Lattice height
-    std::vector<IGSOAComplexNode> nodes_;  // Row-major layout
+
+    // Storage: lattice_ is evolved, nodes_ is the AoS compatibility view,
+    // allocated while it is current and freed once the lattice moves on.
+    // At most one of the two is stale at any time.
+    mutable std::vector<IGSOAComplexNode> nodes_;  // Row-major layout
+    mutable IGSOALatticeSoA lattice_;
+    mutable bool aos_stale_ = true;
+    mutable bool soa_stale_ = false;
+
+    // Coupling caches: stencil for uniform R_c (Direct), CSR lists (NeighborCache),
+    // kernel spectrum (Spectral, large uniform R_c)
+    CouplingStencil2D stencil_;
+    std::unique_ptr<NeighborCache2D> neighbor_cache_;
+    std::unique_ptr<SpectralCoupling> spectral_;
+    mutable bool coupling_dirty_ = true;
+    bool stencil_uniform_ = false;
+    bool spectral_active_ = false;
+
+    // Unrolled stencil kernels for an integer R_c of 1..5 (nullptr: generic stencil)
+    int fixed_radius_ = 0;
+    IGSOAPhysicsSoA::FixedKernel2D<double> fixed_kernel_ = nullptr;
+    IGSOAPhysicsSoA::FixedKernel2D<float> fixed_kernel_f32_ = nullptr;
+
+    // Float precision: working copy of lattice_ for the duration of a mission
+    IGSOALatticeSoAF32 lattice_f32_;
+    bool float_active_ = false;
+
+    // RK4 stage buffers (allocated by the first RK4 mission of each precision)
+    IGSOARK4Stages rk4_stages_;
+    IGSOARK4StagesF32 rk4_stages_f32_;
+
+    // Active-region stepping: tile mask of the quiescent part of the lattice
+    ActiveRegionConfig active_config_;
+    IGSOAActiveRegion active_region_;
+
+    // Fused diagnostics (per-axis trig tables) and the per-mission results
+    mutable IGSOADiagnosticsPass diagnostics_;
+    uint32_t mission_diagnostics_mask_ = 0;
+    IGSOADiagnostics mission_diagnostics_;
+    bool trial_steps_ = false;    // Inside runUntil() attempts (see TrialSteps)
+
+    // Observable time series recorded inside the step loop
+    IGSOAObservableRecorder observables_;
 
     // Simulation state
     double current_time_;
@@ -330,6 +1173,7 @@ private:
     double ns_per_op_ = 0.0;
     double ops_per_sec_ = 0.0;
     int64_t last_execution_time_ns_ = 0;
+    IGSOAStepProfiler profiler_;         // Per-phase step timing
 };
 
 } // namespace igsoa
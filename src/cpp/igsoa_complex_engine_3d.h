@@ -4,12 +4,36 @@
  * Three-dimensional extension of the IGSOA lattice simulator.  The engine
  * mirrors the 2D implementation while expanding the topology to a toroidal
  * volume of size N_x × N_y × N_z.
+ *
+ * State is evolved on an IGSOALatticeSoA; the IGSOAComplexNode vector is a
+ * lazily synchronized AoS view, allocated by getNodes() and freed once the
+ * lattice moves on.
+ *
+ * Out-of-core mode: when estimateMemoryUsage() exceeds the OutOfCorePolicy
+ * budget (out_of_core.h) at construction, the lattice planes are spill-file
+ * mappings. Undriven missions with a uniform R_c then run one z-slab pass
+ * per step (IGSOAPhysicsSoA::runSlabSteps) with read-ahead of the next
+ * slabs. Other
+ * missions step the same file-backed lattice phase by phase. The Spectral
+ * and NeighborCache modes, float32 and the active region need full
+ * in-RAM copies and are not used. getNodes(), getNodesMutable(),
+ * runUntil() and the state initializers materialize in-RAM copies; fill
+ * the state with setPsiRange() / setPhiRange() instead.
  */
 
 #pragma once
 
 #include "igsoa_complex_node.h"
 #include "igsoa_physics_3d.h"
+#include "igsoa_coupling_stencil.h"
+#include "igsoa_lattice_soa.h"
+#include "igsoa_checkpoint.h"
+#include "neighbor_cache.h"
+#include "igsoa_physics_soa.h"
+#include "igsoa_diagnostics.h"
+#include "adaptive_timestep.h"
+#include "igsoa_parareal.h"
+#include "out_of_core.h"
 #include <chrono>
 #include <memory>
 #include <string>
@@ -29,7 +53,6 @@ public:
         , N_x_(N_x)
         , N_y_(N_y)
         , N_z_(N_z)
-        , nodes_(N_x * N_y * N_z)
         , current_time_(0.0)
         , total_steps_(0)
         , total_operations_(0)
@@ -46,17 +69,79 @@ public:
             throw std::invalid_argument("Total nodes exceeds limit (100M max)");
         }
 
-        for (auto& node : nodes_) {
-            node.R_c = config.R_c_default;
-            node.kappa = config.kappa;
-            node.gamma = config.gamma;
+        const OutOfCorePolicy policy = getOutOfCorePolicy();
+        out_of_core_ = exceedsMemoryBudget(estimateMemoryUsage(N_x, N_y, N_z), policy);
+        prefetch_slabs_ = policy.prefetch_slabs;
+        // The lattice is the state from the start; the AoS view is built on request
+        if (out_of_core_) {
+            try {
+                ScopedFileBacking backing(spillDirectory(policy));
+                lattice_.resize(total);
+            } catch (const std::bad_alloc&) {
+                throw std::runtime_error("Cannot create out-of-core lattice files in " + spillDirectory(policy));
+            }
+        } else {
+            lattice_.resize(total);
+        }
+        lattice_.fillParameters(config.R_c_default, config.kappa, config.gamma);
+    }
+
+    /**
+     * Bytes an engine of this size holds in RAM: the SoA lattice (coupling
+     * caches not included; the AoS view exists only between getNodes() and
+     * the next mission)
+     */
+    static size_t estimateMemoryUsage(size_t N_x, size_t N_y, size_t N_z) {
+        return IGSOALatticeSoA::estimateMemoryUsage(N_x * N_y * N_z);
+    }
+
+    /**
+     * Bytes of RAM an engine created with config holds once its missions
+     * have built their caches: estimateMemoryUsage() (nothing for an
+     * out-of-core lattice under the current OutOfCorePolicy, whose planes
+     * are spill files), the coupling cache of config's mode for a uniform
+     * R_c_default (CSR lists, or stencil plus kernel spectrum when Spectral
+     * would use the FFT), the float32 working copy and the RK4
+     * stages.
+     */
+    static size_t estimateFootprint(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z) {
+        const size_t N = N_x * N_y * N_z;
+        const bool out_of_core = exceedsMemoryBudget(estimateMemoryUsage(N_x, N_y, N_z));
+        size_t total = out_of_core ? 0 : estimateMemoryUsage(N_x, N_y, N_z);
+        const bool rk4 = config.integrator == IGSOAIntegrator::RK4 && !out_of_core;
+        if (config.coupling_mode == IGSOACouplingMode::NeighborCache && !out_of_core) {
+            return total + NeighborCache3D::estimateMemoryUsage(N_x, N_y, N_z, config.R_c_default) +
+                   (rk4 ? IGSOARK4Stages::estimateMemoryUsage(N) : 0);
+        }
+        CouplingStencil3D stencil;
+        stencil.build(config.R_c_default, N_x, N_y, N_z);
+        total += stencil.getMemoryUsage();
+        if (out_of_core) {
+            return total;
+        }
+        const bool spectral = config.coupling_mode == IGSOACouplingMode::Spectral &&
+                              SpectralCoupling::isFavorable(stencil.size(), N);
+        if (spectral) {
+            total += SpectralCoupling::estimateMemoryUsage(N);
         }
+        if (config.precision == IGSOAPrecision::Float) {
+            total += IGSOALatticeSoAF32::estimateMemoryUsage(N);
+            if (rk4) total += IGSOARK4StagesF32::estimateMemoryUsage(N);
+        } else if (rk4) {
+            total += IGSOARK4Stages::estimateMemoryUsage(N);
+        }
+        return total;
     }
 
+    // Lattice in spill files (decided at construction, see the file comment)
+    bool isOutOfCore() const { return out_of_core_; }
+    // Read-ahead / release counters of the z-slab missions
+    const SlabStreamer& getSlabStreamer() const { return slab_streamer_; }
+
     size_t getNx() const { return N_x_; }
     size_t getNy() const { return N_y_; }
     size_t getNz() const { return N_z_; }
-    size_t getTotalNodes() const { return nodes_.size(); }
+    size_t getTotalNodes() const { return N_x_ * N_y_ * N_z_; }
 
     size_t coordToIndex(size_t x, size_t y, size_t z) const {
         #ifndef NDEBUG
@@ -77,20 +162,20 @@ public:
     uint64_t getTotalSteps() const { return total_steps_; }
     uint64_t getTotalOperations() const { return total_operations_; }
 
+    // Single-node access goes through the lattice (no AoS view needed)
     void setNodePsi(size_t x, size_t y, size_t z, double real, double imag) {
         size_t index = coordToIndex(x, y, z);
-        if (index < nodes_.size()) {
-            nodes_[index].psi = std::complex<double>(real, imag);
-            nodes_[index].updateInformationalDensity();
-            nodes_[index].updatePhase();
+        if (index < getTotalNodes()) {
+            latticeForWrite().writePsi(index, 1, &real, &imag);
         }
     }
 
     void getNodePsi(size_t x, size_t y, size_t z, double& real_out, double& imag_out) const {
         size_t index = coordToIndex(x, y, z);
-        if (index < nodes_.size()) {
-            real_out = nodes_[index].psi.real();
-            imag_out = nodes_[index].psi.imag();
+        if (index < getTotalNodes()) {
+            const IGSOALatticeSoA& lattice = getLattice();
+            real_out = lattice.psi_re[index];
+            imag_out = lattice.psi_im[index];
         } else {
             real_out = 0.0;
             imag_out = 0.0;
@@ -99,42 +184,120 @@ public:
 
     void setNodePhi(size_t x, size_t y, size_t z, double value) {
         size_t index = coordToIndex(x, y, z);
-        if (index < nodes_.size()) {
-            nodes_[index].phi = value;
+        if (index < getTotalNodes()) {
+            latticeForWrite().phi[index] = value;
         }
     }
 
     double getNodePhi(size_t x, size_t y, size_t z) const {
         size_t index = coordToIndex(x, y, z);
-        if (index < nodes_.size()) {
-            return nodes_[index].phi;
+        if (index < getTotalNodes()) {
+            return getLattice().phi[index];
         }
         return 0.0;
     }
 
     double getNodeF(size_t x, size_t y, size_t z) const {
         size_t index = coordToIndex(x, y, z);
-        if (index < nodes_.size()) {
-            return nodes_[index].F;
+        if (index < getTotalNodes()) {
+            return getLattice().F[index];
         }
         return 0.0;
     }
 
+    // Bulk state access for nodes [first, first + count) (row-major index).
+    // Caller buffers use an element stride; copies go straight to/from the
+    // SoA lattice. Return false if the range does not fit or a buffer is null.
+    bool setPsiRange(size_t first, size_t count, const double* re, const double* im, size_t stride = 1) {
+        if (!re || !im || !rangeFits(first, count, stride)) return false;
+        latticeForWrite().writePsi(first, count, re, im, stride);
+        return true;
+    }
+    bool getPsiRange(size_t first, size_t count, double* re, double* im, size_t stride = 1) const {
+        if (!re || !im || !rangeFits(first, count, stride)) return false;
+        getLattice().readPsi(first, count, re, im, stride);
+        return true;
+    }
+    bool setPhiRange(size_t first, size_t count, const double* values, size_t stride = 1) {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        latticeForWrite().writePhi(first, count, values, stride);
+        return true;
+    }
+    bool getPhiRange(size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        getLattice().readPhi(first, count, values, stride);
+        return true;
+    }
+    bool getFRange(size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(first, count, stride)) return false;
+        getLattice().readF(first, count, values, stride);
+        return true;
+    }
+
+    // Checkpoint/restart (see checkpoint_file.h). saveCheckpoint() references
+    // the lattice planes, so write before the next runMission() or use
+    // writeAsync(). loadCheckpoint() leaves the engine unchanged on failure.
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.setEngineType("igsoa_complex_3d");
+        saveLatticeCheckpoint(writer, {N_x_, N_y_, N_z_}, getLattice(),
+                              current_time_, total_steps_, total_operations_);
+    }
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error = nullptr) {
+        syncLatticeFromNodes();
+        if (!loadLatticeCheckpoint(reader, "igsoa_complex_3d", {N_x_, N_y_, N_z_}, lattice_,
+                                   current_time_, total_steps_, total_operations_, error)) {
+            return false;
+        }
+        releaseNodes();
+        coupling_dirty_ = true;
+        return true;
+    }
+
     void runMission(uint64_t num_steps,
                     const double* input_signals = nullptr,
                     const double* control_patterns = nullptr) {
         auto start_time = std::chrono::high_resolution_clock::now();
         uint64_t operations_this_run = 0;
 
-        for (uint64_t step = 0; step < num_steps; ++step) {
-            if (input_signals && control_patterns) {
-                IGSOAPhysics3D::applyDriving(nodes_, input_signals[step], control_patterns[step]);
-                operations_this_run += static_cast<uint64_t>(nodes_.size());
-            }
+        // Evolve on the SoA lattice; the AoS view is refreshed on next access
+        {
+            DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_TRANSFER);
+            syncLatticeFromNodes();
+        }
+        releaseNodes();
+        refreshCoupling();
+        float_active_ = usesFloatStencil();
 
-            operations_this_run += IGSOAPhysics3D::timeStep(nodes_, config_, N_x_, N_y_, N_z_);
-            current_time_ += config_.dt;
-            total_steps_++;
+        const bool driven = input_signals && control_patterns;
+
+        if (float_active_) {
+            noteActiveRegionFallback(num_steps, "float32");
+            operations_this_run = runFloat(num_steps, input_signals, control_patterns);
+        } else {
+            if (usesRK4()) {
+                noteActiveRegionFallback(num_steps, "rk4");
+                operations_this_run = runRK4(num_steps, input_signals, control_patterns);
+            } else {
+                // Quiescent tiles skipped while the mask applies (driven missions never use it)
+                const uint64_t masked_steps = runActiveRegion(num_steps, driven, operations_this_run);
+
+                if (usesSlabSteps(driven)) {
+                    // One z-slab pass per step over the file-backed lattice
+                    operations_this_run += runSlabs(num_steps - masked_steps);
+                } else {
+                    // Whole mission in one parallel region, Ψ sweep by z-slab bands
+                    // (see IGSOAPhysicsSoA::runSteps)
+                    operations_this_run += IGSOAPhysicsSoA::runSteps(
+                        lattice_, config_, num_steps - masked_steps, N_x_, input_signals, control_patterns,
+                        &profiler_, couplingBands(), [this]() { prepareCoupling(); },
+                        [this](size_t z_begin, size_t z_end) { return evolveCoupling(z_begin, z_end); },
+                        [this](size_t row_begin, size_t row_end) {
+                            IGSOAPhysicsSoA::computeGradients3D(lattice_, N_x_, N_y_, N_z_, row_begin, row_end);
+                        },
+                        beginObservables());
+                }
+            }
+            advanceClock(num_steps);
         }
 
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -146,18 +309,101 @@ public:
             ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
             ops_per_sec_ = 1.0e9 / ns_per_op_;
         }
+
+        if (mission_diagnostics_mask_ != 0 && !trial_steps_) {
+            mission_diagnostics_ = computeDiagnostics(mission_diagnostics_mask_);
+        }
+    }
+
+    // Advance to t_end with step-doubling error control (adaptive_timestep.h):
+    // one undriven step of h against two of h/2, keeping the half-step state
+    // when the scaled max|ΔΨ| is within tolerance. config dt is only the
+    // first guess and is restored even if a step throws; observables and
+    // mission diagnostics see accepted states only.
+    AdaptiveRunStats runUntil(double t_end, const AdaptiveStepConfig& adaptive = AdaptiveStepConfig()) {
+        TrialSteps trial(*this);
+        // Missions that step Euler whatever the integrator (see IGSOAIntegrator)
+        const bool euler_only = out_of_core_;
+        AdaptiveStepController controller(adaptive, trial.dt_fixed,
+                                          euler_only ? 1 : igsoaIntegratorOrder(config_.integrator));
+        IGSOALatticeSoA start;
+        LatticeArray<double> coarse_re, coarse_im;
+        while (controller.running(current_time_, t_end)) {
+            const double h = controller.proposal(current_time_, t_end);
+            const double t0 = current_time_;
+            const uint64_t steps0 = total_steps_;
+            getLattice().saveStepState(start);
+
+            config_.dt = h;
+            runMission(1);
+            coarse_re = lattice_.psi_re;
+            coarse_im = lattice_.psi_im;
+
+            latticeForWrite().restoreStepState(start);
+            current_time_ = t0;
+            total_steps_ = steps0;
+            config_.dt = 0.5 * h;
+            for (int half = 0; half < 2; half++) {
+                runMission(1);
+                holdObservables();
+            }
+            const double err = StepDoublingError::scaledDifference(
+                lattice_.psi_re.data(), lattice_.psi_im.data(),
+                coarse_re.data(), coarse_im.data(), lattice_.size());
+
+            if (controller.accept(err, h, 2)) {
+                current_time_ = t0 + h;
+                total_steps_ = steps0 + 2;
+                observables_.commitHeld();
+            } else {
+                latticeForWrite().restoreStepState(start);
+                current_time_ = t0;
+                total_steps_ = steps0;
+                observables_.dropHeld();
+            }
+        }
+        trial.end();
+        if (mission_diagnostics_mask_ != 0) {
+            mission_diagnostics_ = computeDiagnostics(mission_diagnostics_mask_);
+        }
+        return controller.stats();
+    }
+
+    // Parallel-in-time mission of num_steps undriven steps (parareal.h,
+    // igsoa_parareal.h); matches runMission(num_steps) within the tolerance
+    PararealStats runParareal(uint64_t num_steps, const PararealConfig& parareal = PararealConfig()) {
+        return runIGSOAParareal<IGSOAComplexEngine3D>(
+            "igsoa_complex_3d", {N_x_, N_y_, N_z_}, latticeForWrite(), config_, current_time_, total_steps_,
+            num_steps, parareal,
+            [this](const IGSOAComplexConfig& config) {
+                return std::make_unique<IGSOAComplexEngine3D>(config, N_x_, N_y_, N_z_);
+            },
+            [](IGSOAComplexEngine3D& worker, const IGSOALatticeSoA& in, uint64_t steps, IGSOALatticeSoA& out) {
+                worker.latticeForWrite() = in;
+                worker.runMission(steps);
+                out = worker.getLattice();
+            });
+    }
+
+    // AoS compatibility view: re-fetch after runMission()
+    const std::vector<IGSOAComplexNode>& getNodes() const {
+        syncNodesFromLattice();
+        return nodes_;
     }
+    std::vector<IGSOAComplexNode>& getNodesMutable() { return nodesForWrite(); }
+    bool hasNodeView() const { return !nodes_.empty(); }  // allocated until the lattice moves on
 
-    const std::vector<IGSOAComplexNode>& getNodes() const { return nodes_; }
-    std::vector<IGSOAComplexNode>& getNodesMutable() { return nodes_; }
+    // SoA lattice (authoritative state during evolution)
+    const IGSOALatticeSoA& getLattice() const {
+        syncLatticeFromNodes();
+        return lattice_;
+    }
 
     void reset() {
-        for (auto& node : nodes_) {
-            node.psi = std::complex<double>(0.0, 0.0);
-            node.phi = 0.0;
-            node.F = 0.0;
-            node.phase = 0.0;
-            node.psi_dot = std::complex<double>(0.0, 0.0);
+        IGSOALatticeSoA& lattice = latticeForWrite();
+        for (auto* plane : {&lattice.psi_re, &lattice.psi_im, &lattice.psi_dot_re, &lattice.psi_dot_im,
+                            &lattice.phi, &lattice.F}) {
+            std::fill(plane->begin(), plane->end(), 0.0);
         }
         current_time_ = 0.0;
         total_steps_ = 0;
@@ -165,8 +411,144 @@ public:
         last_execution_time_ns_ = 0;
         ns_per_op_ = 0.0;
         ops_per_sec_ = 0.0;
+        profiler_.reset();
+        active_region_ = IGSOAActiveRegion();
+    }
+
+    /**
+     * Re-initialize as a new engine with config (same lattice size)
+     *
+     * Equivalent to constructing IGSOAComplexEngine3D(config, N_x, N_y,
+     * N_z) but keeps the planes and coupling caches allocated (see the 2D
+     * engine). The in-RAM / out-of-core decision made at construction
+     * stands.
+     */
+    void reinitialize(const IGSOAComplexConfig& config) {
+        setCouplingMode(config.coupling_mode);
+        setPrecision(config.precision);
+        setIntegrator(config.integrator);
+        config_ = config;
+        config_.num_nodes = getTotalNodes();
+
+        IGSOALatticeSoA& lattice = latticeForWrite();
+        lattice.clearState();
+        lattice.fillParameters(config.R_c_default, config.kappa, config.gamma);
+        coupling_dirty_ = true;
+
+        current_time_ = 0.0;
+        total_steps_ = 0;
+        total_operations_ = 0;
+        last_execution_time_ns_ = 0;
+        ns_per_op_ = 0.0;
+        ops_per_sec_ = 0.0;
+        speedup_factor_ = 1.0;
+        profiler_.reset();
+        setActiveRegion(ActiveRegionConfig());
+        setMissionDiagnostics(0);
+        observables_.disable();
+    }
+
+    // Non-local coupling strategy (mode caches build on the next runMission)
+    IGSOACouplingMode getCouplingMode() const { return config_.coupling_mode; }
+
+    void setCouplingMode(IGSOACouplingMode mode) {
+        if (mode == config_.coupling_mode) return;
+        config_.coupling_mode = mode;
+        if (mode != IGSOACouplingMode::NeighborCache) {
+            neighbor_cache_.reset();
+        }
+        if (mode != IGSOACouplingMode::Spectral) {
+            spectral_.reset();
+            spectral_active_ = false;
+        }
+        coupling_dirty_ = true;
+    }
+
+    const NeighborCache3D* getNeighborCache() const { return neighbor_cache_.get(); }
+
+    // Bytes held by coupling caches (neighbor lists, stencil or FFT spectrum)
+    size_t getCouplingCacheMemoryUsage() const {
+        size_t total = stencil_.getMemoryUsage();
+        if (neighbor_cache_) {
+            total += neighbor_cache_->getMemoryUsage();
+        }
+        if (spectral_) {
+            total += spectral_->getMemoryUsage();
+        }
+        return total;
     }
 
+    // True if the last runMission() evaluated the coupling by FFT
+    bool isSpectralCouplingActive() const { return spectral_active_; }
+
+    // Stepping precision (next runMission()); isFloatPrecisionActive() if the
+    // last runMission() stepped in float32
+    IGSOAPrecision getPrecision() const { return config_.precision; }
+    void setPrecision(IGSOAPrecision precision) {
+        config_.precision = precision;
+        if (precision == IGSOAPrecision::Double) {
+            lattice_f32_ = IGSOALatticeSoAF32();
+        }
+    }
+    bool isFloatPrecisionActive() const { return float_active_; }
+
+    // Time integrator (next runMission()): RK4 steps row-major in-RAM CPU
+    // missions, double or float32; out-of-core missions step
+    // Euler. Switching to Euler frees the RK4 stages.
+    IGSOAIntegrator getIntegrator() const { return config_.integrator; }
+    void setIntegrator(IGSOAIntegrator integrator) {
+        config_.integrator = integrator;
+        if (integrator == IGSOAIntegrator::Euler) {
+            rk4_stages_ = IGSOARK4Stages();
+            rk4_stages_f32_ = IGSOARK4StagesF32();
+        }
+    }
+    size_t getIntegratorMemoryUsage() const {
+        return rk4_stages_.getMemoryUsage() + rk4_stages_f32_.getMemoryUsage();
+    }
+
+    // Integer R_c of the compile-time stencil kernel (see IGSOAComplexEngine2D)
+    int getFixedStencilRadius() const { return fixed_radius_; }
+
+    // Active-region stepping (see IGSOAComplexEngine2D::setActiveRegion);
+    // setting the configuration clears the statistics
+    const ActiveRegionConfig& getActiveRegion() const { return active_config_; }
+    void setActiveRegion(const ActiveRegionConfig& config) {
+        active_config_ = config;
+        active_region_ = IGSOAActiveRegion();
+    }
+    const ActiveRegionStats& getActiveRegionStats() const { return active_region_.stats(); }
+
+    // Energy, entropy rate and/or center of mass in one threaded pass
+    // (DiagnosticMask bits, igsoa_diagnostics.h)
+    IGSOADiagnostics computeDiagnostics(uint32_t mask = DIAG_ALL) const {
+        return diagnostics_.compute(getLattice(), N_x_, N_y_, N_z_, mask);
+    }
+
+    // Observables computed right after the last step of every runMission()
+    // (0 disables)
+    void setMissionDiagnostics(uint32_t mask) {
+        mission_diagnostics_mask_ = mask;
+        mission_diagnostics_ = IGSOADiagnostics();
+    }
+    uint32_t getMissionDiagnosticsMask() const { return mission_diagnostics_mask_; }
+    const IGSOADiagnostics& getMissionDiagnostics() const { return mission_diagnostics_; }
+
+    // Observable time series: mask's observables and the probe nodes every
+    // interval steps of later missions into a ring of capacity samples
+    // (clears; no channels disables). Recording bypasses the active-region
+    // mask.
+    void setObservableRecording(uint32_t mask, uint64_t interval, size_t capacity,
+                                const std::vector<IGSOAProbe>& probes = std::vector<IGSOAProbe>()) {
+        observables_.configure(mask, interval, capacity, 3, probes);
+    }
+    // Sliding spectrum of every recorded channel (frequencies in cycles per unit time)
+    void setObservableSpectrum(const SlidingSpectrumConfig& config) {
+        observables_.configureSpectrum(config, config_.dt);
+    }
+    const IGSOAObservableRecorder& getObservableRecorder() const { return observables_; }
+    void clearObservables() { observables_.clear(); }
+
     void getMetrics(double& ns_per_op_out,
                     double& ops_per_sec_out,
                     double& speedup_factor_out,
@@ -179,12 +561,401 @@ public:
 
     void setSpeedupFactor(double factor) { speedup_factor_ = factor; }
 
+    // Accumulated time per step phase (IGSOAStepPhase order); cleared by reset()
+    std::vector<PhaseTiming> getPhaseTimings() const { return profiler_.snapshot(); }
+    void resetPhaseTimings() { profiler_.reset(); }
+
 private:
+    void syncNodesFromLattice() const {
+        if (aos_stale_) {
+            lattice_.storeTo(nodes_);
+            aos_stale_ = false;
+        }
+    }
+
+    void syncLatticeFromNodes() const {
+        if (soa_stale_) {
+            lattice_.loadFrom(nodes_);
+            soa_stale_ = false;
+            coupling_dirty_ = true;  // R_c may have been edited through the AoS view
+        }
+    }
+
+    std::vector<IGSOAComplexNode>& nodesForWrite() {
+        syncNodesFromLattice();
+        soa_stale_ = true;
+        return nodes_;
+    }
+
+    IGSOALatticeSoA& latticeForWrite() {
+        syncLatticeFromNodes();
+        releaseNodes();
+        return lattice_;
+    }
+
+    // Mark the AoS view stale and free it; the lattice must be current
+    void releaseNodes() const {
+        aos_stale_ = true;
+        std::vector<IGSOAComplexNode>().swap(nodes_);
+    }
+
+    bool rangeFits(size_t first, size_t count, size_t stride) const {
+        return stride > 0 && first <= getTotalNodes() && count <= getTotalNodes() - first;
+    }
+
+    /**
+     * Bring the coupling caches up to date with the lattice R_c
+     *
+     * NeighborCache mode rebuilds the CSR lists when any R_c changed;
+     * Direct mode rebuilds the stencil when the (uniform) R_c changed;
+     * Spectral mode also transforms the stencil when the FFT is cheaper.
+     */
+    void refreshCoupling() {
+        if (!coupling_dirty_) return;
+        coupling_dirty_ = false;
+
+        if (config_.coupling_mode == IGSOACouplingMode::NeighborCache && !out_of_core_) {
+            if (!neighbor_cache_) {
+                neighbor_cache_ = std::make_unique<NeighborCache3D>(N_x_, N_y_, N_z_, config_.R_c_default);
+            }
+            if (neighbor_cache_->needsRebuild(lattice_)) {
+                neighbor_cache_->build(lattice_);
+            }
+            return;
+        }
+
+        double R_c = 0.0;
+        stencil_uniform_ = IGSOAPhysicsSoA::hasUniformRadius(lattice_, R_c);
+        if (stencil_uniform_ && !stencil_.matches(R_c, N_x_, N_y_, N_z_)) {
+            stencil_.build(R_c, N_x_, N_y_, N_z_);
+        }
+        fixed_radius_ = stencil_uniform_ ? fixedStencilRadius(R_c, N_x_, N_y_, N_z_) : 0;
+        fixed_kernel_ = IGSOAPhysicsSoA::fixedKernel3D<double>(fixed_radius_);
+        fixed_kernel_f32_ = IGSOAPhysicsSoA::fixedKernel3D<float>(fixed_radius_);
+
+        spectral_active_ = config_.coupling_mode == IGSOACouplingMode::Spectral &&
+                           stencil_uniform_ && !out_of_core_ &&
+                           SpectralCoupling::isFavorable(stencil_.size(), N_x_ * N_y_ * N_z_);
+        if (spectral_active_) {
+            if (!spectral_) {
+                spectral_ = std::make_unique<SpectralCoupling>();
+            }
+            if (!spectral_->matches(R_c, N_x_, N_y_, N_z_)) {
+                spectral_->build(stencil_, N_x_, N_y_, N_z_);
+            }
+        }
+    }
+
+    // Recorder for runSteps() starting at the current step (nullptr if off)
+    IGSOAObservableRecorder* beginObservables() {
+        if (!observables_.enabled() || trial_steps_) return nullptr;
+        observables_.beginMission(N_x_, N_y_, N_z_, total_steps_, current_time_, config_.dt);
+        return &observables_;
+    }
+
+    // runUntil() trial steps: missions skip the recorders, and the dt, held
+    // samples and flag are restored when the scope ends or unwinds
+    struct TrialSteps {
+        IGSOAComplexEngine3D& engine;
+        const double dt_fixed;
+
+        explicit TrialSteps(IGSOAComplexEngine3D& e) : engine(e), dt_fixed(e.config_.dt) {
+            engine.trial_steps_ = true;
+        }
+        ~TrialSteps() { end(); }
+        void end() {
+            engine.config_.dt = dt_fixed;
+            engine.trial_steps_ = false;
+            engine.observables_.dropHeld();
+        }
+    };
+
+    // Sample the trial state if its step is due; runUntil() commits or drops it
+    void holdObservables() {
+        if (!observables_.enabled() || total_steps_ % observables_.interval() != 0) return;
+        DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_OBSERVABLES);
+        observables_.beginMission(N_x_, N_y_, N_z_, total_steps_, current_time_, config_.dt);
+        observables_.hold(getLattice(), total_steps_, current_time_);
+    }
+
+    // Float precision applies to stencil coupling (uniform R_c, no FFT)
+    bool usesFloatStencil() const {
+        return config_.precision == IGSOAPrecision::Float &&
+               config_.coupling_mode != IGSOACouplingMode::NeighborCache &&
+               stencil_uniform_ && !spectral_active_ && !out_of_core_;
+    }
+
+    // Row-major double missions stepped by RK4 (float32 ones: runFloat)
+    bool usesRK4() const {
+        return config_.integrator == IGSOAIntegrator::RK4 && !out_of_core_;
+    }
+
+    // Out-of-core missions the z-slab pass can step (see runSlabSteps)
+    bool usesSlabSteps(bool driven) const {
+        return out_of_core_ && stencil_uniform_ && !driven && !observables_.enabled();
+    }
+
+    uint64_t runSlabs(uint64_t num_steps) {
+        const size_t slab_bytes = N_x_ * N_y_ * sizeof(double);
+        // Slabs behind the sweep still read: Ψ reach, the delayed fused pass, its gradients
+        const size_t halo = static_cast<size_t>(std::max(stencil_.reach(), 0)) + 2;
+        slab_streamer_.clear();
+        if (slab_bytes * N_z_ >= kFirstTouchBytes) {
+            // Planes the pass touches (R_c and harmonic_count are not read)
+            for (const auto* plane : {&lattice_.psi_re, &lattice_.psi_im, &lattice_.psi_dot_re,
+                                      &lattice_.psi_dot_im, &lattice_.phi, &lattice_.phi_dot, &lattice_.F,
+                                      &lattice_.F_gradient, &lattice_.kappa, &lattice_.gamma}) {
+                slab_streamer_.addPlane(plane->data(), slab_bytes);
+            }
+        }
+        slab_streamer_.configure(N_z_, halo, halo, prefetch_slabs_);
+        return IGSOAPhysicsSoA::runSlabSteps(lattice_, config_, stencil_, num_steps, N_x_, N_y_, N_z_,
+                                             slab_streamer_, &profiler_);
+    }
+
+    // Steps on the float32 working copy; the lattice is converted in and back once
+    uint64_t runFloat(uint64_t num_steps, const double* input_signals, const double* control_patterns) {
+        {
+            DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_TRANSFER);
+            lattice_f32_.assignFrom(lattice_);
+        }
+
+        auto gradients = [this](size_t row_begin, size_t row_end) {
+            IGSOAPhysicsSoA::computeGradients3D(lattice_f32_, N_x_, N_y_, N_z_, row_begin, row_end);
+        };
+        const uint64_t operations = config_.integrator == IGSOAIntegrator::RK4
+            ? IGSOAPhysicsSoA::runRK4Steps(
+                  lattice_f32_, config_, num_steps, N_x_, input_signals, control_patterns, &profiler_,
+                  rk4_stages_f32_, nullptr,
+                  [this](const float* u_re, const float* u_im, size_t r, const float*& nl_re, const float*& nl_im) {
+                      return IGSOAPhysicsSoA::stencilCouplingRow3D(stencil_, u_re, u_im, N_x_, N_y_, N_z_, r,
+                                                                   nl_re, nl_im);
+                  },
+                  gradients, beginObservables())
+            : IGSOAPhysicsSoA::runSteps(
+                  lattice_f32_, config_, num_steps, N_x_, input_signals, control_patterns, &profiler_,
+                  IGSOACouplingBands::make(N_z_, static_cast<size_t>(stencil_.reach())), []() {},
+                  [this](size_t z_begin, size_t z_end) {
+                      if (fixed_kernel_f32_) {
+                          return fixed_kernel_f32_(lattice_f32_, config_.dt, N_x_, N_y_, N_z_, z_begin, z_end, 1.0);
+                      }
+                      return IGSOAPhysicsSoA::evolveQuantumStateSlabs3D(lattice_f32_, stencil_, config_.dt,
+                                                                        N_x_, N_y_, N_z_, z_begin, z_end);
+                  },
+                  gradients, beginObservables());
+        advanceClock(num_steps);
+
+        DASE_PROFILE_PHASE(&profiler_, IGSOA_PHASE_TRANSFER);
+        lattice_.assignFrom(lattice_f32_);
+        return operations;
+    }
+
+    // RK4 mission with the configured coupling (see IGSOAComplexEngine2D::runRK4)
+    uint64_t runRK4(uint64_t num_steps, const double* input_signals, const double* control_patterns) {
+        using Row = const double*;
+        auto gradients = [this](size_t row_begin, size_t row_end) {
+            IGSOAPhysicsSoA::computeGradients3D(lattice_, N_x_, N_y_, N_z_, row_begin, row_end);
+        };
+        auto run = [&](auto&& prepare, auto&& row_coupling) {
+            return IGSOAPhysicsSoA::runRK4Steps(lattice_, config_, num_steps, N_x_, input_signals, control_patterns,
+                                                &profiler_, rk4_stages_, prepare, row_coupling, gradients,
+                                                beginObservables());
+        };
+
+        if (config_.coupling_mode == IGSOACouplingMode::NeighborCache && neighbor_cache_) {
+            const NeighborCache3D& cache = *neighbor_cache_;
+            return run(nullptr, [&](Row u_re, Row u_im, size_t r, Row& nl_re, Row& nl_im) {
+                return IGSOAPhysicsSoA::nodeCouplingRow(r * N_x_, N_x_, nl_re, nl_im,
+                    [&](size_t i, double& re, double& im) {
+                        cache.computeCoupling(i, u_re, u_im, re, im);
+                        return static_cast<uint64_t>(cache.getNeighborCount(i));
+                    });
+            });
+        }
+        if (spectral_active_) {
+            SpectralCoupling& spectral = *spectral_;
+            const uint64_t terms = spectral.terms();
+            return run([&](Row u_re, Row u_im) { spectral.convolve(u_re, u_im); },
+                       [&](Row, Row, size_t r, Row& nl_re, Row& nl_im) {
+                           return IGSOAPhysicsSoA::nodeCouplingRow(r * N_x_, N_x_, nl_re, nl_im,
+                               [&](size_t i, double& re, double& im) {
+                                   re = spectral.couplingRe(i);
+                                   im = spectral.couplingIm(i);
+                                   return terms;
+                               });
+                       });
+        }
+        if (stencil_uniform_) {
+            return run(nullptr, [&](Row u_re, Row u_im, size_t r, Row& nl_re, Row& nl_im) {
+                return IGSOAPhysicsSoA::stencilCouplingRow3D(stencil_, u_re, u_im, N_x_, N_y_, N_z_, r,
+                                                             nl_re, nl_im);
+            });
+        }
+        return run(nullptr, [&](Row u_re, Row u_im, size_t r, Row& nl_re, Row& nl_im) {
+            return IGSOAPhysicsSoA::nodeCouplingRow(r * N_x_, N_x_, nl_re, nl_im,
+                [&](size_t i, double& re, double& im) {
+                    return IGSOAPhysicsSoA::boxCoupling3D(lattice_, u_re, u_im, i, N_x_, N_y_, N_z_, re, im);
+                });
+        });
+    }
+
+    // Why the active-region mask cannot step this mission (nullptr if it can)
+    const char* activeRegionBlocker(bool driven) const {
+        if (driven) return "driven";
+        if (out_of_core_) return "out_of_core";
+        if (observables_.enabled()) return "observables";
+        if (config_.normalize_psi) return "normalize_psi";
+        if (config_.coupling_mode != IGSOACouplingMode::Direct &&
+            config_.coupling_mode != IGSOACouplingMode::Recursive) return "coupling_mode";
+        if (!stencil_uniform_) return "non_uniform_R_c";
+        return nullptr;
+    }
+
+    void noteActiveRegionFallback(uint64_t num_steps, const char* reason) {
+        if (active_config_.enabled) {
+            active_region_.countFallbackSteps(num_steps, reason);
+        }
+    }
+
+    // Step through the active-region mask until it covers the lattice;
+    // returns the steps run
+    uint64_t runActiveRegion(uint64_t num_steps, bool driven, uint64_t& operations) {
+        if (!active_config_.enabled) return 0;
+        if (const char* blocker = activeRegionBlocker(driven)) {
+            active_region_.countFallbackSteps(num_steps, blocker);
+            return 0;
+        }
+        active_region_.configure(active_config_, N_x_, N_y_, N_z_, stencil_.reach());
+        const uint64_t steps = IGSOAPhysicsSoA::runActiveSteps(
+            lattice_, config_, num_steps, N_x_, N_y_, N_z_, active_region_, &profiler_, couplingBands(),
+            [this](size_t z_begin, size_t z_end) {
+                return IGSOAPhysicsSoA::evolveQuantumState3D(lattice_, stencil_, active_region_,
+                                                             config_.dt, N_x_, N_y_, N_z_,
+                                                             z_begin * N_y_, z_end * N_y_);
+            },
+            operations);
+        active_region_.countDenseSteps(num_steps - steps);
+        return steps;
+    }
+
+    // Same float accumulation as one current_time_ += dt per step
+    void advanceClock(uint64_t num_steps) {
+        for (uint64_t step = 0; step < num_steps; step++) {
+            current_time_ += config_.dt;
+        }
+        total_steps_ += num_steps;
+    }
+
+    /**
+     * Ψ update with the configured coupling strategy
+     */
+    uint64_t evolveCoupling(size_t z_begin, size_t z_end) {
+        const size_t begin = z_begin * N_x_ * N_y_;
+        const size_t end = z_end * N_x_ * N_y_;
+        const double* psi_re = lattice_.psi_re.data();
+        const double* psi_im = lattice_.psi_im.data();
+        if (usesNeighborCache()) {
+            const NeighborCache3D& cache = *neighbor_cache_;
+            return IGSOAPhysicsSoA::evolveQuantumStateNodes(lattice_, config_.dt, begin, end,
+                [&](size_t i, double& re, double& im) {
+                    cache.computeCoupling(i, psi_re, psi_im, re, im);
+                    return static_cast<uint64_t>(cache.getNeighborCount(i));
+                });
+        }
+        if (spectral_active_) {
+            const SpectralCoupling& spectral = *spectral_;
+            const uint64_t terms = spectral.terms();
+            return IGSOAPhysicsSoA::evolveQuantumStateNodes(lattice_, config_.dt, begin, end,
+                [&](size_t i, double& re, double& im) {
+                    re = spectral.couplingRe(i);
+                    im = spectral.couplingIm(i);
+                    return terms;
+                });
+        }
+        if (stencil_uniform_) {
+            if (fixed_kernel_) {
+                return fixed_kernel_(lattice_, config_.dt, N_x_, N_y_, N_z_, z_begin, z_end, 1.0);
+            }
+            return IGSOAPhysicsSoA::evolveQuantumStateSlabs3D(lattice_, stencil_, config_.dt, N_x_, N_y_, N_z_,
+                                                              z_begin, z_end);
+        }
+        return IGSOAPhysicsSoA::evolveQuantumStateNodes(lattice_, config_.dt, begin, end,
+            [&](size_t i, double& re, double& im) {
+                return IGSOAPhysicsSoA::boxCoupling3D(lattice_, psi_re, psi_im, i, N_x_, N_y_, N_z_, re, im);
+            });
+    }
+
+    // z-slab bands of the sweep above (spectral couplings come from the start-of-step Ψ)
+    IGSOACouplingBands couplingBands() const {
+        if (!usesNeighborCache() && spectral_active_) {
+            return IGSOACouplingBands::jacobi(N_z_);
+        }
+        if (!usesNeighborCache() && stencil_uniform_) {
+            return IGSOACouplingBands::make(N_z_, static_cast<size_t>(stencil_.reach()));
+        }
+        return IGSOACouplingBands::make(N_z_, IGSOAPhysicsSoA::radiusReach(lattice_));
+    }
+
+    // Start-of-step couplings of Jacobi bands
+    void prepareCoupling() {
+        if (!usesNeighborCache() && spectral_active_) {
+            spectral_->convolve(lattice_.psi_re.data(), lattice_.psi_im.data());
+        }
+    }
+
+    bool usesNeighborCache() const {
+        return config_.coupling_mode == IGSOACouplingMode::NeighborCache && neighbor_cache_ != nullptr;
+    }
+
     IGSOAComplexConfig config_;
     size_t N_x_;
     size_t N_y_;
     size_t N_z_;
-    std::vector<IGSOAComplexNode> nodes_;
+
+    // lattice_ is evolved, nodes_ is the AoS compatibility view (one side stale
+    // at most); the view is allocated while current and freed once the lattice moves on
+    mutable std::vector<IGSOAComplexNode> nodes_;
+    mutable IGSOALatticeSoA lattice_;
+    mutable bool aos_stale_ = true;
+    mutable bool soa_stale_ = false;
+
+    // Out-of-core mode: lattice planes in spill files, z-slab missions
+    bool out_of_core_ = false;
+    size_t prefetch_slabs_ = 0;
+    SlabStreamer slab_streamer_;
+
+    // Coupling caches: stencil for uniform R_c (Direct), CSR lists (NeighborCache),
+    // kernel spectrum (Spectral, large uniform R_c)
+    CouplingStencil3D stencil_;
+    std::unique_ptr<NeighborCache3D> neighbor_cache_;
+    std::unique_ptr<SpectralCoupling> spectral_;
+    mutable bool coupling_dirty_ = true;
+    bool stencil_uniform_ = false;
+    bool spectral_active_ = false;
+
+    // Unrolled stencil kernels for an integer R_c of 1..5 (nullptr: generic stencil)
+    int fixed_radius_ = 0;
+    IGSOAPhysicsSoA::FixedKernel3D<double> fixed_kernel_ = nullptr;
+    IGSOAPhysicsSoA::FixedKernel3D<float> fixed_kernel_f32_ = nullptr;
+
+    // Float precision: working copy of lattice_ for the duration of a mission
+    IGSOALatticeSoAF32 lattice_f32_;
+    bool float_active_ = false;
+
+    // RK4 stage buffers (allocated by the first RK4 mission of each precision)
+    IGSOARK4Stages rk4_stages_;
+    IGSOARK4StagesF32 rk4_stages_f32_;
+
+    // Active-region stepping: tile mask of the quiescent part of the lattice
+    ActiveRegionConfig active_config_;
+    IGSOAActiveRegion active_region_;
+
+    // Fused diagnostics (per-axis trig tables) and the per-mission results
+    mutable IGSOADiagnosticsPass diagnostics_;
+    uint32_t mission_diagnostics_mask_ = 0;
+    IGSOADiagnostics mission_diagnostics_;
+    bool trial_steps_ = false;    // Inside runUntil() attempts (see TrialSteps)
+    IGSOAObservableRecorder observables_;   // Time series recorded inside the step loop
 
     double current_time_;
     uint64_t total_steps_;
@@ -194,6 +965,7 @@ private:
     double ops_per_sec_ = 0.0;
     double speedup_factor_ = 1.0;
     uint64_t last_execution_time_ns_ = 0;
+    IGSOAStepProfiler profiler_;
 };
 
 } // namespace igsoa
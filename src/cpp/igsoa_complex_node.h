@@ -33,8 +33,11 @@ namespace igsoa {
  * - phi: Real-valued realized causal energy Φ
  * - F: Informational density F = |Ψ|²
  * - R_c: Causal resistance (mediates dissipation)
- * - T_IGS: IGS temperature T_IGS = F
- * - entropy_rate: Entropy production Ṡ = R_c(∇F)²
+ * - entropy_rate: Entropy production Ṡ = R_c(Φ - Re[Ψ])²
+ *
+ * T_IGS() (= F) and phase() (= arg Ψ) are derived on demand and not stored:
+ * the dynamics never read them, and keeping them current cost a copy and an
+ * atan2 per node and step.
  */
 struct IGSOAComplexNode {
     // Quantum state (complex Hilbert space)
@@ -53,16 +56,12 @@ struct IGSOAComplexNode {
     double R_c;                         // Causal resistance (mediates Φ-Ψ coupling)
     double entropy_rate;                // Ṡ = R_c(Φ - Re[Ψ])² - entropy production
 
-    // IGS temperature (informational)
-    double T_IGS;                       // T_IGS = F - informational temperature
-
     // Coupling parameters
     double kappa;                       // κ - Φ-Ψ coupling strength
     double gamma;                       // γ - dissipation coefficient
 
     // Harmonic analysis (for pattern detection)
     uint32_t harmonic_count;            // Number of harmonics detected
-    double phase;                       // Phase of Ψ: arg(Ψ)
 
     // Default constructor - initialize to ground state
     IGSOAComplexNode()
@@ -74,11 +73,9 @@ struct IGSOAComplexNode {
         , F_gradient(0.0)
         , R_c(3.0)                // Default causal radius (≈3 lattice units)
         , entropy_rate(0.0)
-        , T_IGS(0.0)
         , kappa(1.0)              // Default coupling strength
         , gamma(0.1)              // Default dissipation
         , harmonic_count(0)
-        , phase(0.0)
     {}
 
     /**
@@ -87,15 +84,20 @@ struct IGSOAComplexNode {
      */
     inline void updateInformationalDensity() {
         F = std::norm(psi);  // |Ψ|² = Re(Ψ)² + Im(Ψ)²
-        T_IGS = F;           // Temperature equals informational density
     }
 
     /**
-     * Update phase from quantum state
-     * phase = arg(Ψ) = atan2(Im[Ψ], Re[Ψ])
+     * IGS temperature: equals the informational density, T_IGS = F
      */
-    inline void updatePhase() {
-        phase = std::arg(psi);
+    inline double T_IGS() const {
+        return F;
+    }
+
+    /**
+     * Phase of the quantum state: arg(Ψ) = atan2(Im[Ψ], Re[Ψ])
+     */
+    inline double phase() const {
+        return std::arg(psi);
     }
 
     /**
@@ -122,6 +124,78 @@ struct IGSOAComplexNode {
     }
 };
 
+/**
+ * Non-local coupling evaluation strategy for lattice engines
+ *
+ * - Direct: per-step search (precomputed stencil when R_c is uniform)
+ * - NeighborCache: cached CSR neighbor lists with tiered kernel lookup;
+ *   supports heterogeneous per-node R_c, rebuilt when any R_c changes
+ * - Spectral: FFT convolution for uniform R_c when the cost model favours it
+ *   over the stencil (large R_c); otherwise behaves as Direct.
+ *   Requires a USE_FFTW3 build
+ * - Recursive: 1D only. O(N) recursive filter over the exponential kernel
+ *   for uniform R_c ≥ 1 on a ring longer than 2⌊R_c⌋; otherwise, and in the
+ *   2D/3D engines, behaves as Direct
+ */
+enum class IGSOACouplingMode : uint8_t {
+    Direct = 0,
+    NeighborCache = 1,
+    Spectral = 2,
+    Recursive = 4
+};
+
+/**
+ * Floating-point precision of lattice time stepping (2D/3D engines)
+ *
+ * - Double: every stage in double precision
+ * - Float: Direct-mode stencil steps run on an IGSOALatticeSoAF32 working
+ *   copy (half the bytes per sweep, twice the SIMD lanes); the engine state
+ *   stays double and is converted once per runMission(). Other coupling
+ *   paths (box search, NeighborCache, Spectral) step in double
+ */
+enum class IGSOAPrecision : uint8_t {
+    Double = 0,
+    Float = 1
+};
+
+/**
+ * Time integrator of the Ψ/Φ evolution (1D/2D/3D engines)
+ *
+ * - Euler: in-place forward Euler Ψ sweep (nodes read neighbors already
+ *   advanced this step), then the Φ update from the new Ψ. First order
+ * - RK4: classical Runge-Kutta of the coupled Ψ/Φ system, every stage
+ *   reading the previous stage's state (IGSOAPhysicsSoA::runRK4Steps):
+ *   fourth order, four coupling sweeps per step, each one parallel pass
+ *   that also forms the next stage. Used by the CPU Direct, NeighborCache
+ *   and Spectral paths in row-major order, double or float32;
+ *   Recursive, active-region and out-of-core missions step Euler
+ */
+enum class IGSOAIntegrator : uint8_t {
+    Euler = 0,
+    RK4 = 1
+};
+
+// Accuracy order of the integrator (AdaptiveStepController)
+inline int igsoaIntegratorOrder(IGSOAIntegrator integrator) {
+    return integrator == IGSOAIntegrator::RK4 ? 4 : 1;
+}
+
+inline const char* igsoaIntegratorName(IGSOAIntegrator integrator) {
+    return integrator == IGSOAIntegrator::RK4 ? "rk4" : "euler";
+}
+
+// Parses "euler" / "rk4"; false (integrator unchanged) otherwise
+inline bool parseIGSOAIntegrator(const std::string& name, IGSOAIntegrator& integrator) {
+    if (name == "euler") {
+        integrator = IGSOAIntegrator::Euler;
+    } else if (name == "rk4") {
+        integrator = IGSOAIntegrator::RK4;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 /**
  * Engine configuration for IGSOA Complex simulation
  */
@@ -132,6 +206,9 @@ struct IGSOAComplexConfig {
     double gamma;                  // Dissipation coefficient
     double dt;                     // Time step for integration
     bool normalize_psi;            // Whether to normalize |Ψ⟩ (unitary evolution)
+    IGSOACouplingMode coupling_mode;  // Non-local coupling strategy (2D/3D engines; 1D: Direct or Recursive)
+    IGSOAPrecision precision;      // Stepping precision (2D/3D engines)
+    IGSOAIntegrator integrator;    // Ψ/Φ time integrator
 
     IGSOAComplexConfig()
         : num_nodes(1024)
@@ -140,6 +217,9 @@ struct IGSOAComplexConfig {
         , gamma(0.1)
         , dt(0.01)
         , normalize_psi(true)
+        , coupling_mode(IGSOACouplingMode::Direct)
+        , precision(IGSOAPrecision::Double)
+        , integrator(IGSOAIntegrator::Euler)
     {}
 
     /**
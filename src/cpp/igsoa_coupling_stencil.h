@@ -0,0 +1,412 @@
+/**
+ * IGSOA Coupling Stencil - Precomputed Non-Local Offsets
+ *
+ * For a lattice with uniform causal radius R_c, the set of neighbor offsets
+ * inside the causal disc/ball and their kernel weights K(r, R_c) are the same
+ * for every node.  The stencil stores them once so the coupling loop becomes
+ * a gather-multiply-accumulate with no sqrt/exp/radius test per neighbor.
+ *
+ * Offsets are enumerated in the same order as the bounding-box loops in
+ * IGSOAPhysics2D/3D (z, y, x ascending), and the wrapped distance of an offset
+ * only depends on the offset itself, so stencil and brute-force sweeps sum
+ * identical terms in identical order.
+ *
+ * Rebuild with build() whenever R_c or the lattice dimensions change.
+ *
+ * FixedStencil2D<R> / FixedStencil3D<R> hold the same offsets for an
+ * integer radius R as compile-time tables, for the unrolled kernels of
+ * IGSOAPhysicsSoA (lattices of at least 2R+1 nodes per axis, where no
+ * offset wraps onto another).
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+namespace stencil_detail {
+
+/**
+ * Wrapped 1D distance of an integer offset on a ring of N sites
+ */
+inline int wrappedOffset(int offset, int N) {
+    int wrapped = offset % N;
+    if (wrapped < 0) wrapped += N;
+    return (wrapped < N - wrapped) ? wrapped : N - wrapped;
+}
+
+/**
+ * K(r, R_c) = exp(-r/R_c) / R_c  (0 at r = 0, matching couplingKernel)
+ */
+inline double kernelWeight(double distance, double R_c) {
+    if (distance <= 0.0 || R_c <= 0.0) return 0.0;
+    return std::exp(-distance / R_c) / R_c;
+}
+
+} // namespace stencil_detail
+
+/**
+ * 2D coupling stencil (offsets within the causal disc)
+ */
+class CouplingStencil2D {
+public:
+    /**
+     * Build the offset table for radius R_c on an N_x × N_y torus
+     */
+    void build(double R_c, size_t N_x, size_t N_y) {
+        clear();
+        radius_ = R_c;
+        N_x_ = N_x;
+        N_y_ = N_y;
+
+        const double radius = (R_c > 0.0) ? R_c : 0.0;
+        if (radius <= 0.0 || N_x * N_y <= 1) return;
+
+        const int R_int = static_cast<int>(std::ceil(radius));
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        reach_ = R_int;
+
+        for (int dy = -R_int; dy <= R_int; dy++) {
+            const double dy_wrap = stencil_detail::wrappedOffset(dy, N_y_int);
+            for (int dx = -R_int; dx <= R_int; dx++) {
+                if (dx == 0 && dy == 0) continue;
+
+                const double dx_wrap = stencil_detail::wrappedOffset(dx, N_x_int);
+                const double distance = std::sqrt(dx_wrap * dx_wrap + dy_wrap * dy_wrap);
+                if (distance <= radius) {
+                    dx_.push_back(dx);
+                    dy_.push_back(dy);
+                    linear_.push_back(static_cast<std::ptrdiff_t>(dy) * N_x_int + dx);
+                    weight_.push_back(stencil_detail::kernelWeight(distance, radius));
+                    weight_f32_.push_back(static_cast<float>(weight_.back()));
+                }
+            }
+        }
+    }
+
+    void clear() {
+        dx_.clear();
+        dy_.clear();
+        linear_.clear();
+        weight_.clear();
+        weight_f32_.clear();
+        radius_ = -1.0;
+        reach_ = 0;
+        N_x_ = 0;
+        N_y_ = 0;
+    }
+
+    /**
+     * True if the stencil was built for exactly this radius and lattice
+     */
+    bool matches(double R_c, size_t N_x, size_t N_y) const {
+        return radius_ == R_c && N_x_ == N_x && N_y_ == N_y;
+    }
+
+    size_t size() const { return weight_.size(); }
+    double radius() const { return radius_; }
+    int reach() const { return reach_; }  // ceil(R_c): max |offset| per axis
+
+    const int* dx() const { return dx_.data(); }
+    const int* dy() const { return dy_.data(); }
+    const std::ptrdiff_t* linear() const { return linear_.data(); }  // dy*N_x + dx
+    const double* weight() const { return weight_.data(); }
+    const float* weightF32() const { return weight_f32_.data(); }  // weight() rounded (float32 mode)
+
+    size_t getMemoryUsage() const {
+        return dx_.capacity() * sizeof(int) + dy_.capacity() * sizeof(int) +
+               linear_.capacity() * sizeof(std::ptrdiff_t) + weight_.capacity() * sizeof(double) +
+               weight_f32_.capacity() * sizeof(float);
+    }
+
+private:
+    std::vector<int> dx_;
+    std::vector<int> dy_;
+    std::vector<std::ptrdiff_t> linear_;
+    std::vector<double> weight_;
+    std::vector<float> weight_f32_;
+    double radius_ = -1.0;
+    int reach_ = 0;
+    size_t N_x_ = 0;
+    size_t N_y_ = 0;
+};
+
+/**
+ * 3D coupling stencil (offsets within the causal ball)
+ */
+class CouplingStencil3D {
+public:
+    /**
+     * Build the offset table for radius R_c on an N_x × N_y × N_z torus
+     */
+    void build(double R_c, size_t N_x, size_t N_y, size_t N_z) {
+        clear();
+        radius_ = R_c;
+        N_x_ = N_x;
+        N_y_ = N_y;
+        N_z_ = N_z;
+
+        const double radius = (R_c > 0.0) ? R_c : 0.0;
+        if (radius <= 0.0 || N_x * N_y * N_z <= 1) return;
+
+        const int R_int = static_cast<int>(std::ceil(radius));
+        const double radius_sq = radius * radius;
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const std::ptrdiff_t plane = static_cast<std::ptrdiff_t>(N_x) * static_cast<std::ptrdiff_t>(N_y);
+        reach_ = R_int;
+
+        for (int dz = -R_int; dz <= R_int; dz++) {
+            const double dz_wrap = stencil_detail::wrappedOffset(dz, N_z_int);
+            for (int dy = -R_int; dy <= R_int; dy++) {
+                const double dy_wrap = stencil_detail::wrappedOffset(dy, N_y_int);
+                for (int dx = -R_int; dx <= R_int; dx++) {
+                    if (dx == 0 && dy == 0 && dz == 0) continue;
+
+                    const double dx_wrap = stencil_detail::wrappedOffset(dx, N_x_int);
+                    const double dist_sq = dx_wrap * dx_wrap + dy_wrap * dy_wrap + dz_wrap * dz_wrap;
+                    if (dist_sq <= radius_sq) {
+                        dx_.push_back(dx);
+                        dy_.push_back(dy);
+                        dz_.push_back(dz);
+                        linear_.push_back(static_cast<std::ptrdiff_t>(dz) * plane +
+                                          static_cast<std::ptrdiff_t>(dy) * N_x_int + dx);
+                        weight_.push_back(stencil_detail::kernelWeight(std::sqrt(dist_sq), radius));
+                        weight_f32_.push_back(static_cast<float>(weight_.back()));
+                    }
+                }
+            }
+        }
+    }
+
+    void clear() {
+        dx_.clear();
+        dy_.clear();
+        dz_.clear();
+        linear_.clear();
+        weight_.clear();
+        weight_f32_.clear();
+        radius_ = -1.0;
+        reach_ = 0;
+        N_x_ = 0;
+        N_y_ = 0;
+        N_z_ = 0;
+    }
+
+    bool matches(double R_c, size_t N_x, size_t N_y, size_t N_z) const {
+        return radius_ == R_c && N_x_ == N_x && N_y_ == N_y && N_z_ == N_z;
+    }
+
+    size_t size() const { return weight_.size(); }
+    double radius() const { return radius_; }
+    int reach() const { return reach_; }
+
+    const int* dx() const { return dx_.data(); }
+    const int* dy() const { return dy_.data(); }
+    const int* dz() const { return dz_.data(); }
+    const std::ptrdiff_t* linear() const { return linear_.data(); }  // dz*N_x*N_y + dy*N_x + dx
+    const double* weight() const { return weight_.data(); }
+    const float* weightF32() const { return weight_f32_.data(); }  // weight() rounded (float32 mode)
+
+    size_t getMemoryUsage() const {
+        return (dx_.capacity() + dy_.capacity() + dz_.capacity()) * sizeof(int) +
+               linear_.capacity() * sizeof(std::ptrdiff_t) + weight_.capacity() * sizeof(double) +
+               weight_f32_.capacity() * sizeof(float);
+    }
+
+private:
+    std::vector<int> dx_;
+    std::vector<int> dy_;
+    std::vector<int> dz_;
+    std::vector<std::ptrdiff_t> linear_;
+    std::vector<double> weight_;
+    std::vector<float> weight_f32_;
+    double radius_ = -1.0;
+    int reach_ = 0;
+    size_t N_x_ = 0;
+    size_t N_y_ = 0;
+    size_t N_z_ = 0;
+};
+
+/**
+ * Radii with compile-time stencils (FixedStencil2D/3D, fixed-radius kernels)
+ */
+constexpr int kFixedStencilMaxRadius = 5;
+
+/**
+ * Integer radius R of R_c if it has a compile-time stencil and every axis
+ * holds at least 2R+1 nodes; 0 otherwise
+ */
+inline int fixedStencilRadius(double R_c, size_t N_x, size_t N_y, size_t N_z = 0) {
+    const int R = static_cast<int>(R_c);
+    if (R < 1 || R > kFixedStencilMaxRadius || static_cast<double>(R) != R_c) return 0;
+    const size_t span = static_cast<size_t>(2 * R + 1);
+    if (N_x < span || N_y < span || (N_z != 0 && N_z < span)) return 0;
+    return R;
+}
+
+/**
+ * Compile-time 2D stencil of integer radius R (CouplingStencil2D order)
+ */
+template<int R>
+struct FixedStencil2D {
+    static constexpr int count() {
+        int n = 0;
+        for (int dy = -R; dy <= R; dy++)
+            for (int dx = -R; dx <= R; dx++)
+                if (!(dx == 0 && dy == 0) && dx * dx + dy * dy <= R * R) n++;
+        return n;
+    }
+
+    static constexpr int K = count();
+    static constexpr int KB = R;      // entries behind the node in its row (dx < 0)
+    static constexpr int KC = K - KB; // entries gathered before the row sweep
+    static constexpr int radius = R;
+    static constexpr int kSelfLine = R;  // line of the swept row
+
+    struct Table {
+        int dx[K];
+        int dy[K];
+        int line[K];     // Index of the source row, dy + R
+        bool in_row[K];  // dy == 0: read from the swept row
+        bool behind[K];
+        int cross[KC];   // Entries not behind the node, in stencil order
+        int behind_at[KB];  // in the swept row, at a column already advanced (dx < 0)
+    };
+
+    static constexpr void fillEntryLists(Table& t) {
+        int c = 0, b = 0;
+        for (int k = 0; k < K; k++) {
+            if (t.behind[k]) t.behind_at[b++] = k;
+            else t.cross[c++] = k;
+        }
+    }
+
+    static constexpr Table build() {
+        Table t{};
+        int k = 0;
+        for (int dy = -R; dy <= R; dy++) {
+            for (int dx = -R; dx <= R; dx++) {
+                if ((dx == 0 && dy == 0) || dx * dx + dy * dy > R * R) continue;
+                t.dx[k] = dx;
+                t.dy[k] = dy;
+                t.line[k] = dy + R;
+                t.in_row[k] = (dy == 0);
+                t.behind[k] = (dy == 0 && dx < 0);
+                k++;
+            }
+        }
+        fillEntryLists(t);
+        return t;
+    }
+
+    static constexpr Table table = build();
+
+    /**
+     * K(r, R) of each offset, as CouplingStencil2D computes it
+     */
+    template<typename Real>
+    static const Real* weights() {
+        static const std::array<Real, K> w = []() {
+            std::array<Real, K> out{};
+            for (int k = 0; k < K; k++) {
+                const double dx = table.dx[k];
+                const double dy = table.dy[k];
+                out[k] = static_cast<Real>(
+                    stencil_detail::kernelWeight(std::sqrt(dx * dx + dy * dy), static_cast<double>(R)));
+            }
+            return out;
+        }();
+        return w.data();
+    }
+};
+
+/**
+ * Compile-time 3D stencil of integer radius R (CouplingStencil3D order)
+ */
+template<int R>
+struct FixedStencil3D {
+    static constexpr int count() {
+        int n = 0;
+        for (int dz = -R; dz <= R; dz++)
+            for (int dy = -R; dy <= R; dy++)
+                for (int dx = -R; dx <= R; dx++)
+                    if (!(dx == 0 && dy == 0 && dz == 0) && dx * dx + dy * dy + dz * dz <= R * R) n++;
+        return n;
+    }
+
+    static constexpr int K = count();
+    static constexpr int KB = R;
+    static constexpr int KC = K - KB;
+    static constexpr int radius = R;
+    static constexpr int kSelfLine = R * (2 * R + 1) + R;
+
+    struct Table {
+        int dx[K];
+        int dy[K];
+        int dz[K];
+        int line[K];     // Index of the source row (dz + R) * (2R + 1) + (dy + R)
+        bool in_row[K];
+        bool behind[K];
+        int cross[KC];   // Entries not behind the node, in stencil order
+        int behind_at[KB];
+    };
+
+    static constexpr void fillEntryLists(Table& t) {
+        int c = 0, b = 0;
+        for (int k = 0; k < K; k++) {
+            if (t.behind[k]) t.behind_at[b++] = k;
+            else t.cross[c++] = k;
+        }
+    }
+
+    static constexpr Table build() {
+        Table t{};
+        int k = 0;
+        for (int dz = -R; dz <= R; dz++) {
+            for (int dy = -R; dy <= R; dy++) {
+                for (int dx = -R; dx <= R; dx++) {
+                    if ((dx == 0 && dy == 0 && dz == 0) || dx * dx + dy * dy + dz * dz > R * R) continue;
+                    t.dx[k] = dx;
+                    t.dy[k] = dy;
+                    t.dz[k] = dz;
+                    t.line[k] = (dz + R) * (2 * R + 1) + (dy + R);
+                    t.in_row[k] = (dy == 0 && dz == 0);
+                    t.behind[k] = (dy == 0 && dz == 0 && dx < 0);
+                    k++;
+                }
+            }
+        }
+        fillEntryLists(t);
+        return t;
+    }
+
+    static constexpr Table table = build();
+
+    template<typename Real>
+    static const Real* weights() {
+        static const std::array<Real, K> w = []() {
+            std::array<Real, K> out{};
+            for (int k = 0; k < K; k++) {
+                const double dx = table.dx[k];
+                const double dy = table.dy[k];
+                const double dz = table.dz[k];
+                out[k] = static_cast<Real>(
+                    stencil_detail::kernelWeight(std::sqrt(dx * dx + dy * dy + dz * dz), static_cast<double>(R)));
+            }
+            return out;
+        }();
+        return w.data();
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,559 @@
+/**
+ * IGSOA Fused Diagnostics - One Pass over the SoA Lattice
+ *
+ * Computes any subset of the post-mission observables in a single
+ * threaded sweep instead of one serial pass each:
+ *
+ *   DIAG_ENERGY          E = ∑_i [F_i + Φ_i²]     (IGSOAPhysicsSoA::computeTotalEnergy)
+ *   DIAG_ENTROPY_RATE    Ṡ = ∑_i Ṡ_i               (IGSOAPhysicsSoA::computeTotalEntropyRate)
+ *   DIAG_CENTER_OF_MASS  circular mean of F per torus axis
+ *                                                (IGSOAStateInit2D/3D::computeCenterOfMass)
+ *
+ * Rows (x lines) are split across OpenMP threads. Within a row the x
+ * angle comes from a CircularAxis table; the y and z angles are constant
+ * per row and are applied to the row sums. Results agree with the serial
+ * helpers to rounding (summation order differs).
+ *
+ * IGSOAObservableRecorder runs the same sums inside the engines' step loop
+ * to record a time series of these observables (and of probe nodes) during
+ * a mission, optionally feeding a sliding spectrum bank.
+ */
+
+#pragma once
+
+#include "igsoa_lattice_soa.h"
+#include "lattice_diagnostics.h"
+#include "observable_ring.h"
+#include "sliding_spectrum.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace dase {
+namespace igsoa {
+
+// Observable selection bits
+enum DiagnosticMask : uint32_t {
+    DIAG_ENERGY         = 1u << 0,
+    DIAG_ENTROPY_RATE   = 1u << 1,
+    DIAG_CENTER_OF_MASS = 1u << 2,
+    DIAG_ALL            = DIAG_ENERGY | DIAG_ENTROPY_RATE | DIAG_CENTER_OF_MASS
+};
+
+/**
+ * One lattice node's field, recorded as its own observable channel
+ */
+enum class IGSOAProbeField : uint8_t {
+    PsiReal,
+    PsiImag,
+    Phi,
+    F
+};
+
+struct IGSOAProbe {
+    size_t node = 0;
+    IGSOAProbeField field = IGSOAProbeField::PsiReal;
+
+    bool operator==(const IGSOAProbe& other) const { return node == other.node && field == other.field; }
+};
+
+inline const char* probeFieldName(IGSOAProbeField field) {
+    switch (field) {
+        case IGSOAProbeField::PsiReal: return "psi_real";
+        case IGSOAProbeField::PsiImag: return "psi_imag";
+        case IGSOAProbeField::Phi: return "phi";
+        case IGSOAProbeField::F: return "F";
+    }
+    return "psi_real";
+}
+
+inline bool parseProbeField(const std::string& name, IGSOAProbeField& field) {
+    for (IGSOAProbeField f : {IGSOAProbeField::PsiReal, IGSOAProbeField::PsiImag,
+                              IGSOAProbeField::Phi, IGSOAProbeField::F}) {
+        if (name == probeFieldName(f)) {
+            field = f;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Observables of one pass; fields outside mask are left at zero
+ */
+struct IGSOADiagnostics {
+    uint32_t mask = 0;
+    double total_energy = 0.0;
+    double total_entropy_rate = 0.0;
+    double x_cm = 0.0;
+    double y_cm = 0.0;
+    double z_cm = 0.0;  // 0 for 2D lattices
+
+    bool has(DiagnosticMask bit) const { return (mask & bit) != 0; }
+};
+
+/**
+ * Partial sums of one pass over part of the lattice (combine with +=)
+ */
+struct IGSOADiagnosticSums {
+    double energy = 0.0;
+    double entropy_rate = 0.0;
+    double sum_F = 0.0;
+    double cx = 0.0, sx = 0.0;
+    double cy = 0.0, sy = 0.0;
+    double cz = 0.0, sz = 0.0;
+
+    IGSOADiagnosticSums& operator+=(const IGSOADiagnosticSums& other) {
+        energy += other.energy;
+        entropy_rate += other.entropy_rate;
+        sum_F += other.sum_F;
+        cx += other.cx;
+        sx += other.sx;
+        cy += other.cy;
+        sy += other.sy;
+        cz += other.cz;
+        sz += other.sz;
+        return *this;
+    }
+};
+
+class IGSOADiagnosticsPass {
+public:
+    static constexpr size_t kParallelThreshold = 16384;  // Nodes below which threads cost more
+
+    /**
+     * Run the pass on a row-major (N_x, N_y, N_z) lattice (N_z = 1 for 2D)
+     */
+    template<typename Real>
+    IGSOADiagnostics compute(const IGSOALatticeSoAT<Real>& lattice,
+                             size_t N_x, size_t N_y, size_t N_z, uint32_t mask) {
+        mask &= DIAG_ALL;
+        if (mask == 0 || lattice.size() == 0) {
+            IGSOADiagnostics out;
+            out.mask = mask;
+            return out;
+        }
+        prepare(N_x, N_y, N_z, mask);
+
+        double energy = 0.0, entropy_rate = 0.0, sum_F = 0.0;
+        double cx = 0.0, sx = 0.0, cy = 0.0, sy = 0.0, cz = 0.0, sz = 0.0;
+        const long rows = static_cast<long>(N_y * N_z);
+
+        #pragma omp parallel for schedule(static) reduction(+:energy, entropy_rate, sum_F, cx, sx, cy, sy, cz, sz) \
+            if(lattice.size() >= kParallelThreshold)
+        for (long r = 0; r < rows; r++) {
+            const size_t row = static_cast<size_t>(r) * N_x;
+            IGSOADiagnosticSums s;
+            accumulate(lattice, N_x, N_y, row, row + N_x, mask, s);
+            energy += s.energy;
+            entropy_rate += s.entropy_rate;
+            sum_F += s.sum_F;
+            cx += s.cx;
+            sx += s.sx;
+            cy += s.cy;
+            sy += s.sy;
+            cz += s.cz;
+            sz += s.sz;
+        }
+
+        IGSOADiagnosticSums total;
+        total.energy = energy;
+        total.entropy_rate = entropy_rate;
+        total.sum_F = sum_F;
+        total.cx = cx;
+        total.sx = sx;
+        total.cy = cy;
+        total.sy = sy;
+        total.cz = cz;
+        total.sz = sz;
+        return finish(total, N_x, N_y, N_z, mask);
+    }
+
+    /**
+     * Build the axis tables accumulate() needs for mask
+     */
+    void prepare(size_t N_x, size_t N_y, size_t N_z, uint32_t mask) {
+        if ((mask & DIAG_CENTER_OF_MASS) == 0) return;
+        axis_x_.build(N_x);
+        axis_y_.build(N_y);
+        axis_z_.build(N_z);
+    }
+
+    /**
+     * Add nodes [begin, end) of the lattice to sums (after prepare(); the
+     * range may start and end mid-row, e.g. a 1D thread block)
+     */
+    template<typename Real>
+    void accumulate(const IGSOALatticeSoAT<Real>& lattice, size_t N_x, size_t N_y,
+                    size_t begin, size_t end, uint32_t mask, IGSOADiagnosticSums& sums) const {
+        const Real* F = lattice.F.data();
+        const Real* phi = lattice.phi.data();
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* R_c = lattice.R_c.data();
+        const bool want_com = (mask & DIAG_CENTER_OF_MASS) != 0;
+
+        size_t node = begin;
+        while (node < end) {
+            const size_t r = node / N_x;
+            const size_t row = r * N_x;
+            const size_t x0 = node - row;
+            const size_t x1 = std::min(N_x, x0 + (end - node));
+            node = row + x1;
+
+            if (mask & DIAG_ENERGY) {
+                double row_energy = 0.0;
+                #pragma omp simd reduction(+:row_energy)
+                for (size_t x = x0; x < x1; x++) {
+                    const double p = phi[row + x];
+                    row_energy += static_cast<double>(F[row + x]) + p * p;
+                }
+                sums.energy += row_energy;
+            }
+            if (mask & DIAG_ENTROPY_RATE) {
+                double row_entropy = 0.0;
+                #pragma omp simd reduction(+:row_entropy)
+                for (size_t x = x0; x < x1; x++) {
+                    const double diff = static_cast<double>(phi[row + x]) - psi_re[row + x];
+                    row_entropy += R_c[row + x] * diff * diff;
+                }
+                sums.entropy_rate += row_entropy;
+            }
+            if (want_com) {
+                const double* cos_x = axis_x_.cosTable();
+                const double* sin_x = axis_x_.sinTable();
+                double row_F = 0.0, row_cx = 0.0, row_sx = 0.0;
+                #pragma omp simd reduction(+:row_F, row_cx, row_sx)
+                for (size_t x = x0; x < x1; x++) {
+                    const double f = F[row + x];
+                    row_F += f;
+                    row_cx += f * cos_x[x];
+                    row_sx += f * sin_x[x];
+                }
+                // y and z are constant along a row
+                const size_t y = r % N_y;
+                const size_t z = r / N_y;
+                sums.sum_F += row_F;
+                sums.cx += row_cx;
+                sums.sx += row_sx;
+                sums.cy += row_F * axis_y_.cosTable()[y];
+                sums.sy += row_F * axis_y_.sinTable()[y];
+                sums.cz += row_F * axis_z_.cosTable()[z];
+                sums.sz += row_F * axis_z_.sinTable()[z];
+            }
+        }
+    }
+
+    /**
+     * Observables of the whole-lattice sums
+     */
+    static IGSOADiagnostics finish(const IGSOADiagnosticSums& sums,
+                                   size_t N_x, size_t N_y, size_t N_z, uint32_t mask) {
+        IGSOADiagnostics out;
+        out.mask = mask & DIAG_ALL;
+        if (out.has(DIAG_ENERGY)) out.total_energy = sums.energy;
+        if (out.has(DIAG_ENTROPY_RATE)) out.total_entropy_rate = sums.entropy_rate;
+        if (out.has(DIAG_CENTER_OF_MASS) && sums.sum_F > 0.0) {
+            out.x_cm = circularCenter(sums.cx, sums.sx, N_x);
+            out.y_cm = (N_y > 1) ? circularCenter(sums.cy, sums.sy, N_y) : 0.0;
+            out.z_cm = (N_z > 1) ? circularCenter(sums.cz, sums.sz, N_z) : 0.0;
+        }
+        return out;
+    }
+
+private:
+    CircularAxis axis_x_;
+    CircularAxis axis_y_;
+    CircularAxis axis_z_;
+};
+
+/**
+ * Observable time series recorded during runMission()
+ *
+ * Every interval steps (counted over the engine's lifetime, so the cadence
+ * carries across missions) the selected observables go into an
+ * ObservableRing. Inside IGSOAPhysicsSoA::runSteps each thread adds its own
+ * rows to a per-thread partial right after the fused causal pass wrote
+ * them, and thread 0 combines the partials after the barrier that pass
+ * already has: a recorded step costs one read of F/Φ/Ṡ that is still in
+ * cache, no extra barrier and no allocation.
+ *
+ * Channels, in order: energy, entropy_rate, x_cm, y_cm, z_cm, limited to
+ * the mask and to the lattice dimension (1D: x_cm only), then one channel
+ * per probe ("phi@120"), read by the thread whose rows hold its node. A
+ * sample at step n has time t_0 + (n - n_0)·dt, n_0 and t_0 being the
+ * mission start.
+ *
+ * With a spectrum configured, every sample also updates a
+ * SlidingSpectrumBank over all channels, so spectrograms of the
+ * observables come out of the step loop without copying any state.
+ */
+class IGSOAObservableRecorder {
+public:
+    /**
+     * Record mask's observables and the probes every interval steps into
+     * capacity samples (clears the series and the spectrum; no channels,
+     * interval 0 or capacity 0 disables, dropping the spectrum too)
+     *
+     * @param dimension Lattice dimension (1, 2 or 3)
+     */
+    void configure(uint32_t mask, uint64_t interval, size_t capacity, int dimension,
+                   const std::vector<IGSOAProbe>& probes = std::vector<IGSOAProbe>()) {
+        mask_ = mask & DIAG_ALL;
+        interval_ = interval;
+        dimension_ = dimension;
+        probes_ = probes;
+        if ((mask_ == 0 && probes_.empty()) || interval_ == 0 || capacity == 0) {
+            mask_ = 0;
+            interval_ = 0;
+            capacity = 0;
+            probes_.clear();
+            spectrum_request_ = SlidingSpectrumConfig();
+        }
+        channels_.clear();
+        if (mask_ & DIAG_ENERGY) channels_.push_back(CHANNEL_ENERGY);
+        if (mask_ & DIAG_ENTROPY_RATE) channels_.push_back(CHANNEL_ENTROPY_RATE);
+        if (mask_ & DIAG_CENTER_OF_MASS) {
+            channels_.push_back(CHANNEL_X_CM);
+            if (dimension >= 2) channels_.push_back(CHANNEL_Y_CM);
+            if (dimension >= 3) channels_.push_back(CHANNEL_Z_CM);
+        }
+        static const char* const names[] = {"energy", "entropy_rate", "x_cm", "y_cm", "z_cm"};
+        names_.clear();
+        for (Channel channel : channels_) names_.push_back(names[channel]);
+        for (const IGSOAProbe& probe : probes_) {
+            names_.push_back(std::string(probeFieldName(probe.field)) + "@" + std::to_string(probe.node));
+        }
+
+        // Probes by node, so a thread finds its own with one search
+        probe_order_.resize(probes_.size());
+        for (size_t p = 0; p < probes_.size(); p++) probe_order_[p] = p;
+        std::stable_sort(probe_order_.begin(), probe_order_.end(),
+                         [this](size_t a, size_t b) { return probes_[a].node < probes_[b].node; });
+        probe_values_.assign(probes_.size(), std::numeric_limits<double>::quiet_NaN());
+
+        held_.clear();
+        ring_.configure(names_.size(), capacity);
+        resetSpectrum();
+    }
+
+    /**
+     * Feed every sample into a sliding spectrum bank over all channels
+     * (clears it; no frequencies disables). config.frequencies are in
+     * cycles per unit time and are converted with the sample period
+     * dt·interval, here and whenever configure() changes the interval.
+     */
+    void configureSpectrum(const SlidingSpectrumConfig& config, double dt) {
+        spectrum_request_ = config;
+        spectrum_dt_ = dt;
+        resetSpectrum();
+    }
+
+    void disable() { configure(0, 0, 0, dimension_); }
+    void clear() {
+        ring_.clear();
+        spectrum_.clear();
+    }
+
+    bool enabled() const { return interval_ != 0; }
+    uint32_t mask() const { return mask_; }
+    uint64_t interval() const { return interval_; }
+    const std::vector<IGSOAProbe>& probes() const { return probes_; }
+    const ObservableRing& series() const { return ring_; }
+
+    // Spectrum as requested (frequencies in cycles per unit time) and the bank itself
+    const SlidingSpectrumConfig& spectrumRequest() const { return spectrum_request_; }
+    const SlidingSpectrumBank& spectrum() const { return spectrum_; }
+
+    size_t channelCount() const { return names_.size(); }
+    const char* channelName(size_t channel) const {
+        return names_[channel].c_str();
+    }
+
+    // Steps from total_steps to the next recorded one (1..interval)
+    uint64_t stepsToNextSample(uint64_t total_steps) const {
+        return interval_ - total_steps % interval_;
+    }
+
+    /**
+     * Mission start: lattice extents, engine step count and time before the
+     * first step; sizes the per-thread partials (allocates only when the
+     * thread count grows)
+     */
+    void beginMission(size_t N_x, size_t N_y, size_t N_z, uint64_t first_step, double t0, double dt) {
+        N_x_ = N_x;
+        N_y_ = N_y;
+        N_z_ = N_z;
+        first_step_ = first_step;
+        t0_ = t0;
+        dt_ = dt;
+        pass_.prepare(N_x, N_y, N_z, mask_);
+        size_t threads = 1;
+#ifdef _OPENMP
+        threads = static_cast<size_t>(omp_get_max_threads());
+#endif
+        if (partials_.size() < threads) partials_.resize(threads);
+    }
+
+    // True if step (0-based within the mission) is recorded
+    bool due(uint64_t step) const {
+        return interval_ != 0 && (first_step_ + step + 1) % interval_ == 0;
+    }
+
+    /**
+     * Thread's share of a recorded step: nodes [begin, end)
+     */
+    template<typename Real>
+    void accumulate(const IGSOALatticeSoAT<Real>& lattice, size_t begin, size_t end, size_t thread) {
+        IGSOADiagnosticSums& sums = partials_[thread].sums;
+        sums = IGSOADiagnosticSums();
+        if (mask_ != 0) {
+            pass_.accumulate(lattice, N_x_, N_y_, begin, end, mask_, sums);
+        }
+        if (!probes_.empty()) {
+            sampleProbes(lattice, begin, end);
+        }
+    }
+
+    /**
+     * Read the probes on nodes [begin, end) (all of them by default), for
+     * samples recorded outside runSteps
+     */
+    template<typename Real>
+    void sampleProbes(const IGSOALatticeSoAT<Real>& lattice, size_t begin = 0,
+                      size_t end = std::numeric_limits<size_t>::max()) {
+        end = std::min(end, lattice.size());
+        auto first = std::lower_bound(probe_order_.begin(), probe_order_.end(), begin,
+                                      [this](size_t p, size_t node) { return probes_[p].node < node; });
+        for (auto it = first; it != probe_order_.end() && probes_[*it].node < end; ++it) {
+            const size_t node = probes_[*it].node;
+            double value = 0.0;
+            switch (probes_[*it].field) {
+                case IGSOAProbeField::PsiReal: value = static_cast<double>(lattice.psi_re[node]); break;
+                case IGSOAProbeField::PsiImag: value = static_cast<double>(lattice.psi_im[node]); break;
+                case IGSOAProbeField::Phi: value = static_cast<double>(lattice.phi[node]); break;
+                case IGSOAProbeField::F: value = static_cast<double>(lattice.F[node]); break;
+            }
+            probe_values_[*it] = value;
+        }
+    }
+
+    /**
+     * Combine the threads' partials of step (one thread, after a barrier)
+     */
+    void commit(uint64_t step, size_t threads) {
+        IGSOADiagnosticSums total;
+        for (size_t t = 0; t < threads; t++) total += partials_[t].sums;
+        record(first_step_ + step + 1, t0_ + static_cast<double>(step + 1) * dt_,
+               IGSOADiagnosticsPass::finish(total, N_x_, N_y_, N_z_, mask_));
+    }
+
+    /**
+     * Append a sample computed elsewhere (missions that bypass runSteps;
+     * call sampleProbes() first when there are probes)
+     */
+    void record(uint64_t step, double time, const IGSOADiagnostics& d) {
+        fillSample(d);
+        ring_.push(step, time, sample_.data());
+        spectrum_.push(step, time, sample_.data());
+    }
+
+    /**
+     * Sample the whole lattice at step / time but hold it back:
+     * commitHeld() appends the held samples in order, dropHeld() discards
+     * them (runUntil's trial steps; call beginMission() first)
+     */
+    template<typename Real>
+    void hold(const IGSOALatticeSoAT<Real>& lattice, uint64_t step, double time) {
+        IGSOADiagnosticSums sums;
+        if (mask_ != 0) {
+            pass_.accumulate(lattice, N_x_, N_y_, 0, lattice.size(), mask_, sums);
+        }
+        sampleProbes(lattice);
+        fillSample(IGSOADiagnosticsPass::finish(sums, N_x_, N_y_, N_z_, mask_));
+        held_.push_back(HeldSample{step, time, sample_});
+    }
+
+    void commitHeld() {
+        for (const HeldSample& held : held_) {
+            ring_.push(held.step, held.time, held.values.data());
+            spectrum_.push(held.step, held.time, held.values.data());
+        }
+        held_.clear();
+    }
+
+    void dropHeld() { held_.clear(); }
+
+private:
+    enum Channel : uint8_t {
+        CHANNEL_ENERGY = 0, CHANNEL_ENTROPY_RATE, CHANNEL_X_CM, CHANNEL_Y_CM, CHANNEL_Z_CM
+    };
+
+    // One cache line per thread so partial writes don't false-share
+    struct alignas(64) Partial {
+        IGSOADiagnosticSums sums;
+    };
+
+    struct HeldSample {
+        uint64_t step;
+        double time;
+        std::vector<double> values;
+    };
+
+    // Channel values of d, then the probe values, into sample_
+    void fillSample(const IGSOADiagnostics& d) {
+        double* values = sample_.data();
+        for (size_t c = 0; c < channels_.size(); c++) {
+            switch (channels_[c]) {
+                case CHANNEL_ENERGY: values[c] = d.total_energy; break;
+                case CHANNEL_ENTROPY_RATE: values[c] = d.total_entropy_rate; break;
+                case CHANNEL_X_CM: values[c] = d.x_cm; break;
+                case CHANNEL_Y_CM: values[c] = d.y_cm; break;
+                case CHANNEL_Z_CM: values[c] = d.z_cm; break;
+            }
+        }
+        for (size_t p = 0; p < probes_.size(); p++) {
+            values[channels_.size() + p] = probe_values_[p];
+        }
+    }
+
+    uint32_t mask_ = 0;
+    uint64_t interval_ = 0;
+    int dimension_ = 2;
+    std::vector<Channel> channels_;
+    std::vector<std::string> names_;
+    std::vector<IGSOAProbe> probes_;
+    std::vector<size_t> probe_order_;
+    std::vector<double> probe_values_;   // Written by the thread owning the node
+    std::vector<double> sample_;         // One row of channel values
+    std::vector<HeldSample> held_;       // hold() samples awaiting commitHeld()
+    ObservableRing ring_;
+
+    SlidingSpectrumConfig spectrum_request_;
+    double spectrum_dt_ = 0.0;
+    SlidingSpectrumBank spectrum_;
+
+    IGSOADiagnosticsPass pass_;
+    std::vector<Partial> partials_;
+    size_t N_x_ = 0, N_y_ = 1, N_z_ = 1;
+    uint64_t first_step_ = 0;
+    double t0_ = 0.0;
+    double dt_ = 0.0;
+
+    void resetSpectrum() {
+        sample_.assign(names_.size(), 0.0);
+        SlidingSpectrumConfig config = spectrum_request_;
+        const double period = spectrum_dt_ * static_cast<double>(interval_);
+        for (double& f : config.frequencies) f *= period;
+        spectrum_.configure(enabled() ? names_.size() : 0, config);
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
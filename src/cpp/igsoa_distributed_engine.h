@@ -0,0 +1,652 @@
+/**
+ * IGSOA Complex Engine - MPI Domain Decomposition (2D/3D)
+ *
+ * Distributes the N_x × N_y (× N_z) torus across the ranks of an MPI
+ * communicator as contiguous slabs along the slowest axis (rows of N_x in
+ * 2D, planes of N_x·N_y in 3D). Each rank time-steps only the nodes it owns
+ * and keeps ghost copies of its neighbours' boundary slabs:
+ *
+ * - Ψ halo of ceil(R_c) slabs per side, exchanged before the coupling sweep.
+ *   The exchange is posted non-blocking and overlapped with the coupling of
+ *   the interior slabs, which only read locally owned Ψ; the boundary slabs
+ *   are swept once the halo has arrived.
+ * - F halo of one slab per side for the central-difference gradient, with
+ *   the same overlap.
+ *
+ * Every node sees Ψ at the start of the step (Jacobi ordering, as in the
+ * Spectral coupling mode), so the trajectory does not depend on the number
+ * of ranks; it agrees with the in-place Direct sweep to O(dt²) per step.
+ *
+ * Coupling uses a CouplingStencil2D/3D for the uniform R_c_default of the
+ * configuration. Every rank must own at least ceil(R_c) slabs (and at least
+ * one), so each halo comes from the immediate neighbour.
+ *
+ * Requires MPI; the CMake option DASE_ENABLE_MPI builds the test and the
+ * scaling benchmark against it.
+ */
+
+#pragma once
+
+#include "igsoa_complex_node.h"
+#include "igsoa_coupling_stencil.h"
+#include "igsoa_lattice_soa.h"
+#include "igsoa_checkpoint.h"
+#include "igsoa_physics_soa.h"
+#include <mpi.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+namespace mpi_detail {
+
+template <typename T> MPI_Datatype datatype();
+template <> inline MPI_Datatype datatype<double>() { return MPI_DOUBLE; }
+template <> inline MPI_Datatype datatype<uint32_t>() { return MPI_UINT32_T; }
+
+} // namespace mpi_detail
+
+/**
+ * Slab partition of one torus axis and the halo exchange between neighbours
+ *
+ * Rank r owns slabs [firstSlab(), firstSlab() + localSlabs()); the first
+ * N % P ranks own one extra slab. Halo buffers hold localSlabs() + 2·halo
+ * slabs: halo ghost slabs, the owned slabs, halo ghost slabs.
+ */
+class SlabDecomposition {
+public:
+    SlabDecomposition(MPI_Comm comm, size_t total_slabs, size_t slab_size)
+        : total_slabs_(total_slabs)
+        , slab_size_(slab_size)
+    {
+        MPI_Comm_dup(comm, &comm_);
+        MPI_Comm_rank(comm_, &rank_);
+        MPI_Comm_size(comm_, &size_);
+
+        const size_t P = static_cast<size_t>(size_);
+        const size_t r = static_cast<size_t>(rank_);
+        const size_t base = total_slabs / P;
+        const size_t extra = total_slabs % P;
+        local_slabs_ = base + (r < extra ? 1 : 0);
+        first_slab_ = r * base + std::min(r, extra);
+
+        lower_ = (rank_ + size_ - 1) % size_;
+        upper_ = (rank_ + 1) % size_;
+    }
+
+    ~SlabDecomposition() { MPI_Comm_free(&comm_); }
+
+    SlabDecomposition(const SlabDecomposition&) = delete;
+    SlabDecomposition& operator=(const SlabDecomposition&) = delete;
+
+    MPI_Comm comm() const { return comm_; }
+    int rank() const { return rank_; }
+    int size() const { return size_; }
+    size_t totalSlabs() const { return total_slabs_; }
+    size_t slabSize() const { return slab_size_; }
+    size_t firstSlab() const { return first_slab_; }
+    size_t localSlabs() const { return local_slabs_; }
+    size_t localSize() const { return local_slabs_ * slab_size_; }
+
+    /**
+     * Smallest slab count owned by any rank (the halo width limit)
+     */
+    size_t minLocalSlabs() const { return total_slabs_ / static_cast<size_t>(size_); }
+
+    /**
+     * Post the halo exchange for one field
+     *
+     * Sends the lowest and highest `halo` owned slabs of `ext` to the lower
+     * and upper neighbours and receives their boundary slabs into the ghost
+     * regions. Appends four requests to `requests`; complete them with
+     * MPI_Waitall before reading the ghosts or overwriting the owned slabs.
+     */
+    void postHalo(double* ext, size_t halo, int tag, std::vector<MPI_Request>& requests) const {
+        if (halo == 0) return;
+        const int count = static_cast<int>(halo * slab_size_);
+        double* ghost_low = ext;
+        double* owned_low = ext + halo * slab_size_;
+        double* owned_high = ext + local_slabs_ * slab_size_;
+        double* ghost_high = ext + (local_slabs_ + halo) * slab_size_;
+
+        // Tag 2·tag travels downwards, 2·tag + 1 upwards, so both directions
+        // stay distinct when the lower and upper neighbour are the same rank.
+        MPI_Request request;
+        MPI_Irecv(ghost_low, count, MPI_DOUBLE, lower_, 2 * tag + 1, comm_, &request);
+        requests.push_back(request);
+        MPI_Irecv(ghost_high, count, MPI_DOUBLE, upper_, 2 * tag, comm_, &request);
+        requests.push_back(request);
+        MPI_Isend(owned_low, count, MPI_DOUBLE, lower_, 2 * tag, comm_, &request);
+        requests.push_back(request);
+        MPI_Isend(owned_high, count, MPI_DOUBLE, upper_, 2 * tag + 1, comm_, &request);
+        requests.push_back(request);
+    }
+
+    /**
+     * Gather one owned plane into the global plane on root
+     */
+    template <typename Plane>
+    void gather(const Plane& local, Plane* global, int root) const {
+        using T = typename Plane::value_type;
+        std::vector<int> counts, displs;
+        if (rank_ == root) {
+            counts.resize(size_);
+            displs.resize(size_);
+            const size_t base = total_slabs_ / static_cast<size_t>(size_);
+            const size_t extra = total_slabs_ % static_cast<size_t>(size_);
+            for (int r = 0; r < size_; r++) {
+                const size_t ur = static_cast<size_t>(r);
+                counts[r] = static_cast<int>((base + (ur < extra ? 1 : 0)) * slab_size_);
+                displs[r] = static_cast<int>((ur * base + std::min(ur, extra)) * slab_size_);
+            }
+            global->resize(total_slabs_ * slab_size_);
+        }
+        MPI_Gatherv(local.data(), static_cast<int>(local.size()), mpi_detail::datatype<T>(),
+                    rank_ == root ? global->data() : nullptr, counts.data(), displs.data(),
+                    mpi_detail::datatype<T>(), root, comm_);
+    }
+
+    /**
+     * Gather every plane of the owned lattice into `global` on root
+     */
+    void gatherLattice(const IGSOALatticeSoA& local, IGSOALatticeSoA& global, int root) const {
+        forEachLatticePlane(global, [&](const char* name, auto& global_plane) {
+            forEachLatticePlane(local, [&](const char* local_name, const auto& plane) {
+                using Plane = std::decay_t<decltype(global_plane)>;
+                if constexpr (std::is_same_v<Plane, std::decay_t<decltype(plane)>>) {
+                    if (std::strcmp(name, local_name) == 0) gather(plane, &global_plane, root);
+                }
+            });
+        });
+    }
+
+    double allreduceSum(double local) const {
+        double global = 0.0;
+        MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_SUM, comm_);
+        return global;
+    }
+
+private:
+    MPI_Comm comm_;
+    int rank_ = 0;
+    int size_ = 1;
+    int lower_ = 0;
+    int upper_ = 0;
+    size_t total_slabs_;
+    size_t slab_size_;
+    size_t first_slab_ = 0;
+    size_t local_slabs_ = 0;
+};
+
+/**
+ * Per-rank timing of the distributed step
+ */
+struct DistributedStepTimings {
+    double compute_seconds = 0.0;   // Coupling and local stages
+    double halo_wait_seconds = 0.0; // Time blocked in MPI_Waitall after the interior sweep
+    uint64_t halo_bytes = 0;        // Bytes received into ghost slabs
+};
+
+/**
+ * Slab-decomposed 2D engine
+ *
+ * Rank r owns rows [firstRow(), firstRow() + localRows()) of the global
+ * N_x × N_y torus; localLattice() stores them row-major (local index
+ * (y - firstRow()) * N_x + x). All ranks of the communicator must construct
+ * the engine and call runMission() and the reductions collectively.
+ */
+class IGSOADistributedEngine2D {
+public:
+    IGSOADistributedEngine2D(const IGSOAComplexConfig& config, MPI_Comm comm, size_t N_x, size_t N_y)
+        : config_(config)
+        , N_x_(N_x)
+        , N_y_(N_y)
+        , slabs_(comm, N_y, N_x)
+    {
+        if (N_x == 0 || N_y == 0) {
+            throw std::invalid_argument("Lattice dimensions must be positive");
+        }
+        stencil_.build(config.R_c_default, N_x, N_y);
+        psi_halo_ = static_cast<size_t>(stencil_.reach());
+        if (slabs_.minLocalSlabs() < std::max<size_t>(psi_halo_, 1)) {
+            throw std::invalid_argument("Each rank must own at least max(ceil(R_c), 1) rows (" +
+                                        std::to_string(N_y) + " rows over " +
+                                        std::to_string(slabs_.size()) + " ranks)");
+        }
+
+        lattice_.resize(slabs_.localSize());
+        std::fill(lattice_.R_c.begin(), lattice_.R_c.end(), config.R_c_default);
+        std::fill(lattice_.kappa.begin(), lattice_.kappa.end(), config.kappa);
+        std::fill(lattice_.gamma.begin(), lattice_.gamma.end(), config.gamma);
+
+        const size_t rows = slabs_.localSlabs();
+        ext_re_.assign((rows + 2 * psi_halo_) * N_x, 0.0);
+        ext_im_.assign((rows + 2 * psi_halo_) * N_x, 0.0);
+        ext_F_.assign((rows + 2) * N_x, 0.0);
+        nl_re_.assign(slabs_.localSize(), 0.0);
+        nl_im_.assign(slabs_.localSize(), 0.0);
+    }
+
+    size_t getNx() const { return N_x_; }
+    size_t getNy() const { return N_y_; }
+    size_t getTotalNodes() const { return N_x_ * N_y_; }
+    int rank() const { return slabs_.rank(); }
+    int ranks() const { return slabs_.size(); }
+    size_t firstRow() const { return slabs_.firstSlab(); }
+    size_t localRows() const { return slabs_.localSlabs(); }
+    size_t haloWidth() const { return psi_halo_; }
+    double getCurrentTime() const { return current_time_; }
+    uint64_t getTotalSteps() const { return total_steps_; }
+    uint64_t getLocalOperations() const { return total_operations_; }
+    const DistributedStepTimings& getTimings() const { return timings_; }
+
+    /**
+     * Owned nodes (set initial state here; kappa/gamma/R_c come from config)
+     */
+    IGSOALatticeSoA& localLattice() { return lattice_; }
+    const IGSOALatticeSoA& localLattice() const { return lattice_; }
+
+    bool ownsRow(size_t y) const { return y >= firstRow() && y < firstRow() + localRows(); }
+    size_t localIndex(size_t x, size_t y) const { return (y - firstRow()) * N_x_ + x; }
+
+    void runMission(uint64_t num_steps) {
+        for (uint64_t step = 0; step < num_steps; step++) {
+            timeStep();
+        }
+    }
+
+    /**
+     * Global reductions (collective)
+     */
+    double getTotalEnergy() const {
+        return slabs_.allreduceSum(IGSOAPhysicsSoA::computeTotalEnergy(lattice_));
+    }
+
+    double getTotalEntropyRate() const {
+        return slabs_.allreduceSum(IGSOAPhysicsSoA::computeTotalEntropyRate(lattice_));
+    }
+
+    /**
+     * Assemble the global lattice on root (collective; other ranks' output is untouched)
+     */
+    void gatherLattice(IGSOALatticeSoA& global, int root = 0) const {
+        slabs_.gatherLattice(lattice_, global, root);
+    }
+
+private:
+    void timeStep() {
+        const size_t rows = localRows();
+        const size_t h = psi_halo_;
+        const auto start = std::chrono::steady_clock::now();
+        double waited = 0.0;
+
+        // Ψ: owned rows into the halo buffers, exchange, sweep interior while in flight
+        std::memcpy(ext_re_.data() + h * N_x_, lattice_.psi_re.data(), rows * N_x_ * sizeof(double));
+        std::memcpy(ext_im_.data() + h * N_x_, lattice_.psi_im.data(), rows * N_x_ * sizeof(double));
+        requests_.clear();
+        slabs_.postHalo(ext_re_.data(), h, 0, requests_);
+        slabs_.postHalo(ext_im_.data(), h, 1, requests_);
+
+        const size_t interior_end = (rows > h) ? rows - h : h;
+        for (size_t y = h; y < interior_end; y++) couplingRow(y);
+        waited += waitAll();
+        for (size_t y = 0; y < std::min(h, rows); y++) couplingRow(y);
+        for (size_t y = std::max(interior_end, h); y < rows; y++) couplingRow(y);
+
+        const double inv_hbar = 1.0;
+        for (size_t i = 0; i < lattice_.size(); i++) {
+            IGSOAPhysicsSoA::advancePsi(lattice_, i, nl_re_[i], nl_im_[i], config_.dt, inv_hbar);
+        }
+        total_operations_ += lattice_.size() * (stencil_.size() + 1);
+
+        total_operations_ += IGSOAPhysicsSoA::evolveCausalField(lattice_, config_.dt);
+        total_operations_ += IGSOAPhysicsSoA::updateDerivedQuantities(lattice_);
+
+        // F: one ghost row per side for the central difference
+        std::memcpy(ext_F_.data() + N_x_, lattice_.F.data(), rows * N_x_ * sizeof(double));
+        requests_.clear();
+        slabs_.postHalo(ext_F_.data(), 1, 2, requests_);
+        for (size_t y = 1; y + 1 < rows; y++) gradientRow(y);
+        waited += waitAll();
+        gradientRow(0);
+        if (rows > 1) gradientRow(rows - 1);
+        total_operations_ += lattice_.size();
+
+        if (config_.normalize_psi) {
+            total_operations_ += IGSOAPhysicsSoA::normalizeStates(lattice_);
+        }
+
+        current_time_ += config_.dt;
+        total_steps_++;
+        timings_.halo_bytes += (2 * 2 * h + 2) * N_x_ * sizeof(double);
+        timings_.halo_wait_seconds += waited;
+        timings_.compute_seconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() - waited;
+    }
+
+    double waitAll() {
+        const auto start = std::chrono::steady_clock::now();
+        MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 𝒦[Ψ] for owned row y from the start-of-step halo buffers
+    void couplingRow(size_t y) {
+        const int N_x_int = static_cast<int>(N_x_);
+        const int reach = stencil_.reach();
+        const size_t K = stencil_.size();
+        const int* off_x = stencil_.dx();
+        const int* off_y = stencil_.dy();
+        const std::ptrdiff_t* off_linear = stencil_.linear();
+        const double* weight = stencil_.weight();
+        const double* psi_re = ext_re_.data();
+        const double* psi_im = ext_im_.data();
+        const int y_ext = static_cast<int>(y + psi_halo_);
+
+        for (int x = 0; x < N_x_int; x++) {
+            const size_t e = static_cast<size_t>(y_ext) * N_x_ + static_cast<size_t>(x);
+            const double self_re = psi_re[e];
+            const double self_im = psi_im[e];
+            double nl_re = 0.0;
+            double nl_im = 0.0;
+
+            if (x >= reach && x + reach < N_x_int) {
+                const double* base_re = psi_re + e;
+                const double* base_im = psi_im + e;
+                for (size_t k = 0; k < K; k++) {
+                    nl_re += weight[k] * (base_re[off_linear[k]] - self_re);
+                    nl_im += weight[k] * (base_im[off_linear[k]] - self_im);
+                }
+            } else {
+                for (size_t k = 0; k < K; k++) {
+                    int x_j = (x + off_x[k]) % N_x_int;
+                    if (x_j < 0) x_j += N_x_int;
+                    const size_t j = static_cast<size_t>(y_ext + off_y[k]) * N_x_ + static_cast<size_t>(x_j);
+                    nl_re += weight[k] * (psi_re[j] - self_re);
+                    nl_im += weight[k] * (psi_im[j] - self_im);
+                }
+            }
+
+            const size_t i = y * N_x_ + static_cast<size_t>(x);
+            nl_re_[i] = nl_re;
+            nl_im_[i] = nl_im;
+        }
+    }
+
+    // |∇F| for owned row y (ext_F_ row y + 1)
+    void gradientRow(size_t y) {
+        const double* F = ext_F_.data();
+        const size_t row = (y + 1) * N_x_;
+        const size_t row_up = row + N_x_;
+        const size_t row_down = row - N_x_;
+        double* grad = lattice_.F_gradient.data() + y * N_x_;
+
+        for (size_t x = 0; x < N_x_; x++) {
+            const size_t x_right = (x == N_x_ - 1) ? 0 : x + 1;
+            const size_t x_left = (x == 0) ? N_x_ - 1 : x - 1;
+            const double dF_dx = (F[row + x_right] - F[row + x_left]) * 0.5;
+            const double dF_dy = (F[row_up + x] - F[row_down + x]) * 0.5;
+            grad[x] = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy);
+        }
+    }
+
+    IGSOAComplexConfig config_;
+    size_t N_x_;
+    size_t N_y_;
+    SlabDecomposition slabs_;
+    CouplingStencil2D stencil_;
+    size_t psi_halo_ = 0;
+    IGSOALatticeSoA lattice_;
+    std::vector<double> ext_re_, ext_im_, ext_F_;  // Owned rows plus ghost rows
+    std::vector<double> nl_re_, nl_im_;            // 𝒦[Ψ] for the owned rows
+    std::vector<MPI_Request> requests_;
+    double current_time_ = 0.0;
+    uint64_t total_steps_ = 0;
+    uint64_t total_operations_ = 0;
+    DistributedStepTimings timings_;
+};
+
+/**
+ * Slab-decomposed 3D engine
+ *
+ * Rank r owns z-planes [firstPlane(), firstPlane() + localPlanes()) of the
+ * global N_x × N_y × N_z torus; local index (z - firstPlane()) * N_x * N_y +
+ * y * N_x + x.
+ */
+class IGSOADistributedEngine3D {
+public:
+    IGSOADistributedEngine3D(const IGSOAComplexConfig& config, MPI_Comm comm,
+                             size_t N_x, size_t N_y, size_t N_z)
+        : config_(config)
+        , N_x_(N_x)
+        , N_y_(N_y)
+        , N_z_(N_z)
+        , plane_size_(N_x * N_y)
+        , slabs_(comm, N_z, N_x * N_y)
+    {
+        if (N_x == 0 || N_y == 0 || N_z == 0) {
+            throw std::invalid_argument("Lattice dimensions must be positive");
+        }
+        stencil_.build(config.R_c_default, N_x, N_y, N_z);
+        psi_halo_ = static_cast<size_t>(stencil_.reach());
+        if (slabs_.minLocalSlabs() < std::max<size_t>(psi_halo_, 1)) {
+            throw std::invalid_argument("Each rank must own at least max(ceil(R_c), 1) z-planes (" +
+                                        std::to_string(N_z) + " planes over " +
+                                        std::to_string(slabs_.size()) + " ranks)");
+        }
+
+        lattice_.resize(slabs_.localSize());
+        std::fill(lattice_.R_c.begin(), lattice_.R_c.end(), config.R_c_default);
+        std::fill(lattice_.kappa.begin(), lattice_.kappa.end(), config.kappa);
+        std::fill(lattice_.gamma.begin(), lattice_.gamma.end(), config.gamma);
+
+        const size_t planes = slabs_.localSlabs();
+        ext_re_.assign((planes + 2 * psi_halo_) * plane_size_, 0.0);
+        ext_im_.assign((planes + 2 * psi_halo_) * plane_size_, 0.0);
+        ext_F_.assign((planes + 2) * plane_size_, 0.0);
+        nl_re_.assign(slabs_.localSize(), 0.0);
+        nl_im_.assign(slabs_.localSize(), 0.0);
+    }
+
+    size_t getNx() const { return N_x_; }
+    size_t getNy() const { return N_y_; }
+    size_t getNz() const { return N_z_; }
+    size_t getTotalNodes() const { return plane_size_ * N_z_; }
+    int rank() const { return slabs_.rank(); }
+    int ranks() const { return slabs_.size(); }
+    size_t firstPlane() const { return slabs_.firstSlab(); }
+    size_t localPlanes() const { return slabs_.localSlabs(); }
+    size_t haloWidth() const { return psi_halo_; }
+    double getCurrentTime() const { return current_time_; }
+    uint64_t getTotalSteps() const { return total_steps_; }
+    uint64_t getLocalOperations() const { return total_operations_; }
+    const DistributedStepTimings& getTimings() const { return timings_; }
+
+    IGSOALatticeSoA& localLattice() { return lattice_; }
+    const IGSOALatticeSoA& localLattice() const { return lattice_; }
+
+    bool ownsPlane(size_t z) const { return z >= firstPlane() && z < firstPlane() + localPlanes(); }
+    size_t localIndex(size_t x, size_t y, size_t z) const {
+        return (z - firstPlane()) * plane_size_ + y * N_x_ + x;
+    }
+
+    void runMission(uint64_t num_steps) {
+        for (uint64_t step = 0; step < num_steps; step++) {
+            timeStep();
+        }
+    }
+
+    double getTotalEnergy() const {
+        return slabs_.allreduceSum(IGSOAPhysicsSoA::computeTotalEnergy(lattice_));
+    }
+
+    double getTotalEntropyRate() const {
+        return slabs_.allreduceSum(IGSOAPhysicsSoA::computeTotalEntropyRate(lattice_));
+    }
+
+    void gatherLattice(IGSOALatticeSoA& global, int root = 0) const {
+        slabs_.gatherLattice(lattice_, global, root);
+    }
+
+private:
+    void timeStep() {
+        const size_t planes = localPlanes();
+        const size_t h = psi_halo_;
+        const auto start = std::chrono::steady_clock::now();
+        double waited = 0.0;
+
+        std::memcpy(ext_re_.data() + h * plane_size_, lattice_.psi_re.data(),
+                    planes * plane_size_ * sizeof(double));
+        std::memcpy(ext_im_.data() + h * plane_size_, lattice_.psi_im.data(),
+                    planes * plane_size_ * sizeof(double));
+        requests_.clear();
+        slabs_.postHalo(ext_re_.data(), h, 0, requests_);
+        slabs_.postHalo(ext_im_.data(), h, 1, requests_);
+
+        const size_t interior_end = (planes > h) ? planes - h : h;
+        for (size_t z = h; z < interior_end; z++) couplingPlane(z);
+        waited += waitAll();
+        for (size_t z = 0; z < std::min(h, planes); z++) couplingPlane(z);
+        for (size_t z = std::max(interior_end, h); z < planes; z++) couplingPlane(z);
+
+        const double inv_hbar = 1.0;
+        for (size_t i = 0; i < lattice_.size(); i++) {
+            IGSOAPhysicsSoA::advancePsi(lattice_, i, nl_re_[i], nl_im_[i], config_.dt, inv_hbar);
+        }
+        total_operations_ += lattice_.size() * (stencil_.size() + 1);
+
+        total_operations_ += IGSOAPhysicsSoA::evolveCausalField(lattice_, config_.dt);
+        total_operations_ += IGSOAPhysicsSoA::updateDerivedQuantities(lattice_);
+
+        std::memcpy(ext_F_.data() + plane_size_, lattice_.F.data(), planes * plane_size_ * sizeof(double));
+        requests_.clear();
+        slabs_.postHalo(ext_F_.data(), 1, 2, requests_);
+        for (size_t z = 1; z + 1 < planes; z++) gradientPlane(z);
+        waited += waitAll();
+        gradientPlane(0);
+        if (planes > 1) gradientPlane(planes - 1);
+        total_operations_ += lattice_.size();
+
+        if (config_.normalize_psi) {
+            total_operations_ += IGSOAPhysicsSoA::normalizeStates(lattice_);
+        }
+
+        current_time_ += config_.dt;
+        total_steps_++;
+        timings_.halo_bytes += (2 * 2 * h + 2) * plane_size_ * sizeof(double);
+        timings_.halo_wait_seconds += waited;
+        timings_.compute_seconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() - waited;
+    }
+
+    double waitAll() {
+        const auto start = std::chrono::steady_clock::now();
+        MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 𝒦[Ψ] for owned plane z; x and y wrap explicitly, z indexes the ghost planes
+    void couplingPlane(size_t z) {
+        const int N_x_int = static_cast<int>(N_x_);
+        const int N_y_int = static_cast<int>(N_y_);
+        const int reach = stencil_.reach();
+        const size_t K = stencil_.size();
+        const int* off_x = stencil_.dx();
+        const int* off_y = stencil_.dy();
+        const int* off_z = stencil_.dz();
+        const std::ptrdiff_t* off_linear = stencil_.linear();
+        const double* weight = stencil_.weight();
+        const double* psi_re = ext_re_.data();
+        const double* psi_im = ext_im_.data();
+        const int z_ext = static_cast<int>(z + psi_halo_);
+
+        for (int y = 0; y < N_y_int; y++) {
+            const bool y_interior = (y >= reach) && (y + reach < N_y_int);
+
+            for (int x = 0; x < N_x_int; x++) {
+                const size_t e = static_cast<size_t>(z_ext) * plane_size_ +
+                                 static_cast<size_t>(y) * N_x_ + static_cast<size_t>(x);
+                const double self_re = psi_re[e];
+                const double self_im = psi_im[e];
+                double nl_re = 0.0;
+                double nl_im = 0.0;
+
+                if (y_interior && x >= reach && x + reach < N_x_int) {
+                    const double* base_re = psi_re + e;
+                    const double* base_im = psi_im + e;
+                    for (size_t k = 0; k < K; k++) {
+                        nl_re += weight[k] * (base_re[off_linear[k]] - self_re);
+                        nl_im += weight[k] * (base_im[off_linear[k]] - self_im);
+                    }
+                } else {
+                    for (size_t k = 0; k < K; k++) {
+                        int x_j = (x + off_x[k]) % N_x_int;
+                        if (x_j < 0) x_j += N_x_int;
+                        int y_j = (y + off_y[k]) % N_y_int;
+                        if (y_j < 0) y_j += N_y_int;
+                        const size_t j = static_cast<size_t>(z_ext + off_z[k]) * plane_size_ +
+                                         static_cast<size_t>(y_j) * N_x_ + static_cast<size_t>(x_j);
+                        nl_re += weight[k] * (psi_re[j] - self_re);
+                        nl_im += weight[k] * (psi_im[j] - self_im);
+                    }
+                }
+
+                const size_t i = z * plane_size_ + static_cast<size_t>(y) * N_x_ + static_cast<size_t>(x);
+                nl_re_[i] = nl_re;
+                nl_im_[i] = nl_im;
+            }
+        }
+    }
+
+    // |∇F| for owned plane z (ext_F_ plane z + 1)
+    void gradientPlane(size_t z) {
+        const double* F = ext_F_.data();
+        const size_t plane = (z + 1) * plane_size_;
+        const size_t plane_front = plane + plane_size_;
+        const size_t plane_back = plane - plane_size_;
+        double* grad = lattice_.F_gradient.data() + z * plane_size_;
+
+        for (size_t y = 0; y < N_y_; y++) {
+            const size_t row = y * N_x_;
+            const size_t row_up = ((y == N_y_ - 1) ? 0 : y + 1) * N_x_;
+            const size_t row_down = ((y == 0) ? N_y_ - 1 : y - 1) * N_x_;
+
+            for (size_t x = 0; x < N_x_; x++) {
+                const size_t x_right = (x == N_x_ - 1) ? 0 : x + 1;
+                const size_t x_left = (x == 0) ? N_x_ - 1 : x - 1;
+                const double dF_dx = (F[plane + row + x_right] - F[plane + row + x_left]) * 0.5;
+                const double dF_dy = (F[plane + row_up + x] - F[plane + row_down + x]) * 0.5;
+                const double dF_dz = (F[plane_front + row + x] - F[plane_back + row + x]) * 0.5;
+                grad[row + x] = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy + dF_dz * dF_dz);
+            }
+        }
+    }
+
+    IGSOAComplexConfig config_;
+    size_t N_x_;
+    size_t N_y_;
+    size_t N_z_;
+    size_t plane_size_;
+    SlabDecomposition slabs_;
+    CouplingStencil3D stencil_;
+    size_t psi_halo_ = 0;
+    IGSOALatticeSoA lattice_;
+    std::vector<double> ext_re_, ext_im_, ext_F_;  // Owned planes plus ghost planes
+    std::vector<double> nl_re_, nl_im_;            // 𝒦[Ψ] for the owned planes
+    std::vector<MPI_Request> requests_;
+    double current_time_ = 0.0;
+    uint64_t total_steps_ = 0;
+    uint64_t total_operations_ = 0;
+    DistributedStepTimings timings_;
+};
+
+} // namespace igsoa
+} // namespace dase
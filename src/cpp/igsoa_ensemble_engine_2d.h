@@ -0,0 +1,562 @@
+/**
+ * IGSOA Ensemble Engine - Batched 2D Replicas
+ *
+ * Steps B independent IGSOA 2D tori of the same size in lockstep, for
+ * parameter sweeps over many small lattices (e.g. thousands of 64×64
+ * replicas with different κ/γ) where one engine per replica would spend
+ * most of its time in per-call overhead and short loops.
+ *
+ * Layout: replicas are grouped in blocks of kBlock (one cache line of
+ * doubles), and every field stores each block contiguously, batch-innermost:
+ * node i of replica b is at [(b / kBlock · N + i) · kBlock + b % kBlock].
+ * The coupling sweep walks the stencil once per node and applies it to a
+ * whole block, so the innermost loop is a fixed-length unit-stride loop
+ * across replicas that vectorizes, and a block's neighbor reads stay within
+ * one contiguous plane (no large-stride cache-set conflicts for big B).
+ * OpenMP threads own disjoint blocks. The last block is padded with inert
+ * replicas that are stepped but never reported.
+ *
+ * R_c is shared by all replicas of an ensemble (one coupling stencil); κ and
+ * γ are per replica. Each replica follows the trajectory of an
+ * IGSOAComplexEngine2D with the same parameters in Direct coupling mode
+ * (same in-place row-major sweep and local stages), so results agree with
+ * the single-lattice engine to rounding.
+ */
+
+#pragma once
+
+#include "igsoa_complex_node.h"
+#include "igsoa_coupling_stencil.h"
+#include "igsoa_lattice_soa.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+class IGSOAEnsembleEngine2D {
+public:
+    // Replicas per vector block (one 64-byte cache line of doubles)
+    static constexpr size_t kBlock = 8;
+
+    /**
+     * Constructor
+     *
+     * @param config Shared configuration (R_c_default, dt, normalize_psi;
+     *        kappa/gamma are the initial values of every replica)
+     * @param N_x Number of nodes in x-direction
+     * @param N_y Number of nodes in y-direction
+     * @param replicas Number of replicas B
+     */
+    IGSOAEnsembleEngine2D(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t replicas)
+        : config_(config)
+        , N_x_(N_x)
+        , N_y_(N_y)
+        , B_(replicas)
+        , num_blocks_((replicas + kBlock - 1) / kBlock)
+    {
+        if (N_x == 0 || N_y == 0) {
+            throw std::invalid_argument("Lattice dimensions must be positive");
+        }
+        if (N_x > 4096 || N_y > 4096) {
+            throw std::invalid_argument("Lattice dimension too large (max 4096 per axis)");
+        }
+        if (replicas == 0) {
+            throw std::invalid_argument("Ensemble needs at least one replica");
+        }
+        if (N_x * N_y * replicas > 100'000'000) {
+            throw std::invalid_argument("Total nodes exceeds limit (100M max)");
+        }
+
+        const size_t total = N_x * N_y * num_blocks_ * kBlock;
+        for (auto* plane : planes()) {
+            plane->assign(total, 0.0);
+        }
+        kappa_.assign(num_blocks_ * kBlock, config.kappa);
+        gamma_.assign(num_blocks_ * kBlock, config.gamma);
+        stencil_.build(config.R_c_default, N_x, N_y);
+    }
+
+    size_t getNx() const { return N_x_; }
+    size_t getNy() const { return N_y_; }
+    size_t getNodesPerReplica() const { return N_x_ * N_y_; }
+    size_t getReplicaCount() const { return B_; }
+    double getRc() const { return config_.R_c_default; }
+    double getCurrentTime() const { return current_time_; }
+    uint64_t getTotalSteps() const { return total_steps_; }
+    uint64_t getTotalOperations() const { return total_operations_; }
+
+    /**
+     * Per-replica coupling parameters
+     *
+     * @return false if replica is out of range
+     */
+    bool setReplicaParams(size_t replica, double kappa, double gamma) {
+        if (replica >= B_) return false;
+        kappa_[replica] = kappa;
+        gamma_[replica] = gamma;
+        return true;
+    }
+
+    double getReplicaKappa(size_t replica) const { return kappa_.at(replica); }
+    double getReplicaGamma(size_t replica) const { return gamma_.at(replica); }
+
+    /**
+     * Bulk state access for nodes [first, first + count) of one replica
+     *
+     * Indices are row-major (y * N_x + x), buffers caller-owned with an
+     * element stride, as in IGSOAComplexEngine2D::setPsiRange.
+     *
+     * @return false if the replica or range is out of bounds, or a buffer is null
+     */
+    bool setPsiRange(size_t replica, size_t first, size_t count,
+                     const double* re, const double* im, size_t stride = 1) {
+        if (!re || !im || !rangeFits(replica, first, count, stride)) return false;
+        for (size_t n = 0; n < count; n++) {
+            const size_t at = slot(first + n, replica);
+            psi_re_[at] = re[n * stride];
+            psi_im_[at] = im[n * stride];
+        }
+        return true;
+    }
+
+    bool getPsiRange(size_t replica, size_t first, size_t count,
+                     double* re, double* im, size_t stride = 1) const {
+        if (!re || !im || !rangeFits(replica, first, count, stride)) return false;
+        for (size_t n = 0; n < count; n++) {
+            const size_t at = slot(first + n, replica);
+            re[n * stride] = psi_re_[at];
+            im[n * stride] = psi_im_[at];
+        }
+        return true;
+    }
+
+    bool setPhiRange(size_t replica, size_t first, size_t count, const double* values, size_t stride = 1) {
+        if (!values || !rangeFits(replica, first, count, stride)) return false;
+        for (size_t n = 0; n < count; n++) {
+            phi_[slot(first + n, replica)] = values[n * stride];
+        }
+        return true;
+    }
+
+    bool getPhiRange(size_t replica, size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(replica, first, count, stride)) return false;
+        for (size_t n = 0; n < count; n++) {
+            values[n * stride] = phi_[slot(first + n, replica)];
+        }
+        return true;
+    }
+
+    bool getFRange(size_t replica, size_t first, size_t count, double* values, size_t stride = 1) const {
+        if (!values || !rangeFits(replica, first, count, stride)) return false;
+        for (size_t n = 0; n < count; n++) {
+            values[n * stride] = F_[slot(first + n, replica)];
+        }
+        return true;
+    }
+
+    /**
+     * Copy one replica from / to a single-lattice SoA (e.g. the lattice of an
+     * IGSOAComplexEngine2D initialized with IGSOAStateInit2D)
+     *
+     * loadReplica() takes the evolving state (Ψ, Φ and their derivatives,
+     * F, |∇F|) but not R_c/κ/γ; storeReplica() also fills R_c, κ and γ so
+     * the result can seed a standalone engine.
+     *
+     * @return false if replica is out of range or the lattice size differs
+     */
+    bool loadReplica(size_t replica, const IGSOALatticeSoA& lattice) {
+        if (replica >= B_ || lattice.size() != getNodesPerReplica()) return false;
+        const size_t N = getNodesPerReplica();
+        for (size_t i = 0; i < N; i++) {
+            const size_t at = slot(i, replica);
+            psi_re_[at] = lattice.psi_re[i];
+            psi_im_[at] = lattice.psi_im[i];
+            psi_dot_re_[at] = lattice.psi_dot_re[i];
+            psi_dot_im_[at] = lattice.psi_dot_im[i];
+            phi_[at] = lattice.phi[i];
+            phi_dot_[at] = lattice.phi_dot[i];
+            F_[at] = lattice.F[i];
+            F_gradient_[at] = lattice.F_gradient[i];
+        }
+        return true;
+    }
+
+    bool storeReplica(size_t replica, IGSOALatticeSoA& lattice) const {
+        if (replica >= B_) return false;
+        const size_t N = getNodesPerReplica();
+        lattice.resize(N);
+        for (size_t i = 0; i < N; i++) {
+            const size_t at = slot(i, replica);
+            lattice.psi_re[i] = psi_re_[at];
+            lattice.psi_im[i] = psi_im_[at];
+            lattice.psi_dot_re[i] = psi_dot_re_[at];
+            lattice.psi_dot_im[i] = psi_dot_im_[at];
+            lattice.phi[i] = phi_[at];
+            lattice.phi_dot[i] = phi_dot_[at];
+            lattice.F[i] = F_[at];
+            lattice.F_gradient[i] = F_gradient_[at];
+            lattice.R_c[i] = config_.R_c_default;
+            lattice.kappa[i] = kappa_[replica];
+            lattice.gamma[i] = gamma_[replica];
+        }
+        return true;
+    }
+
+    /**
+     * Run mission - advance every replica num_steps steps
+     *
+     * @param input_signals Optional driving signals (length: num_steps), shared by all replicas
+     * @param control_patterns Optional control patterns (length: num_steps)
+     */
+    void runMission(
+        uint64_t num_steps,
+        const double* input_signals = nullptr,
+        const double* control_patterns = nullptr
+    ) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        const uint64_t replica_nodes = static_cast<uint64_t>(getNodesPerReplica() * B_);
+        uint64_t operations_this_run = 0;
+
+        for (uint64_t step = 0; step < num_steps; step++) {
+            if (input_signals && control_patterns) {
+                applyDriving(input_signals[step], control_patterns[step]);
+                operations_this_run += replica_nodes;
+            }
+
+            // Coupling sweep with the causal-field and derived-quantity
+            // updates fused per node, then gradients (+ normalization)
+            sweep();
+            operations_this_run += replica_nodes * (static_cast<uint64_t>(stencil_.size()) + 3);
+            if (config_.normalize_psi) {
+                operations_this_run += replica_nodes;
+            }
+
+            current_time_ += config_.dt;
+            total_steps_++;
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+        total_operations_ += operations_this_run;
+        if (operations_this_run > 0) {
+            ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
+            ops_per_sec_ = 1.0e9 / ns_per_op_;
+        }
+    }
+
+    /**
+     * Get performance metrics (as IGSOAComplexEngine2D::getMetrics)
+     */
+    void getMetrics(
+        double& out_ns_per_op,
+        double& out_ops_per_sec,
+        double& out_speedup_factor,
+        uint64_t& out_total_ops
+    ) const {
+        out_ns_per_op = ns_per_op_;
+        out_ops_per_sec = ops_per_sec_;
+        out_speedup_factor = (ns_per_op_ > 0.0) ? (1.0 / ns_per_op_) : 0.0;
+        out_total_ops = total_operations_;
+    }
+
+    /**
+     * Replica energy E_b = ∑_i [|Ψ_i|² + Φ_i²]
+     */
+    double getReplicaEnergy(size_t replica) const {
+        if (replica >= B_) return 0.0;
+        double energy = 0.0;
+        for (size_t i = 0; i < getNodesPerReplica(); i++) {
+            const size_t at = slot(i, replica);
+            energy += F_[at];
+            energy += phi_[at] * phi_[at];
+        }
+        return energy;
+    }
+
+    /**
+     * Replica entropy production rate Ṡ_b = ∑_i Ṡ_i
+     */
+    double getReplicaEntropyRate(size_t replica) const {
+        if (replica >= B_) return 0.0;
+        const double R_c = config_.R_c_default;
+        double total_entropy = 0.0;
+        for (size_t i = 0; i < getNodesPerReplica(); i++) {
+            const size_t at = slot(i, replica);
+            const double diff = phi_[at] - psi_re_[at];
+            total_entropy += R_c * diff * diff;
+        }
+        return total_entropy;
+    }
+
+    /**
+     * Zero every replica's state and clock (parameters are kept)
+     */
+    void reset() {
+        for (auto* plane : planes()) {
+            std::fill(plane->begin(), plane->end(), 0.0);
+        }
+        current_time_ = 0.0;
+        total_steps_ = 0;
+        total_operations_ = 0;
+        ns_per_op_ = 0.0;
+        ops_per_sec_ = 0.0;
+    }
+
+    /**
+     * Bytes held by the replica planes and the stencil
+     */
+    size_t getMemoryUsage() const {
+        size_t total = stencil_.getMemoryUsage();
+        for (const auto* plane : planes()) {
+            total += plane->capacity() * sizeof(double);
+        }
+        return total + (kappa_.capacity() + gamma_.capacity()) * sizeof(double);
+    }
+
+    /**
+     * getMemoryUsage() of an engine constructed with these arguments
+     */
+    static size_t estimateMemoryUsage(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t replicas) {
+        const size_t slots = ((replicas + kBlock - 1) / kBlock) * kBlock;
+        CouplingStencil2D stencil;
+        stencil.build(config.R_c_default, N_x, N_y);
+        return stencil.getMemoryUsage() + 8 * N_x * N_y * slots * sizeof(double) + 2 * slots * sizeof(double);
+    }
+
+private:
+    std::vector<LatticeArray<double>*> planes() {
+        return {&psi_re_, &psi_im_, &psi_dot_re_, &psi_dot_im_, &phi_, &phi_dot_,
+                &F_, &F_gradient_};
+    }
+
+    std::vector<const LatticeArray<double>*> planes() const {
+        return {&psi_re_, &psi_im_, &psi_dot_re_, &psi_dot_im_, &phi_, &phi_dot_,
+                &F_, &F_gradient_};
+    }
+
+    // Plane index of node i in replica b
+    size_t slot(size_t i, size_t b) const {
+        return ((b / kBlock) * getNodesPerReplica() + i) * kBlock + b % kBlock;
+    }
+
+    bool rangeFits(size_t replica, size_t first, size_t count, size_t stride) const {
+        const size_t N = getNodesPerReplica();
+        return replica < B_ && stride > 0 && first <= N && count <= N - first;
+    }
+
+    /**
+     * IGSOAPhysicsSoA::applyDriving on every replica
+     */
+    void applyDriving(double signal_real, double signal_imag) {
+        const size_t total = psi_re_.size();
+        double* phi = phi_.data();
+        double* psi_re = psi_re_.data();
+        double* psi_im = psi_im_.data();
+
+        #pragma omp simd
+        for (size_t at = 0; at < total; at++) {
+            phi[at] += signal_real;
+            psi_re[at] += signal_real;
+            psi_im[at] += signal_imag;
+        }
+    }
+
+    /**
+     * One time step for every replica
+     *
+     * Per block, nodes are visited in row-major order and each node couples
+     * to the current Ψ of its neighbors (in-place, as
+     * IGSOAPhysicsSoA::evolveQuantumState2D), then runs the causal-field and
+     * derived-quantity updates, which only read the node itself. Gradients
+     * and normalization follow once the block's sweep is complete.
+     */
+    void sweep() {
+        const long long num_blocks = static_cast<long long>(num_blocks_);
+
+        #pragma omp parallel for schedule(static)
+        for (long long blk = 0; blk < num_blocks; blk++) {
+            const size_t offset = static_cast<size_t>(blk) * getNodesPerReplica() * kBlock;
+            sweepBlock(offset, static_cast<size_t>(blk) * kBlock);
+            gradientBlock(offset);
+        }
+    }
+
+    /**
+     * @param offset Plane offset of the block
+     * @param b_begin First replica of the block
+     */
+    void sweepBlock(size_t offset, size_t b_begin) {
+        const int N_x_int = static_cast<int>(N_x_);
+        const int N_y_int = static_cast<int>(N_y_);
+        const int reach = stencil_.reach();
+        const size_t K = stencil_.size();
+        const int* off_x = stencil_.dx();
+        const int* off_y = stencil_.dy();
+        const std::ptrdiff_t* off_linear = stencil_.linear();
+        const double* weight = stencil_.weight();
+        const double dt = config_.dt;
+        const double* kappa = kappa_.data() + b_begin;
+        const double* gamma = gamma_.data() + b_begin;
+        double* block_re = psi_re_.data() + offset;
+        double* block_im = psi_im_.data() + offset;
+
+        for (int y = 0; y < N_y_int; y++) {
+            const bool y_interior = (y >= reach) && (y + reach < N_y_int);
+
+            for (int x = 0; x < N_x_int; x++) {
+                const size_t i = static_cast<size_t>(y) * N_x_ + static_cast<size_t>(x);
+                const size_t at = i * kBlock;
+                double* psi_re = block_re + at;
+                double* psi_im = block_im + at;
+
+                double nl_re[kBlock] = {};
+                double nl_im[kBlock] = {};
+
+                if (y_interior && x >= reach && x + reach < N_x_int) {
+                    for (size_t k = 0; k < K; k++) {
+                        const double w = weight[k];
+                        const double* nb_re = psi_re + off_linear[k] * static_cast<std::ptrdiff_t>(kBlock);
+                        const double* nb_im = psi_im + off_linear[k] * static_cast<std::ptrdiff_t>(kBlock);
+                        #pragma omp simd
+                        for (size_t l = 0; l < kBlock; l++) {
+                            nl_re[l] += w * (nb_re[l] - psi_re[l]);
+                            nl_im[l] += w * (nb_im[l] - psi_im[l]);
+                        }
+                    }
+                } else {
+                    for (size_t k = 0; k < K; k++) {
+                        int x_j = (x + off_x[k]) % N_x_int;
+                        if (x_j < 0) x_j += N_x_int;
+                        int y_j = (y + off_y[k]) % N_y_int;
+                        if (y_j < 0) y_j += N_y_int;
+                        const size_t j = static_cast<size_t>(y_j) * N_x_ + static_cast<size_t>(x_j);
+                        const double w = weight[k];
+                        const double* nb_re = block_re + j * kBlock;
+                        const double* nb_im = block_im + j * kBlock;
+                        #pragma omp simd
+                        for (size_t l = 0; l < kBlock; l++) {
+                            nl_re[l] += w * (nb_re[l] - psi_re[l]);
+                            nl_im[l] += w * (nb_im[l] - psi_im[l]);
+                        }
+                    }
+                }
+
+                double* psi_dot_re = psi_dot_re_.data() + offset + at;
+                double* psi_dot_im = psi_dot_im_.data() + offset + at;
+                double* phi = phi_.data() + offset + at;
+                double* phi_dot = phi_dot_.data() + offset + at;
+                double* F = F_.data() + offset + at;
+
+                #pragma omp simd
+                for (size_t l = 0; l < kBlock; l++) {
+                    // IGSOAPhysicsSoA::advancePsi (ℏ = 1)
+                    const double re0 = psi_re[l];
+                    const double im0 = psi_im[l];
+                    const double V_eff = kappa[l] * phi[l];
+                    const double g = gamma[l];
+                    const double H_re = -nl_re[l] + V_eff * re0 - g * im0;
+                    const double H_im = -nl_im[l] + V_eff * im0 + g * re0;
+                    const double dot_re = H_im;
+                    const double dot_im = -H_re;
+                    psi_dot_re[l] = dot_re;
+                    psi_dot_im[l] = dot_im;
+                    const double re = re0 + dot_re * dt;
+                    const double im = im0 + dot_im * dt;
+                    psi_re[l] = re;
+                    psi_im[l] = im;
+
+                    // evolveCausalField
+                    const double coupling_diff = phi[l] - re;
+                    const double phi_rate = -kappa[l] * coupling_diff - gamma[l] * phi[l];
+                    const double phi_new = phi[l] + phi_rate * dt;
+                    phi_dot[l] = phi_rate;
+                    phi[l] = phi_new;
+
+                    // updateDerivedQuantities
+                    F[l] = re * re + im * im;
+                }
+            }
+        }
+    }
+
+    /**
+     * |∇F| (computeGradients2D) and optional normalization for one block
+     */
+    void gradientBlock(size_t offset) {
+        const size_t block_size = getNodesPerReplica() * kBlock;
+        const double* F = F_.data() + offset;
+        double* grad = F_gradient_.data() + offset;
+        double* psi_re = psi_re_.data() + offset;
+        double* psi_im = psi_im_.data() + offset;
+
+        for (size_t y = 0; y < N_y_; y++) {
+            const size_t row = y * N_x_;
+            const size_t row_up = ((y == N_y_ - 1) ? 0 : y + 1) * N_x_;
+            const size_t row_down = ((y == 0) ? N_y_ - 1 : y - 1) * N_x_;
+
+            for (size_t x = 0; x < N_x_; x++) {
+                const size_t x_right = (x == N_x_ - 1) ? 0 : x + 1;
+                const size_t x_left = (x == 0) ? N_x_ - 1 : x - 1;
+                const double* F_right = F + (row + x_right) * kBlock;
+                const double* F_left = F + (row + x_left) * kBlock;
+                const double* F_up = F + (row_up + x) * kBlock;
+                const double* F_down = F + (row_down + x) * kBlock;
+                double* out = grad + (row + x) * kBlock;
+
+                #pragma omp simd
+                for (size_t l = 0; l < kBlock; l++) {
+                    const double dF_dx = (F_right[l] - F_left[l]) * 0.5;
+                    const double dF_dy = (F_up[l] - F_down[l]) * 0.5;
+                    out[l] = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy);
+                }
+            }
+        }
+
+        if (!config_.normalize_psi) return;
+        for (size_t at = 0; at < block_size; at++) {
+            const double magnitude = std::hypot(psi_re[at], psi_im[at]);
+            if (magnitude > 1e-15) {
+                psi_re[at] /= magnitude;
+                psi_im[at] /= magnitude;
+            }
+        }
+    }
+
+    IGSOAComplexConfig config_;
+    size_t N_x_;
+    size_t N_y_;
+    size_t B_;           // Replica count
+    size_t num_blocks_;  // ceil(B_ / kBlock)
+
+    // Replica planes, index slot(i, b)
+    LatticeArray<double> psi_re_;
+    LatticeArray<double> psi_im_;
+    LatticeArray<double> psi_dot_re_;
+    LatticeArray<double> psi_dot_im_;
+    LatticeArray<double> phi_;
+    LatticeArray<double> phi_dot_;
+    LatticeArray<double> F_;
+    LatticeArray<double> F_gradient_;
+
+    // Per-replica parameters
+    std::vector<double> kappa_;
+    std::vector<double> gamma_;
+
+    CouplingStencil2D stencil_;  // Shared R_c
+
+    double current_time_ = 0.0;
+    uint64_t total_steps_ = 0;
+    uint64_t total_operations_ = 0;
+    double ns_per_op_ = 0.0;
+    double ops_per_sec_ = 0.0;
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,137 @@
+/**
+ * IGSOA GW Engine - Detector Array Implementation
+ */
+
+#include "detector_array.h"
+#include "projection_operators.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+DetectorArray::DetectorArray(const SymmetryField& field, const std::vector<GWDetector>& detectors,
+                             DetectorSampling sampling)
+    : detectors_(detectors)
+    , sampling_(sampling)
+    , nx_(field.getNx())
+    , ny_(field.getNy())
+    , nz_(field.getNz())
+    , inv_2dx_(1.0 / (2.0 * field.getDx()))
+    , inv_2dy_(1.0 / (2.0 * field.getDy()))
+    , inv_2dz_(1.0 / (2.0 * field.getDz()))
+{
+    const size_t n = detectors_.size();
+    corners_.assign(n * kCorners, 0);
+    phi_weights_.assign(n * kCorners, 0.0);
+    strain_weights_.assign(n * kCorners, 0.0);
+    plus_.resize(n * 6);
+    cross_.resize(n * 6);
+
+    const SymmetryFieldConfig& grid = field.getConfig();
+    const int extent[3] = {nx_, ny_, nz_};
+    const double spacing[3] = {grid.dx, grid.dy, grid.dz};
+    const double origin[3] = {grid.origin.x, grid.origin.y, grid.origin.z};
+
+    for (size_t d = 0; d < n; d++) {
+        const Vector3D& p = detectors_[d].position;
+        const double pos[3] = {p.x, p.y, p.z};
+        int lo[3];
+        double frac[3];
+        for (int a = 0; a < 3; a++) {
+            if (sampling_ == DetectorSampling::Nearest) {
+                // toIndices rounding, then clamped as compute_strain_at_observer
+                const int i = static_cast<int>((pos[a] - origin[a]) / spacing[a] + 0.5);
+                lo[a] = std::max(0, std::min(i, extent[a] - 1));
+                frac[a] = 0.0;
+            } else {
+                const double f = std::min(std::max((pos[a] - origin[a]) / spacing[a], 0.0),
+                                          static_cast<double>(extent[a] - 1));
+                lo[a] = std::min(static_cast<int>(std::floor(f)), std::max(extent[a] - 2, 0));
+                frac[a] = f - lo[a];
+            }
+        }
+
+        for (int c = 0; c < kCorners; c++) {
+            const int o[3] = {c & 1, (c >> 1) & 1, (c >> 2) & 1};
+            int index[3];
+            double w = 1.0;
+            for (int a = 0; a < 3; a++) {
+                index[a] = std::min(lo[a] + o[a], extent[a] - 1);
+                w *= o[a] ? frac[a] : 1.0 - frac[a];
+            }
+            const size_t s = d * kCorners + c;
+            corners_[s] = static_cast<uint32_t>(field.toFlatIndex(index[0], index[1], index[2]));
+            phi_weights_[s] = w;
+            const bool boundary = index[0] == 0 || index[0] == nx_ - 1 || index[1] == 0 ||
+                                  index[1] == ny_ - 1 || index[2] == 0 || index[2] == nz_ - 1;
+            strain_weights_[s] = boundary ? 0.0 : w;
+        }
+
+        double plus[3][3], cross[3][3];
+        ProjectionOperators::polarization_tensors(detectors_[d].normal, plus, cross);
+        const double pc[6] = {plus[0][0], plus[1][1], plus[2][2], plus[0][1], plus[0][2], plus[1][2]};
+        const double cc[6] = {cross[0][0], cross[1][1], cross[2][2], cross[0][1], cross[0][2], cross[1][2]};
+        std::copy(pc, pc + 6, plus_.begin() + 6 * d);
+        std::copy(cc, cc + 6, cross_.begin() + 6 * d);
+    }
+}
+
+void DetectorArray::checkGrid(const SymmetryField& field) const {
+    if (field.getNx() != nx_ || field.getNy() != ny_ || field.getNz() != nz_ ||
+        1.0 / (2.0 * field.getDx()) != inv_2dx_) {
+        throw std::invalid_argument("DetectorArray: field grid differs from the one the stencils were built for");
+    }
+}
+
+void DetectorArray::sample(const SymmetryField& field, double* h_plus, double* h_cross) const {
+    checkGrid(field);
+    const std::complex<double>* phi = field.getDeltaPhiFlat().data();
+    const size_t stride_y = static_cast<size_t>(nx_);
+    const size_t stride_z = static_cast<size_t>(nx_) * ny_;
+    const long long n = static_cast<long long>(detectors_.size());
+
+    #pragma omp parallel for schedule(static) if (n >= 256)
+    for (long long d = 0; d < n; d++) {
+        const double* P = &plus_[6 * d];
+        const double* C = &cross_[6 * d];
+        double plus = 0.0;
+        double cross = 0.0;
+        for (int c = 0; c < kCorners; c++) {
+            const size_t s = static_cast<size_t>(d) * kCorners + c;
+            const double w = strain_weights_[s];
+            if (w == 0.0) continue;
+            const size_t idx = corners_[s];
+            const double gx = std::abs((phi[idx + 1] - phi[idx - 1]) * inv_2dx_);
+            const double gy = std::abs((phi[idx + stride_y] - phi[idx - stride_y]) * inv_2dy_);
+            const double gz = std::abs((phi[idx + stride_z] - phi[idx - stride_z]) * inv_2dz_);
+            const double xx = gx * gx, yy = gy * gy, zz = gz * gz;
+            const double xy = 2.0 * gx * gy, xz = 2.0 * gx * gz, yz = 2.0 * gy * gz;
+            plus += w * (P[0] * xx + P[1] * yy + P[2] * zz + P[3] * xy + P[4] * xz + P[5] * yz);
+            cross += w * (C[0] * xx + C[1] * yy + C[2] * zz + C[3] * xy + C[4] * xz + C[5] * yz);
+        }
+        h_plus[d] = plus;
+        h_cross[d] = cross;
+    }
+}
+
+void DetectorArray::sampleDeltaPhi(const SymmetryField& field, std::complex<double>* delta_phi) const {
+    checkGrid(field);
+    const std::complex<double>* phi = field.getDeltaPhiFlat().data();
+    const size_t n = detectors_.size();
+    for (size_t d = 0; d < n; d++) {
+        std::complex<double> value(0.0, 0.0);
+        for (int c = 0; c < kCorners; c++) {
+            const size_t s = d * kCorners + c;
+            value += phi_weights_[s] * phi[corners_[s]];
+        }
+        delta_phi[d] = value;
+    }
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
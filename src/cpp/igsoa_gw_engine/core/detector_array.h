@@ -0,0 +1,92 @@
+/**
+ * IGSOA GW Engine - Detector Array
+ *
+ * Samples h_+, h_× (and δΦ) at a fixed set of observer positions. The
+ * per-detector work that ProjectionOperators::compute_strain_at_observer
+ * repeats every call (toIndices, clamping, polarization tensors) is done
+ * once at construction: each detector keeps up to eight grid-point
+ * stencils with their weights and its six independent e₊ / eₓ
+ * coefficients. sample() then makes one pass over all detectors:
+ *
+ *   std::vector<GWDetector> detectors = {{position, normal}, ...};
+ *   DetectorArray array(field, detectors);
+ *   array.sample(field, h_plus, h_cross);     // h_plus[d], h_cross[d]
+ *
+ * - Trilinear (default): strain and δΦ are interpolated from the eight
+ *   grid points around the position. Strain at a point uses |∇δΦ| by
+ *   centred differences, zero on the boundary, as compute_strain_field.
+ * - Nearest: the nearest grid point, clamped to the grid, exactly as
+ *   compute_strain_at_observer.
+ *
+ * Positions outside the grid are clamped onto it. The array is bound to
+ * the grid shape it was built for (std::invalid_argument otherwise).
+ */
+
+#pragma once
+
+#include "symmetry_field.h"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+/**
+ * One observer: position and propagation direction (as ProjectionConfig)
+ */
+struct GWDetector {
+    Vector3D position;
+    Vector3D normal;
+};
+
+enum class DetectorSampling {
+    Nearest,     // Nearest grid point (compute_strain_at_observer)
+    Trilinear    // Interpolated from the surrounding cell
+};
+
+class DetectorArray {
+public:
+    static constexpr int kCorners = 8;
+
+    DetectorArray(const SymmetryField& field, const std::vector<GWDetector>& detectors,
+                  DetectorSampling sampling = DetectorSampling::Trilinear);
+
+    size_t size() const { return detectors_.size(); }
+    const std::vector<GWDetector>& detectors() const { return detectors_; }
+    DetectorSampling sampling() const { return sampling_; }
+
+    /**
+     * h_+, h_× of every detector (size() values each)
+     */
+    void sample(const SymmetryField& field, double* h_plus, double* h_cross) const;
+
+    /**
+     * Interpolated (or nearest) δΦ of every detector
+     */
+    void sampleDeltaPhi(const SymmetryField& field, std::complex<double>* delta_phi) const;
+
+private:
+    std::vector<GWDetector> detectors_;
+    DetectorSampling sampling_;
+    int nx_, ny_, nz_;
+    double inv_2dx_, inv_2dy_, inv_2dz_;
+
+    // kCorners per detector: flat grid index, δΦ weight, strain weight
+    // (0 on boundary points, where the gradient is zero)
+    std::vector<uint32_t> corners_;
+    std::vector<double> phi_weights_;
+    std::vector<double> strain_weights_;
+
+    // Per detector: e₊ and eₓ as (xx, yy, zz, xy, xz, yz)
+    std::vector<double> plus_;
+    std::vector<double> cross_;
+
+    void checkGrid(const SymmetryField& field) const;
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
@@ -5,12 +5,14 @@
 #define _USE_MATH_DEFINES
 #include "echo_generator.h"
 #include "utils/logger.h"
+#include "../../simd_math.h"
 #include <cmath>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
+#include <stdexcept>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -20,6 +22,13 @@ namespace dase {
 namespace igsoa {
 namespace gw {
 
+namespace {
+
+constexpr double kPulseWidthFactor = 2.0;   // Temporal Gaussian σ in units of τ₀
+constexpr double kActiveWindowSigma = 3.0;  // Active window half-width in units of τ₀
+
+} // namespace
+
 // ============================================================================
 // Constructor
 // ============================================================================
@@ -132,17 +141,16 @@ void EchoGenerator::validateConfig() const {
 // ============================================================================
 
 void EchoGenerator::initialize() {
-    // Generate prime numbers
-    primes_ = generatePrimes(config_.max_prime_value);
-
-    // Compute prime gaps
-    prime_gaps_ = computePrimeGaps(primes_);
+    // Primes and gaps up to max_prime_value from the shared table
+    prime_table_ = PrimeTable::instance().ensure(config_.max_prime_value);
+    num_primes_ = prime_table_->countUpTo(config_.max_prime_value);
+    num_gaps_ = num_primes_ > 0 ? num_primes_ - 1 : 0;
 
     // Generate echo schedule
-    echo_schedule_ = generateEchoSchedule();
+    resetSchedule(generateEchoSchedule());
 
-    LOG_INFO("EchoGenerator initialized: " + std::to_string(primes_.size()) +
-             " primes, " + std::to_string(prime_gaps_.size()) + " gaps, " +
+    LOG_INFO("EchoGenerator initialized: " + std::to_string(num_primes_) +
+             " primes, " + std::to_string(num_gaps_) + " gaps, " +
              std::to_string(echo_schedule_.size()) + " echoes scheduled");
 }
 
@@ -155,29 +163,9 @@ std::vector<int> EchoGenerator::generatePrimes(int max_value) {
         return std::vector<int>();
     }
 
-    // Sieve of Eratosthenes
-    std::vector<bool> is_prime(max_value + 1, true);
-    is_prime[0] = is_prime[1] = false;
-
-    for (int i = 2; i * i <= max_value; i++) {
-        if (is_prime[i]) {
-            for (int j = i * i; j <= max_value; j += i) {
-                is_prime[j] = false;
-            }
-        }
-    }
-
-    // Collect primes
-    std::vector<int> primes;
-    primes.reserve(max_value / std::log(max_value)); // Approximate count
-
-    for (int i = 2; i <= max_value; i++) {
-        if (is_prime[i]) {
-            primes.push_back(i);
-        }
-    }
-
-    return primes;
+    PrimeTable::Snapshot table = PrimeTable::instance().ensure(max_value);
+    const size_t count = table->countUpTo(max_value);
+    return std::vector<int>(table->primes.begin(), table->primes.begin() + count);
 }
 
 std::vector<int> EchoGenerator::computePrimeGaps(const std::vector<int>& primes) {
@@ -186,6 +174,16 @@ std::vector<int> EchoGenerator::computePrimeGaps(const std::vector<int>& primes)
         return gaps;
     }
 
+    // A sorted prime list starting at 2 whose count and last element match
+    // the table is exactly the table's prefix
+    if (primes.front() == 2) {
+        PrimeTable::Snapshot table = PrimeTable::instance().ensure(primes.back());
+        const size_t count = table->countUpTo(primes.back());
+        if (count == primes.size() && table->primes[count - 1] == primes.back()) {
+            return std::vector<int>(table->gaps.begin(), table->gaps.begin() + (count - 1));
+        }
+    }
+
     gaps.reserve(primes.size() - 1);
 
     for (size_t i = 1; i < primes.size(); i++) {
@@ -196,17 +194,17 @@ std::vector<int> EchoGenerator::computePrimeGaps(const std::vector<int>& primes)
 }
 
 int EchoGenerator::getPrime(int n) const {
-    if (n < 0 || n >= static_cast<int>(primes_.size())) {
+    if (n < 0 || static_cast<size_t>(n) >= num_primes_) {
         return -1;
     }
-    return primes_[n];
+    return prime_table_->primes[n];
 }
 
 int EchoGenerator::getPrimeGap(int n) const {
-    if (n < 0 || n >= static_cast<int>(prime_gaps_.size())) {
+    if (n < 0 || static_cast<size_t>(n) >= num_gaps_) {
         return -1;
     }
-    return prime_gaps_[n];
+    return prime_table_->gaps[n];
 }
 
 // ============================================================================
@@ -216,12 +214,12 @@ int EchoGenerator::getPrimeGap(int n) const {
 std::vector<EchoEvent> EchoGenerator::generateEchoSchedule() const {
     std::vector<EchoEvent> schedule;
 
-    if (prime_gaps_.empty()) {
+    if (num_gaps_ == 0) {
         return schedule;
     }
 
     // Determine number of echoes
-    int num_echoes = std::min(config_.max_primes, static_cast<int>(prime_gaps_.size()));
+    int num_echoes = std::min(config_.max_primes, static_cast<int>(num_gaps_));
 
     schedule.reserve(num_echoes);
 
@@ -229,11 +227,11 @@ std::vector<EchoEvent> EchoGenerator::generateEchoSchedule() const {
 
     for (int i = 0; i < num_echoes; i++) {
         int gap_index = config_.prime_start_index + i;
-        if (gap_index >= static_cast<int>(prime_gaps_.size())) {
+        if (gap_index >= static_cast<int>(num_gaps_)) {
             break;
         }
 
-        int gap = prime_gaps_[gap_index];
+        int gap = prime_table_->gaps[gap_index];
 
         // Accumulate time
         cumulative_time += gap * config_.fundamental_timescale;
@@ -264,7 +262,7 @@ EchoEvent EchoGenerator::createEchoEvent(
     echo.frequency = 244.0 + echo_number * config_.echo_frequency_shift; // Start at ~244 Hz
 
     // Prime gap info
-    echo.prime_gap = prime_gaps_[prime_index];
+    echo.prime_gap = prime_table_->gaps[prime_index];
     echo.prime_index = prime_index;
     echo.echo_number = echo_number;
 
@@ -276,12 +274,52 @@ void EchoGenerator::setMergerTime(double t) {
     merger_detected_ = true;
 
     // Regenerate schedule with new merger time
-    echo_schedule_ = generateEchoSchedule();
+    resetSchedule(generateEchoSchedule());
 
     LOG_INFO("Merger time set to " + std::to_string(t) + " s, " +
              std::to_string(echo_schedule_.size()) + " echoes scheduled");
 }
 
+void EchoGenerator::resetSchedule(std::vector<EchoEvent> schedule) {
+    std::stable_sort(schedule.begin(), schedule.end(),
+                     [](const EchoEvent& a, const EchoEvent& b) { return a.time < b.time; });
+    echo_schedule_ = std::move(schedule);
+    window_begin_ = 0;
+    window_end_ = 0;
+    window_half_width_ = -1.0;
+    signal_valid_ = false;
+}
+
+void EchoGenerator::findActiveRange(double t, double half_width, size_t& begin, size_t& end) const {
+    // Same comparisons as |t - t_n| < half_width, so edges match a linear scan
+    // exactly; both are monotone in t_n over the sorted schedule
+    auto expired = [t, half_width](const EchoEvent& echo) { return t - echo.time >= half_width; };
+    auto started = [t, half_width](const EchoEvent& echo) { return echo.time - t < half_width; };
+    const size_t n = echo_schedule_.size();
+
+    if (half_width != window_half_width_ || t < window_time_) {
+        auto first = std::partition_point(echo_schedule_.begin(), echo_schedule_.end(), expired);
+        auto last = std::partition_point(first, echo_schedule_.end(), started);
+        window_begin_ = static_cast<size_t>(first - echo_schedule_.begin());
+        window_end_ = static_cast<size_t>(last - echo_schedule_.begin());
+    } else {
+        while (window_begin_ < n && expired(echo_schedule_[window_begin_])) {
+            window_begin_++;
+        }
+        if (window_end_ < window_begin_) {
+            window_end_ = window_begin_;
+        }
+        while (window_end_ < n && started(echo_schedule_[window_end_])) {
+            window_end_++;
+        }
+    }
+
+    window_time_ = t;
+    window_half_width_ = half_width;
+    begin = window_begin_;
+    end = window_end_;
+}
+
 // ============================================================================
 // Echo Source Terms
 // ============================================================================
@@ -291,51 +329,147 @@ std::complex<double> EchoGenerator::computeEchoSource(
     const Vector3D& position,
     const Vector3D& source_center) const
 {
-    if (!merger_detected_ || echo_schedule_.empty()) {
-        return std::complex<double>(0.0, 0.0);
+    std::complex<double> signal = computeEchoSignal(t);
+    if (signal == std::complex<double>(0.0, 0.0)) {
+        return signal;
     }
 
-    // Get active echoes at time t
-    std::vector<EchoEvent> active = getActiveEchoes(t, 3.0);
+    // Spatial Gaussian around the source center
+    Vector3D r = position - source_center;
+    double distance_sq = r.x * r.x + r.y * r.y + r.z * r.z;
+    double sigma_sq = config_.echo_gaussian_width * config_.echo_gaussian_width;
+    double spatial_gaussian = std::exp(-distance_sq / (2.0 * sigma_sq));
+
+    return signal * spatial_gaussian;
+}
 
-    if (active.empty()) {
+std::complex<double> EchoGenerator::computeEchoSignal(double t) const {
+    if (!merger_detected_ || echo_schedule_.empty()) {
         return std::complex<double>(0.0, 0.0);
     }
+    if (signal_valid_ && t == cached_signal_time_) {
+        return cached_signal_;
+    }
 
-    // Compute distance from source center
-    Vector3D r = position - source_center;
-    double distance_sq = r.x * r.x + r.y * r.y + r.z * r.z;
-    double sigma_sq = config_.echo_gaussian_width * config_.echo_gaussian_width;
+    size_t begin = 0;
+    size_t end = 0;
+    findActiveRange(t, config_.fundamental_timescale * kActiveWindowSigma, begin, end);
+
+    double pulse_width = config_.fundamental_timescale * kPulseWidthFactor;
+    double inv_two_width_sq = 1.0 / (2.0 * pulse_width * pulse_width);
 
     // Sum contributions from all active echoes
-    std::complex<double> total_source(0.0, 0.0);
+    std::complex<double> total(0.0, 0.0);
+
+    for (size_t n = begin; n < end; n++) {
+        const EchoEvent& echo = echo_schedule_[n];
 
-    for (const auto& echo : active) {
         // Temporal Gaussian pulse
         double dt = t - echo.time;
-        double pulse_width = config_.fundamental_timescale * 2.0; // 2τ₀ width
-        double temporal_gaussian = std::exp(-(dt * dt) / (2.0 * pulse_width * pulse_width));
-
-        // Spatial Gaussian
-        double spatial_gaussian = std::exp(-distance_sq / (2.0 * sigma_sq));
+        double temporal_gaussian = std::exp(-(dt * dt) * inv_two_width_sq);
 
         // Phase based on frequency
         double phase = 2.0 * M_PI * echo.frequency * dt;
 
-        // Complex amplitude
-        double amplitude = echo.amplitude * temporal_gaussian * spatial_gaussian;
-        total_source += std::complex<double>(
-            amplitude * std::cos(phase),
-            amplitude * std::sin(phase)
-        );
+        double amplitude = echo.amplitude * temporal_gaussian;
+        total += std::complex<double>(amplitude * std::cos(phase), amplitude * std::sin(phase));
+    }
+
+    cached_signal_ = total;
+    cached_signal_time_ = t;
+    signal_valid_ = true;
+    return total;
+}
+
+void EchoGenerator::computeEchoEnvelope(double t0, double dt, size_t num_steps, double* envelope) const {
+    accumulatePulses("computeEchoEnvelope", t0, dt, num_steps, envelope, false);
+}
+
+void EchoGenerator::computeEchoWaveform(double t0, double dt, size_t num_steps, double* waveform) const {
+    accumulatePulses("computeEchoWaveform", t0, dt, num_steps, waveform, true);
+}
+
+double EchoGenerator::getEchoTrainEnd() const {
+    if (echo_schedule_.empty()) {
+        return config_.merger_time;
+    }
+    return echo_schedule_.back().time + config_.fundamental_timescale * kActiveWindowSigma;
+}
+
+void EchoGenerator::accumulatePulses(const char* caller, double t0, double dt, size_t num_steps,
+                                     double* out, bool carrier) const {
+    if (num_steps == 0) {
+        return;
+    }
+    if (out == nullptr) {
+        LOG_ERROR(std::string(caller) + ": output is null");
+        throw std::invalid_argument("output cannot be null");
+    }
+    if (!(dt > 0.0)) {
+        std::string error_msg = std::string(caller) + ": dt must be positive, got: " + std::to_string(dt);
+        LOG_ERROR(error_msg);
+        throw std::invalid_argument(error_msg);
     }
 
-    return total_source;
+    std::fill(out, out + num_steps, 0.0);
+    if (!merger_detected_ || echo_schedule_.empty()) {
+        return;
+    }
+
+    const double half_width = config_.fundamental_timescale * kActiveWindowSigma;
+    const double pulse_width = config_.fundamental_timescale * kPulseWidthFactor;
+    const double inv_two_width_sq = 1.0 / (2.0 * pulse_width * pulse_width);
+    const double t_last = t0 + static_cast<double>(num_steps - 1) * dt;
+
+    // Echoes whose active window overlaps [t0, t_last]
+    auto first = std::upper_bound(
+        echo_schedule_.begin(), echo_schedule_.end(), t0 - half_width,
+        [](double value, const EchoEvent& echo) { return value < echo.time; });
+    auto last = std::lower_bound(
+        first, echo_schedule_.end(), t_last + half_width,
+        [](const EchoEvent& echo, double value) { return echo.time < value; });
+
+    const double max_index = static_cast<double>(num_steps);
+    for (auto it = first; it != last; ++it) {
+        const double t_echo = it->time;
+        const double amplitude = it->amplitude;
+        const double omega = 2.0 * M_PI * it->frequency;
+
+        // Step range covering the window, padded by one; the mask below is exact
+        const double j_lo = std::max(0.0, std::floor((t_echo - half_width - t0) / dt) - 1.0);
+        const double j_hi = std::min(max_index, std::ceil((t_echo + half_width - t0) / dt) + 2.0);
+        const size_t begin = static_cast<size_t>(j_lo);
+        const size_t end = static_cast<size_t>(j_hi);
+
+        // Gaussian exponents (and carrier phases) of a chunk of steps, then batched exp / cos
+        constexpr size_t kChunk = 256;
+        double offsets[kChunk];
+        double pulses[kChunk];
+        double phases[kChunk];
+        double sines[kChunk];
+        double cosines[kChunk];
+        for (size_t chunk = begin; chunk < end; chunk += kChunk) {
+            const size_t count = std::min(kChunk, end - chunk);
+            for (size_t k = 0; k < count; k++) {
+                offsets[k] = (t0 + static_cast<double>(chunk + k) * dt) - t_echo;
+                pulses[k] = -(offsets[k] * offsets[k]) * inv_two_width_sq;
+            }
+            dase::expArray(pulses, pulses, count);
+            if (carrier) {
+                for (size_t k = 0; k < count; k++) phases[k] = omega * offsets[k];
+                dase::sinCosArray(phases, sines, cosines, count);
+                for (size_t k = 0; k < count; k++) pulses[k] *= cosines[k];
+            }
+            for (size_t k = 0; k < count; k++) {
+                out[chunk + k] += (std::abs(offsets[k]) < half_width) ? amplitude * pulses[k] : 0.0;
+            }
+        }
+    }
 }
 
 double EchoGenerator::getEchoAmplitude(const EchoEvent& echo, double t) const {
     double dt = t - echo.time;
-    double pulse_width = config_.fundamental_timescale * 2.0;
+    double pulse_width = config_.fundamental_timescale * kPulseWidthFactor;
     double temporal_gaussian = std::exp(-(dt * dt) / (2.0 * pulse_width * pulse_width));
 
     return echo.amplitude * temporal_gaussian;
@@ -378,31 +512,28 @@ bool EchoGenerator::detectMerger(const SymmetryField& field, double current_time
 // ============================================================================
 
 EchoEvent EchoGenerator::getNextEcho(double t) const {
-    for (const auto& echo : echo_schedule_) {
-        if (echo.time > t) {
-            return echo;
-        }
+    auto next = std::upper_bound(
+        echo_schedule_.begin(), echo_schedule_.end(), t,
+        [](double value, const EchoEvent& echo) { return value < echo.time; });
+    if (next != echo_schedule_.end()) {
+        return *next;
     }
     return EchoEvent(); // Empty event if none remaining
 }
 
 bool EchoGenerator::isEchoActive(double t) const {
-    return !getActiveEchoes(t, 3.0).empty();
+    size_t begin = 0;
+    size_t end = 0;
+    findActiveRange(t, config_.fundamental_timescale * kActiveWindowSigma, begin, end);
+    return begin < end;
 }
 
 std::vector<EchoEvent> EchoGenerator::getActiveEchoes(double t, double pulse_width_sigma) const {
-    std::vector<EchoEvent> active;
-
-    double pulse_width = config_.fundamental_timescale * pulse_width_sigma;
-
-    for (const auto& echo : echo_schedule_) {
-        double dt = std::abs(t - echo.time);
-        if (dt < pulse_width) {
-            active.push_back(echo);
-        }
-    }
+    size_t begin = 0;
+    size_t end = 0;
+    findActiveRange(t, config_.fundamental_timescale * pulse_width_sigma, begin, end);
 
-    return active;
+    return std::vector<EchoEvent>(echo_schedule_.begin() + begin, echo_schedule_.begin() + end);
 }
 
 // ============================================================================
@@ -522,10 +653,10 @@ void EchoGenerator::exportEchoSchedule(const std::string& filename) const {
 EchoGenerator::PrimeStats EchoGenerator::getPrimeStatistics() const {
     PrimeStats stats;
 
-    stats.num_primes = static_cast<int>(primes_.size());
-    stats.max_prime = primes_.empty() ? 0 : primes_.back();
+    stats.num_primes = static_cast<int>(num_primes_);
+    stats.max_prime = num_primes_ == 0 ? 0 : prime_table_->primes[num_primes_ - 1];
 
-    if (prime_gaps_.empty()) {
+    if (num_gaps_ == 0) {
         stats.mean_gap = 0.0;
         stats.max_gap = 0;
         stats.min_gap = 0;
@@ -534,16 +665,18 @@ EchoGenerator::PrimeStats EchoGenerator::getPrimeStatistics() const {
 
     // Compute statistics on gaps
     int sum = 0;
-    stats.max_gap = prime_gaps_[0];
-    stats.min_gap = prime_gaps_[0];
+    const std::vector<int>& gaps = prime_table_->gaps;
+    stats.max_gap = gaps[0];
+    stats.min_gap = gaps[0];
 
-    for (int gap : prime_gaps_) {
+    for (size_t n = 0; n < num_gaps_; n++) {
+        int gap = gaps[n];
         sum += gap;
         stats.max_gap = std::max(stats.max_gap, gap);
         stats.min_gap = std::min(stats.min_gap, gap);
     }
 
-    stats.mean_gap = static_cast<double>(sum) / prime_gaps_.size();
+    stats.mean_gap = static_cast<double>(sum) / num_gaps_;
 
     return stats;
 }
@@ -15,6 +15,8 @@
 #pragma once
 
 #include "symmetry_field.h"
+#include "prime_table.h"
+#include <cstddef>
 #include <vector>
 #include <complex>
 
@@ -100,6 +102,11 @@ struct EchoEvent {
  * This provides a clear observational signature distinguishing IGSOA from GR:
  * - GR: Exponential ringdown with smooth decay
  * - IGSOA: Discrete echoes with prime-gap timing structure
+ *
+ * The schedule is kept sorted by time. Active-echo queries walk a cursor
+ * window over it, so a simulation stepping forward in time pays amortized
+ * O(1) per query; stepping backward re-seeds the window by binary search.
+ * The cursor makes queries unsafe to call concurrently on one instance.
  */
 class EchoGenerator {
 public:
@@ -112,7 +119,7 @@ public:
     // === Prime Number Utilities ===
 
     /**
-     * Generate prime numbers up to max_value using Sieve of Eratosthenes
+     * Prime numbers up to max_value, read from the shared PrimeTable
      * @param max_value Maximum value to check for primality
      * @return Vector of prime numbers in ascending order
      */
@@ -120,6 +127,8 @@ public:
 
     /**
      * Compute gaps between consecutive primes: p_{n+1} - p_n
+     * A prefix of the prime sequence (as from generatePrimes) is served from
+     * the shared PrimeTable; any other list is differenced directly.
      * @param primes Vector of prime numbers (must be sorted)
      * @return Vector of gaps (size = primes.size() - 1)
      */
@@ -178,6 +187,52 @@ public:
         const Vector3D& position,
         const Vector3D& source_center) const;
 
+    /**
+     * Sum of the temporal parts of all active echoes at time t
+     *
+     * computeEchoSource() is this signal times the spatial Gaussian. The last
+     * evaluated time is cached, so sweeping a grid at fixed t costs one
+     * evaluation per step rather than one per grid point.
+     *
+     * @param t Current simulation time (s)
+     * @return Complex echo signal (0 before merger)
+     */
+    std::complex<double> computeEchoSignal(double t) const;
+
+    /**
+     * Summed echo envelope ∑ A_n exp(-(t-t_n)²/2σ²) for a block of timesteps
+     *
+     * Evaluates t_j = t0 + j·dt for j < num_steps in one pass per overlapping
+     * echo; each echo contributes only within its active window, as in
+     * computeEchoSource(). The inner loop is branch-free and vectorizes.
+     *
+     * @param t0 Time of the first step (s)
+     * @param dt Timestep (s), must be positive
+     * @param num_steps Number of steps to evaluate
+     * @param envelope Output array of num_steps values (0 before merger)
+     */
+    void computeEchoEnvelope(double t0, double dt, size_t num_steps, double* envelope) const;
+
+    /**
+     * Real echo waveform Re ∑ A_n exp(-(t-t_n)²/2σ²) e^{i2πf_n(t-t_n)}
+     * (the real part of computeEchoSignal()) for a block of timesteps
+     *
+     * Same stepping and windows as computeEchoEnvelope(); used as the
+     * matched-filter template of a schedule.
+     *
+     * @param t0 Time of the first step (s)
+     * @param dt Timestep (s), must be positive
+     * @param num_steps Number of steps to evaluate
+     * @param waveform Output array of num_steps values (0 before merger)
+     */
+    void computeEchoWaveform(double t0, double dt, size_t num_steps, double* waveform) const;
+
+    /**
+     * Time after which no echo is active (end of the last echo's window;
+     * the merger time if the schedule is empty)
+     */
+    double getEchoTrainEnd() const;
+
     /**
      * Get amplitude of specific echo at given time
      * Returns Gaussian pulse: A exp(-((t-t_echo)/σ)²)
@@ -274,17 +329,49 @@ public:
 
 private:
     EchoConfig config_;                   // Configuration
-    std::vector<int> primes_;             // Prime numbers
-    std::vector<int> prime_gaps_;         // Gaps between primes
+    PrimeTable::Snapshot prime_table_;    // Shared primes and gaps
+    size_t num_primes_ = 0;               // Primes <= max_prime_value
+    size_t num_gaps_ = 0;                 // Gaps between those primes
     std::vector<EchoEvent> echo_schedule_; // Scheduled echo events
     bool merger_detected_;                // Whether merger has occurred
     double last_field_energy_;            // For merger detection
 
+    // Active-echo cursor: [window_begin_, window_end_) for the last query
+    mutable size_t window_begin_ = 0;
+    mutable size_t window_end_ = 0;
+    mutable double window_time_ = 0.0;
+    mutable double window_half_width_ = -1.0;  // < 0: window must be re-seeded
+
+    // computeEchoSignal() result for the last queried time
+    mutable std::complex<double> cached_signal_;
+    mutable double cached_signal_time_ = 0.0;
+    mutable bool signal_valid_ = false;
+
     /**
      * Initialize: generate primes and compute gaps
      */
     void initialize();
 
+    /**
+     * Sort the schedule by time and invalidate the cursor and signal cache
+     */
+    void resetSchedule(std::vector<EchoEvent> schedule);
+
+    /**
+     * Index range of echoes with |t - t_n| < half_width
+     *
+     * Advances the cursor for non-decreasing t at a fixed width; otherwise
+     * re-seeds it by binary search.
+     */
+    void findActiveRange(double t, double half_width, size_t& begin, size_t& end) const;
+
+    /**
+     * Sum every echo's windowed pulse (times its carrier if carrier) over
+     * t0 + j·dt into out; caller names the public entry point in errors
+     */
+    void accumulatePulses(const char* caller, double t0, double dt, size_t num_steps,
+                          double* out, bool carrier) const;
+
     /**
      * Validate configuration parameters
      * Throws std::invalid_argument if any parameter is invalid
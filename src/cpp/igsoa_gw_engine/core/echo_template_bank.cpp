@@ -0,0 +1,193 @@
+/**
+ * IGSOA GW Engine - Echo Template Bank Implementation
+ */
+
+#include "echo_template_bank.h"
+#include "utils/logger.h"
+#include "../../real_fft_plan_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+namespace {
+
+std::vector<double> axisOrBase(const std::vector<double>& axis, double base) {
+    return axis.empty() ? std::vector<double>{base} : axis;
+}
+
+} // namespace
+
+EchoTemplateBank::EchoTemplateBank(const EchoTemplateGrid& grid, double dt, size_t max_signal_samples)
+    : dt_(dt)
+    , max_signal_samples_(max_signal_samples)
+{
+    if (!(dt > 0.0)) {
+        throw std::invalid_argument("EchoTemplateBank: dt must be positive");
+    }
+    if (max_signal_samples == 0) {
+        throw std::invalid_argument("EchoTemplateBank: max_signal_samples must be positive");
+    }
+
+    const std::vector<double> timescales = axisOrBase(grid.fundamental_timescales, grid.base.fundamental_timescale);
+    const std::vector<double> decays = axisOrBase(grid.amplitude_decays, grid.base.echo_amplitude_decay);
+    const std::vector<double> shifts = axisOrBase(grid.frequency_shifts, grid.base.echo_frequency_shift);
+
+    // τ₀ slowest, frequency shift fastest
+    for (double timescale : timescales) {
+        for (double decay : decays) {
+            for (double shift : shifts) {
+                EchoConfig config = grid.base;
+                config.merger_time = 0.0;
+                config.auto_detect_merger = false;
+                config.fundamental_timescale = timescale;
+                config.echo_amplitude_decay = decay;
+                config.echo_frequency_shift = shift;
+                configs_.push_back(config);
+            }
+        }
+    }
+    const size_t count = configs_.size();
+
+    // Waveforms first (lengths set the FFT size); generators validate their configs
+    std::vector<std::vector<double>> waveforms(count);
+    lengths_.resize(count);
+    norms_.resize(count);
+    size_t longest = 0;
+    for (size_t k = 0; k < count; k++) {
+        EchoGenerator generator(configs_[k]);
+        generator.setMergerTime(0.0);
+        const size_t length = static_cast<size_t>(std::ceil(generator.getEchoTrainEnd() / dt)) + 1;
+        waveforms[k].resize(length);
+        generator.computeEchoWaveform(0.0, dt, length, waveforms[k].data());
+
+        double energy = 0.0;
+        for (double v : waveforms[k]) energy += v * v;
+        if (!(energy > 0.0)) {
+            throw std::invalid_argument("EchoTemplateBank: template " + std::to_string(k) + " is silent");
+        }
+        lengths_[k] = length;
+        norms_[k] = std::sqrt(energy);
+        longest = std::max(longest, length);
+    }
+
+    fft_size_ = 1;
+    while (fft_size_ < max_signal_samples_ + longest - 1) fft_size_ <<= 1;
+    bins_ = fft_size_ / 2 + 1;
+
+    // conj(FFT(h / ||h||)) / N, so the c2r of X·S is the normalized correlation
+    const RealFFTPlanCache::Plans plans = RealFFTPlanCache::instance().get(static_cast<int>(fft_size_));
+    spectra_.resize(count * bins_);
+    const double scale_n = 1.0 / static_cast<double>(fft_size_);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long k = 0; k < static_cast<long>(count); k++) {
+        RealFFTScratch& scratch = RealFFTScratch::local(fft_size_);
+        const std::vector<double>& h = waveforms[k];
+        const double inv_norm = 1.0 / norms_[k];
+        for (size_t j = 0; j < h.size(); j++) scratch.real[j] = h[j] * inv_norm;
+        std::fill(scratch.real + h.size(), scratch.real + fft_size_, 0.0);
+        fftw_execute_dft_r2c(plans.forward, scratch.real, scratch.spectrum);
+        std::complex<double>* S = spectra_.data() + static_cast<size_t>(k) * bins_;
+        for (size_t b = 0; b < bins_; b++) {
+            S[b] = std::complex<double>(scratch.spectrum[b][0], -scratch.spectrum[b][1]) * scale_n;
+        }
+    }
+
+    LOG_INFO("EchoTemplateBank: " + std::to_string(count) + " templates, longest " +
+             std::to_string(longest) + " samples, FFT size " + std::to_string(fft_size_));
+}
+
+double EchoTemplateBank::estimateNoiseSigma(const double* waveform, size_t num_samples) {
+    if (num_samples == 0) return 0.0;
+    std::vector<double> values(waveform, waveform + num_samples);
+    const size_t mid = num_samples / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    const double median = values[mid];
+    for (double& v : values) v = std::abs(v - median);
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    return 1.4826 * values[mid];
+}
+
+std::vector<EchoMatch> EchoTemplateBank::search(const double* waveform, size_t num_samples, double t0,
+                                                size_t top_k, double noise_sigma) const {
+    if (!waveform || num_samples == 0) {
+        throw std::invalid_argument("EchoTemplateBank::search: empty waveform");
+    }
+    if (num_samples > max_signal_samples_) {
+        throw std::invalid_argument("EchoTemplateBank::search: waveform has " + std::to_string(num_samples) +
+                                    " samples, the bank was built for " + std::to_string(max_signal_samples_));
+    }
+    if (noise_sigma <= 0.0) {
+        noise_sigma = estimateNoiseSigma(waveform, num_samples);
+    }
+    if (!(noise_sigma > 0.0)) {
+        throw std::invalid_argument("EchoTemplateBank::search: noise level is zero (pass noise_sigma)");
+    }
+
+    const RealFFTPlanCache::Plans plans = RealFFTPlanCache::instance().get(static_cast<int>(fft_size_));
+
+    // X = FFT(x zero-padded to N)
+    std::vector<std::complex<double>> X(bins_);
+    {
+        RealFFTScratch& scratch = RealFFTScratch::local(fft_size_);
+        std::memcpy(scratch.real, waveform, num_samples * sizeof(double));
+        std::fill(scratch.real + num_samples, scratch.real + fft_size_, 0.0);
+        fftw_execute_dft_r2c(plans.forward, scratch.real, scratch.spectrum);
+        for (size_t b = 0; b < bins_; b++) X[b] = {scratch.spectrum[b][0], scratch.spectrum[b][1]};
+    }
+
+    // Peak of each template's correlation over lags 0..n-1 (no wrap: N >= n + L - 1)
+    const size_t count = configs_.size();
+    std::vector<size_t> best_lag(count, 0);
+    std::vector<double> best_value(count, 0.0);
+    #pragma omp parallel for schedule(dynamic, 4)
+    for (long k = 0; k < static_cast<long>(count); k++) {
+        RealFFTScratch& scratch = RealFFTScratch::local(fft_size_);
+        const std::complex<double>* S = spectra_.data() + static_cast<size_t>(k) * bins_;
+        for (size_t b = 0; b < bins_; b++) {
+            const std::complex<double> product = X[b] * S[b];
+            scratch.spectrum[b][0] = product.real();
+            scratch.spectrum[b][1] = product.imag();
+        }
+        fftw_execute_dft_c2r(plans.inverse, scratch.spectrum, scratch.real);
+        size_t lag = 0;
+        double value = scratch.real[0];
+        for (size_t j = 1; j < num_samples; j++) {
+            if (std::abs(scratch.real[j]) > std::abs(value)) {
+                value = scratch.real[j];
+                lag = j;
+            }
+        }
+        best_lag[k] = lag;
+        best_value[k] = value;
+    }
+
+    std::vector<size_t> order(count);
+    for (size_t k = 0; k < count; k++) order[k] = k;
+    const size_t keep = std::min(top_k, count);
+    std::partial_sort(order.begin(), order.begin() + keep, order.end(), [&](size_t a, size_t b) {
+        const double va = std::abs(best_value[a]), vb = std::abs(best_value[b]);
+        return va != vb ? va > vb : a < b;
+    });
+
+    std::vector<EchoMatch> matches(keep);
+    for (size_t i = 0; i < keep; i++) {
+        const size_t k = order[i];
+        EchoMatch& match = matches[i];
+        match.template_index = k;
+        match.merger_time = t0 + static_cast<double>(best_lag[k]) * dt_;
+        match.config = configs_[k];
+        match.config.merger_time = match.merger_time;
+        match.snr = best_value[k] / noise_sigma;
+        match.amplitude_scale = best_value[k] / norms_[k];
+    }
+    return matches;
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
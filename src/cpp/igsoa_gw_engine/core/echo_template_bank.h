@@ -0,0 +1,108 @@
+/**
+ * IGSOA GW Engine - Echo Template Bank
+ *
+ * Matched-filter search for prime-gap echo trains. The bank holds one
+ * template per point of a parameter grid (τ₀ × amplitude decay × frequency
+ * shift): the real echo waveform of that EchoGenerator schedule with the
+ * merger at t = 0, sampled at the data's dt and scaled to unit norm. The
+ * merger time is not gridded: it is the lag of the correlation peak.
+ *
+ * Correlating a waveform x of n samples against a template h of L samples
+ * at every lag costs O(n·L) in the time domain. The bank instead keeps the
+ * templates' spectra conj(H) at one FFT size N >= n + L_max - 1 and
+ * correlates by c = IFFT(X · conj(H)): one forward transform of x per
+ * search plus one real inverse transform per template, O(N log N) each.
+ * Templates are correlated in parallel (OpenMP); plans come from
+ * RealFFTPlanCache (FFTWWisdomCache wisdom) and the product buffers from the
+ * per-thread RealFFTScratch.
+ *
+ * For white noise of standard deviation σ, the SNR of template k at lag τ
+ * is c_k(τ) / σ. Each template reports its peak |SNR| over the lags that
+ * put the merger inside the waveform; search() returns the strongest
+ * templates. The result does not depend on the thread count.
+ *
+ * Memory: templates × (N/2 + 1) complex values of spectra.
+ */
+
+#pragma once
+
+#include "echo_generator.h"
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+/**
+ * Template parameter grid (empty axes use the base value)
+ */
+struct EchoTemplateGrid {
+    EchoConfig base;                              // Other fields (merger_time is ignored)
+    std::vector<double> fundamental_timescales;   // τ₀ (s)
+    std::vector<double> amplitude_decays;         // echo_amplitude_decay
+    std::vector<double> frequency_shifts;         // echo_frequency_shift (Hz)
+};
+
+/**
+ * Best lag of one template
+ */
+struct EchoMatch {
+    size_t template_index = 0;
+    EchoConfig config;              // Template parameters with merger_time = the match's
+    double merger_time = 0.0;       // t0 + lag·dt (s)
+    double snr = 0.0;               // Signed: negative for an inverted echo train
+    double amplitude_scale = 0.0;   // Best-fit x ≈ scale × template waveform (at config's amplitudes)
+};
+
+class EchoTemplateBank {
+public:
+    /**
+     * Generate every grid template at sample interval dt for waveforms of
+     * up to max_signal_samples samples
+     *
+     * @throws std::invalid_argument for dt <= 0, max_signal_samples == 0,
+     *         an empty grid, a silent template or an invalid grid EchoConfig
+     */
+    EchoTemplateBank(const EchoTemplateGrid& grid, double dt, size_t max_signal_samples);
+
+    size_t size() const { return configs_.size(); }
+    double sampleInterval() const { return dt_; }
+    size_t maxSignalSamples() const { return max_signal_samples_; }
+    size_t fftSize() const { return fft_size_; }
+
+    const EchoConfig& templateConfig(size_t k) const { return configs_[k]; }
+    size_t templateLength(size_t k) const { return lengths_[k]; }
+
+    /**
+     * Correlate waveform (num_samples <= maxSignalSamples(), sample j at
+     * t0 + j·dt) against every template
+     *
+     * @param noise_sigma Per-sample noise standard deviation; <= 0 estimates
+     *        it from the waveform (1.4826 × median absolute deviation)
+     * @param top_k Number of matches to return
+     * @return Up to top_k matches, largest |snr| first (ties: lower index)
+     */
+    std::vector<EchoMatch> search(const double* waveform, size_t num_samples, double t0,
+                                  size_t top_k = 1, double noise_sigma = 0.0) const;
+
+    /**
+     * Robust noise level of a waveform (1.4826 × median absolute deviation)
+     */
+    static double estimateNoiseSigma(const double* waveform, size_t num_samples);
+
+private:
+    double dt_;
+    size_t max_signal_samples_;
+    size_t fft_size_ = 0;
+    size_t bins_ = 0;
+    std::vector<EchoConfig> configs_;
+    std::vector<size_t> lengths_;
+    std::vector<double> norms_;                          // ||template waveform|| before scaling
+    std::vector<std::complex<double>> spectra_;          // templates × bins, conj(FFT(h / ||h||)) / N
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
@@ -3,7 +3,10 @@
  */
 
 #include "fractional_solver.h"
+#include "soe_kernel_store.h"
 #include "utils/logger.h"
+#include "checkpoint_file.h"
+#include "out_of_core.h"
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
@@ -12,6 +15,13 @@ namespace dase {
 namespace igsoa {
 namespace gw {
 
+namespace {
+
+// Points per work block: a block's ∂²_t δΦ stays in L1 across all ranks
+constexpr int kPointBlock = 1024;
+
+} // namespace
+
 // ============================================================================
 // SOEKernel Implementation
 // ============================================================================
@@ -122,6 +132,7 @@ FractionalSolverConfig::FractionalSolverConfig()
     , dt(0.001)            // 1 ms timestep
     , alpha_min(1.0)       // Maximum memory
     , alpha_max(2.0)       // No memory
+    , alpha_resolution(1e-3)
 {
 }
 
@@ -132,7 +143,13 @@ FractionalSolverConfig::FractionalSolverConfig()
 FractionalSolver::FractionalSolver(const FractionalSolverConfig& config, int num_points)
     : config_(config)
     , num_points_(num_points)
+    , step_dt_(0.0)
 {
+    if (!(config.alpha_resolution > 0.0) || config.alpha_max < config.alpha_min ||
+        (config.alpha_max - config.alpha_min) / config.alpha_resolution >= 65535.5) {
+        throw std::invalid_argument("FractionalSolver: alpha_resolution must give 1-65536 levels over [alpha_min, alpha_max]");
+    }
+
     // Calculate memory requirements
     size_t history_size_per_point = config.soe_rank * sizeof(std::complex<double>);
     size_t total_history_mb = (num_points * history_size_per_point) / (1024 * 1024);
@@ -142,8 +159,19 @@ FractionalSolver::FractionalSolver(const FractionalSolverConfig& config, int num
               std::to_string(config.soe_rank) + ")");
 
     try {
-        // Allocate history states for each grid point
-        history_states_.resize(num_points, HistoryState(config.soe_rank));
+        // Allocate rank-major history states for all grid points (spill
+        // files above the memory budget)
+        const size_t history_size = static_cast<size_t>(num_points) * config.soe_rank;
+        const OutOfCorePolicy policy = getOutOfCorePolicy();
+        out_of_core_ = exceedsMemoryBudget(2 * history_size * sizeof(double), policy);
+        if (out_of_core_) {
+            ScopedFileBacking backing(spillDirectory(policy));
+            history_re_.assign(history_size, 0.0);
+            history_im_.assign(history_size, 0.0);
+        } else {
+            history_re_.assign(history_size, 0.0);
+            history_im_.assign(history_size, 0.0);
+        }
 
         LOG_INFO("FractionalSolver created: " + std::to_string(num_points) +
                  " points, SOE rank " + std::to_string(config.soe_rank) +
@@ -165,32 +193,117 @@ FractionalSolver::~FractionalSolver() {
 }
 
 const SOEKernel& FractionalSolver::getKernel(double alpha) {
-    // TODO: Implement kernel cache lookup/creation
     int idx = findKernelIndex(alpha);
     if (idx >= 0) {
-        return cached_kernels_[idx];
+        return *cached_kernels_[idx];
     }
 
-    // Create new kernel
-    SOEKernel kernel;
-    kernel.initialize(alpha, config_.T_max, config_.soe_rank);
-
+    // Fitted once per process and shared with every other solver
     cached_alphas_.push_back(alpha);
-    cached_kernels_.push_back(kernel);
+    cached_kernels_.push_back(SOEKernelStore::global().acquire(alpha, config_.T_max, config_.soe_rank));
+
+    return *cached_kernels_.back();
+}
+
+int FractionalSolver::resolveKernelIndex(double alpha) {
+    int idx = findKernelIndex(alpha);
+    if (idx < 0) {
+        getKernel(alpha);
+        idx = static_cast<int>(cached_kernels_.size()) - 1;
+    }
+    return idx;
+}
+
+double FractionalSolver::quantizeAlpha(double alpha) const {
+    const double clamped = std::min(std::max(alpha, config_.alpha_min), config_.alpha_max);
+    const double level = std::round((clamped - config_.alpha_min) / config_.alpha_resolution);
+    return std::min(config_.alpha_min + level * config_.alpha_resolution, config_.alpha_max);
+}
+
+void FractionalSolver::setAlphaField(const std::vector<double>& alpha_values) {
+    if (static_cast<int>(alpha_values.size()) != num_points_) {
+        throw std::invalid_argument("FractionalSolver: alpha field size does not match grid");
+    }
+
+    point_alphas_ = alpha_values;
+    point_groups_.resize(num_points_);
+    group_kernels_.clear();
+    runs_.clear();
+    block_runs_.assign(1, 0);
+    step_decay_.clear();
+    step_gain_.clear();
+
+    // Quantized level → group; levels are bounded by the constructor check
+    std::vector<int> level_group;
+    int last_level = -1;
+    int group = -1;
+    for (int i = 0; i < num_points_; i++) {
+        const double alpha = quantizeAlpha(alpha_values[i]);
+        const int level = static_cast<int>(std::lround((alpha - config_.alpha_min) / config_.alpha_resolution));
+
+        if (level != last_level) {
+            if (level >= static_cast<int>(level_group.size())) {
+                level_group.resize(level + 1, -1);
+            }
+            if (level_group[level] < 0) {
+                level_group[level] = static_cast<int>(group_kernels_.size());
+                group_kernels_.push_back(resolveKernelIndex(alpha));
+            }
+            group = level_group[level];
+            last_level = level;
+        }
+        point_groups_[i] = static_cast<uint16_t>(group);
+
+        // Runs break on a group change and at every work-block boundary
+        const bool block_start = (i % kPointBlock) == 0;
+        if (block_start && i > 0) {
+            block_runs_.push_back(static_cast<int>(runs_.size()));
+        }
+        if (runs_.empty() || block_start || runs_.back().group != group) {
+            runs_.push_back(KernelRun{i, i + 1, group});
+        } else {
+            runs_.back().end = i + 1;
+        }
+    }
+    block_runs_.push_back(static_cast<int>(runs_.size()));
+}
 
-    return cached_kernels_.back();
+void FractionalSolver::prepareStepCoefficients(double dt) {
+    const int rank = config_.soe_rank;
+    const size_t size = group_kernels_.size() * rank;
+    if (dt == step_dt_ && step_decay_.size() == size) {
+        return;
+    }
+
+    step_decay_.resize(size);
+    step_gain_.resize(size);
+    for (size_t g = 0; g < group_kernels_.size(); g++) {
+        const SOEKernel& kernel = *cached_kernels_[group_kernels_[g]];
+        for (int r = 0; r < rank; r++) {
+            step_decay_[g * rank + r] = std::exp(-kernel.exponents[r] * dt);
+            step_gain_[g * rank + r] = kernel.weights[r] * dt;
+        }
+    }
+    step_dt_ = dt;
 }
 
 void FractionalSolver::precomputeKernels(int num_alpha_samples) {
-    // TODO: Precompute kernels for α ∈ [alpha_min, alpha_max]
     cached_alphas_.clear();
     cached_kernels_.clear();
+    step_decay_.clear();
+    step_gain_.clear();
 
     for (int i = 0; i < num_alpha_samples; i++) {
         double alpha = config_.alpha_min
                      + (config_.alpha_max - config_.alpha_min) * i / (num_alpha_samples - 1);
         getKernel(alpha);
     }
+
+    // Kernel indices refer to the old cache
+    if (!point_alphas_.empty()) {
+        const std::vector<double> alphas = point_alphas_;
+        setAlphaField(alphas);
+    }
 }
 
 void FractionalSolver::updateHistory(
@@ -199,10 +312,49 @@ void FractionalSolver::updateHistory(
     const std::vector<double>& alpha_values,
     double dt)
 {
-    // TODO: Update all history states
-    for (int i = 0; i < num_points_; i++) {
-        const SOEKernel& kernel = getKernel(alpha_values[i]);
-        history_states_[i].update(kernel, field_second_time_derivatives[i], dt);
+    if (alpha_values != point_alphas_) {
+        setAlphaField(alpha_values);
+    }
+    updateHistory(field_second_time_derivatives, dt);
+}
+
+void FractionalSolver::updateHistory(
+    const std::vector<std::complex<double>>& field_second_time_derivatives,
+    double dt)
+{
+    if (point_groups_.empty()) {
+        throw std::runtime_error("FractionalSolver: setAlphaField() must be called before updateHistory()");
+    }
+    prepareStepCoefficients(dt);
+
+    const int rank = config_.soe_rank;
+    const size_t N = static_cast<size_t>(num_points_);
+    const int num_blocks = static_cast<int>(block_runs_.size()) - 1;
+    const double* source = reinterpret_cast<const double*>(field_second_time_derivatives.data());
+    const double* decay = step_decay_.data();
+    const double* gain = step_gain_.data();
+    double* z_re = history_re_.data();
+    double* z_im = history_im_.data();
+
+    // zᵣ(t+dt) = exp(-sᵣ dt) zᵣ(t) + wᵣ ∂²_t f(t) dt
+    #pragma omp parallel for schedule(static)
+    for (int block = 0; block < num_blocks; block++) {
+        for (int r = 0; r < rank; r++) {
+            double* re = z_re + r * N;
+            double* im = z_im + r * N;
+
+            for (int run = block_runs_[block]; run < block_runs_[block + 1]; run++) {
+                const KernelRun& span = runs_[run];
+                const double a = decay[span.group * rank + r];
+                const double g = gain[span.group * rank + r];
+
+                #pragma omp simd
+                for (int i = span.begin; i < span.end; i++) {
+                    re[i] = a * re[i] + g * source[2 * i];
+                    im[i] = a * im[i] + g * source[2 * i + 1];
+                }
+            }
+        }
     }
 }
 
@@ -210,13 +362,37 @@ std::vector<std::complex<double>> FractionalSolver::computeDerivatives(
     const std::vector<double>& alpha_values) const
 {
     std::vector<std::complex<double>> derivatives(num_points_);
+    computeDerivatives(derivatives);
+    return derivatives;
+}
 
-    // TODO: Compute for all points
-    for (int i = 0; i < num_points_; i++) {
-        derivatives[i] = history_states_[i].computeDerivative();
+void FractionalSolver::computeDerivatives(std::vector<std::complex<double>>& derivatives) const
+{
+    derivatives.assign(num_points_, std::complex<double>(0.0, 0.0));
+
+    // ₀D^α_t f ≈ Σᵣ zᵣ, accumulated rank by rank over blocks of points
+    const int rank = config_.soe_rank;
+    const size_t N = static_cast<size_t>(num_points_);
+    const int num_blocks = (num_points_ + kPointBlock - 1) / kPointBlock;
+    double* out = reinterpret_cast<double*>(derivatives.data());
+    const double* z_re = history_re_.data();
+    const double* z_im = history_im_.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int block = 0; block < num_blocks; block++) {
+        const int begin = block * kPointBlock;
+        const int end = std::min(begin + kPointBlock, num_points_);
+        for (int r = 0; r < rank; r++) {
+            const double* re = z_re + r * N;
+            const double* im = z_im + r * N;
+
+            #pragma omp simd
+            for (int i = begin; i < end; i++) {
+                out[2 * i] += re[i];
+                out[2 * i + 1] += im[i];
+            }
+        }
     }
-
-    return derivatives;
 }
 
 std::complex<double> FractionalSolver::computeDerivativeAt(int point_index, double alpha) const {
@@ -224,22 +400,108 @@ std::complex<double> FractionalSolver::computeDerivativeAt(int point_index, doub
         throw std::out_of_range("Point index out of bounds");
     }
 
-    return history_states_[point_index].computeDerivative();
+    std::complex<double> sum(0.0, 0.0);
+    for (int r = 0; r < config_.soe_rank; r++) {
+        const size_t idx = static_cast<size_t>(r) * num_points_ + point_index;
+        sum += std::complex<double>(history_re_[idx], history_im_[idx]);
+    }
+    return sum;
 }
 
 int FractionalSolver::getNumCachedKernels() const {
     return cached_kernels_.size();
 }
 
+int FractionalSolver::getKernelIndexAt(int point_index) const {
+    if (point_index < 0 || point_index >= num_points_) {
+        throw std::out_of_range("Point index out of bounds");
+    }
+    return point_groups_.empty() ? -1 : group_kernels_[point_groups_[point_index]];
+}
+
 void FractionalSolver::resetHistory() {
-    for (auto& state : history_states_) {
-        state.reset();
+    std::fill(history_re_.begin(), history_re_.end(), 0.0);
+    std::fill(history_im_.begin(), history_im_.end(), 0.0);
+}
+
+std::complex<double> FractionalSolver::getHistoryState(int point_index, int r) const {
+    if (point_index < 0 || point_index >= num_points_ || r < 0 || r >= config_.soe_rank) {
+        throw std::out_of_range("History index out of bounds");
+    }
+    const size_t idx = static_cast<size_t>(r) * num_points_ + point_index;
+    return std::complex<double>(history_re_[idx], history_im_[idx]);
+}
+
+void FractionalSolver::setHistoryFrom(int dst_point, const FractionalSolver& source,
+                                      const int* src_points, const double* weights, int count) {
+    if (source.config_.soe_rank != config_.soe_rank || source.config_.T_max != config_.T_max) {
+        throw std::invalid_argument("setHistoryFrom: SOE rank and T_max must match");
+    }
+    if (dst_point < 0 || dst_point >= num_points_) {
+        throw std::out_of_range("Point index out of bounds");
+    }
+    for (int n = 0; n < count; n++) {
+        if (src_points[n] < 0 || src_points[n] >= source.num_points_) {
+            throw std::out_of_range("Source point index out of bounds");
+        }
+    }
+
+    const size_t dst_stride = static_cast<size_t>(num_points_);
+    const size_t src_stride = static_cast<size_t>(source.num_points_);
+    for (int r = 0; r < config_.soe_rank; r++) {
+        double re = 0.0, im = 0.0;
+        for (int n = 0; n < count; n++) {
+            const size_t idx = r * src_stride + src_points[n];
+            re += weights[n] * source.history_re_[idx];
+            im += weights[n] * source.history_im_[idx];
+        }
+        history_re_[r * dst_stride + dst_point] = re;
+        history_im_[r * dst_stride + dst_point] = im;
+    }
+}
+
+void FractionalSolver::saveCheckpoint(CheckpointWriter& writer) const {
+    const std::vector<uint64_t> dims = {uint64_t(num_points_), uint64_t(config_.soe_rank)};
+    writer.setEngineType("igsoa_gw");
+    writer.copyArray("fractional.dims", dims.data(), dims.size());
+    writer.addScalar("fractional.T_max", config_.T_max);
+    writer.addArray("fractional.history_re", history_re_.data(), history_re_.size());
+    writer.addArray("fractional.history_im", history_im_.data(), history_im_.size());
+    if (!point_alphas_.empty()) {
+        writer.addArray("fractional.alpha", point_alphas_.data(), point_alphas_.size());
+    }
+}
+
+bool FractionalSolver::loadCheckpoint(const CheckpointReader& reader, std::string* error) {
+    const std::vector<uint64_t> dims = {uint64_t(num_points_), uint64_t(config_.soe_rank)};
+    if (!checkCheckpointShape(reader, "igsoa_gw", dims, error, "fractional.dims")) {
+        return false;
+    }
+    double T_max = 0.0;
+    if (!reader.scalar("fractional.T_max", T_max) || T_max != config_.T_max) {
+        if (error) *error = "Checkpoint SOE history was built for a different T_max";
+        return false;
+    }
+    if (!reader.array<double>("fractional.history_re", history_re_.size()) ||
+        !reader.array<double>("fractional.history_im", history_im_.size())) {
+        if (error) *error = "Checkpoint is missing fractional solver history";
+        return false;
+    }
+
+    if (const double* alpha = reader.array<double>("fractional.alpha", num_points_)) {
+        setAlphaField(std::vector<double>(alpha, alpha + num_points_));
     }
+    reader.copyTo("fractional.history_re", history_re_.data(), history_re_.size());
+    reader.copyTo("fractional.history_im", history_im_.data(), history_im_.size());
+    return true;
 }
 
 size_t FractionalSolver::getMemoryUsage() const {
-    // Estimate: num_points * soe_rank * sizeof(complex<double>)
-    return num_points_ * config_.soe_rank * sizeof(std::complex<double>);
+    // History (num_points * soe_rank complex states) plus the per-point α field and kernel groups
+    return num_points_ * config_.soe_rank * sizeof(std::complex<double>)
+         + point_alphas_.capacity() * sizeof(double)
+         + point_groups_.capacity() * sizeof(uint16_t)
+         + runs_.capacity() * sizeof(KernelRun);
 }
 
 double FractionalSolver::computeExactCaputo(double alpha, double beta, double t) const {
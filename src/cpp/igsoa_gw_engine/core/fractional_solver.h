@@ -18,11 +18,18 @@
 
 #pragma once
 
+#include "aligned_allocator.h"
 #include <vector>
 #include <complex>
+#include <cstdint>
 #include <memory>
+#include <string>
 
 namespace dase {
+
+class CheckpointWriter;  // checkpoint_file.h
+class CheckpointReader;
+
 namespace igsoa {
 namespace gw {
 
@@ -66,6 +73,7 @@ struct SOEKernel {
  *
  * Stores internal states zᵣ(t) for each SOE term, enabling
  * recursive update without storing full history.
+ * (Single-point form; FractionalSolver keeps all points rank-major.)
  */
 struct HistoryState {
     std::vector<std::complex<double>> z_states;  // Internal states zᵣ
@@ -103,6 +111,10 @@ struct FractionalSolverConfig {
     double alpha_min;       // Minimum α (maximum memory)
     double alpha_max;       // Maximum α (minimum memory)
 
+    // α(x) is snapped to alpha_min + k·alpha_resolution when kernels are
+    // assigned to grid points (at most 65536 levels over the range)
+    double alpha_resolution;
+
     FractionalSolverConfig();
 };
 
@@ -111,6 +123,11 @@ struct FractionalSolverConfig {
  *
  * Computes Caputo fractional derivatives ₀D^α_t for all grid points,
  * using SOE optimization for efficiency.
+ *
+ * When the history (rank complex states per point) exceeds the
+ * OutOfCorePolicy memory budget (out_of_core.h), it is allocated in spill
+ * files and paged by the kernel. The update and the derivative sum walk
+ * each rank's strip in point order, block by block.
  */
 class FractionalSolver {
 public:
@@ -134,7 +151,9 @@ public:
 
     /**
      * Get or create SOE kernel for given α
-     * (Kernels are cached for efficiency)
+     * (Kernels are fitted once per (α, T_max, rank) in SOEKernelStore and
+     * shared by every solver; the reference stays valid for the solver's
+     * lifetime, or until precomputeKernels())
      */
     const SOEKernel& getKernel(double alpha);
 
@@ -145,9 +164,44 @@ public:
 
     // === Fractional Derivative Computation ===
 
+    /**
+     * Quantize α to the kernel grid: clamp to [alpha_min, alpha_max] and
+     * snap to the nearest alpha_min + k·alpha_resolution
+     */
+    double quantizeAlpha(double alpha) const;
+
+    /**
+     * Resolve the SOE kernel of every grid point from the α field
+     *
+     * Call whenever α(x) changes. Each point stores a uint16 kernel-group
+     * index (one group per quantized α level in use), and points are split
+     * into contiguous runs sharing a group, so the per-step updates neither
+     * search the kernel cache nor re-read α.
+     *
+     * @param alpha_values Fractional order α(x) at each grid point
+     */
+    void setAlphaField(const std::vector<double>& alpha_values);
+
+    /**
+     * Update history states for all grid points using the α field from setAlphaField()
+     *
+     * zᵣ(x) ← exp(-sᵣ dt) zᵣ(x) + wᵣ dt ∂²_t δΦ(x); threaded over blocks
+     * of points, each run of a block updated with its group's broadcast
+     * coefficients and vectorized across points.
+     *
+     * @param field_second_time_derivatives ∂²_t δΦ(x,t)
+     * @param dt Timestep
+     */
+    void updateHistory(
+        const std::vector<std::complex<double>>& field_second_time_derivatives,
+        double dt
+    );
+
     /**
      * Update history states for all grid points
      *
+     * Re-resolves kernels only if alpha_values differs from the current α field.
+     *
      * @param field_values Current field values δΦ(x,t)
      * @param field_second_time_derivatives ∂²_t δΦ(x,t)
      * @param alpha_values Fractional order α(x) at each grid point
@@ -170,6 +224,13 @@ public:
         const std::vector<double>& alpha_values
     ) const;
 
+    /**
+     * Compute fractional derivatives for all grid points into a caller-owned buffer
+     *
+     * @param derivatives Output, resized to getNumPoints() (no allocation once sized)
+     */
+    void computeDerivatives(std::vector<std::complex<double>>& derivatives) const;
+
     /**
      * Compute fractional derivative for single grid point
      */
@@ -198,16 +259,67 @@ public:
      */
     int getNumCachedKernels() const;
 
+    /**
+     * Get the cached-kernel index resolved for a grid point (-1 before setAlphaField)
+     */
+    int getKernelIndexAt(int point_index) const;
+
+    /**
+     * Get number of distinct kernels used by the current α field
+     */
+    int getNumKernelGroups() const { return static_cast<int>(group_kernels_.size()); }
+
+    /**
+     * Get number of same-kernel runs the α field splits the grid into
+     */
+    int getNumKernelRuns() const { return static_cast<int>(runs_.size()); }
+
     /**
      * Reset all history states (for new simulation)
      */
     void resetHistory();
 
+    /**
+     * Get the SOE state zᵣ of one grid point
+     */
+    std::complex<double> getHistoryState(int point_index, int r) const;
+
+    /**
+     * Set the history of dst_point to Σₙ weights[n]·z(source, src_points[n])
+     *
+     * Carries memory between grids with the same SOE rank and T_max (the
+     * states are time integrals, independent of dt): count 1 copies a
+     * point, a trilinear stencil prolongs a coarser grid's history.
+     */
+    void setHistoryFrom(int dst_point, const FractionalSolver& source,
+                        const int* src_points, const double* weights, int count);
+
+    /**
+     * Append the SOE history (and α field, if set) as "fractional.*"
+     * checkpoint sections
+     *
+     * Sections reference the history arrays; write (or snapshot) the
+     * checkpoint before the next updateHistory().
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const;
+
+    /**
+     * Restore the SOE history from a checkpoint with the same point count,
+     * SOE rank and T_max; a saved α field is re-applied via setAlphaField().
+     * Returns false (history unchanged) on mismatch.
+     */
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error = nullptr);
+
     /**
      * Get memory usage estimate (bytes)
      */
     size_t getMemoryUsage() const;
 
+    /**
+     * True if the history lives in spill files (decided at construction)
+     */
+    bool isOutOfCore() const { return out_of_core_; }
+
     // === Analytical Tests ===
 
     /**
@@ -231,16 +343,44 @@ private:
     FractionalSolverConfig config_;
     int num_points_;
 
-    // SOE kernel cache (map: α → kernel)
+    // SOE kernels in use (map: α → kernel), shared through SOEKernelStore::global()
     std::vector<double> cached_alphas_;
-    std::vector<SOEKernel> cached_kernels_;
+    std::vector<std::shared_ptr<const SOEKernel>> cached_kernels_;
+
+    // History states zᵣ(x), rank-major: element r * num_points_ + i
+    AlignedVector<double> history_re_;
+    AlignedVector<double> history_im_;
+    bool out_of_core_ = false;
+
+    // Contiguous points sharing one kernel group (never crosses a work block)
+    struct KernelRun {
+        int begin;
+        int end;
+        int group;
+    };
 
-    // History states for each grid point
-    std::vector<HistoryState> history_states_;
+    // α field and the kernel group resolved for each point
+    std::vector<double> point_alphas_;
+    std::vector<uint16_t> point_groups_;
+    std::vector<int> group_kernels_;       // group → cached-kernel index
+    std::vector<KernelRun> runs_;          // in point order
+    std::vector<int> block_runs_;          // runs_ offsets of each work block
+
+    // Per-group step coefficients for step_dt_, element group * rank + r:
+    // exp(-sᵣ dt) and wᵣ dt
+    std::vector<double> step_decay_;
+    std::vector<double> step_gain_;
+    double step_dt_;
 
     // Helper: find or create kernel for α
     int findKernelIndex(double alpha, double tolerance = 1e-6) const;
 
+    // Helper: find or create kernel for α without invalidating indices
+    int resolveKernelIndex(double alpha);
+
+    // Helper: rebuild step coefficients if dt or the kernel groups changed
+    void prepareStepCoefficients(double dt);
+
     // Helper: interpolate between two kernels if needed
     SOEKernel interpolateKernels(double alpha) const;
 };
@@ -0,0 +1,73 @@
+/**
+ * IGSOA Gravitational Wave Engine - Step Workspace
+ *
+ * Per-step buffers shared by SymmetryField, FractionalSolver and
+ * BinaryMerger. Sized once for the grid and passed to the in-place
+ * overloads, so a GW step allocates nothing after setup:
+ *
+ *   merger.computeSourceTerms(field, t, ws.source_terms);
+ *   solver.computeDerivatives(ws.fractional_derivatives);
+ *   field.evolveStep(ws.fractional_derivatives, ws.source_terms);
+ *   solver.updateHistory(ws.second_derivatives, dt);
+ *
+ * ws.profiler times each stage when the driver wraps it in
+ * DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_*) (phase_profiler.h).
+ */
+
+#pragma once
+
+#include "../../phase_profiler.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+// Stages of one GW step (GWStepWorkspace::profiler slots)
+enum GWStepPhase : size_t {
+    GW_PHASE_SOURCE = 0,    // BinaryMerger::computeSourceTerms (+ echo sources)
+    GW_PHASE_FRACTIONAL,    // FractionalSolver::computeDerivatives
+    GW_PHASE_FIELD,         // SymmetryField::evolveStep
+    GW_PHASE_HISTORY,       // FractionalSolver::updateHistory
+    GW_PHASE_STRAIN         // ProjectionOperators strain extraction
+};
+
+class GWStepProfiler : public PhaseProfiler {
+public:
+    GWStepProfiler()
+        : PhaseProfiler({"source_terms", "fractional_derivatives", "field_step",
+                         "history_update", "strain"}) {}
+};
+
+struct GWStepWorkspace {
+    std::vector<std::complex<double>> fractional_derivatives;  // ₀D^α_t δΦ
+    std::vector<std::complex<double>> source_terms;            // S(x,t)
+    std::vector<std::complex<double>> second_derivatives;      // ∂²_t δΦ
+
+    // Buffer (re)allocations since construction
+    uint64_t allocations = 0;
+
+    // Per-stage step timing (see GWStepPhase)
+    GWStepProfiler profiler;
+
+    GWStepWorkspace() = default;
+    explicit GWStepWorkspace(int num_points) { ensure(num_points); }
+
+    /**
+     * Size all buffers for num_points (zero-filled when grown)
+     */
+    void ensure(int num_points) {
+        const size_t n = static_cast<size_t>(num_points);
+        for (auto* buffer : {&fractional_derivatives, &source_terms, &second_derivatives}) {
+            if (buffer->size() == n) continue;
+            if (buffer->capacity() < n) allocations++;
+            buffer->assign(n, std::complex<double>(0.0, 0.0));
+        }
+    }
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
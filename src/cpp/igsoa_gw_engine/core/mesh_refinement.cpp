@@ -0,0 +1,616 @@
+/**
+ * IGSOA Gravitational Wave Engine - Block-Structured Mesh Refinement Implementation
+ */
+
+#include "mesh_refinement.h"
+#include "source_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+// ============================================================================
+// MeshRefinementConfig Implementation
+// ============================================================================
+
+MeshRefinementConfig::MeshRefinementConfig()
+    : levels(1)
+    , ratio(2)
+    , patch_cells(8)
+    , regrid_interval(8)
+{
+}
+
+// ============================================================================
+// Grid Blocks
+// ============================================================================
+
+struct RefinedSymmetryField::Block {
+    std::unique_ptr<SymmetryField> field;
+    std::unique_ptr<FractionalSolver> solver;
+    GWStepWorkspace workspace;
+
+    int parent = -1;
+    int lo[3] = {0, 0, 0};          // Lower corner in parent points
+    int cells[3] = {0, 0, 0};       // Extent in parent cells
+    int64_t global[3] = {0, 0, 0};  // Corner on the lattice of its level (base origin, level spacing)
+    std::vector<int> children;      // Patch indices on the next level
+
+    // δΦ at the start of the current step (time interpolation of the children's ghosts)
+    std::vector<std::complex<double>> previous;
+
+    // Boundary points and their trilinear parent stencils (8 per point)
+    std::vector<int> ghost_points;
+    std::vector<int> ghost_sources;
+    std::vector<double> ghost_weights;
+};
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+RefinedSymmetryField::RefinedSymmetryField(const SymmetryFieldConfig& field_config,
+                                           const FractionalSolverConfig& solver_config,
+                                           const MeshRefinementConfig& refinement)
+    : field_config_(field_config)
+    , solver_config_(solver_config)
+    , refinement_(refinement)
+{
+    if (refinement_.levels < 0) {
+        throw std::invalid_argument("Refinement levels must be non-negative, got: " +
+                                    std::to_string(refinement_.levels));
+    }
+    if (refinement_.ratio < 2 || refinement_.ratio > 4) {
+        throw std::invalid_argument("Refinement ratio must be in [2, 4], got: " +
+                                    std::to_string(refinement_.ratio));
+    }
+    if (refinement_.patch_cells < 2) {
+        throw std::invalid_argument("Patch width must be at least 2 cells, got: " +
+                                    std::to_string(refinement_.patch_cells));
+    }
+    if (refinement_.regrid_interval < 1) {
+        throw std::invalid_argument("Regrid interval must be positive, got: " +
+                                    std::to_string(refinement_.regrid_interval));
+    }
+
+    auto base = std::make_unique<Block>();
+    base->field = std::make_unique<SymmetryField>(field_config_);
+    solver_config_.dt = field_config_.dt;
+    base->solver = std::make_unique<FractionalSolver>(solver_config_, base->field->getTotalPoints());
+    base->solver->setAlphaField(base->field->getAlphaFlat());
+    base->workspace.ensure(base->field->getTotalPoints());
+
+    levels_.resize(static_cast<size_t>(refinement_.levels) + 1);
+    levels_[0].push_back(std::move(base));
+}
+
+RefinedSymmetryField::~RefinedSymmetryField() = default;
+
+// ============================================================================
+// Coarse-Fine Transfer
+// ============================================================================
+
+void RefinedSymmetryField::parentStencil(const Block& child, const Block& parent, int i, int j, int k,
+                                         int* points, double* weights) const {
+    const int r = refinement_.ratio;
+    const int index[3] = {i, j, k};
+    int corner[3];
+    double frac[3];
+    for (int d = 0; d < 3; d++) {
+        corner[d] = child.lo[d] + index[d] / r;
+        frac[d] = static_cast<double>(index[d] % r) / r;
+    }
+    // Patches end at least one point inside the parent, so corner + 1 is on the grid
+    for (int c = 0; c < 8; c++) {
+        const int o[3] = {c & 1, (c >> 1) & 1, (c >> 2) & 1};
+        double w = 1.0;
+        for (int d = 0; d < 3; d++) {
+            w *= o[d] ? frac[d] : 1.0 - frac[d];
+        }
+        points[c] = parent.field->toFlatIndex(corner[0] + o[0], corner[1] + o[1], corner[2] + o[2]);
+        weights[c] = w;
+    }
+}
+
+void RefinedSymmetryField::prolongAlpha(Block& child, const Block& parent) {
+    SymmetryField& field = *child.field;
+    const SymmetryFieldConfig& cfg = field.getConfig();
+    const std::vector<double>& alpha = parent.field->getAlphaFlat();
+    int points[8];
+    double weights[8];
+    for (int k = 0; k < cfg.nz; k++) {
+        for (int j = 0; j < cfg.ny; j++) {
+            for (int i = 0; i < cfg.nx; i++) {
+                parentStencil(child, parent, i, j, k, points, weights);
+                double a = 0.0;
+                for (int c = 0; c < 8; c++) a += weights[c] * alpha[points[c]];
+                field.setAlpha(i, j, k, std::min(cfg.alpha_max, std::max(cfg.alpha_min, a)));
+            }
+        }
+    }
+    child.solver->setAlphaField(field.getAlphaFlat());
+}
+
+void RefinedSymmetryField::fillGhosts(Block& child, const Block& parent, double theta) {
+    std::vector<std::complex<double>>& phi = child.field->deltaPhiForWrite();
+    const std::complex<double>* now = parent.field->getDeltaPhiFlat().data();
+    const std::complex<double>* before = parent.previous.data();
+    const int* sources = child.ghost_sources.data();
+    const double* weights = child.ghost_weights.data();
+    const size_t count = child.ghost_points.size();
+
+    #pragma omp parallel for schedule(static)
+    for (long long g = 0; g < static_cast<long long>(count); g++) {
+        std::complex<double> value(0.0, 0.0);
+        for (int c = 0; c < 8; c++) {
+            const int s = sources[8 * g + c];
+            value += weights[8 * g + c] * (before[s] + theta * (now[s] - before[s]));
+        }
+        phi[child.ghost_points[g]] = value;
+    }
+}
+
+void RefinedSymmetryField::restrictInto(const Block& child, Block& parent, bool history) {
+    const int r = refinement_.ratio;
+    const int span = 2 * r - 1;
+
+    // Full weighting along one axis: (r - |d|) / r² for d in [-(r-1), r-1]
+    double axis[7];
+    for (int d = -(r - 1); d <= r - 1; d++) {
+        axis[d + r - 1] = static_cast<double>(r - std::abs(d)) / (r * r);
+    }
+
+    const SymmetryField& fine = *child.field;
+    const std::complex<double>* fine_phi = fine.getDeltaPhiFlat().data();
+    std::vector<std::complex<double>>& phi = parent.field->deltaPhiForWrite();
+
+    // Parent points strictly inside the patch; their stencils stay off the ghost layer
+    const int pk_count = child.cells[2] - 1;
+    #pragma omp parallel for schedule(static)
+    for (int pk = 0; pk < pk_count; pk++) {
+        std::vector<int> points(static_cast<size_t>(span) * span * span);
+        std::vector<double> weights(points.size());
+        const int k_parent = child.lo[2] + 1 + pk;
+        const int fk = r * (1 + pk);
+        for (int j_parent = child.lo[1] + 1; j_parent < child.lo[1] + child.cells[1]; j_parent++) {
+            const int fj = r * (j_parent - child.lo[1]);
+            for (int i_parent = child.lo[0] + 1; i_parent < child.lo[0] + child.cells[0]; i_parent++) {
+                const int fi = r * (i_parent - child.lo[0]);
+                std::complex<double> value(0.0, 0.0);
+                int n = 0;
+                for (int dk = 0; dk < span; dk++) {
+                    for (int dj = 0; dj < span; dj++) {
+                        const double w_jk = axis[dk] * axis[dj];
+                        for (int di = 0; di < span; di++) {
+                            const int idx = fine.toFlatIndex(fi + di - (r - 1), fj + dj - (r - 1), fk + dk - (r - 1));
+                            points[n] = idx;
+                            weights[n] = w_jk * axis[di];
+                            value += weights[n] * fine_phi[idx];
+                            n++;
+                        }
+                    }
+                }
+                const int parent_idx = parent.field->toFlatIndex(i_parent, j_parent, k_parent);
+                phi[parent_idx] = value;
+                if (history) {
+                    parent.solver->setHistoryFrom(parent_idx, *child.solver, points.data(), weights.data(), n);
+                }
+            }
+        }
+    }
+}
+
+void RefinedSymmetryField::restrictPatches() {
+    for (int level = static_cast<int>(levels_.size()) - 1; level >= 1; level--) {
+        for (const auto& block : levels_[level]) {
+            restrictInto(*block, *levels_[level - 1][block->parent], false);
+        }
+    }
+}
+
+void RefinedSymmetryField::applyAlphaField() {
+    Block& base = *levels_[0][0];
+    base.solver->setAlphaField(base.field->getAlphaFlat());
+    for (size_t level = 1; level < levels_.size(); level++) {
+        for (auto& block : levels_[level]) {
+            prolongAlpha(*block, *levels_[level - 1][block->parent]);
+        }
+    }
+}
+
+// ============================================================================
+// Regridding
+// ============================================================================
+
+std::unique_ptr<RefinedSymmetryField::Block> RefinedSymmetryField::buildPatch(
+    int level, int parent, const int lo[3], const int cells[3],
+    const std::vector<std::unique_ptr<Block>>& old_level)
+{
+    const int r = refinement_.ratio;
+    const Block& p = *levels_[level - 1][parent];
+    const SymmetryFieldConfig& parent_config = p.field->getConfig();
+
+    auto block = std::make_unique<Block>();
+    block->parent = parent;
+    for (int d = 0; d < 3; d++) {
+        block->lo[d] = lo[d];
+        block->cells[d] = cells[d];
+        block->global[d] = (p.global[d] + lo[d]) * r;
+    }
+
+    SymmetryFieldConfig config = parent_config;
+    config.nx = cells[0] * r + 1;
+    config.ny = cells[1] * r + 1;
+    config.nz = cells[2] * r + 1;
+    config.dx = parent_config.dx / r;
+    config.dy = parent_config.dy / r;
+    config.dz = parent_config.dz / r;
+    config.dt = parent_config.dt / r;
+    config.origin = Vector3D(field_config_.origin.x + block->global[0] * config.dx,
+                             field_config_.origin.y + block->global[1] * config.dy,
+                             field_config_.origin.z + block->global[2] * config.dz);
+    block->field = std::make_unique<SymmetryField>(config);
+    block->field->setCurrentTime(p.field->getCurrentTime());
+
+    FractionalSolverConfig solver_config = solver_config_;
+    solver_config.dt = config.dt;
+    const int num_points = block->field->getTotalPoints();
+    block->solver = std::make_unique<FractionalSolver>(solver_config, num_points);
+    block->workspace.ensure(num_points);
+    prolongAlpha(*block, p);
+
+    // Copy δΦ and zᵣ where an old patch of this level covered the point,
+    // prolong the parent's elsewhere
+    std::vector<std::complex<double>>& phi = block->field->deltaPhiForWrite();
+    const std::vector<std::complex<double>>& parent_phi = p.field->getDeltaPhiFlat();
+    const double one = 1.0;
+    int points[8];
+    double weights[8];
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) {
+                const int idx = block->field->toFlatIndex(i, j, k);
+                const int64_t g[3] = {block->global[0] + i, block->global[1] + j, block->global[2] + k};
+                const Block* source = nullptr;
+                int source_idx = -1;
+                for (const auto& old : old_level) {
+                    if (!old) continue;
+                    const SymmetryFieldConfig& c = old->field->getConfig();
+                    const int64_t oi = g[0] - old->global[0];
+                    const int64_t oj = g[1] - old->global[1];
+                    const int64_t ok = g[2] - old->global[2];
+                    if (oi >= 0 && oi < c.nx && oj >= 0 && oj < c.ny && ok >= 0 && ok < c.nz) {
+                        source = old.get();
+                        source_idx = old->field->toFlatIndex(static_cast<int>(oi), static_cast<int>(oj),
+                                                             static_cast<int>(ok));
+                        break;
+                    }
+                }
+                if (source) {
+                    phi[idx] = source->field->getDeltaPhiFlat()[source_idx];
+                    block->solver->setHistoryFrom(idx, *source->solver, &source_idx, &one, 1);
+                } else {
+                    parentStencil(*block, p, i, j, k, points, weights);
+                    std::complex<double> value(0.0, 0.0);
+                    for (int c = 0; c < 8; c++) value += weights[c] * parent_phi[points[c]];
+                    phi[idx] = value;
+                    block->solver->setHistoryFrom(idx, *p.solver, points, weights, 8);
+                }
+            }
+        }
+    }
+    return block;
+}
+
+void RefinedSymmetryField::linkPatches(int level) {
+    for (auto& parent : levels_[level - 1]) {
+        parent->children.clear();
+    }
+    for (size_t index = 0; index < levels_[level].size(); index++) {
+        Block& block = *levels_[level][index];
+        const Block& parent = *levels_[level - 1][block.parent];
+        levels_[level - 1][block.parent]->children.push_back(static_cast<int>(index));
+
+        const SymmetryFieldConfig& c = block.field->getConfig();
+        block.ghost_points.clear();
+        block.ghost_sources.clear();
+        block.ghost_weights.clear();
+        int points[8];
+        double weights[8];
+        for (int k = 0; k < c.nz; k++) {
+            for (int j = 0; j < c.ny; j++) {
+                for (int i = 0; i < c.nx; i++) {
+                    if (i != 0 && i != c.nx - 1 && j != 0 && j != c.ny - 1 && k != 0 && k != c.nz - 1) {
+                        continue;
+                    }
+                    parentStencil(block, parent, i, j, k, points, weights);
+                    block.ghost_points.push_back(block.field->toFlatIndex(i, j, k));
+                    block.ghost_sources.insert(block.ghost_sources.end(), points, points + 8);
+                    block.ghost_weights.insert(block.ghost_weights.end(), weights, weights + 8);
+                }
+            }
+        }
+    }
+}
+
+void RefinedSymmetryField::regrid(const std::vector<Vector3D>& centers) {
+    const int levels = static_cast<int>(levels_.size()) - 1;
+    if (levels == 0) {
+        return;
+    }
+
+    // Hand the patch memory to the parents first, so cells a patch leaves keep it
+    for (int level = levels; level >= 1; level--) {
+        for (const auto& block : levels_[level]) {
+            restrictInto(*block, *levels_[level - 1][block->parent], true);
+        }
+    }
+
+    const int r = refinement_.ratio;
+    const int width = refinement_.patch_cells;
+    struct Box {
+        int parent;
+        int lo[3];
+        int hi[3];
+    };
+
+    for (int level = 1; level <= levels; level++) {
+        std::vector<std::unique_ptr<Block>> old_level = std::move(levels_[level]);
+        levels_[level].clear();
+        const auto& parents = levels_[level - 1];
+
+        // One box per source inside a parent, clamped to its interior; overlaps merge
+        std::vector<Box> boxes;
+        for (size_t pi = 0; pi < parents.size(); pi++) {
+            const SymmetryField& pf = *parents[pi]->field;
+            const int n[3] = {pf.getNx(), pf.getNy(), pf.getNz()};
+            std::vector<Box> local;
+            for (const Vector3D& center : centers) {
+                const double f[3] = {(center.x - pf.getConfig().origin.x) / pf.getDx(),
+                                     (center.y - pf.getConfig().origin.y) / pf.getDy(),
+                                     (center.z - pf.getConfig().origin.z) / pf.getDz()};
+                Box box{static_cast<int>(pi), {0, 0, 0}, {0, 0, 0}};
+                bool inside = true;
+                for (int d = 0; d < 3; d++) {
+                    const int c = static_cast<int>(std::lround(f[d]));
+                    if (c < 1 || c > n[d] - 2 || width > n[d] - 3) {
+                        inside = false;
+                        break;
+                    }
+                    box.lo[d] = std::min(std::max(c - width / 2, 1), n[d] - 2 - width);
+                    box.hi[d] = box.lo[d] + width;
+                }
+                if (inside) {
+                    local.push_back(box);
+                }
+            }
+            for (bool merged = true; merged;) {
+                merged = false;
+                for (size_t a = 0; a < local.size() && !merged; a++) {
+                    for (size_t b = a + 1; b < local.size() && !merged; b++) {
+                        bool overlap = true;
+                        for (int d = 0; d < 3; d++) {
+                            overlap = overlap && local[a].lo[d] <= local[b].hi[d] && local[b].lo[d] <= local[a].hi[d];
+                        }
+                        if (overlap) {
+                            for (int d = 0; d < 3; d++) {
+                                local[a].lo[d] = std::min(local[a].lo[d], local[b].lo[d]);
+                                local[a].hi[d] = std::max(local[a].hi[d], local[b].hi[d]);
+                            }
+                            local.erase(local.begin() + b);
+                            merged = true;
+                        }
+                    }
+                }
+            }
+            boxes.insert(boxes.end(), local.begin(), local.end());
+        }
+
+        // Unmoved patches are kept; the others are built from the old level
+        std::vector<int> kept(boxes.size(), -1);
+        for (size_t b = 0; b < boxes.size(); b++) {
+            const Block& parent = *parents[boxes[b].parent];
+            for (size_t o = 0; o < old_level.size(); o++) {
+                bool same = true;
+                for (int d = 0; d < 3; d++) {
+                    same = same && old_level[o]->global[d] == (parent.global[d] + boxes[b].lo[d]) * r &&
+                           old_level[o]->cells[d] == boxes[b].hi[d] - boxes[b].lo[d];
+                }
+                if (same) {
+                    kept[b] = static_cast<int>(o);
+                    break;
+                }
+            }
+        }
+        std::vector<std::unique_ptr<Block>> next(boxes.size());
+        for (size_t b = 0; b < boxes.size(); b++) {
+            if (kept[b] >= 0) continue;
+            const int cells[3] = {boxes[b].hi[0] - boxes[b].lo[0], boxes[b].hi[1] - boxes[b].lo[1],
+                                  boxes[b].hi[2] - boxes[b].lo[2]};
+            next[b] = buildPatch(level, boxes[b].parent, boxes[b].lo, cells, old_level);
+        }
+        for (size_t b = 0; b < boxes.size(); b++) {
+            if (kept[b] < 0) continue;
+            next[b] = std::move(old_level[kept[b]]);
+            next[b]->parent = boxes[b].parent;
+            for (int d = 0; d < 3; d++) next[b]->lo[d] = boxes[b].lo[d];
+        }
+        levels_[level] = std::move(next);
+        linkPatches(level);
+    }
+    regrids_++;
+}
+
+// ============================================================================
+// Evolution
+// ============================================================================
+
+void RefinedSymmetryField::advance(int level, int index, BinaryMerger& merger) {
+    Block& block = *levels_[level][index];
+    SymmetryField& field = *block.field;
+    GWStepWorkspace& ws = block.workspace;
+    const double t = field.getCurrentTime();
+    if (!block.children.empty()) {
+        block.previous = field.getDeltaPhiFlat();
+    }
+
+    {
+        DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_SOURCE);
+        merger.computeSourceTerms(field, t, ws.source_terms);
+        if (hook_) hook_(field, t, ws);
+    }
+    {
+        DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_FRACTIONAL);
+        block.solver->computeDerivatives(ws.fractional_derivatives);
+    }
+    {
+        DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_FIELD);
+        field.evolveStep(ws.fractional_derivatives, ws.source_terms);
+    }
+    {
+        DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_HISTORY);
+        block.solver->updateHistory(ws.second_derivatives, field.getTimestep());
+    }
+    point_updates_ += static_cast<uint64_t>(field.getTotalPoints());
+
+    // Subcycle the patches across this step, then average them back
+    const int r = refinement_.ratio;
+    for (int c : block.children) {
+        Block& child = *levels_[level + 1][c];
+        for (int s = 0; s < r; s++) {
+            fillGhosts(child, block, static_cast<double>(s) / r);
+            advance(level + 1, c, merger);
+        }
+        fillGhosts(child, block, 1.0);
+        restrictInto(child, block, false);
+    }
+}
+
+void RefinedSymmetryField::step(BinaryMerger& merger) {
+    if (steps_ % static_cast<uint64_t>(refinement_.regrid_interval) == 0) {
+        regrid({merger.getPosition1(), merger.getPosition2()});
+    }
+    advance(0, 0, merger);
+    merger.evolveOrbit(field_config_.dt);
+    steps_++;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+SymmetryField& RefinedSymmetryField::baseField() {
+    return *levels_[0][0]->field;
+}
+
+const SymmetryField& RefinedSymmetryField::baseField() const {
+    return *levels_[0][0]->field;
+}
+
+FractionalSolver& RefinedSymmetryField::baseSolver() {
+    return *levels_[0][0]->solver;
+}
+
+int RefinedSymmetryField::getNumLevels() const {
+    int levels = 0;
+    while (levels + 1 < static_cast<int>(levels_.size()) && !levels_[levels + 1].empty()) {
+        levels++;
+    }
+    return levels;
+}
+
+int RefinedSymmetryField::getNumPatches(int level) const {
+    if (level < 1 || level >= static_cast<int>(levels_.size())) {
+        throw std::out_of_range("Refinement level out of range");
+    }
+    return static_cast<int>(levels_[level].size());
+}
+
+SymmetryField& RefinedSymmetryField::patchField(int level, int index) {
+    getNumPatches(level);
+    return *levels_[level].at(index)->field;
+}
+
+const SymmetryField& RefinedSymmetryField::patchField(int level, int index) const {
+    getNumPatches(level);
+    return *levels_[level].at(index)->field;
+}
+
+FractionalSolver& RefinedSymmetryField::patchSolver(int level, int index) {
+    getNumPatches(level);
+    return *levels_[level].at(index)->solver;
+}
+
+RefinedPatchInfo RefinedSymmetryField::getPatchInfo(int level, int index) const {
+    getNumPatches(level);
+    const Block& block = *levels_[level].at(index);
+    RefinedPatchInfo info;
+    info.level = level;
+    info.parent = block.parent;
+    for (int d = 0; d < 3; d++) {
+        info.lo[d] = block.lo[d];
+        info.cells[d] = block.cells[d];
+    }
+    info.origin = block.field->getConfig().origin;
+    info.dx = block.field->getDx();
+    info.points = block.field->getTotalPoints();
+    return info;
+}
+
+std::complex<double> RefinedSymmetryField::getDeltaPhiAt(const Vector3D& position) const {
+    for (int level = static_cast<int>(levels_.size()) - 1; level >= 1; level--) {
+        for (const auto& block : levels_[level]) {
+            const SymmetryFieldConfig& c = block->field->getConfig();
+            const Vector3D rel = position - c.origin;
+            if (rel.x >= 0.0 && rel.x <= (c.nx - 1) * c.dx &&
+                rel.y >= 0.0 && rel.y <= (c.ny - 1) * c.dy &&
+                rel.z >= 0.0 && rel.z <= (c.nz - 1) * c.dz) {
+                return block->field->getDeltaPhiAt(position);
+            }
+        }
+    }
+    return baseField().getDeltaPhiAt(position);
+}
+
+int64_t RefinedSymmetryField::getTotalPoints() const {
+    int64_t points = 0;
+    for (const auto& level : levels_) {
+        for (const auto& block : level) points += block->field->getTotalPoints();
+    }
+    return points;
+}
+
+int64_t RefinedSymmetryField::getEquivalentUniformPoints() const {
+    int64_t scale = 1;
+    for (size_t level = 1; level < levels_.size(); level++) scale *= refinement_.ratio;
+    return (static_cast<int64_t>(field_config_.nx - 1) * scale + 1) *
+           (static_cast<int64_t>(field_config_.ny - 1) * scale + 1) *
+           (static_cast<int64_t>(field_config_.nz - 1) * scale + 1);
+}
+
+size_t RefinedSymmetryField::getMemoryUsage() const {
+    // Per point: δΦ and ∇²δΦ (complex); α, |∇δΦ| and V (double); three workspace buffers
+    const size_t per_point = 2 * sizeof(std::complex<double>) + 3 * sizeof(double) +
+                             3 * sizeof(std::complex<double>);
+    size_t bytes = 0;
+    for (const auto& level : levels_) {
+        for (const auto& block : level) {
+            bytes += static_cast<size_t>(block->field->getTotalPoints()) * per_point
+                   + block->solver->getMemoryUsage()
+                   + block->previous.capacity() * sizeof(std::complex<double>)
+                   + block->ghost_points.capacity() * sizeof(int)
+                   + block->ghost_sources.capacity() * sizeof(int)
+                   + block->ghost_weights.capacity() * sizeof(double);
+        }
+    }
+    return bytes;
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,211 @@
+/**
+ * IGSOA Gravitational Wave Engine - Block-Structured Mesh Refinement
+ *
+ * The structure of δΦ is concentrated around the two BinaryMerger
+ * sources, while a uniform SymmetryField pays the near-source resolution
+ * over the whole box. RefinedSymmetryField keeps the uniform grid as the
+ * base level and stacks refined patches (each a SymmetryField with its own
+ * FractionalSolver and GWStepWorkspace) around getPosition1/2():
+ *
+ *   MeshRefinementConfig amr;
+ *   amr.levels = 2;            // dx/2 and dx/4 around the sources
+ *   amr.patch_cells = 8;       // Patch width in parent cells per source
+ *   RefinedSymmetryField grid(field_config, solver_config, amr);
+ *   for (int n = 0; n < steps; n++) grid.step(merger);   // Also evolves the orbit
+ *
+ * - Patches: a box of patch_cells parent cells centred on each source
+ *   inside the parent's interior; overlapping boxes merge. Level l+1
+ *   nests in level l. Every regrid_interval base steps the boxes follow
+ *   the sources.
+ * - Subcycling (Berger-Oliger): each level takes `ratio` steps of dt/ratio
+ *   per parent step. Patch boundary points are the ghosts: trilinear in
+ *   space and linear in time between the parent's old and new δΦ.
+ * - Coarse-fine transfer: trilinear prolongation and full-weighting
+ *   restriction (its adjoint, weights (r-|d|)/r² per axis) both preserve
+ *   the trapezoidal ∫δΦ dV away from patch edges. Patches are restricted
+ *   into their parents after every parent step.
+ * - Memory: the SOE history moves with the patches. On regrid, patch
+ *   histories are restricted into the parents, then a new patch copies δΦ
+ *   and zᵣ where an old patch of its level overlapped and prolongs the
+ *   parent's elsewhere (FractionalSolver::setHistoryFrom).
+ *
+ * Within a base step, the sources sit at the positions of its start (as on
+ * the uniform grid, the orbit advances once per base step). α is
+ * interpolated from the base grid when a patch is built; after changing
+ * the base α call applyAlphaField(). Checkpoints cover the base level
+ * only (baseField()/baseSolver()).
+ */
+
+#pragma once
+
+#include "symmetry_field.h"
+#include "fractional_solver.h"
+#include "gw_step_workspace.h"
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+class BinaryMerger;  // source_manager.h
+
+/**
+ * Configuration for mesh refinement
+ */
+struct MeshRefinementConfig {
+    int levels;             // Refined levels above the base grid (0: uniform)
+    int ratio;              // Spacing and timestep ratio between levels (2-4)
+    int patch_cells;        // Patch width around each source, in parent cells
+    int regrid_interval;    // Base steps between regrids
+
+    MeshRefinementConfig();
+};
+
+/**
+ * Placement of one refined patch
+ */
+struct RefinedPatchInfo {
+    int level;              // 1 = first refined level
+    int parent;             // Patch index on level - 1 (0 on the base)
+    int lo[3];              // Lower corner in parent points
+    int cells[3];           // Extent in parent cells
+    Vector3D origin;        // Position of the patch point (0,0,0)
+    double dx;              // Patch spacing
+    int points;             // Patch grid points (ghost layer included)
+};
+
+/**
+ * Base SymmetryField plus source-following refined patches
+ */
+class RefinedSymmetryField {
+public:
+    /**
+     * Extra source terms / ∂²_t δΦ for one grid, called after the merger
+     * painted ws.source_terms at time t (echo sources, history drive)
+     */
+    using SourceHook = std::function<void(const SymmetryField& field, double t, GWStepWorkspace& ws)>;
+
+    /**
+     * @param field_config Base grid (patches inherit all but nx/dx/dt/origin)
+     * @param solver_config Fractional solver (per-level dt set internally)
+     * @param refinement Patch levels and placement
+     */
+    RefinedSymmetryField(const SymmetryFieldConfig& field_config,
+                         const FractionalSolverConfig& solver_config,
+                         const MeshRefinementConfig& refinement);
+    ~RefinedSymmetryField();
+
+    RefinedSymmetryField(const RefinedSymmetryField&) = delete;
+    RefinedSymmetryField& operator=(const RefinedSymmetryField&) = delete;
+
+    void setSourceHook(SourceHook hook) { hook_ = std::move(hook); }
+
+    // === Evolution ===
+
+    /**
+     * One base step: regrid around the merger (every regrid_interval
+     * steps), advance all levels with subcycling, restrict, then
+     * merger.evolveOrbit(dt)
+     */
+    void step(BinaryMerger& merger);
+
+    /**
+     * Rebuild the patches around centers (sources), carrying δΦ and the
+     * SOE history
+     */
+    void regrid(const std::vector<Vector3D>& centers);
+
+    /**
+     * Full-weighting restriction of every patch into its parent, finest
+     * level first (done after every step)
+     */
+    void restrictPatches();
+
+    /**
+     * Re-apply the base α field to the base solver and re-interpolate it on
+     * the patches
+     */
+    void applyAlphaField();
+
+    // === Access ===
+
+    SymmetryField& baseField();
+    const SymmetryField& baseField() const;
+    FractionalSolver& baseSolver();
+
+    /**
+     * Refined levels holding patches (0 before the first regrid)
+     */
+    int getNumLevels() const;
+    int getNumPatches(int level) const;
+
+    SymmetryField& patchField(int level, int index);
+    const SymmetryField& patchField(int level, int index) const;
+    FractionalSolver& patchSolver(int level, int index);
+    RefinedPatchInfo getPatchInfo(int level, int index) const;
+
+    /**
+     * δΦ at a position from the finest level covering it
+     */
+    std::complex<double> getDeltaPhiAt(const Vector3D& position) const;
+
+    double getCurrentTime() const { return baseField().getCurrentTime(); }
+    uint64_t getStepCount() const { return steps_; }
+    uint64_t getRegridCount() const { return regrids_; }
+
+    // === Cost ===
+
+    /**
+     * Grid points over all levels
+     */
+    int64_t getTotalPoints() const;
+
+    /**
+     * Points of a uniform grid at the finest spacing over the base box
+     */
+    int64_t getEquivalentUniformPoints() const;
+
+    /**
+     * Point updates since construction (a uniform finest grid costs
+     * getEquivalentUniformPoints()·ratio^levels per base step)
+     */
+    uint64_t getPointUpdates() const { return point_updates_; }
+
+    /**
+     * Fields, histories and workspaces of all levels (bytes)
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    struct Block;
+
+    SymmetryFieldConfig field_config_;
+    FractionalSolverConfig solver_config_;
+    MeshRefinementConfig refinement_;
+    SourceHook hook_;
+
+    // levels_[0] holds the base grid; levels_[l] the patches of level l
+    std::vector<std::vector<std::unique_ptr<Block>>> levels_;
+
+    uint64_t steps_ = 0;
+    uint64_t regrids_ = 0;
+    uint64_t point_updates_ = 0;
+
+    void advance(int level, int index, BinaryMerger& merger);
+    void fillGhosts(Block& child, const Block& parent, double theta);
+    void restrictInto(const Block& child, Block& parent, bool history);
+    std::unique_ptr<Block> buildPatch(int level, int parent, const int lo[3], const int cells[3],
+                                      const std::vector<std::unique_ptr<Block>>& old_level);
+    void linkPatches(int level);
+    void prolongAlpha(Block& child, const Block& parent);
+    void parentStencil(const Block& child, const Block& parent, int i, int j, int k,
+                       int* points, double* weights) const;
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,179 @@
+/**
+ * IGSOA GW Engine - Shared Prime Table Implementation
+ */
+
+#include "prime_table.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+namespace {
+
+inline int countTrailingZeros(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+int64_t integerSqrt(int64_t n) {
+    int64_t root = static_cast<int64_t>(std::sqrt(static_cast<double>(n)));
+    while (root * root > n) root--;
+    while ((root + 1) * (root + 1) <= n) root++;
+    return root;
+}
+
+/**
+ * Odd primes up to limit (plain odd-only sieve; limit is at most ~46341)
+ */
+std::vector<int64_t> oddBasePrimes(int64_t limit) {
+    std::vector<int64_t> base;
+    if (limit < 3) {
+        return base;
+    }
+    // Index i represents 2i + 1
+    std::vector<uint8_t> composite(static_cast<size_t>(limit / 2 + 1), 0);
+    for (int64_t i = 1; 2 * i + 1 <= limit; i++) {
+        if (composite[i]) continue;
+        const int64_t p = 2 * i + 1;
+        base.push_back(p);
+        for (int64_t m = p * p; m <= limit; m += 2 * p) {
+            composite[static_cast<size_t>(m / 2)] = 1;
+        }
+    }
+    return base;
+}
+
+} // namespace
+
+// ============================================================================
+// PrimeTableData
+// ============================================================================
+
+size_t PrimeTableData::countUpTo(int value) const {
+    return static_cast<size_t>(std::upper_bound(primes.begin(), primes.end(), value) - primes.begin());
+}
+
+// ============================================================================
+// PrimeTable
+// ============================================================================
+
+PrimeTable::PrimeTable()
+    : current_(std::make_shared<PrimeTableData>())
+{
+}
+
+PrimeTable& PrimeTable::instance() {
+    static PrimeTable table;
+    return table;
+}
+
+PrimeTable::Snapshot PrimeTable::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+}
+
+PrimeTable::Snapshot PrimeTable::ensure(int max_value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_value <= current_->limit) {
+        return current_;
+    }
+
+    // Grow geometrically so a sweep of increasing ranges sieves O(max) in total
+    const int64_t int_max = std::numeric_limits<int>::max();
+    const int64_t new_limit = std::min(int_max, std::max<int64_t>(max_value, 2 * current_->limit));
+
+    auto grown = std::make_shared<PrimeTableData>();
+    grown->primes.reserve(static_cast<size_t>(
+        1.1 * static_cast<double>(new_limit) / std::log(static_cast<double>(std::max<int64_t>(new_limit, 3)))));
+    grown->primes = current_->primes;
+    sieveRange(current_->limit + 1, new_limit, grown->primes);
+    grown->limit = new_limit;
+
+    grown->gaps.reserve(grown->primes.empty() ? 0 : grown->primes.size() - 1);
+    grown->gaps = current_->gaps;
+    for (size_t n = grown->gaps.size() + 1; n < grown->primes.size(); n++) {
+        grown->gaps.push_back(grown->primes[n] - grown->primes[n - 1]);
+    }
+
+    LOG_DEBUG("PrimeTable grown to " + std::to_string(new_limit) + ": " +
+              std::to_string(grown->primes.size()) + " primes");
+
+    current_ = std::move(grown);
+    return current_;
+}
+
+void PrimeTable::sieveRange(int64_t from, int64_t to, std::vector<int>& primes) {
+    if (to > std::numeric_limits<int>::max()) {
+        throw std::invalid_argument("PrimeTable::sieveRange: upper bound exceeds int range");
+    }
+    from = std::max<int64_t>(from, 2);
+    if (to < from) {
+        return;
+    }
+    if (from == 2) {
+        primes.push_back(2);
+        from = 3;
+    }
+    if (from % 2 == 0) {
+        from++;
+    }
+    if (to < from) {
+        return;
+    }
+
+    const std::vector<int64_t> base = oddBasePrimes(integerSqrt(to));
+
+    // Bit k of a segment starting at odd seg_lo stands for seg_lo + 2k
+    const int64_t segment_bits = static_cast<int64_t>(kSegmentBytes * 8);
+    std::vector<uint64_t> segment(kSegmentBytes / sizeof(uint64_t));
+
+    for (int64_t seg_lo = from; seg_lo <= to; seg_lo += 2 * segment_bits) {
+        const int64_t seg_hi = std::min(to, seg_lo + 2 * segment_bits - 1);
+        const int64_t count = (seg_hi - seg_lo) / 2 + 1;
+        const size_t words = static_cast<size_t>((count + 63) / 64);
+        std::fill(segment.begin(), segment.begin() + words, 0);
+
+        for (int64_t p : base) {
+            const int64_t p_sq = p * p;
+            if (p_sq > seg_hi) break;
+            // First odd multiple of p in the segment, never below p²
+            int64_t start = std::max(p_sq, ((seg_lo + p - 1) / p) * p);
+            if (start % 2 == 0) start += p;
+            for (int64_t k = (start - seg_lo) / 2; k < count; k += p) {
+                segment[static_cast<size_t>(k >> 6)] |= uint64_t(1) << (k & 63);
+            }
+        }
+
+        for (size_t w = 0; w < words; w++) {
+            uint64_t candidates = ~segment[w];
+            const int64_t remaining = count - static_cast<int64_t>(w) * 64;
+            if (remaining < 64) {
+                candidates &= (uint64_t(1) << remaining) - 1;
+            }
+            while (candidates) {
+                const int bit = countTrailingZeros(candidates);
+                primes.push_back(static_cast<int>(seg_lo + 2 * (static_cast<int64_t>(w) * 64 + bit)));
+                candidates &= candidates - 1;
+            }
+        }
+    }
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
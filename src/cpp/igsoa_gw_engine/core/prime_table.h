@@ -0,0 +1,84 @@
+/**
+ * IGSOA Gravitational Wave Engine - Shared Prime Table
+ *
+ * Process-wide table of primes and consecutive prime gaps used by
+ * EchoGenerator. The table grows on demand: ensure(n) extends it with a
+ * segmented, bit-packed, odd-only sieve of Eratosthenes (one L1-sized
+ * segment at a time) and returns an immutable snapshot covering [2, n].
+ *
+ * Snapshots are shared and never modified, so callers may keep and read
+ * them without locking while other threads grow the table. Growth at
+ * least doubles the sieved limit, so repeated requests amortize to one
+ * sieve over the largest range; once warm, ensure() is a lookup.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+/**
+ * Immutable prefix of the prime sequence
+ */
+struct PrimeTableData {
+    std::vector<int> primes;  // All primes <= limit, ascending
+    std::vector<int> gaps;    // gaps[n] = primes[n+1] - primes[n]
+    int64_t limit = 1;        // Sieved up to and including this value
+
+    /**
+     * Number of primes <= value (value must not exceed limit)
+     */
+    size_t countUpTo(int value) const;
+};
+
+class PrimeTable {
+public:
+    using Snapshot = std::shared_ptr<const PrimeTableData>;
+
+    // Sieve segment size: 32 KiB of bits, each bit one odd number
+    static constexpr size_t kSegmentBytes = 32768;
+
+    /**
+     * The process-wide table
+     */
+    static PrimeTable& instance();
+
+    /**
+     * Snapshot containing every prime <= max_value; grows the table if needed
+     * @param max_value Largest value that must be covered
+     */
+    Snapshot ensure(int max_value);
+
+    /**
+     * Current snapshot without growing
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * Append the primes in [from, to] to primes using the segmented sieve
+     * @param from Lower bound (inclusive), >= 2
+     * @param to Upper bound (inclusive)
+     * @param primes Output, appended in ascending order
+     */
+    static void sieveRange(int64_t from, int64_t to, std::vector<int>& primes);
+
+    PrimeTable(const PrimeTable&) = delete;
+    PrimeTable& operator=(const PrimeTable&) = delete;
+
+private:
+    PrimeTable();
+
+    mutable std::mutex mutex_;
+    Snapshot current_;
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
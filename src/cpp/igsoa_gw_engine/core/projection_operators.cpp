@@ -6,6 +6,7 @@
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 namespace dase {
 namespace igsoa {
@@ -22,6 +23,49 @@ ProjectionConfig::ProjectionConfig()
 ProjectionOperators::ProjectionOperators(const ProjectionConfig& config)
     : config_(config)
 {
+    polarization_tensors(config_.detector_normal, plus_coeff_, cross_coeff_);
+
+    const Vector3D n = config_.detector_normal.normalized();
+    const double n_vec[3] = {n.x, n.y, n.z};
+    for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+            projector_[a][b] = (a == b ? 1.0 : 0.0) - n_vec[a] * n_vec[b];
+        }
+    }
+}
+
+void ProjectionOperators::polarization_tensors(const Vector3D& n, double plus[3][3], double cross[3][3]) {
+    const double length = n.magnitude();
+    if (!(length > 0.0)) {
+        throw std::invalid_argument("ProjectionOperators: detector_normal must be non-zero");
+    }
+    const double n_vec[3] = {n.x / length, n.y / length, n.z / length};
+
+    // Transverse basis: Gram-Schmidt of x̂, ŷ, ẑ against n and each other
+    double basis[2][3];
+    int found = 0;
+    for (int axis = 0; axis < 3 && found < 2; axis++) {
+        double v[3] = {0.0, 0.0, 0.0};
+        v[axis] = 1.0;
+        const double along_n = v[0] * n_vec[0] + v[1] * n_vec[1] + v[2] * n_vec[2];
+        for (int c = 0; c < 3; c++) v[c] -= along_n * n_vec[c];
+        for (int e = 0; e < found; e++) {
+            const double along_e = v[0] * basis[e][0] + v[1] * basis[e][1] + v[2] * basis[e][2];
+            for (int c = 0; c < 3; c++) v[c] -= along_e * basis[e][c];
+        }
+        const double norm = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (norm > 1e-6) {
+            for (int c = 0; c < 3; c++) basis[found][c] = v[c] / norm;
+            found++;
+        }
+    }
+
+    for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+            plus[a][b] = basis[0][a] * basis[0][b] - basis[1][a] * basis[1][b];
+            cross[a][b] = basis[0][a] * basis[1][b] + basis[1][a] * basis[0][b];
+        }
+    }
 }
 
 double ProjectionOperators::compute_phi_mode(std::complex<double> delta_phi) const {
@@ -29,22 +73,24 @@ double ProjectionOperators::compute_phi_mode(std::complex<double> delta_phi) con
 }
 
 std::vector<double> ProjectionOperators::compute_phi_mode_field(const SymmetryField& field) const {
-    int total = field.getTotalPoints();
-    std::vector<double> phi_field(total);
-
-    for (int i = 0; i < field.getNx(); i++) {
-        for (int j = 0; j < field.getNy(); j++) {
-            for (int k = 0; k < field.getNz(); k++) {
-                int idx = field.toFlatIndex(i, j, k);
-                std::complex<double> phi = field.getDeltaPhi(i, j, k);
-                phi_field[idx] = compute_phi_mode(phi);
-            }
-        }
-    }
-
+    std::vector<double> phi_field;
+    compute_phi_mode_field(field, phi_field);
     return phi_field;
 }
 
+void ProjectionOperators::compute_phi_mode_field(const SymmetryField& field, std::vector<double>& phi_field) const {
+    const int total = field.getTotalPoints();
+    phi_field.resize(total);
+
+    const std::complex<double>* delta_phi = field.getDeltaPhiFlat().data();
+    double* out = phi_field.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int idx = 0; idx < total; idx++) {
+        out[idx] = compute_phi_mode(delta_phi[idx]);
+    }
+}
+
 Tensor4x4 ProjectionOperators::compute_stress_energy_tensor(
     const SymmetryField& field, int i, int j, int k) const
 {
@@ -104,9 +150,29 @@ ProjectionOperators::StrainComponents ProjectionOperators::compute_strain(
     const Tensor4x4& stress_tensor, const Vector3D& detector_direction) const
 {
     StrainComponents strain;
-    // TODO: Extract h_+, h_× from O_μν in TT gauge
-    strain.h_plus = stress_tensor(1, 1) - stress_tensor(2, 2);
-    strain.h_cross = 2.0 * stress_tensor(1, 2);
+
+    // Contract the spatial block with the polarization tensors; cached for
+    // the configured detector, rebuilt for any other direction
+    double plus_local[3][3];
+    double cross_local[3][3];
+    const double (*plus)[3] = plus_coeff_;
+    const double (*cross)[3] = cross_coeff_;
+    if (detector_direction.x != config_.detector_normal.x ||
+        detector_direction.y != config_.detector_normal.y ||
+        detector_direction.z != config_.detector_normal.z) {
+        polarization_tensors(detector_direction, plus_local, cross_local);
+        plus = plus_local;
+        cross = cross_local;
+    }
+
+    strain.h_plus = 0.0;
+    strain.h_cross = 0.0;
+    for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+            strain.h_plus += plus[a][b] * stress_tensor(a + 1, b + 1);
+            strain.h_cross += cross[a][b] * stress_tensor(a + 1, b + 1);
+        }
+    }
     strain.amplitude = std::sqrt(strain.h_plus * strain.h_plus + strain.h_cross * strain.h_cross);
     strain.phase = std::atan2(strain.h_cross, strain.h_plus);
     return strain;
@@ -136,6 +202,62 @@ ProjectionOperators::StrainComponents ProjectionOperators::compute_strain_at_obs
     return result;
 }
 
+void ProjectionOperators::compute_strain_field(
+    const SymmetryField& field,
+    std::vector<double>& h_plus,
+    std::vector<double>& h_cross) const
+{
+    const int nx = field.getNx();
+    const int ny = field.getNy();
+    const int nz = field.getNz();
+    const int total = field.getTotalPoints();
+    h_plus.resize(total);
+    h_cross.resize(total);
+
+    const SymmetryFieldConfig& grid = field.getConfig();
+    const double inv_2dx = 1.0 / (2.0 * grid.dx);
+    const double inv_2dy = 1.0 / (2.0 * grid.dy);
+    const double inv_2dz = 1.0 / (2.0 * grid.dz);
+    const std::complex<double>* phi = field.getDeltaPhiFlat().data();
+    const size_t stride_y = static_cast<size_t>(nx);
+    const size_t stride_z = static_cast<size_t>(nx) * ny;
+
+    const double (*plus_c)[3] = plus_coeff_;
+    const double (*cross_c)[3] = cross_coeff_;
+
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < nz; k++) {
+        for (int j = 0; j < ny; j++) {
+            const size_t row = stride_z * k + stride_y * j;
+            const bool boundary_row = (j == 0 || j == ny - 1 || k == 0 || k == nz - 1);
+            for (int i = 0; i < nx; i++) {
+                const size_t idx = row + i;
+                // Zero gradient on the boundary, as in computeGradient
+                if (boundary_row || i == 0 || i == nx - 1) {
+                    h_plus[idx] = 0.0;
+                    h_cross[idx] = 0.0;
+                    continue;
+                }
+                const double g[3] = {
+                    std::abs((phi[idx + 1] - phi[idx - 1]) * inv_2dx),
+                    std::abs((phi[idx + stride_y] - phi[idx - stride_y]) * inv_2dy),
+                    std::abs((phi[idx + stride_z] - phi[idx - stride_z]) * inv_2dz)
+                };
+                double plus = 0.0;
+                double cross = 0.0;
+                for (int a = 0; a < 3; a++) {
+                    for (int b = 0; b < 3; b++) {
+                        plus += plus_c[a][b] * g[a] * g[b];
+                        cross += cross_c[a][b] * g[a] * g[b];
+                    }
+                }
+                h_plus[idx] = plus;
+                h_cross[idx] = cross;
+            }
+        }
+    }
+}
+
 ProjectionOperators::CausalFlowVector ProjectionOperators::compute_causal_flow(
     const SymmetryField& field, int i, int j, int k) const
 {
@@ -201,28 +323,29 @@ Tensor4x4 ProjectionOperators::apply_TT_projection(const Tensor4x4& tensor) cons
     // h^TT_ij = (P_ik P_jl - 1/2 P_ij P_kl) h_kl
     //
     // where P_ij = δ_ij - n_i n_j is the transverse projector
-    // and n is the propagation direction
-
-    // For now, simple traceless-symmetric extraction
-    // (Full TT projection requires Fourier methods)
-
-    // Copy spatial part
-    for (int i = 1; i <= 3; i++) {
-        for (int j = 1; j <= 3; j++) {
-            TT_tensor(i, j) = tensor(i, j);
+    // and n is the detector direction (cached in projector_)
+
+    // Transverse part: (P h P)_ij and its trace P_kl h_kl
+    double PhP[3][3];
+    double transverse_trace = 0.0;
+    for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+            double sum = 0.0;
+            for (int c = 0; c < 3; c++) {
+                for (int d = 0; d < 3; d++) {
+                    sum += projector_[a][c] * tensor(c + 1, d + 1) * projector_[d][b];
+                }
+            }
+            PhP[a][b] = sum;
+            transverse_trace += projector_[a][b] * tensor(a + 1, b + 1);
         }
     }
 
-    // Make traceless
-    double trace = TT_tensor(1,1) + TT_tensor(2,2) + TT_tensor(3,3);
-    TT_tensor(1, 1) -= trace / 3.0;
-    TT_tensor(2, 2) -= trace / 3.0;
-    TT_tensor(3, 3) -= trace / 3.0;
-
-    // Zero out time components
-    for (int i = 0; i <= 3; i++) {
-        TT_tensor(0, i) = 0.0;
-        TT_tensor(i, 0) = 0.0;
+    // Spatial block; time components stay zero
+    for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+            TT_tensor(a + 1, b + 1) = PhP[a][b] - 0.5 * projector_[a][b] * transverse_trace;
+        }
     }
 
     return TT_tensor;
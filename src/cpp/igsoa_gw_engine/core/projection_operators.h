@@ -7,12 +7,18 @@
  * - B_μ-mode: Causal exchange flow
  *
  * The gravitational wave strain h(t) is extracted from O_μν.
+ *
+ * The transverse projector P = 1 - n nᵀ and the polarization tensors
+ * e₊ = e₁e₁ - e₂e₂, eₓ = e₁e₂ + e₂e₁ depend only on the detector direction
+ * n, so they are built once at construction. The *_field passes thread over
+ * z-planes and write into caller-owned buffers.
  */
 
 #pragma once
 
 #include "symmetry_field.h"
 #include <complex>
+#include <vector>
 
 namespace dase {
 namespace igsoa {
@@ -57,6 +63,12 @@ public:
      */
     std::vector<double> compute_phi_mode_field(const SymmetryField& field) const;
 
+    /**
+     * Compute φ-mode over entire field into a caller-owned buffer
+     * @param phi_field Output, resized to the grid (no allocation once sized)
+     */
+    void compute_phi_mode_field(const SymmetryField& field, std::vector<double>& phi_field) const;
+
     // === O_μν-mode: Tensor Projection ===
 
     /**
@@ -92,6 +104,21 @@ public:
         const SymmetryField& field
     ) const;
 
+    /**
+     * Compute h_+, h_× at every grid point for the configured detector
+     *
+     * Equivalent to compute_strain(compute_stress_energy_tensor(field, i, j, k),
+     * detector_normal) per point. The polarization tensors are traceless, so
+     * the -δ_ij L/3 part of O_ij drops out and only ∇δΦ is needed.
+     *
+     * @param h_plus, h_cross Outputs, resized to the grid
+     */
+    void compute_strain_field(
+        const SymmetryField& field,
+        std::vector<double>& h_plus,
+        std::vector<double>& h_cross
+    ) const;
+
     // === B_μ-mode: Causal Exchange ===
 
     /**
@@ -135,12 +162,26 @@ public:
 
     /**
      * Apply TT projection operator to tensor
+     * h^TT_ij = (P_ik P_jl - ½ P_ij P_kl) h_kl with the cached detector projector
      */
     Tensor4x4 apply_TT_projection(const Tensor4x4& tensor) const;
 
+    /**
+     * Polarization tensors for propagation direction n (need not be unit)
+     *
+     * e₁, e₂ are x̂, ŷ, ẑ Gram-Schmidt-orthogonalized against n, so n = ±ẑ
+     * gives e₊ = x̂x̂ - ŷŷ, eₓ = x̂ŷ + ŷx̂. Throws std::invalid_argument for n = 0.
+     */
+    static void polarization_tensors(const Vector3D& n, double plus[3][3], double cross[3][3]);
+
 private:
     ProjectionConfig config_;
 
+    // Detector-direction constants, built once by the constructor
+    double projector_[3][3];       // P_ij = δ_ij - n_i n_j
+    double plus_coeff_[3][3];      // e₊ = e₁e₁ - e₂e₂
+    double cross_coeff_[3][3];     // eₓ = e₁e₂ + e₂e₁
+
     // Helper: metric tensor g_μν (Minkowski for now)
     double metric(int mu, int nu) const;
 };
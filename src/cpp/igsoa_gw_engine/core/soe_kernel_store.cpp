@@ -0,0 +1,179 @@
+/**
+ * IGSOA GW Engine - Shared SOE Kernel Store Implementation
+ */
+
+#include "soe_kernel_store.h"
+#include "fractional_solver.h"
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'A', 'S', 'E', 'S', 'O', 'E', '1'};
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+void writeRaw(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readRaw(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+SOEKernelStore& SOEKernelStore::global() {
+    static SOEKernelStore store;
+    return store;
+}
+
+size_t SOEKernelStore::KeyHash::operator()(const Key& key) const {
+    uint64_t h = key.alpha_bits * 0x9E3779B97F4A7C15ull;
+    h ^= key.t_max_bits + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    h ^= static_cast<uint64_t>(key.rank) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    return static_cast<size_t>(h);
+}
+
+SOEKernelStore::Key SOEKernelStore::makeKey(double alpha, double T_max, int rank) {
+    // +0.0 and -0.0 are the same α
+    return Key{doubleBits(alpha + 0.0), doubleBits(T_max + 0.0), rank};
+}
+
+std::shared_ptr<const SOEKernel> SOEKernelStore::acquire(double alpha, double T_max, int rank) {
+    const Key key = makeKey(alpha, T_max, rank);
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = kernels_.find(key);
+        if (it != kernels_.end()) {
+            hits_++;
+            return it->second;
+        }
+    }
+
+    auto kernel = std::make_shared<SOEKernel>();
+    kernel->initialize(alpha, T_max, rank);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto inserted = kernels_.emplace(key, std::move(kernel));
+    if (inserted.second) {
+        fits_++;
+    } else {
+        hits_++;
+    }
+    return inserted.first->second;
+}
+
+bool SOEKernelStore::save(const std::string& path, std::string* error) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        if (error) *error = "Cannot write SOE kernel store: " + path;
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    out.write(kMagic, sizeof(kMagic));
+    writeRaw(out, kFitVersion);
+    writeRaw(out, static_cast<uint32_t>(kernels_.size()));
+    for (const auto& entry : kernels_) {
+        const SOEKernel& kernel = *entry.second;
+        double alpha, t_max;
+        std::memcpy(&alpha, &entry.first.alpha_bits, sizeof(alpha));
+        std::memcpy(&t_max, &entry.first.t_max_bits, sizeof(t_max));
+        writeRaw(out, alpha);
+        writeRaw(out, t_max);
+        writeRaw(out, static_cast<uint32_t>(kernel.rank));
+        writeRaw(out, uint32_t(0));
+        out.write(reinterpret_cast<const char*>(kernel.weights.data()),
+                  static_cast<std::streamsize>(kernel.rank * sizeof(double)));
+        out.write(reinterpret_cast<const char*>(kernel.exponents.data()),
+                  static_cast<std::streamsize>(kernel.rank * sizeof(double)));
+    }
+    if (!out) {
+        if (error) *error = "Failed writing SOE kernel store: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool SOEKernelStore::load(const std::string& path, std::string* error) {
+    auto fail = [error](const std::string& message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return fail("Cannot open SOE kernel store: " + path);
+    }
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0, count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !readRaw(in, version) || !readRaw(in, count)) {
+        return fail("Not an SOE kernel store: " + path);
+    }
+    if (version != kFitVersion) {
+        return fail("SOE kernel store was written by another kernel fit version");
+    }
+
+    // Read everything before touching the store
+    std::vector<std::pair<Key, std::shared_ptr<const SOEKernel>>> entries;
+    entries.reserve(count);
+    for (uint32_t n = 0; n < count; n++) {
+        double alpha = 0.0, t_max = 0.0;
+        uint32_t rank = 0, pad = 0;
+        if (!readRaw(in, alpha) || !readRaw(in, t_max) || !readRaw(in, rank) || !readRaw(in, pad) ||
+            rank == 0 || rank > 4096) {
+            return fail("Corrupt SOE kernel store: " + path);
+        }
+        auto kernel = std::make_shared<SOEKernel>();
+        kernel->rank = static_cast<int>(rank);
+        kernel->weights.resize(rank);
+        kernel->exponents.resize(rank);
+        if (!in.read(reinterpret_cast<char*>(kernel->weights.data()), static_cast<std::streamsize>(rank * sizeof(double))) ||
+            !in.read(reinterpret_cast<char*>(kernel->exponents.data()), static_cast<std::streamsize>(rank * sizeof(double)))) {
+            return fail("Truncated SOE kernel store: " + path);
+        }
+        entries.emplace_back(makeKey(alpha, t_max, static_cast<int>(rank)), std::move(kernel));
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (auto& entry : entries) {
+        kernels_.emplace(entry.first, std::move(entry.second));
+    }
+    return true;
+}
+
+void SOEKernelStore::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    kernels_.clear();
+}
+
+size_t SOEKernelStore::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return kernels_.size();
+}
+
+uint64_t SOEKernelStore::getFitCount() const {
+    return fits_.load();
+}
+
+uint64_t SOEKernelStore::getHitCount() const {
+    return hits_.load();
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
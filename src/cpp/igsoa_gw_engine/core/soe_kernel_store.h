@@ -0,0 +1,111 @@
+/**
+ * IGSOA GW Engine - Shared SOE Kernel Store
+ *
+ * Process-wide cache of fitted SOE kernels keyed by (α, T_max, rank).
+ * Every FractionalSolver resolves its kernels here, so α sweeps and
+ * refined patches running many solvers share one immutable copy of each
+ * kernel instead of refitting it per instance:
+ *
+ *   SOEKernelStore& store = SOEKernelStore::global();
+ *   store.load(SOEKernelStore::kDefaultPath);   // optional warm start
+ *   ... construct solvers, run the sweep ...
+ *   store.save(SOEKernelStore::kDefaultPath);
+ *
+ * Kernels are handed out as shared_ptr<const SOEKernel> and never change
+ * once stored, so readers need no lock after acquire(). Lookups take a
+ * shared lock; a miss fits the kernel outside the lock and inserts it
+ * under an exclusive one (a racing fit of the same key is discarded).
+ *
+ * The persisted file is little-endian binary, like FFTW wisdom a pure
+ * cache: a file written by a different kernel-fit version is ignored.
+ *
+ *   header  "DASESOE1", u32 fit_version, u32 count
+ *   entry   f64 alpha, f64 T_max, u32 rank, u32 0,
+ *           f64 weights[rank], f64 exponents[rank]
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+struct SOEKernel;  // fractional_solver.h
+
+class SOEKernelStore {
+public:
+    // Bump whenever SOEKernel::initialize changes its fit
+    static constexpr uint32_t kFitVersion = 1;
+
+    // Next to the Python CacheManager's fractional_kernels category
+    static constexpr const char* kDefaultPath = "./cache/fractional_kernels/soe_kernels.bin";
+
+    /**
+     * The store every FractionalSolver uses
+     */
+    static SOEKernelStore& global();
+
+    SOEKernelStore() = default;
+    SOEKernelStore(const SOEKernelStore&) = delete;
+    SOEKernelStore& operator=(const SOEKernelStore&) = delete;
+
+    /**
+     * Kernel for exactly (alpha, T_max, rank), fitted on first use
+     */
+    std::shared_ptr<const SOEKernel> acquire(double alpha, double T_max, int rank);
+
+    /**
+     * Write every stored kernel to path (replacing it)
+     */
+    bool save(const std::string& path, std::string* error = nullptr) const;
+
+    /**
+     * Add the kernels of a saved store; keys already present are kept.
+     * Returns false (store unchanged) if the file is missing, corrupt or
+     * from another fit version.
+     */
+    bool load(const std::string& path, std::string* error = nullptr);
+
+    /**
+     * Drop every kernel (solvers keep the ones they hold)
+     */
+    void clear();
+
+    size_t size() const;
+    uint64_t getFitCount() const;   // Kernels fitted by acquire() (not loaded)
+    uint64_t getHitCount() const;   // acquire() calls served from the store
+
+private:
+    struct Key {
+        uint64_t alpha_bits;
+        uint64_t t_max_bits;
+        int rank;
+
+        bool operator==(const Key& other) const {
+            return alpha_bits == other.alpha_bits && t_max_bits == other.t_max_bits && rank == other.rank;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    static Key makeKey(double alpha, double T_max, int rank);
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<Key, std::shared_ptr<const SOEKernel>, KeyHash> kernels_;
+    std::atomic<uint64_t> fits_{0};
+    std::atomic<uint64_t> hits_{0};
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
@@ -5,8 +5,10 @@
 #define _USE_MATH_DEFINES  // Enable M_PI on MSVC
 #include <cmath>
 #include "source_manager.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -140,40 +142,93 @@ std::vector<std::complex<double>> BinaryMerger::computeSourceTerms(
     const SymmetryField& field,
     double t) const
 {
-    int total_points = field.getTotalPoints();
-    std::vector<std::complex<double>> sources(total_points, std::complex<double>(0.0, 0.0));
+    std::vector<std::complex<double>> sources;
+    computeSourceTerms(field, t, sources);
+    return sources;
+}
+
+void BinaryMerger::computeSourceTerms(
+    const SymmetryField& field,
+    double t,
+    std::vector<std::complex<double>>& sources) const
+{
+    sources.resize(field.getTotalPoints());
+    std::fill(sources.begin(), sources.end(), std::complex<double>(0.0, 0.0));
+    addSourceTerms(field, t, sources);
+}
+
+void BinaryMerger::addSourceTerms(
+    const SymmetryField& field,
+    double t,
+    std::vector<std::complex<double>>& sources) const
+{
+    if (sources.size() != static_cast<size_t>(field.getTotalPoints())) {
+        throw std::invalid_argument("addSourceTerms: source buffer does not match the grid");
+    }
 
     // If merged, no more source terms
     if (has_merged_) {
-        return sources;
+        return;
     }
 
-    // Get grid configuration
-    const SymmetryFieldConfig& grid_config = field.getConfig();
-
-    // Compute sources for each grid point
-    for (int i = 0; i < grid_config.nx; i++) {
-        for (int j = 0; j < grid_config.ny; j++) {
-            for (int k = 0; k < grid_config.nz; k++) {
-                // Get position of this grid point
-                Vector3D pos = field.toPosition(i, j, k);
+    // Amplitude scales with mass, normalized to mass1
+    paintGaussian(field, position1_, config_.source_amplitude, sources);
+    paintGaussian(field, position2_, config_.source_amplitude * config_.mass2 / config_.mass1, sources);
+}
 
-                // Compute contribution from BH 1
-                std::complex<double> S1 = computeGaussianSource(
-                    pos, position1_, config_.mass1);
+void BinaryMerger::paintGaussian(
+    const SymmetryField& field,
+    const Vector3D& center,
+    double amplitude,
+    std::vector<std::complex<double>>& sources) const
+{
+    const SymmetryFieldConfig& grid = field.getConfig();
+    const double inv_two_sigma_sq = 1.0 / (2.0 * config_.gaussian_width * config_.gaussian_width);
+    const double cutoff = config_.source_truncation_sigma * config_.gaussian_width;
+    const bool truncate = config_.source_truncation_sigma > 0.0;
+
+    axis_weights_.resize(static_cast<size_t>(grid.nx + grid.ny + grid.nz));
+    double* weight_x = axis_weights_.data();
+    double* weight_y = weight_x + grid.nx;
+    double* weight_z = weight_y + grid.ny;
+
+    // Index range [lo, hi) within ±cutoff of c along one axis, and its factors
+    auto axisRange = [&](int n, double spacing, double c, double* weight, int& lo, int& hi) {
+        lo = 0;
+        hi = n;
+        if (truncate) {
+            lo = std::max(0, static_cast<int>(std::ceil((c - cutoff) / spacing)));
+            hi = std::min(n, static_cast<int>(std::floor((c + cutoff) / spacing)) + 1);
+        }
+        for (int i = lo; i < hi; i++) {
+            const double d = i * spacing - c;
+            weight[i] = std::exp(-d * d * inv_two_sigma_sq);
+        }
+    };
 
-                // Compute contribution from BH 2
-                std::complex<double> S2 = computeGaussianSource(
-                    pos, position2_, config_.mass2);
+    int i_lo, i_hi, j_lo, j_hi, k_lo, k_hi;
+    axisRange(grid.nx, grid.dx, center.x - grid.origin.x, weight_x, i_lo, i_hi);
+    axisRange(grid.ny, grid.dy, center.y - grid.origin.y, weight_y, j_lo, j_hi);
+    axisRange(grid.nz, grid.dz, center.z - grid.origin.z, weight_z, k_lo, k_hi);
+    if (i_lo >= i_hi || j_lo >= j_hi || k_lo >= k_hi) {
+        return;
+    }
 
-                // Total source
-                int idx = field.toFlatIndex(i, j, k);
-                sources[idx] = (S1 + S2) * config_.source_amplitude;
+    // Real parts only; std::complex<double> is layout-compatible with double[2]
+    double* out = reinterpret_cast<double*>(sources.data());
+    const int nx = grid.nx;
+    const int ny = grid.ny;
+
+    #pragma omp parallel for schedule(static)
+    for (int k = k_lo; k < k_hi; k++) {
+        for (int j = j_lo; j < j_hi; j++) {
+            const double row_weight = amplitude * weight_z[k] * weight_y[j];
+            double* row = out + 2 * (static_cast<size_t>(nx) * (j + static_cast<size_t>(ny) * k));
+            for (int i = i_lo; i < i_hi; i++) {
+                row[2 * i] += row_weight * weight_x[i];
             }
         }
     }
-
-    return sources;
 }
 
 // ============================================================================
@@ -296,29 +351,6 @@ void BinaryMerger::updatePositions() {
     position2_.z = config_.center.z;
 }
 
-std::complex<double> BinaryMerger::computeGaussianSource(
-    const Vector3D& position,
-    const Vector3D& bh_position,
-    double mass) const
-{
-    // Compute distance squared
-    double dx = position.x - bh_position.x;
-    double dy = position.y - bh_position.y;
-    double dz = position.z - bh_position.z;
-    double r_squared = dx*dx + dy*dy + dz*dz;
-
-    // Gaussian profile: A exp(-r²/(2σ²))
-    // Amplitude scales with mass
-    double sigma_squared = config_.gaussian_width * config_.gaussian_width;
-    double amplitude = mass / config_.mass1;  // Normalize to mass1
-
-    double gaussian = amplitude * std::exp(-r_squared / (2.0 * sigma_squared));
-
-    // Return as complex (real part only for now)
-    // Could add phase based on orbital motion for more realism
-    return std::complex<double>(gaussian, 0.0);
-}
-
 } // namespace gw
 } // namespace igsoa
 } // namespace dase
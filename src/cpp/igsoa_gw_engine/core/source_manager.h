@@ -45,6 +45,7 @@ struct BinaryMergerConfig {
     // Source amplitude parameters
     double gaussian_width;          // σ for asymmetry concentration (meters)
     double source_amplitude;        // Overall amplitude factor
+    double source_truncation_sigma; // Paint each Gaussian within ±this many σ (<= 0: whole grid)
 
     // Physics flags
     bool enable_inspiral;           // Enable GW radiation backreaction
@@ -59,6 +60,7 @@ struct BinaryMergerConfig {
         , center(0, 0, 0)
         , gaussian_width(5e3)           // 5 km
         , source_amplitude(1.0)
+        , source_truncation_sigma(6.0)  // exp(-18) ≈ 1.5e-8 at the cut
         , enable_inspiral(false)        // Start with circular orbit
         , merger_threshold(3.0)         // Merge at 3 R_s
     {}
@@ -119,6 +121,31 @@ public:
         const SymmetryField& field,
         double t) const;
 
+    /**
+     * Compute source terms into a caller-owned buffer
+     *
+     * @param sources Output, resized to the grid (no allocation once sized)
+     */
+    void computeSourceTerms(
+        const SymmetryField& field,
+        double t,
+        std::vector<std::complex<double>>& sources) const;
+
+    /**
+     * Accumulate source terms into an already-sized buffer
+     *
+     * Each Gaussian is painted only inside its bounding box of
+     * ±source_truncation_sigma·σ. The profile is separable, so the box is
+     * filled from three per-axis exp tables with one multiply-add per
+     * point along contiguous x rows; no exp is evaluated per grid point.
+     *
+     * @param sources Buffer of field.getTotalPoints() entries, added to
+     */
+    void addSourceTerms(
+        const SymmetryField& field,
+        double t,
+        std::vector<std::complex<double>>& sources) const;
+
     // ========================================================================
     // Query Methods
     // ========================================================================
@@ -225,6 +252,9 @@ private:
     double total_energy_radiated_;  // E_GW (Joules)
     bool has_merged_;
 
+    // Per-axis Gaussian factors for paintGaussian (nx + ny + nz entries)
+    mutable std::vector<double> axis_weights_;
+
     // Physical constants (CGS → SI conversions handled internally)
     static constexpr double G = 6.67430e-11;        // m³/(kg·s²)
     static constexpr double c = 299792458.0;        // m/s
@@ -260,16 +290,13 @@ private:
     void updatePositions();
 
     /**
-     * Compute Gaussian source amplitude at a point
-     * @param position Field point position
-     * @param bh_position BH position
-     * @param mass BH mass (for amplitude scaling)
-     * @return Complex source amplitude
+     * Add amplitude · exp(-|x - center|²/(2σ²)) over the truncation box
      */
-    std::complex<double> computeGaussianSource(
-        const Vector3D& position,
-        const Vector3D& bh_position,
-        double mass) const;
+    void paintGaussian(
+        const SymmetryField& field,
+        const Vector3D& center,
+        double amplitude,
+        std::vector<std::complex<double>>& sources) const;
 };
 
 } // namespace gw
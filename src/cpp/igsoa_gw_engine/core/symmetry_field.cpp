@@ -4,6 +4,7 @@
 
 #include "symmetry_field.h"
 #include "utils/logger.h"
+#include "checkpoint_file.h"
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
@@ -93,6 +94,7 @@ Tensor4x4 Tensor4x4::transpose() const {
 SymmetryFieldConfig::SymmetryFieldConfig()
     : nx(64), ny(64), nz(64)
     , dx(1000.0), dy(1000.0), dz(1000.0)  // 1 km grid spacing
+    , origin(0.0, 0.0, 0.0)
     , R_c_default(0.5)
     , kappa(1.0)
     , lambda(0.1)
@@ -108,6 +110,7 @@ SymmetryFieldConfig::SymmetryFieldConfig()
 
 SymmetryField::SymmetryField(const SymmetryFieldConfig& config)
     : config_(config)
+    , caches_valid_(true)
     , current_time_(0.0)
 {
     // Validate configuration before allocation
@@ -124,6 +127,7 @@ SymmetryField::SymmetryField(const SymmetryFieldConfig& config)
         alpha_.resize(total, config_.alpha_max);  // Start with no memory
         gradient_magnitude_.resize(total, 0.0);
         potential_.resize(total, 0.0);
+        laplacian_.resize(total, std::complex<double>(0.0, 0.0));
 
     } catch (const std::bad_alloc& e) {
         std::string error_msg = "Failed to allocate memory for SymmetryField: " +
@@ -248,6 +252,12 @@ void SymmetryField::setDeltaPhi(int i, int j, int k, std::complex<double> value)
     }
     int idx = toFlatIndex(i, j, k);
     delta_phi_[idx] = value;
+    caches_valid_ = false;
+}
+
+std::vector<std::complex<double>>& SymmetryField::deltaPhiForWrite() {
+    caches_valid_ = false;
+    return delta_phi_;
 }
 
 std::complex<double> SymmetryField::getDeltaPhiAt(const Vector3D& position) const {
@@ -365,16 +375,80 @@ double SymmetryField::getGradientMagnitude(int i, int j, int k) const {
 }
 
 void SymmetryField::updateGradientCache() {
-    // TODO: Loop over all grid points and compute gradients
-    for (int i = 1; i < config_.nx - 1; i++) {
-        for (int j = 1; j < config_.ny - 1; j++) {
-            for (int k = 1; k < config_.nz - 1; k++) {
-                Vector3D grad = computeGradient(i, j, k);
-                int idx = toFlatIndex(i, j, k);
-                gradient_magnitude_[idx] = grad.magnitude();
+    updateCaches();
+}
+
+void SymmetryField::updateCaches() {
+    const int nx = config_.nx;
+    const int ny = config_.ny;
+    const int nz = config_.nz;
+    const int rows = ny * nz;
+    const size_t plane = static_cast<size_t>(nx) * ny;
+
+    const double inv_dx2 = 1.0 / (config_.dx * config_.dx);
+    const double inv_dy2 = 1.0 / (config_.dy * config_.dy);
+    const double inv_dz2 = 1.0 / (config_.dz * config_.dz);
+    const double inv_2dx = 1.0 / (2.0 * config_.dx);
+    const double inv_2dy = 1.0 / (2.0 * config_.dy);
+    const double inv_2dz = 1.0 / (2.0 * config_.dz);
+    const double lambda = config_.lambda;
+    const double kappa = config_.kappa;
+
+    const std::complex<double>* phi = delta_phi_.data();
+    std::complex<double>* lap = laplacian_.data();
+    double* grad = gradient_magnitude_.data();
+    double* V = potential_.data();
+    const std::complex<double> zero(0.0, 0.0);
+
+    // Row (j, k) starts at flat index nx * (j + ny * k) = nx * row
+    #pragma omp parallel for schedule(static)
+    for (int row = 0; row < rows; row++) {
+        const int j = row % ny;
+        const int k = row / ny;
+        const size_t base = static_cast<size_t>(row) * nx;
+
+        // V(δΦ) = λ |δΦ|² + κ |δΦ|⁴ at every point
+        for (int i = 0; i < nx; i++) {
+            const double abs_phi_sq = std::norm(phi[base + i]);
+            V[base + i] = lambda * abs_phi_sq + kappa * abs_phi_sq * abs_phi_sq;
+        }
+
+        // Boundary rows and end points: zero Laplacian and gradient
+        if (j == 0 || j == ny - 1 || k == 0 || k == nz - 1 || nx < 3) {
+            for (int i = 0; i < nx; i++) {
+                lap[base + i] = zero;
+                grad[base + i] = 0.0;
             }
+            continue;
+        }
+        lap[base] = zero;
+        grad[base] = 0.0;
+        lap[base + nx - 1] = zero;
+        grad[base + nx - 1] = 0.0;
+
+        // Interior: neighbors at ±1 (x), ±nx (y), ±nx·ny (z)
+        for (int i = 1; i < nx - 1; i++) {
+            const size_t idx = base + i;
+            const std::complex<double> c = phi[idx];
+            const std::complex<double> xp = phi[idx + 1];
+            const std::complex<double> xm = phi[idx - 1];
+            const std::complex<double> yp = phi[idx + nx];
+            const std::complex<double> ym = phi[idx - nx];
+            const std::complex<double> zp = phi[idx + plane];
+            const std::complex<double> zm = phi[idx - plane];
+
+            lap[idx] = (xp - 2.0 * c + xm) * inv_dx2
+                     + (yp - 2.0 * c + ym) * inv_dy2
+                     + (zp - 2.0 * c + zm) * inv_dz2;
+
+            // |∇δΦ| = sqrt(|∂ₓ|² + |∂ᵧ|² + |∂_z|²)
+            grad[idx] = std::sqrt(std::norm((xp - xm) * inv_2dx)
+                                + std::norm((yp - ym) * inv_2dy)
+                                + std::norm((zp - zm) * inv_2dz));
         }
     }
+
+    caches_valid_ = true;
 }
 
 // === Effective Potential ===
@@ -412,15 +486,7 @@ double SymmetryField::getPotential(int i, int j, int k) const {
 }
 
 void SymmetryField::updatePotentialCache() {
-    // TODO: Loop over all grid points and compute potentials
-    for (int i = 0; i < config_.nx; i++) {
-        for (int j = 0; j < config_.ny; j++) {
-            for (int k = 0; k < config_.nz; k++) {
-                int idx = toFlatIndex(i, j, k);
-                potential_[idx] = computePotential(i, j, k);
-            }
-        }
-    }
+    updateCaches();
 }
 
 // === Field Evolution ===
@@ -441,57 +507,51 @@ void SymmetryField::evolveStep(
     // - V(δΦ)ψ = potential term
     // - S = source_terms (binary merger)
 
-    int total = getTotalPoints();
-    std::vector<std::complex<double>> new_field(total);
-
-    // Evolve each grid point
-    for (int i = 1; i < config_.nx - 1; i++) {
-        for (int j = 1; j < config_.ny - 1; j++) {
-            for (int k = 1; k < config_.nz - 1; k++) {
-                int idx = toFlatIndex(i, j, k);
-
-                // Get current field value
-                std::complex<double> psi = getDeltaPhi(i, j, k);
-
-                // Compute spatial derivatives (Laplacian)
-                std::complex<double> laplacian = computeLaplacian(i, j, k);
-
-                // Get fractional time derivative
-                std::complex<double> frac_deriv = fractional_derivatives[idx];
-
-                // Get potential
-                double V = getPotential(i, j, k);
+    // ∂²ₓψ and V(δΦ) of the current field
+    if (!caches_valid_) {
+        updateCaches();
+    }
 
-                // Get source term
-                std::complex<double> source = source_terms[idx];
+    const int nx = config_.nx;
+    const int ny = config_.ny;
+    const int nz = config_.nz;
+    const int rows = ny * nz;
+    const double dt = config_.dt;
+    std::complex<double>* phi = delta_phi_.data();
+    const std::complex<double>* lap = laplacian_.data();
+    const double* V = potential_.data();
+    const std::complex<double>* frac = fractional_derivatives.data();
+    const std::complex<double>* src = source_terms.data();
+
+    // Evolve interior points in place: every stencil read went into the caches
+    #pragma omp parallel for schedule(static)
+    for (int row = 0; row < rows; row++) {
+        const int j = row % ny;
+        const int k = row / ny;
+        if (j == 0 || j == ny - 1 || k == 0 || k == nz - 1) {
+            continue;
+        }
 
-                // Fractional wave equation right-hand side:
-                // RHS = ∂²ₓψ - ₀D^α_t ψ - V·ψ + S
-                std::complex<double> rhs = laplacian - frac_deriv - V * psi + source;
+        const size_t base = static_cast<size_t>(row) * nx;
+        for (int i = 1; i < nx - 1; i++) {
+            const size_t idx = base + i;
+            const std::complex<double> psi = phi[idx];
 
-                // Forward Euler step (simple first-order time integration)
-                // For production, use RK4 or other higher-order method
-                new_field[idx] = psi + config_.dt * rhs;
-            }
-        }
-    }
+            // Fractional wave equation right-hand side:
+            // RHS = ∂²ₓψ - ₀D^α_t ψ - V·ψ + S
+            const std::complex<double> rhs = lap[idx] - frac[idx] - V[idx] * psi + src[idx];
 
-    // Update field with new values (interior points only)
-    for (int i = 1; i < config_.nx - 1; i++) {
-        for (int j = 1; j < config_.ny - 1; j++) {
-            for (int k = 1; k < config_.nz - 1; k++) {
-                int idx = toFlatIndex(i, j, k);
-                delta_phi_[idx] = new_field[idx];
-            }
+            // Forward Euler step (simple first-order time integration)
+            // For production, use RK4 or other higher-order method
+            phi[idx] = psi + dt * rhs;
         }
     }
 
     // Boundary conditions: maintain current values at boundaries
     // (Zero-gradient boundary condition implicit)
 
-    // Update gradient and potential caches
-    updateGradientCache();
-    updatePotentialCache();
+    // Update Laplacian, gradient and potential caches
+    updateCaches();
 
     // Advance time
     current_time_ += config_.dt;
@@ -512,16 +572,16 @@ void SymmetryField::fromFlatIndex(int idx, int& i, int& j, int& k) const {
 
 Vector3D SymmetryField::toPosition(int i, int j, int k) const {
     return Vector3D(
-        i * config_.dx,
-        j * config_.dy,
-        k * config_.dz
+        config_.origin.x + i * config_.dx,
+        config_.origin.y + j * config_.dy,
+        config_.origin.z + k * config_.dz
     );
 }
 
 void SymmetryField::toIndices(const Vector3D& pos, int& i, int& j, int& k) const {
-    i = static_cast<int>(pos.x / config_.dx + 0.5);
-    j = static_cast<int>(pos.y / config_.dy + 0.5);
-    k = static_cast<int>(pos.z / config_.dz + 0.5);
+    i = static_cast<int>((pos.x - config_.origin.x) / config_.dx + 0.5);
+    j = static_cast<int>((pos.y - config_.origin.y) / config_.dy + 0.5);
+    k = static_cast<int>((pos.z - config_.origin.z) / config_.dz + 0.5);
 }
 
 // === Diagnostics ===
@@ -607,6 +667,37 @@ void SymmetryField::exportToFile(const std::string& filename) const {
     file.close();
 }
 
+// === Checkpoint/Restart ===
+
+void SymmetryField::saveCheckpoint(CheckpointWriter& writer) const {
+    const std::vector<uint64_t> dims = {uint64_t(config_.nx), uint64_t(config_.ny), uint64_t(config_.nz)};
+    writer.setEngineType("igsoa_gw");
+    writer.copyArray("field.dims", dims.data(), dims.size());
+    writer.addArray("field.delta_phi", delta_phi_.data(), delta_phi_.size());
+    writer.addArray("field.alpha", alpha_.data(), alpha_.size());
+    writer.addScalar("field.current_time", current_time_);
+}
+
+bool SymmetryField::loadCheckpoint(const CheckpointReader& reader, std::string* error) {
+    const std::vector<uint64_t> dims = {uint64_t(config_.nx), uint64_t(config_.ny), uint64_t(config_.nz)};
+    if (!checkCheckpointShape(reader, "igsoa_gw", dims, error, "field.dims")) {
+        return false;
+    }
+    double time = 0.0;
+    if (!reader.array<std::complex<double>>("field.delta_phi", delta_phi_.size()) ||
+        !reader.array<double>("field.alpha", alpha_.size()) ||
+        !reader.scalar("field.current_time", time)) {
+        if (error) *error = "Checkpoint is missing symmetry field sections";
+        return false;
+    }
+
+    reader.copyTo("field.delta_phi", delta_phi_.data(), delta_phi_.size());
+    reader.copyTo("field.alpha", alpha_.data(), alpha_.size());
+    current_time_ = time;
+    caches_valid_ = false;
+    return true;
+}
+
 // === Private Helpers ===
 
 bool SymmetryField::isValidIndex(int i, int j, int k) const {
@@ -619,9 +710,9 @@ std::complex<double> SymmetryField::interpolateDeltaPhi(const Vector3D& pos) con
     // Trilinear interpolation of δΦ at arbitrary position
 
     // Find grid cell containing position
-    double fx = pos.x / config_.dx;
-    double fy = pos.y / config_.dy;
-    double fz = pos.z / config_.dz;
+    double fx = (pos.x - config_.origin.x) / config_.dx;
+    double fy = (pos.y - config_.origin.y) / config_.dy;
+    double fz = (pos.z - config_.origin.z) / config_.dz;
 
     int i0 = static_cast<int>(std::floor(fx));
     int j0 = static_cast<int>(std::floor(fy));
@@ -674,9 +765,9 @@ double SymmetryField::interpolateAlpha(const Vector3D& pos) const {
     // Trilinear interpolation of α at arbitrary position
 
     // Find grid cell containing position
-    double fx = pos.x / config_.dx;
-    double fy = pos.y / config_.dy;
-    double fz = pos.z / config_.dz;
+    double fx = (pos.x - config_.origin.x) / config_.dx;
+    double fy = (pos.y - config_.origin.y) / config_.dy;
+    double fz = (pos.z - config_.origin.z) / config_.dz;
 
     int i0 = static_cast<int>(std::floor(fx));
     int j0 = static_cast<int>(std::floor(fy));
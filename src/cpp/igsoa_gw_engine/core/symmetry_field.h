@@ -14,8 +14,13 @@
 #include <complex>
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace dase {
+
+class CheckpointWriter;  // checkpoint_file.h
+class CheckpointReader;
+
 namespace igsoa {
 namespace gw {
 
@@ -60,6 +65,7 @@ struct SymmetryFieldConfig {
     // Grid dimensions
     int nx, ny, nz;          // Number of grid points in each dimension
     double dx, dy, dz;       // Grid spacing in meters
+    Vector3D origin;         // Position of point (0,0,0) (refined patches sit off zero)
 
     // Physical parameters
     double R_c_default;      // Default coupling constant
@@ -111,6 +117,11 @@ public:
      */
     void setDeltaPhi(int i, int j, int k, std::complex<double> value);
 
+    /**
+     * Mutable δΦ storage for bulk writes (invalidates the caches)
+     */
+    std::vector<std::complex<double>>& deltaPhiForWrite();
+
     /**
      * Get δΦ at physical position (interpolated)
      */
@@ -143,6 +154,12 @@ public:
      */
     std::vector<double> getAlphaValues() const;
 
+    /**
+     * Get flat array of all α values without copying
+     * @return Reference to internal storage
+     */
+    const std::vector<double>& getAlphaFlat() const { return alpha_; }
+
     // === Spatial Derivatives ===
 
     /**
@@ -165,6 +182,15 @@ public:
      */
     void updateGradientCache();
 
+    /**
+     * Update the Laplacian, gradient-magnitude and potential caches
+     *
+     * One threaded sweep over contiguous rows (x fastest); interior rows
+     * run without boundary checks, boundary points get zero Laplacian and
+     * gradient as in computeLaplacian/computeGradient.
+     */
+    void updateCaches();
+
     // === Effective Potential ===
 
     /**
@@ -184,7 +210,7 @@ public:
     double getPotential(int i, int j, int k) const;
 
     /**
-     * Update all potential cache
+     * Update all potential cache (refreshes every cache, see updateCaches)
      */
     void updatePotentialCache();
 
@@ -194,6 +220,10 @@ public:
      * Advance field by one timestep using fractional wave equation:
      * ∂²ₓ ψ - ₀D^α_t ψ - V(δΦ) ψ = S
      *
+     * Uses the cached Laplacian and potential of the current field (refreshed
+     * first if setDeltaPhi changed it), updates interior points in place in
+     * one threaded sweep, then refreshes all caches. No heap allocation.
+     *
      * @param fractional_derivatives Computed by FractionalSolver
      * @param source_terms Source S(x,t) from binary system
      */
@@ -277,6 +307,21 @@ public:
      */
     void exportToFile(const std::string& filename) const;
 
+    /**
+     * Append δΦ, α and the current time as "field.*" checkpoint sections
+     *
+     * Sections reference the field arrays; write (or snapshot) the
+     * checkpoint before the next evolveStep().
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const;
+
+    /**
+     * Restore δΦ, α and the current time from a checkpoint of the same grid
+     *
+     * Caches are invalidated. Returns false (field unchanged) on mismatch.
+     */
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error = nullptr);
+
 private:
     SymmetryFieldConfig config_;
 
@@ -285,6 +330,8 @@ private:
     std::vector<double> alpha_;                       // α(x,y,z) memory order
     std::vector<double> gradient_magnitude_;          // |∇δΦ| (cached)
     std::vector<double> potential_;                   // V(δΦ) (cached)
+    std::vector<std::complex<double>> laplacian_;     // ∇²δΦ (cached)
+    bool caches_valid_;                               // Caches match delta_phi_
 
     double current_time_;
 
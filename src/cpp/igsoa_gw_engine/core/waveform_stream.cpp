@@ -0,0 +1,255 @@
+/**
+ * IGSOA GW Engine - Binary Waveform Streaming Implementation
+ */
+
+#include "waveform_stream.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+namespace {
+
+void putU32(char* dst, uint32_t value) {
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+void putU64(char* dst, uint64_t value) {
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+template <typename T>
+T getRaw(const char* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+WaveformStreamWriter::~WaveformStreamWriter() {
+    if (writer_.joinable()) {
+        close();
+    }
+}
+
+bool WaveformStreamWriter::open(const std::string& path, const std::vector<GWDetector>& detectors,
+                                size_t block_frames) {
+    if (writer_.joinable() || detectors.empty() || block_frames == 0) {
+        return false;
+    }
+
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        return false;
+    }
+    path_ = path;
+    num_detectors_ = detectors.size();
+    block_frames_ = block_frames;
+    frames_recorded_ = 0;
+    closing_ = false;
+    failed_ = false;
+
+    char header[kHeaderBytes] = {};
+    std::memcpy(header, "DASEGWF1", 8);
+    putU32(header + 8, kVersion);
+    putU32(header + 12, static_cast<uint32_t>(num_detectors_));
+    putU64(header + 16, 0);
+    putU64(header + 24, frameBytes());
+    out_.write(header, sizeof(header));
+
+    std::vector<double> table;
+    table.reserve(6 * num_detectors_);
+    for (const GWDetector& d : detectors) {
+        table.insert(table.end(), {d.position.x, d.position.y, d.position.z, d.normal.x, d.normal.y, d.normal.z});
+    }
+    out_.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(double)));
+    bytes_written_ = kHeaderBytes + table.size() * sizeof(double);
+    if (!out_) {
+        return false;
+    }
+
+    for (size_t b = 0; b < blocks_.size(); b++) {
+        blocks_[b].frames.assign(block_frames_ * (1 + 2 * num_detectors_), 0.0);
+        blocks_[b].count = 0;
+        filled_[b] = false;
+    }
+    produce_index_ = 0;
+    consume_index_ = 0;
+
+    writer_ = std::thread([this]() { writerLoop(); });
+    return true;
+}
+
+double* WaveformStreamWriter::nextFrame() {
+    if (!writer_.joinable()) {
+        return nullptr;
+    }
+    if (blocks_[produce_index_].count == block_frames_ && !commitBlock()) {
+        return nullptr;
+    }
+    Block& block = blocks_[produce_index_];
+    double* frame = block.frames.data() + block.count * (1 + 2 * num_detectors_);
+    block.count++;
+    frames_recorded_++;
+    return frame;
+}
+
+bool WaveformStreamWriter::commitBlock() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (failed_) {
+        return false;
+    }
+    filled_[produce_index_] = true;
+    produce_index_ ^= 1;
+    block_ready_.notify_one();
+
+    const auto start = std::chrono::steady_clock::now();
+    block_free_.wait(lock, [this]() { return !filled_[produce_index_]; });
+    stall_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    blocks_[produce_index_].count = 0;
+    return !failed_;
+}
+
+bool WaveformStreamWriter::record(double t, const DetectorArray& array, const SymmetryField& field) {
+    if (array.size() != num_detectors_) {
+        return false;
+    }
+    double* frame = nextFrame();
+    if (!frame) {
+        return false;
+    }
+    frame[0] = t;
+    array.sample(field, frame + 1, frame + 1 + num_detectors_);
+    return true;
+}
+
+bool WaveformStreamWriter::append(double t, const double* h_plus, const double* h_cross) {
+    double* frame = nextFrame();
+    if (!frame) {
+        return false;
+    }
+    frame[0] = t;
+    std::copy(h_plus, h_plus + num_detectors_, frame + 1);
+    std::copy(h_cross, h_cross + num_detectors_, frame + 1 + num_detectors_);
+    return true;
+}
+
+bool WaveformStreamWriter::close() {
+    if (!writer_.joinable()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (blocks_[produce_index_].count > 0) {
+            filled_[produce_index_] = true;
+            produce_index_ ^= 1;
+        }
+        closing_ = true;
+    }
+    block_ready_.notify_one();
+    writer_.join();
+
+    // Frames on disk, patched into the header
+    const uint64_t data_bytes = kHeaderBytes + 6 * num_detectors_ * sizeof(double);
+    const uint64_t frames = (bytes_written_ - data_bytes) / frameBytes();
+    char count[8];
+    putU64(count, frames);
+    out_.seekp(16);
+    out_.write(count, sizeof(count));
+    out_.close();
+    return !failed_ && !out_.fail();
+}
+
+void WaveformStreamWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        block_ready_.wait(lock, [this]() { return filled_[consume_index_] || closing_; });
+        if (!filled_[consume_index_]) {
+            return;  // Closing and drained
+        }
+
+        // The producer only touches the other block while this one is filled
+        const Block& block = blocks_[consume_index_];
+        bool ok = !failed_;
+        lock.unlock();
+        if (ok) {
+            const uint64_t bytes = block.count * frameBytes();
+            out_.write(reinterpret_cast<const char*>(block.frames.data()), static_cast<std::streamsize>(bytes));
+            ok = static_cast<bool>(out_);
+            if (ok) bytes_written_ += bytes;
+        }
+        lock.lock();
+
+        if (!ok) {
+            failed_ = true;
+        }
+        filled_[consume_index_] = false;
+        consume_index_ ^= 1;
+        block_free_.notify_one();
+    }
+}
+
+bool readWaveformFile(const std::string& path, WaveformData& data, std::string* error) {
+    auto fail = [error](const std::string& message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return fail("Cannot open waveform file: " + path);
+    }
+    const uint64_t file_bytes = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+
+    char header[WaveformStreamWriter::kHeaderBytes];
+    if (file_bytes < sizeof(header) || !in.read(header, sizeof(header)) ||
+        std::memcmp(header, "DASEGWF1", 8) != 0) {
+        return fail("Not a waveform file: " + path);
+    }
+    if (getRaw<uint32_t>(header + 8) != WaveformStreamWriter::kVersion) {
+        return fail("Unsupported waveform file version");
+    }
+    const uint64_t detectors = getRaw<uint32_t>(header + 12);
+    const uint64_t frame_count = getRaw<uint64_t>(header + 16);
+    const uint64_t frame_bytes = getRaw<uint64_t>(header + 24);
+    const uint64_t table_bytes = 6 * detectors * sizeof(double);
+    if (detectors == 0 || frame_bytes != (1 + 2 * detectors) * sizeof(double) ||
+        file_bytes < sizeof(header) + table_bytes) {
+        return fail("Corrupt waveform file header");
+    }
+
+    std::vector<double> table(6 * detectors);
+    in.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table_bytes));
+    data.detectors.resize(detectors);
+    for (uint64_t d = 0; d < detectors; d++) {
+        const double* row = &table[6 * d];
+        data.detectors[d].position = Vector3D(row[0], row[1], row[2]);
+        data.detectors[d].normal = Vector3D(row[3], row[4], row[5]);
+    }
+
+    // Unclosed files (frame_count 0) keep every complete frame
+    const uint64_t available = (file_bytes - sizeof(header) - table_bytes) / frame_bytes;
+    const uint64_t frames = frame_count > 0 ? std::min(frame_count, available) : available;
+    std::vector<double> frame(1 + 2 * detectors);
+    data.time.resize(frames);
+    data.h_plus.resize(frames * detectors);
+    data.h_cross.resize(frames * detectors);
+    for (uint64_t k = 0; k < frames; k++) {
+        if (!in.read(reinterpret_cast<char*>(frame.data()), static_cast<std::streamsize>(frame_bytes))) {
+            return fail("Short read in waveform file");
+        }
+        data.time[k] = frame[0];
+        std::copy(frame.begin() + 1, frame.begin() + 1 + detectors, data.h_plus.begin() + k * detectors);
+        std::copy(frame.begin() + 1 + detectors, frame.end(), data.h_cross.begin() + k * detectors);
+    }
+    return true;
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
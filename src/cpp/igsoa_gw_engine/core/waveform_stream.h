@@ -0,0 +1,130 @@
+/**
+ * IGSOA GW Engine - Binary Waveform Streaming
+ *
+ * Records the DetectorArray time series into a preallocated block of
+ * frames and hands full blocks to a background writer thread. There are
+ * two blocks, so the step loop only waits when the disk falls a whole
+ * block behind:
+ *
+ *   WaveformStreamWriter writer;
+ *   writer.open("gw_waveform.gwf", array.detectors());
+ *   for (...) { step(); writer.record(t, array, field); }
+ *   writer.close();
+ *
+ * A .gwf file is little-endian: a fixed header, the detector table and
+ * fixed-size frames:
+ *
+ *   header  (64 bytes)  "DASEGWF1", u32 version, u32 num_detectors,
+ *                       u64 frame_count (0 until close), u64 frame_bytes,
+ *                       32 bytes padding
+ *   detectors           float64 {position x,y,z, normal x,y,z} per detector
+ *   frame k             float64 t, h_plus[D], h_cross[D]
+ *
+ * A file cut short by a crash (frame_count 0) holds every complete frame
+ * up to its size; readWaveformFile recovers them.
+ */
+
+#pragma once
+
+#include "detector_array.h"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+class WaveformStreamWriter {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint64_t kHeaderBytes = 64;
+
+    WaveformStreamWriter() = default;
+    ~WaveformStreamWriter();
+
+    WaveformStreamWriter(const WaveformStreamWriter&) = delete;
+    WaveformStreamWriter& operator=(const WaveformStreamWriter&) = delete;
+
+    /**
+     * Create the file, write the header and detector table, allocate both
+     * blocks of block_frames frames and start the writer thread
+     */
+    bool open(const std::string& path, const std::vector<GWDetector>& detectors, size_t block_frames = 4096);
+
+    /**
+     * Sample array at time t straight into the next frame
+     */
+    bool record(double t, const DetectorArray& array, const SymmetryField& field);
+
+    /**
+     * Append one frame of num_detectors h_+ and h_× values
+     */
+    bool append(double t, const double* h_plus, const double* h_cross);
+
+    /**
+     * Queue the partial block, drain the writer and patch frame_count;
+     * false if any write failed
+     */
+    bool close();
+
+    const std::string& path() const { return path_; }
+    size_t numDetectors() const { return num_detectors_; }
+    uint64_t frameBytes() const { return (1 + 2 * num_detectors_) * sizeof(double); }
+    uint64_t framesRecorded() const { return frames_recorded_; }
+    uint64_t bytesWritten() const { return bytes_written_; }   // Writer thread; final after close()
+    double stallMs() const { return stall_ms_; }                // Time spent waiting for a free block
+
+private:
+    struct Block {
+        std::vector<double> frames;   // block_frames * (1 + 2D)
+        size_t count = 0;
+    };
+
+    std::string path_;
+    std::ofstream out_;
+    size_t num_detectors_ = 0;
+    size_t block_frames_ = 0;
+    uint64_t frames_recorded_ = 0;
+    uint64_t bytes_written_ = 0;
+    double stall_ms_ = 0.0;
+
+    std::mutex mutex_;
+    std::condition_variable block_ready_;
+    std::condition_variable block_free_;
+    std::array<Block, 2> blocks_;
+    std::array<bool, 2> filled_{{false, false}};
+    size_t produce_index_ = 0;
+    size_t consume_index_ = 0;
+    bool closing_ = false;
+    bool failed_ = false;
+    std::thread writer_;
+
+    double* nextFrame();
+    bool commitBlock();
+    void writerLoop();
+};
+
+/**
+ * Contents of a .gwf file; h_plus / h_cross are frame-major
+ * ([frame * detectors.size() + d])
+ */
+struct WaveformData {
+    std::vector<GWDetector> detectors;
+    std::vector<double> time;
+    std::vector<double> h_plus;
+    std::vector<double> h_cross;
+
+    size_t frames() const { return time.size(); }
+};
+
+bool readWaveformFile(const std::string& path, WaveformData& data, std::string* error = nullptr);
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
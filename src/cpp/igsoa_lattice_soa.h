@@ -0,0 +1,323 @@
+/**
+ * IGSOA Lattice - Structure-of-Arrays Storage
+ *
+ * Stores the per-node state of an IGSOA lattice as separate, cache-line aligned
+ * arrays (psi_re, psi_im, phi, F, ...) instead of an array of IGSOAComplexNode.
+ *
+ * Motivation:
+ * - IGSOAComplexNode is ~104 bytes; the coupling loop only needs psi (16 bytes)
+ *   and the gradient pass only needs F (8 bytes), so AoS sweeps drag the rest
+ *   of each node through cache for nothing.
+ * - Contiguous per-field arrays let the compiler vectorize the local updates.
+ *
+ * The AoS IGSOAComplexNode remains the public compatibility view: engines
+ * convert with loadFrom()/storeTo() on demand and keep this lattice as the
+ * authoritative state while time-stepping.
+ *
+ * The lattice is templated on its floating-point type. IGSOALatticeSoA
+ * (double) is the engine state; IGSOALatticeSoAF32 is the working copy of
+ * the float32 stepping mode (IGSOAPrecision::Float), converted with
+ * assignFrom(). The bulk accessors take double buffers for either type.
+ */
+
+#pragma once
+
+#include "aligned_allocator.h"
+#include "igsoa_complex_node.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * Aligned allocator for lattice arrays (64-byte cache lines)
+ */
+template<typename T, std::size_t Alignment = 64>
+using LatticeAllocator = AlignedAllocator<T, Alignment>;
+
+template<typename T>
+using LatticeArray = std::vector<T, LatticeAllocator<T>>;
+
+/**
+ * IGSOA Lattice (SoA)
+ *
+ * One array per stored IGSOAComplexNode field, all of length size().
+ * Index i addresses the same node in every array (row-major for 2D/3D).
+ * The entropy rate, T_IGS and phase are functions of the stored planes
+ * and are evaluated when read (entropyRate(), phase()), never per step.
+ */
+template<typename Real>
+struct IGSOALatticeSoAT {
+    using value_type = Real;
+
+    // Quantum state Ψ and ∂Ψ/∂t (split into real/imaginary planes)
+    LatticeArray<Real> psi_re;
+    LatticeArray<Real> psi_im;
+    LatticeArray<Real> psi_dot_re;
+    LatticeArray<Real> psi_dot_im;
+
+    // Realized causal field Φ and ∂Φ/∂t
+    LatticeArray<Real> phi;
+    LatticeArray<Real> phi_dot;
+
+    // Informational density and gradient
+    LatticeArray<Real> F;
+    LatticeArray<Real> F_gradient;
+
+    // Causal resistance
+    LatticeArray<Real> R_c;
+
+    // Coupling parameters
+    LatticeArray<Real> kappa;
+    LatticeArray<Real> gamma;
+
+    // Harmonic analysis
+    LatticeArray<uint32_t> harmonic_count;
+
+    IGSOALatticeSoAT() = default;
+
+    explicit IGSOALatticeSoAT(size_t num_nodes) {
+        resize(num_nodes);
+    }
+
+    size_t size() const {
+        return psi_re.size();
+    }
+
+    /**
+     * Resize all arrays; new nodes take IGSOAComplexNode defaults
+     */
+    void resize(size_t num_nodes) {
+        const IGSOAComplexNode defaults;
+        psi_re.resize(num_nodes, static_cast<Real>(defaults.psi.real()));
+        psi_im.resize(num_nodes, static_cast<Real>(defaults.psi.imag()));
+        psi_dot_re.resize(num_nodes, static_cast<Real>(defaults.psi_dot.real()));
+        psi_dot_im.resize(num_nodes, static_cast<Real>(defaults.psi_dot.imag()));
+        phi.resize(num_nodes, static_cast<Real>(defaults.phi));
+        phi_dot.resize(num_nodes, static_cast<Real>(defaults.phi_dot));
+        F.resize(num_nodes, static_cast<Real>(defaults.F));
+        F_gradient.resize(num_nodes, static_cast<Real>(defaults.F_gradient));
+        R_c.resize(num_nodes, static_cast<Real>(defaults.R_c));
+        kappa.resize(num_nodes, static_cast<Real>(defaults.kappa));
+        gamma.resize(num_nodes, static_cast<Real>(defaults.gamma));
+        harmonic_count.resize(num_nodes, defaults.harmonic_count);
+    }
+
+    /**
+     * Give every node the same R_c, κ and γ (engine construction)
+     */
+    void fillParameters(double R_c_value, double kappa_value, double gamma_value) {
+        std::fill(R_c.begin(), R_c.end(), static_cast<Real>(R_c_value));
+        std::fill(kappa.begin(), kappa.end(), static_cast<Real>(kappa_value));
+        std::fill(gamma.begin(), gamma.end(), static_cast<Real>(gamma_value));
+    }
+
+    /**
+     * Zero the evolving state of every node (Ψ, Ψ̇, Φ, Φ̇, F, ∇F, harmonic
+     * count); R_c, κ and γ are kept
+     */
+    void clearState() {
+        for (LatticeArray<Real>* plane : {&psi_re, &psi_im, &psi_dot_re, &psi_dot_im,
+                                          &phi, &phi_dot, &F, &F_gradient}) {
+            std::fill(plane->begin(), plane->end(), Real(0));
+        }
+        std::fill(harmonic_count.begin(), harmonic_count.end(), 0u);
+    }
+
+    /**
+     * Copy the planes a step rewrites (Ψ, Ψ̇, Φ, Φ̇, F, ∇F) into snapshot,
+     * reusing its storage; R_c, κ, γ and the harmonic counts stay out
+     */
+    void saveStepState(IGSOALatticeSoAT& snapshot) const {
+        for (Plane plane : stepPlanes()) snapshot.*plane = this->*plane;
+    }
+
+    // Put back the planes saveStepState() copied
+    void restoreStepState(const IGSOALatticeSoAT& snapshot) {
+        for (Plane plane : stepPlanes()) this->*plane = snapshot.*plane;
+    }
+
+    /**
+     * Entropy production rate of node i: Ṡ_i = R_c (Φ - Re[Ψ])²
+     */
+    double entropyRate(size_t i) const {
+        const double diff = static_cast<double>(phi[i]) - static_cast<double>(psi_re[i]);
+        return static_cast<double>(R_c[i]) * diff * diff;
+    }
+
+    /**
+     * Phase of node i: arg(Ψ_i)
+     */
+    double phase(size_t i) const {
+        return std::atan2(static_cast<double>(psi_im[i]), static_cast<double>(psi_re[i]));
+    }
+
+    /**
+     * Copy a single node into the lattice (its entropy_rate is derived, not read)
+     */
+    void setNode(size_t i, const IGSOAComplexNode& node) {
+        psi_re[i] = static_cast<Real>(node.psi.real());
+        psi_im[i] = static_cast<Real>(node.psi.imag());
+        psi_dot_re[i] = static_cast<Real>(node.psi_dot.real());
+        psi_dot_im[i] = static_cast<Real>(node.psi_dot.imag());
+        phi[i] = static_cast<Real>(node.phi);
+        phi_dot[i] = static_cast<Real>(node.phi_dot);
+        F[i] = static_cast<Real>(node.F);
+        F_gradient[i] = static_cast<Real>(node.F_gradient);
+        R_c[i] = static_cast<Real>(node.R_c);
+        kappa[i] = static_cast<Real>(node.kappa);
+        gamma[i] = static_cast<Real>(node.gamma);
+        harmonic_count[i] = node.harmonic_count;
+    }
+
+    /**
+     * Reassemble a single node from the lattice (AoS view)
+     */
+    IGSOAComplexNode getNode(size_t i) const {
+        IGSOAComplexNode node;
+        node.psi = std::complex<double>(psi_re[i], psi_im[i]);
+        node.psi_dot = std::complex<double>(psi_dot_re[i], psi_dot_im[i]);
+        node.phi = phi[i];
+        node.phi_dot = phi_dot[i];
+        node.F = F[i];
+        node.F_gradient = F_gradient[i];
+        node.R_c = R_c[i];
+        node.entropy_rate = entropyRate(i);
+        node.kappa = kappa[i];
+        node.gamma = gamma[i];
+        node.harmonic_count = harmonic_count[i];
+        return node;
+    }
+
+    /**
+     * Load the whole lattice from an AoS node array (resizes to match)
+     */
+    void loadFrom(const std::vector<IGSOAComplexNode>& nodes) {
+        if (size() != nodes.size()) {
+            resize(nodes.size());
+        }
+        for (size_t i = 0; i < nodes.size(); i++) {
+            setNode(i, nodes[i]);
+        }
+    }
+
+    /**
+     * Store the whole lattice into an AoS node array (resizes to match)
+     */
+    void storeTo(std::vector<IGSOAComplexNode>& nodes) const {
+        if (nodes.size() != size()) {
+            nodes.resize(size());
+        }
+        for (size_t i = 0; i < nodes.size(); i++) {
+            nodes[i] = getNode(i);
+        }
+    }
+
+    /**
+     * Bulk field access for nodes [first, first + count)
+     *
+     * Caller buffers are addressed with an element stride, so one half of an
+     * interleaved complex array is (buf, stride 2) / (buf + 1, stride 2).
+     * The range must fit size(). writePsi refreshes F the way
+     * IGSOAComplexNode::updateInformationalDensity does.
+     */
+    void writePsi(size_t first, size_t count, const double* re, const double* im, size_t stride = 1) {
+        for (size_t k = 0; k < count; k++) {
+            const size_t i = first + k;
+            const Real r = static_cast<Real>(re[k * stride]);
+            const Real m = static_cast<Real>(im[k * stride]);
+            psi_re[i] = r;
+            psi_im[i] = m;
+            F[i] = r * r + m * m;
+        }
+    }
+
+    void readPsi(size_t first, size_t count, double* re, double* im, size_t stride = 1) const {
+        for (size_t k = 0; k < count; k++) {
+            re[k * stride] = psi_re[first + k];
+            im[k * stride] = psi_im[first + k];
+        }
+    }
+
+    void writePhi(size_t first, size_t count, const double* values, size_t stride = 1) {
+        for (size_t k = 0; k < count; k++) {
+            phi[first + k] = static_cast<Real>(values[k * stride]);
+        }
+    }
+
+    void readPhi(size_t first, size_t count, double* values, size_t stride = 1) const {
+        for (size_t k = 0; k < count; k++) {
+            values[k * stride] = phi[first + k];
+        }
+    }
+
+    void readF(size_t first, size_t count, double* values, size_t stride = 1) const {
+        for (size_t k = 0; k < count; k++) {
+            values[k * stride] = F[first + k];
+        }
+    }
+
+    /**
+     * Copy every array from a lattice of another precision (resizes to match)
+     */
+    template<typename Other>
+    void assignFrom(const IGSOALatticeSoAT<Other>& other) {
+        if (size() != other.size()) {
+            resize(other.size());
+        }
+        convertArray(other.psi_re, psi_re);
+        convertArray(other.psi_im, psi_im);
+        convertArray(other.psi_dot_re, psi_dot_re);
+        convertArray(other.psi_dot_im, psi_dot_im);
+        convertArray(other.phi, phi);
+        convertArray(other.phi_dot, phi_dot);
+        convertArray(other.F, F);
+        convertArray(other.F_gradient, F_gradient);
+        convertArray(other.R_c, R_c);
+        convertArray(other.kappa, kappa);
+        convertArray(other.gamma, gamma);
+        harmonic_count = other.harmonic_count;
+    }
+
+    /**
+     * Heap bytes held by the lattice arrays
+     */
+    size_t getMemoryUsage() const {
+        return estimateMemoryUsage(size());
+    }
+
+    // Heap bytes of a lattice of num_nodes nodes
+    static size_t estimateMemoryUsage(size_t num_nodes) {
+        return num_nodes * (11 * sizeof(Real) + sizeof(uint32_t));
+    }
+
+private:
+    using Plane = LatticeArray<Real> IGSOALatticeSoAT::*;
+
+    static std::array<Plane, 8> stepPlanes() {
+        return {&IGSOALatticeSoAT::psi_re, &IGSOALatticeSoAT::psi_im,
+                &IGSOALatticeSoAT::psi_dot_re, &IGSOALatticeSoAT::psi_dot_im,
+                &IGSOALatticeSoAT::phi, &IGSOALatticeSoAT::phi_dot,
+                &IGSOALatticeSoAT::F, &IGSOALatticeSoAT::F_gradient};
+    }
+
+    template<typename From, typename To>
+    static void convertArray(const LatticeArray<From>& from, LatticeArray<To>& to) {
+        for (size_t i = 0; i < from.size(); i++) {
+            to[i] = static_cast<To>(from[i]);
+        }
+    }
+};
+
+using IGSOALatticeSoA = IGSOALatticeSoAT<double>;     // Engine state
+using IGSOALatticeSoAF32 = IGSOALatticeSoAT<float>;   // float32 working copy
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,134 @@
+/**
+ * IGSOA Parareal - Parallel-in-Time Lattice Missions
+ *
+ * Lattice state algebra and the runParareal driver shared by the 1D/2D/3D
+ * complex engines (see parareal.h). Every floating-point plane of
+ * IGSOALatticeSoA is corrected, including the derived ones, so a
+ * converged iterate is the fine state plane for plane. harmonic_count is
+ * taken from the fine propagation.
+ *
+ * Workers copy the engine configuration. Each worker builds its coupling
+ * caches serially before the first concurrent sweep, as FFT planning is
+ * not thread safe. Only undriven missions are supported; the active region
+ * mask is not used.
+ */
+
+#pragma once
+
+#include "igsoa_checkpoint.h"
+#include "igsoa_complex_node.h"
+#include "igsoa_lattice_soa.h"
+#include "parareal.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+struct IGSOALatticePararealOps {
+    using State = IGSOALatticeSoA;
+
+    static void correct(const State& g_new, const State& f_old, const State& g_old, State& out) {
+        if (out.size() != g_new.size()) out.resize(g_new.size());
+        const size_t n = g_new.size();
+        forEachPlane(out, g_new, f_old, g_old, [n](double* o, const double* g, const double* f, const double* g0) {
+            #pragma omp parallel for schedule(static)
+            for (long long i = 0; i < static_cast<long long>(n); i++) {
+                o[i] = g[i] + (f[i] - g0[i]);
+            }
+        });
+        out.harmonic_count = f_old.harmonic_count;
+    }
+
+    // Scaled change of the evolved planes (Ψ, ∂Ψ/∂t, Φ, ∂Φ/∂t)
+    static double change(const State& a, const State& b) {
+        double diff = 0.0, scale = 0.0;
+        const size_t n = b.size();
+        for (const auto plane : {&State::psi_re, &State::psi_im, &State::psi_dot_re,
+                                 &State::psi_dot_im, &State::phi, &State::phi_dot}) {
+            const double* x = (a.*plane).data();
+            const double* y = (b.*plane).data();
+            #pragma omp parallel for schedule(static) reduction(max:diff, scale)
+            for (long long i = 0; i < static_cast<long long>(n); i++) {
+                diff = std::max(diff, std::abs(x[i] - y[i]));
+                scale = std::max(scale, std::abs(y[i]));
+            }
+        }
+        return diff / (1.0 + scale);
+    }
+
+    // Planes are referenced, not copied: the iterate is written before it changes
+    static void save(CheckpointWriter& writer, const std::string& name, const State& state) {
+        forEachLatticePlane(state, [&](const char* plane_name, const auto& plane) {
+            writer.addArray(name + "_" + plane_name, plane.data(), plane.size());
+        });
+    }
+
+    static bool load(const CheckpointReader& reader, const std::string& name, State& state) {
+        bool complete = true;
+        forEachLatticePlane(state, [&](const char* plane_name, auto& plane) {
+            complete = complete && reader.copyTo(name + "_" + plane_name, plane.data(), plane.size());
+        });
+        return complete;
+    }
+
+private:
+    template<typename Fn>
+    static void forEachPlane(State& out, const State& g_new, const State& f_old, const State& g_old, Fn&& fn) {
+        for (const auto plane : {&State::psi_re, &State::psi_im, &State::psi_dot_re, &State::psi_dot_im,
+                                 &State::phi, &State::phi_dot, &State::F, &State::F_gradient,
+                                 &State::R_c, &State::kappa, &State::gamma}) {
+            fn((out.*plane).data(), (g_new.*plane).data(), (f_old.*plane).data(), (g_old.*plane).data());
+        }
+    }
+};
+
+/**
+ * runParareal of the IGSOA lattice engines
+ *
+ * make(config) builds a worker engine for config; advance(worker, in,
+ * steps, out) loads in, runs steps undriven and copies the lattice out.
+ * current_time / total_steps are the engine counters, advanced by
+ * num_steps on return.
+ */
+template<typename Engine, typename Make, typename Advance>
+inline PararealStats runIGSOAParareal(const char* engine_type, std::vector<uint64_t> dims,
+                                      IGSOALatticeSoA& lattice, const IGSOAComplexConfig& config,
+                                      double& current_time, uint64_t& total_steps, uint64_t num_steps,
+                                      const PararealConfig& parareal, Make make, Advance advance) {
+    if (num_steps == 0) return PararealStats();
+    const size_t threads = pararealThreads();
+    PararealSchedule schedule;
+    schedule.num_steps = num_steps;
+    schedule.slices = static_cast<size_t>(std::min<uint64_t>(parareal.slices > 0 ? parareal.slices : threads, num_steps));
+
+    auto step = [advance](Engine& worker, const IGSOALatticeSoA& in, uint64_t, uint64_t steps,
+                          IGSOALatticeSoA& out, double, uint64_t) {
+        advance(worker, in, steps, out);
+    };
+    auto build = [&](double multiple, bool coarse) {
+        IGSOAComplexConfig worker_config = config;
+        worker_config.dt = config.dt * multiple;
+        if (coarse && parareal.coarse_float) worker_config.precision = IGSOAPrecision::Float;
+        std::unique_ptr<Engine> worker = make(worker_config);
+        IGSOALatticeSoA warm;
+        advance(*worker, lattice, 0, warm);
+        return worker;
+    };
+    PararealEngines<Engine, IGSOALatticeSoA, IGSOALatticePararealOps, decltype(step)> problem(
+        engine_type, std::move(dims), schedule, std::min(threads, schedule.slices),
+        parareal.coarse_stride, current_time, total_steps, build, step);
+
+    std::vector<IGSOALatticeSoA> u(1, lattice);
+    const PararealStats stats = runParareal(problem, u, parareal);
+    lattice = u.back();   // Copied into the engine's storage (file-backed when out of core)
+    current_time = problem.startTime() + static_cast<double>(num_steps) * config.dt;
+    total_steps = problem.startStep() + num_steps;
+    return stats;
+}
+
+} // namespace igsoa
+} // namespace dase
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <iostream>
 #include <vector>
 
 namespace dase {
@@ -193,9 +194,8 @@ public:
     /**
      * Update derived quantities:
      * - F = |Ψ|² (informational density)
-     * - T_IGS = F (informational temperature)
-     * - phase = arg(Ψ)
      * - Ṡ = R_c(Φ - Re[Ψ])² (entropy production)
+     * T_IGS and phase are derived from the node on read
      */
     static uint64_t updateDerivedQuantities(
         std::vector<IGSOAComplexNode>& nodes
@@ -203,7 +203,6 @@ public:
         uint64_t operations = 0;
         for (auto& node : nodes) {
             node.updateInformationalDensity();  // F = |Ψ|²
-            node.updatePhase();                  // phase = arg(Ψ)
             node.updateEntropyRate();            // Ṡ = R_c(Φ - Re[Ψ])²
             operations++;
         }
@@ -254,7 +253,7 @@ public:
      * Performs one complete integration step:
      * 1. Evolve quantum state Ψ
      * 2. Evolve causal field Φ
-     * 3. Update derived quantities (F, T_IGS, phase, Ṡ)
+     * 3. Update derived quantities (F, Ṡ)
      * 4. Compute gradients
      * 5. Optionally normalize states
      */
@@ -227,7 +227,6 @@ public:
         uint64_t operations = 0;
         for (auto& node : nodes) {
             node.updateInformationalDensity();  // F = |Ψ|²
-            node.updatePhase();                  // phase = arg(Ψ)
             node.updateEntropyRate();            // Ṡ = R_c(Φ - Re[Ψ])²
             operations++;
         }
@@ -299,7 +298,7 @@ public:
      * Performs one complete integration step:
      * 1. Evolve quantum state Ψ (2D coupling)
      * 2. Evolve causal field Φ
-     * 3. Update derived quantities (F, T_IGS, phase, Ṡ)
+     * 3. Update derived quantities (F, Ṡ)
      * 4. Compute 2D gradients
      * 5. Optionally normalize states
      */
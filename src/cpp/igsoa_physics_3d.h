@@ -9,6 +9,7 @@
 #pragma once
 
 #include "igsoa_complex_node.h"
+#include "igsoa_physics.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
@@ -153,7 +154,6 @@ public:
         uint64_t operations = 0;
         for (auto& node : nodes) {
             node.updateInformationalDensity();
-            node.updatePhase();
             node.updateEntropyRate();
             operations++;
         }
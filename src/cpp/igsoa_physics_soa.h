@@ -0,0 +1,2557 @@
+/**
+ * IGSOA Physics Implementation - Structure-of-Arrays Kernels
+ *
+ * Same evolution equations as IGSOAPhysics / IGSOAPhysics2D / IGSOAPhysics3D,
+ * operating on IGSOALatticeSoA instead of std::vector<IGSOAComplexNode>.
+ *
+ * Each sweep only touches the arrays it needs:
+ * - Quantum evolution: psi_re, psi_im, phi, kappa, gamma, R_c (+ psi_dot write)
+ * - Causal field:      phi, psi_re, kappa, gamma (+ phi_dot write)
+ * - Gradients:         F (+ F_gradient write)
+ *
+ * Update order and arithmetic match the AoS kernels (in-place sweep, forward
+ * Euler), so both paths produce the same trajectories.
+ *
+ * When the lattice has a uniform R_c, the 2D/3D coupling can run from a
+ * precomputed CouplingStencil2D/3D instead of the bounding-box search, or as
+ * an FFT convolution (SpectralCoupling) when R_c is large.
+ *
+ * The stencil coupling and the local stages are templated on the lattice
+ * precision so the engines' float32 mode (IGSOALatticeSoAF32) runs the same
+ * code; reductions (energy, entropy) always accumulate in double. The
+ * bounding-box, neighbor-cache and spectral paths are double only.
+ *
+ * On the 1D ring the exponential kernel with a uniform R_c can also run as
+ * a recursive filter (evolveQuantumState1DRecursive), O(N) for any R_c.
+ *
+ * The engines run a whole mission through runSteps(): one parallel region
+ * with a static block of rows per thread, the serial Ψ sweep on thread 0,
+ * and the causal field, derived quantities and normalization fused into
+ * one pass over each thread's rows. runActiveSteps() does the same over the
+ * stepped tiles of an IGSOAActiveRegion only. For an integer R_c of 1..5
+ * the stencil sweep has unrolled, compile-time specializations
+ * (evolveQuantumState2DFixed/3DFixed, chosen by fixedKernel2D/3D).
+ * runRK4Steps() is the runSteps() of IGSOAIntegrator::RK4: four parallel
+ * stage sweeps per step over Jacobi coupling rows (stencilCouplingRow2D/3D,
+ * boxCoupling1D/2D/3D, neighbor lists or the spectral convolution).
+ * The register-blocked gathers of both sweeps also exist as AVX2 and
+ * AVX-512 builds, picked per row from activeSimdLevel() (cpu_dispatch.h).
+ */
+
+#pragma once
+
+#include "cpu_dispatch.h"
+#include "igsoa_active_region.h"
+#include "igsoa_complex_node.h"
+#include "igsoa_coupling_stencil.h"
+#include "igsoa_diagnostics.h"
+#include "igsoa_lattice_soa.h"
+#include "igsoa_spectral_coupling.h"
+#include "neighbor_cache.h"
+#include "out_of_core.h"
+#include "phase_profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace dase {
+namespace igsoa {
+
+// Time-step phases of the IGSOA engines (PhaseProfiler slots)
+enum IGSOAStepPhase : size_t {
+    IGSOA_PHASE_DRIVING = 0,     // applyDriving
+    IGSOA_PHASE_QUANTUM,         // Ψ coupling update (stencil / cache / FFT)
+    IGSOA_PHASE_CAUSAL,          // evolveCausalField (runSteps: fused causal/derived/normalize pass)
+    IGSOA_PHASE_DERIVED,         // updateDerivedQuantities
+    IGSOA_PHASE_GRADIENTS,       // computeGradients1D/2D/3D
+    IGSOA_PHASE_NORMALIZE,       // normalizeStates
+    IGSOA_PHASE_TRANSFER,        // AoS / float32 copies around a mission
+    IGSOA_PHASE_ACTIVE_MASK,     // active-region tile scan and mask update
+    IGSOA_PHASE_OBSERVABLES      // observable time series (IGSOAObservableRecorder)
+};
+
+class IGSOAStepProfiler : public PhaseProfiler {
+public:
+    IGSOAStepProfiler()
+        : PhaseProfiler({"driving", "quantum_evolve", "causal_field", "derived_quantities",
+                         "gradients", "normalize", "transfer", "active_mask",
+                         "observables"}) {}
+};
+
+/**
+ * Stage state of the RK4 integrator (IGSOAIntegrator::RK4)
+ *
+ * Stages alternate between two copies of Ψ and Φ (the input of stage s + 1
+ * is state + c·dt·k_s), while the weighted sum of the stage derivatives
+ * builds up in the lattice's psi_dot / phi_dot planes: six planes beyond
+ * the lattice, allocated once by the engine.
+ */
+template<typename Real>
+struct IGSOARK4StagesT {
+    LatticeArray<Real> psi_re[2];
+    LatticeArray<Real> psi_im[2];
+    LatticeArray<Real> phi[2];
+
+    size_t size() const { return phi[0].size(); }
+
+    void resize(size_t num_nodes) {
+        for (int b = 0; b < 2; b++) {
+            psi_re[b].resize(num_nodes);
+            psi_im[b].resize(num_nodes);
+            phi[b].resize(num_nodes);
+        }
+    }
+
+    size_t getMemoryUsage() const {
+        return estimateMemoryUsage(size());
+    }
+
+    static size_t estimateMemoryUsage(size_t num_nodes) {
+        return 6 * num_nodes * sizeof(Real);
+    }
+};
+
+using IGSOARK4Stages = IGSOARK4StagesT<double>;
+using IGSOARK4StagesF32 = IGSOARK4StagesT<float>;
+
+/**
+ * Bands of the parallel Euler Ψ sweep (IGSOAPhysicsSoA::runSteps)
+ *
+ * The sweep updates Ψ in place in raster order, and with periodic wrap
+ * every node reads the one visited before it, so no split of that order
+ * across threads reproduces it. Instead the slabs of the slowest axis
+ * (nodes in 1D, rows in 2D, z-planes in 3D) are cut into at most
+ * kMaxBands bands, each at least `reach` slabs thick (the coupling's
+ * largest offset along that axis), and
+ * colored so that neighboring bands differ: two colors, and a third for
+ * the last band of an odd count. Bands of one color share no coupling, so
+ * they sweep in parallel, each in raster order; a band reads the bands of
+ * earlier colors advanced and those of later colors not yet
+ * (block red-black Gauss-Seidel). The bands depend only on the lattice
+ * and the reach, never on the thread count.
+ *
+ * jacobi() is for couplings computed from the start-of-step state (the
+ * spectral convolution): prepare() computes them, then every slab is its
+ * own band of one color.
+ */
+struct IGSOACouplingBands {
+    size_t slabs = 0;
+    size_t count = 1;
+    size_t colors = 1;
+    bool prepare_first = false;   // Jacobi: prepare() before the sweep
+
+    // One band: the serial raster sweep
+    static IGSOACouplingBands serial(size_t slabs) {
+        IGSOACouplingBands bands;
+        bands.slabs = slabs;
+        return bands;
+    }
+
+    static constexpr size_t kMaxBands = 64;  // Enough for a socket; fewer boundaries, less per-band setup
+
+    static IGSOACouplingBands make(size_t slabs, size_t reach) {
+        IGSOACouplingBands bands = serial(slabs);
+        const size_t count = std::min(slabs / std::max<size_t>(reach, 1), kMaxBands);
+        if (count >= 2) {
+            bands.count = count;
+            bands.colors = (count % 2 == 0) ? 2 : 3;
+        }
+        return bands;
+    }
+
+    static IGSOACouplingBands jacobi(size_t slabs) {
+        IGSOACouplingBands bands = serial(slabs);
+        bands.count = std::max<size_t>(slabs, 1);
+        bands.prepare_first = true;
+        return bands;
+    }
+
+    size_t begin(size_t band) const { return slabs * band / count; }
+    size_t end(size_t band) const { return slabs * (band + 1) / count; }
+    size_t color(size_t band) const { return (colors == 3 && band + 1 == count) ? 2 : band % colors; }
+};
+
+class IGSOAPhysicsSoA {
+public:
+    static constexpr size_t kParallelThreshold = 16384;  // Nodes below which threads cost more
+
+    // Scalar type of a lattice; used for non-deduced scalar parameters
+    template<typename Real>
+    using ScalarOf = typename IGSOALatticeSoAT<Real>::value_type;
+
+    /**
+     * Non-local coupling kernel K(r, R_c) = exp(-r/R_c) / R_c
+     */
+    static inline double couplingKernel(double distance, double R_c) {
+        if (distance <= 0.0 || R_c <= 0.0) return 0.0;
+        return std::exp(-distance / R_c) / R_c;
+    }
+
+    static inline double wrappedDistance1D(int coord1, int coord2, size_t N) {
+        int raw_dist = std::abs(coord1 - coord2);
+        int wrapped_dist = std::min(raw_dist, static_cast<int>(N) - raw_dist);
+        return static_cast<double>(wrapped_dist);
+    }
+
+    /**
+     * Apply Ĥ_eff = -𝒦[Ψ] + κΦ + iΓ to node i and advance Ψ by dt
+     *
+     * @param nl_re Real part of the accumulated coupling 𝒦[Ψ]
+     * @param nl_im Imaginary part of the accumulated coupling 𝒦[Ψ]
+     */
+    template<typename Real>
+    static inline void advancePsi(IGSOALatticeSoAT<Real>& lattice, size_t i,
+                                  ScalarOf<Real> nl_re, ScalarOf<Real> nl_im,
+                                  ScalarOf<Real> dt, ScalarOf<Real> inv_hbar) {
+        const Real psi_re = lattice.psi_re[i];
+        const Real psi_im = lattice.psi_im[i];
+        const Real V_eff = lattice.kappa[i] * lattice.phi[i];
+        const Real g = lattice.gamma[i];
+
+        // Ĥ Ψ = -𝒦[Ψ] + V_eff Ψ + iΓ Ψ
+        const Real H_re = -nl_re + V_eff * psi_re - g * psi_im;
+        const Real H_im = -nl_im + V_eff * psi_im + g * psi_re;
+
+        // ∂Ψ/∂t = -i/ℏ Ĥ Ψ
+        const Real dot_re = H_im * inv_hbar;
+        const Real dot_im = -H_re * inv_hbar;
+        lattice.psi_dot_re[i] = dot_re;
+        lattice.psi_dot_im[i] = dot_im;
+
+        lattice.psi_re[i] = psi_re + dot_re * dt;
+        lattice.psi_im[i] = psi_im + dot_im * dt;
+    }
+
+    /**
+     * Check whether every node shares one causal radius
+     *
+     * @param R_c_out Output: the shared radius (valid when returning true)
+     */
+    static bool hasUniformRadius(const IGSOALatticeSoA& lattice, double& R_c_out) {
+        if (lattice.size() == 0) return false;
+        const double R_c = lattice.R_c[0];
+        for (size_t i = 1; i < lattice.size(); i++) {
+            if (lattice.R_c[i] != R_c) return false;
+        }
+        R_c_out = R_c;
+        return true;
+    }
+
+    /**
+     * Evolve quantum state on a 1D ring (see IGSOAPhysics::evolveQuantumState)
+     */
+    static uint64_t evolveQuantumState1D(
+        IGSOALatticeSoA& lattice,
+        double dt,
+        double hbar = 1.0
+    ) {
+        const size_t N = lattice.size();
+        const double inv_hbar = 1.0 / hbar;
+        const double* psi_re = lattice.psi_re.data();
+        const double* psi_im = lattice.psi_im.data();
+        uint64_t neighbor_operations = 0;
+
+        for (size_t i = 0; i < N; i++) {
+            double nl_re = 0.0;
+            double nl_im = 0.0;
+            neighbor_operations += boxCoupling1D(lattice, psi_re, psi_im, i, nl_re, nl_im);
+            advancePsi(lattice, i, nl_re, nl_im, dt, inv_hbar);
+        }
+
+        return neighbor_operations + static_cast<uint64_t>(N);
+    }
+
+    /**
+     * Box-search coupling 𝒦[u] of node i on a 1D ring, over the neighbors
+     * within node i's R_c (u: Ψ, or an RK4 stage)
+     *
+     * @return Neighbor terms added to nl_re / nl_im
+     */
+    static uint64_t boxCoupling1D(const IGSOALatticeSoA& lattice, const double* u_re, const double* u_im,
+                                  size_t i, double& nl_re, double& nl_im) {
+        const size_t N = lattice.size();
+        if (N <= 1) return 0;
+        const int N_int = static_cast<int>(N);
+        const double radius = std::max(lattice.R_c[i], 0.0);
+        const int R_c_int = static_cast<int>(std::ceil(radius));
+        const double self_re = u_re[i];
+        const double self_im = u_im[i];
+        uint64_t neighbor_operations = 0;
+
+        for (int offset = -R_c_int; offset <= R_c_int; offset++) {
+            if (offset == 0) continue;
+
+            int j = static_cast<int>(i) + offset;
+            while (j < 0) j += N_int;
+            while (j >= N_int) j -= N_int;
+
+            double distance = std::abs(static_cast<double>(i) - static_cast<double>(j));
+            if (distance > static_cast<double>(N) * 0.5) {
+                distance = static_cast<double>(N) - distance;
+            }
+
+            if (distance <= radius && radius > 0.0) {
+                const double w = couplingKernel(distance, radius);
+                nl_re += w * (u_re[j] - self_re);
+                nl_im += w * (u_im[j] - self_im);
+                neighbor_operations++;
+            }
+        }
+        return neighbor_operations;
+    }
+
+    /**
+     * evolveQuantumState1D in O(N) for a uniform R_c (IGSOACouplingMode::Recursive)
+     *
+     * The truncated kernel Σ_{k=1..K} e^{-k/R_c}/R_c Ψ[i±k] (K = ⌊R_c⌋) is
+     * a windowed first-order recursion in a = e^{-1/R_c}, so each node costs
+     * a few multiply-adds whatever R_c is. The in-place sweep order is kept:
+     * - right sums over the old Ψ come from one backward pass before the sweep
+     * - left sums over the new Ψ advance with the sweep
+     * - across the ring seam, the first K nodes add the old Ψ of the last K,
+     *   and the last K nodes add the new Ψ of the first K
+     * Every recursion only scales by a < 1, so results match the direct sum
+     * to round-off.
+     *
+     * @param scratch Reused buffer (2N + 2K doubles)
+     * @param operations Output: the direct sum's operation count
+     * @return false (lattice untouched) unless R_c is uniform with K ≥ 1 and
+     *         N > 2K; the caller then runs evolveQuantumState1D
+     */
+    static bool evolveQuantumState1DRecursive(
+        IGSOALatticeSoA& lattice,
+        double dt,
+        std::vector<double>& scratch,
+        uint64_t& operations,
+        double hbar = 1.0
+    ) {
+        const size_t N = lattice.size();
+        double uniform_R_c = 0.0;
+        if (!hasUniformRadius(lattice, uniform_R_c)) return false;
+        const double radius = std::max(uniform_R_c, 0.0);
+        const size_t K = static_cast<size_t>(std::floor(radius));
+        if (K == 0 || N <= 2 * K) return false;
+
+        const double inv_hbar = 1.0 / hbar;
+        const double inv_R = 1.0 / radius;
+        const double a = std::exp(-inv_R);
+        const double a_K = std::exp(-static_cast<double>(K) * inv_R);
+
+        // Σ_k w_k over both sides, times Ψ_i, is the self term of Σ w (Ψ_j - Ψ_i)
+        double weight_sum = 0.0;
+        for (size_t k = 1; k <= K; k++) {
+            weight_sum += couplingKernel(static_cast<double>(k), radius);
+        }
+        weight_sum *= 2.0;
+
+        scratch.resize(2 * N + 2 * K);
+        double* right_re = scratch.data();
+        double* right_im = right_re + N;
+        double* wrap_re = right_im + N;
+        double* wrap_im = wrap_re + K;
+        double* psi_re = lattice.psi_re.data();
+        double* psi_im = lattice.psi_im.data();
+
+        // right[i] = Σ_{k≤K, i+k<N} a^k Ψ_old[i+k]
+        right_re[N - 1] = 0.0;
+        right_im[N - 1] = 0.0;
+        for (size_t i = N - 1; i > 0; i--) {
+            double r_re = psi_re[i] + right_re[i];
+            double r_im = psi_im[i] + right_im[i];
+            if (i + K < N) {
+                r_re -= a_K * psi_re[i + K];
+                r_im -= a_K * psi_im[i + K];
+            }
+            right_re[i - 1] = a * r_re;
+            right_im[i - 1] = a * r_im;
+        }
+
+        // Seam term of node 0: Σ_{k=1..K} a^k Ψ_old[N-k]
+        double seam_re = 0.0;
+        double seam_im = 0.0;
+        for (size_t j = N - K; j < N; j++) {
+            seam_re = a * (seam_re + psi_re[j]);
+            seam_im = a * (seam_im + psi_im[j]);
+        }
+
+        double left_re = 0.0;
+        double left_im = 0.0;
+        for (size_t i = 0; i < N; i++) {
+            if (i == N - K) {
+                // Seam terms of the last K nodes over the now-updated first K:
+                // node N-1 sees Σ_{k=1..K} a^k Ψ_new[k-1]
+                double s_re = 0.0;
+                double s_im = 0.0;
+                for (size_t j = K; j-- > 0;) {
+                    s_re = a * (s_re + psi_re[j]);
+                    s_im = a * (s_im + psi_im[j]);
+                }
+                for (size_t m = K; m-- > 0;) {
+                    wrap_re[m] = s_re;
+                    wrap_im[m] = s_im;
+                    if (m > 0) {
+                        // Node N-K+m-1 loses the term of Ψ_new[m]
+                        s_re = a * (s_re - a_K * psi_re[m]);
+                        s_im = a * (s_im - a_K * psi_im[m]);
+                    }
+                }
+            }
+
+            double sum_re = left_re + right_re[i];
+            double sum_im = left_im + right_im[i];
+            if (i < K) {
+                sum_re += seam_re;
+                sum_im += seam_im;
+                seam_re = a * (seam_re - a_K * psi_re[N - K + i]);
+                seam_im = a * (seam_im - a_K * psi_im[N - K + i]);
+            } else if (i >= N - K) {
+                sum_re += wrap_re[i - (N - K)];
+                sum_im += wrap_im[i - (N - K)];
+            }
+
+            const double nl_re = sum_re * inv_R - weight_sum * psi_re[i];
+            const double nl_im = sum_im * inv_R - weight_sum * psi_im[i];
+            advancePsi(lattice, i, nl_re, nl_im, dt, inv_hbar);
+
+            // left[i+1] = Σ_{k≤K, i+1-k≥0} a^k Ψ_new[i+1-k]
+            left_re += psi_re[i];
+            left_im += psi_im[i];
+            if (i >= K) {
+                left_re -= a_K * psi_re[i - K];
+                left_im -= a_K * psi_im[i - K];
+            }
+            left_re *= a;
+            left_im *= a;
+        }
+
+        operations = static_cast<uint64_t>(N) * (2 * K + 1);
+        return true;
+    }
+
+    /**
+     * Evolve quantum state on a 2D torus (see IGSOAPhysics2D::evolveQuantumState)
+     */
+    static uint64_t evolveQuantumState2D(
+        IGSOALatticeSoA& lattice,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        double hbar = 1.0
+    ) {
+        const size_t N_total = N_x * N_y;
+        const double inv_hbar = 1.0 / hbar;
+        const double* psi_re = lattice.psi_re.data();
+        const double* psi_im = lattice.psi_im.data();
+        uint64_t neighbor_operations = 0;
+
+        static std::once_flag diagnostic_flag;
+        if (N_total > 0) {
+            std::call_once(diagnostic_flag, [&]() {
+                std::cerr << "[IGSOA 2D DIAGNOSTIC] Using 2D non-local coupling (SoA lattice, R_c="
+                          << lattice.R_c[0] << ", lattice=" << N_x << "x" << N_y << ")" << std::endl;
+            });
+        }
+
+        for (size_t i = 0; i < N_total; i++) {
+            double nl_re = 0.0;
+            double nl_im = 0.0;
+            neighbor_operations += boxCoupling2D(lattice, psi_re, psi_im, i, N_x, N_y, nl_re, nl_im);
+            advancePsi(lattice, i, nl_re, nl_im, dt, inv_hbar);
+        }
+
+        return neighbor_operations + static_cast<uint64_t>(N_total);
+    }
+
+    /**
+     * Box-search coupling 𝒦[u] of node i on a 2D torus (see boxCoupling1D)
+     */
+    static uint64_t boxCoupling2D(const IGSOALatticeSoA& lattice, const double* u_re, const double* u_im,
+                                  size_t i, size_t N_x, size_t N_y, double& nl_re, double& nl_im) {
+        if (N_x * N_y <= 1) return 0;
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int x_i = static_cast<int>(i % N_x);
+        const int y_i = static_cast<int>(i / N_x);
+        const double radius = std::max(lattice.R_c[i], 0.0);
+        const int R_c_int = static_cast<int>(std::ceil(radius));
+        const double self_re = u_re[i];
+        const double self_im = u_im[i];
+        uint64_t neighbor_operations = 0;
+
+        for (int dy = -R_c_int; dy <= R_c_int; dy++) {
+            int y_temp = (y_i + dy) % N_y_int;
+            const int y_j = (y_temp < 0) ? (y_temp + N_y_int) : y_temp;
+            const double dy_wrap = wrappedDistance1D(y_i, y_j, N_y);
+            const size_t row = static_cast<size_t>(y_j) * N_x;
+
+            for (int dx = -R_c_int; dx <= R_c_int; dx++) {
+                if (dx == 0 && dy == 0) continue;
+
+                int x_temp = (x_i + dx) % N_x_int;
+                const int x_j = (x_temp < 0) ? (x_temp + N_x_int) : x_temp;
+                const double dx_wrap = wrappedDistance1D(x_i, x_j, N_x);
+
+                const double distance = std::sqrt(dx_wrap * dx_wrap + dy_wrap * dy_wrap);
+                if (distance <= radius && radius > 0.0) {
+                    const double w = couplingKernel(distance, radius);
+                    const size_t j = row + static_cast<size_t>(x_j);
+                    nl_re += w * (u_re[j] - self_re);
+                    nl_im += w * (u_im[j] - self_im);
+                    neighbor_operations++;
+                }
+            }
+        }
+        return neighbor_operations;
+    }
+
+    /**
+     * Evolve quantum state on a 3D torus (see IGSOAPhysics3D::evolveQuantumState)
+     */
+    static uint64_t evolveQuantumState3D(
+        IGSOALatticeSoA& lattice,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z,
+        double hbar = 1.0
+    ) {
+        const size_t N_total = N_x * N_y * N_z;
+        const double inv_hbar = 1.0 / hbar;
+        const double* psi_re = lattice.psi_re.data();
+        const double* psi_im = lattice.psi_im.data();
+        uint64_t neighbor_operations = 0;
+
+        static std::once_flag diagnostic_flag;
+        if (N_total > 0) {
+            std::call_once(diagnostic_flag, [&]() {
+                std::cerr << "[IGSOA 3D DIAGNOSTIC] Using 3D non-local coupling (SoA lattice, " << N_x
+                          << "x" << N_y << "x" << N_z << ", R_c=" << lattice.R_c[0] << ")" << std::endl;
+            });
+        }
+
+        for (size_t index = 0; index < N_total; ++index) {
+            double nl_re = 0.0;
+            double nl_im = 0.0;
+            neighbor_operations += boxCoupling3D(lattice, psi_re, psi_im, index, N_x, N_y, N_z, nl_re, nl_im);
+            advancePsi(lattice, index, nl_re, nl_im, dt, inv_hbar);
+        }
+
+        return neighbor_operations + static_cast<uint64_t>(N_total);
+    }
+
+    /**
+     * Box-search coupling 𝒦[u] of node index on a 3D torus (see boxCoupling1D)
+     */
+    static uint64_t boxCoupling3D(const IGSOALatticeSoA& lattice, const double* u_re, const double* u_im,
+                                  size_t index, size_t N_x, size_t N_y, size_t N_z,
+                                  double& nl_re, double& nl_im) {
+        const size_t plane_size = N_x * N_y;
+        const double radius = std::max(lattice.R_c[index], 0.0);
+        if (plane_size * N_z <= 1 || !(radius > 0.0)) return 0;
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const int x_i = static_cast<int>(index % N_x);
+        const int y_i = static_cast<int>((index / N_x) % N_y);
+        const int z_i = static_cast<int>(index / plane_size);
+        const int R_c_int = static_cast<int>(std::ceil(radius));
+        const double radius_sq = radius * radius;
+        const double self_re = u_re[index];
+        const double self_im = u_im[index];
+        uint64_t neighbor_operations = 0;
+
+        for (int dz = -R_c_int; dz <= R_c_int; ++dz) {
+            int z_j = (z_i + dz) % N_z_int;
+            if (z_j < 0) z_j += N_z_int;
+            const double dz_wrap = wrappedDistance1D(z_i, z_j, N_z);
+
+            for (int dy = -R_c_int; dy <= R_c_int; ++dy) {
+                int y_j = (y_i + dy) % N_y_int;
+                if (y_j < 0) y_j += N_y_int;
+                const double dy_wrap = wrappedDistance1D(y_i, y_j, N_y);
+                const size_t row = static_cast<size_t>(z_j) * plane_size +
+                                   static_cast<size_t>(y_j) * N_x;
+
+                for (int dx = -R_c_int; dx <= R_c_int; ++dx) {
+                    if (dx == 0 && dy == 0 && dz == 0) continue;
+
+                    int x_j = (x_i + dx) % N_x_int;
+                    if (x_j < 0) x_j += N_x_int;
+                    const double dx_wrap = wrappedDistance1D(x_i, x_j, N_x);
+
+                    const double dist_sq =
+                        dx_wrap * dx_wrap +
+                        dy_wrap * dy_wrap +
+                        dz_wrap * dz_wrap;
+
+                    if (dist_sq <= radius_sq) {
+                        const double w = couplingKernel(std::sqrt(dist_sq), radius);
+                        const size_t j = row + static_cast<size_t>(x_j);
+                        nl_re += w * (u_re[j] - self_re);
+                        nl_im += w * (u_im[j] - self_im);
+                        neighbor_operations++;
+                    }
+                }
+            }
+        }
+        return neighbor_operations;
+    }
+
+    /**
+     * 2D quantum evolution from a precomputed stencil (uniform R_c)
+     *
+     * Same in-place sweep as the box search, split by row: couplings to other
+     * rows do not change while a row is swept (rows above are final, rows
+     * below untouched), so they are gathered for the whole row first, one
+     * offset at a time and vectorized over x. The sequential pass then only
+     * adds the in-row offsets before advancing each node. Interior columns
+     * use fixed linear offsets; columns within stencil.reach() of an edge
+     * wrap explicitly.
+     */
+    template<typename Real>
+    static uint64_t evolveQuantumState2D(
+        IGSOALatticeSoAT<Real>& lattice,
+        const CouplingStencil2D& stencil,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        double hbar = 1.0
+    ) {
+        return evolveQuantumStateRows2D(lattice, stencil, dt, N_x, N_y, 0, N_y, hbar);
+    }
+
+    /**
+     * Stencil sweep of the rows [y_begin, y_end) only
+     *
+     * Sweeping consecutive ranges in order equals one full sweep.
+     */
+    template<typename Real>
+    static uint64_t evolveQuantumStateRows2D(
+        IGSOALatticeSoAT<Real>& lattice,
+        const CouplingStencil2D& stencil,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t y_begin,
+        size_t y_end,
+        double hbar = 1.0
+    ) {
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int reach = stencil.reach();
+        const size_t K = stencil.size();
+        const int* off_x = stencil.dx();
+        const int* off_y = stencil.dy();
+        const Real* weight = stencilWeight<Real>(stencil);
+        const Real step = static_cast<Real>(dt);
+        const Real inv_hbar = static_cast<Real>(1.0 / hbar);
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* psi_im = lattice.psi_im.data();
+
+        RowScratch<Real>& scratch = rowScratch<Real>(N_x, K);
+        Real* cross_re = scratch.cross_re.data();
+        Real* cross_im = scratch.cross_im.data();
+        const int x_begin = std::min(reach, N_x_int);
+        const int x_end = std::max(x_begin, N_x_int - reach);
+
+        for (int y = static_cast<int>(y_begin); y < static_cast<int>(y_end); y++) {
+            const size_t row = static_cast<size_t>(y) * N_x;
+            std::fill(cross_re, cross_re + N_x, Real(0));
+            std::fill(cross_im, cross_im + N_x, Real(0));
+            scratch.clear();
+
+            for (size_t k = 0; k < K; k++) {
+                const int y_j = wrapIndex(y + off_y[k], N_y_int);
+                if (y_j == y) {
+                    addInRowEntry(scratch, off_x[k], weight[k], k);
+                    continue;
+                }
+                addCrossEntry(scratch, psi_re + row, psi_im + row,
+                              psi_re + static_cast<size_t>(y_j) * N_x, psi_im + static_cast<size_t>(y_j) * N_x,
+                              off_x[k], weight[k], N_x_int, x_begin, x_end);
+            }
+            gatherRow(scratch, psi_re + row, psi_im + row, x_begin, x_end);
+
+            sweepRow(lattice, row, scratch, off_x, weight, N_x_int, x_begin, x_end, step, inv_hbar, 0, N_x_int);
+        }
+
+        return static_cast<uint64_t>(N_x * (y_end - y_begin)) * (static_cast<uint64_t>(K) + 1);
+    }
+
+    /**
+     * 2D stencil sweep restricted to the stepped tiles of an active region
+     *
+     * Same row-split sweep, over the rows and column segments of the mask
+     * only; nodes outside the mask keep their state. Only the mask rows in
+     * [row_begin, row_end) are swept (one band of runActiveSteps()).
+     */
+    template<typename Real>
+    static uint64_t evolveQuantumState2D(
+        IGSOALatticeSoAT<Real>& lattice,
+        const CouplingStencil2D& stencil,
+        const IGSOAActiveRegion& region,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t row_begin,
+        size_t row_end,
+        double hbar = 1.0
+    ) {
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int reach = stencil.reach();
+        const size_t K = stencil.size();
+        const int* off_x = stencil.dx();
+        const int* off_y = stencil.dy();
+        const Real* weight = stencilWeight<Real>(stencil);
+        const Real step = static_cast<Real>(dt);
+        const Real inv_hbar = static_cast<Real>(1.0 / hbar);
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* psi_im = lattice.psi_im.data();
+
+        RowScratch<Real>& scratch = rowScratch<Real>(N_x, K);
+        const int x_begin = std::min(reach, N_x_int);
+        const int x_end = std::max(x_begin, N_x_int - reach);
+
+        const std::vector<size_t>& rows = region.activeRows();
+        const auto first = std::lower_bound(rows.begin(), rows.end(), row_begin);
+        const auto last = std::lower_bound(first, rows.end(), row_end);
+        uint64_t nodes = 0;
+        for (auto it = first; it != last; ++it) {
+            const size_t r = *it;
+            nodes += maskedRowNodes(region, r);
+            const int y = static_cast<int>(r);
+            const size_t row = r * N_x;
+            std::fill(scratch.cross_re.data(), scratch.cross_re.data() + N_x, Real(0));
+            std::fill(scratch.cross_im.data(), scratch.cross_im.data() + N_x, Real(0));
+            scratch.clear();
+
+            for (size_t k = 0; k < K; k++) {
+                const int y_j = wrapIndex(y + off_y[k], N_y_int);
+                if (y_j == y) {
+                    addInRowEntry(scratch, off_x[k], weight[k], k);
+                    continue;
+                }
+                addCrossEntry(scratch, psi_re + row, psi_im + row,
+                              psi_re + static_cast<size_t>(y_j) * N_x, psi_im + static_cast<size_t>(y_j) * N_x,
+                              off_x[k], weight[k], N_x_int, x_begin, x_end);
+            }
+            sweepSegments(lattice, row, r, region, scratch, off_x, weight, N_x_int, x_begin, x_end, step, inv_hbar);
+        }
+
+        return nodes * (static_cast<uint64_t>(K) + 1);
+    }
+
+    /**
+     * 3D quantum evolution from a precomputed stencil (uniform R_c)
+     *
+     * Row-split sweep as in 2D; a row is one (y, z) line.
+     */
+    template<typename Real>
+    static uint64_t evolveQuantumState3D(
+        IGSOALatticeSoAT<Real>& lattice,
+        const CouplingStencil3D& stencil,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z,
+        double hbar = 1.0
+    ) {
+        return evolveQuantumStateSlabs3D(lattice, stencil, dt, N_x, N_y, N_z, 0, N_z, hbar);
+    }
+
+    /**
+     * Stencil sweep of the z-slabs [z_begin, z_end) only
+     *
+     * Sweeping consecutive ranges in order equals one full sweep.
+     */
+    template<typename Real>
+    static uint64_t evolveQuantumStateSlabs3D(
+        IGSOALatticeSoAT<Real>& lattice,
+        const CouplingStencil3D& stencil,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z,
+        size_t z_begin,
+        size_t z_end,
+        double hbar = 1.0
+    ) {
+        const size_t plane_size = N_x * N_y;
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const int reach = stencil.reach();
+        const size_t K = stencil.size();
+        const int* off_x = stencil.dx();
+        const int* off_y = stencil.dy();
+        const int* off_z = stencil.dz();
+        const Real* weight = stencilWeight<Real>(stencil);
+        const Real step = static_cast<Real>(dt);
+        const Real inv_hbar = static_cast<Real>(1.0 / hbar);
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* psi_im = lattice.psi_im.data();
+
+        RowScratch<Real>& scratch = rowScratch<Real>(N_x, K);
+        Real* cross_re = scratch.cross_re.data();
+        Real* cross_im = scratch.cross_im.data();
+        const int x_begin = std::min(reach, N_x_int);
+        const int x_end = std::max(x_begin, N_x_int - reach);
+
+        for (int z = static_cast<int>(z_begin); z < static_cast<int>(z_end); z++) {
+            for (int y = 0; y < N_y_int; y++) {
+                const size_t row = static_cast<size_t>(z) * plane_size + static_cast<size_t>(y) * N_x;
+                std::fill(cross_re, cross_re + N_x, Real(0));
+                std::fill(cross_im, cross_im + N_x, Real(0));
+                scratch.clear();
+
+                for (size_t k = 0; k < K; k++) {
+                    const int y_j = wrapIndex(y + off_y[k], N_y_int);
+                    const int z_j = wrapIndex(z + off_z[k], N_z_int);
+                    if (y_j == y && z_j == z) {
+                        addInRowEntry(scratch, off_x[k], weight[k], k);
+                        continue;
+                    }
+                    const size_t row_j = static_cast<size_t>(z_j) * plane_size + static_cast<size_t>(y_j) * N_x;
+                    addCrossEntry(scratch, psi_re + row, psi_im + row, psi_re + row_j, psi_im + row_j,
+                                  off_x[k], weight[k], N_x_int, x_begin, x_end);
+                }
+                gatherRow(scratch, psi_re + row, psi_im + row, x_begin, x_end);
+
+                sweepRow(lattice, row, scratch, off_x, weight, N_x_int, x_begin, x_end, step, inv_hbar, 0, N_x_int);
+            }
+        }
+
+        return static_cast<uint64_t>(plane_size * (z_end - z_begin)) * (static_cast<uint64_t>(K) + 1);
+    }
+
+    /**
+     * 3D stencil sweep restricted to the stepped tiles of an active region
+     *
+     * Mask rows r = z·N_y + y in [row_begin, row_end) only.
+     */
+    template<typename Real>
+    static uint64_t evolveQuantumState3D(
+        IGSOALatticeSoAT<Real>& lattice,
+        const CouplingStencil3D& stencil,
+        const IGSOAActiveRegion& region,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z,
+        size_t row_begin,
+        size_t row_end,
+        double hbar = 1.0
+    ) {
+        const size_t plane_size = N_x * N_y;
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const int reach = stencil.reach();
+        const size_t K = stencil.size();
+        const int* off_x = stencil.dx();
+        const int* off_y = stencil.dy();
+        const int* off_z = stencil.dz();
+        const Real* weight = stencilWeight<Real>(stencil);
+        const Real step = static_cast<Real>(dt);
+        const Real inv_hbar = static_cast<Real>(1.0 / hbar);
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* psi_im = lattice.psi_im.data();
+
+        RowScratch<Real>& scratch = rowScratch<Real>(N_x, K);
+        const int x_begin = std::min(reach, N_x_int);
+        const int x_end = std::max(x_begin, N_x_int - reach);
+
+        const std::vector<size_t>& rows = region.activeRows();
+        const auto first = std::lower_bound(rows.begin(), rows.end(), row_begin);
+        const auto last = std::lower_bound(first, rows.end(), row_end);
+        uint64_t nodes = 0;
+        for (auto it = first; it != last; ++it) {
+            const size_t r = *it;
+            nodes += maskedRowNodes(region, r);
+            const int y = static_cast<int>(r % N_y);
+            const int z = static_cast<int>(r / N_y);
+            const size_t row = r * N_x;
+            std::fill(scratch.cross_re.data(), scratch.cross_re.data() + N_x, Real(0));
+            std::fill(scratch.cross_im.data(), scratch.cross_im.data() + N_x, Real(0));
+            scratch.clear();
+
+            for (size_t k = 0; k < K; k++) {
+                const int y_j = wrapIndex(y + off_y[k], N_y_int);
+                const int z_j = wrapIndex(z + off_z[k], N_z_int);
+                if (y_j == y && z_j == z) {
+                    addInRowEntry(scratch, off_x[k], weight[k], k);
+                    continue;
+                }
+                const size_t row_j = static_cast<size_t>(z_j) * plane_size + static_cast<size_t>(y_j) * N_x;
+                addCrossEntry(scratch, psi_re + row, psi_im + row, psi_re + row_j, psi_im + row_j,
+                              off_x[k], weight[k], N_x_int, x_begin, x_end);
+            }
+            sweepSegments(lattice, row, r, region, scratch, off_x, weight, N_x_int, x_begin, x_end, step, inv_hbar);
+        }
+
+        return nodes * (static_cast<uint64_t>(K) + 1);
+    }
+
+    /**
+     * 2D stencil sweep for an integer radius R fixed at compile time
+     *
+     * Same sums, term for term and in the same order, as the CouplingStencil2D
+     * sweep, with the offsets and trip count of FixedStencil2D<R> unrolled
+     * into the loop body and the row pointers of each stencil line resolved
+     * once per row. Sweeps rows [y_begin, y_end) in order. The caller
+     * guarantees fixedStencilRadius(R_c, N_x, N_y) == R.
+     */
+    template<int R, typename Real>
+    static uint64_t evolveQuantumState2DFixed(
+        IGSOALatticeSoAT<Real>& lattice,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t y_begin,
+        size_t y_end,
+        double hbar = 1.0
+    ) {
+        using S = FixedStencil2D<R>;
+        constexpr int K = S::K;
+        constexpr int L = 2 * R + 1;
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const Real* w = S::template weights<Real>();
+        const Real step = static_cast<Real>(dt);
+        const Real inv_hbar = static_cast<Real>(1.0 / hbar);
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* psi_im = lattice.psi_im.data();
+
+        for (int y = static_cast<int>(y_begin); y < static_cast<int>(y_end); y++) {
+            const size_t row = static_cast<size_t>(y) * N_x;
+            const Real* src_re[L];
+            const Real* src_im[L];
+            for (int d = 0; d < L; d++) {
+                const size_t row_j = static_cast<size_t>(wrapIndex(y + d - R, N_y_int)) * N_x;
+                src_re[d] = psi_re + row_j;
+                src_im[d] = psi_im + row_j;
+            }
+            sweepFixedRow<S>(lattice, row, src_re, src_im, w, N_x_int, step, inv_hbar);
+        }
+
+        return static_cast<uint64_t>(N_x * (y_end - y_begin)) * (static_cast<uint64_t>(K) + 1);
+    }
+
+    /**
+     * 3D stencil sweep for an integer radius R fixed at compile time, over
+     * the z-slabs [z_begin, z_end) (see evolveQuantumState2DFixed)
+     */
+    template<int R, typename Real>
+    static uint64_t evolveQuantumState3DFixed(
+        IGSOALatticeSoAT<Real>& lattice,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z,
+        size_t z_begin,
+        size_t z_end,
+        double hbar = 1.0
+    ) {
+        using S = FixedStencil3D<R>;
+        constexpr int K = S::K;
+        constexpr int L = 2 * R + 1;
+        const size_t plane_size = N_x * N_y;
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const Real* w = S::template weights<Real>();
+        const Real step = static_cast<Real>(dt);
+        const Real inv_hbar = static_cast<Real>(1.0 / hbar);
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* psi_im = lattice.psi_im.data();
+
+        for (int z = static_cast<int>(z_begin); z < static_cast<int>(z_end); z++) {
+            for (int y = 0; y < N_y_int; y++) {
+                const size_t row = static_cast<size_t>(z) * plane_size + static_cast<size_t>(y) * N_x;
+                const Real* src_re[L * L];
+                const Real* src_im[L * L];
+                for (int dz = 0; dz < L; dz++) {
+                    const size_t plane_j = static_cast<size_t>(wrapIndex(z + dz - R, N_z_int)) * plane_size;
+                    for (int dy = 0; dy < L; dy++) {
+                        const size_t row_j = plane_j + static_cast<size_t>(wrapIndex(y + dy - R, N_y_int)) * N_x;
+                        src_re[dz * L + dy] = psi_re + row_j;
+                        src_im[dz * L + dy] = psi_im + row_j;
+                    }
+                }
+                sweepFixedRow<S>(lattice, row, src_re, src_im, w, N_x_int, step, inv_hbar);
+            }
+        }
+
+        return static_cast<uint64_t>(plane_size * (z_end - z_begin)) * (static_cast<uint64_t>(K) + 1);
+    }
+
+    // (lattice, dt, N_x, N_y, y_begin, y_end, hbar)
+    template<typename Real>
+    using FixedKernel2D = uint64_t (*)(IGSOALatticeSoAT<Real>&, double, size_t, size_t, size_t, size_t, double);
+
+    // (lattice, dt, N_x, N_y, N_z, z_begin, z_end, hbar)
+    template<typename Real>
+    using FixedKernel3D = uint64_t (*)(IGSOALatticeSoAT<Real>&, double, size_t, size_t, size_t, size_t, size_t,
+                                       double);
+
+    /**
+     * Fixed-radius 2D kernel for R (from fixedStencilRadius), nullptr if none
+     */
+    template<typename Real>
+    static FixedKernel2D<Real> fixedKernel2D(int R) {
+        switch (R) {
+            case 1: return &evolveQuantumState2DFixed<1, Real>;
+            case 2: return &evolveQuantumState2DFixed<2, Real>;
+            case 3: return &evolveQuantumState2DFixed<3, Real>;
+            case 4: return &evolveQuantumState2DFixed<4, Real>;
+            case 5: return &evolveQuantumState2DFixed<5, Real>;
+            default: return nullptr;
+        }
+    }
+
+    /**
+     * Fixed-radius 3D kernel for R (from fixedStencilRadius), nullptr if none
+     */
+    template<typename Real>
+    static FixedKernel3D<Real> fixedKernel3D(int R) {
+        switch (R) {
+            case 1: return &evolveQuantumState3DFixed<1, Real>;
+            case 2: return &evolveQuantumState3DFixed<2, Real>;
+            case 3: return &evolveQuantumState3DFixed<3, Real>;
+            case 4: return &evolveQuantumState3DFixed<4, Real>;
+            case 5: return &evolveQuantumState3DFixed<5, Real>;
+            default: return nullptr;
+        }
+    }
+
+    /**
+     * Quantum evolution from cached CSR neighbor lists (any dimension)
+     *
+     * Supports heterogeneous per-node R_c; weights come from the tiered
+     * kernel cache of NeighborCache2D/3D.
+     */
+    static uint64_t evolveQuantumState(
+        IGSOALatticeSoA& lattice,
+        const NeighborListCSR& neighbors,
+        double dt,
+        double hbar = 1.0
+    ) {
+        const size_t N = lattice.size();
+        const double inv_hbar = 1.0 / hbar;
+        const double* psi_re = lattice.psi_re.data();
+        const double* psi_im = lattice.psi_im.data();
+
+        for (size_t i = 0; i < N; i++) {
+            double nl_re = 0.0;
+            double nl_im = 0.0;
+            neighbors.computeCoupling(i, psi_re, psi_im, nl_re, nl_im);
+            advancePsi(lattice, i, nl_re, nl_im, dt, inv_hbar);
+        }
+
+        return static_cast<uint64_t>(neighbors.getTotalNeighborCount()) + static_cast<uint64_t>(N);
+    }
+
+    /**
+     * Quantum evolution with the coupling evaluated as an FFT convolution
+     *
+     * 𝒦[Ψ] is computed for all nodes from the start-of-step state, then every
+     * node is advanced. Returns the equivalent stencil operation count so
+     * metrics stay comparable with the direct path.
+     */
+    static uint64_t evolveQuantumState(
+        IGSOALatticeSoA& lattice,
+        SpectralCoupling& spectral,
+        double dt,
+        double hbar = 1.0
+    ) {
+        const size_t N = lattice.size();
+        const double inv_hbar = 1.0 / hbar;
+
+        spectral.convolve(lattice.psi_re.data(), lattice.psi_im.data());
+        for (size_t i = 0; i < N; i++) {
+            advancePsi(lattice, i, spectral.couplingRe(i), spectral.couplingIm(i), dt, inv_hbar);
+        }
+
+        return static_cast<uint64_t>(N) * (static_cast<uint64_t>(spectral.terms()) + 1);
+    }
+
+    /**
+     * In-place sweep of nodes [begin, end) in order from per-node sums:
+     * coupling(i, nl_re, nl_im) adds 𝒦[Ψ] of node i over the lattice as it
+     * is (boxCoupling1D/2D/3D, neighbor lists, spectral results) and returns
+     * its terms. Sweeping consecutive ranges in order equals the full
+     * evolveQuantumState1D/2D/3D sweep.
+     */
+    template<typename NodeCoupling>
+    static uint64_t evolveQuantumStateNodes(IGSOALatticeSoA& lattice, double dt, size_t begin, size_t end,
+                                            NodeCoupling&& coupling) {
+        uint64_t terms = 0;
+        for (size_t i = begin; i < end; i++) {
+            double nl_re = 0.0;
+            double nl_im = 0.0;
+            terms += coupling(i, nl_re, nl_im);
+            advancePsi(lattice, i, nl_re, nl_im, dt, 1.0);
+        }
+        return terms + static_cast<uint64_t>(end - begin);
+    }
+
+    /**
+     * Largest offset along any axis that a box search or neighbor list over
+     * the lattice's R_c reaches (the reach of its IGSOACouplingBands)
+     */
+    static size_t radiusReach(const IGSOALatticeSoA& lattice) {
+        double radius = 0.0;
+        for (size_t i = 0; i < lattice.size(); i++) {
+            radius = std::max(radius, lattice.R_c[i]);
+        }
+        return static_cast<size_t>(std::ceil(radius));
+    }
+
+    /**
+     * Evolve realized causal field: ∂Φ/∂t = -κ(Φ - Re[Ψ]) - γΦ
+     */
+    template<typename Real>
+    static uint64_t evolveCausalField(IGSOALatticeSoAT<Real>& lattice, double dt) {
+        const size_t N = lattice.size();
+        const Real step = static_cast<Real>(dt);
+        Real* phi = lattice.phi.data();
+        Real* phi_dot = lattice.phi_dot.data();
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* kappa = lattice.kappa.data();
+        const Real* gamma = lattice.gamma.data();
+
+        for (size_t i = 0; i < N; i++) {
+            const Real coupling_diff = phi[i] - psi_re[i];
+            phi_dot[i] = -kappa[i] * coupling_diff - gamma[i] * phi[i];
+            phi[i] += phi_dot[i] * step;
+        }
+        return static_cast<uint64_t>(N);
+    }
+
+    /**
+     * Update the derived quantity the dynamics read: F = |Ψ|² (for the
+     * gradients). Ṡ, T_IGS and phase are evaluated on read
+     * (IGSOALatticeSoAT::entropyRate/phase)
+     */
+    template<typename Real>
+    static uint64_t updateDerivedQuantities(IGSOALatticeSoAT<Real>& lattice) {
+        const size_t N = lattice.size();
+        const Real* psi_re = lattice.psi_re.data();
+        const Real* psi_im = lattice.psi_im.data();
+        Real* F_out = lattice.F.data();
+
+        #pragma omp simd
+        for (size_t i = 0; i < N; i++) {
+            const Real re = psi_re[i];
+            const Real im = psi_im[i];
+            F_out[i] = re * re + im * im;
+        }
+        return static_cast<uint64_t>(N);
+    }
+
+    /**
+     * 1D forward-difference gradient: ∇F ≈ F[i+1] - F[i]
+     */
+    static uint64_t computeGradients1D(IGSOALatticeSoA& lattice) {
+        return computeGradients1D(lattice, 0, lattice.size());
+    }
+
+    /**
+     * 1D gradients of nodes [begin, end)
+     */
+    static uint64_t computeGradients1D(IGSOALatticeSoA& lattice, size_t begin, size_t end) {
+        const size_t N = lattice.size();
+        const double* F = lattice.F.data();
+        double* grad = lattice.F_gradient.data();
+
+        for (size_t i = begin; i < end; i++) {
+            grad[i] = F[(i + 1 == N) ? 0 : i + 1] - F[i];
+        }
+        return static_cast<uint64_t>(end - begin);
+    }
+
+    /**
+     * 2D central-difference gradient magnitude |∇F|
+     */
+    template<typename Real>
+    static uint64_t computeGradients2D(IGSOALatticeSoAT<Real>& lattice, size_t N_x, size_t N_y) {
+        return computeGradients2D(lattice, N_x, N_y, 0, N_y);
+    }
+
+    /**
+     * 2D gradients of rows [row_begin, row_end)
+     */
+    template<typename Real>
+    static uint64_t computeGradients2D(IGSOALatticeSoAT<Real>& lattice, size_t N_x, size_t N_y,
+                                       size_t row_begin, size_t row_end) {
+        const Real* F = lattice.F.data();
+        Real* grad = lattice.F_gradient.data();
+
+        for (size_t y = row_begin; y < row_end; y++) {
+            const size_t row = y * N_x;
+            const size_t row_up = ((y == N_y - 1) ? 0 : y + 1) * N_x;
+            const size_t row_down = ((y == 0) ? N_y - 1 : y - 1) * N_x;
+
+            for (size_t x = 0; x < N_x; x++) {
+                const size_t x_right = (x == N_x - 1) ? 0 : x + 1;
+                const size_t x_left = (x == 0) ? N_x - 1 : x - 1;
+
+                const Real dF_dx = (F[row + x_right] - F[row + x_left]) * Real(0.5);
+                const Real dF_dy = (F[row_up + x] - F[row_down + x]) * Real(0.5);
+                grad[row + x] = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy);
+            }
+        }
+        return static_cast<uint64_t>(N_x * (row_end - row_begin));
+    }
+
+    /**
+     * 3D central-difference gradient magnitude |∇F|
+     */
+    template<typename Real>
+    static uint64_t computeGradients3D(IGSOALatticeSoAT<Real>& lattice, size_t N_x, size_t N_y, size_t N_z) {
+        return computeGradients3D(lattice, N_x, N_y, N_z, 0, N_y * N_z);
+    }
+
+    /**
+     * 3D gradients of rows [row_begin, row_end), row r = (y, z) = (r % N_y, r / N_y)
+     */
+    template<typename Real>
+    static uint64_t computeGradients3D(IGSOALatticeSoAT<Real>& lattice, size_t N_x, size_t N_y, size_t N_z,
+                                       size_t row_begin, size_t row_end) {
+        const size_t plane_size = N_x * N_y;
+        const Real* F = lattice.F.data();
+        Real* grad = lattice.F_gradient.data();
+
+        for (size_t r = row_begin; r < row_end; r++) {
+            const size_t z = r / N_y;
+            const size_t y = r % N_y;
+            const size_t plane = z * plane_size;
+            const size_t plane_front = ((z == N_z - 1) ? 0 : z + 1) * plane_size;
+            const size_t plane_back = ((z == 0) ? N_z - 1 : z - 1) * plane_size;
+            const size_t row = y * N_x;
+            const size_t row_up = ((y == N_y - 1) ? 0 : y + 1) * N_x;
+            const size_t row_down = ((y == 0) ? N_y - 1 : y - 1) * N_x;
+
+            for (size_t x = 0; x < N_x; x++) {
+                const size_t x_right = (x == N_x - 1) ? 0 : x + 1;
+                const size_t x_left = (x == 0) ? N_x - 1 : x - 1;
+
+                const Real dF_dx = (F[plane + row + x_right] - F[plane + row + x_left]) * Real(0.5);
+                const Real dF_dy = (F[plane + row_up + x] - F[plane + row_down + x]) * Real(0.5);
+                const Real dF_dz = (F[plane_front + row + x] - F[plane_back + row + x]) * Real(0.5);
+                grad[plane + row + x] = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy + dF_dz * dF_dz);
+            }
+        }
+        return static_cast<uint64_t>(N_x * (row_end - row_begin));
+    }
+
+    /**
+     * Normalize all quantum states: |Ψ⟩ → |Ψ⟩ / ||Ψ||
+     */
+    template<typename Real>
+    static uint64_t normalizeStates(IGSOALatticeSoAT<Real>& lattice) {
+        const size_t N = lattice.size();
+        Real* psi_re = lattice.psi_re.data();
+        Real* psi_im = lattice.psi_im.data();
+
+        for (size_t i = 0; i < N; i++) {
+            const Real magnitude = std::hypot(psi_re[i], psi_im[i]);
+            if (magnitude > Real(1e-15)) {
+                psi_re[i] /= magnitude;
+                psi_im[i] /= magnitude;
+            }
+        }
+        return static_cast<uint64_t>(N);
+    }
+
+    /**
+     * Full time step on a 1D ring
+     */
+    static uint64_t timeStep1D(IGSOALatticeSoA& lattice, const IGSOAComplexConfig& config,
+                               PhaseProfiler* profiler = nullptr) {
+        uint64_t operations = 0;
+        {
+            DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_QUANTUM);
+            operations += evolveQuantumState1D(lattice, config.dt);
+        }
+        operations += completeLocalStages(lattice, config, profiler, [&]() {
+            return computeGradients1D(lattice);
+        });
+        return operations;
+    }
+
+    /**
+     * Full time step on a 2D torus
+     *
+     * @param stencil Precomputed offsets for a uniform R_c (nullptr: box search)
+     */
+    static uint64_t timeStep2D(IGSOALatticeSoA& lattice, const IGSOAComplexConfig& config,
+                               size_t N_x, size_t N_y,
+                               const CouplingStencil2D* stencil = nullptr) {
+        uint64_t operations = 0;
+        if (stencil) {
+            operations += evolveQuantumState2D(lattice, *stencil, config.dt, N_x, N_y);
+        } else {
+            operations += evolveQuantumState2D(lattice, config.dt, N_x, N_y);
+        }
+        operations += completeStep2D(lattice, config, N_x, N_y);
+        return operations;
+    }
+
+    /**
+     * Local stages of a 2D time step (after the Ψ coupling update):
+     * causal field, derived quantities, gradients, optional normalization
+     */
+    template<typename Real>
+    static uint64_t completeStep2D(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                                   size_t N_x, size_t N_y, PhaseProfiler* profiler = nullptr) {
+        return completeLocalStages(lattice, config, profiler, [&]() {
+            return computeGradients2D(lattice, N_x, N_y);
+        });
+    }
+
+    /**
+     * Full time step on a 3D torus
+     *
+     * @param stencil Precomputed offsets for a uniform R_c (nullptr: box search)
+     */
+    static uint64_t timeStep3D(IGSOALatticeSoA& lattice, const IGSOAComplexConfig& config,
+                               size_t N_x, size_t N_y, size_t N_z,
+                               const CouplingStencil3D* stencil = nullptr) {
+        uint64_t operations = 0;
+        if (stencil) {
+            operations += evolveQuantumState3D(lattice, *stencil, config.dt, N_x, N_y, N_z);
+        } else {
+            operations += evolveQuantumState3D(lattice, config.dt, N_x, N_y, N_z);
+        }
+        operations += completeStep3D(lattice, config, N_x, N_y, N_z);
+        return operations;
+    }
+
+    /**
+     * Local stages of a 3D time step (after the Ψ coupling update)
+     */
+    template<typename Real>
+    static uint64_t completeStep3D(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                                   size_t N_x, size_t N_y, size_t N_z, PhaseProfiler* profiler = nullptr) {
+        return completeLocalStages(lattice, config, profiler, [&]() {
+            return computeGradients3D(lattice, N_x, N_y, N_z);
+        });
+    }
+
+    /**
+     * Causal field, derived quantities, gradients (dimension-specific) and
+     * optional normalization, each timed into its phase when profiled
+     */
+    template<typename Real, typename Gradients>
+    static uint64_t completeLocalStages(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                                        PhaseProfiler* profiler, Gradients&& gradients) {
+        uint64_t operations = 0;
+        {
+            DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_CAUSAL);
+            operations += evolveCausalField(lattice, config.dt);
+        }
+        {
+            DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_DERIVED);
+            operations += updateDerivedQuantities(lattice);
+        }
+        {
+            DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_GRADIENTS);
+            operations += gradients();
+        }
+        if (config.normalize_psi) {
+            DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_NORMALIZE);
+            operations += normalizeStates(lattice);
+        }
+        return operations;
+    }
+
+    /**
+     * Causal field, derived quantities and (optionally) normalization of
+     * nodes [begin, end) in one pass
+     *
+     * Each stage only reads the node it writes, so the per-node order
+     * evolveCausalField → updateDerivedQuantities → normalizeStates gives
+     * the same values as the three separate sweeps. causal = false skips Φ
+     * (runRK4Steps advances it with Ψ).
+     */
+    template<typename Real>
+    static uint64_t updateLocal(IGSOALatticeSoAT<Real>& lattice, double dt, bool normalize,
+                                size_t begin, size_t end, bool causal = true) {
+        const Real step = static_cast<Real>(dt);
+        if (causal) {
+            normalize ? updateLocalRange<true, true>(lattice, step, begin, end)
+                      : updateLocalRange<false, true>(lattice, step, begin, end);
+        } else {
+            normalize ? updateLocalRange<true, false>(lattice, step, begin, end)
+                      : updateLocalRange<false, false>(lattice, step, begin, end);
+        }
+        return static_cast<uint64_t>(end - begin) * ((normalize ? 2 : 1) + (causal ? 1 : 0));
+    }
+
+    /**
+     * Run num_steps full time steps inside one OpenMP parallel region
+     *
+     * The lattice is cut into rows of row_length nodes (N_x in 2D/3D, 1 in
+     * 1D) and every thread owns one static block of rows for the whole
+     * mission. Per step:
+     *
+     *   driving (own rows)  | barrier
+     *   Ψ coupling (thread 0) | barrier
+     *   fused causal / derived / normalize (own rows) | barrier
+     *   gradients (own rows)
+     *
+     * This overload keeps the coupling sweep serial, for couplings that
+     * cannot be cut into slabs (the recursive 1D filter); the banded one
+     * below shares it out. Gradients only read F and nothing before the
+     * next fused pass writes it, so they need no trailing barrier. Below
+     * kParallelThreshold nodes the region runs on one thread.
+     *
+     * On steps the observables recorder samples, every thread adds its rows
+     * to its partial sums right after the fused pass and thread 0 records
+     * the combined sample after that pass's barrier, before the gradients.
+     *
+     * Thread 0 times each phase up to and including its barrier; the fused
+     * pass is reported as IGSOA_PHASE_CAUSAL, the sampling as
+     * IGSOA_PHASE_OBSERVABLES.
+     *
+     * @param coupling Ψ update; returns its operation count
+     * @param gradient_rows Gradients of rows [begin, end)
+     * @param observables Recorder after beginMission(), or nullptr
+     * @return Operations, counted as by the per-step helpers
+     */
+    template<typename Real, typename Coupling, typename GradientRows>
+    static uint64_t runSteps(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                             uint64_t num_steps, size_t row_length,
+                             const double* input_signals, const double* control_patterns,
+                             PhaseProfiler* profiler, Coupling&& coupling, GradientRows&& gradient_rows,
+                             IGSOAObservableRecorder* observables = nullptr) {
+        uint64_t coupling_operations = 0;
+        runStepLoop(lattice, config, num_steps, row_length, input_signals, control_patterns, profiler, true,
+                    [&](size_t thread, size_t, size_t) {
+                        if (thread == 0) coupling_operations += coupling();
+                        #pragma omp barrier
+                    },
+                    gradient_rows, observables);
+        return coupling_operations + localOperations(lattice, config, num_steps, input_signals, control_patterns);
+    }
+
+    /**
+     * The bands a sweep over nodes lattice nodes runs: one below
+     * kParallelThreshold, where the mission runs on one thread anyway
+     */
+    static IGSOACouplingBands effectiveBands(const IGSOACouplingBands& bands, size_t nodes) {
+        IGSOACouplingBands schedule = bands;
+        if (nodes < kParallelThreshold) {
+            schedule.count = 1;
+            schedule.colors = 1;
+        }
+        return schedule;
+    }
+
+    /**
+     * Sweep every band, one color after the other
+     *
+     * Called by every thread of the enclosing parallel region (or outside
+     * one): the team takes the bands of a color dynamically, one at a time,
+     * and a barrier closes the color.
+     *
+     * @return Operations of the bands this thread swept
+     */
+    template<typename CouplingSlabs>
+    static uint64_t sweepBands(const IGSOACouplingBands& schedule, CouplingSlabs&& coupling_slabs) {
+        const long count = static_cast<long>(schedule.count);
+        uint64_t operations = 0;
+        for (size_t color = 0; color < schedule.colors; color++) {
+            #pragma omp for schedule(dynamic, 1) nowait
+            for (long b = 0; b < count; b++) {
+                const size_t band = static_cast<size_t>(b);
+                if (schedule.color(band) != color) continue;
+                operations += coupling_slabs(schedule.begin(band), schedule.end(band));
+            }
+            #pragma omp barrier
+        }
+        return operations;
+    }
+
+    /**
+     * runSteps() with the Ψ sweep shared out by bands (IGSOACouplingBands)
+     *
+     * Per color, the team takes the bands of that color (dynamically, one
+     * at a time) and coupling_slabs(slab_begin, slab_end) sweeps each in
+     * raster order; a barrier closes every color. Jacobi bands first run
+     * prepare() on thread 0, behind a barrier. Below kParallelThreshold
+     * nodes the sweep is the serial raster order, so small lattices step
+     * exactly as before.
+     *
+     * @param coupling_slabs Ψ update of slabs [begin, end); returns its operation count
+     */
+    template<typename Real, typename Prepare, typename CouplingSlabs, typename GradientRows>
+    static uint64_t runSteps(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                             uint64_t num_steps, size_t row_length,
+                             const double* input_signals, const double* control_patterns,
+                             PhaseProfiler* profiler, const IGSOACouplingBands& bands,
+                             Prepare&& prepare, CouplingSlabs&& coupling_slabs, GradientRows&& gradient_rows,
+                             IGSOAObservableRecorder* observables = nullptr) {
+        const IGSOACouplingBands schedule = effectiveBands(bands, lattice.size());
+        uint64_t coupling_operations = 0;
+        runStepLoop(lattice, config, num_steps, row_length, input_signals, control_patterns, profiler, true,
+                    [&](size_t thread, size_t, size_t) {
+                        if (schedule.prepare_first) {
+                            if (thread == 0) prepare();
+                            #pragma omp barrier
+                        }
+                        const uint64_t operations = sweepBands(schedule, coupling_slabs);
+                        #pragma omp atomic
+                        coupling_operations += operations;
+                    },
+                    gradient_rows, observables);
+        return coupling_operations + localOperations(lattice, config, num_steps, input_signals, control_patterns);
+    }
+
+    /**
+     * runSteps() with the classical RK4 integrator (IGSOAIntegrator::RK4)
+     *
+     * Integrates the coupled system
+     *
+     *     ∂Ψ/∂t = -i/ℏ (-𝒦[Ψ] + κΦΨ + iΓΨ),    ∂Φ/∂t = -κ(Φ - Re Ψ) - γΦ
+     *
+     * with stages k_s = f(state + c_s·dt·k_{s-1}), c = (0, ½, ½, 1), and
+     * weights (1, 2, 2, 1)/6. Each stage is one pass over every thread's own
+     * rows: row_coupling(u_re, u_im, row, nl_re, nl_im) points nl_re / nl_im
+     * at 𝒦[u] of one row, summed over the previous stage's Ψ, and the same
+     * pass forms the row's k_s, adds it to psi_dot / phi_dot and writes the
+     * next stage's input (the last stage advances the lattice). A stage only
+     * reads the copy the previous one wrote, so rows need no order and one
+     * barrier separates the stages. prepare(u_re, u_im), unless nullptr,
+     * runs on thread 0 before each stage (the spectral convolution).
+     *
+     * Φ advances with the stages, so the local pass only updates F and
+     * normalizes. After a step psi_dot / phi_dot hold its mean derivative
+     * (change / dt). Driving, observables and gradients are as in
+     * runSteps(); the stages are timed as IGSOA_PHASE_QUANTUM.
+     *
+     * @param stages Stage buffers (resized to the lattice)
+     * @param row_coupling Returns the neighbor terms it summed
+     * @return Operations: runSteps()'s count with four coupling sweeps
+     */
+    template<typename Real, typename Prepare, typename RowCoupling, typename GradientRows>
+    static uint64_t runRK4Steps(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                                uint64_t num_steps, size_t row_length,
+                                const double* input_signals, const double* control_patterns,
+                                PhaseProfiler* profiler, IGSOARK4StagesT<Real>& stages,
+                                Prepare&& prepare, RowCoupling&& row_coupling, GradientRows&& gradient_rows,
+                                IGSOAObservableRecorder* observables = nullptr) {
+        constexpr bool kPrepares = !std::is_same<std::decay_t<Prepare>, std::nullptr_t>::value;
+        if (stages.size() != lattice.size()) {
+            stages.resize(lattice.size());
+        }
+        const Real dt = static_cast<Real>(config.dt);
+        uint64_t coupling_operations = 0;
+        runStepLoop(lattice, config, num_steps, row_length, input_signals, control_patterns, profiler, false,
+                    [&](size_t thread, size_t row_begin, size_t row_end) {
+                        uint64_t operations = 0;
+                        for (int stage = 0; stage < 4; stage++) {
+                            if constexpr (kPrepares) {
+                                if (thread == 0) {
+                                    prepare(rk4InputRe(lattice, stages, stage), rk4InputIm(lattice, stages, stage));
+                                }
+                                #pragma omp barrier
+                            }
+                            operations += rk4StageRows(lattice, stages, stage, dt, row_length,
+                                                       row_begin, row_end, row_coupling);
+                            // The local pass reads only its own nodes, which stage 3 wrote
+                            if (stage < 3) {
+                                #pragma omp barrier
+                            }
+                        }
+                        #pragma omp atomic
+                        coupling_operations += operations;
+                    },
+                    gradient_rows, observables);
+        return coupling_operations + localOperations(lattice, config, num_steps, input_signals, control_patterns);
+    }
+
+    /**
+     * Jacobi coupling rows for runRK4Steps(): 𝒦[u] of row y (2D) or row
+     * z·N_y + y (3D) from the stencil, into the thread's row scratch
+     *
+     * Every entry, in-row ones included, is gathered from u as it is, so
+     * the result does not depend on the sweep order.
+     *
+     * @return Neighbor terms summed
+     */
+    template<typename Real>
+    static uint64_t stencilCouplingRow2D(const CouplingStencil2D& stencil, const Real* u_re, const Real* u_im,
+                                         size_t N_x, size_t N_y, size_t y,
+                                         const Real*& nl_re, const Real*& nl_im) {
+        const int N_y_int = static_cast<int>(N_y);
+        const int* off_y = stencil.dy();
+        return stencilCouplingRow(stencil, u_re, u_im, N_x, y * N_x, nl_re, nl_im, [&](size_t k) {
+            return static_cast<size_t>(wrapIndex(static_cast<int>(y) + off_y[k], N_y_int)) * N_x;
+        });
+    }
+
+    template<typename Real>
+    static uint64_t stencilCouplingRow3D(const CouplingStencil3D& stencil, const Real* u_re, const Real* u_im,
+                                         size_t N_x, size_t N_y, size_t N_z, size_t r,
+                                         const Real*& nl_re, const Real*& nl_im) {
+        const int y = static_cast<int>(r % N_y);
+        const int z = static_cast<int>(r / N_y);
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const int* off_y = stencil.dy();
+        const int* off_z = stencil.dz();
+        return stencilCouplingRow(stencil, u_re, u_im, N_x, r * N_x, nl_re, nl_im, [&](size_t k) {
+            return (static_cast<size_t>(wrapIndex(z + off_z[k], N_z_int)) * N_y +
+                    static_cast<size_t>(wrapIndex(y + off_y[k], N_y_int))) * N_x;
+        });
+    }
+
+    /**
+     * Coupling rows for runRK4Steps() from per-node sums: node(i, nl_re,
+     * nl_im) adds 𝒦[u] of node i (boxCoupling1D/2D/3D, neighbor lists,
+     * spectral results) and returns its terms
+     */
+    template<typename Node>
+    static uint64_t nodeCouplingRow(size_t begin, size_t count, const double*& nl_re, const double*& nl_im,
+                                    Node&& node) {
+        RK4RowBuffer& buffer = rk4RowBuffer(count);
+        uint64_t terms = 0;
+        for (size_t l = 0; l < count; l++) {
+            double re = 0.0;
+            double im = 0.0;
+            terms += node(begin + l, re, im);
+            buffer.re[l] = re;
+            buffer.im[l] = im;
+        }
+        nl_re = buffer.re.data();
+        nl_im = buffer.im.data();
+        return terms;
+    }
+
+    /**
+     * Run num_steps undriven steps as one pass over the z-slabs per step
+     *
+     * Per step, for z = 0 .. N_z-1: stencil Ψ sweep of slab z (one thread),
+     * then, once no later sweep reads them, the fused causal / derived /
+     * normalization pass of slab z - reach and the gradients of the slab
+     * before it (threads over the slab's rows). Each slab is touched in
+     * one window of the pass instead of once per phase, which keeps the
+     * resident set of a file-backed lattice bounded (out_of_core.h);
+     * streamer.enter(z) issues the read-ahead and release hints first.
+     *
+     * The Ψ sweep reads Φ only at the node it updates, and the fused pass
+     * of a slab runs after the last sweep reading its Ψ. The state
+     * therefore equals the serial runSteps() with the same stencil: the
+     * sweep keeps the raster order, since slab bands would take one pass
+     * over the files per color. The first `reach`
+     * slabs are read again by the periodic wrap; they and the last ones
+     * finish after the sweep. Driving acts on the whole lattice before the
+     * sweep and is not supported, nor is observable sampling. Each slab is
+     * timed into its phase.
+     *
+     * @return Operations, counted as by runSteps
+     */
+    template<typename Real>
+    static uint64_t runSlabSteps(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                                 const CouplingStencil3D& stencil, uint64_t num_steps,
+                                 size_t N_x, size_t N_y, size_t N_z,
+                                 SlabStreamer& streamer, PhaseProfiler* profiler) {
+        const size_t plane_size = N_x * N_y;
+        const size_t reach = std::min(static_cast<size_t>(std::max(stencil.reach(), 0)), N_z);
+        const bool parallel = plane_size >= kParallelThreshold;
+        uint64_t coupling_operations = 0;
+        std::vector<char> local_done(N_z), gradient_done(N_z);
+
+        auto local = [&](size_t z) {
+            DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_CAUSAL);
+            const long rows = static_cast<long>(N_y);
+            #pragma omp parallel for schedule(static) if(parallel)
+            for (long y = 0; y < rows; y++) {
+                const size_t row = z * plane_size + static_cast<size_t>(y) * N_x;
+                updateLocal(lattice, config.dt, config.normalize_psi, row, row + N_x);
+            }
+            local_done[z] = 1;
+        };
+        auto gradients = [&](size_t z) {
+            DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_GRADIENTS);
+            const long rows = static_cast<long>(N_y);
+            #pragma omp parallel for schedule(static) if(parallel)
+            for (long y = 0; y < rows; y++) {
+                const size_t row = z * N_y + static_cast<size_t>(y);
+                computeGradients3D(lattice, N_x, N_y, N_z, row, row + 1);
+            }
+            gradient_done[z] = 1;
+        };
+
+        for (uint64_t step = 0; step < num_steps; step++) {
+            std::fill(local_done.begin(), local_done.end(), 0);
+            std::fill(gradient_done.begin(), gradient_done.end(), 0);
+            for (size_t z = 0; z < N_z; z++) {
+                {
+                    DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_TRANSFER);
+                    streamer.enter(z);
+                }
+                {
+                    DASE_PROFILE_PHASE(profiler, IGSOA_PHASE_QUANTUM);
+                    coupling_operations += evolveQuantumStateSlabs3D(lattice, stencil, config.dt,
+                                                                     N_x, N_y, N_z, z, z + 1);
+                }
+                // Slab z - reach is read by no later sweep (nor by the wrap)
+                if (z >= 2 * reach) {
+                    const size_t k = z - reach;
+                    local(k);
+                    if (k >= reach + 2) gradients(k - 1);
+                }
+            }
+            for (size_t k = 0; k < N_z; k++) {
+                if (!local_done[k]) local(k);
+            }
+            for (size_t k = 0; k < N_z; k++) {
+                if (!gradient_done[k]) gradients(k);
+            }
+        }
+
+        // Causal field, derived quantities, gradients, normalization
+        const uint64_t local_per_node = 3 + (config.normalize_psi ? 1 : 0);
+        return coupling_operations + num_steps * local_per_node * static_cast<uint64_t>(lattice.size());
+    }
+
+    /**
+     * Run up to num_steps undriven steps through an active-region mask
+     *
+     * Per step, inside one parallel region:
+     *
+     *   scan stepped tiles (threads) | mask update (one thread)
+     *   Ψ coupling over the mask, by bands (threads)
+     *   fused causal / derived pass over the mask (threads)
+     *   gradients over the mask (threads)
+     *
+     * Stops early once the mask covers the whole lattice, so the caller can
+     * finish the mission on runSteps(). The mask scan and update are timed
+     * as IGSOA_PHASE_ACTIVE_MASK. Normalization is not supported (it would
+     * lift sub-threshold nodes to |Ψ| = 1).
+     *
+     * The bands are the ones runSteps() sweeps the full lattice by, so a
+     * masked step matches a dense one up to the skipped nodes.
+     *
+     * @param coupling_slabs Ψ update of the mask in slabs [begin, end); returns its operation count
+     * @param operations Incremented by the work done, counted as by runSteps
+     * @return Steps run
+     */
+    template<typename Real, typename CouplingSlabs>
+    static uint64_t runActiveSteps(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                                   uint64_t num_steps, size_t N_x, size_t N_y, size_t N_z,
+                                   IGSOAActiveRegion& region, PhaseProfiler* profiler,
+                                   const IGSOACouplingBands& bands, CouplingSlabs&& coupling_slabs,
+                                   uint64_t& operations) {
+        const size_t N = lattice.size();
+        if (N == 0 || num_steps == 0) return 0;
+        const IGSOACouplingBands schedule = effectiveBands(bands, N);
+        uint64_t steps_run = 0;
+        uint64_t work = 0;
+        bool dense = false;
+        region.beginMission();
+
+        #pragma omp parallel if(N >= kParallelThreshold)
+        {
+            PhaseProfiler* timer = nullptr;
+#ifdef _OPENMP
+            if (omp_get_thread_num() == 0) timer = profiler;
+#else
+            timer = profiler;
+#endif
+            for (uint64_t step = 0; step < num_steps; step++) {
+                {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_ACTIVE_MASK);
+                    const long scans = static_cast<long>(region.scanCount());
+                    #pragma omp for schedule(dynamic, 4)
+                    for (long k = 0; k < scans; k++) {
+                        region.scanTile(lattice, static_cast<size_t>(k));
+                    }
+                    #pragma omp single
+                    {
+                        dense = region.update();
+                        if (!dense) {
+                            region.countMaskedStep();
+                            steps_run++;
+                            work += 3 * static_cast<uint64_t>(region.activeNodes());
+                        }
+                    }
+                }
+                if (dense) break;
+
+                const std::vector<size_t>& rows = region.activeRows();
+                const size_t* seg_x0 = region.segmentBegin();
+                const size_t* seg_x1 = region.segmentEnd();
+                const long row_count = static_cast<long>(rows.size());
+                {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_QUANTUM);
+                    const uint64_t swept = sweepBands(schedule, coupling_slabs);
+                    #pragma omp atomic
+                    work += swept;
+                }
+                {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_CAUSAL);
+                    #pragma omp for schedule(static)
+                    for (long i = 0; i < row_count; i++) {
+                        size_t begin, end;
+                        region.rowSegments(rows[i], begin, end);
+                        const size_t row = rows[i] * N_x;
+                        for (size_t s = begin; s < end; s++) {
+                            updateLocal(lattice, config.dt, false, row + seg_x0[s], row + seg_x1[s]);
+                        }
+                    }
+                }
+                {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_GRADIENTS);
+                    #pragma omp for schedule(static)
+                    for (long i = 0; i < row_count; i++) {
+                        size_t begin, end;
+                        region.rowSegments(rows[i], begin, end);
+                        for (size_t s = begin; s < end; s++) {
+                            computeGradientsRow(lattice, N_x, N_y, N_z, rows[i], seg_x0[s], seg_x1[s]);
+                        }
+                    }
+                }
+            }
+        }
+
+        operations += work;
+        return steps_run;
+    }
+
+    /**
+     * Gradient magnitude |∇F| of nodes [x_lo, x_hi) of row r = (r % N_y, r / N_y)
+     *
+     * Central differences as computeGradients2D/3D; pass N_z = 1 in 2D (the
+     * z difference is then zero and adds nothing).
+     */
+    template<typename Real>
+    static void computeGradientsRow(IGSOALatticeSoAT<Real>& lattice, size_t N_x, size_t N_y, size_t N_z,
+                                    size_t r, size_t x_lo, size_t x_hi) {
+        const size_t plane_size = N_x * N_y;
+        const Real* F = lattice.F.data();
+        Real* grad = lattice.F_gradient.data();
+        const size_t z = r / N_y;
+        const size_t y = r % N_y;
+        const size_t plane = z * plane_size;
+        const size_t plane_front = ((z == N_z - 1) ? 0 : z + 1) * plane_size;
+        const size_t plane_back = ((z == 0) ? N_z - 1 : z - 1) * plane_size;
+        const size_t row = y * N_x;
+        const size_t row_up = ((y == N_y - 1) ? 0 : y + 1) * N_x;
+        const size_t row_down = ((y == 0) ? N_y - 1 : y - 1) * N_x;
+
+        for (size_t x = x_lo; x < x_hi; x++) {
+            const size_t x_right = (x == N_x - 1) ? 0 : x + 1;
+            const size_t x_left = (x == 0) ? N_x - 1 : x - 1;
+
+            const Real dF_dx = (F[plane + row + x_right] - F[plane + row + x_left]) * Real(0.5);
+            const Real dF_dy = (F[plane + row_up + x] - F[plane + row_down + x]) * Real(0.5);
+            if (N_z == 1) {
+                grad[plane + row + x] = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy);
+            } else {
+                const Real dF_dz = (F[plane_front + row + x] - F[plane_back + row + x]) * Real(0.5);
+                grad[plane + row + x] = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy + dF_dz * dF_dz);
+            }
+        }
+    }
+
+    /**
+     * Apply external driving signal to every node
+     */
+    template<typename Real>
+    static void applyDriving(IGSOALatticeSoAT<Real>& lattice, double signal_real, double signal_imag = 0.0) {
+        applyDriving(lattice, signal_real, signal_imag, 0, lattice.size());
+    }
+
+    /**
+     * Apply external driving signal to nodes [begin, end)
+     */
+    template<typename Real>
+    static void applyDriving(IGSOALatticeSoAT<Real>& lattice, double signal_real, double signal_imag,
+                             size_t begin, size_t end) {
+        const Real re = static_cast<Real>(signal_real);
+        const Real im = static_cast<Real>(signal_imag);
+        for (size_t i = begin; i < end; i++) {
+            lattice.phi[i] += re;
+            lattice.psi_re[i] += re;
+            lattice.psi_im[i] += im;
+        }
+    }
+
+    /**
+     * Total system energy E = ∑_i [|Ψ_i|² + Φ_i²]
+     */
+    template<typename Real>
+    static double computeTotalEnergy(const IGSOALatticeSoAT<Real>& lattice) {
+        double energy = 0.0;
+        for (size_t i = 0; i < lattice.size(); i++) {
+            const double phi = lattice.phi[i];
+            energy += lattice.F[i];
+            energy += phi * phi;
+        }
+        return energy;
+    }
+
+    /**
+     * Total entropy production rate Ṡ_total = ∑_i Ṡ_i
+     */
+    template<typename Real>
+    static double computeTotalEntropyRate(const IGSOALatticeSoAT<Real>& lattice) {
+        double total_entropy = 0.0;
+        for (size_t i = 0; i < lattice.size(); i++) {
+            total_entropy += lattice.entropyRate(i);
+        }
+        return total_entropy;
+    }
+
+private:
+    /**
+     * Mission loop of runSteps() / runRK4Steps(): quantum(thread, row_begin,
+     * row_end) is the Ψ phase of one step and ends with a barrier; causal
+     * selects whether the fused local pass advances Φ
+     */
+    template<typename Real, typename Quantum, typename GradientRows>
+    static void runStepLoop(IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                            uint64_t num_steps, size_t row_length,
+                            const double* input_signals, const double* control_patterns,
+                            PhaseProfiler* profiler, bool causal, Quantum&& quantum, GradientRows&& gradient_rows,
+                            IGSOAObservableRecorder* observables) {
+        const size_t N = lattice.size();
+        if (N == 0 || row_length == 0) return;
+        const size_t rows = N / row_length;
+        const bool driven = input_signals && control_patterns;
+
+        #pragma omp parallel if(N >= kParallelThreshold)
+        {
+            size_t thread = 0, threads = 1;
+#ifdef _OPENMP
+            thread = static_cast<size_t>(omp_get_thread_num());
+            threads = static_cast<size_t>(omp_get_num_threads());
+#endif
+            const size_t row_begin = rows * thread / threads;
+            const size_t row_end = rows * (thread + 1) / threads;
+            const size_t begin = row_begin * row_length;
+            const size_t end = row_end * row_length;
+            PhaseProfiler* timer = (thread == 0) ? profiler : nullptr;
+
+            for (uint64_t step = 0; step < num_steps; step++) {
+                if (driven) {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_DRIVING);
+                    applyDriving(lattice, input_signals[step], control_patterns[step], begin, end);
+                    #pragma omp barrier
+                }
+                {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_QUANTUM);
+                    quantum(thread, row_begin, row_end);
+                }
+                const bool sample = observables && observables->due(step);
+                {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_CAUSAL);
+                    updateLocal(lattice, config.dt, config.normalize_psi, begin, end, causal);
+                    if (!sample) {
+                        #pragma omp barrier
+                    }
+                }
+                if (sample) {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_OBSERVABLES);
+                    observables->accumulate(lattice, begin, end, thread);
+                    #pragma omp barrier
+                    if (thread == 0) observables->commit(step, threads);
+                }
+                {
+                    DASE_PROFILE_PHASE(timer, IGSOA_PHASE_GRADIENTS);
+                    gradient_rows(row_begin, row_end);
+                }
+            }
+        }
+    }
+
+    // Driving, causal field, derived quantities, gradients, normalization
+    template<typename Real>
+    static uint64_t localOperations(const IGSOALatticeSoAT<Real>& lattice, const IGSOAComplexConfig& config,
+                                    uint64_t num_steps, const double* input_signals,
+                                    const double* control_patterns) {
+        const bool driven = input_signals && control_patterns;
+        const uint64_t local_per_node = 3 + (config.normalize_psi ? 1 : 0) + (driven ? 1 : 0);
+        return num_steps * local_per_node * static_cast<uint64_t>(lattice.size());
+    }
+
+    // Ψ read by RK4 stage s: the lattice, then copies 0, 1, 0
+    template<typename Real>
+    static const Real* rk4InputRe(const IGSOALatticeSoAT<Real>& lattice, const IGSOARK4StagesT<Real>& stages,
+                                  int stage) {
+        return stage == 0 ? lattice.psi_re.data() : stages.psi_re[stage == 2 ? 1 : 0].data();
+    }
+
+    template<typename Real>
+    static const Real* rk4InputIm(const IGSOALatticeSoAT<Real>& lattice, const IGSOARK4StagesT<Real>& stages,
+                                  int stage) {
+        return stage == 0 ? lattice.psi_im.data() : stages.psi_im[stage == 2 ? 1 : 0].data();
+    }
+
+    // One RK4 stage over rows [row_begin, row_end): coupling row, then the fused node update
+    template<typename Real, typename RowCoupling>
+    static uint64_t rk4StageRows(IGSOALatticeSoAT<Real>& lattice, IGSOARK4StagesT<Real>& stages, int stage,
+                                 Real dt, size_t row_length, size_t row_begin, size_t row_end,
+                                 RowCoupling& row_coupling) {
+        const Real* u_re = rk4InputRe(lattice, stages, stage);
+        const Real* u_im = rk4InputIm(lattice, stages, stage);
+        uint64_t terms = 0;
+        for (size_t r = row_begin; r < row_end; r++) {
+            const Real* nl_re = nullptr;
+            const Real* nl_im = nullptr;
+            terms += row_coupling(u_re, u_im, r, nl_re, nl_im);
+            const size_t begin = r * row_length;
+            switch (stage) {
+                case 0: rk4StageRange<0>(lattice, stages, begin, row_length, nl_re, nl_im, dt); break;
+                case 1: rk4StageRange<1>(lattice, stages, begin, row_length, nl_re, nl_im, dt); break;
+                case 2: rk4StageRange<2>(lattice, stages, begin, row_length, nl_re, nl_im, dt); break;
+                default: rk4StageRange<3>(lattice, stages, begin, row_length, nl_re, nl_im, dt); break;
+            }
+        }
+        return terms + static_cast<uint64_t>((row_end - row_begin) * row_length);
+    }
+
+    /**
+     * Stage update of nodes [begin, begin + count) from their coupling
+     *
+     * k = f(u) as in advancePsi (ℏ = 1) and evolveCausalField, with u the
+     * stage input. Stages 0-2 add k (weight 1, 2, 2) to psi_dot / phi_dot
+     * and write state + c·dt·k as the next input; stage 3 turns the sum
+     * into the mean derivative and advances the lattice.
+     */
+    template<int Stage, typename Real>
+    static void rk4StageRange(IGSOALatticeSoAT<Real>& lattice, IGSOARK4StagesT<Real>& stages,
+                              size_t begin, size_t count, const Real* nl_re, const Real* nl_im, Real dt) {
+        constexpr int kIn = (Stage == 2) ? 1 : 0;
+        constexpr int kOut = (Stage == 1) ? 1 : 0;
+        const Real* u_re = (Stage == 0) ? lattice.psi_re.data() : stages.psi_re[kIn].data();
+        const Real* u_im = (Stage == 0) ? lattice.psi_im.data() : stages.psi_im[kIn].data();
+        const Real* u_phi = (Stage == 0) ? lattice.phi.data() : stages.phi[kIn].data();
+        Real* psi_re = lattice.psi_re.data();
+        Real* psi_im = lattice.psi_im.data();
+        Real* phi = lattice.phi.data();
+        Real* acc_re = lattice.psi_dot_re.data();
+        Real* acc_im = lattice.psi_dot_im.data();
+        Real* acc_phi = lattice.phi_dot.data();
+        Real* out_re = stages.psi_re[kOut].data();
+        Real* out_im = stages.psi_im[kOut].data();
+        Real* out_phi = stages.phi[kOut].data();
+        const Real* kappa = lattice.kappa.data();
+        const Real* gamma = lattice.gamma.data();
+        const Real c = (Stage == 2) ? dt : dt * Real(0.5);
+        const Real sixth = Real(1) / Real(6);
+
+        #pragma omp simd
+        for (size_t l = 0; l < count; l++) {
+            const size_t i = begin + l;
+            const Real re = u_re[i];
+            const Real im = u_im[i];
+            const Real ph = u_phi[i];
+            const Real V_eff = kappa[i] * ph;
+            const Real g = gamma[i];
+
+            // k_Ψ = -i (-𝒦[u] + V_eff u + iΓ u),  k_Φ = -κ(Φ - Re u) - γΦ
+            const Real k_re = -nl_im[l] + V_eff * im + g * re;
+            const Real k_im = nl_re[l] - V_eff * re + g * im;
+            const Real k_phi = -kappa[i] * (ph - re) - g * ph;
+
+            if (Stage == 0) {
+                acc_re[i] = k_re;
+                acc_im[i] = k_im;
+                acc_phi[i] = k_phi;
+            } else if (Stage < 3) {
+                acc_re[i] += Real(2) * k_re;
+                acc_im[i] += Real(2) * k_im;
+                acc_phi[i] += Real(2) * k_phi;
+            }
+            if (Stage < 3) {
+                out_re[i] = psi_re[i] + c * k_re;
+                out_im[i] = psi_im[i] + c * k_im;
+                out_phi[i] = phi[i] + c * k_phi;
+            } else {
+                const Real mean_re = (acc_re[i] + k_re) * sixth;
+                const Real mean_im = (acc_im[i] + k_im) * sixth;
+                const Real mean_phi = (acc_phi[i] + k_phi) * sixth;
+                acc_re[i] = mean_re;
+                acc_im[i] = mean_im;
+                acc_phi[i] = mean_phi;
+                psi_re[i] += dt * mean_re;
+                psi_im[i] += dt * mean_im;
+                phi[i] += dt * mean_phi;
+            }
+        }
+    }
+
+    /**
+     * stencilCouplingRow2D/3D: every stencil entry as a gathered entry,
+     * read from the row source_row(k) returns
+     */
+    template<typename Stencil, typename Real, typename SourceRow>
+    static uint64_t stencilCouplingRow(const Stencil& stencil, const Real* u_re, const Real* u_im,
+                                       size_t N_x, size_t row, const Real*& nl_re, const Real*& nl_im,
+                                       SourceRow&& source_row) {
+        const int N_x_int = static_cast<int>(N_x);
+        const int reach = stencil.reach();
+        const size_t K = stencil.size();
+        const int* off_x = stencil.dx();
+        const Real* weight = stencilWeight<Real>(stencil);
+
+        RowScratch<Real>& scratch = rowScratch<Real>(N_x, K);
+        std::fill(scratch.cross_re.data(), scratch.cross_re.data() + N_x, Real(0));
+        std::fill(scratch.cross_im.data(), scratch.cross_im.data() + N_x, Real(0));
+        scratch.clear();
+        const int x_begin = std::min(reach, N_x_int);
+        const int x_end = std::max(x_begin, N_x_int - reach);
+
+        for (size_t k = 0; k < K; k++) {
+            const size_t row_j = source_row(k);
+            addCrossEntry(scratch, u_re + row, u_im + row, u_re + row_j, u_im + row_j,
+                          off_x[k], weight[k], N_x_int, x_begin, x_end);
+        }
+        gatherRow(scratch, u_re + row, u_im + row, x_begin, x_end);
+
+        nl_re = scratch.cross_re.data();
+        nl_im = scratch.cross_im.data();
+        return static_cast<uint64_t>(N_x * K);
+    }
+
+    // Per-thread coupling row of nodeCouplingRow()
+    struct RK4RowBuffer {
+        LatticeArray<double> re;
+        LatticeArray<double> im;
+    };
+
+    static RK4RowBuffer& rk4RowBuffer(size_t count) {
+        static thread_local RK4RowBuffer buffer;
+        if (buffer.re.size() < count) {
+            buffer.re.resize(count);
+            buffer.im.resize(count);
+        }
+        return buffer;
+    }
+
+    template<bool Normalize, bool Causal, typename Real>
+    static void updateLocalRange(IGSOALatticeSoAT<Real>& lattice, Real step, size_t begin, size_t end) {
+        Real* psi_re = lattice.psi_re.data();
+        Real* psi_im = lattice.psi_im.data();
+        Real* phi = lattice.phi.data();
+        Real* phi_dot = lattice.phi_dot.data();
+        const Real* kappa = lattice.kappa.data();
+        const Real* gamma = lattice.gamma.data();
+        Real* F_out = lattice.F.data();
+
+        #pragma omp simd
+        for (size_t i = begin; i < end; i++) {
+            const Real re = psi_re[i];
+            const Real im = psi_im[i];
+
+            // evolveCausalField
+            if (Causal) {
+                const Real dot = -kappa[i] * (phi[i] - re) - gamma[i] * phi[i];
+                const Real phi_new = phi[i] + dot * step;
+                phi_dot[i] = dot;
+                phi[i] = phi_new;
+            }
+
+            // updateDerivedQuantities
+            F_out[i] = re * re + im * im;
+
+            // normalizeStates
+            if (Normalize) {
+                const Real magnitude = std::hypot(re, im);
+                if (magnitude > Real(1e-15)) {
+                    psi_re[i] = re / magnitude;
+                    psi_im[i] = im / magnitude;
+                }
+            }
+        }
+    }
+
+    // Per-thread row buffers of the stencil sweeps: gathered coupling of the
+    // entries that read unchanged nodes (linear offset from the swept node),
+    // and the entries that land in the swept row (all of them for the edge
+    // columns, only those behind the swept node for interior columns)
+    template<typename Real>
+    struct RowScratch {
+        LatticeArray<Real> cross_re;
+        LatticeArray<Real> cross_im;
+        std::vector<std::ptrdiff_t> cross_offset;
+        std::vector<Real> cross_weight;
+        std::vector<size_t> in_row;
+        std::vector<size_t> in_row_behind;
+
+        void clear() {
+            cross_offset.clear();
+            cross_weight.clear();
+            in_row.clear();
+            in_row_behind.clear();
+        }
+    };
+
+    template<typename Real>
+    static RowScratch<Real>& rowScratch(size_t N_x, size_t K) {
+        static thread_local RowScratch<Real> scratch;
+        if (scratch.cross_re.size() < N_x) {
+            scratch.cross_re.resize(N_x);
+            scratch.cross_im.resize(N_x);
+        }
+        scratch.cross_offset.reserve(K);
+        scratch.cross_weight.reserve(K);
+        scratch.in_row.reserve(K);
+        scratch.in_row_behind.reserve(K);
+        return scratch;
+    }
+
+    static inline int wrapIndex(int v, int N) {
+        if (v >= 0 && v < N) return v;
+        if (v < 0 && v + N >= 0) return v + N;
+        if (v >= N && v - N < N) return v - N;
+        int r = v % N;
+        return (r < 0) ? r + N : r;
+    }
+
+    /**
+     * Record one other-row stencil entry and add its coupling at the edge
+     * columns (which wrap in x); interior columns are gathered by gatherRow
+     */
+    template<typename Real>
+    static inline void addCrossEntry(RowScratch<Real>& scratch, const Real* self_re, const Real* self_im,
+                                     const Real* src_re, const Real* src_im,
+                                     int dx, Real w, int N_x, int x_begin, int x_end) {
+        scratch.cross_offset.push_back((src_re - self_re) + dx);
+        scratch.cross_weight.push_back(w);
+        Real* cross_re = scratch.cross_re.data();
+        Real* cross_im = scratch.cross_im.data();
+        for (int x = 0; x < N_x; x = (x + 1 == x_begin) ? x_end : x + 1) {
+            const int x_j = wrapIndex(x + dx, N_x);
+            cross_re[x] += w * (src_re[x_j] - self_re[x]);
+            cross_im[x] += w * (src_im[x_j] - self_im[x]);
+        }
+    }
+
+    /**
+     * Record one stencil entry within the swept row; for interior columns an
+     * entry ahead of the node (dx > 0) still reads the old value, so it joins
+     * the gathered entries
+     */
+    template<typename Real>
+    static inline void addInRowEntry(RowScratch<Real>& scratch, int dx, Real w, size_t k) {
+        scratch.in_row.push_back(k);
+        if (dx > 0) {
+            scratch.cross_offset.push_back(dx);
+            scratch.cross_weight.push_back(w);
+        } else {
+            scratch.in_row_behind.push_back(k);
+        }
+    }
+
+    /**
+     * Gathered coupling of the interior columns [x_begin, x_end): blocks of
+     * 16 then 4 columns with the accumulators held in registers across
+     * entries, scalar for the last few; compiled for the active SIMD level
+     */
+    template<typename Real>
+    static inline void gatherRow(RowScratch<Real>& scratch, const Real* self_re, const Real* self_im,
+                                 int x_begin, int x_end) {
+#if DASE_SIMD_DISPATCH
+        const SimdLevel level = activeSimdLevel();
+        if (level >= SimdLevel::AVX512) return gatherRowAVX512(scratch, self_re, self_im, x_begin, x_end);
+        if (level >= SimdLevel::AVX2) return gatherRowAVX2(scratch, self_re, self_im, x_begin, x_end);
+#endif
+        gatherRowBlocks(scratch, self_re, self_im, x_begin, x_end);
+    }
+
+#if DASE_SIMD_DISPATCH
+    template<typename Real>
+    DASE_TARGET_AVX2 static void gatherRowAVX2(RowScratch<Real>& scratch, const Real* self_re,
+                                               const Real* self_im, int x_begin, int x_end) {
+        gatherRowBlocks(scratch, self_re, self_im, x_begin, x_end);
+    }
+
+    template<typename Real>
+    DASE_TARGET_AVX512 static void gatherRowAVX512(RowScratch<Real>& scratch, const Real* self_re,
+                                                   const Real* self_im, int x_begin, int x_end) {
+        gatherRowBlocks(scratch, self_re, self_im, x_begin, x_end);
+    }
+#endif
+
+    // Always inlined so each gatherRow variant compiles it for its own target
+    template<typename Real>
+    DASE_ALWAYS_INLINE static void gatherRowBlocks(RowScratch<Real>& scratch, const Real* self_re,
+                                                   const Real* self_im, int x_begin, int x_end) {
+        int x = gatherBlocks<16>(scratch, self_re, self_im, x_begin, x_end);
+        x = gatherBlocks<4>(scratch, self_re, self_im, x, x_end);
+        gatherBlocks<1>(scratch, self_re, self_im, x, x_end);
+    }
+
+    // Gather whole Lanes-wide blocks from x_begin; returns the first column left over
+    template<int Lanes, typename Real>
+    DASE_ALWAYS_INLINE static int gatherBlocks(RowScratch<Real>& scratch, const Real* self_re, const Real* self_im,
+                                   int x_begin, int x_end) {
+        const size_t E = scratch.cross_offset.size();
+        const std::ptrdiff_t* offset = scratch.cross_offset.data();
+        const Real* weight = scratch.cross_weight.data();
+        Real* cross_re = scratch.cross_re.data();
+        Real* cross_im = scratch.cross_im.data();
+
+        int x = x_begin;
+        for (; x + Lanes <= x_end; x += Lanes) {
+            Real acc_re[Lanes] = {};
+            Real acc_im[Lanes] = {};
+            for (size_t e = 0; e < E; e++) {
+                const Real w = weight[e];
+                const Real* src_re = self_re + x + offset[e];
+                const Real* src_im = self_im + x + offset[e];
+                #pragma omp simd
+                for (int l = 0; l < Lanes; l++) {
+                    acc_re[l] += w * (src_re[l] - self_re[x + l]);
+                    acc_im[l] += w * (src_im[l] - self_im[x + l]);
+                }
+            }
+            for (int l = 0; l < Lanes; l++) {
+                cross_re[x + l] = acc_re[l];
+                cross_im[x + l] = acc_im[l];
+            }
+        }
+        return x;
+    }
+
+    /**
+     * One row of a fixed-radius sweep: src_re/src_im[line] points at the row
+     * each stencil line reads (S::kSelfLine is the swept row). As in
+     * gatherRow/sweepRow, the interior columns first gather the S::KC entries
+     * not behind the node in register blocks, then the sequential pass adds
+     * the S::KB entries behind it; edge columns sum the other-row entries
+     * then the in-row ones, wrapped in x. Trip counts are compile-time, and
+     * offsets and weights are copied to locals so the gathered stores cannot
+     * alias them.
+     */
+    template<typename S, typename Real>
+    static inline void sweepFixedRow(IGSOALatticeSoAT<Real>& lattice, size_t row,
+                                     const Real* const* src_re, const Real* const* src_im,
+                                     const Real* weight, int N_x, Real step, Real inv_hbar) {
+        constexpr auto& t = S::table;
+        constexpr int K = S::K;
+        constexpr int R = S::radius;
+        const Real* self_re = src_re[S::kSelfLine];
+        const Real* self_im = src_im[S::kSelfLine];
+        RowScratch<Real>& scratch = rowScratch<Real>(static_cast<size_t>(N_x), 0);
+        Real* cross_re = scratch.cross_re.data();
+        Real* cross_im = scratch.cross_im.data();
+
+        std::ptrdiff_t offset[S::KC];
+        Real cross_w[S::KC];
+        for (int e = 0; e < S::KC; e++) {
+            const int k = t.cross[e];
+            offset[e] = (src_re[t.line[k]] - self_re) + t.dx[k];
+            cross_w[e] = weight[k];
+        }
+        Real behind_w[S::KB];
+        for (int e = 0; e < S::KB; e++) {
+            behind_w[e] = weight[t.behind_at[e]];
+        }
+
+        gatherFixedRow<S>(self_re, self_im, offset, cross_w, cross_re, cross_im, R, N_x - R);
+
+        for (int x = 0; x < N_x; x++) {
+            const Real s_re = self_re[x];
+            const Real s_im = self_im[x];
+            Real nl_re;
+            Real nl_im;
+            if (x >= R && x < N_x - R) {
+                nl_re = cross_re[x];
+                nl_im = cross_im[x];
+                for (int e = 0; e < S::KB; e++) {
+                    const int dx = t.dx[t.behind_at[e]];
+                    nl_re += behind_w[e] * (self_re[x + dx] - s_re);
+                    nl_im += behind_w[e] * (self_im[x + dx] - s_im);
+                }
+            } else {
+                nl_re = Real(0);
+                nl_im = Real(0);
+                for (int k = 0; k < K; k++) {
+                    if (t.in_row[k]) continue;
+                    const int x_j = wrapIndex(x + t.dx[k], N_x);
+                    nl_re += weight[k] * (src_re[t.line[k]][x_j] - s_re);
+                    nl_im += weight[k] * (src_im[t.line[k]][x_j] - s_im);
+                }
+                for (int k = 0; k < K; k++) {
+                    if (!t.in_row[k]) continue;
+                    const int x_j = wrapIndex(x + t.dx[k], N_x);
+                    nl_re += weight[k] * (self_re[x_j] - s_re);
+                    nl_im += weight[k] * (self_im[x_j] - s_im);
+                }
+            }
+            advancePsi(lattice, row + static_cast<size_t>(x), nl_re, nl_im, step, inv_hbar);
+        }
+    }
+
+    // gatherRow over the S::KC gathered entries of a fixed-radius stencil
+    template<typename S, typename Real>
+    static inline void gatherFixedRow(const Real* self_re, const Real* self_im,
+                                      const std::ptrdiff_t* offset, const Real* w,
+                                      Real* cross_re, Real* cross_im, int x_begin, int x_end) {
+#if DASE_SIMD_DISPATCH
+        const SimdLevel level = activeSimdLevel();
+        if (level >= SimdLevel::AVX512) {
+            return gatherFixedRowAVX512<S>(self_re, self_im, offset, w, cross_re, cross_im, x_begin, x_end);
+        }
+        if (level >= SimdLevel::AVX2) {
+            return gatherFixedRowAVX2<S>(self_re, self_im, offset, w, cross_re, cross_im, x_begin, x_end);
+        }
+#endif
+        gatherFixedRowBlocks<S>(self_re, self_im, offset, w, cross_re, cross_im, x_begin, x_end);
+    }
+
+#if DASE_SIMD_DISPATCH
+    template<typename S, typename Real>
+    DASE_TARGET_AVX2 static void gatherFixedRowAVX2(const Real* self_re, const Real* self_im,
+                                                    const std::ptrdiff_t* offset, const Real* w,
+                                                    Real* cross_re, Real* cross_im, int x_begin, int x_end) {
+        gatherFixedRowBlocks<S>(self_re, self_im, offset, w, cross_re, cross_im, x_begin, x_end);
+    }
+
+    template<typename S, typename Real>
+    DASE_TARGET_AVX512 static void gatherFixedRowAVX512(const Real* self_re, const Real* self_im,
+                                                        const std::ptrdiff_t* offset, const Real* w,
+                                                        Real* cross_re, Real* cross_im, int x_begin, int x_end) {
+        gatherFixedRowBlocks<S>(self_re, self_im, offset, w, cross_re, cross_im, x_begin, x_end);
+    }
+#endif
+
+    template<typename S, typename Real>
+    DASE_ALWAYS_INLINE static void gatherFixedRowBlocks(const Real* self_re, const Real* self_im,
+                                                        const std::ptrdiff_t* offset, const Real* w,
+                                                        Real* cross_re, Real* cross_im, int x_begin, int x_end) {
+        int x = gatherFixedBlocks<S, 16>(self_re, self_im, offset, w, cross_re, cross_im, x_begin, x_end);
+        x = gatherFixedBlocks<S, 4>(self_re, self_im, offset, w, cross_re, cross_im, x, x_end);
+        gatherFixedBlocks<S, 1>(self_re, self_im, offset, w, cross_re, cross_im, x, x_end);
+    }
+
+    template<typename S, int Lanes, typename Real>
+    DASE_ALWAYS_INLINE static int gatherFixedBlocks(const Real* self_re, const Real* self_im,
+                                        const std::ptrdiff_t* offset, const Real* w,
+                                        Real* cross_re, Real* cross_im, int x_begin, int x_end) {
+        int x = x_begin;
+        for (; x + Lanes <= x_end; x += Lanes) {
+            Real acc_re[Lanes] = {};
+            Real acc_im[Lanes] = {};
+            for (int e = 0; e < S::KC; e++) {
+                const Real we = w[e];
+                const Real* src_re = self_re + x + offset[e];
+                const Real* src_im = self_im + x + offset[e];
+                #pragma omp simd
+                for (int l = 0; l < Lanes; l++) {
+                    acc_re[l] += we * (src_re[l] - self_re[x + l]);
+                    acc_im[l] += we * (src_im[l] - self_im[x + l]);
+                }
+            }
+            for (int l = 0; l < Lanes; l++) {
+                cross_re[x + l] = acc_re[l];
+                cross_im[x + l] = acc_im[l];
+            }
+        }
+        return x;
+    }
+
+    /**
+     * Stepped nodes of mask row r
+     */
+    static inline uint64_t maskedRowNodes(const IGSOAActiveRegion& region, size_t r) {
+        size_t begin, end;
+        region.rowSegments(r, begin, end);
+        uint64_t nodes = 0;
+        for (size_t s = begin; s < end; s++) {
+            nodes += region.segmentEnd()[s] - region.segmentBegin()[s];
+        }
+        return nodes;
+    }
+
+    /**
+     * Gather and sweep the stepped column segments of row r (active region)
+     */
+    template<typename Real>
+    static inline void sweepSegments(IGSOALatticeSoAT<Real>& lattice, size_t row, size_t r,
+                                     const IGSOAActiveRegion& region, RowScratch<Real>& scratch,
+                                     const int* off_x, const Real* weight,
+                                     int N_x, int x_begin, int x_end, Real step, Real inv_hbar) {
+        const Real* self_re = lattice.psi_re.data() + row;
+        const Real* self_im = lattice.psi_im.data() + row;
+        size_t begin, end;
+        region.rowSegments(r, begin, end);
+        for (size_t s = begin; s < end; s++) {
+            const int x_lo = static_cast<int>(region.segmentBegin()[s]);
+            const int x_hi = static_cast<int>(region.segmentEnd()[s]);
+            gatherRow(scratch, self_re, self_im, std::max(x_lo, x_begin), std::min(x_hi, x_end));
+            sweepRow(lattice, row, scratch, off_x, weight, N_x, x_begin, x_end, step, inv_hbar, x_lo, x_hi);
+        }
+    }
+
+    /**
+     * Sequential pass over columns [x_lo, x_hi) of one row: add the in-row
+     * entries still pending (earlier columns already advanced) to the
+     * gathered coupling and advance each node
+     */
+    template<typename Real>
+    static inline void sweepRow(IGSOALatticeSoAT<Real>& lattice, size_t row,
+                                const RowScratch<Real>& scratch, const int* off_x, const Real* weight,
+                                int N_x, int x_begin, int x_end, Real step, Real inv_hbar,
+                                int x_lo, int x_hi) {
+        const Real* psi_re = lattice.psi_re.data() + row;
+        const Real* psi_im = lattice.psi_im.data() + row;
+        const size_t* in_row = scratch.in_row.data();
+        const size_t R = scratch.in_row.size();
+        const size_t* behind = scratch.in_row_behind.data();
+        const size_t B = scratch.in_row_behind.size();
+
+        for (int x = x_lo; x < x_hi; x++) {
+            const Real self_re = psi_re[x];
+            const Real self_im = psi_im[x];
+            Real nl_re = scratch.cross_re[x];
+            Real nl_im = scratch.cross_im[x];
+
+            if (x >= x_begin && x < x_end) {
+                for (size_t r = 0; r < B; r++) {
+                    const size_t k = behind[r];
+                    nl_re += weight[k] * (psi_re[x + off_x[k]] - self_re);
+                    nl_im += weight[k] * (psi_im[x + off_x[k]] - self_im);
+                }
+            } else {
+                for (size_t r = 0; r < R; r++) {
+                    const size_t k = in_row[r];
+                    const int x_j = wrapIndex(x + off_x[k], N_x);
+                    nl_re += weight[k] * (psi_re[x_j] - self_re);
+                    nl_im += weight[k] * (psi_im[x_j] - self_im);
+                }
+            }
+
+            advancePsi(lattice, row + static_cast<size_t>(x), nl_re, nl_im, step, inv_hbar);
+        }
+    }
+
+    // Stencil weights in the lattice precision
+    template<typename Real, typename Stencil>
+    static const Real* stencilWeight(const Stencil& stencil) {
+        if constexpr (std::is_same<Real, float>::value) {
+            return stencil.weightF32();
+        } else {
+            return stencil.weight();
+        }
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
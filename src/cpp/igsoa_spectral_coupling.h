@@ -0,0 +1,289 @@
+/**
+ * IGSOA Spectral Coupling - FFT Convolution of the Non-Local Kernel
+ *
+ * On a torus with uniform R_c the coupling sum
+ *
+ *     𝒦[Ψ]_i = ∑_j K(|r_i - r_j|, R_c) (Ψ_j - Ψ_i) = (G ⋆ Ψ)_i - W Ψ_i
+ *
+ * is a circular correlation of Ψ with the wrapped kernel grid G (the
+ * CouplingStencil2D/3D weights scattered onto the lattice, aliased offsets
+ * summed) minus W = ∑ K times Ψ_i.  With the transform of G precomputed, one
+ * step costs a forward and an inverse FFT, O(N log N), instead of O(N·K).
+ *
+ * Unlike the in-place direct sweeps, every node sees Ψ at the start of the
+ * step (Jacobi rather than Gauss-Seidel ordering); trajectories agree with the
+ * direct path to O(dt²) per step.
+ *
+ * Plans come from FFTWWisdomCache. Requires a build with USE_FFTW3; without it
+ * isAvailable() is false and engines never select the spectral path.
+ */
+
+#pragma once
+
+#include "igsoa_coupling_stencil.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#ifdef USE_FFTW3
+#include "fftw_wisdom_cache.hpp"
+#endif
+
+namespace dase {
+namespace igsoa {
+
+class SpectralCoupling {
+public:
+    /**
+     * Stencil terms per log2(N) above which the FFT path is cheaper
+     *
+     * Direct: ~4 flops per stencil term and node. FFT: two complex transforms,
+     * ~10·log2(N) flops per node, plus memory passes the gather does not need.
+     */
+    static constexpr double kCrossover = 4.0;
+
+    static constexpr bool isAvailable() {
+#ifdef USE_FFTW3
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Cost model: true when the FFT path beats a K-term stencil on N nodes
+     */
+    static bool isFavorable(size_t stencil_terms, size_t num_nodes) {
+        if (!isAvailable() || num_nodes < 2 || stencil_terms == 0) return false;
+        return static_cast<double>(stencil_terms) >
+               kCrossover * std::log2(static_cast<double>(num_nodes));
+    }
+
+    SpectralCoupling() = default;
+    ~SpectralCoupling() { release(); }
+
+    SpectralCoupling(const SpectralCoupling&) = delete;
+    SpectralCoupling& operator=(const SpectralCoupling&) = delete;
+
+    /**
+     * Precompute the kernel transform for a 2D stencil on an N_x × N_y torus
+     */
+    void build(const CouplingStencil2D& stencil, size_t N_x, size_t N_y) {
+        allocate(N_x, N_y, 1, stencil.radius(), stencil.size());
+        const int* dx = stencil.dx();
+        const int* dy = stencil.dy();
+        const double* weight = stencil.weight();
+        for (size_t k = 0; k < stencil.size(); k++) {
+            scatterWeight(wrapIndex(dx[k], N_x) + wrapIndex(dy[k], N_y) * N_x, weight[k]);
+        }
+        transformKernel();
+    }
+
+    /**
+     * Precompute the kernel transform for a 3D stencil on an N_x × N_y × N_z torus
+     */
+    void build(const CouplingStencil3D& stencil, size_t N_x, size_t N_y, size_t N_z) {
+        allocate(N_x, N_y, N_z, stencil.radius(), stencil.size());
+        const int* dx = stencil.dx();
+        const int* dy = stencil.dy();
+        const int* dz = stencil.dz();
+        const double* weight = stencil.weight();
+        for (size_t k = 0; k < stencil.size(); k++) {
+            scatterWeight(wrapIndex(dx[k], N_x) + wrapIndex(dy[k], N_y) * N_x +
+                          wrapIndex(dz[k], N_z) * N_x * N_y, weight[k]);
+        }
+        transformKernel();
+    }
+
+    /**
+     * True if built for exactly this radius and lattice (N_z = 1 for 2D)
+     */
+    bool matches(double R_c, size_t N_x, size_t N_y, size_t N_z = 1) const {
+        return built_ && radius_ == R_c && N_x_ == N_x && N_y_ == N_y && N_z_ == N_z;
+    }
+
+    /**
+     * Evaluate 𝒦[Ψ]_i for every node; read back with couplingRe/Im(i)
+     */
+    void convolve(const double* psi_re, const double* psi_im) {
+#ifdef USE_FFTW3
+        const size_t N = size();
+        for (size_t i = 0; i < N; i++) {
+            buffer_[i][0] = psi_re[i];
+            buffer_[i][1] = psi_im[i];
+        }
+
+        fftw_execute(forward_);
+        for (size_t i = 0; i < N; i++) {
+            const double re = buffer_[i][0];
+            const double im = buffer_[i][1];
+            buffer_[i][0] = re * spectrum_re_[i] - im * spectrum_im_[i];
+            buffer_[i][1] = re * spectrum_im_[i] + im * spectrum_re_[i];
+        }
+        fftw_execute(backward_);
+
+        for (size_t i = 0; i < N; i++) {
+            buffer_[i][0] -= weight_sum_ * psi_re[i];
+            buffer_[i][1] -= weight_sum_ * psi_im[i];
+        }
+#else
+        (void)psi_re;
+        (void)psi_im;
+        throw std::runtime_error("FFTW3 not available - spectral coupling disabled");
+#endif
+    }
+
+    double couplingRe(size_t i) const {
+#ifdef USE_FFTW3
+        return buffer_[i][0];
+#else
+        (void)i;
+        return 0.0;
+#endif
+    }
+
+    double couplingIm(size_t i) const {
+#ifdef USE_FFTW3
+        return buffer_[i][1];
+#else
+        (void)i;
+        return 0.0;
+#endif
+    }
+
+    size_t size() const { return N_x_ * N_y_ * N_z_; }
+    size_t terms() const { return terms_; }   // Stencil terms the convolution replaces
+    double radius() const { return radius_; }
+    bool isBuilt() const { return built_; }
+
+    /**
+     * Bytes held by the FFT buffer and kernel spectrum
+     */
+    size_t getMemoryUsage() const {
+        if (!built_) return 0;
+        return size() * 2 * sizeof(double) +
+               (spectrum_re_.capacity() + spectrum_im_.capacity()) * sizeof(double);
+    }
+
+    // Bytes build() allocates for a lattice of num_nodes nodes
+    static size_t estimateMemoryUsage(size_t num_nodes) {
+        return num_nodes * 4 * sizeof(double);
+    }
+
+private:
+    static size_t wrapIndex(int offset, size_t N) {
+        const int N_int = static_cast<int>(N);
+        int wrapped = offset % N_int;
+        if (wrapped < 0) wrapped += N_int;
+        return static_cast<size_t>(wrapped);
+    }
+
+    void allocate(size_t N_x, size_t N_y, size_t N_z, double R_c, size_t terms) {
+        release();
+#ifdef USE_FFTW3
+        const size_t N = N_x * N_y * N_z;
+        buffer_ = fftw_alloc_complex(N);
+        if (!buffer_) {
+            throw std::runtime_error("SpectralCoupling: FFT buffer allocation failed");
+        }
+
+        // Row-major lattice (x fastest) maps to FFTW dims (z, y, x)
+        if (N_z > 1) {
+            forward_ = FFTWWisdomCache::create_plan_3d(static_cast<int>(N_z), static_cast<int>(N_y),
+                                                       static_cast<int>(N_x), buffer_, buffer_, FFTW_FORWARD);
+            backward_ = FFTWWisdomCache::create_plan_3d(static_cast<int>(N_z), static_cast<int>(N_y),
+                                                        static_cast<int>(N_x), buffer_, buffer_, FFTW_BACKWARD);
+        } else {
+            forward_ = FFTWWisdomCache::create_plan_2d(static_cast<int>(N_y), static_cast<int>(N_x),
+                                                       buffer_, buffer_, FFTW_FORWARD);
+            backward_ = FFTWWisdomCache::create_plan_2d(static_cast<int>(N_y), static_cast<int>(N_x),
+                                                        buffer_, buffer_, FFTW_BACKWARD);
+        }
+        if (!forward_ || !backward_) {
+            release();
+            throw std::runtime_error("SpectralCoupling: FFT planning failed");
+        }
+
+        // Planning may overwrite the buffer, so the kernel is scattered afterwards
+        for (size_t i = 0; i < N; i++) {
+            buffer_[i][0] = 0.0;
+            buffer_[i][1] = 0.0;
+        }
+#else
+        throw std::runtime_error("FFTW3 not available - spectral coupling disabled");
+#endif
+        N_x_ = N_x;
+        N_y_ = N_y;
+        N_z_ = N_z;
+        radius_ = R_c;
+        terms_ = terms;
+        weight_sum_ = 0.0;
+    }
+
+    void scatterWeight(size_t index, double weight) {
+#ifdef USE_FFTW3
+        buffer_[index][0] += weight;
+        weight_sum_ += weight;
+#else
+        (void)index;
+        (void)weight;
+#endif
+    }
+
+    /**
+     * Store conj(Ĝ)/N so that IFFT(FFT(Ψ)·conj(Ĝ)/N) = G ⋆ Ψ
+     */
+    void transformKernel() {
+#ifdef USE_FFTW3
+        const size_t N = size();
+        fftw_execute(forward_);
+        spectrum_re_.resize(N);
+        spectrum_im_.resize(N);
+        const double scale = 1.0 / static_cast<double>(N);
+        for (size_t i = 0; i < N; i++) {
+            spectrum_re_[i] = buffer_[i][0] * scale;
+            spectrum_im_[i] = -buffer_[i][1] * scale;
+        }
+        built_ = true;
+#endif
+    }
+
+    void release() {
+#ifdef USE_FFTW3
+        if (forward_) fftw_destroy_plan(forward_);
+        if (backward_) fftw_destroy_plan(backward_);
+        if (buffer_) fftw_free(buffer_);
+        forward_ = nullptr;
+        backward_ = nullptr;
+        buffer_ = nullptr;
+#endif
+        spectrum_re_.clear();
+        spectrum_im_.clear();
+        built_ = false;
+        N_x_ = 0;
+        N_y_ = 0;
+        N_z_ = 0;
+        radius_ = -1.0;
+        terms_ = 0;
+    }
+
+#ifdef USE_FFTW3
+    fftw_complex* buffer_ = nullptr;   // Ψ̂ in place; holds 𝒦[Ψ] after convolve()
+    fftw_plan forward_ = nullptr;
+    fftw_plan backward_ = nullptr;
+#endif
+    std::vector<double> spectrum_re_;  // conj(Ĝ)/N
+    std::vector<double> spectrum_im_;
+    double weight_sum_ = 0.0;          // W = ∑ K over the stencil
+    double radius_ = -1.0;
+    size_t terms_ = 0;
+    size_t N_x_ = 0;
+    size_t N_y_ = 0;
+    size_t N_z_ = 0;
+    bool built_ = false;
+};
+
+} // namespace igsoa
+} // namespace dase
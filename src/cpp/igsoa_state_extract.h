@@ -0,0 +1,120 @@
+/**
+ * IGSOA State Extraction - Region-of-interest reads from the SoA lattice
+ *
+ * Copies a strided box of selected fields straight out of IGSOALatticeSoA,
+ * so snapshot consumers that need a crop, a subsample or a single field
+ * never pay for a full three-field copy. Output may be double or float.
+ *
+ * The lattice is row-major with extents (N_x, N_y, N_z); 1D and 2D
+ * lattices use N_y = 1 / N_z = 1. Output arrays are row-major over the
+ * sampled box with x fastest: index = (k * out_y + j) * out_x + i.
+ */
+
+#pragma once
+
+#include "igsoa_lattice_soa.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace dase {
+namespace igsoa {
+
+// Field selection bits (psi covers both real and imaginary planes)
+enum StateFieldMask : uint32_t {
+    STATE_FIELD_PSI = 1u << 0,
+    STATE_FIELD_F   = 1u << 1,
+    STATE_FIELD_PHI = 1u << 2,
+    STATE_FIELD_ALL = STATE_FIELD_PSI | STATE_FIELD_F | STATE_FIELD_PHI
+};
+
+/**
+ * Box [x0, x0+nx) x [y0, y0+ny) x [z0, z0+nz), sampled every stride nodes
+ */
+struct StateRegion {
+    size_t x0 = 0, y0 = 0, z0 = 0;
+    size_t nx = 0, ny = 1, nz = 1;
+    size_t stride = 1;
+
+    // Whole lattice, unstrided
+    static StateRegion full(size_t N_x, size_t N_y = 1, size_t N_z = 1) {
+        StateRegion region;
+        region.nx = N_x;
+        region.ny = N_y;
+        region.nz = N_z;
+        return region;
+    }
+
+    size_t outX() const { return stride ? (nx + stride - 1) / stride : 0; }
+    size_t outY() const { return stride ? (ny + stride - 1) / stride : 0; }
+    size_t outZ() const { return stride ? (nz + stride - 1) / stride : 0; }
+    size_t outCount() const { return outX() * outY() * outZ(); }
+
+    // Non-empty, positive stride and inside an (N_x, N_y, N_z) lattice
+    bool fits(size_t N_x, size_t N_y = 1, size_t N_z = 1) const {
+        return stride > 0 && nx > 0 && ny > 0 && nz > 0 &&
+               x0 + nx <= N_x && y0 + ny <= N_y && z0 + nz <= N_z;
+    }
+};
+
+/**
+ * Copy the masked fields of region into the output arrays
+ *
+ * Outputs for unselected fields are ignored and may be null; selected ones
+ * must hold region.outCount() values. Returns false (writing nothing) if the
+ * region does not fit or a selected output is null.
+ */
+template<typename Out>
+bool extractRegion(const IGSOALatticeSoA& lattice,
+                   size_t N_x, size_t N_y, size_t N_z,
+                   const StateRegion& region,
+                   uint32_t field_mask,
+                   Out* psi_real_out, Out* psi_imag_out,
+                   Out* F_out, Out* phi_out) {
+    const bool want_psi = (field_mask & STATE_FIELD_PSI) != 0;
+    const bool want_F = (field_mask & STATE_FIELD_F) != 0;
+    const bool want_phi = (field_mask & STATE_FIELD_PHI) != 0;
+
+    if (!region.fits(N_x, N_y, N_z) || N_x * N_y * N_z != lattice.size() ||
+        (want_psi && (!psi_real_out || !psi_imag_out)) ||
+        (want_F && !F_out) || (want_phi && !phi_out)) {
+        return false;
+    }
+
+    const size_t s = region.stride;
+    size_t out = 0;
+    for (size_t z = region.z0; z < region.z0 + region.nz; z += s) {
+        for (size_t y = region.y0; y < region.y0 + region.ny; y += s) {
+            // One row segment per field keeps each copy a contiguous or strided stream
+            const size_t row = (z * N_y + y) * N_x;
+            const size_t out_row = out;
+            if (want_psi) {
+                const double* re = lattice.psi_re.data() + row;
+                const double* im = lattice.psi_im.data() + row;
+                size_t o = out_row;
+                for (size_t x = region.x0; x < region.x0 + region.nx; x += s, o++) {
+                    psi_real_out[o] = static_cast<Out>(re[x]);
+                    psi_imag_out[o] = static_cast<Out>(im[x]);
+                }
+            }
+            if (want_F) {
+                const double* F = lattice.F.data() + row;
+                size_t o = out_row;
+                for (size_t x = region.x0; x < region.x0 + region.nx; x += s, o++) {
+                    F_out[o] = static_cast<Out>(F[x]);
+                }
+            }
+            if (want_phi) {
+                const double* phi = lattice.phi.data() + row;
+                size_t o = out_row;
+                for (size_t x = region.x0; x < region.x0 + region.nx; x += s, o++) {
+                    phi_out[o] = static_cast<Out>(phi[x]);
+                }
+            }
+            out += region.outX();
+        }
+    }
+    return true;
+}
+
+} // namespace igsoa
+} // namespace dase
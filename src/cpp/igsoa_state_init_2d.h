@@ -9,6 +9,9 @@
 
 #include "igsoa_complex_node.h"
 #include "igsoa_complex_engine_2d.h"
+#include "counter_rng.h"
+#include "profile_tables.h"
+#include "simd_math.h"
 #include <vector>
 #include <cmath>
 #include <complex>
@@ -72,48 +75,57 @@ public:
         IGSOAComplexEngine2D& engine,
         const Gaussian2DParams& params
     ) {
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
-
-        auto& nodes = engine.getNodesMutable();
-
-        for (size_t y = 0; y < N_y; y++) {
-            for (size_t x = 0; x < N_x; x++) {
-                size_t index = y * N_x + x;
+        initGaussians2D(engine, std::vector<Gaussian2DParams>{params});
+    }
 
-                // Compute distance from center
-                double dx = static_cast<double>(x) - params.center_x;
-                double dy = static_cast<double>(y) - params.center_y;
+    /**
+     * Apply several 2D Gaussian profiles in one sweep
+     *
+     * Same result as calling initGaussian2D for each entry in order. Each
+     * profile is the outer product of per-axis tables, A·gx[x]·gy[y], so a
+     * profile costs N_x + N_y exponentials; rows are split across threads.
+     *
+     * @param engine 2D IGSOA engine
+     * @param profiles Gaussian parameters, applied in order
+     */
+    static void initGaussians2D(
+        IGSOAComplexEngine2D& engine,
+        const std::vector<Gaussian2DParams>& profiles
+    ) {
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
 
-                // Gaussian envelope
-                double exponent = -(dx * dx) / (2.0 * params.sigma_x * params.sigma_x)
-                                  -(dy * dy) / (2.0 * params.sigma_y * params.sigma_y);
-                double gaussian_value = params.amplitude * std::exp(exponent);
+        auto& nodes = engine.getNodesMutable();
 
-                // New quantum state (real-valued Gaussian for now)
-                std::complex<double> psi_new(gaussian_value, 0.0);
+        struct Term {
+            ProfileMode mode;  // Unknown mode strings leave the state unchanged
+            std::vector<double> gx, gy;
+        };
+        std::vector<Term> terms;
+        terms.reserve(profiles.size());
+        for (const auto& p : profiles) {
+            terms.push_back({
+                parseProfileMode(p.mode, ProfileMode::None),
+                ProfileTables::gaussian(N_x, 1.0, p.center_x, 1.0 / (2.0 * p.sigma_x * p.sigma_x), false),
+                ProfileTables::gaussian(N_y, 1.0, p.center_y, 1.0 / (2.0 * p.sigma_y * p.sigma_y), false)
+            });
+        }
 
-                // Apply mode
-                if (params.mode == "overwrite") {
-                    // Replace existing state
-                    nodes[index].psi = psi_new;
-                    nodes[index].phi = params.baseline_phi;
-                }
-                else if (params.mode == "add") {
-                    // Add to existing state (perturbation)
-                    nodes[index].psi += psi_new;
-                    // Φ unchanged
+        #pragma omp parallel if(nodes.size() >= ProfileTables::kParallelThreshold)
+        {
+            std::vector<double> row(N_x);
+            const long rows = static_cast<long>(N_y);
+            #pragma omp for schedule(static)
+            for (long y = 0; y < rows; y++) {
+                auto* row_nodes = nodes.data() + static_cast<size_t>(y) * N_x;
+                for (size_t t = 0; t < terms.size(); t++) {
+                    const auto& p = profiles[t];
+                    ProfileTables::scaleRow(row.data(), terms[t].gx.data(), N_x, p.amplitude * terms[t].gy[y]);
+                    applyPsiProfileRow(row_nodes, row.data(), N_x, terms[t].mode, p.baseline_phi, p.beta);
                 }
-                else if (params.mode == "blend") {
-                    // Interpolate: Ψ_final = β*Ψ_new + (1-β)*Ψ_old
-                    double beta = params.beta;
-                    nodes[index].psi = beta * psi_new + (1.0 - beta) * nodes[index].psi;
-                    nodes[index].phi = beta * params.baseline_phi + (1.0 - beta) * nodes[index].phi;
+                for (size_t x = 0; x < N_x; x++) {
+                    row_nodes[x].updateInformationalDensity();
                 }
-
-                // Update derived quantities
-                nodes[index].updateInformationalDensity();
-                nodes[index].updatePhase();
             }
         }
     }
@@ -130,26 +142,23 @@ public:
         IGSOAComplexEngine2D& engine,
         const PlaneWave2DParams& params
     ) {
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
 
         auto& nodes = engine.getNodesMutable();
 
-        for (size_t y = 0; y < N_y; y++) {
-            for (size_t x = 0; x < N_x; x++) {
-                size_t index = y * N_x + x;
-
-                // Compute phase: φ = k_x*x + k_y*y + φ₀
-                double phase = params.k_x * static_cast<double>(x)
-                             + params.k_y * static_cast<double>(y)
-                             + params.phase_offset;
+        // Ψ = A·exp(i k_x x)·exp(i(k_y y + φ₀))
+        const auto ex = ProfileTables::phasor(N_x, params.k_x);
+        const auto ey = ProfileTables::phasor(N_y, params.k_y, params.phase_offset);
 
-                // Ψ = A * exp(iφ)
-                nodes[index].psi = params.amplitude * std::exp(std::complex<double>(0.0, phase));
-
-                // Update derived quantities
-                nodes[index].updateInformationalDensity();
-                nodes[index].updatePhase();
+        const long rows = static_cast<long>(N_y);
+        #pragma omp parallel for schedule(static) if(nodes.size() >= ProfileTables::kParallelThreshold)
+        for (long y = 0; y < rows; y++) {
+            auto* row_nodes = nodes.data() + static_cast<size_t>(y) * N_x;
+            const std::complex<double> row_factor = params.amplitude * ey[y];
+            for (size_t x = 0; x < N_x; x++) {
+                row_nodes[x].psi = row_factor * ex[x];
+                row_nodes[x].updateInformationalDensity();
             }
         }
     }
@@ -176,7 +185,6 @@ public:
             node.psi = std::complex<double>(psi_real, psi_imag);
             node.phi = phi;
             node.updateInformationalDensity();
-            node.updatePhase();
         }
     }
 
@@ -187,30 +195,30 @@ public:
      *
      * @param engine 2D IGSOA engine
      * @param amplitude_max Maximum amplitude of random values
-     * @param seed Random seed (0 = use time)
+     * @param seed Random seed (0 = non-reproducible)
      */
     static void initRandom(
         IGSOAComplexEngine2D& engine,
         double amplitude_max,
         unsigned int seed = 0
     ) {
-        if (seed == 0) {
-            seed = static_cast<unsigned int>(std::time(nullptr));
-        }
-
-        std::srand(seed);
+        const CounterRNG rng(seed == 0 ? CounterRNG::entropySeed() : seed);
 
+        // Node i draws block (0, i): the same state for any thread count
         auto& nodes = engine.getNodesMutable();
-
-        for (auto& node : nodes) {
+        const long count = static_cast<long>(nodes.size());
+        #pragma omp parallel for schedule(static) if(nodes.size() >= CounterRNG::kParallelThreshold)
+        for (long i = 0; i < count; i++) {
             // Random complex number with magnitude <= amplitude_max
-            double magnitude = amplitude_max * (static_cast<double>(std::rand()) / RAND_MAX);
-            double phase = 2.0 * M_PI * (static_cast<double>(std::rand()) / RAND_MAX);
+            double u_magnitude, u_phase;
+            rng.uniformPair(0, static_cast<uint64_t>(i), u_magnitude, u_phase);
+            const double magnitude = amplitude_max * u_magnitude;
+            const double phase = 2.0 * M_PI * u_phase;
 
+            auto& node = nodes[i];
             node.psi = magnitude * std::exp(std::complex<double>(0.0, phase));
             node.phi = 0.0;  // Start with Φ = 0
             node.updateInformationalDensity();
-            node.updatePhase();
         }
     }
 
@@ -268,7 +276,7 @@ public:
         size_t N_x = engine.getNx();
         size_t N_y = engine.getNy();
 
-        const auto& nodes = engine.getNodes();
+        const IGSOALatticeSoA& lattice = engine.getLattice();
 
         double sum_F = 0.0;
         // Use circular statistics for toroidal topology
@@ -277,20 +285,21 @@ public:
         double sum_cos_y = 0.0;
         double sum_sin_y = 0.0;
 
+        // Coordinates as angles on the unit circle, tabulated per axis
+        std::vector<double> cos_x, sin_x, cos_y, sin_y;
+        circleTable(N_x, cos_x, sin_x);
+        circleTable(N_y, cos_y, sin_y);
+
         for (size_t y = 0; y < N_y; y++) {
             for (size_t x = 0; x < N_x; x++) {
                 size_t index = y * N_x + x;
-                double F = nodes[index].F;
-
-                // Convert coordinates to angles on unit circle
-                double theta_x = 2.0 * M_PI * static_cast<double>(x) / static_cast<double>(N_x);
-                double theta_y = 2.0 * M_PI * static_cast<double>(y) / static_cast<double>(N_y);
+                double F = lattice.F[index];
 
                 sum_F += F;
-                sum_cos_x += F * std::cos(theta_x);
-                sum_sin_x += F * std::sin(theta_x);
-                sum_cos_y += F * std::cos(theta_y);
-                sum_sin_y += F * std::sin(theta_y);
+                sum_cos_x += F * cos_x[x];
+                sum_sin_x += F * sin_x[x];
+                sum_cos_y += F * cos_y[y];
+                sum_sin_y += F * sin_y[y];
             }
         }
 
@@ -310,6 +319,18 @@ public:
             y_cm_out = 0.0;
         }
     }
+
+private:
+    // cos/sin of θ = 2π·i/n for i < n (one batched sinCosArray per axis)
+    static void circleTable(size_t n, std::vector<double>& cos_out, std::vector<double>& sin_out) {
+        std::vector<double> theta(n);
+        for (size_t i = 0; i < n; i++) {
+            theta[i] = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n);
+        }
+        cos_out.resize(n);
+        sin_out.resize(n);
+        sinCosArray(theta.data(), sin_out.data(), cos_out.data(), n);
+    }
 };
 
 } // namespace igsoa
@@ -5,13 +5,15 @@
 #pragma once
 
 #include "igsoa_complex_engine_3d.h"
+#include "counter_rng.h"
+#include "profile_tables.h"
+#include "simd_math.h"
 #include <algorithm>
 #include <cmath>
 #include <complex>
 #include <cstdint>
-#include <ctime>
-#include <random>
 #include <string>
+#include <vector>
 
 // Define M_PI for MSVC
 #ifndef M_PI
@@ -53,52 +55,60 @@ public:
         IGSOAComplexEngine3D& engine,
         const Gaussian3DParams& params
     ) {
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
-        size_t N_z = engine.getNz();
+        initGaussians3D(engine, std::vector<Gaussian3DParams>{params});
+    }
 
-        auto& nodes = engine.getNodesMutable();
+    // Several Gaussians in one sweep, same result as initGaussian3D per entry
+    // in order. Each is A·gx[x]·gy[y]·gz[z] from per-axis tables; (z, y) rows
+    // are split across threads.
+    static void initGaussians3D(
+        IGSOAComplexEngine3D& engine,
+        const std::vector<Gaussian3DParams>& profiles
+    ) {
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
+        const size_t N_z = engine.getNz();
 
-        const double sigma_x = std::max(params.sigma_x, MIN_SIGMA_3D);
-        const double sigma_y = std::max(params.sigma_y, MIN_SIGMA_3D);
-        const double sigma_z = std::max(params.sigma_z, MIN_SIGMA_3D);
-        const double inv_two_sigma_x_sq = 1.0 / (2.0 * sigma_x * sigma_x);
-        const double inv_two_sigma_y_sq = 1.0 / (2.0 * sigma_y * sigma_y);
-        const double inv_two_sigma_z_sq = 1.0 / (2.0 * sigma_z * sigma_z);
-        const double baseline_phi = params.baseline_phi;
-        const std::string& mode = params.mode;
-        const double beta_clamped = std::clamp(params.beta, 0.0, 1.0);
+        auto& nodes = engine.getNodesMutable();
 
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t index = z * N_x * N_y + y * N_x + x;
+        struct Term {
+            ProfileMode mode;
+            double beta;
+            std::vector<double> gx, gy, gz;
+        };
+        std::vector<Term> terms;
+        terms.reserve(profiles.size());
+        for (const auto& p : profiles) {
+            const double sigma_x = std::max(p.sigma_x, MIN_SIGMA_3D);
+            const double sigma_y = std::max(p.sigma_y, MIN_SIGMA_3D);
+            const double sigma_z = std::max(p.sigma_z, MIN_SIGMA_3D);
+            terms.push_back({
+                parseProfileMode(p.mode),
+                std::clamp(p.beta, 0.0, 1.0),
+                ProfileTables::gaussian(N_x, 1.0, p.center_x, 1.0 / (2.0 * sigma_x * sigma_x), false),
+                ProfileTables::gaussian(N_y, 1.0, p.center_y, 1.0 / (2.0 * sigma_y * sigma_y), false),
+                ProfileTables::gaussian(N_z, 1.0, p.center_z, 1.0 / (2.0 * sigma_z * sigma_z), false)
+            });
+        }
 
-                    const double dx = static_cast<double>(x) - params.center_x;
-                    const double dy = static_cast<double>(y) - params.center_y;
-                    const double dz = static_cast<double>(z) - params.center_z;
-
-                    const double exponent = -(
-                        (dx * dx) * inv_two_sigma_x_sq +
-                        (dy * dy) * inv_two_sigma_y_sq +
-                        (dz * dz) * inv_two_sigma_z_sq
-                    );
-
-                    const double gaussian_value = params.amplitude * std::exp(exponent);
-                    const std::complex<double> psi_new(gaussian_value, 0.0);
-
-                    if (mode == "add") {
-                        nodes[index].psi += psi_new;
-                    } else if (mode == "blend") {
-                        nodes[index].psi = beta_clamped * psi_new + (1.0 - beta_clamped) * nodes[index].psi;
-                        nodes[index].phi = beta_clamped * baseline_phi + (1.0 - beta_clamped) * nodes[index].phi;
-                    } else {
-                        nodes[index].psi = psi_new;
-                        nodes[index].phi = baseline_phi;
-                    }
-
-                    nodes[index].updateInformationalDensity();
-                    nodes[index].updatePhase();
+        #pragma omp parallel if(nodes.size() >= ProfileTables::kParallelThreshold)
+        {
+            std::vector<double> row(N_x);
+            const long rows = static_cast<long>(N_z * N_y);
+            #pragma omp for schedule(static)
+            for (long r = 0; r < rows; r++) {
+                const size_t z = static_cast<size_t>(r) / N_y;
+                const size_t y = static_cast<size_t>(r) % N_y;
+                auto* row_nodes = nodes.data() + static_cast<size_t>(r) * N_x;
+                for (size_t t = 0; t < terms.size(); t++) {
+                    const auto& term = terms[t];
+                    ProfileTables::scaleRow(row.data(), term.gx.data(), N_x,
+                                            profiles[t].amplitude * term.gz[z] * term.gy[y]);
+                    applyPsiProfileRow(row_nodes, row.data(), N_x, term.mode,
+                                       profiles[t].baseline_phi, term.beta);
+                }
+                for (size_t x = 0; x < N_x; x++) {
+                    row_nodes[x].updateInformationalDensity();
                 }
             }
         }
@@ -133,24 +143,27 @@ public:
         IGSOAComplexEngine3D& engine,
         const PlaneWave3DParams& params
     ) {
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
-        size_t N_z = engine.getNz();
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
+        const size_t N_z = engine.getNz();
 
         auto& nodes = engine.getNodesMutable();
 
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t index = z * N_x * N_y + y * N_x + x;
-                    double phase = params.k_x * static_cast<double>(x)
-                                   + params.k_y * static_cast<double>(y)
-                                   + params.k_z * static_cast<double>(z)
-                                   + params.phase_offset;
-                    nodes[index].psi = params.amplitude * std::exp(std::complex<double>(0.0, phase));
-                    nodes[index].updateInformationalDensity();
-                    nodes[index].updatePhase();
-                }
+        // Ψ = A·exp(i k_x x)·exp(i k_y y)·exp(i(k_z z + φ₀))
+        const auto ex = ProfileTables::phasor(N_x, params.k_x);
+        const auto ey = ProfileTables::phasor(N_y, params.k_y);
+        const auto ez = ProfileTables::phasor(N_z, params.k_z, params.phase_offset);
+
+        const long rows = static_cast<long>(N_z * N_y);
+        #pragma omp parallel for schedule(static) if(nodes.size() >= ProfileTables::kParallelThreshold)
+        for (long r = 0; r < rows; r++) {
+            const size_t z = static_cast<size_t>(r) / N_y;
+            const size_t y = static_cast<size_t>(r) % N_y;
+            auto* row_nodes = nodes.data() + static_cast<size_t>(r) * N_x;
+            const std::complex<double> row_factor = params.amplitude * ez[z] * ey[y];
+            for (size_t x = 0; x < N_x; x++) {
+                row_nodes[x].psi = row_factor * ex[x];
+                row_nodes[x].updateInformationalDensity();
             }
         }
     }
@@ -166,7 +179,6 @@ public:
             node.psi = std::complex<double>(psi_real, psi_imag);
             node.phi = phi;
             node.updateInformationalDensity();
-            node.updatePhase();
         }
     }
 
@@ -178,17 +190,20 @@ public:
         const double max_amplitude = std::max(amplitude_max, 0.0);
         const double two_pi = 2.0 * M_PI;
 
-        std::mt19937_64 rng(seed == 0 ? static_cast<uint64_t>(std::time(nullptr)) : static_cast<uint64_t>(seed));
-        std::uniform_real_distribution<double> magnitude_dist(0.0, max_amplitude);
-        std::uniform_real_distribution<double> phase_dist(0.0, two_pi);
+        const CounterRNG rng(seed == 0 ? CounterRNG::entropySeed() : seed);
 
+        // Node i draws block (0, i): the same state for any thread count
         auto& nodes = engine.getNodesMutable();
-        for (auto& node : nodes) {
-            const double magnitude = magnitude_dist(rng);
-            const double phase = phase_dist(rng);
+        const long count = static_cast<long>(nodes.size());
+        #pragma omp parallel for schedule(static) if(nodes.size() >= CounterRNG::kParallelThreshold)
+        for (long i = 0; i < count; i++) {
+            double u_magnitude, u_phase;
+            rng.uniformPair(0, static_cast<uint64_t>(i), u_magnitude, u_phase);
+            const double magnitude = max_amplitude * u_magnitude;
+            const double phase = two_pi * u_phase;
+            auto& node = nodes[i];
             node.psi = magnitude * std::exp(std::complex<double>(0.0, phase));
             node.updateInformationalDensity();
-            node.updatePhase();
         }
     }
 
@@ -206,7 +221,7 @@ public:
         size_t N_y = engine.getNy();
         size_t N_z = engine.getNz();
 
-        const auto& nodes = engine.getNodes();
+        const IGSOALatticeSoA& lattice = engine.getLattice();
 
         double sum_F = 0.0;
         // Use circular statistics for toroidal topology
@@ -217,24 +232,25 @@ public:
         double sum_cos_z = 0.0;
         double sum_sin_z = 0.0;
 
+        // Coordinates as angles on the unit circle, tabulated per axis
+        std::vector<double> cos_x, sin_x, cos_y, sin_y, cos_z, sin_z;
+        circleTable(N_x, cos_x, sin_x);
+        circleTable(N_y, cos_y, sin_y);
+        circleTable(N_z, cos_z, sin_z);
+
         for (size_t z = 0; z < N_z; ++z) {
             for (size_t y = 0; y < N_y; ++y) {
                 for (size_t x = 0; x < N_x; ++x) {
                     size_t index = z * N_x * N_y + y * N_x + x;
-                    double F = nodes[index].F;
-
-                    // Convert coordinates to angles on unit circle
-                    double theta_x = 2.0 * M_PI * static_cast<double>(x) / static_cast<double>(N_x);
-                    double theta_y = 2.0 * M_PI * static_cast<double>(y) / static_cast<double>(N_y);
-                    double theta_z = 2.0 * M_PI * static_cast<double>(z) / static_cast<double>(N_z);
+                    double F = lattice.F[index];
 
                     sum_F += F;
-                    sum_cos_x += F * std::cos(theta_x);
-                    sum_sin_x += F * std::sin(theta_x);
-                    sum_cos_y += F * std::cos(theta_y);
-                    sum_sin_y += F * std::sin(theta_y);
-                    sum_cos_z += F * std::cos(theta_z);
-                    sum_sin_z += F * std::sin(theta_z);
+                    sum_cos_x += F * cos_x[x];
+                    sum_sin_x += F * sin_x[x];
+                    sum_cos_y += F * cos_y[y];
+                    sum_sin_y += F * sin_y[y];
+                    sum_cos_z += F * cos_z[z];
+                    sum_sin_z += F * sin_z[z];
                 }
             }
         }
@@ -260,8 +276,19 @@ public:
             z_cm_out = 0.0;
         }
     }
+
+private:
+    // cos/sin of θ = 2π·i/n for i < n (one batched sinCosArray per axis)
+    static void circleTable(size_t n, std::vector<double>& cos_out, std::vector<double>& sin_out) {
+        std::vector<double> theta(n);
+        for (size_t i = 0; i < n; i++) {
+            theta[i] = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n);
+        }
+        cos_out.resize(n);
+        sin_out.resize(n);
+        sinCosArray(theta.data(), sin_out.data(), cos_out.data(), n);
+    }
 };
 
 } // namespace igsoa
 } // namespace dase
-
@@ -218,6 +218,14 @@ public:
         return cache->evaluateTiered(distance);
     }
 
+    /**
+     * Drop all caches (e.g. before rebuilding for a new R_c distribution)
+     */
+    void clear() {
+        caches_.clear();
+        R_c_values_.clear();
+    }
+
     /**
      * Get total memory usage
      */
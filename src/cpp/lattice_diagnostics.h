@@ -0,0 +1,64 @@
+/**
+ * Lattice Diagnostics Helpers
+ *
+ * Shared pieces of the fused diagnostics passes (igsoa_diagnostics.h,
+ * satp_higgs_diagnostics.h):
+ *
+ *   CircularAxis   cos/sin of θ = 2π i / N for every index of one torus
+ *                  axis, built once per extent, so the circular-mean
+ *                  center of mass costs two multiply-adds per node and
+ *                  axis instead of a sin and a cos
+ *   circularCenter mean angle of accumulated (Σ w cos θ, Σ w sin θ)
+ *                  mapped back to a coordinate in [0, N)
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dase {
+
+class CircularAxis {
+public:
+    /**
+     * Tables for an axis of extent n (no-op if already built for n)
+     */
+    void build(size_t n) {
+        if (n == extent_) return;
+        extent_ = n;
+        cos_.resize(n);
+        sin_.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            const double theta = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n);
+            cos_[i] = std::cos(theta);
+            sin_[i] = std::sin(theta);
+        }
+    }
+
+    size_t extent() const { return extent_; }
+    const double* cosTable() const { return cos_.data(); }
+    const double* sinTable() const { return sin_.data(); }
+
+private:
+    size_t extent_ = 0;
+    std::vector<double> cos_;
+    std::vector<double> sin_;
+};
+
+/**
+ * Coordinate in [0, n) of the mean angle atan2(sum_sin, sum_cos)
+ */
+inline double circularCenter(double sum_cos, double sum_sin, size_t n) {
+    const double extent = static_cast<double>(n);
+    double center = extent * std::atan2(sum_sin, sum_cos) / (2.0 * M_PI);
+    if (center < 0.0) center += extent;
+    return center;
+}
+
+} // namespace dase
@@ -0,0 +1,196 @@
+/**
+ * Memory Admission - Process-wide budget for engine footprints
+ *
+ * Engines allocate whatever they are asked for, so concurrent sweeps on a
+ * shared machine can swap or be OOM-killed mid-mission. MemoryAdmission
+ * holds one budget for the whole process: callers reserve an engine's
+ * estimated footprint before allocating it and release it when the
+ * engine is freed. dase_cli's EngineManager does this for every engine of
+ * every daemon session.
+ *
+ *   MemoryAdmission& admission = MemoryAdmission::instance();
+ *   admission.setBudget(size_t(16) << 30);
+ *   if (admission.reserve(bytes, 30.0, &error)) { ... admission.release(bytes); }
+ *
+ * A request that fits is granted at once. One that does not either fails
+ * (wait_seconds <= 0) or waits, and waiters are admitted in arrival order:
+ * only the oldest waiter is granted when memory frees up, and a newcomer
+ * never passes a waiter, so a large request is not starved by a stream of
+ * small ones. A request larger than the whole budget fails immediately.
+ * A budget of 0 is unlimited; reservations are still counted.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace dase {
+
+struct MemoryAdmissionStats {
+    size_t budget_bytes = 0;         // 0: unlimited
+    size_t reserved_bytes = 0;
+    size_t peak_reserved_bytes = 0;
+    size_t waiting = 0;              // Requests queued right now
+    uint64_t admitted = 0;           // Granted, at once or after waiting
+    uint64_t waited = 0;             // Requests that had to queue
+    uint64_t rejected = 0;           // Over budget, full without waiting, or timed out
+};
+
+class MemoryAdmission {
+public:
+    // Longest wait a request may ask for (longer values are clamped)
+    static constexpr double kMaxWaitSeconds = 1.0e6;
+
+    static MemoryAdmission& instance() {
+        static MemoryAdmission admission;
+        return admission;
+    }
+
+    MemoryAdmission() = default;
+    MemoryAdmission(const MemoryAdmission&) = delete;
+    MemoryAdmission& operator=(const MemoryAdmission&) = delete;
+
+    /**
+     * Set the budget (0: unlimited). Existing reservations are kept even
+     * above a smaller budget; waiters that can no longer fit fail.
+     */
+    void setBudget(size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            budget_ = bytes;
+        }
+        changed_.notify_all();
+    }
+
+    size_t budget() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return budget_;
+    }
+
+    /**
+     * Reserve bytes if they fit now and nobody is waiting; never waits and
+     * does not count a refusal as a rejection (a first attempt before
+     * freeing memory the caller owns)
+     */
+    bool tryReserve(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!waiters_.empty() || !fits(bytes)) {
+            return false;
+        }
+        grant(bytes);
+        return true;
+    }
+
+    /**
+     * Reserve bytes, waiting up to wait_seconds in arrival order for
+     * releases to make room
+     *
+     * @param error Set to the reason when the request is refused
+     * @return false if bytes exceed the budget, or do not fit in time
+     */
+    bool reserve(size_t bytes, double wait_seconds, std::string* error = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (budget_ > 0 && bytes > budget_) {
+            return refuse(bytes, "exceeds the memory budget", error);
+        }
+        if (waiters_.empty() && fits(bytes)) {
+            grant(bytes);
+            return true;
+        }
+        if (!(wait_seconds > 0.0)) {
+            return refuse(bytes, "does not fit in the memory budget", error);
+        }
+
+        const uint64_t ticket = next_ticket_++;
+        waiters_.push_back(ticket);
+        waited_++;
+        const auto timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(std::min(wait_seconds, kMaxWaitSeconds)));
+        changed_.wait_for(lock, timeout, [&]() {
+            return (budget_ > 0 && bytes > budget_) || (waiters_.front() == ticket && fits(bytes));
+        });
+        const bool over_budget = budget_ > 0 && bytes > budget_;
+        const bool admitted = !over_budget && waiters_.front() == ticket && fits(bytes);
+        waiters_.erase(std::find(waiters_.begin(), waiters_.end(), ticket));
+        if (admitted) {
+            grant(bytes);
+        } else {
+            refuse(bytes, over_budget ? "exceeds the memory budget" : "did not fit in the memory budget in time",
+                   error);
+        }
+        lock.unlock();
+        changed_.notify_all();   // The next waiter may be at the front now
+        return admitted;
+    }
+
+    // Give back bytes of earlier reservations
+    void release(size_t bytes) {
+        if (bytes == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reserved_ -= std::min(bytes, reserved_);
+        }
+        changed_.notify_all();
+    }
+
+    MemoryAdmissionStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        MemoryAdmissionStats stats;
+        stats.budget_bytes = budget_;
+        stats.reserved_bytes = reserved_;
+        stats.peak_reserved_bytes = peak_;
+        stats.waiting = waiters_.size();
+        stats.admitted = admitted_;
+        stats.waited = waited_;
+        stats.rejected = rejected_;
+        return stats;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    size_t budget_ = 0;
+    size_t reserved_ = 0;
+    size_t peak_ = 0;
+    std::deque<uint64_t> waiters_;   // Tickets in arrival order
+    uint64_t next_ticket_ = 0;
+    uint64_t admitted_ = 0;
+    uint64_t waited_ = 0;
+    uint64_t rejected_ = 0;
+
+    bool fits(size_t bytes) const {
+        return budget_ == 0 || (reserved_ <= budget_ && bytes <= budget_ - reserved_);
+    }
+
+    void grant(size_t bytes) {
+        reserved_ += bytes;
+        peak_ = std::max(peak_, reserved_);
+        admitted_++;
+    }
+
+    // Count a refusal and explain it (mutex held)
+    bool refuse(size_t bytes, const char* reason, std::string* error) {
+        rejected_++;
+        if (error) {
+            std::ostringstream message;
+            message << "Engine footprint of " << megabytes(bytes) << " MB " << reason << " ("
+                    << megabytes(reserved_) << " of " << megabytes(budget_) << " MB reserved)";
+            *error = message.str();
+        }
+        return false;
+    }
+
+    static double megabytes(size_t bytes) {
+        return static_cast<double>(bytes) / 1048576.0;
+    }
+};
+
+} // namespace dase
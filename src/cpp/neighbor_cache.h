@@ -3,115 +3,104 @@
  *
  * Pre-computes and caches neighbor lists with coupling weights
  * Combines:
- * - Spatial hashing for fast neighbor discovery
- * - Kernel cache for fast weight computation
- * - Amplitude amplification tiering
+ * - CSR neighbor lists (one contiguous array of packed uint32 id + float
+ *   weight entries, per-node row offsets)
+ * - Kernel cache for fast weight computation (tiered lookup)
+ * - Per-node R_c through KernelCacheManager (heterogeneous lattices)
+ *
+ * Neighbors are enumerated on the torus exactly like the direct coupling
+ * loops (bounding box, wrapped distance, radius cutoff), so the only
+ * difference to IGSOAPhysics2D/3D is the tiered kernel approximation
+ * (stored as float; the coupling sum is accumulated in double).
+ *
+ * Lists are built in two parallel passes over the rows: the first counts
+ * each row's neighbors, a prefix sum turns the counts into row offsets,
+ * and the second writes every row straight into its slice of the shared
+ * array. The result is identical for every thread count.
  *
  * Expected speedup: 5-20x over naive neighbor search
  */
 
 #pragma once
 
-#include "spatial_hash.h"
 #include "kernel_cache.h"
 #include "igsoa_complex_node.h"
-#include <vector>
+#include "igsoa_lattice_soa.h"
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <cstdint>
+#include <vector>
 
 namespace dase {
 namespace igsoa {
 
 /**
- * Neighbor information for a single node
+ * One stored neighbor: lattice index and coupling weight
  */
-struct NeighborInfo {
-    int node_id;           // Index of neighbor node
-    double weight;         // Pre-computed coupling weight K(distance, R_c)
-    double distance;       // Distance (for debugging/analysis)
+struct NeighborEntry {
+    uint32_t id;
+    float weight;
 };
+static_assert(sizeof(NeighborEntry) == 8, "NeighborEntry must stay packed");
 
 /**
- * 2D Neighbor Cache
+ * CSR neighbor storage shared by the 2D and 3D caches
+ *
+ * Neighbors of node i occupy [row_offsets_[i], row_offsets_[i + 1]) in
+ * entries_.
  */
-class NeighborCache2D {
-private:
-    std::vector<std::vector<NeighborInfo>> neighbor_lists_;
-    KernelCache kernel_cache_;
-    SpatialHash2D spatial_hash_;
-
-    size_t N_x_, N_y_;
-    double R_c_;
-    bool is_built_;
-
-    // Distance computation (toroidal)
-    inline double wrappedDistance(int x1, int y1, int x2, int y2) const {
-        int dx = std::abs(x1 - x2);
-        int dy = std::abs(y1 - y2);
-
-        dx = std::min(dx, static_cast<int>(N_x_) - dx);
-        dy = std::min(dy, static_cast<int>(N_y_) - dy);
-
-        return std::sqrt(static_cast<double>(dx * dx + dy * dy));
-    }
-
-public:
-    NeighborCache2D(size_t N_x, size_t N_y, double R_c)
-        : neighbor_lists_(N_x * N_y)
-        , kernel_cache_(R_c, 1024)
-        , spatial_hash_(N_x, N_y, R_c)
-        , N_x_(N_x)
-        , N_y_(N_y)
-        , R_c_(R_c)
-        , is_built_(false)
-    {}
+class NeighborListCSR {
+protected:
+    std::vector<size_t> row_offsets_;
+    std::vector<NeighborEntry> entries_;
+    std::vector<double> built_R_c_;      // Per-node R_c the lists were built for
+    KernelCacheManager kernels_;
+    bool is_built_ = false;
 
     /**
-     * Build neighbor lists and pre-compute weights
-     * Call once at initialization or when R_c changes
+     * Build the lists for built_R_c_ in two passes (count, then fill).
+     * enumerate(i, radius, visit) must call visit(j, distance) for every
+     * neighbor of row i, in the same order on every call.
      */
-    void build() {
-        const size_t N_total = N_x_ * N_y_;
-
-        // Clear previous data
-        spatial_hash_.clear();
-        for (auto& list : neighbor_lists_) {
-            list.clear();
+    template <typename Enumerate>
+    void buildRows(size_t num_nodes, const Enumerate& enumerate) {
+        kernels_.clear();
+        std::vector<double> radii = built_R_c_;
+        std::sort(radii.begin(), radii.end());
+        radii.erase(std::unique(radii.begin(), radii.end()), radii.end());
+        for (double R_c : radii) {
+            if (R_c > 0.0) kernels_.addCache(R_c);
         }
 
-        // Step 1: Populate spatial hash
-        for (size_t i = 0; i < N_total; ++i) {
-            int x = static_cast<int>(i % N_x_);
-            int y = static_cast<int>(i / N_x_);
-            spatial_hash_.insert(static_cast<int>(i), x, y);
+        row_offsets_.assign(num_nodes + 1, 0);
+        const long long rows = static_cast<long long>(num_nodes);
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (long long i = 0; i < rows; ++i) {
+            size_t count = 0;
+            enumerate(static_cast<size_t>(i), std::max(built_R_c_[i], 0.0),
+                      [&count](uint32_t, double) { count++; });
+            row_offsets_[i + 1] = count;
+        }
+        for (size_t i = 0; i < num_nodes; ++i) {
+            row_offsets_[i + 1] += row_offsets_[i];
         }
 
-        // Step 2: Build neighbor lists using spatial hash
-        const int R_c_int = static_cast<int>(std::ceil(R_c_));
-
-        for (size_t i = 0; i < N_total; ++i) {
-            int x_i = static_cast<int>(i % N_x_);
-            int y_i = static_cast<int>(i / N_x_);
-
-            // Query spatial hash for candidates
-            auto candidates = spatial_hash_.query(x_i, y_i, R_c_int);
-
-            // Filter by actual distance and pre-compute weights
-            for (int j : candidates) {
-                if (j == static_cast<int>(i)) continue;  // Skip self
-
-                int x_j = static_cast<int>(j % N_x_);
-                int y_j = static_cast<int>(j / N_x_);
-
-                double dist = wrappedDistance(x_i, y_i, x_j, y_j);
-
-                if (dist <= R_c_) {
-                    NeighborInfo info;
-                    info.node_id = j;
-                    info.distance = dist;
-                    info.weight = kernel_cache_.evaluateTiered(dist);
-
-                    neighbor_lists_[i].push_back(info);
-                }
+        entries_.clear();
+        entries_.shrink_to_fit();
+        entries_.resize(row_offsets_[num_nodes]);
+        #pragma omp parallel
+        {
+            double last_R_c = -1.0;
+            const KernelCache* cache = nullptr;
+            #pragma omp for schedule(dynamic, 256)
+            for (long long i = 0; i < rows; ++i) {
+                const double radius = std::max(built_R_c_[i], 0.0);
+                const KernelCache* kernel = kernelFor(radius, last_R_c, cache);
+                NeighborEntry* out = entries_.data() + row_offsets_[i];
+                enumerate(static_cast<size_t>(i), radius, [&out, kernel](uint32_t j, double dist) {
+                    *out++ = NeighborEntry{j, static_cast<float>(kernel->evaluateTiered(dist))};
+                });
             }
         }
 
@@ -119,20 +108,55 @@ public:
     }
 
     /**
-     * Rebuild cache (e.g., when R_c changes)
+     * Bytes buildRows() holds for num_nodes rows of neighbors entries each
+     * and one kernel cache (a uniform R_c)
      */
-    void rebuild(double new_R_c) {
-        if (std::abs(new_R_c - R_c_) < 1e-10) return;  // No change
+    static size_t estimateRowsMemoryUsage(size_t num_nodes, size_t neighbors, double R_c) {
+        const size_t kernel = R_c > 0.0 ? KernelCache(R_c).getMemoryUsage() : 0;
+        return kernel + (num_nodes + 1) * sizeof(size_t) + num_nodes * neighbors * sizeof(NeighborEntry) +
+               num_nodes * sizeof(double);
+    }
 
-        R_c_ = new_R_c;
-        kernel_cache_.rebuild(new_R_c);
-        spatial_hash_ = SpatialHash2D(N_x_, N_y_, R_c_);
-        build();
+    /**
+     * Kernel cache for R_c, memoized across consecutive nodes with equal R_c
+     */
+    const KernelCache* kernelFor(double R_c, double& last_R_c, const KernelCache*& last_cache) const {
+        if (R_c != last_R_c) {
+            last_R_c = R_c;
+            last_cache = (R_c > 0.0) ? kernels_.getCache(R_c) : nullptr;
+        }
+        return last_cache;
+    }
+
+public:
+    /**
+     * Accumulate 𝒦[Ψ]_i = ∑_j w_ij (Ψ_j - Ψ_i) from SoA planes
+     */
+    inline void computeCoupling(size_t i,
+                                const double* psi_re,
+                                const double* psi_im,
+                                double& nl_re,
+                                double& nl_im) const {
+        const size_t begin = row_offsets_[i];
+        const size_t end = row_offsets_[i + 1];
+        const double self_re = psi_re[i];
+        const double self_im = psi_im[i];
+        double sum_re = 0.0;
+        double sum_im = 0.0;
+
+        for (size_t k = begin; k < end; ++k) {
+            const uint32_t j = entries_[k].id;
+            const double w = entries_[k].weight;
+            sum_re += w * (psi_re[j] - self_re);
+            sum_im += w * (psi_im[j] - self_im);
+        }
+
+        nl_re = sum_re;
+        nl_im = sum_im;
     }
 
     /**
-     * Compute non-local coupling for node i
-     * Uses pre-computed neighbor list (O(neighbors) instead of O(N))
+     * Compute non-local coupling for node i (AoS nodes)
      */
     std::complex<double> computeCoupling(
         size_t i,
@@ -141,202 +165,265 @@ public:
         if (!is_built_) return std::complex<double>(0, 0);
 
         std::complex<double> sum(0, 0);
-        const auto& neighbors = neighbor_lists_[i];
         const auto& node_i = nodes[i];
-
-        // Vectorizable loop (fixed-length, sequential access)
-        for (const auto& neighbor : neighbors) {
-            sum += neighbor.weight * (nodes[neighbor.node_id].psi - node_i.psi);
+        for (size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k) {
+            sum += static_cast<double>(entries_[k].weight) * (nodes[entries_[k].id].psi - node_i.psi);
         }
-
         return sum;
     }
 
+    /**
+     * True if any node's R_c differs from the one the lists were built for
+     */
+    bool needsRebuild(const IGSOALatticeSoA& lattice) const {
+        if (!is_built_ || built_R_c_.size() != lattice.size()) return true;
+        return !std::equal(built_R_c_.begin(), built_R_c_.end(), lattice.R_c.begin());
+    }
+
     /**
      * Get neighbor count for node i
      */
     size_t getNeighborCount(size_t i) const {
-        return neighbor_lists_[i].size();
+        return row_offsets_[i + 1] - row_offsets_[i];
+    }
+
+    /**
+     * First of node i's getNeighborCount(i) entries
+     */
+    const NeighborEntry* getNeighbors(size_t i) const {
+        return entries_.data() + row_offsets_[i];
+    }
+
+    /**
+     * Total stored neighbor entries (one coupling operation each per step)
+     */
+    size_t getTotalNeighborCount() const {
+        return entries_.size();
     }
 
     /**
      * Get average neighbor count
      */
     double getAverageNeighborCount() const {
-        size_t total = 0;
-        for (const auto& list : neighbor_lists_) {
-            total += list.size();
-        }
-        return static_cast<double>(total) / neighbor_lists_.size();
+        if (row_offsets_.size() <= 1) return 0.0;
+        return static_cast<double>(entries_.size()) / (row_offsets_.size() - 1);
     }
 
     /**
      * Get memory usage (bytes)
      */
     size_t getMemoryUsage() const {
-        size_t total = kernel_cache_.getMemoryUsage();
-        total += spatial_hash_.getMemoryUsage();
-
-        for (const auto& list : neighbor_lists_) {
-            total += list.capacity() * sizeof(NeighborInfo);
-        }
-
-        return total;
+        return kernels_.getTotalMemoryUsage() +
+               row_offsets_.capacity() * sizeof(size_t) +
+               entries_.capacity() * sizeof(NeighborEntry) +
+               built_R_c_.capacity() * sizeof(double);
     }
 
+    size_t getNumKernelCaches() const { return kernels_.getNumCaches(); }
+
     bool isBuilt() const { return is_built_; }
 };
 
 /**
- * 3D Neighbor Cache
+ * 2D Neighbor Cache
  */
-class NeighborCache3D {
+class NeighborCache2D : public NeighborListCSR {
 private:
-    std::vector<std::vector<NeighborInfo>> neighbor_lists_;
-    KernelCache kernel_cache_;
-    SpatialHash3D spatial_hash_;
-
-    size_t N_x_, N_y_, N_z_;
+    size_t N_x_, N_y_;
     double R_c_;
-    bool is_built_;
-
-    // Distance computation (toroidal)
-    inline double wrappedDistance(int x1, int y1, int z1, int x2, int y2, int z2) const {
-        int dx = std::abs(x1 - x2);
-        int dy = std::abs(y1 - y2);
-        int dz = std::abs(z1 - z2);
 
-        dx = std::min(dx, static_cast<int>(N_x_) - dx);
-        dy = std::min(dy, static_cast<int>(N_y_) - dy);
-        dz = std::min(dz, static_cast<int>(N_z_) - dz);
+    // visit(j, distance) for every neighbor of node i within radius
+    template <typename Visit>
+    void forEachNeighbor(size_t i, double radius, Visit&& visit) const {
+        const size_t N_total = N_x_ * N_y_;
+        if (N_total <= 1 || radius <= 0.0) return;
+        const int N_x_int = static_cast<int>(N_x_);
+        const int N_y_int = static_cast<int>(N_y_);
+        const int x_i = static_cast<int>(i % N_x_);
+        const int y_i = static_cast<int>(i / N_x_);
+        const int R_c_int = static_cast<int>(std::ceil(radius));
+
+        for (int dy = -R_c_int; dy <= R_c_int; ++dy) {
+            int y_j = (y_i + dy) % N_y_int;
+            if (y_j < 0) y_j += N_y_int;
+            int dy_wrap = std::abs(y_i - y_j);
+            dy_wrap = std::min(dy_wrap, N_y_int - dy_wrap);
+
+            for (int dx = -R_c_int; dx <= R_c_int; ++dx) {
+                if (dx == 0 && dy == 0) continue;
+
+                int x_j = (x_i + dx) % N_x_int;
+                if (x_j < 0) x_j += N_x_int;
+                int dx_wrap = std::abs(x_i - x_j);
+                dx_wrap = std::min(dx_wrap, N_x_int - dx_wrap);
+
+                const double dist = std::sqrt(static_cast<double>(dx_wrap * dx_wrap + dy_wrap * dy_wrap));
+                if (dist <= radius) {
+                    visit(static_cast<uint32_t>(y_j) * static_cast<uint32_t>(N_x_int) + static_cast<uint32_t>(x_j),
+                          dist);
+                }
+            }
+        }
+    }
 
-        return std::sqrt(static_cast<double>(dx * dx + dy * dy + dz * dz));
+    void buildLists() {
+        buildRows(N_x_ * N_y_, [this](size_t i, double radius, auto&& visit) {
+            forEachNeighbor(i, radius, visit);
+        });
     }
 
 public:
-    NeighborCache3D(size_t N_x, size_t N_y, size_t N_z, double R_c)
-        : neighbor_lists_(N_x * N_y * N_z)
-        , kernel_cache_(R_c, 1024)
-        , spatial_hash_(N_x, N_y, N_z, R_c)
-        , N_x_(N_x)
+    NeighborCache2D(size_t N_x, size_t N_y, double R_c)
+        : N_x_(N_x)
         , N_y_(N_y)
-        , N_z_(N_z)
         , R_c_(R_c)
-        , is_built_(false)
     {}
 
     /**
-     * Build neighbor lists and pre-compute weights
+     * Bytes the lists of an N_x × N_y lattice with uniform R_c hold once
+     * built (every node has the neighbor count of node 0 on the torus)
      */
-    void build() {
-        const size_t N_total = N_x_ * N_y_ * N_z_;
-        const size_t plane_size = N_x_ * N_y_;
-
-        // Clear previous data
-        spatial_hash_.clear();
-        for (auto& list : neighbor_lists_) {
-            list.clear();
-        }
-
-        // Step 1: Populate spatial hash
-        for (size_t i = 0; i < N_total; ++i) {
-            int x = static_cast<int>(i % N_x_);
-            int y = static_cast<int>((i / N_x_) % N_y_);
-            int z = static_cast<int>(i / plane_size);
-            spatial_hash_.insert(static_cast<int>(i), x, y, z);
-        }
-
-        // Step 2: Build neighbor lists
-        const int R_c_int = static_cast<int>(std::ceil(R_c_));
-
-        for (size_t i = 0; i < N_total; ++i) {
-            int x_i = static_cast<int>(i % N_x_);
-            int y_i = static_cast<int>((i / N_x_) % N_y_);
-            int z_i = static_cast<int>(i / plane_size);
-
-            // Query spatial hash
-            auto candidates = spatial_hash_.query(x_i, y_i, z_i, R_c_int);
-
-            // Filter and compute weights
-            for (int j : candidates) {
-                if (j == static_cast<int>(i)) continue;
-
-                int x_j = static_cast<int>(j % N_x_);
-                int y_j = static_cast<int>((j / N_x_) % N_y_);
-                int z_j = static_cast<int>(j / plane_size);
-
-                double dist = wrappedDistance(x_i, y_i, z_i, x_j, y_j, z_j);
-
-                if (dist <= R_c_) {
-                    NeighborInfo info;
-                    info.node_id = j;
-                    info.distance = dist;
-                    info.weight = kernel_cache_.evaluateTiered(dist);
+    static size_t estimateMemoryUsage(size_t N_x, size_t N_y, double R_c) {
+        size_t neighbors = 0;
+        NeighborCache2D(N_x, N_y, R_c).forEachNeighbor(0, std::max(R_c, 0.0),
+                                                       [&neighbors](uint32_t, double) { neighbors++; });
+        return estimateRowsMemoryUsage(N_x * N_y, neighbors, R_c);
+    }
 
-                    neighbor_lists_[i].push_back(info);
-                }
-            }
-        }
+    /**
+     * Build neighbor lists for a uniform R_c
+     * Call once at initialization or when R_c changes
+     */
+    void build() {
+        built_R_c_.assign(N_x_ * N_y_, R_c_);
+        buildLists();
+    }
 
-        is_built_ = true;
+    /**
+     * Build neighbor lists from the per-node R_c of a lattice
+     */
+    void build(const IGSOALatticeSoA& lattice) {
+        built_R_c_.assign(lattice.R_c.begin(), lattice.R_c.end());
+        buildLists();
     }
 
     /**
-     * Rebuild cache
+     * Rebuild cache (e.g., when R_c changes)
      */
     void rebuild(double new_R_c) {
-        if (std::abs(new_R_c - R_c_) < 1e-10) return;
+        if (is_built_ && std::abs(new_R_c - R_c_) < 1e-10) return;  // No change
 
         R_c_ = new_R_c;
-        kernel_cache_.rebuild(new_R_c);
-        spatial_hash_ = SpatialHash3D(N_x_, N_y_, N_z_, R_c_);
         build();
     }
+};
 
-    /**
-     * Compute non-local coupling for node i
-     */
-    std::complex<double> computeCoupling(
-        size_t i,
-        const std::vector<IGSOAComplexNode>& nodes
-    ) const {
-        if (!is_built_) return std::complex<double>(0, 0);
-
-        std::complex<double> sum(0, 0);
-        const auto& neighbors = neighbor_lists_[i];
-        const auto& node_i = nodes[i];
+/**
+ * 3D Neighbor Cache
+ */
+class NeighborCache3D : public NeighborListCSR {
+private:
+    size_t N_x_, N_y_, N_z_;
+    double R_c_;
 
-        for (const auto& neighbor : neighbors) {
-            sum += neighbor.weight * (nodes[neighbor.node_id].psi - node_i.psi);
+    // visit(j, distance) for every neighbor of node i within radius
+    template <typename Visit>
+    void forEachNeighbor(size_t i, double radius, Visit&& visit) const {
+        const size_t N_total = N_x_ * N_y_ * N_z_;
+        if (N_total <= 1 || radius <= 0.0) return;
+        const size_t plane_size = N_x_ * N_y_;
+        const int N_x_int = static_cast<int>(N_x_);
+        const int N_y_int = static_cast<int>(N_y_);
+        const int N_z_int = static_cast<int>(N_z_);
+        const int x_i = static_cast<int>(i % N_x_);
+        const int y_i = static_cast<int>((i / N_x_) % N_y_);
+        const int z_i = static_cast<int>(i / plane_size);
+        const int R_c_int = static_cast<int>(std::ceil(radius));
+        const double radius_sq = radius * radius;
+
+        for (int dz = -R_c_int; dz <= R_c_int; ++dz) {
+            int z_j = (z_i + dz) % N_z_int;
+            if (z_j < 0) z_j += N_z_int;
+            int dz_wrap = std::abs(z_i - z_j);
+            dz_wrap = std::min(dz_wrap, N_z_int - dz_wrap);
+
+            for (int dy = -R_c_int; dy <= R_c_int; ++dy) {
+                int y_j = (y_i + dy) % N_y_int;
+                if (y_j < 0) y_j += N_y_int;
+                int dy_wrap = std::abs(y_i - y_j);
+                dy_wrap = std::min(dy_wrap, N_y_int - dy_wrap);
+
+                for (int dx = -R_c_int; dx <= R_c_int; ++dx) {
+                    if (dx == 0 && dy == 0 && dz == 0) continue;
+
+                    int x_j = (x_i + dx) % N_x_int;
+                    if (x_j < 0) x_j += N_x_int;
+                    int dx_wrap = std::abs(x_i - x_j);
+                    dx_wrap = std::min(dx_wrap, N_x_int - dx_wrap);
+
+                    const double dist_sq = static_cast<double>(
+                        dx_wrap * dx_wrap + dy_wrap * dy_wrap + dz_wrap * dz_wrap);
+                    if (dist_sq <= radius_sq) {
+                        const uint32_t j = static_cast<uint32_t>(
+                            static_cast<size_t>(z_j) * plane_size +
+                            static_cast<size_t>(y_j) * N_x_ + static_cast<size_t>(x_j));
+                        visit(j, std::sqrt(dist_sq));
+                    }
+                }
+            }
         }
+    }
 
-        return sum;
+    void buildLists() {
+        buildRows(N_x_ * N_y_ * N_z_, [this](size_t i, double radius, auto&& visit) {
+            forEachNeighbor(i, radius, visit);
+        });
     }
 
-    size_t getNeighborCount(size_t i) const {
-        return neighbor_lists_[i].size();
+public:
+    NeighborCache3D(size_t N_x, size_t N_y, size_t N_z, double R_c)
+        : N_x_(N_x)
+        , N_y_(N_y)
+        , N_z_(N_z)
+        , R_c_(R_c)
+    {}
+
+    /**
+     * Bytes the lists of an N_x × N_y × N_z lattice with uniform R_c hold
+     * once built
+     */
+    static size_t estimateMemoryUsage(size_t N_x, size_t N_y, size_t N_z, double R_c) {
+        size_t neighbors = 0;
+        NeighborCache3D(N_x, N_y, N_z, R_c).forEachNeighbor(0, std::max(R_c, 0.0),
+                                                            [&neighbors](uint32_t, double) { neighbors++; });
+        return estimateRowsMemoryUsage(N_x * N_y * N_z, neighbors, R_c);
     }
 
-    double getAverageNeighborCount() const {
-        size_t total = 0;
-        for (const auto& list : neighbor_lists_) {
-            total += list.size();
-        }
-        return static_cast<double>(total) / neighbor_lists_.size();
+    /**
+     * Build neighbor lists for a uniform R_c
+     */
+    void build() {
+        built_R_c_.assign(N_x_ * N_y_ * N_z_, R_c_);
+        buildLists();
     }
 
-    size_t getMemoryUsage() const {
-        size_t total = kernel_cache_.getMemoryUsage();
-        total += spatial_hash_.getMemoryUsage();
+    /**
+     * Build neighbor lists from the per-node R_c of a lattice
+     */
+    void build(const IGSOALatticeSoA& lattice) {
+        built_R_c_.assign(lattice.R_c.begin(), lattice.R_c.end());
+        buildLists();
+    }
 
-        for (const auto& list : neighbor_lists_) {
-            total += list.capacity() * sizeof(NeighborInfo);
-        }
+    /**
+     * Rebuild cache
+     */
+    void rebuild(double new_R_c) {
+        if (is_built_ && std::abs(new_R_c - R_c_) < 1e-10) return;
 
-        return total;
+        R_c_ = new_R_c;
+        build();
     }
-
-    bool isBuilt() const { return is_built_; }
 };
 
 } // namespace igsoa
@@ -0,0 +1,332 @@
+/**
+ * NUMA Memory - First-Touch Placement, Huge Pages and Thread Pinning
+ *
+ * Linux and Windows place a page on the NUMA node of the thread that first
+ * writes it. Lattice vectors are filled on the constructing thread, so
+ * without help every page of a large lattice lands on one socket and the
+ * threads of the other socket step it through remote memory.
+ *
+ * allocateAligned() backs AlignedAllocator (lattice arrays, SATP fields,
+ * scratch buffers) and the analog engine's aligned_allocator. Blocks of at
+ * least kFirstTouchBytes are mapped fresh and each page is written first
+ * by the OpenMP thread that will step it: thread t of T touches pages
+ * pages*t/T .. pages*(t+1)/T, the same static split the mission region
+ * (IGSOAPhysicsSoA::runSteps) and the schedule(static) loops use for rows.
+ * The vector's own fill then writes pages that are already placed.
+ *
+ * Process-wide MemoryPolicy (set before engines are created):
+ *   first_touch  parallel first touch of large blocks (default on)
+ *   huge_pages   2 MiB aligned blocks with MADV_HUGEPAGE (default off)
+ *
+ * pinThreads() binds OpenMP thread t to one CPU of the process affinity
+ * mask (Compact: consecutive CPUs, Spread: evenly spaced). The OpenMP
+ * runtimes keep their worker threads between regions, so the binding
+ * holds for later regions with the same thread count. OMP_PROC_BIND and
+ * OMP_PLACES remain the way to pin from the environment.
+ *
+ * While a ScopedFileBacking is alive on a thread, the large blocks that
+ * thread allocates are shared mappings of unlinked files in a spill
+ * directory instead of anonymous memory (out_of_core.h). The kernel
+ * writes their pages back to the file under memory pressure instead of
+ * failing the run, and frees the file when the block is released.
+ *
+ * Pinning, huge pages and file backing are Linux-only; elsewhere
+ * pinThreads() returns 0 and the other two are ignored.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace dase {
+
+/**
+ * Where pinThreads() puts the OpenMP threads
+ */
+enum class ThreadPinning {
+    None,     // Unpinned (restores the original affinity mask)
+    Compact,  // Thread t on the t-th allowed CPU
+    Spread    // Threads spaced evenly over the allowed CPUs
+};
+
+inline bool parseThreadPinning(const std::string& name, ThreadPinning& out) {
+    if (name == "none") { out = ThreadPinning::None; return true; }
+    if (name == "compact") { out = ThreadPinning::Compact; return true; }
+    if (name == "spread") { out = ThreadPinning::Spread; return true; }
+    return false;
+}
+
+inline const char* threadPinningName(ThreadPinning mode) {
+    switch (mode) {
+    case ThreadPinning::Compact: return "compact";
+    case ThreadPinning::Spread: return "spread";
+    case ThreadPinning::None: break;
+    }
+    return "none";
+}
+
+struct MemoryPolicy {
+    bool first_touch = true;   // Touch large blocks from their owning threads
+    bool huge_pages = false;   // Back large blocks with transparent huge pages
+};
+
+static constexpr size_t kFirstTouchBytes = size_t(1) << 20;  // Blocks below which one thread touches
+static constexpr size_t kHugePageBytes = size_t(2) << 20;
+
+namespace numa_detail {
+
+inline std::atomic<bool>& firstTouchFlag() {
+    static std::atomic<bool> flag{true};
+    return flag;
+}
+
+inline std::atomic<bool>& hugePagesFlag() {
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+
+// Spill directory of the thread's ScopedFileBacking (nullptr: anonymous memory)
+inline const std::string*& fileBackingDirectory() {
+    static thread_local const std::string* directory = nullptr;
+    return directory;
+}
+
+inline size_t pageBytes() {
+#if defined(__linux__)
+    static const size_t bytes = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return bytes;
+#else
+    return 4096;
+#endif
+}
+
+inline size_t roundUp(size_t bytes, size_t multiple) {
+    return (bytes + multiple - 1) / multiple * multiple;
+}
+
+#if defined(__linux__)
+// CPUs of the process mask, read before the first pinThreads() narrows it
+inline const std::vector<int>& allowedCpus() {
+    static const std::vector<int> cpus = [] {
+        std::vector<int> list;
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &mask)) list.push_back(cpu);
+            }
+        }
+        return list;
+    }();
+    return cpus;
+}
+#endif
+
+} // namespace numa_detail
+
+inline MemoryPolicy getMemoryPolicy() {
+    MemoryPolicy policy;
+    policy.first_touch = numa_detail::firstTouchFlag().load(std::memory_order_relaxed);
+    policy.huge_pages = numa_detail::hugePagesFlag().load(std::memory_order_relaxed);
+    return policy;
+}
+
+/**
+ * Applies to blocks allocated afterwards (existing lattices keep their pages)
+ */
+inline void setMemoryPolicy(const MemoryPolicy& policy) {
+    numa_detail::firstTouchFlag().store(policy.first_touch, std::memory_order_relaxed);
+    numa_detail::hugePagesFlag().store(policy.huge_pages, std::memory_order_relaxed);
+}
+
+/**
+ * Back the large blocks this thread allocates with files in directory
+ *
+ *   {
+ *       ScopedFileBacking backing("/scratch");
+ *       lattice.resize(N);            // planes >= kFirstTouchBytes spill
+ *   }
+ *
+ * Only allocation is affected; blocks keep their backing until released.
+ * Scopes nest (the innermost wins).
+ */
+class ScopedFileBacking {
+public:
+    explicit ScopedFileBacking(const std::string& directory)
+        : directory_(directory.empty() ? std::string("/tmp") : directory)
+        , previous_(numa_detail::fileBackingDirectory()) {
+        numa_detail::fileBackingDirectory() = &directory_;
+    }
+    ~ScopedFileBacking() { numa_detail::fileBackingDirectory() = previous_; }
+
+    ScopedFileBacking(const ScopedFileBacking&) = delete;
+    ScopedFileBacking& operator=(const ScopedFileBacking&) = delete;
+
+private:
+    std::string directory_;
+    const std::string* previous_;
+};
+
+/**
+ * Write one byte per page of [p, p + bytes), split across the OpenMP threads
+ *
+ * Inside a parallel region the calling thread touches everything (the
+ * block is that thread's own scratch).
+ */
+inline void firstTouch(void* p, size_t bytes) {
+    volatile char* base = static_cast<volatile char*>(p);
+    const size_t page = numa_detail::pageBytes();
+    const size_t pages = (bytes + page - 1) / page;
+#ifdef _OPENMP
+    if (!omp_in_parallel()) {
+        #pragma omp parallel
+        {
+            const size_t T = static_cast<size_t>(omp_get_num_threads());
+            const size_t t = static_cast<size_t>(omp_get_thread_num());
+            for (size_t k = pages * t / T; k < pages * (t + 1) / T; k++) {
+                base[k * page] = 0;
+            }
+        }
+        return;
+    }
+#endif
+    for (size_t k = 0; k < pages; k++) {
+        base[k * page] = 0;
+    }
+}
+
+/**
+ * Aligned storage for bytes (nullptr for 0); throws std::bad_alloc
+ *
+ * Blocks of at least kFirstTouchBytes are page aligned (2 MiB on Linux),
+ * placed by firstTouch() and, with huge_pages, advised MADV_HUGEPAGE.
+ * Under a ScopedFileBacking they are page-aligned file mappings instead
+ * (no first touch: the file reads back as zeros). Release with
+ * deallocateAligned(p, bytes) and the same byte count.
+ */
+inline void* allocateAligned(size_t bytes, size_t alignment) {
+    if (bytes == 0) return nullptr;
+    const MemoryPolicy policy = getMemoryPolicy();
+    const bool large = bytes >= kFirstTouchBytes;
+    void* p = nullptr;
+
+#if defined(__linux__)
+    if (large && numa_detail::fileBackingDirectory() && alignment <= numa_detail::pageBytes()) {
+        // Unlinked spill file; the mapping keeps it alive until munmap
+        std::string path = *numa_detail::fileBackingDirectory() + "/dase_spill_XXXXXX";
+        const int fd = mkstemp(&path[0]);
+        if (fd < 0) throw std::bad_alloc();
+        unlink(path.c_str());
+        const size_t length = numa_detail::roundUp(bytes, numa_detail::pageBytes());
+        void* mapped = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(length)) == 0) {
+            mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (mapped == MAP_FAILED) throw std::bad_alloc();
+        return mapped;
+    }
+    if (large) {
+        // Fresh anonymous pages (malloc may hand back pages another thread
+        // already faulted), over-mapped and trimmed to the alignment
+        const size_t align = std::max(alignment, kHugePageBytes);
+        const size_t length = numa_detail::roundUp(bytes, numa_detail::pageBytes());
+        void* mapped = mmap(nullptr, length + align, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) throw std::bad_alloc();
+        const uintptr_t raw = reinterpret_cast<uintptr_t>(mapped);
+        const uintptr_t aligned = numa_detail::roundUp(raw, align);
+        if (aligned > raw) munmap(mapped, aligned - raw);
+        const size_t tail = (raw + length + align) - (aligned + length);
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + length), tail);
+        p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        if (policy.huge_pages) madvise(p, length, MADV_HUGEPAGE);  // Advisory; THP may be off
+#endif
+        if (policy.first_touch) firstTouch(p, bytes);
+        return p;
+    }
+#endif
+
+#if defined(_WIN32)
+    p = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&p, std::max(alignment, sizeof(void*)), bytes) != 0) p = nullptr;
+#endif
+    if (!p) throw std::bad_alloc();
+    if (large && policy.first_touch) firstTouch(p, bytes);
+    return p;
+}
+
+inline void deallocateAligned(void* p, size_t bytes) noexcept {
+    if (!p) return;
+#if defined(__linux__)
+    if (bytes >= kFirstTouchBytes) {
+        munmap(p, numa_detail::roundUp(bytes, numa_detail::pageBytes()));
+        return;
+    }
+#else
+    (void)bytes;
+#endif
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+/**
+ * Bind the OpenMP threads of the next regions to CPUs
+ *
+ * @return Threads pinned (0 for None, without OpenMP, or off Linux)
+ */
+inline int pinThreads(ThreadPinning mode) {
+#if defined(__linux__) && defined(_OPENMP)
+    const std::vector<int>& cpus = numa_detail::allowedCpus();
+    if (cpus.empty()) return 0;
+    int pinned = 0;
+    #pragma omp parallel reduction(+ : pinned)
+    {
+        const size_t T = static_cast<size_t>(omp_get_num_threads());
+        const size_t t = static_cast<size_t>(omp_get_thread_num());
+        const size_t n = cpus.size();
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (mode == ThreadPinning::None) {
+            for (int cpu : cpus) CPU_SET(cpu, &set);
+        } else {
+            const size_t slot = mode == ThreadPinning::Compact ? t % n : (t * n / T) % n;
+            CPU_SET(cpus[slot], &set);
+        }
+        if (sched_setaffinity(0, sizeof(set), &set) == 0 && mode != ThreadPinning::None) {
+            pinned++;
+        }
+    }
+    return pinned;
+#else
+    (void)mode;
+    return 0;
+#endif
+}
+
+} // namespace dase
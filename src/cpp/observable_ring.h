@@ -0,0 +1,105 @@
+/**
+ * Observable Ring - Preallocated Time Series of Scalar Observables
+ *
+ * Fixed-capacity ring of samples (step, time, channel values) filled by an
+ * engine while a mission runs. Capacity and channel count are set once by
+ * configure(); push() never allocates, and once the ring is full each new
+ * sample replaces the oldest one (dropped() counts them).
+ *
+ *   ObservableRing ring;
+ *   ring.configure(2, 4096);
+ *   ring.push(step, time, values);     // values[0..channels)
+ *   std::vector<double> energy;
+ *   ring.copyChannel(0, energy);       // oldest first
+ *
+ * Not synchronized: fill and read it from the same thread, or between
+ * missions.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+
+class ObservableRing {
+public:
+    /**
+     * Allocate room for capacity samples of channels values each (clears)
+     */
+    void configure(size_t channels, size_t capacity) {
+        channels_ = channels;
+        capacity_ = capacity;
+        steps_.assign(capacity, 0);
+        times_.assign(capacity, 0.0);
+        values_.assign(capacity * channels, 0.0);
+        clear();
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+        recorded_ = 0;
+    }
+
+    void push(uint64_t step, double time, const double* values) {
+        if (capacity_ == 0) return;
+        steps_[head_] = step;
+        times_[head_] = time;
+        double* row = values_.data() + head_ * channels_;
+        for (size_t c = 0; c < channels_; c++) {
+            row[c] = values[c];
+        }
+        head_ = (head_ + 1 == capacity_) ? 0 : head_ + 1;
+        if (size_ < capacity_) size_++;
+        recorded_++;
+    }
+
+    size_t channels() const { return channels_; }
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return size_; }
+    uint64_t recorded() const { return recorded_; }                // Samples pushed since clear()
+    uint64_t dropped() const { return recorded_ - size_; }         // Overwritten by newer samples
+
+    // Series in recording order (oldest first)
+    void copySteps(std::vector<double>& out) const {
+        gather(out, [this](size_t slot) { return static_cast<double>(steps_[slot]); });
+    }
+    void copyTimes(std::vector<double>& out) const {
+        gather(out, [this](size_t slot) { return times_[slot]; });
+    }
+    void copyChannel(size_t channel, std::vector<double>& out) const {
+        gather(out, [this, channel](size_t slot) { return values_[slot * channels_ + channel]; });
+    }
+
+    // Newest sample (size() > 0)
+    uint64_t lastStep() const { return steps_[newest()]; }
+    double lastValue(size_t channel) const { return values_[newest() * channels_ + channel]; }
+
+private:
+    size_t channels_ = 0;
+    size_t capacity_ = 0;
+    size_t head_ = 0;       // Slot of the next push
+    size_t size_ = 0;
+    uint64_t recorded_ = 0;
+    std::vector<uint64_t> steps_;
+    std::vector<double> times_;
+    std::vector<double> values_;  // capacity × channels, sample-major
+
+    size_t oldest() const { return size_ < capacity_ ? 0 : head_; }
+    size_t newest() const { return head_ == 0 ? capacity_ - 1 : head_ - 1; }
+
+    template<typename Value>
+    void gather(std::vector<double>& out, Value value) const {
+        out.resize(size_);
+        size_t slot = oldest();
+        for (size_t i = 0; i < size_; i++) {
+            out[i] = value(slot);
+            slot = (slot + 1 == capacity_) ? 0 : slot + 1;
+        }
+    }
+};
+
+} // namespace dase
@@ -0,0 +1,181 @@
+/**
+ * Out-of-Core Storage - Memory Budget, Spill Files and Z-Slab Streaming
+ *
+ * Fields that do not fit in RAM are kept in memory-mapped spill files
+ * (ScopedFileBacking, numa_memory.h) and paged by the kernel. The
+ * process-wide OutOfCorePolicy holds the memory budget. Each engine that
+ * supports spilling compares its estimated footprint with the budget when
+ * it is created, and above it allocates its large fields file-backed:
+ *
+ *   OutOfCorePolicy policy;
+ *   policy.memory_budget_bytes = size_t(8) << 30;
+ *   policy.directory = "/scratch";
+ *   setOutOfCorePolicy(policy);
+ *   IGSOAComplexEngine3D engine(config, 512, 512, 512);   // isOutOfCore()
+ *
+ * Supported: IGSOAComplexEngine3D (the lattice), and the GW
+ * FractionalSolver (the SOE history, the largest GW field).
+ *
+ * SlabStreamer bounds the resident set of a sweep in z order. Before slab
+ * z it asks the kernel to read ahead slabs z+halo+1 .. z+halo+prefetch
+ * (MADV_WILLNEED, asynchronous). It also unmaps slab z-halo-1
+ * (MADV_DONTNEED). The data stays in the file and the page cache, which
+ * the kernel reclaims under pressure. The first `keep` slabs stay mapped
+ * for the periodic wrap at the end of the sweep.
+ *
+ * The hints are Linux-only and advisory; elsewhere the streamer only
+ * counts.
+ */
+
+#pragma once
+
+#include "numa_memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dase {
+
+struct OutOfCorePolicy {
+    size_t memory_budget_bytes = 0;  // Footprint above which storage spills (0: never)
+    std::string directory;           // Spill files ("": $TMPDIR, else /tmp)
+    size_t prefetch_slabs = 2;       // Slabs read ahead of a streamed sweep
+};
+
+namespace out_of_core_detail {
+
+inline std::mutex& policyMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline OutOfCorePolicy& policy() {
+    static OutOfCorePolicy value;
+    return value;
+}
+
+} // namespace out_of_core_detail
+
+inline OutOfCorePolicy getOutOfCorePolicy() {
+    std::lock_guard<std::mutex> lock(out_of_core_detail::policyMutex());
+    return out_of_core_detail::policy();
+}
+
+/**
+ * Applies to engines created afterwards (existing ones keep their storage)
+ */
+inline void setOutOfCorePolicy(const OutOfCorePolicy& policy) {
+    std::lock_guard<std::mutex> lock(out_of_core_detail::policyMutex());
+    out_of_core_detail::policy() = policy;
+}
+
+/**
+ * True if an engine needing footprint_bytes should spill under policy
+ */
+inline bool exceedsMemoryBudget(size_t footprint_bytes, const OutOfCorePolicy& policy = getOutOfCorePolicy()) {
+    return policy.memory_budget_bytes > 0 && footprint_bytes > policy.memory_budget_bytes;
+}
+
+inline std::string spillDirectory(const OutOfCorePolicy& policy = getOutOfCorePolicy()) {
+    if (!policy.directory.empty()) return policy.directory;
+    const char* tmp = std::getenv("TMPDIR");
+    return (tmp && *tmp) ? std::string(tmp) : std::string("/tmp");
+}
+
+/**
+ * Read-ahead / release hints for planes swept slab by slab
+ *
+ * Only add file-backed planes (allocated under a ScopedFileBacking and at
+ * least kFirstTouchBytes): MADV_DONTNEED zero-fills anonymous memory.
+ *
+ *   streamer.clear();
+ *   streamer.addPlane(lattice.psi_re.data(), N_x * N_y * sizeof(double));
+ *   ...
+ *   streamer.configure(N_z, halo, keep, prefetch);
+ *   for (z = 0; z < N_z; z++) { streamer.enter(z); sweep(z); }
+ */
+class SlabStreamer {
+public:
+    void clear() {
+        planes_.clear();
+        slabs_ = 0;
+    }
+
+    // Plane of slabs() consecutive slabs of slab_bytes each
+    void addPlane(const void* base, size_t slab_bytes) {
+        planes_.push_back(Plane{static_cast<const char*>(base), slab_bytes});
+    }
+
+    /**
+     * @param halo Slabs on each side the sweep of one slab reads
+     * @param keep Leading slabs never released (read again by the wrap)
+     * @param prefetch Slabs read ahead beyond the halo
+     */
+    void configure(size_t slabs, size_t halo, size_t keep, size_t prefetch) {
+        slabs_ = slabs;
+        halo_ = halo;
+        keep_ = keep;
+        prefetch_ = prefetch;
+    }
+
+    size_t slabs() const { return slabs_; }
+
+    /**
+     * Sweep is about to process slab z
+     *
+     * Slab 0 also prefetches the halo it reads on both sides.
+     */
+    void enter(size_t z) {
+        if (slabs_ == 0) return;
+        if (z == 0) {
+            for (size_t k = 0; k <= halo_ + prefetch_ && k < slabs_; k++) advise(k, true);
+            for (size_t k = 1; k <= halo_ && k < slabs_; k++) advise(slabs_ - k, true);
+            return;
+        }
+        const size_t ahead = z + halo_ + prefetch_;
+        if (ahead < slabs_) advise(ahead, true);
+        if (z > halo_) {
+            const size_t behind = z - halo_ - 1;
+            if (behind >= keep_) advise(behind, false);
+        }
+    }
+
+    uint64_t prefetchedBytes() const { return prefetched_bytes_; }  // Requested read-ahead
+    uint64_t releasedBytes() const { return released_bytes_; }      // Unmapped behind the sweep
+
+private:
+    struct Plane {
+        const char* base;
+        size_t slab_bytes;
+    };
+
+    std::vector<Plane> planes_;
+    size_t slabs_ = 0;
+    size_t halo_ = 0;
+    size_t keep_ = 0;
+    size_t prefetch_ = 0;
+    uint64_t prefetched_bytes_ = 0;
+    uint64_t released_bytes_ = 0;
+
+    // WILLNEED covers the slab (rounded out to pages); DONTNEED only its
+    // whole pages, so neighbours in use keep their mappings
+    void advise(size_t slab, bool need) {
+        for (const Plane& plane : planes_) {
+            const uintptr_t begin = reinterpret_cast<uintptr_t>(plane.base + slab * plane.slab_bytes);
+            const uintptr_t end = begin + plane.slab_bytes;
+            const uintptr_t page = numa_detail::pageBytes();
+            const uintptr_t lo = need ? begin / page * page : (begin + page - 1) / page * page;
+            const uintptr_t hi = need ? (end + page - 1) / page * page : end / page * page;
+            if (hi <= lo) continue;
+#if defined(__linux__)
+            madvise(reinterpret_cast<void*>(lo), hi - lo, need ? MADV_WILLNEED : MADV_DONTNEED);
+#endif
+            (need ? prefetched_bytes_ : released_bytes_) += hi - lo;
+        }
+    }
+};
+
+} // namespace dase
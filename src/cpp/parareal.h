@@ -0,0 +1,346 @@
+/**
+ * Parareal - Parallel-in-Time Missions
+ *
+ * A long run of num_steps steps is cut into P time slices. A cheap coarse
+ * propagator G (steps of coarse_stride·dt, optionally in float32) sweeps
+ * the slices in order. The accurate fine propagator F (the engine's own
+ * steps) then runs every slice at once, one worker engine per thread. The
+ * boundary states are corrected in one more sequential coarse sweep:
+ *
+ *   U[n+1] ← G(U_new[n]) + F(U_old[n]) - G(U_old[n])
+ *
+ * After iteration k the first k slices hold exactly the serial result, so
+ * P iterations always reproduce it. The run usually stops much earlier,
+ * once no boundary moves by more than the tolerance (scaled as
+ * max|ΔU| / (1 + max|U|)). When G tracks F well, a few iterations of P
+ * concurrent slices beat one thread stepping the whole mission.
+ *
+ *   PararealConfig parareal;
+ *   parareal.slices = 16;
+ *   parareal.coarse_stride = 8;
+ *   parareal.checkpoint_path = "run.parareal";
+ *   PararealStats stats = engine.runParareal(100000, parareal);
+ *
+ * Engines: SATPHiggsEngine1D/2D/3D and IGSOAComplexEngine (1D), 2D and 3D
+ * (runParareal). IGSOA missions are undriven.
+ *
+ * With checkpoint_path set, the boundary states are saved after every
+ * iteration. A later call with the same engine shape, step count and
+ * slicing resumes from the file (stats.resumed), even on a fresh engine:
+ * the mission start state and clock come from the file. Other files at
+ * that path are overwritten.
+ *
+ * Memory: three states per slice boundary plus one engine per worker
+ * thread and two coarse engines. Inside the fine sweep each worker
+ * steps single-threaded (nested OpenMP regions stay inactive), while the
+ * coarse sweeps use every thread.
+ */
+
+#pragma once
+
+#include "checkpoint_file.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace dase {
+
+struct PararealConfig {
+    size_t slices = 0;             // Time slices (0: one per OpenMP thread; at most num_steps)
+    size_t max_iterations = 0;     // Correction iterations, resumed ones included (0: slices, exact)
+    double tolerance = 1e-10;      // Largest scaled boundary change accepted as converged
+    size_t coarse_stride = 4;      // Fine steps per coarse step (lowered to the stability limit)
+    bool coarse_float = false;     // Coarse propagator in float32 (changes stall near 1e-7)
+    std::string checkpoint_path;   // Iterate saved after every iteration and resumed ("": off)
+};
+
+struct PararealStats {
+    size_t slices = 0;
+    size_t iterations = 0;        // Correction iterations (fine sweeps), those before a resume included
+    bool converged = false;       // Boundary change within tolerance, or every slice exact
+    bool resumed = false;         // Started from checkpoint_path
+    double change = 0.0;          // Scaled boundary change of the last iteration
+    size_t coarse_stride = 0;     // Stride used
+    uint64_t fine_steps = 0;      // Steps taken by the fine workers
+    uint64_t coarse_steps = 0;    // Steps taken by the coarse engines
+    double fine_seconds = 0.0;    // Wall time of the concurrent fine sweeps
+    double coarse_seconds = 0.0;  // Wall time of the sequential coarse sweeps
+};
+
+/**
+ * num_steps split into slices of equal length (the first num_steps % slices
+ * one step longer)
+ */
+struct PararealSchedule {
+    uint64_t num_steps = 0;
+    size_t slices = 1;
+
+    uint64_t steps(size_t slice) const {
+        return num_steps / slices + (slice < num_steps % slices ? 1 : 0);
+    }
+    uint64_t first(size_t slice) const {
+        return slice * (num_steps / slices) + std::min<uint64_t>(slice, num_steps % slices);
+    }
+};
+
+inline size_t pararealThreads() {
+#ifdef _OPENMP
+    return static_cast<size_t>(std::max(1, omp_get_max_threads()));
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Engine-backed propagators of runParareal
+ *
+ * Engine workers are created by make(dt_multiple, coarse): one fine
+ * worker per thread, one coarse engine at coarse_stride·dt and one at dt
+ * for the remainder of a slice not divisible by the stride.
+ * advance(engine, in, first_step, steps, out, start_time, start_step)
+ * loads in, sets the clock to mission step first_step (counted from the
+ * mission start start_time / start_step) and steps. Ops supplies the
+ * state algebra and checkpoint sections:
+ *
+ *   static void correct(const State& g_new, const State& f_old, const State& g_old, State& out);
+ *   static double change(const State& a, const State& b);     // max|Δ| / (1 + max|b|)
+ *   static void save(CheckpointWriter& writer, const std::string& name, const State& state);
+ *   static bool load(const CheckpointReader& reader, const std::string& name, State& state);
+ */
+template<typename Engine, typename State, typename Ops, typename Advance>
+class PararealEngines {
+public:
+    using StateType = State;
+
+    template<typename Make>
+    PararealEngines(std::string engine_type, std::vector<uint64_t> dims, const PararealSchedule& schedule,
+                    size_t workers, size_t coarse_stride, double start_time, uint64_t start_step,
+                    Make make, Advance advance)
+        : engine_type_(std::move(engine_type)), dims_(std::move(dims)), schedule_(schedule),
+          stride_(std::max<size_t>(1, coarse_stride)), start_time_(start_time), start_step_(start_step),
+          advance_(std::move(advance)) {
+        for (size_t w = 0; w < workers; w++) {
+            fine_.push_back(make(1.0, false));
+        }
+        coarse_ = make(static_cast<double>(stride_), true);
+        remainder_ = make(1.0, true);
+    }
+
+    size_t slices() const { return schedule_.slices; }
+    size_t workers() const { return fine_.size(); }
+    size_t coarseStride() const { return stride_; }
+    double startTime() const { return start_time_; }
+    uint64_t startStep() const { return start_step_; }
+
+    uint64_t fine(size_t worker, size_t slice, const State& in, State& out) {
+        advance_(*fine_[worker], in, schedule_.first(slice), schedule_.steps(slice), out, start_time_, start_step_);
+        return schedule_.steps(slice);
+    }
+
+    uint64_t coarse(size_t slice, const State& in, State& out) {
+        const uint64_t steps = schedule_.steps(slice);
+        const uint64_t strided = steps / stride_;
+        const uint64_t rest = steps % stride_;
+        const uint64_t first = schedule_.first(slice);
+        if (strided > 0) {
+            advance_(*coarse_, in, first, strided, out, start_time_, start_step_);
+        }
+        if (rest > 0) {
+            advance_(*remainder_, strided > 0 ? out : in, first + strided * stride_, rest, out,
+                     start_time_, start_step_);
+        }
+        if (steps == 0) out = in;
+        return strided + rest;
+    }
+
+    static void correct(const State& g_new, const State& f_old, const State& g_old, State& out) {
+        Ops::correct(g_new, f_old, g_old, out);
+    }
+    static double change(const State& a, const State& b) { return Ops::change(a, b); }
+    static void saveState(CheckpointWriter& writer, const std::string& name, const State& state) {
+        Ops::save(writer, name, state);
+    }
+    static bool loadState(const CheckpointReader& reader, const std::string& name, State& state) {
+        return Ops::load(reader, name, state);
+    }
+
+    // Mission identity stored with the iterate
+    void describe(CheckpointWriter& writer) const {
+        writer.setEngineType("parareal_" + engine_type_);
+        writer.copyArray("dims", dims_.data(), dims_.size());
+        writer.addScalar("num_steps", schedule_.num_steps);
+        writer.addScalar("slices", static_cast<uint64_t>(schedule_.slices));
+        writer.addScalar("coarse_stride", static_cast<uint64_t>(stride_));
+        writer.addScalar("start_time", start_time_);
+        writer.addScalar("start_step", start_step_);
+    }
+
+    // True if reader holds an iterate of this mission; adopts its clock
+    bool matches(const CheckpointReader& reader) {
+        uint64_t num_steps = 0, slices = 0, stride = 0, step = 0;
+        double time = 0.0;
+        if (!checkCheckpointShape(reader, "parareal_" + engine_type_, dims_, nullptr) ||
+            !reader.scalar("num_steps", num_steps) || !reader.scalar("slices", slices) ||
+            !reader.scalar("coarse_stride", stride) || !reader.scalar("start_time", time) ||
+            !reader.scalar("start_step", step)) {
+            return false;
+        }
+        if (num_steps != schedule_.num_steps || slices != schedule_.slices || stride != stride_) return false;
+        start_time_ = time;
+        start_step_ = step;
+        return true;
+    }
+
+private:
+    std::string engine_type_;
+    std::vector<uint64_t> dims_;
+    PararealSchedule schedule_;
+    size_t stride_;
+    double start_time_;
+    uint64_t start_step_;
+    Advance advance_;
+    std::vector<std::unique_ptr<Engine>> fine_;
+    std::unique_ptr<Engine> coarse_;
+    std::unique_ptr<Engine> remainder_;
+};
+
+namespace parareal_detail {
+
+template<typename Problem, typename State>
+inline bool saveIterate(const Problem& problem, const std::string& path, uint64_t iteration, uint64_t exact,
+                        double change, const std::vector<State>& u, const std::vector<State>& g) {
+    CheckpointWriter writer;
+    problem.describe(writer);
+    writer.addScalar("iteration", iteration);
+    writer.addScalar("exact", exact);
+    writer.addScalar("change", change);
+    for (size_t n = 0; n < u.size(); n++) {
+        Problem::saveState(writer, "u" + std::to_string(n), u[n]);
+        if (n > 0) Problem::saveState(writer, "g" + std::to_string(n), g[n]);
+    }
+    return writer.write(path);
+}
+
+template<typename Problem, typename State>
+inline bool loadIterate(Problem& problem, const std::string& path, uint64_t& iteration, uint64_t& exact,
+                        double& change, std::vector<State>& u, std::vector<State>& g) {
+    CheckpointReader reader;
+    if (!reader.open(path) || !problem.matches(reader)) return false;
+    if (!reader.scalar("iteration", iteration) || !reader.scalar("exact", exact) ||
+        !reader.scalar("change", change) || exact < 1 || exact > u.size()) {
+        return false;
+    }
+    std::vector<State> u_file = u;
+    std::vector<State> g_file = g;
+    for (size_t n = 0; n < u.size(); n++) {
+        if (!Problem::loadState(reader, "u" + std::to_string(n), u_file[n])) return false;
+        if (n > 0 && !Problem::loadState(reader, "g" + std::to_string(n), g_file[n])) return false;
+    }
+    u = std::move(u_file);
+    g = std::move(g_file);
+    return true;
+}
+
+inline double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace parareal_detail
+
+/**
+ * Parareal iteration over problem.slices() slices
+ *
+ * u[0] is the initial state (every entry sized like it); on return u[n] is
+ * the state at the end of slice n - 1 and u.back() the mission result.
+ */
+template<typename Problem, typename State>
+PararealStats runParareal(Problem& problem, std::vector<State>& u, const PararealConfig& config) {
+    using Clock = std::chrono::steady_clock;
+    const size_t P = problem.slices();
+    PararealStats stats;
+    stats.slices = P;
+    stats.coarse_stride = problem.coarseStride();
+    const size_t max_iterations = config.max_iterations > 0 ? config.max_iterations : P;
+
+    u.resize(P + 1, u[0]);
+    std::vector<State> g(P + 1, u[0]);   // g[n+1] = G(u_old[n])
+    std::vector<State> f(P + 1, u[0]);   // f[n+1] = F(u_old[n])
+    State g_new = u[0];
+    State next = u[0];
+
+    uint64_t iteration = 0;
+    uint64_t exact = 1;   // u[0 .. exact) hold the serial result
+    double change = 0.0;
+    const bool checkpointing = !config.checkpoint_path.empty();
+    if (checkpointing &&
+        parareal_detail::loadIterate(problem, config.checkpoint_path, iteration, exact, change, u, g)) {
+        stats.resumed = true;
+    } else {
+        const Clock::time_point start = Clock::now();
+        for (size_t n = 0; n < P; n++) {
+            stats.coarse_steps += problem.coarse(n, u[n], g[n + 1]);
+            u[n + 1] = g[n + 1];
+        }
+        stats.coarse_seconds += parareal_detail::secondsSince(start);
+        if (checkpointing) parareal_detail::saveIterate(problem, config.checkpoint_path, 0, exact, change, u, g);
+    }
+
+    auto converged = [&]() { return exact > P || (iteration > 0 && change <= config.tolerance); };
+    while (!converged() && iteration < max_iterations) {
+        // Fine sweep: slices from the last exact boundary on, concurrently
+        const size_t first = static_cast<size_t>(exact - 1);
+        const size_t pending = P - first;
+        const size_t threads = std::min(problem.workers(), pending);
+        uint64_t fine_steps = 0;
+        Clock::time_point start = Clock::now();
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(static_cast<int>(threads)) reduction(+:fine_steps)
+#endif
+        for (long long i = 0; i < static_cast<long long>(pending); i++) {
+            size_t worker = 0;
+#ifdef _OPENMP
+            worker = static_cast<size_t>(omp_get_thread_num());
+#endif
+            const size_t n = first + static_cast<size_t>(i);
+            fine_steps += problem.fine(worker, n, u[n], f[n + 1]);
+        }
+        (void)threads;
+        stats.fine_steps += fine_steps;
+        stats.fine_seconds += parareal_detail::secondsSince(start);
+
+        // Correction sweep: u[exact] = F(u[exact - 1]) is final; later
+        // boundaries take the coarse prediction plus the fine correction
+        start = Clock::now();
+        change = Problem::change(f[exact], u[exact]);
+        u[exact] = f[exact];
+        for (size_t n = static_cast<size_t>(exact); n < P; n++) {
+            stats.coarse_steps += problem.coarse(n, u[n], g_new);
+            Problem::correct(g_new, f[n + 1], g[n + 1], next);
+            change = std::max(change, Problem::change(next, u[n + 1]));
+            std::swap(g[n + 1], g_new);
+            std::swap(u[n + 1], next);
+        }
+        stats.coarse_seconds += parareal_detail::secondsSince(start);
+
+        exact++;
+        iteration++;
+        if (checkpointing) {
+            parareal_detail::saveIterate(problem, config.checkpoint_path, iteration, exact, change, u, g);
+        }
+    }
+    stats.iterations = static_cast<size_t>(iteration);
+    stats.change = change;
+    stats.converged = converged();
+    return stats;
+}
+
+} // namespace dase
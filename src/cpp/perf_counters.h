@@ -0,0 +1,353 @@
+/**
+ * Perf Counters - Hardware Event Counts Around Engine Missions
+ *
+ * Wall-clock ns/op cannot tell a bandwidth-bound regression from a cache
+ * or vectorization one. PerfCounters reads the Linux perf_event counters
+ * over a mission:
+ *
+ *   PerfCounters counters;
+ *   counters.measure([&] { engine.runMission(1000); });
+ *   const PerfCounterSample& s = counters.last();
+ *   double ipc = s.ipc();          // < 0 when cycles/instructions are missing
+ *
+ * Events:
+ * - cycles, instructions       generic hardware events
+ * - llc_references/llc_misses  generic cache events (last-level cache on
+ *                              current x86 and ARM cores)
+ * - fp_vector_instructions     packed FP arithmetic instructions retired.
+ *                              Intel only (raw FP_ARITH_INST_RETIRED, umask
+ *                              0xFC); DASE_PERF_FP_EVENT=<hex> sets another
+ *                              raw event, e.g. on AMD
+ * - task_clock                 CPU time of all counted threads (software)
+ *
+ * Each event opens on every thread in /proc/self/task when the mission
+ * starts, with inherit set so that threads created during it count too;
+ * OpenMP teams are covered either way. Missions on other threads of the
+ * process (async CLI workers) land in the same counts. User space only, so
+ * perf_event_paranoid ≤ 2 is enough. An event the kernel refuses (VMs
+ * without a PMU, paranoid 3, non-Linux builds) is reported unavailable;
+ * the sample keeps the others. Multiplexed counters are scaled by
+ * time_enabled / time_running.
+ *
+ * Memory traffic is estimated as llc_misses × 64 bytes. That misses
+ * prefetched lines and writebacks, so treat it as a lower bound.
+ *
+ * Opening costs a few µs per event and thread, so measure missions, not
+ * single steps.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fstream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dase {
+
+enum class PerfEvent : uint8_t {
+    Cycles = 0,
+    Instructions,
+    LlcReferences,
+    LlcMisses,
+    FpVectorInstructions,
+    TaskClock
+};
+
+constexpr size_t kPerfEventCount = 6;
+
+inline const char* perfEventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::LlcReferences: return "llc_references";
+        case PerfEvent::LlcMisses: return "llc_misses";
+        case PerfEvent::FpVectorInstructions: return "fp_vector_instructions";
+        case PerfEvent::TaskClock: return "task_clock_ns";
+    }
+    return "";
+}
+
+/**
+ * Event counts of one or more missions
+ */
+struct PerfCounterSample {
+    uint64_t values[kPerfEventCount] = {};
+    bool available[kPerfEventCount] = {};
+    uint64_t wall_ns = 0;
+    bool multiplexed = false;   // Some counter shared the PMU and was scaled
+
+    bool has(PerfEvent e) const { return available[static_cast<size_t>(e)]; }
+    uint64_t value(PerfEvent e) const { return values[static_cast<size_t>(e)]; }
+
+    // Derived figures; -1 when an input event is unavailable
+    double ipc() const {
+        return ratio(PerfEvent::Instructions, PerfEvent::Cycles);
+    }
+    double llcMissRatio() const {
+        return ratio(PerfEvent::LlcMisses, PerfEvent::LlcReferences);
+    }
+    double vectorInstructionsPerCycle() const {
+        return ratio(PerfEvent::FpVectorInstructions, PerfEvent::Cycles);
+    }
+    double dramBytes() const {
+        return has(PerfEvent::LlcMisses) ? 64.0 * static_cast<double>(value(PerfEvent::LlcMisses)) : -1.0;
+    }
+    double dramGBPerSecond() const {
+        return has(PerfEvent::LlcMisses) && wall_ns > 0 ? dramBytes() / static_cast<double>(wall_ns) : -1.0;
+    }
+    // Vector FP instructions per DRAM byte (roofline x axis)
+    double vectorInstructionsPerByte() const {
+        const double bytes = dramBytes();
+        return has(PerfEvent::FpVectorInstructions) && bytes > 0.0
+            ? static_cast<double>(value(PerfEvent::FpVectorInstructions)) / bytes : -1.0;
+    }
+    // Threads busy on average (task_clock / wall time)
+    double averageParallelism() const {
+        return has(PerfEvent::TaskClock) && wall_ns > 0
+            ? static_cast<double>(value(PerfEvent::TaskClock)) / static_cast<double>(wall_ns) : -1.0;
+    }
+
+    PerfCounterSample& operator+=(const PerfCounterSample& other) {
+        for (size_t e = 0; e < kPerfEventCount; e++) {
+            values[e] += other.values[e];
+            available[e] = available[e] || other.available[e];
+        }
+        wall_ns += other.wall_ns;
+        multiplexed = multiplexed || other.multiplexed;
+        return *this;
+    }
+
+private:
+    double ratio(PerfEvent num, PerfEvent den) const {
+        return has(num) && has(den) && value(den) > 0
+            ? static_cast<double>(value(num)) / static_cast<double>(value(den)) : -1.0;
+    }
+};
+
+/**
+ * Per-mission counter collection with running totals
+ *
+ * measure() is called by the stepping thread; last()/total() may be read
+ * from another thread and take a short lock.
+ */
+class PerfCounters {
+public:
+    /**
+     * False in builds without perf_event (everything reports unavailable)
+     */
+    static constexpr bool supported() {
+#if defined(__linux__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    template <typename F>
+    auto measure(F&& mission) -> decltype(mission()) {
+        Session session;
+        session.start();
+        struct Finish {
+            Session& session;
+            PerfCounters& owner;
+            ~Finish() { owner.record(session.stop()); }
+        } finish{session, *this};
+        return mission();
+    }
+
+    PerfCounterSample last() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_;
+    }
+
+    PerfCounterSample total() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return total_;
+    }
+
+    uint64_t missions() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return missions_;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_ = PerfCounterSample();
+        total_ = PerfCounterSample();
+        missions_ = 0;
+    }
+
+    /**
+     * Counter set of one measurement (usable on its own, e.g. in benchmarks)
+     */
+    class Session {
+    public:
+        Session() = default;
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+        ~Session() { close(); }
+
+        void start() {
+            close();
+#if defined(__linux__)
+            const std::vector<int> tasks = threadIds();
+            for (size_t e = 0; e < kPerfEventCount; e++) {
+                perf_event_attr attr;
+                if (!eventAttr(static_cast<PerfEvent>(e), attr)) continue;
+                for (int tid : tasks) {
+                    const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+                    if (fd >= 0) fds_[e].push_back(fd);
+                }
+            }
+            for (const auto& list : fds_) {
+                for (int fd : list) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+            start_ = std::chrono::steady_clock::now();
+        }
+
+        PerfCounterSample stop() {
+            PerfCounterSample sample;
+            sample.wall_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count());
+#if defined(__linux__)
+            for (const auto& list : fds_) {
+                for (int fd : list) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+            for (size_t e = 0; e < kPerfEventCount; e++) {
+                if (fds_[e].empty()) continue;
+                double total = 0.0;
+                bool read_any = false;
+                for (int fd : fds_[e]) {
+                    uint64_t data[3] = {};  // value, time_enabled, time_running
+                    if (::read(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+                    read_any = true;
+                    if (data[2] > 0 && data[2] < data[1]) {
+                        total += static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                 static_cast<double>(data[2]);
+                        sample.multiplexed = true;
+                    } else if (data[2] > 0 || data[1] == 0) {
+                        total += static_cast<double>(data[0]);
+                    }
+                }
+                sample.values[e] = static_cast<uint64_t>(total + 0.5);
+                sample.available[e] = read_any;
+            }
+#endif
+            close();
+            return sample;
+        }
+
+    private:
+        std::vector<int> fds_[kPerfEventCount];
+        std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+        void close() {
+#if defined(__linux__)
+            for (auto& list : fds_) {
+                for (int fd : list) ::close(fd);
+                list.clear();
+            }
+#endif
+        }
+
+#if defined(__linux__)
+        static std::vector<int> threadIds() {
+            std::vector<int> ids;
+            if (DIR* dir = opendir("/proc/self/task")) {
+                while (dirent* entry = readdir(dir)) {
+                    const int tid = std::atoi(entry->d_name);
+                    if (tid > 0) ids.push_back(tid);
+                }
+                closedir(dir);
+            }
+            if (ids.empty()) ids.push_back(0);
+            return ids;
+        }
+
+        // Raw FP vector event: DASE_PERF_FP_EVENT, else FP_ARITH_INST_RETIRED
+        // (packed 128/256/512-bit, single and double) on Intel
+        static uint64_t fpVectorRawConfig() {
+            static const uint64_t config = []() -> uint64_t {
+                if (const char* env = std::getenv("DASE_PERF_FP_EVENT")) {
+                    return std::strtoull(env, nullptr, 16);
+                }
+                std::ifstream cpuinfo("/proc/cpuinfo");
+                std::string line;
+                while (std::getline(cpuinfo, line)) {
+                    if (line.compare(0, 9, "vendor_id") == 0) {
+                        return line.find("GenuineIntel") != std::string::npos ? 0xFCC7u : 0u;
+                    }
+                }
+                return 0u;
+            }();
+            return config;
+        }
+
+        static bool eventAttr(PerfEvent event, perf_event_attr& attr) {
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            switch (event) {
+                case PerfEvent::Cycles:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                    return true;
+                case PerfEvent::Instructions:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                    return true;
+                case PerfEvent::LlcReferences:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CACHE_REFERENCES;
+                    return true;
+                case PerfEvent::LlcMisses:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                    return true;
+                case PerfEvent::FpVectorInstructions:
+                    attr.type = PERF_TYPE_RAW;
+                    attr.config = fpVectorRawConfig();
+                    return attr.config != 0;
+                case PerfEvent::TaskClock:
+                    attr.type = PERF_TYPE_SOFTWARE;
+                    attr.config = PERF_COUNT_SW_TASK_CLOCK;
+                    return true;
+            }
+            return false;
+        }
+#endif
+    };
+
+private:
+    mutable std::mutex mutex_;
+    PerfCounterSample last_;
+    PerfCounterSample total_;
+    uint64_t missions_ = 0;
+
+    void record(const PerfCounterSample& sample) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_ = sample;
+        total_ += sample;
+        missions_++;
+    }
+};
+
+} // namespace dase
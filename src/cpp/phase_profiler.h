@@ -0,0 +1,159 @@
+/**
+ * Phase Profiler - Per-Phase Timing of Engine Time Steps
+ *
+ * Each engine owns a PhaseProfiler with a fixed list of phase names and
+ * wraps the stages of its time step in DASE_PROFILE_PHASE scopes:
+ *
+ *   PhaseProfiler profiler({"accel", "update"});
+ *   { DASE_PROFILE_PHASE(&profiler, 0); accel(); }
+ *
+ * Shared step helpers take an optional PhaseProfiler* (nullptr: untimed).
+ *
+ * A scope reads steady_clock on entry and exit and adds the elapsed time
+ * and one call to the phase with relaxed atomics. The stepping thread is
+ * the only writer, so the adds never contend. snapshot() may run on
+ * another thread while a mission is in flight (get_metrics during an
+ * async run) without taking a lock.
+ *
+ * Phases wrap whole-lattice sweeps (microseconds and up), so two clock
+ * reads per phase are noise next to the work being timed.
+ *
+ * Building with DASE_NO_PROFILE (CMake: -DDASE_ENABLE_PROFILING=OFF)
+ * compiles every DASE_PROFILE_PHASE to nothing; snapshot() then reports
+ * zero calls and enabled() is false.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace dase {
+
+/**
+ * Accumulated time of one phase
+ */
+struct PhaseTiming {
+    const char* name = "";
+    uint64_t calls = 0;
+    uint64_t total_ns = 0;
+};
+
+class PhaseProfiler {
+public:
+    static constexpr size_t kMaxPhases = 12;
+
+    explicit PhaseProfiler(std::initializer_list<const char*> names) {
+        for (const char* name : names) {
+            if (count_ == kMaxPhases) break;
+            names_[count_++] = name;
+        }
+    }
+
+    // Copies carry the current totals (engines are copied into containers)
+    PhaseProfiler(const PhaseProfiler& other) { *this = other; }
+
+    PhaseProfiler& operator=(const PhaseProfiler& other) {
+        if (this == &other) return *this;
+        count_ = other.count_;
+        for (size_t p = 0; p < kMaxPhases; p++) {
+            names_[p] = other.names_[p];
+            slots_[p].calls.store(other.slots_[p].calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            slots_[p].total_ns.store(other.slots_[p].total_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    /**
+     * False in DASE_NO_PROFILE builds (all scopes compiled out)
+     */
+    static constexpr bool enabled() {
+#ifdef DASE_NO_PROFILE
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    size_t phaseCount() const { return count_; }
+    const char* phaseName(size_t phase) const { return phase < count_ ? names_[phase] : ""; }
+
+    void add(size_t phase, uint64_t ns) {
+        if (phase >= count_) return;
+        slots_[phase].calls.fetch_add(1, std::memory_order_relaxed);
+        slots_[phase].total_ns.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    /**
+     * Current totals of every phase, in declaration order
+     */
+    std::vector<PhaseTiming> snapshot() const {
+        std::vector<PhaseTiming> out(count_);
+        for (size_t p = 0; p < count_; p++) {
+            out[p].name = names_[p];
+            out[p].calls = slots_[p].calls.load(std::memory_order_relaxed);
+            out[p].total_ns = slots_[p].total_ns.load(std::memory_order_relaxed);
+        }
+        return out;
+    }
+
+    void reset() {
+        for (size_t p = 0; p < count_; p++) {
+            slots_[p].calls.store(0, std::memory_order_relaxed);
+            slots_[p].total_ns.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Times its lifetime into one phase (no clock reads for a null profiler)
+     */
+    class Scope {
+    public:
+        Scope(PhaseProfiler* profiler, size_t phase) : profiler_(profiler), phase_(phase) {
+            if (profiler_) start_ = std::chrono::steady_clock::now();
+        }
+
+        ~Scope() {
+            if (!profiler_) return;
+            const auto elapsed = std::chrono::steady_clock::now() - start_;
+            profiler_->add(phase_, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PhaseProfiler* profiler_;
+        size_t phase_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+private:
+    // One cache line per phase
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> total_ns{0};
+    };
+
+    const char* names_[kMaxPhases] = {};
+    size_t count_ = 0;
+    Slot slots_[kMaxPhases];
+};
+
+} // namespace dase
+
+#define DASE_PROFILE_CONCAT_INNER(a, b) a##b
+#define DASE_PROFILE_CONCAT(a, b) DASE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef DASE_NO_PROFILE
+#define DASE_PROFILE_PHASE(profiler, phase) ((void)sizeof(profiler))
+#else
+// Times the rest of the enclosing block into phase of *profiler (may be null)
+#define DASE_PROFILE_PHASE(profiler, phase) \
+    ::dase::PhaseProfiler::Scope DASE_PROFILE_CONCAT(dase_phase_scope_, __LINE__)((profiler), (phase))
+#endif
@@ -3,11 +3,232 @@
 #include <pybind11/numpy.h>
 
 #include "analog_universal_node_engine_avx2.h"
+#include "analog_stream_filter.h"
+#include "oscillator_bank.h"
+#include "igsoa_complex_engine.h"
+#include "igsoa_complex_engine_2d.h"
+#include "igsoa_complex_engine_3d.h"
+#include "satp_higgs_engine_1d.h"
+#include "satp_higgs_physics_1d.h"
+#include "satp_higgs_engine_2d.h"
+#include "satp_higgs_physics_2d.h"
+#include "satp_higgs_engine_3d.h"
+#include "satp_higgs_physics_3d.h"
+
+#include <atomic>
+#include <complex>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace py = pybind11;
 
+using dase::igsoa::IGSOAComplexConfig;
+using dase::igsoa::IGSOAComplexEngine;
+using dase::igsoa::IGSOAComplexEngine2D;
+using dase::igsoa::IGSOAComplexEngine3D;
+using dase::igsoa::IGSOACouplingMode;
+using dase::igsoa::IGSOALatticeSoA;
+using dase::igsoa::LatticeArray;
+using dase::satp_higgs::SATPHiggsEngine1D;
+using dase::satp_higgs::SATPHiggsEngine2D;
+using dase::satp_higgs::SATPHiggsEngine3D;
+using dase::satp_higgs::SATPHiggsField;
+using dase::satp_higgs::SATPHiggsNode;
+using dase::satp_higgs::SATPHiggsParams;
+
+namespace {
+
+// Engine plus a mission flag. run_mission releases the GIL, so other Python
+// threads may keep reading the state views while it runs; writes through the
+// bindings are refused until it returns.
+template <typename Engine>
+struct BoundEngine {
+    template <typename... Args>
+    explicit BoundEngine(Args&&... args) : engine(std::forward<Args>(args)...) {}
+
+    void requireIdle() const {
+        if (running.load()) {
+            throw std::runtime_error("Engine state is read-only while a mission is running");
+        }
+    }
+
+    template <typename Fn>
+    void runMission(Fn&& evolve) {
+        if (running.exchange(true)) {
+            throw std::runtime_error("A mission is already running on this engine");
+        }
+        struct Reset {
+            std::atomic<bool>& flag;
+            ~Reset() { flag.store(false); }
+        } reset{running};
+        py::gil_scoped_release release;
+        evolve(engine);
+    }
+
+    Engine engine;
+    std::atomic<bool> running{false};
+};
+
+// Read-only NumPy view over engine-owned doubles (row-major shape, `item_stride`
+// bytes between consecutive elements). `owner` is the Python engine object, so
+// the view keeps the engine, and therefore the storage, alive.
+py::array stateView(const double* data, const std::vector<py::ssize_t>& shape,
+                    py::ssize_t item_stride, py::handle owner) {
+    std::vector<py::ssize_t> strides(shape.size());
+    py::ssize_t step = item_stride;
+    for (size_t d = shape.size(); d-- > 0;) {
+        strides[d] = step;
+        step *= shape[d];
+    }
+    py::array view(py::dtype::of<double>(), shape, strides, data, owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+using InputArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+using ComplexInputArray = py::array_t<std::complex<double>, py::array::c_style | py::array::forcecast>;
+
+void requireFit(bool ok) {
+    if (!ok) {
+        throw py::value_error("Range does not fit the engine (first + size > num_nodes)");
+    }
+}
+
+// Members shared by the 1D/2D/3D IGSOA engines. Views alias the SoA lattice,
+// which is the engine's authoritative storage and is updated in place by
+// run_mission; writes go through the bulk setters so F and phase stay consistent.
+template <typename Engine, typename ShapeFn>
+void bindIgsoaState(py::class_<BoundEngine<Engine>>& cls, ShapeFn shape) {
+    using Bound = BoundEngine<Engine>;
+
+    auto latticeView = [shape](LatticeArray<double> IGSOALatticeSoA::* field) {
+        return [shape, field](py::object self) {
+            const Bound& bound = self.cast<const Bound&>();
+            const IGSOALatticeSoA& lattice = bound.engine.getLattice();
+            return stateView((lattice.*field).data(), shape(bound.engine), sizeof(double), self);
+        };
+    };
+
+    cls.def_property_readonly("psi_real", latticeView(&IGSOALatticeSoA::psi_re), "Re(Ψ) view (read-only)")
+       .def_property_readonly("psi_imag", latticeView(&IGSOALatticeSoA::psi_im), "Im(Ψ) view (read-only)")
+       .def_property_readonly("phi", latticeView(&IGSOALatticeSoA::phi), "Φ view (read-only)")
+       .def_property_readonly("phi_dot", latticeView(&IGSOALatticeSoA::phi_dot), "∂Φ/∂t view (read-only)")
+       .def_property_readonly("F", latticeView(&IGSOALatticeSoA::F), "|Ψ|² view (read-only)")
+       .def_property_readonly("phase", latticeView(&IGSOALatticeSoA::phase), "arg(Ψ) view (read-only)")
+       .def_property_readonly("shape", [shape](const Bound& b) { return py::tuple(py::cast(shape(b.engine))); })
+       .def_property_readonly("running", [](const Bound& b) { return b.running.load(); })
+       .def_property_readonly("current_time", [](const Bound& b) { return b.engine.getCurrentTime(); })
+       .def_property_readonly("total_steps", [](const Bound& b) { return b.engine.getTotalSteps(); })
+       .def_property_readonly("total_operations", [](const Bound& b) { return b.engine.getTotalOperations(); })
+       .def("run_mission", [](Bound& b, uint64_t num_steps) {
+            b.runMission([num_steps](Engine& engine) { engine.runMission(num_steps); });
+        }, py::arg("num_steps"),
+           "Evolve num_steps steps with the GIL released (state views stay readable)")
+       .def("set_psi", [](Bound& b, InputArray re, InputArray im, size_t first) {
+            b.requireIdle();
+            if (re.size() != im.size()) {
+                throw py::value_error("psi_real and psi_imag must have the same size");
+            }
+            requireFit(b.engine.setPsiRange(first, re.size(), re.data(), im.data()));
+        }, py::arg("psi_real"), py::arg("psi_imag"), py::arg("first") = 0,
+           "Set Ψ for nodes [first, first + size) (flattened row-major index)")
+       .def("set_psi_complex", [](Bound& b, ComplexInputArray psi, size_t first) {
+            b.requireIdle();
+            const double* interleaved = reinterpret_cast<const double*>(psi.data());
+            requireFit(b.engine.setPsiRange(first, psi.size(), interleaved, interleaved + 1, 2));
+        }, py::arg("psi"), py::arg("first") = 0,
+           "Set Ψ from a complex128 array for nodes [first, first + size)")
+       .def("set_phi", [](Bound& b, InputArray phi, size_t first) {
+            b.requireIdle();
+            requireFit(b.engine.setPhiRange(first, phi.size(), phi.data()));
+        }, py::arg("phi"), py::arg("first") = 0,
+           "Set Φ for nodes [first, first + size)")
+       .def("save_checkpoint", [](const Bound& b, const std::string& path) {
+            b.requireIdle();
+            std::string error;
+            if (!dase::saveCheckpointFile(b.engine, path, &error)) throw std::runtime_error(error);
+        }, py::arg("path"), "Write the engine state to a binary checkpoint file")
+       .def("load_checkpoint", [](Bound& b, const std::string& path) {
+            b.requireIdle();
+            std::string error;
+            if (!dase::loadCheckpointFile(b.engine, path, &error)) throw std::runtime_error(error);
+        }, py::arg("path"), "Restore the engine state from a checkpoint of the same engine and shape")
+       .def("reset", [](Bound& b) {
+            b.requireIdle();
+            b.engine.reset();
+            b.engine.getLattice();  // Refresh the lattice so existing views see the reset
+        });
+}
+
+IGSOAComplexConfig makeIgsoaConfig(size_t num_nodes, double R_c, double kappa, double gamma,
+                                    double dt, bool normalize_psi, IGSOACouplingMode mode) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(num_nodes);
+    config.R_c_default = R_c;
+    config.kappa = kappa;
+    config.gamma = gamma;
+    config.dt = dt;
+    config.normalize_psi = normalize_psi;
+    config.coupling_mode = mode;
+    return config;
+}
+
+// Members shared by the SATP+Higgs engines. Views are strided over the node
+// array (one SATPHiggsNode per site) and reflect the state after each mission.
+template <typename Engine, typename ShapeFn>
+void bindSatpState(py::class_<BoundEngine<Engine>>& cls, ShapeFn shape) {
+    using Bound = BoundEngine<Engine>;
+
+    auto nodeView = [shape](double SATPHiggsNode::* field) {
+        return [shape, field](py::object self) {
+            const Bound& bound = self.cast<const Bound&>();
+            const SATPHiggsNode& first = bound.engine.getNodes().front();
+            return stateView(&(first.*field), shape(bound.engine), sizeof(SATPHiggsNode), self);
+        };
+    };
+
+    cls.def_property_readonly("phi", nodeView(&SATPHiggsNode::phi), "φ view (read-only)")
+       .def_property_readonly("phi_dot", nodeView(&SATPHiggsNode::phi_dot), "∂φ/∂t view (read-only)")
+       .def_property_readonly("h", nodeView(&SATPHiggsNode::h), "h view (read-only)")
+       .def_property_readonly("h_dot", nodeView(&SATPHiggsNode::h_dot), "∂h/∂t view (read-only)")
+       .def_property_readonly("energy_density", nodeView(&SATPHiggsNode::energy_density), "Energy density view (read-only)")
+       .def_property_readonly("conformal_factor", nodeView(&SATPHiggsNode::conformal_factor), "exp(φ) view (read-only)")
+       .def_property_readonly("shape", [shape](const Bound& b) { return py::tuple(py::cast(shape(b.engine))); })
+       .def_property_readonly("running", [](const Bound& b) { return b.running.load(); })
+       .def_property_readonly("time", [](const Bound& b) { return b.engine.getTime(); })
+       .def_property_readonly("step_count", [](const Bound& b) { return b.engine.getStepCount(); })
+       .def("run_mission", [](Bound& b, size_t num_steps) {
+            b.runMission([num_steps](Engine& engine) { engine.evolve(num_steps); });
+        }, py::arg("num_steps"),
+           "Evolve num_steps steps with the GIL released (state views stay readable)")
+       .def("set_field", [](Bound& b, SATPHiggsField field, InputArray values, size_t first) {
+            b.requireIdle();
+            requireFit(b.engine.setFieldRange(field, first, values.size(), values.data()));
+        }, py::arg("field"), py::arg("values"), py::arg("first") = 0,
+           "Set one field for nodes [first, first + size) (flattened row-major index)")
+       .def("save_checkpoint", [](const Bound& b, const std::string& path) {
+            b.requireIdle();
+            std::string error;
+            if (!dase::saveCheckpointFile(b.engine, path, &error)) throw std::runtime_error(error);
+        }, py::arg("path"), "Write the engine state to a binary checkpoint file")
+       .def("load_checkpoint", [](Bound& b, const std::string& path) {
+            b.requireIdle();
+            std::string error;
+            if (!dase::loadCheckpointFile(b.engine, path, &error)) throw std::runtime_error(error);
+        }, py::arg("path"), "Restore the engine state from a checkpoint of the same engine and shape")
+       .def("reset", [](Bound& b) {
+            b.requireIdle();
+            b.engine.reset();
+        });
+}
+
+} // namespace
+
 PYBIND11_MODULE(dase_engine, m) {
-    m.doc() = "DASE Analog Engine AVX2 Python Bindings";
+    m.doc() = "DASE Analog Engine AVX2, IGSOA and SATP+Higgs Python Bindings";
 
     // ------------------------------------------------------------------------
     //  CPU Feature Access Layer
@@ -100,21 +321,241 @@ PYBIND11_MODULE(dase_engine, m) {
     // ------------------------------------------------------------------------
     //  Analog Cellular Engine
     // ------------------------------------------------------------------------
+    // Node fields are SoA arrays inside the engine: get_node/set_node copy one
+    // node in or out, the views alias the arrays the missions update in place
+    auto analogView = [](AnalogNodeStateSoA::Array<double> AnalogNodeStateSoA::* field) {
+        return [field](py::object self) {
+            const AnalogNodeStateSoA& state = self.cast<const AnalogCellularEngineAVX2&>().getNodeState();
+            const auto& values = state.*field;
+            return stateView(values.data(), {static_cast<py::ssize_t>(values.size())}, sizeof(double), self);
+        };
+    };
+    auto checkNodeIndex = [](const AnalogCellularEngineAVX2& self, std::size_t index) {
+        if (index >= self.getNodeCount()) throw py::index_error("node index out of range");
+    };
+
     py::class_<AnalogCellularEngineAVX2>(m, "AnalogCellularEngineAVX2")
         .def(py::init<std::size_t>(), py::arg("num_nodes") = 1024)
+        .def_property_readonly("num_nodes", &AnalogCellularEngineAVX2::getNodeCount)
+        .def("get_node", [checkNodeIndex](const AnalogCellularEngineAVX2& self, std::size_t index) {
+            checkNodeIndex(self, index);
+            return self.getNode(index);
+        }, py::arg("index"), "Copy of one node's state")
+        .def("set_node", [checkNodeIndex](AnalogCellularEngineAVX2& self, std::size_t index,
+                                          const AnalogUniversalNodeAVX2& node) {
+            checkNodeIndex(self, index);
+            self.setNode(index, node);
+        }, py::arg("index"), py::arg("node"), "Write one node's state back")
+        .def_property_readonly("integrator_state", analogView(&AnalogNodeStateSoA::integrator_state),
+                               "Integrator states view (read-only)")
+        .def_property_readonly("current_output", analogView(&AnalogNodeStateSoA::current_output),
+                               "Node outputs view (read-only)")
+        .def_property_readonly("previous_input", analogView(&AnalogNodeStateSoA::previous_input),
+                               "Last inputs view (read-only)")
+        .def_property_readonly("feedback_gain", analogView(&AnalogNodeStateSoA::feedback_gain),
+                               "Feedback gains view (read-only)")
         .def("run_mission", &AnalogCellularEngineAVX2::runMission)
+        .def("run_mission_per_node", [](AnalogCellularEngineAVX2& self, InputArray input, InputArray control,
+                                        std::uint32_t iterations_per_node, bool node_major) {
+            if (input.ndim() != 2 || control.ndim() != 2 ||
+                input.shape(0) != control.shape(0) || input.shape(1) != control.shape(1)) {
+                throw py::value_error("input and control must be 2-D arrays of the same shape");
+            }
+            const std::size_t nodes_axis = node_major ? 0 : 1;
+            if (static_cast<std::size_t>(input.shape(nodes_axis)) != self.getNodeCount()) {
+                throw py::value_error("drive has " + std::to_string(input.shape(nodes_axis)) +
+                                      " node columns, engine has " + std::to_string(self.getNodeCount()));
+            }
+            const auto num_steps = static_cast<std::uint64_t>(input.shape(1 - nodes_axis));
+            const auto layout = node_major ? AnalogCellularEngineAVX2::SignalLayout::NodeMajor
+                                           : AnalogCellularEngineAVX2::SignalLayout::StepMajor;
+            py::gil_scoped_release release;
+            self.runMissionPerNode(input.data(), control.data(), num_steps, layout, iterations_per_node);
+        }, py::arg("input_signals"), py::arg("control_patterns"), py::arg("iterations_per_node") = 30,
+           py::arg("node_major") = false,
+           "Phase 4C mission with per-node drive: [steps, nodes] arrays ([nodes, steps] if node_major)")
+        .def("run_mission_oscillators", [](AnalogCellularEngineAVX2& self, const std::vector<double>& angular_freqs,
+                                           const std::vector<double>& phases, std::uint64_t num_steps,
+                                           std::uint32_t iterations_per_node) {
+            if (angular_freqs.size() != self.getNodeCount()) {
+                throw py::value_error("need one angular frequency per node");
+            }
+            const dase::OscillatorBank bank(angular_freqs, phases);
+            py::gil_scoped_release release;
+            self.runMissionOscillators(bank, num_steps, iterations_per_node);
+        }, py::arg("angular_freqs"), py::arg("phases") = std::vector<double>(), py::arg("num_steps"),
+           py::arg("iterations_per_node") = 30,
+           "Per-node mission driven by sin/cos(phase + angular_freq * step) per node, generated in place")
         .def("run_builtin_benchmark", &AnalogCellularEngineAVX2::runBuiltinBenchmark)
         .def("run_massive_benchmark", &AnalogCellularEngineAVX2::runMassiveBenchmark)
         .def("run_drag_race_benchmark", &AnalogCellularEngineAVX2::runDragRaceBenchmark)
         .def("process_signal_wave_avx2", &AnalogCellularEngineAVX2::processSignalWaveAVX2)
         .def("perform_signal_sweep_avx2", &AnalogCellularEngineAVX2::performSignalSweepAVX2)
-        .def("process_block_frequency_domain", &AnalogCellularEngineAVX2::processBlockFrequencyDomain)
+        .def("process_block_frequency_domain", [](AnalogCellularEngineAVX2& self, std::vector<double> block) {
+            self.processBlockFrequencyDomain(block);
+            return block;
+        }, py::arg("signal_block"), "Filtered copy of the block (real FFT, frequency mask, inverse FFT)")
+        .def("set_frequency_band", &AnalogCellularEngineAVX2::setFrequencyBand, py::arg("low"), py::arg("high"),
+             "Block filter pass band [low, high) in cycles/sample (0..0.5)")
+        .def("set_frequency_mask", &AnalogCellularEngineAVX2::setFrequencyMask,
+             py::arg("block_size"), py::arg("gains"),
+             "Per-bin gains (block_size // 2 + 1) for blocks of block_size samples; [] clears")
         .def("calculate_inter_node_coupling", &AnalogCellularEngineAVX2::calculateInterNodeCoupling)
         .def("generate_noise_signal", &AnalogCellularEngineAVX2::generateNoiseSignal)
+        .def("generate_noise_batch", [](const AnalogCellularEngineAVX2& self, std::size_t count, std::uint64_t step) {
+            py::array_t<double> output(count);
+            self.generateNoiseBatch(static_cast<double*>(output.request().ptr), count, step);
+            return output;
+        }, py::arg("count"), py::arg("step"),
+           "Reproducible noise batch keyed by (seed, step, index)")
+        .def("set_noise_seed", &AnalogCellularEngineAVX2::setNoiseSeed, py::arg("seed"))
+        .def("get_noise_seed", &AnalogCellularEngineAVX2::getNoiseSeed)
         .def("get_metrics", &AnalogCellularEngineAVX2::getMetrics)
         .def("print_live_metrics", &AnalogCellularEngineAVX2::printLiveMetrics)
         .def("reset_metrics", &AnalogCellularEngineAVX2::resetMetrics);
 
+    // ------------------------------------------------------------------------
+    //  Streaming overlap-add filter
+    // ------------------------------------------------------------------------
+    py::class_<dase::StreamFilter>(m, "StreamFilter")
+        .def(py::init<const std::vector<double>&, size_t>(), py::arg("taps"), py::arg("block_size"),
+             "FIR filter over a continuous stream (output delayed by block_size samples)")
+        .def_static("band_pass", [](double low, double high, size_t num_taps, size_t block_size) {
+            return dase::StreamFilter(dase::StreamFilter::designBandPass(low, high, num_taps), block_size);
+        }, py::arg("low"), py::arg("high"), py::arg("num_taps"), py::arg("block_size"),
+           "Windowed-sinc band-pass for [low, high) cycles/sample")
+        .def_static("design_band_pass", &dase::StreamFilter::designBandPass,
+                    py::arg("low"), py::arg("high"), py::arg("num_taps"))
+        .def("process", [](dase::StreamFilter& self, py::array_t<double, py::array::c_style | py::array::forcecast> input) {
+            py::buffer_info in = input.request();
+            if (in.ndim != 1) {
+                throw std::runtime_error("Input must be 1-dimensional array");
+            }
+            py::array_t<double> output(in.shape[0]);
+            self.process(static_cast<const double*>(in.ptr),
+                         static_cast<double*>(output.request().ptr),
+                         static_cast<size_t>(in.shape[0]));
+            return output;
+        }, py::arg("samples"), "Filter the next chunk of the stream (any length)")
+        .def("reset", &dase::StreamFilter::reset)
+        .def_property_readonly("latency", &dase::StreamFilter::latency)
+        .def_property_readonly("block_size", &dase::StreamFilter::blockSize)
+        .def_property_readonly("fft_size", &dase::StreamFilter::fftSize)
+        .def_property_readonly("num_taps", &dase::StreamFilter::numTaps);
+
+    // ------------------------------------------------------------------------
+    //  IGSOA Complex Engines (1D / 2D / 3D)
+    // ------------------------------------------------------------------------
+    py::enum_<IGSOACouplingMode>(m, "IGSOACouplingMode")
+        .value("Direct", IGSOACouplingMode::Direct)
+        .value("NeighborCache", IGSOACouplingMode::NeighborCache)
+        .value("Spectral", IGSOACouplingMode::Spectral)
+        .value("Recursive", IGSOACouplingMode::Recursive);
+
+    py::class_<BoundEngine<IGSOAComplexEngine>> igsoa_1d(m, "IGSOAEngine1D");
+    igsoa_1d
+        .def(py::init([](size_t num_nodes, double R_c, double kappa, double gamma,
+                         double dt, bool normalize_psi, IGSOACouplingMode mode) {
+            return std::make_unique<BoundEngine<IGSOAComplexEngine>>(
+                makeIgsoaConfig(num_nodes, R_c, kappa, gamma, dt, normalize_psi, mode));
+        }), py::arg("num_nodes"), py::arg("R_c") = 3.0, py::arg("kappa") = 1.0,
+            py::arg("gamma") = 0.1, py::arg("dt") = 0.01, py::arg("normalize_psi") = true,
+            py::arg("coupling_mode") = IGSOACouplingMode::Direct)
+        .def_property_readonly("num_nodes", [](const BoundEngine<IGSOAComplexEngine>& b) {
+            return b.engine.getNumNodes();
+        })
+        .def("get_total_energy", [](const BoundEngine<IGSOAComplexEngine>& b) { return b.engine.getTotalEnergy(); })
+        .def("get_total_entropy_rate", [](const BoundEngine<IGSOAComplexEngine>& b) {
+            return b.engine.getTotalEntropyRate();
+        });
+    bindIgsoaState(igsoa_1d, [](const IGSOAComplexEngine& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNumNodes())};
+    });
+
+    py::class_<BoundEngine<IGSOAComplexEngine2D>> igsoa_2d(m, "IGSOAEngine2D");
+    igsoa_2d
+        .def(py::init([](size_t N_x, size_t N_y, double R_c, double kappa, double gamma,
+                         double dt, bool normalize_psi, IGSOACouplingMode mode) {
+            return std::make_unique<BoundEngine<IGSOAComplexEngine2D>>(
+                makeIgsoaConfig(N_x * N_y, R_c, kappa, gamma, dt, normalize_psi, mode), N_x, N_y);
+        }), py::arg("N_x"), py::arg("N_y"), py::arg("R_c") = 3.0, py::arg("kappa") = 1.0,
+            py::arg("gamma") = 0.1, py::arg("dt") = 0.01, py::arg("normalize_psi") = true,
+            py::arg("coupling_mode") = IGSOACouplingMode::Direct)
+        .def_property_readonly("num_nodes", [](const BoundEngine<IGSOAComplexEngine2D>& b) {
+            return b.engine.getTotalNodes();
+        })
+        .def("get_total_energy", [](const BoundEngine<IGSOAComplexEngine2D>& b) { return b.engine.getTotalEnergy(); })
+        .def("get_total_entropy_rate", [](const BoundEngine<IGSOAComplexEngine2D>& b) {
+            return b.engine.getTotalEntropyRate();
+        });
+    bindIgsoaState(igsoa_2d, [](const IGSOAComplexEngine2D& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNy()), static_cast<py::ssize_t>(e.getNx())};
+    });
+
+    py::class_<BoundEngine<IGSOAComplexEngine3D>> igsoa_3d(m, "IGSOAEngine3D");
+    igsoa_3d
+        .def(py::init([](size_t N_x, size_t N_y, size_t N_z, double R_c, double kappa, double gamma,
+                         double dt, bool normalize_psi, IGSOACouplingMode mode) {
+            return std::make_unique<BoundEngine<IGSOAComplexEngine3D>>(
+                makeIgsoaConfig(N_x * N_y * N_z, R_c, kappa, gamma, dt, normalize_psi, mode), N_x, N_y, N_z);
+        }), py::arg("N_x"), py::arg("N_y"), py::arg("N_z"), py::arg("R_c") = 3.0, py::arg("kappa") = 1.0,
+            py::arg("gamma") = 0.1, py::arg("dt") = 0.01, py::arg("normalize_psi") = true,
+            py::arg("coupling_mode") = IGSOACouplingMode::Direct)
+        .def_property_readonly("num_nodes", [](const BoundEngine<IGSOAComplexEngine3D>& b) {
+            return b.engine.getTotalNodes();
+        });
+    bindIgsoaState(igsoa_3d, [](const IGSOAComplexEngine3D& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNz()), static_cast<py::ssize_t>(e.getNy()),
+                                        static_cast<py::ssize_t>(e.getNx())};
+    });
+
+    // ------------------------------------------------------------------------
+    //  SATP+Higgs Engines (1D / 2D / 3D)
+    // ------------------------------------------------------------------------
+    py::class_<SATPHiggsParams>(m, "SATPHiggsParams")
+        .def(py::init<>())
+        .def_readwrite("c", &SATPHiggsParams::c)
+        .def_readwrite("gamma_phi", &SATPHiggsParams::gamma_phi)
+        .def_readwrite("gamma_h", &SATPHiggsParams::gamma_h)
+        .def_readwrite("lambda_", &SATPHiggsParams::lambda)
+        .def_readwrite("mu_squared", &SATPHiggsParams::mu_squared)
+        .def_readwrite("lambda_h", &SATPHiggsParams::lambda_h)
+        .def_readonly("h_vev", &SATPHiggsParams::h_vev)
+        .def("update_vev", &SATPHiggsParams::updateVEV);
+
+    py::enum_<SATPHiggsField>(m, "SATPHiggsField")
+        .value("Phi", SATPHiggsField::Phi)
+        .value("PhiDot", SATPHiggsField::PhiDot)
+        .value("H", SATPHiggsField::H)
+        .value("HDot", SATPHiggsField::HDot);
+
+    py::class_<BoundEngine<SATPHiggsEngine1D>> satp_1d(m, "SATPHiggsEngine1D");
+    satp_1d.def(py::init([](size_t num_nodes, double dx, double dt, const SATPHiggsParams& params) {
+        return std::make_unique<BoundEngine<SATPHiggsEngine1D>>(num_nodes, dx, dt, params);
+    }), py::arg("num_nodes"), py::arg("dx"), py::arg("dt"), py::arg("params") = SATPHiggsParams());
+    bindSatpState(satp_1d, [](const SATPHiggsEngine1D& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getN())};
+    });
+
+    py::class_<BoundEngine<SATPHiggsEngine2D>> satp_2d(m, "SATPHiggsEngine2D");
+    satp_2d.def(py::init([](size_t N_x, size_t N_y, double dx, double dt, const SATPHiggsParams& params) {
+        return std::make_unique<BoundEngine<SATPHiggsEngine2D>>(N_x, N_y, dx, dt, params);
+    }), py::arg("N_x"), py::arg("N_y"), py::arg("dx"), py::arg("dt"), py::arg("params") = SATPHiggsParams());
+    bindSatpState(satp_2d, [](const SATPHiggsEngine2D& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNy()), static_cast<py::ssize_t>(e.getNx())};
+    });
+
+    py::class_<BoundEngine<SATPHiggsEngine3D>> satp_3d(m, "SATPHiggsEngine3D");
+    satp_3d.def(py::init([](size_t N_x, size_t N_y, size_t N_z, double dx, double dt,
+                            const SATPHiggsParams& params) {
+        return std::make_unique<BoundEngine<SATPHiggsEngine3D>>(N_x, N_y, N_z, dx, dt, params);
+    }), py::arg("N_x"), py::arg("N_y"), py::arg("N_z"), py::arg("dx"), py::arg("dt"),
+        py::arg("params") = SATPHiggsParams());
+    bindSatpState(satp_3d, [](const SATPHiggsEngine3D& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNz()), static_cast<py::ssize_t>(e.getNy()),
+                                        static_cast<py::ssize_t>(e.getNx())};
+    });
+
     // ------------------------------------------------------------------------
     //  Benchmark Helper
     // ------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+/**
+ * Real FFT Plan Cache - Shared r2c/c2r Plans and Per-Thread Buffers
+ *
+ * Block filters over real signals use a real-to-complex transform of N
+ * samples (N/2 + 1 bins) and its complex-to-real inverse. RealFFTPlanCache
+ * plans each size once (FFTW_MEASURE through FFTWWisdomCache, so the wisdom
+ * persists across runs) and hands the same plans to every thread; planning
+ * is serialized by a mutex, execution uses the new-array interface
+ * (fftw_execute_dft_r2c / _c2r) on the caller's buffers.
+ *
+ * RealFFTScratch::local(N) returns FFTW-aligned buffers owned by the calling
+ * thread. They grow to the largest N seen and are reused, so a streaming
+ * loop of fixed-size blocks does no allocation after its first call. The
+ * scratch alignment matches the planning buffers, which the new-array
+ * interface requires.
+ */
+
+#pragma once
+
+#include "fftw_wisdom_cache.hpp"
+#include <fftw3.h>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace dase {
+
+class RealFFTPlanCache {
+public:
+    struct Plans {
+        fftw_plan forward = nullptr;   // N real samples -> N/2 + 1 bins
+        fftw_plan inverse = nullptr;   // N/2 + 1 bins -> N samples (unnormalized)
+    };
+
+    static RealFFTPlanCache& instance() {
+        static RealFFTPlanCache cache;
+        return cache;
+    }
+
+    /**
+     * Plans for size N, created on first request (thread-safe)
+     */
+    Plans get(int N) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = plans_.find(N);
+        if (it != plans_.end()) return it->second;
+
+        // FFTW_MEASURE overwrites its arrays, so plan on scratch of the same alignment
+        double* real = fftw_alloc_real(static_cast<size_t>(N));
+        fftw_complex* spectrum = fftw_alloc_complex(static_cast<size_t>(N / 2 + 1));
+        if (!real || !spectrum) {
+            fftw_free(real);
+            fftw_free(spectrum);
+            throw std::runtime_error("RealFFTPlanCache: planning buffer allocation failed");
+        }
+        Plans plans;
+        plans.forward = FFTWWisdomCache::create_plan_r2c_1d(N, real, spectrum);
+        plans.inverse = FFTWWisdomCache::create_plan_c2r_1d(N, spectrum, real);
+        fftw_free(real);
+        fftw_free(spectrum);
+        if (!plans.forward || !plans.inverse) {
+            if (plans.forward) fftw_destroy_plan(plans.forward);
+            if (plans.inverse) fftw_destroy_plan(plans.inverse);
+            throw std::runtime_error("RealFFTPlanCache: FFT planning failed");
+        }
+        plans_[N] = plans;
+        return plans;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return plans_.size();
+    }
+
+    ~RealFFTPlanCache() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : plans_) {
+            fftw_destroy_plan(entry.second.forward);
+            fftw_destroy_plan(entry.second.inverse);
+        }
+    }
+
+private:
+    RealFFTPlanCache() = default;
+    RealFFTPlanCache(const RealFFTPlanCache&) = delete;
+    RealFFTPlanCache& operator=(const RealFFTPlanCache&) = delete;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, Plans> plans_;
+};
+
+/**
+ * FFTW-aligned real / spectrum buffers of the calling thread
+ */
+struct RealFFTScratch {
+    double* real = nullptr;           // capacity samples
+    fftw_complex* spectrum = nullptr; // capacity / 2 + 1 bins
+    size_t capacity = 0;
+
+    static RealFFTScratch& local(size_t N) {
+        thread_local RealFFTScratch scratch;
+        scratch.reserve(N);
+        return scratch;
+    }
+
+    void reserve(size_t N) {
+        if (N <= capacity) return;
+        release();
+        real = fftw_alloc_real(N);
+        spectrum = fftw_alloc_complex(N / 2 + 1);
+        if (!real || !spectrum) {
+            release();
+            throw std::runtime_error("RealFFTScratch: buffer allocation failed");
+        }
+        capacity = N;
+    }
+
+    void release() {
+        fftw_free(real);
+        fftw_free(spectrum);
+        real = nullptr;
+        spectrum = nullptr;
+        capacity = 0;
+    }
+
+    RealFFTScratch() = default;
+    RealFFTScratch(const RealFFTScratch&) = delete;
+    RealFFTScratch& operator=(const RealFFTScratch&) = delete;
+    ~RealFFTScratch() { release(); }
+};
+
+} // namespace dase
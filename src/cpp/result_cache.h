@@ -0,0 +1,332 @@
+/**
+ * Result Cache - Content-Addressed Final States of Deterministic Missions
+ *
+ * A mission's final state is a function of the engine configuration, the
+ * state initializations applied to it and the missions run since. Those
+ * inputs are folded into a MissionProvenance as they happen; its key (a
+ * 128-bit FNV-1a hash, 32 hex digits) names the state a mission of a given
+ * length would end in. ResultCache keeps such states as checkpoint files
+ * (checkpoint_file.h) named <directory>/<key>.dckpt: a hit maps the file
+ * and restores the engine from it instead of stepping, a miss runs and
+ * stores. Entries are evicted least recently used first (last hit or
+ * store, kept as the file's modification time) to stay within a byte
+ * budget, so the directory can be shared by processes and indexed by
+ * outside tools.
+ *
+ *   MissionProvenance provenance;
+ *   provenance.start();
+ *   provenance.event("create").add(engine_type).add(N_x).add(dt);
+ *   const std::string key = provenance.keyAfter(0, num_steps);
+ *   if (!cache.load(key, engine)) {
+ *       engine.runMission(num_steps, ...);
+ *       cache.store(key, engine);
+ *   }
+ *   provenance.advance(0, num_steps);
+ *
+ * Not synchronized; writes go through checkpoint_file's "<path>.tmp" and
+ * rename, so a concurrent reader never sees a partial entry.
+ */
+
+#pragma once
+
+#include "checkpoint_file.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace dase {
+
+// Version of what a provenance key stands for: bump it when an engine's
+// stepping or the hashed events change, so existing cache entries miss
+constexpr uint32_t kResultCacheSchema = 1;
+
+/**
+ * FNV-1a, 128-bit (prime 2^88 + 0x13B)
+ */
+class ResultHash {
+public:
+    ResultHash& addBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            lo_ ^= bytes[i];
+            multiplyByPrime();
+        }
+        return *this;
+    }
+
+    // Strings are length-prefixed, so ("ab", "c") and ("a", "bc") differ
+    ResultHash& add(const std::string& value) {
+        add(static_cast<uint64_t>(value.size()));
+        return addBytes(value.data(), value.size());
+    }
+    ResultHash& add(const char* value) { return add(std::string(value)); }
+
+    template <typename T>
+    ResultHash& add(T value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "hash scalars or strings");
+        return addBytes(&value, sizeof(value));
+    }
+
+    uint64_t high() const { return hi_; }
+    uint64_t low() const { return lo_; }
+
+    std::string hex() const {
+        static const char digits[] = "0123456789abcdef";
+        std::string out(32, '0');
+        for (int i = 0; i < 16; i++) {
+            out[15 - i] = digits[(hi_ >> (4 * i)) & 0xF];
+            out[31 - i] = digits[(lo_ >> (4 * i)) & 0xF];
+        }
+        return out;
+    }
+
+private:
+    uint64_t hi_ = 0x6c62272e07bb0142ULL;   // Offset basis
+    uint64_t lo_ = 0x62b821756295c58dULL;
+
+    // h·(2^88 + 0x13B) mod 2^128, without relying on a 128-bit integer type
+    void multiplyByPrime() {
+        const uint64_t low_part = (lo_ & 0xFFFFFFFFULL) * 0x13B;
+        const uint64_t high_part = (lo_ >> 32) * 0x13B;
+        const uint64_t lo = low_part + (high_part << 32);
+        const uint64_t carry = (high_part >> 32) + (lo < low_part ? 1 : 0);
+        hi_ = hi_ * 0x13B + carry + (lo_ << 24);
+        lo_ = lo;
+    }
+};
+
+/**
+ * Everything that determined an engine's current state
+ *
+ * Events (creation, state profiles, integrator changes) are hashed in
+ * order. Missions only extend a pending step segment while each continues
+ * the previous one's input sequence (its step_offset is where the last one
+ * stopped), so a mission split into chunks keys the same as one call.
+ * Untracked provenance (never started, or after a change that cannot be
+ * hashed) has no key. start() salts the hash with kResultCacheSchema and
+ * the checkpoint format version, so entries written by an older build miss
+ * instead of restoring a state the current one would not reach.
+ */
+class MissionProvenance {
+public:
+    void start() {
+        tracked_ = true;
+        base_ = ResultHash();
+        base_.add("schema").add(kResultCacheSchema).add(kCheckpointVersion);
+        segment_offset_ = 0;
+        segment_steps_ = 0;
+    }
+
+    void untrack() { tracked_ = false; }
+    bool tracked() const { return tracked_; }
+
+    // Hash to append an event's parameters to (after the tag)
+    ResultHash& event(const char* tag) {
+        foldSegment();
+        return base_.add(tag);
+    }
+
+    void advance(uint64_t step_offset, uint64_t steps) {
+        if (steps == 0) return;
+        if (segment_steps_ == 0 || step_offset != segment_offset_ + segment_steps_) {
+            foldSegment();
+            segment_offset_ = step_offset;
+        }
+        segment_steps_ += steps;
+    }
+
+    // Key of the current state (empty if untracked)
+    std::string key() const {
+        if (!tracked_) return std::string();
+        ResultHash hash = base_;
+        return hash.add("steps").add(segment_offset_).add(segment_steps_).hex();
+    }
+
+    // Key of the state after a further mission
+    std::string keyAfter(uint64_t step_offset, uint64_t steps) const {
+        MissionProvenance next = *this;
+        next.advance(step_offset, steps);
+        return next.key();
+    }
+
+private:
+    bool tracked_ = false;
+    ResultHash base_;
+    uint64_t segment_offset_ = 0;
+    uint64_t segment_steps_ = 0;
+
+    void foldSegment() {
+        if (segment_steps_ == 0) return;
+        base_.add("run").add(segment_offset_).add(segment_steps_);
+        segment_steps_ = 0;
+    }
+};
+
+struct ResultCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;          // Entry files in the directory
+    uint64_t bytes = 0;          // Their total size
+    uint64_t max_bytes = 0;
+};
+
+class ResultCache {
+public:
+    static constexpr const char* kExtension = ".dckpt";
+
+    /**
+     * Use directory (created if missing) with a budget of max_bytes,
+     * evicting down to it right away
+     */
+    bool configure(const std::string& directory, uint64_t max_bytes, std::string* error = nullptr) {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec || !std::filesystem::is_directory(directory, ec)) {
+            if (error) *error = "Cannot create result cache directory: " + directory;
+            return false;
+        }
+        directory_ = directory;
+        max_bytes_ = max_bytes;
+        trim();
+        return true;
+    }
+
+    // Stop using the directory (its entries stay on disk)
+    void disable() { directory_.clear(); }
+
+    bool enabled() const { return !directory_.empty(); }
+    const std::string& directory() const { return directory_; }
+    uint64_t maxBytes() const { return max_bytes_; }
+
+    std::string entryPath(const std::string& key) const {
+        return (std::filesystem::path(directory_) / (key + kExtension)).string();
+    }
+
+    bool contains(const std::string& key) const {
+        std::error_code ec;
+        return enabled() && std::filesystem::is_regular_file(entryPath(key), ec);
+    }
+
+    /**
+     * Restore engine from the entry of key, marking it recently used. A
+     * missing entry is a miss; one the engine rejects is removed (and also
+     * counts as a miss, with the reason in error).
+     */
+    template <typename Engine>
+    bool load(const std::string& key, Engine& engine, std::string* error = nullptr) {
+        if (!contains(key)) {
+            misses_++;
+            return false;
+        }
+        const std::string path = entryPath(key);
+        if (!loadCheckpointFile(engine, path, error)) {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            misses_++;
+            return false;
+        }
+        touch(path);
+        hits_++;
+        return true;
+    }
+
+    /**
+     * Store engine's state under key, then evict down to the budget. A
+     * state larger than the whole budget is not stored.
+     */
+    template <typename Engine>
+    bool store(const std::string& key, const Engine& engine, std::string* error = nullptr) {
+        if (!enabled()) return false;
+        CheckpointWriter writer;
+        engine.saveCheckpoint(writer);
+        if (writer.dataBytes() > max_bytes_) {
+            if (error) *error = "State exceeds the result cache budget";
+            return false;
+        }
+        if (!writer.write(entryPath(key), error)) {
+            return false;
+        }
+        stores_++;
+        trim(key);
+        return true;
+    }
+
+    // Counters since construction, entries and bytes as now on disk
+    ResultCacheStats stats() const {
+        ResultCacheStats stats;
+        stats.hits = hits_;
+        stats.misses = misses_;
+        stats.stores = stores_;
+        stats.evictions = evictions_;
+        stats.max_bytes = max_bytes_;
+        for (const Entry& entry : scan()) {
+            stats.entries++;
+            stats.bytes += entry.bytes;
+        }
+        return stats;
+    }
+
+private:
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type used;
+        uint64_t bytes;
+    };
+
+    std::string directory_;
+    uint64_t max_bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t stores_ = 0;
+    uint64_t evictions_ = 0;
+
+    static void touch(const std::string& path) {
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    }
+
+    std::vector<Entry> scan() const {
+        std::vector<Entry> entries;
+        if (!enabled()) return entries;
+        std::error_code ec;
+        for (std::filesystem::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec) || it->path().extension() != kExtension) continue;
+            Entry entry;
+            entry.path = it->path();
+            entry.used = it->last_write_time(ec);
+            entry.bytes = it->file_size(ec);
+            if (!ec) entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    // Remove least recently used entries until the rest fit (keep_key last)
+    void trim(const std::string& keep_key = std::string()) {
+        std::vector<Entry> entries = scan();
+        const std::string keep = keep_key.empty() ? std::string() : keep_key + kExtension;
+        std::sort(entries.begin(), entries.end(), [&](const Entry& a, const Entry& b) {
+            const bool a_kept = a.path.filename() == keep;
+            const bool b_kept = b.path.filename() == keep;
+            if (a_kept != b_kept) return b_kept;
+            return a.used != b.used ? a.used < b.used : a.path < b.path;
+        });
+        uint64_t total = 0;
+        for (const Entry& entry : entries) total += entry.bytes;
+        for (const Entry& entry : entries) {
+            if (total <= max_bytes_) break;
+            std::error_code ec;
+            if (std::filesystem::remove(entry.path, ec)) {
+                total -= entry.bytes;
+                evictions_++;
+            }
+        }
+    }
+};
+
+} // namespace dase
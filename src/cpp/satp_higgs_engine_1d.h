@@ -12,11 +12,22 @@
 
 #pragma once
 
+#include "adaptive_timestep.h"
+#include "aligned_allocator.h"
+#include "checkpoint_file.h"
+#include "parareal.h"
+#include "phase_profiler.h"
+#include "satp_higgs_diagnostics.h"
+#include "satp_higgs_kernels.h"
+#include "satp_higgs_source.h"
+#include "simd_math.h"
 #include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <complex>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -50,6 +61,75 @@ struct SATPHiggsNode {
     }
 };
 
+// Field selector for bulk node access (getFieldRange / setFieldRange)
+enum class SATPHiggsField { Phi, PhiDot, H, HDot };
+
+inline double SATPHiggsNode::* satpFieldMember(SATPHiggsField field) {
+    switch (field) {
+        case SATPHiggsField::PhiDot: return &SATPHiggsNode::phi_dot;
+        case SATPHiggsField::H:      return &SATPHiggsNode::h;
+        case SATPHiggsField::HDot:   return &SATPHiggsNode::h_dot;
+        default:                     return &SATPHiggsNode::phi;
+    }
+}
+
+// Strided copy of one field of nodes [first, first + count) out of / into a
+// caller buffer; false if the range does not fit. Writes refresh derived values.
+inline bool readSATPField(const std::vector<SATPHiggsNode>& nodes, SATPHiggsField field,
+                          size_t first, size_t count, double* out, size_t stride) {
+    if (!out || stride == 0 || first > nodes.size() || count > nodes.size() - first) return false;
+    double SATPHiggsNode::* member = satpFieldMember(field);
+    for (size_t k = 0; k < count; ++k) {
+        out[k * stride] = nodes[first + k].*member;
+    }
+    return true;
+}
+
+inline bool writeSATPField(std::vector<SATPHiggsNode>& nodes, SATPHiggsField field,
+                           size_t first, size_t count, const double* in, size_t stride) {
+    if (!in || stride == 0 || first > nodes.size() || count > nodes.size() - first) return false;
+    double SATPHiggsNode::* member = satpFieldMember(field);
+    for (size_t k = 0; k < count; ++k) {
+        SATPHiggsNode& node = nodes[first + k];
+        node.*member = in[k * stride];
+        node.updateDerived();
+    }
+    return true;
+}
+
+// Checkpoint sections shared by the 1D/2D/3D engines: dims, the node array as
+// raw records, time and step count. The nodes are copied into the writer so
+// the caller may evolve (or hand the writer to writeAsync) straight away;
+// restore validates every section before touching the engine.
+inline void saveSATPCheckpoint(CheckpointWriter& writer, const char* engine_type,
+                               const std::vector<uint64_t>& dims,
+                               const std::vector<SATPHiggsNode>& nodes,
+                               double current_time, uint64_t step_count) {
+    writer.setEngineType(engine_type);
+    writer.copyArray("dims", dims.data(), dims.size());
+    writer.copyArray("nodes", nodes.data(), nodes.size());
+    writer.addScalar("current_time", current_time);
+    writer.addScalar("step_count", step_count);
+}
+
+inline bool loadSATPCheckpoint(const CheckpointReader& reader, const char* engine_type,
+                               const std::vector<uint64_t>& dims,
+                               std::vector<SATPHiggsNode>& nodes,
+                               double& current_time, uint64_t& step_count, std::string* error) {
+    if (!checkCheckpointShape(reader, engine_type, dims, error)) return false;
+    double time = 0.0;
+    uint64_t steps = 0;
+    if (!reader.array<SATPHiggsNode>("nodes", nodes.size()) ||
+        !reader.scalar("current_time", time) || !reader.scalar("step_count", steps)) {
+        if (error) *error = std::string("Checkpoint is missing ") + engine_type + " sections";
+        return false;
+    }
+    reader.copyTo("nodes", nodes.data(), nodes.size());
+    current_time = time;
+    step_count = steps;
+    return true;
+}
+
 // Physics parameters for SATP+Higgs system
 struct SATPHiggsParams {
     double c;           // Wave speed (default: 1.0)
@@ -66,6 +146,11 @@ struct SATPHiggsParams {
         updateVEV();
     }
 
+    SATPHiggsCoefficients coefficients(double dx) const {
+        return SATPHiggsCoefficients{c * c, 1.0 / (dx * dx), gamma_phi, gamma_h,
+                                     lambda, mu_squared, lambda_h};
+    }
+
     void updateVEV() {
         // h_vev = sqrt(-μ²/2λ_h) for Mexican hat potential
         if (mu_squared < 0.0 && lambda_h > 0.0) {
@@ -74,11 +159,309 @@ struct SATPHiggsParams {
             h_vev = 0.0;
         }
     }
+
+    // Velocity Verlet stability limit of the equations linearized about the
+    // vacuum: dt < 2/ω_max, ω_max² = 4c²·dimension/dx² + largest mass²
+    // (Higgs: -4μ² broken / 2μ² unbroken, φ: 2λ·h_vev²)
+    double stableDt(double dx, int dimension) const {
+        const double higgs_mass_sq = mu_squared < 0.0 ? -4.0 * mu_squared : 2.0 * mu_squared;
+        const double phi_mass_sq = 2.0 * lambda * h_vev * h_vev;
+        const double omega_sq = 4.0 * c * c * dimension / (dx * dx) +
+                                std::max({higgs_mass_sq, phi_mass_sq, 0.0});
+        return 2.0 / std::sqrt(omega_sq);
+    }
+};
+
+// Stepping precision of the CPU kernels
+enum class SATPHiggsPrecision : uint8_t {
+    Double = 0,
+    Float = 1   // float32 planes, converted at the start and end of each evolve()
+};
+
+// Time integrator of the CPU kernels
+enum class SATPHiggsIntegrator : uint8_t {
+    Verlet = 0,    // Velocity Verlet: 2nd order, two acceleration sweeps per step
+    Yoshida4 = 1   // Yoshida (Forest-Ruth) triple jump of Verlet sub-steps: 4th order, six sweeps
+};
+
+// Sub-steps of one step of size dt. Yoshida4 runs Verlet sub-steps of
+// w1·dt, w0·dt, w1·dt with w1 = 1/(2 - 2^(1/3)) and w0 = 1 - 2·w1 (< 0). The
+// odd-order errors of the time-symmetric Verlet step then cancel up to
+// dt⁴. This holds for the conservative terms; with γ > 0 the velocity
+// dependent damping keeps the order of the underlying Verlet step.
+struct SATPHiggsSubsteps {
+    size_t count;
+    double weight[3];   // Fractions of dt, in order
+    double stability;   // Largest stable dt relative to Verlet (harmonic oscillator)
+};
+
+inline SATPHiggsSubsteps satpHiggsSubsteps(SATPHiggsIntegrator integrator) {
+    if (integrator == SATPHiggsIntegrator::Yoshida4) {
+        const double w1 = 1.0 / (2.0 - std::cbrt(2.0));
+        return SATPHiggsSubsteps{3, {w1, 1.0 - 2.0 * w1, w1}, 0.7867};
+    }
+    return SATPHiggsSubsteps{1, {1.0, 0.0, 0.0}, 1.0};
+}
+
+inline const char* satpHiggsIntegratorName(SATPHiggsIntegrator integrator) {
+    return integrator == SATPHiggsIntegrator::Yoshida4 ? "yoshida4" : "verlet";
+}
+
+// Parses "verlet" / "yoshida4"; false (integrator unchanged) otherwise
+inline bool parseSATPHiggsIntegrator(const std::string& name, SATPHiggsIntegrator& integrator) {
+    if (name == "verlet") {
+        integrator = SATPHiggsIntegrator::Verlet;
+    } else if (name == "yoshida4") {
+        integrator = SATPHiggsIntegrator::Yoshida4;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Time-step phases of the SATP+Higgs engines (PhaseProfiler slots)
+enum SATPHiggsStepPhase : size_t {
+    SATP_PHASE_ACCEL = 0,    // accel1D/2D/3D stencil sweeps
+    SATP_PHASE_SOURCE,       // addSource callback
+    SATP_PHASE_UPDATE,       // driftKickAll / kickAll
+    SATP_PHASE_TILED,        // stepTiled3D wavefront steps (3D tiled mode)
+    SATP_PHASE_TRANSFER      // node gather / scatter around evolve()
+};
+
+class SATPHiggsStepProfiler : public PhaseProfiler {
+public:
+    SATPHiggsStepProfiler()
+        : PhaseProfiler({"accel", "source", "update", "tiled_step", "transfer"}) {}
 };
 
+// Velocity Verlet planes of one precision: fields and accelerations at t and t+dt
+template<typename Real>
+struct SATPHiggsPlanes {
+    // Field planes evolved by the stencil kernels (SATPHiggsNode order)
+    AlignedVector<Real> phi;
+    AlignedVector<Real> phi_dot;
+    AlignedVector<Real> h;
+    AlignedVector<Real> h_dot;
+
+    AlignedVector<Real> phi_accel;
+    AlignedVector<Real> h_accel;
+    AlignedVector<Real> phi_accel_new;
+    AlignedVector<Real> h_accel_new;
+
+    // SATPHiggsTilePlanesT storage for the tiled 3D step (kPlanes × plane)
+    AlignedVector<Real> tile;
+
+    // Size all buffers for n sites; returns the number of heap allocations made
+    size_t ensure(size_t n) {
+        if (phi_accel.size() == n) return 0;
+        for (auto* buffer : {&phi, &phi_dot, &h, &h_dot,
+                             &phi_accel, &h_accel, &phi_accel_new, &h_accel_new}) {
+            buffer->assign(n, Real(0));
+        }
+        return 8;
+    }
+
+    // Size the tile planes for an N_x × N_y plane; returns the heap allocations made
+    size_t ensureTile(size_t plane) {
+        if (tile.size() == SATPHiggsTilePlanesT<Real>::kPlanes * plane) return 0;
+        tile.assign(SATPHiggsTilePlanesT<Real>::kPlanes * plane, Real(0));
+        return 1;
+    }
+
+    SATPHiggsTilePlanesT<Real> tilePlanes(size_t plane) {
+        Real* base = tile.data();
+        return SATPHiggsTilePlanesT<Real>{{base, base + plane}, {base + 2 * plane, base + 3 * plane},
+                                          base + 4 * plane, base + 5 * plane,
+                                          base + 6 * plane, base + 7 * plane};
+    }
+
+    SATPHiggsFieldViewT<Real> view() {
+        return SATPHiggsFieldViewT<Real>{phi.data(), phi_dot.data(), h.data(), h_dot.data()};
+    }
+
+    // Gather node fields into the planes
+    void loadFrom(const std::vector<SATPHiggsNode>& nodes) {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            phi[i] = static_cast<Real>(nodes[i].phi);
+            phi_dot[i] = static_cast<Real>(nodes[i].phi_dot);
+            h[i] = static_cast<Real>(nodes[i].h);
+            h_dot[i] = static_cast<Real>(nodes[i].h_dot);
+        }
+    }
+
+    // Scatter the planes back into the nodes and refresh derived quantities
+    // (updateDerived, with Ω = exp(φ) batched through expArray per chunk)
+    void storeTo(std::vector<SATPHiggsNode>& nodes) const {
+        constexpr size_t kChunk = 256;
+        double chunk_phi[kChunk];
+        double chunk_omega[kChunk];
+        for (size_t begin = 0; begin < nodes.size(); begin += kChunk) {
+            const size_t count = std::min(kChunk, nodes.size() - begin);
+            for (size_t j = 0; j < count; ++j) chunk_phi[j] = static_cast<double>(phi[begin + j]);
+            expArray(chunk_phi, chunk_omega, count);
+            for (size_t j = 0; j < count; ++j) {
+                SATPHiggsNode& node = nodes[begin + j];
+                node.phi = chunk_phi[j];
+                node.phi_dot = phi_dot[begin + j];
+                node.h = h[begin + j];
+                node.h_dot = h_dot[begin + j];
+                node.conformal_factor = chunk_omega[j];
+                node.energy_density = 0.5 * (node.phi_dot * node.phi_dot + node.h_dot * node.h_dot);
+            }
+        }
+    }
+};
+
+// Velocity Verlet scratch owned by each engine, sized once and reused by
+// every evolve() call: double planes, float32 planes (sized by the first
+// Float-precision evolve)
+struct SATPHiggsScratch : SATPHiggsPlanes<double> {
+    SATPHiggsPlanes<float> f32;
+
+    // Planes of the given precision
+    template<typename Real>
+    SATPHiggsPlanes<Real>& planes();
+
+    // Bytes ensure(n) (and ensureTile(tile_plane) unless it is 0) allocate
+    // in the double planes, plus the float32 planes if float32
+    static size_t estimateMemoryUsage(size_t n, size_t tile_plane, bool float32) {
+        size_t total = 8 * n * sizeof(double) + SATPHiggsTilePlanesT<double>::kPlanes * tile_plane * sizeof(double);
+        if (float32) {
+            total += 8 * n * sizeof(float) + SATPHiggsTilePlanesT<float>::kPlanes * tile_plane * sizeof(float);
+        }
+        return total;
+    }
+};
+
+template<>
+inline SATPHiggsPlanes<double>& SATPHiggsScratch::planes<double>() { return *this; }
+template<>
+inline SATPHiggsPlanes<float>& SATPHiggsScratch::planes<float>() { return f32; }
+
 // Source function callback type
 using SourceFunction = std::function<double(double t, double x, int index)>;
 
+// runUntil of the SATP+Higgs engines (adaptive_timestep.h): blocks of
+// check_interval Verlet steps through engine.evolve(), kept when the
+// relative energy drift is within tolerance and undone otherwise. The drift
+// discounts the damping loss (trapezoid of damping_power over the block);
+// source work is not discounted. dt, current_time and step_count are the
+// engine's own members.
+template<typename Engine>
+inline AdaptiveRunStats runSATPHiggsUntil(Engine& engine, std::vector<SATPHiggsNode>& nodes,
+                                          double& dt, double& current_time, uint64_t& step_count,
+                                          double dt_cap, double t_end, const AdaptiveStepConfig& adaptive) {
+    const double dt_fixed = dt;
+    const uint64_t block = std::max<uint32_t>(1, adaptive.check_interval);
+    AdaptiveStepController controller(adaptive, dt_fixed, 1, dt_cap);
+    std::vector<SATPHiggsNode> start;
+    SATPHiggsDiagnostics before = engine.computeDiagnostics(SATP_DIAG_ENERGY);
+    while (controller.running(current_time, t_end)) {
+        const double h = controller.proposal(current_time, t_end, block);
+        const double t0 = current_time;
+        const uint64_t steps0 = step_count;
+        start = nodes;
+
+        dt = h;
+        engine.evolve(block);
+        const SATPHiggsDiagnostics after = engine.computeDiagnostics(SATP_DIAG_ENERGY);
+        const double span = h * static_cast<double>(block);
+        const double damped = 0.5 * (before.damping_power + after.damping_power) * span;
+        const double err = std::abs(after.total_energy - before.total_energy + damped) /
+                           std::max(std::abs(before.total_energy), adaptive.energy_floor);
+
+        if (controller.accept(err, h, block)) {
+            before = after;
+            current_time = t0 + span;
+        } else {
+            nodes = start;
+            current_time = t0;
+            step_count = steps0;
+        }
+    }
+    dt = dt_fixed;
+    return controller.stats();
+}
+
+// Parareal state algebra of the SATP+Higgs engines (parareal.h): the four
+// evolved fields of each node are corrected, derived values refreshed
+struct SATPHiggsPararealOps {
+    using State = std::vector<SATPHiggsNode>;
+
+    static void correct(const State& g_new, const State& f_old, const State& g_old, State& out) {
+        out.resize(g_new.size());
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < static_cast<long long>(g_new.size()); i++) {
+            SATPHiggsNode& node = out[i];
+            node.phi = g_new[i].phi + (f_old[i].phi - g_old[i].phi);
+            node.phi_dot = g_new[i].phi_dot + (f_old[i].phi_dot - g_old[i].phi_dot);
+            node.h = g_new[i].h + (f_old[i].h - g_old[i].h);
+            node.h_dot = g_new[i].h_dot + (f_old[i].h_dot - g_old[i].h_dot);
+            node.updateDerived();
+        }
+    }
+
+    static double change(const State& a, const State& b) {
+        double diff = 0.0, scale = 0.0;
+        #pragma omp parallel for schedule(static) reduction(max:diff, scale)
+        for (long long i = 0; i < static_cast<long long>(b.size()); i++) {
+            diff = std::max({diff, std::abs(a[i].phi - b[i].phi), std::abs(a[i].phi_dot - b[i].phi_dot),
+                             std::abs(a[i].h - b[i].h), std::abs(a[i].h_dot - b[i].h_dot)});
+            scale = std::max({scale, std::abs(b[i].phi), std::abs(b[i].phi_dot),
+                              std::abs(b[i].h), std::abs(b[i].h_dot)});
+        }
+        return diff / (1.0 + scale);
+    }
+
+    // Referenced, not copied: the iterate is written before it changes
+    static void save(CheckpointWriter& writer, const std::string& name, const State& state) {
+        writer.addArray(name, state.data(), state.size());
+    }
+    static bool load(const CheckpointReader& reader, const std::string& name, State& state) {
+        return reader.copyTo(name, state.data(), state.size());
+    }
+};
+
+// runParareal of the SATP+Higgs engines. make(time_step, float32) builds a
+// worker with the engine's settings; advance(worker, time, steps) sets the
+// worker clock and evolves it. The coarse stride is lowered until
+// stride·dt is within dt_limit (the integrator's stability limit).
+template<typename Engine, typename Make, typename Advance>
+inline PararealStats runSATPHiggsParareal(const char* engine_type, std::vector<uint64_t> dims,
+                                          std::vector<SATPHiggsNode>& nodes, double dt,
+                                          double& current_time, uint64_t& step_count, double dt_limit,
+                                          uint64_t num_steps, const PararealConfig& config,
+                                          Make make, Advance advance) {
+    if (num_steps == 0) return PararealStats();
+    using State = std::vector<SATPHiggsNode>;
+    const size_t threads = pararealThreads();
+    PararealSchedule schedule;
+    schedule.num_steps = num_steps;
+    schedule.slices = static_cast<size_t>(std::min<uint64_t>(config.slices > 0 ? config.slices : threads, num_steps));
+    const size_t stable = static_cast<size_t>(std::max(1.0, std::floor(dt_limit / dt)));
+    const size_t stride = std::max<size_t>(1, std::min(config.coarse_stride, stable));
+
+    auto step = [dt, advance](Engine& worker, const State& in, uint64_t first, uint64_t steps, State& out,
+                              double start_time, uint64_t) {
+        worker.getNodesMutable() = in;
+        advance(worker, start_time + static_cast<double>(first) * dt, static_cast<size_t>(steps));
+        out = worker.getNodes();
+    };
+    PararealEngines<Engine, State, SATPHiggsPararealOps, decltype(step)> problem(
+        engine_type, std::move(dims), schedule, std::min(threads, schedule.slices), stride,
+        current_time, step_count,
+        [&](double multiple, bool coarse) { return make(multiple * dt, coarse && config.coarse_float); },
+        step);
+
+    State initial = nodes;
+    std::vector<State> u(1, std::move(initial));
+    const PararealStats stats = runParareal(problem, u, config);
+    nodes = std::move(u.back());
+    current_time = problem.startTime() + static_cast<double>(num_steps) * dt;
+    step_count = problem.startStep() + num_steps;
+    return stats;
+}
+
 class SATPHiggsEngine1D {
 private:
     // Lattice configuration
@@ -88,13 +471,15 @@ private:
 
     // Field storage
     std::vector<SATPHiggsNode> nodes;
-    std::vector<SATPHiggsNode> nodes_temp;  // Temporary storage for updates
+    SATPHiggsScratch scratch;               // Verlet accelerations (persistent)
 
     // Physics parameters
     SATPHiggsParams params;
 
     // Source term
     SourceFunction source_phi;  // External source for φ field
+    SATPSourceBatch source_batch;     // Plane-at-a-time source (replaces source_phi when set)
+    mutable std::vector<double> source_plane;  // One plane of S(t) filled by source_batch
     bool has_source;
 
     // Simulation state
@@ -107,16 +492,44 @@ private:
 
     // Diagnostics
     std::atomic<uint64_t> total_updates;
+    uint64_t evolve_allocations;  // Heap allocations made inside evolve()
+    bool vectorized;              // AVX2 interior kernels (scalar loop when false)
+    SATPHiggsPrecision precision;  // CPU kernel precision (Double unless setPrecision)
+    SATPHiggsIntegrator integrator;  // CPU time integrator (Verlet unless setIntegrator)
+    mutable SATPHiggsDiagnosticsPass diagnostics;  // Trig tables of computeDiagnostics()
+    SATPHiggsStepProfiler profiler;  // Per-phase evolve() timing
+
+    // Adds the φ source at time t to an acceleration plane (satp_higgs_physics_*.h)
+    template<typename Real>
+    void addSource(Real* accel, double t) const;
+
+    // CPU Verlet steps in precision Real (satp_higgs_physics_1d.h)
+    template<typename Real>
+    void evolveOn(size_t num_steps, const SATPHiggsCoefficientsT<Real>& k);
+
+    // Parareal worker: same lattice, parameters, source and kernel settings
+    std::unique_ptr<SATPHiggsEngine1D> makeWorker(double time_step, bool float32) const {
+        auto worker = std::make_unique<SATPHiggsEngine1D>(N, dx, time_step, params);
+        worker->source_phi = source_phi;
+        worker->source_batch = source_batch;
+        worker->source_plane = source_plane;
+        worker->has_source = has_source;
+        worker->vectorized = vectorized;
+        worker->precision = float32 ? SATPHiggsPrecision::Float : precision;
+        worker->integrator = integrator;
+        return worker;
+    }
 
 public:
     SATPHiggsEngine1D(size_t num_nodes, double spatial_step, double time_step,
                       const SATPHiggsParams& physics_params)
         : N(num_nodes), dx(spatial_step), dt(time_step),
-          nodes(num_nodes), nodes_temp(num_nodes),
+          nodes(num_nodes),
           params(physics_params), has_source(false),
           current_time(0.0), step_count(0),
-          is_running(false), total_updates(0) {
+          is_running(false), total_updates(0), evolve_allocations(0), vectorized(true), precision(SATPHiggsPrecision::Double), integrator(SATPHiggsIntegrator::Verlet) {
 
+        scratch.ensure(num_nodes);
         params.updateVEV();
 
         // Initialize to Higgs VEV by default
@@ -132,19 +545,61 @@ public:
     double getDt() const { return dt; }
     double getTime() const { return current_time; }
     uint64_t getStepCount() const { return step_count; }
+    uint64_t getTotalUpdates() const { return total_updates.load(std::memory_order_relaxed); }
+    uint64_t getEvolveAllocationCount() const { return evolve_allocations; }
+
+    // Accumulated time per step phase (SATPHiggsStepPhase order); cleared by reset()
+    std::vector<PhaseTiming> getPhaseTimings() const { return profiler.snapshot(); }
+    void resetPhaseTimings() { profiler.reset(); }
     const SATPHiggsParams& getParams() const { return params; }
     const std::vector<SATPHiggsNode>& getNodes() const { return nodes; }
     std::vector<SATPHiggsNode>& getNodesMutable() { return nodes; }
 
+    // Bulk field access for nodes [first, first + count); caller buffers use an
+    // element stride. Returns false if the range does not fit or the buffer is null.
+    bool getFieldRange(SATPHiggsField field, size_t first, size_t count,
+                       double* out, size_t stride = 1) const {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return readSATPField(nodes, field, first, count, out, stride);
+    }
+    bool setFieldRange(SATPHiggsField field, size_t first, size_t count,
+                       const double* in, size_t stride = 1) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return writeSATPField(nodes, field, first, count, in, stride);
+    }
+
+    // Checkpoint/restart (see checkpoint_file.h); loadCheckpoint() requires the
+    // same engine type and dimensions and leaves the engine unchanged on failure.
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        saveSATPCheckpoint(writer, "satp_higgs_1d", {N}, nodes, current_time, step_count);
+    }
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error = nullptr) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return loadSATPCheckpoint(reader, "satp_higgs_1d", {N}, nodes,
+                                  current_time, step_count, error);
+    }
+
     // Source term management
     void setSource(SourceFunction func) {
         source_phi = func;
+        source_batch = nullptr;
         has_source = true;
     }
 
+    // Batched source (satp_higgs_source.h): fills a whole plane of S(t) per
+    // call, added to the φ acceleration in one vectorized loop
+    void setSourceBatch(SATPSourceBatch batch) {
+        source_batch = std::move(batch);
+        source_phi = nullptr;
+        source_plane.assign(N, 0.0);
+        has_source = static_cast<bool>(source_batch);
+    }
+
     void clearSource() {
         has_source = false;
         source_phi = nullptr;
+        source_batch = nullptr;
     }
 
     // State management
@@ -153,6 +608,7 @@ public:
         current_time = 0.0;
         step_count = 0;
         total_updates.store(0);
+        profiler.reset();
         for (auto& node : nodes) {
             node.phi = 0.0;
             node.phi_dot = 0.0;
@@ -165,85 +621,75 @@ public:
     // Physics evolution (implemented in satp_higgs_physics_1d.h)
     void evolve(size_t num_steps);
 
-    // Diagnostics
-    double computeTotalEnergy() const {
-        double total_E = 0.0;
-        for (size_t i = 0; i < N; ++i) {
-            const auto& node = nodes[i];
-
-            // Kinetic energy
-            double E_kin = 0.5 * (node.phi_dot * node.phi_dot + node.h_dot * node.h_dot);
-
-            // Gradient energy (finite difference)
-            size_t i_next = (i + 1) % N;
-            double dphi_dx = (nodes[i_next].phi - node.phi) / dx;
-            double dh_dx = (nodes[i_next].h - node.h) / dx;
-            double E_grad = 0.5 * params.c * params.c * (dphi_dx * dphi_dx + dh_dx * dh_dx);
+    // Advance to t_end with energy-drift step control (runSATPHiggsUntil);
+    // dt is capped at stability_fraction·params.stableDt(dx, 1) times the
+    // integrator's relative stability (SATPHiggsSubsteps). The configured dt
+    // is only the first guess and is left unchanged.
+    AdaptiveRunStats runUntil(double t_end, const AdaptiveStepConfig& adaptive = AdaptiveStepConfig()) {
+        return runSATPHiggsUntil(*this, nodes, dt, current_time, step_count,
+                                 adaptive.stability_fraction * params.stableDt(dx, 1) *
+                                 satpHiggsSubsteps(integrator).stability, t_end, adaptive);
+    }
 
-            // Higgs potential
-            double h_val = node.h;
-            double V_higgs = params.mu_squared * h_val * h_val
-                           + params.lambda_h * h_val * h_val * h_val * h_val;
+    // Parallel-in-time run of num_steps steps (parareal.h) on one worker
+    // engine per thread. Workers copy the parameters, source and kernel
+    // settings, so source callbacks run concurrently on their copies. The
+    // result matches evolve(num_steps) within the tolerance, which is
+    // scaled to max|Δfield| / (1 + max|field|).
+    PararealStats runParareal(uint64_t num_steps, const PararealConfig& config = PararealConfig()) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return runSATPHiggsParareal<SATPHiggsEngine1D>(
+            "satp_higgs_1d", {N}, nodes, dt, current_time, step_count,
+            params.stableDt(dx, 1) * satpHiggsSubsteps(integrator).stability, num_steps, config,
+            [this](double time_step, bool float32) { return makeWorker(time_step, float32); },
+            [](SATPHiggsEngine1D& worker, double time, size_t steps) {
+                worker.current_time = time;
+                worker.evolve(steps);
+            });
+    }
 
-            // Coupling energy
-            double V_coupling = params.lambda * node.phi * node.phi * h_val * h_val;
+    // Kernel selection: vectorized (default) or scalar stencil loop.
+    // Both agree within SATPHiggsKernels::kTolerance.
+    void setVectorized(bool enable) { vectorized = enable; }
+    bool isVectorized() const { return vectorized; }
+
+    // Stepping precision of the CPU kernels. Float evolves float32 copies of
+    // the field planes (converted once per evolve() call); the nodes, energy
+    // and other diagnostics stay double.
+    void setPrecision(SATPHiggsPrecision p) { precision = p; }
+    SATPHiggsPrecision getPrecision() const { return precision; }
+
+    // Time integrator of the CPU kernels. Yoshida4 costs three Verlet
+    // sub-steps per step and is 4th order, so for a given energy accuracy
+    // it allows a much larger dt (stable up to ~0.79× the Verlet limit).
+    void setIntegrator(SATPHiggsIntegrator i) { integrator = i; }
+    SATPHiggsIntegrator getIntegrator() const { return integrator; }
+    bool isFloatPrecisionActive() const { return precision == SATPHiggsPrecision::Float; }
+
+    // Diagnostics: computeDiagnostics() evaluates any subset in one threaded
+    // pass (SATPDiagnosticMask bits, satp_higgs_diagnostics.h); the single
+    // observables below run the same pass
+    SATPHiggsDiagnostics computeDiagnostics(uint32_t mask = SATP_DIAG_ALL) const {
+        return diagnostics.compute(nodes.data(), 1, N, 1, 1, dx, params, mask);
+    }
 
-            total_E += (E_kin + E_grad + V_higgs + V_coupling) * dx;
-        }
-        return total_E;
+    double computeTotalEnergy() const {
+        return computeDiagnostics(SATP_DIAG_ENERGY).total_energy;
     }
 
     double computePhiRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            sum += node.phi * node.phi;
-        }
-        return std::sqrt(sum / static_cast<double>(N));
+        return computeDiagnostics(SATP_DIAG_RMS).phi_rms;
     }
 
     double computeHiggsRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            double h_deviation = node.h - params.h_vev;
-            sum += h_deviation * h_deviation;
-        }
-        return std::sqrt(sum / static_cast<double>(N));
+        return computeDiagnostics(SATP_DIAG_RMS).higgs_rms;
     }
 
     void getCenterOfMass(double& x_cm_phi, double& x_cm_h) const {
-        // Use circular statistics for toroidal topology
-        double sum_phi = 0.0, sum_cos_phi = 0.0, sum_sin_phi = 0.0;
-        double sum_h = 0.0, sum_cos_h = 0.0, sum_sin_h = 0.0;
-
-        for (size_t i = 0; i < N; ++i) {
-            double theta = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(N);
-            double weight_phi = std::abs(nodes[i].phi);
-            double weight_h = std::abs(nodes[i].h - params.h_vev);
-
-            sum_phi += weight_phi;
-            sum_cos_phi += weight_phi * std::cos(theta);
-            sum_sin_phi += weight_phi * std::sin(theta);
-
-            sum_h += weight_h;
-            sum_cos_h += weight_h * std::cos(theta);
-            sum_sin_h += weight_h * std::sin(theta);
-        }
-
-        if (sum_phi > 1e-12) {
-            double mean_theta_phi = std::atan2(sum_sin_phi, sum_cos_phi);
-            x_cm_phi = static_cast<double>(N) * mean_theta_phi / (2.0 * M_PI);
-            if (x_cm_phi < 0.0) x_cm_phi += static_cast<double>(N);
-        } else {
-            x_cm_phi = 0.0;
-        }
-
-        if (sum_h > 1e-12) {
-            double mean_theta_h = std::atan2(sum_sin_h, sum_cos_h);
-            x_cm_h = static_cast<double>(N) * mean_theta_h / (2.0 * M_PI);
-            if (x_cm_h < 0.0) x_cm_h += static_cast<double>(N);
-        } else {
-            x_cm_h = 0.0;
-        }
+        // Circular statistics for toroidal topology
+        const auto d = computeDiagnostics(SATP_DIAG_CENTER_OF_MASS);
+        x_cm_phi = d.x_cm;
+        x_cm_h = d.x_cm_h;
     }
 };
 
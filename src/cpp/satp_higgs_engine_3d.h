@@ -18,6 +18,7 @@
 #include <complex>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -32,6 +33,7 @@ namespace satp_higgs {
 // Forward declarations (structures defined in satp_higgs_engine_1d.h)
 struct SATPHiggsNode;
 struct SATPHiggsParams;
+struct SATPHiggsScratch;
 
 // 3D source function: S(t, x, y, z, ix, iy, iz)
 using SourceFunction3D = std::function<double(double t, double x, double y, double z, int ix, int iy, int iz)>;
@@ -45,13 +47,15 @@ private:
 
     // Field storage (flattened 3D array: index = z * N_x * N_y + y * N_x + x)
     std::vector<SATPHiggsNode> nodes;
-    std::vector<SATPHiggsNode> nodes_temp;
+    SATPHiggsScratch scratch;  // Verlet accelerations (persistent)
 
     // Physics parameters
     SATPHiggsParams params;
 
     // Source term
     SourceFunction3D source_phi;
+    SATPSourceBatch source_batch;     // Plane-at-a-time source (replaces source_phi when set)
+    mutable std::vector<double> source_plane;  // One plane of S(t) filled by source_batch
     bool has_source;
 
     // Simulation state
@@ -64,16 +68,47 @@ private:
 
     // Diagnostics
     std::atomic<uint64_t> total_updates;
+    uint64_t evolve_allocations;  // Heap allocations made inside evolve()
+    bool vectorized;              // AVX2 interior kernels (scalar loop when false)
+    bool tiled;                   // Stream each step by z-plane (SATPHiggsKernels::stepTiled3D)
+    SATPHiggsPrecision precision;  // CPU kernel precision (Double unless setPrecision)
+    SATPHiggsIntegrator integrator;  // CPU time integrator (Verlet unless setIntegrator)
+    mutable SATPHiggsDiagnosticsPass diagnostics;  // Trig tables of computeDiagnostics()
+    SATPHiggsStepProfiler profiler;  // Per-phase evolve() timing
+
+    // Adds the φ source at time t to the acceleration plane of slice z (satp_higgs_physics_3d.h)
+    template<typename Real>
+    void addSource(Real* accel_plane, size_t z, double t) const;
+
+    // CPU Verlet steps in precision Real (satp_higgs_physics_3d.h)
+    template<typename Real>
+    void evolveOn(size_t num_steps, const SATPHiggsCoefficientsT<Real>& k);
+
+    // Parareal worker: same lattice, parameters, source and kernel settings
+    std::unique_ptr<SATPHiggsEngine3D> makeWorker(double time_step, bool float32) const {
+        auto worker = std::make_unique<SATPHiggsEngine3D>(N_x, N_y, N_z, dx, time_step, params);
+        worker->source_phi = source_phi;
+        worker->source_batch = source_batch;
+        worker->source_plane = source_plane;
+        worker->has_source = has_source;
+        worker->vectorized = vectorized;
+        worker->tiled = tiled;
+        worker->precision = float32 ? SATPHiggsPrecision::Float : precision;
+        worker->integrator = integrator;
+        return worker;
+    }
 
 public:
     SATPHiggsEngine3D(size_t nx, size_t ny, size_t nz, double spatial_step, double time_step,
                       const SATPHiggsParams& physics_params)
         : N_x(nx), N_y(ny), N_z(nz), dx(spatial_step), dt(time_step),
-          nodes(nx * ny * nz), nodes_temp(nx * ny * nz),
+          nodes(nx * ny * nz),
           params(physics_params), has_source(false),
           current_time(0.0), step_count(0),
-          is_running(false), total_updates(0) {
+          is_running(false), total_updates(0), evolve_allocations(0), vectorized(true), tiled(true), precision(SATPHiggsPrecision::Double), integrator(SATPHiggsIntegrator::Verlet) {
 
+        scratch.ensure(nx * ny * nz);
+        scratch.ensureTile(nx * ny);
         params.updateVEV();
 
         // Initialize to Higgs VEV by default
@@ -92,10 +127,30 @@ public:
     double getDt() const { return dt; }
     double getTime() const { return current_time; }
     uint64_t getStepCount() const { return step_count; }
+    uint64_t getTotalUpdates() const { return total_updates.load(std::memory_order_relaxed); }
+    uint64_t getEvolveAllocationCount() const { return evolve_allocations; }
+
+    // Accumulated time per step phase (SATPHiggsStepPhase order); cleared by reset()
+    std::vector<PhaseTiming> getPhaseTimings() const { return profiler.snapshot(); }
+    void resetPhaseTimings() { profiler.reset(); }
     const SATPHiggsParams& getParams() const { return params; }
     const std::vector<SATPHiggsNode>& getNodes() const { return nodes; }
     std::vector<SATPHiggsNode>& getNodesMutable() { return nodes; }
 
+    // Bulk field access for nodes [first, first + count) in getIndex order; caller
+    // buffers use an element stride. Returns false if the range does not fit or
+    // the buffer is null.
+    bool getFieldRange(SATPHiggsField field, size_t first, size_t count,
+                       double* out, size_t stride = 1) const {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return readSATPField(nodes, field, first, count, out, stride);
+    }
+    bool setFieldRange(SATPHiggsField field, size_t first, size_t count,
+                       const double* in, size_t stride = 1) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return writeSATPField(nodes, field, first, count, in, stride);
+    }
+
     // Index conversion
     size_t getIndex(size_t x, size_t y, size_t z) const {
         return z * N_x * N_y + y * N_x + x;
@@ -108,15 +163,38 @@ public:
         x = remainder % N_x;
     }
 
+    // Checkpoint/restart (see checkpoint_file.h); loadCheckpoint() requires the
+    // same engine type and dimensions and leaves the engine unchanged on failure.
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        saveSATPCheckpoint(writer, "satp_higgs_3d", {N_x, N_y, N_z}, nodes, current_time, step_count);
+    }
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error = nullptr) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return loadSATPCheckpoint(reader, "satp_higgs_3d", {N_x, N_y, N_z}, nodes,
+                                  current_time, step_count, error);
+    }
+
     // Source term management
     void setSource(SourceFunction3D func) {
         source_phi = func;
+        source_batch = nullptr;
         has_source = true;
     }
 
+    // Batched source (satp_higgs_source.h): fills a whole plane of S(t) per
+    // call, added to the φ acceleration in one vectorized loop
+    void setSourceBatch(SATPSourceBatch batch) {
+        source_batch = std::move(batch);
+        source_phi = nullptr;
+        source_plane.assign(N_x * N_y, 0.0);
+        has_source = static_cast<bool>(source_batch);
+    }
+
     void clearSource() {
         has_source = false;
         source_phi = nullptr;
+        source_batch = nullptr;
     }
 
     // State management
@@ -125,6 +203,7 @@ public:
         current_time = 0.0;
         step_count = 0;
         total_updates.store(0);
+        profiler.reset();
         for (auto& node : nodes) {
             node.phi = 0.0;
             node.phi_dot = 0.0;
@@ -137,117 +216,82 @@ public:
     // Physics evolution (implemented in satp_higgs_physics_3d.h)
     void evolve(size_t num_steps);
 
-    // Diagnostics
+    // Advance to t_end with energy-drift step control (runSATPHiggsUntil);
+    // dt is capped at stability_fraction·params.stableDt(dx, 3) times the
+    // integrator's relative stability (SATPHiggsSubsteps). The configured dt
+    // is only the first guess and is left unchanged.
+    AdaptiveRunStats runUntil(double t_end, const AdaptiveStepConfig& adaptive = AdaptiveStepConfig()) {
+        return runSATPHiggsUntil(*this, nodes, dt, current_time, step_count,
+                                 adaptive.stability_fraction * params.stableDt(dx, 3) *
+                                 satpHiggsSubsteps(integrator).stability, t_end, adaptive);
+    }
+
+    // Parallel-in-time run of num_steps steps (parareal.h) on one worker
+    // engine per thread. Workers copy the parameters, source and kernel
+    // settings, so source callbacks run concurrently on their copies. The
+    // result matches evolve(num_steps) within the tolerance, which is
+    // scaled to max|Δfield| / (1 + max|field|).
+    PararealStats runParareal(uint64_t num_steps, const PararealConfig& config = PararealConfig()) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        return runSATPHiggsParareal<SATPHiggsEngine3D>(
+            "satp_higgs_3d", {N_x, N_y, N_z}, nodes, dt, current_time, step_count,
+            params.stableDt(dx, 3) * satpHiggsSubsteps(integrator).stability, num_steps, config,
+            [this](double time_step, bool float32) { return makeWorker(time_step, float32); },
+            [](SATPHiggsEngine3D& worker, double time, size_t steps) {
+                worker.current_time = time;
+                worker.evolve(steps);
+            });
+    }
+
+    // Kernel selection: vectorized (default) or scalar stencil loop.
+    // Both agree within SATPHiggsKernels::kTolerance.
+    void setVectorized(bool enable) { vectorized = enable; }
+    bool isVectorized() const { return vectorized; }
+
+    // Stepping precision of the CPU kernels. Float evolves float32 copies of
+    // the field planes (converted once per evolve() call); the nodes, energy
+    // and other diagnostics stay double.
+    void setPrecision(SATPHiggsPrecision p) { precision = p; }
+    SATPHiggsPrecision getPrecision() const { return precision; }
+
+    // Time integrator of the CPU kernels. Yoshida4 costs three Verlet
+    // sub-steps per step and is 4th order, so for a given energy accuracy
+    // it allows a much larger dt (stable up to ~0.79× the Verlet limit).
+    void setIntegrator(SATPHiggsIntegrator i) { integrator = i; }
+    SATPHiggsIntegrator getIntegrator() const { return integrator; }
+    bool isFloatPrecisionActive() const { return precision == SATPHiggsPrecision::Float; }
+
+    // Execution order: z-plane wavefront (default) or four full-lattice sweeps
+    // per step. Both agree within SATPHiggsKernels::kTolerance; lattices with
+    // N_z < 3 always sweep.
+    void setTiled(bool enable) { tiled = enable; }
+    bool isTiled() const { return tiled; }
+
+    // Diagnostics: computeDiagnostics() evaluates any subset in one threaded
+    // pass (SATPDiagnosticMask bits, satp_higgs_diagnostics.h); the single
+    // observables below run the same pass
+    SATPHiggsDiagnostics computeDiagnostics(uint32_t mask = SATP_DIAG_ALL) const {
+        return diagnostics.compute(nodes.data(), 3, N_x, N_y, N_z, dx, params, mask);
+    }
+
     double computeTotalEnergy() const {
-        double total_E = 0.0;
-        const double dx_cube = dx * dx * dx;  // Volume element
-
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-                    const auto& node = nodes[idx];
-
-                    // Kinetic energy
-                    double E_kin = 0.5 * (node.phi_dot * node.phi_dot + node.h_dot * node.h_dot);
-
-                    // Gradient energy (3D finite difference)
-                    size_t x_next = (x + 1) % N_x;
-                    size_t y_next = (y + 1) % N_y;
-                    size_t z_next = (z + 1) % N_z;
-                    size_t idx_xnext = getIndex(x_next, y, z);
-                    size_t idx_ynext = getIndex(x, y_next, z);
-                    size_t idx_znext = getIndex(x, y, z_next);
-
-                    double dphi_dx = (nodes[idx_xnext].phi - node.phi) / dx;
-                    double dphi_dy = (nodes[idx_ynext].phi - node.phi) / dx;
-                    double dphi_dz = (nodes[idx_znext].phi - node.phi) / dx;
-                    double dh_dx = (nodes[idx_xnext].h - node.h) / dx;
-                    double dh_dy = (nodes[idx_ynext].h - node.h) / dx;
-                    double dh_dz = (nodes[idx_znext].h - node.h) / dx;
-
-                    double E_grad = 0.5 * params.c * params.c * (
-                        dphi_dx * dphi_dx + dphi_dy * dphi_dy + dphi_dz * dphi_dz +
-                        dh_dx * dh_dx + dh_dy * dh_dy + dh_dz * dh_dz
-                    );
-
-                    // Higgs potential
-                    double h_val = node.h;
-                    double V_higgs = params.mu_squared * h_val * h_val
-                                   + params.lambda_h * h_val * h_val * h_val * h_val;
-
-                    // Coupling energy
-                    double V_coupling = params.lambda * node.phi * node.phi * h_val * h_val;
-
-                    total_E += (E_kin + E_grad + V_higgs + V_coupling) * dx_cube;
-                }
-            }
-        }
-        return total_E;
+        return computeDiagnostics(SATP_DIAG_ENERGY).total_energy;
     }
 
     double computePhiRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            sum += node.phi * node.phi;
-        }
-        return std::sqrt(sum / static_cast<double>(nodes.size()));
+        return computeDiagnostics(SATP_DIAG_RMS).phi_rms;
     }
 
     double computeHiggsRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            double h_deviation = node.h - params.h_vev;
-            sum += h_deviation * h_deviation;
-        }
-        return std::sqrt(sum / static_cast<double>(nodes.size()));
+        return computeDiagnostics(SATP_DIAG_RMS).higgs_rms;
     }
 
     void getCenterOfMass(double& x_cm, double& y_cm, double& z_cm) const {
-        // Use circular statistics for toroidal topology
-        double sum_phi = 0.0;
-        double sum_cos_x = 0.0, sum_sin_x = 0.0;
-        double sum_cos_y = 0.0, sum_sin_y = 0.0;
-        double sum_cos_z = 0.0, sum_sin_z = 0.0;
-
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-                    double weight = std::abs(nodes[idx].phi);
-
-                    double theta_x = 2.0 * M_PI * static_cast<double>(x) / static_cast<double>(N_x);
-                    double theta_y = 2.0 * M_PI * static_cast<double>(y) / static_cast<double>(N_y);
-                    double theta_z = 2.0 * M_PI * static_cast<double>(z) / static_cast<double>(N_z);
-
-                    sum_phi += weight;
-                    sum_cos_x += weight * std::cos(theta_x);
-                    sum_sin_x += weight * std::sin(theta_x);
-                    sum_cos_y += weight * std::cos(theta_y);
-                    sum_sin_y += weight * std::sin(theta_y);
-                    sum_cos_z += weight * std::cos(theta_z);
-                    sum_sin_z += weight * std::sin(theta_z);
-                }
-            }
-        }
-
-        if (sum_phi > 1e-12) {
-            double mean_theta_x = std::atan2(sum_sin_x, sum_cos_x);
-            double mean_theta_y = std::atan2(sum_sin_y, sum_cos_y);
-            double mean_theta_z = std::atan2(sum_sin_z, sum_cos_z);
-
-            x_cm = static_cast<double>(N_x) * mean_theta_x / (2.0 * M_PI);
-            y_cm = static_cast<double>(N_y) * mean_theta_y / (2.0 * M_PI);
-            z_cm = static_cast<double>(N_z) * mean_theta_z / (2.0 * M_PI);
-
-            if (x_cm < 0.0) x_cm += static_cast<double>(N_x);
-            if (y_cm < 0.0) y_cm += static_cast<double>(N_y);
-            if (z_cm < 0.0) z_cm += static_cast<double>(N_z);
-        } else {
-            x_cm = 0.0;
-            y_cm = 0.0;
-            z_cm = 0.0;
-        }
+        // Circular statistics for toroidal topology
+        const auto d = computeDiagnostics(SATP_DIAG_CENTER_OF_MASS);
+        x_cm = d.x_cm;
+        y_cm = d.y_cm;
+        z_cm = d.z_cm;
     }
 };
 
@@ -0,0 +1,567 @@
+/**
+ * SATP+Higgs Stencil Kernels - Threaded, Vectorized Velocity Verlet
+ *
+ * Kernels operate on separate field planes (phi, phi_dot, h, h_dot) rather
+ * than the SATPHiggsNode array, so each neighbor access is a contiguous load.
+ *
+ * Row decomposition:
+ * - Rows are distributed over OpenMP threads (y for 2D, (z, y) for 3D,
+ *   fixed-size chunks for 1D).
+ * - Wraparound in y/z is resolved once per row by choosing the neighbor row
+ *   pointers; inside a row only x = 0 and x = N_x - 1 wrap.
+ * - Interior columns run without branches or modulo, 4 doubles (8 floats)
+ *   per AVX2 register when the CPU has AVX2 + FMA (activeSimdLevel(), see
+ *   cpu_dispatch.h; scalar loop otherwise). The AVX2 kernels carry their
+ *   own target attribute, so a portable build still contains them.
+ *
+ * The kernels are templated on the field precision: SATPHiggsKernels is the
+ * double instantiation, SATPHiggsKernelsF32 runs the engines' float32 mode
+ * (planes converted once per evolve() call).
+ *
+ * Arithmetic follows the scalar engines term by term, except that the
+ * Laplacian multiplies by 1/dx² instead of dividing and AVX2 builds use
+ * fused multiply-add. Vectorized and scalar trajectories agree to
+ * kTolerance (relative, per field value) over the test horizons.
+ *
+ * stepTiled3D streams one whole Verlet step through the lattice a z-plane at
+ * a time (see its comment); it evaluates the same site updates as accel3D /
+ * driftKickAll / kickAll, so the two orders differ only by compiler
+ * contraction round-off (well inside kTolerance).
+ */
+
+#pragma once
+
+#include "cpu_dispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace dase {
+namespace satp_higgs {
+
+// Equation coefficients shared by every site
+template<typename Real>
+struct SATPHiggsCoefficientsT {
+    Real c_sq;
+    Real inv_dx_sq;
+    Real gamma_phi;
+    Real gamma_h;
+    Real lambda;
+    Real mu_sq;
+    Real lambda_h;
+
+    // Coefficients rounded to another precision
+    template<typename Other>
+    SATPHiggsCoefficientsT<Other> as() const {
+        return SATPHiggsCoefficientsT<Other>{
+            static_cast<Other>(c_sq), static_cast<Other>(inv_dx_sq),
+            static_cast<Other>(gamma_phi), static_cast<Other>(gamma_h),
+            static_cast<Other>(lambda), static_cast<Other>(mu_sq), static_cast<Other>(lambda_h)};
+    }
+};
+
+// Field planes of one lattice state (index = z * N_x * N_y + y * N_x + x)
+template<typename Real>
+struct SATPHiggsFieldViewT {
+    Real* phi;
+    Real* phi_dot;
+    Real* h;
+    Real* h_dot;
+};
+
+// Plane-sized work buffers for stepTiled3D (each N_x * N_y values)
+template<typename Real>
+struct SATPHiggsTilePlanesT {
+    Real* a_phi[2];   // a(t), ring of two planes
+    Real* a_h[2];
+    Real* b_phi;      // a(t+dt) of the plane being kicked
+    Real* b_h;
+    Real* edge_phi;   // Plane 0 at t (z+1 neighbor of the last plane)
+    Real* edge_h;
+
+    static constexpr size_t kPlanes = 8;
+};
+
+using SATPHiggsCoefficients = SATPHiggsCoefficientsT<double>;
+using SATPHiggsFieldView = SATPHiggsFieldViewT<double>;
+using SATPHiggsTilePlanes = SATPHiggsTilePlanesT<double>;
+
+template<typename Real>
+class SATPHiggsKernelsT {
+    using SATPHiggsCoefficients = SATPHiggsCoefficientsT<Real>;
+    using SATPHiggsFieldView = SATPHiggsFieldViewT<Real>;
+    using SATPHiggsTilePlanes = SATPHiggsTilePlanesT<Real>;
+
+public:
+    // Documented agreement between the vectorized and scalar paths
+    static constexpr double kTolerance = std::is_same<Real, float>::value ? 1e-4 : 1e-10;
+
+    // True if the vectorized path runs the AVX2 kernels on this CPU
+    static bool hasAVX2() {
+#if DASE_SIMD_HAS_AVX2
+        return simdAtLeast(SimdLevel::AVX2);
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Accelerations of one row segment [x_begin, x_end)
+     *
+     * @param cross_phi / cross_h Neighbor rows in y/z (CrossRows pointers)
+     * @param center_weight 2 × dimension (coefficient of f_i in the Laplacian)
+     */
+    template<int CrossRows>
+    static inline void accelRow(const Real* phi, const Real* h,
+                                const Real* phi_dot, const Real* h_dot,
+                                const Real* const* cross_phi, const Real* const* cross_h,
+                                Real* phi_acc, Real* h_acc,
+                                size_t N_x, size_t x_begin, size_t x_end,
+                                Real center_weight, const SATPHiggsCoefficients& k,
+                                bool vectorize) {
+        size_t x = x_begin;
+
+        // x = 0 wraps to N_x - 1
+        if (x == 0 && x < x_end) {
+            site<CrossRows>(phi, h, phi_dot, h_dot, cross_phi, cross_h, phi_acc, h_acc,
+                            0, N_x - 1, (N_x > 1) ? 1 : 0, center_weight, k);
+            x = 1;
+        }
+
+        // Interior: x - 1 and x + 1 both inside the row
+        const size_t interior_end = (x_end < N_x) ? x_end : N_x - 1;
+#if DASE_SIMD_HAS_AVX2
+        if (vectorize && hasAVX2()) {
+            x = accelInteriorAVX2<CrossRows>(phi, h, phi_dot, h_dot, cross_phi, cross_h,
+                                             phi_acc, h_acc, x, interior_end, center_weight, k);
+        }
+#else
+        (void)vectorize;
+#endif
+        for (; x < interior_end; ++x) {
+            site<CrossRows>(phi, h, phi_dot, h_dot, cross_phi, cross_h, phi_acc, h_acc,
+                            x, x - 1, x + 1, center_weight, k);
+        }
+
+        // x = N_x - 1 wraps to 0
+        if (x < x_end && x == N_x - 1) {
+            site<CrossRows>(phi, h, phi_dot, h_dot, cross_phi, cross_h, phi_acc, h_acc,
+                            x, x - 1, 0, center_weight, k);
+        }
+    }
+
+    /**
+     * a(t) for a 1D ring of N sites
+     */
+    static void accel1D(const SATPHiggsFieldView& f, Real* phi_acc, Real* h_acc,
+                        size_t N, const SATPHiggsCoefficients& k, bool vectorize) {
+        const long long num_chunks = static_cast<long long>((N + kChunk - 1) / kChunk);
+
+        #pragma omp parallel for schedule(static) if(N >= kParallelThreshold)
+        for (long long c = 0; c < num_chunks; ++c) {
+            const size_t begin = static_cast<size_t>(c) * kChunk;
+            const size_t end = (begin + kChunk < N) ? begin + kChunk : N;
+            accelRow<0>(f.phi, f.h, f.phi_dot, f.h_dot, nullptr, nullptr,
+                        phi_acc, h_acc, N, begin, end, Real(2), k, vectorize);
+        }
+    }
+
+    /**
+     * a(t) for an N_x × N_y torus
+     */
+    static void accel2D(const SATPHiggsFieldView& f, Real* phi_acc, Real* h_acc,
+                        size_t N_x, size_t N_y, const SATPHiggsCoefficients& k, bool vectorize) {
+        const long long rows = static_cast<long long>(N_y);
+
+        #pragma omp parallel for schedule(static) if(N_x * N_y >= kParallelThreshold)
+        for (long long row = 0; row < rows; ++row) {
+            const size_t y = static_cast<size_t>(row);
+            const size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+            const size_t y_next = (y + 1 == N_y) ? 0 : y + 1;
+            const size_t base = y * N_x;
+
+            const Real* cross_phi[2] = {f.phi + y_prev * N_x, f.phi + y_next * N_x};
+            const Real* cross_h[2] = {f.h + y_prev * N_x, f.h + y_next * N_x};
+            accelRow<2>(f.phi + base, f.h + base, f.phi_dot + base, f.h_dot + base,
+                        cross_phi, cross_h, phi_acc + base, h_acc + base,
+                        N_x, 0, N_x, Real(4), k, vectorize);
+        }
+    }
+
+    /**
+     * a(t) for an N_x × N_y × N_z torus
+     */
+    static void accel3D(const SATPHiggsFieldView& f, Real* phi_acc, Real* h_acc,
+                        size_t N_x, size_t N_y, size_t N_z,
+                        const SATPHiggsCoefficients& k, bool vectorize) {
+        const size_t plane = N_x * N_y;
+        const long long rows = static_cast<long long>(N_y * N_z);
+
+        #pragma omp parallel for schedule(static) if(plane * N_z >= kParallelThreshold)
+        for (long long row = 0; row < rows; ++row) {
+            const size_t y = static_cast<size_t>(row) % N_y;
+            const size_t z = static_cast<size_t>(row) / N_y;
+            accelRow3D(f, phi_acc, h_acc, N_x, N_y, N_z, y, z, k, vectorize);
+        }
+    }
+
+    /**
+     * a(t) for one (y, z) row of a 3D torus
+     */
+    static inline void accelRow3D(const SATPHiggsFieldView& f, Real* phi_acc, Real* h_acc,
+                                  size_t N_x, size_t N_y, size_t N_z, size_t y, size_t z,
+                                  const SATPHiggsCoefficients& k, bool vectorize) {
+        const size_t plane = N_x * N_y;
+        const size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+        const size_t y_next = (y + 1 == N_y) ? 0 : y + 1;
+        const size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
+        const size_t z_next = (z + 1 == N_z) ? 0 : z + 1;
+        const size_t base = z * plane + y * N_x;
+
+        // Order matches the scalar Laplacian: y_prev, y_next, z_prev, z_next
+        const size_t cross[4] = {
+            z * plane + y_prev * N_x, z * plane + y_next * N_x,
+            z_prev * plane + y * N_x, z_next * plane + y * N_x
+        };
+        const Real* cross_phi[4] = {f.phi + cross[0], f.phi + cross[1], f.phi + cross[2], f.phi + cross[3]};
+        const Real* cross_h[4] = {f.h + cross[0], f.h + cross[1], f.h + cross[2], f.h + cross[3]};
+        accelRow<4>(f.phi + base, f.h + base, f.phi_dot + base, f.h_dot + base,
+                    cross_phi, cross_h, phi_acc + base, h_acc + base,
+                    N_x, 0, N_x, Real(6), k, vectorize);
+    }
+
+    /**
+     * Verlet drift + first half kick over [begin, end):
+     * x += v dt + ½ a dt²,  v += ½ a dt
+     */
+    static inline void driftKick(const SATPHiggsFieldView& f, const Real* phi_acc, const Real* h_acc,
+                                 size_t begin, size_t end, Real dt) {
+        const Real half_dt = Real(0.5) * dt;
+        const Real half_dt_sq = Real(0.5) * dt * dt;
+
+        #pragma omp simd
+        for (size_t i = begin; i < end; ++i) {
+            f.phi[i] = f.phi[i] + f.phi_dot[i] * dt + phi_acc[i] * half_dt_sq;
+            f.h[i] = f.h[i] + f.h_dot[i] * dt + h_acc[i] * half_dt_sq;
+            f.phi_dot[i] = f.phi_dot[i] + phi_acc[i] * half_dt;
+            f.h_dot[i] = f.h_dot[i] + h_acc[i] * half_dt;
+        }
+    }
+
+    /**
+     * Verlet second half kick over [begin, end): v += ½ a(t+dt) dt
+     */
+    static inline void kick(const SATPHiggsFieldView& f, const Real* phi_acc, const Real* h_acc,
+                            size_t begin, size_t end, Real dt) {
+        const Real half_dt = Real(0.5) * dt;
+
+        #pragma omp simd
+        for (size_t i = begin; i < end; ++i) {
+            f.phi_dot[i] = f.phi_dot[i] + phi_acc[i] * half_dt;
+            f.h_dot[i] = f.h_dot[i] + h_acc[i] * half_dt;
+        }
+    }
+
+    static void driftKickAll(const SATPHiggsFieldView& f, const Real* phi_acc, const Real* h_acc,
+                             size_t N, Real dt) {
+        const long long num_chunks = static_cast<long long>((N + kChunk - 1) / kChunk);
+
+        #pragma omp parallel for schedule(static) if(N >= kParallelThreshold)
+        for (long long c = 0; c < num_chunks; ++c) {
+            const size_t begin = static_cast<size_t>(c) * kChunk;
+            driftKick(f, phi_acc, h_acc, begin, (begin + kChunk < N) ? begin + kChunk : N, dt);
+        }
+    }
+
+    static void kickAll(const SATPHiggsFieldView& f, const Real* phi_acc, const Real* h_acc,
+                        size_t N, Real dt) {
+        const long long num_chunks = static_cast<long long>((N + kChunk - 1) / kChunk);
+
+        #pragma omp parallel for schedule(static) if(N >= kParallelThreshold)
+        for (long long c = 0; c < num_chunks; ++c) {
+            const size_t begin = static_cast<size_t>(c) * kChunk;
+            kick(f, phi_acc, h_acc, begin, (begin + kChunk < N) ? begin + kChunk : N, dt);
+        }
+    }
+
+    /**
+     * One velocity Verlet step on an N_x × N_y × N_z torus, streamed by z-plane
+     *
+     * The sweep form makes four passes over the whole lattice per step
+     * (a(t), drift, a(t+dt), kick), two of them through full-size
+     * acceleration arrays. Here the passes run as a wavefront over z:
+     *
+     *   plane z:  a(t) at z  ->  drift z-1  ->  a(t+dt) and kick at z-2
+     *
+     * so the planes a site update touches are still in cache when the next
+     * stage needs them, and accelerations only ever occupy a few planes.
+     * Plane 0 at t is copied first because the last plane's z+1 neighbor is
+     * read after plane 0 has drifted; a(t+dt) of plane 0 is evaluated last,
+     * once plane N_z-1 has drifted. Requires N_z >= 3.
+     *
+     * @param source Called as source(accel_plane, z, time) to add S(t) to the
+     *               φ acceleration of plane z (serial; only when has_source)
+     */
+    template<typename PlaneSource>
+    static void stepTiled3D(const SATPHiggsFieldView& f, const SATPHiggsTilePlanes& w,
+                            size_t N_x, size_t N_y, size_t N_z,
+                            const SATPHiggsCoefficients& k, double t, Real dt,
+                            bool vectorize, bool has_source, PlaneSource&& source) {
+        const size_t plane = N_x * N_y;
+
+        #pragma omp parallel if(plane * N_z >= kParallelThreshold)
+        {
+            #pragma omp for schedule(static)
+            for (long long i = 0; i < static_cast<long long>(plane); ++i) {
+                w.edge_phi[i] = f.phi[i];
+                w.edge_h[i] = f.h[i];
+            }
+
+            for (size_t z = 0; z < N_z; ++z) {
+                // a(t) at z: planes z-1 and z+1 have not drifted yet
+                const size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
+                const bool last = (z + 1 == N_z);
+                accelPlane3D(f, f.phi + z_prev * plane, f.h + z_prev * plane,
+                             last ? w.edge_phi : f.phi + (z + 1) * plane,
+                             last ? w.edge_h : f.h + (z + 1) * plane,
+                             z, w.a_phi[z & 1], w.a_h[z & 1], N_x, N_y, k, vectorize);
+                if (has_source) {
+                    #pragma omp single
+                    source(w.a_phi[z & 1], z, t);
+                }
+
+                // Drift z-1: its last reader at time t was a(t) at z
+                if (z >= 1) {
+                    driftKickPlane(f, z - 1, w.a_phi[(z - 1) & 1], w.a_h[(z - 1) & 1], N_x, N_y, dt);
+                }
+
+                // a(t+dt) at z-2: planes z-3 .. z-1 have drifted (plane 0 waits for N_z-1)
+                if (z >= 3) {
+                    kickPlaneAt(f, w, z - 2, N_x, N_y, N_z, k, t + dt, dt, vectorize, has_source, source);
+                }
+            }
+
+            driftKickPlane(f, N_z - 1, w.a_phi[(N_z - 1) & 1], w.a_h[(N_z - 1) & 1], N_x, N_y, dt);
+            kickPlaneAt(f, w, N_z - 2, N_x, N_y, N_z, k, t + dt, dt, vectorize, has_source, source);
+            kickPlaneAt(f, w, N_z - 1, N_x, N_y, N_z, k, t + dt, dt, vectorize, has_source, source);
+            kickPlaneAt(f, w, 0, N_x, N_y, N_z, k, t + dt, dt, vectorize, has_source, source);
+        }
+    }
+
+private:
+    static constexpr size_t kChunk = 4096;               // 1D / elementwise work unit
+    static constexpr size_t kParallelThreshold = 16384;  // Sites below which threads cost more
+
+    /**
+     * Scalar site update (same term order as the scalar engines)
+     */
+    template<int CrossRows>
+    static inline void site(const Real* phi, const Real* h,
+                            const Real* phi_dot, const Real* h_dot,
+                            const Real* const* cross_phi, const Real* const* cross_h,
+                            Real* phi_acc, Real* h_acc,
+                            size_t x, size_t x_prev, size_t x_next,
+                            Real center_weight, const SATPHiggsCoefficients& k) {
+        Real sum_phi = phi[x_prev] + phi[x_next];
+        Real sum_h = h[x_prev] + h[x_next];
+        for (int r = 0; r < CrossRows; ++r) {
+            sum_phi += cross_phi[r][x];
+            sum_h += cross_h[r][x];
+        }
+
+        const Real p = phi[x];
+        const Real q = h[x];
+        const Real laplacian_phi = (sum_phi - center_weight * p) * k.inv_dx_sq;
+        const Real laplacian_h = (sum_h - center_weight * q) * k.inv_dx_sq;
+
+        phi_acc[x] = k.c_sq * laplacian_phi
+                   - k.gamma_phi * phi_dot[x]
+                   - Real(2) * k.lambda * p * q * q;
+
+        h_acc[x] = k.c_sq * laplacian_h
+                 - k.gamma_h * h_dot[x]
+                 - Real(2) * k.mu_sq * q
+                 - Real(4) * k.lambda_h * q * q * q
+                 - Real(2) * k.lambda * p * p * q;
+    }
+
+    /**
+     * Accelerations of plane z into plane-sized buffers, with explicit z±1 planes
+     *
+     * Work-shares rows over the enclosing parallel region (runs serially outside one).
+     */
+    static void accelPlane3D(const SATPHiggsFieldView& f,
+                             const Real* prev_phi, const Real* prev_h,
+                             const Real* next_phi, const Real* next_h, size_t z,
+                             Real* phi_acc, Real* h_acc, size_t N_x, size_t N_y,
+                             const SATPHiggsCoefficients& k, bool vectorize) {
+        const size_t base_z = z * N_x * N_y;
+
+        #pragma omp for schedule(static)
+        for (long long row = 0; row < static_cast<long long>(N_y); ++row) {
+            const size_t y = static_cast<size_t>(row);
+            const size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+            const size_t y_next = (y + 1 == N_y) ? 0 : y + 1;
+            const size_t base = base_z + y * N_x;
+
+            // Same neighbor order as accelRow3D
+            const Real* cross_phi[4] = {f.phi + base_z + y_prev * N_x, f.phi + base_z + y_next * N_x,
+                                          prev_phi + y * N_x, next_phi + y * N_x};
+            const Real* cross_h[4] = {f.h + base_z + y_prev * N_x, f.h + base_z + y_next * N_x,
+                                        prev_h + y * N_x, next_h + y * N_x};
+            accelRow<4>(f.phi + base, f.h + base, f.phi_dot + base, f.h_dot + base,
+                        cross_phi, cross_h, phi_acc + y * N_x, h_acc + y * N_x,
+                        N_x, 0, N_x, Real(6), k, vectorize);
+        }
+    }
+
+    static void driftKickPlane(const SATPHiggsFieldView& f, size_t z,
+                               const Real* phi_acc, const Real* h_acc,
+                               size_t N_x, size_t N_y, Real dt) {
+        const size_t base_z = z * N_x * N_y;
+        const SATPHiggsFieldView fz{f.phi + base_z, f.phi_dot + base_z, f.h + base_z, f.h_dot + base_z};
+
+        #pragma omp for schedule(static)
+        for (long long row = 0; row < static_cast<long long>(N_y); ++row) {
+            const size_t begin = static_cast<size_t>(row) * N_x;
+            driftKick(fz, phi_acc, h_acc, begin, begin + N_x, dt);
+        }
+    }
+
+    /**
+     * a(t+dt) of plane z (all three planes drifted) followed by its second half kick
+     */
+    template<typename PlaneSource>
+    static void kickPlaneAt(const SATPHiggsFieldView& f, const SATPHiggsTilePlanes& w, size_t z,
+                            size_t N_x, size_t N_y, size_t N_z,
+                            const SATPHiggsCoefficients& k, double t, Real dt,
+                            bool vectorize, bool has_source, PlaneSource& source) {
+        const size_t plane = N_x * N_y;
+        const size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
+        const size_t z_next = (z + 1 == N_z) ? 0 : z + 1;
+        accelPlane3D(f, f.phi + z_prev * plane, f.h + z_prev * plane,
+                     f.phi + z_next * plane, f.h + z_next * plane,
+                     z, w.b_phi, w.b_h, N_x, N_y, k, vectorize);
+        if (has_source) {
+            #pragma omp single
+            source(w.b_phi, z, t);
+        }
+
+        const SATPHiggsFieldView fz{f.phi + z * plane, f.phi_dot + z * plane,
+                                    f.h + z * plane, f.h_dot + z * plane};
+
+        #pragma omp for schedule(static)
+        for (long long row = 0; row < static_cast<long long>(N_y); ++row) {
+            const size_t begin = static_cast<size_t>(row) * N_x;
+            kick(fz, w.b_phi, w.b_h, begin, begin + N_x, dt);
+        }
+    }
+
+#if DASE_SIMD_HAS_AVX2
+    /**
+     * Interior columns [x, x_end), 4 sites per iteration; returns first unprocessed x
+     */
+    template<int CrossRows>
+    DASE_TARGET_AVX2 static size_t accelInteriorAVX2(const double* phi, const double* h,
+                                                     const double* phi_dot, const double* h_dot,
+                                                     const double* const* cross_phi, const double* const* cross_h,
+                                                     double* phi_acc, double* h_acc,
+                                                     size_t x, size_t x_end,
+                                                     double center_weight, const SATPHiggsCoefficientsT<double>& k) {
+        const __m256d v_center = _mm256_set1_pd(center_weight);
+        const __m256d v_inv_dx_sq = _mm256_set1_pd(k.inv_dx_sq);
+        const __m256d v_c_sq = _mm256_set1_pd(k.c_sq);
+        const __m256d v_gamma_phi = _mm256_set1_pd(k.gamma_phi);
+        const __m256d v_gamma_h = _mm256_set1_pd(k.gamma_h);
+        const __m256d v_two_lambda = _mm256_set1_pd(2.0 * k.lambda);
+        const __m256d v_two_mu_sq = _mm256_set1_pd(2.0 * k.mu_sq);
+        const __m256d v_four_lambda_h = _mm256_set1_pd(4.0 * k.lambda_h);
+
+        for (; x + 4 <= x_end; x += 4) {
+            __m256d sum_phi = _mm256_add_pd(_mm256_loadu_pd(phi + x - 1), _mm256_loadu_pd(phi + x + 1));
+            __m256d sum_h = _mm256_add_pd(_mm256_loadu_pd(h + x - 1), _mm256_loadu_pd(h + x + 1));
+            for (int r = 0; r < CrossRows; ++r) {
+                sum_phi = _mm256_add_pd(sum_phi, _mm256_loadu_pd(cross_phi[r] + x));
+                sum_h = _mm256_add_pd(sum_h, _mm256_loadu_pd(cross_h[r] + x));
+            }
+
+            const __m256d p = _mm256_loadu_pd(phi + x);
+            const __m256d q = _mm256_loadu_pd(h + x);
+            const __m256d lap_phi = _mm256_mul_pd(_mm256_fnmadd_pd(v_center, p, sum_phi), v_inv_dx_sq);
+            const __m256d lap_h = _mm256_mul_pd(_mm256_fnmadd_pd(v_center, q, sum_h), v_inv_dx_sq);
+            const __m256d q_sq = _mm256_mul_pd(q, q);
+
+            // φ: c²∇²φ - γ_φ φ̇ - 2λ φ h²
+            __m256d a_phi = _mm256_mul_pd(v_c_sq, lap_phi);
+            a_phi = _mm256_fnmadd_pd(v_gamma_phi, _mm256_loadu_pd(phi_dot + x), a_phi);
+            a_phi = _mm256_fnmadd_pd(_mm256_mul_pd(v_two_lambda, p), q_sq, a_phi);
+            _mm256_storeu_pd(phi_acc + x, a_phi);
+
+            // h: c²∇²h - γ_h ḣ - 2μ² h - 4λ_h h³ - 2λ φ² h
+            __m256d a_h = _mm256_mul_pd(v_c_sq, lap_h);
+            a_h = _mm256_fnmadd_pd(v_gamma_h, _mm256_loadu_pd(h_dot + x), a_h);
+            a_h = _mm256_fnmadd_pd(v_two_mu_sq, q, a_h);
+            a_h = _mm256_fnmadd_pd(_mm256_mul_pd(v_four_lambda_h, q), q_sq, a_h);
+            a_h = _mm256_fnmadd_pd(_mm256_mul_pd(v_two_lambda, _mm256_mul_pd(p, p)), q, a_h);
+            _mm256_storeu_pd(h_acc + x, a_h);
+        }
+        return x;
+    }
+
+    /**
+     * Interior columns [x, x_end), 8 sites per iteration (float32); returns first unprocessed x
+     */
+    template<int CrossRows>
+    DASE_TARGET_AVX2 static size_t accelInteriorAVX2(const float* phi, const float* h,
+                                                     const float* phi_dot, const float* h_dot,
+                                                     const float* const* cross_phi, const float* const* cross_h,
+                                                     float* phi_acc, float* h_acc,
+                                                     size_t x, size_t x_end,
+                                                     float center_weight, const SATPHiggsCoefficientsT<float>& k) {
+        const __m256 v_center = _mm256_set1_ps(center_weight);
+        const __m256 v_inv_dx_sq = _mm256_set1_ps(k.inv_dx_sq);
+        const __m256 v_c_sq = _mm256_set1_ps(k.c_sq);
+        const __m256 v_gamma_phi = _mm256_set1_ps(k.gamma_phi);
+        const __m256 v_gamma_h = _mm256_set1_ps(k.gamma_h);
+        const __m256 v_two_lambda = _mm256_set1_ps(2.0f * k.lambda);
+        const __m256 v_two_mu_sq = _mm256_set1_ps(2.0f * k.mu_sq);
+        const __m256 v_four_lambda_h = _mm256_set1_ps(4.0f * k.lambda_h);
+
+        for (; x + 8 <= x_end; x += 8) {
+            __m256 sum_phi = _mm256_add_ps(_mm256_loadu_ps(phi + x - 1), _mm256_loadu_ps(phi + x + 1));
+            __m256 sum_h = _mm256_add_ps(_mm256_loadu_ps(h + x - 1), _mm256_loadu_ps(h + x + 1));
+            for (int r = 0; r < CrossRows; ++r) {
+                sum_phi = _mm256_add_ps(sum_phi, _mm256_loadu_ps(cross_phi[r] + x));
+                sum_h = _mm256_add_ps(sum_h, _mm256_loadu_ps(cross_h[r] + x));
+            }
+
+            const __m256 p = _mm256_loadu_ps(phi + x);
+            const __m256 q = _mm256_loadu_ps(h + x);
+            const __m256 lap_phi = _mm256_mul_ps(_mm256_fnmadd_ps(v_center, p, sum_phi), v_inv_dx_sq);
+            const __m256 lap_h = _mm256_mul_ps(_mm256_fnmadd_ps(v_center, q, sum_h), v_inv_dx_sq);
+            const __m256 q_sq = _mm256_mul_ps(q, q);
+
+            // φ: c²∇²φ - γ_φ φ̇ - 2λ φ h²
+            __m256 a_phi = _mm256_mul_ps(v_c_sq, lap_phi);
+            a_phi = _mm256_fnmadd_ps(v_gamma_phi, _mm256_loadu_ps(phi_dot + x), a_phi);
+            a_phi = _mm256_fnmadd_ps(_mm256_mul_ps(v_two_lambda, p), q_sq, a_phi);
+            _mm256_storeu_ps(phi_acc + x, a_phi);
+
+            // h: c²∇²h - γ_h ḣ - 2μ² h - 4λ_h h³ - 2λ φ² h
+            __m256 a_h = _mm256_mul_ps(v_c_sq, lap_h);
+            a_h = _mm256_fnmadd_ps(v_gamma_h, _mm256_loadu_ps(h_dot + x), a_h);
+            a_h = _mm256_fnmadd_ps(v_two_mu_sq, q, a_h);
+            a_h = _mm256_fnmadd_ps(_mm256_mul_ps(v_four_lambda_h, q), q_sq, a_h);
+            a_h = _mm256_fnmadd_ps(_mm256_mul_ps(v_two_lambda, _mm256_mul_ps(p, p)), q, a_h);
+            _mm256_storeu_ps(h_acc + x, a_h);
+        }
+        return x;
+    }
+#endif
+};
+
+using SATPHiggsKernels = SATPHiggsKernelsT<double>;
+using SATPHiggsKernelsF32 = SATPHiggsKernelsT<float>;
+
+} // namespace satp_higgs
+} // namespace dase
@@ -17,193 +17,150 @@ namespace dase {
 namespace satp_higgs {
 
 // Velocity Verlet implementation for 3D wave equations
+//
+// The step runs on the scratch field planes with SATPHiggsKernels; nodes are
+// gathered once before the first step and scattered back after the last.
+// In tiled mode each step is one z-plane wavefront (stepTiled3D) instead of
+// four full-lattice sweeps. Float precision runs the same steps on the
+// float32 planes.
 inline void SATPHiggsEngine3D::evolve(size_t num_steps) {
     is_running.store(true);
 
-    const double c_sq = params.c * params.c;
-    const double dx_sq = dx * dx;
-    const double gamma_phi = params.gamma_phi;
-    const double gamma_h = params.gamma_h;
-    const double lambda = params.lambda;
-    const double mu_sq = params.mu_squared;
-    const double lambda_h = params.lambda_h;
+    const SATPHiggsCoefficients k = params.coefficients(dx);
 
-    for (size_t step = 0; step < num_steps; ++step) {
-        // Velocity Verlet: x(t+dt) = x(t) + v(t)*dt + 0.5*a(t)*dt²
-        //                  v(t+dt) = v(t) + 0.5*[a(t) + a(t+dt)]*dt
-
-        // Step 1: Compute accelerations at t
-        std::vector<double> phi_accel(N_x * N_y * N_z);
-        std::vector<double> h_accel(N_x * N_y * N_z);
-
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-
-                    // Neighbor indices (periodic boundaries)
-                    size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
-                    size_t x_next = (x + 1) % N_x;
-                    size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
-                    size_t y_next = (y + 1) % N_y;
-                    size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
-                    size_t z_next = (z + 1) % N_z;
-
-                    size_t idx_xprev = getIndex(x_prev, y, z);
-                    size_t idx_xnext = getIndex(x_next, y, z);
-                    size_t idx_yprev = getIndex(x, y_prev, z);
-                    size_t idx_ynext = getIndex(x, y_next, z);
-                    size_t idx_zprev = getIndex(x, y, z_prev);
-                    size_t idx_znext = getIndex(x, y, z_next);
-
-                    const auto& node = nodes[idx];
-                    const auto& node_xprev = nodes[idx_xprev];
-                    const auto& node_xnext = nodes[idx_xnext];
-                    const auto& node_yprev = nodes[idx_yprev];
-                    const auto& node_ynext = nodes[idx_ynext];
-                    const auto& node_zprev = nodes[idx_zprev];
-                    const auto& node_znext = nodes[idx_znext];
-
-                    // 3D Laplacian using 7-point stencil
-                    // ∇²f = (f_{i-1,j,k} + f_{i+1,j,k} + f_{i,j-1,k} + f_{i,j+1,k} + f_{i,j,k-1} + f_{i,j,k+1} - 6f_{i,j,k}) / dx²
-                    double laplacian_phi = (node_xprev.phi + node_xnext.phi +
-                                           node_yprev.phi + node_ynext.phi +
-                                           node_zprev.phi + node_znext.phi -
-                                           6.0 * node.phi) / dx_sq;
-
-                    double laplacian_h = (node_xprev.h + node_xnext.h +
-                                         node_yprev.h + node_ynext.h +
-                                         node_zprev.h + node_znext.h -
-                                         6.0 * node.h) / dx_sq;
-
-                    // Source term for φ field
-                    double source_term = 0.0;
-                    if (has_source) {
-                        double x_pos = static_cast<double>(x) * dx;
-                        double y_pos = static_cast<double>(y) * dx;
-                        double z_pos = static_cast<double>(z) * dx;
-                        source_term = source_phi(current_time, x_pos, y_pos, z_pos,
-                                                static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
-                    }
-
-                    // φ equation: ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x,y,z)
-                    phi_accel[idx] = c_sq * laplacian_phi
-                                   - gamma_phi * node.phi_dot
-                                   - 2.0 * lambda * node.phi * node.h * node.h
-                                   + source_term;
-
-                    // h equation: ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
-                    h_accel[idx] = c_sq * laplacian_h
-                                 - gamma_h * node.h_dot
-                                 - 2.0 * mu_sq * node.h
-                                 - 4.0 * lambda_h * node.h * node.h * node.h
-                                 - 2.0 * lambda * node.phi * node.phi * node.h;
-                }
+    if (precision == SATPHiggsPrecision::Float) {
+        evolveOn<float>(num_steps, k.as<float>());
+    } else {
+        evolveOn<double>(num_steps, k);
+    }
+    is_running.store(false);
+}
+
+// CPU Verlet steps on the scratch planes of precision Real
+template<typename Real>
+inline void SATPHiggsEngine3D::evolveOn(size_t num_steps, const SATPHiggsCoefficientsT<Real>& k) {
+    using Kernels = SATPHiggsKernelsT<Real>;
+    const size_t plane = N_x * N_y;
+    const size_t N_sites = plane * N_z;
+
+    // Fields and accelerations live in the engine's persistent scratch (no per-step allocation)
+    SATPHiggsPlanes<Real>& planes = scratch.planes<Real>();
+    {
+        DASE_PROFILE_PHASE(&profiler, SATP_PHASE_TRANSFER);
+        evolve_allocations += planes.ensure(N_sites);
+        evolve_allocations += planes.ensureTile(plane);
+        planes.loadFrom(nodes);
+    }
+    const SATPHiggsFieldViewT<Real> f = planes.view();
+    const SATPHiggsSubsteps substeps = satpHiggsSubsteps(integrator);
+
+    if (tiled && N_z >= 3) {
+        const SATPHiggsTilePlanesT<Real> w = planes.tilePlanes(plane);
+        auto source = [this](Real* accel_plane, size_t z, double t) { addSource(accel_plane, z, t); };
+
+        for (size_t step = 0; step < num_steps; ++step) {
+            double t = current_time;
+            for (size_t s = 0; s < substeps.count; ++s) {
+                const double h = substeps.weight[s] * dt;
+                DASE_PROFILE_PHASE(&profiler, SATP_PHASE_TILED);
+                Kernels::stepTiled3D(f, w, N_x, N_y, N_z, k, t, static_cast<Real>(h),
+                                     vectorized, has_source, source);
+                t += h;
             }
+            current_time += dt;
+            step_count++;
+            total_updates.fetch_add(N_sites, std::memory_order_relaxed);
         }
 
-        // Step 2: Update positions and half-step velocities
-        for (size_t i = 0; i < N_x * N_y * N_z; ++i) {
-            auto& node = nodes_temp[i];
-            node = nodes[i];
+        {
+            DASE_PROFILE_PHASE(&profiler, SATP_PHASE_TRANSFER);
+            planes.storeTo(nodes);
+        }
+        return;
+    }
 
-            // Position update
-            node.phi = node.phi + node.phi_dot * dt + 0.5 * phi_accel[i] * dt * dt;
-            node.h = node.h + node.h_dot * dt + 0.5 * h_accel[i] * dt * dt;
+    Real* phi_accel = planes.phi_accel.data();
+    Real* h_accel = planes.h_accel.data();
+    Real* phi_accel_new = planes.phi_accel_new.data();
+    Real* h_accel_new = planes.h_accel_new.data();
 
-            // Half-step velocity update
-            node.phi_dot = node.phi_dot + 0.5 * phi_accel[i] * dt;
-            node.h_dot = node.h_dot + 0.5 * h_accel[i] * dt;
-        }
+    for (size_t step = 0; step < num_steps; ++step) {
+        // Velocity Verlet: x(t+h) = x(t) + v(t)*h + 0.5*a(t)*h²
+        //                  v(t+h) = v(t) + 0.5*[a(t) + a(t+h)]*h
+        // with h = dt, or h = weight[s]·dt for each sub-step of the integrator
+        double t = current_time;
+        for (size_t s = 0; s < substeps.count; ++s) {
+            const double h = substeps.weight[s] * dt;
+            const Real sub_dt = static_cast<Real>(h);
+
+            // Step 1: Compute accelerations at t
+            {
+                DASE_PROFILE_PHASE(&profiler, SATP_PHASE_ACCEL);
+                Kernels::accel3D(f, phi_accel, h_accel, N_x, N_y, N_z, k, vectorized);
+            }
+            if (has_source) {
+                DASE_PROFILE_PHASE(&profiler, SATP_PHASE_SOURCE);
+                for (size_t z = 0; z < N_z; ++z) addSource(phi_accel + z * plane, z, t);
+            }
 
-        // Step 3: Compute accelerations at t+dt
-        std::vector<double> phi_accel_new(N_x * N_y * N_z);
-        std::vector<double> h_accel_new(N_x * N_y * N_z);
-
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-
-                    // Neighbor indices
-                    size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
-                    size_t x_next = (x + 1) % N_x;
-                    size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
-                    size_t y_next = (y + 1) % N_y;
-                    size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
-                    size_t z_next = (z + 1) % N_z;
-
-                    size_t idx_xprev = getIndex(x_prev, y, z);
-                    size_t idx_xnext = getIndex(x_next, y, z);
-                    size_t idx_yprev = getIndex(x, y_prev, z);
-                    size_t idx_ynext = getIndex(x, y_next, z);
-                    size_t idx_zprev = getIndex(x, y, z_prev);
-                    size_t idx_znext = getIndex(x, y, z_next);
-
-                    const auto& node = nodes_temp[idx];
-                    const auto& node_xprev = nodes_temp[idx_xprev];
-                    const auto& node_xnext = nodes_temp[idx_xnext];
-                    const auto& node_yprev = nodes_temp[idx_yprev];
-                    const auto& node_ynext = nodes_temp[idx_ynext];
-                    const auto& node_zprev = nodes_temp[idx_zprev];
-                    const auto& node_znext = nodes_temp[idx_znext];
-
-                    // 3D Laplacian at t+dt
-                    double laplacian_phi = (node_xprev.phi + node_xnext.phi +
-                                           node_yprev.phi + node_ynext.phi +
-                                           node_zprev.phi + node_znext.phi -
-                                           6.0 * node.phi) / dx_sq;
-
-                    double laplacian_h = (node_xprev.h + node_xnext.h +
-                                         node_yprev.h + node_ynext.h +
-                                         node_zprev.h + node_znext.h -
-                                         6.0 * node.h) / dx_sq;
-
-                    // Source term at t+dt
-                    double source_term = 0.0;
-                    if (has_source) {
-                        double x_pos = static_cast<double>(x) * dx;
-                        double y_pos = static_cast<double>(y) * dx;
-                        double z_pos = static_cast<double>(z) * dx;
-                        double t_new = current_time + dt;
-                        source_term = source_phi(t_new, x_pos, y_pos, z_pos,
-                                                static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
-                    }
-
-                    // Accelerations at t+dt
-                    phi_accel_new[idx] = c_sq * laplacian_phi
-                                       - gamma_phi * node.phi_dot
-                                       - 2.0 * lambda * node.phi * node.h * node.h
-                                       + source_term;
-
-                    h_accel_new[idx] = c_sq * laplacian_h
-                                     - gamma_h * node.h_dot
-                                     - 2.0 * mu_sq * node.h
-                                     - 4.0 * lambda_h * node.h * node.h * node.h
-                                     - 2.0 * lambda * node.phi * node.phi * node.h;
-                }
+            // Step 2: Update positions and half-step velocities
+            {
+                DASE_PROFILE_PHASE(&profiler, SATP_PHASE_UPDATE);
+                Kernels::driftKickAll(f, phi_accel, h_accel, N_sites, sub_dt);
             }
-        }
 
-        // Step 4: Complete velocity update using average acceleration
-        for (size_t i = 0; i < N_x * N_y * N_z; ++i) {
-            nodes_temp[i].phi_dot = nodes_temp[i].phi_dot + 0.5 * phi_accel_new[i] * dt;
-            nodes_temp[i].h_dot = nodes_temp[i].h_dot + 0.5 * h_accel_new[i] * dt;
+            // Step 3: Compute accelerations at t+h
+            {
+                DASE_PROFILE_PHASE(&profiler, SATP_PHASE_ACCEL);
+                Kernels::accel3D(f, phi_accel_new, h_accel_new, N_x, N_y, N_z, k, vectorized);
+            }
+            if (has_source) {
+                DASE_PROFILE_PHASE(&profiler, SATP_PHASE_SOURCE);
+                for (size_t z = 0; z < N_z; ++z) addSource(phi_accel_new + z * plane, z, t + h);
+            }
 
-            // Update derived quantities
-            nodes_temp[i].updateDerived();
+            // Step 4: Complete velocity update using average acceleration
+            {
+                DASE_PROFILE_PHASE(&profiler, SATP_PHASE_UPDATE);
+                Kernels::kickAll(f, phi_accel_new, h_accel_new, N_sites, sub_dt);
+            }
+            t += h;
         }
 
-        // Step 5: Swap buffers
-        nodes.swap(nodes_temp);
-
         // Update simulation state
         current_time += dt;
         step_count++;
-        total_updates.fetch_add(N_x * N_y * N_z, std::memory_order_relaxed);
+        total_updates.fetch_add(N_sites, std::memory_order_relaxed);
     }
 
-    is_running.store(false);
+    // Derived quantities are refreshed on scatter
+    {
+        DASE_PROFILE_PHASE(&profiler, SATP_PHASE_TRANSFER);
+        planes.storeTo(nodes);
+    }
+}
+
+// Add S(t, x) to the φ acceleration of slice z (serial: the source callback need not be thread-safe)
+template<typename Real>
+inline void SATPHiggsEngine3D::addSource(Real* accel_plane, size_t z, double t) const {
+    if (source_batch) {
+        double* s = source_plane.data();
+        source_batch(t, SATPSourcePlane{N_x, N_y, N_z, z, dx}, s);
+        const size_t n = N_x * N_y;
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            accel_plane[i] += static_cast<Real>(s[i]);
+        }
+        return;
+    }
+    for (size_t y = 0; y < N_y; ++y) {
+        for (size_t x = 0; x < N_x; ++x) {
+            accel_plane[y * N_x + x] += static_cast<Real>(
+                source_phi(t, static_cast<double>(x) * dx,
+                           static_cast<double>(y) * dx, static_cast<double>(z) * dx,
+                           static_cast<int>(x), static_cast<int>(y), static_cast<int>(z)));
+        }
+    }
 }
 
 // CFL stability check for 3D
@@ -0,0 +1,164 @@
+/**
+ * SATP+Higgs Source Terms - Batched φ Sources
+ *
+ * A per-site SourceFunction goes through std::function once per node,
+ * twice per Verlet step, so the source pass cannot be inlined or
+ * vectorized. A SATPSourceBatch instead fills one whole z-plane of S(t)
+ * per call. The engine then adds the plane to the φ acceleration in one
+ * vectorized loop:
+ *
+ *   GaussianPulseSource pulse;
+ *   pulse.center[0] = 3.2;
+ *   pulse.sigma = 0.4;
+ *   pulse.frequency = 2.0;
+ *   engine.setSourceBatch(pulse);          // 1D, 2D or 3D engine
+ *
+ * The built-in sources are separable Gaussians on the periodic lattice.
+ * A plane costs N_x + N_y exponentials (ProfileTables) plus one
+ * vectorized product per site, and the per-axis tables are reused while
+ * the centre stays put:
+ * - GaussianPulseSource: fixed centre, amplitude with an optional Gaussian
+ *   envelope in time and a cos(2πf(t - t0)) carrier
+ * - MovingGaussianSource: centre moving at constant velocity, wrapping
+ *   around the torus
+ *
+ * Axes the lattice does not have (y, z in 1D; z in 2D) contribute a
+ * factor of 1.
+ */
+
+#pragma once
+
+#include "profile_tables.h"
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dase {
+namespace satp_higgs {
+
+/**
+ * Plane a batched source fills: out[y·N_x + x] = S(t, x·dx, y·dx, z·dx)
+ */
+struct SATPSourcePlane {
+    size_t N_x;
+    size_t N_y;   // 1 on the 1D engine
+    size_t N_z;   // 1 on the 1D/2D engines
+    size_t z;     // Plane index
+    double dx;
+};
+
+// Fills N_x·N_y values of S(t) for one plane (called serially)
+using SATPSourceBatch = std::function<void(double t, const SATPSourcePlane& plane, double* out)>;
+
+/**
+ * Periodic Gaussian exp(-|r - c|²/2σ²) written one plane at a time
+ */
+class SeparableGaussianPlane {
+public:
+    void fill(const SATPSourcePlane& plane, const double center[3], double sigma,
+              double scale, double* out) {
+        const double inv_two_sigma_sq = 1.0 / (2.0 * sigma * sigma);
+        axis(x_, plane.N_x, plane.dx, center[0], inv_two_sigma_sq);
+        axis(y_, plane.N_y, plane.dx, center[1], inv_two_sigma_sq);
+        const double gz = plane.N_z > 1
+            ? ProfileTables::gaussianAt(plane.z, plane.N_z, plane.dx,
+                                        wrap(center[2], plane.N_z, plane.dx), inv_two_sigma_sq, true)
+            : 1.0;
+        for (size_t y = 0; y < plane.N_y; y++) {
+            ProfileTables::scaleRow(out + y * plane.N_x, x_.table.data(), plane.N_x, scale * gz * y_.table[y]);
+        }
+    }
+
+private:
+    struct Axis {
+        std::vector<double> table;
+        size_t n = 0;
+        double spacing = 0.0;
+        double center = std::numeric_limits<double>::quiet_NaN();
+        double inv_two_sigma_sq = 0.0;
+    };
+
+    Axis x_;
+    Axis y_;
+
+    // Centre folded into [0, L) so the single-image shift of gaussianAt holds
+    static double wrap(double center, size_t n, double spacing) {
+        const double L = static_cast<double>(n) * spacing;
+        const double c = std::fmod(center, L);
+        return c < 0.0 ? c + L : c;
+    }
+
+    static void axis(Axis& a, size_t n, double spacing, double center, double inv_two_sigma_sq) {
+        if (n <= 1) {
+            a.table.assign(1, 1.0);
+            a.n = n;
+            return;
+        }
+        const double c = wrap(center, n, spacing);
+        if (a.n == n && a.spacing == spacing && a.center == c && a.inv_two_sigma_sq == inv_two_sigma_sq) return;
+        a.table.resize(n);
+        ProfileTables::gaussian(a.table.data(), n, spacing, c, inv_two_sigma_sq, true);
+        a.n = n;
+        a.spacing = spacing;
+        a.center = c;
+        a.inv_two_sigma_sq = inv_two_sigma_sq;
+    }
+};
+
+/**
+ * S = A·exp(-(t - t0)²/2τ²)·cos(2πf(t - t0))·exp(-|r - c|²/2σ²)
+ *
+ * duration τ = 0 drops the envelope; frequency 0 drops the carrier.
+ */
+struct GaussianPulseSource {
+    double amplitude = 1.0;
+    double center[3] = {0.0, 0.0, 0.0};
+    double sigma = 1.0;
+    double t0 = 0.0;
+    double duration = 0.0;
+    double frequency = 0.0;
+
+    double envelope(double t) const {
+        const double s = t - t0;
+        double a = amplitude;
+        if (duration > 0.0) a *= std::exp(-(s * s) / (2.0 * duration * duration));
+        if (frequency > 0.0) a *= std::cos(2.0 * M_PI * frequency * s);
+        return a;
+    }
+
+    void operator()(double t, const SATPSourcePlane& plane, double* out) {
+        gaussian.fill(plane, center, sigma, envelope(t), out);
+    }
+
+    SeparableGaussianPlane gaussian;
+};
+
+/**
+ * S = A·cos(2πf·t)·exp(-|r - (c0 + v·t)|²/2σ²) on the torus
+ */
+struct MovingGaussianSource {
+    double amplitude = 1.0;
+    double start[3] = {0.0, 0.0, 0.0};
+    double velocity[3] = {0.0, 0.0, 0.0};
+    double sigma = 1.0;
+    double frequency = 0.0;
+
+    void operator()(double t, const SATPSourcePlane& plane, double* out) {
+        const double center[3] = {start[0] + velocity[0] * t,
+                                  start[1] + velocity[1] * t,
+                                  start[2] + velocity[2] * t};
+        const double a = frequency > 0.0 ? amplitude * std::cos(2.0 * M_PI * frequency * t) : amplitude;
+        gaussian.fill(plane, center, sigma, a, out);
+    }
+
+    SeparableGaussianPlane gaussian;
+};
+
+} // namespace satp_higgs
+} // namespace dase
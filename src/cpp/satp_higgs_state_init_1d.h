@@ -11,10 +11,12 @@
 #pragma once
 
 #include "satp_higgs_engine_1d.h"
+#include "counter_rng.h"
+#include "profile_tables.h"
 #include <algorithm>
 #include <cmath>
-#include <random>
 #include <string>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -76,94 +78,63 @@ public:
     // Initialize φ field with Gaussian profile
     static void initPhiGaussian(SATPHiggsEngine1D& engine,
                                  const GaussianProfileParams& params) {
-        auto& nodes = engine.getNodesMutable();
-        size_t N = engine.getN();
-        double dx = engine.getDx();
-
-        const double sigma = std::max(params.sigma, MIN_SIGMA_SATP);
-        const double inv_two_sigma_sq = 1.0 / (2.0 * sigma * sigma);
-
-        for (size_t i = 0; i < N; ++i) {
-            double x = static_cast<double>(i) * dx;
-            double dx_val = x - params.center;
-
-            // Handle periodic boundary for distance calculation
-            double L = static_cast<double>(N) * dx;
-            if (dx_val > L / 2.0) dx_val -= L;
-            if (dx_val < -L / 2.0) dx_val += L;
-
-            double exponent = -(dx_val * dx_val) * inv_two_sigma_sq;
-            double gaussian = params.amplitude * std::exp(exponent);
-
-            if (params.mode == "add") {
-                nodes[i].phi += gaussian;
-                if (params.set_velocity) {
-                    nodes[i].phi_dot += params.velocity_amplitude * std::exp(exponent);
-                }
-            } else if (params.mode == "blend") {
-                nodes[i].phi = params.beta * gaussian + (1.0 - params.beta) * nodes[i].phi;
-                if (params.set_velocity) {
-                    double vel = params.velocity_amplitude * std::exp(exponent);
-                    nodes[i].phi_dot = params.beta * vel + (1.0 - params.beta) * nodes[i].phi_dot;
-                }
-            } else {  // overwrite
-                nodes[i].phi = gaussian;
-                if (params.set_velocity) {
-                    nodes[i].phi_dot = params.velocity_amplitude * std::exp(exponent);
-                } else {
-                    nodes[i].phi_dot = 0.0;
-                }
-            }
-
-            nodes[i].updateDerived();
-        }
+        initGaussians(engine, {params}, {});
     }
 
     // Initialize h field with Gaussian perturbation around VEV
     static void initHiggsGaussian(SATPHiggsEngine1D& engine,
                                    const GaussianProfileParams& params) {
-        auto& nodes = engine.getNodesMutable();
-        size_t N = engine.getN();
-        double dx = engine.getDx();
-        double h_vev = engine.getParams().h_vev;
-
-        const double sigma = std::max(params.sigma, MIN_SIGMA_SATP);
-        const double inv_two_sigma_sq = 1.0 / (2.0 * sigma * sigma);
-
-        for (size_t i = 0; i < N; ++i) {
-            double x = static_cast<double>(i) * dx;
-            double dx_val = x - params.center;
-
-            // Handle periodic boundary
-            double L = static_cast<double>(N) * dx;
-            if (dx_val > L / 2.0) dx_val -= L;
-            if (dx_val < -L / 2.0) dx_val += L;
-
-            double exponent = -(dx_val * dx_val) * inv_two_sigma_sq;
-            double gaussian = params.amplitude * std::exp(exponent);
+        initGaussians(engine, {}, {params});
+    }
 
-            if (params.mode == "add") {
-                nodes[i].h += gaussian;
-                if (params.set_velocity) {
-                    nodes[i].h_dot += params.velocity_amplitude * std::exp(exponent);
-                }
-            } else if (params.mode == "blend") {
-                double h_target = h_vev + gaussian;
-                nodes[i].h = params.beta * h_target + (1.0 - params.beta) * nodes[i].h;
-                if (params.set_velocity) {
-                    double vel = params.velocity_amplitude * std::exp(exponent);
-                    nodes[i].h_dot = params.beta * vel + (1.0 - params.beta) * nodes[i].h_dot;
-                }
-            } else {  // overwrite
-                nodes[i].h = h_vev + gaussian;
-                if (params.set_velocity) {
-                    nodes[i].h_dot = params.velocity_amplitude * std::exp(exponent);
+    // Apply several φ and h Gaussians in one sweep (same result as the
+    // single-profile calls in order). Each profile is a periodic table of
+    // N exponentials; nodes are split across threads.
+    static void initGaussians(SATPHiggsEngine1D& engine,
+                              const std::vector<GaussianProfileParams>& phi_profiles,
+                              const std::vector<GaussianProfileParams>& h_profiles) {
+        auto& nodes = engine.getNodesMutable();
+        const size_t N = engine.getN();
+        const double dx = engine.getDx();
+        const double h_vev = engine.getParams().h_vev;
+
+        struct Term {
+            RealFieldProfile profile;
+            bool higgs;
+            std::vector<double> g;
+        };
+        std::vector<Term> terms;
+        terms.reserve(phi_profiles.size() + h_profiles.size());
+        auto addTerms = [&](const std::vector<GaussianProfileParams>& list, bool higgs) {
+            for (const auto& p : list) {
+                const double sigma = std::max(p.sigma, MIN_SIGMA_SATP);
+                Term term;
+                term.profile.mode = parseProfileMode(p.mode);
+                term.profile.amplitude = p.amplitude;
+                term.profile.baseline = higgs ? h_vev : 0.0;
+                term.profile.set_velocity = p.set_velocity;
+                term.profile.velocity_amplitude = p.velocity_amplitude;
+                term.profile.beta = p.beta;
+                term.higgs = higgs;
+                term.g = ProfileTables::gaussian(N, dx, p.center, 1.0 / (2.0 * sigma * sigma), true);
+                terms.push_back(std::move(term));
+            }
+        };
+        addTerms(phi_profiles, false);
+        addTerms(h_profiles, true);
+
+        const long count = static_cast<long>(N);
+        #pragma omp parallel for schedule(static) if(N >= ProfileTables::kParallelThreshold)
+        for (long i = 0; i < count; i++) {
+            auto& node = nodes[i];
+            for (const auto& term : terms) {
+                if (term.higgs) {
+                    term.profile.apply(node.h, node.h_dot, term.g[i]);
                 } else {
-                    nodes[i].h_dot = 0.0;
+                    term.profile.apply(node.phi, node.phi_dot, term.g[i]);
                 }
             }
-
-            nodes[i].updateDerived();
+            node.updateDerived();
         }
     }
 
@@ -195,6 +166,38 @@ public:
         };
     }
 
+    // Same source as a SATPSourceBatch: the zone profile is tabulated once
+    // per lattice and each call scales it by the time factor
+    static SATPSourceBatch createThreeZoneSourceBatch(const ThreeZoneSourceParams& params) {
+        std::vector<double> zones;
+        return [params, zones](double t, const SATPSourcePlane& plane, double* out) mutable {
+            if (zones.size() != plane.N_x) {
+                zones.resize(plane.N_x);
+                for (size_t i = 0; i < plane.N_x; i++) {
+                    const double x = static_cast<double>(i) * plane.dx;
+                    double amplitude = 0.0;
+                    if (x >= params.zone1_start && x <= params.zone1_end) {
+                        amplitude = params.amplitude1;
+                    } else if (x >= params.zone2_start && x <= params.zone2_end) {
+                        amplitude = params.amplitude2;
+                    } else if (x >= params.zone3_start && x <= params.zone3_end) {
+                        amplitude = params.amplitude3;
+                    }
+                    zones[i] = amplitude;
+                }
+            }
+            double scale = 1.0;
+            if (t < params.t_start || (params.t_end > 0.0 && t > params.t_end)) {
+                scale = 0.0;
+            } else if (params.frequency > 0.0) {
+                scale = std::sin(2.0 * M_PI * params.frequency * t);
+            }
+            for (size_t y = 0; y < plane.N_y; y++) {
+                ProfileTables::scaleRow(out + y * plane.N_x, zones.data(), plane.N_x, scale);
+            }
+        };
+    }
+
     // Initialize uniform state
     static void initUniform(SATPHiggsEngine1D& engine,
                            double phi_val, double phi_dot_val,
@@ -214,13 +217,18 @@ public:
                                       double phi_amplitude,
                                       double h_amplitude,
                                       unsigned int seed = 0) {
-        std::mt19937_64 rng(seed == 0 ? std::random_device{}() : seed);
-        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const CounterRNG rng(seed == 0 ? CounterRNG::entropySeed() : seed);
 
+        // Node i draws block (0, i): the same field for any thread count
         auto& nodes = engine.getNodesMutable();
-        for (auto& node : nodes) {
-            node.phi += phi_amplitude * dist(rng);
-            node.h += h_amplitude * dist(rng);
+        const long count = static_cast<long>(nodes.size());
+        #pragma omp parallel for schedule(static) if(nodes.size() >= CounterRNG::kParallelThreshold)
+        for (long i = 0; i < count; i++) {
+            double u_phi, u_h;
+            rng.uniformPair(0, static_cast<uint64_t>(i), u_phi, u_h);
+            auto& node = nodes[i];
+            node.phi += phi_amplitude * (2.0 * u_phi - 1.0);
+            node.h += h_amplitude * (2.0 * u_h - 1.0);
             node.updateDerived();
         }
     }
@@ -234,15 +242,17 @@ public:
         size_t N = engine.getN();
         double dx = engine.getDx();
         double k = 2.0 * M_PI / wavelength;
+        const double h_vev = engine.getParams().h_vev;
 
-        for (size_t i = 0; i < N; ++i) {
+        const long count = static_cast<long>(N);
+        #pragma omp parallel for schedule(static) if(N >= ProfileTables::kParallelThreshold)
+        for (long i = 0; i < count; i++) {
             double x = static_cast<double>(i) * dx;
             double value = amplitude * std::sin(k * x + phase_offset);
 
             if (for_phi_field) {
                 nodes[i].phi = value;
             } else {
-                double h_vev = engine.getParams().h_vev;
                 nodes[i].h = h_vev + value;
             }
             nodes[i].updateDerived();
@@ -11,10 +11,12 @@
 #pragma once
 
 #include "satp_higgs_engine_2d.h"
+#include "counter_rng.h"
+#include "profile_tables.h"
 #include <algorithm>
 #include <cmath>
-#include <random>
 #include <string>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -76,60 +78,7 @@ public:
     // Initialize φ field with elliptical Gaussian
     static void initPhiGaussian(SATPHiggsEngine2D& engine,
                                 const GaussianProfile2DParams& params) {
-        auto& nodes = engine.getNodesMutable();
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
-        double dx = engine.getDx();
-
-        const double sigma_x = std::max(params.sigma_x, MIN_SIGMA_SATP_2D);
-        const double sigma_y = std::max(params.sigma_y, MIN_SIGMA_SATP_2D);
-        const double inv_two_sigma_x_sq = 1.0 / (2.0 * sigma_x * sigma_x);
-        const double inv_two_sigma_y_sq = 1.0 / (2.0 * sigma_y * sigma_y);
-
-        for (size_t y = 0; y < N_y; ++y) {
-            for (size_t x = 0; x < N_x; ++x) {
-                size_t idx = engine.getIndex(x, y);
-
-                double x_pos = static_cast<double>(x) * dx;
-                double y_pos = static_cast<double>(y) * dx;
-                double dx_val = x_pos - params.center_x;
-                double dy_val = y_pos - params.center_y;
-
-                // Handle periodic boundaries
-                double L_x = static_cast<double>(N_x) * dx;
-                double L_y = static_cast<double>(N_y) * dx;
-                if (dx_val > L_x / 2.0) dx_val -= L_x;
-                if (dx_val < -L_x / 2.0) dx_val += L_x;
-                if (dy_val > L_y / 2.0) dy_val -= L_y;
-                if (dy_val < -L_y / 2.0) dy_val += L_y;
-
-                double exponent = -(dx_val * dx_val) * inv_two_sigma_x_sq
-                                 - (dy_val * dy_val) * inv_two_sigma_y_sq;
-                double gaussian = params.amplitude * std::exp(exponent);
-
-                if (params.mode == "add") {
-                    nodes[idx].phi += gaussian;
-                    if (params.set_velocity) {
-                        nodes[idx].phi_dot += params.velocity_amplitude * std::exp(exponent);
-                    }
-                } else if (params.mode == "blend") {
-                    nodes[idx].phi = params.beta * gaussian + (1.0 - params.beta) * nodes[idx].phi;
-                    if (params.set_velocity) {
-                        double vel = params.velocity_amplitude * std::exp(exponent);
-                        nodes[idx].phi_dot = params.beta * vel + (1.0 - params.beta) * nodes[idx].phi_dot;
-                    }
-                } else {  // overwrite
-                    nodes[idx].phi = gaussian;
-                    if (params.set_velocity) {
-                        nodes[idx].phi_dot = params.velocity_amplitude * std::exp(exponent);
-                    } else {
-                        nodes[idx].phi_dot = 0.0;
-                    }
-                }
-
-                nodes[idx].updateDerived();
-            }
-        }
+        initGaussians(engine, {params}, {});
     }
 
     // Initialize h field with circular Gaussian perturbation around VEV
@@ -151,60 +100,66 @@ public:
     // Initialize h field with Gaussian perturbation around VEV
     static void initHiggsGaussian(SATPHiggsEngine2D& engine,
                                    const GaussianProfile2DParams& params) {
-        auto& nodes = engine.getNodesMutable();
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
-        double dx = engine.getDx();
-        double h_vev = engine.getParams().h_vev;
+        initGaussians(engine, {}, {params});
+    }
 
-        const double sigma_x = std::max(params.sigma_x, MIN_SIGMA_SATP_2D);
-        const double sigma_y = std::max(params.sigma_y, MIN_SIGMA_SATP_2D);
-        const double inv_two_sigma_x_sq = 1.0 / (2.0 * sigma_x * sigma_x);
-        const double inv_two_sigma_y_sq = 1.0 / (2.0 * sigma_y * sigma_y);
-
-        for (size_t y = 0; y < N_y; ++y) {
-            for (size_t x = 0; x < N_x; ++x) {
-                size_t idx = engine.getIndex(x, y);
-
-                double x_pos = static_cast<double>(x) * dx;
-                double y_pos = static_cast<double>(y) * dx;
-                double dx_val = x_pos - params.center_x;
-                double dy_val = y_pos - params.center_y;
-
-                // Handle periodic boundaries
-                double L_x = static_cast<double>(N_x) * dx;
-                double L_y = static_cast<double>(N_y) * dx;
-                if (dx_val > L_x / 2.0) dx_val -= L_x;
-                if (dx_val < -L_x / 2.0) dx_val += L_x;
-                if (dy_val > L_y / 2.0) dy_val -= L_y;
-                if (dy_val < -L_y / 2.0) dy_val += L_y;
-
-                double exponent = -(dx_val * dx_val) * inv_two_sigma_x_sq
-                                 - (dy_val * dy_val) * inv_two_sigma_y_sq;
-                double gaussian = params.amplitude * std::exp(exponent);
-
-                if (params.mode == "add") {
-                    nodes[idx].h += gaussian;
-                    if (params.set_velocity) {
-                        nodes[idx].h_dot += params.velocity_amplitude * std::exp(exponent);
-                    }
-                } else if (params.mode == "blend") {
-                    double h_target = h_vev + gaussian;
-                    nodes[idx].h = params.beta * h_target + (1.0 - params.beta) * nodes[idx].h;
-                    if (params.set_velocity) {
-                        double vel = params.velocity_amplitude * std::exp(exponent);
-                        nodes[idx].h_dot = params.beta * vel + (1.0 - params.beta) * nodes[idx].h_dot;
-                    }
-                } else {  // overwrite
-                    nodes[idx].h = h_vev + gaussian;
-                    if (params.set_velocity) {
-                        nodes[idx].h_dot = params.velocity_amplitude * std::exp(exponent);
+    // Apply several φ and h Gaussians in one sweep (same result as the
+    // single-profile calls in order). Each profile is the outer product of
+    // periodic per-axis tables gx[x]·gy[y]; rows are split across threads.
+    static void initGaussians(SATPHiggsEngine2D& engine,
+                              const std::vector<GaussianProfile2DParams>& phi_profiles,
+                              const std::vector<GaussianProfile2DParams>& h_profiles) {
+        auto& nodes = engine.getNodesMutable();
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
+        const double dx = engine.getDx();
+        const double h_vev = engine.getParams().h_vev;
+
+        struct Term {
+            RealFieldProfile profile;
+            bool higgs;
+            std::vector<double> gx, gy;
+        };
+        std::vector<Term> terms;
+        terms.reserve(phi_profiles.size() + h_profiles.size());
+        auto addTerms = [&](const std::vector<GaussianProfile2DParams>& list, bool higgs) {
+            for (const auto& p : list) {
+                const double sigma_x = std::max(p.sigma_x, MIN_SIGMA_SATP_2D);
+                const double sigma_y = std::max(p.sigma_y, MIN_SIGMA_SATP_2D);
+                Term term;
+                term.profile.mode = parseProfileMode(p.mode);
+                term.profile.amplitude = p.amplitude;
+                term.profile.baseline = higgs ? h_vev : 0.0;
+                term.profile.set_velocity = p.set_velocity;
+                term.profile.velocity_amplitude = p.velocity_amplitude;
+                term.profile.beta = p.beta;
+                term.higgs = higgs;
+                term.gx = ProfileTables::gaussian(N_x, dx, p.center_x, 1.0 / (2.0 * sigma_x * sigma_x), true);
+                term.gy = ProfileTables::gaussian(N_y, dx, p.center_y, 1.0 / (2.0 * sigma_y * sigma_y), true);
+                terms.push_back(std::move(term));
+            }
+        };
+        addTerms(phi_profiles, false);
+        addTerms(h_profiles, true);
+
+        #pragma omp parallel if(nodes.size() >= ProfileTables::kParallelThreshold)
+        {
+            std::vector<double> row(N_x);
+            const long rows = static_cast<long>(N_y);
+            #pragma omp for schedule(static)
+            for (long y = 0; y < rows; y++) {
+                auto* row_nodes = nodes.data() + engine.getIndex(0, static_cast<size_t>(y));
+                for (const auto& term : terms) {
+                    ProfileTables::scaleRow(row.data(), term.gx.data(), N_x, term.gy[y]);
+                    if (term.higgs) {
+                        for (size_t x = 0; x < N_x; x++) term.profile.apply(row_nodes[x].h, row_nodes[x].h_dot, row[x]);
                     } else {
-                        nodes[idx].h_dot = 0.0;
+                        for (size_t x = 0; x < N_x; x++) term.profile.apply(row_nodes[x].phi, row_nodes[x].phi_dot, row[x]);
                     }
                 }
-
-                nodes[idx].updateDerived();
+                for (size_t x = 0; x < N_x; x++) {
+                    row_nodes[x].updateDerived();
+                }
             }
         }
     }
@@ -228,13 +183,18 @@ public:
                                       double phi_amplitude,
                                       double h_amplitude,
                                       unsigned int seed = 0) {
-        std::mt19937_64 rng(seed == 0 ? std::random_device{}() : seed);
-        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const CounterRNG rng(seed == 0 ? CounterRNG::entropySeed() : seed);
 
+        // Node i draws block (0, i): the same field for any thread count
         auto& nodes = engine.getNodesMutable();
-        for (auto& node : nodes) {
-            node.phi += phi_amplitude * dist(rng);
-            node.h += h_amplitude * dist(rng);
+        const long count = static_cast<long>(nodes.size());
+        #pragma omp parallel for schedule(static) if(nodes.size() >= CounterRNG::kParallelThreshold)
+        for (long i = 0; i < count; i++) {
+            double u_phi, u_h;
+            rng.uniformPair(0, static_cast<uint64_t>(i), u_phi, u_h);
+            auto& node = nodes[i];
+            node.phi += phi_amplitude * (2.0 * u_phi - 1.0);
+            node.h += h_amplitude * (2.0 * u_h - 1.0);
             node.updateDerived();
         }
     }
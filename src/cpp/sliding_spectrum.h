@@ -0,0 +1,286 @@
+/**
+ * Sliding Spectrum Bank - Streaming Windowed DFT at Tracked Frequencies
+ *
+ * Keeps the DFT of the last `window` samples of each channel at a fixed set
+ * of frequencies, updated as every sample arrives (a sliding DFT, the
+ * streaming form of the Goertzel filter). With X(f) = ∑_m x_m e^{-i2πfm}
+ * over the window, oldest sample first, a new sample x_n costs per channel
+ * and tracked frequency one complex multiply-add:
+ *
+ *   X ← e^{i2πf}·(X - x_{n-W}) + x_n·e^{-i2πf(W-1)}
+ *
+ * so frequencies need not sit on the window's bins. A Hann window is
+ * applied in the frequency domain (0.5·X(f) - 0.25·X(f ± 1/W)), which
+ * triples the terms. Every kResyncWindows windows the terms are recomputed
+ * from the sample history with the Goertzel recurrence, so rounding in the
+ * recursive update cannot build up.
+ *
+ * Every hop samples once the window is full, the window-normalized
+ * magnitudes |X_w(f)| / ∑w of every channel go into a ring of spectrogram
+ * frames (a sinusoid of amplitude A at a tracked frequency reads A/2, a
+ * constant c reads c at f = 0). push() never allocates.
+ *
+ *   SlidingSpectrumConfig config;
+ *   config.frequencies = {0.01, 0.05};   // cycles per sample
+ *   config.window = 256;
+ *   SlidingSpectrumBank bank;
+ *   bank.configure(2, config);
+ *   bank.push(step, time, values);        // values[0..channels)
+ *   std::vector<double> frames;
+ *   bank.copyFrames(0, frames);           // frames × frequencies, oldest first
+ *
+ * Not synchronized, like ObservableRing.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dase {
+
+enum class SpectrumWindow : uint8_t {
+    Rectangular,
+    Hann
+};
+
+inline const char* spectrumWindowName(SpectrumWindow shape) {
+    return shape == SpectrumWindow::Hann ? "hann" : "rectangular";
+}
+
+inline bool parseSpectrumWindow(const std::string& name, SpectrumWindow& shape) {
+    if (name == "hann") {
+        shape = SpectrumWindow::Hann;
+    } else if (name == "rectangular" || name == "rect") {
+        shape = SpectrumWindow::Rectangular;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+struct SlidingSpectrumConfig {
+    std::vector<double> frequencies;               // Tracked frequencies (cycles per sample)
+    size_t window = 256;                           // Samples per transform
+    SpectrumWindow shape = SpectrumWindow::Hann;
+    size_t hop = 0;                                // Samples between frames (0: window)
+    size_t frames = 256;                           // Spectrogram frames kept
+
+    bool operator==(const SlidingSpectrumConfig& other) const {
+        return frequencies == other.frequencies && window == other.window && shape == other.shape &&
+               hop == other.hop && frames == other.frames;
+    }
+    bool operator!=(const SlidingSpectrumConfig& other) const { return !(*this == other); }
+};
+
+class SlidingSpectrumBank {
+public:
+    static constexpr size_t kResyncWindows = 16;
+
+    /**
+     * Track config's frequencies over channels channels (clears; no
+     * frequencies, channels 0 or window 0 disables)
+     */
+    void configure(size_t channels, const SlidingSpectrumConfig& config) {
+        config_ = config;
+        if (config_.hop == 0) config_.hop = config_.window;
+        if (channels == 0 || config_.window == 0 || config_.frequencies.empty()) {
+            channels = 0;
+            config_.frequencies.clear();
+        }
+        channels_ = channels;
+
+        const size_t K = config_.frequencies.size();
+        const bool hann = config_.shape == SpectrumWindow::Hann;
+        const double W = static_cast<double>(config_.window);
+        terms_per_frequency_ = hann ? 3 : 1;
+        term_frequency_.clear();
+        for (size_t k = 0; k < K; k++) {
+            term_frequency_.push_back(config_.frequencies[k]);
+            if (hann) {
+                term_frequency_.push_back(config_.frequencies[k] - 1.0 / W);
+                term_frequency_.push_back(config_.frequencies[k] + 1.0 / W);
+            }
+        }
+        const double two_pi = 6.283185307179586476925286766559;
+        rotate_.resize(term_frequency_.size());
+        enter_.resize(term_frequency_.size());
+        for (size_t t = 0; t < term_frequency_.size(); t++) {
+            rotate_[t] = std::polar(1.0, two_pi * term_frequency_[t]);
+            enter_[t] = std::polar(1.0, -two_pi * term_frequency_[t] * (W - 1.0));
+        }
+        norm_ = channels_ == 0 ? 0.0 : (hann ? 2.0 / W : 1.0 / W);
+
+        terms_.assign(channels_ * term_frequency_.size(), std::complex<double>());
+        history_.assign(channels_ * (channels_ ? config_.window : 0), 0.0);
+        frame_capacity_ = channels_ ? config_.frames : 0;
+        frame_steps_.assign(frame_capacity_, 0);
+        frame_times_.assign(frame_capacity_, 0.0);
+        frame_values_.assign(frame_capacity_ * channels_ * K, 0.0);
+        clear();
+    }
+
+    void clear() {
+        std::fill(terms_.begin(), terms_.end(), std::complex<double>());
+        std::fill(history_.begin(), history_.end(), 0.0);
+        position_ = 0;
+        samples_ = 0;
+        since_resync_ = 0;
+        frame_head_ = 0;
+        frame_size_ = 0;
+        frames_recorded_ = 0;
+    }
+
+    bool enabled() const { return channels_ != 0; }
+    size_t channels() const { return channels_; }
+    const SlidingSpectrumConfig& config() const { return config_; }
+    size_t frequencyCount() const { return config_.frequencies.size(); }
+    uint64_t samples() const { return samples_; }                     // Pushed since clear()
+    bool ready() const { return enabled() && samples_ >= config_.window; }
+
+    void push(uint64_t step, double time, const double* values) {
+        if (channels_ == 0) return;
+        const size_t W = config_.window;
+        const size_t T = term_frequency_.size();
+        for (size_t c = 0; c < channels_; c++) {
+            double& slot = history_[c * W + position_];
+            const double leaving = slot;
+            const double entering = values[c];
+            slot = entering;
+            std::complex<double>* X = terms_.data() + c * T;
+            for (size_t t = 0; t < T; t++) {
+                X[t] = rotate_[t] * (X[t] - leaving) + entering * enter_[t];
+            }
+        }
+        position_ = (position_ + 1 == W) ? 0 : position_ + 1;
+        samples_++;
+
+        if (++since_resync_ == kResyncWindows * W) {
+            resync();
+        }
+        if (samples_ >= W && (samples_ - W) % config_.hop == 0) {
+            pushFrame(step, time);
+        }
+    }
+
+    /**
+     * Current window's transform at tracked frequency k (windowed, not
+     * normalized; zeros stand in for samples before the first push)
+     */
+    std::complex<double> coefficient(size_t channel, size_t k) const {
+        const std::complex<double>* X = terms_.data() + channel * term_frequency_.size() + k * terms_per_frequency_;
+        if (terms_per_frequency_ == 1) return X[0];
+        return 0.5 * X[0] - 0.25 * (X[1] + X[2]);
+    }
+
+    // |X_w(f_k)| / ∑w over the current window
+    double magnitude(size_t channel, size_t k) const {
+        return std::abs(coefficient(channel, k)) * norm_;
+    }
+
+    size_t frameCapacity() const { return frame_capacity_; }
+    size_t frameCount() const { return frame_size_; }
+    uint64_t framesRecorded() const { return frames_recorded_; }
+    uint64_t framesDropped() const { return frames_recorded_ - frame_size_; }
+
+    // Frames in recording order (oldest first), tagged by their last sample
+    void copyFrameSteps(std::vector<double>& out) const {
+        out.resize(frame_size_);
+        size_t slot = oldestFrame();
+        for (size_t i = 0; i < frame_size_; i++) {
+            out[i] = static_cast<double>(frame_steps_[slot]);
+            slot = (slot + 1 == frame_capacity_) ? 0 : slot + 1;
+        }
+    }
+    void copyFrameTimes(std::vector<double>& out) const {
+        out.resize(frame_size_);
+        size_t slot = oldestFrame();
+        for (size_t i = 0; i < frame_size_; i++) {
+            out[i] = frame_times_[slot];
+            slot = (slot + 1 == frame_capacity_) ? 0 : slot + 1;
+        }
+    }
+
+    // Channel's spectrogram: frameCount() rows of frequencyCount() magnitudes
+    void copyFrames(size_t channel, std::vector<double>& out) const {
+        const size_t K = config_.frequencies.size();
+        out.resize(frame_size_ * K);
+        size_t slot = oldestFrame();
+        for (size_t i = 0; i < frame_size_; i++) {
+            const double* row = frame_values_.data() + (slot * channels_ + channel) * K;
+            for (size_t k = 0; k < K; k++) out[i * K + k] = row[k];
+            slot = (slot + 1 == frame_capacity_) ? 0 : slot + 1;
+        }
+    }
+
+private:
+    SlidingSpectrumConfig config_;
+    size_t channels_ = 0;
+    size_t terms_per_frequency_ = 1;
+    std::vector<double> term_frequency_;
+    std::vector<std::complex<double>> rotate_;    // e^{i2πf}
+    std::vector<std::complex<double>> enter_;     // e^{-i2πf(W-1)}
+    double norm_ = 0.0;                           // 1 / ∑w
+
+    std::vector<std::complex<double>> terms_;     // channels × terms
+    std::vector<double> history_;                 // channels × window ring
+    size_t position_ = 0;                         // Slot of the oldest sample (next to leave)
+    uint64_t samples_ = 0;
+    size_t since_resync_ = 0;
+
+    size_t frame_capacity_ = 0;
+    size_t frame_head_ = 0;
+    size_t frame_size_ = 0;
+    uint64_t frames_recorded_ = 0;
+    std::vector<uint64_t> frame_steps_;
+    std::vector<double> frame_times_;
+    std::vector<double> frame_values_;            // frames × channels × frequencies
+
+    size_t oldestFrame() const { return frame_size_ < frame_capacity_ ? 0 : frame_head_; }
+
+    /**
+     * Recompute every term from the history, oldest sample first: the
+     * Goertzel recurrence s_m = x_m + 2cos(ω)s_{m-1} - s_{m-2} leaves
+     * ∑_m x_m e^{iω(W-1-m)} = s_{W-1} - e^{-iω}s_{W-2}
+     */
+    void resync() {
+        since_resync_ = 0;
+        const size_t W = config_.window;
+        const size_t T = term_frequency_.size();
+        for (size_t c = 0; c < channels_; c++) {
+            const double* x = history_.data() + c * W;
+            for (size_t t = 0; t < T; t++) {
+                const double coeff = 2.0 * rotate_[t].real();
+                double s1 = 0.0, s2 = 0.0;
+                for (size_t m = 0, slot = position_; m < W; m++) {
+                    const double s = x[slot] + coeff * s1 - s2;
+                    s2 = s1;
+                    s1 = s;
+                    slot = (slot + 1 == W) ? 0 : slot + 1;
+                }
+                terms_[c * T + t] = enter_[t] * (s1 - std::conj(rotate_[t]) * s2);
+            }
+        }
+    }
+
+    void pushFrame(uint64_t step, double time) {
+        if (frame_capacity_ == 0) return;
+        const size_t K = config_.frequencies.size();
+        frame_steps_[frame_head_] = step;
+        frame_times_[frame_head_] = time;
+        double* row = frame_values_.data() + frame_head_ * channels_ * K;
+        for (size_t c = 0; c < channels_; c++) {
+            for (size_t k = 0; k < K; k++) row[c * K + k] = magnitude(c, k);
+        }
+        frame_head_ = (frame_head_ + 1 == frame_capacity_) ? 0 : frame_head_ + 1;
+        if (frame_size_ < frame_capacity_) frame_size_++;
+        frames_recorded_++;
+    }
+};
+
+} // namespace dase
@@ -0,0 +1,411 @@
+/**
+ * Snapshot Codec - Chunked Compression for float64 State Fields
+ *
+ * Encodes one field (psi_real, psi_imag, phi, ...) as independent chunks
+ * of chunk_values doubles, so chunks compress and decompress on separate
+ * OpenMP threads and a playback reader can decode any index range without
+ * touching the rest of the field:
+ *
+ *   std::vector<uint8_t> bytes = encodeSnapshotField(phi.data(), N, options);
+ *   decodeSnapshotField(bytes.data(), bytes.size(), phi);          // whole field
+ *   decodeSnapshotRange(bytes.data(), bytes.size(), i0, n, out);   // one window
+ *
+ * Codecs:
+ *   Lossless   XOR of each value's bits with its predecessor's, byte-shuffle
+ *              (all byte 0s, then all byte 1s, ...), then an LZ4-style block
+ *              LZ. Neighbours in a smooth field share sign, exponent and
+ *              leading mantissa bits, so the XOR zeroes those bytes and the
+ *              shuffle turns them into long runs. Bit-exact.
+ *   Quantized  q = round(x / (2·error_bound)), zigzag deltas of q within
+ *              the chunk, then shuffle + LZ. Every decoded value is within
+ *              error_bound of the input; meant for visualization frames.
+ *              A chunk holding non-finite values or values too large for
+ *              the quantizer is stored losslessly instead.
+ *
+ * A chunk whose coded form is not smaller is stored raw (exact), so the
+ * encoded field is never more than a few bytes per chunk larger than the
+ * input. The block LZ is a self-contained LZ4-style format (token nibbles,
+ * u16 offsets, 4-byte minimum match), not LZ4 frame compatible.
+ *
+ * Encoded field (little-endian):
+ *   u32 codec, u32 chunk_values, u64 count, f64 error_bound,
+ *   u32 chunk_count, u32 0, u32 chunk_bytes[chunk_count],
+ *   chunk k: u8 mode, payload
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace dase {
+
+enum class SnapshotCodec : uint32_t {
+    Raw = 0,        // Not encoded (stream writers store plain arrays)
+    Lossless = 1,   // XOR delta + byte-shuffle + LZ
+    Quantized = 2   // Error-bounded quantization + shuffle + LZ
+};
+
+struct SnapshotCodecOptions {
+    SnapshotCodec codec = SnapshotCodec::Lossless;
+    double error_bound = 0.0;      // Quantized: max |x - decoded| (> 0)
+    uint32_t chunk_values = 16384; // Doubles per independently coded chunk
+};
+
+namespace snapshot_codec_detail {
+
+constexpr size_t kFieldHeaderBytes = 32;
+constexpr uint8_t kChunkStored = 0;
+constexpr uint8_t kChunkShuffleLZ = 1;
+constexpr uint8_t kChunkQuantizedLZ = 2;
+constexpr int kHashBits = 12;
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr double kMaxQuantized = 4503599627370496.0;  // 2^52
+
+inline uint32_t load32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& out, size_t pos, T value) {
+    std::memcpy(out.data() + pos, &value, sizeof(T));
+}
+
+template <typename T>
+T get(const uint8_t* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+inline void putLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+inline void emitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literal_count,
+                         size_t offset, size_t match_length) {
+    const size_t match_code = match_length >= kMinMatch ? match_length - kMinMatch : 0;
+    out.push_back(static_cast<uint8_t>((std::min<size_t>(literal_count, 15) << 4) |
+                                       std::min<size_t>(match_code, 15)));
+    if (literal_count >= 15) putLength(out, literal_count - 15);
+    out.insert(out.end(), literals, literals + literal_count);
+    if (match_length == 0) return;  // Last sequence: literals only
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (match_code >= 15) putLength(out, match_code - 15);
+}
+
+/**
+ * Append the block LZ encoding of src[0, n) to out
+ */
+inline void lzCompress(const uint8_t* src, size_t n, std::vector<uint8_t>& out) {
+    uint32_t table[1u << kHashBits] = {};  // Position + 1; 0 = empty
+    size_t anchor = 0, i = 0;
+    while (i + kMinMatch <= n) {
+        const uint32_t word = load32(src + i);
+        const uint32_t h = (word * 2654435761u) >> (32 - kHashBits);
+        const size_t candidate = table[h];
+        table[h] = static_cast<uint32_t>(i + 1);
+        if (candidate != 0 && i - (candidate - 1) <= kMaxOffset && load32(src + candidate - 1) == word) {
+            const size_t from = candidate - 1;
+            size_t length = kMinMatch;
+            while (i + length < n && src[from + length] == src[i + length]) length++;
+            emitSequence(out, src + anchor, i - anchor, i - from, length);
+            i += length;
+            anchor = i;
+        } else {
+            i += 1 + ((i - anchor) >> 6);  // Skip faster through incompressible runs
+        }
+    }
+    emitSequence(out, src + anchor, n - anchor, 0, 0);
+}
+
+/**
+ * Decode a block LZ stream into exactly n bytes; false on malformed input
+ */
+inline bool lzDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t n) {
+    const uint8_t* ip = src;
+    const uint8_t* const end = src + size;
+    size_t op = 0;
+    auto readLength = [&](size_t& length) {
+        uint8_t b;
+        do {
+            if (ip >= end) return false;
+            b = *ip++;
+            length += b;
+        } while (b == 255);
+        return true;
+    };
+
+    while (ip < end) {
+        const uint8_t token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(literals)) return false;
+        if (literals > static_cast<size_t>(end - ip) || literals > n - op) return false;
+        std::memcpy(dst + op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == end) break;
+
+        if (end - ip < 2) return false;
+        const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        size_t length = token & 15;
+        if (length == 15 && !readLength(length)) return false;
+        length += kMinMatch;
+        if (offset == 0 || offset > op || length > n - op) return false;
+        // Byte copy: a match may overlap its own output (runs)
+        for (size_t k = 0; k < length; k++, op++) dst[op] = dst[op - offset];
+    }
+    return op == n;
+}
+
+inline void shuffle8(const uint8_t* src, size_t count, uint8_t* dst) {
+    for (size_t i = 0; i < count; i++) {
+        for (size_t b = 0; b < 8; b++) dst[b * count + i] = src[8 * i + b];
+    }
+}
+
+inline void unshuffle8(const uint8_t* src, size_t count, uint8_t* dst) {
+    for (size_t i = 0; i < count; i++) {
+        for (size_t b = 0; b < 8; b++) dst[8 * i + b] = src[b * count + i];
+    }
+}
+
+// NaN / inf from the exponent bits (comparisons fold away under -ffast-math)
+inline bool isNonFinite(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x7FF0000000000000ull) == 0x7FF0000000000000ull;
+}
+
+/**
+ * Quantized words of one chunk; false if it must be stored losslessly
+ */
+inline bool quantizeChunk(const double* x, size_t count, double error_bound, std::vector<uint64_t>& words) {
+    const double step = 2.0 * error_bound;
+    words.resize(count);
+    int64_t previous = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (isNonFinite(x[i])) return false;
+        const double scaled = x[i] / step;
+        if (isNonFinite(scaled) || !(std::abs(scaled) < kMaxQuantized)) return false;
+        const int64_t q = std::llround(scaled);
+        if (!(std::abs(static_cast<double>(q) * step - x[i]) <= error_bound)) return false;
+        const int64_t delta = q - previous;
+        previous = q;
+        words[i] = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+    }
+    return true;
+}
+
+inline void encodeChunk(const double* x, size_t count, const SnapshotCodecOptions& options,
+                        std::vector<uint8_t>& out) {
+    const size_t bytes = count * sizeof(double);
+    std::vector<uint8_t> shuffled(bytes);
+    uint8_t mode = kChunkShuffleLZ;
+
+    std::vector<uint64_t> words;
+    if (options.codec == SnapshotCodec::Quantized && quantizeChunk(x, count, options.error_bound, words)) {
+        mode = kChunkQuantizedLZ;
+        shuffle8(reinterpret_cast<const uint8_t*>(words.data()), count, shuffled.data());
+    } else {
+        // XOR with the previous value clears the bytes neighbours share
+        words.resize(count);
+        uint64_t previous = 0;
+        for (size_t i = 0; i < count; i++) {
+            uint64_t bits;
+            std::memcpy(&bits, x + i, sizeof(bits));
+            words[i] = bits ^ previous;
+            previous = bits;
+        }
+        shuffle8(reinterpret_cast<const uint8_t*>(words.data()), count, shuffled.data());
+    }
+
+    out.clear();
+    out.push_back(mode);
+    lzCompress(shuffled.data(), bytes, out);
+    if (out.size() >= 1 + bytes) {
+        out.assign(1, kChunkStored);
+        out.insert(out.end(), reinterpret_cast<const uint8_t*>(x), reinterpret_cast<const uint8_t*>(x) + bytes);
+    }
+}
+
+inline bool decodeChunk(const uint8_t* src, size_t size, size_t count, double error_bound, double* x) {
+    if (size < 1) return false;
+    const uint8_t mode = src[0];
+    const size_t bytes = count * sizeof(double);
+    if (mode == kChunkStored) {
+        if (size - 1 != bytes) return false;
+        std::memcpy(x, src + 1, bytes);
+        return true;
+    }
+    if (mode != kChunkShuffleLZ && mode != kChunkQuantizedLZ) return false;
+
+    std::vector<uint8_t> shuffled(bytes);
+    if (!lzDecompress(src + 1, size - 1, shuffled.data(), bytes)) return false;
+    std::vector<uint64_t> words(count);
+    unshuffle8(shuffled.data(), count, reinterpret_cast<uint8_t*>(words.data()));
+    if (mode == kChunkShuffleLZ) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < count; i++) {
+            bits ^= words[i];
+            std::memcpy(x + i, &bits, sizeof(bits));
+        }
+        return true;
+    }
+
+    const double step = 2.0 * error_bound;
+    int64_t q = 0;
+    for (size_t i = 0; i < count; i++) {
+        q += static_cast<int64_t>((words[i] >> 1) ^ (~(words[i] & 1) + 1));
+        x[i] = static_cast<double>(q) * step;
+    }
+    return true;
+}
+
+struct FieldLayout {
+    SnapshotCodec codec;
+    size_t chunk_values;
+    size_t count;
+    double error_bound;
+    std::vector<size_t> chunk_offsets;  // chunk_count + 1 entries into the encoded bytes
+};
+
+inline bool parseField(const uint8_t* bytes, size_t size, FieldLayout& layout) {
+    if (size < kFieldHeaderBytes) return false;
+    const uint32_t codec = get<uint32_t>(bytes);
+    layout.chunk_values = get<uint32_t>(bytes + 4);
+    layout.count = static_cast<size_t>(get<uint64_t>(bytes + 8));
+    layout.error_bound = get<double>(bytes + 16);
+    const size_t chunks = get<uint32_t>(bytes + 24);
+    if ((codec != static_cast<uint32_t>(SnapshotCodec::Lossless) &&
+         codec != static_cast<uint32_t>(SnapshotCodec::Quantized)) ||
+        layout.chunk_values == 0 ||
+        chunks != (layout.count + layout.chunk_values - 1) / layout.chunk_values ||
+        (size - kFieldHeaderBytes) / 4 < chunks) {
+        return false;
+    }
+    layout.codec = static_cast<SnapshotCodec>(codec);
+
+    layout.chunk_offsets.resize(chunks + 1);
+    size_t offset = kFieldHeaderBytes + 4 * chunks;
+    for (size_t k = 0; k < chunks; k++) {
+        layout.chunk_offsets[k] = offset;
+        offset += get<uint32_t>(bytes + kFieldHeaderBytes + 4 * k);
+    }
+    layout.chunk_offsets[chunks] = offset;
+    return offset == size;
+}
+
+} // namespace snapshot_codec_detail
+
+/**
+ * Encode data[0, count) with options.codec (Lossless or Quantized)
+ */
+inline std::vector<uint8_t> encodeSnapshotField(const double* data, size_t count,
+                                                const SnapshotCodecOptions& options) {
+    using namespace snapshot_codec_detail;
+    SnapshotCodecOptions opts = options;
+    if (opts.codec != SnapshotCodec::Quantized || !(opts.error_bound > 0.0)) {
+        opts.codec = SnapshotCodec::Lossless;
+        opts.error_bound = 0.0;
+    }
+    const size_t chunk_values = std::max<uint32_t>(opts.chunk_values, 1);
+    const size_t chunks = (count + chunk_values - 1) / chunk_values;
+
+    std::vector<std::vector<uint8_t>> encoded(chunks);
+    #pragma omp parallel for schedule(dynamic, 1) if (chunks > 1)
+    for (long long k = 0; k < static_cast<long long>(chunks); k++) {
+        const size_t first = static_cast<size_t>(k) * chunk_values;
+        encodeChunk(data + first, std::min(chunk_values, count - first), opts, encoded[k]);
+    }
+
+    size_t total = kFieldHeaderBytes + 4 * chunks;
+    for (const auto& chunk : encoded) total += chunk.size();
+    std::vector<uint8_t> out(kFieldHeaderBytes + 4 * chunks);
+    out.reserve(total);
+    put(out, 0, static_cast<uint32_t>(opts.codec));
+    put(out, 4, static_cast<uint32_t>(chunk_values));
+    put(out, 8, static_cast<uint64_t>(count));
+    put(out, 16, opts.error_bound);
+    put(out, 24, static_cast<uint32_t>(chunks));
+    for (size_t k = 0; k < chunks; k++) {
+        put(out, kFieldHeaderBytes + 4 * k, static_cast<uint32_t>(encoded[k].size()));
+    }
+    for (const auto& chunk : encoded) out.insert(out.end(), chunk.begin(), chunk.end());
+    return out;
+}
+
+/**
+ * Number of doubles in an encoded field; 0 if the bytes are not one
+ */
+inline size_t snapshotFieldCount(const uint8_t* bytes, size_t size) {
+    snapshot_codec_detail::FieldLayout layout;
+    return snapshot_codec_detail::parseField(bytes, size, layout) ? layout.count : 0;
+}
+
+/**
+ * Decode out[0, count) = field[first, first + count), touching only the
+ * chunks that overlap the range; false on malformed input or a range
+ * past the end
+ */
+inline bool decodeSnapshotRange(const uint8_t* bytes, size_t size, size_t first, size_t count, double* out) {
+    using namespace snapshot_codec_detail;
+    FieldLayout layout;
+    if (!parseField(bytes, size, layout) || first > layout.count || count > layout.count - first) {
+        return false;
+    }
+    if (count == 0) return true;
+
+    const size_t chunk_values = layout.chunk_values;
+    const size_t k_begin = first / chunk_values;
+    const size_t k_end = (first + count - 1) / chunk_values + 1;
+    bool ok = true;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(&& : ok) if (k_end - k_begin > 1)
+    for (long long k = static_cast<long long>(k_begin); k < static_cast<long long>(k_end); k++) {
+        const size_t chunk_first = static_cast<size_t>(k) * chunk_values;
+        const size_t chunk_count = std::min(chunk_values, layout.count - chunk_first);
+        const size_t lo = std::max(first, chunk_first);
+        const size_t hi = std::min(first + count, chunk_first + chunk_count);
+        const uint8_t* src = bytes + layout.chunk_offsets[k];
+        const size_t src_size = layout.chunk_offsets[k + 1] - layout.chunk_offsets[k];
+        if (lo == chunk_first && hi == chunk_first + chunk_count) {
+            ok = decodeChunk(src, src_size, chunk_count, layout.error_bound, out + (lo - first)) && ok;
+        } else {
+            std::vector<double> scratch(chunk_count);
+            const bool chunk_ok = decodeChunk(src, src_size, chunk_count, layout.error_bound, scratch.data());
+            if (chunk_ok) {
+                std::copy(scratch.begin() + (lo - chunk_first), scratch.begin() + (hi - chunk_first),
+                          out + (lo - first));
+            }
+            ok = chunk_ok && ok;
+        }
+    }
+    return ok;
+}
+
+/**
+ * Decode a whole encoded field into out (resized to its count)
+ */
+inline bool decodeSnapshotField(const uint8_t* bytes, size_t size, std::vector<double>& out) {
+    snapshot_codec_detail::FieldLayout layout;
+    if (!snapshot_codec_detail::parseField(bytes, size, layout)) {
+        return false;
+    }
+    out.resize(layout.count);
+    return decodeSnapshotRange(bytes, size, 0, layout.count, out.data());
+}
+
+} // namespace dase
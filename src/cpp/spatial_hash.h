@@ -4,192 +4,287 @@
  * Quantum Walk-inspired spatial partitioning for O(1) neighbor queries
  * Instead of checking all N nodes, only check nodes in nearby cells
  *
+ * Cells form a dense grid over the lattice (ceil(N / cell_size) per
+ * axis). insert() stages points; finalize() counting-sorts them into CSR
+ * form: the nodes of cell c are cell_nodes_[cell_offsets_[c],
+ * cell_offsets_[c + 1]), in insertion order. Queries walk the cell range
+ * directly, either through a visitor or into a caller-owned buffer, and
+ * never allocate. There is no wrap-around: cells past the grid edge are
+ * empty, and points outside the lattice land in the nearest edge cell.
+ *
+ *   SpatialHash2D grid(N_x, N_y, R_c);
+ *   for (...) grid.insert(id, x, y);
+ *   grid.finalize();
+ *   grid.forEachCandidate(x, y, range, [&](int j) { ... });
+ *
  * Expected speedup: 5-20x for neighbor search
  */
 
 #pragma once
 
 #include <vector>
-#include <unordered_map>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <algorithm>
 
 namespace dase {
 namespace igsoa {
 
+/**
+ * Counting-sort CSR storage shared by the 1D/2D/3D grids
+ */
+class SpatialGridCSR {
+protected:
+    std::vector<uint32_t> cell_offsets_;   // num_cells + 1 after finalize()
+    std::vector<int> cell_nodes_;
+    std::vector<int> staged_ids_;
+    std::vector<uint32_t> staged_cells_;
+    size_t num_cells_ = 0;
+
+    void stage(int node_id, size_t cell) {
+        staged_ids_.push_back(node_id);
+        staged_cells_.push_back(static_cast<uint32_t>(cell));
+    }
+
+    // Visit the nodes of cell c
+    template <typename Visit>
+    void visitCell(size_t c, Visit& visit) const {
+        for (uint32_t k = cell_offsets_[c]; k < cell_offsets_[c + 1]; ++k) {
+            visit(cell_nodes_[k]);
+        }
+    }
+
+    static int clampCell(int c, size_t cells) {
+        return std::min(std::max(c, 0), static_cast<int>(cells) - 1);
+    }
+
+public:
+    void clear() {
+        cell_offsets_.clear();
+        cell_nodes_.clear();
+        staged_ids_.clear();
+        staged_cells_.clear();
+    }
+
+    /**
+     * Sort the staged points into cells (call after the inserts, before
+     * querying; inserting again needs another finalize())
+     */
+    void finalize() {
+        cell_offsets_.assign(num_cells_ + 1, 0);
+        for (uint32_t cell : staged_cells_) {
+            cell_offsets_[cell + 1]++;
+        }
+        for (size_t c = 0; c < num_cells_; ++c) {
+            cell_offsets_[c + 1] += cell_offsets_[c];
+        }
+
+        std::vector<uint32_t> cursor(cell_offsets_.begin(), cell_offsets_.end() - 1);
+        cell_nodes_.resize(staged_ids_.size());
+        for (size_t k = 0; k < staged_ids_.size(); ++k) {
+            cell_nodes_[cursor[staged_cells_[k]]++] = staged_ids_[k];
+        }
+    }
+
+    bool isFinalized() const { return cell_offsets_.size() == num_cells_ + 1; }
+
+    size_t getNumCells() const { return num_cells_; }
+
+    size_t getMemoryUsage() const {
+        return cell_offsets_.capacity() * sizeof(uint32_t) +
+               cell_nodes_.capacity() * sizeof(int) +
+               staged_ids_.capacity() * sizeof(int) +
+               staged_cells_.capacity() * sizeof(uint32_t);
+    }
+};
+
 /**
  * 1D Spatial Hash
  */
-class SpatialHash1D {
+class SpatialHash1D : public SpatialGridCSR {
 private:
-    std::unordered_map<int, std::vector<int>> cells_;
     int cell_size_;
     size_t N_;
+    size_t cells_x_;
 
 public:
     explicit SpatialHash1D(size_t N, double R_c)
-        : N_(N)
-        , cell_size_(std::max(1, static_cast<int>(R_c)))
-    {}
-
-    void clear() {
-        cells_.clear();
+        : cell_size_(std::max(1, static_cast<int>(R_c)))
+        , N_(N)
+    {
+        cells_x_ = std::max<size_t>(1, (N_ + cell_size_ - 1) / cell_size_);
+        num_cells_ = cells_x_;
     }
 
     void insert(int node_id, int x) {
-        int cell_x = x / cell_size_;
-        cells_[cell_x].push_back(node_id);
+        stage(node_id, static_cast<size_t>(clampCell(x / cell_size_, cells_x_)));
     }
 
-    std::vector<int> query(int x, int range) const {
-        std::vector<int> result;
-        int cell_x = x / cell_size_;
-        int cell_range = (range + cell_size_ - 1) / cell_size_;
-
-        for (int dx = -cell_range; dx <= cell_range; ++dx) {
-            int key = cell_x + dx;
-            auto it = cells_.find(key);
-            if (it != cells_.end()) {
-                result.insert(result.end(), it->second.begin(), it->second.end());
-            }
+    /**
+     * Call visit(node_id) for every node in the cells within range of x
+     */
+    template <typename Visit>
+    void forEachCandidate(int x, int range, Visit&& visit) const {
+        if (!isFinalized()) return;
+        const int cell_x = x / cell_size_;
+        const int cell_range = (range + cell_size_ - 1) / cell_size_;
+        const int lo = std::max(cell_x - cell_range, 0);
+        const int hi = std::min(cell_x + cell_range, static_cast<int>(cells_x_) - 1);
+        for (int cx = lo; cx <= hi; ++cx) {
+            visitCell(static_cast<size_t>(cx), visit);
         }
+    }
+
+    /**
+     * Candidates into result (cleared first; its capacity is reused)
+     */
+    void query(int x, int range, std::vector<int>& result) const {
+        result.clear();
+        forEachCandidate(x, range, [&result](int id) { result.push_back(id); });
+    }
 
+    std::vector<int> query(int x, int range) const {
+        std::vector<int> result;
+        query(x, range, result);
         return result;
     }
+
+    int getCellSize() const { return cell_size_; }
 };
 
 /**
  * 2D Spatial Hash
  */
-class SpatialHash2D {
+class SpatialHash2D : public SpatialGridCSR {
 private:
-    std::unordered_map<int64_t, std::vector<int>> cells_;
     int cell_size_;
     size_t N_x_, N_y_;
-
-    // Hash function for 2D coordinates
-    inline int64_t hash2D(int cx, int cy) const {
-        return (static_cast<int64_t>(cx) << 32) | static_cast<int64_t>(cy);
-    }
+    size_t cells_x_, cells_y_;
 
 public:
     explicit SpatialHash2D(size_t N_x, size_t N_y, double R_c)
-        : N_x_(N_x)
+        : cell_size_(std::max(1, static_cast<int>(R_c)))
+        , N_x_(N_x)
         , N_y_(N_y)
-        , cell_size_(std::max(1, static_cast<int>(R_c)))
-    {}
-
-    void clear() {
-        cells_.clear();
+    {
+        cells_x_ = std::max<size_t>(1, (N_x_ + cell_size_ - 1) / cell_size_);
+        cells_y_ = std::max<size_t>(1, (N_y_ + cell_size_ - 1) / cell_size_);
+        num_cells_ = cells_x_ * cells_y_;
     }
 
     void insert(int node_id, int x, int y) {
-        int cell_x = x / cell_size_;
-        int cell_y = y / cell_size_;
-        int64_t key = hash2D(cell_x, cell_y);
-        cells_[key].push_back(node_id);
+        const size_t cx = static_cast<size_t>(clampCell(x / cell_size_, cells_x_));
+        const size_t cy = static_cast<size_t>(clampCell(y / cell_size_, cells_y_));
+        stage(node_id, cy * cells_x_ + cx);
     }
 
-    std::vector<int> query(int x, int y, int range) const {
-        std::vector<int> result;
-        result.reserve(100);  // Pre-allocate
-
-        int cell_x = x / cell_size_;
-        int cell_y = y / cell_size_;
-        int cell_range = (range + cell_size_ - 1) / cell_size_;
-
-        // Query 3x3 (or larger) cell neighborhood
-        for (int dy = -cell_range; dy <= cell_range; ++dy) {
-            for (int dx = -cell_range; dx <= cell_range; ++dx) {
-                int64_t key = hash2D(cell_x + dx, cell_y + dy);
-                auto it = cells_.find(key);
-                if (it != cells_.end()) {
-                    result.insert(result.end(), it->second.begin(), it->second.end());
-                }
+    /**
+     * Call visit(node_id) for every node in the 3x3 (or larger) cell
+     * neighborhood of (x, y)
+     */
+    template <typename Visit>
+    void forEachCandidate(int x, int y, int range, Visit&& visit) const {
+        if (!isFinalized()) return;
+        const int cell_range = (range + cell_size_ - 1) / cell_size_;
+        const int cell_x = x / cell_size_;
+        const int cell_y = y / cell_size_;
+        const int x_lo = std::max(cell_x - cell_range, 0);
+        const int x_hi = std::min(cell_x + cell_range, static_cast<int>(cells_x_) - 1);
+        const int y_lo = std::max(cell_y - cell_range, 0);
+        const int y_hi = std::min(cell_y + cell_range, static_cast<int>(cells_y_) - 1);
+        for (int cy = y_lo; cy <= y_hi; ++cy) {
+            for (int cx = x_lo; cx <= x_hi; ++cx) {
+                visitCell(static_cast<size_t>(cy) * cells_x_ + static_cast<size_t>(cx), visit);
             }
         }
+    }
 
-        return result;
+    /**
+     * Candidates into result (cleared first; its capacity is reused)
+     */
+    void query(int x, int y, int range, std::vector<int>& result) const {
+        result.clear();
+        forEachCandidate(x, y, range, [&result](int id) { result.push_back(id); });
     }
 
-    size_t getMemoryUsage() const {
-        size_t total = 0;
-        for (const auto& pair : cells_) {
-            total += pair.second.capacity() * sizeof(int);
-        }
-        return total + cells_.size() * (sizeof(int64_t) + sizeof(std::vector<int>));
+    std::vector<int> query(int x, int y, int range) const {
+        std::vector<int> result;
+        query(x, y, range, result);
+        return result;
     }
+
+    int getCellSize() const { return cell_size_; }
 };
 
 /**
  * 3D Spatial Hash
  */
-class SpatialHash3D {
+class SpatialHash3D : public SpatialGridCSR {
 private:
-    std::unordered_map<int64_t, std::vector<int>> cells_;
     int cell_size_;
     size_t N_x_, N_y_, N_z_;
-
-    // Hash function for 3D coordinates (Morton code inspired)
-    inline int64_t hash3D(int cx, int cy, int cz) const {
-        // Pack into 64-bit: 21 bits each for x,y,z (supports up to 2M cells per dimension)
-        int64_t hx = static_cast<int64_t>(cx) & 0x1FFFFF;
-        int64_t hy = static_cast<int64_t>(cy) & 0x1FFFFF;
-        int64_t hz = static_cast<int64_t>(cz) & 0x1FFFFF;
-        return (hx << 42) | (hy << 21) | hz;
-    }
+    size_t cells_x_, cells_y_, cells_z_;
 
 public:
     explicit SpatialHash3D(size_t N_x, size_t N_y, size_t N_z, double R_c)
-        : N_x_(N_x)
+        : cell_size_(std::max(1, static_cast<int>(R_c)))
+        , N_x_(N_x)
         , N_y_(N_y)
         , N_z_(N_z)
-        , cell_size_(std::max(1, static_cast<int>(R_c)))
-    {}
-
-    void clear() {
-        cells_.clear();
+    {
+        cells_x_ = std::max<size_t>(1, (N_x_ + cell_size_ - 1) / cell_size_);
+        cells_y_ = std::max<size_t>(1, (N_y_ + cell_size_ - 1) / cell_size_);
+        cells_z_ = std::max<size_t>(1, (N_z_ + cell_size_ - 1) / cell_size_);
+        num_cells_ = cells_x_ * cells_y_ * cells_z_;
     }
 
     void insert(int node_id, int x, int y, int z) {
-        int cell_x = x / cell_size_;
-        int cell_y = y / cell_size_;
-        int cell_z = z / cell_size_;
-        int64_t key = hash3D(cell_x, cell_y, cell_z);
-        cells_[key].push_back(node_id);
+        const size_t cx = static_cast<size_t>(clampCell(x / cell_size_, cells_x_));
+        const size_t cy = static_cast<size_t>(clampCell(y / cell_size_, cells_y_));
+        const size_t cz = static_cast<size_t>(clampCell(z / cell_size_, cells_z_));
+        stage(node_id, (cz * cells_y_ + cy) * cells_x_ + cx);
     }
 
-    std::vector<int> query(int x, int y, int z, int range) const {
-        std::vector<int> result;
-        result.reserve(200);  // Pre-allocate for 3D
-
-        int cell_x = x / cell_size_;
-        int cell_y = y / cell_size_;
-        int cell_z = z / cell_size_;
-        int cell_range = (range + cell_size_ - 1) / cell_size_;
-
-        // Query 3x3x3 (or larger) cell neighborhood
-        for (int dz = -cell_range; dz <= cell_range; ++dz) {
-            for (int dy = -cell_range; dy <= cell_range; ++dy) {
-                for (int dx = -cell_range; dx <= cell_range; ++dx) {
-                    int64_t key = hash3D(cell_x + dx, cell_y + dy, cell_z + dz);
-                    auto it = cells_.find(key);
-                    if (it != cells_.end()) {
-                        result.insert(result.end(), it->second.begin(), it->second.end());
-                    }
+    /**
+     * Call visit(node_id) for every node in the 3x3x3 (or larger) cell
+     * neighborhood of (x, y, z)
+     */
+    template <typename Visit>
+    void forEachCandidate(int x, int y, int z, int range, Visit&& visit) const {
+        if (!isFinalized()) return;
+        const int cell_range = (range + cell_size_ - 1) / cell_size_;
+        const int cell_x = x / cell_size_;
+        const int cell_y = y / cell_size_;
+        const int cell_z = z / cell_size_;
+        const int x_lo = std::max(cell_x - cell_range, 0);
+        const int x_hi = std::min(cell_x + cell_range, static_cast<int>(cells_x_) - 1);
+        const int y_lo = std::max(cell_y - cell_range, 0);
+        const int y_hi = std::min(cell_y + cell_range, static_cast<int>(cells_y_) - 1);
+        const int z_lo = std::max(cell_z - cell_range, 0);
+        const int z_hi = std::min(cell_z + cell_range, static_cast<int>(cells_z_) - 1);
+        for (int cz = z_lo; cz <= z_hi; ++cz) {
+            for (int cy = y_lo; cy <= y_hi; ++cy) {
+                for (int cx = x_lo; cx <= x_hi; ++cx) {
+                    visitCell((static_cast<size_t>(cz) * cells_y_ + static_cast<size_t>(cy)) * cells_x_ +
+                              static_cast<size_t>(cx), visit);
                 }
             }
         }
+    }
 
-        return result;
+    /**
+     * Candidates into result (cleared first; its capacity is reused)
+     */
+    void query(int x, int y, int z, int range, std::vector<int>& result) const {
+        result.clear();
+        forEachCandidate(x, y, z, range, [&result](int id) { result.push_back(id); });
     }
 
-    size_t getMemoryUsage() const {
-        size_t total = 0;
-        for (const auto& pair : cells_) {
-            total += pair.second.capacity() * sizeof(int);
-        }
-        return total + cells_.size() * (sizeof(int64_t) + sizeof(std::vector<int>));
+    std::vector<int> query(int x, int y, int z, int range) const {
+        std::vector<int> result;
+        query(x, y, z, range, result);
+        return result;
     }
 
     int getCellSize() const { return cell_size_; }
@@ -3,14 +3,52 @@
 #include <iomanip>
 #include <ctime>
 #include <chrono>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
 
 namespace igsoa {
 
+/**
+ * One preformatted async log record (fixed size, copied by value)
+ */
+struct Logger::Record {
+    int64_t time_ns;                ///< Wall-clock time of the call
+    int line;                       ///< Source line (-1: none)
+    Level level;                    ///< Severity
+    bool truncated;                 ///< Message longer than kRecordText
+    uint16_t length;                ///< Message bytes in text
+    char file[40];                  ///< Source file name without directories ("" if none)
+    char text[kRecordText + 1];     ///< Message bytes (room for vsnprintf's terminator)
+};
+
+/**
+ * Single-producer / single-consumer ring of one logging thread
+ *
+ * The owning thread advances head after filling a slot; the drain thread
+ * advances tail after copying it out.
+ */
+struct Logger::AsyncRing {
+    explicit AsyncRing(size_t capacity) : records(capacity), mask(capacity - 1) {}
+
+    std::vector<Record> records;
+    const size_t mask;
+    alignas(64) std::atomic<uint64_t> head{0};      ///< Next slot to fill (owner thread)
+    alignas(64) std::atomic<uint64_t> tail{0};      ///< Next slot to drain (drain thread)
+    alignas(64) std::atomic<uint64_t> dropped{0};   ///< Records lost to a full ring
+    std::atomic<uint64_t> truncated{0};             ///< Messages cut to kRecordText
+};
+
 Logger::Logger()
     : console_level_(Level::WARNING),
       file_level_(Level::DEBUG),
       initialized_(false),
-      filename_("igsoa_sim.log") {
+      filename_("igsoa_sim.log"),
+      async_(false),
+      async_generation_(0),
+      drain_stop_(false),
+      written_(0) {
 }
 
 Logger::~Logger() {
@@ -67,22 +105,304 @@ void Logger::setFileLevel(Level level) {
 }
 
 void Logger::log(Level level, const std::string& message, const char* file, int line) {
+    if (!wouldLog(level)) {
+        return;
+    }
+
+    if (isAsync()) {
+        AsyncRing& ring = threadRing();
+        Record* record = reserveRecord(ring);
+        if (record != nullptr) {
+            const size_t length = std::min(message.size(), kRecordText);
+            std::memcpy(record->text, message.data(), length);
+            record->length = static_cast<uint16_t>(length);
+            record->truncated = message.size() > kRecordText;
+            commitRecord(ring, *record, level, file, line);
+        }
+        if (level == Level::FATAL) {
+            flush();
+        }
+        return;
+    }
+
+    const std::string formatted_message =
+        formatLine(level, nowNanoseconds(), file, line, message.data(), message.size());
+
     std::lock_guard<std::mutex> lock(mutex_);
+    writeLine(level, formatted_message);
+}
 
-    // Build log message
-    std::ostringstream oss;
-    oss << "[" << getCurrentTimestamp() << "] ";
-    oss << "[" << levelToString(level) << "] ";
+void Logger::logf(Level level, const char* file, int line, const char* format, ...) {
+    if (!wouldLog(level)) {
+        return;
+    }
 
-    // Add file:line if provided
+    va_list args;
+    va_start(args, format);
+
+    if (isAsync()) {
+        AsyncRing& ring = threadRing();
+        Record* record = reserveRecord(ring);
+        if (record != nullptr) {
+            // Formatted straight into the slot; vsnprintf reports the untruncated length
+            const int needed = std::vsnprintf(record->text, sizeof(record->text), format, args);
+            const size_t length = needed < 0 ? 0 : std::min(static_cast<size_t>(needed), kRecordText);
+            record->length = static_cast<uint16_t>(length);
+            record->truncated = needed > static_cast<int>(kRecordText);
+            commitRecord(ring, *record, level, file, line);
+        }
+        va_end(args);
+        if (level == Level::FATAL) {
+            flush();
+        }
+        return;
+    }
+
+    va_list copy;
+    va_copy(copy, args);
+    const int needed = std::vsnprintf(nullptr, 0, format, copy);
+    va_end(copy);
+    std::string message(needed > 0 ? static_cast<size_t>(needed) : 0, '\0');
+    if (needed > 0) {
+        std::vsnprintf(&message[0], message.size() + 1, format, args);
+    }
+    va_end(args);
+
+    log(level, message, file, line);
+}
+
+void Logger::shutdown() {
+    disableAsync();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (initialized_ && file_.is_open()) {
+        file_ << "\n========================================\n";
+        file_ << "Logger shutdown: " << getCurrentTimestamp() << "\n";
+        file_ << "========================================\n\n";
+        file_.close();
+    }
+
+    initialized_ = false;
+}
+
+void Logger::enableAsync(const AsyncConfig& config) {
+    disableAsync();
+
+    async_config_ = config;
+    size_t capacity = 2;
+    while (capacity < config.ring_capacity) {
+        capacity <<= 1;
+    }
+    async_config_.ring_capacity = capacity;
+
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.clear();
+    }
+    written_.store(0, std::memory_order_relaxed);
+    drain_stop_.store(false, std::memory_order_relaxed);
+    async_generation_.fetch_add(1, std::memory_order_acq_rel);
+
+    drain_thread_ = std::thread(&Logger::drainLoop, this);
+    async_.store(true, std::memory_order_release);
+}
+
+void Logger::disableAsync() {
+    if (!async_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        drain_stop_.store(true, std::memory_order_release);
+    }
+    drain_cv_.notify_one();
+    if (drain_thread_.joinable()) {
+        drain_thread_.join();
+    }
+}
+
+void Logger::flush() {
+    if (!isAsync()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_.is_open()) {
+            file_.flush();
+        }
+        return;
+    }
+
+    // Every record published so far; rings only count up
+    uint64_t target = 0;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (const auto& ring : rings_) {
+            target += ring->head.load(std::memory_order_acquire);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    drain_cv_.notify_one();
+    flushed_cv_.wait(lock, [&]() {
+        return written_.load(std::memory_order_acquire) >= target ||
+               !async_.load(std::memory_order_acquire);
+    });
+}
+
+Logger::AsyncStats Logger::getAsyncStats() const {
+    AsyncStats stats;
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (const auto& ring : rings_) {
+        stats.enqueued += ring->head.load(std::memory_order_acquire);
+        stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+        stats.truncated += ring->truncated.load(std::memory_order_relaxed);
+    }
+    stats.written = written_.load(std::memory_order_acquire);
+    stats.threads = rings_.size();
+    return stats;
+}
+
+Logger::AsyncRing& Logger::threadRing() {
+    // Cached per thread; a new enableAsync() session invalidates the cache
+    thread_local AsyncRing* ring = nullptr;
+    thread_local uint64_t generation = 0;
+
+    const uint64_t current = async_generation_.load(std::memory_order_acquire);
+    if (ring == nullptr || generation != current) {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(std::make_unique<AsyncRing>(async_config_.ring_capacity));
+        ring = rings_.back().get();
+        generation = current;
+    }
+    return *ring;
+}
+
+Logger::Record* Logger::reserveRecord(AsyncRing& ring) {
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    const uint64_t capacity = ring.records.size();
+
+    if (head - ring.tail.load(std::memory_order_acquire) >= capacity) {
+        if (async_config_.overflow == OverflowPolicy::Drop) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        // Backpressure: wait for the drain thread, bounded by block_timeout_us
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::microseconds(async_config_.block_timeout_us);
+        drain_cv_.notify_one();
+        while (head - ring.tail.load(std::memory_order_acquire) >= capacity) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                ring.dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    return &ring.records[head & ring.mask];
+}
+
+void Logger::commitRecord(AsyncRing& ring, Record& record, Level level, const char* file, int line) {
+    record.time_ns = nowNanoseconds();
+    record.level = level;
+    record.line = line;
+    record.file[0] = '\0';
     if (file != nullptr && line >= 0) {
-        oss << "[" << extractFilename(file) << ":" << line << "] ";
+        const char* name = file;
+        for (const char* p = file; *p != '\0'; ++p) {
+            if (*p == '/' || *p == '\\') {
+                name = p + 1;
+            }
+        }
+        std::strncpy(record.file, name, sizeof(record.file) - 1);
+        record.file[sizeof(record.file) - 1] = '\0';
     }
+    if (record.truncated) {
+        ring.truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void Logger::drainLoop() {
+    std::vector<Record> batch;
+    batch.reserve(async_config_.ring_capacity);
 
-    oss << message;
+    while (true) {
+        const bool stopping = drain_stop_.load(std::memory_order_acquire);
+        const size_t drained = drainOnce(batch);
 
-    std::string formatted_message = oss.str();
+        {
+            std::lock_guard<std::mutex> lock(drain_mutex_);
+        }
+        flushed_cv_.notify_all();
+
+        if (drained > 0) {
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
 
+        // Woken early by flush(), a blocked producer or disableAsync()
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        if (!drain_stop_.load(std::memory_order_acquire)) {
+            drain_cv_.wait_for(lock, std::chrono::microseconds(async_config_.drain_interval_us));
+        }
+    }
+
+    // Release flush() callers that raced with disableAsync()
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+    }
+    flushed_cv_.notify_all();
+}
+
+size_t Logger::drainOnce(std::vector<Record>& batch) {
+    batch.clear();
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (const auto& ring : rings_) {
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            for (; tail != head; ++tail) {
+                batch.push_back(ring->records[tail & ring->mask]);
+            }
+            ring->tail.store(tail, std::memory_order_release);
+        }
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+
+    // Interleave the threads by call time
+    std::stable_sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) {
+        return a.time_ns < b.time_ns;
+    });
+
+    std::string line;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Record& record : batch) {
+            line = formatLine(record.level, record.time_ns,
+                              record.file[0] != '\0' ? record.file : nullptr, record.line,
+                              record.text, record.length);
+            if (record.truncated) {
+                line += "...";
+            }
+            writeLine(record.level, line);
+        }
+        if (initialized_ && file_.is_open()) {
+            file_.flush();
+        }
+    }
+
+    written_.fetch_add(batch.size(), std::memory_order_acq_rel);
+    return batch.size();
+}
+
+void Logger::writeLine(Level level, const std::string& formatted_message) {
     // Log to console if level is sufficient
     if (shouldLog(level, console_level_)) {
         if (level >= Level::ERROR) {
@@ -95,21 +415,36 @@ void Logger::log(Level level, const std::string& message, const char* file, int
     // Log to file if initialized and level is sufficient
     if (initialized_ && file_.is_open() && shouldLog(level, file_level_)) {
         file_ << formatted_message << "\n";
-        file_.flush();  // Ensure immediate write (important for errors)
+        if (!isAsync()) {
+            file_.flush();  // Ensure immediate write (important for errors); async flushes per batch
+        }
     }
 }
 
-void Logger::shutdown() {
-    std::lock_guard<std::mutex> lock(mutex_);
+std::string Logger::formatLine(Level level, int64_t time_ns, const char* file, int line,
+                               const char* message, size_t length) {
+    std::ostringstream oss;
+    oss << "[" << formatTimestamp(time_ns) << "] ";
+    oss << "[" << levelToString(level) << "] ";
 
-    if (initialized_ && file_.is_open()) {
-        file_ << "\n========================================\n";
-        file_ << "Logger shutdown: " << getCurrentTimestamp() << "\n";
-        file_ << "========================================\n\n";
-        file_.close();
+    // Add file:line if provided
+    if (file != nullptr && line >= 0) {
+        oss << "[" << extractFilename(file) << ":" << line << "] ";
     }
 
-    initialized_ = false;
+    oss.write(message, static_cast<std::streamsize>(length));
+    return oss.str();
+}
+
+bool Logger::wouldLog(Level level) const {
+    return shouldLog(level, console_level_.load(std::memory_order_relaxed)) ||
+           (initialized_ && shouldLog(level, file_level_.load(std::memory_order_relaxed)));
+}
+
+int64_t Logger::nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
 }
 
 const char* Logger::levelToString(Level level) {
@@ -124,12 +459,14 @@ const char* Logger::levelToString(Level level) {
 }
 
 std::string Logger::getCurrentTimestamp() {
-    // Get current time
-    auto now = std::chrono::system_clock::now();
+    return formatTimestamp(nowNanoseconds());
+}
+
+std::string Logger::formatTimestamp(int64_t time_ns) {
+    const auto now = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(time_ns)));
     auto now_c = std::chrono::system_clock::to_time_t(now);
-    auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()
-    ) % 1000;
+    auto now_ms = (time_ns / 1000000) % 1000;
 
     // Format: YYYY-MM-DD HH:MM:SS.mmm
     std::ostringstream oss;
@@ -142,7 +479,7 @@ std::string Logger::getCurrentTimestamp() {
 #endif
 
     oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-    oss << "." << std::setfill('0') << std::setw(3) << now_ms.count();
+    oss << "." << std::setfill('0') << std::setw(3) << now_ms;
 
     return oss.str();
 }
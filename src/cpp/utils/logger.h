@@ -6,6 +6,11 @@
 #include <mutex>
 #include <memory>
 #include <sstream>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+#include <vector>
 
 namespace igsoa {
 
@@ -20,6 +25,18 @@ namespace igsoa {
  *   Logger::getInstance().initialize("simulation.log");
  *   LOG_INFO("Simulation started with N=" + std::to_string(N));
  *   LOG_ERROR("Failed to allocate memory");
+ *
+ * Asynchronous mode (enableAsync): each logging thread owns a lock-free
+ * single-producer ring of fixed-size records (raw timestamp, level,
+ * file:line and message bytes). A background drain thread formats the
+ * records and does all console/file I/O, so logging from OpenMP regions
+ * no longer serializes the threads on the mutex. When a ring is full the
+ * record is dropped and counted (OverflowPolicy::Drop) or the caller
+ * waits up to block_timeout_us for the drain (OverflowPolicy::Block).
+ * LOG_*_F(format, ...) formats printf-style straight into the record.
+ *
+ * Levels below IGSOA_LOG_MIN_LEVEL (0 = DEBUG ... 4 = FATAL, default 0)
+ * compile to nothing; their arguments are not evaluated.
  */
 class Logger {
 public:
@@ -34,6 +51,37 @@ public:
         FATAL       ///< Fatal errors that cause program termination
     };
 
+    /**
+     * @brief Behavior of a full per-thread ring in asynchronous mode
+     */
+    enum class OverflowPolicy {
+        Drop,       ///< Discard the record and count it (never waits)
+        Block       ///< Wait for the drain thread, dropping after block_timeout_us
+    };
+
+    /**
+     * @brief Asynchronous mode settings
+     */
+    struct AsyncConfig {
+        size_t ring_capacity = 1024;            ///< Records per thread (rounded up to a power of two)
+        OverflowPolicy overflow = OverflowPolicy::Drop;
+        unsigned block_timeout_us = 10000;      ///< Longest wait of OverflowPolicy::Block
+        unsigned drain_interval_us = 1000;      ///< Drain thread sleep when all rings are empty
+    };
+
+    /**
+     * @brief Asynchronous mode counters (totals since enableAsync)
+     */
+    struct AsyncStats {
+        uint64_t enqueued = 0;      ///< Records placed in a ring
+        uint64_t dropped = 0;       ///< Records lost to a full ring
+        uint64_t truncated = 0;     ///< Messages cut to kRecordText bytes
+        uint64_t written = 0;       ///< Records formatted by the drain thread
+        size_t threads = 0;         ///< Threads that own a ring
+    };
+
+    static constexpr size_t kRecordText = 192;  ///< Message bytes kept per async record
+
     /**
      * @brief Get the singleton Logger instance
      * @return Reference to the global Logger instance
@@ -75,7 +123,53 @@ public:
              const char* file = nullptr, int line = -1);
 
     /**
-     * @brief Close the log file
+     * @brief Log a printf-style message (formatted in place in async mode)
+     * @param level Log severity level
+     * @param file Source file name (usually __FILE__)
+     * @param line Source line number (usually __LINE__)
+     * @param format printf format string
+     */
+    void logf(Level level, const char* file, int line, const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((format(printf, 5, 6)))
+#endif
+        ;
+
+    /**
+     * @brief Switch to asynchronous logging (drain thread + per-thread rings)
+     *
+     * Call while no other thread is logging; reconfigures if already async.
+     * @param config Ring size, overflow policy and drain interval
+     */
+    void enableAsync(const AsyncConfig& config);
+    void enableAsync() { enableAsync(AsyncConfig()); }
+
+    /**
+     * @brief Drain all rings, stop the drain thread and return to synchronous logging
+     *
+     * Call while no other thread is logging.
+     */
+    void disableAsync();
+
+    /**
+     * @brief Check if asynchronous mode is active
+     * @return true between enableAsync() and disableAsync()
+     */
+    bool isAsync() const { return async_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Wait until every record enqueued before the call has been written
+     */
+    void flush();
+
+    /**
+     * @brief Asynchronous mode counters
+     * @return Totals over all thread rings
+     */
+    AsyncStats getAsyncStats() const;
+
+    /**
+     * @brief Close the log file (drains and stops asynchronous mode first)
      */
     void shutdown();
 
@@ -92,9 +186,61 @@ public:
     Logger& operator=(Logger&&) = delete;
 
 private:
+    struct Record;
+    struct AsyncRing;
+
     Logger();
     ~Logger();
 
+    /**
+     * @brief Ring of the calling thread, created on its first async record
+     * @return Ring owned by rings_
+     */
+    AsyncRing& threadRing();
+
+    /**
+     * @brief Reserve the next slot of a ring, applying the overflow policy
+     * @return Slot to fill and commit, or nullptr if the record is dropped
+     */
+    Record* reserveRecord(AsyncRing& ring);
+
+    /**
+     * @brief Publish the slot returned by reserveRecord()
+     */
+    static void commitRecord(AsyncRing& ring, Record& record, Level level,
+                             const char* file, int line);
+
+    /**
+     * @brief Drain thread body
+     */
+    void drainLoop();
+
+    /**
+     * @brief Move every published record into batch, write it, return the count
+     */
+    size_t drainOnce(std::vector<Record>& batch);
+
+    /**
+     * @brief Write one formatted line to the sinks whose level admits it (mutex_ held)
+     */
+    void writeLine(Level level, const std::string& line);
+
+    /**
+     * @brief Format "[timestamp] [LEVEL] [file:line] message"
+     */
+    static std::string formatLine(Level level, int64_t time_ns, const char* file, int line,
+                                  const char* message, size_t length);
+
+    /**
+     * @brief Check the runtime levels before any formatting
+     */
+    bool wouldLog(Level level) const;
+
+    /**
+     * @brief Wall-clock time in nanoseconds since the epoch
+     */
+    static int64_t nowNanoseconds();
+
     /**
      * @brief Convert log level to string
      * @param level Log level
@@ -108,6 +254,11 @@ private:
      */
     static std::string getCurrentTimestamp();
 
+    /**
+     * @brief Format a wall-clock time as "YYYY-MM-DD HH:MM:SS.mmm"
+     */
+    static std::string formatTimestamp(int64_t time_ns);
+
     /**
      * @brief Extract filename from full path
      * @param filepath Full file path
@@ -125,45 +276,100 @@ private:
 
     std::ofstream file_;           ///< Log file stream
     std::mutex mutex_;             ///< Mutex for thread safety
-    Level console_level_;          ///< Minimum level for console output
-    Level file_level_;             ///< Minimum level for file output
+    std::atomic<Level> console_level_;  ///< Minimum level for console output
+    std::atomic<Level> file_level_;     ///< Minimum level for file output
     bool initialized_;             ///< Whether logger is initialized
     std::string filename_;         ///< Current log filename
+
+    // Asynchronous mode
+    std::atomic<bool> async_;                      ///< Records go to the thread rings
+    std::atomic<uint64_t> async_generation_;       ///< Bumped by enableAsync (invalidates cached rings)
+    AsyncConfig async_config_;                     ///< Settings of the current session
+    mutable std::mutex rings_mutex_;               ///< Guards rings_ (registration and drain)
+    std::vector<std::unique_ptr<AsyncRing>> rings_;  ///< One ring per logging thread
+    std::thread drain_thread_;                     ///< Formats and writes the records
+    std::atomic<bool> drain_stop_;                 ///< Drain thread exits once rings are empty
+    std::mutex drain_mutex_;                       ///< Guards the drain wake-up / flush handshake
+    std::condition_variable drain_cv_;             ///< Wakes the drain thread (flush, stop)
+    std::condition_variable flushed_cv_;           ///< Signals flush() waiters after each batch
+    std::atomic<uint64_t> written_;                ///< Records written by the drain thread
 };
 
 } // namespace igsoa
 
+// Compile-time level filter: 0 = DEBUG, 1 = INFO, 2 = WARNING, 3 = ERROR, 4 = FATAL.
+// Macros below the minimum expand to nothing (arguments are not evaluated).
+#ifndef IGSOA_LOG_MIN_LEVEL
+#define IGSOA_LOG_MIN_LEVEL 0
+#endif
+
+#define IGSOA_LOG_DISABLED ((void)0)
+
 // Convenience macros for logging
 // Use :: prefix to ensure global namespace lookup (works from any namespace)
+#if IGSOA_LOG_MIN_LEVEL <= 0
 #define LOG_DEBUG(msg) \
     ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::DEBUG, msg, __FILE__, __LINE__)
-
-#define LOG_INFO(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::INFO, msg, __FILE__, __LINE__)
-
-#define LOG_WARNING(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::WARNING, msg, __FILE__, __LINE__)
-
-#define LOG_ERROR(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::ERROR, msg, __FILE__, __LINE__)
-
-#define LOG_FATAL(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::FATAL, msg, __FILE__, __LINE__)
-
-// Alternative: Log without file/line information (cleaner output)
 #define LOG_DEBUG_SIMPLE(msg) \
     ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::DEBUG, msg)
+#define LOG_DEBUG_F(...) \
+    ::igsoa::Logger::getInstance().logf(::igsoa::Logger::Level::DEBUG, __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_DEBUG(msg) IGSOA_LOG_DISABLED
+#define LOG_DEBUG_SIMPLE(msg) IGSOA_LOG_DISABLED
+#define LOG_DEBUG_F(...) IGSOA_LOG_DISABLED
+#endif
 
+#if IGSOA_LOG_MIN_LEVEL <= 1
+#define LOG_INFO(msg) \
+    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::INFO, msg, __FILE__, __LINE__)
 #define LOG_INFO_SIMPLE(msg) \
     ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::INFO, msg)
+#define LOG_INFO_F(...) \
+    ::igsoa::Logger::getInstance().logf(::igsoa::Logger::Level::INFO, __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_INFO(msg) IGSOA_LOG_DISABLED
+#define LOG_INFO_SIMPLE(msg) IGSOA_LOG_DISABLED
+#define LOG_INFO_F(...) IGSOA_LOG_DISABLED
+#endif
 
+#if IGSOA_LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(msg) \
+    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::WARNING, msg, __FILE__, __LINE__)
 #define LOG_WARNING_SIMPLE(msg) \
     ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::WARNING, msg)
+#define LOG_WARNING_F(...) \
+    ::igsoa::Logger::getInstance().logf(::igsoa::Logger::Level::WARNING, __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_WARNING(msg) IGSOA_LOG_DISABLED
+#define LOG_WARNING_SIMPLE(msg) IGSOA_LOG_DISABLED
+#define LOG_WARNING_F(...) IGSOA_LOG_DISABLED
+#endif
 
+#if IGSOA_LOG_MIN_LEVEL <= 3
+#define LOG_ERROR(msg) \
+    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::ERROR, msg, __FILE__, __LINE__)
 #define LOG_ERROR_SIMPLE(msg) \
     ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::ERROR, msg)
+#define LOG_ERROR_F(...) \
+    ::igsoa::Logger::getInstance().logf(::igsoa::Logger::Level::ERROR, __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_ERROR(msg) IGSOA_LOG_DISABLED
+#define LOG_ERROR_SIMPLE(msg) IGSOA_LOG_DISABLED
+#define LOG_ERROR_F(...) IGSOA_LOG_DISABLED
+#endif
 
+#if IGSOA_LOG_MIN_LEVEL <= 4
+#define LOG_FATAL(msg) \
+    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::FATAL, msg, __FILE__, __LINE__)
 #define LOG_FATAL_SIMPLE(msg) \
     ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::FATAL, msg)
+#define LOG_FATAL_F(...) \
+    ::igsoa::Logger::getInstance().logf(::igsoa::Logger::Level::FATAL, __FILE__, __LINE__, __VA_ARGS__)
+#else
+#define LOG_FATAL(msg) IGSOA_LOG_DISABLED
+#define LOG_FATAL_SIMPLE(msg) IGSOA_LOG_DISABLED
+#define LOG_FATAL_F(...) IGSOA_LOG_DISABLED
+#endif
 
 #endif // IGSOA_LOGGER_H
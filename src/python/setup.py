@@ -11,7 +11,6 @@ extra_compile_args = [
     '/Ob3',         # Aggressive inlining (new)
     '/Oi',          # Enable intrinsic functions (new)
     '/Ot',          # Favor fast code over small code (new)
-    '/arch:AVX2',   # AVX2 instructions
     '/fp:fast',     # Fast floating-point (relaxed IEEE compliance) (new)
     '/GL',          # Whole program optimization (new)
     '/DNOMINMAX'    # Disable min/max macros
@@ -32,6 +31,7 @@ ext_modules = [
             '../../'   # Include project root for fftw3.h
         ],
         language='c++',
+        define_macros=[('USE_FFTW3', None)],  # Spectral coupling for the IGSOA 2D/3D engines
         extra_compile_args=extra_compile_args,
         extra_link_args=extra_link_args,
         library_dirs=['../../'],  # FFTW library location
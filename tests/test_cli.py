@@ -8,6 +8,9 @@ import subprocess
 import json
 import sys
 
+# dase_cli binary (first argument; dase_cli.exe from the build directory by default)
+CLI = sys.argv[1] if len(sys.argv) > 1 else 'dase_cli.exe'
+
 def test_cli_basic():
     """Test basic CLI communication"""
     print("=" * 60)
@@ -18,7 +21,7 @@ def test_cli_basic():
         # Start CLI process
         print("\n1. Starting dase_cli process...")
         proc = subprocess.Popen(
-            ['dase_cli.exe'],
+            [CLI],
             stdin=subprocess.PIPE,
             stdout=subprocess.PIPE,
             stderr=subprocess.PIPE,
@@ -85,5 +88,41 @@ def test_cli_basic():
         print(f"\n❌ ERROR: {e}")
         return False
 
+def test_cli_command_streams():
+    """Batch, --buffered and --pipeline answer a command burst in order"""
+    print("=" * 60)
+    print("DASE CLI Test - Batched and Pipelined Command Streams")
+    print("=" * 60)
+
+    lines = [{"command": "create_engine", "params": {"engine_type": "igsoa_complex", "num_nodes": 64}},
+             {"command": "batch", "request_id": "b", "params": {"stop_on_error": True, "commands": [
+                 {"command": "get_node_state", "params": {"engine_id": "engine_001", "node_index": 0}},
+                 {"command": "no_such_command", "params": {}},
+                 {"command": "get_node_state", "params": {"engine_id": "engine_001", "node_index": 1}}]}}]
+    burst = 2000
+    lines += [{"command": "get_node_state", "request_id": i,
+               "params": {"engine_id": "engine_001", "node_index": i % 64}} for i in range(burst)]
+    stdin = "".join(json.dumps(line) + "\n" for line in lines)
+
+    ok = True
+    for flags in ([], ["--buffered"], ["--pipeline"], ["--buffered", "--pipeline"]):
+        try:
+            run = subprocess.run([CLI] + flags, input=stdin, capture_output=True, text=True, timeout=60)
+        except (FileNotFoundError, subprocess.TimeoutExpired) as e:
+            print(f"\n❌ ERROR: {' '.join(flags) or 'default'}: {e}")
+            return False
+        responses = [json.loads(l) for l in run.stdout.splitlines() if l.startswith("{")]
+        batch = next((r for r in responses if r.get("request_id") == "b"), {})
+        ids = [r.get("request_id") for r in responses if isinstance(r.get("request_id"), int)]
+        result = batch.get("result", {})
+        passed = (run.returncode == 0 and ids == list(range(burst)) and
+                  (result.get("executed"), result.get("failed"), result.get("skipped")) == (2, 1, 1))
+        print(f"   {'✅' if passed else '❌'} {' '.join(flags) or 'default'}: "
+              f"{len(ids)} responses in order, batch {result.get('executed')}/{result.get('failed')}/{result.get('skipped')}")
+        ok = ok and passed
+    return ok
+
 if __name__ == "__main__":
     test_cli_basic()
+    if not test_cli_command_streams():
+        sys.exit(1)
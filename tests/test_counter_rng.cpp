@@ -0,0 +1,169 @@
+/**
+ * Counter-Based RNG Test
+ *
+ * Checks Philox4x32-10 against the Random123 known-answer vectors, that
+ * batch fills give the same values for every OpenMP thread count and
+ * counter offset and match the per-element calls, that uniform and normal batches have the
+ * expected moments, and that the random state initializers reproduce a
+ * seeded field independent of the thread count.
+ */
+
+#include "../src/cpp/counter_rng.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+bool blockEquals(const PhiloxBlock& b, uint32_t v0, uint32_t v1, uint32_t v2, uint32_t v3) {
+    return b.v[0] == v0 && b.v[1] == v1 && b.v[2] == v2 && b.v[3] == v3;
+}
+
+void testKnownAnswers() {
+    std::cout << "Philox4x32-10 known answers" << std::endl;
+    const uint32_t zero_ctr[4] = {0, 0, 0, 0};
+    const uint32_t zero_key[2] = {0, 0};
+    check(blockEquals(philox4x32_10(zero_ctr, zero_key), 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8),
+          "zero counter and key");
+
+    const uint32_t ones_ctr[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const uint32_t ones_key[2] = {0xffffffff, 0xffffffff};
+    check(blockEquals(philox4x32_10(ones_ctr, ones_key), 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd),
+          "all-ones counter and key");
+
+    const uint32_t pi_ctr[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const uint32_t pi_key[2] = {0xa4093822, 0x299f31d0};
+    check(blockEquals(philox4x32_10(pi_ctr, pi_key), 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1),
+          "pi digits counter and key");
+}
+
+void testBatches() {
+    std::cout << "batch fills" << std::endl;
+    const size_t n = 100003;  // Above kParallelThreshold, odd tail
+    CounterRNG rng(0x5eed);
+
+    std::vector<double> serial(n), threaded(n);
+    setThreads(1);
+    rng.fillNormal(serial.data(), n, 12, 0.5, 2.0);
+    setThreads(4);
+    rng.fillNormal(threaded.data(), n, 12, 0.5, 2.0);
+    check(serial == threaded, "normal batch independent of thread count");
+    check(std::abs(serial[777] - (0.5 + 2.0 * rng.normal(12, 777))) < 1e-12,
+          "batch element matches per-element call");
+
+    std::vector<double> offset(10);
+    rng.fillNormal(offset.data(), offset.size(), 12, 0.5, 2.0, 500);
+    check(offset[3] == serial[503], "first_index offsets the counter");
+
+    std::vector<double> next_step(n);
+    rng.fillNormal(next_step.data(), n, 13, 0.5, 2.0);
+    size_t equal = 0;
+    for (size_t i = 0; i < n; i++) equal += (next_step[i] == serial[i]);
+    check(equal == 0, "steps give independent draws");
+
+    double mean = 0.0, var = 0.0;
+    for (double x : serial) mean += x;
+    mean /= n;
+    for (double x : serial) var += (x - mean) * (x - mean);
+    var /= n;
+    check(std::abs(mean - 0.5) < 0.03 && std::abs(var - 4.0) < 0.1, "normal moments");
+
+    std::vector<double> uniform(n), uniform_threaded(n);
+    setThreads(1);
+    rng.fillUniform(uniform.data(), n, 3, -1.0, 1.0);
+    setThreads(4);
+    rng.fillUniform(uniform_threaded.data(), n, 3, -1.0, 1.0);
+    check(uniform == uniform_threaded && uniform[42] == -1.0 + 2.0 * rng.uniform(3, 42),
+          "uniform batch independent of thread count");
+    double u_mean = 0.0, u_min = 1.0, u_max = -1.0;
+    for (double u : uniform) {
+        u_mean += u;
+        u_min = std::min(u_min, u);
+        u_max = std::max(u_max, u);
+    }
+    u_mean /= n;
+    check(u_min >= -1.0 && u_max < 1.0 && std::abs(u_mean) < 0.01, "uniform range and mean");
+
+    CounterRNG other(0x5eee);
+    check(other.normal(12, 0) != rng.normal(12, 0), "seed changes the stream");
+}
+
+void testStateInit() {
+    std::cout << "seeded state initializers" << std::endl;
+    using namespace dase::satp_higgs;
+    SATPHiggsParams params;
+
+    SATPHiggsEngine2D serial(160, 128, 0.1, 0.02, params);  // Above kParallelThreshold sites
+    SATPHiggsEngine2D threaded(160, 128, 0.1, 0.02, params);
+    setThreads(1);
+    SATPHiggsStateInit2D::addRandomPerturbation(serial, 0.1, 0.05, 99);
+    setThreads(4);
+    SATPHiggsStateInit2D::addRandomPerturbation(threaded, 0.1, 0.05, 99);
+    bool same = true;
+    for (size_t i = 0; i < serial.getNodes().size(); i++) {
+        same = same && serial.getNodes()[i].phi == threaded.getNodes()[i].phi &&
+               serial.getNodes()[i].h == threaded.getNodes()[i].h;
+    }
+    check(same, "SATP perturbation independent of thread count");
+
+    using namespace dase::igsoa;
+    IGSOAComplexConfig config;
+    config.num_nodes = 6 * 5 * 4;
+    IGSOAComplexEngine3D a(config, 6, 5, 4);
+    IGSOAComplexEngine3D b(config, 6, 5, 4);
+    IGSOAStateInit3D::initRandom(a, 0.8, 7);
+    IGSOAStateInit3D::initRandom(b, 0.8, 7);
+    bool reproducible = true, bounded = true;
+    for (size_t i = 0; i < a.getNodes().size(); i++) {
+        reproducible = reproducible && a.getNodes()[i].psi == b.getNodes()[i].psi;
+        bounded = bounded && std::abs(a.getNodes()[i].psi) <= 0.8 + 1e-12;
+    }
+    check(reproducible && bounded, "IGSOA 3D random state reproducible and bounded");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Counter RNG Test ===" << std::endl;
+
+    testKnownAnswers();
+    testBatches();
+    testStateInit();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
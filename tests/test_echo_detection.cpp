@@ -6,15 +6,22 @@
  * - Prime gap calculation
  * - Echo schedule generation
  * - Echo signal timing
+ * - Windowed active-echo lookup and batched envelope
+ * - Shared segmented prime table
+ * - Matched-filter template bank search
  */
 
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "../src/cpp/igsoa_gw_engine/core/echo_generator.h"
+#include "../src/cpp/igsoa_gw_engine/core/echo_template_bank.h"
 #include <iostream>
 #include <fstream>
 #include <cassert>
 #include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -280,6 +287,250 @@ bool test_echo_export() {
     return true;
 }
 
+// ============================================================================
+// Test 8: Windowed Lookup and Batched Envelope
+// ============================================================================
+
+bool test_batched_envelope() {
+    std::cout << "\n=== Test 8: Windowed Lookup and Batched Envelope ===" << std::endl;
+
+    EchoConfig config;
+    config.fundamental_timescale = 0.001;
+    config.max_primes = 40;
+    config.auto_detect_merger = false;
+
+    EchoGenerator generator(config);
+    generator.setMergerTime(1.0);
+    const auto& schedule = generator.getEchoSchedule();
+
+    // Cursor lookup matches a brute-force scan, stepping forward then back.
+    // The step is incommensurate with tau_0 so no sample sits exactly on a
+    // window edge, where FMA contraction could tip the comparison either way
+    const double t0 = 0.99937;
+    const double dt = 1.3e-4;
+    const size_t num_steps = 2500;
+    const double half_width = 3.0 * config.fundamental_timescale;
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t k = 0; k < num_steps; k += 7) {
+            size_t j = (pass == 0) ? k : num_steps - 1 - k;
+            double t = t0 + j * dt;
+            size_t expected = 0;
+            for (const auto& echo : schedule) {
+                if (std::abs(t - echo.time) < half_width) expected++;
+            }
+            TEST_ASSERT(generator.getActiveEchoes(t).size() == expected,
+                        "Windowed lookup should match brute-force scan");
+            TEST_ASSERT(generator.isEchoActive(t) == (expected > 0),
+                        "isEchoActive should agree with getActiveEchoes");
+        }
+    }
+
+    // Batched envelope matches per-echo amplitudes over the active window
+    std::vector<double> envelope(num_steps);
+    generator.computeEchoEnvelope(t0, dt, num_steps, envelope.data());
+
+    double max_diff = 0.0;
+    double max_envelope = 0.0;
+    for (size_t j = 0; j < num_steps; j++) {
+        double t = t0 + j * dt;
+        double expected = 0.0;
+        for (const auto& echo : schedule) {
+            if (std::abs(t - echo.time) < half_width) {
+                expected += generator.getEchoAmplitude(echo, t);
+            }
+        }
+        max_diff = std::max(max_diff, std::abs(envelope[j] - expected));
+        max_envelope = std::max(max_envelope, envelope[j]);
+    }
+    std::cout << std::scientific << "Max envelope: " << max_envelope
+              << ", max deviation: " << max_diff << std::endl;
+    TEST_ASSERT(max_envelope > 0.0, "Envelope should be non-zero after merger");
+    TEST_ASSERT(max_diff < 1e-12, "Batched envelope should match per-echo amplitudes");
+
+    // Source is the cached temporal signal times the spatial Gaussian
+    Vector3D center(0.0, 0.0, 0.0);
+    Vector3D offset(2000.0, 0.0, 0.0);
+    double t_echo = schedule[2].time;
+    auto signal = generator.computeEchoSignal(t_echo);
+    auto source = generator.computeEchoSource(t_echo, offset, center);
+    double sigma = config.echo_gaussian_width;
+    double spatial = std::exp(-(2000.0 * 2000.0) / (2.0 * sigma * sigma));
+    TEST_ASSERT(std::abs(source - signal * spatial) < 1e-15, "Source should factor into signal x spatial");
+    TEST_ASSERT(std::abs(signal) > 1e-10, "Signal should be non-zero at echo time");
+
+    // Invalid arguments are rejected
+    bool threw = false;
+    try {
+        generator.computeEchoEnvelope(t0, 0.0, num_steps, envelope.data());
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "Non-positive dt should throw");
+
+    std::cout << "✓ Batched envelope test passed" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// Test 9: Shared Segmented Prime Table
+// ============================================================================
+
+bool test_prime_table() {
+    std::cout << "\n=== Test 9: Shared Segmented Prime Table ===" << std::endl;
+
+    // Reference: plain sieve past several sieve segments
+    const int limit = 3000000;
+    std::vector<bool> is_prime(limit + 1, true);
+    is_prime[0] = is_prime[1] = false;
+    for (int i = 2; i * i <= limit; i++) {
+        if (is_prime[i]) {
+            for (int j = i * i; j <= limit; j += i) is_prime[j] = false;
+        }
+    }
+    std::vector<int> reference;
+    for (int i = 2; i <= limit; i++) {
+        if (is_prime[i]) reference.push_back(i);
+    }
+
+    // Grow in uneven steps; earlier snapshots stay valid and unchanged
+    PrimeTable& table = PrimeTable::instance();
+    PrimeTable::Snapshot small = table.ensure(1000);
+    const size_t small_count = small->countUpTo(1000);
+    table.ensure(700001);
+    PrimeTable::Snapshot large = table.ensure(limit);
+
+    TEST_ASSERT(small_count == 168, "Should be 168 primes under 1000");
+    TEST_ASSERT(small->primes.size() >= small_count, "Earlier snapshot should be intact");
+    TEST_ASSERT(large->limit >= limit, "Table should cover the requested range");
+
+    const size_t count = large->countUpTo(limit);
+    TEST_ASSERT(count == reference.size(), "Segmented sieve prime count should match");
+    for (size_t n = 0; n < count; n++) {
+        TEST_ASSERT(large->primes[n] == reference[n], "Segmented sieve should match plain sieve");
+    }
+    for (size_t n = 0; n + 1 < count; n++) {
+        TEST_ASSERT(large->gaps[n] == reference[n + 1] - reference[n], "Cached gaps should match");
+    }
+    std::cout << "Primes <= " << limit << ": " << count << std::endl;
+
+    // Generators and helpers share the table without re-sieving
+    EchoConfig config;
+    config.max_prime_value = 500000;
+    EchoGenerator generator(config);
+    TEST_ASSERT(table.snapshot() == large, "Covered range should not regrow the table");
+    TEST_ASSERT(generator.getPrimeStatistics().max_prime == 499979, "Largest prime under 500000");
+    TEST_ASSERT(EchoGenerator::generatePrimes(30).size() == 10, "Should be 10 primes under 30");
+
+    // Non-prefix lists are still differenced directly
+    auto gaps = EchoGenerator::computePrimeGaps({5, 11, 17});
+    TEST_ASSERT(gaps.size() == 2 && gaps[0] == 6 && gaps[1] == 6, "Arbitrary prime list gaps");
+
+    std::cout << "✓ Shared prime table test passed" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// Test 10: Template Bank Search
+// ============================================================================
+
+bool test_template_bank() {
+    std::cout << "\n=== Test 10: Template Bank Search ===" << std::endl;
+
+    // The waveform is the real part of the echo signal
+    EchoConfig config;
+    config.max_primes = 30;
+    config.auto_detect_merger = false;
+    EchoGenerator generator(config);
+    generator.setMergerTime(0.2);
+    const double dt = 1.0 / 8192.0;
+    std::vector<double> wave(4096);
+    generator.computeEchoWaveform(0.19, dt, wave.size(), wave.data());
+    double max_diff = 0.0;
+    for (size_t j = 0; j < wave.size(); j++) {
+        max_diff = std::max(max_diff, std::abs(wave[j] - generator.computeEchoSignal(0.19 + j * dt).real()));
+    }
+    TEST_ASSERT(max_diff < 1e-12, "Batched waveform should match the echo signal's real part");
+    TEST_ASSERT(generator.getEchoTrainEnd() > generator.getEchoSchedule().back().time,
+                "Echo train should end after the last echo");
+
+    // 4 x 3 x 2 templates; inject one of them, scaled, into white noise
+    EchoTemplateGrid grid;
+    grid.base = config;
+    grid.fundamental_timescales = {0.0008, 0.001, 0.0012, 0.0014};
+    grid.amplitude_decays = {5.0, 10.0, 20.0};
+    grid.frequency_shifts = {5.0, 10.0};
+    const size_t n = 8192;
+    EchoTemplateBank bank(grid, dt, n);
+    TEST_ASSERT(bank.size() == 24, "Bank should hold the full grid");
+    TEST_ASSERT(bank.fftSize() >= n + bank.templateLength(0) - 1, "FFT size should avoid wrap-around");
+
+    const size_t injected = 2 * 6 + 1 * 2 + 1;       // τ₀ 1.2 ms, decay 10, shift 10 Hz
+    const EchoConfig& truth = bank.templateConfig(injected);
+    TEST_ASSERT(truth.fundamental_timescale == 0.0012 && truth.echo_amplitude_decay == 10.0 &&
+                truth.echo_frequency_shift == 10.0, "Grid order: τ₀, decay, shift");
+
+    const double t0 = 10.0;
+    const double merger = t0 + 1536 * dt;
+    const double scale = 2.5;
+    const double sigma = 0.02;
+    EchoConfig injected_config = truth;
+    EchoGenerator source(injected_config);
+    source.setMergerTime(merger);
+    std::vector<double> data(n);
+    source.computeEchoWaveform(t0, dt, n, data.data());
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, sigma);
+    for (double& v : data) v = scale * v + noise(rng);
+
+    auto matches = bank.search(data.data(), n, t0, 3);
+    TEST_ASSERT(matches.size() == 3, "Should return top_k matches");
+    const EchoMatch& best = matches[0];
+    std::cout << std::fixed << std::setprecision(4) << "Best: template " << best.template_index
+              << ", merger " << best.merger_time << " s, SNR " << best.snr
+              << ", scale " << best.amplitude_scale << std::endl;
+    TEST_ASSERT(best.template_index == injected, "Best template should be the injected one");
+    TEST_ASSERT(std::abs(best.merger_time - merger) < 0.5 * dt, "Merger time should be recovered");
+    TEST_ASSERT(std::abs(best.amplitude_scale - scale) < 0.05 * scale, "Amplitude scale should be recovered");
+    TEST_ASSERT(best.config.merger_time == best.merger_time, "Match config should carry the merger time");
+    TEST_ASSERT(std::abs(matches[1].snr) <= std::abs(best.snr) && std::abs(matches[2].snr) <= std::abs(matches[1].snr),
+                "Matches should be ordered by |SNR|");
+
+    // SNR equals the direct time-domain correlation with the unit-norm template
+    EchoGenerator replay(bank.templateConfig(injected));
+    replay.setMergerTime(0.0);
+    std::vector<double> h(bank.templateLength(injected));
+    replay.computeEchoWaveform(0.0, dt, h.size(), h.data());
+    double dot = 0.0, energy = 0.0;
+    const size_t lag = static_cast<size_t>(std::lround((best.merger_time - t0) / dt));
+    for (size_t j = 0; j < h.size() && lag + j < n; j++) {
+        dot += data[lag + j] * h[j];
+        energy += h[j] * h[j];
+    }
+    const double sigma_hat = EchoTemplateBank::estimateNoiseSigma(data.data(), n);
+    const double direct_snr = dot / std::sqrt(energy) / sigma_hat;
+    TEST_ASSERT(std::abs(best.snr - direct_snr) < 1e-9 * std::abs(direct_snr), "FFT SNR should match direct correlation");
+    TEST_ASSERT(std::abs(sigma_hat - sigma) < 0.2 * sigma, "Noise estimate should be close to the injected level");
+
+    // Explicit noise level and an inverted signal
+    for (double& v : data) v = -v;
+    auto inverted = bank.search(data.data(), n, t0, 1, sigma);
+    TEST_ASSERT(inverted[0].template_index == injected && inverted[0].snr < 0.0 &&
+                std::abs(inverted[0].snr * sigma + best.snr * sigma_hat) < 1e-9 * std::abs(best.snr * sigma_hat),
+                "Inverted signal should match with negative SNR");
+
+    bool threw = false;
+    try {
+        bank.search(data.data(), n + 1, t0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    TEST_ASSERT(threw, "Waveform longer than the bank's size should throw");
+
+    std::cout << "✓ Template bank test passed" << std::endl;
+    return true;
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -290,7 +541,7 @@ int main() {
     std::cout << "========================================" << std::endl;
 
     int tests_passed = 0;
-    int tests_total = 7;
+    int tests_total = 10;
 
     if (test_prime_generation()) tests_passed++;
     if (test_prime_gaps()) tests_passed++;
@@ -299,6 +550,9 @@ int main() {
     if (test_prime_statistics()) tests_passed++;
     if (test_active_echoes()) tests_passed++;
     if (test_echo_export()) tests_passed++;
+    if (test_batched_envelope()) tests_passed++;
+    if (test_prime_table()) tests_passed++;
+    if (test_template_bank()) tests_passed++;
 
     std::cout << "\n========================================" << std::endl;
     std::cout << "Test Results: " << tests_passed << "/" << tests_total << " passed" << std::endl;
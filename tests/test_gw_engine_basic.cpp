@@ -4,6 +4,19 @@
  * Tests core components:
  * - SymmetryField 3D grid operations
  * - FractionalSolver SOE kernel
+ * - FractionalSolver rank-major history vs per-point HistoryState (also in spill files)
+ * - FractionalSolver α quantization and kernel grouping
+ * - Allocation-free GW step with GWStepWorkspace (stage profiler counts each step)
+ * - Fused SymmetryField cache sweep vs per-point stencils
+ * - Bounding-box BinaryMerger source assembly vs full-grid Gaussians
+ * - Field-wide ProjectionOperators passes vs per-point projections
+ * - SymmetryField + FractionalSolver checkpoint/restart
+ * - RefinedSymmetryField: source-following patches vs a uniform fine grid,
+ *   conservative restriction, history carried across regrids, point savings
+ * - DetectorArray sampling vs per-observer projections; .gwf waveform
+ *   streaming round trip and truncated-file recovery
+ * - SOEKernelStore: kernels shared across solvers and threads, persisted
+ *   and reloaded without refitting
  * - Basic field evolution
  */
 
@@ -11,8 +24,26 @@
 #include <cmath>
 #include "../src/cpp/igsoa_gw_engine/core/symmetry_field.h"
 #include "../src/cpp/igsoa_gw_engine/core/fractional_solver.h"
+#include "../src/cpp/igsoa_gw_engine/core/source_manager.h"
+#include "../src/cpp/igsoa_gw_engine/core/projection_operators.h"
+#include "../src/cpp/igsoa_gw_engine/core/gw_step_workspace.h"
+#include "../src/cpp/igsoa_gw_engine/core/mesh_refinement.h"
+#include "../src/cpp/igsoa_gw_engine/core/detector_array.h"
+#include "../src/cpp/igsoa_gw_engine/core/waveform_stream.h"
+#include "../src/cpp/igsoa_gw_engine/core/soe_kernel_store.h"
+#include "../src/cpp/checkpoint_file.h"
+#include "../src/cpp/out_of_core.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <new>
+#include <thread>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -20,6 +51,31 @@
 
 using namespace dase::igsoa::gw;
 
+// Heap allocations made through operator new, from any thread (Test 8)
+static std::atomic<size_t> g_heap_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_heap_allocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+// Kept out of line: GCC would otherwise see std::free() paired with the
+// built-in operator new at inlined call sites (-Wmismatched-new-delete)
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static void freeHeapBlock(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p) noexcept { freeHeapBlock(p); }
+void operator delete(void* p, std::size_t) noexcept { freeHeapBlock(p); }
+void operator delete[](void* p) noexcept { freeHeapBlock(p); }
+void operator delete[](void* p, std::size_t) noexcept { freeHeapBlock(p); }
+
 // Test 1: SymmetryField construction and grid operations
 bool test_symmetry_field_basic() {
     std::cout << "\n=== Test 1: SymmetryField Basic Operations ===" << std::endl;
@@ -322,13 +378,1061 @@ bool test_interpolation() {
 }
 
 // Main test runner
+// Test 6: Batched history update matches the per-point HistoryState recursion
+bool test_fractional_history() {
+    std::cout << "\n=== Test 6: Fractional History Update ===" << std::endl;
+
+    FractionalSolverConfig config;
+    config.T_max = 1.0;
+    config.soe_rank = 12;
+
+    // Not a multiple of the solver's point block
+    const int num_points = 2500;
+    const double dt = 0.001;
+    const double alphas[3] = {1.2, 1.5, 1.8};
+
+    std::vector<double> alpha_values(num_points);
+    for (int i = 0; i < num_points; i++) {
+        alpha_values[i] = alphas[(i / 7) % 3];
+    }
+
+    FractionalSolver solver(config, num_points);
+    FractionalSolver legacy(config, num_points);
+    solver.setAlphaField(alpha_values);
+
+    // Over the memory budget the history lives in spill files
+    const dase::OutOfCorePolicy saved_policy = dase::getOutOfCorePolicy();
+    dase::OutOfCorePolicy spill_policy;
+    spill_policy.memory_budget_bytes = 1;
+    dase::setOutOfCorePolicy(spill_policy);
+    FractionalSolver spilled(config, num_points);
+    dase::setOutOfCorePolicy(saved_policy);
+    spilled.setAlphaField(alpha_values);
+    if (!spilled.isOutOfCore() || solver.isOutOfCore()) {
+        std::cout << "FAILED: memory budget did not select the history storage" << std::endl;
+        return false;
+    }
+
+    if (solver.getNumCachedKernels() != 3) {
+        std::cout << "FAILED: expected 3 kernels, got " << solver.getNumCachedKernels() << std::endl;
+        return false;
+    }
+    for (int i = 0; i < num_points; i++) {
+        if (solver.getKernelIndexAt(i) != solver.getKernelIndexAt((i / 7) % 3 * 7)) {
+            std::cout << "FAILED: kernel index mismatch at point " << i << std::endl;
+            return false;
+        }
+    }
+
+    SOEKernel kernels[3];
+    for (int k = 0; k < 3; k++) {
+        kernels[k].initialize(solver.quantizeAlpha(alphas[k]), config.T_max, config.soe_rank);
+    }
+    std::vector<HistoryState> reference(num_points, HistoryState(config.soe_rank));
+
+    std::vector<std::complex<double>> second_derivs(num_points);
+    for (int step = 0; step < 10; step++) {
+        for (int i = 0; i < num_points; i++) {
+            second_derivs[i] = std::complex<double>(std::sin(0.01 * i + step), std::cos(0.03 * i - step));
+            reference[i].update(kernels[(i / 7) % 3], second_derivs[i], dt);
+        }
+        solver.updateHistory(second_derivs, dt);
+        spilled.updateHistory(second_derivs, dt);
+        legacy.updateHistory(second_derivs, second_derivs, alpha_values, dt);
+    }
+
+    auto derivs = solver.computeDerivatives(alpha_values);
+    auto legacy_derivs = legacy.computeDerivatives(alpha_values);
+    if (spilled.computeDerivatives(alpha_values) != derivs) {
+        std::cout << "FAILED: out-of-core history differs" << std::endl;
+        return false;
+    }
+
+    double max_rel_error = 0.0;
+    for (int i = 0; i < num_points; i++) {
+        const std::complex<double> expected = reference[i].computeDerivative();
+        const double scale = std::max(std::abs(expected), 1e-30);
+        max_rel_error = std::max(max_rel_error, std::abs(derivs[i] - expected) / scale);
+        max_rel_error = std::max(max_rel_error, std::abs(solver.computeDerivativeAt(i, alpha_values[i]) - expected) / scale);
+
+        if (legacy_derivs[i] != derivs[i]) {
+            std::cout << "FAILED: legacy updateHistory differs at point " << i << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Max relative error vs HistoryState: " << max_rel_error << std::endl;
+    if (max_rel_error > 1e-12) {
+        std::cout << "FAILED: batched history diverges from per-point recursion" << std::endl;
+        return false;
+    }
+
+    solver.resetHistory();
+    if (solver.computeDerivativeAt(num_points - 1, alpha_values.back()) != std::complex<double>(0.0, 0.0)) {
+        std::cout << "FAILED: resetHistory left non-zero state" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ Batched history matches per-point recursion" << std::endl;
+    return true;
+}
+
+// Test 7: α quantization bins a graded field into a few contiguous kernel groups
+bool test_fractional_grouping() {
+    std::cout << "\n=== Test 7: Fractional Kernel Grouping ===" << std::endl;
+
+    FractionalSolverConfig config;
+    config.T_max = 1.0;
+    config.soe_rank = 10;
+    config.alpha_resolution = 0.01;
+
+    // α rises from 1.1 to 1.9 along a 40x50 grid (x fastest), ±jitter below the resolution
+    const int nx = 40;
+    const int ny = 50;
+    const int num_points = nx * ny;
+    const double dt = 0.001;
+    std::vector<double> alpha_values(num_points);
+    for (int i = 0; i < num_points; i++) {
+        alpha_values[i] = 1.1 + 0.8 * (i / nx) / (ny - 1) + 1e-4 * ((i % 3) - 1);
+    }
+
+    FractionalSolver solver(config, num_points);
+    solver.setAlphaField(alpha_values);
+
+    std::cout << "Kernel groups: " << solver.getNumKernelGroups()
+              << ", runs: " << solver.getNumKernelRuns() << std::endl;
+    if (solver.getNumKernelGroups() > 81 || solver.getNumKernelRuns() > solver.getNumKernelGroups() + 2) {
+        std::cout << "FAILED: jitter below alpha_resolution split kernel groups" << std::endl;
+        return false;
+    }
+    if (solver.quantizeAlpha(0.5) != config.alpha_min || solver.quantizeAlpha(3.0) != config.alpha_max) {
+        std::cout << "FAILED: quantizeAlpha does not clamp to [alpha_min, alpha_max]" << std::endl;
+        return false;
+    }
+
+    std::vector<HistoryState> reference(num_points, HistoryState(config.soe_rank));
+    std::vector<SOEKernel> kernels(num_points);
+    for (int i = 0; i < num_points; i++) {
+        kernels[i].initialize(solver.quantizeAlpha(alpha_values[i]), config.T_max, config.soe_rank);
+    }
+
+    std::vector<std::complex<double>> second_derivs(num_points);
+    for (int step = 0; step < 8; step++) {
+        for (int i = 0; i < num_points; i++) {
+            second_derivs[i] = std::complex<double>(std::cos(0.02 * i * step), 0.5);
+            reference[i].update(kernels[i], second_derivs[i], dt);
+        }
+        solver.updateHistory(second_derivs, dt);
+    }
+
+    double max_rel_error = 0.0;
+    for (int i = 0; i < num_points; i++) {
+        const std::complex<double> expected = reference[i].computeDerivative();
+        const double scale = std::max(std::abs(expected), 1e-30);
+        max_rel_error = std::max(max_rel_error, std::abs(solver.computeDerivativeAt(i, alpha_values[i]) - expected) / scale);
+    }
+
+    std::cout << "Max relative error vs quantized HistoryState: " << max_rel_error << std::endl;
+    if (max_rel_error > 1e-12) {
+        std::cout << "FAILED: grouped update diverges from per-point recursion" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ Quantized kernel groups match per-point recursion" << std::endl;
+    return true;
+}
+
+// Test 8: One GW step through the in-place APIs touches no heap
+bool test_allocation_free_step() {
+    std::cout << "\n=== Test 8: Allocation-Free GW Step ===" << std::endl;
+
+    SymmetryFieldConfig field_config;
+    field_config.nx = 12;
+    field_config.ny = 12;
+    field_config.nz = 12;
+    field_config.dx = 1000.0;
+    field_config.dy = 1000.0;
+    field_config.dz = 1000.0;
+    field_config.dt = 0.001;
+
+    SymmetryField field(field_config);
+    SymmetryField reference_field(field_config);
+    for (int i = 0; i < field_config.nx; i++) {
+        for (int j = 0; j < field_config.ny; j++) {
+            for (int k = 0; k < field_config.nz; k++) {
+                const double alpha = (k < field_config.nz / 2) ? 1.4 : 1.8;
+                field.setAlpha(i, j, k, alpha);
+                reference_field.setAlpha(i, j, k, alpha);
+            }
+        }
+    }
+
+    FractionalSolverConfig frac_config;
+    frac_config.T_max = 1.0;
+    FractionalSolver solver(frac_config, field.getTotalPoints());
+    FractionalSolver reference_solver(frac_config, field.getTotalPoints());
+    solver.setAlphaField(field.getAlphaFlat());
+
+    BinaryMergerConfig merger_config;
+    merger_config.initial_separation = 4e3;
+    merger_config.gaussian_width = 2e3;
+    merger_config.center = Vector3D(6e3, 6e3, 6e3);
+    BinaryMerger merger(merger_config);
+    BinaryMerger reference_merger(merger_config);
+
+    GWStepWorkspace ws(field.getTotalPoints());
+    const uint64_t setup_allocations = ws.allocations;
+
+    auto step = [&](double t) {
+        {
+            DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_SOURCE);
+            merger.computeSourceTerms(field, t, ws.source_terms);
+        }
+        {
+            DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_FRACTIONAL);
+            solver.computeDerivatives(ws.fractional_derivatives);
+        }
+        {
+            DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_FIELD);
+            field.evolveStep(ws.fractional_derivatives, ws.source_terms);
+        }
+        for (size_t i = 0; i < ws.second_derivatives.size(); i++) {
+            ws.second_derivatives[i] = ws.source_terms[i];
+        }
+        {
+            DASE_PROFILE_PHASE(&ws.profiler, GW_PHASE_HISTORY);
+            solver.updateHistory(ws.second_derivatives, field_config.dt);
+        }
+        merger.evolveOrbit(field_config.dt);
+    };
+
+    // Warm-up step builds the per-dt coefficients
+    step(0.0);
+
+    const size_t heap_before = g_heap_allocations;
+    for (int n = 1; n <= 5; n++) {
+        step(n * field_config.dt);
+    }
+    const size_t step_heap_allocations = g_heap_allocations - heap_before;
+
+    // Same six steps through the allocating APIs
+    for (int n = 0; n <= 5; n++) {
+        const double t = n * field_config.dt;
+        auto sources = reference_merger.computeSourceTerms(reference_field, t);
+        auto alpha_values = reference_field.getAlphaValues();
+        auto frac_derivs = reference_solver.computeDerivatives(alpha_values);
+        reference_field.evolveStep(frac_derivs, sources);
+        reference_solver.updateHistory(reference_field.getDeltaPhiFlat(), sources, alpha_values, field_config.dt);
+        reference_merger.evolveOrbit(field_config.dt);
+    }
+
+    std::cout << "Heap allocations in 5 steps: " << step_heap_allocations
+              << ", workspace reallocations: " << ws.allocations - setup_allocations << std::endl;
+    if (step_heap_allocations != 0 || ws.allocations != setup_allocations) {
+        std::cout << "FAILED: GW step allocated" << std::endl;
+        return false;
+    }
+    if (field.getDeltaPhiFlat() != reference_field.getDeltaPhiFlat()) {
+        std::cout << "FAILED: in-place step differs from allocating API" << std::endl;
+        return false;
+    }
+
+    // Profiled stages: one call per step each (none when compiled out)
+    const uint64_t expected_calls = dase::PhaseProfiler::enabled() ? 6 : 0;
+    for (const auto& phase : ws.profiler.snapshot()) {
+        const bool timed = std::string(phase.name) != "strain";
+        if (phase.calls != (timed ? expected_calls : 0)) {
+            std::cout << "FAILED: phase " << phase.name << " counted " << phase.calls << " calls" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "✓ GW step allocation-free and identical to allocating API" << std::endl;
+    return true;
+}
+
+// Test 9: Fused cache sweep and in-place evolve match the per-point stencils
+bool test_fused_field_sweep() {
+    std::cout << "\n=== Test 9: Fused Field Sweep ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 13;
+    config.ny = 9;
+    config.nz = 7;
+    config.dx = 1000.0;
+    config.dy = 1500.0;
+    config.dz = 800.0;
+    config.dt = 0.001;
+    config.lambda = 0.3;
+    config.kappa = 0.05;
+
+    SymmetryField field(config);
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) {
+                field.setDeltaPhi(i, j, k, std::complex<double>(std::sin(0.7 * i + 0.3 * j), std::cos(0.5 * k - 0.2 * i)));
+            }
+        }
+    }
+
+    // Expected next state from the per-point stencils on the current field
+    const int total = field.getTotalPoints();
+    std::vector<std::complex<double>> frac(total), sources(total), expected(field.getDeltaPhiFlat());
+    for (int idx = 0; idx < total; idx++) {
+        frac[idx] = std::complex<double>(0.01 * (idx % 5), -0.02);
+        sources[idx] = std::complex<double>(0.0, 0.001 * (idx % 3));
+    }
+    for (int k = 1; k < config.nz - 1; k++) {
+        for (int j = 1; j < config.ny - 1; j++) {
+            for (int i = 1; i < config.nx - 1; i++) {
+                const int idx = field.toFlatIndex(i, j, k);
+                const std::complex<double> psi = field.getDeltaPhi(i, j, k);
+                const std::complex<double> rhs = field.computeLaplacian(i, j, k) - frac[idx]
+                                               - field.computePotential(i, j, k) * psi + sources[idx];
+                expected[idx] = psi + config.dt * rhs;
+            }
+        }
+    }
+
+    field.evolveStep(frac, sources);
+
+    double max_error = 0.0;
+    for (int idx = 0; idx < total; idx++) {
+        max_error = std::max(max_error, std::abs(field.getDeltaPhiFlat()[idx] - expected[idx]));
+    }
+
+    // Caches now describe the evolved field
+    double max_cache_error = 0.0;
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) {
+                const double grad = field.computeGradient(i, j, k).magnitude();
+                const double V = field.computePotential(i, j, k);
+                max_cache_error = std::max(max_cache_error, std::abs(field.getGradientMagnitude(i, j, k) - grad) / std::max(grad, 1e-30));
+                max_cache_error = std::max(max_cache_error, std::abs(field.getPotential(i, j, k) - V) / std::max(V, 1e-30));
+            }
+        }
+    }
+
+    std::cout << "Max evolve error: " << max_error << ", max relative cache error: " << max_cache_error << std::endl;
+    if (max_error > 1e-12 || max_cache_error > 1e-12) {
+        std::cout << "FAILED: fused sweep differs from per-point stencils" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ Fused sweep matches per-point stencils" << std::endl;
+    return true;
+}
+
+// Test 10: Truncated, separable source painting matches full-grid Gaussians
+bool test_source_assembly() {
+    std::cout << "\n=== Test 10: Source Assembly ===" << std::endl;
+
+    SymmetryFieldConfig field_config;
+    field_config.nx = 40;
+    field_config.ny = 24;
+    field_config.nz = 20;
+    field_config.dx = 1000.0;
+    field_config.dy = 1200.0;
+    field_config.dz = 900.0;
+    SymmetryField field(field_config);
+
+    BinaryMergerConfig merger_config;
+    merger_config.mass1 = 30.0;
+    merger_config.mass2 = 20.0;
+    merger_config.initial_separation = 12e3;
+    merger_config.initial_orbital_phase = 0.4;
+    merger_config.gaussian_width = 2e3;
+    merger_config.source_amplitude = 3.0;
+    merger_config.center = Vector3D(20e3, 14e3, 9e3);
+
+    // Direct evaluation of A Σ_b (m_b/m_1) exp(-|x - x_b|²/(2σ²)) at every point
+    auto direct = [&](const BinaryMerger& merger, int i, int j, int k) {
+        const Vector3D pos = field.toPosition(i, j, k);
+        const double two_sigma_sq = 2.0 * merger_config.gaussian_width * merger_config.gaussian_width;
+        const Vector3D d1 = pos - merger.getPosition1();
+        const Vector3D d2 = pos - merger.getPosition2();
+        return merger_config.source_amplitude *
+               (std::exp(-(d1.x * d1.x + d1.y * d1.y + d1.z * d1.z) / two_sigma_sq) +
+                merger_config.mass2 / merger_config.mass1 *
+                std::exp(-(d2.x * d2.x + d2.y * d2.y + d2.z * d2.z) / two_sigma_sq));
+    };
+
+    double max_full_error = 0.0;
+    double max_truncated_error = 0.0;
+    double peak = 0.0;
+    int untouched_nonzero = 0;
+
+    for (double truncation : {0.0, 3.0}) {
+        merger_config.source_truncation_sigma = truncation;
+        BinaryMerger merger(merger_config);
+        std::vector<std::complex<double>> sources(field.getTotalPoints(), std::complex<double>(5.0, 7.0));
+        merger.computeSourceTerms(field, 0.0, sources);
+
+        const double cutoff = truncation * merger_config.gaussian_width;
+        for (int k = 0; k < field_config.nz; k++) {
+            for (int j = 0; j < field_config.ny; j++) {
+                for (int i = 0; i < field_config.nx; i++) {
+                    const std::complex<double> S = sources[field.toFlatIndex(i, j, k)];
+                    const double expected = direct(merger, i, j, k);
+                    const double error = std::abs(S - expected);
+                    peak = std::max(peak, expected);
+                    if (truncation == 0.0) {
+                        max_full_error = std::max(max_full_error, error);
+                        continue;
+                    }
+                    max_truncated_error = std::max(max_truncated_error, error);
+
+                    // Outside both boxes the buffer must be exactly zero
+                    const Vector3D pos = field.toPosition(i, j, k);
+                    bool inside = false;
+                    for (const Vector3D& c : {merger.getPosition1(), merger.getPosition2()}) {
+                        inside = inside || (std::abs(pos.x - c.x) <= cutoff &&
+                                            std::abs(pos.y - c.y) <= cutoff &&
+                                            std::abs(pos.z - c.z) <= cutoff);
+                    }
+                    if (!inside && S != std::complex<double>(0.0, 0.0)) {
+                        untouched_nonzero++;
+                    }
+                }
+            }
+        }
+    }
+
+    // Truncation drops at most one e^{-t²/2}-sized tail per BH
+    const double tail_bound = merger_config.source_amplitude *
+                              (1.0 + merger_config.mass2 / merger_config.mass1) * std::exp(-4.5);
+    std::cout << "Peak source: " << peak << ", full-grid error: " << max_full_error
+              << ", truncated error: " << max_truncated_error << " (bound " << tail_bound << ")" << std::endl;
+    if (max_full_error > 1e-12 * peak || max_truncated_error > tail_bound || untouched_nonzero != 0) {
+        std::cout << "FAILED: source assembly differs from direct Gaussians" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ Source assembly matches direct Gaussians" << std::endl;
+    return true;
+}
+
+// Test 11: Field-wide projection passes match the per-point projections
+bool test_projection_field() {
+    std::cout << "\n=== Test 11: Projection Field Passes ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 11;
+    config.ny = 9;
+    config.nz = 8;
+    config.dx = 1000.0;
+    config.dy = 1300.0;
+    config.dz = 700.0;
+    SymmetryField field(config);
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) {
+                field.setDeltaPhi(i, j, k, std::complex<double>(std::sin(0.6 * i + 0.2 * k), std::cos(0.4 * j - 0.3 * i)));
+            }
+        }
+    }
+    field.updateCaches();
+
+    double max_strain_error = 0.0;
+    double max_phi_error = 0.0;
+    double max_tt_error = 0.0;
+    std::vector<double> phi_field, h_plus, h_cross;
+
+    for (const Vector3D& n : {Vector3D(0, 0, -1), Vector3D(0.3, -0.5, 0.8), Vector3D(1, 0, 0)}) {
+        ProjectionConfig proj_config;
+        proj_config.detector_normal = n;
+        ProjectionOperators projector(proj_config);
+
+        projector.compute_phi_mode_field(field, phi_field);
+        projector.compute_strain_field(field, h_plus, h_cross);
+
+        for (int k = 0; k < config.nz; k++) {
+            for (int j = 0; j < config.ny; j++) {
+                for (int i = 0; i < config.nx; i++) {
+                    const int idx = field.toFlatIndex(i, j, k);
+                    const Tensor4x4 O = projector.compute_stress_energy_tensor(field, i, j, k);
+                    const auto strain = projector.compute_strain(O, n);
+                    const double scale = std::max(1e-12, std::abs(O(1, 1)) + std::abs(O(2, 2)) + std::abs(O(3, 3)));
+                    max_strain_error = std::max(max_strain_error, std::abs(h_plus[idx] - strain.h_plus) / scale);
+                    max_strain_error = std::max(max_strain_error, std::abs(h_cross[idx] - strain.h_cross) / scale);
+                    max_phi_error = std::max(max_phi_error, std::abs(phi_field[idx] - std::abs(field.getDeltaPhi(i, j, k))));
+
+                    // TT part is transverse, traceless and a projection
+                    const Tensor4x4 TT = projector.apply_TT_projection(O);
+                    const Tensor4x4 TT2 = projector.apply_TT_projection(TT);
+                    const Vector3D u = n.normalized();
+                    const double u_vec[3] = {u.x, u.y, u.z};
+                    for (int a = 0; a < 3; a++) {
+                        double transverse = 0.0;
+                        for (int b = 0; b < 3; b++) {
+                            transverse += TT(a + 1, b + 1) * u_vec[b];
+                            max_tt_error = std::max(max_tt_error, std::abs(TT2(a + 1, b + 1) - TT(a + 1, b + 1)) / scale);
+                        }
+                        max_tt_error = std::max(max_tt_error, std::abs(transverse) / scale);
+                    }
+                    max_tt_error = std::max(max_tt_error, std::abs(TT(1, 1) + TT(2, 2) + TT(3, 3)) / scale);
+                }
+            }
+        }
+    }
+
+    // The axis-aligned detector keeps the original h_+ = O_xx - O_yy, h_× = 2 O_xy
+    ProjectionOperators axis_projector{ProjectionConfig()};
+    const Tensor4x4 O = axis_projector.compute_stress_energy_tensor(field, 4, 4, 4);
+    const auto strain = axis_projector.compute_strain(O, ProjectionConfig().detector_normal);
+    const bool axis_exact = strain.h_plus == O(1, 1) - O(2, 2) && strain.h_cross == 2.0 * O(1, 2);
+
+    std::cout << "Max strain error: " << max_strain_error << ", phi error: " << max_phi_error
+              << ", TT error: " << max_tt_error << std::endl;
+    if (max_strain_error > 1e-12 || max_phi_error != 0.0 || max_tt_error > 1e-12 || !axis_exact) {
+        std::cout << "FAILED: field passes differ from per-point projections" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ Field passes match per-point projections" << std::endl;
+    return true;
+}
+
+// Test 12: Field + fractional history checkpoint restarts the same trajectory
+bool test_checkpoint_restart() {
+    std::cout << "\n=== Test 12: Checkpoint/Restart ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 9;
+    config.ny = 8;
+    config.nz = 7;
+    config.dt = 0.001;
+    FractionalSolverConfig frac_config;
+    frac_config.T_max = 1.0;
+    frac_config.soe_rank = 8;
+
+    SymmetryField field(config);
+    const int total = field.getTotalPoints();
+    FractionalSolver solver(frac_config, total);
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) {
+                field.setDeltaPhi(i, j, k, std::complex<double>(std::sin(0.4 * i + 0.3 * k), std::cos(0.2 * j)));
+                field.setAlpha(i, j, k, 1.2 + 0.1 * ((i + j) % 4));
+            }
+        }
+    }
+    solver.setAlphaField(field.getAlphaFlat());
+
+    std::vector<std::complex<double>> sources(total), frac(total);
+    for (int idx = 0; idx < total; idx++) {
+        sources[idx] = std::complex<double>(0.001 * (idx % 5), -0.002);
+    }
+    auto step = [&](SymmetryField& f, FractionalSolver& s) {
+        s.computeDerivatives(frac);
+        f.evolveStep(frac, sources);
+        s.updateHistory(sources, config.dt);
+    };
+    for (int n = 0; n < 4; n++) {
+        step(field, solver);
+    }
+
+    const std::string path = "test_gw_checkpoint.bin";
+    dase::CheckpointWriter writer;
+    field.saveCheckpoint(writer);
+    solver.saveCheckpoint(writer);
+    std::string error;
+    if (!writer.write(path, &error)) {
+        std::cout << "FAILED: " << error << std::endl;
+        return false;
+    }
+
+    SymmetryField restored_field(config);
+    FractionalSolver restored_solver(frac_config, total);
+    dase::CheckpointReader reader;
+    if (!reader.open(path, &error) || !restored_field.loadCheckpoint(reader, &error) ||
+        !restored_solver.loadCheckpoint(reader, &error)) {
+        std::cout << "FAILED: " << error << std::endl;
+        return false;
+    }
+    if (restored_field.getCurrentTime() != field.getCurrentTime() ||
+        restored_solver.getKernelIndexAt(total - 1) != solver.getKernelIndexAt(total - 1)) {
+        std::cout << "FAILED: time or α field not restored" << std::endl;
+        return false;
+    }
+
+    for (int n = 0; n < 3; n++) {
+        step(field, solver);
+        step(restored_field, restored_solver);
+    }
+    if (restored_field.getDeltaPhiFlat() != field.getDeltaPhiFlat()) {
+        std::cout << "FAILED: restarted trajectory diverges" << std::endl;
+        return false;
+    }
+
+    FractionalSolverConfig other_rank = frac_config;
+    other_rank.soe_rank = 12;
+    FractionalSolver mismatched(other_rank, total);
+    if (mismatched.loadCheckpoint(reader, &error)) {
+        std::cout << "FAILED: SOE rank mismatch accepted" << std::endl;
+        return false;
+    }
+    reader.close();
+    std::remove(path.c_str());
+
+    std::cout << "✓ Restart reproduces the trajectory exactly" << std::endl;
+    return true;
+}
+
+// Test 13: Block-structured mesh refinement
+bool test_mesh_refinement() {
+    std::cout << "\n=== Test 13: Mesh Refinement ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = config.ny = config.nz = 17;
+    config.dx = config.dy = config.dz = 1.0;
+    config.dt = 0.02;
+    config.alpha_min = 1.2;
+    FractionalSolverConfig frac_config;
+    frac_config.T_max = 1.0;
+    frac_config.soe_rank = 8;
+
+    BinaryMergerConfig merger_config;
+    merger_config.initial_separation = 3.0;
+    merger_config.gaussian_width = 1.5;
+    merger_config.center = Vector3D(8.0, 8.0, 8.0);
+
+    // Offset grids: toPosition/toIndices and source painting follow the origin
+    {
+        SymmetryFieldConfig shifted = config;
+        shifted.origin = Vector3D(2.0, 3.0, 4.0);
+        SymmetryField a(config), b(shifted);
+        BinaryMerger merger(merger_config);
+        std::vector<std::complex<double>> sa, sb;
+        merger.computeSourceTerms(a, 0.0, sa);
+        merger.computeSourceTerms(b, 0.0, sb);
+        int i, j, k;
+        b.toIndices(Vector3D(5.0, 7.0, 9.0), i, j, k);
+        if (i != 3 || j != 4 || k != 5 || b.toPosition(1, 1, 1).z != 5.0 ||
+            std::abs(sb[b.toFlatIndex(3, 3, 3)] - sa[a.toFlatIndex(5, 6, 7)]) > 1e-12) {
+            std::cout << "FAILED: grid origin not applied" << std::endl;
+            return false;
+        }
+    }
+
+    // Same α step for step on the patches and on a uniform grid at dx/2, dt/2
+    MeshRefinementConfig amr;
+    amr.levels = 1;
+    amr.ratio = 2;
+    amr.patch_cells = 8;
+    amr.regrid_interval = 4;
+    RefinedSymmetryField grid(config, frac_config, amr);
+    auto drive = [](const SymmetryField&, double, GWStepWorkspace& ws) {
+        ws.second_derivatives = ws.source_terms;
+    };
+    grid.setSourceHook(drive);
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) grid.baseField().setAlpha(i, j, k, 1.6 + 0.02 * (i % 5));
+        }
+    }
+    grid.applyAlphaField();
+
+    SymmetryFieldConfig fine_config = config;
+    fine_config.nx = fine_config.ny = fine_config.nz = 33;
+    fine_config.dx = fine_config.dy = fine_config.dz = 0.5;
+    fine_config.dt = 0.01;
+    SymmetryField fine(fine_config);
+    for (int k = 0; k < fine_config.nz; k++) {
+        for (int j = 0; j < fine_config.ny; j++) {
+            for (int i = 0; i < fine_config.nx; i++) {
+                fine.setAlpha(i, j, k, grid.baseField().getAlphaAt(fine.toPosition(i, j, k)));
+            }
+        }
+    }
+    FractionalSolverConfig fine_frac = frac_config;
+    fine_frac.dt = fine_config.dt;
+    FractionalSolver fine_solver(fine_frac, fine.getTotalPoints());
+    fine_solver.setAlphaField(fine.getAlphaFlat());
+    GWStepWorkspace fine_ws(fine.getTotalPoints());
+
+    SymmetryField coarse(config);
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) coarse.setAlpha(i, j, k, grid.baseField().getAlpha(i, j, k));
+        }
+    }
+    FractionalSolver coarse_solver(frac_config, coarse.getTotalPoints());
+    coarse_solver.setAlphaField(coarse.getAlphaFlat());
+    GWStepWorkspace coarse_ws(coarse.getTotalPoints());
+
+    BinaryMerger merger(merger_config), fine_merger(merger_config), coarse_merger(merger_config);
+    auto uniform_step = [&](SymmetryField& f, FractionalSolver& s, GWStepWorkspace& ws, BinaryMerger& m) {
+        m.computeSourceTerms(f, f.getCurrentTime(), ws.source_terms);
+        drive(f, f.getCurrentTime(), ws);
+        s.computeDerivatives(ws.fractional_derivatives);
+        f.evolveStep(ws.fractional_derivatives, ws.source_terms);
+        s.updateHistory(ws.second_derivatives, f.getTimestep());
+    };
+    const int steps = 10;
+    for (int n = 0; n < steps; n++) {
+        grid.step(merger);
+        uniform_step(fine, fine_solver, fine_ws, fine_merger);
+        uniform_step(fine, fine_solver, fine_ws, fine_merger);
+        fine_merger.evolveOrbit(config.dt);
+        uniform_step(coarse, coarse_solver, coarse_ws, coarse_merger);
+        coarse_merger.evolveOrbit(config.dt);
+    }
+    if (grid.getNumLevels() != 1 || grid.getNumPatches(1) != 1 || grid.getRegridCount() != 3 ||
+        std::abs(grid.getCurrentTime() - steps * config.dt) > 1e-12 ||
+        std::abs(grid.patchField(1, 0).getCurrentTime() - grid.getCurrentTime()) > 1e-12) {
+        std::cout << "FAILED: unexpected patch layout or clocks" << std::endl;
+        return false;
+    }
+
+    // Patch interior vs the uniform fine grid, against a coarse-only run
+    const SymmetryField& patch = grid.patchField(1, 0);
+    double patch_error = 0.0, coarse_error = 0.0, scale = 0.0;
+    for (int k = 0; k < patch.getNz(); k++) {
+        for (int j = 0; j < patch.getNy(); j++) {
+            for (int i = 0; i < patch.getNx(); i++) {
+                int fi, fj, fk;
+                fine.toIndices(patch.toPosition(i, j, k), fi, fj, fk);
+                const std::complex<double> reference = fine.getDeltaPhi(fi, fj, fk);
+                scale = std::max(scale, std::abs(reference));
+                // The ghost layer carries the coarse time error a few fine cells in
+                const int edge = std::min({i, j, k, patch.getNx() - 1 - i, patch.getNy() - 1 - j, patch.getNz() - 1 - k});
+                if (edge < 3) continue;
+                patch_error = std::max(patch_error, std::abs(patch.getDeltaPhi(i, j, k) - reference));
+                if (fi % 2 == 0 && fj % 2 == 0 && fk % 2 == 0) {
+                    coarse_error = std::max(coarse_error, std::abs(coarse.getDeltaPhi(fi / 2, fj / 2, fk / 2) - reference));
+                }
+            }
+        }
+    }
+    std::cout << "  Patch error " << patch_error / scale << ", coarse-only error " << coarse_error / scale
+              << " (relative to max |δΦ| = " << scale << ")" << std::endl;
+    if (scale <= 0.0 || patch_error > 1e-4 * scale || 10.0 * patch_error >= coarse_error) {
+        std::cout << "FAILED: patch does not track the fine-grid solution" << std::endl;
+        return false;
+    }
+    const Vector3D probe = patch.toPosition(patch.getNx() / 2 + 1, patch.getNy() / 2, patch.getNz() / 2);
+    if (grid.getDeltaPhiAt(probe) != patch.getDeltaPhiAt(probe)) {
+        std::cout << "FAILED: getDeltaPhiAt does not read the finest level" << std::endl;
+        return false;
+    }
+
+    // Moving the patch keeps δΦ and zᵣ where old and new patches overlap
+    const RefinedPatchInfo before = grid.getPatchInfo(1, 0);
+    const Vector3D kept_point = patch.toPosition(before.cells[0] * 2 - 4, 6, 6);
+    int pi, pj, pk;
+    patch.toIndices(kept_point, pi, pj, pk);
+    const std::complex<double> kept_phi = patch.getDeltaPhi(pi, pj, pk);
+    const std::complex<double> kept_z = grid.patchSolver(1, 0).getHistoryState(patch.toFlatIndex(pi, pj, pk), 3);
+    grid.regrid({merger.getPosition1() + Vector3D(2.0, 0.0, 0.0), merger.getPosition2() + Vector3D(2.0, 0.0, 0.0)});
+    const RefinedPatchInfo after = grid.getPatchInfo(1, 0);
+    const SymmetryField& moved = grid.patchField(1, 0);
+    moved.toIndices(kept_point, pi, pj, pk);
+    const int moved_idx = moved.toFlatIndex(pi, pj, pk);
+    int bi, bj, bk;
+    const Vector3D new_point = moved.toPosition(moved.getNx() - 3, 6, 6);
+    grid.baseField().toIndices(new_point, bi, bj, bk);
+    const int new_idx = moved.toFlatIndex(moved.getNx() - 3, 6, 6);
+    if (after.lo[0] != before.lo[0] + 2 || moved.getDeltaPhi(pi, pj, pk) != kept_phi ||
+        grid.patchSolver(1, 0).getHistoryState(moved_idx, 3) != kept_z ||
+        moved.getDeltaPhiFlat()[new_idx] != grid.baseField().getDeltaPhi(bi, bj, bk) ||
+        grid.patchSolver(1, 0).getHistoryState(new_idx, 3) !=
+            grid.baseSolver().getHistoryState(grid.baseField().toFlatIndex(bi, bj, bk), 3)) {
+        std::cout << "FAILED: regrid lost the patch state or history" << std::endl;
+        return false;
+    }
+
+    // Full-weighting restriction conserves ∫δΦ dV
+    SymmetryField& base = grid.baseField();
+    std::fill(base.deltaPhiForWrite().begin(), base.deltaPhiForWrite().end(), std::complex<double>(0.0, 0.0));
+    SymmetryField& bump = grid.patchField(1, 0);
+    std::vector<std::complex<double>>& bump_phi = bump.deltaPhiForWrite();
+    std::fill(bump_phi.begin(), bump_phi.end(), std::complex<double>(0.0, 0.0));
+    double fine_integral = 0.0;
+    for (int k = 2; k <= bump.getNz() - 3; k++) {
+        for (int j = 2; j <= bump.getNy() - 3; j++) {
+            for (int i = 2; i <= bump.getNx() - 3; i++) {
+                const double v = 1.0 + std::sin(0.7 * i) * std::cos(0.3 * j + 0.5 * k);
+                bump_phi[bump.toFlatIndex(i, j, k)] = v;
+                fine_integral += v * 0.125;
+            }
+        }
+    }
+    grid.restrictPatches();
+    double coarse_integral = 0.0;
+    for (const auto& v : base.getDeltaPhiFlat()) coarse_integral += v.real();
+    if (std::abs(coarse_integral - fine_integral) > 1e-10 * fine_integral) {
+        std::cout << "FAILED: restriction changed the integral (" << coarse_integral << " vs "
+                  << fine_integral << ")" << std::endl;
+        return false;
+    }
+
+    // Two levels around the sources cost a fraction of the uniform dx/4 grid
+    SymmetryFieldConfig big = config;
+    big.nx = big.ny = big.nz = 33;
+    BinaryMergerConfig big_merger_config = merger_config;
+    big_merger_config.center = Vector3D(16.0, 16.0, 16.0);
+    BinaryMerger big_merger(big_merger_config);
+    amr.levels = 2;
+    RefinedSymmetryField nested(big, frac_config, amr);
+    nested.step(big_merger);
+    const double point_ratio = double(nested.getEquivalentUniformPoints()) / double(nested.getTotalPoints());
+    const double update_ratio = double(nested.getEquivalentUniformPoints()) * 4.0 / double(nested.getPointUpdates());
+    const RefinedPatchInfo inner = nested.getPatchInfo(2, 0);
+    std::cout << "  2 levels: " << nested.getTotalPoints() << " points vs " << nested.getEquivalentUniformPoints()
+              << " uniform (" << point_ratio << "x), " << update_ratio << "x fewer point updates, "
+              << nested.getMemoryUsage() / 1024 << " KB" << std::endl;
+    if (nested.getNumLevels() != 2 || inner.dx != 0.25 || point_ratio < 10.0 || update_ratio < 10.0) {
+        std::cout << "FAILED: nested patches do not save an order of magnitude" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ Patches match the fine grid, restriction conserves, history follows regrids" << std::endl;
+    return true;
+}
+
+// Test 14: Detector array sampling and waveform streaming
+bool test_detector_array() {
+    std::cout << "\n=== Test 14: Detector Array ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 12;
+    config.ny = 10;
+    config.nz = 9;
+    config.origin = Vector3D(-5e3, 0.0, 2e3);
+    SymmetryField field(config);
+    for (int k = 0; k < config.nz; k++) {
+        for (int j = 0; j < config.ny; j++) {
+            for (int i = 0; i < config.nx; i++) {
+                field.setDeltaPhi(i, j, k, std::complex<double>(std::sin(0.5 * i + 0.2 * j) * std::cos(0.3 * k),
+                                                                0.1 * std::cos(0.4 * j - 0.7 * i)));
+            }
+        }
+    }
+
+    std::vector<GWDetector> detectors;
+    for (int n = 0; n < 40; n++) {
+        GWDetector d;
+        d.position = config.origin + Vector3D(250.0 * n + 100.0, 220.0 * (n % 9) + 40.0, 190.0 * (n % 7) + 300.0);
+        d.normal = Vector3D(0.1 * (n % 3), 0.2 * (n % 5) - 0.3, n % 2 ? 1.0 : -1.0);
+        detectors.push_back(d);
+    }
+    detectors.push_back({config.origin + Vector3D(-4e3, 1e3, 1e3), Vector3D(0, 0, 1)});   // Outside: clamped
+    const size_t count = detectors.size();
+
+    // Nearest: compute_strain_at_observer per detector
+    DetectorArray nearest(field, detectors, DetectorSampling::Nearest);
+    std::vector<double> h_plus(count), h_cross(count);
+    nearest.sample(field, h_plus.data(), h_cross.data());
+    double nearest_error = 0.0;
+    for (size_t d = 0; d < count; d++) {
+        ProjectionConfig pc;
+        pc.observer_position = detectors[d].position;
+        pc.detector_normal = detectors[d].normal;
+        const auto strain = ProjectionOperators(pc).compute_strain_at_observer(field);
+        nearest_error = std::max({nearest_error, std::abs(strain.h_plus - h_plus[d]), std::abs(strain.h_cross - h_cross[d])});
+    }
+
+    // Trilinear: the strain field of each detector's projector, interpolated; δΦ as getDeltaPhiAt
+    DetectorArray trilinear(field, detectors);
+    std::vector<std::complex<double>> phi(count);
+    trilinear.sample(field, h_plus.data(), h_cross.data());
+    trilinear.sampleDeltaPhi(field, phi.data());
+    double trilinear_error = 0.0, phi_error = 0.0;
+    std::vector<double> plus_field, cross_field;
+    for (size_t d = 0; d + 1 < count; d++) {
+        ProjectionConfig pc;
+        pc.detector_normal = detectors[d].normal;
+        ProjectionOperators(pc).compute_strain_field(field, plus_field, cross_field);
+        const Vector3D rel = detectors[d].position - config.origin;
+        const double f[3] = {rel.x / config.dx, rel.y / config.dy, rel.z / config.dz};
+        const int i0 = int(f[0]), j0 = int(f[1]), k0 = int(f[2]);
+        double expected_plus = 0.0, expected_cross = 0.0;
+        for (int c = 0; c < 8; c++) {
+            const int o[3] = {c & 1, (c >> 1) & 1, (c >> 2) & 1};
+            double w = 1.0;
+            w *= o[0] ? f[0] - i0 : 1.0 - (f[0] - i0);
+            w *= o[1] ? f[1] - j0 : 1.0 - (f[1] - j0);
+            w *= o[2] ? f[2] - k0 : 1.0 - (f[2] - k0);
+            const int idx = field.toFlatIndex(i0 + o[0], j0 + o[1], k0 + o[2]);
+            expected_plus += w * plus_field[idx];
+            expected_cross += w * cross_field[idx];
+        }
+        trilinear_error = std::max({trilinear_error, std::abs(expected_plus - h_plus[d]), std::abs(expected_cross - h_cross[d])});
+        phi_error = std::max(phi_error, std::abs(phi[d] - field.getDeltaPhiAt(detectors[d].position)));
+    }
+    std::cout << "Nearest error: " << nearest_error << ", trilinear error: " << trilinear_error
+              << ", δΦ error: " << phi_error << std::endl;
+    if (nearest_error > 1e-18 || trilinear_error > 1e-18 || phi_error > 1e-14) {
+        std::cout << "FAILED: detector samples differ from per-observer projections" << std::endl;
+        return false;
+    }
+
+    SymmetryFieldConfig other = config;
+    other.nx = 8;
+    SymmetryField other_field(other);
+    bool threw = false;
+    try {
+        trilinear.sample(other_field, h_plus.data(), h_cross.data());
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cout << "FAILED: sampling a different grid was accepted" << std::endl;
+        return false;
+    }
+
+    // Streaming across block swaps, then an unclosed (truncated) copy
+    const std::string path = "test_gw_waveform.gwf";
+    WaveformStreamWriter writer;
+    if (!writer.open(path, detectors, 3)) {
+        std::cout << "FAILED: cannot open " << path << std::endl;
+        return false;
+    }
+    const int frames = 10;
+    std::vector<double> expected_plus, expected_cross;
+    for (int n = 0; n < frames; n++) {
+        field.setDeltaPhi(5, 5, 5, std::complex<double>(0.1 * n, 0.0));
+        trilinear.sample(field, h_plus.data(), h_cross.data());
+        expected_plus.insert(expected_plus.end(), h_plus.begin(), h_plus.end());
+        expected_cross.insert(expected_cross.end(), h_cross.begin(), h_cross.end());
+        if (!writer.record(0.5 * n, trilinear, field)) {
+            std::cout << "FAILED: record" << std::endl;
+            return false;
+        }
+    }
+    if (!writer.close() || writer.framesRecorded() != uint64_t(frames)) {
+        std::cout << "FAILED: close" << std::endl;
+        return false;
+    }
+    WaveformData data;
+    std::string error;
+    if (!readWaveformFile(path, data, &error) || data.frames() != size_t(frames) ||
+        data.h_plus != expected_plus || data.h_cross != expected_cross || data.time[7] != 3.5 ||
+        data.detectors.size() != count || data.detectors[3].normal.y != detectors[3].normal.y) {
+        std::cout << "FAILED: waveform round trip " << error << std::endl;
+        return false;
+    }
+
+    // A crash leaves frame_count 0 and a partial frame: complete frames survive
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        const size_t cut = WaveformStreamWriter::kHeaderBytes + 6 * count * sizeof(double) +
+                           6 * writer.frameBytes() + 40;
+        std::fill(bytes.begin() + 16, bytes.begin() + 24, 0);
+        std::ofstream truncated(path, std::ios::binary | std::ios::trunc);
+        truncated.write(bytes.data(), static_cast<std::streamsize>(cut));
+    }
+    WaveformData partial;
+    const bool recovered = readWaveformFile(path, partial, &error) && partial.frames() == 6 &&
+                           std::equal(partial.h_cross.begin(), partial.h_cross.end(), expected_cross.begin());
+    std::remove(path.c_str());
+    if (!recovered) {
+        std::cout << "FAILED: truncated file not recovered " << error << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ " << count << " detectors sampled in one pass; " << frames
+              << " frames streamed and read back" << std::endl;
+    return true;
+}
+
+// Test 15: Shared SOE kernel store
+bool test_soe_kernel_store() {
+    std::cout << "\n=== Test 15: SOE Kernel Store ===" << std::endl;
+
+    SOEKernelStore& store = SOEKernelStore::global();
+    FractionalSolverConfig config;
+    config.T_max = 3.25;   // Keys no other test uses
+    config.soe_rank = 10;
+    config.alpha_min = 1.0;
+    config.alpha_max = 2.0;
+    config.alpha_resolution = 0.05;
+
+    // Solvers of one sweep: the second fits nothing
+    const uint64_t fits_before = store.getFitCount();
+    FractionalSolver first(config, 64);
+    FractionalSolver second(config, 64);
+    std::vector<double> alpha(64);
+    for (int i = 0; i < 64; i++) alpha[i] = 1.0 + i / 63.0;
+    first.setAlphaField(alpha);
+    const uint64_t first_fits = store.getFitCount() - fits_before;
+    second.setAlphaField(alpha);
+    const uint64_t second_fits = store.getFitCount() - fits_before - first_fits;
+    if (first_fits != uint64_t(first.getNumKernelGroups()) || second_fits != 0 ||
+        &first.getKernel(1.5) != &second.getKernel(1.5)) {
+        std::cout << "FAILED: solvers did not share kernels (" << first_fits << ", " << second_fits << ")" << std::endl;
+        return false;
+    }
+    FractionalSolverConfig longer = config;
+    longer.T_max = 6.5;
+    FractionalSolver third(longer, 64);
+    if (&third.getKernel(1.5) == &first.getKernel(1.5) ||
+        third.getKernel(1.5).exponents[0] != 1.0 / longer.T_max) {
+        std::cout << "FAILED: kernels with different T_max were shared" << std::endl;
+        return false;
+    }
+
+    // Concurrent first use fits each key once
+    const uint64_t fits_threaded = store.getFitCount();
+    std::vector<std::thread> threads;
+    std::vector<std::vector<const SOEKernel*>> seen(4);
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            for (int k = 0; k < 50; k++) {
+                seen[t].push_back(store.acquire(1.0 + 0.02 * k, 4.75, 8).get());
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    if (store.getFitCount() - fits_threaded != 50 || seen[0] != seen[1] || seen[0] != seen[2] || seen[0] != seen[3]) {
+        std::cout << "FAILED: concurrent acquire fitted duplicates" << std::endl;
+        return false;
+    }
+
+    // Persist, reload into a fresh store: same coefficients, no fits
+    const std::string path = "test_soe_kernels.bin";
+    std::string error;
+    SOEKernelStore reloaded;
+    if (!store.save(path, &error) || !reloaded.load(path, &error) || reloaded.size() != store.size()) {
+        std::cout << "FAILED: store round trip " << error << std::endl;
+        std::remove(path.c_str());
+        return false;
+    }
+    const std::shared_ptr<const SOEKernel> saved = store.acquire(1.5, config.T_max, config.soe_rank);
+    const std::shared_ptr<const SOEKernel> loaded = reloaded.acquire(1.5, config.T_max, config.soe_rank);
+    const bool identical = reloaded.getFitCount() == 0 && loaded->rank == saved->rank &&
+                           loaded->weights == saved->weights && loaded->exponents == saved->exponents;
+
+    // A file from another fit version is ignored
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        const uint32_t other_version = SOEKernelStore::kFitVersion + 1;
+        file.seekp(8);
+        file.write(reinterpret_cast<const char*>(&other_version), sizeof(other_version));
+    }
+    SOEKernelStore stale;
+    const bool rejected = !stale.load(path, &error) && stale.size() == 0;
+    std::remove(path.c_str());
+    if (!identical || !rejected) {
+        std::cout << "FAILED: reloaded kernels differ or a stale store was accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ " << first_fits << " kernels fitted once for two solvers; " << store.size()
+              << " kernels persisted and reloaded without refitting" << std::endl;
+    return true;
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "IGSOA GW Engine - Basic Functionality Tests" << std::endl;
     std::cout << "========================================" << std::endl;
 
     int passed = 0;
-    int total = 5;
+    int total = 15;
 
     if (test_symmetry_field_basic()) {
         passed++;
@@ -365,6 +1469,76 @@ int main() {
         std::cout << "✗ Test 5 FAILED" << std::endl;
     }
 
+    if (test_fractional_history()) {
+        passed++;
+        std::cout << "✓ Test 6 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 6 FAILED" << std::endl;
+    }
+
+    if (test_fractional_grouping()) {
+        passed++;
+        std::cout << "✓ Test 7 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 7 FAILED" << std::endl;
+    }
+
+    if (test_allocation_free_step()) {
+        passed++;
+        std::cout << "✓ Test 8 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 8 FAILED" << std::endl;
+    }
+
+    if (test_fused_field_sweep()) {
+        passed++;
+        std::cout << "✓ Test 9 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 9 FAILED" << std::endl;
+    }
+
+    if (test_source_assembly()) {
+        passed++;
+        std::cout << "✓ Test 10 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 10 FAILED" << std::endl;
+    }
+
+    if (test_projection_field()) {
+        passed++;
+        std::cout << "✓ Test 11 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 11 FAILED" << std::endl;
+    }
+
+    if (test_checkpoint_restart()) {
+        passed++;
+        std::cout << "✓ Test 12 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 12 FAILED" << std::endl;
+    }
+
+    if (test_mesh_refinement()) {
+        passed++;
+        std::cout << "✓ Test 13 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 13 FAILED" << std::endl;
+    }
+
+    if (test_detector_array()) {
+        passed++;
+        std::cout << "✓ Test 14 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 14 FAILED" << std::endl;
+    }
+
+    if (test_soe_kernel_store()) {
+        passed++;
+        std::cout << "✓ Test 15 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 15 FAILED" << std::endl;
+    }
+
     std::cout << "\n========================================" << std::endl;
     std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
     std::cout << "========================================" << std::endl;
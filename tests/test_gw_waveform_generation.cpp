@@ -6,6 +6,8 @@
  * - FractionalSolver (memory dynamics)
  * - BinaryMerger (source terms)
  * - ProjectionOperators (GW strain extraction)
+ * - DetectorArray + WaveformStreamWriter (binary .gwf waveform, read back)
+ * - SOEKernelStore (kernels persisted across the runs of an α sweep)
  *
  * Generates the first IGSOA gravitational waveform!
  */
@@ -17,6 +19,10 @@
 #include "../src/cpp/igsoa_gw_engine/core/source_manager.h"
 #include "../src/cpp/igsoa_gw_engine/core/projection_operators.h"
 #include "../src/cpp/igsoa_gw_engine/core/echo_generator.h"
+#include "../src/cpp/igsoa_gw_engine/core/gw_step_workspace.h"
+#include "../src/cpp/igsoa_gw_engine/core/detector_array.h"
+#include "../src/cpp/igsoa_gw_engine/core/waveform_stream.h"
+#include "../src/cpp/igsoa_gw_engine/core/soe_kernel_store.h"
 #include "../src/cpp/utils/logger.h"
 #include <iostream>
 #include <fstream>
@@ -30,88 +36,6 @@
 
 using namespace dase::igsoa::gw;
 
-// Helper function to export waveform to CSV
-void exportWaveformCSV(
-    const std::string& filename,
-    const std::vector<double>& time,
-    const std::vector<double>& h_plus,
-    const std::vector<double>& h_cross,
-    const std::vector<double>& amplitude)
-{
-    // Validate inputs
-    if (filename.empty()) {
-        LOG_ERROR("Export failed: filename cannot be empty");
-        throw std::invalid_argument("filename cannot be empty");
-    }
-
-    if (time.size() != h_plus.size() || time.size() != h_cross.size() ||
-        time.size() != amplitude.size()) {
-        LOG_ERROR("Export failed: data vector size mismatch");
-        throw std::invalid_argument("All data vectors must have the same size");
-    }
-
-    try {
-        // Open file
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::string error_msg = "Failed to open file for writing: " + filename +
-                                   " (check permissions and disk space)";
-            LOG_ERROR(error_msg);
-            throw std::runtime_error(error_msg);
-        }
-
-        // Set formatting
-        file << std::scientific << std::setprecision(12);
-
-        // Write header
-        file << "time,h_plus,h_cross,amplitude\n";
-        if (!file.good()) {
-            std::string error_msg = "Write error while writing header to: " + filename;
-            LOG_ERROR(error_msg);
-            throw std::runtime_error(error_msg);
-        }
-
-        // Write data
-        for (size_t i = 0; i < time.size(); i++) {
-            file << time[i] << ","
-                 << h_plus[i] << ","
-                 << h_cross[i] << ","
-                 << amplitude[i] << "\n";
-
-            // Check write status periodically
-            if (i % 100 == 0 && !file.good()) {
-                std::string error_msg = "Write error at row " + std::to_string(i) +
-                                       " while exporting to: " + filename +
-                                       " (possible disk full)";
-                LOG_ERROR(error_msg);
-                throw std::runtime_error(error_msg);
-            }
-        }
-
-        // Final write check
-        if (!file.good()) {
-            std::string error_msg = "Write error occurred while exporting to: " + filename;
-            LOG_ERROR(error_msg);
-            throw std::runtime_error(error_msg);
-        }
-
-        file.close();
-
-        // Verify close succeeded
-        if (file.fail()) {
-            LOG_WARNING("Failed to close file properly: " + filename);
-        }
-
-        LOG_INFO("Waveform exported successfully: " + filename +
-                 " (" + std::to_string(time.size()) + " data points)");
-        std::cout << "Exported waveform to: " + filename << std::endl;
-
-    } catch (const std::exception& e) {
-        LOG_ERROR("Exception during waveform export: " + std::string(e.what()));
-        throw;  // Re-throw for caller to handle
-    }
-}
-
 // Main integration test
 int main(int argc, char** argv) {
     // Initialize logger
@@ -211,6 +135,12 @@ int main(int argc, char** argv) {
 
     auto init_start = std::chrono::high_resolution_clock::now();
 
+    // Later runs of a sweep reuse the kernels fitted by earlier ones
+    SOEKernelStore& kernel_store = SOEKernelStore::global();
+    if (kernel_store.load(SOEKernelStore::kDefaultPath)) {
+        std::cout << "✓ SOE kernel store loaded (" << kernel_store.size() << " kernels)" << std::endl;
+    }
+
     SymmetryField field(field_config);
     std::cout << "✓ SymmetryField created (" << field.getTotalPoints() << " points)" << std::endl;
 
@@ -236,6 +166,16 @@ int main(int argc, char** argv) {
     ProjectionOperators projector(proj_config);
     std::cout << "✓ ProjectionOperators created" << std::endl;
 
+    // The observer as a one-detector array (same samples as compute_strain_at_observer)
+    DetectorArray detectors(field, {{proj_config.observer_position, proj_config.detector_normal}},
+                            DetectorSampling::Nearest);
+    const std::string filename = "gw_waveform_alpha_" + std::to_string(alpha_value) + ".gwf";
+    WaveformStreamWriter waveform_writer;
+    if (!waveform_writer.open(filename, detectors.detectors())) {
+        std::cerr << "Failed to open waveform file: " << filename << std::endl;
+        return 1;
+    }
+
     EchoGenerator echo_generator(echo_config);
     std::cout << "✓ EchoGenerator created (ready for merger detection)" << std::endl;
 
@@ -249,6 +189,10 @@ int main(int argc, char** argv) {
     }
     std::cout << "✓ Alpha field initialized to " << alpha_value << std::endl;
 
+    // Kernels are resolved once from the α field; step buffers are reused
+    solver.setAlphaField(field.getAlphaFlat());
+    GWStepWorkspace workspace(field.getTotalPoints());
+
     auto init_end = std::chrono::high_resolution_clock::now();
     auto init_duration = std::chrono::duration_cast<std::chrono::milliseconds>(init_end - init_start).count();
     std::cout << "Initialization time: " << init_duration << " ms" << std::endl;
@@ -281,45 +225,62 @@ int main(int argc, char** argv) {
         }
 
         // Get source terms from binary
-        auto sources = merger.computeSourceTerms(field, t);
-
-        // Add echo sources if merger has occurred
-        if (merger_detected) {
-            Vector3D merger_center = merger_config.center;
-
-            // Add echo contribution at each grid point
-            for (int i = 0; i < field_config.nx; i++) {
-                for (int j = 0; j < field_config.ny; j++) {
-                    for (int k = 0; k < field_config.nz; k++) {
-                        Vector3D pos = field.toPosition(i, j, k);
-                        int idx = field.toFlatIndex(i, j, k);
-
-                        std::complex<double> echo_source = echo_generator.computeEchoSource(t, pos, merger_center);
-                        sources[idx] += echo_source;
+        auto& sources = workspace.source_terms;
+        {
+            DASE_PROFILE_PHASE(&workspace.profiler, GW_PHASE_SOURCE);
+            merger.computeSourceTerms(field, t, sources);
+
+            // Add echo sources if merger has occurred
+            if (merger_detected) {
+                Vector3D merger_center = merger_config.center;
+
+                // Add echo contribution at each grid point
+                for (int i = 0; i < field_config.nx; i++) {
+                    for (int j = 0; j < field_config.ny; j++) {
+                        for (int k = 0; k < field_config.nz; k++) {
+                            Vector3D pos = field.toPosition(i, j, k);
+                            int idx = field.toFlatIndex(i, j, k);
+
+                            std::complex<double> echo_source = echo_generator.computeEchoSource(t, pos, merger_center);
+                            sources[idx] += echo_source;
+                        }
                     }
                 }
             }
         }
 
         // Compute fractional derivatives
-        auto alpha_values = field.getAlphaValues();
-        auto frac_derivs = solver.computeDerivatives(alpha_values);
+        {
+            DASE_PROFILE_PHASE(&workspace.profiler, GW_PHASE_FRACTIONAL);
+            solver.computeDerivatives(workspace.fractional_derivatives);
+        }
 
         // Evolve field one timestep
-        field.evolveStep(frac_derivs, sources);
+        {
+            DASE_PROFILE_PHASE(&workspace.profiler, GW_PHASE_FIELD);
+            field.evolveStep(workspace.fractional_derivatives, sources);
+        }
 
         // Update fractional solver history
         // For now, use simple approximation: second derivative ≈ 0
         // TODO: Compute actual second time derivatives
-        std::vector<std::complex<double>> second_derivs(field.getTotalPoints(), std::complex<double>(0.0, 0.0));
-        solver.updateHistory(field.getDeltaPhiFlat(), second_derivs, alpha_values, field_config.dt);
+        {
+            DASE_PROFILE_PHASE(&workspace.profiler, GW_PHASE_HISTORY);
+            solver.updateHistory(workspace.second_derivatives, field_config.dt);
+        }
 
         // Evolve binary orbit
         merger.evolveOrbit(field_config.dt);
 
         // Extract and record strain (every output_interval steps)
         if (step % output_interval == 0) {
-            auto strain = projector.compute_strain_at_observer(field);
+            ProjectionOperators::StrainComponents strain{};
+            {
+                DASE_PROFILE_PHASE(&workspace.profiler, GW_PHASE_STRAIN);
+                detectors.sample(field, &strain.h_plus, &strain.h_cross);
+                waveform_writer.append(t, &strain.h_plus, &strain.h_cross);
+            }
+            strain.amplitude = std::sqrt(strain.h_plus * strain.h_plus + strain.h_cross * strain.h_cross);
 
             time_array.push_back(t);
             h_plus_array.push_back(strain.h_plus);
@@ -351,6 +312,14 @@ int main(int argc, char** argv) {
     std::cout << "\n✓ Evolution complete!" << std::endl;
     std::cout << "Evolution time: " << evolution_duration << " ms" << std::endl;
     std::cout << "Performance: " << num_steps * 1000.0 / evolution_duration << " steps/sec" << std::endl;
+    if (dase::PhaseProfiler::enabled()) {
+        std::cout << "Step phases:" << std::endl;
+        for (const auto& phase : workspace.profiler.snapshot()) {
+            std::cout << "  " << std::left << std::setw(24) << phase.name << std::right
+                      << std::fixed << std::setprecision(2) << phase.total_ns * 1e-6 << " ms"
+                      << " (" << phase.calls << " calls)" << std::endl;
+        }
+    }
 
     // ========================================================================
     // 4. Export Results
@@ -358,8 +327,15 @@ int main(int argc, char** argv) {
 
     std::cout << "\n=== Export ===" << std::endl;
 
-    std::string filename = "gw_waveform_alpha_" + std::to_string(alpha_value) + ".csv";
-    exportWaveformCSV(filename, time_array, h_plus_array, h_cross_array, amplitude_array);
+    WaveformData written;
+    std::string read_error;
+    if (!waveform_writer.close() || !readWaveformFile(filename, written, &read_error) ||
+        written.h_plus != h_plus_array || written.h_cross != h_cross_array || written.time != time_array) {
+        std::cerr << "Waveform file does not round-trip: " << filename << " " << read_error << std::endl;
+        return 1;
+    }
+    std::cout << "Exported waveform to: " << filename << " (" << written.frames() << " frames, "
+              << waveform_writer.bytesWritten() << " bytes)" << std::endl;
 
     // Export echo schedule if merger was detected
     if (merger_detected) {
@@ -377,6 +353,13 @@ int main(int argc, char** argv) {
         std::cout << "\nWARNING: No merger detected - no echoes generated!" << std::endl;
     }
 
+    std::cout << "\nSOE kernels: " << kernel_store.getFitCount() << " fitted, "
+              << kernel_store.getHitCount() << " shared";
+    if (kernel_store.save(SOEKernelStore::kDefaultPath)) {
+        std::cout << " (saved to " << SOEKernelStore::kDefaultPath << ")";
+    }
+    std::cout << std::endl;
+
     // ========================================================================
     // 5. Summary Statistics
     // ========================================================================
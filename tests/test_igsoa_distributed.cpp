@@ -0,0 +1,243 @@
+/**
+ * IGSOA MPI Domain Decomposition Test
+ *
+ * Runs the slab-decomposed 2D/3D engines on sub-communicators of 1, 2, 3
+ * and 4 ranks (as many as the launch provides) and checks the gathered
+ * state against a serial start-of-step (Jacobi) stencil reference, plus the
+ * distributed energy and entropy reductions.
+ *
+ * Usage: mpirun -np 4 test_igsoa_distributed   (also runs as a single process)
+ */
+
+#include "../src/cpp/igsoa_distributed_engine.h"
+#include <mpi.h>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+int world_rank = 0;
+
+void check(bool condition, const char* name) {
+    if (world_rank != 0) return;
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+IGSOAComplexConfig makeConfig(double R_c) {
+    IGSOAComplexConfig config;
+    config.R_c_default = R_c;
+    config.kappa = 1.0;
+    config.gamma = 0.1;
+    config.dt = 0.01;
+    config.normalize_psi = true;
+    return config;
+}
+
+void seedNode(IGSOALatticeSoA& lattice, size_t local, size_t global) {
+    lattice.psi_re[local] = std::sin(0.37 * global);
+    lattice.psi_im[local] = std::cos(0.11 * global);
+    lattice.phi[local] = 0.1 * std::cos(0.23 * global);
+}
+
+/**
+ * Serial Jacobi reference: all nodes couple to Ψⁿ, then the local stages
+ */
+template <typename Stencil>
+void referenceSteps(IGSOALatticeSoA& lattice, const Stencil& stencil, const int* off_z,
+                    const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z, int steps) {
+    const size_t N = lattice.size();
+    std::vector<double> nl_re(N), nl_im(N);
+    for (int step = 0; step < steps; step++) {
+        for (size_t i = 0; i < N; i++) {
+            const int x = static_cast<int>(i % N_x);
+            const int y = static_cast<int>((i / N_x) % N_y);
+            const int z = static_cast<int>(i / (N_x * N_y));
+            nl_re[i] = 0.0;
+            nl_im[i] = 0.0;
+            for (size_t k = 0; k < stencil.size(); k++) {
+                const int x_j = static_cast<int>((x + stencil.dx()[k] + 8 * N_x) % N_x);
+                const int y_j = static_cast<int>((y + stencil.dy()[k] + 8 * N_y) % N_y);
+                const int dz = off_z ? off_z[k] : 0;
+                const int z_j = static_cast<int>((z + dz + 8 * N_z) % N_z);
+                const size_t j = (static_cast<size_t>(z_j) * N_y + y_j) * N_x + x_j;
+                nl_re[i] += stencil.weight()[k] * (lattice.psi_re[j] - lattice.psi_re[i]);
+                nl_im[i] += stencil.weight()[k] * (lattice.psi_im[j] - lattice.psi_im[i]);
+            }
+        }
+        for (size_t i = 0; i < N; i++) {
+            IGSOAPhysicsSoA::advancePsi(lattice, i, nl_re[i], nl_im[i], config.dt, 1.0);
+        }
+        if (off_z) {
+            IGSOAPhysicsSoA::completeStep3D(lattice, config, N_x, N_y, N_z);
+        } else {
+            IGSOAPhysicsSoA::completeStep2D(lattice, config, N_x, N_y);
+        }
+    }
+}
+
+double maxDifference(const IGSOALatticeSoA& a, const IGSOALatticeSoA& b) {
+    double max_diff = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        max_diff = std::max(max_diff, std::abs(a.psi_re[i] - b.psi_re[i]));
+        max_diff = std::max(max_diff, std::abs(a.psi_im[i] - b.psi_im[i]));
+        max_diff = std::max(max_diff, std::abs(a.phi[i] - b.phi[i]));
+        max_diff = std::max(max_diff, std::abs(a.F[i] - b.F[i]));
+        max_diff = std::max(max_diff, std::abs(a.F_gradient[i] - b.F_gradient[i]));
+    }
+    return max_diff;
+}
+
+// Ranks [0, P) of the world; the others get MPI_COMM_NULL
+MPI_Comm subCommunicator(int P) {
+    MPI_Comm comm;
+    MPI_Comm_split(MPI_COMM_WORLD, world_rank < P ? 0 : MPI_UNDEFINED, world_rank, &comm);
+    return comm;
+}
+
+void test2D(int P) {
+    const size_t N_x = 20, N_y = 13;
+    const int steps = 5;
+    const auto config = makeConfig(2.5);
+
+    MPI_Comm comm = subCommunicator(P);
+    bool ok = true;
+    double max_diff = 0.0, energy_diff = 0.0, entropy_diff = 0.0;
+    if (comm != MPI_COMM_NULL) {
+        IGSOADistributedEngine2D engine(config, comm, N_x, N_y);
+        IGSOALatticeSoA& local = engine.localLattice();
+        for (size_t y = engine.firstRow(); y < engine.firstRow() + engine.localRows(); y++) {
+            for (size_t x = 0; x < N_x; x++) {
+                seedNode(local, engine.localIndex(x, y), y * N_x + x);
+            }
+        }
+        engine.runMission(steps);
+        const double energy = engine.getTotalEnergy();
+        const double entropy = engine.getTotalEntropyRate();
+
+        IGSOALatticeSoA gathered;
+        engine.gatherLattice(gathered);
+        if (engine.rank() == 0) {
+            IGSOALatticeSoA reference(N_x * N_y);
+            std::fill(reference.R_c.begin(), reference.R_c.end(), config.R_c_default);
+            std::fill(reference.kappa.begin(), reference.kappa.end(), config.kappa);
+            std::fill(reference.gamma.begin(), reference.gamma.end(), config.gamma);
+            for (size_t i = 0; i < reference.size(); i++) seedNode(reference, i, i);
+            CouplingStencil2D stencil;
+            stencil.build(config.R_c_default, N_x, N_y);
+            referenceSteps(reference, stencil, nullptr, config, N_x, N_y, 1, steps);
+
+            ok = gathered.size() == reference.size() && engine.getTotalSteps() == steps;
+            max_diff = ok ? maxDifference(gathered, reference) : 1.0;
+            energy_diff = std::abs(energy - IGSOAPhysicsSoA::computeTotalEnergy(reference));
+            entropy_diff = std::abs(entropy - IGSOAPhysicsSoA::computeTotalEntropyRate(reference));
+        }
+        MPI_Comm_free(&comm);
+    }
+
+    if (world_rank == 0) {
+        std::cout << "2D slabs on " << P << " rank(s)" << std::endl;
+    }
+    check(ok, "gathered lattice complete");
+    check(max_diff < 1e-12, "matches serial Jacobi reference");
+    check(energy_diff < 1e-10, "distributed total energy");
+    check(entropy_diff < 1e-10, "distributed total entropy rate");
+}
+
+void test3D(int P) {
+    const size_t N_x = 7, N_y = 6, N_z = 9;
+    const int steps = 3;
+    const auto config = makeConfig(1.8);
+
+    MPI_Comm comm = subCommunicator(P);
+    double max_diff = 0.0, energy_diff = 0.0;
+    if (comm != MPI_COMM_NULL) {
+        IGSOADistributedEngine3D engine(config, comm, N_x, N_y, N_z);
+        IGSOALatticeSoA& local = engine.localLattice();
+        for (size_t z = engine.firstPlane(); z < engine.firstPlane() + engine.localPlanes(); z++) {
+            for (size_t y = 0; y < N_y; y++) {
+                for (size_t x = 0; x < N_x; x++) {
+                    seedNode(local, engine.localIndex(x, y, z), (z * N_y + y) * N_x + x);
+                }
+            }
+        }
+        engine.runMission(steps);
+        const double energy = engine.getTotalEnergy();
+
+        IGSOALatticeSoA gathered;
+        engine.gatherLattice(gathered);
+        if (engine.rank() == 0) {
+            IGSOALatticeSoA reference(N_x * N_y * N_z);
+            std::fill(reference.R_c.begin(), reference.R_c.end(), config.R_c_default);
+            std::fill(reference.kappa.begin(), reference.kappa.end(), config.kappa);
+            std::fill(reference.gamma.begin(), reference.gamma.end(), config.gamma);
+            for (size_t i = 0; i < reference.size(); i++) seedNode(reference, i, i);
+            CouplingStencil3D stencil;
+            stencil.build(config.R_c_default, N_x, N_y, N_z);
+            referenceSteps(reference, stencil, stencil.dz(), config, N_x, N_y, N_z, steps);
+
+            max_diff = gathered.size() == reference.size() ? maxDifference(gathered, reference) : 1.0;
+            energy_diff = std::abs(energy - IGSOAPhysicsSoA::computeTotalEnergy(reference));
+        }
+        MPI_Comm_free(&comm);
+    }
+
+    if (world_rank == 0) {
+        std::cout << "3D slabs on " << P << " rank(s)" << std::endl;
+    }
+    check(max_diff < 1e-12, "matches serial Jacobi reference");
+    check(energy_diff < 1e-10, "distributed total energy");
+}
+
+void testHaloLimit(int world_size) {
+    if (world_rank == 0) {
+        std::cout << "Halo width limit" << std::endl;
+    }
+    // Every rank needs ceil(R_c) = 3 rows: 8 rows fit on 2 ranks, not on 3
+    bool rejected = false;
+    try {
+        IGSOADistributedEngine2D engine(makeConfig(2.5), MPI_COMM_WORLD, 8, 8);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    check(rejected == (world_size > 2), "slabs thinner than the halo are rejected");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int world_size = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+
+    if (world_rank == 0) {
+        std::cout << "=== IGSOA MPI Domain Decomposition Test (" << world_size << " ranks) ===" << std::endl;
+    }
+    for (int P = 1; P <= std::min(world_size, 4); P++) {
+        test2D(P);
+        test3D(P);
+    }
+    testHaloLimit(world_size);
+
+    int status = failures;
+    MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (world_rank == 0) {
+        if (status == 0) {
+            std::cout << "All tests passed" << std::endl;
+        } else {
+            std::cout << status << " test(s) failed" << std::endl;
+        }
+    }
+    MPI_Finalize();
+    return status == 0 ? 0 : 1;
+}
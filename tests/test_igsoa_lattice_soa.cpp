@@ -0,0 +1,1347 @@
+/**
+ * IGSOA SoA Lattice Test
+ *
+ * Checks that the engines (evolving on IGSOALatticeSoA) reproduce the
+ * reference AoS kernels (IGSOAPhysics / IGSOAPhysics2D / IGSOAPhysics3D),
+ * and that the AoS compatibility view stays coherent across edits. The
+ * lattice stores no entropy rate, T_IGS or phase; reading them must give
+ * the node formulas.
+ * Uniform-R_c lattices exercise the precomputed coupling stencil; the
+ * NeighborCache coupling mode is checked against the direct search, and (in
+ * USE_FFTW3 builds) the Spectral mode against a start-of-step reference.
+ * float32 stepping is
+ * checked against the double path to single-precision tolerance, and the
+ * fused diagnostics pass against the serial energy / entropy / center of
+ * mass helpers. The step phase profiler must count one call per step for
+ * every stage that ran. Missions in one parallel region must give the same
+ * state for every thread count and match the per-step helpers. The
+ * separable Gaussian and plane-wave initializers must match the per-node
+ * formulas, and a list of Gaussians must equal the single-profile calls
+ * in order. Adaptive runUntil must land on t_end, keep two half steps per
+ * accepted attempt, beat the fixed-dt error, restore the configured dt and
+ * recover from a rejected first step. Active-region missions must stay
+ * within the skip bound of the full-lattice run, skip most tiles of a
+ * localized start, give the same state for every thread count, widen the
+ * halo when the guard trips and fall back for driven missions. The
+ * compile-time kernels for integer R_c must reproduce the generic stencil
+ * sweep for every radius they cover, in both precisions. The 1D recursive
+ * coupling must match the direct sum to round-off for small, fractional
+ * and ring-sized radii, and fall back to it when it cannot apply. The
+ * two-pass parallel neighbor-list build must not depend on the thread
+ * count and must count rows like a brute-force torus search, and the
+ * counting-sort spatial grid must cover every node in range without
+ * reallocating the query buffer.
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_ensemble_engine_2d.h"
+#include "../src/cpp/igsoa_state_extract.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include "../src/cpp/async_checkpointer.h"
+#include "../src/cpp/spatial_hash.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+double maxStateDifference(const std::vector<IGSOAComplexNode>& a,
+                          const std::vector<IGSOAComplexNode>& b) {
+    double max_diff = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        max_diff = std::max(max_diff, std::abs(a[i].psi - b[i].psi));
+        max_diff = std::max(max_diff, std::abs(a[i].phi - b[i].phi));
+        max_diff = std::max(max_diff, std::abs(a[i].F - b[i].F));
+        max_diff = std::max(max_diff, std::abs(a[i].F_gradient - b[i].F_gradient));
+    }
+    return max_diff;
+}
+
+void seed(std::vector<IGSOAComplexNode>& nodes) {
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i].psi = std::complex<double>(std::sin(0.37 * i), std::cos(0.11 * i));
+        nodes[i].phi = 0.1 * std::cos(0.23 * i);
+        nodes[i].updateInformationalDensity();
+    }
+}
+
+IGSOAComplexConfig makeConfig(uint32_t num_nodes, double R_c) {
+    IGSOAComplexConfig config;
+    config.num_nodes = num_nodes;
+    config.R_c_default = R_c;
+    config.kappa = 1.0;
+    config.gamma = 0.1;
+    config.dt = 0.01;
+    config.normalize_psi = true;
+    return config;
+}
+
+void testRoundTrip() {
+    std::cout << "Lattice round trip" << std::endl;
+    std::vector<IGSOAComplexNode> nodes(17);
+    seed(nodes);
+    nodes[3].R_c = 2.5;
+    nodes[5].harmonic_count = 7;
+
+    IGSOALatticeSoA lattice;
+    lattice.loadFrom(nodes);
+    std::vector<IGSOAComplexNode> restored;
+    lattice.storeTo(restored);
+
+    check(restored.size() == nodes.size(), "size preserved");
+    check(maxStateDifference(nodes, restored) == 0.0, "state preserved");
+    check(restored[3].R_c == 2.5 && restored[5].harmonic_count == 7, "parameters preserved");
+    check(reinterpret_cast<uintptr_t>(lattice.psi_re.data()) % 64 == 0, "arrays 64-byte aligned");
+
+    // Ṡ, T_IGS and phase are derived from the stored planes on read
+    double max_derived_diff = 0.0;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        IGSOAComplexNode node = nodes[i];
+        node.updateEntropyRate();
+        max_derived_diff = std::max(max_derived_diff, std::abs(restored[i].entropy_rate - node.entropy_rate));
+        max_derived_diff = std::max(max_derived_diff, std::abs(lattice.entropyRate(i) - node.entropy_rate));
+        max_derived_diff = std::max(max_derived_diff, std::abs(lattice.phase(i) - std::arg(nodes[i].psi)));
+        max_derived_diff = std::max(max_derived_diff, std::abs(restored[i].T_IGS() - restored[i].F));
+    }
+    check(max_derived_diff < 1e-15, "derived quantities on demand");
+    check(lattice.getMemoryUsage() == nodes.size() * (11 * sizeof(double) + sizeof(uint32_t)),
+          "eleven stored planes");
+}
+
+void test1D() {
+    std::cout << "1D engine matches AoS reference" << std::endl;
+    const auto config = makeConfig(64, 3.0);
+    IGSOAComplexEngine engine(config);
+    seed(engine.getNodesMutable());
+
+    std::vector<IGSOAComplexNode> reference = engine.getNodes();
+    engine.runMission(25);
+    for (int step = 0; step < 25; step++) {
+        IGSOAPhysics::timeStep(reference, config);
+    }
+    check(maxStateDifference(engine.getNodes(), reference) < 1e-9, "trajectory");
+}
+
+void test2D() {
+    std::cout << "2D engine matches AoS reference" << std::endl;
+    const size_t N_x = 24;
+    const size_t N_y = 16;
+    const auto config = makeConfig(N_x * N_y, 3.5);
+    IGSOAComplexEngine2D engine(config, N_x, N_y);
+    seed(engine.getNodesMutable());
+
+    std::vector<IGSOAComplexNode> reference = engine.getNodes();
+    engine.runMission(10);
+    for (int step = 0; step < 10; step++) {
+        IGSOAPhysics2D::timeStep(reference, config, N_x, N_y);
+    }
+    check(maxStateDifference(engine.getNodes(), reference) < 1e-9, "trajectory");
+
+    // Edits through the AoS view must reach the next run
+    engine.setNodePsi(4, 5, 2.0, -1.0);
+    reference[5 * N_x + 4].psi = std::complex<double>(2.0, -1.0);
+    reference[5 * N_x + 4].updateInformationalDensity();
+    engine.runMission(3);
+    for (int step = 0; step < 3; step++) {
+        IGSOAPhysics2D::timeStep(reference, config, N_x, N_y);
+    }
+    check(maxStateDifference(engine.getNodes(), reference) < 1e-9, "edit between runs");
+
+    double energy_ref = IGSOAPhysics2D::computeTotalEnergy(reference);
+    check(std::abs(engine.getTotalEnergy() - energy_ref) < 1e-9, "energy from lattice");
+
+    const auto& lattice = engine.getLattice();
+    check(lattice.psi_re[7] == engine.getNodes()[7].psi.real(), "lattice and view agree");
+}
+
+void testNodeView() {
+    std::cout << "lazy AoS view" << std::endl;
+    const size_t N_x = 24, N_y = 16;
+    const auto config = makeConfig(N_x * N_y, 2.0);
+    IGSOAComplexEngine2D engine(config, N_x, N_y);
+    check(!engine.hasNodeView() && engine.getLattice().R_c[5] == 2.0, "2D engine starts on the lattice");
+
+    double re = 0.0, im = 0.0;
+    engine.setNodePsi(3, 2, 0.5, 0.25);
+    engine.setNodePhi(3, 2, 0.125);
+    engine.getNodePsi(3, 2, re, im);
+    check(!engine.hasNodeView() && re == 0.5 && im == 0.25 && engine.getNodeF(3, 2) == 0.3125 &&
+          engine.getNodePhi(3, 2) == 0.125, "node access leaves the view unbuilt");
+    check(engine.getNodes()[2 * N_x + 3].psi == std::complex<double>(0.5, 0.25) && engine.hasNodeView(),
+          "getNodes() builds the view");
+    engine.runMission(2);
+    check(!engine.hasNodeView(), "mission frees the view");
+    engine.getNodesMutable()[0].psi = std::complex<double>(1.0, 0.0);
+    engine.reset();
+    check(!engine.hasNodeView() && engine.getLattice().psi_re[0] == 0.0 && engine.getLattice().R_c[0] == 2.0,
+          "reset on the lattice");
+
+    IGSOAComplexEngine engine_1d(makeConfig(64, 2.0));
+    IGSOAComplexEngine3D engine_3d(makeConfig(512, 2.0), 8, 8, 8);
+    engine_1d.setNodePsi(5, 1.0, 0.0);
+    engine_1d.runMission(1);
+    engine_3d.runMission(1);
+    check(!engine_1d.hasNodeView() && !engine_3d.hasNodeView() && engine_1d.getAverageInformationalDensity() > 0.0 &&
+          !engine_1d.hasNodeView(), "1D and 3D engines build the view on demand only");
+    check(IGSOAComplexEngine2D::estimateMemoryUsage(N_x, N_y) == IGSOALatticeSoA::estimateMemoryUsage(N_x * N_y) &&
+          IGSOAComplexEngine3D::estimateMemoryUsage(8, 8, 8) == IGSOALatticeSoA::estimateMemoryUsage(512),
+          "memory estimates count the lattice only");
+}
+
+void test3D() {
+    std::cout << "3D engine matches AoS reference" << std::endl;
+    const size_t N = 8;
+    const auto config = makeConfig(N * N * N, 2.0);
+    IGSOAComplexEngine3D engine(config, N, N, N);
+    seed(engine.getNodesMutable());
+
+    std::vector<IGSOAComplexNode> reference = engine.getNodes();
+    engine.runMission(5);
+    for (int step = 0; step < 5; step++) {
+        IGSOAPhysics3D::timeStep(reference, config, N, N, N);
+    }
+    check(maxStateDifference(engine.getNodes(), reference) < 1e-9, "trajectory");
+}
+
+void testStencil() {
+    std::cout << "Stencil coupling matches box search" << std::endl;
+    const size_t N_x = 20;
+    const size_t N_y = 12;
+    auto config = makeConfig(N_x * N_y, 2.5);
+    IGSOAComplexEngine2D engine(config, N_x, N_y);
+    seed(engine.getNodesMutable());
+
+    // R_c change between runs must rebuild the stencil
+    std::vector<IGSOAComplexNode> reference = engine.getNodes();
+    engine.runMission(4);
+    for (auto& node : engine.getNodesMutable()) node.R_c = 5.0;
+    for (int step = 0; step < 4; step++) {
+        IGSOAPhysics2D::timeStep(reference, config, N_x, N_y);
+    }
+    for (auto& node : reference) node.R_c = 5.0;
+    engine.runMission(4);
+    for (int step = 0; step < 4; step++) {
+        IGSOAPhysics2D::timeStep(reference, config, N_x, N_y);
+    }
+    check(maxStateDifference(engine.getNodes(), reference) < 1e-9, "rebuild on R_c change");
+
+    // Heterogeneous R_c falls back to the per-node search
+    engine.getNodesMutable()[17].R_c = 1.5;
+    reference[17].R_c = 1.5;
+    engine.runMission(3);
+    for (int step = 0; step < 3; step++) {
+        IGSOAPhysics2D::timeStep(reference, config, N_x, N_y);
+    }
+    check(maxStateDifference(engine.getNodes(), reference) < 1e-9, "heterogeneous R_c");
+
+    // Radius wider than half the torus (wrapped offsets alias)
+    const size_t N = 6;
+    auto config_3d = makeConfig(N * N * N, 3.5);
+    IGSOAComplexEngine3D engine_3d(config_3d, N, N, N);
+    seed(engine_3d.getNodesMutable());
+    std::vector<IGSOAComplexNode> reference_3d = engine_3d.getNodes();
+    engine_3d.runMission(3);
+    for (int step = 0; step < 3; step++) {
+        IGSOAPhysics3D::timeStep(reference_3d, config_3d, N, N, N);
+    }
+    check(maxStateDifference(engine_3d.getNodes(), reference_3d) < 1e-9, "3D small torus");
+}
+
+void testNeighborCache() {
+    std::cout << "Neighbor-cache coupling mode" << std::endl;
+    const size_t N_x = 16;
+    const size_t N_y = 16;
+    auto config = makeConfig(N_x * N_y, 3.0);
+    IGSOAComplexEngine2D direct(config, N_x, N_y);
+    config.coupling_mode = IGSOACouplingMode::NeighborCache;
+    IGSOAComplexEngine2D cached(config, N_x, N_y);
+    seed(direct.getNodesMutable());
+    seed(cached.getNodesMutable());
+
+    // Heterogeneous R_c: ring of wider nodes
+    for (size_t i = 0; i < N_x * N_y; i += 7) {
+        direct.getNodesMutable()[i].R_c = 4.5;
+        cached.getNodesMutable()[i].R_c = 4.5;
+    }
+
+    direct.runMission(5);
+    cached.runMission(5);
+    const auto* cache = cached.getNeighborCache();
+    check(cache != nullptr && cache->isBuilt(), "cache built on first run");
+    check(cache->getNumKernelCaches() == 2, "one kernel cache per distinct R_c");
+    check(maxStateDifference(direct.getNodes(), cached.getNodes()) < 1e-3, "tracks direct coupling");
+    check(cached.getCouplingCacheMemoryUsage() > 0, "memory usage reported");
+
+    // Wrap-around neighbors are included (torus)
+    check(cache->getNeighborCount(1) == cache->getNeighborCount(5 * N_x + 6), "edge node sees wrapped neighbors");
+
+    // Mutating R_c invalidates the lists
+    const size_t before = cache->getNeighborCount(1);
+    cached.getNodesMutable()[1].R_c = 1.0;
+    cached.runMission(1);
+    check(cached.getNeighborCache()->getNeighborCount(1) < before, "rebuilt after R_c change");
+
+    cached.setCouplingMode(IGSOACouplingMode::Direct);
+    check(cached.getNeighborCache() == nullptr, "cache released in Direct mode");
+}
+
+#ifdef USE_FFTW3
+/**
+ * Stencil coupling evaluated from a frozen copy of psi (all nodes see Ψⁿ)
+ */
+template<typename Stencil>
+void stencilCoupling(const IGSOALatticeSoA& lattice, const Stencil& stencil, const int* off_z,
+                     size_t N_x, size_t N_y, size_t N_z,
+                     std::vector<double>& nl_re, std::vector<double>& nl_im) {
+    const size_t N = lattice.size();
+    nl_re.assign(N, 0.0);
+    nl_im.assign(N, 0.0);
+    for (size_t i = 0; i < N; i++) {
+        const int x = static_cast<int>(i % N_x);
+        const int y = static_cast<int>((i / N_x) % N_y);
+        const int z = static_cast<int>(i / (N_x * N_y));
+        for (size_t k = 0; k < stencil.size(); k++) {
+            const int x_j = static_cast<int>((x + stencil.dx()[k] + 8 * N_x) % N_x);
+            const int y_j = static_cast<int>((y + stencil.dy()[k] + 8 * N_y) % N_y);
+            const int dz = off_z ? off_z[k] : 0;
+            const int z_j = static_cast<int>((z + dz + 8 * N_z) % N_z);
+            const size_t j = (static_cast<size_t>(z_j) * N_y + y_j) * N_x + x_j;
+            nl_re[i] += stencil.weight()[k] * (lattice.psi_re[j] - lattice.psi_re[i]);
+            nl_im[i] += stencil.weight()[k] * (lattice.psi_im[j] - lattice.psi_im[i]);
+        }
+    }
+}
+
+/**
+ * Jacobi-ordered reference steps (coupling from Ψ at the start of each step)
+ */
+template<typename Stencil>
+void jacobiSteps(IGSOALatticeSoA& lattice, const Stencil& stencil, const int* off_z,
+                 const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z, int steps) {
+    std::vector<double> nl_re, nl_im;
+    for (int step = 0; step < steps; step++) {
+        stencilCoupling(lattice, stencil, off_z, N_x, N_y, N_z, nl_re, nl_im);
+        for (size_t i = 0; i < lattice.size(); i++) {
+            IGSOAPhysicsSoA::advancePsi(lattice, i, nl_re[i], nl_im[i], config.dt, 1.0);
+        }
+        if (N_z > 1) {
+            IGSOAPhysicsSoA::completeStep3D(lattice, config, N_x, N_y, N_z);
+        } else {
+            IGSOAPhysicsSoA::completeStep2D(lattice, config, N_x, N_y);
+        }
+    }
+}
+#endif
+
+#ifdef USE_FFTW3
+void testSpectral() {
+    std::cout << "Spectral coupling mode" << std::endl;
+
+    // Convolution reproduces the stencil sum, including aliased offsets
+    const size_t N = 6;
+    std::vector<IGSOAComplexNode> nodes(N * N * N);
+    seed(nodes);
+    IGSOALatticeSoA lattice;
+    lattice.loadFrom(nodes);
+    CouplingStencil3D stencil;
+    stencil.build(3.5, N, N, N);
+    SpectralCoupling spectral;
+    spectral.build(stencil, N, N, N);
+    spectral.convolve(lattice.psi_re.data(), lattice.psi_im.data());
+
+    std::vector<double> nl_re, nl_im;
+    stencilCoupling(lattice, stencil, stencil.dz(), N, N, N, nl_re, nl_im);
+    double max_diff = 0.0;
+    for (size_t i = 0; i < lattice.size(); i++) {
+        max_diff = std::max(max_diff, std::abs(spectral.couplingRe(i) - nl_re[i]));
+        max_diff = std::max(max_diff, std::abs(spectral.couplingIm(i) - nl_im[i]));
+    }
+    check(max_diff < 1e-10, "FFT convolution matches stencil sum");
+
+    // Large R_c switches the engine to the FFT path
+    const size_t N_x = 32;
+    const size_t N_y = 24;
+    auto config = makeConfig(N_x * N_y, 8.0);
+    config.coupling_mode = IGSOACouplingMode::Spectral;
+    IGSOAComplexEngine2D engine(config, N_x, N_y);
+    seed(engine.getNodesMutable());
+
+    IGSOALatticeSoA reference;
+    reference.loadFrom(engine.getNodes());
+    CouplingStencil2D stencil_2d;
+    stencil_2d.build(8.0, N_x, N_y);
+    engine.runMission(4);
+    for (int step = 0; step < 4; step++) {
+        stencilCoupling(reference, stencil_2d, nullptr, N_x, N_y, 1, nl_re, nl_im);
+        for (size_t i = 0; i < reference.size(); i++) {
+            IGSOAPhysicsSoA::advancePsi(reference, i, nl_re[i], nl_im[i], config.dt, 1.0);
+        }
+        IGSOAPhysicsSoA::completeStep2D(reference, config, N_x, N_y);
+    }
+    check(engine.isSpectralCouplingActive(), "FFT path selected for large R_c");
+    std::vector<IGSOAComplexNode> expected;
+    reference.storeTo(expected);
+    check(maxStateDifference(engine.getNodes(), expected) < 1e-9, "trajectory");
+
+    // Small R_c stays on the stencil
+    for (auto& node : engine.getNodesMutable()) node.R_c = 1.5;
+    engine.runMission(1);
+    check(!engine.isSpectralCouplingActive(), "stencil kept for small R_c");
+}
+#endif
+
+void testRegionExtract() {
+    std::cout << "Region extraction:" << std::endl;
+
+    const size_t N_x = 5, N_y = 4, N_z = 3;
+    IGSOALatticeSoA lattice(N_x * N_y * N_z);
+    for (size_t i = 0; i < lattice.size(); i++) {
+        lattice.psi_re[i] = static_cast<double>(i);
+        lattice.psi_im[i] = -static_cast<double>(i);
+        lattice.F[i] = 0.5 * static_cast<double>(i);
+        lattice.phi[i] = 1000.0 + static_cast<double>(i);
+    }
+
+    // x in {1, 3}, y in {0, 2}, z in {1}: 4 samples, x fastest
+    StateRegion region;
+    region.x0 = 1; region.nx = 4;
+    region.y0 = 0; region.ny = 3;
+    region.z0 = 1; region.nz = 2;
+    region.stride = 2;
+    check(region.outCount() == 4, "strided region sample count");
+
+    std::vector<double> re(4), im(4), phi(4);
+    bool ok = extractRegion(lattice, N_x, N_y, N_z, region,
+                            STATE_FIELD_PSI | STATE_FIELD_PHI,
+                            re.data(), im.data(), static_cast<double*>(nullptr), phi.data());
+    check(ok, "psi+phi extraction with null F output");
+
+    bool match = true;
+    size_t o = 0;
+    for (size_t y = 0; y < 3; y += 2) {
+        for (size_t x = 1; x < 5; x += 2, o++) {
+            const double i = static_cast<double>((1 * N_y + y) * N_x + x);
+            match = match && re[o] == i && im[o] == -i && phi[o] == 1000.0 + i;
+        }
+    }
+    check(match, "strided samples match lattice (row-major, x fastest)");
+
+    std::vector<float> F(4);
+    ok = extractRegion(lattice, N_x, N_y, N_z, region, STATE_FIELD_F,
+                       static_cast<float*>(nullptr), static_cast<float*>(nullptr),
+                       F.data(), static_cast<float*>(nullptr));
+    check(ok && F[3] == static_cast<float>(0.5 * ((1 * N_y + 2) * N_x + 3)), "float32 F-only extraction");
+
+    std::vector<double> F_double(4);
+    region.nx = 5;
+    check(!extractRegion(lattice, N_x, N_y, N_z, region, STATE_FIELD_ALL,
+                         re.data(), im.data(), F_double.data(), phi.data()),
+          "region past the lattice edge rejected");
+}
+
+void testBulkAccess() {
+    std::cout << "Bulk range access:" << std::endl;
+    const size_t N_x = 12, N_y = 10;
+    const auto config = makeConfig(N_x * N_y, 2.5);
+    IGSOAComplexEngine2D bulk(config, N_x, N_y);
+    IGSOAComplexEngine2D per_node(config, N_x, N_y);
+
+    // Interleaved complex buffer over rows 2..4, written in one call
+    const size_t first = 2 * N_x, count = 3 * N_x;
+    std::vector<double> psi(2 * count), phi(count);
+    for (size_t k = 0; k < count; k++) {
+        psi[2 * k] = 0.1 * static_cast<double>(k);
+        psi[2 * k + 1] = -0.05 * static_cast<double>(k);
+        phi[k] = 0.3 + 0.01 * static_cast<double>(k);
+    }
+    check(bulk.setPsiRange(first, count, psi.data(), psi.data() + 1, 2), "interleaved psi write");
+    check(bulk.setPhiRange(first, count, phi.data()), "phi write");
+    for (size_t k = 0; k < count; k++) {
+        const size_t i = first + k;
+        per_node.setNodePsi(i % N_x, i / N_x, psi[2 * k], psi[2 * k + 1]);
+        per_node.setNodePhi(i % N_x, i / N_x, phi[k]);
+    }
+    check(maxStateDifference(bulk.getNodes(), per_node.getNodes()) < 1e-12, "matches per-node setters");
+
+    bulk.runMission(4);
+    per_node.runMission(4);
+    check(maxStateDifference(bulk.getNodes(), per_node.getNodes()) < 1e-9, "bulk write reaches the next run");
+
+    std::vector<double> re(count), im(count), F(count), phi_out(count);
+    check(bulk.getPsiRange(first, count, re.data(), im.data()) &&
+          bulk.getFRange(first, count, F.data()) &&
+          bulk.getPhiRange(first, count, phi_out.data()), "range reads");
+    const auto& nodes = bulk.getNodes();
+    check(re[5] == nodes[first + 5].psi.real() && im[5] == nodes[first + 5].psi.imag() &&
+          F[5] == nodes[first + 5].F && phi_out[5] == nodes[first + 5].phi, "reads match node view");
+
+    check(!bulk.setPhiRange(N_x * N_y - 1, 2, phi.data()), "range past the end rejected");
+    check(!bulk.getPsiRange(0, 1, re.data(), im.data(), 0), "zero stride rejected");
+}
+
+void testCheckpoint() {
+    std::cout << "Checkpoint/restart:" << std::endl;
+    const size_t N_x = 12, N_y = 10;
+    const auto config = makeConfig(N_x * N_y, 2.5);
+    const std::string path = "test_igsoa_checkpoint.bin";
+    IGSOAComplexEngine2D original(config, N_x, N_y);
+    seed(original.getNodesMutable());
+    original.runMission(5);
+
+    std::string error;
+    check(dase::saveCheckpointFile(original, path, &error), "write checkpoint");
+
+    IGSOAComplexEngine2D restored(config, N_x, N_y);
+    check(dase::loadCheckpointFile(restored, path, &error), "map and restore");
+    check(maxStateDifference(restored.getNodes(), original.getNodes()) == 0.0, "state restored exactly");
+    check(restored.getTotalSteps() == 5 && restored.getCurrentTime() == original.getCurrentTime(), "counters restored");
+
+    original.runMission(5);
+    restored.runMission(5);
+    check(maxStateDifference(restored.getNodes(), original.getNodes()) == 0.0, "restart continues the trajectory");
+
+    // Async write: snapshot taken at the call, the engine may evolve meanwhile
+    dase::CheckpointWriter writer;
+    original.saveCheckpoint(writer);
+    const std::vector<IGSOAComplexNode> at_snapshot = original.getNodes();
+    auto pending = std::move(writer).writeAsync(path);
+    original.runMission(3);
+    check(pending.get(), "async write");
+    check(dase::loadCheckpointFile(restored, path) &&
+          maxStateDifference(restored.getNodes(), at_snapshot) == 0.0, "async checkpoint holds the snapshot");
+
+    IGSOAComplexEngine2D wrong_shape(makeConfig(N_x * N_y, 2.5), N_y, N_x);
+    check(!dase::loadCheckpointFile(wrong_shape, path, &error), "dimension mismatch rejected");
+    IGSOAComplexEngine3D wrong_type(makeConfig(N_x * N_y, 2.5), N_x, N_y, 1);
+    check(!dase::loadCheckpointFile(wrong_type, path, &error), "engine type mismatch rejected");
+
+    std::remove(path.c_str());
+
+    // Double-buffered background checkpoints: keep the newest two
+    dase::CheckpointPolicy policy;
+    policy.prefix = "test_igsoa_async";
+    policy.keep_last = 2;
+    policy.max_write_mb_per_s = 1.0;  // ~15 KB each: throttled, still fast
+    std::vector<IGSOAComplexNode> last_captured;
+    {
+        dase::AsyncCheckpointer checkpointer(policy);
+        for (uint64_t step = 1; step <= 3; step++) {
+            original.runMission(2);
+            checkpointer.capture(original, step);
+            last_captured = original.getNodes();
+        }
+        original.runMission(2);  // Evolves while the last write may still be in flight
+        checkpointer.flush();
+
+        const auto totals = checkpointer.totals();
+        const auto records = checkpointer.recent();
+        check(totals.written == 3 && totals.failed == 0 && checkpointer.pending() == 0, "async checkpoints written");
+        check(records.size() == 3 && records.back().bytes > 0 && records.back().write_mb_per_s > 0.0 &&
+              records.back().stall_ms >= 0.0, "per-checkpoint throughput and stall recorded");
+        check(checkpointer.files().size() == 2 && checkpointer.files().back() == records.back().path,
+              "retention keeps the newest checkpoints");
+        std::FILE* oldest = std::fopen(records.front().path.c_str(), "rb");
+        check(oldest == nullptr, "older checkpoint removed");
+        if (oldest) std::fclose(oldest);
+        check(dase::loadCheckpointFile(restored, records.back().path) &&
+              maxStateDifference(restored.getNodes(), last_captured) == 0.0, "staged copy matches capture time");
+        for (const auto& file : checkpointer.files()) {
+            std::remove(file.c_str());
+        }
+    }
+}
+
+void testEnsemble() {
+    std::cout << "Ensemble engine matches per-replica 2D engines" << std::endl;
+    const size_t N_x = 16;
+    const size_t N_y = 12;
+    const size_t B = 11;  // one full vector block plus a partial one
+    auto config = makeConfig(N_x * N_y, 2.5);
+    config.coupling_mode = IGSOACouplingMode::Direct;
+    IGSOAEnsembleEngine2D ensemble(config, N_x, N_y, B);
+
+    std::vector<IGSOAComplexEngine2D> singles;
+    singles.reserve(B);
+    for (size_t b = 0; b < B; b++) {
+        auto replica_config = config;
+        replica_config.kappa = 0.5 + 0.1 * b;
+        replica_config.gamma = 0.05 + 0.02 * b;
+        singles.emplace_back(replica_config, N_x, N_y);
+        auto& nodes = singles.back().getNodesMutable();
+        seed(nodes);
+        for (auto& node : nodes) {
+            node.psi *= 1.0 + 0.05 * b;
+            node.updateInformationalDensity();
+        }
+        ensemble.setReplicaParams(b, replica_config.kappa, replica_config.gamma);
+        ensemble.loadReplica(b, singles.back().getLattice());
+    }
+    check(!ensemble.setReplicaParams(B, 1.0, 0.1), "replica index bounds");
+
+    const double signals[3] = {0.01, -0.02, 0.005};
+    const double controls[3] = {0.0, 0.01, -0.01};
+    ensemble.runMission(3, signals, controls);
+    ensemble.runMission(4);
+    for (auto& single : singles) {
+        single.runMission(3, signals, controls);
+        single.runMission(4);
+    }
+
+    double max_diff = 0.0;
+    double max_energy_diff = 0.0;
+    IGSOALatticeSoA replica;
+    for (size_t b = 0; b < B; b++) {
+        ensemble.storeReplica(b, replica);
+        const auto& lattice = singles[b].getLattice();
+        for (size_t i = 0; i < lattice.size(); i++) {
+            max_diff = std::max(max_diff, std::abs(replica.psi_re[i] - lattice.psi_re[i]));
+            max_diff = std::max(max_diff, std::abs(replica.psi_im[i] - lattice.psi_im[i]));
+            max_diff = std::max(max_diff, std::abs(replica.phi[i] - lattice.phi[i]));
+            max_diff = std::max(max_diff, std::abs(replica.F[i] - lattice.F[i]));
+            max_diff = std::max(max_diff, std::abs(replica.F_gradient[i] - lattice.F_gradient[i]));
+            max_diff = std::max(max_diff, std::abs(replica.entropyRate(i) - lattice.entropyRate(i)));
+        }
+        max_energy_diff = std::max(max_energy_diff,
+                                   std::abs(ensemble.getReplicaEnergy(b) - singles[b].getTotalEnergy()));
+    }
+    check(max_diff < 1e-12, "replica trajectories");
+    check(max_energy_diff < 1e-9, "replica energy");
+    check(ensemble.getTotalSteps() == 7 && singles[0].getTotalSteps() == 7, "step counters");
+
+    double re = 0.0;
+    double im = 0.0;
+    check(ensemble.getPsiRange(B - 1, 5, 1, &re, &im) &&
+          re == singles[B - 1].getLattice().psi_re[5] && !ensemble.getPsiRange(B, 0, 1, &re, &im),
+          "replica range access");
+}
+
+void testFloatPrecision() {
+    std::cout << "float32 stepping" << std::endl;
+
+    // Lattice precision conversion keeps float-representable values exactly
+    IGSOALatticeSoA lattice(6);
+    for (size_t i = 0; i < lattice.size(); i++) {
+        lattice.psi_re[i] = 0.25 * i;
+        lattice.psi_im[i] = -0.5 * i;
+        lattice.phi[i] = 0.125 * i;
+    }
+    IGSOALatticeSoAF32 lattice_f32;
+    lattice_f32.assignFrom(lattice);
+    IGSOALatticeSoA back;
+    back.assignFrom(lattice_f32);
+    bool exact = back.size() == lattice.size();
+    for (size_t i = 0; exact && i < lattice.size(); i++) {
+        exact = back.psi_re[i] == lattice.psi_re[i] && back.psi_im[i] == lattice.psi_im[i] &&
+                back.phi[i] == lattice.phi[i] && back.F[i] == lattice.F[i];
+    }
+    check(exact, "lattice float round trip");
+
+    const size_t N_x = 24;
+    const size_t N_y = 16;
+    auto config = makeConfig(N_x * N_y, 2.5);
+    IGSOAComplexEngine2D reference(config, N_x, N_y);
+    config.precision = IGSOAPrecision::Float;
+    IGSOAComplexEngine2D engine(config, N_x, N_y);
+    IGSOAComplexEngine2D chunked(config, N_x, N_y);
+    seed(reference.getNodesMutable());
+    seed(engine.getNodesMutable());
+    seed(chunked.getNodesMutable());
+
+    const double signals[4] = {0.01, -0.02, 0.005, 0.0};
+    const double controls[4] = {0.0, 0.01, -0.01, 0.02};
+    reference.runMission(4, signals, controls);
+    engine.runMission(4, signals, controls);
+    chunked.runMission(2, signals, controls);
+    chunked.runMission(2, signals + 2, controls + 2);
+    check(engine.isFloatPrecisionActive(), "float path selected");
+    check(maxStateDifference(engine.getNodes(), reference.getNodes()) < 1e-4, "2D trajectory (float tolerance)");
+    check(std::abs(engine.getTotalEnergy() - reference.getTotalEnergy()) <
+          1e-4 * std::abs(reference.getTotalEnergy()), "2D energy (float tolerance)");
+    check(maxStateDifference(engine.getNodes(), chunked.getNodes()) < 1e-6, "mission chunking");
+    check(engine.getTotalSteps() == 4 && engine.getCurrentTime() == reference.getCurrentTime(), "step counters");
+
+    const size_t M_x = 8, M_y = 6, M_z = 5;
+    auto config_3d = makeConfig(M_x * M_y * M_z, 1.8);
+    IGSOAComplexEngine3D reference_3d(config_3d, M_x, M_y, M_z);
+    config_3d.precision = IGSOAPrecision::Float;
+    IGSOAComplexEngine3D engine_3d(config_3d, M_x, M_y, M_z);
+    seed(reference_3d.getNodesMutable());
+    seed(engine_3d.getNodesMutable());
+    reference_3d.runMission(3);
+    engine_3d.runMission(3);
+    check(engine_3d.isFloatPrecisionActive(), "3D float path selected");
+    check(maxStateDifference(engine_3d.getNodes(), reference_3d.getNodes()) < 1e-4, "3D trajectory (float tolerance)");
+
+    // Paths without a float kernel keep stepping in double
+    config.coupling_mode = IGSOACouplingMode::NeighborCache;
+    IGSOAComplexEngine2D cached(config, N_x, N_y);
+    seed(cached.getNodesMutable());
+    cached.runMission(1);
+    check(!cached.isFloatPrecisionActive(), "NeighborCache stays double");
+    engine.setPrecision(IGSOAPrecision::Double);
+    engine.runMission(1);
+    check(!engine.isFloatPrecisionActive(), "switch back to double");
+}
+
+} // namespace
+
+void testDiagnostics() {
+    std::cout << "fused diagnostics" << std::endl;
+
+    auto near = [](double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); };
+
+    const size_t N_x = 24;
+    const size_t N_y = 16;
+    IGSOAComplexEngine2D engine(makeConfig(N_x * N_y, 2.5), N_x, N_y);
+    IGSOAStateInit2D::initCircularGaussian(engine, 1.0, 5.0, 12.0, 3.0);
+    engine.runMission(3);
+
+    const IGSOADiagnostics all = engine.computeDiagnostics();
+    double x_cm = 0.0, y_cm = 0.0;
+    IGSOAStateInit2D::computeCenterOfMass(engine, x_cm, y_cm);
+    check(all.mask == DIAG_ALL, "all observables selected");
+    check(near(all.total_energy, engine.getTotalEnergy()), "2D energy");
+    check(near(all.total_entropy_rate, engine.getTotalEntropyRate()), "2D entropy rate");
+    check(near(all.x_cm, x_cm) && near(all.y_cm, y_cm) && all.z_cm == 0.0, "2D center of mass");
+
+    const IGSOADiagnostics energy_only = engine.computeDiagnostics(DIAG_ENERGY);
+    check(near(energy_only.total_energy, all.total_energy), "subset matches full pass");
+    check(energy_only.total_entropy_rate == 0.0 && energy_only.x_cm == 0.0, "unselected fields left zero");
+
+    // Folded into the last timestep of runMission
+    engine.setMissionDiagnostics(DIAG_ENERGY | DIAG_CENTER_OF_MASS);
+    engine.runMission(2);
+    const IGSOADiagnostics folded = engine.getMissionDiagnostics();
+    const IGSOADiagnostics after = engine.computeDiagnostics(DIAG_ENERGY | DIAG_CENTER_OF_MASS);
+    check(folded.mask == (DIAG_ENERGY | DIAG_CENTER_OF_MASS) && folded.total_energy == after.total_energy &&
+          folded.x_cm == after.x_cm && folded.y_cm == after.y_cm, "mission diagnostics");
+    engine.setMissionDiagnostics(0);
+    engine.runMission(1);
+    check(engine.getMissionDiagnostics().mask == 0, "mission diagnostics disabled");
+
+    const size_t M_x = 8, M_y = 6, M_z = 5;
+    IGSOAComplexEngine3D engine_3d(makeConfig(M_x * M_y * M_z, 1.8), M_x, M_y, M_z);
+    IGSOAStateInit3D::initSphericalGaussian(engine_3d, 1.0, 1.0, 4.0, 3.5, 1.5);
+    engine_3d.runMission(2);
+    const IGSOADiagnostics all_3d = engine_3d.computeDiagnostics();
+    double z_cm = 0.0;
+    IGSOAStateInit3D::computeCenterOfMass(engine_3d, x_cm, y_cm, z_cm);
+    check(near(all_3d.total_energy, IGSOAPhysicsSoA::computeTotalEnergy(engine_3d.getLattice())), "3D energy");
+    check(near(all_3d.total_entropy_rate, IGSOAPhysicsSoA::computeTotalEntropyRate(engine_3d.getLattice())),
+          "3D entropy rate");
+    check(near(all_3d.x_cm, x_cm) && near(all_3d.y_cm, y_cm) && near(all_3d.z_cm, z_cm), "3D center of mass");
+}
+
+void testPhaseProfiling() {
+    std::cout << "step phase profiling" << std::endl;
+
+    // Calls of each phase, in IGSOAStepPhase order
+    auto calls = [](const std::vector<dase::PhaseTiming>& phases) {
+        std::vector<uint64_t> out;
+        for (const auto& phase : phases) out.push_back(phase.calls);
+        return out;
+    };
+    const uint64_t per_step = dase::PhaseProfiler::enabled() ? 1 : 0;
+
+    IGSOAComplexEngine engine_1d(makeConfig(64, 3.0));
+    engine_1d.runMission(3);
+    const auto phases_1d = engine_1d.getPhaseTimings();
+    check(phases_1d.size() == 9 && std::string(phases_1d[IGSOA_PHASE_QUANTUM].name) == "quantum_evolve",
+          "1D phase names");
+    const auto c1 = calls(phases_1d);
+    // runSteps fuses derived quantities and normalization into the causal pass
+    check(c1[IGSOA_PHASE_QUANTUM] == 3 * per_step && c1[IGSOA_PHASE_CAUSAL] == 3 * per_step &&
+          c1[IGSOA_PHASE_GRADIENTS] == 3 * per_step && c1[IGSOA_PHASE_NORMALIZE] == 0 &&
+          c1[IGSOA_PHASE_DRIVING] == 0, "1D calls per step");
+
+    const size_t N_x = 12, N_y = 10;
+    IGSOAComplexEngine2D engine_2d(makeConfig(N_x * N_y, 2.5), N_x, N_y);
+    IGSOAStateInit2D::initCircularGaussian(engine_2d, 1.0, 5.0, 6.0, 2.0);
+    engine_2d.runMission(4);
+    const auto c2 = calls(engine_2d.getPhaseTimings());
+    check(c2[IGSOA_PHASE_QUANTUM] == 4 * per_step && c2[IGSOA_PHASE_CAUSAL] == 4 * per_step &&
+          c2[IGSOA_PHASE_DERIVED] == 0 && c2[IGSOA_PHASE_GRADIENTS] == 4 * per_step &&
+          c2[IGSOA_PHASE_NORMALIZE] == 0, "2D calls per step");
+    check(c2[IGSOA_PHASE_TRANSFER] >= per_step, "2D transfer timed");
+
+    engine_2d.resetPhaseTimings();
+    bool cleared = true;
+    for (const auto& phase : engine_2d.getPhaseTimings()) cleared = cleared && phase.calls == 0 && phase.total_ns == 0;
+    check(cleared, "resetPhaseTimings clears counters");
+
+    IGSOAComplexEngine3D engine_3d(makeConfig(6 * 5 * 4, 1.8), 6, 5, 4);
+    engine_3d.runMission(2);
+    const auto c3 = calls(engine_3d.getPhaseTimings());
+    check(c3[IGSOA_PHASE_QUANTUM] == 2 * per_step && c3[IGSOA_PHASE_GRADIENTS] == 2 * per_step,
+          "3D calls per step");
+}
+
+void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+void testMissionRegion() {
+    std::cout << "single parallel region missions" << std::endl;
+
+    // Above IGSOAPhysicsSoA::kParallelThreshold, uniform R_c (stencil path)
+    const size_t N_x = 160, N_y = 128;
+    auto config = makeConfig(N_x * N_y, 1.5);
+    std::vector<double> signals(6, 0.01), controls(6, -0.02);
+
+    IGSOAComplexEngine2D serial(config, N_x, N_y);
+    IGSOAComplexEngine2D threaded(config, N_x, N_y);
+    seed(serial.getNodesMutable());
+    seed(threaded.getNodesMutable());
+    setThreads(1);
+    serial.runMission(6, signals.data(), controls.data());
+    setThreads(4);
+    threaded.runMission(6, signals.data(), controls.data());
+    check(maxStateDifference(serial.getNodes(), threaded.getNodes()) == 0.0, "2D state independent of thread count");
+    check(serial.getTotalSteps() == 6 && serial.getCurrentTime() == threaded.getCurrentTime(), "2D clock advanced");
+
+    // Per-step helpers on a copy of the start state, row bands color by color
+    IGSOAComplexEngine2D start(config, N_x, N_y);
+    seed(start.getNodesMutable());
+    IGSOALatticeSoA reference, raster;
+    reference.loadFrom(start.getNodes());
+    raster.loadFrom(start.getNodes());
+    CouplingStencil2D stencil;
+    stencil.build(1.5, N_x, N_y);
+    const IGSOACouplingBands bands = IGSOACouplingBands::make(N_y, stencil.reach());
+    for (int step = 0; step < 6; step++) {
+        IGSOAPhysicsSoA::applyDriving(reference, 0.01, -0.02);
+        for (size_t color = 0; color < bands.colors; color++) {
+            for (size_t band = 0; band < bands.count; band++) {
+                if (bands.color(band) != color) continue;
+                IGSOAPhysicsSoA::evolveQuantumStateRows2D(reference, stencil, config.dt, N_x, N_y,
+                                                          bands.begin(band), bands.end(band));
+            }
+        }
+        IGSOAPhysicsSoA::completeStep2D(reference, config, N_x, N_y);
+
+        IGSOAPhysicsSoA::applyDriving(raster, 0.01, -0.02);
+        IGSOAPhysicsSoA::evolveQuantumState2D(raster, stencil, config.dt, N_x, N_y);
+        IGSOAPhysicsSoA::completeStep2D(raster, config, N_x, N_y);
+    }
+    std::vector<IGSOAComplexNode> reference_nodes, raster_nodes;
+    reference.storeTo(reference_nodes);
+    raster.storeTo(raster_nodes);
+    check(maxStateDifference(threaded.getNodes(), reference_nodes) == 0.0, "2D matches per-step helpers by bands");
+    // The sweep order moves Ψ by about (dt·ΣK)² ≈ 6e-4 per step (ΣK ≈ 2.4)
+    const double sweep_order = maxStateDifference(threaded.getNodes(), raster_nodes);
+    check(sweep_order > 0.0 && sweep_order < 2e-2, "2D banded sweep within O(dt^2) of the raster sweep");
+
+    check(bands.count == 64 && bands.colors == 2 && bands.begin(63) == 126 && bands.end(63) == 128,
+          "even band count takes two colors");
+    const IGSOACouplingBands odd = IGSOACouplingBands::make(10, 3);
+    check(odd.count == 3 && odd.colors == 3 && odd.color(0) == 0 && odd.color(1) == 1 && odd.color(2) == 2 &&
+          odd.end(2) == 10, "odd band count gives the last band a third color");
+    check(IGSOACouplingBands::make(5, 3).count == 1 &&
+          IGSOAPhysicsSoA::effectiveBands(bands, IGSOAPhysicsSoA::kParallelThreshold - 1).count == 1,
+          "short or small lattices sweep in one band");
+
+    const size_t M = 28;  // 28^3 nodes
+    auto config_3d = makeConfig(M * M * M, 1.0);
+    config_3d.normalize_psi = false;
+    IGSOAComplexEngine3D serial_3d(config_3d, M, M, M);
+    IGSOAComplexEngine3D threaded_3d(config_3d, M, M, M);
+    seed(serial_3d.getNodesMutable());
+    seed(threaded_3d.getNodesMutable());
+    setThreads(1);
+    serial_3d.runMission(3);
+    setThreads(3);
+    threaded_3d.runMission(3);
+    check(maxStateDifference(serial_3d.getNodes(), threaded_3d.getNodes()) == 0.0,
+          "3D state independent of thread count");
+
+    IGSOAComplexEngine serial_1d(makeConfig(20000, 2.0));
+    IGSOAComplexEngine threaded_1d(makeConfig(20000, 2.0));
+    seed(serial_1d.getNodesMutable());
+    seed(threaded_1d.getNodesMutable());
+    setThreads(1);
+    serial_1d.runMission(4);
+    setThreads(4);
+    threaded_1d.runMission(4);
+    check(maxStateDifference(serial_1d.getNodes(), threaded_1d.getNodes()) == 0.0,
+          "1D state independent of thread count");
+    setThreads(1);
+}
+
+void testStateInit() {
+    std::cout << "separable state initializers" << std::endl;
+
+    const size_t N_x = 160, N_y = 128;  // Above ProfileTables::kParallelThreshold
+    IGSOAComplexEngine2D engine(makeConfig(N_x * N_y, 2.5), N_x, N_y);
+    Gaussian2DParams g{0.9, 40.5, 70.0, 12.0, 5.0, 0.3, "overwrite", 1.0};
+    IGSOAStateInit2D::initGaussian2D(engine, g);
+    double max_diff = 0.0;
+    for (size_t y = 0; y < N_y; y++) {
+        for (size_t x = 0; x < N_x; x++) {
+            const double dx = static_cast<double>(x) - g.center_x;
+            const double dy = static_cast<double>(y) - g.center_y;
+            const double expected = g.amplitude * std::exp(-(dx * dx) / (2.0 * g.sigma_x * g.sigma_x)
+                                                           - (dy * dy) / (2.0 * g.sigma_y * g.sigma_y));
+            const auto& node = engine.getNodes()[y * N_x + x];
+            max_diff = std::max(max_diff, std::abs(node.psi - std::complex<double>(expected, 0.0)));
+            max_diff = std::max(max_diff, std::abs(node.F - std::norm(node.psi)) + std::abs(node.phi - 0.3));
+        }
+    }
+    check(max_diff < 1e-14, "2D Gaussian matches per-node formula");
+
+    Gaussian2DParams bump{0.2, 100.0, 20.0, 3.0, 3.0, 0.0, "add", 1.0};
+    Gaussian2DParams blend{0.5, 80.0, 64.0, 30.0, 30.0, -0.1, "blend", 0.4};
+    IGSOAComplexEngine2D sequential(makeConfig(N_x * N_y, 2.5), N_x, N_y);
+    IGSOAStateInit2D::initGaussian2D(sequential, g);
+    IGSOAStateInit2D::initGaussian2D(sequential, bump);
+    IGSOAStateInit2D::initGaussian2D(sequential, blend);
+    IGSOAStateInit2D::initGaussians2D(engine, {g, bump, blend});
+    check(maxStateDifference(sequential.getNodes(), engine.getNodes()) == 0.0,
+          "2D Gaussian list matches calls in order");
+
+    const size_t M_x = 8, M_y = 6, M_z = 5;
+    IGSOAComplexEngine3D wave(makeConfig(M_x * M_y * M_z, 1.8), M_x, M_y, M_z);
+    PlaneWave3DParams w{0.8, 0.7, -0.4, 1.1, 0.25};
+    IGSOAStateInit3D::initPlaneWave3D(wave, w);
+    max_diff = 0.0;
+    for (size_t z = 0; z < M_z; z++) {
+        for (size_t y = 0; y < M_y; y++) {
+            for (size_t x = 0; x < M_x; x++) {
+                const double phase = w.k_x * x + w.k_y * y + w.k_z * z + w.phase_offset;
+                const auto& node = wave.getNodes()[(z * M_y + y) * M_x + x];
+                max_diff = std::max(max_diff, std::abs(node.psi - w.amplitude * std::exp(std::complex<double>(0.0, phase))));
+            }
+        }
+    }
+    check(max_diff < 1e-14, "3D plane wave matches per-node formula");
+
+    Gaussian3DParams ball{1.0, 2.0, 3.0, 2.5, 1.5, 1.5, 1.5, 0.0, "overwrite", 1.0};
+    Gaussian3DParams dent{-0.3, 5.0, 1.0, 1.0, 1.0, 2.0, 1.0, 0.0, "add", 1.0};
+    IGSOAComplexEngine3D sequential_3d(makeConfig(M_x * M_y * M_z, 1.8), M_x, M_y, M_z);
+    IGSOAStateInit3D::initGaussian3D(sequential_3d, ball);
+    IGSOAStateInit3D::initGaussian3D(sequential_3d, dent);
+    IGSOAStateInit3D::initGaussians3D(wave, {ball, dent});
+    check(maxStateDifference(sequential_3d.getNodes(), wave.getNodes()) == 0.0,
+          "3D Gaussian list matches calls in order");
+}
+
+void testAdaptiveStepping() {
+    std::cout << "adaptive stepping" << std::endl;
+
+    // normalize_psi off: per-node normalization makes the Gaussian tails chaotic
+    const size_t N_x = 32, N_y = 32;
+    auto config = makeConfig(N_x * N_y, 2.5);
+    config.normalize_psi = false;
+    Gaussian2DParams g{0.8, 16.0, 16.0, 4.0, 4.0, 0.0, "overwrite", 1.0};
+
+    const double t_end = 4.0;
+    auto fine_config = config;
+    fine_config.dt = 0.001;
+    IGSOAComplexEngine2D fine(fine_config, N_x, N_y);
+    IGSOAComplexEngine2D adaptive(config, N_x, N_y);
+    IGSOAStateInit2D::initGaussian2D(fine, g);
+    IGSOAStateInit2D::initGaussian2D(adaptive, g);
+    fine.runMission(4000);
+    IGSOAComplexEngine2D fixed(config, N_x, N_y);
+    IGSOAStateInit2D::initGaussian2D(fixed, g);
+    fixed.runMission(400);
+
+    dase::AdaptiveStepConfig step;
+    step.tolerance = 1e-4;
+    const dase::AdaptiveRunStats stats = adaptive.runUntil(t_end, step);
+    check(stats.reached && std::abs(adaptive.getCurrentTime() - t_end) < 1e-12,
+          "lands on t_end");
+    check(adaptive.getTotalSteps() == 2 * stats.accepted && stats.steps == adaptive.getTotalSteps(),
+          "two half steps kept per accepted attempt");
+    check(maxStateDifference(fine.getNodes(), adaptive.getNodes()) <
+          maxStateDifference(fine.getNodes(), fixed.getNodes()),
+          "adaptive state closer to the reference than fixed dt");
+
+    adaptive.runMission(1);
+    check(std::abs(adaptive.getCurrentTime() - (t_end + config.dt)) < 1e-12, "configured dt restored");
+
+    IGSOAComplexEngine2D rejecting(config, N_x, N_y);
+    IGSOAStateInit2D::initGaussian2D(rejecting, g);
+    rejecting.setObservableRecording(DIAG_ENERGY, 1, 1 << 16);
+    rejecting.setMissionDiagnostics(DIAG_ENERGY);
+    step.dt_initial = 2.0;
+    const dase::AdaptiveRunStats shrunk = rejecting.runUntil(1.0, step);
+    check(shrunk.reached && shrunk.rejected > 0 && shrunk.dt_largest < 2.0,
+          "oversized first step is rejected and recovered");
+
+    // Trial steps stay out of the recorders: one sample per kept step, in order
+    const dase::ObservableRing& series = rejecting.getObservableRecorder().series();
+    std::vector<double> steps;
+    series.copySteps(steps);
+    bool in_order = series.recorded() == rejecting.getTotalSteps();
+    for (size_t k = 0; k < steps.size(); k++) {
+        in_order = in_order && steps[k] == static_cast<double>(k + 1);
+    }
+    check(in_order, "observables record accepted steps only");
+    const double energy = rejecting.computeDiagnostics(DIAG_ENERGY).total_energy;
+    check(std::abs(rejecting.getMissionDiagnostics().total_energy - energy) <= 1e-12 * std::abs(energy) &&
+          std::abs(series.lastValue(0) - energy) <= 1e-9 * std::abs(energy),
+          "diagnostics describe the accepted state");
+}
+
+void testActiveRegion() {
+    std::cout << "active-region stepping" << std::endl;
+
+    // 128^2 (threaded region) with a localized Gaussian in a zero field
+    const size_t N_x = 128, N_y = 128;
+    auto config = makeConfig(N_x * N_y, 2.0);
+    config.normalize_psi = false;
+    Gaussian2DParams g{0.8, 64.0, 64.0, 3.0, 3.0, 0.0, "overwrite", 1.0};
+    ActiveRegionConfig region;
+    region.enabled = true;
+    region.tile = 8;
+
+    IGSOAComplexEngine2D full(config, N_x, N_y);
+    IGSOAComplexEngine2D masked(config, N_x, N_y);
+    IGSOAComplexEngine2D masked_threaded(config, N_x, N_y);
+    IGSOAStateInit2D::initGaussian2D(full, g);
+    IGSOAStateInit2D::initGaussian2D(masked, g);
+    IGSOAStateInit2D::initGaussian2D(masked_threaded, g);
+    masked.setActiveRegion(region);
+    masked_threaded.setActiveRegion(region);
+    full.runMission(40);
+    setThreads(1);
+    masked.runMission(40);
+    setThreads(4);
+    masked_threaded.runMission(40);
+    setThreads(1);
+
+    const ActiveRegionStats& stats = masked.getActiveRegionStats();
+    check(maxStateDifference(full.getNodes(), masked.getNodes()) < 1e-9, "2D matches the full lattice");
+    check(stats.masked_steps == 40 && stats.fallback_steps == 0 && stats.tiles == 256, "2D steps through the mask");
+    check(stats.skippedRatio() > 0.5, "2D skips most tiles of a localized start");
+    check(maxStateDifference(masked.getNodes(), masked_threaded.getNodes()) == 0.0,
+          "2D state independent of thread count");
+    check(masked.getTotalSteps() == 40 && masked.getCurrentTime() == full.getCurrentTime(), "2D clock advanced");
+
+    // A frontier tile turning hot within one step trips the guard
+    IGSOALatticeSoA lattice(32 * 32);
+    lattice.psi_re[16 * 32 + 16] = 1.0;
+    IGSOAActiveRegion mask;
+    region.tile = 4;
+    mask.configure(region, 32, 32, 1, 2);
+    mask.beginMission();
+    for (size_t k = 0; k < mask.scanCount(); k++) mask.scanTile(lattice, k);
+    mask.update();
+    check(mask.stats().last_active_tiles == 9 && mask.activeNodes() == 9 * 4 * 4,
+          "mask dilates the hot tile by the halo");
+    lattice.psi_re[16 * 32 + 16 + 4] = 1.0;  // next tile in x (frontier)
+    for (size_t k = 0; k < mask.scanCount(); k++) mask.scanTile(lattice, k);
+    mask.update();
+    check(mask.stats().guard_trips == 1 && mask.stats().halo_tiles == 2 &&
+          mask.stats().last_active_tiles == 5 * 6, "guard widens the halo");
+
+    std::vector<double> signals(3, 0.01), controls(3, 0.0);
+    masked.runMission(3, signals.data(), controls.data());
+    check(stats.fallback_steps == 3 && stats.fallback_reason == "driven", "driven mission falls back");
+
+    const size_t M = 48;
+    auto config_3d = makeConfig(M * M * M, 1.5);
+    config_3d.normalize_psi = false;
+    Gaussian3DParams g3{0.7, 24.0, 24.0, 24.0, 1.5, 1.5, 1.5, 0.0, "overwrite", 1.0};
+    IGSOAComplexEngine3D full_3d(config_3d, M, M, M);
+    IGSOAComplexEngine3D masked_3d(config_3d, M, M, M);
+    IGSOAStateInit3D::initGaussian3D(full_3d, g3);
+    IGSOAStateInit3D::initGaussian3D(masked_3d, g3);
+    masked_3d.setActiveRegion(region);
+    full_3d.runMission(12);
+    masked_3d.runMission(12);
+    check(maxStateDifference(full_3d.getNodes(), masked_3d.getNodes()) < 1e-9, "3D matches the full lattice");
+    check(masked_3d.getActiveRegionStats().skippedRatio() > 0.5, "3D skips most tiles of a localized start");
+}
+
+template<typename Real>
+void seedLattice(IGSOALatticeSoAT<Real>& lattice) {
+    for (size_t i = 0; i < lattice.size(); i++) {
+        lattice.psi_re[i] = static_cast<Real>(std::sin(0.37 * i));
+        lattice.psi_im[i] = static_cast<Real>(std::cos(0.11 * i));
+        lattice.phi[i] = static_cast<Real>(0.1 * std::cos(0.23 * i));
+        lattice.kappa[i] = Real(1);
+        lattice.gamma[i] = Real(0.1);
+    }
+}
+
+template<typename Real>
+double maxDotDifference(const IGSOALatticeSoAT<Real>& a, const IGSOALatticeSoAT<Real>& b) {
+    double max_diff = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        max_diff = std::max(max_diff, std::abs(static_cast<double>(a.psi_dot_re[i] - b.psi_dot_re[i])));
+        max_diff = std::max(max_diff, std::abs(static_cast<double>(a.psi_dot_im[i] - b.psi_dot_im[i])));
+    }
+    return max_diff;
+}
+
+// Fixed-radius vs generic stencil sweep for R = 1..5 on one lattice shape
+template<typename Real>
+bool fixedKernelsMatch(size_t N_x, size_t N_y, size_t N_z, double tolerance) {
+    bool match = true;
+    for (int R = 1; R <= kFixedStencilMaxRadius; R++) {
+        IGSOALatticeSoAT<Real> generic(N_x * N_y * N_z);
+        seedLattice(generic);
+        IGSOALatticeSoAT<Real> fixed = generic;
+        if (N_z == 1) {
+            CouplingStencil2D stencil;
+            stencil.build(R, N_x, N_y);
+            const uint64_t ops = IGSOAPhysicsSoA::evolveQuantumState2D(generic, stencil, 0.01, N_x, N_y);
+            match = match && IGSOAPhysicsSoA::fixedKernel2D<Real>(R)(fixed, 0.01, N_x, N_y, 0, N_y, 1.0) == ops;
+        } else {
+            CouplingStencil3D stencil;
+            stencil.build(R, N_x, N_y, N_z);
+            const uint64_t ops = IGSOAPhysicsSoA::evolveQuantumState3D(generic, stencil, 0.01, N_x, N_y, N_z);
+            match = match && IGSOAPhysicsSoA::fixedKernel3D<Real>(R)(fixed, 0.01, N_x, N_y, N_z, 0, N_z, 1.0) == ops;
+        }
+        match = match && maxDotDifference(generic, fixed) <= tolerance;
+    }
+    return match;
+}
+
+void testFixedRadiusKernels() {
+    std::cout << "fixed-radius stencil kernels" << std::endl;
+
+    check(fixedStencilRadius(3.0, 16, 16) == 3 && fixedStencilRadius(5.0, 11, 11, 11) == 5,
+          "integer R_c selects its kernel");
+    check(fixedStencilRadius(2.5, 16, 16) == 0 && fixedStencilRadius(6.0, 32, 32) == 0 &&
+          fixedStencilRadius(3.0, 6, 16) == 0 && fixedStencilRadius(2.0, 16, 16, 4) == 0,
+          "fractional, large or wrapping radii stay generic");
+    check(FixedStencil2D<1>::K == 4 && FixedStencil2D<2>::K == 12 && FixedStencil3D<1>::K == 6 &&
+          FixedStencil3D<2>::K == 32, "compile-time offset counts");
+
+    check(fixedKernelsMatch<double>(23, 17, 1, 1e-13), "2D matches the generic stencil (R = 1..5)");
+    check(fixedKernelsMatch<double>(13, 12, 11, 1e-13), "3D matches the generic stencil (R = 1..5)");
+    check(fixedKernelsMatch<float>(23, 17, 1, 1e-5), "2D float32 matches the generic stencil");
+    check(fixedKernelsMatch<float>(13, 12, 11, 1e-5), "3D float32 matches the generic stencil");
+
+    // Engines dispatch on the lattice R_c and keep the reference trajectory
+    const size_t N_x = 20, N_y = 16;
+    auto config = makeConfig(N_x * N_y, 3.0);
+    IGSOAComplexEngine2D engine(config, N_x, N_y);
+    seed(engine.getNodesMutable());
+    std::vector<IGSOAComplexNode> reference = engine.getNodes();
+    engine.runMission(4);
+    for (int step = 0; step < 4; step++) {
+        IGSOAPhysics2D::timeStep(reference, config, N_x, N_y);
+    }
+    check(engine.getFixedStencilRadius() == 3, "2D engine selects R = 3");
+    check(maxStateDifference(engine.getNodes(), reference) < 1e-9, "2D engine matches the reference");
+    for (auto& node : engine.getNodesMutable()) node.R_c = 2.5;
+    engine.runMission(1);
+    check(engine.getFixedStencilRadius() == 0, "fractional R_c falls back to the generic stencil");
+
+    const size_t M = 12;
+    auto config_3d = makeConfig(M * M * M, 2.0);
+    IGSOAComplexEngine3D engine_3d(config_3d, M, M, M);
+    seed(engine_3d.getNodesMutable());
+    std::vector<IGSOAComplexNode> reference_3d = engine_3d.getNodes();
+    engine_3d.runMission(3);
+    for (int step = 0; step < 3; step++) {
+        IGSOAPhysics3D::timeStep(reference_3d, config_3d, M, M, M);
+    }
+    check(engine_3d.getFixedStencilRadius() == 2, "3D engine selects R = 2");
+    check(maxStateDifference(engine_3d.getNodes(), reference_3d) < 1e-9, "3D engine matches the reference");
+}
+
+// Max |ΔΨ| between one recursive and one direct sweep from the same state
+double recursiveSweepError(size_t N, double R_c) {
+    IGSOALatticeSoA direct(N);
+    for (size_t i = 0; i < N; i++) {
+        direct.psi_re[i] = std::sin(0.37 * i);
+        direct.psi_im[i] = std::cos(0.11 * i);
+        direct.phi[i] = 0.1 * std::cos(0.23 * i);
+        direct.kappa[i] = 1.0;
+        direct.gamma[i] = 0.1;
+        direct.R_c[i] = R_c;
+    }
+    IGSOALatticeSoA recursive = direct;
+    std::vector<double> scratch;
+    uint64_t operations = 0;
+    const uint64_t direct_operations = IGSOAPhysicsSoA::evolveQuantumState1D(direct, 0.01);
+    if (!IGSOAPhysicsSoA::evolveQuantumState1DRecursive(recursive, 0.01, scratch, operations)) return 1.0;
+    if (operations != direct_operations) return 1.0;
+
+    double max_diff = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        max_diff = std::max(max_diff, std::abs(direct.psi_re[i] - recursive.psi_re[i]));
+        max_diff = std::max(max_diff, std::abs(direct.psi_im[i] - recursive.psi_im[i]));
+    }
+    return max_diff;
+}
+
+void testRecursiveCoupling() {
+    std::cout << "1D recursive coupling" << std::endl;
+
+    check(recursiveSweepError(64, 1.0) < 1e-13, "R_c = 1 matches the direct sum");
+    check(recursiveSweepError(64, 3.7) < 1e-13, "fractional R_c matches the direct sum");
+    check(recursiveSweepError(51, 25.0) < 1e-13, "window just under half the ring");
+    check(recursiveSweepError(4096, 300.0) < 1e-12, "R_c = 300 matches the direct sum");
+
+    // Whole missions through the engine
+    auto config = makeConfig(257, 40.0);
+    IGSOAComplexEngine direct(config);
+    config.coupling_mode = IGSOACouplingMode::Recursive;
+    IGSOAComplexEngine recursive(config);
+    seed(direct.getNodesMutable());
+    seed(recursive.getNodesMutable());
+    direct.runMission(20);
+    recursive.runMission(20);
+    check(recursive.isRecursiveCouplingActive(), "engine selects the recursive sweep");
+    check(maxStateDifference(recursive.getNodes(), direct.getNodes()) < 1e-11, "engine trajectory");
+    check(recursive.getTotalOperations() == direct.getTotalOperations(), "same operation count");
+
+    // Non-uniform R_c, R_c < 1 and rings of at most 2⌊R_c⌋ run the direct sum
+    recursive.getNodesMutable()[7].R_c = 12.0;
+    recursive.runMission(1);
+    check(!recursive.isRecursiveCouplingActive(), "non-uniform R_c falls back");
+
+    auto small = makeConfig(10, 5.0);
+    small.coupling_mode = IGSOACouplingMode::Recursive;
+    IGSOAComplexEngine wrapped(small);
+    IGSOAComplexEngine wrapped_direct(makeConfig(10, 5.0));
+    seed(wrapped.getNodesMutable());
+    seed(wrapped_direct.getNodesMutable());
+    wrapped.runMission(3);
+    wrapped_direct.runMission(3);
+    check(!wrapped.isRecursiveCouplingActive() &&
+          maxStateDifference(wrapped.getNodes(), wrapped_direct.getNodes()) == 0.0,
+          "ring shorter than the window falls back");
+
+    auto narrow = makeConfig(32, 0.5);
+    narrow.coupling_mode = IGSOACouplingMode::Recursive;
+    IGSOAComplexEngine local(narrow);
+    local.runMission(1);
+    check(!local.isRecursiveCouplingActive(), "R_c < 1 falls back");
+}
+
+void testNeighborBuild() {
+    std::cout << "parallel neighbor-list build and spatial grid" << std::endl;
+    const size_t N_x = 48, N_y = 40;
+    IGSOALatticeSoA lattice(N_x * N_y);
+    for (size_t i = 0; i < lattice.size(); i++) {
+        lattice.R_c[i] = (i % 11 == 0) ? 3.5 : 2.0;
+    }
+
+    NeighborCache2D serial(N_x, N_y, 2.0);
+    NeighborCache2D threaded(N_x, N_y, 2.0);
+    setThreads(1);
+    serial.build(lattice);
+    setThreads(4);
+    threaded.build(lattice);
+    bool same = serial.getTotalNeighborCount() == threaded.getTotalNeighborCount();
+    for (size_t i = 0; same && i < lattice.size(); i++) {
+        same = serial.getNeighborCount(i) == threaded.getNeighborCount(i);
+        for (size_t k = 0; same && k < serial.getNeighborCount(i); k++) {
+            same = serial.getNeighbors(i)[k].id == threaded.getNeighbors(i)[k].id &&
+                   serial.getNeighbors(i)[k].weight == threaded.getNeighbors(i)[k].weight;
+        }
+    }
+    check(same, "CSR lists independent of thread count");
+
+    // Row lengths match a brute-force count on the torus
+    bool counts = true;
+    for (size_t i = 0; counts && i < lattice.size(); i += 37) {
+        size_t expected = 0;
+        for (size_t j = 0; j < lattice.size(); j++) {
+            int dx = std::abs(static_cast<int>(i % N_x) - static_cast<int>(j % N_x));
+            int dy = std::abs(static_cast<int>(i / N_x) - static_cast<int>(j / N_x));
+            dx = std::min(dx, static_cast<int>(N_x) - dx);
+            dy = std::min(dy, static_cast<int>(N_y) - dy);
+            if (j != i && std::sqrt(static_cast<double>(dx * dx + dy * dy)) <= lattice.R_c[i]) expected++;
+        }
+        counts = serial.getNeighborCount(i) == expected;
+    }
+    check(counts, "row lengths match brute force");
+
+    // Grid candidates cover every node within range and reuse the buffer
+    SpatialHash2D grid(N_x, N_y, 3.0);
+    for (size_t i = 0; i < lattice.size(); i++) {
+        grid.insert(static_cast<int>(i), static_cast<int>(i % N_x), static_cast<int>(i / N_x));
+    }
+    grid.finalize();
+    std::vector<int> candidates;
+    bool covered = true;
+    const int px = 20, py = 17, range = 4;
+    grid.query(px, py, range, candidates);
+    std::vector<int> sorted = candidates;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t j = 0; j < lattice.size(); j++) {
+        const int dx = static_cast<int>(j % N_x) - px, dy = static_cast<int>(j / N_x) - py;
+        if (dx * dx + dy * dy <= range * range) {
+            covered = covered && std::binary_search(sorted.begin(), sorted.end(), static_cast<int>(j));
+        }
+    }
+    const size_t capacity = candidates.capacity();
+    grid.query(px, py, range, candidates);
+    check(covered && candidates.size() == sorted.size() && candidates.capacity() == capacity,
+          "grid query covers the range without reallocating");
+    size_t visited = 0;
+    grid.forEachCandidate(0, 0, 1, [&visited](int) { visited++; });
+    check(visited == 4 * 9, "corner query clipped to the grid");  // 2x2 cells of 3x3
+}
+
+int main() {
+    std::cout << "=== IGSOA SoA Lattice Test ===" << std::endl;
+
+    testRoundTrip();
+    test1D();
+    test2D();
+    testNodeView();
+    test3D();
+    testStencil();
+    testNeighborCache();
+    testRegionExtract();
+    testBulkAccess();
+    testCheckpoint();
+    testEnsemble();
+    testFloatPrecision();
+    testDiagnostics();
+    testPhaseProfiling();
+    testMissionRegion();
+    testStateInit();
+    testAdaptiveStepping();
+    testActiveRegion();
+    testFixedRadiusKernels();
+    testRecursiveCoupling();
+    testNeighborBuild();
+#ifdef USE_FFTW3
+    testSpectral();
+#endif
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
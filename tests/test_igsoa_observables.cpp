@@ -0,0 +1,277 @@
+/**
+ * IGSOA Observable Recording Test
+ *
+ * Checks that the observable recorder samples on the lifetime step
+ * cadence across missions, matches the fused diagnostics pass of the same
+ * state for every thread count and lattice dimension, keeps the newest
+ * samples once the ring wraps, and bypasses the active-region mask; that
+ * probe channels read their node's field on every sample wherever it lies
+ * among the threads' rows; and that the sliding spectrum matches a
+ * windowed DFT of the recorded series.
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+void seed(std::vector<IGSOAComplexNode>& nodes) {
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i].psi = std::complex<double>(std::sin(0.37 * i), std::cos(0.11 * i));
+        nodes[i].phi = 0.1 * std::cos(0.23 * i);
+        nodes[i].updateInformationalDensity();
+    }
+}
+
+IGSOAComplexConfig makeConfig(uint32_t num_nodes, double R_c) {
+    IGSOAComplexConfig config;
+    config.num_nodes = num_nodes;
+    config.R_c_default = R_c;
+    config.kappa = 1.0;
+    config.gamma = 0.1;
+    config.dt = 0.01;
+    config.normalize_psi = true;
+    return config;
+}
+
+void testObservableRecording() {
+    std::cout << "observable time series" << std::endl;
+
+    auto near = [](double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); };
+
+    // Reference: one-step missions and a full diagnostics pass per sample
+    const size_t N_x = 20, N_y = 14;
+    IGSOAComplexEngine2D recorded(makeConfig(N_x * N_y, 2.5), N_x, N_y);
+    IGSOAComplexEngine2D reference(makeConfig(N_x * N_y, 2.5), N_x, N_y);
+    IGSOAStateInit2D::initCircularGaussian(recorded, 1.0, 4.0, 6.0, 5.0);
+    IGSOAStateInit2D::initCircularGaussian(reference, 1.0, 4.0, 6.0, 5.0);
+    recorded.setObservableRecording(DIAG_ALL, 3, 4);
+
+    std::vector<IGSOADiagnostics> expected;
+    for (int step = 1; step <= 20; step++) {
+        reference.runMission(1);
+        if (step % 3 == 0) expected.push_back(reference.computeDiagnostics());
+    }
+    // Missions of 5, 7 and 8 steps: samples at steps 3, 6, ..., 18
+    recorded.runMission(5);
+    recorded.runMission(7);
+    recorded.runMission(8);
+
+    const IGSOAObservableRecorder& recorder = recorded.getObservableRecorder();
+    const dase::ObservableRing& ring = recorder.series();
+    check(recorder.channelCount() == 4 && std::string(recorder.channelName(0)) == "energy" &&
+          std::string(recorder.channelName(3)) == "y_cm", "2D channels");
+    check(ring.recorded() == 6 && ring.size() == 4 && ring.dropped() == 2, "ring keeps the newest samples");
+
+    std::vector<double> steps, times, energy, entropy, x_cm, y_cm;
+    ring.copySteps(steps);
+    ring.copyTimes(times);
+    ring.copyChannel(0, energy);
+    ring.copyChannel(1, entropy);
+    ring.copyChannel(2, x_cm);
+    ring.copyChannel(3, y_cm);
+    bool steps_ok = true, values_ok = true;
+    for (size_t i = 0; i < ring.size(); i++) {
+        const IGSOADiagnostics& d = expected[i + 2];
+        steps_ok = steps_ok && steps[i] == static_cast<double>(3 * (i + 3)) &&
+                   near(times[i], steps[i] * 0.01);
+        values_ok = values_ok && near(energy[i], d.total_energy) && near(entropy[i], d.total_entropy_rate) &&
+                    near(x_cm[i], d.x_cm) && near(y_cm[i], d.y_cm);
+    }
+    check(steps_ok, "sample steps and times");
+    check(values_ok, "samples match the diagnostics pass");
+    check(ring.lastStep() == 18 && ring.lastValue(0) == energy.back(), "newest sample");
+
+    recorded.clearObservables();
+    check(ring.size() == 0 && recorder.enabled(), "clear keeps the configuration");
+    recorded.setObservableRecording(0, 3, 4);
+    recorded.runMission(3);
+    check(!recorder.enabled() && ring.size() == 0, "mask 0 disables recording");
+
+    // Threaded missions sample the same state
+    const size_t M = 128;
+    auto big = makeConfig(M * M, 1.0);
+    std::vector<double> first_energy;
+    for (int threads : {1, 4}) {
+        setThreads(threads);
+        IGSOAComplexEngine2D engine(big, M, M);
+        IGSOAStateInit2D::initCircularGaussian(engine, 1.0, 50.0, 70.0, 9.0);
+        engine.setObservableRecording(DIAG_ENERGY | DIAG_CENTER_OF_MASS, 2, 8);
+        engine.runMission(4);
+        const IGSOADiagnostics last = engine.computeDiagnostics(DIAG_ENERGY | DIAG_CENTER_OF_MASS);
+        const dase::ObservableRing& series = engine.getObservableRecorder().series();
+        check(series.size() == 2 && near(series.lastValue(0), last.total_energy) &&
+              near(series.lastValue(1), last.x_cm) && near(series.lastValue(2), last.y_cm),
+              "threaded samples match the diagnostics pass");
+        std::vector<double> e;
+        series.copyChannel(0, e);
+        if (first_energy.empty()) first_energy = e;
+        check(e.size() == first_energy.size() && near(e[0], first_energy[0]) && near(e[1], first_energy[1]),
+              "samples independent of the thread count");
+    }
+    setThreads(1);
+
+    // 1D ring: x_cm only; 3D: all three coordinates
+    IGSOAComplexEngine engine_1d(makeConfig(64, 3.0));
+    seed(engine_1d.getNodesMutable());
+    engine_1d.setObservableRecording(DIAG_ALL, 1, 16);
+    engine_1d.runMission(5);
+    const auto& recorder_1d = engine_1d.getObservableRecorder();
+    check(recorder_1d.channelCount() == 3 && std::string(recorder_1d.channelName(2)) == "x_cm" &&
+          recorder_1d.series().size() == 5, "1D channels");
+    check(near(recorder_1d.series().lastValue(0), engine_1d.getTotalEnergy()) &&
+          near(recorder_1d.series().lastValue(1), engine_1d.getTotalEntropyRate()), "1D samples");
+
+    IGSOAComplexEngine3D engine_3d(makeConfig(8 * 6 * 5, 1.8), 8, 6, 5);
+    IGSOAStateInit3D::initSphericalGaussian(engine_3d, 1.0, 1.0, 4.0, 3.5, 1.5);
+    engine_3d.setObservableRecording(DIAG_CENTER_OF_MASS, 2, 4);
+    engine_3d.runMission(4);
+    const IGSOADiagnostics com_3d = engine_3d.computeDiagnostics(DIAG_CENTER_OF_MASS);
+    const auto& series_3d = engine_3d.getObservableRecorder().series();
+    check(series_3d.channels() == 3 && series_3d.size() == 2 && near(series_3d.lastValue(0), com_3d.x_cm) &&
+          near(series_3d.lastValue(1), com_3d.y_cm) && near(series_3d.lastValue(2), com_3d.z_cm),
+          "3D samples");
+
+    // Recording needs every node stepped, so the active-region mask stands aside
+    IGSOAComplexEngine2D masked(makeConfig(N_x * N_y, 1.0), N_x, N_y);
+    ActiveRegionConfig active;
+    active.enabled = true;
+    masked.setActiveRegion(active);
+    masked.setObservableRecording(DIAG_ENERGY, 1, 4);
+    masked.runMission(2);
+    check(masked.getActiveRegionStats().fallback_reason == "observables" &&
+          masked.getObservableRecorder().series().size() == 2, "active region falls back while recording");
+}
+
+void testObservableProbesAndSpectrum() {
+    std::cout << "observable probes and spectrum" << std::endl;
+
+    // Probes in the first, middle and last rows, so 4 threads each own one
+    const size_t M = 128;
+    const std::vector<IGSOAProbe> probes = {
+        {M * M - 3, IGSOAProbeField::Phi}, {5, IGSOAProbeField::PsiReal},
+        {M * (M / 2) + 7, IGSOAProbeField::F}, {5, IGSOAProbeField::PsiImag}};
+    std::vector<std::vector<double>> first_values;
+    for (int threads : {1, 4}) {
+        setThreads(threads);
+        IGSOAComplexEngine2D engine(makeConfig(M * M, 1.0), M, M);
+        IGSOAComplexEngine2D reference(makeConfig(M * M, 1.0), M, M);
+        IGSOAStateInit2D::initCircularGaussian(engine, 1.0, 40.0, 64.0, 9.0);
+        IGSOAStateInit2D::initCircularGaussian(reference, 1.0, 40.0, 64.0, 9.0);
+        engine.setObservableRecording(DIAG_ENERGY, 2, 16, probes);
+        engine.runMission(6);
+
+        std::vector<std::vector<double>> expected(probes.size());
+        for (int step = 1; step <= 6; step++) {
+            reference.runMission(1);
+            if (step % 2 != 0) continue;
+            const auto& lattice = reference.getLattice();
+            expected[0].push_back(lattice.phi[probes[0].node]);
+            expected[1].push_back(lattice.psi_re[probes[1].node]);
+            expected[2].push_back(lattice.F[probes[2].node]);
+            expected[3].push_back(lattice.psi_im[probes[3].node]);
+        }
+
+        const IGSOAObservableRecorder& recorder = engine.getObservableRecorder();
+        check(recorder.channelCount() == 5 && std::string(recorder.channelName(1)) == "phi@16381" &&
+              std::string(recorder.channelName(4)) == "psi_imag@5", "probe channels follow the observables");
+        bool same = recorder.series().size() == 3;
+        std::vector<std::vector<double>> values(probes.size());
+        for (size_t p = 0; p < probes.size(); p++) {
+            recorder.series().copyChannel(1 + p, values[p]);
+            same = same && values[p] == expected[p];
+        }
+        check(same, "probes read their node on every sample");
+        if (first_values.empty()) first_values = values;
+        check(values == first_values, "probes independent of the thread count");
+    }
+    setThreads(1);
+
+    // Spectrum of a recorded probe vs a Hann-windowed DFT of its series
+    const size_t N_x = 24, N_y = 16;
+    IGSOAComplexEngine2D engine(makeConfig(N_x * N_y, 2.0), N_x, N_y);
+    IGSOAStateInit2D::initCircularGaussian(engine, 1.0, 6.0, 8.0, 3.0);
+    engine.setObservableRecording(DIAG_ENERGY, 3, 64, {{N_x * 8 + 6, IGSOAProbeField::PsiReal}});
+    dase::SlidingSpectrumConfig spectrum;
+    spectrum.frequencies = {0.5, 2.0, 5.0};    // cycles per unit time (dt 0.01)
+    spectrum.window = 32;
+    spectrum.hop = 8;
+    spectrum.frames = 8;
+    engine.setObservableSpectrum(spectrum);
+    engine.runMission(150);
+
+    const IGSOAObservableRecorder& recorder = engine.getObservableRecorder();
+    const dase::SlidingSpectrumBank& bank = recorder.spectrum();
+    check(bank.enabled() && bank.channels() == 2 && bank.samples() == 50 && bank.ready() &&
+          bank.framesRecorded() == 3, "spectrum takes every sample of every channel");
+    std::vector<double> probe;
+    recorder.series().copyChannel(1, probe);
+    const double two_pi = 6.283185307179586;
+    bool spectrum_ok = true;
+    for (size_t k = 0; k < spectrum.frequencies.size(); k++) {
+        const double f = spectrum.frequencies[k] * 0.01 * 3;   // cycles per sample
+        std::complex<double> sum;
+        for (size_t m = 0; m < 32; m++) {
+            const double w = 0.5 - 0.5 * std::cos(two_pi * m / 32);
+            sum += w * probe[probe.size() - 32 + m] * std::polar(1.0, -two_pi * f * m);
+        }
+        spectrum_ok = spectrum_ok && std::abs(bank.magnitude(1, k) - std::abs(sum) / 16.0) < 1e-12;
+    }
+    check(spectrum_ok, "spectrum matches a windowed DFT of the recorded series");
+
+    engine.clearObservables();
+    check(bank.samples() == 0 && bank.frameCount() == 0 && bank.enabled(), "clear empties the spectrum");
+    engine.setObservableRecording(0, 3, 64);
+    check(!recorder.enabled() && !bank.enabled(), "no channels disables recording and spectrum");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== IGSOA Observable Recording Test ===" << std::endl;
+
+    testObservableRecording();
+    testObservableProbesAndSpectrum();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,345 @@
+/**
+ * IGSOA RK4 Integrator Test
+ *
+ * Checks that an RK4 step of the 2D engine equals a reference RK4 step of
+ * the coupled Ψ/Φ system built from frozen stencil sums, that its error
+ * falls ~16× per halving of dt and is far below Euler's at the same dt
+ * (1D and 3D too), that the stage sweeps do not depend on the thread
+ * count, that the neighbor-cache, spectral and float32 paths agree with
+ * the stencil path, that the adaptive controller takes fourth-order steps,
+ * and that the stage buffers are counted and released.
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+IGSOAComplexConfig makeConfig(double R_c, IGSOAIntegrator integrator, double dt = 0.02) {
+    IGSOAComplexConfig config;
+    config.R_c_default = R_c;
+    config.kappa = 1.0;
+    config.gamma = 0.1;
+    config.dt = dt;
+    config.normalize_psi = false;
+    config.integrator = integrator;
+    return config;
+}
+
+// Smooth, non-symmetric start state
+void fill(IGSOALatticeSoA& lattice, size_t N_x, size_t N_y) {
+    for (size_t i = 0; i < lattice.size(); i++) {
+        const double x = 2.0 * M_PI * static_cast<double>(i % N_x) / N_x;
+        const double y = 2.0 * M_PI * static_cast<double>((i / N_x) % N_y) / N_y;
+        lattice.psi_re[i] = 0.5 * std::sin(x + 0.3) + 0.2 * std::cos(2.0 * y);
+        lattice.psi_im[i] = 0.3 * std::cos(x - y) + 0.1;
+        lattice.phi[i] = 0.05 * std::sin(y);
+    }
+}
+
+template<typename Engine>
+void seed(Engine& engine, size_t N_x, size_t N_y) {
+    IGSOALatticeSoA state(engine.getTotalNodes());
+    fill(state, N_x, N_y);
+    engine.setPsiRange(0, state.size(), state.psi_re.data(), state.psi_im.data());
+    engine.setPhiRange(0, state.size(), state.phi.data());
+}
+
+double psiDifference(const IGSOALatticeSoA& a, const IGSOALatticeSoA& b) {
+    double diff = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        diff = std::max(diff, std::abs(a.psi_re[i] - b.psi_re[i]));
+        diff = std::max(diff, std::abs(a.psi_im[i] - b.psi_im[i]));
+    }
+    return diff;
+}
+
+// 2D engine state after t_end in steps of dt
+IGSOALatticeSoA run2D(IGSOAIntegrator integrator, double dt, double t_end, size_t N = 16) {
+    IGSOAComplexEngine2D engine(makeConfig(2.0, integrator, dt), N, N);
+    seed(engine, N, N);
+    engine.runMission(static_cast<uint64_t>(std::llround(t_end / dt)));
+    return engine.getLattice();
+}
+
+/**
+ * One RK4 step of ∂Ψ/∂t = -i(-𝒦[Ψ] + κΦΨ + iγΨ), ∂Φ/∂t = -κ(Φ - Re Ψ) - γΦ
+ * with 𝒦 summed from the stencil by coordinates
+ */
+void referenceStep(IGSOALatticeSoA& lattice, const CouplingStencil2D& stencil, size_t N_x, size_t N_y, double dt) {
+    const size_t N = lattice.size();
+    using Plane = std::vector<double>;
+    auto derivative = [&](const Plane& re, const Plane& im, const Plane& phi, Plane& d_re, Plane& d_im, Plane& d_phi) {
+        for (size_t i = 0; i < N; i++) {
+            const int x = static_cast<int>(i % N_x), y = static_cast<int>(i / N_x);
+            double nl_re = 0.0, nl_im = 0.0;
+            for (size_t k = 0; k < stencil.size(); k++) {
+                const size_t j = ((y + stencil.dy()[k] + N_y) % N_y) * N_x + (x + stencil.dx()[k] + N_x) % N_x;
+                nl_re += stencil.weight()[k] * (re[j] - re[i]);
+                nl_im += stencil.weight()[k] * (im[j] - im[i]);
+            }
+            const double V = lattice.kappa[i] * phi[i], g = lattice.gamma[i];
+            const double H_re = -nl_re + V * re[i] - g * im[i];
+            const double H_im = -nl_im + V * im[i] + g * re[i];
+            d_re[i] = H_im;
+            d_im[i] = -H_re;
+            d_phi[i] = -lattice.kappa[i] * (phi[i] - re[i]) - g * phi[i];
+        }
+    };
+    const Plane re0(lattice.psi_re.begin(), lattice.psi_re.end());
+    const Plane im0(lattice.psi_im.begin(), lattice.psi_im.end());
+    const Plane phi0(lattice.phi.begin(), lattice.phi.end());
+    Plane k_re[4], k_im[4], k_phi[4], u_re(re0), u_im(im0), u_phi(phi0);
+    const double c[4] = {0.0, 0.5, 0.5, 1.0};
+    for (int s = 0; s < 4; s++) {
+        k_re[s].resize(N);
+        k_im[s].resize(N);
+        k_phi[s].resize(N);
+        if (s > 0) {
+            for (size_t i = 0; i < N; i++) {
+                u_re[i] = re0[i] + c[s] * dt * k_re[s - 1][i];
+                u_im[i] = im0[i] + c[s] * dt * k_im[s - 1][i];
+                u_phi[i] = phi0[i] + c[s] * dt * k_phi[s - 1][i];
+            }
+        }
+        derivative(u_re, u_im, u_phi, k_re[s], k_im[s], k_phi[s]);
+    }
+    for (size_t i = 0; i < N; i++) {
+        lattice.psi_re[i] += dt / 6.0 * (k_re[0][i] + 2.0 * k_re[1][i] + 2.0 * k_re[2][i] + k_re[3][i]);
+        lattice.psi_im[i] += dt / 6.0 * (k_im[0][i] + 2.0 * k_im[1][i] + 2.0 * k_im[2][i] + k_im[3][i]);
+        lattice.phi[i] += dt / 6.0 * (k_phi[0][i] + 2.0 * k_phi[1][i] + 2.0 * k_phi[2][i] + k_phi[3][i]);
+    }
+}
+
+void testReference() {
+    std::cout << "Reference step:" << std::endl;
+    const size_t N_x = 12, N_y = 10;
+    const IGSOAComplexConfig config = makeConfig(2.5, IGSOAIntegrator::RK4, 0.05);
+    IGSOAComplexEngine2D engine(config, N_x, N_y);
+    seed(engine, N_x, N_y);
+    IGSOALatticeSoA reference = engine.getLattice();
+    CouplingStencil2D stencil;
+    stencil.build(config.R_c_default, N_x, N_y);
+
+    engine.runMission(3);
+    for (int step = 0; step < 3; step++) {
+        referenceStep(reference, stencil, N_x, N_y, config.dt);
+    }
+    const IGSOALatticeSoA& lattice = engine.getLattice();
+    double phi_diff = 0.0, F_diff = 0.0;
+    for (size_t i = 0; i < lattice.size(); i++) {
+        phi_diff = std::max(phi_diff, std::abs(lattice.phi[i] - reference.phi[i]));
+        const double F = reference.psi_re[i] * reference.psi_re[i] + reference.psi_im[i] * reference.psi_im[i];
+        F_diff = std::max(F_diff, std::abs(lattice.F[i] - F));
+    }
+    check(psiDifference(lattice, reference) < 1e-12 && phi_diff < 1e-12, "engine step equals the reference RK4 step");
+    check(F_diff < 1e-12, "F follows the new state");
+    check(engine.getTotalSteps() == 3 && std::abs(engine.getCurrentTime() - 0.15) < 1e-12, "clock advanced");
+}
+
+void testConvergence() {
+    std::cout << "Convergence:" << std::endl;
+    const double t_end = 0.64;
+    const IGSOALatticeSoA exact = run2D(IGSOAIntegrator::RK4, 0.0025, t_end);
+    const double rk4_coarse = psiDifference(run2D(IGSOAIntegrator::RK4, 0.04, t_end), exact);
+    const double rk4_fine = psiDifference(run2D(IGSOAIntegrator::RK4, 0.02, t_end), exact);
+    const double euler_coarse = psiDifference(run2D(IGSOAIntegrator::Euler, 0.04, t_end), exact);
+    const double euler_fine = psiDifference(run2D(IGSOAIntegrator::Euler, 0.02, t_end), exact);
+    std::cout << "    rk4 " << rk4_coarse << " -> " << rk4_fine
+              << ", euler " << euler_coarse << " -> " << euler_fine << std::endl;
+    check(rk4_fine > 0.0 && rk4_coarse / rk4_fine > 12.0 && rk4_coarse / rk4_fine < 20.0,
+          "2D RK4 error falls ~16x per halving of dt");
+    check(euler_coarse / euler_fine > 1.6 && euler_coarse / euler_fine < 2.5, "Euler error falls ~2x");
+    check(rk4_coarse * 100.0 < euler_coarse, "RK4 beats Euler at the same dt");
+
+    auto run1D = [](IGSOAIntegrator integrator, double dt) {
+        IGSOAComplexConfig config = makeConfig(3.0, integrator, dt);
+        config.num_nodes = 64;
+        IGSOAComplexEngine engine(config);
+        for (size_t i = 0; i < 64; i++) {
+            const double x = 2.0 * M_PI * static_cast<double>(i) / 64.0;
+            engine.setNodePsi(i, 0.5 * std::sin(x), 0.3 * std::cos(2.0 * x));
+        }
+        engine.runMission(static_cast<uint64_t>(std::llround(0.64 / dt)));
+        return engine.getLattice();
+    };
+    const IGSOALatticeSoA exact_1d = run1D(IGSOAIntegrator::RK4, 0.0025);
+    const double coarse_1d = psiDifference(run1D(IGSOAIntegrator::RK4, 0.04), exact_1d);
+    const double fine_1d = psiDifference(run1D(IGSOAIntegrator::RK4, 0.02), exact_1d);
+    check(fine_1d > 0.0 && coarse_1d / fine_1d > 12.0 && coarse_1d / fine_1d < 20.0, "1D RK4 is fourth order");
+    check(coarse_1d * 100.0 < psiDifference(run1D(IGSOAIntegrator::Euler, 0.04), exact_1d), "1D RK4 beats Euler");
+}
+
+void testThreads() {
+    std::cout << "Threads:" << std::endl;
+    // Above IGSOAPhysicsSoA::kParallelThreshold
+    const size_t N_x = 160, N_y = 128;
+    IGSOAComplexConfig config = makeConfig(1.5, IGSOAIntegrator::RK4);
+    config.normalize_psi = true;
+    std::vector<double> signals(4, 0.01), controls(4, -0.02);
+    IGSOAComplexEngine2D serial(config, N_x, N_y), threaded(config, N_x, N_y);
+    seed(serial, N_x, N_y);
+    seed(threaded, N_x, N_y);
+    setThreads(1);
+    serial.runMission(4, signals.data(), controls.data());
+    setThreads(4);
+    threaded.runMission(4, signals.data(), controls.data());
+    check(psiDifference(serial.getLattice(), threaded.getLattice()) == 0.0 &&
+          serial.getLattice().phi == threaded.getLattice().phi, "stage sweeps independent of thread count");
+}
+
+void testPaths() {
+    std::cout << "Coupling paths:" << std::endl;
+    const size_t N = 16;
+
+    // Heterogeneous R_c: per-node box search against the neighbor lists
+    IGSOAComplexEngine2D direct(makeConfig(3.0, IGSOAIntegrator::RK4), N, N);
+    IGSOAComplexConfig cache_config = makeConfig(3.0, IGSOAIntegrator::RK4);
+    cache_config.coupling_mode = IGSOACouplingMode::NeighborCache;
+    IGSOAComplexEngine2D cached(cache_config, N, N);
+    seed(direct, N, N);
+    seed(cached, N, N);
+    for (size_t i = 0; i < N * N; i += 7) {
+        direct.getNodesMutable()[i].R_c = 4.5;
+        cached.getNodesMutable()[i].R_c = 4.5;
+    }
+    direct.runMission(5);
+    cached.runMission(5);
+    check(psiDifference(direct.getLattice(), cached.getLattice()) < 1e-3, "neighbor cache tracks the box search");
+
+#ifdef USE_FFTW3
+    IGSOAComplexEngine2D stencil(makeConfig(8.0, IGSOAIntegrator::RK4), 32, 24);
+    IGSOAComplexConfig spectral_config = makeConfig(8.0, IGSOAIntegrator::RK4);
+    spectral_config.coupling_mode = IGSOACouplingMode::Spectral;
+    IGSOAComplexEngine2D spectral(spectral_config, 32, 24);
+    seed(stencil, 32, 24);
+    seed(spectral, 32, 24);
+    stencil.runMission(4);
+    spectral.runMission(4);
+    check(spectral.isSpectralCouplingActive() && psiDifference(stencil.getLattice(), spectral.getLattice()) < 1e-9,
+          "spectral stages equal the stencil stages");
+#endif
+
+    IGSOAComplexConfig float_config = makeConfig(2.0, IGSOAIntegrator::RK4);
+    float_config.precision = IGSOAPrecision::Float;
+    IGSOAComplexEngine2D single(float_config, N, N);
+    IGSOAComplexEngine2D full(makeConfig(2.0, IGSOAIntegrator::RK4), N, N);
+    seed(single, N, N);
+    seed(full, N, N);
+    single.runMission(10);
+    full.runMission(10);
+    check(single.isFloatPrecisionActive() && psiDifference(single.getLattice(), full.getLattice()) < 1e-4,
+          "float32 RK4 tracks double");
+
+    // 3D (seeded by its first 16 x 16 indices)
+    auto run3D = [&](const IGSOAComplexConfig& config, double dt) {
+        IGSOAComplexConfig stepped = config;
+        stepped.dt = dt;
+        IGSOAComplexEngine3D cube(stepped, 8, 8, 8);
+        seed(cube, N, N);
+        cube.runMission(static_cast<uint64_t>(std::llround(0.64 / dt)));
+        return cube;
+    };
+    const IGSOAComplexConfig cube_config = makeConfig(2.0, IGSOAIntegrator::RK4);
+    const IGSOALatticeSoA exact = run3D(cube_config, 0.0025).getLattice();
+    const double coarse = psiDifference(run3D(cube_config, 0.04).getLattice(), exact);
+    const double fine = psiDifference(run3D(cube_config, 0.02).getLattice(), exact);
+    check(fine > 0.0 && coarse / fine > 12.0 && coarse / fine < 20.0, "3D RK4 is fourth order");
+    const IGSOAComplexEngine3D cube_f32 = run3D(float_config, 0.02);
+    check(cube_f32.isFloatPrecisionActive() && psiDifference(cube_f32.getLattice(), exact) < 1e-4,
+          "3D float32 RK4 tracks double");
+}
+
+void testMemory() {
+    std::cout << "Memory:" << std::endl;
+    const size_t N = 16;
+    const IGSOAComplexConfig config = makeConfig(2.0, IGSOAIntegrator::RK4);
+    IGSOAComplexEngine2D engine(config, N, N);
+    check(engine.getIntegratorMemoryUsage() == 0, "stages allocated by the first mission");
+    engine.runMission(1);
+    check(engine.getIntegratorMemoryUsage() == IGSOARK4Stages::estimateMemoryUsage(N * N), "stage bytes");
+    check(IGSOAComplexEngine2D::estimateFootprint(config, N, N) ==
+              IGSOAComplexEngine2D::estimateMemoryUsage(N, N) + engine.getCouplingCacheMemoryUsage() +
+              engine.getIntegratorMemoryUsage(), "footprint estimate counts the stages");
+
+    IGSOAComplexEngine3D cube(config, 8, 8, 8);
+    cube.runMission(1);
+    check(IGSOAComplexEngine3D::estimateFootprint(config, 8, 8, 8) ==
+              IGSOAComplexEngine3D::estimateMemoryUsage(8, 8, 8) + cube.getCouplingCacheMemoryUsage() +
+              cube.getIntegratorMemoryUsage(), "3D footprint estimate");
+
+    engine.setIntegrator(IGSOAIntegrator::Euler);
+    check(engine.getIntegratorMemoryUsage() == 0 && engine.getIntegrator() == IGSOAIntegrator::Euler,
+          "switching to Euler frees the stages");
+
+    IGSOAIntegrator parsed = IGSOAIntegrator::Euler;
+    check(parseIGSOAIntegrator("rk4", parsed) && parsed == IGSOAIntegrator::RK4 &&
+          !parseIGSOAIntegrator("rk45", parsed) && std::string(igsoaIntegratorName(parsed)) == "rk4",
+          "names");
+}
+
+void testAdaptive() {
+    std::cout << "Adaptive:" << std::endl;
+    auto attempts = [](IGSOAIntegrator integrator) {
+        const size_t N = 16;
+        IGSOAComplexEngine2D engine(makeConfig(2.0, integrator, 0.01), N, N);
+        seed(engine, N, N);
+        dase::AdaptiveStepConfig adaptive;
+        adaptive.tolerance = 1e-6;
+        const dase::AdaptiveRunStats stats = engine.runUntil(1.0, adaptive);
+        return stats.reached ? stats.accepted + stats.rejected : UINT64_MAX;
+    };
+    const uint64_t euler = attempts(IGSOAIntegrator::Euler);
+    const uint64_t rk4 = attempts(IGSOAIntegrator::RK4);
+    std::cout << "    attempts: euler " << euler << ", rk4 " << rk4 << std::endl;
+    check(rk4 * 10 < euler, "RK4 reaches t_end in far fewer attempts");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== IGSOA RK4 Integrator Test ===" << std::endl;
+    testReference();
+    testConvergence();
+    testThreads();
+    testPaths();
+    testMemory();
+    testAdaptive();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
@@ -2,7 +2,8 @@
  * @file test_logger.cpp
  * @brief Test the Logger utility class
  *
- * Tests basic logging functionality, log levels, and file output.
+ * Tests basic logging functionality, log levels, and file output, and the
+ * asynchronous mode (per-thread rings, drop / backpressure accounting).
  */
 
 #include "utils/logger.h"
@@ -11,6 +12,9 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
 
 using namespace igsoa;
 
@@ -135,6 +139,86 @@ void verifyLogFile() {
     }
 }
 
+int countLines(const char* filename, const std::string& needle) {
+    std::ifstream file(filename);
+    int count = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find(needle) != std::string::npos) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void runWorkers(int num_threads, int per_thread) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; t++) {
+        workers.emplace_back([t, per_thread]() {
+            for (int i = 0; i < per_thread; i++) {
+                LOG_INFO_F("async worker %d message %d", t, i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void testAsyncLogging() {
+    std::cout << "\n=== Test 7: Asynchronous Logging ===\n";
+
+    std::remove("test_logger_async.log");
+    Logger& logger = Logger::getInstance();
+    logger.initialize("test_logger_async.log", Logger::Level::WARNING, Logger::Level::DEBUG);
+
+    // Drop policy with rings large enough for the burst
+    Logger::AsyncConfig config;
+    config.ring_capacity = 4096;
+    logger.enableAsync(config);
+    runWorkers(4, 500);
+    logger.flush();
+    Logger::AsyncStats stats = logger.getAsyncStats();
+    if (stats.enqueued + stats.dropped != 2000 || stats.written != stats.enqueued || stats.threads != 4) {
+        throw std::runtime_error("async drop accounting");
+    }
+
+    // Backpressure: tiny rings, producers wait for the drain instead of dropping
+    config.ring_capacity = 8;
+    config.overflow = Logger::OverflowPolicy::Block;
+    config.block_timeout_us = 5000000;
+    logger.enableAsync(config);
+    runWorkers(4, 200);
+    logger.flush();
+    const Logger::AsyncStats blocked = logger.getAsyncStats();
+    if (blocked.dropped != 0 || blocked.written != 800) {
+        throw std::runtime_error("async backpressure");
+    }
+
+    // Messages beyond kRecordText are cut and marked
+    LOG_INFO(std::string(Logger::kRecordText + 50, 'x'));
+    logger.flush();
+    if (logger.getAsyncStats().truncated != 1) {
+        throw std::runtime_error("async truncation count");
+    }
+
+    logger.shutdown();
+    if (logger.isAsync()) {
+        throw std::runtime_error("shutdown leaves async mode");
+    }
+    const int lines = countLines("test_logger_async.log", "async worker");
+    if (lines != static_cast<int>(stats.enqueued + blocked.written)) {
+        throw std::runtime_error("async records missing from log file");
+    }
+    if (countLines("test_logger_async.log", std::string(Logger::kRecordText, 'x') + "...") != 1) {
+        throw std::runtime_error("truncated record not marked");
+    }
+
+    std::cout << "Async: " << stats.enqueued << " enqueued, " << stats.dropped << " dropped (drop), "
+              << blocked.written << " written (block)\n";
+    std::cout << "✓ Test 7 passed: Asynchronous logging\n";
+}
+
 int main() {
     std::cout << "========================================\n";
     std::cout << "Logger Test Suite\n";
@@ -147,6 +231,7 @@ int main() {
         testWithNumbers();
         testThreadSafety();
         verifyLogFile();
+        testAsyncLogging();
 
         std::cout << "\n========================================\n";
         std::cout << "✓ ALL TESTS PASSED!\n";
@@ -0,0 +1,161 @@
+/**
+ * Memory Admission Test
+ *
+ * Checks that MemoryAdmission grants requests that fit, refuses requests
+ * over the budget at once, queues the rest in arrival order (a newcomer
+ * does not pass a waiter), times waiters out and admits them as memory is
+ * released, and that the engines' footprint estimates equal what stepped
+ * engines actually hold.
+ */
+
+#include "../src/cpp/memory_admission.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_ensemble_engine_2d.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dase;
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+void settle() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+void testAdmission() {
+    std::cout << "Admission:" << std::endl;
+    MemoryAdmission admission;
+    admission.setBudget(1000);
+
+    std::string error;
+    check(admission.reserve(600, 0.0, &error), "request that fits is granted");
+    check(!admission.reserve(500, 0.0, &error) && !error.empty(), "request that does not fit fails without waiting");
+
+    const auto start = std::chrono::steady_clock::now();
+    check(!admission.reserve(2000, 5.0, &error) &&
+          std::chrono::steady_clock::now() - start < std::chrono::seconds(1),
+          "request over the budget fails at once");
+
+    check(!admission.reserve(500, 0.05, &error), "waiter times out");
+    check(admission.stats().waiting == 0, "timed-out waiter leaves the queue");
+
+    // Queue: 700 waits for the 600, then 200 (which would fit) waits behind it
+    std::vector<int> order;
+    std::mutex order_mutex;
+    auto waiter = [&](size_t bytes, int id) {
+        if (admission.reserve(bytes, 5.0)) {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(id);
+        }
+    };
+    std::thread large(waiter, 700, 1);
+    settle();
+    std::thread small(waiter, 200, 2);
+    settle();
+    check(admission.stats().waiting == 2 && admission.stats().reserved_bytes == 600,
+          "a newcomer that fits queues behind a waiter");
+    check(!admission.tryReserve(100), "tryReserve does not pass waiters");
+
+    admission.release(600);
+    large.join();
+    small.join();
+    check(order == std::vector<int>({1, 2}) && admission.stats().reserved_bytes == 900,
+          "waiters admitted in arrival order once memory is released");
+
+    MemoryAdmissionStats stats = admission.stats();
+    check(stats.admitted == 3 && stats.waited == 3 && stats.rejected == 3 && stats.peak_reserved_bytes == 900,
+          "counters");
+
+    // A shrinking budget fails waiters that can no longer fit
+    std::atomic<bool> refused{false};
+    std::thread doomed([&]() { refused = !admission.reserve(600, 5.0); });
+    settle();
+    admission.setBudget(500);
+    doomed.join();
+    check(refused && admission.stats().reserved_bytes == 900, "smaller budget refuses waiters over it");
+
+    admission.setBudget(0);
+    check(admission.reserve(size_t(1) << 40, 0.0), "budget 0 is unlimited");
+    admission.release(size_t(1) << 40);
+    admission.release(900);
+    check(admission.stats().reserved_bytes == 0, "release");
+}
+
+IGSOAComplexConfig latticeConfig(double R_c, IGSOACouplingMode mode) {
+    IGSOAComplexConfig config;
+    config.R_c_default = R_c;
+    config.coupling_mode = mode;
+    config.normalize_psi = false;
+    return config;
+}
+
+bool footprintMatches3D(double R_c, IGSOACouplingMode mode, size_t N) {
+    const IGSOAComplexConfig config = latticeConfig(R_c, mode);
+    IGSOAComplexEngine3D engine(config, N, N, N);
+    engine.runMission(1);
+    const size_t actual = IGSOAComplexEngine3D::estimateMemoryUsage(N, N, N) + engine.getCouplingCacheMemoryUsage();
+    return IGSOAComplexEngine3D::estimateFootprint(config, N, N, N) == actual;
+}
+
+bool footprintMatches2D(double R_c, IGSOACouplingMode mode, size_t N) {
+    const IGSOAComplexConfig config = latticeConfig(R_c, mode);
+    IGSOAComplexEngine2D engine(config, N, N);
+    engine.runMission(1);
+    const size_t actual = IGSOAComplexEngine2D::estimateMemoryUsage(N, N) + engine.getCouplingCacheMemoryUsage();
+    return IGSOAComplexEngine2D::estimateFootprint(config, N, N) == actual;
+}
+
+void testEstimates() {
+    std::cout << "Footprint estimates:" << std::endl;
+    check(footprintMatches3D(2.0, IGSOACouplingMode::Direct, 12) &&
+          footprintMatches3D(2.5, IGSOACouplingMode::Direct, 8), "3D direct");
+    check(footprintMatches3D(1.5, IGSOACouplingMode::NeighborCache, 12) &&
+          footprintMatches3D(3.0, IGSOACouplingMode::NeighborCache, 5), "3D neighbor cache (wrapped radius)");
+    check(footprintMatches3D(4.0, IGSOACouplingMode::Spectral, 16), "3D spectral");
+    check(footprintMatches2D(3.0, IGSOACouplingMode::Direct, 32) &&
+          footprintMatches2D(3.0, IGSOACouplingMode::NeighborCache, 32) &&
+          footprintMatches2D(6.0, IGSOACouplingMode::Spectral, 32), "2D direct, neighbor cache and spectral");
+
+    IGSOAComplexConfig config = latticeConfig(2.0, IGSOACouplingMode::Direct);
+    const size_t row_major = IGSOAComplexEngine3D::estimateFootprint(config, 16, 16, 16);
+    config.precision = IGSOAPrecision::Float;
+    check(IGSOAComplexEngine3D::estimateFootprint(config, 16, 16, 16) ==
+              row_major + IGSOALatticeSoAF32::estimateMemoryUsage(4096), "float32 working copy counted");
+
+    const IGSOAComplexConfig ensemble_config = latticeConfig(2.0, IGSOACouplingMode::Direct);
+    IGSOAEnsembleEngine2D ensemble(ensemble_config, 16, 12, 11);
+    check(IGSOAEnsembleEngine2D::estimateMemoryUsage(ensemble_config, 16, 12, 11) == ensemble.getMemoryUsage(),
+          "ensemble");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Memory Admission Test ===" << std::endl;
+    testAdmission();
+    testEstimates();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * Perf Counters Test
+ *
+ * Checks the derived figures of PerfCounterSample against hand-computed
+ * values, that missing events propagate as -1, that measure() records one
+ * sample per mission (also when the mission throws) and sums the totals,
+ * and that a busy loop registers CPU time whenever the host exposes the
+ * task clock. Hardware events may be unavailable (VMs, paranoid 3); the
+ * test then only checks that they are reported as such.
+ */
+
+#include "../src/cpp/perf_counters.h"
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+void set(PerfCounterSample& s, PerfEvent e, uint64_t value) {
+    s.values[static_cast<size_t>(e)] = value;
+    s.available[static_cast<size_t>(e)] = true;
+}
+
+void testDerived() {
+    std::cout << "derived figures" << std::endl;
+    PerfCounterSample s;
+    s.wall_ns = 1000000;
+    check(s.ipc() < 0.0 && s.dramGBPerSecond() < 0.0 && s.averageParallelism() < 0.0,
+          "missing events report -1");
+
+    set(s, PerfEvent::Cycles, 4000);
+    set(s, PerfEvent::Instructions, 10000);
+    set(s, PerfEvent::LlcReferences, 200);
+    set(s, PerfEvent::LlcMisses, 50);
+    set(s, PerfEvent::FpVectorInstructions, 1600);
+    set(s, PerfEvent::TaskClock, 3000000);
+    check(std::abs(s.ipc() - 2.5) < 1e-12, "ipc");
+    check(std::abs(s.llcMissRatio() - 0.25) < 1e-12, "llc miss ratio");
+    check(std::abs(s.vectorInstructionsPerCycle() - 0.4) < 1e-12, "vector instructions per cycle");
+    check(std::abs(s.dramBytes() - 3200.0) < 1e-12, "dram bytes = 64 per miss");
+    check(std::abs(s.dramGBPerSecond() - 0.0032) < 1e-15, "dram bandwidth");
+    check(std::abs(s.vectorInstructionsPerByte() - 0.5) < 1e-12, "vector instructions per byte");
+    check(std::abs(s.averageParallelism() - 3.0) < 1e-12, "average parallelism");
+
+    PerfCounterSample other;
+    other.wall_ns = 500;
+    set(other, PerfEvent::TaskClock, 7);
+    other.multiplexed = true;
+    s += other;
+    check(s.value(PerfEvent::TaskClock) == 3000007 && s.wall_ns == 1000500 && s.multiplexed &&
+          s.value(PerfEvent::Cycles) == 4000, "accumulation");
+}
+
+void testMeasure() {
+    std::cout << "mission measurement" << std::endl;
+    PerfCounters counters;
+    volatile double sink = 0.0;
+    const int result = counters.measure([&]() {
+        for (int i = 0; i < 20000000; i++) sink = sink + 1e-9 * i;
+        return 42;
+    });
+    check(result == 42, "mission result is returned");
+    check(counters.missions() == 1 && counters.last().wall_ns > 0, "one sample recorded");
+
+    const PerfCounterSample first = counters.last();
+    if (first.has(PerfEvent::TaskClock)) {
+        check(first.value(PerfEvent::TaskClock) > first.wall_ns / 4, "task clock covers the loop");
+    } else {
+        std::cout << "  [SKIP] task clock unavailable on this host" << std::endl;
+    }
+    if (first.has(PerfEvent::Cycles) && first.has(PerfEvent::Instructions)) {
+        check(first.value(PerfEvent::Instructions) > 20000000 && first.ipc() > 0.0, "hardware events count");
+    } else {
+        check(first.ipc() < 0.0, "unavailable hardware events stay -1");
+    }
+
+    bool threw = false;
+    try {
+        counters.measure([]() { throw std::runtime_error("mission failed"); });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    check(threw && counters.missions() == 2, "throwing mission still recorded");
+    check(counters.total().wall_ns >= first.wall_ns, "totals accumulate");
+
+    counters.reset();
+    check(counters.missions() == 0 && counters.total().wall_ns == 0, "reset clears totals");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Perf Counters Test ===" << std::endl;
+
+    testDerived();
+    testMeasure();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
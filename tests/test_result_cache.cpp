@@ -0,0 +1,185 @@
+/**
+ * Result Cache Test
+ *
+ * Checks the 128-bit FNV-1a hash against its published vectors, that
+ * MissionProvenance keys a chunked mission like a single call but tells
+ * apart different configurations, event orders and restarted input
+ * sequences, and that ResultCache restores stored states, rejects and
+ * drops entries of the wrong engine type, and evicts least recently used
+ * entries to stay within its byte budget.
+ */
+
+#include "../src/cpp/result_cache.h"
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+// Minimal engine: a field and a step counter in a checkpoint
+struct ToyEngine {
+    std::string type = "toy";
+    std::vector<double> field;
+    uint64_t steps = 0;
+
+    explicit ToyEngine(size_t n) : field(n, 0.0) {}
+
+    void run(uint64_t n) {
+        for (uint64_t s = 0; s < n; s++, steps++) {
+            for (size_t i = 0; i < field.size(); i++) field[i] += 0.5 * static_cast<double>(i + steps);
+        }
+    }
+
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        writer.setEngineType(type);
+        const uint64_t dims = field.size();
+        writer.copyArray("dims", &dims, 1);
+        writer.addArray("field", field.data(), field.size());
+        writer.addScalar("steps", steps);
+    }
+
+    bool loadCheckpoint(const CheckpointReader& reader, std::string* error) {
+        if (!checkCheckpointShape(reader, type, {field.size()}, error)) return false;
+        const double* stored = reader.array<double>("field", field.size());
+        const uint64_t* stored_steps = reader.array<uint64_t>("steps", 1);
+        if (!stored || !stored_steps) {
+            if (error) *error = "missing sections";
+            return false;
+        }
+        field.assign(stored, stored + field.size());
+        steps = *stored_steps;
+        return true;
+    }
+};
+
+void testHash() {
+    std::cout << "FNV-1a 128:" << std::endl;
+    check(ResultHash().hex() == "6c62272e07bb014262b821756295c58d", "empty input is the offset basis");
+    check(ResultHash().addBytes("a", 1).hex() == "d228cb696f1a8caf78912b704e4a8964", "\"a\"");
+    check(ResultHash().addBytes("foobar", 6).hex() == "343e1662793c64bf6f0d3597ba446f18", "\"foobar\"");
+    check(ResultHash().add("ab").add("c").hex() != ResultHash().add("a").add("bc").hex(),
+          "strings are length-prefixed");
+}
+
+MissionProvenance created(double dt) {
+    MissionProvenance provenance;
+    provenance.start();
+    provenance.event("create").add("toy").add(64).add(dt);
+    return provenance;
+}
+
+void testProvenance() {
+    std::cout << "Provenance:" << std::endl;
+    MissionProvenance whole = created(0.01);
+    const std::string key = whole.keyAfter(0, 300);
+    whole.advance(0, 300);
+    check(key.size() == 32 && whole.key() == key, "keyAfter predicts the key after advance");
+    const std::string salted = ResultHash().add("schema").add(kResultCacheSchema).add(kCheckpointVersion)
+                                   .add("create").add("toy").add(64).add(0.01)
+                                   .add("steps").add(uint64_t(0)).add(uint64_t(300)).hex();
+    check(key == salted, "keys are salted with the schema and checkpoint version");
+
+    MissionProvenance chunked = created(0.01);
+    chunked.advance(0, 100);
+    chunked.advance(100, 150);
+    chunked.advance(250, 50);
+    check(chunked.key() == key, "contiguous chunks key like one mission");
+
+    MissionProvenance restarted = created(0.01);
+    restarted.advance(0, 150);
+    restarted.advance(0, 150);
+    check(restarted.key() != key, "restarting the input sequence changes the key");
+
+    check(created(0.02).keyAfter(0, 300) != key, "configuration changes the key");
+
+    MissionProvenance a = created(0.01), b = created(0.01);
+    a.event("profile").add("gaussian");
+    a.advance(0, 10);
+    b.advance(0, 10);
+    b.event("profile").add("gaussian");
+    check(a.key() != b.key(), "events and missions hash in order");
+
+    a.untrack();
+    check(a.key().empty() && a.keyAfter(0, 5).empty(), "untracked provenance has no key");
+    check(MissionProvenance().key().empty(), "never started is untracked");
+}
+
+void testCache() {
+    std::cout << "Cache:" << std::endl;
+    const std::string directory = "test_result_cache_dir";
+    std::filesystem::remove_all(directory);
+
+    ResultCache cache;
+    ToyEngine engine(64);
+    check(!cache.enabled() && !cache.load("0", engine) && !cache.store("0", engine), "disabled cache stores nothing");
+
+    std::string error;
+    check(cache.configure(directory, 1 << 20, &error), "configure creates the directory");
+
+    ToyEngine original(64);
+    original.run(20);
+    check(cache.store("k1", original, &error) && cache.contains("k1"), "store");
+
+    ToyEngine restored(64);
+    check(cache.load("k1", restored, &error) && restored.field == original.field && restored.steps == 20,
+          "hit restores the stored state");
+    check(!cache.load("k2", restored), "unknown key misses");
+
+    ToyEngine other(64);
+    other.type = "other";
+    check(!cache.load("k1", other, &error) && !cache.contains("k1"), "rejected entry is dropped");
+
+    ResultCacheStats stats = cache.stats();
+    check(stats.hits == 1 && stats.misses == 3 && stats.stores == 1 && stats.entries == 0, "counters");
+
+    // Budget for two entries: storing a third evicts the least recently used
+    cache.store("a", original);
+    const uint64_t entry_bytes = cache.stats().bytes;
+    check(cache.configure(directory, 2 * entry_bytes + entry_bytes / 2), "reconfigure budget");
+    cache.store("b", original);
+    cache.load("a", restored);            // a is now newer than b
+    cache.store("c", original);
+    check(cache.contains("a") && !cache.contains("b") && cache.contains("c"),
+          "least recently used entry evicted");
+    stats = cache.stats();
+    check(stats.entries == 2 && stats.bytes <= stats.max_bytes && stats.evictions == 1, "within budget");
+
+    check(cache.configure(directory, entry_bytes / 2) && cache.stats().entries == 0,
+          "shrinking the budget evicts");
+    check(!cache.store("d", original, &error) && !cache.contains("d"), "state over the budget is not stored");
+
+    cache.disable();
+    check(!cache.enabled() && !cache.contains("a"), "disable");
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Result Cache Test ===" << std::endl;
+    testHash();
+    testProvenance();
+    testCache();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,852 @@
+/**
+ * SATP+Higgs Engine Test
+ *
+ * Checks the 1D/2D/3D velocity-Verlet engines reuse their persistent
+ * scratch buffers (no heap allocation inside evolve()), that splitting a
+ * run across several evolve() calls leaves the trajectory unchanged, and
+ * that the vectorized and scalar kernels match a straightforward AoS
+ * reference within SATPHiggsKernels::kTolerance, and that the tiled 3D step
+ * reproduces the full-lattice sweeps to the same tolerance. float32 stepping is checked against the
+ * double path within SATPHiggsKernelsF32::kTolerance, and the fused
+ * diagnostics pass against serial energy / RMS / center-of-mass loops.
+ * The step phase profiler must count every sweep of each evolve(). The
+ * separable Gaussian initializers must match the per-node periodic formula,
+ * and a list of profiles must equal the single-profile calls in order.
+ * Adaptive runUntil must land on t_end, grow dt past the configured step
+ * within the stability limit, track a fine fixed-dt reference, and recover
+ * from a rejected first step. The vectorized path must match the scalar one
+ * at every SIMD level this CPU supports (runtime dispatch). Batched sources
+ * (moving and pulsed Gaussians, three zones) must match the same S(t, r)
+ * through the per-site callback. The Yoshida4 integrator must converge at
+ * 4th order and drift less in energy than Verlet at the same dt. Parareal
+ * missions must reproduce the serial run after one iteration per slice,
+ * converge in fewer at the tolerance, and resume from their checkpoint on
+ * a fresh engine.
+ */
+
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_1d.h"
+#include "../src/cpp/satp_higgs_engine_2d.h"
+#include "../src/cpp/satp_higgs_physics_2d.h"
+#include "../src/cpp/satp_higgs_engine_3d.h"
+#include "../src/cpp/satp_higgs_physics_3d.h"
+#include "../src/cpp/satp_higgs_state_init_1d.h"
+#include "../src/cpp/satp_higgs_state_init_2d.h"
+#include "../src/cpp/satp_higgs_state_init_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+using namespace dase::satp_higgs;
+using dase::AdaptiveRunStats;
+using dase::AdaptiveStepConfig;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+double maxFieldDifference(const std::vector<SATPHiggsNode>& a,
+                          const std::vector<SATPHiggsNode>& b) {
+    double max_diff = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+        max_diff = std::max(max_diff, std::abs(a[i].phi - b[i].phi));
+        max_diff = std::max(max_diff, std::abs(a[i].phi_dot - b[i].phi_dot));
+        max_diff = std::max(max_diff, std::abs(a[i].h - b[i].h));
+        max_diff = std::max(max_diff, std::abs(a[i].h_dot - b[i].h_dot));
+    }
+    return max_diff;
+}
+
+void seed(std::vector<SATPHiggsNode>& nodes, double h_vev) {
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i].phi = 0.2 * std::sin(0.37 * i);
+        nodes[i].phi_dot = 0.05 * std::cos(0.11 * i);
+        nodes[i].h = h_vev + 0.1 * std::cos(0.23 * i);
+        nodes[i].updateDerived();
+    }
+}
+
+/**
+ * Reference velocity Verlet on SATPHiggsNode (periodic 7/5/3-point Laplacian)
+ */
+void referenceEvolve(std::vector<SATPHiggsNode>& nodes, size_t N_x, size_t N_y, size_t N_z,
+                     double dx, double dt, const SATPHiggsParams& params, size_t num_steps,
+                     const std::vector<double>& source) {
+    const size_t N = nodes.size();
+    const int dims = 1 + (N_y > 1) + (N_z > 1);
+    auto accel = [&](const std::vector<SATPHiggsNode>& state, std::vector<double>& a_phi,
+                     std::vector<double>& a_h) {
+        for (size_t i = 0; i < N; i++) {
+            const size_t x = i % N_x;
+            const size_t y = (i / N_x) % N_y;
+            const size_t z = i / (N_x * N_y);
+            std::vector<size_t> nb = {
+                z * N_x * N_y + y * N_x + (x + N_x - 1) % N_x,
+                z * N_x * N_y + y * N_x + (x + 1) % N_x};
+            if (N_y > 1) {
+                nb.push_back(z * N_x * N_y + ((y + N_y - 1) % N_y) * N_x + x);
+                nb.push_back(z * N_x * N_y + ((y + 1) % N_y) * N_x + x);
+            }
+            if (N_z > 1) {
+                nb.push_back(((z + N_z - 1) % N_z) * N_x * N_y + y * N_x + x);
+                nb.push_back(((z + 1) % N_z) * N_x * N_y + y * N_x + x);
+            }
+            double lap_phi = -2.0 * dims * state[i].phi;
+            double lap_h = -2.0 * dims * state[i].h;
+            for (size_t j : nb) {
+                lap_phi += state[j].phi;
+                lap_h += state[j].h;
+            }
+            lap_phi /= dx * dx;
+            lap_h /= dx * dx;
+            const auto& n = state[i];
+            a_phi[i] = params.c * params.c * lap_phi - params.gamma_phi * n.phi_dot
+                     - 2.0 * params.lambda * n.phi * n.h * n.h + source[i];
+            a_h[i] = params.c * params.c * lap_h - params.gamma_h * n.h_dot
+                   - 2.0 * params.mu_squared * n.h - 4.0 * params.lambda_h * n.h * n.h * n.h
+                   - 2.0 * params.lambda * n.phi * n.phi * n.h;
+        }
+    };
+
+    std::vector<double> a_phi(N), a_h(N);
+    for (size_t step = 0; step < num_steps; step++) {
+        accel(nodes, a_phi, a_h);
+        for (size_t i = 0; i < N; i++) {
+            nodes[i].phi += nodes[i].phi_dot * dt + 0.5 * a_phi[i] * dt * dt;
+            nodes[i].h += nodes[i].h_dot * dt + 0.5 * a_h[i] * dt * dt;
+            nodes[i].phi_dot += 0.5 * a_phi[i] * dt;
+            nodes[i].h_dot += 0.5 * a_h[i] * dt;
+        }
+        accel(nodes, a_phi, a_h);
+        for (size_t i = 0; i < N; i++) {
+            nodes[i].phi_dot += 0.5 * a_phi[i] * dt;
+            nodes[i].h_dot += 0.5 * a_h[i] * dt;
+        }
+    }
+}
+
+double relativeDifference(const std::vector<SATPHiggsNode>& a, const std::vector<SATPHiggsNode>& b) {
+    double scale = 1.0;
+    for (const auto& node : b) {
+        scale = std::max({scale, std::abs(node.phi), std::abs(node.h),
+                          std::abs(node.phi_dot), std::abs(node.h_dot)});
+    }
+    return maxFieldDifference(a, b) / scale;
+}
+
+template<typename Engine>
+void checkKernels(Engine& vectorized, Engine& scalar, size_t N_x, size_t N_y, size_t N_z,
+                  const std::vector<double>& source, const char* label) {
+    std::cout << label << std::endl;
+    const size_t steps = 20;
+    seed(vectorized.getNodesMutable(), vectorized.getParams().h_vev);
+    seed(scalar.getNodesMutable(), scalar.getParams().h_vev);
+    std::vector<SATPHiggsNode> reference = scalar.getNodes();
+
+    scalar.setVectorized(false);
+    vectorized.evolve(steps);
+    scalar.evolve(steps);
+    referenceEvolve(reference, N_x, N_y, N_z, vectorized.getDx(), vectorized.getDt(),
+                    vectorized.getParams(), steps, source);
+
+    check(relativeDifference(vectorized.getNodes(), scalar.getNodes()) < SATPHiggsKernels::kTolerance,
+          "vectorized matches scalar");
+    check(relativeDifference(scalar.getNodes(), reference) < SATPHiggsKernels::kTolerance,
+          "scalar matches AoS reference");
+    const SATPHiggsNode& refreshed = vectorized.getNodes()[3];
+    check(std::abs(refreshed.conformal_factor - std::exp(refreshed.phi)) <= 2.3e-16 * std::exp(refreshed.phi),
+          "derived quantities refreshed (Ω within 1 ULP of exp φ)");
+}
+
+void checkTiled(size_t N_x, size_t N_y, size_t N_z, bool vectorized, bool with_source,
+                const SATPHiggsParams& params, const char* label) {
+    std::cout << label << std::endl;
+    SATPHiggsEngine3D tiled(N_x, N_y, N_z, 0.1, 0.02, params);
+    SATPHiggsEngine3D sweep(N_x, N_y, N_z, 0.1, 0.02, params);
+    sweep.setTiled(false);
+    for (auto* engine : {&tiled, &sweep}) {
+        engine->setVectorized(vectorized);
+        seed(engine->getNodesMutable(), params.h_vev);
+        if (with_source) {
+            engine->setSource([](double t, double x, double y, double z, int, int, int) {
+                return 0.3 * std::sin(3.0 * x + 2.0 * y + z + t);
+            });
+        }
+    }
+
+    tiled.evolve(9);
+    tiled.evolve(6);
+    sweep.evolve(15);
+
+    check(tiled.isTiled() && !sweep.isTiled(), "execution modes selected");
+    check(relativeDifference(tiled.getNodes(), sweep.getNodes()) < SATPHiggsKernels::kTolerance,
+          "tiled matches sweep");
+    check(tiled.getEvolveAllocationCount() == 0, "no allocation inside tiled evolve()");
+    check(tiled.getTotalUpdates() == sweep.getTotalUpdates(), "site updates counted");
+}
+
+template<typename Engine>
+void checkFloat(Engine& f32, Engine& f64, const char* label) {
+    std::cout << label << std::endl;
+    seed(f32.getNodesMutable(), f32.getParams().h_vev);
+    seed(f64.getNodesMutable(), f64.getParams().h_vev);
+    f32.setPrecision(SATPHiggsPrecision::Float);
+
+    f32.evolve(7);
+    f32.evolve(5);
+    f64.evolve(12);
+
+    check(f32.isFloatPrecisionActive() && !f64.isFloatPrecisionActive(), "float path selected");
+    check(relativeDifference(f32.getNodes(), f64.getNodes()) < SATPHiggsKernelsF32::kTolerance,
+          "matches double within float tolerance");
+    check(std::abs(f32.computeTotalEnergy() - f64.computeTotalEnergy()) <
+          SATPHiggsKernelsF32::kTolerance * std::abs(f64.computeTotalEnergy()), "energy agrees");
+    check(f32.getTotalUpdates() == f64.getTotalUpdates() && f32.getTime() == f64.getTime(),
+          "steps and site updates counted");
+}
+
+/**
+ * Serial reference of the fused diagnostics pass: energy (forward
+ * differences), RMS and |φ|-weighted circular center per axis
+ */
+SATPHiggsDiagnostics referenceDiagnostics(const std::vector<SATPHiggsNode>& nodes, size_t N_x, size_t N_y,
+                                          size_t N_z, int dimension, double dx, const SATPHiggsParams& p) {
+    SATPHiggsDiagnostics out;
+    const size_t N = nodes.size();
+    double sum_w = 0.0, sum_cos[3] = {0.0, 0.0, 0.0}, sum_sin[3] = {0.0, 0.0, 0.0};
+    double phi_sq = 0.0, h_sq = 0.0, dev_sq = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        const size_t idx[3] = {i % N_x, (i / N_x) % N_y, i / (N_x * N_y)};
+        const size_t ext[3] = {N_x, N_y, N_z};
+        const size_t next[3] = {(idx[0] + 1) % N_x + (i - idx[0]),
+                                i - idx[1] * N_x + ((idx[1] + 1) % N_y) * N_x,
+                                i - idx[2] * N_x * N_y + ((idx[2] + 1) % N_z) * N_x * N_y};
+        const auto& n = nodes[i];
+        double grad_sq = 0.0;
+        for (int d = 0; d < dimension; d++) {
+            const double dphi = (nodes[next[d]].phi - n.phi) / dx;
+            const double dh = (nodes[next[d]].h - n.h) / dx;
+            grad_sq += dphi * dphi + dh * dh;
+        }
+        out.total_energy += 0.5 * (n.phi_dot * n.phi_dot + n.h_dot * n.h_dot) + 0.5 * p.c * p.c * grad_sq
+                          + p.mu_squared * n.h * n.h + p.lambda_h * std::pow(n.h, 4)
+                          + p.lambda * n.phi * n.phi * n.h * n.h;
+        out.damping_power += p.gamma_phi * n.phi_dot * n.phi_dot + p.gamma_h * n.h_dot * n.h_dot;
+        phi_sq += n.phi * n.phi;
+        h_sq += n.h * n.h;
+        dev_sq += (n.h - p.h_vev) * (n.h - p.h_vev);
+        const double w = std::abs(n.phi);
+        sum_w += w;
+        for (int d = 0; d < 3; d++) {
+            const double theta = 2.0 * M_PI * static_cast<double>(idx[d]) / static_cast<double>(ext[d]);
+            sum_cos[d] += w * std::cos(theta);
+            sum_sin[d] += w * std::sin(theta);
+        }
+    }
+    out.total_energy *= std::pow(dx, dimension);
+    out.damping_power *= std::pow(dx, dimension);
+    out.phi_rms = std::sqrt(phi_sq / N);
+    out.h_rms = std::sqrt(h_sq / N);
+    out.higgs_rms = std::sqrt(dev_sq / N);
+    double* centers[3] = {&out.x_cm, &out.y_cm, &out.z_cm};
+    const size_t ext[3] = {N_x, N_y, N_z};
+    for (int d = 0; d < dimension && sum_w > 1e-12; d++) {
+        const double theta = std::atan2(sum_sin[d], sum_cos[d]);
+        *centers[d] = (theta < 0.0 ? theta + 2.0 * M_PI : theta) * static_cast<double>(ext[d]) / (2.0 * M_PI);
+    }
+    return out;
+}
+
+template<typename Engine>
+void checkDiagnostics(Engine& engine, size_t N_x, size_t N_y, size_t N_z, int dimension, const char* label) {
+    std::cout << label << std::endl;
+    seed(engine.getNodesMutable(), engine.getParams().h_vev);
+    engine.evolve(3);
+
+    auto near = [](double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); };
+    const SATPHiggsDiagnostics all = engine.computeDiagnostics();
+    const SATPHiggsDiagnostics ref = referenceDiagnostics(engine.getNodes(), N_x, N_y, N_z, dimension,
+                                                          engine.getDx(), engine.getParams());
+    check(near(all.total_energy, ref.total_energy) && near(all.damping_power, ref.damping_power),
+          "energy and damping power match serial reference");
+    check(near(all.phi_rms, ref.phi_rms) && near(all.h_rms, ref.h_rms) && near(all.higgs_rms, ref.higgs_rms),
+          "RMS matches serial reference");
+    check(near(all.x_cm, ref.x_cm) && near(all.y_cm, ref.y_cm) && near(all.z_cm, ref.z_cm),
+          "center of mass matches serial reference");
+    check(engine.computeTotalEnergy() == engine.computeDiagnostics(SATP_DIAG_ENERGY).total_energy &&
+          engine.computeDiagnostics(SATP_DIAG_RMS).total_energy == 0.0, "single observables share the pass");
+}
+
+template<typename Engine>
+void checkEngine(Engine& whole, Engine& split, const char* label) {
+    std::cout << label << std::endl;
+    seed(whole.getNodesMutable(), whole.getParams().h_vev);
+    seed(split.getNodesMutable(), split.getParams().h_vev);
+
+    whole.evolve(12);
+    split.evolve(5);
+    split.evolve(7);
+
+    check(whole.getEvolveAllocationCount() == 0, "no allocation inside evolve()");
+    check(split.getEvolveAllocationCount() == 0, "no allocation across calls");
+    check(maxFieldDifference(whole.getNodes(), split.getNodes()) == 0.0, "split run identical");
+    check(whole.getTotalUpdates() == 12 * whole.getN(), "site updates counted");
+    check(std::isfinite(whole.computeTotalEnergy()), "energy finite");
+
+    // Two accel and two update sweeps per Verlet step (one wavefront when tiled),
+    // one gather and one scatter per evolve()
+    const uint64_t per_call = dase::PhaseProfiler::enabled() ? 1 : 0;
+    const auto phases = whole.getPhaseTimings();
+    check(phases.size() == 5 && phases[SATP_PHASE_ACCEL].calls == phases[SATP_PHASE_UPDATE].calls &&
+          phases[SATP_PHASE_ACCEL].calls / 2 + phases[SATP_PHASE_TILED].calls == 12 * per_call &&
+          phases[SATP_PHASE_TRANSFER].calls == 2 * per_call && phases[SATP_PHASE_SOURCE].calls == 0,
+          "step phases counted");
+    whole.reset();
+    check(whole.getPhaseTimings()[SATP_PHASE_ACCEL].calls == 0 &&
+          whole.getPhaseTimings()[SATP_PHASE_TILED].calls == 0, "reset clears phase timings");
+}
+
+/**
+ * Batched sources against the same S(t, r) through the per-site callback
+ */
+void checkBatchSource(const SATPHiggsParams& params) {
+    std::cout << "Batched sources" << std::endl;
+    const double dx = 0.1;
+    MovingGaussianSource moving;
+    moving.amplitude = 0.4;
+    moving.start[0] = 0.9;
+    moving.start[1] = 0.2;
+    moving.start[2] = 0.35;
+    moving.velocity[0] = -3.0;   // crosses the x = 0 seam within the run
+    moving.velocity[1] = 1.5;
+    moving.velocity[2] = 2.0;
+    moving.sigma = 0.15;
+    moving.frequency = 3.0;
+
+    // Minimum-image squared distance, centre folded into [0, L)
+    auto dist2 = [](double r, double c, double L) {
+        c = std::fmod(c, L);
+        if (c < 0.0) c += L;
+        double d = r - c;
+        if (d > L / 2.0) d -= L;
+        if (d < -L / 2.0) d += L;
+        return d * d;
+    };
+    auto moving_at = [&](double t, double x, double y, double z, size_t N_x, size_t N_y, size_t N_z) {
+        double r2 = dist2(x, moving.start[0] + moving.velocity[0] * t, N_x * dx);
+        if (N_y > 1) r2 += dist2(y, moving.start[1] + moving.velocity[1] * t, N_y * dx);
+        if (N_z > 1) r2 += dist2(z, moving.start[2] + moving.velocity[2] * t, N_z * dx);
+        return moving.amplitude * std::cos(2.0 * M_PI * moving.frequency * t) *
+               std::exp(-r2 / (2.0 * moving.sigma * moving.sigma));
+    };
+
+    SATPHiggsEngine1D batch_1d(37, dx, 0.02, params);
+    SATPHiggsEngine1D site_1d(37, dx, 0.02, params);
+    batch_1d.setSourceBatch(moving);
+    site_1d.setSource([&](double t, double x, int) { return moving_at(t, x, 0.0, 0.0, 37, 1, 1); });
+    batch_1d.evolve(25);
+    site_1d.evolve(25);
+    check(relativeDifference(batch_1d.getNodes(), site_1d.getNodes()) < 1e-12, "1D moving source matches per-site");
+
+    SATPHiggsEngine2D batch_2d(13, 9, dx, 0.02, params);
+    SATPHiggsEngine2D site_2d(13, 9, dx, 0.02, params);
+    batch_2d.setSourceBatch(moving);
+    site_2d.setSource([&](double t, double x, double y, int, int) {
+        return moving_at(t, x, y, 0.0, 13, 9, 1);
+    });
+    batch_2d.evolve(25);
+    site_2d.evolve(25);
+    check(relativeDifference(batch_2d.getNodes(), site_2d.getNodes()) < 1e-12, "2D moving source matches per-site");
+
+    for (bool tiled : {true, false}) {
+        SATPHiggsEngine3D batch_3d(11, 6, 5, dx, 0.02, params);
+        SATPHiggsEngine3D site_3d(11, 6, 5, dx, 0.02, params);
+        batch_3d.setTiled(tiled);
+        site_3d.setTiled(tiled);
+        batch_3d.setSourceBatch(moving);
+        site_3d.setSource([&](double t, double x, double y, double z, int, int, int) {
+            return moving_at(t, x, y, z, 11, 6, 5);
+        });
+        batch_3d.evolve(25);
+        site_3d.evolve(25);
+        check(relativeDifference(batch_3d.getNodes(), site_3d.getNodes()) < 1e-12,
+              tiled ? "3D moving source matches per-site (tiled)" : "3D moving source matches per-site (sweep)");
+        check(batch_3d.getEvolveAllocationCount() == 0, "3D batched source keeps the CPU planes");
+    }
+
+    // Pulse: envelope and carrier in time, static spatial tables
+    GaussianPulseSource pulse;
+    pulse.amplitude = 0.8;
+    pulse.center[0] = 1.7;
+    pulse.center[1] = 0.4;
+    pulse.sigma = 0.2;
+    pulse.t0 = 0.2;
+    pulse.duration = 0.1;
+    pulse.frequency = 5.0;
+    SATPHiggsEngine2D pulse_batch(19, 8, dx, 0.02, params);
+    SATPHiggsEngine2D pulse_site(19, 8, dx, 0.02, params);
+    pulse_batch.setSourceBatch(pulse);
+    pulse_site.setSource([&](double t, double x, double y, int, int) {
+        const double s = t - pulse.t0;
+        const double r2 = dist2(x, pulse.center[0], 19 * dx) + dist2(y, pulse.center[1], 8 * dx);
+        return pulse.amplitude * std::exp(-(s * s) / (2.0 * pulse.duration * pulse.duration)) *
+               std::cos(2.0 * M_PI * pulse.frequency * s) * std::exp(-r2 / (2.0 * pulse.sigma * pulse.sigma));
+    });
+    pulse_batch.evolve(30);
+    pulse_site.evolve(30);
+    check(relativeDifference(pulse_batch.getNodes(), pulse_site.getNodes()) < 1e-12, "pulse source matches per-site");
+
+    // Three-zone batch reproduces the callback exactly
+    ThreeZoneSourceParams zones;
+    zones.zone1_start = 0.5;
+    zones.zone1_end = 1.2;
+    zones.zone2_start = 2.0;
+    zones.zone2_end = 2.6;
+    zones.zone3_start = 3.1;
+    zones.zone3_end = 3.5;
+    zones.amplitude1 = 0.05;
+    zones.amplitude2 = -0.03;
+    zones.amplitude3 = 0.04;
+    zones.frequency = 5.0;
+    zones.t_start = 0.1;
+    zones.t_end = 0.5;
+    SATPHiggsEngine1D zone_batch(40, dx, 0.02, params);
+    SATPHiggsEngine1D zone_site(40, dx, 0.02, params);
+    zone_batch.setSourceBatch(SATPHiggsStateInit1D::createThreeZoneSourceBatch(zones));
+    zone_site.setSource(SATPHiggsStateInit1D::createThreeZoneSource(zones, dx));
+    zone_batch.evolve(40);
+    zone_site.evolve(40);
+    check(maxFieldDifference(zone_batch.getNodes(), zone_site.getNodes()) == 0.0, "three-zone batch matches callback");
+
+    zone_batch.clearSource();
+    zone_site.clearSource();
+    zone_batch.evolve(5);
+    zone_site.evolve(5);
+    check(maxFieldDifference(zone_batch.getNodes(), zone_site.getNodes()) == 0.0, "clearSource removes the batch");
+}
+
+/**
+ * Yoshida4: 4th-order convergence, smaller energy drift than Verlet at the
+ * same dt, and the tiled 3D step agreeing with the sweep
+ */
+void checkIntegrator(SATPHiggsParams params) {
+    std::cout << "Yoshida4 integrator" << std::endl;
+    params.gamma_phi = 0.0;
+    params.gamma_h = 0.0;
+    const double T = 1.0;
+
+    auto run = [&](SATPHiggsIntegrator integrator, double dt) {
+        // Long-wavelength state (|ω|·dt well inside the asymptotic regime)
+        SATPHiggsEngine1D engine(64, 0.1, dt, params);
+        auto& nodes = engine.getNodesMutable();
+        for (size_t i = 0; i < nodes.size(); i++) {
+            nodes[i].phi = 0.3 * std::sin(2.0 * M_PI * i / 64.0);
+            nodes[i].h = params.h_vev + 0.1 * std::cos(4.0 * M_PI * i / 64.0);
+            nodes[i].updateDerived();
+        }
+        engine.setIntegrator(integrator);
+        engine.evolve(static_cast<size_t>(T / dt + 0.5));
+        return engine.getNodes();
+    };
+    const std::vector<SATPHiggsNode> reference = run(SATPHiggsIntegrator::Yoshida4, 0.00125);
+    const double yoshida_coarse = maxFieldDifference(run(SATPHiggsIntegrator::Yoshida4, 0.02), reference);
+    const double yoshida_fine = maxFieldDifference(run(SATPHiggsIntegrator::Yoshida4, 0.01), reference);
+    const double verlet_coarse = maxFieldDifference(run(SATPHiggsIntegrator::Verlet, 0.02), reference);
+    const double verlet_fine = maxFieldDifference(run(SATPHiggsIntegrator::Verlet, 0.01), reference);
+    check(yoshida_coarse / yoshida_fine > 12.0, "Yoshida4 error falls ~16x per halving of dt");
+    check(verlet_coarse / verlet_fine > 3.0 && verlet_coarse / verlet_fine < 5.0, "Verlet error falls ~4x");
+    check(yoshida_coarse < 0.1 * verlet_coarse, "Yoshida4 more accurate at the same dt");
+
+    auto drift = [&](SATPHiggsIntegrator integrator) {
+        SATPHiggsEngine2D engine(16, 12, 0.1, 0.02, params);
+        seed(engine.getNodesMutable(), params.h_vev);
+        engine.setIntegrator(integrator);
+        const double e0 = engine.computeTotalEnergy();
+        double worst = 0.0;
+        for (int block = 0; block < 10; block++) {
+            engine.evolve(10);
+            worst = std::max(worst, std::abs(engine.computeTotalEnergy() - e0) / std::abs(e0));
+        }
+        return worst;
+    };
+    check(drift(SATPHiggsIntegrator::Yoshida4) < drift(SATPHiggsIntegrator::Verlet),
+          "Yoshida4 energy drift below Verlet");
+
+    SATPHiggsEngine3D tiled(9, 7, 5, 0.1, 0.02, params);
+    SATPHiggsEngine3D sweep(9, 7, 5, 0.1, 0.02, params);
+    sweep.setTiled(false);
+    for (auto* engine : {&tiled, &sweep}) {
+        seed(engine->getNodesMutable(), params.h_vev);
+        engine->setIntegrator(SATPHiggsIntegrator::Yoshida4);
+        engine->setSource([](double t, double x, double y, double z, int, int, int) {
+            return 0.3 * std::sin(3.0 * x + 2.0 * y + z + t);
+        });
+    }
+    tiled.evolve(12);
+    sweep.evolve(12);
+    check(relativeDifference(tiled.getNodes(), sweep.getNodes()) < SATPHiggsKernels::kTolerance,
+          "Yoshida4 tiled matches sweep");
+    check(tiled.getEvolveAllocationCount() == 0 && std::abs(tiled.getTime() - 12 * 0.02) < 1e-15,
+          "Yoshida4 steps use the persistent planes and advance by dt");
+    SATPHiggsIntegrator parsed = SATPHiggsIntegrator::Verlet;
+    check(parseSATPHiggsIntegrator("yoshida4", parsed) && parsed == SATPHiggsIntegrator::Yoshida4 &&
+          !parseSATPHiggsIntegrator("rk4", parsed), "integrator names parsed");
+}
+
+/**
+ * Parareal: exact after one iteration per slice, early convergence at the
+ * tolerance (double and float32 coarse), resume from a checkpoint
+ */
+void checkParareal(const SATPHiggsParams& params) {
+    std::cout << "Parareal missions" << std::endl;
+    GaussianPulseSource pulse;
+    pulse.amplitude = 0.5;
+    pulse.center[0] = 3.2;
+    pulse.sigma = 0.5;
+    pulse.frequency = 1.5;
+    const size_t steps = 240;
+
+    // Long-wavelength state: the coarse steps resolve it, so the iteration
+    // converges early (short waves need a finer coarse propagator)
+    auto smooth = [&](std::vector<SATPHiggsNode>& nodes, size_t N_x) {
+        for (size_t i = 0; i < nodes.size(); i++) {
+            nodes[i].phi = 0.3 * std::sin(2.0 * M_PI * (i % N_x) / N_x);
+            nodes[i].h = params.h_vev + 0.1 * std::cos(4.0 * M_PI * (i % N_x) / N_x);
+            nodes[i].updateDerived();
+        }
+    };
+    auto prepare = [&](SATPHiggsEngine1D& engine) {
+        smooth(engine.getNodesMutable(), 64);
+        engine.setSourceBatch(pulse);
+    };
+    SATPHiggsEngine1D serial(64, 0.1, 0.02, params);
+    prepare(serial);
+    serial.evolve(steps);
+
+    dase::PararealConfig exact;
+    exact.slices = 8;
+    exact.tolerance = 0.0;
+    SATPHiggsEngine1D sliced(64, 0.1, 0.02, params);
+    prepare(sliced);
+    const dase::PararealStats all = sliced.runParareal(steps, exact);
+    check(all.converged && all.iterations == 8 && all.slices == 8 && all.coarse_stride == 4,
+          "one iteration per slice");
+    check(maxFieldDifference(sliced.getNodes(), serial.getNodes()) < 1e-12, "exact after P iterations");
+    check(sliced.getStepCount() == steps && std::abs(sliced.getTime() - serial.getTime()) < 1e-12,
+          "clock advanced by the mission");
+
+    dase::PararealConfig early;
+    early.slices = 8;
+    early.tolerance = 1e-8;
+    SATPHiggsEngine1D converged(64, 0.1, 0.02, params);
+    prepare(converged);
+    const dase::PararealStats fast = converged.runParareal(steps, early);
+    check(fast.converged && fast.iterations < 8 && fast.change <= 1e-8, "converges in fewer iterations");
+    check(maxFieldDifference(converged.getNodes(), serial.getNodes()) < 1e-6, "converged state near serial");
+
+    SATPHiggsEngine2D serial_2d(16, 12, 0.1, 0.02, params);
+    SATPHiggsEngine2D float_2d(16, 12, 0.1, 0.02, params);
+    smooth(serial_2d.getNodesMutable(), 16);
+    smooth(float_2d.getNodesMutable(), 16);
+    serial_2d.evolve(90);
+    early.slices = 6;
+    early.coarse_float = true;
+    early.tolerance = 1e-10;
+    const dase::PararealStats f32 = float_2d.runParareal(90, early);
+    check(f32.converged && maxFieldDifference(float_2d.getNodes(), serial_2d.getNodes()) < 1e-8,
+          "float32 coarse propagator converges to the double run");
+
+    SATPHiggsEngine3D serial_3d(8, 6, 5, 0.1, 0.02, params);
+    SATPHiggsEngine3D sliced_3d(8, 6, 5, 0.1, 0.02, params);
+    seed(serial_3d.getNodesMutable(), params.h_vev);
+    seed(sliced_3d.getNodesMutable(), params.h_vev);
+    serial_3d.evolve(37);
+    exact.slices = 5;
+    exact.coarse_stride = 1000;
+    const dase::PararealStats strided = sliced_3d.runParareal(37, exact);
+    check(strided.coarse_stride * 0.02 <= params.stableDt(0.1, 3) && strided.coarse_stride >= 1,
+          "coarse stride held to the stability limit");
+    check(maxFieldDifference(sliced_3d.getNodes(), serial_3d.getNodes()) < 1e-12, "3D slices (uneven) exact");
+
+    // Interrupted after two iterations, resumed on a fresh engine
+    dase::PararealConfig resumable = exact;
+    resumable.slices = 8;
+    resumable.coarse_stride = 4;
+    resumable.max_iterations = 2;
+    resumable.checkpoint_path = "test_satp_parareal.bin";
+    SATPHiggsEngine1D first(64, 0.1, 0.02, params);
+    prepare(first);
+    const dase::PararealStats partial = first.runParareal(steps, resumable);
+    check(!partial.converged && partial.iterations == 2, "max_iterations stops the run");
+    SATPHiggsEngine1D fresh(64, 0.1, 0.02, params);
+    fresh.setSourceBatch(pulse);
+    resumable.max_iterations = 0;
+    const dase::PararealStats resumed = fresh.runParareal(steps, resumable);
+    check(resumed.resumed && resumed.converged && resumed.iterations == 8, "resumed from the checkpoint");
+    check(maxFieldDifference(fresh.getNodes(), serial.getNodes()) < 1e-12, "resumed run matches serial");
+    std::remove("test_satp_parareal.bin");
+}
+
+void checkStateInit(const SATPHiggsParams& params) {
+    std::cout << "Gaussian state initializers" << std::endl;
+
+    // Straight per-node evaluation with nearest-image distances
+    const size_t N_x = 160, N_y = 128;  // Above ProfileTables::kParallelThreshold
+    const double dx = 0.1;
+    SATPHiggsEngine2D engine(N_x, N_y, dx, 0.02, params);
+    GaussianProfile2DParams phi;
+    phi.amplitude = 0.7;
+    phi.center_x = 1.3;  // Near the edge: the profile wraps
+    phi.center_y = 11.0;
+    phi.sigma_x = 1.1;
+    phi.sigma_y = 0.6;
+    phi.set_velocity = true;
+    phi.velocity_amplitude = -0.2;
+    SATPHiggsStateInit2D::initPhiGaussian(engine, phi);
+    double max_diff = 0.0;
+    for (size_t y = 0; y < N_y; y++) {
+        for (size_t x = 0; x < N_x; x++) {
+            double ddx = static_cast<double>(x) * dx - phi.center_x;
+            double ddy = static_cast<double>(y) * dx - phi.center_y;
+            const double L_x = static_cast<double>(N_x) * dx, L_y = static_cast<double>(N_y) * dx;
+            if (ddx > L_x / 2.0) ddx -= L_x;
+            if (ddx < -L_x / 2.0) ddx += L_x;
+            if (ddy > L_y / 2.0) ddy -= L_y;
+            if (ddy < -L_y / 2.0) ddy += L_y;
+            const double g = std::exp(-ddx * ddx / (2.0 * phi.sigma_x * phi.sigma_x)
+                                      - ddy * ddy / (2.0 * phi.sigma_y * phi.sigma_y));
+            const auto& node = engine.getNodes()[engine.getIndex(x, y)];
+            max_diff = std::max(max_diff, std::abs(node.phi - phi.amplitude * g));
+            max_diff = std::max(max_diff, std::abs(node.phi_dot - phi.velocity_amplitude * g));
+            max_diff = std::max(max_diff, std::abs(node.conformal_factor - std::exp(node.phi)));
+        }
+    }
+    check(max_diff < 1e-14, "2D Gaussian matches periodic per-node formula");
+
+    // One sweep over a profile list vs one call per profile
+    GaussianProfile2DParams bump = phi;
+    bump.mode = "add";
+    bump.center_x = 8.0;
+    GaussianProfile2DParams higgs;
+    higgs.amplitude = 0.1;
+    higgs.center_x = 4.0;
+    higgs.center_y = 4.0;
+    higgs.sigma_x = higgs.sigma_y = 2.0;
+    higgs.mode = "blend";
+    higgs.beta = 0.25;
+    SATPHiggsEngine2D sequential(N_x, N_y, dx, 0.02, params);
+    SATPHiggsStateInit2D::initPhiGaussian(sequential, phi);
+    SATPHiggsStateInit2D::initPhiGaussian(sequential, bump);
+    SATPHiggsStateInit2D::initHiggsGaussian(sequential, higgs);
+    SATPHiggsEngine2D composed(N_x, N_y, dx, 0.02, params);
+    SATPHiggsStateInit2D::initGaussians(composed, {phi, bump}, {higgs});
+    check(maxFieldDifference(sequential.getNodes(), composed.getNodes()) == 0.0, "2D profile list matches calls in order");
+
+    SATPHiggsEngine3D sequential_3d(13, 6, 5, dx, 0.02, params);
+    SATPHiggsEngine3D composed_3d(13, 6, 5, dx, 0.02, params);
+    GaussianProfile3DParams ball;
+    ball.amplitude = 0.5;
+    ball.center_x = 0.2;
+    ball.center_y = 0.3;
+    ball.center_z = 0.1;
+    ball.sigma_x = ball.sigma_y = ball.sigma_z = 0.2;
+    GaussianProfile3DParams ball_h = ball;
+    ball_h.mode = "add";
+    SATPHiggsStateInit3D::initPhiGaussian(sequential_3d, ball);
+    SATPHiggsStateInit3D::initHiggsGaussian(sequential_3d, ball_h);
+    SATPHiggsStateInit3D::initGaussians(composed_3d, {ball}, {ball_h});
+    const auto& origin = composed_3d.getNodes()[0];
+    const double g0 = std::exp(-(0.2 * 0.2 + 0.3 * 0.3 + 0.1 * 0.1) / (2.0 * 0.2 * 0.2));
+    check(maxFieldDifference(sequential_3d.getNodes(), composed_3d.getNodes()) == 0.0 &&
+          std::abs(origin.phi - 0.5 * g0) < 1e-15 && std::abs(origin.h - (params.h_vev + 0.5 * g0)) < 1e-14,
+          "3D profile list matches calls in order");
+}
+
+void checkAdaptive(const SATPHiggsParams& params) {
+    std::cout << "adaptive stepping" << std::endl;
+    GaussianProfile2DParams pulse;
+    pulse.amplitude = 0.5;
+    pulse.center_x = pulse.center_y = 12.0;
+    pulse.sigma_x = pulse.sigma_y = 2.0;
+
+    // Reference at a tenth of the engine dt; the adaptive run starts from dt = 0.01
+    const double t_end = 10.0;
+    SATPHiggsEngine2D fine(48, 48, 0.5, 0.001, params);
+    SATPHiggsEngine2D adaptive(48, 48, 0.5, 0.01, params);
+    SATPHiggsStateInit2D::initPhiGaussian(fine, pulse);
+    SATPHiggsStateInit2D::initPhiGaussian(adaptive, pulse);
+    fine.evolve(10000);
+
+    AdaptiveStepConfig config;
+    config.tolerance = 1e-7;
+    const AdaptiveRunStats stats = adaptive.runUntil(t_end, config);
+    check(stats.reached && std::abs(adaptive.getTime() - t_end) < 1e-12 &&
+          adaptive.getStepCount() == stats.steps && adaptive.getDt() == 0.01,
+          "lands on t_end and keeps the configured dt");
+    check(stats.steps < 500 && stats.dt_largest > 0.05, "dt grows past the configured step");
+    check(stats.dt_largest <= config.stability_fraction * params.stableDt(0.5, 2) * (1.0 + 1e-12),
+          "dt stays below the stability limit");
+    check(maxFieldDifference(fine.getNodes(), adaptive.getNodes()) < 1e-3, "adaptive state tracks the reference");
+
+    SATPHiggsEngine1D rejecting(128, 0.1, 0.01, params);
+    {
+        auto& nodes = rejecting.getNodesMutable();
+        for (size_t i = 0; i < nodes.size(); i++) nodes[i].phi = 0.5 * std::exp(-0.5 * std::pow((i - 64.0) * 0.1, 2));
+    }
+    config.dt_initial = 1.0;  // Far above the stability limit: clamped, then shrunk
+    const AdaptiveRunStats shrunk = rejecting.runUntil(1.0, config);
+    check(shrunk.reached && shrunk.rejected > 0 && std::isfinite(rejecting.computeTotalEnergy()),
+          "oversized first step is rejected and recovered");
+}
+
+} // namespace
+
+void checkDispatch(const SATPHiggsParams& params) {
+    using dase::SimdLevel;
+    std::cout << "Runtime SIMD dispatch (" << dase::simdLevelName(dase::activeSimdLevel()) << ")" << std::endl;
+    const SimdLevel initial = dase::activeSimdLevel();
+    const SimdLevel detected = dase::detectSimdLevel();
+    check(detected >= dase::compiledSimdLevel(), "CPU runs the compiled baseline");
+    check(dase::setSimdLevel(SimdLevel::AVX512) == detected, "requested level capped to the CPU");
+    check(dase::setSimdLevel(SimdLevel::Scalar) == dase::compiledSimdLevel(), "level kept at the compiled baseline");
+
+    SATPHiggsEngine2D scalar(23, 9, 0.1, 0.02, params);
+    scalar.setVectorized(false);
+    seed(scalar.getNodesMutable(), params.h_vev);
+    scalar.evolve(20);
+
+    bool all_match = true;
+    bool avx2_reported = true;
+    for (int l = static_cast<int>(dase::compiledSimdLevel()); l <= static_cast<int>(detected); l++) {
+        const SimdLevel level = dase::setSimdLevel(static_cast<SimdLevel>(l));
+        SATPHiggsEngine2D vectorized(23, 9, 0.1, 0.02, params);
+        seed(vectorized.getNodesMutable(), params.h_vev);
+        vectorized.evolve(20);
+        all_match &= relativeDifference(vectorized.getNodes(), scalar.getNodes()) < SATPHiggsKernels::kTolerance;
+        avx2_reported &= SATPHiggsKernels::hasAVX2() == (DASE_SIMD_HAS_AVX2 && level >= SimdLevel::AVX2);
+    }
+    check(all_match, "vectorized matches scalar at every level");
+    check(avx2_reported, "AVX2 kernels follow the active level");
+    dase::setSimdLevel(initial);
+}
+
+int main() {
+    std::cout << "=== SATP+Higgs Engine Test ===" << std::endl;
+
+    SATPHiggsParams params;
+    params.gamma_phi = 0.01;
+
+    SATPHiggsEngine1D whole_1d(64, 0.1, 0.02, params);
+    SATPHiggsEngine1D split_1d(64, 0.1, 0.02, params);
+    checkEngine(whole_1d, split_1d, "1D engine");
+
+    SATPHiggsEngine2D whole_2d(24, 16, 0.1, 0.02, params);
+    SATPHiggsEngine2D split_2d(24, 16, 0.1, 0.02, params);
+    checkEngine(whole_2d, split_2d, "2D engine");
+
+    SATPHiggsEngine3D whole_3d(8, 8, 8, 0.1, 0.02, params);
+    SATPHiggsEngine3D split_3d(8, 8, 8, 0.1, 0.02, params);
+    checkEngine(whole_3d, split_3d, "3D engine");
+
+    // Odd widths exercise the vector tail and both wrapped columns;
+    // a static source field S(x) checks the source pass
+    auto source_at = [](double x, double y, double z) {
+        return 0.3 * std::sin(3.0 * x + 2.0 * y + z);
+    };
+
+    SATPHiggsEngine1D vec_1d(103, 0.1, 0.02, params);
+    SATPHiggsEngine1D sca_1d(103, 0.1, 0.02, params);
+    std::vector<double> source_1d(103);
+    for (size_t i = 0; i < source_1d.size(); i++) source_1d[i] = source_at(i * 0.1, 0.0, 0.0);
+    for (auto* engine : {&vec_1d, &sca_1d}) {
+        engine->setSource([&](double, double x, int) { return source_at(x, 0.0, 0.0); });
+    }
+    checkKernels(vec_1d, sca_1d, 103, 1, 1, source_1d, "1D kernels");
+
+    SATPHiggsEngine2D vec_2d(23, 9, 0.1, 0.02, params);
+    SATPHiggsEngine2D sca_2d(23, 9, 0.1, 0.02, params);
+    std::vector<double> source_2d(23 * 9);
+    for (size_t i = 0; i < source_2d.size(); i++) source_2d[i] = source_at((i % 23) * 0.1, (i / 23) * 0.1, 0.0);
+    for (auto* engine : {&vec_2d, &sca_2d}) {
+        engine->setSource([&](double, double x, double y, int, int) { return source_at(x, y, 0.0); });
+    }
+    checkKernels(vec_2d, sca_2d, 23, 9, 1, source_2d, "2D kernels");
+
+    SATPHiggsEngine3D vec_3d(13, 6, 5, 0.1, 0.02, params);
+    SATPHiggsEngine3D sca_3d(13, 6, 5, 0.1, 0.02, params);
+    std::vector<double> no_source(13 * 6 * 5, 0.0);
+    checkKernels(vec_3d, sca_3d, 13, 6, 5, no_source, "3D kernels");
+
+    checkTiled(13, 6, 5, true, false, params, "3D tiled (vectorized)");
+    checkTiled(13, 6, 5, false, true, params, "3D tiled (scalar, source)");
+    checkTiled(9, 7, 3, true, true, params, "3D tiled (N_z = 3)");
+    checkTiled(8, 4, 2, true, false, params, "3D tiled fallback (N_z = 2)");
+
+    SATPHiggsEngine1D f32_1d(103, 0.1, 0.02, params);
+    SATPHiggsEngine1D f64_1d(103, 0.1, 0.02, params);
+    checkFloat(f32_1d, f64_1d, "1D float32 step");
+
+    SATPHiggsEngine2D f32_2d(23, 9, 0.1, 0.02, params);
+    SATPHiggsEngine2D f64_2d(23, 9, 0.1, 0.02, params);
+    checkFloat(f32_2d, f64_2d, "2D float32 step");
+
+    SATPHiggsEngine3D f32_3d(13, 6, 5, 0.1, 0.02, params);
+    SATPHiggsEngine3D f64_3d(13, 6, 5, 0.1, 0.02, params);
+    checkFloat(f32_3d, f64_3d, "3D float32 step");
+
+    SATPHiggsEngine1D diag_1d(103, 0.1, 0.02, params);
+    checkDiagnostics(diag_1d, 103, 1, 1, 1, "1D diagnostics");
+    SATPHiggsEngine2D diag_2d(23, 9, 0.1, 0.02, params);
+    checkDiagnostics(diag_2d, 23, 9, 1, 2, "2D diagnostics");
+    SATPHiggsEngine3D diag_3d(13, 6, 5, 0.1, 0.02, params);
+    checkDiagnostics(diag_3d, 13, 6, 5, 3, "3D diagnostics");
+
+    // Bulk field access: strided write, derived values refreshed, read back
+    SATPHiggsEngine2D bulk_2d(6, 5, 0.1, 0.02, params);
+    std::vector<double> pairs = {0.5, 9.0, 0.25, 9.0, -0.5, 9.0};
+    check(bulk_2d.setFieldRange(SATPHiggsField::Phi, 7, 3, pairs.data(), 2), "bulk phi write (stride 2)");
+    check(std::abs(bulk_2d.getNodes()[8].conformal_factor - std::exp(0.25)) < 1e-15, "bulk write refreshes derived");
+    std::vector<double> h_out(30);
+    check(bulk_2d.getFieldRange(SATPHiggsField::H, 0, 30, h_out.data()) &&
+          h_out[29] == bulk_2d.getNodes()[29].h, "bulk h read");
+    check(!bulk_2d.getFieldRange(SATPHiggsField::H, 1, 30, h_out.data()), "bulk range past the end rejected");
+
+    // Checkpoint/restart: restored engine continues the same trajectory
+    SATPHiggsEngine3D ckpt_3d(7, 6, 5, 0.1, 0.02, params);
+    ckpt_3d.setFieldRange(SATPHiggsField::Phi, 10, 3, pairs.data(), 2);
+    ckpt_3d.evolve(4);
+    check(dase::saveCheckpointFile(ckpt_3d, "test_satp_checkpoint.bin"), "checkpoint write");
+    SATPHiggsEngine3D resumed_3d(7, 6, 5, 0.1, 0.02, params);
+    check(dase::loadCheckpointFile(resumed_3d, "test_satp_checkpoint.bin") &&
+          resumed_3d.getStepCount() == 4 && resumed_3d.getTime() == ckpt_3d.getTime(), "checkpoint restore");
+    ckpt_3d.evolve(3);
+    resumed_3d.evolve(3);
+    check(maxFieldDifference(ckpt_3d.getNodes(), resumed_3d.getNodes()) == 0.0, "restart continues the trajectory");
+    check(!dase::loadCheckpointFile(bulk_2d, "test_satp_checkpoint.bin"), "checkpoint of another engine rejected");
+    std::remove("test_satp_checkpoint.bin");
+
+    checkStateInit(params);
+    checkAdaptive(params);
+    checkDispatch(params);
+    checkBatchSource(params);
+    checkIntegrator(params);
+    checkParareal(params);
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
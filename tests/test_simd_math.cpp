@@ -0,0 +1,219 @@
+/**
+ * SIMD Math Test
+ *
+ * Checks at every SIMD level that expArray, sinCosArray and atan2Array stay
+ * within their documented ULP bounds of libm over random arguments, that
+ * special values (±0, ±inf, NaN, overflow, underflow, large sin/cos
+ * arguments, atan2 on the axes) follow libm, that every element of a call
+ * gets the same value whatever the array length and offset (tails), and
+ * that outputs may alias inputs.
+ */
+
+#include "../src/cpp/simd_math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+// The libm references must be plain calls in -ffast-math builds too
+#if defined(__clang__) || defined(_MSC_VER)
+#pragma float_control(precise, on, push)
+#elif defined(__GNUC__)
+#pragma GCC optimize("no-fast-math", "no-tree-vectorize")
+#endif
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+// Distance in representable doubles (0 for equal values, including ±0 and NaN/NaN)
+double ulpDistance(double a, double b) {
+    if (a == b || (std::isnan(a) && std::isnan(b))) return 0.0;
+    if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<double>::infinity();
+    auto ordered = [](double v) {
+        int64_t i;
+        std::memcpy(&i, &v, sizeof(i));
+        return i < 0 ? std::numeric_limits<int64_t>::min() - i : i;
+    };
+    const int64_t ia = ordered(a), ib = ordered(b);
+    const uint64_t distance = ia > ib ? static_cast<uint64_t>(ia) - static_cast<uint64_t>(ib)
+                                      : static_cast<uint64_t>(ib) - static_cast<uint64_t>(ia);
+    return static_cast<double>(distance);
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+std::vector<double> uniform(size_t n, double lo, double hi, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<double> x(n);
+    for (auto& v : x) v = dist(rng);
+    return x;
+}
+
+void testAccuracy() {
+    const size_t n = 1000000;
+    std::vector<double> out(n), out_cos(n);
+
+    const double exp_ranges[][2] = {{-745.0, 709.7}, {-1.0, 1.0}, {-30.0, 30.0}};
+    double exp_ulp = 0.0;
+    for (const auto& range : exp_ranges) {
+        const std::vector<double> x = uniform(n, range[0], range[1], 11);
+        expArray(x.data(), out.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            const double ref = std::exp(x[i]);
+            if (ref >= std::numeric_limits<double>::min()) exp_ulp = std::max(exp_ulp, ulpDistance(out[i], ref));
+        }
+    }
+    std::cout << "  exp max error " << exp_ulp << " ULP" << std::endl;
+    check(exp_ulp <= 1.0, "exp within 1 ULP of libm");
+
+    const double sincos_ranges[] = {1.0, 10.0, 1000.0, 1.0e5};
+    double sin_ulp = 0.0, cos_ulp = 0.0, near_zero = 0.0;
+    for (double range : sincos_ranges) {
+        const std::vector<double> x = uniform(n, -range, range, 12);
+        sinCosArray(x.data(), out.data(), out_cos.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            const double s = std::sin(x[i]);
+            const double c = std::cos(x[i]);
+            if (std::fabs(s) >= 1e-3) sin_ulp = std::max(sin_ulp, ulpDistance(out[i], s));
+            else near_zero = std::max(near_zero, std::fabs(out[i] - s));
+            if (std::fabs(c) >= 1e-3) cos_ulp = std::max(cos_ulp, ulpDistance(out_cos[i], c));
+            else near_zero = std::max(near_zero, std::fabs(out_cos[i] - c));
+        }
+    }
+    std::cout << "  sin/cos max error " << sin_ulp << "/" << cos_ulp << " ULP, " << near_zero
+              << " near zeros" << std::endl;
+    check(sin_ulp <= 1.0 && cos_ulp <= 1.0, "sin/cos within 1 ULP of libm");
+    check(near_zero <= std::ldexp(1.0, -60), "sin/cos within 2^-60 near their zeros");
+
+    double atan_ulp = 0.0;
+    {
+        const std::vector<double> y = uniform(n, -10.0, 10.0, 13);
+        const std::vector<double> x = uniform(n, -10.0, 10.0, 14);
+        atan2Array(y.data(), x.data(), out.data(), n);
+        for (size_t i = 0; i < n; i++) atan_ulp = std::max(atan_ulp, ulpDistance(out[i], std::atan2(y[i], x[i])));
+    }
+    {
+        std::vector<double> y = uniform(n, -10.0, 10.0, 15);
+        std::vector<double> x = uniform(n, -10.0, 10.0, 16);
+        std::mt19937_64 rng(17);
+        std::uniform_int_distribution<int> exponent(-300, 300);
+        for (size_t i = 0; i < n; i++) {
+            y[i] = std::ldexp(y[i], exponent(rng));
+            x[i] = std::ldexp(x[i], exponent(rng));
+        }
+        atan2Array(y.data(), x.data(), out.data(), n);
+        for (size_t i = 0; i < n; i++) atan_ulp = std::max(atan_ulp, ulpDistance(out[i], std::atan2(y[i], x[i])));
+    }
+    std::cout << "  atan2 max error " << atan_ulp << " ULP" << std::endl;
+    check(atan_ulp <= 2.0, "atan2 within 2 ULP of libm");
+}
+
+void testSpecialValues() {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    const std::vector<double> x = {0.0, -0.0, inf, -inf, nan, 709.79, 710.0, 1e300,
+                                   -745.2, -746.0, -1e300, -744.0, -708.5, 1e6, -3e7};
+    std::vector<double> e(x.size()), s(x.size()), c(x.size());
+    expArray(x.data(), e.data(), x.size());
+    sinCosArray(x.data(), s.data(), c.data(), x.size());
+    bool exp_ok = true, sincos_ok = true;
+    for (size_t i = 0; i < x.size(); i++) {
+        const double ref = std::exp(x[i]);
+        exp_ok = exp_ok && (sameBits(e[i], ref) || (ref != 0.0 && std::isfinite(ref) && ulpDistance(e[i], ref) <= 1.0));
+        sincos_ok = sincos_ok && sameBits(s[i], std::sin(x[i])) && ulpDistance(c[i], std::cos(x[i])) <= 1.0;
+    }
+    check(exp_ok, "exp of ±0, ±inf, NaN, overflow and underflow (subnormal results) match libm");
+    check(sincos_ok, "sin/cos of ±0, ±inf, NaN and huge arguments match libm");
+
+    const std::vector<double> y = {0.0, -0.0, 0.0, -0.0, inf, -inf, 1.0, -1.0, 1.0, nan, 0.0, -2.0, inf};
+    const std::vector<double> xa = {0.0, 0.0, -0.0, -0.0, inf, 1.0, -0.0, -inf, inf, 1.0, -3.0, 0.0, nan};
+    std::vector<double> a(y.size());
+    atan2Array(y.data(), xa.data(), a.data(), y.size());
+    bool atan_ok = true;
+    for (size_t i = 0; i < y.size(); i++) atan_ok = atan_ok && sameBits(a[i], std::atan2(y[i], xa[i]));
+    check(atan_ok, "atan2 on zeros, axes, infinities and NaN matches libm bit for bit");
+}
+
+void testTailsAndAliasing() {
+    const size_t n = 67;
+    const std::vector<double> x = uniform(n, -20.0, 20.0, 21);
+    const std::vector<double> y = uniform(n, -20.0, 20.0, 22);
+    std::vector<double> e(n), s(n), c(n), a(n);
+    expArray(x.data(), e.data(), n);
+    sinCosArray(x.data(), s.data(), c.data(), n);
+    atan2Array(y.data(), x.data(), a.data(), n);
+
+    bool same = true;
+    for (size_t offset = 0; offset < 9; offset++) {
+        for (size_t len = 0; offset + len <= n && len < 20; len++) {
+            std::vector<double> pe(len), ps(len), pc(len), pa(len);
+            expArray(x.data() + offset, pe.data(), len);
+            sinCosArray(x.data() + offset, ps.data(), pc.data(), len);
+            atan2Array(y.data() + offset, x.data() + offset, pa.data(), len);
+            for (size_t i = 0; i < len; i++) {
+                same = same && sameBits(pe[i], e[offset + i]) && sameBits(ps[i], s[offset + i]) &&
+                       sameBits(pc[i], c[offset + i]) && sameBits(pa[i], a[offset + i]);
+            }
+        }
+    }
+    check(same, "results independent of array length and offset");
+
+    std::vector<double> only_sin(n), only_cos(n);
+    sinCosArray(x.data(), only_sin.data(), nullptr, n);
+    sinCosArray(x.data(), nullptr, only_cos.data(), n);
+    check(only_sin == s && only_cos == c, "sin-only and cos-only calls match the pair");
+
+    std::vector<double> in_place = x;
+    expArray(in_place.data(), in_place.data(), n);
+    bool alias_ok = in_place == e;
+    in_place = x;
+    sinCosArray(in_place.data(), in_place.data(), c.data(), n);
+    alias_ok = alias_ok && in_place == s;
+    in_place = y;
+    atan2Array(in_place.data(), x.data(), in_place.data(), n);
+    alias_ok = alias_ok && in_place == a;
+    check(alias_ok, "outputs may alias inputs");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== SIMD Math Test ===" << std::endl;
+
+    const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE4, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (SimdLevel requested : levels) {
+        const SimdLevel level = setSimdLevel(requested);
+        if (level != requested) continue;
+        std::cout << "Level " << simdLevelName(level) << std::endl;
+        testAccuracy();
+        testSpecialValues();
+        testTailsAndAliasing();
+    }
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
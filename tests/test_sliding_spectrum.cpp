@@ -0,0 +1,159 @@
+/**
+ * Sliding Spectrum Bank Test
+ *
+ * Checks SlidingSpectrumBank against a direct windowed DFT of the last
+ * window samples (rectangular and Hann, on and off the window's bins,
+ * before the window fills and across the periodic Goertzel resync), the
+ * normalized magnitudes of a sinusoid and a constant, and the spectrogram
+ * frame ring (hop, capacity, dropped frames, clear).
+ */
+
+#include "../src/cpp/sliding_spectrum.h"
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+const double kTwoPi = 6.283185307179586476925286766559;
+
+// ∑_m w_m x_m e^{-i2πfm} over the window ending at sample n (zeros before 0)
+std::complex<double> directDFT(const std::vector<double>& x, size_t n, size_t W, double f, SpectrumWindow shape) {
+    std::complex<double> sum;
+    for (size_t m = 0; m < W; m++) {
+        const long i = static_cast<long>(n) - static_cast<long>(W) + 1 + static_cast<long>(m);
+        if (i < 0) continue;
+        const double w = shape == SpectrumWindow::Hann ? 0.5 - 0.5 * std::cos(kTwoPi * m / W) : 1.0;
+        sum += w * x[static_cast<size_t>(i)] * std::polar(1.0, -kTwoPi * f * static_cast<double>(m));
+    }
+    return sum;
+}
+
+void testAgainstDirectDFT() {
+    std::cout << "sliding DFT vs direct DFT" << std::endl;
+    const size_t W = 64;
+    const size_t n = SlidingSpectrumBank::kResyncWindows * W * 3 + 17;
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> noise;
+    std::vector<double> a(n), b(n);
+    for (size_t i = 0; i < n; i++) {
+        a[i] = std::sin(kTwoPi * 0.1 * i) + 0.2 * noise(rng);
+        b[i] = 3.0 + std::cos(kTwoPi * 0.237 * i);
+    }
+
+    for (SpectrumWindow shape : {SpectrumWindow::Rectangular, SpectrumWindow::Hann}) {
+        SlidingSpectrumConfig config;
+        config.frequencies = {0.0, 0.1, 0.237, 0.5, 3.0 / W};
+        config.window = W;
+        config.shape = shape;
+        SlidingSpectrumBank bank;
+        bank.configure(2, config);
+
+        double worst = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            const double values[2] = {a[i], b[i]};
+            bank.push(i, 0.0, values);
+            if (i % 7 != 0 && i + 1 != n) continue;
+            for (size_t k = 0; k < config.frequencies.size(); k++) {
+                const std::complex<double> ref_a = directDFT(a, i, W, config.frequencies[k], shape);
+                const std::complex<double> ref_b = directDFT(b, i, W, config.frequencies[k], shape);
+                worst = std::max(worst, std::abs(bank.coefficient(0, k) - ref_a));
+                worst = std::max(worst, std::abs(bank.coefficient(1, k) - ref_b));
+            }
+        }
+        std::cout << "  " << spectrumWindowName(shape) << " max error " << worst << std::endl;
+        check(worst < 1e-9, shape == SpectrumWindow::Hann ? "Hann terms match the direct DFT"
+                                                           : "rectangular terms match the direct DFT");
+    }
+}
+
+void testMagnitudes() {
+    std::cout << "normalized magnitudes" << std::endl;
+    SlidingSpectrumConfig config;
+    config.frequencies = {0.0, 0.125, 0.25};
+    config.window = 128;
+    SlidingSpectrumBank bank;
+    bank.configure(1, config);
+    check(!bank.ready(), "not ready before the window fills");
+    for (size_t i = 0; i < 1000; i++) {
+        const double v = 1.5 + 2.0 * std::sin(kTwoPi * 0.125 * i + 0.3);
+        bank.push(i, 0.01 * i, &v);
+    }
+    check(bank.ready(), "ready once the window fills");
+    check(std::abs(bank.magnitude(0, 0) - 1.5) < 1e-9, "constant c reads c at f = 0");
+    check(std::abs(bank.magnitude(0, 1) - 1.0) < 1e-9, "sinusoid of amplitude A reads A/2 at its frequency");
+    check(bank.magnitude(0, 2) < 1e-9, "Hann window leaves no leakage into other bins");
+}
+
+void testFrames() {
+    std::cout << "spectrogram frames" << std::endl;
+    SlidingSpectrumConfig config;
+    config.frequencies = {0.05, 0.2};
+    config.window = 32;
+    config.hop = 8;
+    config.frames = 4;
+    SlidingSpectrumBank bank;
+    bank.configure(2, config);
+
+    // A tone that switches from 0.05 to 0.2 at sample 200
+    for (size_t i = 0; i < 400; i++) {
+        const double f = i < 200 ? 0.05 : 0.2;
+        const double values[2] = {std::cos(kTwoPi * f * i), 0.0};
+        bank.push(1000 + i, 0.5 * i, values);
+    }
+    // Frames after samples 32, 40, ..., 400: (400 - 32) / 8 + 1 = 47
+    check(bank.framesRecorded() == 47 && bank.frameCount() == 4 && bank.framesDropped() == 43,
+          "one frame per hop once the window is full, ring keeps the newest");
+
+    std::vector<double> steps, times, frames, silent;
+    bank.copyFrameSteps(steps);
+    bank.copyFrameTimes(times);
+    bank.copyFrames(0, frames);
+    bank.copyFrames(1, silent);
+    check(steps.size() == 4 && steps.front() == 1000 + 375 && steps.back() == 1000 + 399 &&
+          times.back() == 0.5 * 399, "frame steps and times are those of their last sample");
+    check(frames.size() == 8 && frames[1] > 0.49 && frames[0] < 0.01 && frames[6] < 0.01,
+          "frames follow the switched tone");
+    check(silent.size() == 8 && silent[0] == 0.0 && silent[7] == 0.0, "channels keep separate frames");
+    check(std::abs(frames[7] - bank.magnitude(0, 1)) < 1e-15, "newest frame is the current window");
+
+    bank.clear();
+    check(bank.frameCount() == 0 && bank.samples() == 0 && !bank.ready() && bank.magnitude(0, 1) == 0.0,
+          "clear empties window and frames");
+
+    bank.configure(2, SlidingSpectrumConfig());
+    const double values[2] = {1.0, 2.0};
+    bank.push(0, 0.0, values);
+    check(!bank.enabled() && bank.frameCount() == 0, "no frequencies disables the bank");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Sliding Spectrum Test ===" << std::endl;
+    testAgainstDirectDFT();
+    testMagnitudes();
+    testFrames();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
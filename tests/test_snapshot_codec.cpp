@@ -0,0 +1,182 @@
+/**
+ * Snapshot Codec Test
+ *
+ * Checks that the lossless codec round-trips smooth, noisy, constant,
+ * special-value and tiny fields bit-exactly, that smooth fields actually
+ * shrink, that the quantized codec keeps every value within its error
+ * bound (falling back to lossless on non-finite chunks), that range
+ * decodes match the full decode, that encodings are identical for every
+ * OpenMP thread count, and that truncated or corrupted bytes are rejected.
+ */
+
+#include "../src/cpp/snapshot_codec.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* name) {
+    if (condition) {
+        std::cout << "  [PASS] " << name << std::endl;
+    } else {
+        std::cout << "  [FAIL] " << name << std::endl;
+        failures++;
+    }
+}
+
+void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+bool bitEqual(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+std::vector<double> smoothField(size_t n) {
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = 0.5 * std::exp(-std::pow((static_cast<double>(i) - n / 2.0) / (n / 8.0), 2.0));
+    }
+    return x;
+}
+
+bool roundTrips(const std::vector<double>& x, const SnapshotCodecOptions& options) {
+    const std::vector<uint8_t> bytes = encodeSnapshotField(x.data(), x.size(), options);
+    std::vector<double> decoded;
+    return decodeSnapshotField(bytes.data(), bytes.size(), decoded) && bitEqual(x, decoded);
+}
+
+void testLossless() {
+    std::cout << "lossless codec" << std::endl;
+    SnapshotCodecOptions options;
+    options.chunk_values = 4096;
+
+    const std::vector<double> smooth = smoothField(100003);  // Odd tail chunk
+    const std::vector<uint8_t> bytes = encodeSnapshotField(smooth.data(), smooth.size(), options);
+    std::vector<double> decoded;
+    check(decodeSnapshotField(bytes.data(), bytes.size(), decoded) && bitEqual(smooth, decoded),
+          "smooth field round-trips bit-exactly");
+    check(bytes.size() < smooth.size() * sizeof(double) * 4 / 5, "smooth field compresses");
+    check(snapshotFieldCount(bytes.data(), bytes.size()) == smooth.size(), "encoded count");
+
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> noise(20000);
+    for (double& v : noise) v = uniform(rng);
+    const std::vector<uint8_t> noise_bytes = encodeSnapshotField(noise.data(), noise.size(), options);
+    check(roundTrips(noise, options), "random field round-trips bit-exactly");
+    check(noise_bytes.size() <= noise.size() * sizeof(double) + 64,
+          "incompressible field stays near raw size");
+
+    check(roundTrips(std::vector<double>(50000, 0.25), options), "constant field round-trips");
+    check(roundTrips({}, options) && roundTrips({1.0}, options) && roundTrips({1.0, -2.0, 3.0}, options),
+          "empty and tiny fields round-trip");
+    std::vector<double> special = {0.0, -0.0, std::numeric_limits<double>::infinity(),
+                                   -std::numeric_limits<double>::infinity(),
+                                   std::numeric_limits<double>::quiet_NaN(),
+                                   std::numeric_limits<double>::denorm_min(), 1e308};
+    check(roundTrips(special, options), "special values round-trip bit-exactly");
+}
+
+void testQuantized() {
+    std::cout << "quantized codec" << std::endl;
+    SnapshotCodecOptions options;
+    options.codec = SnapshotCodec::Quantized;
+    options.error_bound = 1e-4;
+    options.chunk_values = 4096;
+
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> normal(0.0, 1e-3);
+    std::vector<double> x = smoothField(60000);
+    for (double& v : x) v += normal(rng);
+
+    const std::vector<uint8_t> bytes = encodeSnapshotField(x.data(), x.size(), options);
+    std::vector<double> decoded;
+    bool ok = decodeSnapshotField(bytes.data(), bytes.size(), decoded) && decoded.size() == x.size();
+    double max_error = 0.0;
+    for (size_t i = 0; ok && i < x.size(); i++) max_error = std::max(max_error, std::abs(decoded[i] - x[i]));
+    check(ok && max_error <= options.error_bound, "every value within the error bound");
+
+    SnapshotCodecOptions lossless = options;
+    lossless.codec = SnapshotCodec::Lossless;
+    const std::vector<uint8_t> exact = encodeSnapshotField(x.data(), x.size(), lossless);
+    check(bytes.size() * 2 < exact.size(), "quantized frame much smaller than lossless");
+
+    std::vector<double> with_nan = smoothField(10000);
+    with_nan[9000] = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<uint8_t> nan_bytes = encodeSnapshotField(with_nan.data(), with_nan.size(), options);
+    std::vector<double> nan_decoded;
+    ok = decodeSnapshotField(nan_bytes.data(), nan_bytes.size(), nan_decoded) && snapshot_codec_detail::isNonFinite(nan_decoded[9000]);
+    for (size_t i = 8192; ok && i < with_nan.size(); i++) {
+        ok = i == 9000 || nan_decoded[i] == with_nan[i];  // Whole chunk stored exactly
+    }
+    for (size_t i = 0; ok && i < 8192; i++) ok = std::abs(nan_decoded[i] - with_nan[i]) <= options.error_bound;
+    check(ok, "non-finite chunk falls back to lossless");
+}
+
+void testRangesAndThreads() {
+    std::cout << "random access and threading" << std::endl;
+    SnapshotCodecOptions options;
+    options.chunk_values = 1000;
+    const std::vector<double> x = smoothField(12345);
+    const std::vector<uint8_t> bytes = encodeSnapshotField(x.data(), x.size(), options);
+
+    bool ok = true;
+    const size_t ranges[][2] = {{0, 1}, {999, 2}, {1500, 300}, {0, 12345}, {12000, 345}, {4321, 0}};
+    for (const auto& range : ranges) {
+        std::vector<double> window(range[1]);
+        ok = ok && decodeSnapshotRange(bytes.data(), bytes.size(), range[0], range[1], window.data()) &&
+             std::memcmp(window.data(), x.data() + range[0], range[1] * sizeof(double)) == 0;
+    }
+    check(ok, "range decodes match the field");
+    std::vector<double> past(10);
+    check(!decodeSnapshotRange(bytes.data(), bytes.size(), 12340, 10, past.data()), "range past the end rejected");
+
+    setThreads(1);
+    const std::vector<uint8_t> serial = encodeSnapshotField(x.data(), x.size(), options);
+    setThreads(4);
+    const std::vector<uint8_t> threaded = encodeSnapshotField(x.data(), x.size(), options);
+    check(serial == threaded, "encoding independent of thread count");
+
+    std::vector<double> decoded;
+    check(!decodeSnapshotField(bytes.data(), bytes.size() - 1, decoded), "truncated field rejected");
+    std::vector<uint8_t> corrupt = bytes;
+    corrupt[corrupt.size() / 2] ^= 0xff;
+    corrupt[corrupt.size() / 2 + 1] ^= 0x5a;
+    const bool corrupt_ok = decodeSnapshotField(corrupt.data(), corrupt.size(), decoded);
+    check(!corrupt_ok || decoded.size() == x.size(), "corrupted payload never overruns");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Snapshot Codec Test ===" << std::endl;
+
+    testLossless();
+    testQuantized();
+    testRangesAndThreads();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}